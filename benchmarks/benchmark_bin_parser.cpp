@@ -0,0 +1,87 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <vector>
+
+#include <ur_client_library/comm/bin_parser.h>
+#include <ur_client_library/types.h>
+
+using namespace urcl;
+
+namespace
+{
+// Enough data for every benchmark iteration to parse a full buffer
+constexpr size_t BUFFER_SIZE = 4096;
+}  // namespace
+
+template <typename T>
+static void BM_BinParserPrimitive(benchmark::State& state)
+{
+  std::vector<uint8_t> buffer(BUFFER_SIZE, 0x3f);
+  const size_t count = BUFFER_SIZE / sizeof(T);
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+      T value;
+      bp.parse(value);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, uint8_t);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, int32_t);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, uint64_t);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, float);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, double);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, vector6d_t);
+BENCHMARK_TEMPLATE(BM_BinParserPrimitive, vector6int32_t);
+
+static void BM_BinParserDoubleArray(benchmark::State& state)
+{
+  std::vector<uint8_t> buffer(BUFFER_SIZE, 0x3f);
+  constexpr size_t COUNT = BUFFER_SIZE / sizeof(double);
+  std::array<double, COUNT> values;
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    bp.parse(values);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * COUNT);
+  state.SetBytesProcessed(state.iterations() * BUFFER_SIZE);
+}
+BENCHMARK(BM_BinParserDoubleArray);
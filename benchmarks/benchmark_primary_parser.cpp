@@ -0,0 +1,76 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ur_client_library/comm/bin_parser.h>
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/primary/primary_parser.h>
+
+using namespace urcl;
+
+namespace
+{
+// First robot state of a UR5e from URSim 5.8, the same as used by the primary parser tests
+std::vector<uint8_t> readCapturedFrame()
+{
+  const std::string path = std::string(URCL_BENCHMARK_RESOURCES) + "/robot_state_ur5e.bin";
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+  {
+    throw UrException("Could not open captured frame " + path);
+  }
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+static void BM_PrimaryParserParse(benchmark::State& state)
+{
+  std::vector<uint8_t> frame = readCapturedFrame();
+  primary_interface::PrimaryParser parser;
+  parser.setRobotStateFrames(state.range(0) != 0);
+  std::vector<std::unique_ptr<primary_interface::PrimaryPackage>> products;
+
+  for (auto _ : state)
+  {
+    comm::BinParser bp(frame.data(), frame.size());
+    benchmark::DoNotOptimize(parser.parse(bp, products));
+    products.clear();
+  }
+  state.SetLabel(state.range(0) != 0 ? "robot state frames" : "sub-packages");
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_PrimaryParserParse)->Arg(0)->Arg(1);
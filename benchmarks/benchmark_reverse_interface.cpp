@@ -0,0 +1,166 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/control/reverse_interface.h>
+#include <ur_client_library/control/trajectory_point_interface.h>
+#include <ur_client_library/log.h>
+
+using namespace urcl;
+
+namespace
+{
+// Connects to an interface like the robot's program does and discards everything sent to it, so
+// the benchmarks measure encoding and sending, but never block on a full socket buffer.
+class DrainingClient : public comm::TCPSocket
+{
+public:
+  explicit DrainingClient(const int port) : running_(true)
+  {
+    std::string host = "127.0.0.1";
+    TCPSocket::setup(host, port);
+    timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 100000;
+    TCPSocket::setReceiveTimeout(tv);
+    thread_ = std::thread([this]() {
+      uint8_t buffer[65536];
+      size_t read;
+      while (running_)
+      {
+        TCPSocket::read(buffer, sizeof(buffer), read);
+      }
+    });
+  }
+
+  ~DrainingClient() override
+  {
+    running_ = false;
+    thread_.join();
+    TCPSocket::close();
+  }
+
+private:
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+
+// The server accepts the client asynchronously, so writes fail until it has been registered
+template <typename WriteFunction>
+bool waitForClient(WriteFunction write)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (!write())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+static void BM_ReverseInterfaceWrite(benchmark::State& state)
+{
+  setLogLevel(LogLevel::WARN);
+  control::ReverseInterface reverse_interface(60030, [](bool) {});
+  DrainingClient client(60030);
+  const vector6d_t positions = { 1.1, -2.2, 3.3, -0.4, 0.5, -0.6 };
+  const comm::ControlMode mode = static_cast<comm::ControlMode>(state.range(0));
+  if (!waitForClient([&]() { return reverse_interface.write(&positions, mode); }))
+  {
+    state.SkipWithError("Client did not connect");
+    return;
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(reverse_interface.write(&positions, mode));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReverseInterfaceWrite)
+    ->Arg(static_cast<int>(comm::ControlMode::MODE_SERVOJ))
+    ->Arg(static_cast<int>(comm::ControlMode::MODE_SPEEDJ))
+    ->Arg(static_cast<int>(comm::ControlMode::MODE_IDLE));
+
+static void BM_TrajectoryPointInterfaceWritePoint(benchmark::State& state)
+{
+  setLogLevel(LogLevel::WARN);
+  control::TrajectoryPointInterface trajectory_interface(60031);
+  DrainingClient client(60031);
+  const vector6d_t positions = { 1.1, -2.2, 3.3, -0.4, 0.5, -0.6 };
+  if (!waitForClient([&]() { return trajectory_interface.writeTrajectoryPoint(&positions, 1.4f, 1.05f, 0.0f, 0.0f); }))
+  {
+    state.SkipWithError("Client did not connect");
+    return;
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(trajectory_interface.writeTrajectoryPoint(&positions, 1.4f, 1.05f, 0.0f, 0.0f));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrajectoryPointInterfaceWritePoint);
+
+static void BM_TrajectoryPointInterfaceWritePoints(benchmark::State& state)
+{
+  setLogLevel(LogLevel::WARN);
+  control::TrajectoryPointInterface trajectory_interface(60032);
+  DrainingClient client(60032);
+  std::vector<control::TrajectoryPoint> points(static_cast<size_t>(state.range(0)));
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i].positions = { 0.01 * i, -2.2, 3.3, -0.4, 0.5, -0.6 };
+  }
+  if (!waitForClient([&]() { return trajectory_interface.writeTrajectoryPoints(points.data(), points.size()); }))
+  {
+    state.SkipWithError("Client did not connect");
+    return;
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(trajectory_interface.writeTrajectoryPoints(points.data(), points.size()));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_TrajectoryPointInterfaceWritePoints)->Arg(10)->Arg(100);
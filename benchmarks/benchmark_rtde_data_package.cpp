@@ -0,0 +1,109 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ur_client_library/comm/bin_parser.h>
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/rtde/data_package.h>
+
+using namespace urcl;
+
+namespace
+{
+const char* const RECIPES[] = { "rtde_output_recipe.txt", "exhaustive_rtde_output_recipe.txt" };
+
+std::vector<std::string> readRecipe(const std::string& file_name)
+{
+  const std::string path = std::string(URCL_BENCHMARK_TEST_RESOURCES) + "/" + file_name;
+  std::ifstream file(path);
+  if (!file)
+  {
+    throw UrException("Could not open recipe " + path);
+  }
+  std::vector<std::string> recipe;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (!line.empty())
+    {
+      recipe.push_back(line);
+    }
+  }
+  return recipe;
+}
+
+// A serialized data package of the recipe, without the package header
+std::vector<uint8_t> serializedData(rtde_interface::DataPackage& package)
+{
+  std::vector<uint8_t> buffer(4096);
+  const size_t size = package.serializePackage(buffer.data());
+  return std::vector<uint8_t>(buffer.begin() + 3, buffer.begin() + size);
+}
+}  // namespace
+
+static void BM_DataPackageParseWith(benchmark::State& state)
+{
+  const std::vector<std::string> recipe = readRecipe(RECIPES[state.range(0)]);
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  std::vector<uint8_t> data = serializedData(package);
+
+  for (auto _ : state)
+  {
+    comm::BinParser bp(data.data(), data.size());
+    benchmark::DoNotOptimize(package.parseWith(bp));
+  }
+  state.SetLabel(RECIPES[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_DataPackageParseWith)->DenseRange(0, 1);
+
+static void BM_DataPackageSerializePackage(benchmark::State& state)
+{
+  const std::vector<std::string> recipe = readRecipe(RECIPES[state.range(0)]);
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  std::vector<uint8_t> buffer(4096);
+
+  size_t size = 0;
+  for (auto _ : state)
+  {
+    size = package.serializePackage(buffer.data());
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetLabel(RECIPES[state.range(0)]);
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_DataPackageSerializePackage)->DenseRange(0, 1);
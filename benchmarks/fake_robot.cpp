@@ -0,0 +1,463 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "fake_robot.h"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <ur_client_library/comm/control_mode.h>
+#include <ur_client_library/comm/package_serializer.h>
+#include <ur_client_library/helpers.h>
+#include <ur_client_library/primary/package_header.h>
+#include <ur_client_library/rtde/package_header.h>
+#include <ur_client_library/rtde/rtde_client.h>
+#include <ur_client_library/types.h>
+
+namespace urcl
+{
+namespace benchmarks
+{
+namespace
+{
+constexpr uint8_t OUTPUT_RECIPE_ID = 1;
+constexpr uint8_t INPUT_RECIPE_ID = 2;
+constexpr uint16_t PROTOCOL_VERSION = 2;
+// The driver stops waiting for the robot to boot once the timestamp is above 40 seconds.
+constexpr double START_TIMESTAMP = 1000.0;
+constexpr size_t REVERSE_MESSAGE_SIZE = 8 * sizeof(int32_t);
+
+// Type names used by the robot in the answers to recipe setup requests, in the order of the
+// alternatives of rtde_type_variant.
+const char* const VARIABLE_TYPE_NAMES[] = { "BOOL",     "UINT8",    "UINT32",       "UINT64",        "INT32", "DOUBLE",
+                                            "VECTOR3D", "VECTOR6D", "VECTOR6INT32", "VECTOR6UINT32", "STRING" };
+static_assert(sizeof(VARIABLE_TYPE_NAMES) / sizeof(VARIABLE_TYPE_NAMES[0]) ==
+                  std::variant_size<rtde_interface::rtde_type_variant>::value,
+              "Every RTDE data type needs a name");
+
+std::vector<std::string> splitVariableNames(const std::string& variables)
+{
+  std::vector<std::string> names;
+  std::stringstream ss(variables);
+  std::string name;
+  while (std::getline(ss, name, ','))
+  {
+    names.push_back(name);
+  }
+  return names;
+}
+
+std::string variableTypes(const rtde_interface::CompiledRecipe& recipe)
+{
+  std::string types;
+  for (const auto& field : recipe.getFields())
+  {
+    if (!types.empty())
+    {
+      types += ",";
+    }
+    types += field.known ? VARIABLE_TYPE_NAMES[field.empty_value.index()] : "NOT_FOUND";
+  }
+  return types;
+}
+
+int64_t toNanoseconds(const std::chrono::steady_clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+}  // namespace
+
+FakeRobot::FakeRobot(const double frequency)
+  : period_(static_cast<int64_t>(1e9 / frequency))
+  , rtde_server_(UR_RTDE_PORT, 1)
+  , primary_server_(primary_interface::UR_PRIMARY_PORT, 1)
+  , num_sessions_(0)
+  , running_(true)
+  , measuring_(false)
+  , measured_packages_(0)
+  , send_times_(new std::atomic<int64_t>[MAX_SESSIONS * NUM_SEQUENCE_NUMBERS])
+{
+  for (size_t i = 0; i < MAX_SESSIONS * NUM_SEQUENCE_NUMBERS; ++i)
+  {
+    send_times_[i] = 0;
+  }
+
+  rtde_server_.setConnectCallback([this](const int fd) {
+    std::lock_guard<std::mutex> lock(rtde_mutex_);
+    Session& session = sessions_[fd];
+    session = Session();
+    session.index = num_sessions_++ % MAX_SESSIONS;
+  });
+  rtde_server_.setDisconnectCallback([this](const int fd) {
+    std::lock_guard<std::mutex> lock(rtde_mutex_);
+    sessions_.erase(fd);
+  });
+  // Without TCP_NODELAY, a package sent right after another one would wait for its acknowledgement.
+  rtde_server_.setClientSocketOptions(comm::SocketOptions());
+  rtde_server_.setMessageCallback(
+      [this](const int fd, char* buffer, const int nbytesrecv) { rtdeMessageCallback(fd, buffer, nbytesrecv); });
+  ThreadConfig thread_config;
+  thread_config.name = "fake_rtde";
+  rtde_server_.setThreadConfig(thread_config);
+  rtde_server_.start();
+  // The drivers only need to be able to connect to the primary interface.
+  thread_config.name = "fake_primary";
+  primary_server_.setThreadConfig(thread_config);
+  primary_server_.start();
+
+  stream_thread_ = std::thread(&FakeRobot::streamPackages, this);
+  thread_config.name = "fake_stream";
+  applyThreadConfig(stream_thread_.native_handle(), thread_config);
+}
+
+FakeRobot::~FakeRobot()
+{
+  {
+    std::lock_guard<std::mutex> lock(rtde_mutex_);
+    running_ = false;
+  }
+  streaming_cv_.notify_all();
+  stream_thread_.join();
+  program_connections_.clear();
+}
+
+bool FakeRobot::connectProgram(const int reverse_port, const int trajectory_port, const int script_command_port)
+{
+  bool connected = true;
+  for (const int port : { reverse_port, trajectory_port, script_command_port })
+  {
+    program_connections_.push_back(std::make_unique<ProgramConnection>(*this, port, port == reverse_port));
+    connected = connected && program_connections_.back()->isConnected();
+  }
+  return connected;
+}
+
+void FakeRobot::startMeasurement()
+{
+  measuring_ = false;
+  for (size_t i = 0; i < MAX_SESSIONS * NUM_SEQUENCE_NUMBERS; ++i)
+  {
+    send_times_[i] = 0;
+  }
+  latencies_.reset();
+  measured_packages_ = 0;
+  measuring_ = true;
+}
+
+void FakeRobot::stopMeasurement()
+{
+  measuring_ = false;
+}
+
+void FakeRobot::stopStreaming()
+{
+  std::lock_guard<std::mutex> lock(rtde_mutex_);
+  for (auto& session : sessions_)
+  {
+    session.second.streaming = false;
+  }
+}
+
+void FakeRobot::rtdeMessageCallback(const int fd, char* buffer, const int nbytesrecv)
+{
+  // Only the server's worker thread changes the receive buffers.
+  std::vector<uint8_t>* receive_buffer;
+  {
+    std::lock_guard<std::mutex> lock(rtde_mutex_);
+    receive_buffer = &sessions_[fd].receive_buffer;
+  }
+
+  // Requests may be split up or sent back-to-back, e.g. with a cached handshake.
+  receive_buffer->insert(receive_buffer->end(), buffer, buffer + nbytesrecv);
+  const size_t header_size = sizeof(rtde_interface::PackageHeader::_package_size_type) + sizeof(uint8_t);
+  size_t offset = 0;
+  while (receive_buffer->size() - offset >= header_size)
+  {
+    uint8_t* package = receive_buffer->data() + offset;
+    const size_t package_length = rtde_interface::PackageHeader::getPackageLength(package);
+    if (package_length < header_size)
+    {
+      receive_buffer->clear();
+      return;
+    }
+    if (receive_buffer->size() - offset < package_length)
+    {
+      break;
+    }
+    handleRTDERequest(fd, package[2], package + header_size, package_length - header_size);
+    offset += package_length;
+  }
+  receive_buffer->erase(receive_buffer->begin(), receive_buffer->begin() + offset);
+}
+
+void FakeRobot::handleRTDERequest(const int fd, const uint8_t type, uint8_t* payload, const size_t payload_length)
+{
+  using rtde_interface::PackageType;
+  std::lock_guard<std::mutex> lock(rtde_mutex_);
+  Session& session = sessions_[fd];
+  uint8_t answer[4096];
+  size_t answer_length = 0;
+  switch (static_cast<PackageType>(type))
+  {
+    case PackageType::RTDE_REQUEST_PROTOCOL_VERSION:
+    {
+      uint16_t version = 0;
+      if (payload_length >= sizeof(version))
+      {
+        std::memcpy(&version, payload, sizeof(version));
+        version = be16toh(version);
+      }
+      answer_length = comm::PackageSerializer::serialize(answer, static_cast<uint8_t>(version == PROTOCOL_VERSION));
+      break;
+    }
+    case PackageType::RTDE_GET_URCONTROL_VERSION:
+    {
+      const uint32_t version[] = { 5, 19, 0, 0 };
+      for (const uint32_t part : version)
+      {
+        answer_length += comm::PackageSerializer::serialize(answer + answer_length, part);
+      }
+      break;
+    }
+    case PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS:
+    {
+      // The frequency requested is ignored, packages are sent at the configured rate.
+      if (payload_length < sizeof(double))
+      {
+        return;
+      }
+      const std::string variables(reinterpret_cast<char*>(payload) + sizeof(double), payload_length - sizeof(double));
+      auto recipe = std::make_shared<const rtde_interface::CompiledRecipe>(splitVariableNames(variables));
+      answer_length = comm::PackageSerializer::serialize(answer, OUTPUT_RECIPE_ID);
+      answer_length += comm::PackageSerializer::serialize(answer + answer_length, variableTypes(*recipe));
+
+      session.data_package = std::make_unique<rtde_interface::DataPackage>(recipe, PROTOCOL_VERSION);
+      session.data_package->initEmpty();
+      session.data_package->setRecipeID(OUTPUT_RECIPE_ID);
+      size_t index;
+      session.timestamp_handle = recipe->findIndex("timestamp", index) ? recipe->getFieldHandle<double>("timestamp") :
+                                                                         rtde_interface::FieldHandle<double>();
+      session.actual_q_handle = recipe->findIndex("actual_q", index) ?
+                                    recipe->getFieldHandle<vector6d_t>("actual_q") :
+                                    rtde_interface::FieldHandle<vector6d_t>();
+      break;
+    }
+    case PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS:
+    {
+      const std::string variables(reinterpret_cast<char*>(payload), payload_length);
+      const rtde_interface::CompiledRecipe recipe(splitVariableNames(variables));
+      answer_length = comm::PackageSerializer::serialize(answer, INPUT_RECIPE_ID);
+      answer_length += comm::PackageSerializer::serialize(answer + answer_length, variableTypes(recipe));
+      break;
+    }
+    case PackageType::RTDE_CONTROL_PACKAGE_START:
+      session.streaming = session.data_package != nullptr;
+      // The driver expects the answer to the start request before the first package.
+      session.first_package_time = std::chrono::steady_clock::now() + period_;
+      answer_length = comm::PackageSerializer::serialize(answer, static_cast<uint8_t>(session.streaming));
+      streaming_cv_.notify_all();
+      break;
+    case PackageType::RTDE_CONTROL_PACKAGE_PAUSE:
+      session.streaming = false;
+      answer_length = comm::PackageSerializer::serialize(answer, static_cast<uint8_t>(1));
+      break;
+    default:
+      // Input data packages written by the driver are not used.
+      return;
+  }
+  sendRTDE(fd, static_cast<PackageType>(type), answer, answer_length);
+}
+
+void FakeRobot::sendRTDE(const int fd, const rtde_interface::PackageType type, const uint8_t* payload,
+                         const size_t payload_length)
+{
+  uint8_t buffer[4096];
+  const size_t header_length =
+      rtde_interface::PackageHeader::serializeHeader(buffer, type, static_cast<uint16_t>(payload_length));
+  std::memcpy(buffer + header_length, payload, payload_length);
+  size_t written;
+  rtde_server_.write(fd, buffer, header_length + payload_length, written);
+}
+
+void FakeRobot::streamPackages()
+{
+  uint8_t buffer[16384];
+  uint64_t sequence_number = 0;
+  auto next_send_time = std::chrono::steady_clock::now();
+  auto is_streaming = [this]() {
+    return std::any_of(sessions_.begin(), sessions_.end(), [](const auto& session) { return session.second.streaming; });
+  };
+  std::unique_lock<std::mutex> lock(rtde_mutex_);
+  while (running_)
+  {
+    if (!is_streaming())
+    {
+      streaming_cv_.wait(lock, [this, &is_streaming]() { return is_streaming() || !running_; });
+      next_send_time = std::chrono::steady_clock::now();
+      continue;
+    }
+
+    lock.unlock();
+    std::this_thread::sleep_until(next_send_time);
+    next_send_time += period_;
+    // Packages that are late are not sent in a burst to catch up.
+    const auto now = std::chrono::steady_clock::now();
+    if (next_send_time < now)
+    {
+      next_send_time = now;
+    }
+    lock.lock();
+
+    // All connections get a package with the same sequence number in every cycle.
+    const size_t sequence_index = sequence_number % NUM_SEQUENCE_NUMBERS;
+    const double timestamp = START_TIMESTAMP + sequence_number * std::chrono::duration<double>(period_).count();
+    ++sequence_number;
+    for (auto& entry : sessions_)
+    {
+      Session& session = entry.second;
+      if (!session.streaming || now < session.first_package_time)
+      {
+        continue;
+      }
+      if (session.timestamp_handle.isValid())
+      {
+        session.data_package->setData(session.timestamp_handle, timestamp);
+      }
+      if (session.actual_q_handle.isValid())
+      {
+        // The numbers are sent back as integers in thousandths of a radian.
+        const vector6d_t actual_q = { sequence_index * 1e-3, session.index * 1e-3, 0.0, 0.0, 0.0, 0.0 };
+        session.data_package->setData(session.actual_q_handle, actual_q);
+      }
+      const size_t size = session.data_package->serializePackage(buffer);
+
+      // The send time has to be known before the command for this package can arrive.
+      if (measuring_)
+      {
+        send_times_[session.index * NUM_SEQUENCE_NUMBERS + sequence_index] =
+            toNanoseconds(std::chrono::steady_clock::now());
+        ++measured_packages_;
+      }
+      size_t written;
+      rtde_server_.write(entry.first, buffer, size, written);
+    }
+  }
+}
+
+void FakeRobot::recordCommand(const int32_t encoded_sequence_number, const int32_t encoded_session,
+                              const std::chrono::steady_clock::time_point received)
+{
+  const int64_t sequence_index = std::lround(encoded_sequence_number / 1000.0);
+  const int64_t session_index = std::lround(encoded_session / 1000.0);
+  if (sequence_index < 0 || sequence_index >= static_cast<int64_t>(NUM_SEQUENCE_NUMBERS) || session_index < 0 ||
+      session_index >= static_cast<int64_t>(MAX_SESSIONS))
+  {
+    return;
+  }
+  // Only the first command computed from a package is measured.
+  const int64_t send_time = send_times_[session_index * NUM_SEQUENCE_NUMBERS + sequence_index].exchange(0);
+  if (send_time == 0)
+  {
+    return;
+  }
+  latencies_.record(std::chrono::nanoseconds(toNanoseconds(received) - send_time));
+}
+
+FakeRobot::ProgramConnection::ProgramConnection(FakeRobot& robot, const int port, const bool measure)
+  : robot_(robot), measure_(measure), connected_(false), running_(true)
+{
+  std::string host = "127.0.0.1";
+  connected_ = TCPSocket::setup(host, port, 1);
+  timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = 100000;
+  TCPSocket::setReceiveTimeout(tv);
+  if (connected_)
+  {
+    thread_ = std::thread(&ProgramConnection::run, this);
+    ThreadConfig thread_config;
+    thread_config.name = "fake_program";
+    applyThreadConfig(thread_.native_handle(), thread_config);
+  }
+}
+
+FakeRobot::ProgramConnection::~ProgramConnection()
+{
+  running_ = false;
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+  TCPSocket::close();
+}
+
+void FakeRobot::ProgramConnection::run()
+{
+  uint8_t buffer[64 * REVERSE_MESSAGE_SIZE];
+  size_t filled = 0;
+  while (running_ && getState() == comm::SocketState::Connected)
+  {
+    size_t read;
+    if (!TCPSocket::read(buffer + filled, sizeof(buffer) - filled, read))
+    {
+      continue;
+    }
+    const auto received = std::chrono::steady_clock::now();
+    filled += read;
+    if (!measure_)
+    {
+      filled = 0;
+      continue;
+    }
+
+    // Every message of the full reverse interface protocol consists of eight integers, the
+    // positions of a servoj command being the second to seventh, and the control mode the last.
+    size_t offset = 0;
+    for (; filled - offset >= REVERSE_MESSAGE_SIZE; offset += REVERSE_MESSAGE_SIZE)
+    {
+      int32_t message[8];
+      std::memcpy(message, buffer + offset, REVERSE_MESSAGE_SIZE);
+      if (static_cast<int32_t>(be32toh(message[7])) == toUnderlying(comm::ControlMode::MODE_SERVOJ))
+      {
+        robot_.recordCommand(static_cast<int32_t>(be32toh(message[1])), static_cast<int32_t>(be32toh(message[2])),
+                             received);
+      }
+    }
+    std::memmove(buffer, buffer + offset, filled - offset);
+    filled -= offset;
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace urcl
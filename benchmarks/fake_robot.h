@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_BENCHMARKS_FAKE_ROBOT_H_INCLUDED
+#define UR_CLIENT_LIBRARY_BENCHMARKS_FAKE_ROBOT_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/latency_statistics.h>
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/rtde/data_package.h>
+
+namespace urcl
+{
+namespace benchmarks
+{
+/*!
+ * \brief In-process stand-in for robots, serving the RTDE and primary interfaces on the local host
+ * and connecting back to drivers like the External Control program does.
+ *
+ * Every RTDE connection is served as a robot of its own, so many drivers can be connected at the
+ * same time. The RTDE server answers the handshake for any recipe and, once started, sends data
+ * packages at a fixed rate. Every package carries a sequence number and the number of its
+ * connection in the first two joints of \p actual_q. The reverse interface connections decode these
+ * numbers from the servoj commands received, which gives the time from sending a package to
+ * receiving the command computed from it. Only the full reverse interface protocol is supported,
+ * so the compact protocol must not be enabled in the drivers.
+ *
+ * All threads of the fake robot have names starting with "fake_", so they can be told apart from
+ * the driver's threads.
+ */
+class FakeRobot
+{
+public:
+  /*!
+   * \brief Starts the RTDE and primary servers on their default ports.
+   *
+   * \param frequency Rate at which data packages are sent in Hz
+   *
+   * \throws std::system_error if one of the ports is in use
+   */
+  explicit FakeRobot(const double frequency);
+  ~FakeRobot();
+
+  /*!
+   * \brief Connects to a driver's interfaces like the External Control program. This can be called
+   * once per driver.
+   *
+   * \param reverse_port Port of the driver's reverse interface
+   * \param trajectory_port Port of the driver's trajectory point interface
+   * \param script_command_port Port of the driver's script command interface
+   *
+   * \returns False if one of the connections could not be established
+   */
+  bool connectProgram(const int reverse_port, const int trajectory_port, const int script_command_port);
+
+  /*!
+   * \brief Records the latencies of the packages sent from now on, discarding previous results.
+   */
+  void startMeasurement();
+
+  /*!
+   * \brief Stops marking packages for measurement. Commands for packages sent before are still
+   * recorded when they arrive.
+   */
+  void stopMeasurement();
+
+  /*!
+   * \brief Stops sending data packages on all connections until a driver requests them to be
+   * started again.
+   */
+  void stopStreaming();
+
+  /*!
+   * \brief Time from sending a data package to receiving the first servoj command for it.
+   */
+  const comm::LatencyHistogram& getLatencies() const
+  {
+    return latencies_;
+  }
+
+  /*!
+   * \brief Number of data packages sent while measuring.
+   */
+  uint64_t getNumMeasuredPackages() const
+  {
+    return measured_packages_;
+  }
+
+private:
+  // Connects to one of the driver's interfaces. Everything but servoj commands is discarded.
+  class ProgramConnection : public comm::TCPSocket
+  {
+  public:
+    ProgramConnection(FakeRobot& robot, const int port, const bool measure);
+    ~ProgramConnection() override;
+
+    bool isConnected() const
+    {
+      return connected_;
+    }
+
+  private:
+    void run();
+
+    FakeRobot& robot_;
+    const bool measure_;
+    bool connected_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+  };
+
+  // State of a single RTDE connection
+  struct Session
+  {
+    size_t index = 0;
+    bool streaming = false;
+    std::chrono::steady_clock::time_point first_package_time;
+    std::vector<uint8_t> receive_buffer;
+    std::unique_ptr<rtde_interface::DataPackage> data_package;
+    rtde_interface::FieldHandle<double> timestamp_handle;
+    rtde_interface::FieldHandle<vector6d_t> actual_q_handle;
+  };
+
+  static constexpr size_t NUM_SEQUENCE_NUMBERS = 1 << 12;
+  static constexpr size_t MAX_SESSIONS = 128;
+
+  void rtdeMessageCallback(const int fd, char* buffer, const int nbytesrecv);
+  void handleRTDERequest(const int fd, const uint8_t type, uint8_t* payload, const size_t payload_length);
+  void sendRTDE(const int fd, const rtde_interface::PackageType type, const uint8_t* payload,
+                const size_t payload_length);
+  void streamPackages();
+  void recordCommand(const int32_t encoded_sequence_number, const int32_t encoded_session,
+                     const std::chrono::steady_clock::time_point received);
+
+  const std::chrono::nanoseconds period_;
+  comm::TCPServer rtde_server_;
+  comm::TCPServer primary_server_;
+
+  // Guards the RTDE connections, so data packages and answers to requests are never interleaved.
+  std::mutex rtde_mutex_;
+  std::condition_variable streaming_cv_;
+  std::map<int, Session> sessions_;
+  size_t num_sessions_;
+
+  std::atomic<bool> running_;
+  std::atomic<bool> measuring_;
+  std::atomic<uint64_t> measured_packages_;
+  // Send time of the packages by session and sequence number in nanoseconds, 0 once a command has
+  // been received
+  std::unique_ptr<std::atomic<int64_t>[]> send_times_;
+  comm::LatencyHistogram latencies_;
+  std::vector<std::unique_ptr<ProgramConnection>> program_connections_;
+  std::thread stream_thread_;
+};
+
+}  // namespace benchmarks
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_BENCHMARKS_FAKE_ROBOT_H_INCLUDED
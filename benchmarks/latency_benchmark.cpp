@@ -0,0 +1,276 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <ur_client_library/comm/reactor.h>
+#include <ur_client_library/helpers.h>
+#include <ur_client_library/log.h>
+#include <ur_client_library/ur/ur_driver.h>
+
+#include "fake_robot.h"
+
+using namespace urcl;
+
+namespace
+{
+const std::string SCRIPT_FILE = URCL_BENCHMARK_SCRIPT_FILE;
+const std::string OUTPUT_RECIPE = URCL_BENCHMARK_EXAMPLE_RESOURCES "/rtde_output_recipe.txt";
+const std::string INPUT_RECIPE = URCL_BENCHMARK_EXAMPLE_RESOURCES "/rtde_input_recipe.txt";
+const uint32_t REVERSE_PORT = 50001;
+const uint32_t SCRIPT_SENDER_PORT = 50002;
+const uint32_t TRAJECTORY_PORT = 50003;
+const uint32_t SCRIPT_COMMAND_PORT = 50004;
+// Commands for packages sent right before the end of the measurement are still waited for.
+const std::chrono::milliseconds DRAIN_TIME(100);
+
+struct Options
+{
+  double frequency = 500.0;
+  double duration = 10.0;
+  double warmup = 1.0;
+  bool synchronized = false;
+  bool non_blocking_read = false;
+  bool reactor = false;
+  int fifo_priority = -1;
+  int busy_poll_us = 0;
+};
+
+void printUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "Measures the time from the fake robot sending an RTDE package to receiving the servoj command\n"
+            << "computed from it through the UrDriver. The fake robot uses the ports 30001, 30004 and 50001 to\n"
+            << "50004 on the local host.\n\n"
+            << "  --frequency HZ        Rate of the RTDE packages sent (default 500)\n"
+            << "  --duration S          Length of the measurement (default 10)\n"
+            << "  --warmup S            Time before the measurement starts (default 1)\n"
+            << "  --mode loop|sync      Write commands from an application loop reading the packages, or\n"
+            << "                        on the RTDE thread using synchronized commands (default loop)\n"
+            << "  --non-blocking-read   Poll for packages instead of waiting for them\n"
+            << "  --reactor             Serve the robot's connections from a reactor\n"
+            << "  --fifo-priority P     Run the driver's threads and the loop with SCHED_FIFO priority P\n"
+            << "  --busy-poll US        Busy poll the driver's sockets for US microseconds\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--frequency" && has_value)
+    {
+      options.frequency = std::atof(argv[++i]);
+    }
+    else if (arg == "--duration" && has_value)
+    {
+      options.duration = std::atof(argv[++i]);
+    }
+    else if (arg == "--warmup" && has_value)
+    {
+      options.warmup = std::atof(argv[++i]);
+    }
+    else if (arg == "--mode" && has_value)
+    {
+      const std::string mode = argv[++i];
+      if (mode != "loop" && mode != "sync")
+      {
+        return false;
+      }
+      options.synchronized = mode == "sync";
+    }
+    else if (arg == "--non-blocking-read")
+    {
+      options.non_blocking_read = true;
+    }
+    else if (arg == "--reactor")
+    {
+      options.reactor = true;
+    }
+    else if (arg == "--fifo-priority" && has_value)
+    {
+      options.fifo_priority = std::atoi(argv[++i]);
+    }
+    else if (arg == "--busy-poll" && has_value)
+    {
+      options.busy_poll_us = std::atoi(argv[++i]);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return options.frequency > 0.0 && options.duration > 0.0 && options.warmup >= 0.0;
+}
+
+std::chrono::steady_clock::duration seconds(const double value)
+{
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(value));
+}
+
+// Reads every package like a control loop would. Without synchronized commands, the positions
+// received are sent back as servoj command.
+void runControlLoop(UrDriver& driver, benchmarks::FakeRobot& robot, const Options& options)
+{
+  const auto handle = driver.getRTDEOutputFieldHandle<vector6d_t>("actual_q");
+  const auto measurement_start = std::chrono::steady_clock::now() + seconds(options.warmup);
+  const auto measurement_end = measurement_start + seconds(options.duration);
+  bool measuring = false;
+  vector6d_t command;
+  while (true)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (!measuring && now >= measurement_start && now < measurement_end)
+    {
+      robot.startMeasurement();
+      measuring = true;
+    }
+    else if (measuring && now >= measurement_end)
+    {
+      robot.stopMeasurement();
+      measuring = false;
+    }
+    else if (now >= measurement_end + DRAIN_TIME)
+    {
+      break;
+    }
+
+    std::unique_ptr<rtde_interface::DataPackage> package = driver.getDataPackage();
+    if (!options.synchronized && package != nullptr && package->getData(handle, command))
+    {
+      driver.writeJointCommand(command, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(100));
+    }
+  }
+}
+
+void printResults(const benchmarks::FakeRobot& robot, const Options& options)
+{
+  const comm::LatencyHistogram& latencies = robot.getLatencies();
+  const uint64_t num_packages = robot.getNumMeasuredPackages();
+  const uint64_t num_commands = latencies.getCount();
+  std::cout << "Mode: " << (options.synchronized ? "sync" : "loop") << ", frequency: " << options.frequency
+            << " Hz, duration: " << options.duration << " s\n"
+            << "Packages sent: " << num_packages << ", commands received: " << num_commands
+            << ", packages without command: " << (num_packages > num_commands ? num_packages - num_commands : 0)
+            << "\n"
+            << "Read-to-command latency: " << latencies.toString() << "\n"
+            << "Percentiles [us]: p50 " << latencies.getPercentile(50).count() << ", p90 "
+            << latencies.getPercentile(90).count() << ", p99 " << latencies.getPercentile(99).count() << ", p99.9 "
+            << latencies.getPercentile(99.9).count() << ", max " << latencies.getMax().count() << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+  setLogLevel(LogLevel::WARN);
+
+  benchmarks::FakeRobot robot(options.frequency);
+  UrDriver driver("127.0.0.1", SCRIPT_FILE, OUTPUT_RECIPE, INPUT_RECIPE, [](bool) {}, false,
+                  std::unique_ptr<ToolCommSetup>(), REVERSE_PORT, SCRIPT_SENDER_PORT, 2000, 0.03,
+                  options.non_blocking_read, "", TRAJECTORY_PORT, SCRIPT_COMMAND_PORT);
+
+  ThreadConfig thread_config;
+  if (options.fifo_priority >= 0)
+  {
+    thread_config.policy = SCHED_FIFO;
+    thread_config.priority = options.fifo_priority;
+    driver.setThreadConfig(thread_config);
+  }
+  if (options.busy_poll_us > 0)
+  {
+    comm::SocketOptions socket_options;
+    socket_options.busy_poll_us = options.busy_poll_us;
+    driver.setSocketOptions(socket_options);
+  }
+  std::shared_ptr<comm::Reactor> reactor;
+  if (options.reactor)
+  {
+    reactor = std::make_shared<comm::Reactor>();
+    driver.setReactor(reactor);
+  }
+  if (options.synchronized)
+  {
+    const auto handle = driver.getRTDEOutputFieldHandle<vector6d_t>("actual_q");
+    driver.enableRTDESynchronizedCommands(
+        comm::ControlMode::MODE_SERVOJ,
+        [handle](const rtde_interface::DataPackage& package, vector6d_t& command) {
+          return package.getData(handle, command);
+        },
+        RobotReceiveTimeout::millisec(100));
+  }
+
+  if (!robot.connectProgram(REVERSE_PORT, TRAJECTORY_PORT, SCRIPT_COMMAND_PORT))
+  {
+    std::cerr << "The fake robot could not connect to the driver" << std::endl;
+    return 1;
+  }
+  const auto connect_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (!driver.isReverseInterfaceConnected())
+  {
+    if (std::chrono::steady_clock::now() > connect_deadline)
+    {
+      std::cerr << "The driver did not accept the fake robot's connection" << std::endl;
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  driver.startRTDECommunication();
+  if (options.fifo_priority >= 0)
+  {
+    applyThreadConfig(pthread_self(), thread_config);
+  }
+  runControlLoop(driver, robot, options);
+
+  printResults(robot, options);
+
+  // The driver pauses the RTDE communication when it is destroyed. The answer has to fit into the
+  // queue of packages received, which isn't read anymore.
+  robot.stopStreaming();
+  while (driver.getDataPackage() != nullptr)
+  {
+  }
+  return 0;
+}
@@ -0,0 +1,383 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+
+#include <ur_client_library/comm/reactor.h>
+#include <ur_client_library/helpers.h>
+#include <ur_client_library/log.h>
+#include <ur_client_library/ur/ur_driver.h>
+
+#include "fake_robot.h"
+
+using namespace urcl;
+
+namespace
+{
+const std::string SCRIPT_FILE = URCL_BENCHMARK_SCRIPT_FILE;
+const std::string OUTPUT_RECIPE = URCL_BENCHMARK_EXAMPLE_RESOURCES "/rtde_output_recipe.txt";
+const std::string INPUT_RECIPE = URCL_BENCHMARK_EXAMPLE_RESOURCES "/rtde_input_recipe.txt";
+// Every driver uses five consecutive ports starting here for the interfaces the robot connects to.
+const uint32_t FIRST_PORT = 50001;
+const uint32_t PORTS_PER_DRIVER = 5;
+const std::chrono::milliseconds DRAIN_TIME(100);
+const char* const APPLICATION_THREAD_NAME = "app";
+
+struct Options
+{
+  std::vector<size_t> robots = { 1, 2, 4, 8, 16, 32 };
+  double frequency = 500.0;
+  double duration = 5.0;
+  double warmup = 1.0;
+  bool synchronized = false;
+  bool reactor = false;
+};
+
+void printUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "Runs an increasing number of UrDriver instances against fake robots in this process and reports\n"
+            << "the resources used per robot and the read-to-command latency. The fake robots use the ports 30001\n"
+            << "and 30004, the drivers use 5 ports per driver starting at 50001 on the local host.\n\n"
+            << "  --robots N,M,...      Numbers of robots to run (default 1,2,4,8,16,32)\n"
+            << "  --frequency HZ        Rate of the RTDE packages sent to every driver (default 500)\n"
+            << "  --duration S          Length of the measurement per number of robots (default 5)\n"
+            << "  --warmup S            Time before the measurement starts (default 1)\n"
+            << "  --mode loop|sync      Write commands from an application thread per driver, or on the RTDE\n"
+            << "                        thread using synchronized commands (default loop)\n"
+            << "  --reactor             Serve all robots' connections from one shared reactor\n";
+}
+
+bool parseRobots(const std::string& list, std::vector<size_t>& robots)
+{
+  robots.clear();
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ','))
+  {
+    const long value = std::atol(item.c_str());
+    if (value <= 0)
+    {
+      return false;
+    }
+    robots.push_back(static_cast<size_t>(value));
+  }
+  return !robots.empty();
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--robots" && has_value)
+    {
+      if (!parseRobots(argv[++i], options.robots))
+      {
+        return false;
+      }
+    }
+    else if (arg == "--frequency" && has_value)
+    {
+      options.frequency = std::atof(argv[++i]);
+    }
+    else if (arg == "--duration" && has_value)
+    {
+      options.duration = std::atof(argv[++i]);
+    }
+    else if (arg == "--warmup" && has_value)
+    {
+      options.warmup = std::atof(argv[++i]);
+    }
+    else if (arg == "--mode" && has_value)
+    {
+      const std::string mode = argv[++i];
+      if (mode != "loop" && mode != "sync")
+      {
+        return false;
+      }
+      options.synchronized = mode == "sync";
+    }
+    else if (arg == "--reactor")
+    {
+      options.reactor = true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return options.frequency > 0.0 && options.duration > 0.0 && options.warmup >= 0.0;
+}
+
+std::chrono::steady_clock::duration seconds(const double value)
+{
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(value));
+}
+
+// Resources used by a thread of this process since it has been started
+struct ThreadSample
+{
+  std::string name;
+  uint64_t cpu_time_ns = 0;
+  uint64_t context_switches = 0;
+};
+
+std::map<int, ThreadSample> sampleThreads()
+{
+  std::map<int, ThreadSample> samples;
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr)
+  {
+    return samples;
+  }
+  while (dirent* entry = readdir(dir))
+  {
+    const int tid = std::atoi(entry->d_name);
+    if (tid <= 0)
+    {
+      continue;
+    }
+    const std::string path = std::string("/proc/self/task/") + entry->d_name;
+    ThreadSample sample;
+    std::ifstream(path + "/comm") >> sample.name;
+    // The first field is the time spent on the CPU in nanoseconds.
+    std::ifstream(path + "/schedstat") >> sample.cpu_time_ns;
+    std::ifstream status(path + "/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+      if (line.rfind("voluntary_ctxt_switches:", 0) == 0 || line.rfind("nonvoluntary_ctxt_switches:", 0) == 0)
+      {
+        sample.context_switches += std::strtoull(line.substr(line.find(':') + 1).c_str(), nullptr, 10);
+      }
+    }
+    samples[tid] = sample;
+  }
+  closedir(dir);
+  return samples;
+}
+
+// Thread resources used while measuring, split by the owner of the threads
+struct Usage
+{
+  size_t driver_threads = 0;
+  double driver_cpu_seconds = 0.0;
+  double application_cpu_seconds = 0.0;
+  uint64_t context_switches = 0;
+};
+
+Usage computeUsage(const std::map<int, ThreadSample>& before, const std::map<int, ThreadSample>& after)
+{
+  Usage usage;
+  const int main_tid = getpid();
+  for (const auto& entry : after)
+  {
+    const ThreadSample& sample = entry.second;
+    // The fake robots' threads and the main thread, which only waits, are not counted.
+    if (entry.first == main_tid || sample.name.rfind("fake_", 0) == 0)
+    {
+      continue;
+    }
+    ThreadSample start;
+    auto it = before.find(entry.first);
+    if (it != before.end())
+    {
+      start = it->second;
+    }
+    const double cpu_seconds = (sample.cpu_time_ns - start.cpu_time_ns) * 1e-9;
+    usage.context_switches += sample.context_switches - start.context_switches;
+    if (sample.name == APPLICATION_THREAD_NAME)
+    {
+      usage.application_cpu_seconds += cpu_seconds;
+    }
+    else
+    {
+      usage.driver_cpu_seconds += cpu_seconds;
+      ++usage.driver_threads;
+    }
+  }
+  return usage;
+}
+
+// Reads every package of a driver like a control loop would. Without synchronized commands, the
+// positions received are sent back as servoj command.
+void runApplication(UrDriver& driver, const bool synchronized, const std::atomic<bool>& running)
+{
+  const auto handle = driver.getRTDEOutputFieldHandle<vector6d_t>("actual_q");
+  vector6d_t command;
+  while (running)
+  {
+    std::unique_ptr<rtde_interface::DataPackage> package = driver.getDataPackage();
+    if (!synchronized && package != nullptr && package->getData(handle, command))
+    {
+      driver.writeJointCommand(command, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(100));
+    }
+  }
+}
+
+bool runWithRobots(const size_t num_robots, const Options& options)
+{
+  benchmarks::FakeRobot robot(options.frequency);
+  std::shared_ptr<comm::Reactor> reactor = options.reactor ? std::make_shared<comm::Reactor>() : nullptr;
+  std::vector<std::unique_ptr<UrDriver>> drivers;
+  for (size_t i = 0; i < num_robots; ++i)
+  {
+    const uint32_t port = FIRST_PORT + static_cast<uint32_t>(i) * PORTS_PER_DRIVER;
+    drivers.push_back(std::make_unique<UrDriver>("127.0.0.1", SCRIPT_FILE, OUTPUT_RECIPE, INPUT_RECIPE, [](bool) {},
+                                                 false, std::unique_ptr<ToolCommSetup>(), port, port + 1, 2000, 0.03,
+                                                 false, "", port + 2, port + 3));
+    UrDriver& driver = *drivers.back();
+    if (reactor != nullptr)
+    {
+      driver.setReactor(reactor);
+    }
+    if (options.synchronized)
+    {
+      const auto handle = driver.getRTDEOutputFieldHandle<vector6d_t>("actual_q");
+      driver.enableRTDESynchronizedCommands(
+          comm::ControlMode::MODE_SERVOJ,
+          [handle](const rtde_interface::DataPackage& package, vector6d_t& command) {
+            return package.getData(handle, command);
+          },
+          RobotReceiveTimeout::millisec(100));
+    }
+    if (!robot.connectProgram(port, port + 2, port + 3))
+    {
+      std::cerr << "The fake robot could not connect to driver " << i << std::endl;
+      return false;
+    }
+    const auto connect_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!driver.isReverseInterfaceConnected())
+    {
+      if (std::chrono::steady_clock::now() > connect_deadline)
+      {
+        std::cerr << "Driver " << i << " did not accept the fake robot's connection" << std::endl;
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  std::atomic<bool> running(true);
+  std::vector<std::thread> applications;
+  ThreadConfig application_config;
+  application_config.name = APPLICATION_THREAD_NAME;
+  for (auto& driver : drivers)
+  {
+    driver->startRTDECommunication();
+    applications.emplace_back(runApplication, std::ref(*driver), options.synchronized, std::cref(running));
+    applyThreadConfig(applications.back().native_handle(), application_config);
+  }
+
+  std::this_thread::sleep_for(seconds(options.warmup));
+  const std::map<int, ThreadSample> before = sampleThreads();
+  const auto measurement_start = std::chrono::steady_clock::now();
+  robot.startMeasurement();
+  std::this_thread::sleep_for(seconds(options.duration));
+  robot.stopMeasurement();
+  const std::map<int, ThreadSample> after = sampleThreads();
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - measurement_start).count();
+  std::this_thread::sleep_for(DRAIN_TIME);
+
+  const Usage usage = computeUsage(before, after);
+  const comm::LatencyHistogram& latencies = robot.getLatencies();
+  const uint64_t num_packages = robot.getNumMeasuredPackages();
+  const uint64_t num_lost = num_packages > latencies.getCount() ? num_packages - latencies.getCount() : 0;
+  const double robots = static_cast<double>(num_robots);
+  std::cout << std::setw(6) << num_robots << std::setw(9) << usage.driver_threads << std::setw(9) << std::fixed
+            << std::setprecision(1) << usage.driver_threads / robots << std::setw(11)
+            << 100.0 * usage.driver_cpu_seconds / elapsed / robots << std::setw(11)
+            << 100.0 * usage.application_cpu_seconds / elapsed / robots << std::setw(13) << std::setprecision(0)
+            << usage.context_switches / elapsed / robots << std::setw(9) << latencies.getPercentile(50).count()
+            << std::setw(9) << latencies.getPercentile(99).count() << std::setw(9)
+            << latencies.getPercentile(99.9).count() << std::setw(9) << latencies.getMax().count() << std::setw(9)
+            << std::setprecision(2) << (num_packages > 0 ? 100.0 * num_lost / num_packages : 0.0) << std::endl;
+
+  running = false;
+  for (auto& application : applications)
+  {
+    application.join();
+  }
+  // The drivers pause the RTDE communication when they are destroyed. The answer has to fit into the
+  // queue of packages received, which isn't read anymore.
+  robot.stopStreaming();
+  for (auto& driver : drivers)
+  {
+    while (driver->getDataPackage() != nullptr)
+    {
+    }
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+  setLogLevel(LogLevel::WARN);
+
+  std::cout << "Mode: " << (options.synchronized ? "sync" : "loop") << (options.reactor ? " with reactor" : "")
+            << ", frequency: " << options.frequency << " Hz, duration: " << options.duration << " s per run\n"
+            << "CPU and context switches are per robot, latencies in microseconds\n"
+            << "robots  threads  per bot  driver CPU%  app CPU%  ctx switch/s      p50      p99    p99.9      max"
+               "   lost %"
+            << std::endl;
+  for (const size_t num_robots : options.robots)
+  {
+    if (!runWithRobots(num_robots, options))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
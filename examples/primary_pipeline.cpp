@@ -30,8 +30,32 @@
 #include <ur_client_library/comm/shell_consumer.h>
 #include <ur_client_library/primary/primary_parser.h>
 
+#include <algorithm>
+
 using namespace urcl;
 
+// Logs a few diagnostic values of every robot state. The views point directly into the received
+// data, so values are read while parsing, without creating package objects for them.
+class DiagnosticsConsumer : public primary_interface::RobotStateViewConsumer
+{
+public:
+  void consume(const primary_interface::RobotModeDataView& view) override
+  {
+    URCL_LOG_INFO("Robot mode: %d, speed scaling: %.2f", view.getRobotMode(), view.getSpeedScaling());
+  }
+
+  void consume(const primary_interface::JointDataView& view) override
+  {
+    const vector6d_t temperatures = view.getMotorTemperatures();
+    URCL_LOG_INFO("Hottest joint motor: %.1f degrees", *std::max_element(temperatures.begin(), temperatures.end()));
+  }
+
+  void consume(const primary_interface::MasterboardDataView& view) override
+  {
+    URCL_LOG_INFO("Safety mode: %d, robot current: %.2f A", view.getSafetyMode(), view.getRobotCurrent());
+  }
+};
+
 // In a real-world example it would be better to get those values from command line parameters / a better configuration
 // system such as Boost.Program_options
 const std::string DEFAULT_ROBOT_IP = "192.168.56.101";
@@ -58,8 +82,11 @@ int main(int argc, char* argv[])
   // First of all, we need a stream that connects to the robot's primary interface
   comm::URStream<primary_interface::PrimaryPackage> primary_stream(robot_ip, urcl::primary_interface::UR_PRIMARY_PORT);
 
-  // This will parse the primary packages
+  // This will parse the primary packages. Robot state data is handed to the diagnostics consumer
+  // directly while parsing.
   primary_interface::PrimaryParser parser;
+  DiagnosticsConsumer diagnostics;
+  parser.setRobotStateViewConsumer(&diagnostics);
 
   // The producer needs both, the stream and the parser to fully work
   comm::URProducer<primary_interface::PrimaryPackage> prod(primary_stream, parser);
@@ -79,7 +106,8 @@ int main(int argc, char* argv[])
   pipeline.run();
 
   // Package contents will be printed while not being interrupted
-  // Note: Packages for which the parsing isn't implemented, will only get their raw bytes printed.
+  // Note: Robot messages for which the parsing isn't implemented, will only get their raw bytes
+  // printed.
   do
   {
     std::this_thread::sleep_for(std::chrono::seconds(second_to_run));
@@ -81,8 +81,10 @@ int main(int argc, char* argv[])
   // First of all, we need a stream that connects to the robot
   comm::URStream<primary_interface::PrimaryPackage> primary_stream(robot_ip, urcl::primary_interface::UR_PRIMARY_PORT);
 
-  // This will parse the primary packages
+  // This will parse the primary packages. Only the kinematics info is needed for the calibration,
+  // so all other robot state sub-packages are skipped.
   primary_interface::PrimaryParser parser;
+  parser.setRobotStateSubscription({ primary_interface::RobotStateType::KINEMATICS_INFO });
 
   // The producer needs both, the stream and the parser to fully work
   comm::URProducer<primary_interface::PrimaryPackage> prod(primary_stream, parser);
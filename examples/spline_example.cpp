@@ -33,6 +33,7 @@
 #include <ur_client_library/control/trajectory_point_interface.h>
 #include <ur_client_library/ur/dashboard_client.h>
 #include <ur_client_library/ur/ur_driver.h>
+#include <ur_client_library/joint_space.h>
 #include <ur_client_library/types.h>
 
 #include <iostream>
@@ -269,7 +270,8 @@ int main(int argc, char* argv[])
     }
   }
 
-  URCL_LOG_INFO("CUBIC Movement done");
+  URCL_LOG_INFO("CUBIC Movement done, final joint error: %f rad",
+                joint_space::maxAbsDifference(p.back(), g_joint_positions));
 
   // QUINTIC
   sendTrajectory(p, v, a, time, true);
@@ -300,7 +302,8 @@ int main(int argc, char* argv[])
     }
   }
 
-  URCL_LOG_INFO("QUINTIC Movement done");
+  URCL_LOG_INFO("QUINTIC Movement done, final joint error: %f rad",
+                joint_space::maxAbsDifference(p.back(), g_joint_positions));
 
   ret = g_my_driver->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_NOOP);
   if (!ret)
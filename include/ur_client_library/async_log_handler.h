@@ -0,0 +1,160 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+/*!
+ * \brief LogHandler object that hands log messages to another handler on a background thread.
+ *
+ * Every logging thread writes its messages into a ring buffer of its own without locking or
+ * allocating memory, so logging from time-critical threads doesn't block on the output of the
+ * wrapped handler, e.g. on stdout. The ring of a thread is allocated when the thread logs for the
+ * first time, which can be done ahead of time using registerCurrentThread(). A background thread
+ * drains all rings in regular intervals and passes the messages drained together to the wrapped
+ * handler in the order they were logged. Messages logged while the ring of a thread is full are dropped and
+ * counted, messages longer than MAX_MESSAGE_LENGTH are truncated.
+ *
+ * The file name passed to log() isn't copied, so it has to stay valid. This is the case for the
+ * file names passed by the logging macros.
+ */
+class AsyncLogHandler : public LogHandler
+{
+public:
+  static constexpr size_t MAX_MESSAGE_LENGTH = 511;
+  static constexpr size_t DEFAULT_RING_CAPACITY = 256;
+
+  /*!
+   * \brief Creates an AsyncLogHandler and starts its background thread.
+   *
+   * \param handler The handler messages are passed to on the background thread
+   * \param ring_capacity Number of messages each logging thread can buffer, rounded up to a power
+   * of two
+   * \param flush_interval Time between draining the rings
+   */
+  explicit AsyncLogHandler(std::unique_ptr<LogHandler> handler, const size_t ring_capacity = DEFAULT_RING_CAPACITY,
+                           const std::chrono::milliseconds flush_interval = std::chrono::milliseconds(10));
+
+  /*!
+   * \brief Passes all remaining messages to the wrapped handler and stops the background thread.
+   */
+  ~AsyncLogHandler() override;
+
+  /*!
+   * \brief Buffers a log message of the calling thread.
+   *
+   * \param file The log message comes from this file
+   * \param line The log message comes from this line
+   * \param loglevel Indicates the severity of the log message
+   * \param log Log message
+   */
+  void log(const char* file, int line, LogLevel loglevel, const char* log) override;
+
+  /*!
+   * \brief Allocates the ring of the calling thread, so it doesn't have to be allocated when the
+   * thread logs for the first time.
+   */
+  void registerCurrentThread();
+
+  /*!
+   * \brief Passes all messages buffered so far to the wrapped handler.
+   */
+  void flush();
+
+  /*!
+   * \brief Getter for the number of messages dropped, because the ring of the logging thread was
+   * full.
+   */
+  uint64_t getDroppedCount() const
+  {
+    return dropped_count_;
+  }
+
+private:
+  struct Record
+  {
+    uint64_t sequence;
+    const char* file;
+    int line;
+    LogLevel level;
+    char text[MAX_MESSAGE_LENGTH + 1];
+  };
+
+  // Ring with a single producer, the logging thread, and a single consumer, the background thread
+  struct Ring
+  {
+    explicit Ring(const size_t capacity) : records(capacity), mask(capacity - 1), head(0), tail(0)
+    {
+    }
+
+    std::vector<Record> records;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;  // Next record to write, only written by the producer
+    alignas(64) std::atomic<size_t> tail;  // Next record to read, only written by the consumer
+  };
+
+  Ring& getThreadRing();
+  void run();
+  void drain();
+
+  std::unique_ptr<LogHandler> handler_;
+  size_t ring_capacity_;
+  std::chrono::milliseconds flush_interval_;
+  // Tells the rings of different handlers apart in the threads' ring caches
+  uint64_t id_;
+  std::atomic<uint64_t> next_sequence_;
+  std::atomic<uint64_t> dropped_count_;
+  uint64_t reported_dropped_count_;
+
+  std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  // Serializes draining between the background thread and flush()
+  std::mutex drain_mutex_;
+
+  std::mutex run_mutex_;
+  std::condition_variable run_cv_;
+  bool keep_running_;
+  std::thread thread_;
+};
+
+}  // namespace urcl
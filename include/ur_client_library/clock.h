@@ -0,0 +1,215 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_CLOCK_H_INCLUDED
+#define UR_CLIENT_LIBRARY_CLOCK_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace urcl
+{
+/*!
+ * \brief Source of time for the library's timeouts, retry periods and reconnection delays.
+ *
+ * The library uses the clock registered using registerClock(), so tests and simulators can
+ * accelerate or control the time the library waits. Time points are expressed as
+ * std::chrono::steady_clock time points, so they can be mixed with the rest of the library's
+ * timestamps.
+ */
+class Clock
+{
+public:
+  using time_point = std::chrono::steady_clock::time_point;
+  using duration = std::chrono::steady_clock::duration;
+
+  virtual ~Clock() = default;
+
+  /*!
+   * \brief Getter for the current time.
+   */
+  virtual time_point now() const = 0;
+
+  /*!
+   * \brief Blocks the calling thread until the given time has been reached.
+   *
+   * \param deadline Time to wait for
+   */
+  virtual void sleepUntil(const time_point deadline) = 0;
+
+  /*!
+   * \brief Blocks the calling thread for the given time.
+   *
+   * \param period Time to wait
+   */
+  void sleepFor(const duration period)
+  {
+    sleepUntil(now() + period);
+  }
+
+  /*!
+   * \brief Waits on a condition variable until a predicate holds or the given time has been
+   * reached.
+   *
+   * \param cv The condition variable notified when the predicate might hold
+   * \param lock Lock of the mutex protecting the predicate's state, has to be locked
+   * \param deadline Time to wait for at most
+   * \param predicate Condition to wait for
+   *
+   * \returns The result of the predicate
+   */
+  template <typename Predicate>
+  bool waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, const time_point deadline,
+                 Predicate predicate)
+  {
+    while (!predicate())
+    {
+      const duration remaining = realTimeUntil(deadline);
+      if (remaining <= duration::zero())
+      {
+        return predicate();
+      }
+      cv.wait_for(lock, remaining);
+    }
+    return true;
+  }
+
+protected:
+  /*!
+   * \brief Real time to block for before checking the clock against a deadline again.
+   *
+   * \param deadline Time waited for
+   *
+   * \returns A non-positive duration once the deadline has been reached
+   */
+  virtual duration realTimeUntil(const time_point deadline) const = 0;
+};
+
+/*!
+ * \brief The default clock, using std::chrono::steady_clock.
+ */
+class SteadyClock : public Clock
+{
+public:
+  time_point now() const override
+  {
+    return std::chrono::steady_clock::now();
+  }
+
+  void sleepUntil(const time_point deadline) override;
+
+protected:
+  duration realTimeUntil(const time_point deadline) const override
+  {
+    return deadline - now();
+  }
+};
+
+/*!
+ * \brief Clock for tests and simulations, running at a multiple of real time and allowing to skip
+ * time.
+ *
+ * The simulated time starts at the real time of creating the clock. It advances time_scale times
+ * as fast as real time, e.g. a timeout of 1 s expires after 10 ms of real time with a scale of
+ * 100. advance() skips time instantly, waking up all threads sleeping on this clock. Threads
+ * waiting on other condition variables using waitUntil() notice skipped time within
+ * MAX_WAIT_SLICE of real time.
+ */
+class SimulatedClock : public Clock
+{
+public:
+  //! Longest real time a waitUntil() call blocks without checking the simulated time
+  static constexpr std::chrono::milliseconds MAX_WAIT_SLICE{ 10 };
+
+  /*!
+   * \brief Creates a new SimulatedClock object.
+   *
+   * \param time_scale Speed of the simulated time relative to real time. 0 stops the time, so it
+   * only advances using advance().
+   *
+   * \throws UrException if the time scale is negative
+   */
+  explicit SimulatedClock(const double time_scale = 1.0);
+
+  time_point now() const override;
+
+  void sleepUntil(const time_point deadline) override;
+
+  /*!
+   * \brief Skips time, waking up threads whose deadlines have been reached.
+   *
+   * \param period Time to skip
+   */
+  void advance(const duration period);
+
+  /*!
+   * \brief Getter for the speed of the simulated time relative to real time.
+   */
+  double getTimeScale() const
+  {
+    return time_scale_;
+  }
+
+protected:
+  duration realTimeUntil(const time_point deadline) const override;
+
+private:
+  time_point nowLocked() const;
+
+  const double time_scale_;
+  const std::chrono::steady_clock::time_point real_start_;
+  mutable std::mutex mutex_;
+  std::condition_variable advanced_cv_;
+  duration skipped_;
+};
+
+/*!
+ * \brief Registers the clock the library uses from now on. It should be registered before creating
+ * any of the library's components, as waits already running keep the clock they started with.
+ *
+ * \param clock The clock to use, nullptr to use a SteadyClock
+ */
+void registerClock(std::shared_ptr<Clock> clock);
+
+/*!
+ * \brief Restores the default SteadyClock.
+ */
+void unregisterClock();
+
+/*!
+ * \brief Getter for the clock used by the library.
+ */
+std::shared_ptr<Clock> getClock();
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_CLOCK_H_INCLUDED
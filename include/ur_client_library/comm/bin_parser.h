@@ -23,12 +23,15 @@
 #include <assert.h>
 #include <endian.h>
 #include <inttypes.h>
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cstddef>
 #include <cstring>
 #include <string>
 #include <memory>
+#include <type_traits>
+#include "ur_client_library/comm/byte_swap.h"
 #include "ur_client_library/log.h"
 #include "ur_client_library/types.h"
 #include "ur_client_library/exceptions.h"
@@ -37,15 +40,41 @@ namespace urcl
 {
 namespace comm
 {
+/*!
+ * \brief Result of parsing a buffer with a BinParser.
+ */
+enum class ParseStatus
+{
+  OK,        ///< All reads so far were inside the buffer
+  TRUNCATED  ///< A read or size check went past the end of the buffer
+};
+
 /*!
  * \brief The BinParser class handles a byte buffer and functionality to iteratively parse the
  * content.
+ *
+ * Reading past the end of the buffer throws an UrException by default. With ErrorMode::STATUS the
+ * parser is poisoned instead: its status is set to ParseStatus::TRUNCATED, the position moves to
+ * the end of the buffer and all further reads return zeroed values. A malformed frame therefore
+ * costs at most one check per read and can be detected with failed() once it has been parsed.
  */
 class BinParser
 {
+public:
+  /*!
+   * \brief How a BinParser reports reads past the end of its buffer.
+   */
+  enum class ErrorMode
+  {
+    THROW,  ///< Throw an UrException
+    STATUS  ///< Poison the parser and report the error through getStatus()
+  };
+
 private:
   uint8_t *buf_pos_, *buf_end_;
   BinParser& parent_;
+  ErrorMode mode_;
+  ParseStatus status_;
 
   // Decode from network encoding (big endian) to host encoding
   template <typename T>
@@ -78,36 +107,106 @@ private:
     return be64toh(val);
   }
 
+  void fail()
+  {
+    status_ = ParseStatus::TRUNCATED;
+    buf_pos_ = buf_end_;
+    if (mode_ == ErrorMode::THROW)
+      throw UrException("Could not parse received package. This can occur if the driver is started while the robot is "
+                        "booting - please restart the driver once the robot has finished booting. "
+                        "If the problem persists after the robot has booted, please contact the package maintainer.");
+  }
+
+  // Returns false if the bytes aren't available, after poisoning the parser in ErrorMode::STATUS
+  bool ensureRemaining(const size_t bytes)
+  {
+    if (status_ == ParseStatus::OK && bytes <= remaining())
+    {
+      return true;
+    }
+    fail();
+    return false;
+  }
+
+  // Decodes all elements of an array of 4 or 8 byte numbers at once
+  template <typename T, size_t N>
+  void parseBulk(std::array<T, N>& array)
+  {
+    if (!ensureRemaining(sizeof(T) * N))
+    {
+      array.fill(T());
+      return;
+    }
+    swapBytes<T>(reinterpret_cast<uint8_t*>(array.data()), buf_pos_, N);
+    buf_pos_ += sizeof(T) * N;
+  }
+
 public:
   /*!
    * \brief Creates a new BinParser object from a given buffer.
    *
    * \param buffer The byte buffer to parse
    * \param buf_len Size of the buffer
+   * \param mode How reads past the end of the buffer are reported
    */
-  BinParser(uint8_t* buffer, size_t buf_len) : buf_pos_(buffer), buf_end_(buffer + buf_len), parent_(*this)
+  BinParser(uint8_t* buffer, size_t buf_len, const ErrorMode mode = ErrorMode::THROW)
+    : buf_pos_(buffer), buf_end_(buffer + buf_len), parent_(*this), mode_(mode), status_(ParseStatus::OK)
   {
     assert(buf_pos_ <= buf_end_);
   }
 
   /*!
-   * \brief Creates a new BinParser object for part of a buffer from a parent BinParser.
+   * \brief Creates a new BinParser object for part of a buffer from a parent BinParser. The error
+   * mode and status are taken from the parent.
+   *
+   * If the parent holds less than \p sub_len bytes, the sub-parser is limited to the parent's
+   * buffer and fails like a read past its end.
    *
    * \param parent Parent BinParser
    * \param sub_len Size of the sub-buffer to parse
    */
   BinParser(BinParser& parent, size_t sub_len)
-    : buf_pos_(parent.buf_pos_), buf_end_(parent.buf_pos_ + sub_len), parent_(parent)
+    : buf_pos_(parent.buf_pos_)
+    , buf_end_(parent.buf_pos_ + std::min(sub_len, parent.remaining()))
+    , parent_(parent)
+    , mode_(parent.mode_)
+    , status_(parent.status_)
   {
-    assert(buf_pos_ <= buf_end_);
+    if (sub_len > parent.remaining())
+    {
+      fail();
+    }
   }
 
   /*!
-   * \brief Deconstructor for the BinParser.
+   * \brief Deconstructor for the BinParser. Moves the parent's position and passes a failure on
+   * to the parent.
    */
   ~BinParser()
   {
     parent_.buf_pos_ = buf_pos_;
+    if (status_ != ParseStatus::OK)
+    {
+      parent_.status_ = status_;
+      parent_.buf_pos_ = parent_.buf_end_;
+    }
+  }
+
+  /*!
+   * \brief Getter for the parser's status.
+   */
+  ParseStatus getStatus() const
+  {
+    return status_;
+  }
+
+  /*!
+   * \brief Checks whether a read went past the end of the buffer. This can only happen in
+   * ErrorMode::STATUS, otherwise an exception is thrown.
+   */
+  bool failed() const
+  {
+    return status_ != ParseStatus::OK;
   }
 
   /*!
@@ -120,10 +219,10 @@ public:
   template <typename T>
   T peek()
   {
-    if (buf_pos_ + sizeof(T) > buf_end_)
-      throw UrException("Could not parse received package. This can occur if the driver is started while the robot is "
-                        "booting - please restart the driver once the robot has finished booting. "
-                        "If the problem persists after the robot has booted, please contact the package maintainer.");
+    if (!ensureRemaining(sizeof(T)))
+    {
+      return T();
+    }
     T val;
     std::memcpy(&val, buf_pos_, sizeof(T));
     return decode(val);
@@ -139,7 +238,10 @@ public:
   void parse(T& val)
   {
     val = peek<T>();
-    buf_pos_ += sizeof(T);
+    if (status_ == ParseStatus::OK)
+    {
+      buf_pos_ += sizeof(T);
+    }
   }
 
   /*!
@@ -188,10 +290,7 @@ public:
    */
   void parse(vector3d_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseBulk(val);
   }
 
   /*!
@@ -201,10 +300,7 @@ public:
    */
   void parse(vector6d_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseBulk(val);
   }
 
   /*!
@@ -214,10 +310,7 @@ public:
    */
   void parse(vector6int32_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseBulk(val);
   }
 
   /*!
@@ -227,10 +320,7 @@ public:
    */
   void parse(vector6uint32_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseBulk(val);
   }
 
   /*!
@@ -247,6 +337,23 @@ public:
     consume();
   }
 
+  /*!
+   * \brief Copies a given number of bytes into a given buffer without parsing them.
+   *
+   * \param buffer The buffer to copy the bytes to. It has to be able to hold \p length bytes.
+   * \param length Number of bytes to copy
+   */
+  void rawData(uint8_t* buffer, const size_t length)
+  {
+    if (!ensureRemaining(length))
+    {
+      std::memset(buffer, 0, length);
+      return;
+    }
+    std::memcpy(buffer, buf_pos_, length);
+    buf_pos_ += length;
+  }
+
   /*!
    * \brief Parses the remaining bytes as a string.
    *
@@ -265,6 +372,11 @@ public:
    */
   void parse(std::string& val, size_t len)
   {
+    if (!ensureRemaining(len))
+    {
+      val.clear();
+      return;
+    }
     val.assign(reinterpret_cast<char*>(buf_pos_), len);
     buf_pos_ += len;
   }
@@ -291,9 +403,16 @@ public:
   template <typename T, size_t N>
   void parse(std::array<T, N>& array)
   {
-    for (size_t i = 0; i < N; i++)
+    if constexpr (std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))
+    {
+      parseBulk(array);
+    }
+    else
     {
-      parse(array[i]);
+      for (size_t i = 0; i < N; i++)
+      {
+        parse(array[i]);
+      }
     }
   }
 
@@ -326,7 +445,10 @@ public:
    */
   void consume(size_t bytes)
   {
-    buf_pos_ += bytes;
+    if (ensureRemaining(bytes))
+    {
+      buf_pos_ += bytes;
+    }
   }
 
   /*!
@@ -354,6 +476,42 @@ public:
     return checkSize(size);
   }
 
+  /*!
+   * \brief Checks if at least a given number of bytes is still remaining unparsed in the buffer
+   * and fails the parser otherwise, e.g. when a length field announces more data than was
+   * received. Unlike a read past the end of the buffer, this never throws.
+   *
+   * \param bytes Number of bytes to check for
+   *
+   * \returns True, if at least the given number of bytes are unparsed, false otherwise.
+   */
+  bool require(size_t bytes)
+  {
+    if (status_ == ParseStatus::OK && checkSize(bytes))
+    {
+      return true;
+    }
+    status_ = ParseStatus::TRUNCATED;
+    buf_pos_ = buf_end_;
+    return false;
+  }
+
+  /*!
+   * \brief Returns a pointer to the next unparsed byte for interpreting the remaining bytes in place.
+   */
+  const uint8_t* position() const
+  {
+    return buf_pos_;
+  }
+
+  /*!
+   * \brief Returns the number of bytes remaining unparsed in the buffer.
+   */
+  size_t remaining() const
+  {
+    return static_cast<size_t>(buf_end_ - buf_pos_);
+  }
+
   /*!
    * \brief Checks if no unparsed bytes remain in the buffer.
    *
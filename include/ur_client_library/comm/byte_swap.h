@@ -0,0 +1,177 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
+#define UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
+
+#include <endian.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+#  if defined(__SSSE3__)
+#    include <immintrin.h>
+#  elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#  endif
+#endif
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Converts a sequence of 64 bit values between network byte order (big endian) and host byte
+ * order.
+ *
+ * Depending on the instruction sets enabled at compile time (AVX2, SSSE3 or NEON) multiple values
+ * are converted at once, remaining values are converted one by one. Source and destination may
+ * point to the same memory, but otherwise must not overlap.
+ *
+ * \param dst Buffer to write the converted values to
+ * \param src Buffer to read the values from
+ * \param count Number of 64 bit values to convert
+ */
+inline void swapBytes64(uint8_t* dst, const uint8_t* src, const size_t count)
+{
+  size_t i = 0;
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+#  if defined(__AVX2__)
+  const __m256i mask_256 = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,
+                                            0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 8), _mm256_shuffle_epi8(values, mask_256));
+  }
+#  endif
+#  if defined(__SSSE3__)
+  const __m128i mask_128 = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 2 <= count; i += 2)
+  {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 8), _mm_shuffle_epi8(values, mask_128));
+  }
+#  elif defined(__ARM_NEON)
+  for (; i + 2 <= count; i += 2)
+  {
+    vst1q_u8(dst + i * 8, vrev64q_u8(vld1q_u8(src + i * 8)));
+  }
+#  endif
+#endif
+  for (; i < count; ++i)
+  {
+    uint64_t value;
+    std::memcpy(&value, src + i * 8, sizeof(value));
+    value = be64toh(value);
+    std::memcpy(dst + i * 8, &value, sizeof(value));
+  }
+}
+
+/*!
+ * \brief Converts a sequence of 32 bit values between network byte order (big endian) and host byte
+ * order.
+ *
+ * Depending on the instruction sets enabled at compile time (AVX2, SSSE3 or NEON) multiple values
+ * are converted at once, remaining values are converted one by one. Source and destination may
+ * point to the same memory, but otherwise must not overlap.
+ *
+ * \param dst Buffer to write the converted values to
+ * \param src Buffer to read the values from
+ * \param count Number of 32 bit values to convert
+ */
+inline void swapBytes32(uint8_t* dst, const uint8_t* src, const size_t count)
+{
+  size_t i = 0;
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+#  if defined(__AVX2__)
+  const __m256i mask_256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+                                            4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(values, mask_256));
+  }
+#  endif
+#  if defined(__SSSE3__)
+  const __m128i mask_128 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(values, mask_128));
+  }
+#  elif defined(__ARM_NEON)
+  for (; i + 4 <= count; i += 4)
+  {
+    vst1q_u8(dst + i * 4, vrev32q_u8(vld1q_u8(src + i * 4)));
+  }
+#  endif
+#endif
+  for (; i < count; ++i)
+  {
+    uint32_t value;
+    std::memcpy(&value, src + i * 4, sizeof(value));
+    value = be32toh(value);
+    std::memcpy(dst + i * 4, &value, sizeof(value));
+  }
+}
+
+/*!
+ * \brief Converts a sequence of values between network byte order (big endian) and host byte
+ * order, choosing the conversion matching the value size.
+ *
+ * @tparam T Type of the values. Has to be 1, 4 or 8 bytes large.
+ * \param dst Buffer to write the converted values to
+ * \param src Buffer to read the values from
+ * \param count Number of values to convert
+ */
+template <typename T>
+void swapBytes(uint8_t* dst, const uint8_t* src, const size_t count)
+{
+  static_assert(sizeof(T) == 1 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported value size for byte swapping");
+  if constexpr (sizeof(T) == 8)
+  {
+    swapBytes64(dst, src, count);
+  }
+  else if constexpr (sizeof(T) == 4)
+  {
+    swapBytes32(dst, src, count);
+  }
+  else
+  {
+    std::memmove(dst, src, count);
+  }
+}
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
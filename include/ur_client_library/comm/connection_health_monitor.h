@@ -0,0 +1,178 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_CONNECTION_HEALTH_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_CONNECTION_HEALTH_MONITOR_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/helpers.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Periodically samples the kernel's TCP statistics of a set of connections in a thread of
+ * its own, so round-trip times and retransmits can be observed without touching the threads using
+ * the connections.
+ *
+ * New retransmits are logged as warnings, as they delay messages to the robot and are a common
+ * cause of the robot's receive timeout triggering.
+ */
+class ConnectionHealthMonitor
+{
+public:
+  //! Reads the current statistics of a connection, returns false if it isn't connected
+  using Sampler = std::function<bool(TcpStatistics&)>;
+
+  /*!
+   * \brief Health of a single connection at the time of its last sample
+   */
+  struct ConnectionHealth
+  {
+    //! Whether the connection was established when it was sampled
+    bool connected = false;
+    //! The kernel's statistics, only valid if connected
+    TcpStatistics statistics;
+    //! Number of retransmits since the previous sample
+    uint32_t new_retransmits = 0;
+    //! Time of the last sample
+    std::chrono::steady_clock::time_point sample_time;
+  };
+
+  //! Default interval in between two samples
+  static constexpr std::chrono::milliseconds DEFAULT_SAMPLE_INTERVAL{ 1000 };
+
+  /*!
+   * \brief Creates a new ConnectionHealthMonitor object. Sampling starts with start().
+   *
+   * \param sample_interval Interval in between two samples of all connections
+   */
+  explicit ConnectionHealthMonitor(const std::chrono::milliseconds sample_interval = DEFAULT_SAMPLE_INTERVAL);
+  ConnectionHealthMonitor(const ConnectionHealthMonitor&) = delete;
+  ConnectionHealthMonitor& operator=(const ConnectionHealthMonitor&) = delete;
+  ~ConnectionHealthMonitor();
+
+  /*!
+   * \brief Adds a connection to sample. A connection added with an existing name replaces it.
+   *
+   * \param name Name of the connection used for lookups and log messages
+   * \param sampler Function reading the connection's statistics. It is called from the
+   * monitor's thread and has to stay valid until the monitor is stopped.
+   */
+  void addConnection(const std::string& name, Sampler sampler);
+
+  /*!
+   * \brief Starts the sampling thread. Does nothing if it is running already.
+   */
+  void start();
+
+  /*!
+   * \brief Stops the sampling thread. The samples taken so far are kept.
+   */
+  void stop();
+
+  /*!
+   * \brief Checks whether the sampling thread is running.
+   */
+  bool isRunning() const
+  {
+    return running_;
+  }
+
+  /*!
+   * \brief Samples all connections once. This is done periodically by the sampling thread, but
+   * can also be called manually, e.g. when not starting the thread.
+   */
+  void sample();
+
+  /*!
+   * \brief Gets the latest sample of a connection.
+   *
+   * \param name Name of the connection
+   * \param health Target for the sample
+   *
+   * \returns False if no connection with the given name has been sampled yet, true otherwise
+   */
+  bool getHealth(const std::string& name, ConnectionHealth& health) const;
+
+  /*!
+   * \brief Gets the latest samples of all connections.
+   *
+   * \returns The samples by connection name
+   */
+  std::map<std::string, ConnectionHealth> getHealth() const;
+
+  /*!
+   * \brief Registers a callback called from the monitor's thread whenever a sample shows new
+   * retransmits on a connection.
+   *
+   * \param callback Function getting the connection's name and its sample
+   */
+  void setRetransmitCallback(std::function<void(const std::string&, const ConnectionHealth&)> callback);
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the sampling thread. They are applied when
+   * the thread is started and, if it is running already, immediately.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+private:
+  void run();
+
+  std::chrono::milliseconds sample_interval_;
+  std::vector<std::pair<std::string, Sampler>> connections_;
+  std::map<std::string, ConnectionHealth> health_;
+  std::function<void(const std::string&, const ConnectionHealth&)> retransmit_callback_;
+  mutable std::mutex mutex_;
+
+  std::thread thread_;
+  ThreadConfig thread_config_;
+  std::atomic<bool> running_;
+  std::mutex run_mutex_;
+  std::condition_variable run_cv_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_CONNECTION_HEALTH_MONITOR_H_INCLUDED
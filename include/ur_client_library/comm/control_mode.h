@@ -52,6 +52,7 @@ enum class ControlMode : int32_t
   MODE_FREEDRIVE = 6,       ///< Set when freedrive mode is active.
   MODE_TOOL_IN_CONTACT =
       7,  ///< Used only internally in the script, when robot is in tool contact, clear by endToolContact()
+  MODE_FORCE = 8,           ///< Set when the wrench of force mode is streamed to the robot.
   END     ///< This is not an actual control mode, but used internally to get the number of control modes
 };
 
@@ -63,7 +64,8 @@ class ControlModeTypes
 public:
   // Control modes that require realtime communication
   static const inline std::vector<ControlMode> REALTIME_CONTROL_MODES = {
-    ControlMode::MODE_SERVOJ, ControlMode::MODE_SPEEDJ, ControlMode::MODE_SPEEDL, ControlMode::MODE_POSE
+    ControlMode::MODE_SERVOJ, ControlMode::MODE_SPEEDJ, ControlMode::MODE_SPEEDL, ControlMode::MODE_POSE,
+    ControlMode::MODE_FORCE
   };
 
   // Control modes that doesn't require realtime communication
@@ -0,0 +1,222 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_EXECUTION_BUDGET_H_INCLUDED
+#define UR_CLIENT_LIBRARY_EXECUTION_BUDGET_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "ur_client_library/metrics.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Describes one invocation that took longer than its budget.
+ */
+struct BudgetOverrun
+{
+  //! Name of the budget, e.g. the consumer or callback measured
+  std::string name;
+  //! Wall clock time the invocation took
+  std::chrono::nanoseconds wall_time{ 0 };
+  /*!
+   * \brief CPU time the invocation's thread spent. Much less than \p wall_time means the thread
+   * has been preempted or blocked, rather than doing too much work.
+   */
+  std::chrono::nanoseconds cpu_time{ 0 };
+  //! The budget that has been exceeded
+  std::chrono::nanoseconds budget{ 0 };
+  //! Time the invocation ended
+  std::chrono::steady_clock::time_point end_time;
+};
+
+/*!
+ * \brief Time budget of a consumer or callback, measuring the wall clock and thread CPU time of
+ * every invocation and counting the invocations exceeding the budget.
+ *
+ * Invocations are measured by one thread at a time using a Measurement, while the statistics can
+ * be read from any thread. Overruns are counted in urcl_execution_budget_overruns_total in
+ * getMetricsRegistry(). The overrun handler is called on the measuring thread right after the
+ * invocation, so it has to return quickly.
+ */
+class ExecutionBudget
+{
+public:
+  //! Called with every overrun
+  using OverrunHandler = std::function<void(const BudgetOverrun&)>;
+
+  /*!
+   * \brief Measures one invocation from its construction until its destruction.
+   */
+  class Measurement
+  {
+  public:
+    /*!
+     * \brief Starts measuring an invocation.
+     *
+     * \param budget Budget to record the invocation in, nullptr to measure nothing
+     */
+    explicit Measurement(ExecutionBudget* budget);
+    ~Measurement();
+    Measurement(const Measurement&) = delete;
+    Measurement& operator=(const Measurement&) = delete;
+
+  private:
+    ExecutionBudget* budget_;
+    std::chrono::steady_clock::time_point wall_start_;
+    std::chrono::nanoseconds cpu_start_;
+  };
+
+  ExecutionBudget() = delete;
+
+  /*!
+   * \brief Creates a new ExecutionBudget object.
+   *
+   * \param name Name identifying the measured consumer or callback in overruns and metrics
+   * \param budget Time an invocation may take
+   * \param labels Additional labels of the overrun metric, e.g. the robot's host
+   */
+  ExecutionBudget(const std::string& name, const std::chrono::nanoseconds budget, const MetricLabels& labels = {});
+  ExecutionBudget(const ExecutionBudget&) = delete;
+  ExecutionBudget& operator=(const ExecutionBudget&) = delete;
+
+  /*!
+   * \brief Sets a function called with every overrun. This must not be called while invocations
+   * are measured.
+   *
+   * \param handler Function to call, pass an empty function to remove a handler
+   */
+  void setOverrunHandler(OverrunHandler handler)
+  {
+    overrun_handler_ = std::move(handler);
+  }
+
+  /*!
+   * \brief Records an invocation measured elsewhere.
+   *
+   * \param wall_time Wall clock time the invocation took
+   * \param cpu_time CPU time the invocation's thread spent
+   */
+  void record(const std::chrono::nanoseconds wall_time, const std::chrono::nanoseconds cpu_time);
+
+  /*!
+   * \brief Getter for the name of the budget.
+   */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * \brief Getter for the time an invocation may take.
+   */
+  std::chrono::nanoseconds getBudget() const
+  {
+    return budget_;
+  }
+
+  /*!
+   * \brief Getter for the number of invocations measured.
+   */
+  uint64_t getInvocations() const
+  {
+    return invocations_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Getter for the number of invocations exceeding the budget.
+   */
+  uint64_t getOverruns() const
+  {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Getter for the longest wall clock time of an invocation.
+   */
+  std::chrono::nanoseconds getMaxWallTime() const
+  {
+    return std::chrono::nanoseconds(max_wall_ns_.load(std::memory_order_relaxed));
+  }
+
+  /*!
+   * \brief Getter for the longest CPU time of an invocation.
+   */
+  std::chrono::nanoseconds getMaxCpuTime() const
+  {
+    return std::chrono::nanoseconds(max_cpu_ns_.load(std::memory_order_relaxed));
+  }
+
+  /*!
+   * \brief Getter for the last invocation exceeding the budget.
+   *
+   * \param overrun Target for the overrun
+   *
+   * \returns False if there hasn't been an overrun yet
+   */
+  bool getLastOverrun(BudgetOverrun& overrun) const;
+
+  /*!
+   * \brief Resets the statistics, but not the overrun metric.
+   */
+  void reset();
+
+  /*!
+   * \brief CPU time spent by the calling thread, read from CLOCK_THREAD_CPUTIME_ID.
+   */
+  static std::chrono::nanoseconds threadCpuTime();
+
+private:
+  std::string name_;
+  std::chrono::nanoseconds budget_;
+  OverrunHandler overrun_handler_;
+  Counter* overrun_metric_;
+
+  std::atomic<uint64_t> invocations_;
+  std::atomic<uint64_t> overruns_;
+  std::atomic<int64_t> max_wall_ns_;
+  std::atomic<int64_t> max_cpu_ns_;
+
+  // Only locked on overruns and by readers of the last overrun
+  mutable std::mutex overrun_mutex_;
+  BudgetOverrun last_overrun_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_EXECUTION_BUDGET_H_INCLUDED
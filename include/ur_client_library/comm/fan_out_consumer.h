@@ -0,0 +1,310 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_FAN_OUT_CONSUMER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_FAN_OUT_CONSUMER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/latency_statistics.h"
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/product_queue.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Consumer, that hands each product to multiple consumers which are isolated from each
+ * other.
+ *
+ * Contrary to the MultiConsumer, each consumer gets its own bounded queue and thread, so a slow
+ * consumer, e.g. a logger, cannot delay the others. Consumers marked as real-time are called
+ * directly on the pipeline's consumer thread instead, before the product is handed to the queues
+ * of the other consumers. For each consumer, the time between a product being queued by the
+ * pipeline and being consumed is recorded as its lag.
+ *
+ * @tparam T Type of the consumed products
+ */
+template <typename T>
+class FanOutConsumer : public IConsumer<T>
+{
+public:
+  static constexpr size_t DEFAULT_QUEUE_CAPACITY = 32;
+
+  FanOutConsumer() : running_(false)
+  {
+  }
+
+  virtual ~FanOutConsumer()
+  {
+    stopWorkers();
+  }
+
+  /*!
+   * \brief Registers a consumer. This must not be called while the pipeline is running.
+   *
+   * \param consumer The consumer to register, it has to outlive this object
+   * \param real_time If true, the consumer is called directly on the pipeline's consumer thread
+   * \param capacity Maximum number of products queued for the consumer, ignored for real-time
+   * consumers
+   * \param policy What to do with new products while the consumer's queue is full. With
+   * OverflowPolicy::BLOCK, a slow consumer slows down all others.
+   *
+   * \returns The index of the consumer, used to query its statistics
+   */
+  size_t addConsumer(IConsumer<T>* consumer, const bool real_time = false,
+                     const size_t capacity = DEFAULT_QUEUE_CAPACITY,
+                     const OverflowPolicy policy = OverflowPolicy::DROP_NEWEST)
+  {
+    auto branch = std::make_unique<Branch>();
+    branch->consumer = consumer;
+    branch->real_time = real_time;
+    if (!real_time)
+    {
+      branch->queue = std::make_unique<ProductQueue<T, std::shared_ptr<T>>>(capacity, policy);
+    }
+    branches_.push_back(std::move(branch));
+    return branches_.size() - 1;
+  }
+
+  /*!
+   * \brief Sets up all registered consumers.
+   */
+  void setupConsumer() override
+  {
+    for (auto& branch : branches_)
+    {
+      branch->consumer->setupConsumer();
+    }
+  }
+
+  /*!
+   * \brief Stops the consumer threads and tears down all registered consumers.
+   */
+  void teardownConsumer() override
+  {
+    stopWorkers();
+    for (auto& branch : branches_)
+    {
+      branch->consumer->teardownConsumer();
+    }
+  }
+
+  /*!
+   * \brief Stops the consumer threads and all registered consumers.
+   */
+  void stopConsumer() override
+  {
+    stopWorkers();
+    for (auto& branch : branches_)
+    {
+      branch->consumer->stopConsumer();
+    }
+  }
+
+  /*!
+   * \brief Triggers timeout functionality for all real-time consumers. The other consumers handle
+   * timeouts on their own threads.
+   */
+  void onTimeout() override
+  {
+    for (auto& branch : branches_)
+    {
+      if (branch->real_time)
+      {
+        branch->consumer->onTimeout();
+      }
+    }
+  }
+
+  /*!
+   * \brief Consumes a product with all real-time consumers and queues it for all others. The
+   * consumer threads are started with the first product.
+   *
+   * \param product Shared pointer to the product to be consumed.
+   *
+   * \returns False if a real-time consumer failed, true otherwise.
+   */
+  bool consume(std::shared_ptr<T> product) override
+  {
+    if (!running_)
+    {
+      startWorkers();
+    }
+    bool res = true;
+    for (auto& branch : branches_)
+    {
+      if (branch->real_time)
+      {
+        recordConsumed(*branch, *product);
+        if (!branch->consumer->consume(product))
+          res = false;
+      }
+    }
+    for (auto& branch : branches_)
+    {
+      if (!branch->real_time)
+      {
+        branch->queue->enqueue(std::shared_ptr<T>(product), running_);
+      }
+    }
+    return res;
+  }
+
+  /*!
+   * \brief Getter for the number of products a consumer has received.
+   *
+   * \param index The consumer's index as returned by addConsumer()
+   *
+   * \returns The number of products handed to the consumer
+   */
+  uint64_t getNumConsumed(const size_t index) const
+  {
+    return branches_.at(index)->num_consumed;
+  }
+
+  /*!
+   * \brief Getter for the number of products discarded, because a consumer's queue was full.
+   *
+   * \param index The consumer's index as returned by addConsumer()
+   *
+   * \returns The number of discarded products, always 0 for real-time consumers
+   */
+  uint64_t getNumDropped(const size_t index) const
+  {
+    const auto& queue = branches_.at(index)->queue;
+    return queue == nullptr ? 0 : queue->getNumDropped();
+  }
+
+  /*!
+   * \brief Getter for the largest number of products queued for a consumer at the same time.
+   *
+   * \param index The consumer's index as returned by addConsumer()
+   *
+   * \returns The high-water mark of the consumer's queue, always 0 for real-time consumers
+   */
+  size_t getQueueHighWaterMark(const size_t index) const
+  {
+    const auto& queue = branches_.at(index)->queue;
+    return queue == nullptr ? 0 : queue->getHighWaterMark();
+  }
+
+  /*!
+   * \brief Getter for the lag of a consumer, i.e. the time between the pipeline queueing products
+   * and the consumer receiving them.
+   *
+   * \param index The consumer's index as returned by addConsumer()
+   *
+   * \returns Histogram of the consumer's lag
+   */
+  const LatencyHistogram& getLag(const size_t index) const
+  {
+    return branches_.at(index)->lag;
+  }
+
+private:
+  struct Branch
+  {
+    IConsumer<T>* consumer = nullptr;
+    bool real_time = false;
+    std::unique_ptr<ProductQueue<T, std::shared_ptr<T>>> queue;
+    std::thread thread;
+    std::atomic<uint64_t> num_consumed{ 0 };
+    LatencyHistogram lag;
+  };
+
+  void startWorkers()
+  {
+    running_ = true;
+    for (auto& branch : branches_)
+    {
+      if (!branch->real_time)
+      {
+        branch->thread = std::thread(&FanOutConsumer::runWorker, this, branch.get());
+      }
+    }
+  }
+
+  void stopWorkers()
+  {
+    running_ = false;
+    for (auto& branch : branches_)
+    {
+      if (branch->thread.joinable())
+      {
+        branch->thread.join();
+      }
+    }
+  }
+
+  void recordConsumed(Branch& branch, const T& product)
+  {
+    branch.num_consumed++;
+    const std::chrono::steady_clock::time_point enqueue_time = product.getTimestamps().enqueue;
+    if (enqueue_time != std::chrono::steady_clock::time_point())
+    {
+      branch.lag.record(std::chrono::steady_clock::now() - enqueue_time);
+    }
+  }
+
+  void runWorker(Branch* branch)
+  {
+    std::shared_ptr<T> product;
+    while (running_)
+    {
+      // Same timeout as the pipeline's consumer thread
+      if (!branch->queue->waitDequeTimed(product, std::chrono::milliseconds(8)))
+      {
+        branch->consumer->onTimeout();
+        continue;
+      }
+      recordConsumed(*branch, *product);
+      if (!branch->consumer->consume(std::move(product)))
+      {
+        URCL_LOG_ERROR("A consumer of a fan-out consumer failed, it will not receive any further products.");
+        branch->consumer->teardownConsumer();
+        break;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Branch>> branches_;
+  std::atomic<bool> running_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_FAN_OUT_CONSUMER_H_INCLUDED
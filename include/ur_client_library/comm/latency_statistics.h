@@ -0,0 +1,176 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Lock-free histogram of durations with microsecond resolution.
+ *
+ * Durations are sorted into buckets with a relative width of about 3%, covering durations of up to
+ * about half an hour. Recording a duration is a few relaxed atomic operations, so it can be done
+ * for every received package and from multiple threads.
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+
+  /*!
+   * \brief Adds a duration to the histogram. Negative durations are counted as 0.
+   *
+   * \param duration The duration to add
+   */
+  void record(const std::chrono::steady_clock::duration duration);
+
+  /*!
+   * \brief Removes all recorded durations.
+   */
+  void reset();
+
+  /*!
+   * \brief Adds all durations recorded in another histogram to this one, e.g. to aggregate the
+   * latencies of several robots.
+   *
+   * \param other The histogram to add
+   */
+  void merge(const LatencyHistogram& other);
+
+  /*!
+   * \brief Getter for the number of recorded durations.
+   *
+   * \returns The number of durations
+   */
+  uint64_t getCount() const;
+
+  /*!
+   * \brief Getter for the smallest recorded duration.
+   *
+   * \returns The minimum, 0 if nothing has been recorded
+   */
+  std::chrono::microseconds getMin() const;
+
+  /*!
+   * \brief Getter for the largest recorded duration.
+   *
+   * \returns The maximum, 0 if nothing has been recorded
+   */
+  std::chrono::microseconds getMax() const;
+
+  /*!
+   * \brief Getter for the mean of all recorded durations.
+   *
+   * \returns The mean, 0 if nothing has been recorded
+   */
+  std::chrono::microseconds getMean() const;
+
+  /*!
+   * \brief Estimates a percentile of the recorded durations from the histogram's buckets.
+   *
+   * \param percentile The percentile to compute in the range [0, 100]
+   *
+   * \returns The lower bound of the bucket containing the percentile, 0 if nothing has been recorded
+   */
+  std::chrono::microseconds getPercentile(const double percentile) const;
+
+  /*!
+   * \brief Produces a human readable summary of the histogram.
+   *
+   * \returns A string containing count, minimum, mean, median, 99th percentile and maximum
+   */
+  std::string toString() const;
+
+private:
+  static constexpr size_t SUB_BUCKET_BITS = 5;
+  static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr size_t MAX_SHIFT = 26;
+  static constexpr size_t NUM_BUCKETS = (MAX_SHIFT + 2) * SUB_BUCKETS;
+
+  static size_t getBucketIndex(const uint64_t microseconds);
+  static uint64_t getBucketLowerBound(const size_t index);
+
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+/*!
+ * \brief Latencies of the stages a package passes through on its way from the network to a
+ * consumer, recorded by a Pipeline. See PackageTimestamps for the individual points in time.
+ */
+struct LatencyStatistics
+{
+  //! From the kernel receiving the data to reading it from the socket. Requires kernel timestamps.
+  LatencyHistogram kernel_to_receive;
+  //! From reading a package from the socket until it has been parsed
+  LatencyHistogram receive_to_parse;
+  //! From parsing a package until it has been queued or handed to the producer callback
+  LatencyHistogram parse_to_enqueue;
+  //! From queueing a package until it has been taken out of the queue
+  LatencyHistogram enqueue_to_consume;
+  //! Time between reading two consecutive packages from the socket. Its spread shows the jitter.
+  LatencyHistogram receive_interval;
+
+  /*!
+   * \brief Removes all recorded durations from all histograms.
+   */
+  void reset();
+
+  /*!
+   * \brief Adds the durations of all histograms of another statistics to this one.
+   *
+   * \param other The statistics to add
+   */
+  void merge(const LatencyStatistics& other);
+
+  /*!
+   * \brief Produces a human readable summary of all histograms.
+   *
+   * \returns A string with one line per histogram
+   */
+  std::string toString() const;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
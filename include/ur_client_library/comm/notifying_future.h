@@ -0,0 +1,217 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_NOTIFYING_FUTURE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_NOTIFYING_FUTURE_H_INCLUDED
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Callbacks waiting for a NotifyingPromise to be satisfied.
+ */
+class CompletionCallbacks
+{
+public:
+  //! Calls all callbacks registered so far, callbacks registered afterwards are called right away
+  void complete()
+  {
+    std::vector<std::function<void()>> callbacks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_ = true;
+      callbacks.swap(callbacks_);
+    }
+    for (auto& callback : callbacks)
+    {
+      callback();
+    }
+  }
+
+  //! Registers a callback, which is called on the thread completing the promise
+  void add(std::function<void()> callback)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!completed_)
+      {
+        callbacks_.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback();
+  }
+
+private:
+  std::mutex mutex_;
+  bool completed_ = false;
+  std::vector<std::function<void()>> callbacks_;
+};
+
+/*!
+ * \brief Future of a NotifyingPromise, which calls callbacks once it is ready.
+ *
+ * It is a std::future, so it can be used as such, e.g. stored in a std::future<T>. Only as a
+ * NotifyingFuture it can notify callbacks, e.g. the continuations passed to Reactor::whenReady().
+ *
+ * @tparam T Type of the future's value
+ */
+template <typename T>
+class NotifyingFuture : public std::future<T>
+{
+public:
+  NotifyingFuture() = default;
+
+  NotifyingFuture(std::future<T>&& future, std::shared_ptr<CompletionCallbacks> callbacks)
+    : std::future<T>(std::move(future)), callbacks_(std::move(callbacks))
+  {
+  }
+
+  /*!
+   * \brief Calls a function once the future is ready. It is called on the thread satisfying the
+   * promise or, if the future is ready already, right away. Futures without a promise never call it.
+   *
+   * \param callback The function to call, it has to return quickly
+   */
+  void onReady(std::function<void()> callback) const
+  {
+    if (callbacks_)
+    {
+      callbacks_->add(std::move(callback));
+    }
+  }
+
+private:
+  std::shared_ptr<CompletionCallbacks> callbacks_;
+};
+
+/*!
+ * \brief std::promise that notifies the callbacks registered on its NotifyingFuture once it is
+ * satisfied, so waiting for the future doesn't require polling it.
+ *
+ * A promise destroyed without being satisfied sets a std::future_error with
+ * std::future_errc::broken_promise as std::promise does and notifies the callbacks, too.
+ *
+ * @tparam T Type of the promise's value
+ */
+template <typename T>
+class NotifyingPromise
+{
+public:
+  NotifyingPromise() : callbacks_(std::make_shared<CompletionCallbacks>()), satisfied_(false)
+  {
+  }
+
+  NotifyingPromise(NotifyingPromise&& other) noexcept
+    : promise_(std::move(other.promise_))
+    , callbacks_(std::move(other.callbacks_))
+    , satisfied_(other.satisfied_)
+  {
+  }
+
+  NotifyingPromise& operator=(NotifyingPromise&& other) noexcept
+  {
+    if (this != &other)
+    {
+      abandon();
+      promise_ = std::move(other.promise_);
+      callbacks_ = std::move(other.callbacks_);
+      satisfied_ = other.satisfied_;
+    }
+    return *this;
+  }
+
+  NotifyingPromise(const NotifyingPromise&) = delete;
+  NotifyingPromise& operator=(const NotifyingPromise&) = delete;
+
+  ~NotifyingPromise()
+  {
+    abandon();
+  }
+
+  /*!
+   * \brief Returns the future of the promise, can only be called once.
+   */
+  NotifyingFuture<T> getFuture()
+  {
+    return NotifyingFuture<T>(promise_.get_future(), callbacks_);
+  }
+
+  /*!
+   * \brief Stores a value in the future and calls the callbacks registered on it.
+   */
+  void setValue(T value)
+  {
+    promise_.set_value(std::move(value));
+    satisfied_ = true;
+    callbacks_->complete();
+  }
+
+  /*!
+   * \brief Stores an exception in the future and calls the callbacks registered on it.
+   */
+  void setException(std::exception_ptr exception)
+  {
+    promise_.set_exception(exception);
+    satisfied_ = true;
+    callbacks_->complete();
+  }
+
+private:
+  // Breaks the promise of a future still waiting and notifies its callbacks
+  void abandon()
+  {
+    if (callbacks_ && !satisfied_)
+    {
+      {
+        std::promise<T> broken(std::move(promise_));
+      }
+      callbacks_->complete();
+    }
+  }
+
+  std::promise<T> promise_;
+  std::shared_ptr<CompletionCallbacks> callbacks_;
+  bool satisfied_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_NOTIFYING_FUTURE_H_INCLUDED
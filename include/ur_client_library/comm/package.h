@@ -28,19 +28,42 @@
 #ifndef UR_CLIENT_LIBRARY_PACKAGE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_PACKAGE_H_INCLUDED
 
+#include <chrono>
+
 #include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/memory_resource.h"
 
 namespace urcl
 {
 namespace comm
 {
+/*!
+ * \brief Points in time a package passed on its way from the network to a consumer. All of them
+ * use the monotonic steady clock. A default constructed time point means that the stage has not
+ * been timestamped, e.g. because kernel timestamps are disabled.
+ */
+struct PackageTimestamps
+{
+  //! The kernel received the data. Only set if kernel timestamping is enabled on the socket.
+  std::chrono::steady_clock::time_point kernel;
+  //! The data was read from the socket
+  std::chrono::steady_clock::time_point receive;
+  //! The package has been parsed
+  std::chrono::steady_clock::time_point parse;
+  //! The package has been handed to the pipeline's queue or producer callback
+  std::chrono::steady_clock::time_point enqueue;
+};
+
 /*!
  * \brief The URPackage a parent class. From that two implementations are inherited,
  * one for the primary, one for the rtde interface (primary_interface::primaryPackage;
  * rtde_interface::rtdePackage). The URPackage makes use of the template HeaderT.
+ *
+ * Packages created with \p new are allocated from the library's memory resource, see
+ * setMemoryResource().
  */
 template <typename HeaderT>
-class URPackage
+class URPackage : public MemoryResourceAllocated
 {
 public:
   /*!
@@ -67,10 +90,31 @@ public:
    */
   virtual std::string toString() const = 0;
 
+  /*!
+   * \brief Getter for the points in time this package passed through the stages of the pipeline.
+   *
+   * \returns The timestamps of this package
+   */
+  PackageTimestamps& getTimestamps()
+  {
+    return timestamps_;
+  }
+
+  /*!
+   * \brief Getter for the points in time this package passed through the stages of the pipeline.
+   *
+   * \returns The timestamps of this package
+   */
+  const PackageTimestamps& getTimestamps() const
+  {
+    return timestamps_;
+  }
+
   using HeaderType = HeaderT;
 
 private:
   HeaderT header_;
+  PackageTimestamps timestamps_;
 };
 }  // namespace comm
 }  // namespace urcl
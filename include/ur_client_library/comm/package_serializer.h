@@ -30,7 +30,12 @@
 #define UR_CLIENT_LIBRARY_PACKAGE_SERIALIZER_H_INCLUDED
 
 #include <endian.h>
+#include <array>
 #include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "ur_client_library/comm/byte_swap.h"
 
 namespace urcl
 {
@@ -79,6 +84,35 @@ public:
     return size;
   }
 
+  /*!
+   * \brief A serialization method for arrays. Arrays of 4 or 8 byte numbers are converted at once.
+   *
+   * @tparam T The type of the array elements
+   * @tparam N The number of array elements
+   * \param buffer The buffer to write the serialization into.
+   * \param val The array to serialize.
+   *
+   * \returns Size in byte of the serialization.
+   */
+  template <typename T, size_t N>
+  static size_t serialize(uint8_t* buffer, const std::array<T, N>& val)
+  {
+    if constexpr (std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))
+    {
+      swapBytes<T>(buffer, reinterpret_cast<const uint8_t*>(val.data()), N);
+      return sizeof(T) * N;
+    }
+    else
+    {
+      size_t size = 0;
+      for (const auto& item : val)
+      {
+        size += serialize(buffer + size, item);
+      }
+      return size;
+    }
+  }
+
   /*!
    * \brief A serialization method for strings.
    *
@@ -20,12 +20,19 @@
 
 #pragma once
 
+#include "ur_client_library/comm/latency_statistics.h"
 #include "ur_client_library/comm/package.h"
+#include "ur_client_library/comm/product_queue.h"
 #include "ur_client_library/log.h"
 #include "ur_client_library/helpers.h"
-#include "ur_client_library/queue/readerwriterqueue.h"
+#include "ur_client_library/metrics.h"
+#include "ur_client_library/comm/execution_budget.h"
+#include "ur_client_library/trace.h"
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <thread>
 #include <vector>
 #include <fstream>
@@ -79,6 +86,23 @@ public:
    * \returns Success of the consumption.
    */
   virtual bool consume(std::shared_ptr<T> product) = 0;
+
+  /*!
+   * \brief Consumes a product owned by the pipeline. This is what the Pipeline calls for each
+   * product.
+   *
+   * By default, the product is handed to consume(std::shared_ptr<T>), which requires allocating a
+   * shared pointer for every product. Consumers that don't keep products beyond this call should
+   * override this method as well. They may still take ownership by moving out of \p product.
+   *
+   * \param product The product to be consumed.
+   *
+   * \returns Success of the consumption.
+   */
+  virtual bool consumeProduct(std::unique_ptr<T>& product)
+  {
+    return consume(std::shared_ptr<T>(std::move(product)));
+  }
 };
 
 /*!
@@ -92,6 +116,7 @@ class MultiConsumer : public IConsumer<T>
 {
 private:
   std::vector<IConsumer<T>*> consumers_;
+  std::vector<std::shared_ptr<ExecutionBudget>> budgets_;
 
 public:
   /*!
@@ -99,10 +124,22 @@ public:
    *
    * \param consumers The list of consumers that should all consume given products
    */
-  MultiConsumer(std::vector<IConsumer<T>*> consumers) : consumers_(consumers)
+  MultiConsumer(std::vector<IConsumer<T>*> consumers) : consumers_(consumers), budgets_(consumers_.size())
   {
   }
 
+  /*!
+   * \brief Sets the time budget of one of the consumers. Every product consumed by it is measured
+   * against the budget. This must not be called while products are consumed.
+   *
+   * \param index Index of the consumer in the list given to the constructor
+   * \param budget The budget to measure against, nullptr to stop measuring
+   */
+  void setConsumerBudget(const size_t index, std::shared_ptr<ExecutionBudget> budget)
+  {
+    budgets_.at(index) = std::move(budget);
+  }
+
   /*!
    * \brief Sets up all registered consumers.
    */
@@ -154,9 +191,10 @@ public:
   bool consume(std::shared_ptr<T> product)
   {
     bool res = true;
-    for (auto& con : consumers_)
+    for (size_t i = 0; i < consumers_.size(); ++i)
     {
-      if (!con->consume(product))
+      ExecutionBudget::Measurement measurement(budgets_[i].get());
+      if (!consumers_[i]->consume(product))
         res = false;
     }
     return res;
@@ -246,6 +284,9 @@ class Pipeline
 public:
   typedef std::chrono::high_resolution_clock Clock;
   typedef Clock::time_point Time;
+  static constexpr size_t DEFAULT_QUEUE_CAPACITY = 32;
+  // Chosen because CB3 robots publish at 125 Hz (every 8 ms)
+  static constexpr std::chrono::microseconds DEFAULT_CONSUMER_TIMEOUT{ 8000 };
   /*!
    * \brief Creates a new Pipeline object, registering producer, consumer and notifier.
    * Additionally, an empty queue is initialized.
@@ -262,10 +303,11 @@ public:
     , consumer_(consumer)
     , name_(name)
     , notifier_(notifier)
-    , queue_{ 32 }
+    , queue_(std::make_unique<ProductQueue<T>>(DEFAULT_QUEUE_CAPACITY, OverflowPolicy::DROP_NEWEST))
     , running_{ false }
     , producer_fifo_scheduling_(producer_fifo_scheduling)
-  {
+    , consumer_timeout_(DEFAULT_CONSUMER_TIMEOUT)
+  {  setMetricLabels({});
   }
   /*!
    * \brief Creates a new Pipeline object, registering producer and notifier while no consumer is
@@ -281,10 +323,11 @@ public:
     , consumer_(nullptr)
     , name_(name)
     , notifier_(notifier)
-    , queue_{ 32 }
+    , queue_(std::make_unique<ProductQueue<T>>(DEFAULT_QUEUE_CAPACITY, OverflowPolicy::DROP_NEWEST))
     , running_{ false }
     , producer_fifo_scheduling_(producer_fifo_scheduling)
-  {
+    , consumer_timeout_(DEFAULT_CONSUMER_TIMEOUT)
+  {  setMetricLabels({});
   }
 
   /*!
@@ -319,11 +362,18 @@ public:
     if (running_)
       return;
 
+    // Join the threads of a previous run that ended because the producer failed
+    stop();
+
     running_ = true;
     producer_.startProducer();
     pThread_ = std::thread(&Pipeline::runProducer, this);
+    applyThreadConfig(pThread_.native_handle(), producer_thread_config_);
     if (consumer_ != nullptr)
+    {
       cThread_ = std::thread(&Pipeline::runConsumer, this);
+      applyThreadConfig(cThread_.native_handle(), consumer_thread_config_);
+    }
     notifier_.started(name_);
   }
 
@@ -332,7 +382,9 @@ public:
    */
   void stop()
   {
-    if (!running_)
+    // If the producer failed, the threads have already ended by themselves but still need to be joined.
+    const bool was_running = running_;
+    if (!was_running && !pThread_.joinable() && !cThread_.joinable())
       return;
 
     URCL_LOG_DEBUG("Stopping pipeline! <%s>", name_.c_str());
@@ -348,7 +400,215 @@ public:
     {
       cThread_.join();
     }
-    notifier_.stopped(name_);
+    if (was_running)
+    {
+      notifier_.stopped(name_);
+    }
+  }
+
+  /*!
+   * \brief Checks whether the pipeline has been started and its producer hasn't failed since.
+   */
+  bool isRunning() const
+  {
+    return running_;
+  }
+
+  /*!
+   * \brief Registers a function that is called on the producer thread for each produced package,
+   * before the package would be added to the queue.
+   *
+   * This allows handling packages with the lowest possible latency, as no thread handoff is
+   * involved. The callback has to return quickly, as it blocks reading the next packages. This
+   * must not be called while the pipeline is running.
+   *
+   * \param callback Function receiving each product. If it returns true, the product has been
+   * consumed and is not added to the queue. Pass an empty function to remove a callback.
+   */
+  void setProducerCallback(std::function<bool(std::unique_ptr<T>&)> callback)
+  {
+    producer_callback_ = callback;
+  }
+
+  /*!
+   * \brief Sets how long the consumer thread waits for a product before calling the consumer's
+   * onTimeout(). This must not be called while the pipeline is running.
+   *
+   * \param timeout Maximum time between calls to the consumer. With a timeout of 0, onTimeout() is
+   * never called and the consumer thread only wakes up for new products and to stop.
+   */
+  void setConsumerTimeout(const std::chrono::microseconds timeout)
+  {
+    consumer_timeout_ = timeout;
+  }
+
+  /*!
+   * \brief Sets the consumer timeout to the period of the given frequency, so the consumer is
+   * updated at least as often as the data is published. This must not be called while the pipeline
+   * is running.
+   *
+   * \param frequency Frequency the products are expected with in Hz. The current timeout is kept if
+   * the frequency isn't greater than 0, is NaN or its period doesn't fit into the timeout.
+   */
+  void setConsumerTimeoutFromFrequency(const double frequency)
+  {
+    if (frequency > 0.0)
+    {
+      const double period = 1e6 / frequency;
+      if (period < static_cast<double>(std::numeric_limits<int64_t>::max()))
+      {
+        consumer_timeout_ = std::chrono::microseconds(static_cast<int64_t>(period));
+      }
+    }
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the producer thread. They are applied every
+   * time the pipeline is started and, if it is running already, immediately.
+   *
+   * Scheduling set here takes precedence over the producer_fifo_scheduling constructor argument.
+   *
+   * \param config The thread settings
+   */
+  void setProducerThreadConfig(const ThreadConfig& config)
+  {
+    producer_thread_config_ = config;
+    if (pThread_.joinable())
+    {
+      applyThreadConfig(pThread_.native_handle(), producer_thread_config_);
+    }
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the consumer thread. They are applied every
+   * time the pipeline is started and, if it is running already, immediately.
+   *
+   * \param config The thread settings
+   */
+  void setConsumerThreadConfig(const ThreadConfig& config)
+  {
+    consumer_thread_config_ = config;
+    if (cThread_.joinable())
+    {
+      applyThreadConfig(cThread_.native_handle(), consumer_thread_config_);
+    }
+  }
+
+  /*!
+   * \brief Getter for the time the consumer thread waits for a product before calling onTimeout().
+   *
+   * \returns The consumer timeout, 0 if onTimeout() is never called
+   */
+  std::chrono::microseconds getConsumerTimeout() const
+  {
+    return consumer_timeout_;
+  }
+
+  /*!
+   * \brief Configures the queue handing products from the producer to the consumer. The default
+   * is a queue of DEFAULT_QUEUE_CAPACITY products discarding new products while it is full. This
+   * must not be called while the pipeline is running and discards all queued products.
+   *
+   * \param capacity Maximum number of products in the queue, ignored for OverflowPolicy::LATEST_ONLY
+   * \param policy What to do with new products while the queue is full
+   */
+  void setQueue(const size_t capacity, const OverflowPolicy policy)
+  {
+    queue_ = std::make_unique<ProductQueue<T>>(capacity, policy);
+  }
+
+  /*!
+   * \brief Getter for the number of products discarded because the queue was full.
+   *
+   * \returns The number of discarded products since the queue has been configured
+   */
+  uint64_t getNumDroppedProducts() const
+  {
+    return queue_->getNumDropped();
+  }
+
+  /*!
+   * \brief Getter for the largest number of products that have been queued at the same time. This
+   * helps sizing the queue.
+   *
+   * \returns The high-water mark of the queue since it has been configured
+   */
+  size_t getQueueHighWaterMark() const
+  {
+    return queue_->getHighWaterMark();
+  }
+
+  /*!
+   * \brief Registers a function that is called on the producer thread whenever a product is
+   * discarded, because the queue is full. This must not be called while the pipeline is running.
+   *
+   * \param callback Function to call on overflows, pass an empty function to remove a callback.
+   */
+  void setOverflowCallback(std::function<void()> callback)
+  {
+    overflow_callback_ = callback;
+  }
+
+  /*!
+   * \brief Sets the labels of the pipeline's metrics in addition to its name, e.g. the robot's host.
+   * The queue depth is reported as urcl_pipeline_queue_depth and discarded products as
+   * urcl_pipeline_dropped_products_total to getMetricsRegistry(). This must not be called while the
+   * pipeline is running.
+   *
+   * \param labels Additional labels of the metrics
+   */
+  void setMetricLabels(const MetricLabels& labels)
+  {
+    MetricLabels all_labels{ { "pipeline", name_ } };
+    all_labels.insert(all_labels.end(), labels.begin(), labels.end());
+    queue_depth_metric_ = &getMetricsRegistry().getGauge("urcl_pipeline_queue_depth",
+                                                         "Number of products waiting for the consumer", all_labels);
+    dropped_metric_ = &getMetricsRegistry().getCounter("urcl_pipeline_dropped_products_total",
+                                                       "Products discarded because the queue was full", all_labels);
+  }
+
+  /*!
+   * \brief Sets the time budget of the consumer. Every product consumed is measured against the
+   * budget, so overruns can be attributed to this pipeline's consumer. This must not be called
+   * while the pipeline is running.
+   *
+   * \param budget The budget to measure against, nullptr to stop measuring
+   */
+  void setConsumerBudget(std::shared_ptr<ExecutionBudget> budget)
+  {
+    consumer_budget_ = std::move(budget);
+  }
+
+  /*!
+   * \brief Getter for the time budget of the consumer.
+   *
+   * \returns The budget set, nullptr if none is set
+   */
+  std::shared_ptr<ExecutionBudget> getConsumerBudget() const
+  {
+    return consumer_budget_;
+  }
+
+  /*!
+   * \brief Registers statistics that the latencies of all packages passing through the pipeline are
+   * recorded into. Stages that have not been timestamped are skipped. This must not be called while
+   * the pipeline is running.
+   *
+   * \param statistics The statistics to record into, nullptr to disable recording
+   */
+  void setLatencyStatistics(std::shared_ptr<LatencyStatistics> statistics)
+  {
+    latency_statistics_ = std::move(statistics);
+  }
+
+  /*!
+   * \brief Getter for the statistics latencies are recorded into.
+   *
+   * \returns The registered statistics, nullptr if none are registered
+   */
+  std::shared_ptr<LatencyStatistics> getLatencyStatistics() const
+  {
+    return latency_statistics_;
   }
 
   /*!
@@ -356,38 +616,129 @@ public:
    * already contains one or more items, the queue will be flushed and the newest item will be returned. If there is no
    * item inside the queue, the function will wait for \p timeout for a new package
    *
+   * With a OverflowPolicy::LATEST_ONLY queue, the newest package is taken in constant time and the
+   * package previously held by \p product is handed back to the queue instead of being destroyed.
+   *
    * \param product Unique pointer to be set to the package
    * \param timeout Time to wait if no package is in the queue before returning
    *
-   * \returns
+   * \returns True if a package was received, false otherwise
    */
   bool getLatestProduct(std::unique_ptr<T>& product, std::chrono::milliseconds timeout)
   {
+    // A single slot queue only holds the latest package, so there is nothing to flush.
+    if (queue_->getPolicy() == OverflowPolicy::LATEST_ONLY)
+    {
+      if (!queue_->waitDequeTimed(product, timeout))
+      {
+        return false;
+      }
+      recordConsumed(*product);
+      return true;
+    }
+
     // If the queue has more than one package, get the latest one.
     bool res = false;
-    while (queue_.tryDequeue(product))
+    while (queue_->tryDequeue(product))
     {
       res = true;
     }
 
     // If the queue is empty, wait for a package.
-    return res || queue_.waitDequeTimed(product, timeout);
+    res = res || queue_->waitDequeTimed(product, timeout);
+    if (res)
+    {
+      recordConsumed(*product);
+    }
+    return res;
+  }
+
+  /*!
+   * \brief Returns the oldest package in the queue without dropping any other packages. This allows
+   * receiving several answers to requests, that have been sent back-to-back, in order. If there is
+   * no item inside the queue, the function will wait for \p timeout for a new package.
+   *
+   * \param product Unique pointer to be set to the package
+   * \param timeout Time to wait if no package is in the queue before returning
+   *
+   * \returns True if a package was received, false otherwise
+   */
+  bool getNextProduct(std::unique_ptr<T>& product, std::chrono::milliseconds timeout)
+  {
+    if (!queue_->waitDequeTimed(product, timeout))
+    {
+      return false;
+    }
+    recordConsumed(*product);
+    return true;
   }
 
 private:
+  static constexpr std::chrono::microseconds STOP_CHECK_INTERVAL{ 100000 };
+
   IProducer<T>& producer_;
   IConsumer<T>* consumer_;
   std::string name_;
   INotifier& notifier_;
-  moodycamel::BlockingReaderWriterQueue<std::unique_ptr<T>> queue_;
+  std::unique_ptr<ProductQueue<T>> queue_;
   std::atomic<bool> running_;
   std::thread pThread_, cThread_;
   bool producer_fifo_scheduling_;
+  std::function<bool(std::unique_ptr<T>&)> producer_callback_;
+  std::function<void()> overflow_callback_;
+  std::chrono::microseconds consumer_timeout_;
+  ThreadConfig producer_thread_config_;
+  ThreadConfig consumer_thread_config_;
+  std::shared_ptr<LatencyStatistics> latency_statistics_;
+  std::shared_ptr<ExecutionBudget> consumer_budget_;
+  std::chrono::steady_clock::time_point last_receive_time_;
+  Gauge* queue_depth_metric_;
+  Counter* dropped_metric_;
+
+  void recordProduced(T& product)
+  {
+    PackageTimestamps& timestamps = product.getTimestamps();
+    timestamps.enqueue = std::chrono::steady_clock::now();
+    if (latency_statistics_ == nullptr)
+    {
+      return;
+    }
+    const std::chrono::steady_clock::time_point unset;
+    if (timestamps.receive == unset)
+    {
+      return;
+    }
+    if (timestamps.kernel != unset)
+    {
+      latency_statistics_->kernel_to_receive.record(timestamps.receive - timestamps.kernel);
+    }
+    // Packages parsed from the same frame share their receive time.
+    if (timestamps.receive != last_receive_time_)
+    {
+      if (last_receive_time_ != unset)
+      {
+        latency_statistics_->receive_interval.record(timestamps.receive - last_receive_time_);
+      }
+      last_receive_time_ = timestamps.receive;
+    }
+    latency_statistics_->receive_to_parse.record(timestamps.parse - timestamps.receive);
+    latency_statistics_->parse_to_enqueue.record(timestamps.enqueue - timestamps.parse);
+  }
+
+  void recordConsumed(const T& product)
+  {
+    URCL_TRACE(TracePoint::PIPELINE_DEQUEUE, tracePackageId(product.getTimestamps().receive));
+    if (latency_statistics_ != nullptr)
+    {
+      latency_statistics_->enqueue_to_consume.record(std::chrono::steady_clock::now() -
+                                                     product.getTimestamps().enqueue);
+    }
+  }
 
   void runProducer()
   {
     URCL_LOG_DEBUG("Starting up producer");
-    if (producer_fifo_scheduling_)
+    if (producer_fifo_scheduling_ && producer_thread_config_.policy < 0)
     {
       pthread_t this_thread = pthread_self();
       const int max_thread_priority = sched_get_priority_max(SCHED_FIFO);
@@ -405,11 +756,24 @@ private:
 
       for (auto& p : products)
       {
-        if (!queue_.tryEnqueue(std::move(p)))
+        recordProduced(*p);
+        if (producer_callback_ && producer_callback_(p))
+        {
+          continue;
+        }
+        URCL_TRACE(TracePoint::PIPELINE_ENQUEUE, tracePackageId(p->getTimestamps().receive));
+        // Replacing the previous product is the regular operation of a single slot queue.
+        if (!queue_->enqueue(std::move(p), running_) && queue_->getPolicy() != OverflowPolicy::LATEST_ONLY)
         {
           URCL_LOG_ERROR("Pipeline producer overflowed! <%s>", name_.c_str());
+          dropped_metric_->increment();
+          if (overflow_callback_)
+          {
+            overflow_callback_();
+          }
         }
       }
+      queue_depth_metric_->set(static_cast<double>(queue_->getSize()));
 
       products.clear();
     }
@@ -420,19 +784,31 @@ private:
   void runConsumer()
   {
     std::unique_ptr<T> product;
+    // The consumer has to be updated at least as often as messages are expected, so it is updated
+    // via onTimeout if no message arrives in time. Without a timeout, the thread only wakes up
+    // periodically to notice when the pipeline is stopped.
+    const bool use_timeout = consumer_timeout_.count() > 0;
+    const std::chrono::microseconds wait_time = use_timeout ? consumer_timeout_ : STOP_CHECK_INTERVAL;
     while (running_)
     {
-      // timeout was chosen because we should receive messages
-      // at roughly 125hz (every 8ms) and have to update
-      // the controllers (i.e. the consumer) with *at least* 125Hz
-      // So we update the consumer more frequently via onTimeout
-      if (!queue_.waitDequeTimed(product, std::chrono::milliseconds(8)))
+      if (!queue_->waitDequeTimed(product, wait_time))
       {
-        consumer_->onTimeout();
+        if (use_timeout)
+        {
+          consumer_->onTimeout();
+        }
         continue;
       }
+      recordConsumed(*product);
 
-      if (!consumer_->consume(std::move(product)))
+      URCL_TRACE(TracePoint::CONSUMER_INVOKED, tracePackageId(product->getTimestamps().receive));
+      bool consumed;
+      {
+        ExecutionBudget::Measurement measurement(consumer_budget_.get());
+        consumed = consumer_->consumeProduct(product);
+      }
+      URCL_TRACE(TracePoint::CONSUMER_DONE, 0);
+      if (!consumed)
       {
         consumer_->teardownConsumer();
         running_ = false;
@@ -19,12 +19,20 @@
  */
 
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include "ur_client_library/clock.h"
 #include "ur_client_library/comm/pipeline.h"
 #include "ur_client_library/comm/parser.h"
 #include "ur_client_library/comm/stream.h"
 #include "ur_client_library/comm/package.h"
+#include "ur_client_library/comm/reconnect_backoff.h"
 #include "ur_client_library/exceptions.h"
+#include "ur_client_library/metrics.h"
+#include "ur_client_library/trace.h"
 
 namespace urcl
 {
@@ -42,18 +50,55 @@ class URProducer : public IProducer<T>
 private:
   URStream<T>& stream_;
   Parser<T>& parser_;
-  std::chrono::seconds timeout_;
+  std::function<void(const uint8_t*, size_t)> raw_frame_callback_;
+  ReconnectBackoff backoff_;
+  std::atomic<ConnectionState> connection_state_;
+  std::function<void(ConnectionState)> connection_state_callback_;
+  std::chrono::steady_clock::time_point next_reconnect_;
 
-  bool running_;
+  // Used for unbuffered reading, grows to the largest package received
+  std::vector<uint8_t> frame_buffer_;
+
+  std::atomic<bool> running_;
+  std::mutex running_mutex_;
+  std::condition_variable running_cv_;
+
+  Counter& packages_parsed_metric_;
+  Histogram& parse_time_metric_;
+  Counter& reconnects_metric_;
+  Counter& malformed_frames_metric_;
+
+  MetricLabels metricLabels() const
+  {
+    return { { "host", stream_.getHost() }, { "port", std::to_string(stream_.getPort()) } };
+  }
 
 public:
   /*!
    * \brief Creates a URProducer object, registering a stream and a parser.
    *
+   * The producer reports the number of parsed packages, the time needed to parse them, the number
+   * of skipped malformed frames and the number of reconnections to getMetricsRegistry(), labeled
+   * with the stream's host and port.
+   *
    * \param stream The stream to read from
    * \param parser The parser to use to interpret received byte information
    */
-  URProducer(URStream<T>& stream, Parser<T>& parser) : stream_(stream), parser_(parser), timeout_(1), running_(false)
+  URProducer(URStream<T>& stream, Parser<T>& parser)
+    : stream_(stream)
+    , parser_(parser)
+    , connection_state_(ConnectionState::DISCONNECTED)
+    , frame_buffer_(4096)
+    , running_(false)
+    , packages_parsed_metric_(
+          getMetricsRegistry().getCounter("urcl_packages_parsed_total", "Packages parsed from the stream", metricLabels()))
+    , parse_time_metric_(getMetricsRegistry().getHistogram("urcl_package_parse_seconds",
+                                                           "Time needed to parse a frame received from the stream",
+                                                           Histogram::defaultDurationBounds(), metricLabels()))
+    , reconnects_metric_(getMetricsRegistry().getCounter(
+          "urcl_reconnects_total", "Connections re-established after the connection was lost", metricLabels()))
+    , malformed_frames_metric_(getMetricsRegistry().getCounter(
+          "urcl_malformed_frames_total", "Truncated or malformed frames skipped by the parser", metricLabels()))
   {
   }
 
@@ -75,6 +120,8 @@ public:
     {
       throw UrException("Failed to connect to robot. Please check if the robot is booted and connected.");
     }
+    backoff_.reset();
+    setConnectionState(ConnectionState::CONNECTED);
   }
   /*!
    * \brief Tears down the producer. Currently no special handling needed.
@@ -84,11 +131,16 @@ public:
     stopProducer();
   }
   /*!
-   * \brief Stops the producer. Currently no functionality needed.
+   * \brief Stops the producer. A pending reconnection is cancelled, so tryGet() returns right
+   * away.
    */
   void stopProducer() override
   {
-    running_ = false;
+    {
+      std::lock_guard<std::mutex> lock(running_mutex_);
+      running_ = false;
+    }
+    running_cv_.notify_all();
   }
 
   void startProducer() override
@@ -96,49 +148,232 @@ public:
     running_ = true;
   }
 
+  /*!
+   * \brief Registers a callback that is called with every frame read from the stream, before it
+   * is parsed. This can be used to record the raw byte stream.
+   *
+   * This must not be called while the producer is running.
+   *
+   * \param callback Callback receiving the frame's buffer and size, nullptr to remove it
+   */
+  void setRawFrameCallback(std::function<void(const uint8_t*, size_t)> callback)
+  {
+    raw_frame_callback_ = std::move(callback);
+  }
+
+  /*!
+   * \brief Configures the delays between attempts to reconnect after the connection to the robot
+   * has been lost. By default, the delay starts at 1 second and doubles up to 2 minutes with an
+   * unlimited number of attempts. This must not be called while the producer is running.
+   *
+   * \param config The delays to use
+   */
+  void setReconnectionBackoff(const BackoffConfig& config)
+  {
+    backoff_ = ReconnectBackoff(config);
+  }
+
+  /*!
+   * \brief Registers a callback that is called whenever the connection state changes, e.g. when
+   * the connection is lost or has been re-established. It is called from the producer's thread and
+   * must return quickly. This must not be called while the producer is running.
+   *
+   * \param callback Callback receiving the new state, nullptr to remove it
+   */
+  void setConnectionStateCallback(std::function<void(ConnectionState)> callback)
+  {
+    connection_state_callback_ = std::move(callback);
+  }
+
+  /*!
+   * \brief Getter for the state of the connection to the robot.
+   *
+   * \returns The current connection state
+   */
+  ConnectionState getConnectionState() const
+  {
+    return connection_state_;
+  }
+
   /*!
    * \brief Attempts to read byte stream from the robot and parse it as a URPackage.
    *
+   * If the stream reads in chunks, all complete packages that have been received with the first
+   * one are parsed as well, so a backlog is worked off without additional reads from the socket.
+   *
+   * When the connection has been lost, every call performs one step of reconnecting: It waits
+   * until the next attempt is due, which is cancelled by stopProducer(), or makes a single
+   * connection attempt. Until the connection is re-established, calls succeed without producing
+   * packages. Once the configured number of attempts has failed, false is returned.
+   *
+   * Frames that turn out to be truncated while parsing are skipped and counted in the
+   * \c urcl_malformed_frames_total metric, without ending the pipeline.
+   *
    * \param products Unique pointer to hold the produced package
    *
    * \returns Success of reading and parsing the package
    */
   bool tryGet(std::vector<std::unique_ptr<T>>& products) override
   {
-    // TODO This function has become really ugly! That should be refactored!
+    if (connection_state_ == ConnectionState::RECONNECTING)
+    {
+      return reconnect();
+    }
 
-    // 4KB should be enough to hold any packet received from UR
-    uint8_t buf[4096];
+    uint8_t* frame = nullptr;
     size_t read = 0;
-    // expoential backoff reconnects
-    while (true)
+
+    // With buffered reading, packages are parsed in place in the stream's buffer
+    bool got_frame;
+    if (stream_.isBufferedReading())
+    {
+      got_frame = stream_.readFrame(frame, read);
+    }
+    else
+    {
+      got_frame = stream_.read(frame_buffer_, read);
+      frame = frame_buffer_.data();
+    }
+    if (got_frame)
     {
-      if (stream_.read(buf, sizeof(buf), read))
+      const auto receive_time = std::chrono::steady_clock::now();
+      const auto kernel_time = getKernelReceiveTime(receive_time);
+      bool parsed = parseFrame(frame, read, products, kernel_time, receive_time);
+      while (parsed && stream_.nextBufferedFrame(frame, read))
       {
-        // reset sleep amount
-        timeout_ = std::chrono::seconds(1);
-        BinParser bp(buf, read);
-        return parser_.parse(bp, products);
+        parsed = parseFrame(frame, read, products, kernel_time, receive_time);
       }
+      return parsed;
+    }
+
+    if (!running_)
+      return true;
+
+    if (stream_.closed())
+    {
+      setConnectionState(ConnectionState::DISCONNECTED);
+      return false;
+    }
+
+    if (stream_.getState() == SocketState::Connected)
+    {
+      // The read timed out, but the connection is still alive.
+      URCL_LOG_DEBUG("Timed out while waiting for data from %s.", stream_.getHost().c_str());
+      return true;
+    }
+
+    backoff_.reset();
+    return scheduleReconnect();
+  }
+
+private:
+  // Schedules the next reconnection attempt. Returns false if no attempts are left.
+  bool scheduleReconnect()
+  {
+    std::chrono::milliseconds delay;
+    if (!backoff_.nextDelay(delay))
+    {
+      URCL_LOG_ERROR("Failed to reconnect to %s after %zu attempts. Giving up.", stream_.getHost().c_str(),
+                     backoff_.getNumAttempts());
+      setConnectionState(ConnectionState::FAILED);
+      return false;
+    }
+    URCL_LOG_WARN("Connection to %s lost, reconnecting in %ld ms...", stream_.getHost().c_str(),
+                  static_cast<long>(delay.count()));
+    next_reconnect_ = getClock()->now() + delay;
+    setConnectionState(ConnectionState::RECONNECTING);
+    return true;
+  }
 
-      if (!running_)
+  bool reconnect()
+  {
+    {
+      std::unique_lock<std::mutex> lock(running_mutex_);
+      if (getClock()->waitUntil(running_cv_, lock, next_reconnect_, [this]() { return !running_; }))
+      {
+        // Cancelled by stopping the producer. The reconnection is continued when it is restarted.
         return true;
+      }
+    }
 
-      if (stream_.closed())
-        return false;
+    if (stream_.closed())
+    {
+      setConnectionState(ConnectionState::DISCONNECTED);
+      return false;
+    }
 
-      URCL_LOG_WARN("Failed to read from stream, reconnecting in %ld seconds...", timeout_.count());
-      std::this_thread::sleep_for(timeout_);
+    if (stream_.connect(1, std::chrono::milliseconds(0)))
+    {
+      URCL_LOG_INFO("Reconnected to %s.", stream_.getHost().c_str());
+      reconnects_metric_.increment();
+      backoff_.reset();
+      setConnectionState(ConnectionState::CONNECTED);
+      return true;
+    }
+    return scheduleReconnect();
+  }
 
-      if (stream_.connect())
-        continue;
+  void setConnectionState(const ConnectionState state)
+  {
+    if (connection_state_.exchange(state) != state && connection_state_callback_)
+    {
+      connection_state_callback_(state);
+    }
+  }
 
-      auto next = timeout_ * 2;
-      if (next <= std::chrono::seconds(120))
-        timeout_ = next;
+  bool parseFrame(uint8_t* buf, const size_t size, std::vector<std::unique_ptr<T>>& products,
+                  const std::chrono::steady_clock::time_point kernel_time,
+                  const std::chrono::steady_clock::time_point receive_time)
+  {
+    if (raw_frame_callback_)
+    {
+      raw_frame_callback_(buf, size);
     }
+    const size_t first_new = products.size();
+    BinParser bp(buf, size, BinParser::ErrorMode::STATUS);
+    const auto parse_start = std::chrono::steady_clock::now();
+    const bool parsed = parser_.parse(bp, products);
+    const auto parse_time = std::chrono::steady_clock::now();
+    parse_time_metric_.observe(parse_time - parse_start);
+    URCL_TRACE(TracePoint::PARSE_DONE, tracePackageId(receive_time));
+    if (bp.failed())
+    {
+      // A corrupted frame doesn't affect the following ones, so it is dropped as a whole.
+      products.resize(first_new);
+      malformed_frames_metric_.increment();
+      URCL_LOG_WARN("Skipping truncated frame of %zu bytes received from %s.", size, stream_.getHost().c_str());
+      return true;
+    }
+    packages_parsed_metric_.increment(products.size() - first_new);
+    stampProducts(products, first_new, kernel_time, receive_time, parse_time);
+    return parsed;
+  }
+
+  std::chrono::steady_clock::time_point getKernelReceiveTime(const std::chrono::steady_clock::time_point receive_time)
+  {
+    const auto kernel_timestamp = stream_.getLastKernelTimestamp();
+    if (kernel_timestamp == std::chrono::system_clock::time_point())
+    {
+      return std::chrono::steady_clock::time_point();
+    }
+    // The kernel timestamps using the realtime clock, move it to the monotonic clock.
+    const auto age = std::chrono::system_clock::now() - kernel_timestamp;
+    return receive_time - std::chrono::duration_cast<std::chrono::steady_clock::duration>(age);
+  }
 
-    return false;
+  void stampProducts(std::vector<std::unique_ptr<T>>& products, const size_t first,
+                     const std::chrono::steady_clock::time_point kernel_time,
+                     const std::chrono::steady_clock::time_point receive_time,
+                     const std::chrono::steady_clock::time_point parse_time)
+  {
+    for (size_t i = first; i < products.size(); ++i)
+    {
+      PackageTimestamps& timestamps = products[i]->getTimestamps();
+      timestamps.kernel = kernel_time;
+      timestamps.receive = receive_time;
+      timestamps.parse = parse_time;
+      timestamps.enqueue = std::chrono::steady_clock::time_point();
+    }
   }
 };
 }  // namespace comm
@@ -0,0 +1,388 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_PRODUCT_QUEUE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_PRODUCT_QUEUE_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "ur_client_library/queue/readerwriterqueue.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Defines what happens to products that are added to a full ProductQueue.
+ */
+enum class OverflowPolicy
+{
+  DROP_NEWEST,  ///< The new product is discarded
+  DROP_OLDEST,  ///< The oldest product in the queue is discarded to make room for the new one
+  BLOCK,        ///< The producer waits until there is room in the queue
+  LATEST_ONLY   ///< A lock-free mailbox holding only the newest product, which replaces older ones
+};
+
+/*!
+ * \brief Bounded queue handing products from a single producer thread to a single consumer thread.
+ *
+ * With the DROP_NEWEST and BLOCK policies a lock-free queue is used. As the producer cannot remove
+ * elements from it, a mutex protected queue is used for DROP_OLDEST instead. LATEST_ONLY uses a
+ * triple buffer, where the producer overwrites the newest product and the consumer swaps it out in
+ * constant time. Products replaced this way are destroyed on the producer thread only.
+ *
+ * @tparam T Type of the queued products
+ * @tparam PointerT Smart pointer type owning the queued products
+ */
+template <typename T, typename PointerT = std::unique_ptr<T>>
+class ProductQueue
+{
+public:
+  /*!
+   * \brief Creates a new ProductQueue object.
+   *
+   * \param capacity Maximum number of products in the queue, ignored for LATEST_ONLY
+   * \param policy What to do with products added to a full queue
+   */
+  ProductQueue(const size_t capacity, const OverflowPolicy policy)
+    : capacity_(policy == OverflowPolicy::LATEST_ONLY ? 1 : (capacity > 0 ? capacity : 1))
+    , policy_(policy)
+    , lock_free_queue_(usesLockedQueue() || policy == OverflowPolicy::LATEST_ONLY ? 1 : capacity_)
+    , mailbox_(0)
+    , back_(1)
+    , front_(2)
+    , producer_waiting_(false)
+    , num_dropped_(0)
+    , high_water_mark_(0)
+  {
+  }
+
+  /*!
+   * \brief Adds a product to the queue, applying the overflow policy if the queue is full.
+   *
+   * \param product The product to add
+   * \param keep_waiting With the BLOCK policy, waiting for room is aborted once this is false
+   *
+   * \returns False, if a product has been discarded, true otherwise
+   */
+  bool enqueue(PointerT&& product, const std::atomic<bool>& keep_waiting)
+  {
+    switch (policy_)
+    {
+      case OverflowPolicy::LATEST_ONLY:
+        return publish(std::move(product));
+      case OverflowPolicy::DROP_OLDEST:
+      {
+        bool dropped = false;
+        PointerT oldest;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (locked_queue_.size() >= capacity_)
+          {
+            // Destroy the product outside of the lock
+            oldest = std::move(locked_queue_.front());
+            locked_queue_.pop_front();
+            dropped = true;
+          }
+          locked_queue_.push_back(std::move(product));
+          updateHighWaterMark(locked_queue_.size());
+        }
+        cv_.notify_one();
+        if (dropped)
+        {
+          num_dropped_++;
+        }
+        return !dropped;
+      }
+      case OverflowPolicy::BLOCK:
+        while (!tryEnqueueLockFree(product))
+        {
+          if (!keep_waiting)
+          {
+            num_dropped_++;
+            return false;
+          }
+          // The consumer only signals a freed slot while the producer waits. Trying again after
+          // announcing it catches a slot freed in between.
+          producer_waiting_.store(true, std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (tryEnqueueLockFree(product))
+          {
+            producer_waiting_.store(false, std::memory_order_relaxed);
+            return true;
+          }
+          slot_freed_.wait(std::chrono::duration_cast<std::chrono::microseconds>(BLOCK_WAIT_TIMEOUT).count());
+          producer_waiting_.store(false, std::memory_order_relaxed);
+        }
+        return true;
+      case OverflowPolicy::DROP_NEWEST:
+      default:
+        if (!tryEnqueueLockFree(product))
+        {
+          num_dropped_++;
+          return false;
+        }
+        return true;
+    }
+  }
+
+  /*!
+   * \brief Takes the oldest product from the queue without waiting.
+   *
+   * With LATEST_ONLY, the product previously held by \p product is handed back to the queue
+   * instead of being destroyed, so taking products never frees memory on the consumer's thread.
+   *
+   * \param product Unique pointer to be set to the product
+   *
+   * \returns True if a product was taken from the queue, false if it was empty
+   */
+  bool tryDequeue(PointerT& product)
+  {
+    if (policy_ == OverflowPolicy::LATEST_ONLY)
+    {
+      return take(product);
+    }
+    if (!usesLockedQueue())
+    {
+      return freedSlot(lock_free_queue_.tryDequeue(product));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return popLocked(product);
+  }
+
+  /*!
+   * \brief Takes the oldest product from the queue, waiting for one if the queue is empty. See
+   * tryDequeue() for how the previous product is handled with LATEST_ONLY.
+   *
+   * \param product Unique pointer to be set to the product
+   * \param timeout Maximum time to wait for a product
+   *
+   * \returns True if a product was taken from the queue, false on timeout
+   */
+  template <typename Rep, typename Period>
+  bool waitDequeTimed(PointerT& product, const std::chrono::duration<Rep, Period>& timeout)
+  {
+    if (policy_ == OverflowPolicy::LATEST_ONLY)
+    {
+      return waitAndTake(product, timeout);
+    }
+    if (!usesLockedQueue())
+    {
+      return freedSlot(lock_free_queue_.waitDequeTimed(product, timeout));
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout, [this]() { return !locked_queue_.empty(); });
+    return popLocked(product);
+  }
+
+  /*!
+   * \brief Getter for the maximum number of products in the queue.
+   */
+  size_t getCapacity() const
+  {
+    return capacity_;
+  }
+
+  /*!
+   * \brief Getter for the overflow policy.
+   */
+  OverflowPolicy getPolicy() const
+  {
+    return policy_;
+  }
+
+  /*!
+   * \brief Getter for the number of products discarded because the queue was full.
+   */
+  uint64_t getNumDropped() const
+  {
+    return num_dropped_;
+  }
+
+  /*!
+   * \brief Getter for the number of products currently in the queue. The consumer might take
+   * products concurrently, so the result is approximate.
+   */
+  size_t getSize()
+  {
+    if (policy_ == OverflowPolicy::LATEST_ONLY)
+    {
+      return (mailbox_.load(std::memory_order_acquire) & FRESH) ? 1 : 0;
+    }
+    if (!usesLockedQueue())
+    {
+      return lock_free_queue_.sizeApprox();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return locked_queue_.size();
+  }
+
+  /*!
+   * \brief Getter for the largest number of products that have been in the queue at the same time.
+   */
+  size_t getHighWaterMark() const
+  {
+    return high_water_mark_;
+  }
+
+private:
+  // The mailbox stores the index of the slot shared between producer and consumer, with this flag
+  // set if the slot holds a product the consumer hasn't taken yet.
+  static constexpr uint8_t FRESH = 4;
+  static constexpr uint8_t INDEX_MASK = 3;
+  // A producer blocked by a full queue checks whether to keep waiting at least this often
+  static constexpr std::chrono::milliseconds BLOCK_WAIT_TIMEOUT{ 10 };
+
+  bool usesLockedQueue() const
+  {
+    return policy_ == OverflowPolicy::DROP_OLDEST;
+  }
+
+  bool publish(PointerT&& product)
+  {
+    // This destroys a product the consumer has handed back, if any.
+    slots_[back_] = std::move(product);
+    const uint8_t previous = mailbox_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+    back_ = previous & INDEX_MASK;
+    updateHighWaterMark(1);
+    if (previous & FRESH)
+    {
+      num_dropped_++;
+      return false;
+    }
+    ready_.signal();
+    return true;
+  }
+
+  bool take(PointerT& product)
+  {
+    if (!(mailbox_.load(std::memory_order_acquire) & FRESH))
+    {
+      return false;
+    }
+    // Only the producer changes the mailbox otherwise, which keeps it fresh.
+    front_ = mailbox_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+    std::swap(product, slots_[front_]);
+    return true;
+  }
+
+  template <typename Rep, typename Period>
+  bool waitAndTake(PointerT& product, const std::chrono::duration<Rep, Period>& timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!take(product))
+    {
+      const auto remaining =
+          std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+      // The semaphore may still be signaled for a product that has been taken already.
+      if (remaining.count() <= 0 || !ready_.wait(remaining.count()))
+      {
+        return take(product);
+      }
+    }
+    return true;
+  }
+
+  // Wakes up a producer waiting for room if a product has been taken
+  bool freedSlot(const bool dequeued)
+  {
+    if (!dequeued || policy_ != OverflowPolicy::BLOCK)
+    {
+      return dequeued;
+    }
+    // Pairs with the fence of the producer, so either it sees the slot or this sees it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producer_waiting_.load(std::memory_order_relaxed) && producer_waiting_.exchange(false))
+    {
+      slot_freed_.signal();
+    }
+    return dequeued;
+  }
+
+  bool tryEnqueueLockFree(PointerT& product)
+  {
+    // The lock-free queue may have room for more than the requested capacity.
+    const size_t size = lock_free_queue_.sizeApprox();
+    if (size >= capacity_ || !lock_free_queue_.tryEnqueue(std::move(product)))
+    {
+      return false;
+    }
+    updateHighWaterMark(size + 1);
+    return true;
+  }
+
+  bool popLocked(PointerT& product)
+  {
+    if (locked_queue_.empty())
+    {
+      return false;
+    }
+    product = std::move(locked_queue_.front());
+    locked_queue_.pop_front();
+    return true;
+  }
+
+  void updateHighWaterMark(const size_t size)
+  {
+    // Only the producer thread updates the high-water mark.
+    if (size > high_water_mark_)
+    {
+      high_water_mark_ = size;
+    }
+  }
+
+  const size_t capacity_;
+  const OverflowPolicy policy_;
+  moodycamel::BlockingReaderWriterQueue<PointerT> lock_free_queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<PointerT> locked_queue_;
+  PointerT slots_[3];
+  std::atomic<uint8_t> mailbox_;
+  uint8_t back_;
+  uint8_t front_;
+  moodycamel::spsc_sema::LightweightSemaphore ready_;
+  // Signaled by the consumer for a producer waiting with the BLOCK policy
+  moodycamel::spsc_sema::LightweightSemaphore slot_freed_;
+  std::atomic<bool> producer_waiting_;
+  std::atomic<uint64_t> num_dropped_;
+  std::atomic<size_t> high_water_mark_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_PRODUCT_QUEUE_H_INCLUDED
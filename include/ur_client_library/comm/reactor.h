@@ -0,0 +1,313 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_REACTOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_REACTOR_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ur_client_library/comm/notifying_future.h"
+#include "ur_client_library/helpers.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Event loop multiplexing the sockets of many components on a few threads.
+ *
+ * Instead of running one thread per socket server, components register their file descriptors
+ * together with a callback that is called on the loop thread whenever the descriptor is readable.
+ * The reactor runs a configurable number of loops, each with its own thread and epoll instance.
+ * Every component gets one loop assigned using assignLoop() and registers all of its descriptors on
+ * that loop, so its callbacks are never called concurrently.
+ *
+ * Callbacks have to return quickly, as they block all other descriptors of their loop.
+ *
+ * Besides descriptors, functions can be posted to a loop, optionally delayed, and continuations
+ * can be attached to futures. This allows driving many concurrent operations, e.g. the motions of
+ * all robots of a cell, from a single loop thread without blocking it.
+ */
+class Reactor
+{
+public:
+  //! Callback called on the loop thread when a file descriptor is readable
+  using Callback = std::function<void()>;
+  //! Function posted to an event loop
+  using Task = std::function<void()>;
+  //! Default period for checking whether a std::future passed to whenReady() is ready
+  static constexpr std::chrono::milliseconds DEFAULT_POLL_PERIOD{ 1 };
+
+  /*!
+   * \brief Creates a reactor and starts its loop threads.
+   *
+   * \param num_loops Number of event loops and therefore threads. Has to be at least 1.
+   */
+  explicit Reactor(const size_t num_loops = 1);
+  Reactor(const Reactor&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+
+  /*!
+   * \brief Stops and joins all loop threads. All components have to remove their file descriptors
+   * before. Posted functions that haven't been called yet are discarded.
+   */
+  ~Reactor();
+
+  /*!
+   * \brief Assigns an event loop to a component. Loops are assigned in turns.
+   *
+   * \returns The index of the loop the component should register its descriptors on
+   */
+  size_t assignLoop();
+
+  /*!
+   * \brief Registers a file descriptor on an event loop.
+   *
+   * This can be called from any thread, including the loop's callbacks.
+   *
+   * \param loop Index of the loop as returned by assignLoop()
+   * \param fd The file descriptor to watch for readability
+   * \param callback Called on the loop thread whenever the descriptor is readable
+   *
+   * \returns True on success, false if the descriptor couldn't be registered
+   */
+  bool add(const size_t loop, const int fd, Callback callback);
+
+  /*!
+   * \brief Removes a file descriptor from an event loop. The descriptor has to be removed before it
+   * is closed.
+   *
+   * When called from another thread than the loop's, this waits for a callback of the loop that is
+   * currently running to finish, so afterwards the callback is guaranteed not to be called anymore.
+   *
+   * \param loop Index of the loop the descriptor has been registered on
+   * \param fd The file descriptor to remove
+   */
+  void remove(const size_t loop, const int fd);
+
+  /*!
+   * \brief Calls a function while no callback of an event loop is running.
+   *
+   * This allows changing state shared with the loop's callbacks from another thread, e.g. to
+   * register or remove several descriptors at once.
+   *
+   * \param loop Index of the loop to synchronize with
+   * \param function The function to call
+   */
+  void synchronize(const size_t loop, const std::function<void()>& function);
+
+  /*!
+   * \brief Calls a function on the thread of an event loop.
+   *
+   * This can be called from any thread, including the loop's callbacks, e.g. to hand the results of
+   * callbacks called on other threads, like UrDriver::registerTrajectoryDoneCallback(), over to the
+   * loop. Posted functions are called in the order they have been posted.
+   *
+   * \param loop Index of the loop to call the function on
+   * \param task The function to call
+   */
+  void post(const size_t loop, Task task);
+
+  /*!
+   * \brief Calls a function on the thread of an event loop once a delay has passed.
+   *
+   * \param loop Index of the loop to call the function on
+   * \param delay Time to wait before calling the function. Delays are rounded up to milliseconds.
+   * \param task The function to call
+   */
+  void postDelayed(const size_t loop, const std::chrono::steady_clock::duration delay, Task task);
+
+  /*!
+   * \brief Calls a continuation on the thread of an event loop once a future is ready.
+   *
+   * The futures returned by the library's asynchronous functions, e.g.
+   * InstructionExecutor::executeMotionAsync(), are NotifyingFutures. The thread completing them
+   * posts the continuation to the loop, so waiting costs the loop nothing. The continuation is
+   * called with the ready future, so it can take its value or exception using get().
+   *
+   * \param loop Index of the loop to call the continuation on
+   * \param future The future to wait for
+   * \param continuation Function taking a std::future<T>&
+   */
+  template <typename T, typename Continuation>
+  void whenReady(const size_t loop, NotifyingFuture<T> future, Continuation continuation)
+  {
+    auto shared_future = std::make_shared<NotifyingFuture<T>>(std::move(future));
+    auto shared_continuation = std::make_shared<Continuation>(std::move(continuation));
+    // The callback is released once the future is ready, so the future referencing it isn't leaked
+    shared_future->onReady([guard = post_guard_, loop, shared_future, shared_continuation]() {
+      std::lock_guard<std::mutex> lock(guard->mutex);
+      if (guard->reactor != nullptr)
+      {
+        guard->reactor->post(loop, [shared_future, shared_continuation]() {
+          std::future<T>& ready = *shared_future;
+          (*shared_continuation)(ready);
+        });
+      }
+    });
+  }
+
+  /*!
+   * \brief Calls a continuation on the thread of an event loop once a std::future is ready.
+   *
+   * Futures not created by the library don't notify anyone, so the loop checks the future
+   * periodically without blocking. Prefer the overload taking a NotifyingFuture where possible.
+   *
+   * \param loop Index of the loop to call the continuation on
+   * \param future The future to wait for
+   * \param continuation Function taking a std::future<T>&
+   * \param poll_period Period of checking whether the future is ready
+   */
+  template <typename T, typename Continuation>
+  void whenReady(const size_t loop, std::future<T> future, Continuation continuation,
+                 const std::chrono::milliseconds poll_period = DEFAULT_POLL_PERIOD)
+  {
+    post(loop, FutureWaiter<T, Continuation>{ this, loop, std::make_shared<std::future<T>>(std::move(future)),
+                                              std::make_shared<Continuation>(std::move(continuation)), poll_period });
+  }
+
+  /*!
+   * \brief Getter for the number of event loops.
+   *
+   * \returns The number of loops and therefore threads of the reactor
+   */
+  size_t getNumLoops() const
+  {
+    return loops_.size();
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of all loop threads. A name given in the config
+   * is extended with the index of the loop.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of a single loop thread, e.g. to pin every loop
+   * to a core of its own.
+   *
+   * \param loop Index of the loop
+   * \param config The thread settings
+   */
+  void setLoopThreadConfig(const size_t loop, const ThreadConfig& config);
+
+private:
+  // Calls the continuation once the future is ready, posts itself again otherwise
+  template <typename T, typename Continuation>
+  struct FutureWaiter
+  {
+    Reactor* reactor;
+    size_t loop;
+    std::shared_ptr<std::future<T>> future;
+    std::shared_ptr<Continuation> continuation;
+    std::chrono::milliseconds poll_period;
+
+    void operator()() const
+    {
+      if (future->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      {
+        (*continuation)(*future);
+        return;
+      }
+      reactor->postDelayed(loop, poll_period, *this);
+    }
+  };
+
+  // Lets completed futures post their continuations only as long as the reactor exists
+  struct PostGuard
+  {
+    std::mutex mutex;
+    Reactor* reactor = nullptr;
+  };
+
+  struct Handler
+  {
+    uint32_t generation;
+    Callback callback;
+  };
+
+  struct Timer
+  {
+    std::chrono::steady_clock::time_point due;
+    // Keeps timers due at the same time in the order they have been posted
+    uint64_t sequence;
+    Task task;
+
+    bool operator>(const Timer& other) const
+    {
+      return due > other.due || (due == other.due && sequence > other.sequence);
+    }
+  };
+
+  struct Loop
+  {
+    int epoll_fd = -1;
+    int wakeup_fd = -1;
+    std::thread thread;
+    // Held while dispatching events, so removing a descriptor can wait for its callback to finish.
+    std::recursive_mutex mutex;
+    std::unordered_map<int, Handler> handlers;
+    uint32_t next_generation = 0;
+    std::mutex tasks_mutex;
+    std::vector<Task> tasks;
+    // Min-heap ordered by due time
+    std::vector<Timer> timers;
+    uint64_t next_timer_sequence = 0;
+  };
+
+  void run(Loop& loop);
+  void dispatch(Loop& loop, const uint64_t data);
+  void wakeUp(Loop& loop);
+  //! Returns the timeout for epoll_wait() in milliseconds, -1 if nothing is pending
+  int nextTimeout(Loop& loop);
+  //! Calls the posted functions and the due timers, has to be called with the loop's mutex locked
+  void runTasks(Loop& loop);
+
+  std::shared_ptr<PostGuard> post_guard_;
+  std::vector<std::unique_ptr<Loop>> loops_;
+  std::atomic<bool> keep_running_;
+  std::atomic<size_t> next_loop_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_REACTOR_H_INCLUDED
@@ -0,0 +1,131 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RECONNECT_BACKOFF_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RECONNECT_BACKOFF_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief State of the connection of a producer to the robot.
+ */
+enum class ConnectionState
+{
+  DISCONNECTED,  ///< Not connected yet or stopped
+  CONNECTED,     ///< Connected and receiving data
+  RECONNECTING,  ///< Connection lost, waiting for the next reconnection attempt
+  FAILED         ///< All reconnection attempts failed
+};
+
+/*!
+ * \brief Configuration of the delays between reconnection attempts.
+ *
+ * The delay starts at initial_delay and is multiplied by multiplier after every failed attempt,
+ * until it reaches max_delay. Every delay is randomly varied by up to the jitter fraction, so many
+ * clients losing their connection at the same time don't reconnect in lockstep.
+ */
+struct BackoffConfig
+{
+  //! Delay before the first reconnection attempt
+  std::chrono::milliseconds initial_delay{ 1000 };
+  //! Upper limit of the delay
+  std::chrono::milliseconds max_delay{ 120000 };
+  //! Factor the delay grows by after each failed attempt
+  double multiplier = 2.0;
+  //! Relative random variation of each delay in the range [0, 1]
+  double jitter = 0.0;
+  //! Number of attempts before giving up. Unlimited attempts when set to 0.
+  size_t max_attempts = 0;
+};
+
+/*!
+ * \brief Computes the delays between reconnection attempts following a BackoffConfig.
+ */
+class ReconnectBackoff
+{
+public:
+  /*!
+   * \brief Creates a backoff starting at the configured initial delay.
+   *
+   * \param config The delays to use
+   */
+  explicit ReconnectBackoff(const BackoffConfig& config = BackoffConfig());
+
+  /*!
+   * \brief Computes the delay before the next attempt and counts the attempt.
+   *
+   * \param[out] delay Time to wait before the next attempt
+   *
+   * \returns False, if the maximum number of attempts has been reached
+   */
+  bool nextDelay(std::chrono::milliseconds& delay);
+
+  /*!
+   * \brief Starts over at the initial delay, e.g. after a connection has been established.
+   */
+  void reset();
+
+  /*!
+   * \brief Getter for the number of attempts since the last reset.
+   *
+   * \returns The number of attempts
+   */
+  size_t getNumAttempts() const
+  {
+    return num_attempts_;
+  }
+
+  /*!
+   * \brief Getter for the configuration used.
+   *
+   * \returns The configuration
+   */
+  const BackoffConfig& getConfig() const
+  {
+    return config_;
+  }
+
+private:
+  BackoffConfig config_;
+  double current_delay_ms_;
+  size_t num_attempts_;
+  std::mt19937 random_engine_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_RECONNECT_BACKOFF_H_INCLUDED
@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/parser.h"
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/log.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief A producer that feeds recorded frames through a Parser instead of reading them from the
+ * robot. Together with a Pipeline this allows running consumers on recorded data offline, either
+ * as fast as possible or paced to the times the frames were originally received.
+ *
+ * Frames are read from a recording written by rtde_interface::RTDERecorder. When replaying RTDE
+ * data, the parser should be created from the recording's recipe and protocol version. Frames of
+ * other streams, e.g. the primary interface, can be recorded in the same format using
+ * URProducer::setRawFrameCallback() and an empty recipe.
+ *
+ * Once the end of the recording is reached, tryGet() returns false, which stops the pipeline.
+ *
+ * @tparam T Type of the produced packages
+ */
+template <typename T>
+class ReplayProducer : public IProducer<T>
+{
+public:
+  ReplayProducer() = delete;
+
+  /*!
+   * \brief Creates a new ReplayProducer object.
+   *
+   * \param recording The recording to replay. It has to outlive the producer.
+   * \param parser The parser to use to interpret the recorded frames
+   * \param speed Replay speed relative to the original timing, e.g. 2.0 replays twice as fast as
+   * the frames were received. Frames are produced as fast as possible when set to 0.
+   */
+  ReplayProducer(rtde_interface::RTDERecording& recording, Parser<T>& parser, const double speed = 0.0)
+    : recording_(recording), parser_(parser), speed_(speed), first_frame_(true)
+  {
+  }
+
+  /*!
+   * \brief Restarts the replay at the beginning of the recording.
+   *
+   * \param max_num_tries Unused, as there is no connection to set up
+   * \param reconnection_time Unused, as there is no connection to set up
+   */
+  void setupProducer(const size_t max_num_tries = 0,
+                     const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10)) override
+  {
+    recording_.rewind();
+    first_frame_ = true;
+  }
+
+  /*!
+   * \brief Reads the next frame from the recording and parses it.
+   *
+   * If a replay speed is configured, this blocks until the frame is due.
+   *
+   * \param products Vector to be filled with the parsed packages
+   *
+   * \returns False once the end of the recording is reached or a frame couldn't be parsed
+   */
+  bool tryGet(std::vector<std::unique_ptr<T>>& products) override
+  {
+    rtde_interface::RTDERecording::Frame frame;
+    if (!recording_.next(frame))
+    {
+      URCL_LOG_INFO("Reached the end of the recording.");
+      return false;
+    }
+    if (speed_ > 0.0)
+    {
+      waitForFrame(frame.receive_time);
+    }
+
+    // Parse from a copy, just like frames read from the socket
+    if (buf_.size() < frame.size)
+    {
+      buf_.resize(frame.size);
+    }
+    std::memcpy(buf_.data(), frame.data, frame.size);
+    BinParser bp(buf_.data(), frame.size, BinParser::ErrorMode::STATUS);
+    return parser_.parse(bp, products);
+  }
+
+private:
+  void waitForFrame(const std::chrono::system_clock::time_point receive_time)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (first_frame_)
+    {
+      first_frame_ = false;
+      replay_start_ = now;
+      recording_start_ = receive_time;
+      return;
+    }
+    const auto offset = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(receive_time - recording_start_) / speed_);
+    std::this_thread::sleep_until(replay_start_ + offset);
+  }
+
+  rtde_interface::RTDERecording& recording_;
+  Parser<T>& parser_;
+  double speed_;
+  bool first_frame_;
+  std::chrono::steady_clock::time_point replay_start_;
+  std::chrono::system_clock::time_point recording_start_;
+  // Grows to the largest frame replayed
+  std::vector<uint8_t> buf_;
+};
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
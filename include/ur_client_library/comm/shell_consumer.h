@@ -63,6 +63,19 @@ public:
     return true;
   }
 
+  /*!
+   * \brief Consumes a package, writing a human readable representation to the logging.
+   *
+   * \param product The package to consume
+   *
+   * \returns True if the output was successful
+   */
+  virtual bool consumeProduct(std::unique_ptr<T>& product)
+  {
+    URCL_LOG_INFO("%s", product->toString().c_str());
+    return true;
+  }
+
 private:
   /* data */
 };
@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STATIC_CONSUMER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STATIC_CONSUMER_H_INCLUDED
+
+#include <memory>
+
+#include "ur_client_library/comm/pipeline.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Tells whether a product is an object of the package class \p PackageT.
+ *
+ * Specializations provide a static function \p matches(const BaseT& product) for each package
+ * class, which checks the type information stored in the product itself, so no RTTI is needed.
+ * The primary and RTDE interfaces provide specializations for their package classes.
+ *
+ * @tparam PackageT Package class to recognize
+ */
+template <typename PackageT>
+struct PackageClassTraits;
+
+/*!
+ * \brief Consumer calling statically dispatched handlers for a fixed set of package classes.
+ *
+ * For each product, the classes in \p HandledT are checked in the given order using
+ * PackageClassTraits and the first match is handed to Derived::handle() as a reference to that
+ * class. As Derived is known at compile time, the handlers are called without virtual dispatch and
+ * can be inlined. Products of other classes are handed to Derived::handleOther(), which ignores
+ * them by default.
+ *
+ * \code{.cpp}
+ * class KinematicsConsumer : public comm::StaticConsumer<KinematicsConsumer, PrimaryPackage, KinematicsInfo>
+ * {
+ * public:
+ *   bool handle(KinematicsInfo& info)
+ *   {
+ *     // ...
+ *     return true;
+ *   }
+ * };
+ * \endcode
+ *
+ * @tparam Derived The consumer class deriving from this class
+ * @tparam T Type of the consumed products
+ * @tparam HandledT Package classes Derived provides a handle() function for
+ */
+template <typename Derived, typename T, typename... HandledT>
+class StaticConsumer : public IConsumer<T>
+{
+public:
+  virtual ~StaticConsumer() = default;
+
+  /*!
+   * \brief Dispatches a product to the matching handler.
+   *
+   * \param product Shared pointer to the product to be consumed
+   *
+   * \returns The result of the handler
+   */
+  bool consume(std::shared_ptr<T> product) override
+  {
+    return product == nullptr || dispatch(*product);
+  }
+
+  /*!
+   * \brief Dispatches a product owned by the pipeline to the matching handler.
+   *
+   * \param product The product to be consumed
+   *
+   * \returns The result of the handler
+   */
+  bool consumeProduct(std::unique_ptr<T>& product) override
+  {
+    return product == nullptr || dispatch(*product);
+  }
+
+  /*!
+   * \brief Calls the handler matching the product's class.
+   *
+   * \param product The product to dispatch
+   *
+   * \returns The result of the handler
+   */
+  bool dispatch(T& product)
+  {
+    bool result = true;
+    const bool handled = (tryHandle<HandledT>(product, result) || ...);
+    if (!handled)
+    {
+      result = static_cast<Derived*>(this)->handleOther(product);
+    }
+    return result;
+  }
+
+  /*!
+   * \brief Handles products of classes not listed in \p HandledT. Derived classes may provide their
+   * own handleOther() to replace this.
+   *
+   * \returns True, as the product is ignored
+   */
+  bool handleOther(T& /*product*/)
+  {
+    return true;
+  }
+
+private:
+  template <typename PackageT>
+  bool tryHandle(T& product, bool& result)
+  {
+    if (!PackageClassTraits<PackageT>::matches(product))
+    {
+      return false;
+    }
+    result = static_cast<Derived*>(this)->handle(static_cast<PackageT&>(product));
+    return true;
+  }
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_STATIC_CONSUMER_H_INCLUDED
@@ -24,8 +24,11 @@
 #include <sys/types.h>
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include <vector>
+#include "ur_client_library/helpers.h"
 #include "ur_client_library/log.h"
 #include "ur_client_library/comm/tcp_socket.h"
 
@@ -50,10 +53,17 @@ public:
    * \param host IP address of the remote host
    * \param port Port on which the socket shall be connected
    */
-  URStream(const std::string& host, int port) : host_(host), port_(port)
+  URStream(const std::string& host, int port)
+    : host_(host), port_(port), buffered_(false), buffer_begin_(0), buffer_end_(0)
   {
   }
 
+  //! Size of the buffer used for buffered reading
+  static constexpr size_t READ_BUFFER_SIZE = 65536;
+
+  //! Largest package accepted. This protects the buffers from growing due to a corrupt length field.
+  static constexpr size_t MAX_PACKAGE_SIZE = 1 << 20;
+
   /*!
    * \brief Connects to the configured socket.
    *
@@ -66,6 +76,7 @@ public:
   bool connect(const size_t max_num_tries = 0,
                const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10))
   {
+    clearReadBuffer();
     return TCPSocket::setup(host_, port_, max_num_tries, reconnection_time);
   }
 
@@ -100,7 +111,93 @@ public:
   bool read(uint8_t* buf, const size_t buf_len, size_t& read);
 
   /*!
-   * \brief Writes directly to the underlying socket (with a mutex guard)
+   * \brief Reads a full UR package out of a socket into a buffer that grows as required.
+   *
+   * The buffer is only enlarged if the package does not fit, so a buffer reused for all reads
+   * grows once to the largest package received and no allocations happen afterwards.
+   *
+   * \param[in,out] buf The buffer where the content shall be stored
+   * \param[out] read Number of bytes actually read from the socket
+   *
+   * \returns True on success, false on error, e.g. the package exceeds MAX_PACKAGE_SIZE
+   */
+  bool read(std::vector<uint8_t>& buf, size_t& read);
+
+  /*!
+   * \brief Enables reading from the socket in large chunks.
+   *
+   * Without buffering, every package costs at least two reads from the socket, one for the length
+   * field and one for the rest of it. With buffering, as many bytes as available are read into a
+   * buffer of READ_BUFFER_SIZE bytes at once and read() hands out one package after the other
+   * from the buffer. The buffer grows for larger packages up to MAX_PACKAGE_SIZE. Use
+   * hasBufferedPackage() to check whether the next package can be read without accessing the
+   * socket. Partially received packages are kept in the buffer when a read times out. This must not
+   * be called while the stream is connected.
+   *
+   * \param buffered True to read in chunks, false to read every package separately
+   */
+  void setBufferedReading(const bool buffered)
+  {
+    std::lock_guard<PriorityInheritanceMutex> lock(read_mutex_);
+    buffered_ = buffered;
+    read_buffer_.assign(buffered ? READ_BUFFER_SIZE : 0, 0);
+    buffer_begin_ = 0;
+    buffer_end_ = 0;
+  }
+
+  /*!
+   * \brief Getter for whether the stream reads in chunks.
+   *
+   * \returns True if buffered reading is enabled
+   */
+  bool isBufferedReading() const
+  {
+    return buffered_;
+  }
+
+  /*!
+   * \brief Checks whether a complete package has been buffered, so it can be read without
+   * accessing the socket.
+   *
+   * \returns True if the next call to read() returns a package from the buffer
+   */
+  bool hasBufferedPackage()
+  {
+    std::lock_guard<PriorityInheritanceMutex> lock(read_mutex_);
+    return findBufferedPackage() > 0;
+  }
+
+  /*!
+   * \brief Reads the next package without copying it out of the read buffer.
+   *
+   * This works like read(), but hands out a view of the package inside the stream's buffer, so it
+   * can be parsed in place. The view is valid until the next call to any of the reading functions.
+   * To save the lock taken by read(), this is meant for a single reading thread and must not be
+   * called concurrently with other reading functions. Buffered reading has to be enabled.
+   *
+   * \param[out] frame Start of the package in the read buffer
+   * \param[out] length Length of the package in bytes
+   *
+   * \returns True on success, false on error or if buffered reading is disabled
+   */
+  bool readFrame(uint8_t*& frame, size_t& length);
+
+  /*!
+   * \brief Hands out the next package from the read buffer without accessing the socket.
+   *
+   * The same rules as for readFrame() apply.
+   *
+   * \param[out] frame Start of the package in the read buffer
+   * \param[out] length Length of the package in bytes
+   *
+   * \returns True if a complete package was buffered, false otherwise
+   */
+  bool nextBufferedFrame(uint8_t*& frame, size_t& length);
+
+  /*!
+   * \brief Writes directly to the underlying socket. Concurrent writers are serialized by a
+   * priority inheritance mutex, so a real-time writer isn't delayed by lower priority threads
+   * holding it for long.
    *
    * \param[in] buf Byte stream that should be sent
    * \param[in] buf_len Number of bytes in buffer
@@ -115,28 +212,59 @@ public:
    *
    * \returns The host IP
    */
-  std::string getHost()
+  std::string getHost() const
   {
     return host_;
   }
 
+  /*!
+   * \brief Get the port
+   *
+   * \returns The port connected to
+   */
+  int getPort() const
+  {
+    return port_;
+  }
+
 private:
+  // Length of the complete package at the beginning of the buffer, 0 if there is none
+  size_t findBufferedPackage();
+  // Reads from the socket until a complete package is at the beginning of the buffer
+  bool fillBuffer(size_t& package_length);
+  bool readBuffered(uint8_t* buf, const size_t buf_len, size_t& total);
+  void clearReadBuffer()
+  {
+    std::lock_guard<PriorityInheritanceMutex> lock(read_mutex_);
+    buffer_begin_ = 0;
+    buffer_end_ = 0;
+  }
+
   std::string host_;
   int port_;
-  std::mutex write_mutex_, read_mutex_;
+  // Shared by real-time threads, e.g. the RTDE writer, and handshakes from other threads
+  PriorityInheritanceMutex write_mutex_, read_mutex_;
+  bool buffered_;
+  std::vector<uint8_t> read_buffer_;
+  size_t buffer_begin_;
+  size_t buffer_end_;
 };
 
 template <typename T>
 bool URStream<T>::write(const uint8_t* buf, const size_t buf_len, size_t& written)
 {
-  std::lock_guard<std::mutex> lock(write_mutex_);
+  std::lock_guard<PriorityInheritanceMutex> lock(write_mutex_);
   return TCPSocket::write(buf, buf_len, written);
 }
 
 template <typename T>
 bool URStream<T>::read(uint8_t* buf, const size_t buf_len, size_t& total)
 {
-  std::lock_guard<std::mutex> lock(read_mutex_);
+  std::lock_guard<PriorityInheritanceMutex> lock(read_mutex_);
+  if (buffered_)
+  {
+    return readBuffered(buf, buf_len, total);
+  }
 
   bool initial = true;
   uint8_t* buf_pos = buf;
@@ -163,5 +291,174 @@ bool URStream<T>::read(uint8_t* buf, const size_t buf_len, size_t& total)
 
   return remainder == 0;
 }
+
+template <typename T>
+bool URStream<T>::read(std::vector<uint8_t>& buf, size_t& total)
+{
+  std::lock_guard<PriorityInheritanceMutex> lock(read_mutex_);
+  const size_t header_size = sizeof(typename T::HeaderType::_package_size_type);
+  size_t package_length = 0;
+  if (buffered_)
+  {
+    if (!fillBuffer(package_length))
+    {
+      return false;
+    }
+    if (buf.size() < package_length)
+    {
+      buf.resize(package_length);
+    }
+    std::memcpy(buf.data(), read_buffer_.data() + buffer_begin_, package_length);
+    buffer_begin_ += package_length;
+    total += package_length;
+    return true;
+  }
+
+  if (buf.size() < header_size)
+  {
+    buf.resize(header_size);
+  }
+  size_t received = 0;
+  size_t read = 0;
+  while (received < header_size)
+  {
+    if (!TCPSocket::read(buf.data() + received, header_size - received, read))
+    {
+      return false;
+    }
+    received += read;
+  }
+
+  package_length = T::HeaderType::getPackageLength(buf.data());
+  if (package_length < header_size || package_length > MAX_PACKAGE_SIZE)
+  {
+    URCL_LOG_ERROR("Packet size %zu is invalid, discarding.", package_length);
+    return false;
+  }
+  if (buf.size() < package_length)
+  {
+    buf.resize(package_length);
+  }
+
+  while (received < package_length)
+  {
+    if (!TCPSocket::read(buf.data() + received, package_length - received, read))
+    {
+      return false;
+    }
+    received += read;
+  }
+  total += package_length;
+  return true;
+}
+
+template <typename T>
+size_t URStream<T>::findBufferedPackage()
+{
+  const size_t available = buffer_end_ - buffer_begin_;
+  if (available < sizeof(typename T::HeaderType::_package_size_type))
+  {
+    return 0;
+  }
+  const size_t package_length = T::HeaderType::getPackageLength(read_buffer_.data() + buffer_begin_);
+  return package_length <= available ? package_length : 0;
+}
+
+template <typename T>
+bool URStream<T>::fillBuffer(size_t& package_length)
+{
+  while (true)
+  {
+    const size_t available = buffer_end_ - buffer_begin_;
+    if (available >= sizeof(typename T::HeaderType::_package_size_type))
+    {
+      package_length = T::HeaderType::getPackageLength(read_buffer_.data() + buffer_begin_);
+      if (package_length > MAX_PACKAGE_SIZE || package_length < sizeof(typename T::HeaderType::_package_size_type))
+      {
+        URCL_LOG_ERROR("Packet size %zu is invalid, discarding buffered data.", package_length);
+        buffer_begin_ = 0;
+        buffer_end_ = 0;
+        return false;
+      }
+      if (package_length <= available)
+      {
+        return true;
+      }
+      if (package_length > read_buffer_.size())
+      {
+        // Grow once, the buffer is reused for all following packages
+        read_buffer_.resize(package_length);
+      }
+    }
+
+    // Move the incomplete package to the front to make room for the rest of it
+    if (buffer_begin_ > 0)
+    {
+      std::memmove(read_buffer_.data(), read_buffer_.data() + buffer_begin_, available);
+      buffer_begin_ = 0;
+      buffer_end_ = available;
+    }
+    size_t read = 0;
+    if (!TCPSocket::read(read_buffer_.data() + buffer_end_, read_buffer_.size() - buffer_end_, read))
+    {
+      return false;
+    }
+    buffer_end_ += read;
+  }
+}
+
+template <typename T>
+bool URStream<T>::readBuffered(uint8_t* buf, const size_t buf_len, size_t& total)
+{
+  size_t package_length = 0;
+  if (!fillBuffer(package_length))
+  {
+    return false;
+  }
+  if (package_length >= buf_len)
+  {
+    URCL_LOG_ERROR("Packet size %zu doesn't fit into buffer %zu, discarding.", package_length, buf_len);
+    buffer_begin_ += package_length;
+    return false;
+  }
+  std::memcpy(buf, read_buffer_.data() + buffer_begin_, package_length);
+  buffer_begin_ += package_length;
+  total += package_length;
+  return true;
+}
+
+template <typename T>
+bool URStream<T>::readFrame(uint8_t*& frame, size_t& length)
+{
+  if (!buffered_)
+  {
+    URCL_LOG_ERROR("Reading frames in place requires buffered reading.");
+    return false;
+  }
+  if (!fillBuffer(length))
+  {
+    return false;
+  }
+  frame = read_buffer_.data() + buffer_begin_;
+  buffer_begin_ += length;
+  return true;
+}
+
+template <typename T>
+bool URStream<T>::nextBufferedFrame(uint8_t*& frame, size_t& length)
+{
+  if (!buffered_)
+  {
+    return false;
+  }
+  length = findBufferedPackage();
+  if (length < sizeof(typename T::HeaderType::_package_size_type))
+  {
+    return false;
+  }
+  frame = read_buffer_.data() + buffer_begin_;
+  buffer_begin_ += length;
+  return true;
+}
 }  // namespace comm
 }  // namespace urcl
@@ -37,12 +37,29 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ur_client_library/comm/reactor.h"
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/helpers.h"
 
 namespace urcl
 {
 namespace comm
 {
+/*!
+ * \brief Defines how the byte stream received from a client is split into messages.
+ */
+enum class MessageFraming
+{
+  NONE,            ///< Every chunk received is passed on as it is
+  FIXED_SIZE,      ///< All messages have the same size
+  LENGTH_PREFIXED  ///< Every message is preceded by its length as a 32 bit big endian integer
+};
+
 /*!
  * \brief Wrapper class for a TCP socket server.
  *
@@ -56,6 +73,10 @@ namespace comm
  *
  *  While this server implementation supports multiple (number limited by system's socket
  *  implementation) clients by default, a maximum number of allowed clients can be configured.
+ *
+ *  Events are handled by a worker thread waiting on an edge-triggered epoll instance, so the cost
+ *  of a wakeup does not depend on the number or value of the file descriptors in use. Client
+ *  sockets are non-blocking and are read until they are drained on every event.
  */
 class TCPServer
 {
@@ -65,7 +86,7 @@ public:
    * \brief Create a TCPServer object
    *
    * \param port Port on which to operate. The port will be bound to the process creating the
-   * object.
+   * object. If 0, the operating system assigns a free port, see getPort().
    * \param max_num_tries If binding the socket fails, it will be retried this many times. If 0 is
    * specified, binding the socket will be tried indefinitely.
    * \param reconnection_time Wait time in between binding attempts.
@@ -100,7 +121,9 @@ public:
    * \brief This callback will be triggered on messages received on the socket
    *
    * \param func Function handling the event information. The file client's file_descriptor will be
-   * passed to the function as well as the actual message received from the client.
+   * passed to the function as well as the actual message received from the client and its length.
+   * Without message framing, the data is followed by a terminating zero byte. With message framing,
+   * it is not. The data is only valid during the callback.
    */
   void setMessageCallback(std::function<void(const int, char*, int)> func)
   {
@@ -135,6 +158,32 @@ public:
    */
   bool write(const int fd, const uint8_t* buf, const size_t buf_len, size_t& written);
 
+  /*!
+   * \brief Writes several buffers to a client using a single syscall where possible.
+   *
+   * This allows sending e.g. a header and a payload, or a batch of messages, without copying them
+   * into one contiguous buffer first.
+   *
+   * \param[in] fd File descriptor belonging to the client the data should be sent to
+   * \param[in] iov Array of buffers to write, in order
+   * \param[in] iov_count Number of elements in the array
+   * \param[out] written Number of bytes actually written
+   *
+   * \returns True on success, false otherwise
+   */
+  bool writev(const int fd, const struct iovec* iov, const size_t iov_count, size_t& written);
+
+  /*!
+   * \brief Get the port the server is bound to. If the server has been created with port 0, this
+   * is the port assigned by the operating system.
+   *
+   * \returns The bound port
+   */
+  int getPort() const
+  {
+    return port_;
+  }
+
   /*!
    * \brief Get the maximum number of clients allowed to connect to this server
    *
@@ -156,6 +205,99 @@ public:
     max_clients_allowed_ = max_clients_allowed;
   }
 
+  /*!
+   * \brief Set the size of the receive buffer every client gets.
+   *
+   * Without message framing, this is the maximum number of bytes passed to the message callback at
+   * once. With message framing, it limits the size of a message including its length prefix. This
+   * has to be called before start() and only applies to clients connecting afterwards.
+   *
+   * \param size Size of the receive buffer in bytes
+   *
+   * \throws UrException if the size is 0 or smaller than the configured message framing requires
+   */
+  void setReceiveBufferSize(const size_t size);
+
+  /*!
+   * \brief Get the size of the receive buffer every client gets.
+   *
+   * \returns The receive buffer size in bytes
+   */
+  size_t getReceiveBufferSize() const
+  {
+    return receive_buffer_size_;
+  }
+
+  /*!
+   * \brief Let the server split the data received from a client into messages.
+   *
+   * Data received is collected in the client's receive buffer and the message callback is called
+   * once per complete message. Length prefixes are stripped from the messages. A client announcing
+   * a message that does not fit into the receive buffer is disconnected. This has to be called
+   * before start().
+   *
+   * \param framing The framing to use
+   * \param frame_size Size of every message in bytes when using MessageFraming::FIXED_SIZE. Ignored
+   * otherwise.
+   *
+   * \throws UrException if the frame size is 0 or does not fit into the receive buffer
+   */
+  void setMessageFraming(const MessageFraming framing, const size_t frame_size = 0);
+
+  /*!
+   * \brief Set the length of the queue of connection requests waiting to be accepted.
+   *
+   * Connection requests arriving while the queue is full are refused by the system. This can be
+   * called at any time and takes effect immediately.
+   *
+   * \param backlog Maximum number of pending connection requests
+   *
+   * \throws std::system_error if the backlog cannot be applied to the listening socket
+   */
+  void setListenBacklog(const int backlog);
+
+  /*!
+   * \brief Get the length of the queue of connection requests waiting to be accepted.
+   *
+   * \returns The configured backlog
+   */
+  int getListenBacklog() const
+  {
+    return listen_backlog_;
+  }
+
+  /*!
+   * \brief Sets tuning options for the sockets of clients connecting to the server.
+   *
+   * Without calling this, accepted sockets keep the system's defaults. The buffer sizes are also
+   * applied to the listening socket, so they are in effect when the connection is established. This
+   * has to be called before start() and only applies to clients connecting afterwards.
+   *
+   * \param options The socket options
+   */
+  void setClientSocketOptions(const SocketOptions& options);
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the worker thread handling the server's
+   * events. They are applied every time the server is started and, if it is running already,
+   * immediately.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Lets a reactor handle the server's events instead of a worker thread of its own.
+   *
+   * This allows many servers to share a few threads. A running server is moved to the reactor or
+   * back to its own worker thread immediately. The thread config set using setThreadConfig() only
+   * applies to the server's own worker thread. This must not be called from one of the server's
+   * callbacks.
+   *
+   * \param reactor The reactor to use, nullptr to use a worker thread of its own
+   */
+  void setReactor(std::shared_ptr<Reactor> reactor);
+
 private:
   void init();
   void bind(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time);
@@ -169,30 +311,60 @@ private:
   //! read data from socket
   void readData(const int fd);
 
+  struct ClientBuffer
+  {
+    std::vector<char> data;
+    size_t fill = 0;
+  };
+
+  //! Passes the messages received in a client's buffer to the message callback. Returns false if the
+  //! client sent an invalid message.
+  bool dispatchMessages(const int fd, ClientBuffer& client);
+
+  //! Throws if the message framing does not fit into the receive buffer
+  void checkFraming(const size_t receive_buffer_size, const MessageFraming framing, const size_t frame_size) const;
+
   //! Event handler. Blocks until activity on any client or connection attempt
   void spin();
 
+  //! Registers fd with the worker's epoll instance for edge-triggered input events
+  void addToEpoll(const int fd);
+
+  //! Removes fd from the worker's epoll instance
+  void removeFromEpoll(const int fd);
+
   //! Runs spin() as long as keep_running_ is set to true.
   void worker();
 
   std::atomic<bool> keep_running_;
   std::thread worker_thread_;
+  ThreadConfig thread_config_;
+  std::shared_ptr<Reactor> reactor_;
+  size_t reactor_loop_;
 
   std::atomic<int> listen_fd_;
   int port_;
 
-  int maxfd_;
-  fd_set masterfds_;
-  fd_set tempfds_;
+  // epoll instance used by the server's own worker thread. The listening socket and all clients
+  // are registered edge-triggered while the worker is running.
+  int epoll_fd_;
+  // eventfd used to interrupt the worker thread on shutdown
+  int shutdown_fd_;
 
   uint32_t max_clients_allowed_;
   std::vector<int> client_fds_;
 
-  // Pipe for the self-pipe trick (https://cr.yp.to/docs/selfpipe.html)
-  int self_pipe_[2];
+  static const int MAX_EPOLL_EVENTS = 16;
 
-  static const int INPUT_BUFFER_SIZE = 100;
-  char input_buffer_[INPUT_BUFFER_SIZE];
+  static const size_t DEFAULT_RECEIVE_BUFFER_SIZE = 4096;
+  // Leaves room for a client reconnecting while other connection requests are still pending
+  static const int DEFAULT_LISTEN_BACKLOG = 8;
+  int listen_backlog_;
+  size_t receive_buffer_size_;
+  MessageFraming framing_;
+  size_t frame_size_;
+  std::unordered_map<int, ClientBuffer> client_buffers_;
+  std::optional<SocketOptions> client_socket_options_;
 
   std::function<void(const int)> new_connection_callback_;
   std::function<void(const int)> disconnect_callback_;
@@ -22,16 +22,84 @@
 #include <netdb.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <atomic>
 #include <chrono>
 #include <mutex>
 #include <string>
 #include <memory>
 
+#include "ur_client_library/comm/transport.h"
+
 namespace urcl
 {
 namespace comm
 {
+/*!
+ * \brief Sends the data described by an array of iovecs on a socket in as few syscalls as possible.
+ *
+ * Partial writes are continued until everything is sent. If the socket is non-blocking, this waits
+ * for room in the send buffer.
+ *
+ * \param[in] fd File descriptor of the socket
+ * \param[in] iov Array of buffers to send, in order
+ * \param[in] iov_count Number of elements in the array
+ * \param[out] written Number of bytes actually written
+ *
+ * \returns True on success, false otherwise
+ */
+bool sendIovec(const int fd, const struct iovec* iov, const size_t iov_count, size_t& written);
+
+/*!
+ * \brief Tuning options for the sockets used to communicate with the robot.
+ *
+ * Numeric options set to 0 (or -1, where 0 is a valid value) leave the system's default untouched.
+ */
+struct SocketOptions
+{
+  bool tcp_nodelay = true;       ///< Disable Nagle's algorithm (TCP_NODELAY)
+  bool tcp_quickack = true;      ///< Acknowledge received data immediately (TCP_QUICKACK)
+  int busy_poll_us = 0;          ///< Busy poll the device queue on blocking reads for this long (SO_BUSY_POLL)
+  int priority = -1;             ///< Queueing priority of sent packets (SO_PRIORITY), >6 needs CAP_NET_ADMIN
+  int tos = -1;                  ///< Type of service byte of sent packets (IP_TOS), i.e. DSCP << 2
+  int receive_buffer_size = 0;   ///< Size of the kernel's receive buffer in bytes (SO_RCVBUF)
+  int send_buffer_size = 0;      ///< Size of the kernel's send buffer in bytes (SO_SNDBUF)
+};
+
+/*!
+ * \brief Applies socket options to a socket. Options that cannot be set are reported as warnings.
+ *
+ * \param fd File descriptor of the socket
+ * \param options The options to apply
+ *
+ * \returns True if all options could be applied, false otherwise
+ */
+bool applySocketOptions(const int fd, const SocketOptions& options);
+
+/*!
+ * \brief Statistics of a TCP connection as reported by the kernel (TCP_INFO).
+ */
+struct TcpStatistics
+{
+  std::chrono::microseconds rtt{ 0 };           ///< Smoothed round-trip time
+  std::chrono::microseconds rtt_variance{ 0 };  ///< Variance of the round-trip time
+  uint32_t retransmits = 0;                     ///< Segments retransmitted since the connection was established
+  uint32_t lost = 0;                            ///< Segments currently considered lost
+  uint32_t unacknowledged = 0;                  ///< Segments sent, but not acknowledged yet
+  uint32_t congestion_window = 0;               ///< Sending congestion window in segments
+};
+
+/*!
+ * \brief Reads the kernel's statistics of a TCP connection. This is a single non-blocking system
+ * call, so it can be done while the socket is in use by other threads.
+ *
+ * \param fd File descriptor of the socket
+ * \param statistics Target for the statistics
+ *
+ * \returns True on success, false if fd isn't a TCP socket
+ */
+bool readTcpStatistics(const int fd, TcpStatistics& statistics);
+
 /*!
  * \brief State the socket can be in
  */
@@ -45,6 +113,9 @@ enum class SocketState
 
 /*!
  * \brief Class for TCP socket abstraction
+ *
+ * By default, a POSIX socket is used. Alternatively, a custom Transport can be set, which then
+ * handles connecting, reading and writing instead.
  */
 class TCPSocket
 {
@@ -53,8 +124,15 @@ private:
   std::atomic<SocketState> state_;
   std::chrono::milliseconds reconnection_time_;
   bool reconnection_time_modified_deprecated_ = false;
+  bool kernel_timestamping_ = false;
+  SocketOptions socket_options_;
+  std::chrono::milliseconds connect_timeout_;
+  std::chrono::system_clock::time_point last_kernel_timestamp_;
+  std::shared_ptr<Transport> transport_;
 
   void setupOptions();
+  bool connectWithTimeout(int socket_fd, struct sockaddr* address, size_t address_len);
+  ssize_t recvWithTimestamp(uint8_t* buf, const size_t buf_len);
 
 protected:
   static bool open(int socket_fd, struct sockaddr* address, size_t address_len)
@@ -88,7 +166,7 @@ public:
   /*!
    * \brief Getter for the file descriptor of the socket.
    *
-   * \returns The file descriptor of the socket
+   * \returns The file descriptor of the socket, -1 when using a custom transport
    */
   int getSocketFD()
   {
@@ -133,11 +211,65 @@ public:
    */
   bool write(const uint8_t* buf, const size_t buf_len, size_t& written);
 
+  /*!
+   * \brief Writes several buffers to the socket using a single syscall where possible.
+   *
+   * This allows sending e.g. a header and a payload, or a batch of messages, without copying them
+   * into one contiguous buffer first.
+   *
+   * \param[in] iov Array of buffers to write, in order
+   * \param[in] iov_count Number of elements in the array
+   * \param[out] written Number of bytes actually written
+   *
+   * \returns True on success, false otherwise
+   */
+  bool writev(const struct iovec* iov, const size_t iov_count, size_t& written);
+
+  /*!
+   * \brief Reads the kernel's statistics of the connection, see readTcpStatistics().
+   *
+   * \param statistics Target for the statistics
+   *
+   * \returns True on success, false if the socket isn't connected or uses a custom transport
+   */
+  bool getTcpStatistics(TcpStatistics& statistics) const;
+
+  /*!
+   * \brief Waits until data can be read from the socket.
+   *
+   * \param timeout Maximum time to wait
+   *
+   * \returns True if data can be read or the connection has been closed by the peer, false if the
+   * timeout passed or the socket isn't connected
+   */
+  bool poll(const std::chrono::milliseconds timeout);
+
   /*!
    * \brief Closes the connection to the socket.
    */
   void close();
 
+  /*!
+   * \brief Replaces the POSIX socket by a custom transport, e.g. a userspace TCP stack or an
+   * InMemoryTransport. Socket options and kernel timestamping don't apply to custom transports.
+   * This has to be called before connecting the socket.
+   *
+   * \param transport The transport to use, nullptr to use a POSIX socket
+   *
+   * \throws UrException if the socket is connected
+   */
+  void setTransport(std::shared_ptr<Transport> transport);
+
+  /*!
+   * \brief Getter for the custom transport set using setTransport().
+   *
+   * \returns The transport, nullptr if a POSIX socket is used
+   */
+  std::shared_ptr<Transport> getTransport() const
+  {
+    return transport_;
+  }
+
   /*!
    * \brief Setup Receive timeout used for this socket.
    *
@@ -145,6 +277,70 @@ public:
    */
   void setReceiveTimeout(const timeval& timeout);
 
+  /*!
+   * \brief Sets tuning options of the socket. They are applied every time the socket connects and,
+   * if it is connected already, immediately.
+   *
+   * \param options The socket options
+   */
+  void setSocketOptions(const SocketOptions& options);
+
+  /*!
+   * \brief Limits how long a single connection attempt may take.
+   *
+   * By default, connection attempts block until the operating system gives up, which can take
+   * minutes for an unreachable host. With a timeout, the socket connects non-blocking and an
+   * attempt fails once the timeout passes. This has to be called before connecting the socket.
+   *
+   * \param timeout Maximum duration of a connection attempt, 0 to wait for the operating system
+   */
+  void setConnectTimeout(const std::chrono::milliseconds timeout)
+  {
+    connect_timeout_ = timeout;
+  }
+
+  /*!
+   * \brief Getter for the maximum duration of a connection attempt.
+   *
+   * \returns The connect timeout, 0 if attempts wait for the operating system
+   */
+  std::chrono::milliseconds getConnectTimeout() const
+  {
+    return connect_timeout_;
+  }
+
+  /*!
+   * \brief Getter for the tuning options of the socket.
+   *
+   * \returns The socket options
+   */
+  const SocketOptions& getSocketOptions() const
+  {
+    return socket_options_;
+  }
+
+  /*!
+   * \brief Enables software receive timestamps of the kernel on this socket. This has to be called
+   * before connecting the socket.
+   *
+   * \param enabled Whether the kernel shall timestamp received data
+   */
+  void setKernelTimestamping(const bool enabled)
+  {
+    kernel_timestamping_ = enabled;
+  }
+
+  /*!
+   * \brief Getter for the time the kernel received the data returned by the last call to read().
+   *
+   * \returns The kernel's receive timestamp, a default constructed time point if kernel
+   * timestamping is disabled or not supported
+   */
+  std::chrono::system_clock::time_point getLastKernelTimestamp() const
+  {
+    return last_kernel_timestamp_;
+  }
+
   /*!
    * \brief Set reconnection time, if the server is unavailable during connection this will set the time before
    * trying connect to the server again.
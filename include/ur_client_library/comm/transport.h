@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRANSPORT_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRANSPORT_H_INCLUDED
+
+#include <sys/uio.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Interface of a byte stream connection replacing the POSIX socket of a TCPSocket.
+ *
+ * This allows running URStream, DashboardClient and everything built on top of them on
+ * alternative transports, e.g. a userspace TCP stack or an in-process connection for testing and
+ * benchmarking. Implementations have to be safe to read from and write to from different threads.
+ */
+class Transport
+{
+public:
+  virtual ~Transport() = default;
+
+  /*!
+   * \brief Performs a single connection attempt. Retries are handled by the TCPSocket.
+   *
+   * \param host Host to connect to
+   * \param port Port to connect to
+   *
+   * \returns True if the connection has been established, false otherwise
+   */
+  virtual bool connect(const std::string& host, const int port) = 0;
+
+  /*!
+   * \brief Closes the connection. Blocked reads return.
+   */
+  virtual void close() = 0;
+
+  /*!
+   * \brief Checks whether the connection is usable, i.e. it has been established and neither side
+   * closed it.
+   */
+  virtual bool isConnected() const = 0;
+
+  /*!
+   * \brief Reads the data available, blocking until some data arrives or the receive timeout
+   * passes.
+   *
+   * \param[out] buf Buffer where the data shall be stored
+   * \param[in] buf_len Number of bytes allocated for the buffer
+   * \param[out] read Number of bytes actually read
+   *
+   * \returns True if data has been read, false on timeout or if the connection has been closed
+   */
+  virtual bool read(uint8_t* buf, const size_t buf_len, size_t& read) = 0;
+
+  /*!
+   * \brief Writes all given buffers, in order.
+   *
+   * \param[in] iov Array of buffers to write
+   * \param[in] iov_count Number of elements in the array
+   * \param[out] written Number of bytes actually written
+   *
+   * \returns True on success, false otherwise
+   */
+  virtual bool write(const struct iovec* iov, const size_t iov_count, size_t& written) = 0;
+
+  /*!
+   * \brief Waits until data can be read.
+   *
+   * \param timeout Maximum time to wait
+   *
+   * \returns True if data can be read without blocking or the connection has been closed, false if
+   * the timeout passed
+   */
+  virtual bool poll(const std::chrono::milliseconds timeout) = 0;
+
+  /*!
+   * \brief Limits how long read() blocks.
+   *
+   * \param timeout Maximum time read() waits for data, 0 to wait indefinitely
+   */
+  virtual void setReceiveTimeout(const std::chrono::microseconds timeout) = 0;
+
+  /*!
+   * \brief Getter for the local IP address of the connection, as sent to the robot for reverse
+   * connections.
+   *
+   * \returns The local IP address, an empty string if the transport doesn't have one
+   */
+  virtual std::string getLocalIP() const
+  {
+    return std::string();
+  }
+};
+
+/*!
+ * \brief Transport connecting two endpoints inside the same process without involving the
+ * network stack.
+ *
+ * Endpoints are created in pairs, everything written to one endpoint can be read from the other.
+ * Connecting an endpoint ignores host and port. If the connection has been closed, a new one is
+ * started between both endpoints, dropping data left over from the previous connection. Otherwise,
+ * the open connection is kept, so data the peer has written already is not lost.
+ */
+class InMemoryTransport : public Transport
+{
+public:
+  //! An endpoint and its peer
+  using Pair = std::pair<std::shared_ptr<InMemoryTransport>, std::shared_ptr<InMemoryTransport>>;
+
+  /*!
+   * \brief Creates two connected endpoints.
+   *
+   * \returns The endpoints, one of them is usually passed to TCPSocket::setTransport()
+   */
+  static Pair createPair();
+
+  virtual ~InMemoryTransport() = default;
+
+  bool connect(const std::string& host, const int port) override;
+  void close() override;
+  bool isConnected() const override;
+  bool read(uint8_t* buf, const size_t buf_len, size_t& read) override;
+  bool write(const struct iovec* iov, const size_t iov_count, size_t& written) override;
+  bool poll(const std::chrono::milliseconds timeout) override;
+  void setReceiveTimeout(const std::chrono::microseconds timeout) override;
+
+  //! Convenience overload writing a single buffer
+  bool write(const uint8_t* buf, const size_t buf_len, size_t& written);
+
+private:
+  // Data flowing in one direction
+  struct Channel
+  {
+    std::deque<uint8_t> data;
+    std::condition_variable cv;
+  };
+  // State shared by both endpoints. A single mutex guards both directions.
+  struct Connection
+  {
+    std::mutex mutex;
+    Channel channels[2];
+    bool closed = false;
+  };
+
+  InMemoryTransport(std::shared_ptr<Connection> connection, const size_t side);
+
+  std::shared_ptr<Connection> connection_;
+  Channel& rx_;
+  Channel& tx_;
+  std::chrono::microseconds receive_timeout_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRANSPORT_H_INCLUDED
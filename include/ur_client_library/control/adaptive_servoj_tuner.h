@@ -0,0 +1,164 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_ADAPTIVE_SERVOJ_TUNER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_ADAPTIVE_SERVOJ_TUNER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "ur_client_library/comm/latency_statistics.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Configuration of an AdaptiveServojTuner.
+ */
+struct AdaptiveServojConfig
+{
+  //! Lookahead time used without any jitter in seconds, at least 0.03
+  double min_lookahead_time = 0.03;
+  //! Upper bound of the lookahead time in seconds, at most 0.2
+  double max_lookahead_time = 0.2;
+  //! Seconds of lookahead time added per second of measured jitter
+  double jitter_factor = 2.0;
+  //! Whether the gain is lowered as the lookahead time grows. The gain the tuner is created with is
+  //! used at the minimum lookahead time.
+  bool adapt_gain = false;
+  //! Lower bound of the gain if adapt_gain is set, at least 100
+  uint32_t min_gain = 100;
+  //! Number of setpoint intervals the jitter is measured over
+  size_t window_size = 500;
+  //! Smallest change of the lookahead time in seconds worth sending to the robot
+  double min_change = 0.005;
+  //! Intervals longer than this are pauses of the stream rather than jitter and are left out
+  std::chrono::milliseconds max_interval{ 500 };
+};
+
+/*!
+ * \brief Adapts the lookahead time and gain of servoj to the jitter of the setpoint stream.
+ *
+ * The lookahead time smoothens the trajectory the robot follows over setpoints arriving late or
+ * early. A short one tracks the setpoints closely, but turns jitter into jerky motion. The tuner
+ * measures the jitter as the spread between the median and the 99th percentile of the intervals
+ * between setpoints over a window and sets the lookahead time to
+ * min_lookahead_time + jitter_factor * jitter. Optionally the gain is lowered proportionally to keep
+ * the servo stable with long lookahead times.
+ *
+ * Setpoints are reported by a single thread, see ReverseInterface::setAdaptiveServojTuner(). The
+ * parameters can be read from any thread.
+ */
+class AdaptiveServojTuner
+{
+public:
+  AdaptiveServojTuner() = delete;
+
+  /*!
+   * \brief Creates a new AdaptiveServojTuner object.
+   *
+   * \param config Bounds and window of the adaption
+   * \param lookahead_time Lookahead time the program has been started with in seconds
+   * \param gain Gain the program has been started with
+   */
+  AdaptiveServojTuner(const AdaptiveServojConfig& config, const double lookahead_time, const uint32_t gain);
+
+  /*!
+   * \brief Reports a servoj setpoint that has been sent.
+   *
+   * \param send_time Time the setpoint has been sent at
+   *
+   * \returns True if a window has been completed and the parameters have changed, so they have to
+   * be sent to the robot
+   */
+  bool addSetpoint(const std::chrono::steady_clock::time_point send_time);
+
+  /*!
+   * \brief Restarts the measurement, e.g. once the program has been restarted with its initial
+   * parameters. The parameters are sent with the next completed window, even if they didn't change.
+   */
+  void reset();
+
+  /*!
+   * \brief Getter for the lookahead time in seconds.
+   */
+  double getLookaheadTime() const
+  {
+    return lookahead_time_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Getter for the gain.
+   */
+  uint32_t getGain() const
+  {
+    return gain_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Getter for the jitter measured over the last completed window.
+   */
+  std::chrono::microseconds getJitter() const
+  {
+    return std::chrono::microseconds(jitter_us_.load(std::memory_order_relaxed));
+  }
+
+  /*!
+   * \brief Getter for the configuration.
+   */
+  const AdaptiveServojConfig& getConfig() const
+  {
+    return config_;
+  }
+
+private:
+  void restart();
+
+  AdaptiveServojConfig config_;
+  double initial_lookahead_time_;
+  uint32_t initial_gain_;
+  std::atomic<double> lookahead_time_;
+  std::atomic<uint32_t> gain_;
+  std::atomic<int64_t> jitter_us_;
+  std::atomic<bool> reset_requested_;
+
+  // Only accessed by the thread reporting setpoints
+  comm::LatencyHistogram intervals_;
+  size_t num_intervals_;
+  std::chrono::steady_clock::time_point last_send_time_;
+  bool send_pending_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_ADAPTIVE_SERVOJ_TUNER_H_INCLUDED
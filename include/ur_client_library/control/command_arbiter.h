@@ -0,0 +1,349 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_COMMAND_ARBITER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_COMMAND_ARBITER_H_INCLUDED
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/control/reverse_interface.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+
+namespace urcl
+{
+namespace control
+{
+class CommandArbiter;
+
+/*!
+ * \brief Handle of one component commanding the robot through a CommandArbiter, e.g. a motion
+ * planner, a teleoperation tool or a safety supervisor.
+ *
+ * Commands are only forwarded to the robot while the client is in control, otherwise they are
+ * rejected. Clients are created using CommandArbiter::addClient() and leave the arbitration when
+ * they are destroyed. All methods can be called from any thread.
+ */
+class CommandClient
+{
+public:
+  CommandClient(const CommandClient&) = delete;
+  CommandClient& operator=(const CommandClient&) = delete;
+
+  /*!
+   * \brief Releases control, if the client is in control, and removes it from the arbiter. Control
+   * is handed to the next pending request right away, calling that client's control callback.
+   */
+  ~CommandClient();
+
+  /*!
+   * \brief Requests control of the robot.
+   *
+   * Control is granted right away, if no other client is in control or the client in control has
+   * a lower priority. Otherwise, the request is kept until the robot becomes available, see
+   * setControlCallback().
+   *
+   * \returns True, if the client is in control now
+   */
+  bool requestControl();
+
+  /*!
+   * \brief Gives up control or withdraws a pending request. A trajectory that is still running is
+   * canceled.
+   */
+  void releaseControl();
+
+  /*!
+   * \brief Checks whether the client is in control of the robot.
+   */
+  bool hasControl() const;
+
+  /*!
+   * \brief Sets a callback, that is called with true when the client gains control and with false
+   * when it loses control, e.g. because a client with a higher priority took over. A preempted
+   * client keeps its request and regains control once the robot becomes available again, unless it
+   * calls releaseControl(). The callback is called from the thread causing the change.
+   *
+   * \param callback The callback, nullptr to remove it
+   */
+  void setControlCallback(std::function<void(bool)> callback);
+
+  /*!
+   * \brief Sets a callback receiving the result of trajectories started by this client. A
+   * trajectory canceled because the client lost control reports
+   * TrajectoryResult::TRAJECTORY_RESULT_CANCELED.
+   *
+   * \param callback The callback, nullptr to remove it
+   */
+  void setTrajectoryDoneCallback(std::function<void(TrajectoryResult)> callback);
+
+  /*!
+   * \brief Writes a joint command, see ReverseInterface::write(). comm::ControlMode::MODE_STOPPED
+   * is rejected, as it would end the program on the robot for all clients, use stopMotion()
+   * instead.
+   *
+   * \param values Joint positions, velocities, pose, twist or wrench depending on the control mode
+   * \param control_mode Control mode of the command
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   *
+   * \returns True, if the client is in control and the command has been written
+   */
+  bool writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                         const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+
+  /*!
+   * \brief Writes a trajectory control message, see ReverseInterface::writeTrajectoryControlMessage().
+   * Streamed trajectories are started using startTrajectoryStream().
+   *
+   * \param trajectory_action The action to be taken, such as starting a new trajectory
+   * \param point_number The number of points of a new trajectory to be sent
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   *
+   * \returns True, if the client is in control and the message has been written
+   */
+  bool
+  writeTrajectoryControlMessage(const TrajectoryControlMessage trajectory_action, const int point_number = 0,
+                                const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Starts a streamed trajectory, see UrDriver::startTrajectoryStream().
+   *
+   * \param window_size Maximum number of points in flight
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   *
+   * \returns True, if the client is in control and the stream has been started
+   */
+  bool startTrajectoryStream(const size_t window_size,
+                             const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Ends a streamed trajectory, see TrajectoryPointInterface::endTrajectoryStream().
+   *
+   * \returns True, if the client is in control and the end of the stream has been written
+   */
+  bool endTrajectoryStream();
+
+  /*!
+   * \brief Writes trajectory points. The points are written in chunks, so a client taking over
+   * doesn't wait for a long upload.
+   *
+   * \param points The points to write
+   *
+   * \returns True, if the client stayed in control and all points have been written
+   */
+  bool writeTrajectoryPoints(const std::vector<TrajectoryPoint>& points);
+
+  /*!
+   * \brief Writes spline points, see writeTrajectoryPoints().
+   *
+   * \param points The points to write
+   *
+   * \returns True, if the client stayed in control and all points have been written
+   */
+  bool writeTrajectorySplinePoints(const std::vector<TrajectorySplinePoint>& points);
+
+  /*!
+   * \brief Writes spline segments with precomputed coefficients, see writeTrajectoryPoints().
+   *
+   * \param segments The segments to write
+   *
+   * \returns True, if the client stayed in control and all segments have been written
+   */
+  bool writeTrajectorySplineSegments(const std::vector<TrajectorySplineSegment>& segments);
+
+  /*!
+   * \brief Stops the robot while keeping the program running. A running trajectory is canceled
+   * and the robot is switched to comm::ControlMode::MODE_IDLE.
+   *
+   * \returns True, if the client is in control and the robot has been stopped
+   */
+  bool stopMotion();
+
+  /*!
+   * \brief Getter for the client's name.
+   */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * \brief Getter for the client's priority. Higher values take precedence.
+   */
+  int32_t getPriority() const
+  {
+    return priority_;
+  }
+
+private:
+  friend class CommandArbiter;
+
+  CommandClient(CommandArbiter& arbiter, const std::string& name, const int32_t priority);
+
+  CommandArbiter& arbiter_;
+  std::string name_;
+  int32_t priority_;
+  // Guarded by the arbiter's state mutex
+  bool requesting_;
+  uint64_t request_order_;
+  std::function<void(bool)> control_callback_;
+  std::function<void(TrajectoryResult)> trajectory_done_callback_;
+};
+
+/*!
+ * \brief Lets several components command the same robot through one ReverseInterface and
+ * TrajectoryPointInterface, i.e. one connection and one program on the robot.
+ *
+ * At most one CommandClient is in control at a time. A client requesting control preempts the
+ * client in control, if its priority is higher. Otherwise, its request is kept and granted once
+ * the robot becomes available, to the pending request of the highest priority first and in the
+ * order of the requests among equal priorities. Losing control cancels a trajectory the client
+ * started, so the next client starts from a stopped robot. Commands of clients not in control are
+ * rejected.
+ *
+ * Commands are serialized, bulk writes are split into chunks of
+ * TrajectoryPointInterface::UPLOAD_CHUNK_SIZE points and the client's control is checked for every
+ * chunk. A command already being written when its client is preempted is still sent. The arbiter
+ * takes over the trajectory end callback of the TrajectoryPointInterface to report the results to
+ * the client that started the trajectory.
+ *
+ * SharedCommandServer makes the arbitration available to other processes on the same host.
+ */
+class CommandArbiter
+{
+public:
+  CommandArbiter() = delete;
+
+  /*!
+   * \brief Creates an arbiter without clients.
+   *
+   * \param reverse_interface Interface the commands are written to
+   * \param trajectory_interface Interface the trajectory points are written to
+   */
+  CommandArbiter(ReverseInterface& reverse_interface, TrajectoryPointInterface& trajectory_interface);
+  CommandArbiter(const CommandArbiter&) = delete;
+  CommandArbiter& operator=(const CommandArbiter&) = delete;
+
+  /*!
+   * \brief Removes the trajectory end callback. All clients have to be destroyed before.
+   */
+  ~CommandArbiter();
+
+  /*!
+   * \brief Adds a client to the arbitration. The client doesn't request control yet.
+   *
+   * \param name Name of the client, used for logging
+   * \param priority Priority of the client, higher values take precedence
+   *
+   * \returns The client, it has to be destroyed before the arbiter
+   */
+  std::shared_ptr<CommandClient> addClient(const std::string& name, const int32_t priority);
+
+  /*!
+   * \brief Getter for the name of the client in control.
+   *
+   * \returns The client's name, an empty string if no client is in control
+   */
+  std::string getOwnerName() const;
+
+  /*!
+   * \brief Getter for the number of clients.
+   */
+  size_t getNumClients() const;
+
+  /*!
+   * \brief Getter for the number of times control has been handed to another client.
+   */
+  uint64_t getNumHandoffs() const;
+
+private:
+  friend class CommandClient;
+
+  struct Notification
+  {
+    std::function<void(bool)> callback;
+    bool has_control;
+  };
+
+  //! A trajectory the robot hasn't reported a result for, yet
+  struct PendingTrajectory
+  {
+    CommandClient* client;
+    bool canceled;
+  };
+
+  void removeClient(CommandClient* client);
+  bool requestControl(CommandClient* client);
+  void releaseControl(CommandClient* client);
+  bool hasControl(const CommandClient* client) const;
+  //! Grants control to the pending request of the highest priority, called with state_mutex_ held
+  void grantNext(std::vector<Notification>& notifications);
+  //! Changes the owner, called with state_mutex_ held. Returns true, if the running trajectory has
+  //! to be canceled.
+  bool changeOwner(CommandClient* owner, std::vector<Notification>& notifications);
+  //! Marks the running trajectory as canceled, called with state_mutex_ held. Returns false, if
+  //! there is none.
+  bool markTrajectoryCanceled();
+  //! Cancels the running trajectory and calls the notifications, called without state_mutex_
+  void finishHandoff(const bool cancel_trajectory, const std::vector<Notification>& notifications);
+  //! Registers a trajectory started by the client, called with state_mutex_ held
+  void addTrajectory(CommandClient* client);
+  void handleTrajectoryDone(const TrajectoryResult result);
+
+  //! Writes a command while holding command_mutex_, if the client is in control
+  bool writeCommand(const CommandClient* client, const std::function<bool()>& write);
+  template <typename T>
+  bool writeChunks(const CommandClient* client, const std::vector<T>& items,
+                   const std::function<bool(const T*, size_t)>& write);
+
+  ReverseInterface& reverse_interface_;
+  TrajectoryPointInterface& trajectory_interface_;
+
+  mutable std::mutex state_mutex_;
+  std::vector<CommandClient*> clients_;
+  CommandClient* owner_;
+  // Results are reported in the order the trajectories have been started
+  std::deque<PendingTrajectory> pending_trajectories_;
+  uint64_t request_counter_;
+  uint64_t num_handoffs_;
+
+  // Serializes the commands of all clients
+  std::mutex command_mutex_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_COMMAND_ARBITER_H_INCLUDED
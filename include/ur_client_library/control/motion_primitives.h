@@ -32,6 +32,8 @@
 #define UR_CLIENT_LIBRARY_MOTION_PRIMITIVES_H_INCLUDED
 
 #include <chrono>
+#include <optional>
+#include <variant>
 #include <ur_client_library/types.h>
 
 namespace urcl
@@ -90,6 +92,72 @@ struct MoveLPrimitive : public MotionPrimitive
 
   urcl::Pose target_pose;
 };
+
+struct MovePPrimitive : public MotionPrimitive
+{
+  MovePPrimitive(const urcl::Pose& target, const double blend_radius = 0, const double acceleration = 1.4,
+                 const double velocity = 1.04)
+  {
+    type = MotionType::MOVEP;
+    target_pose = target;
+    this->duration = std::chrono::milliseconds(0);
+    this->acceleration = acceleration;
+    this->velocity = velocity;
+    this->blend_radius = blend_radius;
+  }
+
+  urcl::Pose target_pose;
+};
+
+struct MoveCPrimitive : public MotionPrimitive
+{
+  MoveCPrimitive(const urcl::Pose& via_point, const urcl::Pose& target, const double blend_radius = 0,
+                 const double acceleration = 1.4, const double velocity = 1.04, const int32_t mode = 0)
+  {
+    type = MotionType::MOVEC;
+    via_point_pose = via_point;
+    target_pose = target;
+    this->duration = std::chrono::milliseconds(0);
+    this->acceleration = acceleration;
+    this->velocity = velocity;
+    this->blend_radius = blend_radius;
+    this->mode = mode;
+  }
+
+  urcl::Pose via_point_pose;
+  urcl::Pose target_pose;
+  int32_t mode = 0;  ///< Orientation mode of movec: 0 unconstrained, 1 fixed
+};
+
+struct SplinePrimitive : public MotionPrimitive
+{
+  SplinePrimitive(const urcl::vector6d_t& target_positions, const urcl::vector6d_t& target_velocities,
+                  const std::optional<urcl::vector6d_t>& target_accelerations,
+                  const std::chrono::duration<double> duration = std::chrono::milliseconds(0))
+  {
+    type = MotionType::SPLINE;
+    this->target_positions = target_positions;
+    this->target_velocities = target_velocities;
+    this->target_accelerations = target_accelerations;
+    this->duration = duration;
+    this->acceleration = 0;
+    this->velocity = 0;
+    this->blend_radius = 0;
+  }
+
+  urcl::vector6d_t target_positions;
+  urcl::vector6d_t target_velocities;
+  std::optional<urcl::vector6d_t> target_accelerations;  ///< Without, cubic interpolation is used
+};
+
+/*!
+ * \brief Value type holding any motion primitive supported by the InstructionExecutor.
+ *
+ * Sequences of these can be stored contiguously in a vector, so building and sending long
+ * motion sequences doesn't allocate per primitive.
+ */
+using MotionPrimitiveValue =
+    std::variant<MoveJPrimitive, MoveLPrimitive, MovePPrimitive, MoveCPrimitive, SplinePrimitive>;
 }  // namespace control
 }  // namespace urcl
 #endif  // UR_CLIENT_LIBRARY_MOTION_PRIMITIVES_H_INCLUDED
\ No newline at end of file
@@ -31,12 +31,24 @@
 
 #include "ur_client_library/comm/tcp_server.h"
 #include "ur_client_library/comm/control_mode.h"
+#include "ur_client_library/comm/product_queue.h"
+#include "ur_client_library/control/adaptive_servoj_tuner.h"
+#include "ur_client_library/control/setpoint_latency_monitor.h"
+#include "ur_client_library/control/wire_protocol.h"
+#include "ur_client_library/kinematics.h"
 #include "ur_client_library/types.h"
 #include "ur_client_library/log.h"
+#include "ur_client_library/metrics.h"
+#include "ur_client_library/trace.h"
 #include "ur_client_library/ur/robot_receive_timeout.h"
 #include <cstring>
 #include <endian.h>
+#include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace urcl
 {
@@ -50,6 +62,10 @@ enum class TrajectoryControlMessage : int32_t
   TRAJECTORY_CANCEL = -1,  ///< Represents command to cancel currently active trajectory.
   TRAJECTORY_NOOP = 0,     ///< Represents no new control command.
   TRAJECTORY_START = 1,    ///< Represents command to start a new trajectory.
+  TRAJECTORY_STREAM = 2,   ///< Represents command to start a new trajectory streamed point by point.
+  TRAJECTORY_REPLAY = 3,   ///< Represents command to execute a trajectory from the robot's trajectory cache.
+  TRAJECTORY_START_CACHED = 4,  ///< Represents command to start a new trajectory and keep it in the trajectory cache.
+  TRAJECTORY_START_ARMED = 5,   ///< Represents command to receive a new trajectory and start it once triggered.
 };
 
 /*!
@@ -62,6 +78,15 @@ enum class FreedriveControlMessage : int32_t
   FREEDRIVE_START = 1,  ///< Represents command to start freedrive mode.
 };
 
+/*!
+ * \brief Message formats used on the reverse socket.
+ */
+enum class ReverseProtocol : int32_t
+{
+  FULL = 0,     ///< Every command has the same size, fields not needed by the control mode are zero.
+  COMPACT = 1,  ///< Commands only carry the fields needed by their control mode.
+};
+
 /*!
  * \brief The ReverseInterface class handles communication to the robot. It starts a server and
  * waits for the robot to connect via its URCaps program.
@@ -69,7 +94,7 @@ enum class FreedriveControlMessage : int32_t
 class ReverseInterface
 {
 public:
-  static const int32_t MULT_JOINTSTATE = 1000000;
+  static const int32_t MULT_JOINTSTATE = wire::MULT_JOINTSTATE;
 
   ReverseInterface() = delete;
   /*!
@@ -85,7 +110,7 @@ public:
   /*!
    * \brief Disconnects possible clients so the reverse interface object can be safely destroyed.
    */
-  virtual ~ReverseInterface() = default;
+  virtual ~ReverseInterface();
 
   /*!
    * \brief Writes needed information to the robot to be read by the URCaps program.
@@ -98,16 +123,40 @@ public:
    * expects to get a new control signal each control cycle. Note the timeout cannot be higher than 1 second for
    * realtime commands.
    *
-   * \returns True, if the write was performed successfully, false otherwise.
+   * \returns True, if the write was performed successfully, false otherwise. With asynchronous
+   * setpoint writes, true is returned once the setpoint is handed to the writer thread.
    */
   virtual bool write(const vector6d_t* positions, const comm::ControlMode control_mode = comm::ControlMode::MODE_IDLE,
                      const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
 
+  /*!
+   * \brief Writes a setpoint computed from a robot state, dropping it once it expired.
+   *
+   * The setpoint is valid for the duration set by setSetpointValidity() after \p state_time. An
+   * expired setpoint isn't sent, as the robot would execute an outdated command followed by a
+   * fresh one in the same cycle. With asynchronous setpoint writes, the writer thread drops it as
+   * well, if it expires before being sent. Dropped setpoints are counted, see
+   * getNumExpiredSetpoints().
+   *
+   * \param positions A vector of joint targets for the robot
+   * \param control_mode Control mode assigned to this command
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket, see write()
+   * \param state_time The time the robot state the setpoint is computed from has been received,
+   * e.g. the receive time of the RTDE data package
+   *
+   * \returns False, if the setpoint expired or the write failed, true otherwise
+   */
+  bool write(const vector6d_t* positions, const comm::ControlMode control_mode,
+             const RobotReceiveTimeout& robot_receive_timeout, const std::chrono::steady_clock::time_point state_time);
+
   /*!
    * \brief Writes needed information to the robot to be read by the URScript program.
    *
-   * \param trajectory_action 1 if a trajectory is to be started, -1 if it should be stopped
-   * \param point_number The number of points of the trajectory to be executed
+   * \param trajectory_action 1 if a trajectory is to be started, 2 if a trajectory is to be streamed, -1 if it
+   * should be stopped
+   * \param point_number The number of points of the trajectory to be executed. Ignored for streamed trajectories.
+   * When canceling, the number of points written to the trajectory interface, so the robot discards the ones it
+   * didn't read yet. It is replaced by the count of the canceler set by setTrajectoryWritesCanceler().
    * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
    * control script on the robot. If you want to make the read function blocking then use RobotReceiveTimeout::off()
    * function to create the RobotReceiveTimeout object
@@ -128,6 +177,25 @@ public:
    *
    * \returns True, if the write was performed successfully, false otherwise.
    */
+  /*!
+   * \brief Writes a trajectory control message referring to a trajectory in the robot's trajectory cache.
+   *
+   * \param trajectory_action TrajectoryControlMessage::TRAJECTORY_REPLAY to execute the cached trajectory,
+   * TrajectoryControlMessage::TRAJECTORY_START_CACHED to start a new trajectory, that is kept in the cache, or
+   * TrajectoryControlMessage::TRAJECTORY_START_ARMED to start a new trajectory once its start token has been written
+   * into the start register, see UrDriver::setTrajectoryStartRegister()
+   * \param trajectory_id The ID the trajectory is cached under, the start token for an armed trajectory
+   * \param point_number The number of points of a new trajectory. Ignored for replays.
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot. If you want to make the read function blocking then use RobotReceiveTimeout::off()
+   * function to create the RobotReceiveTimeout object
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool writeTrajectoryCacheControlMessage(
+      const TrajectoryControlMessage trajectory_action, const int32_t trajectory_id, const int point_number = 0,
+      const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
   bool
   writeFreedriveControlMessage(const FreedriveControlMessage freedrive_action,
                                const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
@@ -146,6 +214,389 @@ public:
     disconnection_callback_ = disconnection_fun;
   }
 
+  /*!
+   * \brief Sets the function stopping the upload of trajectory points, e.g.
+   * TrajectoryPointInterface::cancelTrajectoryWrites(). It returns the number of points written.
+   *
+   * It is called for every canceled trajectory and its count is sent along, so the robot discards
+   * exactly the points written but not read yet. Leaving MODE_FORWARD cancels the trajectory as
+   * well, so this is sent as an explicit cancel first. Without a canceler, cancels carry the
+   * point_number passed to writeTrajectoryControlMessage() and leaving MODE_FORWARD discards the
+   * points announced for the trajectory. Set it before the robot connects.
+   *
+   * \param canceler Function returning the number of points written, nullptr to remove it
+   */
+  void setTrajectoryWritesCanceler(std::function<size_t()> canceler)
+  {
+    trajectory_writes_canceler_ = canceler;
+  }
+
+  /*!
+   * \brief Checks whether a robot is connected to the interface.
+   *
+   * \returns True, if the program running on the robot is connected
+   */
+  bool isConnected() const
+  {
+    return client_fd_ != -1;
+  }
+
+  /*!
+   * \brief Checks whether the program running on the robot is parked.
+   *
+   * A resident program is parked instead of exiting if it doesn't receive a command in time. It
+   * stays connected, and the next command written re-arms it.
+   *
+   * \returns True, if the program reported being parked and no command has been written since
+   */
+  bool isProgramParked() const
+  {
+    return program_parked_;
+  }
+
+  /*!
+   * \brief Lets the program running on the robot resume its session after a brief reconnect.
+   *
+   * The external control script announces a session ID every time it connects. With a resume
+   * timeout set, a lost connection is not reported to the program state callback right away. If
+   * the same session connects again within the timeout, the connection is considered resumed and
+   * the program state isn't changed at all. Otherwise the program is reported as stopped once the
+   * timeout expires or a different session connects. A timeout of 0 reports every lost connection
+   * immediately, which is the default.
+   *
+   * \param timeout Time a session may take to reconnect
+   */
+  void setSessionResumeTimeout(const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Get the session ID announced by the program running on the robot.
+   *
+   * \returns The session ID, 0 if no session has been announced yet
+   */
+  int32_t getSessionId() const
+  {
+    return session_id_;
+  }
+
+  /*!
+   * \brief Keeps the program running on the robot from timing out while no commands are written.
+   *
+   * While enabled, a no-op command is written in the control mode of the last command once half of
+   * that command's read timeout has passed without any other command being written. This is only
+   * done in the non-realtime control modes IDLE, FORWARD and FREEDRIVE, as setpoints of realtime
+   * control modes have to be streamed by the application. No keepalive messages are sent while the
+   * program is parked, so it isn't re-armed by them.
+   *
+   * \param enabled Whether keepalive messages should be sent
+   */
+  void setAutomaticKeepalive(const bool enabled);
+
+  /*!
+   * \brief Writes heartbeats while the program running on the robot is parked.
+   *
+   * A program configured with a standby host takes its host as lost, if it doesn't receive anything
+   * for the failover timeout while parked, and connects to the standby host, see
+   * UrDriver::setStandbyHost(). Heartbeats tell it that the host is still running without
+   * re-arming it.
+   *
+   * \param period Time between two heartbeats, 0 to stop writing heartbeats
+   */
+  void setParkedHeartbeatPeriod(const std::chrono::milliseconds period);
+
+  /*!
+   * \brief Checks whether keepalive messages are sent automatically, see setAutomaticKeepalive().
+   *
+   * \returns True, if keepalive messages are sent automatically
+   */
+  bool isAutomaticKeepaliveEnabled() const
+  {
+    return automatic_keepalive_;
+  }
+
+  /*!
+   * \brief Use the compact message format on the reverse socket if the robot supports it.
+   *
+   * In the compact format, the read timeout and the control mode share the first field and a
+   * command only carries the fields its control mode needs, e.g. none in MODE_IDLE and two for
+   * trajectory control messages. The external control script announces its support after
+   * connecting and the format is switched with the next command written. Scripts not announcing
+   * support keep receiving the full format. Disabling the compact format takes effect for the next
+   * connection.
+   *
+   * \param use_compact True to use the compact format when the robot supports it
+   */
+  void setUseCompactProtocol(const bool use_compact)
+  {
+    use_compact_protocol_ = use_compact;
+  }
+
+  /*!
+   * \brief Sets the monitor the send times of setpoints are reported to.
+   *
+   * A script rendered with a setpoint echo register announces that it echoes setpoints after
+   * connecting. The next command written then switches to numbering every setpoint: Each message
+   * is followed by the sequence number of its setpoint, 0 for all other commands. The send time of
+   * every numbered setpoint is passed to the monitor, which matches it with the echo received
+   * through RTDE. See UrDriver::setSetpointEchoRegister().
+   *
+   * \param monitor The monitor to report to, nullptr to stop reporting
+   */
+  void setSetpointLatencyMonitor(std::shared_ptr<SetpointLatencyMonitor> monitor)
+  {
+    std::lock_guard<std::mutex> lk(write_mutex_);
+    latency_monitor_ = std::move(monitor);
+  }
+
+  /*!
+   * \brief Changes the lookahead time and gain servoj is called with, without restarting the
+   * program. They are used from the next servoj setpoint on and are kept until the program is
+   * restarted. This doesn't change the control mode and doesn't re-arm a parked program.
+   *
+   * \param lookahead_time Lookahead time in seconds, range [0.03, 0.2]
+   * \param gain Proportional gain, range [100, 2000]
+   *
+   * \returns True if the parameters have been sent, false if they are out of range or sending failed
+   */
+  bool writeServoParameters(const double lookahead_time, const uint32_t gain);
+
+  /*!
+   * \brief Sets the tuner adapting the servoj parameters to the jitter of the setpoint stream.
+   *
+   * Every MODE_SERVOJ setpoint sent is reported to the tuner. Whenever it has measured a window of
+   * setpoints and changed the parameters, they are sent using writeServoParameters() right after
+   * the setpoint. The tuner is reset once the robot disconnects, as a restarted program starts with
+   * its initial parameters.
+   *
+   * \param tuner The tuner to report to, nullptr to keep the current parameters from now on
+   */
+  void setAdaptiveServojTuner(std::shared_ptr<AdaptiveServojTuner> tuner)
+  {
+    std::atomic_store(&servoj_tuner_, std::move(tuner));
+  }
+
+  /*!
+   * \brief Getter for the tuner set using setAdaptiveServojTuner(), nullptr if none is set.
+   */
+  std::shared_ptr<AdaptiveServojTuner> getAdaptiveServojTuner() const
+  {
+    return std::atomic_load(&servoj_tuner_);
+  }
+
+  /*!
+   * \brief Whether setpoints are currently numbered for the robot to echo them, see
+   * setSetpointLatencyMonitor().
+   */
+  bool isSequencingSetpoints() const
+  {
+    std::lock_guard<std::mutex> lk(write_mutex_);
+    return sequenced_;
+  }
+
+  /*!
+   * \brief Get the message format currently used on the reverse socket.
+   *
+   * \returns The protocol in use
+   */
+  ReverseProtocol getProtocol() const
+  {
+    std::lock_guard<std::mutex> lk(write_mutex_);
+    return protocol_;
+  }
+
+  /*!
+   * \brief Reads the kernel's statistics of the connection to the robot, see
+   * comm::readTcpStatistics(). This can be called from any thread.
+   *
+   * \param statistics Target for the statistics
+   *
+   * \returns True on success, false if no robot is connected
+   */
+  bool getTcpStatistics(comm::TcpStatistics& statistics) const
+  {
+    return comm::readTcpStatistics(client_fd_, statistics);
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the thread handling the connection to the
+   * robot.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config)
+  {
+    server_.setThreadConfig(config);
+  }
+
+  /*!
+   * \brief Hands the commands written by write() to a writer thread instead of sending them on the
+   * calling thread.
+   *
+   * write() then only stores the command in a lock-free slot holding the latest one and returns
+   * without waiting, so socket backpressure doesn't stall a realtime control loop. The writer
+   * thread encodes and sends the latest command available. Commands replaced before they were
+   * sent are counted, see getNumReplacedSetpoints(). Trajectory and freedrive control messages
+   * are still sent on the calling thread and discard a command that hasn't been sent yet.
+   *
+   * write() must not be called from several threads at the same time or while this is changed.
+   *
+   * \param enabled Whether commands written by write() are sent by the writer thread
+   */
+  void setAsyncSetpointWrites(const bool enabled);
+
+  /*!
+   * \brief Checks whether commands written by write() are sent by the writer thread, see
+   * setAsyncSetpointWrites().
+   *
+   * \returns True, if asynchronous setpoint writes are enabled
+   */
+  bool isAsyncSetpointWritesEnabled() const
+  {
+    return async_setpoint_writes_;
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the thread sending asynchronously written
+   * setpoints. They are applied when the thread is started and, if it is running already,
+   * immediately.
+   *
+   * \param config The thread settings
+   */
+  void setSetpointWriterThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Getter for the number of asynchronously written setpoints that were replaced by a newer
+   * one before the writer thread sent them.
+   */
+  uint64_t getNumReplacedSetpoints() const
+  {
+    return setpoint_queue_.getNumDropped();
+  }
+
+  /*!
+   * \brief Sets how long a setpoint written with a state time stays valid after the robot state it
+   * is computed from has been received.
+   *
+   * Choose it below one control cycle, so a setpoint is dropped instead of competing with the one
+   * computed from the next RTDE package.
+   *
+   * \param validity Validity of setpoints, zero to never drop setpoints
+   */
+  void setSetpointValidity(const std::chrono::steady_clock::duration validity)
+  {
+    setpoint_validity_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(validity).count();
+  }
+
+  /*!
+   * \brief Getter for the validity of setpoints written with a state time.
+   */
+  std::chrono::steady_clock::duration getSetpointValidity() const
+  {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(setpoint_validity_ns_.load()));
+  }
+
+  /*!
+   * \brief Getter for the number of setpoints that weren't sent, because they expired.
+   */
+  uint64_t getNumExpiredSetpoints() const
+  {
+    return num_expired_setpoints_;
+  }
+
+  /*!
+   * \brief Solves the inverse kinematics of poses written in comm::ControlMode::MODE_POSE on the
+   * client instead of on the robot.
+   *
+   * write() then takes a TCP pose in MODE_POSE as usual, but calculates the joint positions using
+   * the given model and sends them as comm::ControlMode::MODE_SERVOJ setpoint. The robot doesn't
+   * have to solve the inverse kinematics in every control cycle anymore. The first pose of a
+   * stream is solved closest to the configuration returned by the seed function, e.g. the robot's
+   * \p actual_q. Every following pose is solved closest to the previous solution, so the robot
+   * doesn't jump between solutions. A pose without solution isn't sent and write() returns false.
+   *
+   * write() must not be called from several threads at the same time or while this is changed.
+   *
+   * \param model Kinematics model of the robot, including its TCP offset. Pass nullptr to solve
+   * the inverse kinematics on the robot again.
+   * \param seed Function providing the configuration the first pose of a stream is solved closest
+   * to. Without it, or if it returns false, the last solution or, if there is none, the first
+   * solution found is used.
+   */
+  void setInverseKinematics(std::shared_ptr<const kinematics::KinematicsModel> model,
+                            std::function<bool(vector6d_t&)> seed = nullptr);
+
+  /*!
+   * \brief Getter for the number of poses written in MODE_POSE that weren't sent, because their
+   * inverse kinematics couldn't be solved on the client.
+   */
+  uint64_t getNumUnreachablePoses() const
+  {
+    return num_unreachable_poses_;
+  }
+
+  /*!
+   * \brief Marks the robot state the setpoints are computed from as stale, e.g. because the RTDE
+   * stream stopped.
+   *
+   * While the state is stale, write() doesn't send setpoints of realtime control modes, which
+   * would be based on outdated data, and returns false. A setpoint that has been handed over to
+   * the writer thread but hasn't been sent yet is discarded. The robot stops once its receive
+   * timeout expires. Stopping and other non-realtime commands are still sent.
+   *
+   * \param stale True if the robot state is stale, false once it is fresh again
+   */
+  void setRobotStateStale(const bool stale);
+
+  /*!
+   * \brief Checks whether the robot state has been marked stale, see setRobotStateStale().
+   */
+  bool isRobotStateStale() const
+  {
+    return robot_state_stale_;
+  }
+
+  /*!
+   * \brief Getter for the number of setpoints written while the robot state was stale, which
+   * weren't sent.
+   */
+  uint64_t getNumStaleSetpoints() const
+  {
+    return num_stale_setpoints_;
+  }
+
+  /*!
+   * \brief Sets tuning options for the socket of the robot connecting to this interface. See
+   * comm::TCPServer::setClientSocketOptions() for details.
+   *
+   * \param options The socket options
+   */
+  void setSocketOptions(const comm::SocketOptions& options)
+  {
+    server_.setClientSocketOptions(options);
+  }
+
+  /*!
+   * \brief Getter for the port the robot connects to. If the interface has been created with port 0, this
+   * is the port assigned by the operating system.
+   *
+   * \returns The bound port
+   */
+  uint32_t getPort() const
+  {
+    return static_cast<uint32_t>(server_.getPort());
+  }
+
+  /*!
+   * \brief Lets a reactor handle the connection to the robot instead of a thread of its own. See
+   * comm::TCPServer::setReactor() for details.
+   *
+   * \param reactor The reactor to use, nullptr to use a thread of its own
+   */
+  void setReactor(std::shared_ptr<comm::Reactor> reactor)
+  {
+    server_.setReactor(reactor);
+  }
+
 protected:
   virtual void connectionCallback(const int filedescriptor);
 
@@ -154,9 +605,12 @@ protected:
   virtual void messageCallback(const int filedescriptor, char* buffer, int nbytesrecv);
 
   std::function<void(const int)> disconnection_callback_ = nullptr;
+  std::function<size_t()> trajectory_writes_canceler_ = nullptr;
 
-  int client_fd_;
+  std::atomic<int> client_fd_;
   comm::TCPServer server_;
+  Counter& bytes_sent_metric_;
+  Counter& expired_setpoints_metric_;
 
   template <typename T>
   size_t append(uint8_t* buffer, T& val)
@@ -166,13 +620,133 @@ protected:
     return s;
   }
 
-  static const int MAX_MESSAGE_LENGTH = 8;
+  static const int MAX_MESSAGE_LENGTH = wire::reverse::MESSAGE_LENGTH;
+  //! Value of the control mode field of a full command that selects the protocol used afterwards
+  static const int32_t PROTOCOL_SELECT = -100;
+  //! The first field of a compact command is read_timeout * COMPACT_MODE_RANGE + control_mode - MODE_STOPPED
+  static const int32_t COMPACT_MODE_RANGE = 16;
+  //! Sent by a resident program once it is parked
+  static const int32_t PROGRAM_PARKED = 2;
+  //! Sent by the program after connecting, followed by its session ID
+  static const int32_t SESSION_ANNOUNCEMENT = 3;
+  //! Sent by the program after connecting, if it echoes the sequence numbers of setpoints
+  static const int32_t SETPOINT_ECHO = 4;
+  //! Control mode field of a heartbeat, the highest value a compact command can encode
+  static const int32_t HEARTBEAT = COMPACT_MODE_RANGE + toUnderlying(comm::ControlMode::MODE_STOPPED) - 1;
+  //! Control mode field of a message changing the servoj parameters
+  static const int32_t SERVO_PARAMETERS = wire::reverse::SERVO_PARAMETERS_MODE;
+
+  /*!
+   * \brief Writes a command in the protocol in use.
+   *
+   * \param message A full message in host byte order, holding the payload fields of the control
+   * mode's wire::reverse layout. The read timeout and control mode are filled in here.
+   */
+  bool writeCommand(const int32_t read_timeout, const comm::ControlMode control_mode, int32_t* message);
 
   std::function<void(bool)> handle_program_state_;
   std::chrono::milliseconds step_time_;
 
   uint32_t keepalive_count_;
   bool keep_alive_count_modified_deprecated_;
+
+  std::atomic<bool> use_compact_protocol_;
+  std::atomic<bool> robot_supports_compact_;
+  std::atomic<bool> robot_echoes_setpoints_;
+  std::atomic<bool> program_parked_;
+
+  //! Handles a session ID announced by the robot
+  void handleSessionAnnouncement(const int32_t session_id);
+  //! Reports lost connections that weren't resumed in time
+  void resumeWatchdog();
+
+  std::atomic<int32_t> session_id_;
+  bool expecting_session_id_;
+  std::chrono::milliseconds session_resume_timeout_;
+  bool resume_pending_;
+  std::chrono::steady_clock::time_point resume_deadline_;
+  bool stop_resume_watchdog_;
+  std::mutex session_mutex_;
+  std::condition_variable session_cv_;
+  std::thread resume_watchdog_;
+
+  //! Writes keepalive messages while no other commands are written
+  void keepaliveLoop();
+
+  //! Writes heartbeats while the program is parked
+  void heartbeatLoop();
+
+  std::chrono::milliseconds heartbeat_period_;
+  bool stop_heartbeat_;
+  std::mutex heartbeat_mutex_;
+  std::condition_variable heartbeat_cv_;
+  std::thread heartbeat_thread_;
+
+  std::atomic<bool> automatic_keepalive_;
+  bool stop_keepalive_;
+  // The last command written, guarded by keepalive_mutex_
+  comm::ControlMode last_control_mode_;
+  int32_t last_read_timeout_;
+  std::chrono::steady_clock::time_point last_command_time_;
+  std::mutex keepalive_mutex_;
+  std::condition_variable keepalive_cv_;
+  std::thread keepalive_thread_;
+
+  //! A command written by write() waiting for the writer thread
+  struct QueuedSetpoint
+  {
+    vector6d_t values;
+    bool has_values;
+    comm::ControlMode control_mode;
+    int32_t read_timeout;
+    uint64_t sequence;
+    //! The setpoint isn't sent after this point in time
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  //! Sends a setpoint unless it expires before, see write()
+  bool writeBeforeDeadline(const vector6d_t* positions, comm::ControlMode control_mode,
+                           const RobotReceiveTimeout& robot_receive_timeout,
+                           const std::chrono::steady_clock::time_point deadline);
+  //! Counts a setpoint dropped because it expired
+  void countExpiredSetpoint();
+
+  //! Replaces a pose by the joint positions reaching it, see setInverseKinematics()
+  bool solvePose(const vector6d_t& pose, vector6d_t& q);
+
+  std::shared_ptr<const kinematics::KinematicsModel> ik_model_;
+  std::function<bool(vector6d_t&)> ik_seed_;
+  // Last solution, only used by the thread calling write()
+  vector6d_t ik_solution_;
+  bool ik_streaming_;
+  bool ik_has_solution_;
+  std::atomic<uint64_t> num_unreachable_poses_;
+  std::atomic<bool> robot_state_stale_;
+  std::atomic<uint64_t> num_stale_setpoints_;
+  std::atomic<int64_t> setpoint_validity_ns_;
+  std::atomic<uint64_t> num_expired_setpoints_;
+
+  //! Encodes and writes a command written by write()
+  bool writeSetpoint(const vector6d_t* positions, const comm::ControlMode control_mode, const int32_t read_timeout);
+  //! Sends the commands handed over by write()
+  void runSetpointWriter();
+  //! Keeps a command handed over by write() before from being sent after another one
+  void discardQueuedSetpoint();
+
+  comm::ProductQueue<QueuedSetpoint, QueuedSetpoint> setpoint_queue_;
+  std::atomic<bool> async_setpoint_writes_;
+  // Only written by the thread calling write()
+  std::atomic<uint64_t> published_setpoints_;
+  std::atomic<uint64_t> discarded_setpoints_;
+  std::thread setpoint_writer_;
+  ThreadConfig setpoint_writer_config_;
+  ReverseProtocol protocol_;
+  // Whether each message is followed by a sequence number, guarded by write_mutex_ like protocol_
+  bool sequenced_;
+  int32_t last_sequence_;
+  std::shared_ptr<SetpointLatencyMonitor> latency_monitor_;
+  std::shared_ptr<AdaptiveServojTuner> servoj_tuner_;
+  mutable std::mutex write_mutex_;
 };
 
 }  // namespace control
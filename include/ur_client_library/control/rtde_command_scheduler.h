@@ -0,0 +1,185 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_COMMAND_SCHEDULER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_COMMAND_SCHEDULER_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "ur_client_library/comm/control_mode.h"
+#include "ur_client_library/control/reverse_interface.h"
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/types.h"
+#include "ur_client_library/ur/robot_receive_timeout.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Writes a command to the reverse interface exactly once per received RTDE package,
+ * directly on the thread reading from the robot.
+ *
+ * Register onDataPackage() as an observer of the RTDE client, see
+ * rtde_interface::RTDEClient::addDataPackageObserver(). While the scheduler is active, every
+ * package received triggers a write of either the latest command set using setCommand() or of a
+ * command computed by a callback from the package itself. This closes the loop of reading the
+ * robot state, computing and sending a command within one thread and one wakeup per cycle.
+ */
+class RTDECommandScheduler
+{
+public:
+  /*!
+   * \brief Computes the command of a cycle from the data package just received. Returns false to
+   * skip writing a command in this cycle.
+   */
+  using CommandCallback = std::function<bool(const rtde_interface::DataPackage&, vector6d_t&)>;
+
+  /*!
+   * \brief Creates a new RTDECommandScheduler object. The scheduler is inactive until calling
+   * setActive().
+   *
+   * \param reverse_interface The reverse interface to write to. It has to outlive the scheduler.
+   * \param control_mode Control mode of the commands written, has to be a realtime control mode
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket used with
+   * every command written
+   *
+   * \throws UrException if the control mode isn't a realtime control mode
+   */
+  RTDECommandScheduler(ReverseInterface& reverse_interface, const comm::ControlMode control_mode,
+                       const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+  RTDECommandScheduler(const RTDECommandScheduler&) = delete;
+  RTDECommandScheduler& operator=(const RTDECommandScheduler&) = delete;
+
+  /*!
+   * \brief Sets the control mode and receive timeout of the commands written. Waits for a cycle
+   * being handled to finish.
+   *
+   * \param control_mode Control mode of the commands written, has to be a realtime control mode
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   *
+   * \throws UrException if the control mode isn't a realtime control mode
+   */
+  void setControlMode(const comm::ControlMode control_mode, const RobotReceiveTimeout& robot_receive_timeout);
+
+  /*!
+   * \brief Sets a callback computing the command of every cycle. With a callback set, commands
+   * set using setCommand() are ignored. Waits for a cycle being handled to finish, so it must not
+   * be called from the callback.
+   *
+   * \param callback Function called on the thread reading from the robot with each data package
+   * received. It has to return within one RTDE cycle. Pass an empty function to write the
+   * commands set using setCommand() again.
+   */
+  void setCommandCallback(CommandCallback callback);
+
+  /*!
+   * \brief Sets the command written in every cycle until it is replaced. This can be called from
+   * any thread.
+   *
+   * \param command The command
+   */
+  void setCommand(const vector6d_t& command);
+
+  /*!
+   * \brief Removes the command set using setCommand(). Nothing is written until a new command is
+   * set.
+   */
+  void clearCommand();
+
+  /*!
+   * \brief Activates or deactivates writing commands. Deactivating waits for a cycle being
+   * handled to finish, so nothing is written to the reverse interface after this returns. It must
+   * not be called from the command callback.
+   *
+   * \param active True to write commands, false to stop writing
+   */
+  void setActive(const bool active);
+
+  /*!
+   * \brief Checks whether commands are written.
+   */
+  bool isActive() const
+  {
+    return active_;
+  }
+
+  /*!
+   * \brief Writes the command of the cycle triggered by a received data package, if the scheduler
+   * is active.
+   *
+   * \param package The data package just received
+   */
+  void onDataPackage(const rtde_interface::DataPackage& package);
+
+  /*!
+   * \brief Getter for the number of commands written successfully.
+   */
+  uint64_t getNumWrites() const
+  {
+    return num_writes_;
+  }
+
+  /*!
+   * \brief Getter for the number of commands that couldn't be written, e.g. as the robot wasn't
+   * connected.
+   */
+  uint64_t getNumFailedWrites() const
+  {
+    return num_failed_writes_;
+  }
+
+private:
+  //! Throws if the control mode isn't a realtime control mode
+  static void checkControlMode(const comm::ControlMode control_mode);
+
+  ReverseInterface& reverse_interface_;
+  comm::ControlMode control_mode_;
+  RobotReceiveTimeout robot_receive_timeout_;
+  CommandCallback callback_;
+  // Held while a cycle is handled, so settings used by a cycle are only changed in between cycles
+  std::mutex cycle_mutex_;
+
+  vector6d_t command_;
+  bool has_command_;
+  std::mutex command_mutex_;
+
+  std::atomic<bool> active_;
+  std::atomic<uint64_t> num_writes_;
+  std::atomic<uint64_t> num_failed_writes_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_COMMAND_SCHEDULER_H_INCLUDED
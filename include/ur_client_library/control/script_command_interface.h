@@ -29,6 +29,14 @@
 #ifndef UR_CLIENT_LIBRARY_SCRIPT_COMMAND_INTERFACE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_SCRIPT_COMMAND_INTERFACE_H_INCLUDED
 
+#include <array>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ur_client_library/comm/notifying_future.h"
 #include "ur_client_library/control/reverse_interface.h"
 #include "ur_client_library/ur/tool_communication.h"
 
@@ -51,10 +59,107 @@ enum class ToolContactResult : int32_t
  * to forward script commands to the robot, which will be executed locally on the robot.
  *
  * The script commands will be executed in a separate thread in the external control script.
+ *
+ * Every command carries a sequence number, which the robot sends back once it has executed the
+ * command. The asynchronous variants of the commands return a future becoming ready with that
+ * acknowledgement, so several commands can be sent at once and waited for only as long as the
+ * robot actually needs to execute them. The future holds false, if the command couldn't be
+ * written or the robot disconnected before acknowledging it.
  */
 class ScriptCommandInterface : public ReverseInterface
 {
 public:
+  /*!
+   * \brief Several script commands sent in a single message by sendBatch() and executed by the
+   * robot in one go, e.g. for setting up the payload, tool voltage and force mode at once.
+   *
+   * The commands take the same arguments as their counterparts of the ScriptCommandInterface and
+   * are executed in the order they have been added.
+   */
+  class Batch
+  {
+  public:
+    //! Maximum number of commands in a batch
+    static const size_t MAX_COMMANDS = 16;
+
+    /*!
+     * \brief Adds zeroing the force torque sensor.
+     *
+     * \throws UrException if the batch is full already
+     */
+    void zeroFTSensor();
+
+    /*!
+     * \brief Adds setting the active payload mass and center of gravity, see
+     * ScriptCommandInterface::setPayload().
+     *
+     * \throws UrException if the batch is full already
+     */
+    void setPayload(const double mass, const vector3d_t* cog);
+
+    /*!
+     * \brief Adds setting the tool voltage, see ScriptCommandInterface::setToolVoltage().
+     *
+     * \throws UrException if the batch is full already
+     */
+    void setToolVoltage(const ToolVoltage voltage);
+
+    /*!
+     * \brief Adds starting force mode, see ScriptCommandInterface::startForceMode().
+     *
+     * \throws UrException if the batch is full already
+     */
+    void startForceMode(const vector6d_t* task_frame, const vector6uint32_t* selection_vector, const vector6d_t* wrench,
+                        const unsigned int type, const vector6d_t* limits, double damping_factor,
+                        double gain_scaling_factor);
+
+    /*!
+     * \brief Adds stopping force mode.
+     *
+     * \throws UrException if the batch is full already
+     */
+    void endForceMode();
+
+    /*!
+     * \brief Adds starting to look for tool contact, see ScriptCommandInterface::startToolContact().
+     *
+     * \throws UrException if the batch is full already
+     */
+    void startToolContact();
+
+    /*!
+     * \brief Adds stopping to look for tool contact, see ScriptCommandInterface::endToolContact().
+     *
+     * \throws UrException if the batch is full already
+     */
+    void endToolContact();
+
+    //! Number of commands in the batch
+    size_t size() const
+    {
+      return commands_.size();
+    }
+
+    bool empty() const
+    {
+      return commands_.empty();
+    }
+
+    void clear()
+    {
+      commands_.clear();
+    }
+
+  private:
+    friend class ScriptCommandInterface;
+    using Message = std::array<int32_t, wire::script_command::MESSAGE_LENGTH>;
+
+    //! Appends an empty message for the given command and returns it
+    int32_t* add(const int32_t command);
+
+    std::vector<Message> commands_;
+  };
+
   ScriptCommandInterface() = delete;
   /*!
    * \brief Creates a ScriptCommandInterface object, including a new TCPServer
@@ -70,6 +175,14 @@ public:
    */
   bool zeroFTSensor();
 
+  /*!
+   * \brief Asynchronous variant of zeroFTSensor(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> zeroFTSensorAsync();
+
   /*!
    * \brief Set the active payload mass and center of gravity
    *
@@ -81,6 +194,14 @@ public:
    */
   bool setPayload(const double mass, const vector3d_t* cog);
 
+  /*!
+   * \brief Asynchronous variant of setPayload(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> setPayloadAsync(const double mass, const vector3d_t* cog);
+
   /*!
    * \brief Set the tool voltage.
    *
@@ -90,6 +211,14 @@ public:
    */
   bool setToolVoltage(const ToolVoltage voltage);
 
+  /*!
+   * \brief Asynchronous variant of setToolVoltage(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> setToolVoltageAsync(const ToolVoltage voltage);
+
   /*!
    * \brief Set robot to be controlled in force mode.
    *
@@ -123,6 +252,17 @@ public:
                       const unsigned int type, const vector6d_t* limits, double damping_factor,
                       double gain_scaling_factor);
 
+  /*!
+   * \brief Asynchronous variant of startForceMode(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> startForceModeAsync(const vector6d_t* task_frame, const vector6uint32_t* selection_vector,
+                                                  const vector6d_t* wrench, const unsigned int type,
+                                                  const vector6d_t* limits, double damping_factor,
+                                                  double gain_scaling_factor);
+
   /*!
    * \brief Stop force mode and put the robot into normal operation mode.
    *
@@ -130,6 +270,14 @@ public:
    */
   bool endForceMode();
 
+  /*!
+   * \brief Asynchronous variant of endForceMode(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> endForceModeAsync();
+
   /*!
    * \brief This will make the robot look for tool contact in the tcp directions that the robot is currently
    * moving. Once a tool contact has been detected all movements will be canceled. Call endToolContact to enable
@@ -139,6 +287,14 @@ public:
    */
   bool startToolContact();
 
+  /*!
+   * \brief Asynchronous variant of startToolContact(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> startToolContactAsync();
+
   /*!
    * \brief This will stop the robot from looking for a tool contact, it will also enable sending move commands to the
    * robot again if the robot's tool is in contact
@@ -147,6 +303,32 @@ public:
    */
   bool endToolContact();
 
+  /*!
+   * \brief Asynchronous variant of endToolContact(), returning as soon as the command is written.
+   *
+   * \returns A future becoming ready once the robot has acknowledged the command. It holds
+   * false, if the command couldn't be written or wasn't acknowledged before the robot disconnected.
+   */
+  comm::NotifyingFuture<bool> endToolContactAsync();
+
+  /*!
+   * \brief Sends all commands of a batch in a single message, which the robot executes at once.
+   *
+   * \param batch The commands to send
+   *
+   * \returns True, if the write was performed successfully or the batch is empty, false otherwise.
+   */
+  bool sendBatch(const Batch& batch);
+
+  /*!
+   * \brief Asynchronous variant of sendBatch(), returning as soon as the batch is written.
+   *
+   * \returns A future becoming ready once the robot has executed all commands of the batch. It
+   * holds false, if the batch couldn't be written or wasn't acknowledged before the robot
+   * disconnected.
+   */
+  comm::NotifyingFuture<bool> sendBatchAsync(const Batch& batch);
+
   /*!
    * \brief  Returns whether a client/robot is connected to this server.
    *
@@ -170,6 +352,14 @@ protected:
 
   virtual void messageCallback(const int filedescriptor, char* buffer, int nbytesrecv) override;
 
+  /*!
+   * \brief Sets the sequence number the next command is sent with, e.g. for testing the wrap
+   * around after INT32_MAX.
+   *
+   * \param sequence_number Sequence number in [1, INT32_MAX]
+   */
+  void setNextSequenceNumber(const int32_t sequence_number);
+
 private:
   /*!
    * \brief Available script commands
@@ -184,10 +374,26 @@ private:
     END_FORCE_MODE = 4,      ///< End force mode
     START_TOOL_CONTACT = 5,  ///< Start detecting tool contact
     END_TOOL_CONTACT = 6,    ///< End detecting tool contact
+    BATCH = 7,               ///< Header of a batch of commands
   };
 
+  //! Writes a command message and registers it for being acknowledged
+  comm::NotifyingFuture<bool> sendCommand(int32_t* message);
+
+  //! Writes \p length fields starting with a message's header, the header carries the sequence number
+  comm::NotifyingFuture<bool> sendMessages(int32_t* messages, const size_t length);
+
+  //! Fails all commands still waiting for an acknowledgement
+  void failPendingAcknowledgements();
+
   bool client_connected_;
-  static const int MAX_MESSAGE_LENGTH = 28;
+  //! Number of fields in a command message, the last one holds the command's sequence number
+  static const int MAX_MESSAGE_LENGTH = wire::script_command::MESSAGE_LENGTH;
+
+  std::mutex acknowledgement_mutex_;
+  // Commands written and not acknowledged yet in the order they have been written
+  std::deque<std::pair<int32_t, comm::NotifyingPromise<bool>>> pending_acknowledgements_;
+  int32_t next_sequence_number_;
 
   std::function<void(ToolContactResult)> handle_tool_contact_result_;
 };
@@ -30,6 +30,7 @@
 #ifndef UR_CLIENT_LIBRARY_SCRIPT_SENDER_H_INCLUDED
 #define UR_CLIENT_LIBRARY_SCRIPT_SENDER_H_INCLUDED
 
+#include <mutex>
 #include <thread>
 #include <string>
 
@@ -56,10 +57,61 @@ public:
    */
   ScriptSender(uint32_t port, const std::string& program);
 
+  /*!
+   * \brief Replaces the program sent to the robot upon request.
+   *
+   * \param program Program to send to the robot from now on
+   */
+  void setProgram(const std::string& program);
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the thread serving the program to the robot.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config)
+  {
+    server_.setThreadConfig(config);
+  }
+
+  /*!
+   * \brief Sets tuning options for the socket of the robot connecting to this interface. See
+   * comm::TCPServer::setClientSocketOptions() for details.
+   *
+   * \param options The socket options
+   */
+  void setSocketOptions(const comm::SocketOptions& options)
+  {
+    server_.setClientSocketOptions(options);
+  }
+
+  /*!
+   * \brief Getter for the port the program is requested on. If the interface has been created with port 0, this
+   * is the port assigned by the operating system.
+   *
+   * \returns The bound port
+   */
+  uint32_t getPort() const
+  {
+    return static_cast<uint32_t>(server_.getPort());
+  }
+
+  /*!
+   * \brief Lets a reactor handle requests for the program instead of a thread of its own. See
+   * comm::TCPServer::setReactor() for details.
+   *
+   * \param reactor The reactor to use, nullptr to use a thread of its own
+   */
+  void setReactor(std::shared_ptr<comm::Reactor> reactor)
+  {
+    server_.setReactor(reactor);
+  }
+
 private:
   comm::TCPServer server_;
   std::thread script_thread_;
   std::string program_;
+  std::mutex program_mutex_;
 
   const std::string PROGRAM_REQUEST_ = std::string("request_program\n");
 
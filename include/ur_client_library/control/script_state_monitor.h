@@ -0,0 +1,127 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SCRIPT_STATE_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SCRIPT_STATE_MONITOR_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "ur_client_library/control/script_command_interface.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Decodes the state the external control script mirrors into an RTDE output integer
+ * register and reports changes of it.
+ *
+ * The script sets the register to a combination of the flags below whenever freedrive or tool
+ * contact detection change. Pass every new value of the register to update(), e.g. from a field
+ * change callback of the RTDE client, see rtde_interface::RTDEClient::addFieldChangeCallback().
+ * This way, changes are reported within one RTDE cycle and no messages on the script command
+ * socket are needed for tool contact results.
+ */
+class ScriptStateMonitor
+{
+public:
+  //! Set while freedrive mode is active
+  static constexpr int32_t FREEDRIVE_ACTIVE = 1;
+  //! Set while tool contact detection is running
+  static constexpr int32_t TOOL_CONTACT_RUNNING = 2;
+  //! Set once tool contact has been detected, until tool contact detection is started again
+  static constexpr int32_t TOOL_CONTACT_DETECTED = 4;
+
+  ScriptStateMonitor();
+
+  /*!
+   * \brief Sets a function called whenever freedrive mode is activated or deactivated.
+   *
+   * \param callback Function called with true if freedrive mode became active, false otherwise
+   */
+  void setFreedriveStateCallback(std::function<void(bool)> callback)
+  {
+    freedrive_state_callback_ = callback;
+  }
+
+  /*!
+   * \brief Sets a function called with the result of tool contact detection, i.e. once tool
+   * contact has been detected or tool contact detection has been ended without a contact.
+   *
+   * \param callback Function called with the tool contact result
+   */
+  void setToolContactResultCallback(std::function<void(ToolContactResult)> callback)
+  {
+    tool_contact_result_callback_ = callback;
+  }
+
+  /*!
+   * \brief Handles a new value of the state register and calls the callbacks of the changes.
+   *
+   * \param state The value of the state register
+   */
+  void update(const int32_t state);
+
+  /*!
+   * \brief Getter for the last value of the state register.
+   */
+  int32_t getState() const
+  {
+    return state_;
+  }
+
+  /*!
+   * \brief Checks whether freedrive mode is active.
+   */
+  bool isFreedriveActive() const
+  {
+    return (state_ & FREEDRIVE_ACTIVE) != 0;
+  }
+
+  /*!
+   * \brief Checks whether tool contact detection is running.
+   */
+  bool isToolContactRunning() const
+  {
+    return (state_ & TOOL_CONTACT_RUNNING) != 0;
+  }
+
+private:
+  std::atomic<int32_t> state_;
+  std::function<void(bool)> freedrive_state_callback_;
+  std::function<void(ToolContactResult)> tool_contact_result_callback_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SCRIPT_STATE_MONITOR_H_INCLUDED
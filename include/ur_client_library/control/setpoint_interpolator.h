@@ -0,0 +1,249 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SETPOINT_INTERPOLATOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SETPOINT_INTERPOLATOR_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ur_client_library/helpers.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Resamples sparse, timestamped setpoints to the robot's control rate.
+ *
+ * Setpoints can be added from any thread at any rate. Every time a cycle is notified, e.g. on the
+ * arrival of an RTDE package, the interpolator's thread samples the setpoints at the cycle's time
+ * minus a configurable delay and passes the result to an output function, which usually writes
+ * it to the reverse interface. This way a command is sent in every control cycle, even if the
+ * application produces setpoints at a lower or irregular rate.
+ *
+ * In between two setpoints, a cubic Hermite spline with Catmull-Rom tangents is used, so the
+ * sampled positions and velocities are continuous. After the last setpoint, its velocity is
+ * extrapolated for at most the configured extrapolation time. After that, the last extrapolated
+ * value is held.
+ *
+ * With time scaling enabled, the setpoints are sampled on a trajectory clock instead, which
+ * advances by the elapsed cycle time multiplied with the time scale of each cycle, e.g. the
+ * robot's speed scaling. When the robot is slowed down, the setpoints are slowed down the same way
+ * instead of running away from the robot.
+ */
+class SetpointInterpolator
+{
+public:
+  //! Sends a sampled setpoint, returns false if it couldn't be sent
+  using OutputFunction = std::function<bool(const vector6d_t&)>;
+
+  //! Maximum number of setpoints kept for interpolation
+  static const size_t MAX_SETPOINTS = 16;
+
+  //! Default time the last setpoint's velocity is extrapolated for
+  static constexpr std::chrono::milliseconds DEFAULT_MAX_EXTRAPOLATION{ 20 };
+
+  /*!
+   * \brief Creates a new SetpointInterpolator object. Sampling cycles are handled after calling
+   * start().
+   *
+   * \param output Function called from the interpolator's thread with every sampled setpoint
+   * \param delay Time the sampling lags behind the cycle times. Setpoints arriving later than
+   * this are extrapolated to.
+   */
+  explicit SetpointInterpolator(OutputFunction output,
+                                const std::chrono::microseconds delay = std::chrono::microseconds(0));
+  SetpointInterpolator(const SetpointInterpolator&) = delete;
+  SetpointInterpolator& operator=(const SetpointInterpolator&) = delete;
+  ~SetpointInterpolator();
+
+  /*!
+   * \brief Adds a setpoint to interpolate. If a setpoint with the same time exists already, it is
+   * replaced.
+   *
+   * \param setpoint The setpoint
+   * \param time Time the robot should reach the setpoint
+   *
+   * \returns False if the setpoint is older than the latest setpoint and was discarded, true
+   * otherwise
+   */
+  bool addSetpoint(const vector6d_t& setpoint, const std::chrono::steady_clock::time_point time);
+
+  /*!
+   * \brief Removes all setpoints. Until a new setpoint is added, nothing is sent anymore.
+   */
+  void clear();
+
+  /*!
+   * \brief Samples the setpoints at a given time.
+   *
+   * \param time Time to sample at
+   * \param setpoint Target for the sampled setpoint
+   *
+   * \returns False if there are no setpoints, true otherwise
+   */
+  bool sample(const std::chrono::steady_clock::time_point time, vector6d_t& setpoint) const;
+
+  /*!
+   * \brief Sets the time the sampling lags behind the cycle times.
+   *
+   * \param delay The delay
+   */
+  void setDelay(const std::chrono::microseconds delay);
+
+  /*!
+   * \brief Getter for the time the sampling lags behind the cycle times.
+   */
+  std::chrono::microseconds getDelay() const;
+
+  /*!
+   * \brief Sets for how long the last setpoint's velocity is extrapolated.
+   *
+   * \param max_extrapolation Maximum extrapolation time, 0 to hold the last setpoint
+   */
+  void setMaxExtrapolation(const std::chrono::microseconds max_extrapolation);
+
+  /*!
+   * \brief Starts the thread handling the cycles. Does nothing if it is running already.
+   */
+  void start();
+
+  /*!
+   * \brief Stops the thread handling the cycles. The setpoints are kept.
+   */
+  void stop();
+
+  /*!
+   * \brief Checks whether the thread handling the cycles is running.
+   */
+  bool isRunning() const
+  {
+    return running_;
+  }
+
+  /*!
+   * \brief Lets the interpolator's thread sample the setpoints and send the result. Returns
+   * immediately. A cycle notified while the previous one is still being handled replaces it.
+   *
+   * \param cycle_time Time of the cycle, e.g. the receive time of an RTDE package
+   * \param time_scale Factor the trajectory clock advances with in this cycle, only used with time
+   * scaling enabled. Negative values are treated as 0.
+   */
+  void notifyCycle(const std::chrono::steady_clock::time_point cycle_time, const double time_scale = 1.0);
+
+  /*!
+   * \brief Lets the setpoints be sampled on a trajectory clock advancing with the time scale of
+   * each cycle instead of the cycle times.
+   *
+   * The trajectory clock starts at the first cycle's time minus the delay, once time scaling has
+   * been enabled or the setpoints have been cleared, so it matches the cycle times as long as the
+   * time scale is 1. Times of added setpoints refer to the trajectory clock, see
+   * getTrajectoryTime().
+   *
+   * \param enabled True to scale the time, false to sample at the cycle times again
+   */
+  void setTimeScaling(const bool enabled);
+
+  /*!
+   * \brief Checks whether time scaling is enabled.
+   */
+  bool isTimeScalingEnabled() const;
+
+  /*!
+   * \brief Getter for the time the setpoints have last been sampled at. With time scaling enabled,
+   * this is the trajectory clock, which lags behind the cycle times while the robot is slowed down.
+   *
+   * \returns The last sampling time, the epoch if nothing has been sampled yet
+   */
+  std::chrono::steady_clock::time_point getTrajectoryTime() const;
+
+  /*!
+   * \brief Getter for the number of cycles in which a setpoint had to be extrapolated, as no
+   * setpoint newer than the sampling time existed.
+   */
+  uint64_t getNumExtrapolatedCycles() const
+  {
+    return num_extrapolated_cycles_;
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the interpolator's thread. They are applied
+   * when the thread is started and, if it is running already, immediately.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+private:
+  struct Setpoint
+  {
+    vector6d_t value;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  //! Samples the setpoints, returns false if there are none. Has to be called with mutex_ locked.
+  bool sampleLocked(const std::chrono::steady_clock::time_point time, vector6d_t& setpoint, bool& extrapolated) const;
+
+  void run();
+
+  OutputFunction output_;
+  std::deque<Setpoint> setpoints_;
+  std::chrono::microseconds delay_;
+  std::chrono::microseconds max_extrapolation_;
+  bool time_scaling_;
+  // Trajectory clock, it is restarted on the next cycle if not valid
+  bool trajectory_time_valid_;
+  std::chrono::steady_clock::time_point trajectory_time_;
+  std::chrono::steady_clock::time_point last_cycle_time_;
+  mutable std::mutex mutex_;
+
+  std::thread thread_;
+  ThreadConfig thread_config_;
+  std::atomic<bool> running_;
+  std::atomic<uint64_t> num_extrapolated_cycles_;
+  std::mutex run_mutex_;
+  std::condition_variable run_cv_;
+  bool cycle_pending_;
+  std::chrono::steady_clock::time_point cycle_time_;
+  double cycle_time_scale_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SETPOINT_INTERPOLATOR_H_INCLUDED
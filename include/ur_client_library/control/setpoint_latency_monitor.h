@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_SETPOINT_LATENCY_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SETPOINT_LATENCY_MONITOR_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ur_client_library/comm/latency_statistics.h"
+#include "ur_client_library/metrics.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Measures the round trip of setpoints written to the ReverseInterface, which the external
+ * control script echoes into an RTDE output integer register.
+ *
+ * The ReverseInterface numbers every setpoint it sends and calls recordSent() once it has been
+ * written to the socket. The script writes the number of the last setpoint it has handed to the
+ * motion thread into the register. Register onDataPackage() as an observer of the RTDE client, see
+ * rtde_interface::RTDEClient::addDataPackageObserver(). Every time the echoed number changes, the
+ * time from writing that setpoint until receiving the package is recorded. This covers the network
+ * in both directions, the script's reaction and up to one RTDE period until the echo is published.
+ *
+ * The latencies are recorded into getLatencyHistogram() and reported as the
+ * \p urcl_setpoint_round_trip_seconds metric, see getMetricsRegistry().
+ */
+class SetpointLatencyMonitor
+{
+public:
+  //! Number of setpoints whose send time is kept to be matched with their echo
+  static const size_t HISTORY_SIZE = 256;
+
+  SetpointLatencyMonitor() = delete;
+
+  /*!
+   * \brief Creates a new SetpointLatencyMonitor object.
+   *
+   * \param echo_register Index of the output integer register the script echoes the setpoints into
+   */
+  explicit SetpointLatencyMonitor(const int echo_register);
+
+  /*!
+   * \brief Remembers the time a setpoint has been written. This is called by the ReverseInterface
+   * and doesn't allocate or lock.
+   *
+   * \param sequence The setpoint's sequence number, greater than 0
+   * \param send_time The time the setpoint has been written to the socket
+   */
+  void recordSent(const int32_t sequence, const std::chrono::steady_clock::time_point send_time);
+
+  /*!
+   * \brief Reads the echoed sequence number from a data package and records the latency of the
+   * setpoint, if the number has changed.
+   *
+   * \param package The data package just received. Packages whose recipe lacks the echo register
+   * are ignored.
+   */
+  void onDataPackage(const rtde_interface::DataPackage& package);
+
+  /*!
+   * \brief Getter for the distribution of the measured round trips.
+   */
+  const comm::LatencyHistogram& getLatencyHistogram() const
+  {
+    return latencies_;
+  }
+
+  /*!
+   * \brief Getter for the round trip measured last.
+   *
+   * \returns The latency, 0 if nothing has been measured yet
+   */
+  std::chrono::microseconds getLastLatency() const
+  {
+    return std::chrono::microseconds(last_latency_us_.load(std::memory_order_relaxed));
+  }
+
+  /*!
+   * \brief Getter for the number of echoes of setpoints sent too long ago to be matched, e.g. after
+   * the script has been restarted.
+   */
+  uint64_t getNumUnmatchedEchoes() const
+  {
+    return unmatched_echoes_.load(std::memory_order_relaxed);
+  }
+
+  //! Name of the RTDE output field the setpoints are echoed into
+  const std::string& getEchoField() const
+  {
+    return echo_field_;
+  }
+
+private:
+  struct SentSetpoint
+  {
+    std::atomic<int32_t> sequence{ 0 };
+    std::atomic<int64_t> send_time_ns{ 0 };
+  };
+
+  const std::string echo_field_;
+  std::array<SentSetpoint, HISTORY_SIZE> sent_;
+
+  // Only accessed by the thread passing the data packages
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  rtde_interface::FieldHandle<int32_t> echo_handle_;
+  int32_t last_echo_;
+
+  comm::LatencyHistogram latencies_;
+  std::atomic<int64_t> last_latency_us_;
+  std::atomic<uint64_t> unmatched_echoes_;
+  Histogram& latency_metric_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SETPOINT_LATENCY_MONITOR_H_INCLUDED
@@ -0,0 +1,226 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SHARED_COMMANDS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SHARED_COMMANDS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/control/command_arbiter.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Makes a CommandArbiter available to other processes on the same host through a POSIX
+ * shared memory segment.
+ *
+ * The segment holds a fixed number of client slots. Each slot is claimed by one
+ * SharedCommandClient and contains its control request and a mailbox for its latest joint
+ * command, protected by a sequence lock. A thread polls the slots, creates a CommandClient for
+ * every claimed slot and forwards requests and commands to the arbiter, i.e. the processes never
+ * wait for each other. Slots of processes that exited without releasing them are freed.
+ *
+ * Only joint commands, stopping the robot and control requests are available through the segment.
+ * Trajectories have to be sent by in-process clients.
+ */
+class SharedCommandServer
+{
+public:
+  //! Default number of client slots
+  static constexpr size_t DEFAULT_SLOT_COUNT = 8;
+
+  SharedCommandServer() = delete;
+
+  /*!
+   * \brief Creates the shared memory segment and starts polling it. An existing segment of the
+   * same name is replaced.
+   *
+   * \param arbiter The arbiter the commands are forwarded to, it has to outlive the server
+   * \param name Name of the shared memory segment, e.g. "/urcl_commands"
+   * \param slot_count Maximum number of clients connected at the same time
+   * \param poll_period Time between polling the slots, i.e. the latency added to commands
+   *
+   * \throws UrException if the slot count is 0 or the segment cannot be created
+   */
+  SharedCommandServer(CommandArbiter& arbiter, const std::string& name, const size_t slot_count = DEFAULT_SLOT_COUNT,
+                      const std::chrono::microseconds poll_period = std::chrono::microseconds(500));
+  SharedCommandServer(const SharedCommandServer&) = delete;
+  SharedCommandServer& operator=(const SharedCommandServer&) = delete;
+
+  /*!
+   * \brief Stops polling, removes the clients from the arbiter and removes the segment. Clients
+   * still having it mapped can detect this using SharedCommandClient::isActive().
+   */
+  ~SharedCommandServer();
+
+  /*!
+   * \brief Getter for the name of the shared memory segment.
+   */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * \brief Getter for the number of clients currently connected through the segment.
+   */
+  size_t getNumConnectedClients() const
+  {
+    return num_connected_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // State of a slot as seen by the polling thread
+  struct SlotState
+  {
+    std::shared_ptr<CommandClient> client;
+    uint32_t generation = 0;
+    bool requested = false;
+    uint64_t handled_sequence = 0;
+    uint64_t handled_stops = 0;
+  };
+
+  void run();
+  void poll(const size_t index, const bool check_liveness);
+  void disconnect(const size_t index);
+
+  CommandArbiter& arbiter_;
+  std::string name_;
+  size_t slot_count_;
+  std::chrono::microseconds poll_period_;
+  size_t segment_size_;
+  uint8_t* segment_;
+  std::vector<SlotState> slots_;
+  std::atomic<size_t> num_connected_;
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+
+/*!
+ * \brief Commands the robot through a SharedCommandServer, possibly in another process.
+ *
+ * All methods only write into the client's slot of the shared memory segment and return right
+ * away. The server picks up requests and commands within its poll period, so hasControl() reflects
+ * a request only after that. Joint commands replace each other, the server forwards the latest one
+ * it finds. A client must only be used by one thread at a time.
+ */
+class SharedCommandClient
+{
+public:
+  SharedCommandClient() = delete;
+
+  /*!
+   * \brief Maps an existing segment and claims a free slot.
+   *
+   * \param segment_name Name of the shared memory segment as passed to the server
+   * \param name Name of the client, used for logging. Longer names are truncated to 31 characters.
+   * \param priority Priority of the client, higher values take precedence
+   *
+   * \throws UrException if the segment doesn't exist, hasn't been created by a
+   * SharedCommandServer or has no free slot
+   */
+  SharedCommandClient(const std::string& segment_name, const std::string& name, const int32_t priority);
+  SharedCommandClient(const SharedCommandClient&) = delete;
+  SharedCommandClient& operator=(const SharedCommandClient&) = delete;
+
+  /*!
+   * \brief Frees the slot, releasing control if the client is in control.
+   */
+  ~SharedCommandClient();
+
+  /*!
+   * \brief Requests control of the robot, see CommandClient::requestControl().
+   */
+  void requestControl();
+
+  /*!
+   * \brief Gives up control or withdraws a pending request, see CommandClient::releaseControl().
+   */
+  void releaseControl();
+
+  /*!
+   * \brief Checks whether the server has granted control to this client.
+   */
+  bool hasControl() const;
+
+  /*!
+   * \brief Writes a joint command into the mailbox, see CommandClient::writeJointCommand().
+   *
+   * \param values Joint positions, velocities, pose, twist or wrench depending on the control mode
+   * \param control_mode Control mode of the command, comm::ControlMode::MODE_STOPPED is rejected
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   *
+   * \returns False, if the control mode is rejected or the server is gone, true otherwise. Whether
+   * the command reaches the robot depends on the client being in control, see
+   * getNumRejectedCommands().
+   */
+  bool writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                         const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+
+  /*!
+   * \brief Requests stopping the robot, see CommandClient::stopMotion(). Unlike joint commands,
+   * stop requests are never replaced by later commands.
+   *
+   * \returns False, if the server is gone, true otherwise
+   */
+  bool stopMotion();
+
+  /*!
+   * \brief Getter for the number of commands the server rejected, because the client wasn't in
+   * control.
+   */
+  uint64_t getNumRejectedCommands() const;
+
+  /*!
+   * \brief Checks whether the server is still serving the segment. Once this returns false, a new
+   * client has to be created.
+   */
+  bool isActive() const;
+
+private:
+  size_t segment_size_;
+  uint8_t* segment_;
+  uint8_t* slot_;
+  uint64_t sequence_;
+  uint64_t stops_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SHARED_COMMANDS_H_INCLUDED
@@ -0,0 +1,142 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SPLINE_PLANNER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SPLINE_PLANNER_H_INCLUDED
+
+#include <vector>
+
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Velocity and acceleration limits of the robot's joints used for planning.
+ */
+struct JointLimits
+{
+  vector6d_t max_velocity;      ///< Maximum joint velocities [rad/s]
+  vector6d_t max_acceleration;  ///< Maximum joint accelerations [rad/s^2]
+};
+
+/*!
+ * \brief Plans joint spline trajectories on the client, so the robot only has to execute them.
+ *
+ * planTrajectory() assigns durations, velocities and accelerations to a sequence of joint
+ * waypoints. Every segment starts out with the shortest duration a quintic moving in between two
+ * rests would need to stay within the joint limits. Velocities and accelerations at the waypoints
+ * are chosen from the neighbouring segments' average slopes, and segments exceeding the limits
+ * are stretched until the whole trajectory stays within them. The result is not strictly time
+ * optimal, but it is never rejected by the robot for violating the limits.
+ *
+ * computeSegments() turns spline points into segments with precomputed coefficients, which the
+ * robot can execute without computing the quintic coefficients itself.
+ *
+ * The computations over the six joints are written as plain loops over fixed size arrays, so the
+ * compiler can vectorise them.
+ */
+class SplinePlanner
+{
+public:
+  //! Shortest duration assigned to a segment
+  static constexpr double MIN_SEGMENT_DURATION = 0.008;
+
+  //! Maximum number of times the segments are stretched until they stay within the limits
+  static const size_t MAX_ITERATIONS = 20;
+
+  SplinePlanner() = delete;
+  /*!
+   * \brief Creates a new SplinePlanner object.
+   *
+   * \param limits Joint limits the planned trajectories have to stay within
+   *
+   * \throws UrException if any of the limits isn't positive
+   */
+  explicit SplinePlanner(const JointLimits& limits);
+
+  /*!
+   * \brief Plans a quintic spline trajectory through the given waypoints.
+   *
+   * The trajectory starts and ends at rest.
+   *
+   * \param start Joint positions the robot is at when the trajectory is started
+   * \param waypoints Joint positions to pass through, the last one is the trajectory's target
+   * \param points Filled with one spline point per waypoint
+   *
+   * \returns True, if a trajectory within the limits was found, false otherwise. In that case,
+   * the points hold the last attempt.
+   */
+  bool planTrajectory(const vector6d_t& start, const std::vector<vector6d_t>& waypoints,
+                      std::vector<TrajectorySplinePoint>& points) const;
+
+  /*!
+   * \brief Precomputes the coefficients of a spline trajectory starting at rest.
+   *
+   * Points without accelerations are treated as having zero acceleration, so all segments are
+   * quintic. The segments are relative to the start, so it has to match the robot's joint
+   * positions when the trajectory is started.
+   *
+   * \param start Joint positions the robot is at when the trajectory is started
+   * \param points Spline points of the trajectory, e.g. planned using planTrajectory()
+   * \param segments Filled with one segment per point, see
+   * TrajectoryPointInterface::writeTrajectorySplineSegments()
+   */
+  static void computeSegments(const vector6d_t& start, const std::vector<TrajectorySplinePoint>& points,
+                              std::vector<TrajectorySplineSegment>& segments);
+
+  /*!
+   * \brief Get the joint limits used for planning.
+   *
+   * \returns The joint limits
+   */
+  const JointLimits& getLimits() const
+  {
+    return limits_;
+  }
+
+private:
+  //! Sets velocities and accelerations of the points from the segments' durations
+  void setWaypointStates(const vector6d_t& start, const std::vector<double>& durations,
+                         std::vector<TrajectorySplinePoint>& points) const;
+
+  //! Returns by how much a segment exceeds the limits, values up to 1 stay within them
+  double limitRatio(const vector6d_t& start_q, const vector6d_t& start_qd, const vector6d_t& start_qdd,
+                    const TrajectorySplinePoint& end, const double duration) const;
+
+  JointLimits limits_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SPLINE_PLANNER_H_INCLUDED
@@ -0,0 +1,221 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SPLINE_SIMULATOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SPLINE_SIMULATOR_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief State of the simulated robot at the end of a control cycle.
+ */
+struct SplineSimulationSample
+{
+  double time;            ///< Time since the trajectory has been started [s]
+  vector6d_t q;           ///< Joint positions [rad]
+  vector6d_t qd;          ///< Joint velocities [rad/s]
+  double scaling_factor;  ///< Scaling applied while slowing down at the end of the trajectory
+  size_t point_index;     ///< Index of the point or segment being executed
+};
+
+/*!
+ * \brief Outcome of a simulated spline trajectory.
+ */
+struct SplineSimulationResult
+{
+  TrajectoryResult result = TrajectoryResult::TRAJECTORY_RESULT_UNKNOWN;  ///< Result the robot would report
+  double motion_time = 0.0;     ///< Time until the last spline step has been executed [s]
+  double execution_time = 0.0;  ///< Time including stopping the robot at the end [s]
+  size_t num_steps = 0;         ///< Number of control cycles used by the spline steps
+  size_t num_points = 0;        ///< Number of points or segments processed, including a canceled one
+  bool slowed_down = false;     ///< True, if the last point had to be slowed down to end at rest
+  vector6d_t final_q;           ///< Joint positions after the robot has stopped [rad]
+  std::vector<SplineSimulationSample> samples;  ///< One sample per control cycle, if recorded
+};
+
+/*!
+ * \brief Host-side reference implementation of the spline interpolation of the external control
+ * script.
+ *
+ * The simulator runs the same computations as cubicSplineRun(), quinticSplineRun(),
+ * precomputedSplineRun() and jointSplineRun() in the script, including the limit check, skipping a
+ * first point with time 0 and slowing down towards the end of the last point. It is deterministic
+ * and doesn't need a robot or URSim, so it can be used for fast regression tests of trajectories
+ * and to predict how long the robot takes to execute them.
+ *
+ * The robot itself is modelled as an ideal joint velocity controller. Every speedj() call of the
+ * script takes one control cycle, in which the joints reach the commanded velocity with the given
+ * acceleration and keep it for the rest of the cycle. The final stopj() decelerates all joints
+ * with the same acceleration. The simulated joint positions are fed back into the next segment
+ * like get_joint_positions() on the robot. Effects of the real controller such as tracking errors,
+ * the speed slider and protective stops aren't modelled.
+ */
+class SplineSimulator
+{
+public:
+  //! Control cycle of e-Series robots [s]
+  static constexpr double DEFAULT_STEP_TIME = 0.002;
+  //! Joint speed the script scales down from at the end of a trajectory [rad/s]
+  static constexpr double MAX_JOINT_SPEED = 6.283185;
+  //! Joint speed, above which the script rejects a target [rad/s]
+  static constexpr double JOINT_IGNORE_SPEED = 20.0;
+  //! Deceleration used to check whether the end of a trajectory has to be slowed down [rad/s^2]
+  static constexpr double MAX_DECELERATION = 15.0;
+  //! Acceleration of the stopj() at the end of a trajectory [rad/s^2]
+  static constexpr double STOPJ_ACCELERATION = 4.0;
+
+  /*!
+   * \brief Creates a new SplineSimulator object.
+   *
+   * \param step_time Control cycle of the simulated robot
+   * \param quantize If true, all values are rounded to the resolution they are sent to the robot
+   * with, see TrajectoryPointInterface
+   *
+   * \throws UrException if the step time isn't positive
+   */
+  explicit SplineSimulator(const double step_time = DEFAULT_STEP_TIME, const bool quantize = true);
+
+  /*!
+   * \brief Simulates a trajectory of spline points. Points with accelerations are interpolated
+   * quintic, others cubic.
+   *
+   * \param start Joint positions the robot is at when the trajectory is started
+   * \param points Points of the trajectory
+   * \param record_samples If true, the robot's state is recorded in every control cycle
+   *
+   * \returns The simulated execution of the trajectory
+   */
+  SplineSimulationResult run(const vector6d_t& start, const std::vector<TrajectorySplinePoint>& points,
+                             const bool record_samples = false);
+
+  /*!
+   * \brief Simulates a trajectory of segments with precomputed coefficients, see
+   * TrajectoryPointInterface::writeTrajectorySplineSegments().
+   *
+   * \param start Joint positions the robot is at when the trajectory is started
+   * \param segments Segments of the trajectory
+   * \param record_samples If true, the robot's state is recorded in every control cycle
+   *
+   * \returns The simulated execution of the trajectory
+   */
+  SplineSimulationResult run(const vector6d_t& start, const std::vector<TrajectorySplineSegment>& segments,
+                             const bool record_samples = false);
+
+  /*!
+   * \brief Checks whether the script accepts a target, like targetWithinLimits() in the script.
+   *
+   * \param start Joint positions at the start of the segment
+   * \param end Joint positions at the end of the segment
+   * \param time Duration of the segment
+   *
+   * \returns False, if any joint would have to move faster than JOINT_IGNORE_SPEED
+   */
+  static bool targetWithinLimits(const vector6d_t& start, const vector6d_t& end, const double time);
+
+  /*!
+   * \brief Checks whether the end of the last point has to be slowed down, like
+   * checkSlowDownRequired() in the script.
+   *
+   * \param x Time left to decelerate
+   * \param qd Joint velocities after the next step
+   * \param max_deceleration Deceleration the allowed speed decreases with
+   *
+   * \returns True, if any joint is faster than MAX_JOINT_SPEED - x * max_deceleration
+   */
+  static bool checkSlowDownRequired(const double x, const vector6d_t& qd, const double max_deceleration);
+
+  /*!
+   * \brief Getter for the control cycle of the simulated robot.
+   */
+  double getStepTime() const
+  {
+    return step_time_;
+  }
+
+private:
+  //! Polynomial coefficients of a segment. The constant part is the joint position at its start.
+  struct Coefficients
+  {
+    vector6d_t c1, c2, c3, c4, c5;
+  };
+
+  void reset(const vector6d_t& start, const bool record_samples);
+  //! Returns true, if the robot keeps moving after the point
+  bool cubicSplineRun(const vector6d_t& end_q, const vector6d_t& end_qd, const double time, const bool is_last_point,
+                      const bool is_first_point);
+  bool quinticSplineRun(const vector6d_t& end_q, const vector6d_t& end_qd, const vector6d_t& end_qdd,
+                        const double time, const bool is_last_point, const bool is_first_point);
+  bool precomputedSplineRun(const TrajectorySplineSegment& segment, const double time, const bool is_last_point);
+  bool zeroTimePoint(const vector6d_t& end_q, const double time, const bool is_first_point);
+  void jointSplineRun(const Coefficients& coefficients, const double total_time, const bool is_last_point);
+  void jointSplineStep(const Coefficients& coefficients, const double traveled, const double timestep,
+                       const double scaling_factor);
+  void speedj(const vector6d_t& qd, const double acceleration, const double timestep);
+  void stopj();
+  void record(const double scaling_factor);
+  double quantize(const double value, const int32_t multiplier) const;
+  vector6d_t quantize(const vector6d_t& values) const;
+  SplineSimulationResult finish();
+
+  double step_time_;
+  bool quantize_;
+
+  // Simulated robot
+  vector6d_t q_;
+  vector6d_t qd_;
+  double time_;
+  size_t num_steps_;
+  size_t point_index_;
+  bool record_samples_;
+  bool slowed_down_;
+  TrajectoryResult trajectory_result_;
+  std::vector<SplineSimulationSample> samples_;
+
+  // Globals of the script
+  vector6d_t spline_qd_;
+  vector6d_t spline_qdd_;
+  vector6d_t spline_planned_q_;
+  vector6d_t spline_planned_qd_;
+  vector6d_t spline_planned_qdd_;
+  bool spline_planned_valid_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SPLINE_SIMULATOR_H_INCLUDED
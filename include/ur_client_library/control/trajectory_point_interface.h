@@ -29,7 +29,13 @@
 #ifndef UR_CLIENT_LIBRARY_TRAJECTORY_INTERFACE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_TRAJECTORY_INTERFACE_H_INCLUDED
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "ur_client_library/control/reverse_interface.h"
 #include "ur_client_library/comm/control_mode.h"
@@ -54,13 +60,24 @@ enum class TrajectoryResult : int32_t
 
 std::string trajectoryResultToString(const TrajectoryResult result);
 
+/*!
+ * \brief Answers of the robot to a request for replaying a cached trajectory.
+ */
+enum class TrajectoryReplayResult : int32_t
+{
+  NO_ANSWER = 0,   ///< The request couldn't be sent or the robot didn't answer in time
+  STARTED = 1,     ///< The trajectory is executed from the robot's trajectory cache
+  NOT_CACHED = 2,  ///< The trajectory isn't cached and has to be uploaded again
+};
+
 /*!
  * Spline types
  */
 enum class TrajectorySplineType : int32_t
 {
   SPLINE_CUBIC = 1,
-  SPLINE_QUINTIC = 2
+  SPLINE_QUINTIC = 2,
+  SPLINE_PRECOMPUTED = 3  ///< Quintic segment with coefficients computed by the client, see TrajectorySplineSegment
 };
 
 /*!
@@ -70,7 +87,68 @@ enum class TrajectoryMotionType : int32_t
 {
   JOINT_POINT = 0,
   CARTESIAN_POINT = 1,
-  JOINT_POINT_SPLINE = 2
+  JOINT_POINT_SPLINE = 2,
+  STREAM_END = 3,      ///< Not a motion, marks the end of a streamed trajectory
+  PROCESS_POINT = 4,   ///< Cartesian target reached with constant tool speed (movep)
+  CIRCULAR_POINT = 5   ///< Cartesian target reached on a circular path through a via pose (movec)
+};
+
+/*!
+ * \brief A joint or Cartesian target of a motion trajectory, see
+ * TrajectoryPointInterface::writeTrajectoryPoints().
+ */
+struct TrajectoryPoint
+{
+  vector6d_t positions;      ///< Joint or Cartesian target of the robot
+  float acceleration = 1.4;  ///< Acceleration of the leading axis [rad/s^2] / tool acceleration [m/s^2]
+  float velocity = 1.05;     ///< Speed of the leading axis [rad/s] / tool speed [m/s]
+  float goal_time = 0;       ///< Time to reach the target. If non-zero, has priority over speed and acceleration.
+  float blend_radius = 0;    ///< Radius to be used for blending between control points
+  bool cartesian = false;    ///< True, if the target is specified in Cartesian space
+  bool process = false;      ///< True to move with constant tool speed (movep). Implies cartesian, ignores goal_time.
+};
+
+/*!
+ * \brief A Cartesian target reached on a circular path, see
+ * TrajectoryPointInterface::writeTrajectoryCircularPoints().
+ */
+struct TrajectoryCircularPoint
+{
+  vector6d_t via_pose;       ///< Pose the circular path passes through
+  vector6d_t target_pose;    ///< Cartesian target of the robot
+  float acceleration = 1.2;  ///< Tool acceleration [m/s^2]
+  float velocity = 0.25;     ///< Tool speed [m/s]
+  float blend_radius = 0;    ///< Radius to be used for blending between control points
+  int32_t mode = 0;          ///< Orientation mode of movec: 0 unconstrained, 1 fixed
+};
+
+/*!
+ * \brief A point of a joint spline trajectory, see TrajectoryPointInterface::writeTrajectorySplinePoints().
+ */
+struct TrajectorySplinePoint
+{
+  vector6d_t positions;                     ///< Joint target positions
+  vector6d_t velocities;                    ///< Joint target velocities
+  std::optional<vector6d_t> accelerations;  ///< Joint target accelerations. Without, cubic interpolation is used.
+  float goal_time = 0;                      ///< Time to reach the target point
+};
+
+/*!
+ * \brief A quintic joint spline segment with precomputed coefficients, see
+ * TrajectoryPointInterface::writeTrajectorySplineSegments().
+ *
+ * The coefficients are scaled by the respective power of the segment's duration, so they are given
+ * in radians. The lower order coefficients follow from the state the previous segment ends in, so
+ * consecutive segments have continuous velocities and accelerations. The first segment starts at
+ * rest from the robot's current joint positions. SplinePlanner::computeSegments() creates segments
+ * from spline points.
+ */
+struct TrajectorySplineSegment
+{
+  vector6d_t coefficients3;  ///< Cubic coefficients multiplied by duration^3
+  vector6d_t coefficients4;  ///< Quartic coefficients multiplied by duration^4
+  vector6d_t coefficients5;  ///< Quintic coefficients multiplied by duration^5
+  float duration = 0;        ///< Duration of the segment
 };
 
 /*!
@@ -80,8 +158,16 @@ enum class TrajectoryMotionType : int32_t
 class TrajectoryPointInterface : public ReverseInterface
 {
 public:
-  static const int32_t MULT_TIME = 1000;
-  static const int MESSAGE_LENGTH = 21;
+  static const int32_t MULT_TIME = wire::MULT_TIME;
+  static const int MESSAGE_LENGTH = wire::trajectory::MESSAGE_LENGTH;
+  //! Sent by the robot for every point of a streamed trajectory it has taken from the socket
+  static const int32_t STREAM_POINT_CONSUMED = -2;
+  //! Sent by the robot before executing a trajectory from its trajectory cache
+  static const int32_t REPLAY_STARTED = -3;
+  //! Sent by the robot instead of executing a trajectory missing in its trajectory cache
+  static const int32_t REPLAY_NOT_CACHED = -4;
+  //! Maximum number of points sent at once by a bulk write, a cancel takes effect in between
+  static const size_t UPLOAD_CHUNK_SIZE = 32;
 
   TrajectoryPointInterface() = delete;
   /*!
@@ -141,6 +227,172 @@ public:
   bool writeTrajectorySplinePoint(const vector6d_t* positions, const vector6d_t* velocities,
                                   const vector6d_t* accelerations, const float goal_time);
 
+  /*!
+   * \brief Writes a whole motion trajectory to the robot.
+   *
+   * All points are encoded into one buffer which is sent using as few syscalls as possible. This
+   * is considerably faster than calling writeTrajectoryPoint() for each point of a long trajectory.
+   * While a batch is started, the points are added to it instead.
+   *
+   * \param points Array of trajectory points
+   * \param count Number of points in the array
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool writeTrajectoryPoints(const TrajectoryPoint* points, const size_t count);
+
+  /*!
+   * \brief Writes a whole spline trajectory to the robot.
+   *
+   * All points are encoded into one buffer which is sent using as few syscalls as possible. This
+   * is considerably faster than calling writeTrajectorySplinePoint() for each point of a long
+   * trajectory. While a batch is started, the points are added to it instead.
+   *
+   * \param points Array of spline points
+   * \param count Number of points in the array
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool writeTrajectorySplinePoints(const TrajectorySplinePoint* points, const size_t count);
+
+  /*!
+   * \brief Writes a whole circular motion trajectory to the robot, see writeTrajectoryPoints().
+   *
+   * \param points Array of circular points
+   * \param count Number of points in the array
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool writeTrajectoryCircularPoints(const TrajectoryCircularPoint* points, const size_t count);
+
+  /*!
+   * \brief Writes a whole spline trajectory with precomputed coefficients to the robot, see
+   * writeTrajectorySplinePoints().
+   *
+   * \param segments Array of spline segments
+   * \param count Number of segments in the array
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool writeTrajectorySplineSegments(const TrajectorySplineSegment* segments, const size_t count);
+
+  /*!
+   * \brief Queue the trajectory points written from now on instead of sending them one by one.
+   *
+   * writeTrajectoryPoint() and writeTrajectorySplinePoint() only add their messages to a batch
+   * until flushTrajectoryBatch() sends the whole batch at once. This saves a syscall per point when
+   * forwarding a full trajectory to the robot.
+   */
+  void startTrajectoryBatch();
+
+  /*!
+   * \brief Sends all trajectory points queued since startTrajectoryBatch() and stops batching.
+   *
+   * \returns True, if the batch was written successfully, false otherwise. The batch is discarded
+   * in either case.
+   */
+  bool flushTrajectoryBatch();
+
+  /*!
+   * \brief Start flow control for a trajectory streamed to the robot.
+   *
+   * From now on, at most window_size points written are in flight, i.e. sent but not yet taken
+   * from the socket by the robot. Writing more points blocks until the robot has consumed enough
+   * of them, so arbitrarily long trajectories can be streamed without overrunning the controller.
+   * Bulk writes are split accordingly. Points written while streaming are never batched.
+   *
+   * The robot has to be switched to streaming using
+   * ReverseInterface::writeTrajectoryControlMessage() with TrajectoryControlMessage::TRAJECTORY_STREAM.
+   * Streaming lasts until endTrajectoryStream() is called, the trajectory ends on the robot or the
+   * robot disconnects. Writes blocking at that point return false.
+   *
+   * \param window_size Maximum number of points in flight
+   *
+   * \throws UrException if the window size is 0
+   */
+  void startTrajectoryStream(const size_t window_size);
+
+  /*!
+   * \brief Tells the robot that the streamed trajectory is complete.
+   *
+   * The robot finishes the points in flight and reports the result of the trajectory as usual.
+   * Streamed trajectories are not slowed down towards their end, so the last point should be
+   * chosen accordingly.
+   *
+   * \returns True, if the write was performed successfully, false otherwise.
+   */
+  bool endTrajectoryStream();
+
+  /*!
+   * \brief Checks whether flow control for a streamed trajectory is active.
+   *
+   * \returns True between startTrajectoryStream() and the end of the stream
+   */
+  bool isStreaming() const;
+
+  /*!
+   * \brief Get the number of streamed points sent, but not yet consumed by the robot.
+   *
+   * \returns The number of points in flight
+   */
+  size_t getPointsInFlight() const;
+
+  /*!
+   * \brief Waits until the window of a streamed trajectory has room for at least one point.
+   *
+   * This allows generating points only once they can be sent without blocking.
+   *
+   * \param timeout Maximum time to wait
+   *
+   * \returns True, if a point can be written, false on timeout or if not streaming.
+   */
+  bool waitForStreamWindow(const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Stops writing the points of the current trajectory, e.g. because it is canceled.
+   *
+   * Bulk writes in progress return false once the chunk currently being sent is complete, and
+   * writes waiting for the stream window return false right away. Further points and batches are
+   * rejected until resumeTrajectoryWrites() is called, so the robot only has to discard the points
+   * already sent instead of waiting for the rest of the upload.
+   *
+   * \returns The number of points written since resumeTrajectoryWrites(), including the end of a
+   * streamed trajectory. Send it with the cancel, so the robot discards exactly the points it didn't
+   * read yet, see ReverseInterface::setTrajectoryWritesCanceler().
+   */
+  size_t cancelTrajectoryWrites();
+
+  /*!
+   * \brief Accepts points again after cancelTrajectoryWrites() and restarts counting the points
+   * written. Call this before the points of the next trajectory are written.
+   */
+  void resumeTrajectoryWrites();
+
+  /*!
+   * \brief Checks whether writing points has been canceled using cancelTrajectoryWrites().
+   *
+   * \returns True, if points are rejected
+   */
+  bool isTrajectoryWritingCanceled() const
+  {
+    return writes_canceled_;
+  }
+
+  /*!
+   * \brief Forgets the answer to a previous replay request. Call this before requesting a replay,
+   * so waitForReplayAnswer() doesn't return an outdated answer.
+   */
+  void resetReplayAnswer();
+
+  /*!
+   * \brief Waits for the robot to answer a request for replaying a cached trajectory.
+   *
+   * \param timeout Maximum time to wait
+   *
+   * \returns The robot's answer or TrajectoryReplayResult::NO_ANSWER on timeout.
+   */
+  TrajectoryReplayResult waitForReplayAnswer(const std::chrono::milliseconds timeout);
+
   void setTrajectoryEndCallback(std::function<void(TrajectoryResult)> callback)
   {
     handle_trajectory_end_ = callback;
@@ -154,7 +406,44 @@ protected:
   virtual void messageCallback(const int filedescriptor, char* buffer, int nbytesrecv) override;
 
 private:
+  //! Sends the messages of num_points points or adds them to the current batch. The points are
+  //! sent in chunks of at most UPLOAD_CHUNK_SIZE points, which fit into the window while streaming.
+  bool writeMessage(const uint8_t* buffer, const size_t num_points);
+
+  //! Blocks until at least one point fits into the stream window. Returns the number of points
+  //! out of max_points that may be sent, 0 if streaming ended while waiting.
+  size_t reserveStreamWindow(const size_t max_points);
+
+  //! Stops streaming and wakes up all writes waiting for the window
+  void stopTrajectoryStream();
+
+  //! Counts points about to be written, false if writing them has been canceled
+  bool countPointsWritten(const size_t num_points);
+
+  //! Converts the native values in encode_buffer_ to network byte order and sends them
+  bool writeEncodeBuffer();
+
   std::function<void(TrajectoryResult)> handle_trajectory_end_;
+  bool batching_;
+  std::vector<uint8_t> batch_;
+  // Messages of bulk writes in host byte order, reused to avoid allocating for every trajectory
+  std::vector<int32_t> encode_buffer_;
+  std::atomic<bool> writes_canceled_;
+  // Serializes counting points with canceling, so the points written are known once canceled
+  std::mutex upload_mutex_;
+  // Points written or being written since resumeTrajectoryWrites(), guarded by upload_mutex_
+  size_t points_written_;
+
+  mutable std::mutex stream_mutex_;
+  std::condition_variable stream_window_cv_;
+  bool streaming_;
+  size_t stream_window_size_;
+  size_t points_in_flight_;
+  std::mutex replay_mutex_;
+  std::condition_variable replay_cv_;
+  TrajectoryReplayResult replay_answer_;
+  //! Number of finished trajectories per TrajectoryResult, starting with TRAJECTORY_RESULT_UNKNOWN
+  std::array<Counter*, 4> result_metrics_;
 };
 
 }  // namespace control
@@ -0,0 +1,144 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRAJECTORY_PROGRESS_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRAJECTORY_PROGRESS_MONITOR_H_INCLUDED
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Progress of the trajectory executed by the external control script.
+ */
+struct TrajectoryProgress
+{
+  //! Index of the executed point, counting from 0 for every trajectory. -1 if no trajectory is executed.
+  int32_t point_index = -1;
+  //! Time in seconds left until the executed point is reached
+  double time_left = 0.0;
+  //! Robot time in seconds the progress has been sampled at, as in the \p timestamp field
+  double robot_time = 0.0;
+};
+
+/*!
+ * \brief Decodes the progress of the executed trajectory, which the external control script
+ * mirrors into an RTDE output integer and an output double register every control cycle.
+ *
+ * The integer register holds the index of the executed trajectory point, the double register the
+ * time left until it is reached. Spline points count down the interpolated time, so speed scaling
+ * is taken into account. For all other points, the nominal time of the point counts down.
+ *
+ * Register onDataPackage() as an observer of the RTDE client, see
+ * rtde_interface::RTDEClient::addDataPackageObserver(). The progress callback is then called on
+ * the thread reading from the robot with every package received while a trajectory is executed and
+ * once more when it has ended.
+ */
+class TrajectoryProgressMonitor
+{
+public:
+  //! Called with the progress of every cycle, it has to return quickly
+  using ProgressCallback = std::function<void(const TrajectoryProgress&)>;
+
+  TrajectoryProgressMonitor() = delete;
+
+  /*!
+   * \brief Creates a new TrajectoryProgressMonitor object.
+   *
+   * \param index_register Index of the output integer register holding the point index
+   * \param time_register Index of the output double register holding the time left
+   */
+  TrajectoryProgressMonitor(const int index_register, const int time_register);
+
+  /*!
+   * \brief Sets a function called with the progress of every cycle a trajectory is executed in and
+   * of the cycle it has ended in. It has to be set before data packages are passed.
+   */
+  void setProgressCallback(ProgressCallback callback)
+  {
+    callback_ = callback;
+  }
+
+  /*!
+   * \brief Reads the progress from a data package and passes it to the callback.
+   *
+   * \param package The data package just received. Packages whose recipe lacks the progress
+   * registers are ignored.
+   */
+  void onDataPackage(const rtde_interface::DataPackage& package);
+
+  /*!
+   * \brief Getter for the progress of the last data package.
+   */
+  TrajectoryProgress getProgress() const
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return progress_;
+  }
+
+  //! Name of the RTDE output field holding the point index
+  const std::string& getIndexField() const
+  {
+    return index_field_;
+  }
+
+  //! Name of the RTDE output field holding the time left
+  const std::string& getTimeField() const
+  {
+    return time_field_;
+  }
+
+private:
+  const std::string index_field_;
+  const std::string time_field_;
+
+  // Only accessed by the thread passing the data packages
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  rtde_interface::FieldHandle<int32_t> index_handle_;
+  rtde_interface::FieldHandle<double> time_handle_;
+  rtde_interface::FieldHandle<double> timestamp_handle_;
+
+  mutable std::mutex mutex_;
+  TrajectoryProgress progress_;
+  ProgressCallback callback_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRAJECTORY_PROGRESS_MONITOR_H_INCLUDED
@@ -0,0 +1,150 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRAJECTORY_REDUCER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRAJECTORY_REDUCER_H_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ur_client_library/control/motion_primitives.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/kinematics.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Settings of a TrajectoryReducer.
+ */
+struct TrajectoryReductionOptions
+{
+  //! Maximum deviation of any joint from the original trajectory at a removed point [rad]
+  double joint_tolerance = 0.001;
+  //! Maximum number of consecutive segments merged into one
+  size_t max_merged_segments = 100;
+  //! Blend radius assigned to the inner joint targets kept of a run points were removed from [m].
+  //! With 0, the original blend radii are kept.
+  double blend_radius = 0.0;
+  //! If set, blend radii are limited to half the TCP distance to the neighbouring targets, so
+  //! consecutive blends don't overlap
+  std::shared_ptr<const kinematics::KinematicsModel> model;
+};
+
+/*!
+ * \brief Removes points from dense trajectories, e.g. planner output, as long as the path stays
+ * within a tolerance of the original one.
+ *
+ * Every point uploaded costs a message on the trajectory socket and a loop iteration of the
+ * robot's trajectory thread. Consecutive points that lie nearly on the path between their
+ * neighbours add little but this overhead.
+ *
+ * Points are removed using the Douglas-Peucker algorithm. Runs of consecutive joint motions
+ * (movej targets with equal speed and acceleration) are reduced against the straight joint space
+ * path the robot moves on. Runs of consecutive spline points
+ * are reduced against the spline the robot interpolates between the remaining points, evaluated
+ * at the times of the removed points. The goal times of removed points are added to the next
+ * remaining point, so the trajectory's timing is kept. The first and last point of every run are
+ * always kept, all other primitives are passed on unchanged.
+ */
+class TrajectoryReducer
+{
+public:
+  TrajectoryReducer() = delete;
+
+  /*!
+   * \brief Creates a new TrajectoryReducer object.
+   *
+   * \param options Tolerance and blend radius settings
+   *
+   * \throws UrException if the tolerance or blend radius is negative or no segments may be merged
+   */
+  explicit TrajectoryReducer(const TrajectoryReductionOptions& options);
+
+  /*!
+   * \brief Reduces a sequence of motion primitives.
+   *
+   * \param motions Pointer to the first motion primitive
+   * \param count Number of motion primitives
+   * \param reduced Filled with the remaining motion primitives
+   *
+   * \returns The number of primitives removed
+   */
+  size_t reduce(const MotionPrimitiveValue* motions, const size_t count,
+                std::vector<MotionPrimitiveValue>& reduced) const;
+
+  /*!
+   * \brief Reduces a sequence of motion primitives, see reduce().
+   */
+  size_t reduce(const std::vector<MotionPrimitiveValue>& motions, std::vector<MotionPrimitiveValue>& reduced) const;
+
+  /*!
+   * \brief Reduces a spline trajectory, e.g. before writing it using
+   * TrajectoryPointInterface::writeTrajectorySplinePoints().
+   *
+   * \param points Spline points of the trajectory
+   * \param reduced Filled with the remaining spline points
+   *
+   * \returns The number of points removed
+   */
+  size_t reduce(const std::vector<TrajectorySplinePoint>& points, std::vector<TrajectorySplinePoint>& reduced) const;
+
+  /*!
+   * \brief Get the reduction settings.
+   */
+  const TrajectoryReductionOptions& getOptions() const
+  {
+    return options_;
+  }
+
+private:
+  //! Appends the indices of the points to keep out of [begin, end) of a spline run
+  void reduceSplineRun(const TrajectorySplinePoint* points, const size_t begin, const size_t end,
+                       std::vector<size_t>& kept) const;
+  //! Appends the indices of the targets to keep out of [begin, end) of a joint motion run
+  void reduceJointRun(const vector6d_t* targets, const size_t begin, const size_t end,
+                      std::vector<size_t>& kept) const;
+  //! Appends the indices of the points to keep out of [begin, end), given the deviation of a point
+  //! k from the segment between two points kept
+  template <typename Deviation>
+  void simplify(const size_t begin, const size_t end, std::vector<size_t>& kept, Deviation deviation) const;
+  //! Blend radius of a joint target kept in between the given neighbours
+  double blendRadius(const vector6d_t& previous_pose, const vector6d_t& pose, const vector6d_t& next_pose) const;
+
+  TrajectoryReductionOptions options_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRAJECTORY_REDUCER_H_INCLUDED
@@ -0,0 +1,149 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRAJECTORY_START_TRIGGER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRAJECTORY_START_TRIGGER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Starts an armed trajectory at a given robot time by writing its start token into an
+ * RTDE input register, directly on the thread reading from the robot.
+ *
+ * A trajectory started with TrajectoryControlMessage::TRAJECTORY_START_ARMED is received by the
+ * robot program, but only executed once the start register holds its start token. Register
+ * onDataPackage() as an observer of the RTDE client, see
+ * rtde_interface::RTDEClient::addDataPackageObserver(). Once a start has been scheduled, the token
+ * is written after the package sent in the cycle before the scheduled robot time, so the robot
+ * picks it up in the control cycle closest to that time. Robots whose
+ * start times are mapped from the same host time using their clock synchronizers thereby start
+ * within one control period of each other.
+ */
+class TrajectoryStartTrigger
+{
+public:
+  /*!
+   * \brief Writes a start token into the start register. Returns false if it couldn't be written.
+   */
+  using WriteFunction = std::function<bool(int32_t)>;
+
+  /*!
+   * \brief State of the scheduled start.
+   */
+  enum class State
+  {
+    IDLE,     ///< No start has been scheduled
+    PENDING,  ///< The start has been scheduled, but the token hasn't been written yet
+    FIRED,    ///< The token has been written
+    FAILED    ///< The token couldn't be written
+  };
+
+  TrajectoryStartTrigger();
+  TrajectoryStartTrigger(const TrajectoryStartTrigger&) = delete;
+  TrajectoryStartTrigger& operator=(const TrajectoryStartTrigger&) = delete;
+
+  /*!
+   * \brief Schedules writing a start token. A start scheduled before is replaced.
+   *
+   * \param token Start token of the armed trajectory
+   * \param robot_time Robot time in seconds, as in the \p timestamp field, the trajectory should
+   * start at
+   */
+  void schedule(const int32_t token, const double robot_time);
+
+  /*!
+   * \brief Cancels a scheduled start, that hasn't been triggered yet.
+   */
+  void cancel();
+
+  /*!
+   * \brief Writes the start token, if a start is pending and its time has come.
+   *
+   * \param package The data package just received. Its recipe has to contain \p timestamp.
+   * \param write Function writing the start token into the start register of the robot the
+   * package has been received from
+   */
+  void onDataPackage(const rtde_interface::DataPackage& package, const WriteFunction& write);
+
+  /*!
+   * \brief Waits for the scheduled start to be triggered.
+   *
+   * \param timeout Maximum time to wait
+   *
+   * \returns True if the start token has been written, false if writing failed, the start has been
+   * cancelled, nothing is scheduled or the timeout passed
+   */
+  bool waitForTrigger(const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Getter for the state of the scheduled start.
+   */
+  State getState() const;
+
+  /*!
+   * \brief Getter for the \p timestamp of the package the start token has been written after.
+   *
+   * \returns The robot time in seconds, 0 if the start hasn't been triggered
+   */
+  double getTriggerTime() const;
+
+private:
+  // Only used by the thread reading from the robot
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  rtde_interface::FieldHandle<double> timestamp_handle_;
+  bool has_previous_;
+  double previous_timestamp_;
+
+  // Lets onDataPackage() skip locking while no start is pending
+  std::atomic<bool> pending_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  State state_;
+  int32_t token_;
+  double robot_time_;
+  double trigger_time_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRAJECTORY_START_TRIGGER_H_INCLUDED
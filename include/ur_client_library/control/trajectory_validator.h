@@ -0,0 +1,225 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRAJECTORY_VALIDATOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRAJECTORY_VALIDATOR_H_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/control/motion_primitives.h"
+#include "ur_client_library/control/spline_planner.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/kinematics.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Reasons a trajectory is rejected by a TrajectoryValidator.
+ */
+enum class TrajectoryViolation
+{
+  NONE = 0,                ///< The trajectory is valid
+  INVALID_VALUE = 1,       ///< A value isn't finite or a parameter is out of its range, e.g. a negative speed
+  POSITION_LIMIT = 2,      ///< A joint target is outside of the joint position limits
+  VELOCITY_LIMIT = 3,      ///< A velocity exceeds the joint velocity limits
+  ACCELERATION_LIMIT = 4,  ///< An acceleration exceeds the joint acceleration limits
+  WORKSPACE = 5            ///< A TCP target is outside of the Cartesian workspace
+};
+
+std::string trajectoryViolationToString(const TrajectoryViolation violation);
+
+/*!
+ * \brief Result of validating a trajectory.
+ */
+struct TrajectoryValidationResult
+{
+  TrajectoryViolation violation = TrajectoryViolation::NONE;  ///< First violation found
+  size_t index = 0;  ///< Index of the motion or point violating the limits
+
+  /*!
+   * \brief Checks whether the trajectory is valid.
+   */
+  explicit operator bool() const
+  {
+    return violation == TrajectoryViolation::NONE;
+  }
+};
+
+/*!
+ * \brief Checks whole trajectories against joint and workspace limits on the client, before they
+ * are uploaded to the robot.
+ *
+ * The robot only checks a motion's target when it starts executing it, so an invalid point aborts
+ * a trajectory in the middle of the motion. The validator rejects such a trajectory before any of
+ * it is sent. For every joint target, the positions have to be within the position limits. For
+ * spline points, the given velocities and accelerations have to be within the joint limits, and
+ * the average velocity needed to reach a joint target in its goal time must not exceed them
+ * either. Speed and acceleration of joint motions without a goal time are leading axis values,
+ * which must not exceed the largest joint limit. Optionally, the TCP has to stay within an
+ * axis-aligned box relative to the robot's base. Cartesian targets are checked directly, joint
+ * targets using the forward kinematics of a model, which computes all targets of the trajectory
+ * in one batch.
+ *
+ * The element-wise checks use the vector instructions of joint_space, so a trajectory of
+ * thousands of points is validated in well below a millisecond.
+ */
+class TrajectoryValidator
+{
+public:
+  TrajectoryValidator() = delete;
+
+  /*!
+   * \brief Creates a new TrajectoryValidator object with joint positions limited to +-2pi.
+   *
+   * \param limits Joint velocity and acceleration limits
+   *
+   * \throws UrException if any of the limits isn't positive
+   */
+  explicit TrajectoryValidator(const JointLimits& limits);
+
+  /*!
+   * \brief Creates a new TrajectoryValidator object.
+   *
+   * \param limits Joint velocity and acceleration limits
+   * \param position_min Lower joint position limits [rad]
+   * \param position_max Upper joint position limits [rad]
+   *
+   * \throws UrException if any of the limits isn't positive or a lower position limit is above
+   * the upper one
+   */
+  TrajectoryValidator(const JointLimits& limits, const vector6d_t& position_min, const vector6d_t& position_max);
+
+  /*!
+   * \brief Restricts the TCP to an axis-aligned box relative to the robot's base.
+   *
+   * \param lower Lower corner of the box [m]
+   * \param upper Upper corner of the box [m]
+   * \param model Kinematics used to check joint targets. Without, only Cartesian targets are
+   * checked.
+   *
+   * \throws UrException if the lower corner is above the upper one
+   */
+  void setWorkspace(const vector3d_t& lower, const vector3d_t& upper,
+                    std::shared_ptr<const kinematics::KinematicsModel> model = nullptr);
+
+  /*!
+   * \brief Removes the workspace set using setWorkspace().
+   */
+  void clearWorkspace();
+
+  /*!
+   * \brief Validates a sequence of motion primitives, e.g. before it is executed by an
+   * InstructionExecutor.
+   *
+   * \param motions Pointer to the first motion primitive
+   * \param count Number of motion primitives
+   *
+   * \returns The first violation found, indexing the motion primitive
+   */
+  TrajectoryValidationResult validate(const MotionPrimitiveValue* motions, const size_t count) const;
+
+  /*!
+   * \brief Validates a sequence of motion primitives, see validate().
+   */
+  TrajectoryValidationResult validate(const std::vector<MotionPrimitiveValue>& motions) const;
+
+  /*!
+   * \brief Validates a sequence of motion primitives, see validate(). Primitives of unknown type
+   * are skipped.
+   */
+  TrajectoryValidationResult validate(const std::vector<std::shared_ptr<MotionPrimitive>>& motions) const;
+
+  /*!
+   * \brief Validates joint and Cartesian trajectory points, see
+   * TrajectoryPointInterface::writeTrajectoryPoints().
+   *
+   * \param points Pointer to the first point
+   * \param count Number of points
+   *
+   * \returns The first violation found, indexing the point
+   */
+  TrajectoryValidationResult validate(const TrajectoryPoint* points, const size_t count) const;
+
+  /*!
+   * \brief Validates joint spline points, see TrajectoryPointInterface::writeTrajectorySplinePoints().
+   *
+   * \param points Pointer to the first point
+   * \param count Number of points
+   *
+   * \returns The first violation found, indexing the point
+   */
+  TrajectoryValidationResult validate(const TrajectorySplinePoint* points, const size_t count) const;
+
+  /*!
+   * \brief Validates circular motion points, see
+   * TrajectoryPointInterface::writeTrajectoryCircularPoints().
+   *
+   * \param points Pointer to the first point
+   * \param count Number of points
+   *
+   * \returns The first violation found, indexing the point
+   */
+  TrajectoryValidationResult validate(const TrajectoryCircularPoint* points, const size_t count) const;
+
+  /*!
+   * \brief Get the joint velocity and acceleration limits.
+   */
+  const JointLimits& getLimits() const
+  {
+    return limits_;
+  }
+
+private:
+  //! State of validating one trajectory
+  class Pass;
+
+  JointLimits limits_;
+  vector6d_t position_min_;
+  vector6d_t position_max_;
+  //! Largest joint limits, bounding the leading axis of joint motions
+  double max_leading_velocity_;
+  double max_leading_acceleration_;
+
+  bool has_workspace_;
+  vector6d_t workspace_min_;
+  vector6d_t workspace_max_;
+  std::shared_ptr<const kinematics::KinematicsModel> model_;
+};
+
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRAJECTORY_VALIDATOR_H_INCLUDED
@@ -0,0 +1,384 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_WIRE_PROTOCOL_H_INCLUDED
+#define UR_CLIENT_LIBRARY_WIRE_PROTOCOL_H_INCLUDED
+
+#include <endian.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ur_client_library/comm/control_mode.h"
+
+namespace urcl
+{
+namespace control
+{
+/*!
+ * \brief Layouts of the messages sent to the external control script.
+ *
+ * Messages on the reverse, trajectory and script command sockets are sequences of big-endian
+ * int32 values, read by the script using socket_read_binary_integer(). Every message is described
+ * by a Message listing its fields. The C++ encoders write fields using encode(), the script uses
+ * the field indices rendered by generateURScriptDefinitions() into the {{WIRE_PROTOCOL_REPLACE}}
+ * placeholder. Changing a layout here changes both sides.
+ */
+namespace wire
+{
+//! Conversion of a field's values into the integers sent
+enum class Scale
+{
+  RAW,          ///< Integers sent as they are
+  JOINT_STATE,  ///< Multiplied by MULT_JOINTSTATE, e.g. positions, velocities or wrenches
+  TIME          ///< Multiplied by MULT_TIME, e.g. durations in seconds or blend radii
+};
+
+//! Multiplier of values scaled using Scale::JOINT_STATE
+constexpr int32_t MULT_JOINTSTATE = 1000000;
+//! Multiplier of values scaled using Scale::TIME
+constexpr int32_t MULT_TIME = 1000;
+
+/*!
+ * \brief A field of a message, made of \p width consecutive integers.
+ */
+struct Field
+{
+  const char* name;  ///< Name of the field in the script, without the message's name
+  size_t offset;     ///< Position of the field's first integer in the message
+  size_t width;      ///< Number of integers
+  Scale scale;       ///< Conversion of the field's values
+
+  constexpr size_t end() const
+  {
+    return offset + width;
+  }
+};
+
+/*!
+ * \brief Layout of a message with \p N fields. Integers not covered by a field are sent as zero.
+ */
+template <size_t N>
+struct Message
+{
+  const char* name;  ///< Prefix of the message's definitions in the script
+  size_t length;     ///< Number of integers in the message
+  std::array<Field, N> fields;
+
+  /*!
+   * \brief Checks that the fields are ordered by their offset, don't overlap and fit into the
+   * message.
+   */
+  constexpr bool isWellFormed() const
+  {
+    size_t end = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+      if (fields[i].width == 0 || fields[i].offset < end)
+      {
+        return false;
+      }
+      end = fields[i].end();
+    }
+    return end <= length;
+  }
+
+  /*!
+   * \brief Number of integers up to and including the last field starting before \p limit.
+   */
+  constexpr size_t usedLength(const size_t limit) const
+  {
+    size_t end = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+      if (fields[i].offset < limit && fields[i].end() > end)
+      {
+        end = fields[i].end();
+      }
+    }
+    return end;
+  }
+};
+
+constexpr int32_t multiplier(const Scale scale)
+{
+  return scale == Scale::JOINT_STATE ? MULT_JOINTSTATE : (scale == Scale::TIME ? MULT_TIME : 1);
+}
+
+//! Converts a value into the integer sent for a field
+inline int32_t toWire(const Field& field, const double value)
+{
+  return static_cast<int32_t>(std::round(value * multiplier(field.scale)));
+}
+
+//! Writes a raw integer into a single-integer field of a message in host byte order
+inline void encode(int32_t* message, const Field& field, const int32_t value)
+{
+  message[field.offset] = value;
+}
+
+//! Writes a value into a single-integer field of a message in host byte order
+inline void encode(int32_t* message, const Field& field, const double value)
+{
+  message[field.offset] = toWire(field, value);
+}
+
+//! Writes an array of values into a field of the same width in host byte order
+template <typename T, size_t M>
+inline void encode(int32_t* message, const Field& field, const std::array<T, M>& values)
+{
+  for (size_t i = 0; i < M; ++i)
+  {
+    message[field.offset + i] = toWire(field, static_cast<double>(values[i]));
+  }
+}
+
+//! Writes the same value into all integers of a field in host byte order
+inline void fill(int32_t* message, const Field& field, const double value)
+{
+  const int32_t wire_value = toWire(field, value);
+  for (size_t i = 0; i < field.width; ++i)
+  {
+    message[field.offset + i] = wire_value;
+  }
+}
+
+//! Converts encoded messages into network byte order
+inline void toBigEndian(int32_t* values, const size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    values[i] = htobe32(values[i]);
+  }
+}
+
+/*!
+ * \brief Messages sent on the reverse socket.
+ *
+ * Every message starts with the read timeout and ends with the control mode. In the compact
+ * protocol, both are combined into a header followed by the payload fields of the control mode
+ * only, see compactPayloadLength().
+ */
+namespace reverse
+{
+constexpr size_t MESSAGE_LENGTH = 8;
+
+constexpr Field READ_TIMEOUT{ "READ_TIMEOUT", 0, 1, Scale::RAW };
+constexpr Field CONTROL_MODE{ "CONTROL_MODE", MESSAGE_LENGTH - 1, 1, Scale::RAW };
+
+//! Setpoints of the realtime control modes
+constexpr Field SETPOINT_VALUES{ "VALUES", 1, 6, Scale::JOINT_STATE };
+constexpr Message<3> SETPOINT{ "REVERSE_SETPOINT", MESSAGE_LENGTH, { READ_TIMEOUT, SETPOINT_VALUES, CONTROL_MODE } };
+
+//! Trajectory control messages in MODE_FORWARD
+constexpr Field TRAJECTORY_ACTION{ "ACTION", 1, 1, Scale::RAW };
+constexpr Field TRAJECTORY_POINT_COUNT{ "POINT_COUNT", 2, 1, Scale::RAW };
+constexpr Field TRAJECTORY_ID{ "ID", 3, 1, Scale::RAW };
+constexpr Message<5> TRAJECTORY{ "REVERSE_TRAJECTORY",
+                                 MESSAGE_LENGTH,
+                                 { READ_TIMEOUT, TRAJECTORY_ACTION, TRAJECTORY_POINT_COUNT, TRAJECTORY_ID,
+                                   CONTROL_MODE } };
+
+//! Freedrive control messages in MODE_FREEDRIVE
+constexpr Field FREEDRIVE_ACTION{ "ACTION", 1, 1, Scale::RAW };
+constexpr Message<3> FREEDRIVE{ "REVERSE_FREEDRIVE", MESSAGE_LENGTH, { READ_TIMEOUT, FREEDRIVE_ACTION, CONTROL_MODE } };
+
+//! Selects the protocol of the following messages, sent with PROTOCOL_SELECT as control mode. If
+//! SEQUENCED is 1, every following message is followed by the sequence number of its setpoint.
+constexpr Field PROTOCOL_PROTOCOL{ "PROTOCOL", 1, 1, Scale::RAW };
+constexpr Field PROTOCOL_SEQUENCED{ "SEQUENCED", 2, 1, Scale::RAW };
+constexpr Message<4> PROTOCOL{ "REVERSE_PROTOCOL",
+                               MESSAGE_LENGTH,
+                               { READ_TIMEOUT, PROTOCOL_PROTOCOL, PROTOCOL_SEQUENCED, CONTROL_MODE } };
+
+//! Control mode field of servo parameter messages. They don't change the control mode, but use the
+//! value below the heartbeat's, so they can be encoded in the compact protocol's header as well.
+constexpr int32_t SERVO_PARAMETERS_MODE = 12;
+
+//! Lookahead time and gain of servoj, sent with SERVO_PARAMETERS_MODE as control mode
+constexpr Field SERVO_LOOKAHEAD_TIME{ "LOOKAHEAD_TIME", 1, 1, Scale::TIME };
+constexpr Field SERVO_GAIN{ "GAIN", 2, 1, Scale::RAW };
+constexpr Message<4> SERVO_PARAMETERS{ "REVERSE_SERVO_PARAMETERS",
+                                       MESSAGE_LENGTH,
+                                       { READ_TIMEOUT, SERVO_LOOKAHEAD_TIME, SERVO_GAIN, CONTROL_MODE } };
+
+static_assert(SETPOINT.isWellFormed() && TRAJECTORY.isWellFormed() && FREEDRIVE.isWellFormed() &&
+                  PROTOCOL.isWellFormed() && SERVO_PARAMETERS.isWellFormed(),
+              "Malformed reverse interface message");
+
+//! Number of payload fields of a compact message with the given message's layout
+template <size_t N>
+constexpr size_t compactPayloadLength(const Message<N>& message)
+{
+  return message.usedLength(CONTROL_MODE.offset) - READ_TIMEOUT.end();
+}
+
+//! Number of payload fields of a compact message in the given control mode
+constexpr size_t compactPayloadLength(const comm::ControlMode control_mode)
+{
+  if (static_cast<int32_t>(control_mode) == SERVO_PARAMETERS_MODE)
+  {
+    return compactPayloadLength(SERVO_PARAMETERS);
+  }
+  switch (control_mode)
+  {
+    case comm::ControlMode::MODE_SERVOJ:
+    case comm::ControlMode::MODE_SPEEDJ:
+    case comm::ControlMode::MODE_SPEEDL:
+    case comm::ControlMode::MODE_POSE:
+    case comm::ControlMode::MODE_FORCE:
+      return compactPayloadLength(SETPOINT);
+    case comm::ControlMode::MODE_FORWARD:
+      return compactPayloadLength(TRAJECTORY);
+    case comm::ControlMode::MODE_FREEDRIVE:
+      return compactPayloadLength(FREEDRIVE);
+    default:
+      return 0;
+  }
+}
+}  // namespace reverse
+
+/*!
+ * \brief Messages sent on the trajectory socket, one per trajectory point.
+ */
+namespace trajectory
+{
+constexpr size_t MESSAGE_LENGTH = 21;
+
+constexpr Field TIME{ "TIME", 18, 1, Scale::TIME };
+constexpr Field TYPE{ "TYPE", MESSAGE_LENGTH - 1, 1, Scale::RAW };
+
+//! Joint, linear and process moves
+constexpr Field MOVE_POSITIONS{ "POSITIONS", 0, 6, Scale::JOINT_STATE };
+constexpr Field MOVE_VELOCITY{ "VELOCITY", 6, 6, Scale::JOINT_STATE };
+constexpr Field MOVE_ACCELERATION{ "ACCELERATION", 12, 6, Scale::JOINT_STATE };
+constexpr Field MOVE_BLEND{ "BLEND", 19, 1, Scale::TIME };
+constexpr Message<6> MOVE{ "TRAJECTORY_MOVE",
+                           MESSAGE_LENGTH,
+                           { MOVE_POSITIONS, MOVE_VELOCITY, MOVE_ACCELERATION, TIME, MOVE_BLEND, TYPE } };
+
+//! Circular moves
+constexpr Field CIRCULAR_TARGET{ "TARGET", 0, 6, Scale::JOINT_STATE };
+constexpr Field CIRCULAR_VIA{ "VIA", 6, 6, Scale::JOINT_STATE };
+constexpr Field CIRCULAR_ACCELERATION{ "ACCELERATION", 12, 1, Scale::JOINT_STATE };
+constexpr Field CIRCULAR_VELOCITY{ "VELOCITY", 13, 1, Scale::JOINT_STATE };
+constexpr Field CIRCULAR_MODE{ "MODE", 14, 1, Scale::RAW };
+constexpr Field CIRCULAR_BLEND{ "BLEND", 19, 1, Scale::TIME };
+constexpr Message<7> CIRCULAR{ "TRAJECTORY_CIRCULAR",
+                               MESSAGE_LENGTH,
+                               { CIRCULAR_TARGET, CIRCULAR_VIA, CIRCULAR_ACCELERATION, CIRCULAR_VELOCITY,
+                                 CIRCULAR_MODE, CIRCULAR_BLEND, TYPE } };
+
+//! Joint spline points
+constexpr Field SPLINE_POSITIONS{ "POSITIONS", 0, 6, Scale::JOINT_STATE };
+constexpr Field SPLINE_VELOCITIES{ "VELOCITIES", 6, 6, Scale::JOINT_STATE };
+constexpr Field SPLINE_ACCELERATIONS{ "ACCELERATIONS", 12, 6, Scale::JOINT_STATE };
+constexpr Field SPLINE_TYPE{ "SPLINE_TYPE", 19, 1, Scale::RAW };
+constexpr Message<6> SPLINE{ "TRAJECTORY_SPLINE",
+                             MESSAGE_LENGTH,
+                             { SPLINE_POSITIONS, SPLINE_VELOCITIES, SPLINE_ACCELERATIONS, TIME, SPLINE_TYPE, TYPE } };
+
+//! Quintic spline segments with precomputed coefficients, sent as spline points
+constexpr Field SEGMENT_COEFFICIENTS3{ "COEFFICIENTS3", 0, 6, Scale::JOINT_STATE };
+constexpr Field SEGMENT_COEFFICIENTS4{ "COEFFICIENTS4", 6, 6, Scale::JOINT_STATE };
+constexpr Field SEGMENT_COEFFICIENTS5{ "COEFFICIENTS5", 12, 6, Scale::JOINT_STATE };
+constexpr Message<6> SEGMENT{ "TRAJECTORY_SEGMENT",
+                              MESSAGE_LENGTH,
+                              { SEGMENT_COEFFICIENTS3, SEGMENT_COEFFICIENTS4, SEGMENT_COEFFICIENTS5, TIME,
+                                SPLINE_TYPE, TYPE } };
+
+static_assert(MOVE.isWellFormed() && CIRCULAR.isWellFormed() && SPLINE.isWellFormed() && SEGMENT.isWellFormed(),
+              "Malformed trajectory message");
+}  // namespace trajectory
+
+/*!
+ * \brief Messages sent on the script command socket. Every message starts with the command and
+ * ends with the command's sequence number, which the script sends back negated once the command
+ * has been executed.
+ */
+namespace script_command
+{
+constexpr size_t MESSAGE_LENGTH = 29;
+
+constexpr Field COMMAND{ "COMMAND", 0, 1, Scale::RAW };
+constexpr Field SEQUENCE{ "SEQUENCE", MESSAGE_LENGTH - 1, 1, Scale::RAW };
+
+//! Commands without arguments
+constexpr Message<2> PLAIN{ "SCRIPT_COMMAND", MESSAGE_LENGTH, { COMMAND, SEQUENCE } };
+
+constexpr Field PAYLOAD_MASS{ "MASS", 1, 1, Scale::JOINT_STATE };
+constexpr Field PAYLOAD_COG{ "COG", 2, 3, Scale::JOINT_STATE };
+constexpr Message<4> PAYLOAD{ "SCRIPT_PAYLOAD", MESSAGE_LENGTH, { COMMAND, PAYLOAD_MASS, PAYLOAD_COG, SEQUENCE } };
+
+constexpr Field TOOL_VOLTAGE_VOLTAGE{ "VOLTAGE", 1, 1, Scale::JOINT_STATE };
+constexpr Message<3> TOOL_VOLTAGE{ "SCRIPT_TOOL_VOLTAGE", MESSAGE_LENGTH, { COMMAND, TOOL_VOLTAGE_VOLTAGE, SEQUENCE } };
+
+constexpr Field FORCE_MODE_TASK_FRAME{ "TASK_FRAME", 1, 6, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_SELECTION{ "SELECTION", 7, 6, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_WRENCH{ "WRENCH", 13, 6, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_TYPE{ "TYPE", 19, 1, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_LIMITS{ "LIMITS", 20, 6, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_DAMPING{ "DAMPING", 26, 1, Scale::JOINT_STATE };
+constexpr Field FORCE_MODE_GAIN_SCALING{ "GAIN_SCALING", 27, 1, Scale::JOINT_STATE };
+constexpr Message<9> FORCE_MODE{ "SCRIPT_FORCE_MODE",
+                                 MESSAGE_LENGTH,
+                                 { COMMAND, FORCE_MODE_TASK_FRAME, FORCE_MODE_SELECTION, FORCE_MODE_WRENCH,
+                                   FORCE_MODE_TYPE, FORCE_MODE_LIMITS, FORCE_MODE_DAMPING, FORCE_MODE_GAIN_SCALING,
+                                   SEQUENCE } };
+
+//! Header of a batch, followed by \p COUNT messages without sequence numbers
+constexpr Field BATCH_COUNT{ "COUNT", 1, 1, Scale::RAW };
+constexpr Message<3> BATCH{ "SCRIPT_BATCH", MESSAGE_LENGTH, { COMMAND, BATCH_COUNT, SEQUENCE } };
+
+static_assert(PLAIN.isWellFormed() && PAYLOAD.isWellFormed() && TOOL_VOLTAGE.isWellFormed() &&
+                  FORCE_MODE.isWellFormed() && BATCH.isWellFormed(),
+              "Malformed script command message");
+}  // namespace script_command
+
+/*!
+ * \brief Renders the definitions the external control script needs to decode the messages above.
+ *
+ * For every message, \p <MESSAGE>_LENGTH holds the number of integers and \p <MESSAGE>_<FIELD> the
+ * index of the field's first integer in the list returned by socket_read_binary_integer(), whose
+ * first element is the number of integers read. The multipliers of scaled fields and the function
+ * \p compact_payload_length(mode) of the compact reverse protocol are rendered as well.
+ *
+ * \returns The URScript definitions
+ */
+std::string generateURScriptDefinitions();
+
+}  // namespace wire
+}  // namespace control
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_WIRE_PROTOCOL_H_INCLUDED
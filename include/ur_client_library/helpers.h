@@ -29,10 +29,291 @@
 #ifndef UR_CLIENT_LIBRARY_HELPERS_H_INCLUDED
 #define UR_CLIENT_LIBRARY_HELPERS_H_INCLUDED
 
+#include <pthread.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace urcl
 {
 bool setFiFoScheduling(pthread_t& thread, const int priority);
+
+/*!
+ * \brief Scheduling, CPU affinity and name of a thread.
+ *
+ * Every member left at its default keeps the corresponding setting the thread already has, so a
+ * default constructed config does not change a thread at all.
+ */
+struct ThreadConfig
+{
+  /*!
+   * \brief Scheduling policy such as SCHED_FIFO, SCHED_RR or SCHED_OTHER. With a negative value the
+   * scheduling is left untouched.
+   */
+  int policy = -1;
+  //! Scheduling priority used together with policy
+  int priority = 0;
+  //! CPUs the thread may run on. An empty set keeps the affinity inherited from the creating thread.
+  std::vector<int> cpus;
+  //! Name of the thread. Names are cut to 15 characters which is the limit of the kernel.
+  std::string name;
+
+  /*!
+   * \brief Whether the config changes anything about a thread.
+   *
+   * \returns True if no member is set
+   */
+  bool empty() const
+  {
+    return policy < 0 && cpus.empty() && name.empty();
+  }
+
+  /*!
+   * \brief Creates a copy of this config whose name is extended by a suffix, if a name is set.
+   *
+   * This is used to give every thread of a component a distinctive name based on one config.
+   *
+   * \param suffix Text appended to the name, separated by an underscore
+   *
+   * \returns The copy of the config
+   */
+  ThreadConfig withNameSuffix(const std::string& suffix) const
+  {
+    ThreadConfig config = *this;
+    if (!config.name.empty())
+    {
+      config.name += "_" + suffix;
+    }
+    return config;
+  }
+};
+
+/*!
+ * \brief Applies a thread config to a thread.
+ *
+ * All settings are applied, even if one of them fails. Failures are logged.
+ *
+ * \param thread The thread to configure
+ * \param config The settings to apply
+ *
+ * \returns True if all settings were applied successfully
+ */
+bool applyThreadConfig(pthread_t thread, const ThreadConfig& config);
+
+/*!
+ * \brief Getter for the NUMA node a CPU belongs to.
+ *
+ * \param cpu The CPU
+ *
+ * \returns The node, -1 if it is unknown, e.g. on kernels without NUMA support
+ */
+int getNumaNode(const int cpu);
+
+/*!
+ * \brief Getter for the NUMA node of the CPUs of a thread config.
+ *
+ * \param config The thread config
+ *
+ * \returns The node, -1 if the config has no CPUs, they belong to different nodes or a node is
+ * unknown
+ */
+int getNumaNode(const ThreadConfig& config);
+
+/*!
+ * \brief Runs a function on a temporary thread pinned to the CPUs of a thread config, so the
+ * memory it allocates ends up on their NUMA node.
+ *
+ * Linux places a page on the node of the thread touching it first. The temporary thread
+ * additionally prefers allocating on the CPUs' node, which threads created by the function inherit.
+ * Creating a component this way places the buffers, pools and queues allocated by its constructor
+ * on the node its threads run on. If the config has no CPUs, the function is called directly.
+ *
+ * \param config The thread config whose CPUs the function is run on
+ * \param function The function to run, exceptions thrown by it are rethrown
+ */
+void runOnNumaNode(const ThreadConfig& config, const std::function<void()>& function);
+
+/*!
+ * \brief Sets the stack size of all threads created from now on, including the internal threads of
+ * the library.
+ *
+ * Threads get stacks of the size of the stack resource limit by default, usually 8 MB each. Only
+ * the pages touched are actually backed by memory, but the stacks still reserve address space and
+ * may grow that large. Smaller stacks bound the memory of components running several threads on
+ * targets with little memory. This applies to every thread of the process created afterwards, so
+ * it should be called once at startup. The library's threads need less than 256 kB.
+ *
+ * \param bytes Stack size in bytes, at least PTHREAD_STACK_MIN
+ *
+ * \returns False if the size is too small or the system doesn't support it
+ */
+bool setThreadStackSize(const size_t bytes);
+
+/*!
+ * \brief Getter for the stack size of threads created from now on, see setThreadStackSize().
+ *
+ * \returns The stack size in bytes, 0 if it is unknown
+ */
+size_t getThreadStackSize();
+
+/*!
+ * \brief Memory used by the process, see getMemoryFootprint().
+ */
+struct MemoryFootprint
+{
+  //! Bytes of memory actually backed by physical memory
+  size_t resident_bytes = 0;
+  //! Bytes of address space reserved, including the stacks of all threads
+  size_t virtual_bytes = 0;
+  //! Number of threads of the process
+  size_t num_threads = 0;
+  //! Stack size of threads created from now on in bytes
+  size_t thread_stack_size = 0;
+};
+
+/*!
+ * \brief Reports the memory actually used by the process, e.g. for checking the memory budget of
+ * the drivers running in it.
+ *
+ * \returns The footprint, members that couldn't be determined are 0
+ */
+MemoryFootprint getMemoryFootprint();
+
+/*!
+ * \brief Mutex using the priority inheritance protocol, for locks shared between real-time and
+ * non real-time threads.
+ *
+ * While a thread holds the mutex, it runs with the highest priority of the threads waiting for
+ * it. A SCHED_FIFO thread waiting for a lock held by a low priority thread is therefore not
+ * delayed by threads of medium priority. Waiting threads acquire the mutex in the order of their
+ * priority, so real-time threads take precedence over other waiters. It can be used with
+ * std::lock_guard and std::unique_lock.
+ */
+class PriorityInheritanceMutex
+{
+public:
+  /*!
+   * \brief Creates an unlocked mutex. If the system doesn't support priority inheritance, a
+   * warning is logged and a plain mutex is used.
+   */
+  PriorityInheritanceMutex();
+  ~PriorityInheritanceMutex();
+  PriorityInheritanceMutex(const PriorityInheritanceMutex&) = delete;
+  PriorityInheritanceMutex& operator=(const PriorityInheritanceMutex&) = delete;
+
+  /*!
+   * \brief Blocks until the mutex has been acquired.
+   *
+   * \throws std::system_error if the mutex cannot be locked
+   */
+  void lock();
+
+  /*!
+   * \brief Acquires the mutex if it isn't locked.
+   *
+   * \returns True if the mutex has been acquired
+   */
+  bool try_lock();
+
+  /*!
+   * \brief Releases the mutex.
+   */
+  void unlock();
+
+private:
+  pthread_mutex_t mutex_;
+};
+
+/*!
+ * \brief Process wide preparations for running real-time threads, applied by setupRealtimeProcess().
+ */
+struct RealtimeSetupConfig
+{
+  /*!
+   * \brief Locks all current and future memory of the process into RAM using mlockall().
+   *
+   * This faults in and locks the stacks of all threads, including the ones the library creates
+   * later on, as glibc maps thread stacks completely when creating a thread.
+   */
+  bool lock_memory = true;
+  //! Number of bytes of the calling thread's stack to fault in. The main thread's stack grows on demand.
+  size_t stack_prefault_size = 512 * 1024;
+  /*!
+   * \brief Number of bytes of heap memory to fault in and keep inside the process, so that the
+   * buffers and pools allocated by the RTDE and reverse interface paths don't page fault when they
+   * are first used. Returning freed memory to the system is disabled if this is non-zero.
+   */
+  size_t heap_prefault_size = 8 * 1024 * 1024;
+  //! CPUs the real-time threads will be pinned to, checked for being isolated from the scheduler
+  std::vector<int> cpus;
+  //! FIFO priority the real-time threads will use, checked for being permitted. Not checked if 0.
+  int fifo_priority = 0;
+};
+
+/*!
+ * \brief Result of setupRealtimeProcess().
+ */
+struct RealtimeSetupReport
+{
+  //! Whether the memory of the process is locked
+  bool memory_locked = false;
+  //! Whether the calling thread's stack and the heap have been faulted in
+  bool memory_prefaulted = false;
+  //! Whether threads may use SCHED_FIFO with the requested priority
+  bool fifo_permitted = false;
+  //! CPUs from the config that are not isolated
+  std::vector<int> non_isolated_cpus;
+  //! One human readable description per problem found
+  std::vector<std::string> problems;
+
+  /*!
+   * \brief Whether no problems have been found.
+   */
+  bool ok() const
+  {
+    return problems.empty();
+  }
+};
+
+/*!
+ * \brief Prepares the process for real-time threads and checks the system's real-time setup.
+ *
+ * Call this once at startup before creating a UrDriver or any of the library's clients. Problems
+ * are logged as a single warning and returned, the process keeps running without the missing
+ * parts.
+ *
+ * \param config What to prepare and check
+ *
+ * \returns A report of what has been set up and which problems were found
+ */
+RealtimeSetupReport setupRealtimeProcess(const RealtimeSetupConfig& config);
+
+/*!
+ * \brief Faults in a part of the calling thread's stack, so using it later doesn't page fault.
+ *
+ * \param size Number of bytes to fault in, starting at the current stack frame
+ */
+void prefaultStack(const size_t size);
+
+/*!
+ * \brief Parses a CPU list in the kernel's format, e.g. "0-2,5" as used in
+ * /sys/devices/system/cpu/isolated.
+ *
+ * \param list The CPU list
+ *
+ * \returns The CPUs contained in the list, in the order given. Malformed entries are skipped.
+ */
+std::vector<int> parseCpuList(const std::string& list);
+
+/*!
+ * \brief Reads the CPUs isolated from the scheduler, i.e. the ones given to the isolcpus kernel
+ * parameter.
+ *
+ * \returns The isolated CPUs, empty if there are none or the list cannot be read
+ */
+std::vector<int> getIsolatedCpus();
 }
 #endif  // ifndef UR_CLIENT_LIBRARY_HELPERS_H_INCLUDED
@@ -0,0 +1,545 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_JOINT_SPACE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_JOINT_SPACE_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/types.h"
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#  include <arm_neon.h>
+#endif
+
+namespace urcl
+{
+/*!
+ * \brief Element-wise operations on joint vectors and TCP poses as needed inside control loops.
+ *
+ * Joint vectors are processed as three pairs of doubles. Depending on the instruction sets enabled
+ * at compile time (SSE2 or NEON on aarch64) each pair is handled by a single vector instruction,
+ * otherwise the operations fall back to plain scalar code with identical results.
+ */
+namespace joint_space
+{
+namespace detail
+{
+#if defined(__SSE2__)
+using Pair = __m128d;
+
+inline Pair load(const double* src)
+{
+  return _mm_loadu_pd(src);
+}
+inline void store(double* dst, const Pair value)
+{
+  _mm_storeu_pd(dst, value);
+}
+inline Pair broadcast(const double value)
+{
+  return _mm_set1_pd(value);
+}
+inline Pair add(const Pair a, const Pair b)
+{
+  return _mm_add_pd(a, b);
+}
+inline Pair sub(const Pair a, const Pair b)
+{
+  return _mm_sub_pd(a, b);
+}
+inline Pair mul(const Pair a, const Pair b)
+{
+  return _mm_mul_pd(a, b);
+}
+inline Pair min(const Pair a, const Pair b)
+{
+  return _mm_min_pd(a, b);
+}
+inline Pair max(const Pair a, const Pair b)
+{
+  return _mm_max_pd(a, b);
+}
+inline Pair abs(const Pair a)
+{
+  return _mm_andnot_pd(_mm_set1_pd(-0.0), a);
+}
+inline double sum(const Pair a)
+{
+  return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+}
+inline double maximum(const Pair a)
+{
+  return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a)));
+}
+// True if both lanes of a are within [lower, upper]. NaN compares false.
+inline bool within(const Pair a, const Pair lower, const Pair upper)
+{
+  return _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(a, lower), _mm_cmple_pd(a, upper))) == 0x3;
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+using Pair = float64x2_t;
+
+inline Pair load(const double* src)
+{
+  return vld1q_f64(src);
+}
+inline void store(double* dst, const Pair value)
+{
+  vst1q_f64(dst, value);
+}
+inline Pair broadcast(const double value)
+{
+  return vdupq_n_f64(value);
+}
+inline Pair add(const Pair a, const Pair b)
+{
+  return vaddq_f64(a, b);
+}
+inline Pair sub(const Pair a, const Pair b)
+{
+  return vsubq_f64(a, b);
+}
+inline Pair mul(const Pair a, const Pair b)
+{
+  return vmulq_f64(a, b);
+}
+inline Pair min(const Pair a, const Pair b)
+{
+  return vminnmq_f64(a, b);
+}
+inline Pair max(const Pair a, const Pair b)
+{
+  return vmaxnmq_f64(a, b);
+}
+inline Pair abs(const Pair a)
+{
+  return vabsq_f64(a);
+}
+inline double sum(const Pair a)
+{
+  return vaddvq_f64(a);
+}
+inline double maximum(const Pair a)
+{
+  return vmaxnmvq_f64(a);
+}
+inline bool within(const Pair a, const Pair lower, const Pair upper)
+{
+  const uint64x2_t inside = vandq_u64(vcgeq_f64(a, lower), vcleq_f64(a, upper));
+  return vgetq_lane_u64(inside, 0) != 0 && vgetq_lane_u64(inside, 1) != 0;
+}
+#else
+struct Pair
+{
+  double lo;
+  double hi;
+};
+
+inline Pair load(const double* src)
+{
+  return { src[0], src[1] };
+}
+inline void store(double* dst, const Pair value)
+{
+  dst[0] = value.lo;
+  dst[1] = value.hi;
+}
+inline Pair broadcast(const double value)
+{
+  return { value, value };
+}
+inline Pair add(const Pair a, const Pair b)
+{
+  return { a.lo + b.lo, a.hi + b.hi };
+}
+inline Pair sub(const Pair a, const Pair b)
+{
+  return { a.lo - b.lo, a.hi - b.hi };
+}
+inline Pair mul(const Pair a, const Pair b)
+{
+  return { a.lo * b.lo, a.hi * b.hi };
+}
+inline Pair min(const Pair a, const Pair b)
+{
+  return { a.lo < b.lo ? a.lo : b.lo, a.hi < b.hi ? a.hi : b.hi };
+}
+inline Pair max(const Pair a, const Pair b)
+{
+  return { a.lo > b.lo ? a.lo : b.lo, a.hi > b.hi ? a.hi : b.hi };
+}
+inline Pair abs(const Pair a)
+{
+  return { std::fabs(a.lo), std::fabs(a.hi) };
+}
+inline double sum(const Pair a)
+{
+  return a.lo + a.hi;
+}
+inline double maximum(const Pair a)
+{
+  return a.hi > a.lo ? a.hi : a.lo;
+}
+inline bool within(const Pair a, const Pair lower, const Pair upper)
+{
+  return a.lo >= lower.lo && a.lo <= upper.lo && a.hi >= lower.hi && a.hi <= upper.hi;
+}
+#endif
+}  // namespace detail
+
+/*!
+ * \brief Element-wise sum a + b.
+ */
+inline vector6d_t add(const vector6d_t& a, const vector6d_t& b)
+{
+  vector6d_t result;
+  for (size_t i = 0; i < 6; i += 2)
+  {
+    detail::store(&result[i], detail::add(detail::load(&a[i]), detail::load(&b[i])));
+  }
+  return result;
+}
+
+/*!
+ * \brief Element-wise difference a - b.
+ */
+inline vector6d_t subtract(const vector6d_t& a, const vector6d_t& b)
+{
+  vector6d_t result;
+  for (size_t i = 0; i < 6; i += 2)
+  {
+    detail::store(&result[i], detail::sub(detail::load(&a[i]), detail::load(&b[i])));
+  }
+  return result;
+}
+
+/*!
+ * \brief Multiplies every element of a vector with a factor.
+ */
+inline vector6d_t scale(const vector6d_t& a, const double factor)
+{
+  const detail::Pair f = detail::broadcast(factor);
+  vector6d_t result;
+  for (size_t i = 0; i < 6; i += 2)
+  {
+    detail::store(&result[i], detail::mul(detail::load(&a[i]), f));
+  }
+  return result;
+}
+
+/*!
+ * \brief Dot product of two vectors.
+ */
+inline double dot(const vector6d_t& a, const vector6d_t& b)
+{
+  detail::Pair acc = detail::mul(detail::load(&a[0]), detail::load(&b[0]));
+  acc = detail::add(acc, detail::mul(detail::load(&a[2]), detail::load(&b[2])));
+  acc = detail::add(acc, detail::mul(detail::load(&a[4]), detail::load(&b[4])));
+  return detail::sum(acc);
+}
+
+/*!
+ * \brief Euclidean norm of a vector.
+ */
+inline double norm(const vector6d_t& a)
+{
+  return std::sqrt(dot(a, a));
+}
+
+/*!
+ * \brief Largest absolute element of a vector (infinity norm).
+ */
+inline double maxAbs(const vector6d_t& a)
+{
+  detail::Pair acc = detail::abs(detail::load(&a[0]));
+  acc = detail::max(acc, detail::abs(detail::load(&a[2])));
+  acc = detail::max(acc, detail::abs(detail::load(&a[4])));
+  return detail::maximum(acc);
+}
+
+/*!
+ * \brief Largest absolute element-wise difference between two vectors, e.g. the worst joint
+ * tracking error between a target and \p actual_q.
+ */
+inline double maxAbsDifference(const vector6d_t& a, const vector6d_t& b)
+{
+  detail::Pair acc = detail::abs(detail::sub(detail::load(&a[0]), detail::load(&b[0])));
+  acc = detail::max(acc, detail::abs(detail::sub(detail::load(&a[2]), detail::load(&b[2]))));
+  acc = detail::max(acc, detail::abs(detail::sub(detail::load(&a[4]), detail::load(&b[4]))));
+  return detail::maximum(acc);
+}
+
+/*!
+ * \brief Checks whether every element lies within the given bounds (inclusive).
+ *
+ * \param q Vector to check, e.g. joint positions
+ * \param lower Lower bound per element
+ * \param upper Upper bound per element
+ *
+ * \returns False if any element is outside of its bounds or is NaN.
+ */
+inline bool withinLimits(const vector6d_t& q, const vector6d_t& lower, const vector6d_t& upper)
+{
+  return detail::within(detail::load(&q[0]), detail::load(&lower[0]), detail::load(&upper[0])) &&
+         detail::within(detail::load(&q[2]), detail::load(&lower[2]), detail::load(&upper[2])) &&
+         detail::within(detail::load(&q[4]), detail::load(&lower[4]), detail::load(&upper[4]));
+}
+
+/*!
+ * \brief Checks whether the absolute value of every element is at most the given limit, e.g. for
+ * symmetric velocity limits.
+ */
+inline bool withinLimits(const vector6d_t& q, const vector6d_t& limit)
+{
+  return withinLimits(q, scale(limit, -1.0), limit);
+}
+
+/*!
+ * \brief Clamps every element into the given bounds (inclusive).
+ */
+inline vector6d_t clamp(const vector6d_t& q, const vector6d_t& lower, const vector6d_t& upper)
+{
+  vector6d_t result;
+  for (size_t i = 0; i < 6; i += 2)
+  {
+    detail::store(&result[i], detail::min(detail::max(detail::load(&q[i]), detail::load(&lower[i])),
+                                          detail::load(&upper[i])));
+  }
+  return result;
+}
+
+/*!
+ * \brief Backward finite difference (current - previous) / dt.
+ *
+ * \param current Most recent sample
+ * \param previous Sample taken \p dt seconds before \p current
+ * \param dt Time between both samples in seconds. Has to be positive.
+ */
+inline vector6d_t finiteDifference(const vector6d_t& current, const vector6d_t& previous, const double dt)
+{
+  const detail::Pair inverse_dt = detail::broadcast(1.0 / dt);
+  vector6d_t result;
+  for (size_t i = 0; i < 6; i += 2)
+  {
+    detail::store(&result[i], detail::mul(detail::sub(detail::load(&current[i]), detail::load(&previous[i])),
+                                          inverse_dt));
+  }
+  return result;
+}
+
+/*!
+ * \brief Euclidean distance between the positions of two TCP poses.
+ *
+ * \param a Pose as [x, y, z, rx, ry, rz] with the orientation as rotation vector, e.g. \p actual_TCP_pose
+ * \param b Pose in the same representation
+ */
+inline double tcpPositionError(const vector6d_t& a, const vector6d_t& b)
+{
+  const double dx = a[0] - b[0];
+  const double dy = a[1] - b[1];
+  const double dz = a[2] - b[2];
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/*!
+ * \brief Angle of the rotation between the orientations of two TCP poses in radians.
+ *
+ * Other than the difference of both rotation vectors this is independent of how the orientations
+ * are represented, e.g. rotation vectors of length close to pi pointing in opposite directions
+ * are recognized as almost the same orientation.
+ *
+ * \param a Pose as [x, y, z, rx, ry, rz] with the orientation as rotation vector, e.g. \p actual_TCP_pose
+ * \param b Pose in the same representation
+ *
+ * \returns Angle within [0, pi]
+ */
+inline double tcpOrientationError(const vector6d_t& a, const vector6d_t& b)
+{
+  // Convert both rotation vectors to unit quaternions (w, x, y, z)
+  auto to_quaternion = [](const vector6d_t& pose, double* quaternion) {
+    const double angle = std::sqrt(pose[3] * pose[3] + pose[4] * pose[4] + pose[5] * pose[5]);
+    quaternion[0] = std::cos(0.5 * angle);
+    const double factor = angle > 1e-12 ? std::sin(0.5 * angle) / angle : 0.5;
+    quaternion[1] = pose[3] * factor;
+    quaternion[2] = pose[4] * factor;
+    quaternion[3] = pose[5] * factor;
+  };
+  double qa[4];
+  double qb[4];
+  to_quaternion(a, qa);
+  to_quaternion(b, qb);
+
+  // Relative rotation conj(qa) * qb. Using atan2 on its parts stays accurate for small angles.
+  const double w = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+  const double x = qa[0] * qb[1] - qb[0] * qa[1] - (qa[2] * qb[3] - qa[3] * qb[2]);
+  const double y = qa[0] * qb[2] - qb[0] * qa[2] - (qa[3] * qb[1] - qa[1] * qb[3]);
+  const double z = qa[0] * qb[3] - qb[0] * qa[3] - (qa[1] * qb[2] - qa[2] * qb[1]);
+  return 2.0 * std::atan2(std::sqrt(x * x + y * y + z * z), std::fabs(w));
+}
+
+/*!
+ * \brief Estimates joint velocities and accelerations from a stream of joint positions such as
+ * \p actual_q using backward finite differences.
+ *
+ * Each estimate can optionally be smoothed by a first order low pass filter. A smoothing factor
+ * of 1 uses the raw finite differences, smaller values weight new samples less and reject more
+ * noise at the cost of delay.
+ */
+class JointStateDifferentiator
+{
+public:
+  /*!
+   * \brief Creates a differentiator without any samples.
+   *
+   * \param smoothing Weight of each new estimate within (0, 1]
+   *
+   * \throws UrException if \p smoothing is outside of (0, 1]
+   */
+  explicit JointStateDifferentiator(const double smoothing = 1.0) : smoothing_(smoothing)
+  {
+    if (!(smoothing > 0.0 && smoothing <= 1.0))
+    {
+      throw UrException("The smoothing factor of a joint state differentiator has to be within (0, 1].");
+    }
+    reset();
+  }
+
+  /*!
+   * \brief Adds a new position sample.
+   *
+   * The first sample only initializes the differentiator, velocities are available from the second
+   * sample onwards and accelerations from the third.
+   *
+   * \param positions Joint positions of the new sample
+   * \param dt Time since the previous sample in seconds
+   *
+   * \returns False if \p dt is not positive, in which case the sample is ignored.
+   */
+  bool update(const vector6d_t& positions, const double dt)
+  {
+    if (num_samples_ == 0)
+    {
+      positions_ = positions;
+      num_samples_ = 1;
+      return true;
+    }
+    if (!(dt > 0.0))
+    {
+      return false;
+    }
+
+    const vector6d_t velocity = filter(velocities_, finiteDifference(positions, positions_, dt), num_samples_ == 1);
+    if (num_samples_ >= 2)
+    {
+      accelerations_ = filter(accelerations_, finiteDifference(velocity, velocities_, dt), num_samples_ == 2);
+    }
+    velocities_ = velocity;
+    positions_ = positions;
+    num_samples_ = std::min<size_t>(num_samples_ + 1, 3);
+    return true;
+  }
+
+  /*!
+   * \brief Drops all samples and resets the estimates to zero.
+   */
+  void reset()
+  {
+    positions_ = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    velocities_ = positions_;
+    accelerations_ = positions_;
+    num_samples_ = 0;
+  }
+
+  /*!
+   * \brief Returns true once enough samples were added for a velocity estimate.
+   */
+  bool hasVelocity() const
+  {
+    return num_samples_ >= 2;
+  }
+
+  /*!
+   * \brief Returns true once enough samples were added for an acceleration estimate.
+   */
+  bool hasAcceleration() const
+  {
+    return num_samples_ >= 3;
+  }
+
+  /*!
+   * \brief Most recent position sample.
+   */
+  const vector6d_t& getPositions() const
+  {
+    return positions_;
+  }
+
+  /*!
+   * \brief Current velocity estimate, zero until hasVelocity() returns true.
+   */
+  const vector6d_t& getVelocities() const
+  {
+    return velocities_;
+  }
+
+  /*!
+   * \brief Current acceleration estimate, zero until hasAcceleration() returns true.
+   */
+  const vector6d_t& getAccelerations() const
+  {
+    return accelerations_;
+  }
+
+private:
+  vector6d_t filter(const vector6d_t& estimate, const vector6d_t& raw, const bool first) const
+  {
+    if (first || smoothing_ == 1.0)
+    {
+      return raw;
+    }
+    return add(estimate, scale(subtract(raw, estimate), smoothing_));
+  }
+
+  double smoothing_;
+  vector6d_t positions_;
+  vector6d_t velocities_;
+  vector6d_t accelerations_;
+  size_t num_samples_;
+};
+}  // namespace joint_space
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_JOINT_SPACE_H_INCLUDED
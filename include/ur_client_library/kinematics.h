@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_KINEMATICS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_KINEMATICS_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ur_client_library/types.h"
+#include "ur_client_library/primary/robot_state/kinematics_info.h"
+
+namespace urcl
+{
+/*!
+ * \brief Forward and inverse kinematics of a robot arm calculated on the client.
+ *
+ * Poses are represented like on the robot as [x, y, z, rx, ry, rz] with the orientation as
+ * rotation vector, relative to the robot's base.
+ */
+namespace kinematics
+{
+/*!
+ * \brief Denavit-Hartenberg parameters of the six joints of a robot arm.
+ *
+ * For joint i, the transformation from the previous frame is Rz(theta[i] + q[i]) * Tz(d[i]) *
+ * Tx(a[i]) * Rx(alpha[i]). Lengths are in meters, angles in radians.
+ */
+struct DHParameters
+{
+  vector6d_t theta;
+  vector6d_t a;
+  vector6d_t d;
+  vector6d_t alpha;
+};
+
+/*!
+ * \brief Kinematic model of a robot arm built from its (calibrated) DH parameters.
+ *
+ * Using the calibration the robot reports in its KinematicsInfo, the model matches the robot's
+ * own get_forward_kin() and get_inverse_kin() without a round trip to the robot.
+ *
+ * Inverse kinematics are solved in closed form for the nominal geometry of the arm, i.e. ignoring
+ * the small calibration deltas. Each solution is then refined by Newton iterations on the full
+ * calibrated model. When a configuration close to the solution is known, e.g. the current joint
+ * positions, the refinement can start there directly.
+ */
+class KinematicsModel
+{
+public:
+  //! Maximum number of joint configurations reaching the same pose
+  static constexpr size_t MAX_IK_SOLUTIONS = 8;
+
+  KinematicsModel() = delete;
+
+  /*!
+   * \brief Creates a model from DH parameters.
+   *
+   * \param parameters DH parameters of the arm
+   */
+  explicit KinematicsModel(const DHParameters& parameters);
+
+  /*!
+   * \brief Creates a model from the calibration the robot reports on the primary interface.
+   *
+   * \param info The robot's kinematics information
+   */
+  explicit KinematicsModel(const primary_interface::KinematicsInfo& info);
+
+  /*!
+   * \brief Getter for the DH parameters of the model.
+   */
+  const DHParameters& getParameters() const
+  {
+    return parameters_;
+  }
+
+  /*!
+   * \brief Sets the pose of the TCP relative to the tool flange, like set_tcp() on the robot.
+   *
+   * \param tcp_offset Pose of the TCP in the flange's frame
+   */
+  void setTcpOffset(const vector6d_t& tcp_offset);
+
+  /*!
+   * \brief Getter for the pose of the TCP relative to the tool flange.
+   */
+  const vector6d_t& getTcpOffset() const
+  {
+    return tcp_offset_;
+  }
+
+  /*!
+   * \brief Calculates the pose of the TCP for a joint configuration.
+   *
+   * \param q Joint positions
+   *
+   * \returns The TCP pose
+   */
+  vector6d_t forward(const vector6d_t& q) const;
+
+  /*!
+   * \brief Calculates the TCP poses of many joint configurations.
+   *
+   * Two configurations are processed at once using vector instructions (SSE2 or NEON on aarch64)
+   * if enabled at compile time, see joint_space.
+   *
+   * \param q Joint configurations
+   * \param poses Target for the TCP poses, it has to hold \p count poses
+   * \param count Number of configurations
+   */
+  void forward(const vector6d_t* q, vector6d_t* poses, const size_t count) const;
+
+  /*!
+   * \brief Calculates the TCP poses of many joint configurations.
+   *
+   * \param q Joint configurations
+   * \param poses Resized to hold the TCP pose of each configuration
+   */
+  void forward(const std::vector<vector6d_t>& q, std::vector<vector6d_t>& poses) const;
+
+  /*!
+   * \brief Calculates all joint configurations within [-pi, pi] reaching a TCP pose.
+   *
+   * \param pose The TCP pose
+   * \param solutions Target for the joint configurations
+   *
+   * \returns The number of solutions found, 0 if the pose is out of reach
+   */
+  size_t inverse(const vector6d_t& pose, std::array<vector6d_t, MAX_IK_SOLUTIONS>& solutions) const;
+
+  /*!
+   * \brief Calculates the joint configuration reaching a TCP pose, that is closest to the given
+   * configuration. Like on the robot, each joint may be shifted by multiples of 2 pi to get closer.
+   *
+   * The refinement starts at \p q_near first, which converges within a few iterations if it is
+   * close to a solution, e.g. when tracking a slowly moving target from the current joint
+   * positions. Otherwise all closed-form solutions are considered.
+   *
+   * \param pose The TCP pose
+   * \param q_near Joint configuration the solution should be close to
+   * \param q Target for the solution
+   *
+   * \returns True if a solution was found, false if the pose is out of reach
+   */
+  bool inverse(const vector6d_t& pose, const vector6d_t& q_near, vector6d_t& q) const;
+
+private:
+  // Homogeneous transformation stored as the upper 3x4 part of the matrix in row-major order
+  using Transform = std::array<double, 12>;
+
+  Transform flangeTransform(const vector6d_t& q, std::array<Transform, 6>* frames) const;
+  size_t closedFormFlange(const Transform& flange, std::array<vector6d_t, MAX_IK_SOLUTIONS>& solutions) const;
+  bool refine(const Transform& target, vector6d_t& q) const;
+
+  DHParameters parameters_;
+  vector6d_t cos_alpha_;
+  vector6d_t sin_alpha_;
+  vector6d_t tcp_offset_;
+  Transform tcp_;
+  Transform tcp_inverse_;
+};
+
+}  // namespace kinematics
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_KINEMATICS_H_INCLUDED
@@ -18,13 +18,43 @@
 
 #pragma once
 #include <inttypes.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <vector>
 
-#define URCL_LOG_DEBUG(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::DEBUG, __VA_ARGS__)
-#define URCL_LOG_WARN(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::WARN, __VA_ARGS__)
-#define URCL_LOG_INFO(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::INFO, __VA_ARGS__)
-#define URCL_LOG_ERROR(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::ERROR, __VA_ARGS__)
-#define URCL_LOG_FATAL(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::FATAL, __VA_ARGS__)
+/*!
+ * \brief Minimum level of messages compiled in, as value of the urcl::LogLevel enum (0 for DEBUG up
+ * to 5 for NONE).
+ *
+ * Logging macros below this level expand to code that is removed by the compiler, including the
+ * evaluation of their arguments. Define it before including this header or on the command line.
+ */
+#ifndef URCL_LOG_MIN_LEVEL
+#define URCL_LOG_MIN_LEVEL 0
+#endif
+
+// The level is checked before the arguments are evaluated. The first check is a constant, so calls
+// below the compile-time minimum are removed entirely. Every call site has a LogSite of its own, which
+// limits the rate of its messages before they are formatted.
+#define URCL_LOG_AT_LEVEL(level, ...)                                                                                  \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (static_cast<int>(level) >= URCL_LOG_MIN_LEVEL && urcl::isLogLevelEnabled(level))                               \
+    {                                                                                                                  \
+      static urcl::LogSite urcl_log_site(__FILE__, __LINE__, level);                                                   \
+      if (urcl_log_site.admit())                                                                                       \
+      {                                                                                                                \
+        urcl::log(urcl_log_site, __VA_ARGS__);                                                                         \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (false)
+
+#define URCL_LOG_DEBUG(...) URCL_LOG_AT_LEVEL(urcl::LogLevel::DEBUG, __VA_ARGS__)
+#define URCL_LOG_WARN(...) URCL_LOG_AT_LEVEL(urcl::LogLevel::WARN, __VA_ARGS__)
+#define URCL_LOG_INFO(...) URCL_LOG_AT_LEVEL(urcl::LogLevel::INFO, __VA_ARGS__)
+#define URCL_LOG_ERROR(...) URCL_LOG_AT_LEVEL(urcl::LogLevel::ERROR, __VA_ARGS__)
+#define URCL_LOG_FATAL(...) URCL_LOG_AT_LEVEL(urcl::LogLevel::FATAL, __VA_ARGS__)
 
 namespace urcl
 {
@@ -78,6 +108,31 @@ void unregisterLogHandler();
  */
 void setLogLevel(LogLevel level);
 
+/*!
+ * \brief Getter for the log level set using setLogLevel().
+ *
+ * \returns The current log level
+ */
+LogLevel getLogLevel();
+
+namespace detail
+{
+//! Current log level, only to be accessed through setLogLevel() and isLogLevelEnabled()
+extern std::atomic<LogLevel> g_log_level;
+}  // namespace detail
+
+/*!
+ * \brief Checks whether messages of a level are logged with the current log level.
+ *
+ * \param level Severity of a log message
+ *
+ * \returns True if messages of the level are logged
+ */
+inline bool isLogLevelEnabled(const LogLevel level)
+{
+  return level >= detail::g_log_level.load(std::memory_order_relaxed);
+}
+
 /*!
  * \brief Log a message, this is used internally by the macros to unpack the log message.
  * Use the macros instead of this function directly.
@@ -89,4 +144,95 @@ void setLogLevel(LogLevel level);
  */
 void log(const char* file, int line, LogLevel level, const char* fmt, ...);
 
+/*!
+ * \brief State of a single logging call site, used by the logging macros to limit messages during
+ * incidents, e.g. a warning logged on every cycle of the control loop.
+ *
+ * A site logs at most the number of messages set with setLogRateLimit() per interval. Messages
+ * beyond that, and messages identical to the previous message of the site within the interval, are
+ * suppressed. The next message logged by the site reports how many messages have been suppressed.
+ */
+class LogSite
+{
+public:
+  /*!
+   * \brief Creates a call site and registers it for getLogSiteStatistics(). Sites are created as
+   * static variables by the logging macros and have to live until the end of the program.
+   *
+   * \param file The messages come from this file
+   * \param line The messages come from this line
+   * \param level Severity of the messages
+   */
+  LogSite(const char* file, int line, LogLevel level);
+
+  LogSite(const LogSite&) = delete;
+  LogSite& operator=(const LogSite&) = delete;
+
+  /*!
+   * \brief Checks whether the rate limit allows another message of this site, counting it as
+   * suppressed otherwise.
+   *
+   * \returns True if the message should be formatted and passed to log()
+   */
+  bool admit();
+
+  const char* file_;
+  const int line_;
+  const LogLevel level_;
+
+  std::atomic<int64_t> interval_start_;
+  std::atomic<uint32_t> interval_count_;
+  std::atomic<uint64_t> last_message_hash_;
+  std::atomic<int64_t> last_message_time_;
+  std::atomic<uint64_t> pending_suppressed_;
+  std::atomic<uint64_t> logged_;
+  std::atomic<uint64_t> suppressed_;
+};
+
+/*!
+ * \brief Log a message of a call site that has been admitted by LogSite::admit(). Messages
+ * repeating the previous message of the site are suppressed. Use the macros instead of this function
+ * directly.
+ *
+ * \param site Call site logging the message
+ * \param fmt Format string
+ */
+void log(LogSite& site, const char* fmt, ...);
+
+/*!
+ * \brief Sets how many messages a single call site may log per interval. The default is 20 messages
+ * per second.
+ *
+ * \param max_messages Number of messages per interval and site, 0 disables rate limiting and the
+ * suppression of repeated messages
+ * \param interval Length of the interval
+ */
+void setLogRateLimit(uint32_t max_messages, std::chrono::milliseconds interval = std::chrono::seconds(1));
+
+/*!
+ * \brief Counters of a logging call site.
+ */
+struct LogSiteStatistics
+{
+  const char* file;
+  int line;
+  LogLevel level;
+  uint64_t logged;      //!< Messages passed to the log handler
+  uint64_t suppressed;  //!< Messages dropped by the rate limit or as repetitions
+};
+
+/*!
+ * \brief Reads the counters of all call sites that have been reached by the program.
+ *
+ * \returns One entry per call site
+ */
+std::vector<LogSiteStatistics> getLogSiteStatistics();
+
+/*!
+ * \brief Sum of the suppressed messages of all call sites.
+ *
+ * \returns Number of suppressed messages since the start of the program
+ */
+uint64_t getSuppressedLogCount();
+
 }  // namespace urcl
@@ -0,0 +1,93 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_MEMORY_RESOURCE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_MEMORY_RESOURCE_H_INCLUDED
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace urcl
+{
+/*!
+ * \brief Sets the memory resource packages and their field values are allocated from, e.g. an
+ * arena of a real-time process.
+ *
+ * This applies to all packages created from now on, including the ones the parsers create while
+ * receiving data. Memory is always returned to the resource it has been allocated from, so the
+ * resource may be replaced at any time, but it has to outlive everything allocated from it.
+ *
+ * \param resource The resource to use, nullptr restores std::pmr::new_delete_resource()
+ */
+void setMemoryResource(std::pmr::memory_resource* resource);
+
+/*!
+ * \brief Getter for the memory resource packages are allocated from, see setMemoryResource().
+ *
+ * \returns The memory resource, never nullptr
+ */
+std::pmr::memory_resource* getMemoryResource();
+
+/*!
+ * \brief Base class routing the allocation of heap objects of a class through getMemoryResource().
+ *
+ * Objects created with \p new and deleted with \p delete are allocated from the memory resource
+ * set at the time of creation. Objects created with std::make_shared or placement new are not
+ * affected.
+ */
+class MemoryResourceAllocated
+{
+public:
+  /*!
+   * \brief Allocates memory for an object of at most \p size bytes from the current memory
+   * resource.
+   *
+   * \param size Number of bytes to allocate
+   *
+   * \returns The allocated memory
+   */
+  static void* operator new(std::size_t size);
+
+  /*!
+   * \brief Returns memory allocated with operator new() to the memory resource it has been
+   * allocated from.
+   *
+   * \param ptr The memory to free, may be nullptr
+   */
+  static void operator delete(void* ptr) noexcept;
+
+protected:
+  MemoryResourceAllocated() = default;
+  ~MemoryResourceAllocated() = default;
+};
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_MEMORY_RESOURCE_H_INCLUDED
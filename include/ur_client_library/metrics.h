@@ -0,0 +1,299 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_METRICS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_METRICS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace urcl
+{
+//! Label names and values identifying one metric of a family, e.g. { { "host", "192.168.56.101" } }
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/*!
+ * \brief Monotonically increasing count, e.g. of received packages.
+ */
+class Counter
+{
+public:
+  Counter() : value_(0)
+  {
+  }
+
+  /*!
+   * \brief Increases the count.
+   *
+   * \param amount Amount to add
+   */
+  void increment(const uint64_t amount = 1)
+  {
+    value_.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Getter for the current count.
+   */
+  uint64_t getValue() const
+  {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> value_;
+};
+
+/*!
+ * \brief Value that can go up and down, e.g. the number of products in a queue.
+ */
+class Gauge
+{
+public:
+  Gauge() : value_(0.0)
+  {
+  }
+
+  /*!
+   * \brief Sets the value.
+   *
+   * \param value New value
+   */
+  void set(const double value)
+  {
+    value_.store(value, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Adds to the value.
+   *
+   * \param amount Amount to add, negative to decrease the value
+   */
+  void add(const double amount);
+
+  /*!
+   * \brief Getter for the current value.
+   */
+  double getValue() const
+  {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<double> value_;
+};
+
+/*!
+ * \brief Distribution of observed values over fixed buckets, e.g. of durations in seconds.
+ *
+ * Observing a value is a search through the bucket bounds and a few relaxed atomic operations, so
+ * values can be observed from multiple threads, e.g. for every received package.
+ */
+class Histogram
+{
+public:
+  /*!
+   * \brief Creates a histogram.
+   *
+   * \param upper_bounds Inclusive upper bounds of the buckets in ascending order. An additional
+   * bucket counts values above the last bound.
+   */
+  explicit Histogram(const std::vector<double>& upper_bounds);
+
+  /*!
+   * \brief Adds a value to the histogram.
+   *
+   * \param value Observed value
+   */
+  void observe(const double value);
+
+  /*!
+   * \brief Adds a duration to the histogram in seconds.
+   *
+   * \param duration Observed duration
+   */
+  void observe(const std::chrono::steady_clock::duration duration)
+  {
+    observe(std::chrono::duration<double>(duration).count());
+  }
+
+  /*!
+   * \brief Getter for the upper bounds of the buckets, without the one above the last bound.
+   */
+  const std::vector<double>& getUpperBounds() const
+  {
+    return upper_bounds_;
+  }
+
+  /*!
+   * \brief Getter for the number of values in a bucket.
+   *
+   * \param bucket Index of the bucket, getUpperBounds().size() for values above the last bound
+   *
+   * \returns Number of values in this bucket only, not including the buckets below
+   */
+  uint64_t getBucketCount(const size_t bucket) const;
+
+  /*!
+   * \brief Getter for the number of observed values.
+   */
+  uint64_t getCount() const;
+
+  /*!
+   * \brief Getter for the sum of all observed values.
+   */
+  double getSum() const
+  {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Bounds from 50 us to 1 s suitable for durations in the library, e.g. the time to parse a
+   * package or the time until a command has been answered.
+   */
+  static std::vector<double> defaultDurationBounds();
+
+private:
+  std::vector<double> upper_bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<double> sum_;
+};
+
+/*!
+ * \brief Collection of named metrics, which can be exported in the Prometheus text format.
+ *
+ * Metrics are grouped into families sharing a name, type and help text. The metrics of a family
+ * are distinguished by their labels. Metrics are created on first use and live as long as the
+ * registry, so components look them up once and keep the reference. Requesting a metric again
+ * with the same name and labels returns the same object, e.g. once a driver has been recreated.
+ *
+ * The library reports its metrics to the registry returned by getMetricsRegistry().
+ */
+class MetricsRegistry
+{
+public:
+  MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  /*!
+   * \brief Gets a counter, creating it if necessary.
+   *
+   * \param name Name of the family, should end in "_total"
+   * \param help Description of the family
+   * \param labels Labels of the counter within the family
+   *
+   * \throws UrException if the name or a label name is invalid or the family exists with another
+   * type
+   *
+   * \returns The counter
+   */
+  Counter& getCounter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+  /*!
+   * \brief Gets a gauge, creating it if necessary.
+   *
+   * \param name Name of the family
+   * \param help Description of the family
+   * \param labels Labels of the gauge within the family
+   *
+   * \throws UrException if the name or a label name is invalid or the family exists with another
+   * type
+   *
+   * \returns The gauge
+   */
+  Gauge& getGauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+  /*!
+   * \brief Gets a histogram, creating it if necessary.
+   *
+   * \param name Name of the family
+   * \param help Description of the family
+   * \param upper_bounds Bucket bounds in ascending order, the same for all histograms of a family
+   * \param labels Labels of the histogram within the family
+   *
+   * \throws UrException if the name or a label name is invalid, the family exists with another
+   * type or other bounds, or the bounds aren't ascending
+   *
+   * \returns The histogram
+   */
+  Histogram& getHistogram(const std::string& name, const std::string& help, const std::vector<double>& upper_bounds,
+                          const MetricLabels& labels = {});
+
+  /*!
+   * \brief Writes all metrics in the Prometheus text exposition format, which is also understood by
+   * OpenMetrics parsers. Families are sorted by name.
+   *
+   * \returns The exported metrics, e.g. to be served by an HTTP endpoint of the application
+   */
+  std::string exportText() const;
+
+private:
+  enum class Type
+  {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+  };
+
+  struct Family
+  {
+    Type type;
+    std::string help;
+    std::vector<double> upper_bounds;
+    // Keyed by the formatted labels
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+  };
+
+  Family& getFamily(const std::string& name, const std::string& help, const Type type);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+};
+
+/*!
+ * \brief Getter for the registry the library reports its metrics to.
+ *
+ * \returns The registry shared by all components of the library
+ */
+MetricsRegistry& getMetricsRegistry();
+
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_METRICS_H_INCLUDED
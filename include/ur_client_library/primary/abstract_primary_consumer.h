@@ -31,8 +31,11 @@
 
 #include "ur_client_library/log.h"
 #include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/primary/robot_message/error_code_message.h"
+#include "ur_client_library/primary/robot_message/runtime_exception_message.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
 #include "ur_client_library/primary/robot_state/kinematics_info.h"
+#include "ur_client_library/primary/robot_state_frame.h"
 
 namespace urcl
 {
@@ -68,12 +71,76 @@ public:
     return false;
   }
 
+  /*!
+   * \brief Same as consume(std::shared_ptr<PrimaryPackage>), while the package stays owned by the
+   * pipeline.
+   *
+   * \param product package as it is received from the robot
+   *
+   * \returns true on successful consuming
+   */
+  virtual bool consumeProduct(std::unique_ptr<PrimaryPackage>& product) final
+  {
+    if (product != nullptr)
+    {
+      return product->consumeWith(*this);
+    }
+    return false;
+  }
+
   // To be implemented in specific consumers
   virtual bool consume(RobotMessage& pkg) = 0;
   virtual bool consume(RobotState& pkg) = 0;
   virtual bool consume(VersionMessage& pkg) = 0;
   virtual bool consume(KinematicsInfo& pkg) = 0;
 
+  /*!
+   * \brief Consumes an error code message. By default, it is consumed as a generic robot message.
+   *
+   * \param pkg Message as it is received from the robot
+   *
+   * \returns true on successful consuming
+   */
+  virtual bool consume(ErrorCodeMessage& pkg)
+  {
+    return consume(static_cast<RobotMessage&>(pkg));
+  }
+
+  /*!
+   * \brief Consumes a runtime exception message. By default, it is consumed as a generic robot
+   * message.
+   *
+   * \param pkg Message as it is received from the robot
+   *
+   * \returns true on successful consuming
+   */
+  virtual bool consume(RuntimeExceptionMessage& pkg)
+  {
+    return consume(static_cast<RobotMessage&>(pkg));
+  }
+
+  /*!
+   * \brief Consumes a frame of robot state sub-packages. By default, each of the frame's package
+   * objects is consumed on its own.
+   *
+   * \param frame Frame as it is received from the robot
+   *
+   * \returns true if consuming all of the frame's packages succeeded
+   */
+  virtual bool consume(RobotStateFrame& frame)
+  {
+    bool result = true;
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+      PrimaryPackage* package = frame.getSubPackage(i).package;
+      if (package != nullptr)
+      {
+        result = package->consumeWith(*this) && result;
+      }
+    }
+    return result;
+  }
+
 private:
   /* data */
 };
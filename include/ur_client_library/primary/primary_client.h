@@ -0,0 +1,302 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_PRIMARY_CLIENT_H_INCLUDED
+#define UR_CLIENT_LIBRARY_PRIMARY_CLIENT_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/producer.h"
+#include "ur_client_library/comm/stream.h"
+#include "ur_client_library/primary/package_header.h"
+#include "ur_client_library/primary/primary_parser.h"
+#include "ur_client_library/primary/robot_configuration.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief Persistent client to the robot's primary interface.
+ *
+ * The client keeps one connection to the primary interface open, which is used both to receive
+ * packages from the robot and to send URScript code to it. All received packages are read
+ * continuously by a pipeline and handed to the registered consumers, so the connection never
+ * stalls and does not have to be re-established before sending a script. Robot messages such as
+ * error codes and runtime exceptions are reported through callbacks as soon as they arrive.
+ *
+ * Robot state is delivered as one RobotStateFrame per received robot state package.
+ */
+class PrimaryClient
+{
+public:
+  PrimaryClient() = delete;
+
+  /*!
+   * \brief Creates a new PrimaryClient object. No connection is established before start() is
+   * called.
+   *
+   * \param robot_ip IP address of the robot
+   * \param notifier Notifier informed about the pipeline starting and stopping, has to outlive the
+   * client
+   * \param port Port of the robot's interface to connect to
+   */
+  PrimaryClient(const std::string& robot_ip, comm::INotifier& notifier, const int port = UR_PRIMARY_PORT);
+  ~PrimaryClient();
+
+  /*!
+   * \brief Connects to the robot and starts reading packages in the background. When the
+   * connection is lost afterwards, it is re-established automatically.
+   *
+   * \param max_num_tries Maximum number of connection attempts before counting the connection as
+   * failed. Unlimited number of attempts when set to 0.
+   * \param reconnection_time time in between connection attempts to the server
+   *
+   * \throws UrException if no connection could be established
+   */
+  void start(const size_t max_num_tries = 0,
+             const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10));
+
+  /*!
+   * \brief Stops reading packages and closes the connection.
+   */
+  void stop();
+
+  /*!
+   * \brief Configures the queue handing received packages to the consumers. By default, up to
+   * comm::Pipeline::DEFAULT_QUEUE_CAPACITY packages are queued and new packages are discarded
+   * while the queue is full. A smaller queue bounds the memory of packages waiting to be
+   * consumed. If the client is running, its pipeline is restarted and queued packages are
+   * discarded, the connection is kept.
+   *
+   * \param capacity Maximum number of queued packages
+   * \param policy What to do with new packages while the queue is full
+   */
+  void setPipelineQueue(const size_t capacity, const comm::OverflowPolicy policy);
+
+  /*!
+   * \brief Getter for the state of the connection to the robot.
+   *
+   * \returns The current connection state
+   */
+  comm::ConnectionState getConnectionState() const
+  {
+    return producer_.getConnectionState();
+  }
+
+  /*!
+   * \brief Limits the robot state sub-packages parsed by the client, see
+   * PrimaryParser::setRobotStateSubscription(). This must not be called after start().
+   *
+   * \param types Robot state types to parse
+   */
+  void setRobotStateSubscription(const std::vector<RobotStateType>& types);
+
+  /*!
+   * \brief Decodes robot messages into events queued in a ring, see
+   * PrimaryParser::setRobotMessageEventRing(). Robot messages are then no longer handed to the
+   * consumers and callbacks. This must not be called after start().
+   *
+   * \param ring Ring to queue the events in or nullptr to disable it, has to outlive the client
+   */
+  void setRobotMessageEventRing(RobotMessageEventRing* ring);
+
+  /*!
+   * \brief Adds a consumer receiving all packages read from the robot. Consumers are called from
+   * the pipeline's consumer thread and can be added and removed at any time.
+   *
+   * \param consumer Consumer to add
+   */
+  void addPrimaryConsumer(std::shared_ptr<comm::IConsumer<PrimaryPackage>> consumer);
+
+  /*!
+   * \brief Removes a consumer added with addPrimaryConsumer(). Once this returns, the consumer
+   * is not called anymore. This must not be called from within a consumer or callback.
+   *
+   * \param consumer Consumer to remove
+   */
+  void removePrimaryConsumer(const std::shared_ptr<comm::IConsumer<PrimaryPackage>>& consumer);
+
+  /*!
+   * \brief Sets a function called with every robot message received, including error codes and
+   * runtime exceptions.
+   *
+   * \param callback Function to call from the pipeline's consumer thread, nullptr to disable
+   */
+  void setRobotMessageCallback(std::function<void(const RobotMessage&)> callback);
+
+  /*!
+   * \brief Sets a function called with every error code message received, e.g. when the robot
+   * goes into a protective stop.
+   *
+   * \param callback Function to call from the pipeline's consumer thread, nullptr to disable
+   */
+  void setErrorCodeCallback(std::function<void(const ErrorCodeMessage&)> callback);
+
+  /*!
+   * \brief Sets a function called with every runtime exception message received, i.e. when a
+   * URScript program running on the robot fails.
+   *
+   * \param callback Function to call from the pipeline's consumer thread, nullptr to disable
+   */
+  void setRuntimeExceptionCallback(std::function<void(const RuntimeExceptionMessage&)> callback);
+
+  /*!
+   * \brief Sends URScript code to the robot over the open connection.
+   *
+   * \param program The URScript code. A newline is appended, as the robot's runtime only executes
+   * scripts ending with one.
+   *
+   * \returns True if the script was sent, false if the client is not connected and could not
+   * reconnect
+   */
+  bool sendScript(const std::string& program);
+
+  /*!
+   * \brief Compares the hash of the robot's calibration with the given one.
+   *
+   * The client hashes the calibration as soon as it is received after connecting, which usually
+   * happens right after start(). If it has been received already, the result is returned
+   * immediately, otherwise this waits for it.
+   *
+   * \param checksum Hash of the expected calibration, see KinematicsInfo::toHash()
+   *
+   * \returns True if the robot's calibration matches the checksum, false otherwise
+   */
+  bool checkCalibration(const std::string& checksum);
+
+  /*!
+   * \brief Getter for the hash of the robot's calibration without waiting for it.
+   *
+   * \param hash Filled with the hash, see KinematicsInfo::toHash()
+   *
+   * \returns True if the calibration has been received since start(), false otherwise
+   */
+  bool getCalibrationHash(std::string& hash);
+
+  /*!
+   * \brief Getter for the robot's calibration without waiting for it, e.g. to build a
+   * kinematics::KinematicsModel.
+   *
+   * \param calibration Filled with the DH parameters and checksums of the calibration
+   *
+   * \returns True if the calibration has been received since start(), false otherwise
+   */
+  bool getCalibration(KinematicsInfo& calibration);
+
+  /*!
+   * \brief Getter for the robot's version and configuration.
+   *
+   * The snapshot is taken once per connection from the version message and the first robot state
+   * containing configuration data. It can be stored using a RobotConfigurationCache to have it
+   * available before the robot is connected next time.
+   *
+   * \param configuration Filled with the snapshot
+   * \param timeout Maximum time to wait for the snapshot, if it hasn't been received yet
+   *
+   * \returns True if the snapshot has been received since start(), false on timeout
+   */
+  bool getRobotConfiguration(RobotConfiguration& configuration,
+                             const std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+  /*!
+   * \brief Sets tuning options for the client's socket.
+   *
+   * \param options Options to apply to the socket when it is (re-)connected
+   */
+  void setSocketOptions(const comm::SocketOptions& options);
+
+  /*!
+   * \brief Gets the kernel's TCP statistics of the client's connection.
+   *
+   * \param stats Statistics to fill
+   *
+   * \returns True if the statistics could be read
+   */
+  bool getTcpStatistics(comm::TcpStatistics& stats);
+
+private:
+  class Dispatcher : public comm::IConsumer<PrimaryPackage>
+  {
+  public:
+    explicit Dispatcher(PrimaryClient& client) : client_(client)
+    {
+    }
+
+    bool consume(std::shared_ptr<PrimaryPackage> product) override;
+    bool consumeProduct(std::unique_ptr<PrimaryPackage>& product) override;
+
+  private:
+    PrimaryClient& client_;
+  };
+
+  // Restarts the pipeline with a new connection
+  bool reconnect();
+  void updateCalibration(const PrimaryPackage& product);
+  void updateConfiguration(const PrimaryPackage& product);
+  void dispatchMessage(const PrimaryPackage& product);
+  bool forwardToConsumers(std::shared_ptr<PrimaryPackage> product);
+
+  comm::URStream<PrimaryPackage> stream_;
+  PrimaryParser parser_;
+  comm::URProducer<PrimaryPackage> producer_;
+  Dispatcher dispatcher_;
+  std::unique_ptr<comm::Pipeline<PrimaryPackage>> pipeline_;
+  std::mutex send_mutex_;
+
+  std::mutex consumers_mutex_;
+  std::vector<std::shared_ptr<comm::IConsumer<PrimaryPackage>>> consumers_;
+  std::function<void(const RobotMessage&)> robot_message_callback_;
+  std::function<void(const ErrorCodeMessage&)> error_code_callback_;
+  std::function<void(const RuntimeExceptionMessage&)> runtime_exception_callback_;
+
+  std::mutex calibration_mutex_;
+  std::condition_variable calibration_cv_;
+  KinematicsInfo calibration_;
+  std::string calibration_hash_;
+  bool calibration_received_;
+
+  std::mutex configuration_mutex_;
+  std::condition_variable configuration_cv_;
+  RobotConfiguration configuration_;
+  bool version_received_;
+  bool configuration_data_received_;
+};
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_PRIMARY_CLIENT_H_INCLUDED
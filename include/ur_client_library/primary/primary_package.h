@@ -38,6 +38,22 @@ namespace primary_interface
 {
 class AbstractPrimaryConsumer;
 
+/*!
+ * \brief Identifies the class of a primary package object, so packages can be cast to their class
+ * without RTTI.
+ */
+enum class PrimaryPackageClass : uint8_t
+{
+  OTHER,                      ///< Package classes defined outside of this library
+  ROBOT_STATE,                ///< RobotState
+  KINEMATICS_INFO,            ///< KinematicsInfo
+  ROBOT_STATE_FRAME,          ///< RobotStateFrame
+  ROBOT_MESSAGE,              ///< RobotMessage
+  VERSION_MESSAGE,            ///< VersionMessage
+  ERROR_CODE_MESSAGE,         ///< ErrorCodeMessage
+  RUNTIME_EXCEPTION_MESSAGE   ///< RuntimeExceptionMessage
+};
+
 /*!
  * \brief The PrimaryPackage is solely an abstraction level.
  * It inherits form the URPackage and is also a parent class for primary_interface::RobotMessage,
@@ -49,7 +65,7 @@ public:
   /*!
    * \brief Creates a new PrimaryPackage object.
    */
-  PrimaryPackage() : buffer_length_(0)
+  PrimaryPackage() : buffer_length_(0), package_class_(PrimaryPackageClass::OTHER)
   {
   }
   virtual ~PrimaryPackage() = default;
@@ -81,9 +97,32 @@ public:
    */
   virtual std::string toString() const;
 
+  /*!
+   * \brief Getter for the class of this package object.
+   *
+   * \returns The most derived package class of this library the object belongs to
+   */
+  PrimaryPackageClass getPackageClass() const
+  {
+    return package_class_;
+  }
+
 protected:
+  /*!
+   * \brief Creates a new PrimaryPackage object of a given package class.
+   *
+   * \param package_class Class of the package object being created
+   */
+  explicit PrimaryPackage(const PrimaryPackageClass package_class)
+    : buffer_length_(0), package_class_(package_class)
+  {
+  }
+
   std::unique_ptr<uint8_t[]> buffer_;
   size_t buffer_length_;
+
+private:
+  PrimaryPackageClass package_class_;
 };
 
 }  // namespace primary_interface
@@ -19,14 +19,20 @@
  */
 
 #pragma once
+#include <bitset>
 #include <vector>
 #include "ur_client_library/comm/bin_parser.h"
 #include "ur_client_library/comm/pipeline.h"
 #include "ur_client_library/comm/parser.h"
 #include "ur_client_library/primary/package_header.h"
 #include "ur_client_library/primary/robot_state.h"
+#include "ur_client_library/primary/robot_state_frame.h"
 #include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/primary/robot_message_events.h"
 #include "ur_client_library/primary/robot_state/kinematics_info.h"
+#include "ur_client_library/primary/robot_state/robot_state_views.h"
+#include "ur_client_library/primary/robot_message/error_code_message.h"
+#include "ur_client_library/primary/robot_message/runtime_exception_message.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
 
 namespace urcl
@@ -43,6 +49,88 @@ public:
   PrimaryParser() = default;
   virtual ~PrimaryParser() = default;
 
+  /*!
+   * \brief Puts all sub-packages of a ROBOT_STATE package into a single RobotStateFrame.
+   *
+   * Instead of one package object per sub-package, each ROBOT_STATE package produces one frame,
+   * which is allocated at once and handed through the pipeline as a single product. Sub-packages
+   * without a specific package type are only available as views from the frame. Packages with no
+   * subscribed sub-packages produce no frame at all. Disabled by default.
+   *
+   * \param enabled Whether to create frames
+   */
+  void setRobotStateFrames(const bool enabled)
+  {
+    robot_state_frames_ = enabled;
+  }
+
+  /*!
+   * \brief Limits the robot state sub-packages handled by the parser to the given types.
+   *
+   * Sub-packages of all other types are skipped without being parsed. They are neither created as
+   * packages nor handed to a view consumer. Robot messages are not affected. By default all types
+   * are handled.
+   *
+   * \param types Robot state types to handle
+   */
+  void setRobotStateSubscription(const std::vector<RobotStateType>& types)
+  {
+    subscribed_states_.reset();
+    for (const RobotStateType type : types)
+    {
+      subscribed_states_.set(toUnderlying(type));
+    }
+  }
+
+  /*!
+   * \brief Handles robot state sub-packages of all types again.
+   */
+  void subscribeAllRobotStates()
+  {
+    subscribed_states_.set();
+  }
+
+  /*!
+   * \brief Checks whether robot state sub-packages of a given type are handled by the parser.
+   *
+   * \param type Robot state type to check
+   *
+   * \returns True, if sub-packages of this type are parsed, false if they are skipped
+   */
+  bool isSubscribed(const RobotStateType type) const
+  {
+    return subscribed_states_.test(toUnderlying(type));
+  }
+
+  /*!
+   * \brief Hands all robot state sub-packages to a consumer as views of the received buffer.
+   *
+   * The consumer is called while parsing, before any package objects are created. Sub-packages
+   * without a specific package type are then no longer created as generic RobotState objects, as
+   * the views already cover them. KinematicsInfo packages are still created.
+   *
+   * \param consumer Consumer to call with each sub-package or nullptr to disable views. Has to
+   * outlive the parser or be reset before being destroyed.
+   */
+  void setRobotStateViewConsumer(RobotStateViewConsumer* consumer)
+  {
+    view_consumer_ = consumer;
+  }
+
+  /*!
+   * \brief Decodes robot messages into events queued in a ring instead of creating package objects.
+   *
+   * Robot messages are then decoded without allocating memory and reach neither the pipeline nor
+   * its consumers. Repeated messages are collapsed by the ring, see RobotMessageEventRing.
+   *
+   * \param ring Ring to queue the events in or nullptr to create package objects again. Has to
+   * outlive the parser or be reset before being destroyed.
+   */
+  void setRobotMessageEventRing(RobotMessageEventRing* ring)
+  {
+    message_event_ring_ = ring;
+  }
+
   /*!
    * \brief Uses the given BinParser to create package objects from the contained serialization.
    *
@@ -50,7 +138,8 @@ public:
    * \param results A vector of pointers to created primary package objects
    *
    * \returns True, if the byte stream could successfully be parsed as primary packages, false
-   * otherwise
+   * otherwise. If the package or one of its sub-packages is truncated, \p bp is marked as failed
+   * additionally.
    */
   bool parse(comm::BinParser& bp, std::vector<std::unique_ptr<PrimaryPackage>>& results)
   {
@@ -63,15 +152,19 @@ public:
     {
       case RobotPackageType::ROBOT_STATE:
       {
+        if (robot_state_frames_)
+        {
+          return parseRobotStateFrame(bp, results);
+        }
         while (!bp.empty())
         {
-          if (!bp.checkSize(sizeof(uint32_t)))
+          if (!bp.require(sizeof(uint32_t)))
           {
             URCL_LOG_ERROR("Failed to read sub-package length, there's likely a parsing error");
             return false;
           }
           uint32_t sub_size = bp.peek<uint32_t>();
-          if (!bp.checkSize(static_cast<size_t>(sub_size)))
+          if (!bp.require(static_cast<size_t>(sub_size)))
           {
             URCL_LOG_WARN("Invalid sub-package size of %" PRIu32 " received!", sub_size);
             return false;
@@ -83,6 +176,22 @@ public:
           RobotStateType type;
           sbp.parse(type);
 
+          if (!isSubscribed(type))
+          {
+            sbp.consume();
+            continue;
+          }
+
+          if (view_consumer_ != nullptr)
+          {
+            consumeRobotStateView(*view_consumer_, type, sbp.position(), sbp.remaining());
+            if (type != RobotStateType::KINEMATICS_INFO)
+            {
+              sbp.consume();
+              continue;
+            }
+          }
+
           std::unique_ptr<PrimaryPackage> packet(stateFromType(type));
 
           if (packet == nullptr)
@@ -93,7 +202,7 @@ public:
             continue;
           }
 
-          if (!packet->parseWith(sbp))
+          if (!packet->parseWith(sbp) || sbp.failed())
           {
             URCL_LOG_ERROR("Sub-package parsing of type %d failed!", static_cast<int>(type));
             return false;
@@ -122,8 +231,21 @@ public:
         bp.parse(source);
         bp.parse(message_type);
 
-        std::unique_ptr<PrimaryPackage> packet(messageFromType(message_type, timestamp, source));
-        if (!packet->parseWith(bp))
+        if (message_event_ring_ != nullptr)
+        {
+          RobotMessageEvent event;
+          if (!decodeRobotMessageEvent(message_type, timestamp, source, bp, event))
+          {
+            URCL_LOG_ERROR("Robot message of type %d is too short!", static_cast<int>(message_type));
+            return false;
+          }
+          message_event_ring_->push(event);
+          return true;
+        }
+
+        std::unique_ptr<RobotMessage> packet(messageFromType(message_type, timestamp, source));
+        packet->message_type_ = message_type;
+        if (!packet->parseWith(bp) || bp.failed())
         {
           URCL_LOG_ERROR("Package parsing of type %d failed!", static_cast<int>(message_type));
           return false;
@@ -145,6 +267,95 @@ public:
   }
 
 private:
+  // Sub-package types that are parsed into package objects
+  static bool hasPackageType(const RobotStateType type)
+  {
+    return type == RobotStateType::KINEMATICS_INFO;
+  }
+
+  bool parseRobotStateFrame(comm::BinParser& bp, std::vector<std::unique_ptr<PrimaryPackage>>& results)
+  {
+    // The first pass validates the sub-packages and counts what the frame has to hold, so the whole
+    // frame can be allocated at once.
+    const uint8_t* data = bp.position();
+    const size_t size = bp.remaining();
+    size_t num_sub_packages = 0;
+    size_t package_storage = 0;
+    for (size_t offset = 0; offset < size;)
+    {
+      if (!bp.require(offset + sizeof(uint32_t) + sizeof(RobotStateType)))
+      {
+        URCL_LOG_ERROR("Failed to read sub-package header, there's likely a parsing error");
+        return false;
+      }
+      uint32_t sub_size;
+      std::memcpy(&sub_size, data + offset, sizeof(sub_size));
+      sub_size = be32toh(sub_size);
+      if (sub_size < sizeof(uint32_t) + sizeof(RobotStateType) || !bp.require(offset + sub_size))
+      {
+        URCL_LOG_WARN("Invalid sub-package size of %" PRIu32 " received!", sub_size);
+        return false;
+      }
+      const RobotStateType type = static_cast<RobotStateType>(data[offset + sizeof(uint32_t)]);
+      if (isSubscribed(type))
+      {
+        ++num_sub_packages;
+        if (hasPackageType(type))
+        {
+          package_storage += RobotStateFrame::storageFor<KinematicsInfo>();
+        }
+      }
+      offset += sub_size;
+    }
+    bp.consume();
+    if (num_sub_packages == 0)
+    {
+      return true;
+    }
+
+    std::unique_ptr<RobotStateFrame> frame =
+        RobotStateFrame::create(data, size, num_sub_packages, package_storage);
+    for (size_t offset = 0; offset < size;)
+    {
+      uint32_t sub_size;
+      std::memcpy(&sub_size, data + offset, sizeof(sub_size));
+      sub_size = be32toh(sub_size);
+      const RobotStateType type = static_cast<RobotStateType>(data[offset + sizeof(uint32_t)]);
+      const size_t payload_offset = offset + sizeof(uint32_t) + sizeof(RobotStateType);
+      const size_t payload_size = sub_size - sizeof(uint32_t) - sizeof(RobotStateType);
+      offset += sub_size;
+      if (!isSubscribed(type))
+      {
+        continue;
+      }
+
+      frame->addSubPackage(type, payload_offset, payload_size);
+      uint8_t* payload = frame->getSubPackageData(frame->size() - 1);
+      if (view_consumer_ != nullptr)
+      {
+        consumeRobotStateView(*view_consumer_, type, payload, payload_size);
+      }
+      if (hasPackageType(type))
+      {
+        KinematicsInfo* package = frame->emplacePackage<KinematicsInfo>(type);
+        comm::BinParser sbp(payload, payload_size);
+        if (!package->parseWith(sbp) || sbp.failed())
+        {
+          URCL_LOG_ERROR("Sub-package parsing of type %d failed!", static_cast<int>(type));
+          return false;
+        }
+        if (!sbp.empty())
+        {
+          URCL_LOG_ERROR("Sub-package of type %d was not parsed completely!", static_cast<int>(type));
+          sbp.debug();
+          return false;
+        }
+      }
+    }
+    results.push_back(std::move(frame));
+    return true;
+  }
+
   RobotState* stateFromType(RobotStateType type)
   {
     switch (type)
@@ -174,10 +385,19 @@ private:
         return new MBD;*/
       case RobotMessagePackageType::ROBOT_MESSAGE_VERSION:
         return new VersionMessage(timestamp, source);
+      case RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE:
+        return new ErrorCodeMessage(timestamp, source);
+      case RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION:
+        return new RuntimeExceptionMessage(timestamp, source);
       default:
         return new RobotMessage(timestamp, source);
     }
   }
+
+  RobotStateViewConsumer* view_consumer_ = nullptr;
+  RobotMessageEventRing* message_event_ring_ = nullptr;
+  bool robot_state_frames_ = false;
+  std::bitset<256> subscribed_states_ = std::bitset<256>().set();
 };
 
 }  // namespace primary_interface
@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_ROBOT_CONFIGURATION_H_INCLUDED
+#define UR_CLIENT_LIBRARY_ROBOT_CONFIGURATION_H_INCLUDED
+
+#include <string>
+
+#include "ur_client_library/types.h"
+#include "ur_client_library/primary/robot_message/version_message.h"
+#include "ur_client_library/primary/robot_state/robot_state_views.h"
+#include "ur_client_library/ur/version_information.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief Snapshot of the robot's software version and configuration as sent on the primary
+ * interface, e.g. for client-side checks of joint limits.
+ */
+struct RobotConfiguration
+{
+  VersionInformation version;
+  std::string project_name;
+
+  vector6d_t joint_min_limits{};
+  vector6d_t joint_max_limits{};
+  vector6d_t joint_max_speeds{};
+  vector6d_t joint_max_accelerations{};
+  double default_joint_speed = 0.0;
+  double default_joint_acceleration = 0.0;
+  double default_tool_speed = 0.0;
+  double default_tool_acceleration = 0.0;
+  double eq_radius = 0.0;
+  vector6d_t dh_a{};
+  vector6d_t dh_d{};
+  vector6d_t dh_alpha{};
+  vector6d_t dh_theta{};
+  int32_t masterboard_version = 0;
+  int32_t controller_box_type = 0;
+  int32_t robot_type = 0;
+  int32_t robot_sub_type = 0;
+
+  /*!
+   * \brief Takes over the software version from a version message.
+   *
+   * \param message The version message received from the robot
+   */
+  void setVersion(const VersionMessage& message);
+
+  /*!
+   * \brief Takes over the configuration from a configuration data sub-package.
+   *
+   * \param view View of the sub-package, has to be valid
+   */
+  void setConfiguration(const ConfigurationDataView& view);
+
+  /*!
+   * \brief Checks whether joint positions are within the robot's joint limits.
+   *
+   * \param positions Joint positions to check
+   *
+   * \returns True if all positions are within the limits
+   */
+  bool isWithinJointLimits(const vector6d_t& positions) const;
+
+  friend bool operator==(const RobotConfiguration& c1, const RobotConfiguration& c2);
+  friend bool operator!=(const RobotConfiguration& c1, const RobotConfiguration& c2);
+};
+
+/*!
+ * \brief Stores robot configuration snapshots on disk, one file per robot.
+ *
+ * Robots are identified by their serial number, which can be read using
+ * DashboardClient::commandGetSerialNumber(). Applications can load the snapshot at startup and
+ * replace it once the configuration has been received from the robot again.
+ */
+class RobotConfigurationCache
+{
+public:
+  /*!
+   * \brief Creates a new RobotConfigurationCache object.
+   *
+   * \param directory Directory the snapshots are stored in, it has to exist
+   */
+  explicit RobotConfigurationCache(const std::string& directory);
+
+  /*!
+   * \brief Loads the snapshot of a robot.
+   *
+   * \param serial_number Serial number of the robot
+   * \param configuration Filled with the snapshot
+   *
+   * \returns True if a complete snapshot was loaded, false if there is none or it is invalid
+   */
+  bool load(const std::string& serial_number, RobotConfiguration& configuration) const;
+
+  /*!
+   * \brief Stores the snapshot of a robot, replacing the one stored before.
+   *
+   * \param serial_number Serial number of the robot
+   * \param configuration The snapshot to store
+   *
+   * \returns True if the snapshot was stored
+   */
+  bool store(const std::string& serial_number, const RobotConfiguration& configuration) const;
+
+  /*!
+   * \brief Getter for the file a robot's snapshot is stored in.
+   *
+   * \param serial_number Serial number of the robot
+   *
+   * \throws UrException if the serial number contains characters other than letters, digits, '-'
+   * and '_'
+   *
+   * \returns The path of the file
+   */
+  std::string getPath(const std::string& serial_number) const;
+
+private:
+  std::string directory_;
+};
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_ROBOT_CONFIGURATION_H_INCLUDED
@@ -63,7 +63,8 @@ public:
    * \param timestamp Timestamp of the package
    * \param source The package's source
    */
-  RobotMessage(const uint64_t timestamp, const uint8_t source) : timestamp_(timestamp), source_(source)
+  RobotMessage(const uint64_t timestamp, const uint8_t source)
+    : RobotMessage(timestamp, source, PrimaryPackageClass::ROBOT_MESSAGE)
   {
   }
   virtual ~RobotMessage() = default;
@@ -97,6 +98,19 @@ public:
   uint64_t timestamp_;
   uint8_t source_;
   RobotMessagePackageType message_type_;
+
+protected:
+  /*!
+   * \brief Creates a new RobotMessage object of a derived package class.
+   *
+   * \param timestamp Timestamp of the package
+   * \param source The package's source
+   * \param package_class Class of the package object being created
+   */
+  RobotMessage(const uint64_t timestamp, const uint8_t source, const PrimaryPackageClass package_class)
+    : PrimaryPackage(package_class), timestamp_(timestamp), source_(source)
+  {
+  }
 };
 
 }  // namespace primary_interface
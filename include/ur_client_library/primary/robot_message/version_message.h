@@ -48,7 +48,8 @@ public:
    * \param timestamp Timestamp of the package
    * \param source The package's source
    */
-  VersionMessage(uint64_t timestamp, uint8_t source) : RobotMessage(timestamp, source)
+  VersionMessage(uint64_t timestamp, uint8_t source)
+    : RobotMessage(timestamp, source, PrimaryPackageClass::VERSION_MESSAGE)
   {
   }
   virtual ~VersionMessage() = default;
@@ -0,0 +1,227 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_ROBOT_MESSAGE_EVENTS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_ROBOT_MESSAGE_EVENTS_H_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/primary/robot_message/error_code_message.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief A robot message decoded into fixed-size storage, so no memory is allocated per message.
+ *
+ * Fields not used by the message's type are 0. Texts longer than TEXT_CAPACITY are truncated.
+ */
+struct RobotMessageEvent
+{
+  static constexpr size_t TEXT_CAPACITY = 128;
+
+  uint64_t timestamp = 0;
+  uint8_t source = 0;
+  RobotMessagePackageType type = RobotMessagePackageType::ROBOT_MESSAGE_TEXT;
+  int32_t code = 0;                              ///< Message code of error code messages
+  int32_t argument = 0;                          ///< Message argument of error code messages
+  ReportLevel report_level = ReportLevel::INFO;  ///< Report level of error code messages
+  int32_t line_number = 0;                       ///< Script line of runtime exception messages
+  int32_t column_number = 0;                     ///< Script column of runtime exception messages
+  uint32_t repeat_count = 1;                     ///< Number of identical messages collapsed into this one
+  size_t text_length = 0;
+  bool text_truncated = false;
+  std::array<char, TEXT_CAPACITY> text{};
+
+  /*!
+   * \brief Getter for the message's text.
+   *
+   * \returns A view of the stored text
+   */
+  std::string_view getText() const
+  {
+    return std::string_view(text.data(), text_length);
+  }
+
+  /*!
+   * \brief Checks whether another event reports the same message, ignoring time and repetitions.
+   *
+   * \param other Event to compare with
+   *
+   * \returns True if both events have the same type, codes, script location and text
+   */
+  bool isRepetitionOf(const RobotMessageEvent& other) const;
+};
+
+/*!
+ * \brief Decodes the payload of a robot message into an event without allocating memory.
+ *
+ * \param type Message type parsed from the package header
+ * \param timestamp Timestamp parsed from the package header
+ * \param source Source parsed from the package header
+ * \param bp Parser positioned at the message's payload, which is consumed completely
+ * \param event Event to fill
+ *
+ * \returns True if the payload could be decoded, false if it was too short for the message type
+ */
+bool decodeRobotMessageEvent(const RobotMessagePackageType type, const uint64_t timestamp, const uint8_t source,
+                             comm::BinParser& bp, RobotMessageEvent& event);
+
+/*!
+ * \brief Bounded queue of robot message events, allocated once on construction.
+ *
+ * An event identical to the newest event still queued is not queued again, instead the queued
+ * event's repeat count is increased. That way, a storm of repeated messages, e.g. protective stop
+ * messages, occupies a single slot. When the queue is full, the oldest event is dropped.
+ *
+ * Events can be pushed and popped from different threads.
+ */
+class RobotMessageEventRing
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+  /*!
+   * \brief Creates a new RobotMessageEventRing object.
+   *
+   * \param capacity Maximum number of queued events
+   *
+   * \throws UrException if the capacity is 0
+   */
+  explicit RobotMessageEventRing(const size_t capacity = DEFAULT_CAPACITY);
+
+  /*!
+   * \brief Queues an event or collapses it into the newest queued event if it is a repetition.
+   *
+   * \param event The event to queue
+   *
+   * \returns True if the event was queued or collapsed without dropping another one, false if the
+   * oldest event had to be dropped
+   */
+  bool push(const RobotMessageEvent& event);
+
+  /*!
+   * \brief Takes the oldest queued event.
+   *
+   * \param event Filled with the oldest event
+   *
+   * \returns True if an event was taken, false if the queue is empty
+   */
+  bool pop(RobotMessageEvent& event);
+
+  /*!
+   * \brief Getter for the number of queued events.
+   *
+   * \returns The number of queued events
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Getter for the number of events dropped because the queue was full.
+   *
+   * \returns The number of dropped events
+   */
+  uint64_t getDroppedCount() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<RobotMessageEvent> events_;
+  size_t head_;
+  size_t size_;
+  uint64_t dropped_;
+};
+
+/*!
+ * \brief Logs robot message events, limiting the number of log messages per interval.
+ *
+ * Error codes are logged with a level matching their report level. Messages exceeding the limit
+ * are counted and summarized in a single log message once messages are logged again.
+ */
+class RobotMessageLogger
+{
+public:
+  /*!
+   * \brief Creates a new RobotMessageLogger object.
+   *
+   * \param max_messages Maximum number of messages logged per interval
+   * \param interval Length of the interval
+   */
+  explicit RobotMessageLogger(const size_t max_messages = 10,
+                              const std::chrono::milliseconds interval = std::chrono::seconds(1));
+
+  /*!
+   * \brief Logs an event unless the limit is reached.
+   *
+   * \param event The event to log
+   *
+   * \returns True if the event was logged, false if it was suppressed
+   */
+  bool log(const RobotMessageEvent& event);
+
+  /*!
+   * \brief Takes all queued events from a ring and logs them.
+   *
+   * \param ring The ring to take the events from
+   *
+   * \returns The number of events taken from the ring
+   */
+  size_t drain(RobotMessageEventRing& ring);
+
+  /*!
+   * \brief Getter for the number of events suppressed in total.
+   *
+   * \returns The number of suppressed events
+   */
+  uint64_t getSuppressedCount() const
+  {
+    return suppressed_total_;
+  }
+
+private:
+  size_t max_messages_;
+  std::chrono::steady_clock::duration interval_;
+  std::chrono::steady_clock::time_point interval_start_;
+  size_t logged_in_interval_;
+  uint64_t suppressed_in_interval_;
+  uint64_t suppressed_total_;
+};
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_ROBOT_MESSAGE_EVENTS_H_INCLUDED
@@ -50,7 +50,10 @@ enum class RobotStateType : uint8_t
   CONFIGURATION_DATA = 6,
   FORCE_MODE_DATA = 7,
   ADDITIONAL_INFO = 8,
-  CALIBRATION_DATA = 9
+  CALIBRATION_DATA = 9,
+  SAFETY_DATA = 10,
+  TOOL_COMM_INFO = 11,
+  TOOL_MODE_INFO = 12
 };
 
 /*!
@@ -65,7 +68,7 @@ public:
    *
    * \param type The type of state message
    */
-  RobotState(const RobotStateType type) : state_type_(type)
+  RobotState(const RobotStateType type) : RobotState(type, PrimaryPackageClass::ROBOT_STATE)
   {
   }
   virtual ~RobotState() = default;
@@ -96,6 +99,18 @@ public:
    */
   virtual std::string toString() const;
 
+protected:
+  /*!
+   * \brief Creates a new RobotState object of a derived package class.
+   *
+   * \param type The type of state message
+   * \param package_class Class of the package object being created
+   */
+  RobotState(const RobotStateType type, const PrimaryPackageClass package_class)
+    : PrimaryPackage(package_class), state_type_(type)
+  {
+  }
+
 private:
   RobotStateType state_type_;
 };
@@ -49,7 +49,7 @@ public:
    *
    * \param type The type of RobotState message received
    */
-  KinematicsInfo(const RobotStateType type) : RobotState(type)
+  KinematicsInfo(const RobotStateType type) : RobotState(type, PrimaryPackageClass::KINEMATICS_INFO)
   {
   }
   virtual ~KinematicsInfo() = default;
@@ -0,0 +1,967 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_ROBOT_STATE_VIEWS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_ROBOT_STATE_VIEWS_H_INCLUDED
+
+#include <endian.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "ur_client_library/comm/byte_swap.h"
+#include "ur_client_library/log.h"
+#include "ur_client_library/primary/robot_state.h"
+#include "ur_client_library/types.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief Read-only view of a serialized robot state sub-package.
+ *
+ * Views do not own or copy any data. They point into the buffer the sub-package was received in
+ * and decode fields from their fixed offsets when accessed, so they are only valid as long as this
+ * buffer is, e.g. during a call of a RobotStateViewConsumer.
+ *
+ * Specific views for each RobotStateType offer typed accessors. Their accessors may only be used if
+ * isValid() returns true, i.e. if the sub-package contains all fields the view knows about.
+ */
+class RobotStateView
+{
+public:
+  /*!
+   * \brief Creates a view of a sub-package.
+   *
+   * \param type Type of the sub-package
+   * \param data Begin of the sub-package's payload directly following its type
+   * \param size Size of the payload in bytes
+   */
+  RobotStateView(const RobotStateType type, const uint8_t* data, const size_t size)
+    : type_(type), data_(data), size_(size)
+  {
+  }
+
+  /*!
+   * \brief Type of the viewed sub-package.
+   */
+  RobotStateType getType() const
+  {
+    return type_;
+  }
+
+  /*!
+   * \brief Serialized payload of the sub-package in network byte order.
+   */
+  const uint8_t* data() const
+  {
+    return data_;
+  }
+
+  /*!
+   * \brief Size of the payload in bytes.
+   */
+  size_t size() const
+  {
+    return size_;
+  }
+
+protected:
+  // Decodes a single big endian value at the given offset of the payload
+  template <typename T>
+  T get(const size_t offset) const
+  {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic values can be decoded from robot state views");
+    if constexpr (std::is_same<T, bool>::value)
+    {
+      return data_[offset] != 0;
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+      return static_cast<T>(data_[offset]);
+    }
+    else
+    {
+      using Raw = typename std::conditional<sizeof(T) == 8, uint64_t,
+                                            typename std::conditional<sizeof(T) == 4, uint32_t, uint16_t>::type>::type;
+      Raw raw;
+      std::memcpy(&raw, data_ + offset, sizeof(raw));
+      if constexpr (sizeof(T) == 8)
+      {
+        raw = be64toh(raw);
+      }
+      else if constexpr (sizeof(T) == 4)
+      {
+        raw = be32toh(raw);
+      }
+      else
+      {
+        raw = be16toh(raw);
+      }
+      T value;
+      std::memcpy(&value, &raw, sizeof(value));
+      return value;
+    }
+  }
+
+  // Decodes consecutive big endian values at the given offset of the payload
+  template <typename T, size_t N>
+  std::array<T, N> getArray(const size_t offset) const
+  {
+    std::array<T, N> values;
+    comm::swapBytes<T>(reinterpret_cast<uint8_t*>(values.data()), data_ + offset, N);
+    return values;
+  }
+
+  // Decodes one value of each joint, with the joints' values being the given stride apart
+  template <typename T>
+  vector6d_t getJointValues(const size_t offset, const size_t stride) const
+  {
+    vector6d_t values;
+    for (size_t i = 0; i < 6; ++i)
+    {
+      values[i] = get<T>(offset + i * stride);
+    }
+    return values;
+  }
+
+  RobotStateType type_;
+  const uint8_t* data_;
+  size_t size_;
+};
+
+/*!
+ * \brief View of a ROBOT_MODE_DATA sub-package.
+ */
+class RobotModeDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 41;
+
+  RobotModeDataView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::ROBOT_MODE_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  uint64_t getTimestamp() const
+  {
+    return get<uint64_t>(0);
+  }
+  bool isRealRobotConnected() const
+  {
+    return get<bool>(8);
+  }
+  bool isRealRobotEnabled() const
+  {
+    return get<bool>(9);
+  }
+  bool isRobotPowerOn() const
+  {
+    return get<bool>(10);
+  }
+  bool isEmergencyStopped() const
+  {
+    return get<bool>(11);
+  }
+  bool isProtectiveStopped() const
+  {
+    return get<bool>(12);
+  }
+  bool isProgramRunning() const
+  {
+    return get<bool>(13);
+  }
+  bool isProgramPaused() const
+  {
+    return get<bool>(14);
+  }
+  /*!
+   * \brief Robot mode as also used by RTDE's \p robot_mode, e.g. 7 for RUNNING.
+   */
+  int8_t getRobotMode() const
+  {
+    return get<int8_t>(15);
+  }
+  uint8_t getControlMode() const
+  {
+    return get<uint8_t>(16);
+  }
+  double getTargetSpeedFraction() const
+  {
+    return get<double>(17);
+  }
+  double getSpeedScaling() const
+  {
+    return get<double>(25);
+  }
+  double getTargetSpeedFractionLimit() const
+  {
+    return get<double>(33);
+  }
+};
+
+/*!
+ * \brief View of a JOINT_DATA sub-package.
+ */
+class JointDataView : public RobotStateView
+{
+public:
+  static constexpr size_t JOINT_SIZE = 41;
+  static constexpr size_t MIN_SIZE = 6 * JOINT_SIZE;
+
+  JointDataView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::JOINT_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  double getActualPosition(const size_t joint) const
+  {
+    return get<double>(joint * JOINT_SIZE);
+  }
+  double getTargetPosition(const size_t joint) const
+  {
+    return get<double>(joint * JOINT_SIZE + 8);
+  }
+  double getActualSpeed(const size_t joint) const
+  {
+    return get<double>(joint * JOINT_SIZE + 16);
+  }
+  float getActualCurrent(const size_t joint) const
+  {
+    return get<float>(joint * JOINT_SIZE + 24);
+  }
+  float getActualVoltage(const size_t joint) const
+  {
+    return get<float>(joint * JOINT_SIZE + 28);
+  }
+  float getMotorTemperature(const size_t joint) const
+  {
+    return get<float>(joint * JOINT_SIZE + 32);
+  }
+  uint8_t getJointMode(const size_t joint) const
+  {
+    return get<uint8_t>(joint * JOINT_SIZE + 40);
+  }
+
+  vector6d_t getActualPositions() const
+  {
+    return getJointValues<double>(0, JOINT_SIZE);
+  }
+  vector6d_t getTargetPositions() const
+  {
+    return getJointValues<double>(8, JOINT_SIZE);
+  }
+  vector6d_t getActualSpeeds() const
+  {
+    return getJointValues<double>(16, JOINT_SIZE);
+  }
+  vector6d_t getActualCurrents() const
+  {
+    return getJointValues<float>(24, JOINT_SIZE);
+  }
+  vector6d_t getMotorTemperatures() const
+  {
+    return getJointValues<float>(32, JOINT_SIZE);
+  }
+};
+
+/*!
+ * \brief View of a TOOL_DATA sub-package.
+ */
+class ToolDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 32;
+
+  ToolDataView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::TOOL_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  uint8_t getAnalogInputRange0() const
+  {
+    return get<uint8_t>(0);
+  }
+  uint8_t getAnalogInputRange1() const
+  {
+    return get<uint8_t>(1);
+  }
+  double getAnalogInput0() const
+  {
+    return get<double>(2);
+  }
+  double getAnalogInput1() const
+  {
+    return get<double>(10);
+  }
+  float getToolVoltage48V() const
+  {
+    return get<float>(18);
+  }
+  uint8_t getToolOutputVoltage() const
+  {
+    return get<uint8_t>(22);
+  }
+  float getToolCurrent() const
+  {
+    return get<float>(23);
+  }
+  float getToolTemperature() const
+  {
+    return get<float>(27);
+  }
+  uint8_t getToolMode() const
+  {
+    return get<uint8_t>(31);
+  }
+};
+
+/*!
+ * \brief View of a MASTERBOARD_DATA sub-package.
+ *
+ * The Euromap67 fields are only present if isEuromap67InterfaceInstalled() returns true.
+ */
+class MasterboardDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 63;
+  static constexpr size_t EUROMAP67_SIZE = 16;
+
+  MasterboardDataView(const uint8_t* data, const size_t size)
+    : RobotStateView(RobotStateType::MASTERBOARD_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE && (!isEuromap67InterfaceInstalled() || size_ >= MIN_SIZE + EUROMAP67_SIZE);
+  }
+
+  uint32_t getDigitalInputBits() const
+  {
+    return get<uint32_t>(0);
+  }
+  uint32_t getDigitalOutputBits() const
+  {
+    return get<uint32_t>(4);
+  }
+  uint8_t getAnalogInputRange0() const
+  {
+    return get<uint8_t>(8);
+  }
+  uint8_t getAnalogInputRange1() const
+  {
+    return get<uint8_t>(9);
+  }
+  double getAnalogInput0() const
+  {
+    return get<double>(10);
+  }
+  double getAnalogInput1() const
+  {
+    return get<double>(18);
+  }
+  uint8_t getAnalogOutputDomain0() const
+  {
+    return get<uint8_t>(26);
+  }
+  uint8_t getAnalogOutputDomain1() const
+  {
+    return get<uint8_t>(27);
+  }
+  double getAnalogOutput0() const
+  {
+    return get<double>(28);
+  }
+  double getAnalogOutput1() const
+  {
+    return get<double>(36);
+  }
+  float getMasterboardTemperature() const
+  {
+    return get<float>(44);
+  }
+  float getRobotVoltage48V() const
+  {
+    return get<float>(48);
+  }
+  float getRobotCurrent() const
+  {
+    return get<float>(52);
+  }
+  float getMasterIOCurrent() const
+  {
+    return get<float>(56);
+  }
+  /*!
+   * \brief Safety mode as also used by RTDE's \p safety_mode, e.g. 1 for NORMAL.
+   */
+  uint8_t getSafetyMode() const
+  {
+    return get<uint8_t>(60);
+  }
+  bool isInReducedMode() const
+  {
+    return get<bool>(61);
+  }
+  bool isEuromap67InterfaceInstalled() const
+  {
+    return get<bool>(62);
+  }
+  uint32_t getEuromapInputBits() const
+  {
+    return get<uint32_t>(63);
+  }
+  uint32_t getEuromapOutputBits() const
+  {
+    return get<uint32_t>(67);
+  }
+  float getEuromapVoltage24V() const
+  {
+    return get<float>(71);
+  }
+  float getEuromapCurrent() const
+  {
+    return get<float>(75);
+  }
+
+  /*!
+   * \brief Returns true if the package contains the operational mode selector and three position
+   * enabling device inputs, which depends on the software version.
+   */
+  bool hasSafetyInputs() const
+  {
+    return size_ >= euromapEnd() + 6;
+  }
+  uint8_t getOperationalModeSelectorInput() const
+  {
+    return get<uint8_t>(euromapEnd() + 4);
+  }
+  uint8_t getThreePositionEnablingDeviceInput() const
+  {
+    return get<uint8_t>(euromapEnd() + 5);
+  }
+
+private:
+  size_t euromapEnd() const
+  {
+    return isEuromap67InterfaceInstalled() ? MIN_SIZE + EUROMAP67_SIZE : MIN_SIZE;
+  }
+};
+
+/*!
+ * \brief View of a CARTESIAN_INFO sub-package.
+ */
+class CartesianInfoView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 96;
+
+  CartesianInfoView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::CARTESIAN_INFO, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  /*!
+   * \brief TCP pose as [x, y, z, rx, ry, rz] in the base frame.
+   */
+  vector6d_t getToolPose() const
+  {
+    return getArray<double, 6>(0);
+  }
+  /*!
+   * \brief Configured TCP offset as [x, y, z, rx, ry, rz] relative to the flange.
+   */
+  vector6d_t getTcpOffset() const
+  {
+    return getArray<double, 6>(48);
+  }
+};
+
+/*!
+ * \brief View of a KINEMATICS_INFO sub-package. See KinematicsInfo for a parsed copy.
+ */
+class KinematicsInfoView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 220;
+
+  KinematicsInfoView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::KINEMATICS_INFO, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  vector6uint32_t getChecksum() const
+  {
+    return getArray<uint32_t, 6>(0);
+  }
+  vector6d_t getDHTheta() const
+  {
+    return getArray<double, 6>(24);
+  }
+  vector6d_t getDHa() const
+  {
+    return getArray<double, 6>(72);
+  }
+  vector6d_t getDHd() const
+  {
+    return getArray<double, 6>(120);
+  }
+  vector6d_t getDHAlpha() const
+  {
+    return getArray<double, 6>(168);
+  }
+  uint32_t getCalibrationStatus() const
+  {
+    return get<uint32_t>(216);
+  }
+};
+
+/*!
+ * \brief View of a CONFIGURATION_DATA sub-package.
+ */
+class ConfigurationDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 440;
+
+  ConfigurationDataView(const uint8_t* data, const size_t size)
+    : RobotStateView(RobotStateType::CONFIGURATION_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  vector6d_t getJointMinLimits() const
+  {
+    return getJointValues<double>(0, 16);
+  }
+  vector6d_t getJointMaxLimits() const
+  {
+    return getJointValues<double>(8, 16);
+  }
+  vector6d_t getJointMaxSpeeds() const
+  {
+    return getJointValues<double>(96, 16);
+  }
+  vector6d_t getJointMaxAccelerations() const
+  {
+    return getJointValues<double>(104, 16);
+  }
+  double getDefaultJointSpeed() const
+  {
+    return get<double>(192);
+  }
+  double getDefaultJointAcceleration() const
+  {
+    return get<double>(200);
+  }
+  double getDefaultToolSpeed() const
+  {
+    return get<double>(208);
+  }
+  double getDefaultToolAcceleration() const
+  {
+    return get<double>(216);
+  }
+  double getEqRadius() const
+  {
+    return get<double>(224);
+  }
+  vector6d_t getDHa() const
+  {
+    return getArray<double, 6>(232);
+  }
+  vector6d_t getDHd() const
+  {
+    return getArray<double, 6>(280);
+  }
+  vector6d_t getDHAlpha() const
+  {
+    return getArray<double, 6>(328);
+  }
+  vector6d_t getDHTheta() const
+  {
+    return getArray<double, 6>(376);
+  }
+  int32_t getMasterboardVersion() const
+  {
+    return get<int32_t>(424);
+  }
+  int32_t getControllerBoxType() const
+  {
+    return get<int32_t>(428);
+  }
+  int32_t getRobotType() const
+  {
+    return get<int32_t>(432);
+  }
+  int32_t getRobotSubType() const
+  {
+    return get<int32_t>(436);
+  }
+};
+
+/*!
+ * \brief View of a FORCE_MODE_DATA sub-package.
+ */
+class ForceModeDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 56;
+
+  ForceModeDataView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::FORCE_MODE_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  /*!
+   * \brief Wrench as [Fx, Fy, Fz, Frx, Fry, Frz] applied by force mode.
+   */
+  vector6d_t getWrench() const
+  {
+    return getArray<double, 6>(0);
+  }
+  double getRobotDexterity() const
+  {
+    return get<double>(48);
+  }
+};
+
+/*!
+ * \brief View of an ADDITIONAL_INFO sub-package.
+ */
+class AdditionalInfoView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 3;
+
+  AdditionalInfoView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::ADDITIONAL_INFO, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  bool isFreedriveButtonPressed() const
+  {
+    return get<bool>(0);
+  }
+  bool isFreedriveButtonEnabled() const
+  {
+    return get<bool>(1);
+  }
+  bool isFreedriveIOEnabled() const
+  {
+    return get<bool>(2);
+  }
+};
+
+/*!
+ * \brief View of a CALIBRATION_DATA sub-package, which is used by UR software only.
+ */
+class CalibrationDataView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 48;
+
+  CalibrationDataView(const uint8_t* data, const size_t size)
+    : RobotStateView(RobotStateType::CALIBRATION_DATA, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  /*!
+   * \brief The six calibration values of the force torque sensor [Fx, Fy, Fz, Frx, Fry, Frz].
+   */
+  vector6d_t getValues() const
+  {
+    return getArray<double, 6>(0);
+  }
+};
+
+/*!
+ * \brief View of a TOOL_COMM_INFO sub-package describing the tool communication interface.
+ */
+class ToolCommInfoView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 21;
+
+  ToolCommInfoView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::TOOL_COMM_INFO, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  bool isToolCommunicationEnabled() const
+  {
+    return get<bool>(0);
+  }
+  int32_t getBaudRate() const
+  {
+    return get<int32_t>(1);
+  }
+  int32_t getParity() const
+  {
+    return get<int32_t>(5);
+  }
+  int32_t getStopBits() const
+  {
+    return get<int32_t>(9);
+  }
+  float getRxIdleChars() const
+  {
+    return get<float>(13);
+  }
+  float getTxIdleChars() const
+  {
+    return get<float>(17);
+  }
+};
+
+/*!
+ * \brief View of a TOOL_MODE_INFO sub-package describing the tool's output configuration.
+ */
+class ToolModeInfoView : public RobotStateView
+{
+public:
+  static constexpr size_t MIN_SIZE = 3;
+
+  ToolModeInfoView(const uint8_t* data, const size_t size) : RobotStateView(RobotStateType::TOOL_MODE_INFO, data, size)
+  {
+  }
+
+  bool isValid() const
+  {
+    return size_ >= MIN_SIZE;
+  }
+
+  uint8_t getOutputMode() const
+  {
+    return get<uint8_t>(0);
+  }
+  uint8_t getDigitalOutputModeOutput0() const
+  {
+    return get<uint8_t>(1);
+  }
+  uint8_t getDigitalOutputModeOutput1() const
+  {
+    return get<uint8_t>(2);
+  }
+};
+
+/*!
+ * \brief Receives views of robot state sub-packages from the PrimaryParser.
+ *
+ * Each function is called on the producer's thread while the received package is being parsed and
+ * the view is only valid during that call. Values needed later have to be copied. Consumers only
+ * override the functions for the sub-packages they need, all others forward to
+ * consume(const RobotStateView&), which does nothing by default.
+ */
+class RobotStateViewConsumer
+{
+public:
+  virtual ~RobotStateViewConsumer() = default;
+
+  virtual void consume(const RobotModeDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const JointDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const ToolDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const MasterboardDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const CartesianInfoView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const KinematicsInfoView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const ConfigurationDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const ForceModeDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const AdditionalInfoView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const CalibrationDataView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const ToolCommInfoView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+  virtual void consume(const ToolModeInfoView& view)
+  {
+    consume(static_cast<const RobotStateView&>(view));
+  }
+
+  /*!
+   * \brief Called for sub-packages without a specific view, such as SAFETY_DATA, and for
+   * sub-packages too short for their specific view.
+   */
+  virtual void consume(const RobotStateView& /*view*/)
+  {
+  }
+};
+
+namespace detail
+{
+template <typename View>
+void consumeRobotStateView(RobotStateViewConsumer& consumer, const uint8_t* data, const size_t size)
+{
+  const View view(data, size);
+  if (view.isValid())
+  {
+    consumer.consume(view);
+  }
+  else
+  {
+    URCL_LOG_DEBUG("Sub-package of type %d is too short for its view (%zu bytes)", static_cast<int>(view.getType()),
+                   size);
+    consumer.consume(static_cast<const RobotStateView&>(view));
+  }
+}
+}  // namespace detail
+
+/*!
+ * \brief Hands a serialized sub-package to a consumer as the view matching its type.
+ *
+ * \param consumer Consumer to call
+ * \param type Type of the sub-package
+ * \param data Begin of the sub-package's payload directly following its type
+ * \param size Size of the payload in bytes
+ */
+inline void consumeRobotStateView(RobotStateViewConsumer& consumer, const RobotStateType type, const uint8_t* data,
+                                  const size_t size)
+{
+  switch (type)
+  {
+    case RobotStateType::ROBOT_MODE_DATA:
+      detail::consumeRobotStateView<RobotModeDataView>(consumer, data, size);
+      break;
+    case RobotStateType::JOINT_DATA:
+      detail::consumeRobotStateView<JointDataView>(consumer, data, size);
+      break;
+    case RobotStateType::TOOL_DATA:
+      detail::consumeRobotStateView<ToolDataView>(consumer, data, size);
+      break;
+    case RobotStateType::MASTERBOARD_DATA:
+      detail::consumeRobotStateView<MasterboardDataView>(consumer, data, size);
+      break;
+    case RobotStateType::CARTESIAN_INFO:
+      detail::consumeRobotStateView<CartesianInfoView>(consumer, data, size);
+      break;
+    case RobotStateType::KINEMATICS_INFO:
+      detail::consumeRobotStateView<KinematicsInfoView>(consumer, data, size);
+      break;
+    case RobotStateType::CONFIGURATION_DATA:
+      detail::consumeRobotStateView<ConfigurationDataView>(consumer, data, size);
+      break;
+    case RobotStateType::FORCE_MODE_DATA:
+      detail::consumeRobotStateView<ForceModeDataView>(consumer, data, size);
+      break;
+    case RobotStateType::ADDITIONAL_INFO:
+      detail::consumeRobotStateView<AdditionalInfoView>(consumer, data, size);
+      break;
+    case RobotStateType::CALIBRATION_DATA:
+      detail::consumeRobotStateView<CalibrationDataView>(consumer, data, size);
+      break;
+    case RobotStateType::TOOL_COMM_INFO:
+      detail::consumeRobotStateView<ToolCommInfoView>(consumer, data, size);
+      break;
+    case RobotStateType::TOOL_MODE_INFO:
+      detail::consumeRobotStateView<ToolModeInfoView>(consumer, data, size);
+      break;
+    default:
+      consumer.consume(RobotStateView(type, data, size));
+      break;
+  }
+}
+
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_ROBOT_STATE_VIEWS_H_INCLUDED
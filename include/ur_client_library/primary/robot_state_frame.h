@@ -0,0 +1,235 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_ROBOT_STATE_FRAME_H_INCLUDED
+#define UR_CLIENT_LIBRARY_ROBOT_STATE_FRAME_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "ur_client_library/primary/primary_package.h"
+#include "ur_client_library/primary/robot_state.h"
+#include "ur_client_library/primary/robot_state/robot_state_views.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief All sub-packages of one received ROBOT_STATE package in a single allocation.
+ *
+ * The frame object, a copy of the serialized sub-packages, the table of sub-packages and all
+ * sub-packages parsed into package objects (such as KinematicsInfo) live in one contiguous block
+ * of memory, which is freed at once when the frame is destroyed. Sub-packages without a specific
+ * package type are not created as objects but can be read through views of the frame's copy,
+ * which stay valid as long as the frame exists.
+ *
+ * Frames are created by the PrimaryParser if enabled using PrimaryParser::setRobotStateFrames().
+ */
+class RobotStateFrame : public PrimaryPackage
+{
+public:
+  /*!
+   * \brief Entry of a single sub-package of the frame.
+   */
+  struct SubPackage
+  {
+    RobotStateType type;
+    uint32_t offset;          ///< Offset of the sub-package's payload in the frame's data
+    uint32_t size;            ///< Size of the sub-package's payload
+    PrimaryPackage* package;  ///< Parsed package object or nullptr if the sub-package is only available as view
+  };
+
+  /*!
+   * \brief Creates a new frame holding a copy of serialized sub-packages.
+   *
+   * \param data Serialized sub-packages of a ROBOT_STATE package
+   * \param size Size of \p data in bytes
+   * \param max_sub_packages Number of sub-packages that can be added to the frame
+   * \param package_storage Bytes to reserve for package objects created using emplacePackage()
+   *
+   * \returns The new frame
+   */
+  static std::unique_ptr<RobotStateFrame> create(const uint8_t* data, const size_t size,
+                                                 const size_t max_sub_packages, const size_t package_storage);
+
+  /*!
+   * \brief Storage needed for a package object of the given type created using emplacePackage().
+   */
+  template <typename T>
+  static constexpr size_t storageFor()
+  {
+    return alignUp(sizeof(T));
+  }
+
+  RobotStateFrame(const RobotStateFrame&) = delete;
+  RobotStateFrame& operator=(const RobotStateFrame&) = delete;
+  virtual ~RobotStateFrame();
+
+  /*!
+   * \brief Adds a sub-package with the given position in the frame's data.
+   *
+   * \param type Type of the sub-package
+   * \param offset Offset of the sub-package's payload in the frame's data
+   * \param size Size of the payload in bytes
+   *
+   * \returns False, if the frame is full or the sub-package exceeds the frame's data
+   */
+  bool addSubPackage(const RobotStateType type, const size_t offset, const size_t size);
+
+  /*!
+   * \brief Creates a package object for the sub-package added last within the frame's storage.
+   *
+   * \param args Arguments for the package's constructor
+   *
+   * \returns The created package or nullptr if the reserved storage is exhausted or no sub-package
+   * has been added yet
+   */
+  template <typename T, typename... Args>
+  T* emplacePackage(Args&&... args)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned packages are not supported");
+    if (num_sub_packages_ == 0 || sub_packages_[num_sub_packages_ - 1].package != nullptr ||
+        package_storage_used_ + storageFor<T>() > package_storage_size_)
+    {
+      return nullptr;
+    }
+    T* package = ::new (package_storage_ + package_storage_used_) T(std::forward<Args>(args)...);
+    package_storage_used_ += storageFor<T>();
+    sub_packages_[num_sub_packages_ - 1].package = package;
+    return package;
+  }
+
+  /*!
+   * \brief Number of sub-packages in the frame.
+   */
+  size_t size() const
+  {
+    return num_sub_packages_;
+  }
+
+  /*!
+   * \brief Returns one sub-package of the frame.
+   *
+   * \param index Index of the sub-package, has to be less than size()
+   */
+  const SubPackage& getSubPackage(const size_t index) const
+  {
+    return sub_packages_[index];
+  }
+
+  /*!
+   * \brief Payload of one sub-package, e.g. for parsing it into a package object.
+   *
+   * \param index Index of the sub-package, has to be less than size()
+   */
+  uint8_t* getSubPackageData(const size_t index)
+  {
+    return data_ + sub_packages_[index].offset;
+  }
+
+  /*!
+   * \brief Creates a view of one sub-package, which is valid as long as the frame exists.
+   *
+   * \param index Index of the sub-package, has to be less than size()
+   */
+  RobotStateView getView(const size_t index) const
+  {
+    const SubPackage& sub_package = sub_packages_[index];
+    return RobotStateView(sub_package.type, data_ + sub_package.offset, sub_package.size);
+  }
+
+  /*!
+   * \brief Returns the first package object of the given type within the frame.
+   *
+   * \returns The package or nullptr if the frame contains no such package
+   */
+  template <typename T>
+  T* getPackage() const
+  {
+    for (size_t i = 0; i < num_sub_packages_; ++i)
+    {
+      if (T* package = dynamic_cast<T*>(sub_packages_[i].package))
+      {
+        return package;
+      }
+    }
+    return nullptr;
+  }
+
+  /*!
+   * \brief Hands all sub-packages of the frame to a consumer as views.
+   *
+   * \param consumer Consumer to call with each sub-package
+   */
+  void consumeViews(RobotStateViewConsumer& consumer) const;
+
+  /*!
+   * \brief Hands all package objects of the frame to a consumer.
+   *
+   * \param consumer Consumer to call with each package object
+   *
+   * \returns True, if consuming all package objects succeeded
+   */
+  virtual bool consumeWith(AbstractPrimaryConsumer& consumer);
+
+  /*!
+   * \brief Produces a human readable representation of the frame's package objects.
+   *
+   * \returns A string representing the object
+   */
+  virtual std::string toString() const;
+
+private:
+  static constexpr size_t alignUp(const size_t size)
+  {
+    return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+  }
+
+  RobotStateFrame(uint8_t* package_storage, const size_t package_storage_size, SubPackage* sub_packages,
+                  const size_t max_sub_packages, uint8_t* data, const size_t size);
+
+  uint8_t* package_storage_;
+  size_t package_storage_size_;
+  size_t package_storage_used_;
+  SubPackage* sub_packages_;
+  size_t max_sub_packages_;
+  size_t num_sub_packages_;
+  uint8_t* data_;
+  size_t data_size_;
+};
+
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_ROBOT_STATE_FRAME_H_INCLUDED
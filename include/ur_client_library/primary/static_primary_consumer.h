@@ -0,0 +1,138 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STATIC_PRIMARY_CONSUMER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STATIC_PRIMARY_CONSUMER_H_INCLUDED
+
+#include "ur_client_library/comm/static_consumer.h"
+#include "ur_client_library/primary/primary_package.h"
+#include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/primary/robot_message/error_code_message.h"
+#include "ur_client_library/primary/robot_message/runtime_exception_message.h"
+#include "ur_client_library/primary/robot_message/version_message.h"
+#include "ur_client_library/primary/robot_state.h"
+#include "ur_client_library/primary/robot_state/kinematics_info.h"
+#include "ur_client_library/primary/robot_state_frame.h"
+
+namespace urcl
+{
+namespace comm
+{
+template <>
+struct PackageClassTraits<primary_interface::RobotState>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::ROBOT_STATE ||
+           product.getPackageClass() == primary_interface::PrimaryPackageClass::KINEMATICS_INFO;
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::KinematicsInfo>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::KINEMATICS_INFO;
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::RobotStateFrame>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::ROBOT_STATE_FRAME;
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::RobotMessage>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    switch (product.getPackageClass())
+    {
+      case primary_interface::PrimaryPackageClass::ROBOT_MESSAGE:
+      case primary_interface::PrimaryPackageClass::VERSION_MESSAGE:
+      case primary_interface::PrimaryPackageClass::ERROR_CODE_MESSAGE:
+      case primary_interface::PrimaryPackageClass::RUNTIME_EXCEPTION_MESSAGE:
+        return true;
+      default:
+        return false;
+    }
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::VersionMessage>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::VERSION_MESSAGE;
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::ErrorCodeMessage>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::ERROR_CODE_MESSAGE;
+  }
+};
+
+template <>
+struct PackageClassTraits<primary_interface::RuntimeExceptionMessage>
+{
+  static bool matches(const primary_interface::PrimaryPackage& product)
+  {
+    return product.getPackageClass() == primary_interface::PrimaryPackageClass::RUNTIME_EXCEPTION_MESSAGE;
+  }
+};
+}  // namespace comm
+
+namespace primary_interface
+{
+/*!
+ * \brief Primary interface consumer with statically dispatched handlers, see comm::StaticConsumer.
+ *
+ * Handled classes can be RobotState, KinematicsInfo, RobotStateFrame, RobotMessage,
+ * VersionMessage, ErrorCodeMessage and RuntimeExceptionMessage. More specific classes have to be listed before their base classes.
+ *
+ * @tparam Derived The consumer class deriving from this class
+ * @tparam HandledT Package classes Derived provides a handle() function for
+ */
+template <typename Derived, typename... HandledT>
+using StaticPrimaryConsumer = comm::StaticConsumer<Derived, PrimaryPackage, HandledT...>;
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_STATIC_PRIMARY_CONSUMER_H_INCLUDED
@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_CLOCK_SYNCHRONIZER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_CLOCK_SYNCHRONIZER_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Estimates the relation between the robot controller's clock and the host's clocks.
+ *
+ * The robot's \p timestamp field counts the controller's time in seconds, while data of other
+ * sensors is usually stamped with host time. Every received package relates a robot time to the
+ * host time it arrived at, which is delayed by a varying network and scheduling latency, but never
+ * earlier than the robot time plus the true offset. The synchronizer therefore keeps the sample
+ * with the smallest delay within windows of a configurable duration and fits offset and drift
+ * through the minima of the recent windows using least squares. Jitter only ever delays packages,
+ * so it hardly affects the minima.
+ *
+ * The host times are taken from the steady clock, i.e. \p CLOCK_MONOTONIC. Mappings to the system
+ * clock, i.e. \p CLOCK_REALTIME, use the current offset between both host clocks.
+ */
+class ClockSynchronizer
+{
+public:
+  //! Default duration of a window, whose minimum delay is used for the fit
+  static constexpr std::chrono::milliseconds DEFAULT_WINDOW{ 500 };
+  //! Default number of windows used for the fit
+  static const size_t DEFAULT_NUM_WINDOWS = 20;
+
+  /*!
+   * \brief Creates a new ClockSynchronizer object.
+   *
+   * \param window Duration of a window in robot time, whose minimum delay is used for the fit
+   * \param num_windows Number of recent windows used for the fit, at least 1
+   *
+   * \throws UrException if window or num_windows isn't positive
+   */
+  explicit ClockSynchronizer(const std::chrono::milliseconds window = DEFAULT_WINDOW,
+                             const size_t num_windows = DEFAULT_NUM_WINDOWS);
+
+  /*!
+   * \brief Binds the synchronizer to the recipe of the received data packages.
+   *
+   * \param recipe The recipe of the data packages passed to update()
+   *
+   * \throws UrException if the recipe doesn't contain the \p timestamp field
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Adds the robot time of a received data package. The kernel receive time is used if
+   * available, the time the package was read from the socket otherwise.
+   *
+   * \param package The data package, it has to be based on the recipe passed to setRecipe()
+   */
+  void update(const DataPackage& package);
+
+  /*!
+   * \brief Adds a pair of robot time and host time it has been received at.
+   *
+   * \param robot_time The robot's \p timestamp in seconds
+   * \param host_time The time the robot time has been received on the host
+   */
+  void update(const double robot_time, const std::chrono::steady_clock::time_point host_time);
+
+  /*!
+   * \brief Discards all samples, e.g. after the robot controller has been restarted. This is done
+   * automatically, if the robot time runs backwards.
+   */
+  void reset();
+
+  /*!
+   * \brief Checks whether enough samples have been added to map times, i.e. at least one.
+   */
+  bool isSynchronized() const;
+
+  /*!
+   * \brief Maps a robot time to the host's steady clock.
+   *
+   * \param robot_time The robot's \p timestamp in seconds
+   *
+   * \returns The host time, the epoch if not synchronized yet
+   */
+  std::chrono::steady_clock::time_point toHostTime(const double robot_time) const;
+
+  /*!
+   * \brief Maps a robot time to the host's system clock.
+   *
+   * \param robot_time The robot's \p timestamp in seconds
+   *
+   * \returns The system time, the epoch if not synchronized yet
+   */
+  std::chrono::system_clock::time_point toSystemTime(const double robot_time) const;
+
+  /*!
+   * \brief Maps a time of the host's steady clock to robot time.
+   *
+   * \param host_time The host time
+   *
+   * \returns The robot time in seconds, 0 if not synchronized yet
+   */
+  double toRobotTime(const std::chrono::steady_clock::time_point host_time) const;
+
+  /*!
+   * \brief Maps a time of the host's system clock to robot time.
+   *
+   * \param system_time The system time
+   *
+   * \returns The robot time in seconds, 0 if not synchronized yet
+   */
+  double toRobotTime(const std::chrono::system_clock::time_point system_time) const;
+
+  /*!
+   * \brief Getter for the estimated drift of the host's steady clock against the robot's clock.
+   *
+   * \returns The drift in parts per million, positive if the host clock runs faster
+   */
+  double getDriftPpm() const;
+
+  /*!
+   * \brief Getter for the number of samples added since the last reset.
+   */
+  uint64_t getNumSamples() const;
+
+private:
+  struct Minimum
+  {
+    //! Robot time of the sample with the smallest delay
+    double robot_time;
+    //! Host time minus robot time of that sample, relative to the host reference
+    double offset;
+  };
+
+  //! Fits offset and drift through the minima. Has to be called with mutex_ locked.
+  void fit();
+  //! Host time relative to the host reference in seconds. Has to be called with mutex_ locked.
+  double mapToHost(const double robot_time) const;
+
+  double window_;
+  size_t num_windows_;
+  FieldHandle<double> timestamp_handle_;
+  mutable std::mutex mutex_;
+  std::chrono::steady_clock::time_point host_reference_;
+  double robot_reference_;
+  double last_robot_time_;
+  std::deque<Minimum> minima_;
+  Minimum current_;
+  double current_window_end_;
+  uint64_t num_samples_;
+  // host - reference = intercept_ + (1 + drift_) * (robot - robot_reference_)
+  double intercept_;
+  double drift_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_CLOCK_SYNCHRONIZER_H_INCLUDED
@@ -0,0 +1,256 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_COLUMNAR_EXPORT_H_INCLUDED
+#define UR_CLIENT_LIBRARY_COLUMNAR_EXPORT_H_INCLUDED
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Writes RTDE data in a column-oriented layout, storing all samples of a recipe field in
+ * one contiguous array, e.g. all actual_q samples one after another.
+ *
+ * Samples are collected into chunks of a configurable number of rows. Each chunk contains the
+ * receive times (int64 nanoseconds since the epoch) followed by one array per known field of the
+ * recipe in recipe order. In contrast to the RTDE wire format, all values are stored in host byte
+ * order, so columns can be processed without any conversion. The file starts with a header
+ * containing the recipe. Fields without a known data type are not exported.
+ *
+ * Chunks are written uncompressed, so they can be mapped and scanned directly. Files can be read
+ * back using ColumnarFile.
+ */
+class ColumnarWriter
+{
+public:
+  //! Default number of rows in a chunk
+  static constexpr size_t DEFAULT_CHUNK_ROWS = 64 * 1024;
+
+  ColumnarWriter() = delete;
+
+  /*!
+   * \brief Creates the output file and writes its header.
+   *
+   * \param path Path of the output file. An existing file will be overwritten.
+   * \param recipe Recipe of the exported data
+   * \param chunk_rows Number of rows collected before a chunk is written to the file
+   *
+   * \throws UrException if the file cannot be created or chunk_rows is 0
+   */
+  ColumnarWriter(const std::string& path, std::shared_ptr<const CompiledRecipe> recipe,
+                 const size_t chunk_rows = DEFAULT_CHUNK_ROWS);
+  ColumnarWriter(const ColumnarWriter&) = delete;
+  ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+  ~ColumnarWriter();
+
+  /*!
+   * \brief Appends the data of a data package as a new row.
+   *
+   * \param package The data package to append. It has to be based on the writer's recipe.
+   * \param receive_time Time the package was received
+   *
+   * \returns True on success, false if the package is based on a different recipe
+   */
+  bool append(const DataPackage& package, const std::chrono::system_clock::time_point receive_time);
+
+  /*!
+   * \brief Appends a raw RTDE frame as a new row.
+   *
+   * \param frame Raw frame including the package header, as recorded by RTDERecorder
+   * \param size Size of the frame in bytes
+   * \param protocol_version RTDE protocol version of the frame
+   * \param receive_time Time the frame was received
+   *
+   * \returns True if the frame has been appended, false if it isn't a data package matching the
+   * writer's recipe
+   */
+  bool appendFrame(const uint8_t* frame, const size_t size, const uint16_t protocol_version,
+                   const std::chrono::system_clock::time_point receive_time);
+
+  /*!
+   * \brief Writes all pending rows to the file and closes it.
+   */
+  void close();
+
+  /*!
+   * \brief Getter for the number of rows appended so far.
+   *
+   * \returns The number of rows
+   */
+  size_t getNumRows() const
+  {
+    return num_rows_;
+  }
+
+  //! Identifies columnar RTDE files, stored at the beginning of the file
+  static constexpr char MAGIC[8] = { 'U', 'R', 'C', 'L', 'C', 'O', 'L', 'S' };
+  //! Version of the file format
+  static constexpr uint16_t FORMAT_VERSION = 1;
+
+private:
+  void appendData(const uint8_t* data, const std::chrono::system_clock::time_point receive_time);
+  void writeChunk();
+
+  struct Column
+  {
+    size_t offset;
+    size_t size;
+    size_t element_size;
+    std::vector<uint8_t> values;
+  };
+
+  std::string path_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  size_t chunk_rows_;
+  std::ofstream file_;
+  std::vector<int64_t> receive_times_;
+  std::vector<Column> columns_;
+  std::vector<uint8_t> package_buffer_;
+  size_t num_rows_;
+};
+
+/*!
+ * \brief Reads a file written by ColumnarWriter into memory.
+ */
+class ColumnarFile
+{
+public:
+  ColumnarFile() = delete;
+
+  /*!
+   * \brief Reads a columnar file.
+   *
+   * \param path Path of the file
+   *
+   * \throws UrException if the file cannot be read or isn't a valid columnar RTDE file
+   */
+  explicit ColumnarFile(const std::string& path);
+
+  /*!
+   * \brief Getter for the recipe of the stored data.
+   *
+   * \returns The compiled recipe
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Getter for the number of stored rows.
+   *
+   * \returns The number of rows
+   */
+  size_t getNumRows() const
+  {
+    return receive_times_.size();
+  }
+
+  /*!
+   * \brief Getter for the number of chunks the rows were stored in.
+   *
+   * \returns The number of chunks
+   */
+  size_t getNumChunks() const
+  {
+    return num_chunks_;
+  }
+
+  /*!
+   * \brief Getter for the receive times of all rows.
+   *
+   * \returns The receive times
+   */
+  const std::vector<std::chrono::system_clock::time_point>& getReceiveTimes() const
+  {
+    return receive_times_;
+  }
+
+  /*!
+   * \brief Copies all values of a field into a vector.
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   * \param values Target vector, that will contain one value per row
+   *
+   * \returns True on success, false if the field isn't part of the recipe or the type doesn't match
+   */
+  template <typename T>
+  bool getColumn(const std::string& name, std::vector<T>& values) const
+  {
+    size_t index;
+    if (!recipe_->findIndex(name, index) || !std::holds_alternative<T>(recipe_->getFields()[index].empty_value))
+    {
+      return false;
+    }
+    const std::vector<uint8_t>& column = columns_[index];
+    values.resize(column.size() / sizeof(T));
+    std::memcpy(values.data(), column.data(), values.size() * sizeof(T));
+    return true;
+  }
+
+private:
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::vector<std::chrono::system_clock::time_point> receive_times_;
+  std::vector<std::vector<uint8_t>> columns_;
+  size_t num_chunks_;
+};
+
+/*!
+ * \brief Converts an RTDE recording into a columnar file.
+ *
+ * Only data packages of the recording's output recipe are exported. Other frames, e.g. text
+ * messages or packages of additional output recipes with a different size, are skipped.
+ *
+ * \param recording The recording to convert
+ * \param path Path of the output file
+ * \param chunk_rows Number of rows per chunk
+ *
+ * \throws UrException if the output file cannot be created
+ *
+ * \returns The number of exported rows
+ */
+size_t exportColumnar(RTDERecording& recording, const std::string& path,
+                      const size_t chunk_rows = ColumnarWriter::DEFAULT_CHUNK_ROWS);
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_COLUMNAR_EXPORT_H_INCLUDED
@@ -29,11 +29,17 @@
 #ifndef UR_CLIENT_LIBRARY_DATA_PACKAGE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_DATA_PACKAGE_H_INCLUDED
 
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/memory_resource.h"
 #include "ur_client_library/types.h"
+#include "ur_client_library/rtde/field_types.h"
 #include "ur_client_library/rtde/rtde_package.h"
 
 namespace urcl
@@ -53,6 +59,187 @@ enum class RUNTIME_STATE : uint32_t
   RESUMING = 5
 };
 
+/*!
+ * \brief Variant holding any of the data types that can be transferred over the RTDE interface.
+ */
+using rtde_type_variant = std::variant<bool, uint8_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t,
+                                       vector6int32_t, vector6uint32_t, std::string>;
+
+/*!
+ * \brief Handle to a single data field of a CompiledRecipe.
+ *
+ * A handle is resolved once from the field's name and can then be used to access that field in
+ * every DataPackage created from the same CompiledRecipe without any name lookup.
+ *
+ * @tparam T Type of the data field
+ */
+template <typename T>
+class FieldHandle
+{
+public:
+  /*!
+   * \brief Creates an invalid handle, that doesn't point to any data field.
+   */
+  FieldHandle() : index_(INVALID_INDEX)
+  {
+  }
+
+  /*!
+   * \brief Checks whether the handle points to a data field.
+   */
+  bool isValid() const
+  {
+    return index_ != INVALID_INDEX;
+  }
+
+  /*!
+   * \brief Getter for the position of the data field inside the recipe.
+   */
+  size_t getIndex() const
+  {
+    return index_;
+  }
+
+private:
+  friend class CompiledRecipe;
+  explicit FieldHandle(const size_t index) : index_(index)
+  {
+  }
+
+  static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+  size_t index_;
+};
+
+/*!
+ * \brief A recipe, that has been resolved into a fixed layout.
+ *
+ * Every field of the recipe is assigned its position inside the recipe, its data type and its
+ * offset and size inside the serialized data package. This is done once when the recipe is
+ * compiled, so DataPackage objects sharing a CompiledRecipe don't have to look up anything per
+ * package.
+ */
+class CompiledRecipe
+{
+public:
+  /*!
+   * \brief Information about one data field of the recipe
+   */
+  struct Field
+  {
+    std::string name;
+    //! Default value of the field, defining its type. Only meaningful if the field is known.
+    rtde_type_variant empty_value;
+    //! Whether the field's name is a known RTDE data field
+    bool known;
+    //! Byte offset of the field inside the serialized data, not counting header and recipe id
+    size_t offset;
+    //! Number of bytes of the field's serialization
+    size_t size;
+  };
+
+  CompiledRecipe() = delete;
+  /*!
+   * \brief Compiles a recipe given as a list of field names.
+   *
+   * \param recipe The recipe to compile
+   */
+  explicit CompiledRecipe(const std::vector<std::string>& recipe);
+
+  /*!
+   * \brief Gets a compiled recipe shared by everyone using an equal recipe. The recipe is only
+   * compiled if nobody holds a compiled version of it anymore, so creating many packages from the
+   * same list of names compiles it once.
+   *
+   * \param recipe The recipe to compile
+   *
+   * \returns The shared compiled recipe
+   */
+  static std::shared_ptr<const CompiledRecipe> intern(const std::vector<std::string>& recipe);
+
+  /*!
+   * \brief Getter for the recipe as list of field names.
+   */
+  const std::vector<std::string>& getRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Getter for the layout of all fields in recipe order.
+   */
+  const std::vector<Field>& getFields() const
+  {
+    return fields_;
+  }
+
+  /*!
+   * \brief Checks whether all fields of the recipe are known RTDE data fields.
+   */
+  bool isComplete() const
+  {
+    return complete_;
+  }
+
+  /*!
+   * \brief Getter for the number of bytes needed to serialize all known fields of the recipe.
+   */
+  size_t getDataSize() const
+  {
+    return data_size_;
+  }
+
+  /*!
+   * \brief Looks up the position of a known data field inside the recipe.
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   * \param index Target variable for the position
+   *
+   * \returns True on success, false if the field isn't a known field of this recipe.
+   */
+  bool findIndex(const std::string& name, size_t& index) const
+  {
+    auto it = indices_.find(name);
+    if (it == indices_.end())
+    {
+      return false;
+    }
+    index = it->second;
+    return true;
+  }
+
+  /*!
+   * \brief Resolves a data field to a handle, that can be used for fast access to the field.
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   *
+   * \throws UrException if the field isn't part of the recipe or the requested type doesn't match
+   * the field's type.
+   *
+   * \returns A handle to the data field
+   */
+  template <typename T>
+  FieldHandle<T> getFieldHandle(const std::string& name) const
+  {
+    size_t index;
+    if (!findIndex(name, index))
+    {
+      throw UrException("The data field '" + name + "' is not part of the recipe.");
+    }
+    if (!std::holds_alternative<T>(fields_[index].empty_value))
+    {
+      throw UrException("The requested type doesn't match the type of data field '" + name + "'.");
+    }
+    return FieldHandle<T>(index);
+  }
+
+private:
+  std::vector<std::string> recipe_;
+  std::vector<Field> fields_;
+  std::unordered_map<std::string, size_t> indices_;
+  bool complete_;
+  size_t data_size_;
+};
+
 /*!
  * \brief The DataPackage class handles communication in the form of RTDE data packages both to and
  * from the robot. It contains functionality to parse and serialize packages for arbitrary recipes.
@@ -60,26 +247,104 @@ enum class RUNTIME_STATE : uint32_t
 class DataPackage : public RTDEPackage
 {
 public:
-  using _rtde_type_variant = std::variant<bool, uint8_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t,
-                                          vector6int32_t, vector6uint32_t, std::string>;
+  using _rtde_type_variant = rtde_type_variant;
 
   DataPackage() = delete;
 
-  DataPackage(const DataPackage& other) : DataPackage(other.recipe_)
+  /*!
+   * \brief Copies a package. The recipe is shared with the other package, only the field values
+   * are copied.
+   */
+  DataPackage(const DataPackage& other)
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE)
+    , recipe_id_(other.recipe_id_)
+    , data_(other.data_, getMemoryResource())
+    , raw_data_(other.raw_data_, getMemoryResource())
+    , recipe_(other.recipe_)
+    , protocol_version_(other.protocol_version_)
+    , lazy_decoding_(other.lazy_decoding_)
+  {
+  }
+
+  /*!
+   * \brief Moves a package, taking over its field values without copying them.
+   */
+  DataPackage(DataPackage&& other) noexcept
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE)
+    , recipe_id_(other.recipe_id_)
+    , data_(std::move(other.data_))
+    , raw_data_(std::move(other.raw_data_))
+    , recipe_(std::move(other.recipe_))
+    , protocol_version_(other.protocol_version_)
+    , lazy_decoding_(other.lazy_decoding_)
+  {
+  }
+
+  /*!
+   * \brief Copies the field values of another package into this one. If this package already
+   * holds values of the same recipe, their storage is reused, so copying doesn't allocate memory,
+   * e.g. when keeping the latest package in a preallocated package.
+   */
+  DataPackage& operator=(const DataPackage& other)
+  {
+    if (this != &other)
+    {
+      recipe_id_ = other.recipe_id_;
+      data_ = other.data_;
+      raw_data_ = other.raw_data_;
+      recipe_ = other.recipe_;
+      protocol_version_ = other.protocol_version_;
+      lazy_decoding_ = other.lazy_decoding_;
+    }
+    return *this;
+  }
+
+  /*!
+   * \brief Moves the field values of another package into this one.
+   */
+  DataPackage& operator=(DataPackage&& other) noexcept
   {
-    this->data_ = other.data_;
-    this->protocol_version_ = other.protocol_version_;
+    recipe_id_ = other.recipe_id_;
+    data_ = std::move(other.data_);
+    raw_data_ = std::move(other.raw_data_);
+    recipe_ = std::move(other.recipe_);
+    protocol_version_ = other.protocol_version_;
+    lazy_decoding_ = other.lazy_decoding_;
+    return *this;
   }
 
   /*!
-   * \brief Creates a new DataPackage object, based on a given recipe.
+   * \brief Creates a new DataPackage object, based on a given recipe. Packages created from equal
+   * recipes share one CompiledRecipe, see CompiledRecipe::intern().
    *
    * \param recipe The used recipe
    *
    * \param protocol_version Protocol version used for the RTDE communication
    */
   DataPackage(const std::vector<std::string>& recipe, const uint16_t& protocol_version = 2)
-    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE), recipe_(recipe), protocol_version_(protocol_version)
+    : DataPackage(CompiledRecipe::intern(recipe), protocol_version)
+  {
+  }
+
+  /*!
+   * \brief Creates a new DataPackage object, based on an already compiled recipe.
+   *
+   * \param recipe The used recipe. It can be shared between many packages.
+   *
+   * \param protocol_version Protocol version used for the RTDE communication
+   *
+   * \param lazy_decoding If true, the package keeps the serialized data fields and only decodes a
+   * field when it is accessed. Otherwise all fields are decoded while parsing the package.
+   */
+  DataPackage(std::shared_ptr<const CompiledRecipe> recipe, const uint16_t& protocol_version = 2,
+              const bool lazy_decoding = false)
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE)
+    , recipe_id_(0)
+    , data_(getMemoryResource())
+    , raw_data_(getMemoryResource())
+    , recipe_(recipe)
+    , protocol_version_(protocol_version)
+    , lazy_decoding_(lazy_decoding)
   {
   }
   virtual ~DataPackage() = default;
@@ -95,9 +360,21 @@ public:
    *
    * \param bp A parser containing a serialized version of the package
    *
-   * \returns True, if the package was parsed successfully, false otherwise
+   * \returns True, if the package was parsed successfully, false otherwise, e.g. if \p bp has been
+   * truncated in comm::BinParser::ErrorMode::STATUS
    */
   virtual bool parseWith(comm::BinParser& bp);
+
+  /*!
+   * \brief Parses only the data fields of the package from their compact binary form as created
+   * by serializeData(). The recipe id is left untouched.
+   *
+   * \param bp A parser containing the serialized data fields
+   *
+   * \returns True, if the data was parsed successfully, false otherwise
+   */
+  bool parseData(comm::BinParser& bp);
+
   /*!
    * \brief Produces a human readable representation of the package object.
    *
@@ -114,6 +391,17 @@ public:
    */
   size_t serializePackage(uint8_t* buffer);
 
+  /*!
+   * \brief Serializes only the data fields of the package in recipe order, without header and
+   * recipe id. This is the compact binary form of the package's data.
+   *
+   * \param buffer Buffer to fill with the serialization, it has to hold at least
+   * CompiledRecipe::getDataSize() bytes
+   *
+   * \returns The size of the serialized data, 0 if the package hasn't been initialized
+   */
+  size_t serializeData(uint8_t* buffer) const;
+
   /*!
    * \brief Get a data field from the DataPackage.
    *
@@ -127,15 +415,12 @@ public:
   template <typename T>
   bool getData(const std::string& name, T& val)
   {
-    if (data_.find(name) != data_.end())
-    {
-      val = std::get<T>(data_[name]);
-    }
-    else
+    size_t index;
+    if (!recipe_->findIndex(name, index))
     {
       return false;
     }
-    return true;
+    return getValue(index, val);
   }
 
   /*!
@@ -153,17 +438,32 @@ public:
   {
     static_assert(sizeof(T) * 8 >= N, "Bitset is too large for underlying variable");
 
-    if (data_.find(name) != data_.end())
-    {
-      val = std::bitset<N>(std::get<T>(data_[name]));
-    }
-    else
+    size_t index;
+    T raw_value;
+    if (!recipe_->findIndex(name, index) || !getValue(index, raw_value))
     {
       return false;
     }
+    val = std::bitset<N>(raw_value);
     return true;
   }
 
+  /*!
+   * \brief Get a data field from the DataPackage using a handle.
+   *
+   * The handle has to be created from the CompiledRecipe this package was created with.
+   *
+   * \param handle Handle to the data field
+   * \param val Target variable
+   *
+   * \returns True on success, false if the package doesn't contain any data for the handle.
+   */
+  template <typename T>
+  bool getData(const FieldHandle<T>& handle, T& val) const
+  {
+    return getValue(handle.getIndex(), val);
+  }
+
   /*!
    * \brief Set a data field in the DataPackage.
    *
@@ -177,15 +477,28 @@ public:
   template <typename T>
   bool setData(const std::string& name, T& val)
   {
-    if (data_.find(name) != data_.end())
-    {
-      data_[name] = val;
-    }
-    else
+    size_t index;
+    if (!recipe_->findIndex(name, index))
     {
       return false;
     }
-    return true;
+    return setValue(index, val);
+  }
+
+  /*!
+   * \brief Set a data field in the DataPackage using a handle.
+   *
+   * The handle has to be created from the CompiledRecipe this package was created with.
+   *
+   * \param handle Handle to the data field
+   * \param val Value to set
+   *
+   * \returns True on success, false if the package doesn't contain any data for the handle.
+   */
+  template <typename T>
+  bool setData(const FieldHandle<T>& handle, const T& val)
+  {
+    return setValue(handle.getIndex(), val);
   }
 
   /*!
@@ -198,13 +511,104 @@ public:
     recipe_id_ = recipe_id;
   }
 
+  /*!
+   * \brief Getter of the recipe id value used to identify the used recipe.
+   */
+  uint8_t getRecipeID() const
+  {
+    return recipe_id_;
+  }
+
+  /*!
+   * \brief Getter for the compiled recipe this package is based on.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Checks whether the package decodes its fields on access instead of while parsing.
+   */
+  bool isLazyDecoding() const
+  {
+    return lazy_decoding_;
+  }
+
 private:
-  // Const would be better here
-  static std::unordered_map<std::string, _rtde_type_variant> g_type_list;
+  friend class CompiledRecipe;
+
+  template <typename T>
+  bool getValue(const size_t index, T& val) const
+  {
+    if (lazy_decoding_)
+    {
+      if (index >= recipe_->getFields().size() || raw_data_.size() != recipe_->getDataSize())
+      {
+        return false;
+      }
+      const CompiledRecipe::Field& field = recipe_->getFields()[index];
+      if (!field.known)
+      {
+        return false;
+      }
+      if (!std::holds_alternative<T>(field.empty_value))
+      {
+        throw std::bad_variant_access();
+      }
+      // The BinParser only reads from the buffer
+      comm::BinParser bp(const_cast<uint8_t*>(raw_data_.data()) + field.offset, field.size);
+      bp.parse(val);
+      return true;
+    }
+
+    if (index >= data_.size())
+    {
+      return false;
+    }
+    val = std::get<T>(data_[index]);
+    return true;
+  }
+
+  template <typename T>
+  bool setValue(const size_t index, const T& val)
+  {
+    if (lazy_decoding_)
+    {
+      if (index >= recipe_->getFields().size() || raw_data_.size() != recipe_->getDataSize())
+      {
+        return false;
+      }
+      const CompiledRecipe::Field& field = recipe_->getFields()[index];
+      if (!field.known)
+      {
+        return false;
+      }
+      if (!std::holds_alternative<T>(field.empty_value))
+      {
+        throw std::bad_variant_access();
+      }
+      comm::PackageSerializer::serialize(raw_data_.data() + field.offset, val);
+      return true;
+    }
+
+    if (index >= data_.size())
+    {
+      return false;
+    }
+    data_[index] = val;
+    return true;
+  }
+
   uint8_t recipe_id_;
-  std::unordered_map<std::string, _rtde_type_variant> data_;
-  std::vector<std::string> recipe_;
+  // Field values in recipe order. Unknown fields keep a placeholder value and are never accessed.
+  // Both are allocated from the memory resource set when the package was created.
+  std::pmr::vector<_rtde_type_variant> data_;
+  // Serialized field values in recipe order, only used with lazy decoding.
+  std::pmr::vector<uint8_t> raw_data_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
   uint16_t protocol_version_;
+  bool lazy_decoding_;
 };
 
 }  // namespace rtde_interface
@@ -0,0 +1,169 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_DATA_PACKAGE_HISTORY_H_INCLUDED
+#define UR_CLIENT_LIBRARY_DATA_PACKAGE_HISTORY_H_INCLUDED
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Fixed-capacity ring buffer retaining the most recent data packages in their compact
+ * binary form together with the time they were received.
+ *
+ * Samples can be looked up by the robot's timestamp, e.g. to correlate external measurements with
+ * the robot state at the time they were taken. The recipe has to contain the timestamp field and
+ * timestamps are expected to increase monotonically.
+ */
+class DataPackageHistory
+{
+public:
+  //! Clock used for receive times
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * \brief Meta data of a stored sample.
+   */
+  struct Sample
+  {
+    //! The robot's timestamp of the sample
+    double timestamp;
+    //! Time the sample was added to the history
+    Clock::time_point receive_time;
+  };
+
+  DataPackageHistory() = delete;
+
+  /*!
+   * \brief Creates a new DataPackageHistory object. All memory is allocated upfront.
+   *
+   * \param recipe The recipe of the stored data packages
+   * \param capacity Maximum number of stored data packages
+   *
+   * \throws UrException if the recipe doesn't contain the timestamp field or the capacity is 0
+   */
+  DataPackageHistory(std::shared_ptr<const CompiledRecipe> recipe, const size_t capacity);
+  virtual ~DataPackageHistory() = default;
+
+  /*!
+   * \brief Adds a data package to the history, overwriting the oldest one if the history is full.
+   *
+   * \param package The package to add, it has to be based on the history's recipe
+   * \param receive_time Time the package has been received
+   *
+   * \returns False, if the package is based on a different recipe, true otherwise
+   */
+  bool push(const DataPackage& package, const Clock::time_point receive_time = Clock::now());
+
+  /*!
+   * \brief Fills a data package with the stored sample whose timestamp is closest to the given one.
+   *
+   * \param timestamp The robot timestamp to look up
+   * \param package The package to fill, it has to be based on the history's recipe
+   * \param sample If not nullptr, filled with the meta data of the found sample
+   *
+   * \returns False, if the history is empty or the package is based on a different recipe, true
+   * otherwise
+   */
+  bool getNearest(const double timestamp, DataPackage& package, Sample* sample = nullptr) const;
+
+  /*!
+   * \brief Gets all stored samples with a timestamp within the given window, oldest first.
+   *
+   * \param start_timestamp Robot timestamp of the window's start
+   * \param end_timestamp Robot timestamp of the window's end
+   * \param packages Vector the samples are appended to as data packages
+   * \param samples If not nullptr, the samples' meta data is appended to this vector
+   *
+   * \returns The number of samples found
+   */
+  size_t getWindow(const double start_timestamp, const double end_timestamp, std::vector<DataPackage>& packages,
+                   std::vector<Sample>* samples = nullptr) const;
+
+  /*!
+   * \brief Getter for the number of currently stored samples.
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Getter for the maximum number of stored samples.
+   */
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /*!
+   * \brief Removes all stored samples.
+   */
+  void clear();
+
+  /*!
+   * \brief Getter for the recipe of the stored data packages.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+private:
+  // Position of the i-th oldest sample inside the ring buffer
+  size_t slotIndex(const size_t i) const
+  {
+    return (head_ + capacity_ - size_ + i) % capacity_;
+  }
+  // Index of the oldest sample with a timestamp not smaller than the given one
+  size_t lowerBound(const double timestamp) const;
+  void fill(const size_t slot, DataPackage& package) const;
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  FieldHandle<double> timestamp_handle_;
+  size_t capacity_;
+  size_t data_size_;
+  std::vector<uint8_t> data_;
+  std::vector<uint8_t> recipe_ids_;
+  std::vector<Sample> samples_;
+  size_t head_;
+  size_t size_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_DATA_PACKAGE_HISTORY_H_INCLUDED
@@ -0,0 +1,163 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_DATA_PACKAGE_POOL_H_INCLUDED
+#define UR_CLIENT_LIBRARY_DATA_PACKAGE_POOL_H_INCLUDED
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+class DataPackagePool;
+
+/*!
+ * \brief Deleter returning a DataPackage to the DataPackagePool it was taken from.
+ *
+ * If the pool doesn't exist anymore, the package is deleted.
+ */
+struct DataPackageDeleter
+{
+  std::weak_ptr<DataPackagePool> pool;
+
+  void operator()(DataPackage* package) const;
+};
+
+/*!
+ * \brief A DataPackage that is returned to its pool once it is released.
+ */
+using PooledDataPackage = std::unique_ptr<DataPackage, DataPackageDeleter>;
+
+/*!
+ * \brief A fixed size pool of pre-initialized DataPackage objects for one recipe.
+ *
+ * Packages taken from the pool are regular heap objects, so they can be passed around as
+ * std::unique_ptr with the default deleter as well. Packages that are returned to the pool are
+ * reused by later acquire() calls, so receiving data doesn't require any memory allocation as long
+ * as all packages are returned. If the pool is exhausted, new packages are allocated.
+ *
+ * The pool has to be managed by a std::shared_ptr, see create().
+ */
+class DataPackagePool : public std::enable_shared_from_this<DataPackagePool>
+{
+public:
+  DataPackagePool() = delete;
+  ~DataPackagePool();
+
+  /*!
+   * \brief Creates a new pool filled with \p pool_size initialized packages.
+   *
+   * \param recipe The compiled recipe used for all packages of this pool
+   * \param protocol_version Protocol version used for the RTDE communication
+   * \param pool_size Number of packages kept inside the pool
+   * \param lazy_decoding Whether the packages decode their fields on access, see DataPackage
+   *
+   * \returns The newly created pool
+   */
+  static std::shared_ptr<DataPackagePool> create(std::shared_ptr<const CompiledRecipe> recipe,
+                                                 const uint16_t protocol_version, const size_t pool_size,
+                                                 const bool lazy_decoding = false);
+
+  /*!
+   * \brief Takes a package from the pool. If the pool is empty, a new package is allocated.
+   *
+   * \returns A package initialized for the pool's recipe
+   */
+  std::unique_ptr<DataPackage> acquire();
+
+  /*!
+   * \brief Returns a package to the pool. Packages not belonging to the pool's recipe or exceeding
+   * the pool's size are deleted.
+   *
+   * \param package The package to return
+   */
+  void release(std::unique_ptr<DataPackage> package);
+
+  /*!
+   * \brief Wraps a package, so it will be returned to this pool once it is released.
+   *
+   * \param package The package to wrap
+   *
+   * \returns The wrapped package
+   */
+  PooledDataPackage makePooled(std::unique_ptr<DataPackage> package);
+
+  /*!
+   * \brief Getter for the compiled recipe all packages of this pool are based on.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Checks whether the packages of this pool decode their fields on access.
+   */
+  bool isLazyDecoding() const
+  {
+    return lazy_decoding_;
+  }
+
+  /*!
+   * \brief Getter for the number of packages currently available inside the pool.
+   */
+  size_t available();
+
+  /*!
+   * \brief Getter for the number of packages that had to be allocated because the pool was empty.
+   */
+  size_t getNumAllocations() const
+  {
+    return num_allocations_;
+  }
+
+private:
+  DataPackagePool(std::shared_ptr<const CompiledRecipe> recipe, const uint16_t protocol_version,
+                  const size_t pool_size, const bool lazy_decoding);
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  uint16_t protocol_version_;
+  bool lazy_decoding_;
+  size_t pool_size_;
+  std::vector<DataPackage*> packages_;
+  std::mutex packages_mutex_;
+  std::atomic<size_t> num_allocations_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_DATA_PACKAGE_POOL_H_INCLUDED
@@ -0,0 +1,243 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_DERIVED_SIGNALS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_DERIVED_SIGNALS_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Registry of signals derived from the RTDE data packages, e.g. the TCP's linear speed.
+ *
+ * Every signal is computed once per data package and shared by all readers, so consumers don't
+ * have to recompute the same quantities. For each package, the inputs of all signals are gathered
+ * into one contiguous buffer in a single pass over the package. The signals are then evaluated on
+ * that buffer, updating their state incrementally, e.g. the running sum of a sliding window.
+ *
+ * Signals have to be registered before the first package is fed using update(). The registry
+ * binds itself to the recipe of the packages it is fed with and resets the signals' state when the
+ * recipe changes. Readers may access the values from any thread.
+ */
+class DerivedSignals
+{
+public:
+  /*!
+   * \brief Function evaluating a signal.
+   *
+   * The first argument points to the signal's inputs in the order they were registered, vector
+   * fields contributing all of their elements. The second argument points to the signal's state,
+   * which is zero-initialized whenever the registry binds to a recipe. The last argument points
+   * to the signal's values, that have to be written.
+   */
+  using Kernel = std::function<void(const double* inputs, double* state, double* values)>;
+
+  DerivedSignals() = default;
+  virtual ~DerivedSignals() = default;
+
+  /*!
+   * \brief Registers a signal with a custom kernel.
+   *
+   * \param name Unique name of the signal
+   * \param inputs Names of the data fields the signal is computed from. Only fields of type double,
+   * vector3d_t and vector6d_t are supported.
+   * \param width Number of values of the signal
+   * \param state_size Number of doubles of state the kernel keeps between packages
+   * \param kernel Function computing the signal's values
+   *
+   * \throws UrException if a signal with the same name exists or an input isn't a known floating
+   * point data field
+   *
+   * \returns The index of the signal, used to read its values
+   */
+  size_t addSignal(const std::string& name, const std::vector<std::string>& inputs, const size_t width,
+                   const size_t state_size, Kernel kernel);
+
+  /*!
+   * \brief Registers the linear speed of the TCP in m/s, computed from \p actual_TCP_speed.
+   *
+   * \param name Unique name of the signal
+   *
+   * \returns The index of the signal
+   */
+  size_t addTcpLinearSpeed(const std::string& name = "tcp_linear_speed");
+
+  /*!
+   * \brief Registers the mechanical power of each joint in W, computed from \p actual_current and
+   * \p actual_qd as torque constant times current times joint velocity.
+   *
+   * \param torque_constants Torque constant of each joint in Nm/A. With the default of 1, the
+   * signal is the product of current and velocity.
+   * \param name Unique name of the signal
+   *
+   * \returns The index of the signal, which has 6 values
+   */
+  size_t addJointMechanicalPower(const vector6d_t& torque_constants = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 },
+                                 const std::string& name = "joint_mechanical_power");
+
+  /*!
+   * \brief Registers the root mean square of a data field over a sliding window of packages,
+   * computed element-wise.
+   *
+   * \param field Name of the data field, e.g. \p actual_TCP_force
+   * \param window_size Number of packages in the window
+   * \param name Unique name of the signal, defaults to the field's name followed by "_rms"
+   *
+   * \throws UrException if the window is empty
+   *
+   * \returns The index of the signal, which has as many values as the field has elements
+   */
+  size_t addSlidingRms(const std::string& field, const size_t window_size, const std::string& name = "");
+
+  /*!
+   * \brief Computes all signals from a received data package.
+   *
+   * \param package The received data package
+   */
+  void update(const DataPackage& package);
+
+  /*!
+   * \brief Looks up a signal by its name.
+   *
+   * \param name The name the signal has been registered with
+   * \param index Target variable for the signal's index
+   *
+   * \returns True if the signal exists, false otherwise
+   */
+  bool findSignal(const std::string& name, size_t& index) const;
+
+  /*!
+   * \brief Getter for the number of values of a signal.
+   */
+  size_t getWidth(const size_t index) const
+  {
+    return signals_.at(index).width;
+  }
+
+  /*!
+   * \brief Getter for the names of all data fields the signals are computed from. These should be
+   * declared using RTDEClient::requireOutputFields().
+   */
+  std::vector<std::string> getRequiredFields() const;
+
+  /*!
+   * \brief Reads the current values of a signal.
+   *
+   * \param index The signal's index
+   * \param values Target buffer, it has to hold getWidth() values
+   *
+   * \returns True if the signal has been computed from at least one package, false otherwise
+   */
+  bool getValues(const size_t index, double* values) const;
+
+  /*!
+   * \brief Reads the current value of a signal with a single value.
+   *
+   * \param index The signal's index
+   * \param value Target variable
+   *
+   * \returns True if the signal has been computed from at least one package, false otherwise
+   */
+  bool getValue(const size_t index, double& value) const
+  {
+    return getWidth(index) == 1 && getValues(index, &value);
+  }
+
+  /*!
+   * \brief Reads the current values of a signal with N values.
+   *
+   * \param index The signal's index
+   * \param values Target variable
+   *
+   * \returns True if the signal has been computed from at least one package, false otherwise
+   */
+  template <size_t N>
+  bool getValue(const size_t index, std::array<double, N>& values) const
+  {
+    return getWidth(index) == N && getValues(index, values.data());
+  }
+
+  /*!
+   * \brief Getter for the number of packages the signals have been computed from since binding
+   * to the current recipe.
+   */
+  uint64_t getNumUpdates() const;
+
+private:
+  struct Input
+  {
+    size_t width;
+    FieldHandle<double> double_handle;
+    FieldHandle<vector3d_t> vector3d_handle;
+    FieldHandle<vector6d_t> vector6d_handle;
+  };
+
+  struct Signal
+  {
+    std::string name;
+    std::vector<std::string> inputs;
+    size_t width;
+    size_t state_size;
+    Kernel kernel;
+    size_t input_offset;
+    size_t state_offset;
+    size_t value_offset;
+  };
+
+  void bind(const std::shared_ptr<const CompiledRecipe>& recipe);
+
+  std::vector<Signal> signals_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
+
+  // Inputs of all signals in registration order, gathered from each package
+  std::vector<Input> inputs_;
+  std::vector<double> input_buffer_;
+  std::vector<double> state_;
+  std::vector<double> values_;
+
+  mutable std::mutex mutex_;
+  std::vector<double> published_values_;
+  uint64_t num_updates_ = 0;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_DERIVED_SIGNALS_H_INCLUDED
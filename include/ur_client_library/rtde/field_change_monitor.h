@@ -0,0 +1,120 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_FIELD_CHANGE_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_FIELD_CHANGE_MONITOR_H_INCLUDED
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Detects changes of individual data fields between consecutive data packages and notifies
+ * the subscribers of the changed fields.
+ *
+ * Subscriptions are made by field name and have to be bound to a recipe using setRecipe() before
+ * packages can be checked for changes. For every subscribed field, only the field itself is
+ * compared to its previous value.
+ */
+class FieldChangeMonitor
+{
+public:
+  FieldChangeMonitor() = default;
+  virtual ~FieldChangeMonitor() = default;
+
+  /*!
+   * \brief Subscribes to changes of a data field. The callback is also called for the first
+   * package checked after binding the monitor to a recipe.
+   *
+   * \param name The string identifier for the data field as used in the documentation
+   * \param callback Function to call with the field's new value whenever it has changed
+   */
+  template <typename T>
+  void subscribe(const std::string& name, std::function<void(const T&)> callback)
+  {
+    subscriptions_.push_back([name, callback](const CompiledRecipe& recipe) -> ChangeCheck {
+      FieldHandle<T> handle = recipe.getFieldHandle<T>(name);
+      bool has_value = false;
+      T last_value = T();
+      return [handle, callback, has_value, last_value](const DataPackage& package) mutable {
+        T value;
+        if (package.getData(handle, value) && (!has_value || !(value == last_value)))
+        {
+          has_value = true;
+          last_value = value;
+          callback(value);
+        }
+      };
+    });
+  }
+
+  /*!
+   * \brief Binds all subscriptions to a recipe. Previously seen values are reset.
+   *
+   * \param recipe The recipe of the data packages that will be checked
+   *
+   * \throws UrException if a subscribed field isn't part of the recipe or has a different type
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Checks a data package for changed fields and calls the respective callbacks.
+   *
+   * \param package The data package to check, it has to be based on the recipe passed to
+   * setRecipe()
+   */
+  void update(const DataPackage& package);
+
+  /*!
+   * \brief Checks whether there are any subscriptions.
+   */
+  bool empty() const
+  {
+    return subscriptions_.empty();
+  }
+
+private:
+  using ChangeCheck = std::function<void(const DataPackage&)>;
+
+  // Each subscription creates the change check for a given recipe
+  std::vector<std::function<ChangeCheck(const CompiledRecipe&)>> subscriptions_;
+  std::vector<ChangeCheck> checks_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_FIELD_CHANGE_MONITOR_H_INCLUDED
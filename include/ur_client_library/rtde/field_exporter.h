@@ -0,0 +1,141 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_FIELD_EXPORTER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_FIELD_EXPORTER_H_INCLUDED
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Copies a precompiled list of data fields from data packages into a contiguous buffer.
+ *
+ * The fields are resolved once, when the exporter is created. Every export then copies the values
+ * of all fields one after another into a buffer provided by the caller, e.g. \p actual_q,
+ * \p actual_qd and \p actual_current into an array of 18 doubles, which can be mapped by linear
+ * algebra libraries without any further copies. Integer and boolean fields are converted to the
+ * buffer's value type. Exporting doesn't allocate memory, so it can be used on real-time threads.
+ */
+class FieldExporter
+{
+public:
+  FieldExporter() = delete;
+
+  /*!
+   * \brief Resolves the exported fields.
+   *
+   * \param recipe Recipe of the exported data packages
+   * \param fields Names of the exported fields in the order they are stored in the buffer
+   *
+   * \throws UrException if a field isn't part of the recipe or isn't numeric
+   */
+  FieldExporter(std::shared_ptr<const CompiledRecipe> recipe, const std::vector<std::string>& fields);
+
+  /*!
+   * \brief Copies the fields of a data package into a buffer.
+   *
+   * \param package The data package, it has to be based on the exporter's recipe
+   * \param buffer Target buffer, it has to hold at least getNumValues() values
+   *
+   * \returns False, if the package is based on a different recipe, true otherwise
+   */
+  bool exportTo(const DataPackage& package, double* buffer) const;
+
+  /*!
+   * \brief Copies the fields of a data package into a buffer of single precision values, e.g. for
+   * the input of a neural network.
+   *
+   * \param package The data package, it has to be based on the exporter's recipe
+   * \param buffer Target buffer, it has to hold at least getNumValues() values
+   *
+   * \returns False, if the package is based on a different recipe, true otherwise
+   */
+  bool exportTo(const DataPackage& package, float* buffer) const;
+
+  /*!
+   * \brief Getter for the number of values written by an export, i.e. the minimum size of the
+   * buffer.
+   */
+  size_t getNumValues() const
+  {
+    return num_values_;
+  }
+
+  /*!
+   * \brief Getter for the position of a field's first value in the buffer.
+   *
+   * \param field Name of an exported field
+   *
+   * \throws UrException if the field isn't exported
+   *
+   * \returns The position of the first value
+   */
+  size_t getOffset(const std::string& field) const;
+
+  /*!
+   * \brief Getter for the names of the exported fields.
+   */
+  const std::vector<std::string>& getFields() const
+  {
+    return fields_;
+  }
+
+private:
+  using Handle = std::variant<FieldHandle<bool>, FieldHandle<uint8_t>, FieldHandle<uint32_t>, FieldHandle<uint64_t>,
+                              FieldHandle<int32_t>, FieldHandle<double>, FieldHandle<vector3d_t>,
+                              FieldHandle<vector6d_t>, FieldHandle<vector6int32_t>, FieldHandle<vector6uint32_t>>;
+
+  struct Entry
+  {
+    Handle handle;
+    size_t offset;
+  };
+
+  template <typename T>
+  bool exportValues(const DataPackage& package, T* buffer) const;
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::vector<std::string> fields_;
+  std::vector<Entry> entries_;
+  size_t num_values_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_FIELD_EXPORTER_H_INCLUDED
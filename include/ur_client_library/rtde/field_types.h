@@ -0,0 +1,695 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_FIELD_TYPES_H_INCLUDED
+#define UR_CLIENT_LIBRARY_FIELD_TYPES_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Data type of an RTDE data field
+ */
+enum class FieldType : uint8_t
+{
+  BOOL,
+  UINT8,
+  UINT32,
+  UINT64,
+  INT32,
+  DOUBLE,
+  VECTOR3D,
+  VECTOR6D,
+  VECTOR6INT32,
+  VECTOR6UINT32
+};
+
+/*!
+ * \brief Name and data type of a known RTDE data field
+ */
+struct FieldTypeEntry
+{
+  std::string_view name;
+  FieldType type;
+};
+
+//! All known RTDE data fields
+inline constexpr std::array FIELD_TYPES = {
+  FieldTypeEntry{ "timestamp", FieldType::DOUBLE },
+  FieldTypeEntry{ "target_q", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_qd", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_qdd", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_current", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_moment", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_q", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_qd", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_current", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_current_window", FieldType::VECTOR6D },
+  FieldTypeEntry{ "joint_control_output", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_TCP_pose", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_TCP_speed", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_TCP_force", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_TCP_pose", FieldType::VECTOR6D },
+  FieldTypeEntry{ "target_TCP_speed", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_digital_input_bits", FieldType::UINT64 },
+  FieldTypeEntry{ "joint_temperatures", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_execution_time", FieldType::DOUBLE },
+  FieldTypeEntry{ "robot_mode", FieldType::INT32 },
+  FieldTypeEntry{ "joint_mode", FieldType::VECTOR6INT32 },
+  FieldTypeEntry{ "safety_mode", FieldType::INT32 },
+  FieldTypeEntry{ "safety_status", FieldType::INT32 },
+  FieldTypeEntry{ "actual_tool_accelerometer", FieldType::VECTOR3D },
+  FieldTypeEntry{ "speed_scaling", FieldType::DOUBLE },
+  FieldTypeEntry{ "target_speed_fraction", FieldType::DOUBLE },
+  FieldTypeEntry{ "actual_momentum", FieldType::DOUBLE },
+  FieldTypeEntry{ "actual_main_voltage", FieldType::DOUBLE },
+  FieldTypeEntry{ "actual_robot_voltage", FieldType::DOUBLE },
+  FieldTypeEntry{ "actual_robot_current", FieldType::DOUBLE },
+  FieldTypeEntry{ "actual_joint_voltage", FieldType::VECTOR6D },
+  FieldTypeEntry{ "actual_digital_output_bits", FieldType::UINT64 },
+  FieldTypeEntry{ "runtime_state", FieldType::UINT32 },
+  FieldTypeEntry{ "elbow_position", FieldType::VECTOR3D },
+  FieldTypeEntry{ "elbow_velocity", FieldType::VECTOR3D },
+  FieldTypeEntry{ "robot_status_bits", FieldType::UINT32 },
+  FieldTypeEntry{ "safety_status_bits", FieldType::UINT32 },
+  FieldTypeEntry{ "analog_io_types", FieldType::UINT32 },
+  FieldTypeEntry{ "standard_analog_input0", FieldType::DOUBLE },
+  FieldTypeEntry{ "standard_analog_input1", FieldType::DOUBLE },
+  FieldTypeEntry{ "standard_analog_output0", FieldType::DOUBLE },
+  FieldTypeEntry{ "standard_analog_output1", FieldType::DOUBLE },
+  FieldTypeEntry{ "io_current", FieldType::DOUBLE },
+  FieldTypeEntry{ "euromap67_input_bits", FieldType::UINT32 },
+  FieldTypeEntry{ "euromap67_output_bits", FieldType::UINT32 },
+  FieldTypeEntry{ "euromap67_24V_voltage", FieldType::DOUBLE },
+  FieldTypeEntry{ "euromap67_24V_current", FieldType::DOUBLE },
+  FieldTypeEntry{ "tool_mode", FieldType::UINT32 },
+  FieldTypeEntry{ "tool_analog_input_types", FieldType::UINT32 },
+  FieldTypeEntry{ "tool_analog_input0", FieldType::DOUBLE },
+  FieldTypeEntry{ "tool_analog_input1", FieldType::DOUBLE },
+  FieldTypeEntry{ "tool_output_voltage", FieldType::INT32 },
+  FieldTypeEntry{ "tool_output_current", FieldType::DOUBLE },
+  FieldTypeEntry{ "tool_temperature", FieldType::DOUBLE },
+  FieldTypeEntry{ "tcp_force_scalar", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_bit_registers0_to_31", FieldType::UINT32 },
+  FieldTypeEntry{ "output_bit_registers32_to_63", FieldType::UINT32 },
+  FieldTypeEntry{ "output_bit_register_0", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_1", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_2", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_3", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_4", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_5", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_6", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_7", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_8", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_9", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_10", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_11", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_12", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_13", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_14", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_15", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_16", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_17", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_18", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_19", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_20", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_21", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_22", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_23", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_24", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_25", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_26", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_27", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_28", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_29", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_30", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_31", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_32", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_33", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_34", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_35", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_36", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_37", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_38", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_39", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_40", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_41", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_42", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_43", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_44", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_45", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_46", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_47", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_48", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_49", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_50", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_51", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_52", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_53", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_54", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_55", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_56", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_57", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_58", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_59", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_60", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_61", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_62", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_63", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_64", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_65", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_66", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_67", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_68", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_69", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_70", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_71", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_72", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_73", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_74", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_75", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_76", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_77", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_78", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_79", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_80", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_81", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_82", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_83", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_84", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_85", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_86", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_87", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_88", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_89", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_90", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_91", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_92", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_93", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_94", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_95", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_96", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_97", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_98", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_99", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_100", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_101", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_102", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_103", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_104", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_105", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_106", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_107", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_108", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_109", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_110", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_111", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_112", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_113", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_114", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_115", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_116", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_117", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_118", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_119", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_120", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_121", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_122", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_123", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_124", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_125", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_126", FieldType::BOOL },
+  FieldTypeEntry{ "output_bit_register_127", FieldType::BOOL },
+  FieldTypeEntry{ "output_int_register_0", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_1", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_2", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_3", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_4", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_5", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_6", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_7", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_8", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_9", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_10", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_11", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_12", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_13", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_14", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_15", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_16", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_17", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_18", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_19", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_20", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_21", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_22", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_23", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_24", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_25", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_26", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_27", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_28", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_29", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_30", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_31", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_32", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_33", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_34", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_35", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_36", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_37", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_38", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_39", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_40", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_41", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_42", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_43", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_44", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_45", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_46", FieldType::INT32 },
+  FieldTypeEntry{ "output_int_register_47", FieldType::INT32 },
+  FieldTypeEntry{ "output_double_register_0", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_1", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_2", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_3", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_4", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_5", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_6", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_7", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_8", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_9", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_10", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_11", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_12", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_13", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_14", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_15", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_16", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_17", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_18", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_19", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_20", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_21", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_22", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_23", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_24", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_25", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_26", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_27", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_28", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_29", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_30", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_31", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_32", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_33", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_34", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_35", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_36", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_37", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_38", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_39", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_40", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_41", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_42", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_43", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_44", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_45", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_46", FieldType::DOUBLE },
+  FieldTypeEntry{ "output_double_register_47", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_bit_registers0_to_31", FieldType::UINT32 },
+  FieldTypeEntry{ "input_bit_registers32_to_63", FieldType::UINT32 },
+  FieldTypeEntry{ "input_bit_register_0", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_1", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_2", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_3", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_4", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_5", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_6", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_7", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_8", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_9", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_10", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_11", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_12", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_13", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_14", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_15", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_16", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_17", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_18", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_19", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_20", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_21", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_22", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_23", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_24", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_25", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_26", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_27", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_28", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_29", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_30", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_31", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_32", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_33", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_34", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_35", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_36", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_37", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_38", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_39", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_40", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_41", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_42", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_43", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_44", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_45", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_46", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_47", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_48", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_49", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_50", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_51", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_52", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_53", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_54", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_55", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_56", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_57", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_58", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_59", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_60", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_61", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_62", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_63", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_64", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_65", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_66", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_67", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_68", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_69", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_70", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_71", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_72", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_73", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_74", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_75", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_76", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_77", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_78", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_79", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_80", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_81", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_82", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_83", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_84", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_85", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_86", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_87", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_88", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_89", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_90", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_91", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_92", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_93", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_94", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_95", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_96", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_97", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_98", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_99", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_100", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_101", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_102", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_103", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_104", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_105", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_106", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_107", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_108", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_109", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_110", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_111", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_112", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_113", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_114", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_115", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_116", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_117", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_118", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_119", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_120", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_121", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_122", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_123", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_124", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_125", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_126", FieldType::BOOL },
+  FieldTypeEntry{ "input_bit_register_127", FieldType::BOOL },
+  FieldTypeEntry{ "input_int_register_0", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_1", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_2", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_3", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_4", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_5", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_6", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_7", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_8", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_9", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_10", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_11", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_12", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_13", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_14", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_15", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_16", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_17", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_18", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_19", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_20", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_21", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_22", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_23", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_24", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_25", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_26", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_27", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_28", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_29", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_30", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_31", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_32", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_33", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_34", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_35", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_36", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_37", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_38", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_39", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_40", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_41", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_42", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_43", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_44", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_45", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_46", FieldType::INT32 },
+  FieldTypeEntry{ "input_int_register_47", FieldType::INT32 },
+  FieldTypeEntry{ "input_double_register_0", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_1", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_2", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_3", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_4", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_5", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_6", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_7", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_8", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_9", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_10", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_11", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_12", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_13", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_14", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_15", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_16", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_17", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_18", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_19", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_20", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_21", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_22", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_23", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_24", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_25", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_26", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_27", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_28", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_29", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_30", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_31", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_32", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_33", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_34", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_35", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_36", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_37", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_38", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_39", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_40", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_41", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_42", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_43", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_44", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_45", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_46", FieldType::DOUBLE },
+  FieldTypeEntry{ "input_double_register_47", FieldType::DOUBLE },
+  FieldTypeEntry{ "speed_slider_mask", FieldType::UINT32 },
+  FieldTypeEntry{ "speed_slider_fraction", FieldType::DOUBLE },
+  FieldTypeEntry{ "standard_digital_output_mask", FieldType::UINT8 },
+  FieldTypeEntry{ "standard_digital_output", FieldType::UINT8 },
+  FieldTypeEntry{ "configurable_digital_output_mask", FieldType::UINT8 },
+  FieldTypeEntry{ "configurable_digital_output", FieldType::UINT8 },
+  FieldTypeEntry{ "tool_digital_output_mask", FieldType::UINT8 },
+  FieldTypeEntry{ "tool_output_mode", FieldType::UINT8 },
+  FieldTypeEntry{ "tool_digital_output0_mode", FieldType::UINT8 },
+  FieldTypeEntry{ "tool_digital_output1_mode", FieldType::UINT8 },
+  FieldTypeEntry{ "tool_digital_output", FieldType::UINT8 },
+  FieldTypeEntry{ "payload", FieldType::DOUBLE },
+  FieldTypeEntry{ "payload_cog", FieldType::VECTOR3D },
+  FieldTypeEntry{ "payload_inertia", FieldType::VECTOR6D },
+  FieldTypeEntry{ "script_control_line", FieldType::UINT32 },
+  FieldTypeEntry{ "ft_raw_wrench", FieldType::VECTOR6D },
+  FieldTypeEntry{ "joint_position_deviation_ratio", FieldType::DOUBLE },
+  FieldTypeEntry{ "collision_detection_ratio", FieldType::DOUBLE },
+  FieldTypeEntry{ "time_scale_source", FieldType::INT32 },
+  FieldTypeEntry{ "standard_analog_output_mask", FieldType::UINT8 },
+  FieldTypeEntry{ "standard_analog_output_type", FieldType::UINT8 },
+  FieldTypeEntry{ "standard_analog_output_0", FieldType::DOUBLE },
+  FieldTypeEntry{ "standard_analog_output_1", FieldType::DOUBLE },
+  FieldTypeEntry{ "tcp_offset", FieldType::VECTOR6D },
+};
+
+namespace detail
+{
+//! Number of slots of the field type hash table, a power of two
+constexpr size_t FIELD_TYPE_SLOTS = 2048;
+
+//! FNV-1a hash of a field name
+constexpr uint32_t hashFieldName(const std::string_view name)
+{
+  uint32_t hash = 2166136261u;
+  for (const char c : name)
+  {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+constexpr std::array<FieldTypeEntry, FIELD_TYPE_SLOTS> buildFieldTypeSlots()
+{
+  std::array<FieldTypeEntry, FIELD_TYPE_SLOTS> slots{};
+  for (const FieldTypeEntry& entry : FIELD_TYPES)
+  {
+    size_t slot = hashFieldName(entry.name) & (FIELD_TYPE_SLOTS - 1);
+    while (!slots[slot].name.empty())
+    {
+      slot = (slot + 1) & (FIELD_TYPE_SLOTS - 1);
+    }
+    slots[slot] = entry;
+  }
+  return slots;
+}
+
+//! Open addressing hash table of FIELD_TYPES, built by the compiler
+inline constexpr std::array<FieldTypeEntry, FIELD_TYPE_SLOTS> FIELD_TYPE_SLOT_TABLE = buildFieldTypeSlots();
+
+constexpr size_t maxFieldTypeProbes()
+{
+  size_t max_probes = 0;
+  for (const FieldTypeEntry& entry : FIELD_TYPES)
+  {
+    size_t probes = 1;
+    size_t slot = hashFieldName(entry.name) & (FIELD_TYPE_SLOTS - 1);
+    while (FIELD_TYPE_SLOT_TABLE[slot].name != entry.name)
+    {
+      slot = (slot + 1) & (FIELD_TYPE_SLOTS - 1);
+      ++probes;
+    }
+    max_probes = probes > max_probes ? probes : max_probes;
+  }
+  return max_probes;
+}
+
+// Keeps lookups of known fields within a few comparisons when fields are added
+static_assert(maxFieldTypeProbes() <= 8, "Too many collisions in the RTDE field type table, increase its size.");
+}  // namespace detail
+
+/*!
+ * \brief Looks up the data type of an RTDE data field. This can be evaluated at compile time.
+ *
+ * \param name Name of the data field
+ * \param type Target for the data type
+ *
+ * \returns True if the field is known, false otherwise
+ */
+constexpr bool findFieldType(const std::string_view name, FieldType& type)
+{
+  for (size_t slot = detail::hashFieldName(name) & (detail::FIELD_TYPE_SLOTS - 1);
+       !detail::FIELD_TYPE_SLOT_TABLE[slot].name.empty(); slot = (slot + 1) & (detail::FIELD_TYPE_SLOTS - 1))
+  {
+    if (detail::FIELD_TYPE_SLOT_TABLE[slot].name == name)
+    {
+      type = detail::FIELD_TYPE_SLOT_TABLE[slot].type;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief Checks whether a name is a known RTDE data field. This can be evaluated at compile time.
+ *
+ * \param name Name of the data field
+ */
+constexpr bool isKnownField(const std::string_view name)
+{
+  FieldType type{};
+  return findFieldType(name, type);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_FIELD_TYPES_H_INCLUDED
@@ -0,0 +1,199 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_IO_EVENT_ENGINE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_IO_EVENT_ENGINE_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Group of digital I/Os of the robot
+ */
+enum class IOBank
+{
+  STANDARD_INPUT,       ///< Standard digital inputs 0-7
+  CONFIGURABLE_INPUT,   ///< Configurable digital inputs 0-7
+  TOOL_INPUT,           ///< Tool digital inputs 0-1
+  STANDARD_OUTPUT,      ///< Standard digital outputs 0-7
+  CONFIGURABLE_OUTPUT,  ///< Configurable digital outputs 0-7
+  TOOL_OUTPUT           ///< Tool digital outputs 0-1
+};
+
+/*!
+ * \brief Edges of a digital signal an IOEventEngine subscription reacts to
+ */
+enum class IOEdge
+{
+  RISING,   ///< The signal changed from low to high
+  FALLING,  ///< The signal changed from high to low
+  BOTH      ///< Both rising and falling edges
+};
+
+/*!
+ * \brief Edge of a digital I/O detected by an IOEventEngine
+ */
+struct IOEdgeEvent
+{
+  IOBank bank;
+  //! Pin inside the bank, e.g. 3 for configurable input 3
+  uint8_t pin;
+  //! True for a rising edge, false for a falling edge
+  bool rising;
+  //! Robot timestamp of the package showing the new state in seconds. The edge occurred after
+  //! previous_timestamp and no later than this.
+  double timestamp;
+  //! Robot timestamp of the previous package showing the old state in seconds
+  double previous_timestamp;
+  //! Time the package showing the new state has been received
+  std::chrono::steady_clock::time_point receive_time;
+};
+
+/*!
+ * \brief Detects rising and falling edges of the robot's standard, configurable and tool digital
+ * inputs and outputs between consecutive data packages.
+ *
+ * The states of all digital inputs and all digital outputs are read from the \p
+ * actual_digital_input_bits and \p actual_digital_output_bits fields. Edges of all pins are
+ * computed at once with bitwise operations, so checking a package costs little more than reading
+ * the two fields, no matter how many pins are subscribed. Events carry the robot's \p timestamp,
+ * so edges are timed with the resolution of the RTDE stream.
+ *
+ * Subscriptions have to be bound to a recipe using setRecipe() before packages can be checked.
+ * Edges are only reported from the second package on, as the first one only provides the initial
+ * state.
+ */
+class IOEventEngine
+{
+public:
+  //! Callback called for every detected edge
+  using EdgeCallback = std::function<void(const IOEdgeEvent&)>;
+
+  IOEventEngine() = default;
+  virtual ~IOEventEngine() = default;
+
+  /*!
+   * \brief Subscribes to edges of a digital I/O.
+   *
+   * \param bank The group of the I/O
+   * \param pin The pin inside the group
+   * \param edge The edges to report
+   * \param callback Function to call with every detected edge
+   *
+   * \throws UrException if the bank doesn't have the given pin
+   */
+  void subscribe(const IOBank bank, const uint8_t pin, const IOEdge edge, EdgeCallback callback);
+
+  /*!
+   * \brief Binds all subscriptions to a recipe. Previously seen states are reset.
+   *
+   * \param recipe The recipe of the data packages that will be checked
+   *
+   * \throws UrException if \p timestamp or a field needed by a subscription isn't part of the recipe
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Checks a data package for edges and calls the respective callbacks.
+   *
+   * \param package The data package to check, it has to be based on the recipe passed to
+   * setRecipe()
+   * \param receive_time Time the package has been received
+   */
+  void update(const DataPackage& package,
+              const std::chrono::steady_clock::time_point receive_time = std::chrono::steady_clock::now());
+
+  /*!
+   * \brief Getter for the data fields needed by the subscriptions, including \p timestamp.
+   */
+  std::vector<std::string> getRequiredFields() const;
+
+  /*!
+   * \brief Checks whether there are any subscriptions.
+   */
+  bool empty() const
+  {
+    return sources_[0].subscriptions.empty() && sources_[1].subscriptions.empty();
+  }
+
+  /*!
+   * \brief Getter for the number of pins of a bank.
+   */
+  static uint8_t getNumPins(const IOBank bank);
+
+  /*!
+   * \brief Getter for the data field holding the states of a bank.
+   */
+  static const char* getFieldName(const IOBank bank);
+
+private:
+  struct Subscription
+  {
+    IOBank bank;
+    uint8_t pin;
+    //! Bit of the pin inside the data field
+    uint64_t mask;
+    bool rising;
+    bool falling;
+    EdgeCallback callback;
+  };
+
+  //! A data field holding the states of several banks
+  struct Source
+  {
+    FieldHandle<uint64_t> handle;
+    //! Bits of all subscribed pins
+    uint64_t mask = 0;
+    uint64_t previous_bits = 0;
+    bool has_previous = false;
+    std::vector<Subscription> subscriptions;
+  };
+
+  static size_t sourceOf(const IOBank bank);
+
+  // Inputs and outputs
+  Source sources_[2];
+  FieldHandle<double> timestamp_handle_;
+  double previous_timestamp_ = 0.0;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_IO_EVENT_ENGINE_H_INCLUDED
@@ -0,0 +1,148 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_OUTPUT_FREQUENCY_POLICY_H_INCLUDED
+#define UR_CLIENT_LIBRARY_OUTPUT_FREQUENCY_POLICY_H_INCLUDED
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/ur/datatypes.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Chooses the RTDE output frequency from the robot's state, so the robot only publishes
+ * with a high frequency while it is active, see RTDEClient::setOutputFrequencyPolicy().
+ *
+ * The robot counts as active depending on its \p robot_mode and \p runtime_state, by default while
+ * it is running and a program is playing, pausing or resuming. The active frequency is chosen as
+ * soon as the robot becomes active. The idle frequency is only chosen once the robot has been idle
+ * for a configurable delay, so short breaks in between programs don't cause switching back and
+ * forth.
+ */
+class OutputFrequencyPolicy
+{
+public:
+  //! Decides whether the robot is active in the given state
+  using ActivityCheck = std::function<bool(RobotMode, RuntimeState)>;
+
+  //! Default time the robot has to be idle before switching to the idle frequency
+  static constexpr std::chrono::milliseconds DEFAULT_IDLE_DELAY{ 2000 };
+
+  OutputFrequencyPolicy() = delete;
+
+  /*!
+   * \brief Creates a new OutputFrequencyPolicy object.
+   *
+   * \param active_frequency Output frequency while the robot is active
+   * \param idle_frequency Output frequency while the robot is idle
+   * \param idle_delay Time the robot has to be idle before switching to the idle frequency
+   * \param is_active Decides whether the robot is active, isActiveByDefault() if empty
+   *
+   * \throws UrException if a frequency isn't positive
+   */
+  OutputFrequencyPolicy(const double active_frequency, const double idle_frequency,
+                        const std::chrono::milliseconds idle_delay = DEFAULT_IDLE_DELAY,
+                        ActivityCheck is_active = nullptr);
+
+  /*!
+   * \brief Binds the policy to the recipe of the checked data packages. The robot counts as idle
+   * until the first package has been checked.
+   *
+   * \param recipe The recipe of the data packages that will be checked
+   *
+   * \throws UrException if the recipe doesn't contain \p robot_mode and \p runtime_state
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Checks the robot's state in a data package.
+   *
+   * \param package The data package to check, it has to be based on the recipe passed to
+   * setRecipe()
+   * \param now Time the package has been received
+   *
+   * \returns The output frequency the robot should publish with
+   */
+  double update(const DataPackage& package,
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  /*!
+   * \brief Default check whether the robot is active: It is running and a program is playing,
+   * pausing or resuming.
+   */
+  static bool isActiveByDefault(const RobotMode robot_mode, const RuntimeState runtime_state);
+
+  /*!
+   * \brief Getter for the data fields the policy reads.
+   */
+  static std::vector<std::string> getRequiredFields()
+  {
+    return { "robot_mode", "runtime_state" };
+  }
+
+  /*!
+   * \brief Getter for the output frequency while the robot is active.
+   */
+  double getActiveFrequency() const
+  {
+    return active_frequency_;
+  }
+
+  /*!
+   * \brief Getter for the output frequency while the robot is idle.
+   */
+  double getIdleFrequency() const
+  {
+    return idle_frequency_;
+  }
+
+private:
+  double active_frequency_;
+  double idle_frequency_;
+  std::chrono::steady_clock::duration idle_delay_;
+  ActivityCheck is_active_;
+
+  FieldHandle<int32_t> robot_mode_handle_;
+  FieldHandle<uint32_t> runtime_state_handle_;
+  bool was_active_;
+  std::chrono::steady_clock::time_point last_active_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_OUTPUT_FREQUENCY_POLICY_H_INCLUDED
@@ -0,0 +1,222 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RATE_ADAPTER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RATE_ADAPTER_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief How the data packages received during one delivery window are combined.
+ *
+ * Only floating point fields, i.e. fields of type double, vector3d_t and vector6d_t, are
+ * aggregated. All other fields, e.g. status bits and digital IOs, always hold the value of the
+ * latest package of the window.
+ */
+enum class Aggregation
+{
+  LATEST,  ///< Deliver the latest package of the window
+  MEAN,    ///< Deliver the element-wise mean of all packages of the window
+  MIN_MAX  ///< Deliver the latest package together with the element-wise minimum and maximum
+};
+
+/*!
+ * \brief The result of one delivery window of a DecimatedOutput.
+ */
+struct DecimatedPackage
+{
+  DecimatedPackage();
+
+  //! The latest package of the window or, with Aggregation::MEAN, the mean of the window
+  DataPackage value;
+  //! Element-wise minimum of the window, only filled with Aggregation::MIN_MAX
+  DataPackage minimum;
+  //! Element-wise maximum of the window, only filled with Aggregation::MIN_MAX
+  DataPackage maximum;
+  //! Number of data packages combined in this window
+  uint64_t num_samples;
+  //! Number of windows published before this one, that were never read
+  uint64_t num_skipped;
+};
+
+/*!
+ * \brief Delivers the data packages of a RateAdapter to one consumer at the consumer's rate.
+ *
+ * Only the result of the latest completed window is kept, so a consumer reading less often than
+ * its configured rate skips windows instead of accumulating a backlog.
+ */
+class DecimatedOutput
+{
+public:
+  DecimatedOutput() = delete;
+  DecimatedOutput(const double max_rate, const Aggregation aggregation);
+  virtual ~DecimatedOutput() = default;
+
+  /*!
+   * \brief Waits for a window that hasn't been read yet.
+   *
+   * \param package Target of the window's result. Reusing the same object for every call avoids
+   * allocating memory.
+   * \param timeout Time to wait if no new window has been completed yet
+   *
+   * \returns True if a new window was read, false on timeout
+   */
+  bool waitForPackage(DecimatedPackage& package, const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Reads a window that hasn't been read yet without waiting.
+   *
+   * \param package Target of the window's result
+   *
+   * \returns True if a new window was read, false otherwise
+   */
+  bool tryGetPackage(DecimatedPackage& package);
+
+  /*!
+   * \brief Getter for the maximum rate the consumer receives windows with.
+   *
+   * \returns The rate in Hz
+   */
+  double getMaxRate() const
+  {
+    return 1.0 / period_.count();
+  }
+
+  /*!
+   * \brief Getter for how packages are combined per window.
+   */
+  Aggregation getAggregation() const
+  {
+    return aggregation_;
+  }
+
+private:
+  friend class RateAdapter;
+
+  struct Field
+  {
+    size_t width;
+    FieldHandle<double> double_handle;
+    FieldHandle<vector3d_t> vector3d_handle;
+    FieldHandle<vector6d_t> vector6d_handle;
+  };
+
+  // Overwrites the floating point fields of a package with the given scalars divided by divisor
+  static void writeFields(DataPackage& package, const std::vector<Field>& fields, const std::vector<double>& scalars,
+                          const double divisor);
+
+  void bind(const size_t num_scalars);
+  void add(const DataPackage& package, const std::vector<Field>& fields, const std::vector<double>& scalars,
+           const std::chrono::steady_clock::time_point now);
+  void publish(const DataPackage& package, const std::vector<Field>& fields);
+  bool readLocked(DecimatedPackage& package);
+
+  const std::chrono::duration<double> period_;
+  const Aggregation aggregation_;
+
+  // Window state, only accessed by the thread feeding the RateAdapter
+  bool window_open_;
+  std::chrono::steady_clock::time_point window_end_;
+  uint64_t window_samples_;
+  std::vector<double> sum_;
+  std::vector<double> min_;
+  std::vector<double> max_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  DecimatedPackage published_;
+  bool unread_;
+};
+
+/*!
+ * \brief Pipeline stage handing the RTDE data packages to consumers that don't need every
+ * package, e.g. an HMI updating with 30 Hz or a historian recording with 100 Hz.
+ *
+ * Each consumer registers with its own maximum rate and receives a DecimatedOutput. The adapter
+ * is fed with every received data package, typically as data package observer of the RTDEClient,
+ * and combines the packages of each consumer's delivery window as configured. The consumer is
+ * only woken up once per window. Consumers using Aggregation::LATEST don't cost anything in
+ * between, the others accumulate the floating point fields of every package.
+ *
+ * The adapter binds itself to the recipe of the packages it is fed with. When the recipe changes,
+ * e.g. after switching the output recipe, all open windows are discarded.
+ */
+class RateAdapter
+{
+public:
+  RateAdapter() = default;
+  virtual ~RateAdapter() = default;
+
+  /*!
+   * \brief Registers a consumer. This must not be called while packages are fed to the adapter.
+   *
+   * \param max_rate Maximum rate in Hz, with which the consumer receives packages
+   * \param aggregation How the packages of each delivery window are combined
+   *
+   * \throws UrException if the rate isn't positive
+   *
+   * \returns The output the consumer reads its packages from
+   */
+  std::shared_ptr<DecimatedOutput> addConsumer(const double max_rate, const Aggregation aggregation = Aggregation::LATEST);
+
+  /*!
+   * \brief Feeds a received data package to all consumers.
+   *
+   * \param package The received data package
+   * \param now The time the package was received
+   */
+  void update(const DataPackage& package,
+              const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+private:
+  void bind(const std::shared_ptr<const CompiledRecipe>& recipe);
+
+  std::vector<std::shared_ptr<DecimatedOutput>> outputs_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::vector<DecimatedOutput::Field> fields_;
+  std::vector<double> scalars_;
+  bool needs_scalars_ = false;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RATE_ADAPTER_H_INCLUDED
@@ -0,0 +1,173 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_REGISTER_TRANSFER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_REGISTER_TRANSFER_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Registers used by a RegisterTransfer.
+ */
+struct RegisterTransferConfig
+{
+  //! Input integer register announcing a new chunk, in [24, 47]
+  uint32_t control_register = 24;
+  //! Output integer register the robot program acknowledges chunks in, in [0, 47]
+  uint32_t ack_register = 24;
+  //! First input double register carrying the chunk's values, in [24, 47]
+  uint32_t first_data_register = 24;
+  //! Number of consecutive input double registers carrying the chunk's values, at least 2
+  uint32_t num_data_registers = 8;
+  //! Maximum number of values of one transfer, allocated by the robot program upfront
+  uint32_t capacity = 1000;
+
+  /*!
+   * \brief Names of the input registers, that have to be part of the input recipe.
+   */
+  std::vector<std::string> getInputRegisters() const;
+
+  /*!
+   * \brief Name of the output register, that has to be part of the output recipe.
+   */
+  std::string getAckField() const;
+};
+
+/*!
+ * \brief Transfers arrays of doubles to the robot program in chunks of RTDE input registers.
+ *
+ * A transfer starts with a header chunk carrying the number of values and an id, followed by the
+ * values split into chunks of RegisterTransferConfig::num_data_registers. Each chunk is written
+ * together with a new value of the control register in one RTDE package. The robot program
+ * copies the chunk and writes the control value into the acknowledgement register, before the
+ * next chunk is written. Odd control values mark header chunks, even ones data chunks. Control
+ * values are never 0 and never repeat in consecutive chunks.
+ *
+ * Pass changes of the acknowledgement register to onAcknowledgement(), see
+ * RTDEClient::addFieldChangeCallback().
+ */
+class RegisterTransfer
+{
+public:
+  /*!
+   * \brief Writes a chunk into the input registers in one RTDE package. Returns false if it
+   * couldn't be written.
+   *
+   * The first parameter is the value of the control register, the second one holds the values of
+   * all data registers.
+   */
+  using WriteFunction = std::function<bool(int32_t, const std::vector<double>&)>;
+
+  RegisterTransfer() = delete;
+
+  /*!
+   * \brief Creates a new RegisterTransfer object.
+   *
+   * \param config Registers used for the transfer
+   *
+   * \throws UrException if a register index is out of range or fewer than 2 data registers are
+   * configured
+   */
+  explicit RegisterTransfer(const RegisterTransferConfig& config);
+  RegisterTransfer(const RegisterTransfer&) = delete;
+  RegisterTransfer& operator=(const RegisterTransfer&) = delete;
+
+  /*!
+   * \brief Sends an array to the robot program, blocking until all chunks have been
+   * acknowledged.
+   *
+   * Transfers must not be sent from several threads concurrently.
+   *
+   * \param values The values to send, at most RegisterTransferConfig::capacity
+   * \param id Id passed to the robot program along with the values
+   * \param write Function writing a chunk into the registers
+   * \param chunk_timeout Maximum time to wait for the acknowledgement of each chunk
+   *
+   * \throws UrException if there are more values than the robot program can hold
+   *
+   * \returns True if all chunks have been acknowledged, false if writing a chunk failed or a chunk
+   * hasn't been acknowledged in time
+   */
+  bool send(const std::vector<double>& values, const int32_t id, const WriteFunction& write,
+            const std::chrono::milliseconds chunk_timeout = std::chrono::milliseconds(100));
+
+  /*!
+   * \brief Passes the value of the acknowledgement register received from the robot.
+   *
+   * \param control The new value of the acknowledgement register
+   */
+  void onAcknowledgement(const int32_t control);
+
+  /*!
+   * \brief Getter for the registers used for the transfer.
+   */
+  const RegisterTransferConfig& getConfig() const
+  {
+    return config_;
+  }
+
+  /*!
+   * \brief Getter for the number of chunks needed to transfer a given number of values, including
+   * the header chunk.
+   */
+  size_t getNumChunks(const size_t num_values) const;
+
+private:
+  //! Writes one chunk and waits for its acknowledgement
+  bool sendChunk(const int32_t control, const std::vector<double>& data, const WriteFunction& write,
+                 const std::chrono::milliseconds timeout);
+  //! Returns the next sequence number, that is never 0
+  int32_t nextSequence();
+
+  RegisterTransferConfig config_;
+  // Seeded from the clock, so a new transfer object doesn't repeat the last control value of the
+  // robot program
+  int32_t sequence_;
+  std::vector<double> chunk_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int32_t acknowledged_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_REGISTER_TRANSFER_H_INCLUDED
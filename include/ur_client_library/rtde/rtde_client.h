@@ -29,7 +29,12 @@
 #ifndef UR_CLIENT_LIBRARY_RTDE_CLIENT_H_INCLUDED
 #define UR_CLIENT_LIBRARY_RTDE_CLIENT_H_INCLUDED
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "ur_client_library/comm/pipeline.h"
 #include "ur_client_library/rtde/package_header.h"
@@ -38,6 +43,18 @@
 #include "ur_client_library/rtde/rtde_parser.h"
 #include "ur_client_library/comm/producer.h"
 #include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/data_package_history.h"
+#include "ur_client_library/rtde/data_package_pool.h"
+#include "ur_client_library/rtde/field_change_monitor.h"
+#include "ur_client_library/rtde/io_event_engine.h"
+#include "ur_client_library/rtde/output_frequency_policy.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+#include "ur_client_library/rtde/shared_state.h"
+#include "ur_client_library/rtde/state_cache.h"
+#include "ur_client_library/rtde/clock_synchronizer.h"
+#include "ur_client_library/rtde/stream_monitor.h"
+#include "ur_client_library/rtde/stream_watchdog.h"
+#include "ur_client_library/rtde/typed_data_package.h"
 #include "ur_client_library/rtde/request_protocol_version.h"
 #include "ur_client_library/rtde/control_package_setup_outputs.h"
 #include "ur_client_library/rtde/control_package_start.h"
@@ -139,6 +156,69 @@ public:
    */
   bool init(const size_t max_num_tries = 0,
             const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10));
+  /*!
+   * \brief Switches to a new output recipe on the existing connection, without tearing down the
+   * RTDE session.
+   *
+   * A started client is paused, the new recipe is set up with the robot and the client is resumed
+   * afterwards, so this takes only a few round trips. All data packages received afterwards are
+   * based on the new recipe. Data package pool and history are recreated for the new recipe and
+   * field change subscriptions are bound to it. The timestamp is added to the recipe if missing.
+   *
+   * \param new_recipe The new output recipe
+   *
+   * \throws UrException if the client isn't initialized, a recording is running, the robot doesn't
+   * accept the new recipe or it doesn't match the configured typed recipe. If the robot doesn't
+   * accept the new recipe, the previous recipe is restored and the client stays paused.
+   *
+   * \returns True on success, false if the client couldn't be paused or resumed
+   */
+  bool switchOutputRecipe(const std::vector<std::string>& new_recipe);
+
+  /*!
+   * \brief Changes the frequency the robot publishes the output data packages with.
+   *
+   * The client is paused, the current output recipe is set up again with the new frequency and the
+   * client is resumed, if it was running. The compiled recipe and everything bound to it, e.g. the
+   * data package pool, history and state cache, is kept, so this takes only a few round trips.
+   * Stream monitoring and stale stream detection use the new frequency afterwards. The input
+   * recipe isn't affected.
+   *
+   * \param frequency The new output frequency
+   *
+   * \throws UrException if the client isn't initialized, the frequency isn't supported by the robot
+   * or the robot doesn't confirm the new setup
+   *
+   * \returns True on success, false if the client couldn't be paused or resumed
+   */
+  bool setOutputFrequency(const double frequency);
+
+  /*!
+   * \brief Switches the output frequency automatically between an idle and an active frequency
+   * depending on the robot's state, see OutputFrequencyPolicy.
+   *
+   * The policy checks every data package on the thread reading from the robot. Switching the
+   * frequency using setOutputFrequency() is done by a thread of its own, so no data packages are
+   * received for a few round trips during a switch. The output recipe has to contain \p robot_mode
+   * and \p runtime_state, which are declared for output recipe minimization if this is called
+   * before init(). This has to be called before start().
+   *
+   * \param policy The policy to use, nullptr to keep the current frequency
+   *
+   * \throws UrException if the client has been started already
+   */
+  void setOutputFrequencyPolicy(std::shared_ptr<OutputFrequencyPolicy> policy);
+
+  /*!
+   * \brief Getter for the policy switching the output frequency.
+   *
+   * \returns The policy, nullptr if the frequency isn't switched automatically
+   */
+  std::shared_ptr<OutputFrequencyPolicy> getOutputFrequencyPolicy() const
+  {
+    return frequency_policy_;
+  }
+
   /*!
    * \brief Triggers the robot to start sending RTDE data packages in the negotiated format.
    *
@@ -160,6 +240,597 @@ public:
    */
   std::unique_ptr<rtde_interface::DataPackage> getDataPackage(std::chrono::milliseconds timeout);
 
+  /*!
+   * \brief Reads the pipeline to fetch the next data package. The returned package is given back
+   * to the client's data package pool once it is released, so it can be reused for receiving
+   * further data packages.
+   *
+   * Without a pool configured using setDataPackagePoolSize(), the package is deleted when being
+   * released.
+   *
+   * \param timeout Time to wait if no data package is currently in the queue
+   *
+   * \returns Unique ptr to the package, if a package was fetched successfully, nullptr otherwise
+   */
+  PooledDataPackage getPooledDataPackage(std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Registers a callback that gets called for every received data package directly on the
+   * thread reading from the robot, right after the package has been parsed.
+   *
+   * Data packages handled by the callback are not added to the pipeline's queue, so they can't be
+   * fetched using getDataPackage() anymore. As the callback blocks reading the next package, it
+   * has to return within one RTDE cycle. If a data package pool is configured, the package is
+   * given back to the pool once the callback returns. This has to be called before start().
+   *
+   * \param callback Function to call with each received data package. Pass an empty function to
+   * return to polling data packages.
+   * \param budget Time budget every call of the callback is measured against, nullptr to not
+   * measure it
+   */
+  void setDataPackageCallback(std::function<void(DataPackage&)> callback,
+                              std::shared_ptr<comm::ExecutionBudget> budget = nullptr)
+  {
+    data_package_callback_ = callback;
+    data_package_callback_budget_ = budget;
+  }
+
+  /*!
+   * \brief Registers a function that gets called for every received data package directly on the
+   * thread reading from the robot, right after the package has been parsed.
+   *
+   * Unlike setDataPackageCallback(), observing a package doesn't consume it, so it can still be
+   * fetched using getDataPackage() or handled by the data package callback afterwards. Observers
+   * are called in the order they were added and have to return quickly, as they block reading the
+   * next package. This has to be called before start().
+   *
+   * \param observer Function to call with each received data package
+   * \param budget Time budget every call of the observer is measured against, nullptr to not
+   * measure it
+   */
+  void addDataPackageObserver(std::function<void(const DataPackage&)> observer,
+                              std::shared_ptr<comm::ExecutionBudget> budget = nullptr)
+  {
+    data_package_observers_.push_back({ observer, budget });
+  }
+
+  /*!
+   * \brief Configures the number of data packages retained in the client's data package history.
+   *
+   * With a history configured, every received data package is stored in its compact binary form
+   * together with its receive time right after being parsed. This has to be called before init().
+   *
+   * \param history_size Number of data packages to retain. Set to 0 to disable the history.
+   */
+  void setDataPackageHistorySize(const size_t history_size)
+  {
+    data_package_history_size_ = history_size;
+  }
+
+  /*!
+   * \brief Getter for the data package history configured using setDataPackageHistorySize().
+   *
+   * \returns The history of received data packages, nullptr if no history is configured or the
+   * client hasn't been initialized
+   */
+  std::shared_ptr<DataPackageHistory> getDataPackageHistory() const
+  {
+    return data_package_history_;
+  }
+
+  /*!
+   * \brief Publishes every received data package into a shared memory segment, see
+   * SharedStatePublisher. Other processes on the same host can read the robot state from there
+   * using SharedStateReader instead of connecting to the robot themselves.
+   *
+   * The segment is created during init() and recreated when switching the output recipe, which
+   * deactivates the previous segment. This has to be called before init().
+   *
+   * \param name Name of the shared memory segment, e.g. "/urcl_rtde_state". Set to an empty string
+   * to disable publishing.
+   * \param slot_count Number of data packages retained in the segment
+   */
+  void setSharedStatePublishing(const std::string& name,
+                                const size_t slot_count = SharedStatePublisher::DEFAULT_SLOT_COUNT)
+  {
+    shared_state_name_ = name;
+    shared_state_slot_count_ = slot_count;
+  }
+
+  /*!
+   * \brief Getter for the publisher configured using setSharedStatePublishing().
+   *
+   * Switching the output recipe replaces the publisher, the previous one is deactivated then.
+   *
+   * \returns The shared state publisher, nullptr if publishing is disabled or the client hasn't
+   * been initialized
+   */
+  std::shared_ptr<SharedStatePublisher> getSharedStatePublisher() const
+  {
+    return shared_state_publisher_;
+  }
+
+  /*!
+   * \brief Keeps the latest received data package in a StateCache, from which any number of
+   * threads can read the robot state without taking packages from the queue.
+   *
+   * The cache is created during init() and recreated when switching the output recipe, so it has
+   * to be fetched again using getStateCache() afterwards. This has to be called before init().
+   *
+   * \param enabled True to cache the latest data package, false to disable caching
+   */
+  void setStateCaching(const bool enabled)
+  {
+    state_caching_ = enabled;
+  }
+
+  /*!
+   * \brief Getter for the cache enabled using setStateCaching().
+   *
+   * \returns The state cache, nullptr if caching is disabled or the client hasn't been initialized
+   */
+  std::shared_ptr<StateCache> getStateCache() const
+  {
+    return state_cache_;
+  }
+
+  /*!
+   * \brief Starts recording all frames received from the robot to a binary log file, see
+   * RTDERecorder. Frames are recorded exactly as they are read from the socket, before they are
+   * parsed, including packages of additional output recipes and text messages.
+   *
+   * This has to be called after init() and before start(). The recording is stopped when calling
+   * stopRecording() or disconnect().
+   *
+   * \param path Path of the log file. An existing file will be overwritten.
+   *
+   * \throws UrException if the client isn't initialized, has already been started or the file
+   * cannot be created
+   */
+  void startRecording(const std::string& path);
+
+  /*!
+   * \brief Stops a recording started with startRecording() and closes the log file.
+   */
+  void stopRecording();
+
+  /*!
+   * \brief Registers an additional output recipe, that is sent by the robot with its own frequency
+   * on the same connection, e.g. to receive diagnostic data at a much lower rate than the main
+   * output recipe.
+   *
+   * Data packages of an additional recipe are not added to the pipeline's queue. Instead, they are
+   * handed to the given callback on the thread reading from the robot, so they don't affect
+   * consumers of the main recipe. The package passed to the callback is reused for every package
+   * of this recipe. This requires RTDE protocol version 2 and has to be called before init().
+   *
+   * \param recipe The additional output recipe
+   * \param frequency Frequency in Hz at which the robot sends data packages for this recipe
+   * \param callback Function to call with every received data package of this recipe
+   */
+  void addOutputRecipe(const std::vector<std::string>& recipe, const double frequency,
+                       std::function<void(DataPackage&)> callback)
+  {
+    AdditionalOutputRecipe additional_recipe;
+    additional_recipe.recipe = recipe;
+    additional_recipe.frequency = frequency;
+    additional_recipe.callback = callback;
+    additional_output_recipes_.push_back(additional_recipe);
+  }
+
+  /*!
+   * \brief Registers a callback that gets called whenever the value of an output data field has
+   * changed.
+   *
+   * Changes are detected centrally on the thread reading from the robot, right after a data package
+   * has been parsed, by comparing only the subscribed field to its previous value. The callback is
+   * also called for the first data package received after starting the client. It has to return
+   * quickly, as it blocks reading the next package. This has to be called before start(), which
+   * will throw an UrException if the field isn't part of the output recipe or has a different type.
+   *
+   * \param name The string identifier for the data field as used in the documentation
+   * \param callback Function to call with the field's new value
+   */
+  template <typename T>
+  void addFieldChangeCallback(const std::string& name, std::function<void(const T&)> callback)
+  {
+    field_change_monitor_.subscribe<T>(name, callback);
+    if (client_state_ == ClientState::UNINITIALIZED)
+    {
+      requireOutputFields({ name });
+    }
+  }
+
+  /*!
+   * \brief Registers a callback for rising and/or falling edges of a digital input or output.
+   *
+   * Edges of all subscribed I/Os are detected together on the thread reading from the robot, right
+   * after a data package has been parsed, see IOEventEngine. Each event carries the robot
+   * timestamps of the packages before and after the edge. The callback has to return quickly, as it
+   * blocks reading the next package. This has to be called before start(), which will throw an
+   * UrException if the output recipe doesn't contain \p timestamp and the field holding the I/O's
+   * states.
+   *
+   * \param bank The group of the I/O
+   * \param pin The pin inside the group
+   * \param edge The edges to report
+   * \param callback Function to call with every detected edge
+   *
+   * \throws UrException if the bank doesn't have the given pin
+   */
+  void addIOEdgeCallback(const IOBank bank, const uint8_t pin, const IOEdge edge,
+                         IOEventEngine::EdgeCallback callback)
+  {
+    io_event_engine_.subscribe(bank, pin, edge, callback);
+    if (client_state_ == ClientState::UNINITIALIZED)
+    {
+      requireOutputFields(io_event_engine_.getRequiredFields());
+    }
+  }
+
+  /*!
+   * \brief Declares output data fields a consumer of the data packages reads.
+   *
+   * With setOutputRecipeMinimization() enabled, only the declared fields are requested from the
+   * robot. Fields subscribed using addFieldChangeCallback() or addIOEdgeCallback() or of the typed recipe
+   * configured using useTypedDataPackages() are declared automatically. This has to be called before init().
+   *
+   * \param fields The string identifiers of the data fields as used in the documentation
+   */
+  void requireOutputFields(const std::vector<std::string>& fields);
+
+  /*!
+   * \brief Getter for the output data fields declared using requireOutputFields().
+   */
+  const std::vector<std::string>& getRequiredOutputFields() const
+  {
+    return required_output_fields_;
+  }
+
+  /*!
+   * \brief Reduces the output recipe to the fields declared using requireOutputFields() during
+   * init(), so the robot doesn't send fields nobody reads. Fields keep their order of the configured
+   * recipe, declared fields not contained in it are appended and the timestamp field is always
+   * kept. If no field has been declared, the configured recipe is used as is. This has to be called
+   * before init().
+   *
+   * \param enabled True to minimize the output recipe, false to use the configured recipe
+   */
+  void setOutputRecipeMinimization(const bool enabled)
+  {
+    minimize_output_recipe_ = enabled;
+  }
+
+  /*!
+   * \brief Configures the number of pre-allocated data packages used for receiving data.
+   *
+   * With a pool configured, received data is parsed into packages taken from the pool instead of
+   * allocating a new package per received message. Data packages fetched using
+   * getPooledDataPackage() are returned to the pool automatically, so receiving data doesn't
+   * allocate memory as long as packages are consumed in time. This has to be called before init().
+   *
+   * \param pool_size Number of packages inside the pool. 0 disables pooling, which is the default.
+   */
+  void setDataPackagePoolSize(const size_t pool_size)
+  {
+    data_package_pool_size_ = pool_size;
+  }
+
+  /*!
+   * \brief Configures the client to parse received data into TypedDataPackage objects for the given
+   * typed recipe. Those have to be fetched using getTypedDataPackage().
+   *
+   * The client's output recipe has to be TypedDataPackage<RecipeT>::getRecipe(). Since the
+   * timestamp field is always part of the output recipe, the typed recipe has to contain it, as
+   * well. This has to be called before init(), which will throw an UrException if the negotiated
+   * output recipe doesn't match the typed recipe.
+   *
+   * @tparam RecipeT The struct defining the recipe, see TypedDataPackage
+   */
+  template <typename RecipeT>
+  void useTypedDataPackages()
+  {
+    typed_recipe_tag_ = TypedDataPackage<RecipeT>::getRecipeTag();
+    requireOutputFields(TypedDataPackage<RecipeT>::getRecipe());
+    typed_recipe_check_ = [](const CompiledRecipe& recipe) { return TypedDataPackage<RecipeT>::matches(recipe); };
+    typed_package_factory_ = [](const uint16_t protocol_version) -> std::unique_ptr<RTDEPackage> {
+      return std::make_unique<TypedDataPackage<RecipeT>>(protocol_version);
+    };
+  }
+
+  /*!
+   * \brief Reads the pipeline to fetch the next typed data package. The client has to be configured
+   * using useTypedDataPackages() for the same recipe.
+   *
+   * \param timeout Time to wait if no data package is currently in the queue
+   *
+   * \returns Unique ptr to the package, if a package was fetched successfully, nullptr otherwise
+   */
+  template <typename RecipeT>
+  std::unique_ptr<TypedDataPackage<RecipeT>> getTypedDataPackage(std::chrono::milliseconds timeout)
+  {
+    if (typed_recipe_tag_ != TypedDataPackage<RecipeT>::getRecipeTag())
+    {
+      URCL_LOG_ERROR("The RTDE client is not configured to use this typed recipe, see useTypedDataPackages().");
+      return std::unique_ptr<TypedDataPackage<RecipeT>>(nullptr);
+    }
+    std::unique_ptr<RTDEPackage> urpackage;
+    if (pipeline_->getLatestProduct(urpackage, timeout) && urpackage->getType() == PackageType::RTDE_DATA_PACKAGE &&
+        parser_.hasDataPackageFactory())
+    {
+      return std::unique_ptr<TypedDataPackage<RecipeT>>(static_cast<TypedDataPackage<RecipeT>*>(urpackage.release()));
+    }
+    return std::unique_ptr<TypedDataPackage<RecipeT>>(nullptr);
+  }
+
+  /*!
+   * \brief Configures received data packages to keep the serialized data and only decode fields
+   * when they are accessed.
+   *
+   * This reduces the time needed to parse a received package, if only some fields of the output
+   * recipe are read from each package. This has to be called before init().
+   *
+   * \param lazy_decoding True to decode fields on access, false to decode all fields when a package
+   * is received, which is the default.
+   */
+  void setLazyDecoding(const bool lazy_decoding)
+  {
+    lazy_decoding_ = lazy_decoding;
+  }
+
+  /*!
+   * \brief Configures whether the result of a successful handshake is cached and reused when
+   * connecting to the same robot again.
+   *
+   * With a cached handshake, all handshake requests are sent back-to-back using the protocol
+   * version, controller version and output recipe validated before, instead of waiting for each
+   * answer separately. If any answer differs from the cached result, the client reconnects and
+   * performs the full handshake. The cache is shared by all clients of the process and is keyed by
+   * the robot's IP address. This is enabled by default and has to be called before init().
+   *
+   * \param enabled True to use the handshake cache, false to always perform the full handshake
+   */
+  void setHandshakeCaching(const bool enabled)
+  {
+    handshake_caching_ = enabled;
+  }
+
+  /*!
+   * \brief Removes all cached handshake results, so the next handshake with any robot is performed
+   * completely.
+   */
+  static void clearHandshakeCache();
+
+  /*!
+   * \brief Enables recording the latencies of received packages into histograms.
+   *
+   * Every package is timestamped when it is read from the socket, parsed, queued and taken out of
+   * the queue. The durations in between, as well as the interval between received packages, are
+   * available through getLatencyStatistics(). Optionally, the kernel's software receive timestamps
+   * are requested, which adds the time a package waited in the socket's receive buffer. This has to
+   * be called before start() and, when requesting kernel timestamps, before init().
+   *
+   * \param enabled True to record latencies, false to disable recording
+   * \param kernel_timestamps True to additionally request receive timestamps from the kernel
+   */
+  void setLatencyInstrumentation(const bool enabled, const bool kernel_timestamps = false);
+
+  /*!
+   * \brief Enables reading from the robot in large chunks instead of reading every package
+   * separately.
+   *
+   * This reduces the number of system calls per package to one or less and lets the client catch
+   * up with all packages received after a delay in one go. See comm::URStream::setBufferedReading()
+   * for details. This has to be called before init().
+   *
+   * \param buffered True to read in chunks
+   */
+  void setBufferedReading(const bool buffered);
+
+  /*!
+   * \brief Configures the delays between attempts to reconnect after the connection to the robot
+   * has been lost while receiving data. See comm::URProducer::setReconnectionBackoff() for details.
+   * This has to be called before start().
+   *
+   * \param config The delays to use
+   */
+  void setReconnectionBackoff(const comm::BackoffConfig& config);
+
+  /*!
+   * \brief Registers a callback that is called whenever the connection to the robot is lost or
+   * re-established while receiving data. It is called from the thread receiving data and must
+   * return quickly. This has to be called before start().
+   *
+   * \param callback Callback receiving the new connection state, nullptr to remove it
+   */
+  void setConnectionStateCallback(std::function<void(comm::ConnectionState)> callback);
+
+  /*!
+   * \brief Getter for the state of the connection used to receive data.
+   *
+   * \returns The current connection state
+   */
+  comm::ConnectionState getConnectionState() const
+  {
+    return prod_->getConnectionState();
+  }
+
+  /*!
+   * \brief Configures the queue buffering received packages until they are read, e.g. using
+   * getDataPackage().
+   *
+   * By default, up to comm::Pipeline::DEFAULT_QUEUE_CAPACITY packages are queued and new packages
+   * are discarded while the queue is full. Consumers acting on the robot's state should prefer
+   * comm::OverflowPolicy::DROP_OLDEST or comm::OverflowPolicy::LATEST_ONLY, so they never get
+   * outdated packages. The queue is applied when starting the client, while establishing the
+   * connection the default queue is used. This has to be called before start().
+   *
+   * \param capacity Maximum number of queued packages
+   * \param policy What to do with new packages while the queue is full
+   */
+  void setPipelineQueue(const size_t capacity, const comm::OverflowPolicy policy)
+  {
+    pipeline_queue_capacity_ = capacity;
+    pipeline_queue_policy_ = policy;
+  }
+
+  /*!
+   * \brief Getter for the number of received packages discarded, because the queue was full.
+   *
+   * \returns The number of discarded packages since the client has been started
+   */
+  uint64_t getNumDroppedPackages() const
+  {
+    return pipeline_->getNumDroppedProducts();
+  }
+
+  /*!
+   * \brief Getter for the largest number of packages that have been queued at the same time.
+   *
+   * \returns The high-water mark of the queue since the client has been started
+   */
+  size_t getQueueHighWaterMark() const
+  {
+    return pipeline_->getQueueHighWaterMark();
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the client's threads, i.e. the thread
+   * receiving data packages and the thread writing inputs to the robot.
+   *
+   * A name given in the config is extended with "_rx" and "_tx" for the two threads. The settings
+   * are kept when the output recipe is changed and are applied to running threads immediately.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Sets tuning options of the socket connected to the robot's RTDE interface. They are
+   * applied immediately and on every reconnect.
+   *
+   * \param options The socket options
+   */
+  void setSocketOptions(const comm::SocketOptions& options)
+  {
+    stream_.setSocketOptions(options);
+  }
+
+  /*!
+   * \brief Limits how long a single attempt to connect to the robot's RTDE interface may take. See
+   * comm::TCPSocket::setConnectTimeout() for details. This has to be called before init().
+   *
+   * \param timeout Maximum duration of a connection attempt, 0 to wait for the operating system
+   */
+  void setConnectTimeout(const std::chrono::milliseconds timeout)
+  {
+    stream_.setConnectTimeout(timeout);
+  }
+
+  /*!
+   * \brief Reads the kernel's statistics of the connection to the robot's RTDE interface, see
+   * comm::readTcpStatistics(). This can be called from any thread.
+   *
+   * \param statistics Target for the statistics
+   *
+   * \returns True on success, false if the client isn't connected
+   */
+  bool getTcpStatistics(comm::TcpStatistics& statistics) const
+  {
+    return stream_.getTcpStatistics(statistics);
+  }
+
+  /*!
+   * \brief Enables monitoring the received data stream for missed and late packages as well as
+   * pipeline overflows.
+   *
+   * The monitor compares the robot's \p timestamp field and the arrival times of the data packages
+   * against the target frequency. Use getStreamMonitor() to read its statistics, configure its
+   * tolerance or register a callback for violations. This has to be called before start().
+   *
+   * \param enabled True to monitor the stream, false to disable monitoring
+   */
+  void setStreamMonitoring(const bool enabled)
+  {
+    stream_monitor_ = enabled ? std::make_shared<StreamMonitor>() : nullptr;
+  }
+
+  /*!
+   * \brief Getter for the monitor watching the received data stream.
+   *
+   * \returns The stream monitor, nullptr if stream monitoring is disabled
+   */
+  std::shared_ptr<StreamMonitor> getStreamMonitor() const
+  {
+    return stream_monitor_;
+  }
+
+  /*!
+   * \brief Enables detecting a stale data stream within a few publishing periods.
+   *
+   * The watchdog declares the stream stale, if no package with an advancing robot \p timestamp
+   * arrived for \p missed_periods periods of the target frequency. Use getStreamWatchdog() to
+   * register a callback for staleness changes. This has to be called before start().
+   *
+   * \param missed_periods Number of periods without a fresh package, 0 disables the watchdog
+   */
+  void setStaleStreamDetection(const size_t missed_periods)
+  {
+    if (missed_periods == 0)
+    {
+      stream_watchdog_ = nullptr;
+      return;
+    }
+    if (stream_watchdog_ == nullptr)
+    {
+      stream_watchdog_ = std::make_shared<StreamWatchdog>();
+    }
+    stream_watchdog_->setMissedPeriods(missed_periods);
+  }
+
+  /*!
+   * \brief Getter for the watchdog detecting a stale data stream.
+   *
+   * \returns The stream watchdog, nullptr if stale stream detection is disabled
+   */
+  std::shared_ptr<StreamWatchdog> getStreamWatchdog() const
+  {
+    return stream_watchdog_;
+  }
+
+  /*!
+   * \brief Enables estimating the relation between the robot's clock and the host's clocks from
+   * the received data packages, e.g. to fuse robot data with data of other sensors. Use
+   * getClockSynchronizer() to map times. This has to be called before start().
+   *
+   * \param enabled True to synchronize the clocks, false to disable synchronization
+   */
+  void setClockSynchronization(const bool enabled)
+  {
+    clock_synchronizer_ = enabled ? std::make_shared<ClockSynchronizer>() : nullptr;
+  }
+
+  /*!
+   * \brief Getter for the estimator of the relation between the robot's clock and the host's
+   * clocks.
+   *
+   * \returns The clock synchronizer, nullptr if clock synchronization is disabled
+   */
+  std::shared_ptr<ClockSynchronizer> getClockSynchronizer() const
+  {
+    return clock_synchronizer_;
+  }
+
+  /*!
+   * \brief Getter for the recorded latencies of received packages.
+   *
+   * \returns The latency statistics, nullptr if latency instrumentation is disabled
+   */
+  std::shared_ptr<comm::LatencyStatistics> getLatencyStatistics() const
+  {
+    return latency_statistics_;
+  }
+
   /*!
    * \brief Getter for the maximum frequency the robot can publish RTDE data packages with.
    *
@@ -215,9 +886,68 @@ public:
     return output_recipe_;
   }
 
+  /*!
+   * \brief Getter for the compiled RTDE output recipe all received data packages are based on.
+   *
+   * As the output recipe might get adapted during init(), this should be called after the client
+   * has been initialized.
+   *
+   * \returns The compiled output recipe
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledOutputRecipe() const
+  {
+    return parser_.getCompiledRecipe();
+  }
+
+  /*!
+   * \brief Resolves a field of the output recipe to a handle for fast access inside received data
+   * packages.
+   *
+   * As the output recipe might get adapted during init(), handles should be created after the
+   * client has been initialized.
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   *
+   * \throws UrException if the field isn't part of the output recipe or the type doesn't match.
+   *
+   * \returns A handle to the data field
+   */
+  template <typename T>
+  FieldHandle<T> getOutputFieldHandle(const std::string& name) const
+  {
+    return parser_.getCompiledRecipe()->getFieldHandle<T>(name);
+  }
+
 private:
+  struct AdditionalOutputRecipe
+  {
+    std::vector<std::string> recipe;
+    double frequency;
+    std::function<void(DataPackage&)> callback;
+  };
+
+  // Result of a successful handshake, which can be used to speed up reconnecting to the same robot
+  struct HandshakeCacheEntry
+  {
+    std::vector<std::string> requested_output_recipe;
+    std::vector<std::string> output_recipe;
+    std::vector<std::string> input_recipe;
+    double requested_frequency;
+    double target_frequency;
+    uint16_t protocol_version;
+    VersionInformation urcontrol_version;
+  };
+
+  void frequencySwitchLoop();
+  void stopFrequencySwitching();
+
+  // Returns the package as DataPackage, if it is one, without needing RTTI. Returns nullptr otherwise.
+  DataPackage* toDataPackage(RTDEPackage* package) const;
+
   comm::URStream<RTDEPackage> stream_;
   std::vector<std::string> output_recipe_;
+  bool minimize_output_recipe_;
+  std::vector<std::string> required_output_fields_;
   bool ignore_unavailable_outputs_;
   std::vector<std::string> input_recipe_;
   RTDEParser parser_;
@@ -229,12 +959,58 @@ private:
   VersionInformation urcontrol_version_;
 
   double max_frequency_;
-  double target_frequency_;
+  // Changed by setOutputFrequency(), possibly from the thread switching the frequency
+  std::atomic<double> target_frequency_;
 
   ClientState client_state_;
 
-  constexpr static const double CB3_MAX_FREQUENCY = 125.0;
-  constexpr static const double URE_MAX_FREQUENCY = 500.0;
+  size_t data_package_pool_size_;
+  std::shared_ptr<DataPackagePool> data_package_pool_;
+  bool lazy_decoding_;
+  std::function<void(DataPackage&)> data_package_callback_;
+  std::shared_ptr<comm::ExecutionBudget> data_package_callback_budget_;
+  struct DataPackageObserver
+  {
+    std::function<void(const DataPackage&)> callback;
+    std::shared_ptr<comm::ExecutionBudget> budget;
+  };
+  std::vector<DataPackageObserver> data_package_observers_;
+  std::vector<AdditionalOutputRecipe> additional_output_recipes_;
+  size_t data_package_history_size_;
+  std::shared_ptr<DataPackageHistory> data_package_history_;
+  std::string shared_state_name_;
+  size_t shared_state_slot_count_;
+  std::shared_ptr<SharedStatePublisher> shared_state_publisher_;
+  bool state_caching_;
+  std::shared_ptr<StateCache> state_cache_;
+  FieldChangeMonitor field_change_monitor_;
+  IOEventEngine io_event_engine_;
+  const void* typed_recipe_tag_;
+  std::function<bool(const CompiledRecipe&)> typed_recipe_check_;
+  std::function<std::unique_ptr<RTDEPackage>(const uint16_t)> typed_package_factory_;
+  std::shared_ptr<RTDERecorder> recorder_;
+  bool handshake_caching_;
+  std::shared_ptr<comm::LatencyStatistics> latency_statistics_;
+  std::shared_ptr<StreamMonitor> stream_monitor_;
+  std::shared_ptr<StreamWatchdog> stream_watchdog_;
+  std::shared_ptr<ClockSynchronizer> clock_synchronizer_;
+  std::shared_ptr<OutputFrequencyPolicy> frequency_policy_;
+  // Serializes changes of the output setup
+  std::mutex output_setup_mutex_;
+  std::thread frequency_switch_thread_;
+  std::mutex frequency_switch_mutex_;
+  std::condition_variable frequency_switch_cv_;
+  bool frequency_switch_running_;
+  // Latest frequency chosen by the policy
+  std::atomic<double> policy_frequency_;
+  size_t pipeline_queue_capacity_;
+  comm::OverflowPolicy pipeline_queue_policy_;
+  ThreadConfig thread_config_;
+  comm::BackoffConfig reconnection_backoff_;
+  std::function<void(comm::ConnectionState)> connection_state_callback_;
+
+  static std::mutex handshake_cache_mutex_;
+  static std::unordered_map<std::string, HandshakeCacheEntry> handshake_cache_;
 
   // Reads output or input recipe from a file
   std::vector<std::string> readRecipe(const std::string& recipe_file) const;
@@ -242,13 +1018,23 @@ private:
   // Helper function to ensure that timestamp is present in the output recipe. The timestamp is needed to ensure that
   // the robot is booted.
   std::vector<std::string> ensureTimestampIsPresent(const std::vector<std::string>& output_recipe) const;
+  // Keeps only the required output fields of the recipe and appends the missing ones
+  std::vector<std::string> minimizeOutputRecipe(const std::vector<std::string>& output_recipe) const;
 
   void setupCommunication(const size_t max_num_tries = 0,
                           const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10));
+  bool findHandshakeCacheEntry(HandshakeCacheEntry& entry);
+  // Sends all handshake requests at once based on a cached handshake. Returns false if any of the
+  // answers doesn't match the cached result.
+  bool setupCachedHandshake(const HandshakeCacheEntry& entry);
   bool negotiateProtocolVersion(const uint16_t protocol_version);
   void queryURControlVersion();
   void setupOutputs(const uint16_t protocol_version);
+  void setupAdditionalOutputs(const uint16_t protocol_version);
   void setupInputs();
+  // Sets up the given output recipe on an established connection. Returns the recipe confirmed by
+  // the robot, with unavailable variables removed if they may be ignored.
+  std::vector<std::string> setupSwitchedOutputs(std::vector<std::string> recipe);
   void disconnect();
 
   /*!
@@ -47,7 +47,7 @@ public:
    * \brief Creates a new RTDEPackage object.
    */
   RTDEPackage() = delete;
-  RTDEPackage(const PackageType type) : type_(type)
+  RTDEPackage(const PackageType type) : RTDEPackage(type, nullptr)
   {
   }
   virtual ~RTDEPackage() = default;
@@ -68,10 +68,45 @@ public:
    */
   virtual std::string toString() const;
 
+  /*!
+   * \brief Getter for the package's type. As every type of package received from the robot is
+   * represented by exactly one class, this can be used to cast a package to its actual class
+   * without needing RTTI.
+   *
+   * \returns The type of the package
+   */
+  PackageType getType() const
+  {
+    return type_;
+  }
+
+  /*!
+   * \brief Getter for the tag of the typed recipe this package was parsed with.
+   *
+   * \returns TypedDataPackage::getRecipeTag() for typed data packages, nullptr for all other packages
+   */
+  const void* getTypedRecipeTag() const
+  {
+    return typed_recipe_tag_;
+  }
+
 protected:
+  /*!
+   * \brief Creates a new RTDEPackage object belonging to a typed recipe.
+   *
+   * \param type The type of the package
+   * \param typed_recipe_tag Tag of the typed recipe, see TypedDataPackage::getRecipeTag()
+   */
+  RTDEPackage(const PackageType type, const void* typed_recipe_tag) : type_(type), typed_recipe_tag_(typed_recipe_tag)
+  {
+  }
+
   std::unique_ptr<uint8_t[]> buffer_;
   size_t buffer_length_;
   PackageType type_;
+
+private:
+  const void* typed_recipe_tag_;
 };
 
 }  // namespace rtde_interface
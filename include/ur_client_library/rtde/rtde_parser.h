@@ -19,6 +19,8 @@
  */
 
 #pragma once
+#include <functional>
+#include <memory>
 #include <vector>
 #include "ur_client_library/comm/parser.h"
 #include "ur_client_library/comm/bin_parser.h"
@@ -29,6 +31,7 @@
 #include "ur_client_library/rtde/control_package_setup_outputs.h"
 #include "ur_client_library/rtde/control_package_start.h"
 #include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/data_package_pool.h"
 #include "ur_client_library/rtde/get_urcontrol_version.h"
 #include "ur_client_library/rtde/package_header.h"
 #include "ur_client_library/rtde/request_protocol_version.h"
@@ -51,7 +54,8 @@ public:
    *
    * \param recipe The recipe used in RTDE data communication
    */
-  RTDEParser(const std::vector<std::string>& recipe) : recipe_(recipe), protocol_version_(1)
+  RTDEParser(const std::vector<std::string>& recipe)
+    : recipe_(CompiledRecipe::intern(recipe)), lazy_decoding_(false), protocol_version_(1)
   {
   }
   virtual ~RTDEParser() = default;
@@ -63,7 +67,7 @@ public:
    * \param results A vector of pointers to created RTDE package objects
    *
    * \returns True, if the byte stream could successfully be parsed as RTDE packages, false
-   * otherwise
+   * otherwise. If the package is truncated, \p bp is marked as failed additionally.
    */
   bool parse(comm::BinParser& bp, std::vector<std::unique_ptr<RTDEPackage>>& results)
 
@@ -73,7 +77,7 @@ public:
     bp.parse(size);
     bp.parse(type);
 
-    if (!bp.checkSize(size - sizeof(size) - sizeof(type)))
+    if (!bp.require(size - sizeof(size) - sizeof(type)))
     {
       URCL_LOG_ERROR("Buffer len shorter than expected packet length");
       return false;
@@ -83,9 +87,33 @@ public:
     {
       case PackageType::RTDE_DATA_PACKAGE:
       {
-        std::unique_ptr<RTDEPackage> package(new DataPackage(recipe_, protocol_version_));
+        OutputRecipe* output_recipe = findOutputRecipe(bp);
+        if (output_recipe != nullptr)
+        {
+          if (!output_recipe->package->parseWith(bp) || bp.failed())
+          {
+            URCL_LOG_ERROR("Package parsing of type %d failed!", static_cast<int>(type));
+            return false;
+          }
+          output_recipe->callback(*output_recipe->package);
+          break;
+        }
+
+        std::unique_ptr<RTDEPackage> package;
+        if (data_package_factory_)
+        {
+          package = data_package_factory_();
+        }
+        else if (data_package_pool_ != nullptr)
+        {
+          package = data_package_pool_->acquire();
+        }
+        else
+        {
+          package.reset(new DataPackage(std::atomic_load(&recipe_), protocol_version_, lazy_decoding_));
+        }
 
-        if (!package->parseWith(bp))
+        if (!package->parseWith(bp) || bp.failed())
         {
           URCL_LOG_ERROR("Package parsing of type %d failed!", static_cast<int>(type));
           return false;
@@ -96,7 +124,7 @@ public:
       default:
       {
         std::unique_ptr<RTDEPackage> package(packageFromType(type));
-        if (!package->parseWith(bp))
+        if (!package->parseWith(bp) || bp.failed())
         {
           URCL_LOG_ERROR("Package parsing of type %d failed!", static_cast<int>(type));
           return false;
@@ -121,8 +149,146 @@ public:
     protocol_version_ = protocol_version;
   }
 
+  /*!
+   * \brief Getter for the protocol version used to parse packages.
+   *
+   * \returns The RTDE protocol version
+   */
+  uint16_t getProtocolVersion() const
+  {
+    return protocol_version_;
+  }
+
+  /*!
+   * \brief Getter for the compiled recipe used for all parsed data packages.
+   *
+   * \returns The compiled output recipe
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return std::atomic_load(&recipe_);
+  }
+
+  /*!
+   * \brief Replaces the compiled recipe used for all data packages parsed afterwards, e.g. after the
+   * robot confirmed a new output recipe. The recipe is swapped atomically, so this can be called
+   * while another thread is parsing.
+   *
+   * A configured data package pool is removed, as it is bound to the previous recipe.
+   *
+   * \param recipe The new compiled output recipe
+   */
+  void setCompiledRecipe(std::shared_ptr<const CompiledRecipe> recipe)
+  {
+    data_package_pool_ = nullptr;
+    std::atomic_store(&recipe_, std::move(recipe));
+  }
+
+  /*!
+   * \brief Sets a pool to take data packages from instead of allocating a new package for every
+   * received data package. The pool has to be created for the parser's compiled recipe and
+   * protocol version.
+   *
+   * \param pool The pool to use. Pass a nullptr to allocate a new package for every data package.
+   */
+  void setDataPackagePool(std::shared_ptr<DataPackagePool> pool)
+  {
+    if (pool != nullptr && pool->getCompiledRecipe() != getCompiledRecipe())
+    {
+      throw UrException("The data package pool has to be created for the recipe used by the parser.");
+    }
+    data_package_pool_ = pool;
+  }
+
+  /*!
+   * \brief Sets a function creating the package objects data packages are parsed into, e.g. to
+   * create TypedDataPackage objects. A configured factory takes precedence over a data package pool.
+   *
+   * \param factory The function to create data package objects. Pass an empty function to use
+   * DataPackage objects.
+   */
+  void setDataPackageFactory(std::function<std::unique_ptr<RTDEPackage>()> factory)
+  {
+    data_package_factory_ = factory;
+  }
+
+  /*!
+   * \brief Checks whether data packages are created using a factory set with setDataPackageFactory().
+   */
+  bool hasDataPackageFactory() const
+  {
+    return static_cast<bool>(data_package_factory_);
+  }
+
+  /*!
+   * \brief Configures whether created data packages decode their fields while being parsed or once
+   * a field is accessed. Packages taken from a data package pool use the pool's configuration.
+   *
+   * \param lazy_decoding True to decode fields on access
+   */
+  void setLazyDecoding(const bool lazy_decoding)
+  {
+    lazy_decoding_ = lazy_decoding;
+  }
+
+  /*!
+   * \brief Registers an additional output recipe. Data packages using this recipe's id are parsed
+   * into a data package reused for every package of this recipe and handed to the given callback
+   * instead of being returned as parse results. This requires protocol version 2.
+   *
+   * \param recipe_id The output recipe id assigned by the robot
+   * \param recipe The additional output recipe
+   * \param callback Function to call with every parsed data package of this recipe
+   */
+  void addOutputRecipe(const uint8_t recipe_id, std::shared_ptr<const CompiledRecipe> recipe,
+                       std::function<void(DataPackage&)> callback)
+  {
+    OutputRecipe output_recipe;
+    output_recipe.recipe_id = recipe_id;
+    output_recipe.package = std::make_shared<DataPackage>(recipe, 2, lazy_decoding_);
+    output_recipe.package->initEmpty();
+    output_recipe.callback = callback;
+    output_recipes_.push_back(output_recipe);
+  }
+
+  /*!
+   * \brief Removes all additional output recipes registered using addOutputRecipe().
+   */
+  void clearOutputRecipes()
+  {
+    output_recipes_.clear();
+  }
+
 private:
-  std::vector<std::string> recipe_;
+  struct OutputRecipe
+  {
+    uint8_t recipe_id;
+    std::shared_ptr<DataPackage> package;
+    std::function<void(DataPackage&)> callback;
+  };
+
+  OutputRecipe* findOutputRecipe(comm::BinParser& bp)
+  {
+    if (protocol_version_ != 2 || output_recipes_.empty())
+    {
+      return nullptr;
+    }
+    const uint8_t recipe_id = bp.peek<uint8_t>();
+    for (auto& output_recipe : output_recipes_)
+    {
+      if (output_recipe.recipe_id == recipe_id)
+      {
+        return &output_recipe;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<OutputRecipe> output_recipes_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::shared_ptr<DataPackagePool> data_package_pool_;
+  std::function<std::unique_ptr<RTDEPackage>()> data_package_factory_;
+  bool lazy_decoding_;
   RTDEPackage* packageFromType(PackageType type)
   {
     switch (type)
@@ -0,0 +1,231 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Writes raw RTDE frames, exactly as they are read from the robot, to an append-only
+ * memory-mapped binary log.
+ *
+ * The log starts with a header containing the output recipe and the protocol version negotiated
+ * with the robot, followed by one record per frame. Each record consists of the time the frame was
+ * received as nanoseconds since the epoch (uint64), the frame size in bytes (uint32) and the raw
+ * frame. All header values are stored in network byte order. Recording a frame is a plain copy
+ * into the mapped file, the operating system takes care of writing it to disk. As the file is
+ * mapped shared, all recorded frames survive a crash of the recording process.
+ *
+ * The file grows in chunks of a configurable size and is truncated to the recorded data when the
+ * recorder is closed. Recordings can be read back using RTDERecording.
+ */
+class RTDERecorder
+{
+public:
+  //! Default size by which the log file grows when it is full
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024 * 1024;
+
+  RTDERecorder() = delete;
+
+  /*!
+   * \brief Creates a new RTDERecorder object. The file isn't touched until open() is called.
+   *
+   * \param path Path of the log file. An existing file will be overwritten.
+   * \param chunk_size Size in bytes by which the log file grows when it is full
+   */
+  explicit RTDERecorder(const std::string& path, const size_t chunk_size = DEFAULT_CHUNK_SIZE);
+  RTDERecorder(const RTDERecorder&) = delete;
+  RTDERecorder& operator=(const RTDERecorder&) = delete;
+  ~RTDERecorder();
+
+  /*!
+   * \brief Creates the log file and writes its header.
+   *
+   * \param recipe The output recipe of the recorded frames
+   * \param protocol_version The RTDE protocol version negotiated with the robot
+   *
+   * \throws UrException if the recorder is already open or the file cannot be created and mapped
+   */
+  void open(const std::vector<std::string>& recipe, const uint16_t protocol_version);
+
+  /*!
+   * \brief Appends a frame to the log.
+   *
+   * \param frame Buffer containing the raw frame including its package header
+   * \param size Size of the frame in bytes
+   * \param receive_time Time the frame was received
+   *
+   * \returns True on success, false if the recorder isn't open or the file couldn't be grown
+   */
+  bool record(const uint8_t* frame, const size_t size,
+              const std::chrono::system_clock::time_point receive_time = std::chrono::system_clock::now());
+
+  /*!
+   * \brief Unmaps the log file and truncates it to the recorded data. Frames recorded afterwards
+   * are dropped.
+   */
+  void close();
+
+  /*!
+   * \brief Checks whether the recorder is open.
+   *
+   * \returns True if frames can be recorded
+   */
+  bool isOpen() const;
+
+  /*!
+   * \brief Getter for the number of frames recorded since open() was called.
+   *
+   * \returns The number of recorded frames
+   */
+  size_t getNumFrames() const;
+
+  /*!
+   * \brief Getter for the number of bytes used in the log file including the header.
+   *
+   * \returns The size of the recorded data in bytes
+   */
+  size_t getSize() const;
+
+  //! Identifies RTDE recordings, stored at the beginning of the file
+  static constexpr char MAGIC[8] = { 'U', 'R', 'C', 'L', 'R', 'T', 'D', 'E' };
+  //! Version of the log format
+  static constexpr uint16_t FORMAT_VERSION = 1;
+  //! Size of the header preceding every recorded frame
+  static constexpr size_t RECORD_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+private:
+  bool reserve(const size_t size);
+  void unmap();
+
+  std::string path_;
+  size_t chunk_size_;
+  int fd_;
+  uint8_t* data_;
+  size_t capacity_;
+  size_t size_;
+  size_t num_frames_;
+  mutable std::mutex mutex_;
+};
+
+/*!
+ * \brief Reads back a log written by RTDERecorder.
+ *
+ * The file is mapped read-only and frames are returned without copying, so they are only valid
+ * as long as the RTDERecording object exists.
+ */
+class RTDERecording
+{
+public:
+  /*!
+   * \brief A single recorded frame.
+   */
+  struct Frame
+  {
+    //! Time the frame was received
+    std::chrono::system_clock::time_point receive_time;
+    //! Raw frame including its package header
+    const uint8_t* data;
+    //! Size of the frame in bytes
+    size_t size;
+  };
+
+  RTDERecording() = delete;
+
+  /*!
+   * \brief Opens a recording and reads its header.
+   *
+   * \param path Path of the log file
+   *
+   * \throws UrException if the file cannot be opened or isn't a valid RTDE recording
+   */
+  explicit RTDERecording(const std::string& path);
+  RTDERecording(const RTDERecording&) = delete;
+  RTDERecording& operator=(const RTDERecording&) = delete;
+  ~RTDERecording();
+
+  /*!
+   * \brief Getter for the output recipe of the recorded frames.
+   *
+   * \returns The output recipe
+   */
+  const std::vector<std::string>& getRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Getter for the RTDE protocol version used during the recording.
+   *
+   * \returns The protocol version
+   */
+  uint16_t getProtocolVersion() const
+  {
+    return protocol_version_;
+  }
+
+  /*!
+   * \brief Reads the next frame of the recording.
+   *
+   * A recording that wasn't closed properly ends at the first incomplete or empty record.
+   *
+   * \param frame Frame to fill
+   *
+   * \returns True if a frame was read, false at the end of the recording
+   */
+  bool next(Frame& frame);
+
+  /*!
+   * \brief Restarts reading at the first frame of the recording.
+   */
+  void rewind();
+
+private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t first_frame_;
+  size_t offset_;
+  std::vector<std::string> recipe_;
+  uint16_t protocol_version_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
@@ -0,0 +1,407 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_RELAY_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_RELAY_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ur_client_library/comm/tcp_server.h"
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Encodes data packages into compact frames for forwarding them over links with little
+ * bandwidth, see RelayDecoder for decoding them.
+ *
+ * Floating point values are quantised to integer multiples of a per-field resolution, integer
+ * fields are taken as they are. Each frame only contains the difference to the previous frame:
+ * the delta of the quantised floating point values and the XOR of integer values, stored as
+ * variable length integers. Fields that didn't change at all only take a single bit. Keyframes
+ * are encoded against a state of zeros, so a decoder can start decoding or recover from a lost
+ * frame with them.
+ *
+ * The decoder needs the header returned by getHeader(), which contains the field names and
+ * resolutions. Fields without a known data type aren't encoded.
+ */
+class RelayEncoder
+{
+public:
+  //! Default resolution of floating point values, i.e. 1 µrad for joint positions
+  static constexpr double DEFAULT_RESOLUTION = 1e-6;
+  //! Default number of frames in between two keyframes
+  static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 500;
+
+  RelayEncoder() = delete;
+
+  /*!
+   * \brief Creates a new RelayEncoder object.
+   *
+   * \param recipe Recipe of the encoded data packages
+   * \param resolution Resolution of all floating point fields without a resolution of their own
+   * \param field_resolutions Resolutions of single floating point fields by their names
+   * \param keyframe_interval Number of frames in between two keyframes, 0 to only encode a
+   * keyframe at first and upon requestKeyframe()
+   *
+   * \throws UrException if a resolution isn't positive or a field of \p field_resolutions isn't a
+   * floating point field of the recipe
+   */
+  explicit RelayEncoder(std::shared_ptr<const CompiledRecipe> recipe, const double resolution = DEFAULT_RESOLUTION,
+                        const std::unordered_map<std::string, double>& field_resolutions = {},
+                        const size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+  /*!
+   * \brief Encodes a data package into a frame.
+   *
+   * \param package The package to encode, it has to be based on the encoder's recipe
+   * \param frame Target for the frame, its previous content is replaced
+   *
+   * \returns False, if the package is based on a different recipe or hasn't been initialized,
+   * true otherwise
+   */
+  bool encode(const DataPackage& package, std::vector<uint8_t>& frame);
+
+  /*!
+   * \brief Makes the next frame a keyframe, e.g. once a new decoder joins or a frame got lost.
+   */
+  void requestKeyframe()
+  {
+    keyframe_requested_ = true;
+  }
+
+  /*!
+   * \brief Getter for the header, which has to be passed to a RelayDecoder.
+   */
+  const std::vector<uint8_t>& getHeader() const
+  {
+    return header_;
+  }
+
+  /*!
+   * \brief Getter for the recipe of the encoded data packages.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Checks whether a frame is a keyframe.
+   *
+   * \param frame The frame to check
+   * \param size Size of the frame in bytes
+   */
+  static bool isKeyframe(const uint8_t* frame, const size_t size);
+
+  //! Identifies relay headers, stored at the beginning of the header
+  static constexpr char MAGIC[8] = { 'U', 'R', 'C', 'L', 'R', 'L', 'A', 'Y' };
+  //! Version of the encoding
+  static constexpr uint16_t FORMAT_VERSION = 1;
+
+  //! Position of an element in the serialized data, i.e. a value of a field or an entry of a vector field
+  struct Element
+  {
+    size_t offset;
+    size_t size;
+    //! Resolution of floating point values, 0 for integers
+    double resolution;
+  };
+
+  //! Known fields of a recipe with their elements
+  struct Field
+  {
+    size_t first_element;
+    size_t num_elements;
+  };
+
+private:
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  size_t keyframe_interval_;
+  std::vector<Field> fields_;
+  std::vector<Element> elements_;
+  std::vector<uint8_t> header_;
+
+  std::vector<uint8_t> data_;
+  std::vector<uint64_t> reference_;
+  std::vector<uint64_t> values_;
+  uint64_t sequence_number_;
+  size_t frames_since_keyframe_;
+  bool keyframe_requested_;
+};
+
+/*!
+ * \brief Reconstructs data packages from the frames of a RelayEncoder.
+ *
+ * Frames have to be decoded in the order they have been encoded. After a frame has been lost,
+ * frames are rejected until the next keyframe arrives.
+ */
+class RelayDecoder
+{
+public:
+  RelayDecoder() = delete;
+
+  /*!
+   * \brief Creates a new RelayDecoder object.
+   *
+   * \param header Header of the encoder, see RelayEncoder::getHeader()
+   *
+   * \throws UrException if the header is invalid
+   */
+  explicit RelayDecoder(const std::vector<uint8_t>& header);
+
+  /*!
+   * \brief Decodes a frame into a data package.
+   *
+   * \param frame The frame to decode
+   * \param size Size of the frame in bytes
+   * \param package Target for the decoded data, it has to be based on the decoder's recipe
+   *
+   * \returns False, if the frame is malformed, the package is based on a different recipe or the
+   * decoder waits for a keyframe, true otherwise
+   */
+  bool decode(const uint8_t* frame, const size_t size, DataPackage& package);
+
+  /*!
+   * \brief Getter for the recipe of the decoded packages. It only contains the fields that have
+   * been encoded.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Checks whether the decoder has decoded a keyframe and no frame got lost since.
+   */
+  bool isSynchronized() const
+  {
+    return synchronized_;
+  }
+
+  /*!
+   * \brief Getter for the number of frames rejected because a previous frame got lost.
+   */
+  uint64_t getNumSkippedFrames() const
+  {
+    return num_skipped_frames_;
+  }
+
+private:
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::vector<RelayEncoder::Field> fields_;
+  std::vector<RelayEncoder::Element> elements_;
+
+  std::vector<uint64_t> reference_;
+  std::vector<uint64_t> values_;
+  std::vector<uint8_t> data_;
+  uint64_t sequence_number_;
+  bool synchronized_;
+  uint64_t num_skipped_frames_;
+};
+
+/*!
+ * \brief Forwards data packages to any number of remote monitors connecting via TCP, encoded by a
+ * RelayEncoder.
+ *
+ * Each message is prefixed by its size as a 32 bit unsigned integer in network byte order. A
+ * monitor connecting to the relay first receives the encoder's header, followed by the frames
+ * starting at the next keyframe. RTDERelayClient receives and decodes them.
+ *
+ * Packages are handed over to a thread of the relay, so the thread receiving RTDE data is never
+ * blocked by the network. If monitors can't keep up, frames are dropped and the next frame is a
+ * keyframe.
+ */
+class RTDERelay
+{
+public:
+  //! Default number of frames waiting to be sent, before frames are dropped
+  static constexpr size_t DEFAULT_QUEUE_SIZE = 64;
+
+  RTDERelay() = delete;
+
+  /*!
+   * \brief Creates a new RTDERelay object and starts its server.
+   *
+   * \param port Port to start the server on
+   * \param recipe Recipe of the forwarded data packages, e.g. RTDEClient::getCompiledOutputRecipe()
+   * \param decimation Only every n-th package is forwarded
+   * \param resolution Resolution of all floating point fields without a resolution of their own
+   * \param field_resolutions Resolutions of single floating point fields by their names
+   * \param queue_size Number of frames waiting to be sent, before frames are dropped
+   *
+   * \throws UrException if decimation or queue_size is 0 or a resolution is invalid, see
+   * RelayEncoder
+   */
+  RTDERelay(const uint32_t port, std::shared_ptr<const CompiledRecipe> recipe, const size_t decimation = 1,
+            const double resolution = RelayEncoder::DEFAULT_RESOLUTION,
+            const std::unordered_map<std::string, double>& field_resolutions = {},
+            const size_t queue_size = DEFAULT_QUEUE_SIZE);
+  RTDERelay(const RTDERelay&) = delete;
+  RTDERelay& operator=(const RTDERelay&) = delete;
+  ~RTDERelay();
+
+  /*!
+   * \brief Forwards a data package to all connected monitors. This must only be called from one
+   * thread, e.g. as observer registered using RTDEClient::addDataPackageObserver().
+   *
+   * \param package The package to forward, it has to be based on the relay's recipe
+   *
+   * \returns False, if the package is based on a different recipe, true otherwise
+   */
+  bool update(const DataPackage& package);
+
+  /*!
+   * \brief Getter for the number of connected monitors.
+   */
+  size_t getNumClients() const
+  {
+    return num_clients_;
+  }
+
+  /*!
+   * \brief Getter for the number of frames dropped, because the network couldn't keep up.
+   */
+  uint64_t getNumDroppedFrames() const
+  {
+    return num_dropped_frames_;
+  }
+
+  /*!
+   * \brief Getter for the number of bytes sent to all monitors together.
+   */
+  uint64_t getNumSentBytes() const
+  {
+    return num_sent_bytes_;
+  }
+
+private:
+  void connectionCallback(const int filedescriptor);
+  void disconnectionCallback(const int filedescriptor);
+  bool send(const int filedescriptor, const std::vector<uint8_t>& message);
+  void sendLoop();
+
+  RelayEncoder encoder_;
+  size_t decimation_;
+  size_t num_skipped_packages_;
+  std::atomic<uint64_t> num_dropped_frames_;
+  std::atomic<uint64_t> num_sent_bytes_;
+  std::atomic<size_t> num_clients_;
+  std::vector<uint8_t> frame_;
+
+  // Frames are passed to the sending thread in a ring of buffers, that are swapped in and out
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::vector<uint8_t>> queue_;
+  size_t queue_head_;
+  size_t queue_count_;
+  std::atomic<bool> keyframe_requested_;
+  std::vector<int> connected_;
+  std::vector<int> disconnected_;
+  bool running_;
+
+  std::thread send_thread_;
+  comm::TCPServer server_;
+};
+
+/*!
+ * \brief Connects to an RTDERelay and decodes the data packages it forwards.
+ */
+class RTDERelayClient : public comm::TCPSocket
+{
+public:
+  //! Maximum size of a message accepted from the relay
+  static constexpr uint32_t MAX_MESSAGE_SIZE = 1024 * 1024;
+
+  RTDERelayClient() = delete;
+
+  /*!
+   * \brief Creates a new RTDERelayClient object.
+   *
+   * \param host IP address of the relay
+   * \param port Port of the relay
+   */
+  RTDERelayClient(const std::string& host, const int port);
+
+  /*!
+   * \brief Connects to the relay and receives its header.
+   *
+   * \param max_num_tries Maximum number of connection attempts, 0 for trying indefinitely
+   * \param reconnection_time Time in between connection attempts
+   *
+   * \returns True on success, false if connecting failed or the header is invalid
+   */
+  bool connect(const size_t max_num_tries = 0,
+               const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10));
+
+  /*!
+   * \brief Receives the next data package from the relay. Frames received before the first
+   * keyframe are skipped.
+   *
+   * \param package Target for the data, it has to be based on getCompiledRecipe()
+   *
+   * \returns False, if the connection has been closed or the package is based on a different
+   * recipe, true otherwise
+   */
+  bool readPackage(DataPackage& package);
+
+  /*!
+   * \brief Getter for the recipe of the forwarded data packages. Only valid after connecting.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return decoder_ == nullptr ? nullptr : decoder_->getCompiledRecipe();
+  }
+
+private:
+  bool readMessage(std::vector<uint8_t>& message);
+
+  std::string host_;
+  int port_;
+  std::unique_ptr<RelayDecoder> decoder_;
+  std::vector<uint8_t> message_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_RELAY_H_INCLUDED
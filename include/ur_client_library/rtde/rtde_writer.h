@@ -35,17 +35,143 @@
 #include "ur_client_library/comm/stream.h"
 #include "ur_client_library/queue/readerwriterqueue.h"
 #include "ur_client_library/ur/datatypes.h"
+#include "ur_client_library/helpers.h"
+#include "ur_client_library/metrics.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
 #include <thread>
-#include <mutex>
+#include <vector>
 
 namespace urcl
 {
 namespace rtde_interface
 {
+/*!
+ * \brief Policies for when the RTDEWriter sends changed data to the robot.
+ */
+enum class FlushPolicy
+{
+  IMMEDIATE,  ///< Send a package as soon as data has been changed
+  PER_CYCLE,  ///< Send at most one package per RTDE cycle containing all changes made meanwhile
+  ON_COMMIT   ///< Only send a package when a transaction is committed
+};
+
+/*!
+ * \brief Outputs the RTDEWriter can ramp, see RTDEWriter::startRamp().
+ */
+enum class RampTarget
+{
+  SPEED_SLIDER = 0,              ///< speed_slider_fraction
+  STANDARD_ANALOG_OUTPUT_0 = 1,  ///< standard_analog_output_0
+  STANDARD_ANALOG_OUTPUT_1 = 2   ///< standard_analog_output_1
+};
+
+/*!
+ * \brief Shapes of the ramps of an RTDEWriter.
+ */
+enum class RampProfile
+{
+  LINEAR,  ///< Constant rate of change
+  SMOOTH   ///< Cosine shaped, starting and ending without a step in the rate of change
+};
+
+class RTDEWriter;
+
+/*!
+ * \brief A set of RTDE input registers exclusively owned by one subsystem, created using
+ * RTDEWriter::createInputRegisterBank().
+ *
+ * Subsystems writing disjoint registers each use their own bank instead of sharing the writer's
+ * send functions. New values are staged in the bank and handed to the writer using publish(),
+ * which neither locks nor allocates. All values of one publication are sent in the same package,
+ * which also contains the publications of other banks in the same RTDE cycle. A bank must only be
+ * used by one thread at a time and must not outlive its writer.
+ */
+class InputRegisterBank
+{
+public:
+  InputRegisterBank() = delete;
+  InputRegisterBank(const InputRegisterBank&) = delete;
+  InputRegisterBank& operator=(const InputRegisterBank&) = delete;
+
+  /*!
+   * \brief Releases the bank's registers, so they can be written using the writer's send
+   * functions or another bank again.
+   */
+  ~InputRegisterBank();
+
+  /*!
+   * \brief Stages a new value for an input_bit_register owned by this bank.
+   *
+   * \param register_id The id of the register that should be changed [64..127]
+   * \param value The new value
+   *
+   * \returns False, if the register isn't owned by this bank, true otherwise
+   */
+  bool setBitRegister(uint32_t register_id, bool value);
+
+  /*!
+   * \brief Stages a new value for an input_int_register owned by this bank.
+   *
+   * \param register_id The id of the register that should be changed [24..47]
+   * \param value The new value
+   *
+   * \returns False, if the register isn't owned by this bank, true otherwise
+   */
+  bool setIntRegister(uint32_t register_id, int32_t value);
+
+  /*!
+   * \brief Stages a new value for an input_double_register owned by this bank.
+   *
+   * \param register_id The id of the register that should be changed [24..47]
+   * \param value The new value
+   *
+   * \returns False, if the register isn't owned by this bank, true otherwise
+   */
+  bool setDoubleRegister(uint32_t register_id, double value);
+
+  /*!
+   * \brief Hands the staged values of all registers of the bank to the writer, which sends them
+   * according to its flush policy.
+   */
+  void publish();
+
+  /*!
+   * \brief Getter for the names of the registers owned by this bank.
+   */
+  const std::vector<std::string>& getRegisters() const
+  {
+    return registers_;
+  }
+
+private:
+  friend class RTDEWriter;
+  InputRegisterBank(RTDEWriter& writer, const std::vector<std::string>& registers,
+                    const std::vector<size_t>& field_indices);
+
+  bool stage(const size_t field_index, const uint64_t bits);
+
+  RTDEWriter& writer_;
+  std::vector<std::string> registers_;
+  // Recipe indices of the owned fields and their staged values
+  std::vector<size_t> field_indices_;
+  std::vector<uint64_t> staged_values_;
+};
+
 /*!
  * \brief The RTDEWriter class offers an abstraction layer to send data to the robot via the RTDE
  * interface. Several simple to use functions to create data packages to send exist, which are
  * then sent to the robot in an additional thread.
+ *
+ * The send functions don't lock or allocate. They store the new values in atomic slots and wake up
+ * the writer thread, which sends all changes made since its last package in one package. Changes
+ * to output pins are coalesced using the respective masks, so multiple commands issued within one
+ * RTDE cycle are all applied by the robot.
  */
 class RTDEWriter
 {
@@ -54,6 +180,9 @@ public:
   /*!
    * \brief Creates a new RTDEWriter object using a given URStream and recipe.
    *
+   * The package used for sending is laid out once from the recipe, so sending it only requires
+   * writing the current values to their fixed offsets in the outgoing frame.
+   *
    * \param stream The URStream to use for communication with the robot
    * \param recipe The recipe to use for communication
    */
@@ -68,17 +197,65 @@ public:
     }
   }
   /*!
-   * \brief Starts the writer thread, which periodically clears the queue to write packages to the
-   * robot.
+   * \brief Starts the writer thread, which sends a package to the robot whenever data has been
+   * changed.
    *
    * \param recipe_id The recipe id to use, so the robot correctly identifies the used recipe
+   * \param target_frequency The RTDE communication frequency. The writer thread will send at most
+   * one package per RTDE cycle. If set to 0, packages are sent as soon as data has changed.
+   *
+   * Sent packages and failed writes are reported to getMetricsRegistry(), labeled with the
+   * stream's host.
    */
-  void init(uint8_t recipe_id);
+  void init(uint8_t recipe_id, double target_frequency = 0.0);
   /*!
    * \brief The writer thread loop, continually serializing and sending packages to the robot.
    */
   void run();
 
+  /*!
+   * \brief Sets the policy for when changed data is sent to the robot. Defaults to
+   * FlushPolicy::PER_CYCLE.
+   *
+   * \param policy The new flush policy
+   */
+  void setFlushPolicy(const FlushPolicy policy)
+  {
+    flush_policy_ = policy;
+  }
+
+  /*!
+   * \brief Getter for the flush policy currently used.
+   */
+  FlushPolicy getFlushPolicy() const
+  {
+    return flush_policy_;
+  }
+
+  /*!
+   * \brief Sets scheduling, CPU affinity and name of the writer thread. They are applied when the
+   * writer thread is started and, if it is running already, immediately.
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Starts a transaction. Until the transaction is committed, data changed by any of the
+   * send functions is held back and then sent in one package.
+   *
+   * Transactions can be nested and are shared between all threads using this writer. Data is sent
+   * once the last open transaction is committed.
+   */
+  void beginTransaction();
+
+  /*!
+   * \brief Commits a transaction started with beginTransaction().
+   *
+   * \returns False, if there was no open transaction, true otherwise
+   */
+  bool commitTransaction();
+
   /*!
    * \brief Creates a package to request setting a new value for the speed slider.
    *
@@ -158,16 +335,194 @@ public:
    */
   bool sendInputDoubleRegister(uint32_t register_id, double value);
 
+  /*!
+   * \brief Creates a bank exclusively owning a set of input registers, see InputRegisterBank.
+   * While the bank exists, the registers can't be written using the send functions above.
+   *
+   * \param registers Names of the registers, e.g. "input_int_register_24". All of them have to be
+   * input_bit_register, input_int_register or input_double_register fields of the recipe.
+   *
+   * \throws UrException if a register isn't part of the recipe or is owned by another bank
+   *
+   * \returns The bank
+   */
+  std::unique_ptr<InputRegisterBank> createInputRegisterBank(const std::vector<std::string>& registers);
+
+  /*!
+   * \brief Ramps an output from one value to another, evaluated by the writer thread.
+   *
+   * While a ramp is running, the writer thread sends a package once per RTDE cycle, or every
+   * DEFAULT_RAMP_PERIOD if no target frequency has been given, containing the ramp's current
+   * value. This neither needs an application thread nor allocates per step. The ramp ends by
+   * sending \p end_value. A ramp started before for the same target is replaced. Values sent for
+   * the target using the send functions are overwritten by a running ramp. Ramps are sent
+   * regardless of the flush policy and open transactions.
+   *
+   * \param target The output to ramp
+   * \param start_value The value to start at, between 0.0 and 1.0
+   * \param end_value The value to end at, between 0.0 and 1.0
+   * \param duration Time to ramp from \p start_value to \p end_value
+   * \param profile Shape of the ramp
+   *
+   * \returns False, if a value is out of range or the target's fields are not part of the recipe,
+   * true otherwise
+   */
+  bool startRamp(const RampTarget target, const double start_value, const double end_value,
+                 const std::chrono::milliseconds duration, const RampProfile profile = RampProfile::LINEAR);
+
+  /*!
+   * \brief Stops a running ramp. The value sent last is kept.
+   *
+   * \param target The output whose ramp should be stopped
+   */
+  void cancelRamp(const RampTarget target);
+
+  /*!
+   * \brief Checks whether a ramp has been started for a target and hasn't ended yet.
+   *
+   * \param target The output to check
+   */
+  bool isRampActive(const RampTarget target) const;
+
+  //! Period of the ramp steps if the writer has been started without a target frequency
+  static constexpr std::chrono::microseconds DEFAULT_RAMP_PERIOD{ 2000 };
+
 private:
+  friend class InputRegisterBank;
+
+  template <typename T>
+  static uint64_t toBits(const T& value)
+  {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+  }
+
+  // Returns false and logs an error if the field is owned by a register bank
+  bool checkNotOwned(const size_t index) const;
+
+  // Stores the values of a bank, so they are all sent in the same package
+  void publishBank(const std::vector<size_t>& field_indices, const std::vector<uint64_t>& values);
+  void releaseBank(const std::vector<size_t>& field_indices);
   uint8_t pinToMask(uint8_t pin);
+
+  // Marks fields the send functions need, but which are not part of the recipe
+  static constexpr size_t NOT_IN_RECIPE = std::numeric_limits<size_t>::max();
+
+  // Pin fields consist of a mask selecting the pins to change and their values
+  struct PinFields
+  {
+    size_t mask;
+    size_t value;
+  };
+
+  // Returns the field's index, or NOT_IN_RECIPE if the recipe doesn't contain it with type T
+  template <typename T>
+  size_t resolveField(const std::string& name) const
+  {
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Input fields have to fit into a value slot");
+    size_t index;
+    if (!compiled_recipe_->findIndex(name, index))
+    {
+      return NOT_IN_RECIPE;
+    }
+    const CompiledRecipe::Field& field = compiled_recipe_->getFields()[index];
+    return field.known && std::holds_alternative<T>(field.empty_value) ? index : NOT_IN_RECIPE;
+  }
+
+  PinFields resolvePinFields(const std::string& name) const
+  {
+    return PinFields{ resolveField<uint8_t>(name + "_mask"), resolveField<uint8_t>(name) };
+  }
+
+  void resolveFields();
+
+  template <typename T>
+  void storeField(const size_t index, const T& value)
+  {
+    field_values_[index].store(toBits(value));
+  }
+
+  // Sets the given bits of a pin value field. Bits of other pins are only kept, if their mask bit
+  // is still waiting to be sent.
+  void mergeBits(const size_t value_index, const size_t mask_index, const uint8_t bits, const uint8_t value);
+  void notifyWriter();
+  void triggerSend();
+  void serializeFields();
+
+  static constexpr size_t NUM_RAMP_TARGETS = 3;
+
+  struct Ramp
+  {
+    double start_value = 0.0;
+    double end_value = 0.0;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::nanoseconds duration{ 0 };
+    RampProfile profile = RampProfile::LINEAR;
+    // False for requests cancelling a ramp
+    bool active = false;
+    uint64_t generation = 0;
+  };
+
+  // Resolves the fields of a ramp target, returns false if they are not part of the recipe
+  bool resolveRampFields(const RampTarget target, size_t& value_index, size_t& mask_index, uint32_t& mask) const;
+  void requestRamp(const RampTarget target, const Ramp& ramp);
+  // Takes over ramps started or cancelled by the application, only called by the writer thread
+  void applyRampRequests();
+  // Stores the current values of all running ramps, only called by the writer thread
+  void advanceRamps(const std::chrono::steady_clock::time_point now);
+
   comm::URStream<RTDEPackage>* stream_;
   std::vector<std::string> recipe_;
+  std::shared_ptr<const CompiledRecipe> compiled_recipe_;
   uint8_t recipe_id_;
-  moodycamel::BlockingReaderWriterQueue<std::unique_ptr<DataPackage>> queue_;
+  std::unique_ptr<std::atomic<uint64_t>[]> field_values_;
+  std::vector<bool> is_mask_;
+  // Whether a field is owned by a register bank
+  std::unique_ptr<std::atomic<bool>[]> field_owned_;
+  // Banks currently storing their values and the number of completed publications. The writer
+  // thread retries reading the values, if a publication overlapped with reading them.
+  std::atomic<int> publishing_banks_;
+  std::atomic<uint64_t> bank_publications_;
+  // Field values read by the writer thread before serializing them
+  std::vector<uint64_t> field_snapshot_;
+
+  // Indices of all fields the send functions can change, resolved once so sending doesn't have to
+  // look up field names
+  size_t speed_slider_mask_index_;
+  size_t speed_slider_fraction_index_;
+  PinFields standard_digital_output_fields_;
+  PinFields configurable_digital_output_fields_;
+  PinFields tool_digital_output_fields_;
+  size_t standard_analog_output_mask_index_;
+  size_t standard_analog_output_type_index_;
+  std::array<size_t, 2> standard_analog_output_indices_;
+  std::array<size_t, 64> input_bit_register_indices_;
+  std::array<size_t, 24> input_int_register_indices_;
+  std::array<size_t, 24> input_double_register_indices_;
+  std::vector<uint8_t> frame_;
+  std::atomic<bool> dirty_;
+  std::atomic<int> open_transactions_;
+  std::atomic<FlushPolicy> flush_policy_;
+  moodycamel::spsc_sema::LightweightSemaphore dirty_signal_;
   std::thread writer_thread_;
-  bool running_;
-  DataPackage package_;
-  std::mutex package_mutex_;
+  ThreadConfig thread_config_;
+  std::atomic<bool> running_;
+  std::chrono::microseconds cycle_time_;
+  Counter* packages_sent_metric_;
+  Counter* write_failures_metric_;
+
+  // Ramps requested by the application, taken over by the writer thread
+  PriorityInheritanceMutex ramp_mutex_;
+  std::array<Ramp, NUM_RAMP_TARGETS> requested_ramps_;
+  std::array<bool, NUM_RAMP_TARGETS> ramp_requested_;
+  std::atomic<bool> ramps_requested_;
+  // A ramp is active while its latest requested generation hasn't been finished
+  std::array<std::atomic<uint64_t>, NUM_RAMP_TARGETS> requested_generations_;
+  std::array<std::atomic<uint64_t>, NUM_RAMP_TARGETS> finished_generations_;
+  // Only used by the writer thread
+  std::array<Ramp, NUM_RAMP_TARGETS> ramps_;
+  size_t num_active_ramps_;
 };
 
 }  // namespace rtde_interface
@@ -0,0 +1,257 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SHARED_STATE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SHARED_STATE_H_INCLUDED
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Publishes data packages into a POSIX shared memory segment, so other processes on the
+ * same host can read the robot state without a connection to the robot of their own.
+ *
+ * The segment contains the output recipe and a ring of slots, each holding one data package in
+ * its compact binary form together with its receive time. Every slot is protected by a sequence
+ * lock, i.e. publishing never blocks and never waits for readers. There must only be one
+ * publisher per segment. Readers are implemented by SharedStateReader.
+ */
+class SharedStatePublisher
+{
+public:
+  //! Clock used for receive times. It is shared by all processes on the host.
+  using Clock = std::chrono::steady_clock;
+
+  //! Default number of slots in the ring
+  static constexpr size_t DEFAULT_SLOT_COUNT = 64;
+
+  SharedStatePublisher() = delete;
+
+  /*!
+   * \brief Creates the shared memory segment. An existing segment of the same name is replaced, if
+   * its publisher has been deactivated or its process is gone. Processes still reading it keep their
+   * mapping, but won't receive any further packages.
+   *
+   * \param name Name of the shared memory segment, e.g. "/urcl_rtde_state"
+   * \param recipe The recipe of the published data packages
+   * \param slot_count Number of slots in the ring. Readers falling behind by more than this
+   * number of packages miss packages.
+   * \param protocol_version Protocol version used for the RTDE communication
+   *
+   * \throws UrException if the slot count is 0, another publisher is still active on the segment
+   * or the segment cannot be created
+   */
+  SharedStatePublisher(const std::string& name, std::shared_ptr<const CompiledRecipe> recipe,
+                       const size_t slot_count = DEFAULT_SLOT_COUNT, const uint16_t protocol_version = 2);
+  SharedStatePublisher(const SharedStatePublisher&) = delete;
+  SharedStatePublisher& operator=(const SharedStatePublisher&) = delete;
+
+  /*!
+   * \brief Marks the segment as inactive and removes it, unless a new publisher replaced it
+   * already. Readers still having it mapped can detect this using SharedStateReader::isActive().
+   */
+  ~SharedStatePublisher();
+
+  /*!
+   * \brief Marks the segment as inactive without removing it, so a new publisher can replace it
+   * while this one is still referenced. No further packages are published.
+   */
+  void deactivate();
+
+  /*!
+   * \brief Writes a data package into the next slot of the ring, overwriting the oldest package.
+   *
+   * \param package The package to publish, it has to be based on the publisher's recipe
+   * \param receive_time Time the package has been received
+   *
+   * \returns False, if the package is based on a different recipe or the publisher has been
+   * deactivated, true otherwise
+   */
+  bool publish(const DataPackage& package, const Clock::time_point receive_time = Clock::now());
+
+  /*!
+   * \brief Getter for the name of the shared memory segment.
+   */
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /*!
+   * \brief Getter for the number of slots in the ring.
+   */
+  size_t getSlotCount() const
+  {
+    return slot_count_;
+  }
+
+  /*!
+   * \brief Getter for the recipe of the published data packages.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+private:
+  std::string name_;
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  size_t slot_count_;
+  size_t slot_size_;
+  size_t slots_offset_;
+  size_t segment_size_;
+  uint8_t* segment_;
+  // Identify the segment created, the name may refer to a newer segment later on
+  dev_t device_;
+  ino_t inode_;
+};
+
+/*!
+ * \brief Reads data packages published by a SharedStatePublisher, possibly in another process.
+ *
+ * Reading never blocks the publisher. A read copies the slot out of the shared memory and retries
+ * if the publisher overwrote the slot meanwhile. A reader must only be used by one thread at a
+ * time.
+ */
+class SharedStateReader
+{
+public:
+  //! Clock used for receive times
+  using Clock = SharedStatePublisher::Clock;
+
+  SharedStateReader() = delete;
+
+  /*!
+   * \brief Maps an existing shared memory segment read-only.
+   *
+   * \param name Name of the shared memory segment as passed to the publisher
+   *
+   * \throws UrException if the segment doesn't exist or hasn't been created by a
+   * SharedStatePublisher
+   */
+  explicit SharedStateReader(const std::string& name);
+  SharedStateReader(const SharedStateReader&) = delete;
+  SharedStateReader& operator=(const SharedStateReader&) = delete;
+  ~SharedStateReader();
+
+  /*!
+   * \brief Fills a data package with the most recently published package.
+   *
+   * \param package The package to fill, it has to be based on getCompiledRecipe()
+   * \param receive_time If not nullptr, filled with the time the package has been received
+   *
+   * \returns False, if nothing has been published yet, the package is based on a different recipe
+   * or the publisher kept overwriting the slot while reading it, true otherwise
+   */
+  bool readLatest(DataPackage& package, Clock::time_point* receive_time = nullptr);
+
+  /*!
+   * \brief Fills a data package with the next package published since the last call, so every
+   * package is read once. The first call returns the first package published after the reader has
+   * been created.
+   *
+   * \param package The package to fill, it has to be based on getCompiledRecipe()
+   * \param receive_time If not nullptr, filled with the time the package has been received
+   *
+   * \returns False, if no new package has been published or the package is based on a different
+   * recipe, true otherwise
+   */
+  bool readNext(DataPackage& package, Clock::time_point* receive_time = nullptr);
+
+  /*!
+   * \brief Getter for the number of packages readNext() skipped, because the publisher
+   * overwrote them before they were read.
+   */
+  uint64_t getMissedCount() const
+  {
+    return missed_count_;
+  }
+
+  /*!
+   * \brief Getter for the total number of packages published into the segment.
+   */
+  uint64_t getPublishedCount() const;
+
+  /*!
+   * \brief Checks whether the publisher is still publishing into the segment. Once this returns
+   * false, e.g. because the output recipe has been switched, a new reader has to be created.
+   */
+  bool isActive() const;
+
+  /*!
+   * \brief Getter for the recipe of the published data packages.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+  /*!
+   * \brief Getter for the protocol version used for the RTDE communication.
+   */
+  uint16_t getProtocolVersion() const
+  {
+    return protocol_version_;
+  }
+
+private:
+  // Copies the package with the given sequence number out of its slot. Returns false if it has
+  // been overwritten or is being written.
+  bool copySlot(const uint64_t package_number, Clock::time_point* receive_time);
+  bool fill(DataPackage& package);
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  uint16_t protocol_version_;
+  size_t slot_count_;
+  size_t slot_size_;
+  size_t slots_offset_;
+  size_t segment_size_;
+  const uint8_t* segment_;
+  std::vector<uint8_t> data_;
+  uint8_t recipe_id_;
+  uint64_t next_package_;
+  uint64_t missed_count_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_SHARED_STATE_H_INCLUDED
@@ -0,0 +1,332 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STATE_CACHE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STATE_CACHE_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Model used to predict the joint state at a later time, see
+ * StateSnapshot::predictJointState().
+ */
+enum class PredictionModel
+{
+  CONSTANT_VELOCITY,     ///< The joints keep moving with \p actual_qd
+  CONSTANT_ACCELERATION  ///< The joints keep accelerating like in between the last two packages
+};
+
+/*!
+ * \brief Copy of the robot state read from a StateCache.
+ *
+ * A snapshot holds the data fields in their compact binary form and decodes a field only when it
+ * is accessed. All memory is allocated when the snapshot is created, so it can be filled
+ * repeatedly from a real-time thread.
+ */
+class StateSnapshot
+{
+public:
+  //! Clock used for receive times
+  using Clock = std::chrono::steady_clock;
+
+  StateSnapshot() = delete;
+
+  /*!
+   * \brief Creates an empty snapshot.
+   *
+   * \param recipe The recipe of the cache the snapshot is filled from
+   */
+  explicit StateSnapshot(std::shared_ptr<const CompiledRecipe> recipe);
+
+  /*!
+   * \brief Get a data field from the snapshot using a handle resolved from the snapshot's recipe.
+   *
+   * @tparam T Type of the data field
+   *
+   * \param handle Handle of the data field
+   * \param val Target variable
+   *
+   * \throws std::bad_variant_access if the handle's type doesn't match the field's type
+   *
+   * \returns True on success, false if the snapshot hasn't been filled yet or the handle is invalid
+   */
+  template <typename T>
+  bool getData(const FieldHandle<T>& handle, T& val) const
+  {
+    if (!valid_ || !handle.isValid() || handle.getIndex() >= recipe_->getFields().size())
+    {
+      return false;
+    }
+    const CompiledRecipe::Field& field = recipe_->getFields()[handle.getIndex()];
+    if (!field.known)
+    {
+      return false;
+    }
+    if (!std::holds_alternative<T>(field.empty_value))
+    {
+      throw std::bad_variant_access();
+    }
+    // The BinParser only reads from the buffer
+    comm::BinParser bp(const_cast<uint8_t*>(data_.data()) + field.offset, field.size);
+    bp.parse(val);
+    return true;
+  }
+
+  /*!
+   * \brief Get a data field from the snapshot by its name. This looks up the field in every call,
+   * prefer resolving a FieldHandle once on real-time threads.
+   *
+   * @tparam T Type of the data field
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   * \param val Target variable
+   *
+   * \returns True on success, false if the snapshot hasn't been filled yet or the field isn't part
+   * of the recipe
+   */
+  template <typename T>
+  bool getData(const std::string& name, T& val) const
+  {
+    size_t index;
+    if (!recipe_->findIndex(name, index))
+    {
+      return false;
+    }
+    return getData(recipe_->getFieldHandle<T>(name), val);
+  }
+
+  /*!
+   * \brief Predicts the joint positions and velocities at a given time from \p actual_q and
+   * \p actual_qd, e.g. at the time a setpoint computed from the snapshot will be sent.
+   *
+   * The snapshot's state is assumed to be measured \p measurement_delay before it has been received,
+   * e.g. the measured latency of the connection to the robot. With
+   * PredictionModel::CONSTANT_ACCELERATION, the acceleration is estimated from \p actual_qd and
+   * \p timestamp of the last two packages written into the cache. If there is only one package, no
+   * acceleration is assumed.
+   *
+   * \param time Time to predict the joint state at
+   * \param q Target for the predicted joint positions
+   * \param qd Target for the predicted joint velocities
+   * \param model Model used for the prediction
+   * \param measurement_delay Time between measuring and receiving the state
+   *
+   * \returns False if the snapshot hasn't been filled yet or its recipe doesn't contain
+   * \p actual_q and \p actual_qd, true otherwise
+   */
+  bool predictJointState(const Clock::time_point time, vector6d_t& q, vector6d_t& qd,
+                         const PredictionModel model = PredictionModel::CONSTANT_VELOCITY,
+                         const std::chrono::microseconds measurement_delay = std::chrono::microseconds(0)) const;
+
+  /*!
+   * \brief Fills a data package with the snapshot's data.
+   *
+   * \param package The package to fill, it has to be based on the snapshot's recipe
+   *
+   * \returns False, if the snapshot hasn't been filled yet or the package is based on a different
+   * recipe, true otherwise
+   */
+  bool fill(DataPackage& package) const;
+
+  /*!
+   * \brief Checks whether the snapshot has been filled from a cache.
+   */
+  bool isValid() const
+  {
+    return valid_;
+  }
+
+  /*!
+   * \brief Getter for the number of the package in the cache, starting at 1 for the first
+   * package. Comparing it between two reads tells whether a new package has arrived in between.
+   */
+  uint64_t getPackageNumber() const
+  {
+    return package_number_;
+  }
+
+  /*!
+   * \brief Getter for the time the package has been received.
+   */
+  Clock::time_point getReceiveTime() const
+  {
+    return receive_time_;
+  }
+
+  /*!
+   * \brief Getter for the recipe ID of the package.
+   */
+  uint8_t getRecipeID() const
+  {
+    return recipe_id_;
+  }
+
+  /*!
+   * \brief Getter for the snapshot's recipe.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+private:
+  friend class StateCache;
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  std::vector<uint8_t> data_;
+  bool valid_;
+  uint64_t package_number_;
+  Clock::time_point receive_time_;
+  uint8_t recipe_id_;
+  FieldHandle<vector6d_t> actual_q_handle_;
+  FieldHandle<vector6d_t> actual_qd_handle_;
+  vector6d_t acceleration_;
+};
+
+/*!
+ * \brief Holds the latest data package received from the robot, so any number of threads can read
+ * the current robot state without taking packages from the RTDE client's queue.
+ *
+ * The cache is written by a single thread, usually the thread receiving RTDE data, and read using
+ * StateSnapshot objects. Two slots are protected by sequence locks and written alternately, so
+ * neither updating nor reading takes a lock or allocates memory. A read only has to be repeated if
+ * the writer overwrote the slot meanwhile, i.e. the reader has been interrupted for more than a
+ * whole RTDE cycle.
+ */
+class StateCache
+{
+public:
+  //! Clock used for receive times
+  using Clock = StateSnapshot::Clock;
+
+  //! Number of attempts of a read, before giving up on a slot that is overwritten continuously
+  static constexpr size_t MAX_READ_ATTEMPTS = 8;
+
+  StateCache() = delete;
+
+  /*!
+   * \brief Creates a new StateCache object. All memory is allocated upfront.
+   *
+   * \param recipe The recipe of the cached data packages
+   */
+  explicit StateCache(std::shared_ptr<const CompiledRecipe> recipe);
+  StateCache(const StateCache&) = delete;
+  StateCache& operator=(const StateCache&) = delete;
+
+  /*!
+   * \brief Replaces the cached state by a data package. This must only be called from one thread.
+   *
+   * \param package The new state, it has to be based on the cache's recipe
+   * \param receive_time Time the package has been received
+   *
+   * \returns False, if the package is based on a different recipe, true otherwise
+   */
+  bool update(const DataPackage& package, const Clock::time_point receive_time = Clock::now());
+
+  /*!
+   * \brief Copies the latest state into a snapshot. This can be called from any number of threads
+   * concurrently, each using its own snapshot.
+   *
+   * \param snapshot The snapshot to fill, it has to be based on the cache's recipe
+   *
+   * \returns False, if nothing has been cached yet, the snapshot is based on a different recipe or
+   * the state has been overwritten during all attempts of reading it, true otherwise
+   */
+  bool read(StateSnapshot& snapshot) const;
+
+  /*!
+   * \brief Creates a snapshot, that can be filled from this cache.
+   */
+  StateSnapshot createSnapshot() const
+  {
+    return StateSnapshot(recipe_);
+  }
+
+  /*!
+   * \brief Getter for the number of packages written into the cache.
+   */
+  uint64_t getUpdateCount() const
+  {
+    return update_count_.load(std::memory_order_acquire);
+  }
+
+  /*!
+   * \brief Getter for the recipe of the cached data packages.
+   */
+  std::shared_ptr<const CompiledRecipe> getCompiledRecipe() const
+  {
+    return recipe_;
+  }
+
+private:
+  struct alignas(64) Slot
+  {
+    //! Odd while the slot is being written
+    std::atomic<uint64_t> sequence{ 0 };
+    std::atomic<uint64_t> package_number{ 0 };
+    std::atomic<int64_t> receive_time_ns{ 0 };
+    std::atomic<uint8_t> recipe_id{ 0 };
+  };
+
+  //! Estimates the joint acceleration in between the last two packages, only called by the writer
+  vector6d_t estimateAcceleration(const DataPackage& package);
+
+  std::shared_ptr<const CompiledRecipe> recipe_;
+  size_t data_size_;
+  std::array<Slot, 2> slots_;
+  std::vector<uint8_t> data_;
+  // Written together with the data of the same slot
+  std::array<vector6d_t, 2> accelerations_;
+  alignas(64) std::atomic<uint64_t> update_count_;
+
+  // Only used by the writer
+  FieldHandle<double> timestamp_handle_;
+  FieldHandle<vector6d_t> actual_qd_handle_;
+  bool has_previous_;
+  double previous_timestamp_;
+  vector6d_t previous_qd_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_STATE_CACHE_H_INCLUDED
@@ -0,0 +1,142 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STATIC_RTDE_CONSUMER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STATIC_RTDE_CONSUMER_H_INCLUDED
+
+#include "ur_client_library/comm/static_consumer.h"
+#include "ur_client_library/rtde/control_package_pause.h"
+#include "ur_client_library/rtde/control_package_setup_inputs.h"
+#include "ur_client_library/rtde/control_package_setup_outputs.h"
+#include "ur_client_library/rtde/control_package_start.h"
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/get_urcontrol_version.h"
+#include "ur_client_library/rtde/request_protocol_version.h"
+#include "ur_client_library/rtde/rtde_package.h"
+#include "ur_client_library/rtde/text_message.h"
+#include "ur_client_library/rtde/typed_data_package.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Recognizes RTDE packages by their package type, as each received package type is
+ * represented by exactly one class.
+ */
+template <rtde_interface::PackageType TYPE>
+struct RTDEPackageTypeTraits
+{
+  static bool matches(const rtde_interface::RTDEPackage& product)
+  {
+    return product.getType() == TYPE;
+  }
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::DataPackage>
+{
+  static bool matches(const rtde_interface::RTDEPackage& product)
+  {
+    return product.getType() == rtde_interface::PackageType::RTDE_DATA_PACKAGE &&
+           product.getTypedRecipeTag() == nullptr;
+  }
+};
+
+template <typename RecipeT>
+struct PackageClassTraits<rtde_interface::TypedDataPackage<RecipeT>>
+{
+  static bool matches(const rtde_interface::RTDEPackage& product)
+  {
+    return product.getType() == rtde_interface::PackageType::RTDE_DATA_PACKAGE &&
+           product.getTypedRecipeTag() == rtde_interface::TypedDataPackage<RecipeT>::getRecipeTag();
+  }
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::TextMessage>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_TEXT_MESSAGE>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::RequestProtocolVersion>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_REQUEST_PROTOCOL_VERSION>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::GetUrcontrolVersion>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_GET_URCONTROL_VERSION>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::ControlPackageSetupOutputs>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::ControlPackageSetupInputs>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::ControlPackageStart>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_START>
+{
+};
+
+template <>
+struct PackageClassTraits<rtde_interface::ControlPackagePause>
+  : RTDEPackageTypeTraits<rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_PAUSE>
+{
+};
+}  // namespace comm
+
+namespace rtde_interface
+{
+/*!
+ * \brief RTDE consumer with statically dispatched handlers, see comm::StaticConsumer.
+ *
+ * Handled classes can be DataPackage, any TypedDataPackage and the received responses such as
+ * TextMessage or ControlPackageSetupOutputs.
+ *
+ * @tparam Derived The consumer class deriving from this class
+ * @tparam HandledT Package classes Derived provides a handle() function for
+ */
+template <typename Derived, typename... HandledT>
+using StaticRTDEConsumer = comm::StaticConsumer<Derived, RTDEPackage, HandledT...>;
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_STATIC_RTDE_CONSUMER_H_INCLUDED
@@ -0,0 +1,176 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STREAM_MONITOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STREAM_MONITOR_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Kinds of irregularities a StreamMonitor detects in the RTDE data stream.
+ */
+enum class StreamViolation
+{
+  MISSED_PACKAGES,   ///< The robot timestamp skipped one or more cycles
+  LATE_PACKAGE,      ///< A package arrived considerably later than one period after its predecessor
+  PIPELINE_OVERFLOW  ///< A package was discarded, because the pipeline's queue was full
+};
+
+/*!
+ * \brief Statistics about the timing of a received RTDE data stream.
+ */
+struct StreamStatistics
+{
+  //! Number of data packages checked
+  uint64_t num_packages = 0;
+  //! Number of packages the robot sent, but that never arrived, according to the robot timestamp
+  uint64_t num_missed = 0;
+  //! Number of packages that arrived later than the late tolerance allows
+  uint64_t num_late = 0;
+  //! Number of packages discarded by the pipeline because its queue was full
+  uint64_t num_overflows = 0;
+  //! Largest interval between the arrival of two consecutive packages
+  std::chrono::microseconds max_arrival_interval{ 0 };
+  //! Largest deviation of an arrival interval from the expected period
+  std::chrono::microseconds max_jitter{ 0 };
+  //! Mean deviation of the arrival intervals from the expected period
+  std::chrono::microseconds mean_jitter{ 0 };
+};
+
+/*!
+ * \brief Watches the arrival of RTDE data packages against the configured publishing frequency.
+ *
+ * The robot's \p timestamp field is used to detect cycles the robot published, but that were never
+ * received. The arrival times of the packages on the host are used to detect late packages and to
+ * measure the jitter of the stream. Whenever an irregularity is detected, an optional callback is
+ * called, which e.g. allows reporting it to a monitoring system.
+ */
+class StreamMonitor
+{
+public:
+  using ViolationCallback = std::function<void(const StreamViolation, const StreamStatistics&)>;
+
+  StreamMonitor();
+  virtual ~StreamMonitor() = default;
+
+  /*!
+   * \brief Binds the monitor to the recipe of the checked data packages.
+   *
+   * \param recipe The recipe of the data packages that will be checked
+   *
+   * \throws UrException if the recipe doesn't contain the \p timestamp field
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Sets the frequency the robot publishes the data packages with.
+   *
+   * \param frequency Publishing frequency in Hz
+   */
+  void setTargetFrequency(const double frequency);
+
+  /*!
+   * \brief Sets how much later than expected a package may arrive before it is counted as late.
+   * This also applies to the robot timestamp when detecting missed cycles. Defaults to 1.5.
+   *
+   * \param factor Multiple of the publishing period an interval may take
+   */
+  void setLateTolerance(const double factor);
+
+  /*!
+   * \brief Registers a callback that is called whenever a violation is detected. It is called on
+   * the thread reading from the robot and has to return quickly.
+   *
+   * \param callback Callback receiving the kind of violation and the updated statistics
+   */
+  void setViolationCallback(ViolationCallback callback);
+
+  /*!
+   * \brief Checks a received data package.
+   *
+   * \param package The data package to check, it has to be based on the recipe passed to
+   * setRecipe()
+   * \param arrival_time The time the package was received
+   */
+  void update(const DataPackage& package, const std::chrono::steady_clock::time_point arrival_time);
+
+  /*!
+   * \brief Counts a package that has been discarded by the pipeline.
+   */
+  void reportOverflow();
+
+  /*!
+   * \brief Forgets the previously checked package, e.g. after the stream has been paused, so the
+   * gap isn't counted as missed packages. The statistics are kept.
+   */
+  void restart();
+
+  /*!
+   * \brief Resets all statistics.
+   */
+  void reset();
+
+  /*!
+   * \brief Getter for the current statistics.
+   *
+   * \returns A copy of the current statistics
+   */
+  StreamStatistics getStatistics() const;
+
+private:
+  void notify(const StreamViolation violation, const StreamStatistics& statistics);
+
+  mutable std::mutex mutex_;
+  FieldHandle<double> timestamp_handle_;
+  double period_;
+  double late_tolerance_;
+  ViolationCallback callback_;
+
+  bool has_previous_;
+  double previous_timestamp_;
+  std::chrono::steady_clock::time_point previous_arrival_;
+  std::chrono::microseconds jitter_sum_;
+  uint64_t num_intervals_;
+  StreamStatistics statistics_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_STREAM_MONITOR_H_INCLUDED
@@ -0,0 +1,167 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STREAM_WATCHDOG_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STREAM_WATCHDOG_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Detects an RTDE data stream that stopped within a few publishing periods.
+ *
+ * A dead connection to the robot is noticed by the socket only after its receive timeout of a
+ * second. The watchdog instead expects a package with an advancing robot \p timestamp every
+ * publishing period and declares the stream stale, once none arrived for a configurable number of
+ * periods. Packages repeating the previous timestamp don't count as fresh. The deadline is watched
+ * by a thread of its own, so staleness is reported even if no package arrives at all.
+ */
+class StreamWatchdog
+{
+public:
+  //! Called with true once the stream became stale and with false once it is fresh again
+  using StaleCallback = std::function<void(bool)>;
+
+  //! Default number of periods without a fresh package before the stream is stale
+  static const size_t DEFAULT_MISSED_PERIODS = 3;
+
+  StreamWatchdog();
+  StreamWatchdog(const StreamWatchdog&) = delete;
+  StreamWatchdog& operator=(const StreamWatchdog&) = delete;
+  ~StreamWatchdog();
+
+  /*!
+   * \brief Binds the watchdog to the recipe of the checked data packages.
+   *
+   * \param recipe The recipe of the data packages that will be checked
+   *
+   * \throws UrException if the recipe doesn't contain the \p timestamp field
+   */
+  void setRecipe(const CompiledRecipe& recipe);
+
+  /*!
+   * \brief Sets the frequency the robot publishes the data packages with.
+   *
+   * \param frequency Publishing frequency in Hz
+   *
+   * \throws UrException if the frequency isn't positive
+   */
+  void setTargetFrequency(const double frequency);
+
+  /*!
+   * \brief Sets the number of publishing periods without a fresh package, after which the stream
+   * is stale.
+   *
+   * \param missed_periods Number of periods, at least 1
+   *
+   * \throws UrException if the number is 0
+   */
+  void setMissedPeriods(const size_t missed_periods);
+
+  /*!
+   * \brief Registers a callback for changes of the stream's staleness.
+   *
+   * The callback is called with true on the watchdog's thread and with false on the thread calling
+   * update(), i.e. the thread reading from the robot. It has to return quickly.
+   *
+   * \param callback The callback to register
+   */
+  void setStaleCallback(StaleCallback callback);
+
+  /*!
+   * \brief Checks a received data package, feeding the watchdog if its robot timestamp advanced.
+   * The watchdog is armed by the first package after start().
+   *
+   * \param package The data package to check, it has to be based on the recipe passed to
+   * setRecipe()
+   * \param arrival_time The time the package was received
+   */
+  void update(const DataPackage& package, const std::chrono::steady_clock::time_point arrival_time);
+
+  /*!
+   * \brief Starts watching the stream. The watchdog is armed by the first package received.
+   */
+  void start();
+
+  /*!
+   * \brief Stops watching the stream, e.g. while it is paused. A stale stream stays stale until the
+   * next fresh package.
+   */
+  void stop();
+
+  /*!
+   * \brief Checks whether the stream is stale.
+   */
+  bool isStale() const;
+
+  /*!
+   * \brief Getter for the number of times the stream became stale.
+   */
+  uint64_t getNumStaleEvents() const;
+
+  /*!
+   * \brief Getter for the time without a fresh package, after which the stream is stale.
+   */
+  std::chrono::steady_clock::duration getTimeout() const;
+
+private:
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  bool keep_running_;
+  FieldHandle<double> timestamp_handle_;
+  double period_;
+  size_t missed_periods_;
+  StaleCallback callback_;
+  bool watching_;
+  bool armed_;
+  bool stale_;
+  bool has_timestamp_;
+  double last_timestamp_;
+  std::chrono::steady_clock::time_point deadline_;
+  uint64_t num_stale_events_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_STREAM_WATCHDOG_H_INCLUDED
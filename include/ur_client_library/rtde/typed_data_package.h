@@ -0,0 +1,214 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TYPED_DATA_PACKAGE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TYPED_DATA_PACKAGE_H_INCLUDED
+
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace detail
+{
+template <typename T, typename VariantT>
+struct IsVariantMember;
+
+template <typename T, typename... Ts>
+struct IsVariantMember<T, std::variant<Ts...>> : std::disjunction<std::is_same<T, Ts>...>
+{
+};
+}  // namespace detail
+
+/*!
+ * \brief Describes one data field of a typed recipe, see TypedDataPackage.
+ *
+ * @tparam RecipeT The struct holding the recipe's data
+ * @tparam T Type of the data field
+ */
+template <typename RecipeT, typename T>
+struct RecipeField
+{
+  static_assert(detail::IsVariantMember<T, rtde_type_variant>::value && !std::is_same<T, std::string>::value,
+                "Recipe fields have to use one of the data types of the RTDE interface");
+
+  constexpr RecipeField(const char* field_name, T RecipeT::*field_member) : name(field_name), member(field_member)
+  {
+  }
+
+  //! The string identifier for the data field as used in the documentation
+  const char* name;
+  //! The struct member holding the field's data
+  T RecipeT::*member;
+};
+
+/*!
+ * \brief A data package for a recipe, that is defined at compile time.
+ *
+ * The recipe is given as a struct containing one member per data field and a static constexpr
+ * function fields() listing all data fields in recipe order:
+ *
+ * \code{.cpp}
+ * struct JointState
+ * {
+ *   double timestamp;
+ *   vector6d_t actual_q;
+ *
+ *   static constexpr auto fields()
+ *   {
+ *     return std::make_tuple(RecipeField("timestamp", &JointState::timestamp),
+ *                            RecipeField("actual_q", &JointState::actual_q));
+ *   }
+ * };
+ * \endcode
+ *
+ * Parsing a package decodes all fields directly into the struct members without any lookup at
+ * runtime.
+ *
+ * @tparam RecipeT The struct defining the recipe
+ */
+template <typename RecipeT>
+class TypedDataPackage : public RTDEPackage
+{
+public:
+  /*!
+   * \brief Creates a new TypedDataPackage object.
+   *
+   * \param protocol_version Protocol version used for the RTDE communication
+   */
+  explicit TypedDataPackage(const uint16_t protocol_version = 2)
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE, getRecipeTag()), data(), recipe_id_(0), protocol_version_(protocol_version)
+  {
+  }
+  virtual ~TypedDataPackage() = default;
+
+  /*!
+   * \brief Getter for the recipe as list of field names, e.g. to construct an RTDEClient.
+   *
+   * \returns The field names in recipe order
+   */
+  static std::vector<std::string> getRecipe()
+  {
+    std::vector<std::string> recipe;
+    std::apply([&recipe](auto&&... fields) { (recipe.push_back(fields.name), ...); }, RecipeT::fields());
+    return recipe;
+  }
+
+  /*!
+   * \brief Getter for a tag uniquely identifying the typed recipe. Together with the package type,
+   * this allows casting packages to the correct TypedDataPackage class without needing RTTI.
+   *
+   * \returns An address unique to this typed recipe
+   */
+  static const void* getRecipeTag()
+  {
+    static const char tag = 0;
+    return &tag;
+  }
+
+  /*!
+   * \brief Checks whether a compiled recipe contains exactly the fields of this typed recipe, in the
+   * same order and with the same data types.
+   *
+   * \param recipe The compiled recipe to check
+   *
+   * \returns True if the recipes match, false otherwise
+   */
+  static bool matches(const CompiledRecipe& recipe)
+  {
+    const std::vector<CompiledRecipe::Field>& compiled_fields = recipe.getFields();
+    if (compiled_fields.size() != std::tuple_size<decltype(RecipeT::fields())>::value)
+    {
+      return false;
+    }
+    size_t i = 0;
+    bool match = true;
+    std::apply(
+        [&](auto&&... fields) {
+          ((match = match && compiled_fields[i].known && compiled_fields[i].name == fields.name &&
+                    std::holds_alternative<std::remove_reference_t<decltype(std::declval<RecipeT&>().*(fields.member))>>(
+                        compiled_fields[i].empty_value),
+            ++i),
+           ...);
+        },
+        RecipeT::fields());
+    return match;
+  }
+
+  /*!
+   * \brief Sets the attributes of the package by parsing a serialized representation of the
+   * package.
+   *
+   * \param bp A parser containing a serialized version of the package
+   *
+   * \returns True, if the package was parsed successfully, false otherwise
+   */
+  virtual bool parseWith(comm::BinParser& bp)
+  {
+    if (protocol_version_ == 2)
+    {
+      bp.parse(recipe_id_);
+    }
+    std::apply([this, &bp](auto&&... fields) { (bp.parse(data.*(fields.member)), ...); }, RecipeT::fields());
+    return true;
+  }
+
+  /*!
+   * \brief Produces a human readable representation of the package object.
+   *
+   * \returns A string representing the object
+   */
+  virtual std::string toString() const
+  {
+    std::stringstream ss;
+    std::apply(
+        [this, &ss](auto&&... fields) { ((ss << fields.name << ": " << data.*(fields.member) << std::endl), ...); },
+        RecipeT::fields());
+    return ss.str();
+  }
+
+  //! The data of the package
+  RecipeT data;
+
+private:
+  uint8_t recipe_id_;
+  uint16_t protocol_version_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TYPED_DATA_PACKAGE_H_INCLUDED
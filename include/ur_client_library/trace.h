@@ -0,0 +1,147 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRACE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRACE_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Records a trace event if the library has been built with the URCL_TRACING CMake option.
+ * Otherwise, trace points expand to nothing, including the evaluation of their argument.
+ *
+ * \param point The urcl::TracePoint reached
+ * \param argument Value identifying what has been processed, see urcl::TracePoint
+ */
+#ifdef URCL_TRACING
+#define URCL_TRACE(point, argument) urcl::recordTraceEvent(point, argument)
+#else
+#define URCL_TRACE(point, argument)                                                                                    \
+  do                                                                                                                   \
+  {                                                                                                                    \
+  } while (false)
+#endif
+
+namespace urcl
+{
+/*!
+ * \brief Stages of a package's way through the library, from the socket to the consumer and back to
+ * the robot.
+ *
+ * Events of a package carry the time it has been received as steady clock nanoseconds as
+ * argument, so the stages of one package can be matched across threads.
+ */
+enum class TracePoint : uint8_t
+{
+  SOCKET_READ,             //!< A read from a socket returned, the argument is the number of bytes
+  PARSE_DONE,              //!< A frame has been parsed, the argument identifies the first package
+  PIPELINE_ENQUEUE,        //!< A package has been put into a pipeline's queue
+  PIPELINE_DEQUEUE,        //!< A package has been taken from a pipeline's queue
+  CONSUMER_INVOKED,        //!< A pipeline's consumer is called with a package
+  CONSUMER_DONE,           //!< A pipeline's consumer has returned
+  REVERSE_INTERFACE_WRITE  //!< A command has been sent to the robot, the argument is the number of bytes
+};
+
+/*!
+ * \brief Converts a trace point to a string.
+ *
+ * \param point The trace point
+ *
+ * \returns The name of the trace point, e.g. "SOCKET_READ"
+ */
+std::string tracePointToString(const TracePoint point);
+
+/*!
+ * \brief A trace point reached by a thread.
+ */
+struct TraceEvent
+{
+  std::chrono::steady_clock::time_point time;
+  uint32_t thread_id;  //!< Kernel thread id
+  TracePoint point;
+  uint64_t argument;
+};
+
+//! Number of events kept, older events are overwritten
+constexpr size_t TRACE_BUFFER_SIZE = 1 << 16;
+
+/*!
+ * \brief Records an event in the trace buffer. Use the URCL_TRACE macro instead, which removes the
+ * call if tracing is disabled.
+ *
+ * Recording is lock-free and costs a clock read and a few relaxed atomic operations.
+ *
+ * \param point The trace point reached
+ * \param argument Value identifying what has been processed
+ */
+void recordTraceEvent(const TracePoint point, const uint64_t argument);
+
+/*!
+ * \brief Identifies a package in trace events by the time it has been received.
+ *
+ * \param receive_time The package's receive timestamp
+ *
+ * \returns The argument to pass to URCL_TRACE
+ */
+inline uint64_t tracePackageId(const std::chrono::steady_clock::time_point receive_time)
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count());
+}
+
+/*!
+ * \brief Reads the events in the trace buffer, which is at most the last TRACE_BUFFER_SIZE events.
+ * Events being overwritten while reading are skipped.
+ *
+ * \returns The events sorted by time
+ */
+std::vector<TraceEvent> getTraceEvents();
+
+/*!
+ * \brief Removes all events from the trace buffer. Events recorded concurrently might be kept.
+ */
+void clearTraceEvents();
+
+/*!
+ * \brief Converts events to the Trace Event Format understood by e.g. chrome://tracing and
+ * Perfetto, with one track per thread.
+ *
+ * \param events Events as returned by getTraceEvents()
+ *
+ * \returns A JSON document
+ */
+std::string traceEventsToJson(const std::vector<TraceEvent>& events);
+
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRACE_H_INCLUDED
@@ -28,9 +28,13 @@
 #ifndef UR_CLIENT_LIBRARY_UR_CALIBRATION_CHECKER_H_INCLUDED
 #define UR_CLIENT_LIBRARY_UR_CALIBRATION_CHECKER_H_INCLUDED
 
+#include <atomic>
+
 #include <ur_client_library/comm/pipeline.h>
 
 #include <ur_client_library/primary/robot_state/kinematics_info.h>
+#include <ur_client_library/primary/robot_state_frame.h>
+#include <ur_client_library/primary/static_primary_consumer.h>
 
 namespace urcl
 {
@@ -39,7 +43,9 @@ namespace urcl
  * packages. These are then checked against the used kinematics to see if the correct calibration
  * is used.
  */
-class CalibrationChecker : public comm::IConsumer<primary_interface::PrimaryPackage>
+class CalibrationChecker
+  : public primary_interface::StaticPrimaryConsumer<CalibrationChecker, primary_interface::KinematicsInfo,
+                                                    primary_interface::RobotStateFrame>
 {
 public:
   /*!
@@ -77,14 +83,23 @@ public:
   }
 
   /*!
-   * \brief Consumes a package, checking its hash if it is a KinematicsInfo package. If the hash
-   * does not match the expected hash, an error is logged.
+   * \brief Checks the hash of a KinematicsInfo package. If the hash does not match the expected
+   * hash, checkSuccessful() returns false.
    *
-   * \param product The package to consume
+   * \param kin_info The package to check
    *
    * \returns True, if the package was consumed correctly
    */
-  virtual bool consume(std::shared_ptr<primary_interface::PrimaryPackage> product);
+  bool handle(primary_interface::KinematicsInfo& kin_info);
+
+  /*!
+   * \brief Checks the KinematicsInfo package contained in a robot state frame, if any.
+   *
+   * \param frame The frame to check
+   *
+   * \returns True, if the frame was consumed correctly
+   */
+  bool handle(primary_interface::RobotStateFrame& frame);
 
   /*!
    * \brief Used to make sure the calibration check is not performed several times.
@@ -109,8 +124,8 @@ public:
 
 private:
   std::string expected_hash_;
-  bool checked_;
-  bool matches_;
+  std::atomic<bool> checked_;
+  std::atomic<bool> matches_;
 };
 }  // namespace urcl
 
@@ -28,11 +28,34 @@
 #ifndef UR_ROBOT_DRIVER_DASHBOARD_CLIENT_DASHBOARD_CLIENT_H_INCLUDED
 #define UR_ROBOT_DRIVER_DASHBOARD_CLIENT_DASHBOARD_CLIENT_H_INCLUDED
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <ur_client_library/comm/tcp_socket.h>
-#include <ur_client_library/ur/version_information.h>
+#include <ur_client_library/ur/datatypes.h>
+#include <ur_client_library/ur/version_capabilities.h>
 
 namespace urcl
 {
+namespace rtde_interface
+{
+class RTDEClient;
+}
+
+/*!
+ * \brief Answers of the dashboard server describing the robot's current status.
+ */
+struct DashboardStatus
+{
+  std::string robot_mode;      ///< Answer to "robotmode"
+  std::string safety_mode;     ///< Answer to "safetymode"
+  std::string program_state;   ///< Answer to "programState"
+  std::string loaded_program;  ///< Answer to "get loaded program"
+};
+
 /*!
  * \brief This class is a wrapper around the dashboard server.
  *
@@ -85,6 +108,21 @@ public:
    */
   std::string sendAndReceive(const std::string& command);
 
+  /*!
+   * \brief Sends several commands at once and reads their answers afterwards.
+   *
+   * Sending all commands before reading the first answer saves a round trip to the server per
+   * command, e.g. when polling the status of a robot frequently.
+   *
+   * \param commands Commands that will be sent to the server.
+   *
+   * \throws UrException if the commands could not be sent
+   * \throws TimeoutException if not all answers were read from the dashboard server in time
+   *
+   * \returns The answers in the order of the commands, cut off any trailing newlines.
+   */
+  std::vector<std::string> sendAndReceive(const std::vector<std::string>& commands);
+
   /*!
    * \brief Sends command and compare it with the expected answer
    *
@@ -137,6 +175,19 @@ public:
                     const std::chrono::duration<double> timeout,
                     const std::chrono::duration<double> retry_period = std::chrono::seconds(1));
 
+  /*!
+   * \brief Confirms state changes using the robot mode and runtime state received by an RTDE client
+   * instead of polling the dashboard server.
+   *
+   * Once the RTDE client has received data, commands such as commandPowerOn(), commandBrakeRelease()
+   * or commandPlay() return as soon as the resulting state is observed on RTDE. Until then, the
+   * dashboard server is polled as before. This has to be called before the RTDE client is started
+   * and its output recipe has to contain "robot_mode" and "runtime_state".
+   *
+   * \param rtde_client The RTDE client to observe
+   */
+  void attachRTDEClient(rtde_interface::RTDEClient& rtde_client);
+
   /*!
    * \brief Send Power off command
    *
@@ -292,6 +343,15 @@ public:
    */
   bool commandPolyscopeVersion(std::string& polyscope_version);
 
+  /*!
+   * \brief Getter for the capabilities of the PolyScope version queried when connecting. Nothing
+   * is supported before the version has been queried.
+   */
+  const VersionCapabilities& getVersionCapabilities() const
+  {
+    return capabilities_;
+  }
+
   /*!
    * \brief Get Robot model
    *
@@ -355,6 +415,15 @@ public:
    */
   bool commandProgramState(std::string& program_state);
 
+  /*!
+   * \brief Get Robot mode, Safety mode, Program state and the loaded program with a single round trip
+   *
+   * \param status The answers of the dashboard server
+   *
+   * \return True succeeded
+   */
+  bool commandGetStatus(DashboardStatus& status);
+
   /*!
    * \brief Get Operational mode
    *
@@ -436,18 +505,21 @@ public:
 
 private:
   /*!
-   * \brief Makes sure that the dashboard_server's version is above the required version
+   * \brief Makes sure that the dashboard server's version supports a call
    *
-   * \param e_series_min_ver SW version for e-Series
-   * \param cb3_min_ver SW version for cb3
-   * \param required_call The dashboard call that should be checked
+   * \param command The dashboard call that should be checked
    *
-   * \throws UrException if the robot's version isn't large enough
+   * \throws UrException if the robot's version doesn't support the call
    */
-  void assertVersion(const std::string& e_series_min_ver, const std::string& cb3_min_ver,
-                     const std::string& required_call);
+  void assertSupported(const DashboardCommand command) const;
   bool send(const std::string& text);
   std::string read();
+  // Wait for a state either observed on RTDE or polled from the dashboard server
+  bool waitForRobotMode(const RobotMode mode, const std::chrono::duration<double> timeout);
+  bool waitForRuntimeState(const RuntimeState state, const std::string& expected_program_state,
+                           const std::chrono::duration<double> timeout);
+  // Matches a string against a regex pattern, which is only compiled on its first use
+  static bool matches(const std::string& str, const std::string& pattern);
   void rtrim(std::string& str, const std::string& chars = "\t\n\v\f\r ");
 
   /*!
@@ -458,10 +530,24 @@ private:
    */
   timeval getConfiguredReceiveTimeout() const;
 
-  VersionInformation polyscope_version_;
+  VersionCapabilities capabilities_;
   std::string host_;
   int port_;
   std::mutex write_mutex_;
+  std::string read_buffer_;
+
+  // State received by an attached RTDE client. It is shared with the RTDE client's callbacks, so it
+  // stays valid even if the RTDE client outlives this object.
+  struct RTDEState
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool has_robot_mode = false;
+    int32_t robot_mode = 0;
+    bool has_runtime_state = false;
+    uint32_t runtime_state = 0;
+  };
+  std::shared_ptr<RTDEState> rtde_state_;
 };
 }  // namespace urcl
 #endif  // ifndef UR_ROBOT_DRIVER_DASHBOARD_CLIENT_DASHBOARD_CLIENT_H_INCLUDED
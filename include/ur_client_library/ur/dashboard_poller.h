@@ -0,0 +1,157 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_DASHBOARD_POLLER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_DASHBOARD_POLLER_H_INCLUDED
+
+#include <sys/socket.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "ur_client_library/comm/reactor.h"
+#include "ur_client_library/ur/dashboard_client.h"
+#include "ur_client_library/ur/datatypes.h"
+
+namespace urcl
+{
+/*!
+ * \brief Status of a robot as polled from its dashboard server.
+ *
+ * Values the robot didn't report, e.g. the operational mode on CB3 robots, are left empty.
+ */
+struct DashboardPollResult
+{
+  //! False if the robot couldn't be reached or didn't answer within the timeout
+  bool connected = false;
+  std::optional<RobotMode> robot_mode;
+  std::optional<SafetyStatus> safety_status;
+  std::optional<OperationalMode> operational_mode;
+  //! Time between sending the queries and receiving the last answer
+  std::chrono::steady_clock::duration round_trip_time{};
+};
+
+/*!
+ * \brief Periodically polls the status of many robots from their dashboard servers.
+ *
+ * The poller keeps one connection per robot open and handles all of them on a single event loop of
+ * a comm::Reactor, so polling a fleet of robots doesn't need a thread per robot. In every period,
+ * the robot mode, safety status and operational mode are queried at once. If a robot doesn't
+ * answer within the timeout, its connection is closed and established again in the next period.
+ */
+class DashboardPoller
+{
+public:
+  //! Called on the event loop thread with the result of every poll, it has to return quickly
+  using ResultCallback = std::function<void(const DashboardPollResult&)>;
+
+  /*!
+   * \brief Creates a new DashboardPoller object.
+   *
+   * \param reactor The reactor to run on, e.g. the one of a UrDriverGroup. If nullptr, the poller
+   * creates a reactor with a single event loop on its own.
+   * \param period Time between two polls of a robot
+   * \param timeout Maximum time for connecting to a robot and for a robot to answer all queries
+   */
+  explicit DashboardPoller(std::shared_ptr<comm::Reactor> reactor = nullptr,
+                           const std::chrono::milliseconds period = std::chrono::seconds(1),
+                           const std::chrono::milliseconds timeout = std::chrono::milliseconds(500));
+  DashboardPoller(const DashboardPoller&) = delete;
+  DashboardPoller& operator=(const DashboardPoller&) = delete;
+  ~DashboardPoller();
+
+  /*!
+   * \brief Starts polling a robot. The first poll is done right after connecting.
+   *
+   * \param host IP address of the robot
+   * \param callback Function to call with the result of every poll
+   * \param port Port of the dashboard server
+   *
+   * \throws UrException if the address of the robot can't be resolved
+   *
+   * \returns An identifier of the robot to be used with removeRobot()
+   */
+  size_t addRobot(const std::string& host, ResultCallback callback,
+                  const int port = DashboardClient::DASHBOARD_SERVER_PORT);
+
+  /*!
+   * \brief Stops polling a robot and closes its connection. Afterwards, its callback isn't called
+   * anymore.
+   *
+   * \param id The identifier returned by addRobot()
+   */
+  void removeRobot(const size_t id);
+
+private:
+  enum class RobotState
+  {
+    DISCONNECTED,  // Waiting for the next connection attempt
+    CONNECTING,    // Waiting for the dashboard server's welcome message
+    IDLE,          // Waiting for the next poll
+    POLLING        // Waiting for the answers to the queries
+  };
+
+  struct Robot
+  {
+    std::string host;
+    sockaddr_storage address{};
+    socklen_t address_length = 0;
+    ResultCallback callback;
+    int socket_fd = -1;
+    int timer_fd = -1;
+    RobotState state = RobotState::DISCONNECTED;
+    std::string read_buffer;
+    std::chrono::steady_clock::time_point poll_start;
+  };
+
+  void connect(Robot& robot);
+  void disconnect(Robot& robot);
+  void poll(Robot& robot);
+  void fail(Robot& robot, const char* reason);
+  void onTimer(Robot& robot);
+  void onReadable(Robot& robot);
+  void handleAnswers(Robot& robot);
+  void setTimer(Robot& robot, const std::chrono::milliseconds delay);
+
+  std::shared_ptr<comm::Reactor> reactor_;
+  size_t loop_;
+  std::chrono::milliseconds period_;
+  std::chrono::milliseconds timeout_;
+  // Only accessed on the event loop or synchronized with it
+  std::unordered_map<size_t, std::unique_ptr<Robot>> robots_;
+  size_t next_id_;
+};
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_DASHBOARD_POLLER_H_INCLUDED
@@ -28,6 +28,10 @@
 //----------------------------------------------------------------------
 #pragma once
 
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
 #include <ur_client_library/types.h>
 
 namespace urcl
@@ -79,6 +83,23 @@ enum class SafetyStatus : int8_t  // Only available on 3.10/5.4
   SYSTEM_THREE_POSITION_ENABLING_STOP = 13
 };
 
+enum class RuntimeState : uint32_t
+{
+  STOPPING = 0,
+  STOPPED = 1,
+  PLAYING = 2,
+  PAUSING = 3,
+  PAUSED = 4,
+  RESUMING = 5
+};
+
+enum class OperationalMode : int8_t  // Only available on e-series robots
+{
+  NONE = 0,  // No operational mode password is configured
+  MANUAL = 1,
+  AUTOMATIC = 2
+};
+
 enum class AnalogOutputType : int8_t
 {
   SET_ON_TEACH_PENDANT = -1,
@@ -186,4 +207,27 @@ inline std::string safetyStatusString(const SafetyStatus& status)
       throw std::invalid_argument(ss.str());
   }
 }
+
+inline std::string runtimeStateString(const RuntimeState& state)
+{
+  switch (state)
+  {
+    case RuntimeState::STOPPING:
+      return "STOPPING";
+    case RuntimeState::STOPPED:
+      return "STOPPED";
+    case RuntimeState::PLAYING:
+      return "PLAYING";
+    case RuntimeState::PAUSING:
+      return "PAUSING";
+    case RuntimeState::PAUSED:
+      return "PAUSED";
+    case RuntimeState::RESUMING:
+      return "RESUMING";
+    default:
+      std::stringstream ss;
+      ss << "Unknown runtime state: " << static_cast<uint32_t>(state);
+      throw std::invalid_argument(ss.str());
+  }
+}
 }  // namespace urcl
@@ -0,0 +1,240 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_EVENT_STREAM_H_INCLUDED
+#define UR_CLIENT_LIBRARY_EVENT_STREAM_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/control/script_command_interface.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/primary/primary_package.h"
+#include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/queue/readerwriterqueue.h"
+#include "ur_client_library/rtde/clock_synchronizer.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+/*!
+ * \brief Sources merged by an EventStream.
+ */
+enum class EventSource : uint8_t
+{
+  DATA_PACKAGE = 0,         ///< RTDE data packages
+  ROBOT_MESSAGE = 1,        ///< Robot messages received on the primary interface
+  TRAJECTORY_RESULT = 2,    ///< Results of forwarded trajectories
+  TOOL_CONTACT_RESULT = 3,  ///< Results of tool contact
+};
+
+/*!
+ * \brief An event delivered by an EventStream. Only the member matching the event's source is set.
+ */
+struct Event
+{
+  EventSource source = EventSource::DATA_PACKAGE;
+  //! Robot time of the event in seconds, the events are delivered in the order of this time
+  double robot_time = 0.0;
+  //! Host time the event has been received at
+  std::chrono::steady_clock::time_point receive_time;
+  //! Copy of the data package, only valid during the callback
+  const rtde_interface::DataPackage* data_package = nullptr;
+  std::shared_ptr<primary_interface::RobotMessage> robot_message;
+  control::TrajectoryResult trajectory_result = control::TrajectoryResult::TRAJECTORY_RESULT_UNKNOWN;
+  control::ToolContactResult tool_contact_result = control::ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_CANCELED;
+};
+
+/*!
+ * \brief Merges RTDE data packages, robot messages, trajectory results and tool contact results
+ * into a single stream of events, delivered in robot time order on one thread.
+ *
+ * Every source has its own bounded single-producer single-consumer queue, so each source has to be
+ * pushed from a single thread, e.g. the RTDE client's observer thread or the thread calling a result
+ * callback. Pushing never blocks, events not fitting into their source's queue are dropped and
+ * counted.
+ *
+ * The stream's thread merges the queues by robot time. Data packages are stamped with their
+ * \p timestamp field, all other events with the robot time their receive time maps to, see
+ * rtde_interface::ClockSynchronizer. Without a synchronized clock, they are stamped with the robot
+ * time of the latest data package instead. As sparse sources like trajectory results may not have
+ * an event queued, an event is delivered once every other source has a later event queued or it has
+ * been received longer than the reorder window ago. Events arriving later than that are still
+ * delivered, but may be out of order.
+ */
+class EventStream
+{
+public:
+  //! Called on the stream's thread with every event, it has to return quickly
+  using EventCallback = std::function<void(const Event&)>;
+
+  //! Default time events are held back to be ordered with events of other sources
+  static constexpr std::chrono::milliseconds DEFAULT_REORDER_WINDOW{ 20 };
+  //! Default number of events queued per source
+  static const size_t DEFAULT_QUEUE_CAPACITY = 256;
+
+  EventStream() = delete;
+
+  /*!
+   * \brief Creates a new EventStream object and starts its thread. All queues are allocated
+   * upfront.
+   *
+   * \param callback Function to call with every event
+   * \param clock Synchronizer mapping receive times to robot time, e.g. the RTDE client's one. If
+   * nullptr, events are stamped with the robot time of the latest data package.
+   * \param reorder_window Time events are held back to be ordered with events of other sources
+   * \param queue_capacity Number of events queued per source
+   */
+  explicit EventStream(EventCallback callback, std::shared_ptr<rtde_interface::ClockSynchronizer> clock = nullptr,
+                       const std::chrono::milliseconds reorder_window = DEFAULT_REORDER_WINDOW,
+                       const size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
+  EventStream(const EventStream&) = delete;
+  EventStream& operator=(const EventStream&) = delete;
+
+  /*!
+   * \brief Stops the stream's thread. Queued events are discarded.
+   */
+  ~EventStream();
+
+  /*!
+   * \brief Queues a copy of a data package, e.g. from an observer added using
+   * rtde_interface::RTDEClient::addDataPackageObserver(). Copies are reused once delivered, so no
+   * memory is allocated as long as the recipe doesn't change.
+   *
+   * \param package The received data package
+   *
+   * \returns False if the queue was full and the package has been dropped, true otherwise
+   */
+  bool pushDataPackage(const rtde_interface::DataPackage& package);
+
+  /*!
+   * \brief Queues a robot message.
+   *
+   * \param message The received robot message
+   *
+   * \returns False if the queue was full and the message has been dropped, true otherwise
+   */
+  bool pushRobotMessage(std::shared_ptr<primary_interface::RobotMessage> message);
+
+  /*!
+   * \brief Queues the result of a trajectory, e.g. from a callback registered using
+   * UrDriver::registerTrajectoryDoneCallback().
+   *
+   * \param result The trajectory's result
+   *
+   * \returns False if the queue was full and the result has been dropped, true otherwise
+   */
+  bool pushTrajectoryResult(const control::TrajectoryResult result);
+
+  /*!
+   * \brief Queues the result of tool contact, e.g. from a callback registered using
+   * UrDriver::registerToolContactResultCallback().
+   *
+   * \param result The tool contact result
+   *
+   * \returns False if the queue was full and the result has been dropped, true otherwise
+   */
+  bool pushToolContactResult(const control::ToolContactResult result);
+
+  /*!
+   * \brief Creates a consumer queueing all robot messages received on the primary interface, see
+   * primary_interface::PrimaryClient::addPrimaryConsumer().
+   *
+   * \returns The consumer, it refers to this stream and must not outlive it
+   */
+  std::shared_ptr<comm::IConsumer<primary_interface::PrimaryPackage>> createPrimaryConsumer();
+
+  /*!
+   * \brief Getter for the number of events of a source dropped because its queue was full.
+   *
+   * \param source The source
+   *
+   * \returns The number of dropped events
+   */
+  uint64_t getDroppedCount(const EventSource source) const
+  {
+    return sources_[static_cast<size_t>(source)]->dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  static const size_t NUM_SOURCES = 4;
+
+  struct QueuedEvent
+  {
+    Event event;
+    // Owns the copy event.data_package points to
+    std::unique_ptr<rtde_interface::DataPackage> package;
+  };
+
+  struct Source
+  {
+    explicit Source(const size_t capacity) : queue(capacity), dropped(0), has_head(false)
+    {
+    }
+
+    moodycamel::ReaderWriterQueue<QueuedEvent> queue;
+    std::atomic<uint64_t> dropped;
+    // Only accessed by the stream's thread
+    QueuedEvent head;
+    bool has_head;
+  };
+
+  bool push(const EventSource source, QueuedEvent&& queued);
+  // Robot time of an event without a robot time of its own
+  double mapToRobotTime(const std::chrono::steady_clock::time_point receive_time) const;
+  void run();
+  // Delivers the oldest head, returns the time to wait for more events if nothing was delivered
+  bool deliverNext(std::chrono::steady_clock::duration& wait_time);
+
+  EventCallback callback_;
+  std::shared_ptr<rtde_interface::ClockSynchronizer> clock_;
+  std::chrono::steady_clock::duration reorder_window_;
+  std::array<std::unique_ptr<Source>, NUM_SOURCES> sources_;
+  // Delivered package copies handed back to the producer of data packages
+  moodycamel::ReaderWriterQueue<std::unique_ptr<rtde_interface::DataPackage>> free_packages_;
+  std::atomic<double> latest_robot_time_;
+  // Only used by the producer of data packages
+  std::shared_ptr<const rtde_interface::CompiledRecipe> timestamp_recipe_;
+  rtde_interface::FieldHandle<double> timestamp_handle_;
+
+  moodycamel::spsc_sema::LightweightSemaphore pending_;
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_EVENT_STREAM_H_INCLUDED
@@ -31,8 +31,13 @@
 #ifndef UR_CLIENT_LIBRARY_INSTRUCTION_EXECUTOR_H_INCLUDED
 #define UR_CLIENT_LIBRARY_INSTRUCTION_EXECUTOR_H_INCLUDED
 
+#include <future>
+
+#include "ur_client_library/comm/notifying_future.h"
 #include "ur_client_library/ur/ur_driver.h"
 #include "ur_client_library/control/motion_primitives.h"
+#include "ur_client_library/control/trajectory_reducer.h"
+#include "ur_client_library/control/trajectory_validator.h"
 
 namespace urcl
 {
@@ -48,6 +53,8 @@ public:
         std::bind(&InstructionExecutor::trajDisconnectCallback, this, std::placeholders::_1));
   }
 
+  ~InstructionExecutor();
+
   /**
    * \brief Execute a sequence of motion primitives.
    *
@@ -58,6 +65,181 @@ public:
    */
   bool executeMotion(const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence);
 
+  /**
+   * \brief Execute a sequence of motion primitives stored by value.
+   *
+   * Behaves like the overload taking shared pointers, but neither building nor sending the
+   * sequence allocates per primitive.
+   *
+   * \param motion_sequence The sequence of motion primitives to execute
+   */
+  bool executeMotion(const std::vector<control::MotionPrimitiveValue>& motion_sequence);
+
+  /**
+   * \brief Start executing a sequence of motion primitives without waiting for it to finish.
+   *
+   * The returned future becomes ready as soon as the robot reports the trajectory's result. While
+   * the trajectory is running, the driver sends keepalive messages whenever no other command was
+   * sent in time, see UrDriver::setAutomaticKeepalive(), so the caller isn't blocked. Only one sequence can be executed at a time.
+   *
+   * \param motion_sequence The sequence of motion primitives to execute
+   * \return A future holding the trajectory's result. If the sequence cannot be started, e.g. as
+   * another one is still running or no client is connected, the future is ready immediately and
+   * holds TRAJECTORY_RESULT_FAILURE.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeMotionAsync(const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence);
+
+  /**
+   * \brief Start executing a sequence of motion primitives stored by value without waiting for it
+   * to finish. See executeMotionAsync() for details.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeMotionAsync(const std::vector<control::MotionPrimitiveValue>& motion_sequence);
+
+  /**
+   * \brief Start executing a sequence of motion primitives stored in an array, e.g. a reused
+   * preallocated motion buffer, without waiting for it to finish. See executeMotionAsync() for
+   * details.
+   *
+   * \param motion_sequence Pointer to the first motion primitive
+   * \param num_primitives Number of motion primitives to execute
+   */
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeMotionAsync(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives);
+
+  /**
+   * \brief Execute a motion sequence kept in the robot's trajectory cache, uploading it only if it
+   * isn't cached.
+   *
+   * The robot is asked to replay the trajectory cached under the given ID first. If it isn't
+   * cached, the sequence is reduced, validated and uploaded like by executeMotionAsync() and cached
+   * under the ID once it has been executed successfully. The cache has to be enabled using
+   * UrDriver::setTrajectoryCacheCapacity(). The ID has to identify the sequence's content, e.g.
+   * using motionSequenceId(), as a cached trajectory is replayed without comparing it to the
+   * sequence passed.
+   *
+   * \param trajectory_id The ID the sequence is cached under
+   * \param motion_sequence The sequence of motion primitives to execute
+   *
+   * \return True if the robot has executed the sequence successfully, false otherwise.
+   */
+  bool executeCachedMotion(const int32_t trajectory_id,
+                           const std::vector<control::MotionPrimitiveValue>& motion_sequence);
+
+  /**
+   * \brief Start executing a motion sequence kept in the robot's trajectory cache without waiting
+   * for it to finish. See executeCachedMotion() and executeMotionAsync() for details.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeCachedMotionAsync(const int32_t trajectory_id,
+                           const std::vector<control::MotionPrimitiveValue>& motion_sequence);
+
+  /**
+   * \brief Start executing a motion sequence stored in an array and kept in the robot's trajectory
+   * cache without waiting for it to finish. See executeCachedMotion() and executeMotionAsync() for
+   * details.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeCachedMotionAsync(const int32_t trajectory_id, const control::MotionPrimitiveValue* motion_sequence,
+                           const size_t num_primitives);
+
+  /**
+   * \brief Computes an ID for caching a motion sequence from its content, see executeCachedMotion().
+   *
+   * Sequences differing in any parameter get different IDs with high probability.
+   *
+   * \param motion_sequence Pointer to the first motion primitive
+   * \param num_primitives Number of motion primitives
+   */
+  static int32_t motionSequenceId(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives);
+
+  /**
+   * \brief Start a motion queue, a trajectory that motion sequences are appended to while it is
+   * executed.
+   *
+   * Motion sequences added using queueMotion() are uploaded to the robot while the previous ones
+   * are still running, so there is no dead time in between them. The robot blends from the last
+   * motion of one sequence into the first motion of the next one using the last motion's blend
+   * radius. The next sequence has to be queued before the robot has finished all motions queued
+   * so far, otherwise the trajectory fails. Use a blend radius of 0 for the last motion queued
+   * before calling endMotionQueue().
+   *
+   * \param window_size Maximum number of motions uploaded to the robot but not yet started
+   * \return A future holding the result of the whole queue, which becomes ready after
+   * endMotionQueue() has been called and all motions are finished, or as soon as a motion fails.
+   * If the queue cannot be started, the future is ready immediately and holds
+   * TRAJECTORY_RESULT_FAILURE.
+   *
+   * \throws UrException if the window size is 0
+   */
+  comm::NotifyingFuture<control::TrajectoryResult> startMotionQueue(const size_t window_size = DEFAULT_QUEUE_WINDOW);
+
+  /**
+   * \brief Append a motion sequence to the queue started using startMotionQueue(). Blocks while
+   * the robot's window is full. This must not be called from several threads at the same time.
+   *
+   * \param motion_sequence The sequence of motion primitives to execute
+   * \return False if no queue is running or the motions couldn't be uploaded, true otherwise
+   */
+  bool queueMotion(const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence);
+
+  /**
+   * \brief Append a motion sequence stored by value to the queue started using
+   * startMotionQueue(). See queueMotion() for details.
+   */
+  bool queueMotion(const std::vector<control::MotionPrimitiveValue>& motion_sequence);
+
+  /**
+   * \brief Tell the robot that no further motions will be queued. The queue's future becomes
+   * ready once all queued motions are finished.
+   *
+   * \return False if no queue is running or the message couldn't be sent, true otherwise
+   */
+  bool endMotionQueue();
+
+  /**
+   * \brief Check whether a motion queue is running and accepts further motion sequences.
+   */
+  bool isQueueing()
+  {
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    return queueing_;
+  }
+
+  /**
+   * \brief Check whether a motion sequence is currently being executed.
+   */
+  bool isTrajectoryRunning() const
+  {
+    return trajectory_running_;
+  }
+
+  /**
+   * \brief Validate motion sequences on the client before executing or queueing them.
+   *
+   * An invalid sequence isn't sent to the robot at all. Executing it fails right away, queueing it
+   * returns false. This must not be called while a motion sequence is started or queued.
+   *
+   * \param validator The validator to use, nullptr disables validation
+   */
+  void setTrajectoryValidator(std::shared_ptr<const control::TrajectoryValidator> validator)
+  {
+    trajectory_validator_ = validator;
+  }
+
+  /**
+   * \brief Remove points from motion sequences before executing or queueing them, as long as the
+   * path stays within the reducer's tolerance. Sequences are reduced before they are validated.
+   * This must not be called while a motion sequence is started or queued.
+   *
+   * \param reducer The reducer to use, nullptr disables reduction
+   */
+  void setTrajectoryReducer(std::shared_ptr<const control::TrajectoryReducer> reducer)
+  {
+    trajectory_reducer_ = reducer;
+  }
+
   /**
    * \brief Move the robot to a joint target.
    *
@@ -92,13 +274,110 @@ public:
   bool moveL(const urcl::Pose& target, const double acceleration = 1.4, const double velocity = 1.04,
              const double time = 0, const double blend_radius = 0);
 
+  /**
+   * \brief Move the robot's tool to a pose target with constant speed using movep.
+   *
+   * The function will return once the robot has reached the target.
+   *
+   * \param target The pose target to move to.
+   * \param acceleration Tool acceleration [m/s^2]
+   * \param velocity Tool speed [m/s]
+   * \param blend_radius The blend radius to use for the motion.
+   * \return True if the robot has reached the target, false otherwise.
+   */
+  bool moveP(const urcl::Pose& target, const double acceleration = 1.4, const double velocity = 1.04,
+             const double blend_radius = 0);
+
+  /**
+   * \brief Move the robot's tool along a circular arc through a via point to a pose target using movec.
+   *
+   * The function will return once the robot has reached the target.
+   *
+   * \param via_point The pose the arc passes through.
+   * \param target The pose target to move to.
+   * \param acceleration Tool acceleration [m/s^2]
+   * \param velocity Tool speed [m/s]
+   * \param blend_radius The blend radius to use for the motion.
+   * \param mode Orientation mode of the motion, 0 for unconstrained and 1 for fixed orientation.
+   * \return True if the robot has reached the target, false otherwise.
+   */
+  bool moveC(const urcl::Pose& via_point, const urcl::Pose& target, const double acceleration = 1.4,
+             const double velocity = 1.04, const double blend_radius = 0, const int32_t mode = 0);
+
+  /**
+   * \brief Start moving the robot to a joint target without waiting for it to arrive. See moveJ()
+   * and executeMotionAsync() for details.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult> moveJAsync(const urcl::vector6d_t& target,
+                                                              const double acceleration = 1.4,
+                                                              const double velocity = 1.04, const double time = 0,
+                                                              const double blend_radius = 0);
+
+  /**
+   * \brief Start moving the robot to a pose target without waiting for it to arrive. See moveL()
+   * and executeMotionAsync() for details.
+   */
+  comm::NotifyingFuture<control::TrajectoryResult> moveLAsync(const urcl::Pose& target, const double acceleration = 1.4,
+                                                              const double velocity = 1.04, const double time = 0,
+                                                              const double blend_radius = 0);
+
+  //! Default number of queued motions uploaded to the robot ahead of execution
+  static const size_t DEFAULT_QUEUE_WINDOW = 8;
+
 private:
   void trajDoneCallback(const urcl::control::TrajectoryResult& result);
   void trajDisconnectCallback(const int filedescriptor);
+  //! Finishes the running trajectory, has to be called with trajectory_result_mutex_ locked
+  void finishTrajectory(const urcl::control::TrajectoryResult result);
+  //! Lets the driver keep the trajectory marked as running alive
+  void enableKeepalive();
+  //! Marks a trajectory as running, returns false with a failed result if one is running already
+  bool beginTrajectory(comm::NotifyingFuture<control::TrajectoryResult>& result);
+  //! Sends the start of the trajectory marked as running, finishes it if that fails
+  bool startTrajectory(const size_t num_primitives, const std::optional<int32_t>& trajectory_id = std::nullopt);
+  //! Check a motion sequence using the trajectory validator if set, logging the first violation
+  bool validateMotions(const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence) const;
+  bool validateMotions(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives) const;
+  static bool acceptValidation(const control::TrajectoryValidationResult& result);
+  //! Validates, starts and writes a motion sequence after it has been reduced
+  comm::NotifyingFuture<control::TrajectoryResult>
+  executeReducedMotionAsync(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives);
+  //! Validates and queues a motion sequence after it has been reduced
+  bool queueReducedMotion(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives);
+  //! Returns a future holding a failed result
+  static comm::NotifyingFuture<control::TrajectoryResult> failedTrajectory();
+
+  //! Encoded motions not written yet. Only one of the vectors holds points at a time.
+  struct MotionBuffer
+  {
+    std::vector<control::TrajectoryPoint> points;
+    std::vector<control::TrajectoryCircularPoint> circular_points;
+    std::vector<control::TrajectorySplinePoint> spline_points;
+  };
+  bool writeMotions(const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence,
+                    MotionBuffer& buffer);
+  bool writeMotions(const control::MotionPrimitiveValue* motion_sequence, const size_t num_primitives,
+                    MotionBuffer& buffer);
+  //! Adds a motion to the buffer, writing the buffered motions first if they are of another kind
+  bool addMotion(const control::MotionPrimitiveValue& primitive, MotionBuffer& buffer);
+  bool flushMotions(MotionBuffer& buffer);
+
   std::shared_ptr<urcl::UrDriver> driver_;
   std::atomic<bool> trajectory_running_ = false;
   std::mutex trajectory_result_mutex_;
   urcl::control::TrajectoryResult trajectory_result_;
+  comm::NotifyingPromise<control::TrajectoryResult> trajectory_promise_;
+  bool queueing_ = false;
+  // Reused for every motion sequence executed, only accessed while starting the running trajectory
+  MotionBuffer motion_buffer_;
+  // Reused for every queued motion sequence, only accessed by the thread queueing motions
+  MotionBuffer queue_buffer_;
+  // Whether automatic keepalive was enabled on the driver before the running trajectory
+  bool keepalive_enabled_before_ = false;
+  // Checks motion sequences before they are sent, if set
+  std::shared_ptr<const control::TrajectoryValidator> trajectory_validator_;
+  // Removes points from motion sequences before they are validated, if set
+  std::shared_ptr<const control::TrajectoryReducer> trajectory_reducer_;
 };
 }  // namespace urcl
 
@@ -0,0 +1,92 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SCRIPT_MINIFIER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SCRIPT_MINIFIER_H_INCLUDED
+
+#include <set>
+#include <string>
+
+namespace urcl
+{
+/*!
+ * \brief Shrinks URScript programs before they are sent to the robot.
+ *
+ * Comments, indentation, trailing whitespace and empty lines are removed, which reduces the size
+ * of the program transferred and the time the robot needs to compile it. Comments marking the
+ * parts of the script used by the URCap (e.g. HEADER_BEGIN) are kept.
+ *
+ * Code in between the comments "# BEGIN_SECTION <name>" and "# END_SECTION <name>" is left out
+ * entirely if the section's name is excluded. The external_control.urscript defines the sections
+ * SPEEDJ, SPEEDL, POSE, FORCE and SPLINE. Commands for an excluded feature are ignored by the
+ * robot.
+ */
+class ScriptMinifier
+{
+public:
+  //! Sections of the external_control.urscript that can be excluded
+  static const inline std::set<std::string> SECTIONS = { "SPEEDJ", "SPEEDL", "POSE", "FORCE", "SPLINE" };
+
+  /*!
+   * \brief Creates a minifier.
+   *
+   * \param excluded_sections Names of the sections to leave out
+   */
+  explicit ScriptMinifier(const std::set<std::string>& excluded_sections = {});
+
+  /*!
+   * \brief Minifies a script.
+   *
+   * \param script The script to minify
+   *
+   * \throws UrException if a section is not terminated or the section markers are not nested
+   * properly
+   *
+   * \returns The minified script
+   */
+  std::string minify(const std::string& script) const;
+
+  /*!
+   * \brief Get the sections left out by this minifier.
+   *
+   * \returns The names of the excluded sections
+   */
+  const std::set<std::string>& getExcludedSections() const
+  {
+    return excluded_sections_;
+  }
+
+private:
+  std::set<std::string> excluded_sections_;
+};
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_SCRIPT_MINIFIER_H_INCLUDED
@@ -0,0 +1,144 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_SCRIPT_TEMPLATE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_SCRIPT_TEMPLATE_H_INCLUDED
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace urcl
+{
+/*!
+ * \brief Parameters rendered into a ScriptTemplate, mapping placeholder names without braces to
+ * their replacements.
+ */
+using ScriptParameters = std::map<std::string, std::string>;
+
+/*!
+ * \brief A URScript program containing placeholders of the form {{NAME}}.
+ *
+ * The script is split into literal text and placeholders once on construction, so rendering it
+ * only copies each part once, independent of the number of placeholders. Rendered programs are
+ * cached by a hash of their parameters, rendering the same parameters again returns the cached
+ * program.
+ *
+ * Templates read using fromFile() are shared, so a file is only read again if it changed on disk.
+ */
+class ScriptTemplate
+{
+public:
+  //! Maximum number of rendered programs kept in the cache of a template
+  static constexpr size_t MAX_CACHED_PROGRAMS = 8;
+
+  ScriptTemplate() = delete;
+  /*!
+   * \brief Creates a template from the given script.
+   *
+   * \param script The script including its placeholders
+   */
+  explicit ScriptTemplate(const std::string& script);
+
+  /*!
+   * \brief Reads a template from a file.
+   *
+   * Templates are cached by file name, the file is only read again if its modification time or
+   * size changed since it was read last.
+   *
+   * \param filename Path to the script file
+   *
+   * \throws UrException if the file cannot be read
+   *
+   * \returns The template read from the file
+   */
+  static std::shared_ptr<const ScriptTemplate> fromFile(const std::string& filename);
+
+  /*!
+   * \brief Replaces the placeholders in the script.
+   *
+   * Placeholders without a parameter are kept in the program as they are.
+   *
+   * \param parameters Replacements of the placeholders
+   *
+   * \returns The rendered program
+   */
+  std::string render(const ScriptParameters& parameters) const;
+
+  /*!
+   * \brief Get the names of all placeholders contained in the script, in order of their first
+   * occurrence.
+   *
+   * \returns The placeholder names without braces
+   */
+  std::vector<std::string> getPlaceholders() const;
+
+  /*!
+   * \brief Get the number of rendered programs currently cached.
+   *
+   * \returns The number of cached programs
+   */
+  size_t getCachedProgramCount() const;
+
+private:
+  struct Segment
+  {
+    size_t begin;
+    size_t length;
+    // Index into placeholders_ or NO_PLACEHOLDER for literal text
+    size_t placeholder;
+  };
+
+  struct CachedProgram
+  {
+    ScriptParameters parameters;
+    std::shared_ptr<const std::string> program;
+  };
+
+  static constexpr size_t NO_PLACEHOLDER = static_cast<size_t>(-1);
+
+  static size_t hashParameters(const ScriptParameters& parameters);
+
+  std::string script_;
+  std::vector<Segment> segments_;
+  std::vector<std::string> placeholders_;
+
+  mutable std::mutex cache_mutex_;
+  mutable std::unordered_map<size_t, CachedProgram> cache_;
+  mutable std::vector<size_t> cache_order_;
+};
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_SCRIPT_TEMPLATE_H_INCLUDED
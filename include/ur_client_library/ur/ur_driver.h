@@ -28,21 +28,103 @@
 #ifndef UR_CLIENT_LIBRARY_UR_UR_DRIVER_H_INCLUDED
 #define UR_CLIENT_LIBRARY_UR_UR_DRIVER_H_INCLUDED
 
+#include <chrono>
 #include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
 
+#include "ur_client_library/comm/connection_health_monitor.h"
+#include "ur_client_library/comm/notifying_future.h"
 #include "ur_client_library/rtde/rtde_client.h"
 #include "ur_client_library/control/reverse_interface.h"
 #include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/control/trajectory_validator.h"
 #include "ur_client_library/control/script_command_interface.h"
+#include "ur_client_library/control/setpoint_interpolator.h"
+#include "ur_client_library/control/rtde_command_scheduler.h"
 #include "ur_client_library/control/script_sender.h"
+#include "ur_client_library/control/script_state_monitor.h"
+#include "ur_client_library/control/setpoint_latency_monitor.h"
+#include "ur_client_library/control/trajectory_progress_monitor.h"
+#include "ur_client_library/control/trajectory_start_trigger.h"
+#include "ur_client_library/control/command_arbiter.h"
 #include "ur_client_library/ur/tool_communication.h"
+#include "ur_client_library/ur/version_capabilities.h"
 #include "ur_client_library/ur/version_information.h"
 #include "ur_client_library/ur/robot_receive_timeout.h"
+#include "ur_client_library/ur/script_minifier.h"
+#include "ur_client_library/ur/script_template.h"
+#include "ur_client_library/primary/primary_client.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
+#include "ur_client_library/rtde/register_transfer.h"
 #include "ur_client_library/rtde/rtde_writer.h"
 
 namespace urcl
 {
+/*!
+ * \brief Optional interfaces a UrDriver provides, combined into a mask.
+ *
+ * The RTDE and primary interfaces are always provided. Interfaces that are left out are not
+ * created, so they don't bind a port or run a thread. Calling a function requiring one of them
+ * throws a UrException.
+ */
+enum class DriverCapabilities : uint32_t
+{
+  //! \brief Only the RTDE and primary interfaces, for applications that don't command the robot
+  MONITORING_ONLY = 0,
+  //! \brief Writing joint commands and control messages. The robot program is only prepared with
+  //! this interface, as the program stops without it.
+  REVERSE_INTERFACE = 1 << 0,
+  //! \brief Forwarding trajectories to the robot
+  TRAJECTORY_INTERFACE = 1 << 1,
+  //! \brief Executing script commands like zeroFTSensor() or startForceMode()
+  SCRIPT_COMMAND_INTERFACE = 1 << 2,
+  //! \brief Serving the program to the External Control URCap when not in headless mode
+  SCRIPT_SENDER = 1 << 3,
+  //! \brief Creating the driver as hot standby for another host. The program isn't sent in headless
+  //! mode, but only when taking over using UrDriver::takeOver(). Not part of ALL.
+  STANDBY = 1 << 4,
+  //! \brief All interfaces
+  ALL = REVERSE_INTERFACE | TRAJECTORY_INTERFACE | SCRIPT_COMMAND_INTERFACE | SCRIPT_SENDER
+};
+
+inline DriverCapabilities operator|(const DriverCapabilities lhs, const DriverCapabilities rhs)
+{
+  return static_cast<DriverCapabilities>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+inline DriverCapabilities operator&(const DriverCapabilities lhs, const DriverCapabilities rhs)
+{
+  return static_cast<DriverCapabilities>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+/*!
+ * \brief Time spent in the phases of a UrDriver's startup.
+ *
+ * Phases that don't depend on each other run concurrently, so the total startup time is bounded by
+ * the slowest chain of dependent phases rather than by the sum of all phases.
+ */
+struct StartupTimings
+{
+  //! Connecting the RTDE client and setting up the recipes
+  std::chrono::microseconds rtde{ 0 };
+  //! Connecting to the primary interface
+  std::chrono::microseconds primary{ 0 };
+  //! Reading and parsing the script template
+  std::chrono::microseconds script_loading{ 0 };
+  //! Starting the trajectory and script command servers
+  std::chrono::microseconds control_servers{ 0 };
+  //! Starting the reverse interface, which needs the RTDE frequency
+  std::chrono::microseconds reverse_interface{ 0 };
+  //! Rendering the program, which needs the RTDE connection's local IP and the robot's version
+  std::chrono::microseconds script_rendering{ 0 };
+  //! Sending the program in headless mode, starting the script sender otherwise
+  std::chrono::microseconds program_setup{ 0 };
+  //! The complete startup
+  std::chrono::microseconds total{ 0 };
+};
+
 /*!
  * \brief This is the main class for interfacing the driver.
  *
@@ -92,13 +174,19 @@ public:
    * trajectory forwarding.
    * \param script_command_port Port used for forwarding script commands to the robot. The script commands will be
    * executed locally on the robot.
+   * \param capabilities The optional interfaces to create. Use DriverCapabilities::MONITORING_ONLY
+   * to only read data from the robot. The script file isn't read without the reverse interface.
+   *
+   * Any of the ports may be 0 to let the operating system assign a free port, e.g. for running
+   * several drivers on one host. The program sent to the robot connects to the assigned ports.
    */
   UrDriver(const std::string& robot_ip, const std::string& script_file, const std::string& output_recipe_file,
            const std::string& input_recipe_file, std::function<void(bool)> handle_program_state, bool headless_mode,
            std::unique_ptr<ToolCommSetup> tool_comm_setup, const uint32_t reverse_port = 50001,
            const uint32_t script_sender_port = 50002, int servoj_gain = 2000, double servoj_lookahead_time = 0.03,
            bool non_blocking_read = false, const std::string& reverse_ip = "", const uint32_t trajectory_port = 50003,
-           const uint32_t script_command_port = 50004);
+           const uint32_t script_command_port = 50004,
+           const DriverCapabilities capabilities = DriverCapabilities::ALL);
 
   /*!
    * \brief Constructs a new UrDriver object.
@@ -227,7 +315,7 @@ public:
   {
   }
 
-  virtual ~UrDriver() = default;
+  virtual ~UrDriver();
 
   /*!
    * \brief Access function to receive the latest data package sent from the robot through RTDE
@@ -238,6 +326,29 @@ public:
    */
   std::unique_ptr<rtde_interface::DataPackage> getDataPackage();
 
+  /*!
+   * \brief Getter for the cache holding the latest data package received through the RTDE
+   * interface. It is updated by the thread receiving RTDE data, independently of whether packages
+   * are taken using getDataPackage(). Any number of threads can read consistent snapshots of the
+   * robot state from it without locking:
+   *
+   * \code{.cpp}
+   * std::shared_ptr<rtde_interface::StateCache> cache = driver.getStateCache();
+   * rtde_interface::StateSnapshot snapshot = cache->createSnapshot();
+   * auto actual_q = cache->getCompiledRecipe()->getFieldHandle<vector6d_t>("actual_q");
+   * vector6d_t q;
+   * if (cache->read(snapshot) && snapshot.getData(actual_q, q)) { ... }
+   * \endcode
+   *
+   * The cache is replaced when resetting the RTDE client or switching the output recipe.
+   *
+   * \returns The state cache of the RTDE client
+   */
+  std::shared_ptr<rtde_interface::StateCache> getStateCache() const
+  {
+    return rtde_client_->getStateCache();
+  }
+
   uint32_t getControlFrequency() const
   {
     return rtde_client_->getTargetFrequency();
@@ -259,6 +370,151 @@ public:
   bool writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
                          const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
 
+  /*!
+   * \brief Writes a joint command computed from a robot state, dropping it once it expired. See
+   * control::ReverseInterface::write() and setSetpointValidity() for details.
+   *
+   * \param values Desired joint positions
+   * \param control_mode Control mode this command is assigned to.
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket
+   * \param state_time The time the robot state the command is computed from has been received,
+   * e.g. the receive time of the RTDE data package
+   *
+   * \returns True on successful write, false if the command expired or the write failed.
+   */
+  bool writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                         const RobotReceiveTimeout& robot_receive_timeout,
+                         const std::chrono::steady_clock::time_point state_time);
+
+  /*!
+   * \brief Writes the wrench of force mode onto the socket being sent to the robot.
+   *
+   * This streams the wrench in every control cycle using comm::ControlMode::MODE_FORCE. The task
+   * frame, selection vector, type and limits are kept from the last call to startForceMode().
+   * Force mode is ended once a command of another control mode is written.
+   *
+   * \param wrench 6d vector of forces/torques [x,y,z,rotX,rotY,rotZ] that the robot will apply to its
+   * environment
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot. Note the timeout cannot be higher than 1 second for realtime commands.
+   *
+   * \returns True on successful write.
+   */
+  bool writeForceModeWrench(const vector6d_t& wrench,
+                            const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+
+  /*!
+   * \brief Lets a control::SetpointInterpolator resample sparse setpoints to the robot's control
+   * rate. Once enabled, the interpolator writes a joint command with the given control mode
+   * every time an RTDE package is received, using setpoints added with addInterpolatedSetpoint().
+   *
+   * With a command being sent in every control cycle, the robot doesn't have to extrapolate
+   * missing commands itself. This has to be called before startRTDECommunication() and is kept
+   * when the RTDE client is reset. Calling it again reconfigures the interpolator and removes its
+   * setpoints.
+   *
+   * \param control_mode Control mode of the commands written, has to be a realtime control mode
+   * \param delay Time the sampling lags behind the RTDE packages' receive times. This should be
+   * at least the interval in between two setpoints, so setpoints don't have to be extrapolated.
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket used with
+   * every command written
+   *
+   * \throws UrException if the control mode isn't a realtime control mode
+   */
+  void
+  enableSetpointInterpolation(const comm::ControlMode control_mode, const std::chrono::microseconds delay,
+                              const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+
+  /*!
+   * \brief Stops writing interpolated commands. The robot will time out according to the receive
+   * timeout of the last command written, unless other commands are written.
+   */
+  void disableSetpointInterpolation();
+
+  /*!
+   * \brief Adds a setpoint to the interpolator enabled using enableSetpointInterpolation(). This
+   * can be called from any thread.
+   *
+   * \param values Desired joint positions, velocities or pose, depending on the control mode
+   * \param time Time the robot should reach the setpoint
+   *
+   * \returns False if interpolation isn't enabled or the setpoint is older than the latest one,
+   * true otherwise
+   */
+  bool addInterpolatedSetpoint(const vector6d_t& values,
+                               const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+
+  /*!
+   * \brief Getter for the interpolator enabled using enableSetpointInterpolation().
+   *
+   * \returns The interpolator, nullptr if interpolation has never been enabled
+   */
+  std::shared_ptr<control::SetpointInterpolator> getSetpointInterpolator() const
+  {
+    return setpoint_interpolator_;
+  }
+
+  /*!
+   * \brief Lets the setpoint interpolator follow the robot's speed scaling.
+   *
+   * The interpolator's trajectory clock then advances by the product of the \p speed_scaling and
+   * \p target_speed_fraction fields of every RTDE package, see
+   * control::SetpointInterpolator::setTimeScaling(). When the speed slider is lowered or the robot
+   * slows down, the interpolated setpoints slow down as well instead of running away from the
+   * robot. Fields missing in the output recipe are treated as 1. Times of setpoints added with
+   * addInterpolatedSetpoint() refer to the trajectory clock then. This is kept when interpolation
+   * is enabled again or the RTDE client is reset.
+   *
+   * \param enabled True to scale the interpolator's time, false to follow the wall clock
+   */
+  void setSetpointInterpolationTimeScaling(const bool enabled);
+
+  /*!
+   * \brief Writes a command to the reverse interface once per received RTDE package, directly on
+   * the thread reading RTDE data. See control::RTDECommandScheduler for details.
+   *
+   * Without a callback, the command set using setRTDESynchronizedCommand() is written in every
+   * cycle. This has to be called before startRTDECommunication() and is kept when the RTDE client
+   * is reset. Calling it again reconfigures the scheduler and removes its command.
+   *
+   * \param control_mode Control mode of the commands written, has to be a realtime control mode
+   * \param callback Optional function computing the command from each data package received
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket used with
+   * every command written
+   *
+   * \throws UrException if the control mode isn't a realtime control mode
+   */
+  void enableRTDESynchronizedCommands(
+      const comm::ControlMode control_mode,
+      control::RTDECommandScheduler::CommandCallback callback = control::RTDECommandScheduler::CommandCallback(),
+      const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(20));
+
+  /*!
+   * \brief Stops writing commands once per received RTDE package. No command is written by the
+   * scheduler anymore after this returns.
+   */
+  void disableRTDESynchronizedCommands();
+
+  /*!
+   * \brief Sets the command written once per received RTDE package. This can be called from any
+   * thread.
+   *
+   * \param values Desired joint positions, velocities or pose, depending on the control mode
+   *
+   * \returns False if synchronized commands aren't enabled, true otherwise
+   */
+  bool setRTDESynchronizedCommand(const vector6d_t& values);
+
+  /*!
+   * \brief Getter for the scheduler enabled using enableRTDESynchronizedCommands().
+   *
+   * \returns The scheduler, nullptr if synchronized commands have never been enabled
+   */
+  std::shared_ptr<control::RTDECommandScheduler> getRTDECommandScheduler() const
+  {
+    return command_scheduler_;
+  }
+
   /*!
    * \brief Writes a trajectory point onto the dedicated socket.
    *
@@ -324,9 +580,113 @@ public:
    */
   bool writeTrajectorySplinePoint(const vector6d_t& positions, const float goal_time = 0.0);
 
+  /*!
+   * \brief Writes a whole motion trajectory onto the dedicated socket.
+   *
+   * All points are encoded into one buffer and sent at once, which is considerably faster than
+   * writing long trajectories point by point.
+   *
+   * \param points The trajectory points
+   *
+   * \returns True on successful write.
+   */
+  bool writeTrajectoryPoints(const std::vector<control::TrajectoryPoint>& points);
+
+  /*!
+   * \brief Writes a whole spline trajectory onto the dedicated socket.
+   *
+   * All points are encoded into one buffer and sent at once, which is considerably faster than
+   * writing long trajectories point by point.
+   *
+   * \param points The spline points
+   *
+   * \returns True on successful write.
+   */
+  bool writeTrajectorySplinePoints(const std::vector<control::TrajectorySplinePoint>& points);
+
+  /*!
+   * \brief Writes a whole circular motion trajectory onto the dedicated socket. The robot moves to
+   * each target on a circular path through the point's via pose using movec.
+   *
+   * \param points The circular points
+   *
+   * \returns True on successful write.
+   */
+  bool writeTrajectoryCircularPoints(const std::vector<control::TrajectoryCircularPoint>& points);
+
+  /*!
+   * \brief Writes a whole spline trajectory with precomputed coefficients onto the dedicated
+   * socket. Use control::SplinePlanner to create the segments.
+   *
+   * \param segments The spline segments
+   *
+   * \returns True on successful write.
+   */
+  bool writeTrajectorySplineSegments(const std::vector<control::TrajectorySplineSegment>& segments);
+
+  /*!
+   * \brief Validates trajectory points on the client before they are written.
+   *
+   * Points written using writeTrajectoryPoint(), writeTrajectorySplinePoint() and the functions
+   * writing whole trajectories are checked by the validator first. If any point is invalid, nothing
+   * is sent and the write returns false. Points written one by one are only checked on their own,
+   * so the velocity needed to reach them from the previous point isn't checked. This must not be
+   * called while trajectory points are written.
+   *
+   * \param validator The validator to use, nullptr disables validation
+   */
+  void setTrajectoryValidator(std::shared_ptr<const control::TrajectoryValidator> validator);
+
+  /*!
+   * \brief Queue the trajectory points written from now on instead of sending them one by one.
+   *
+   * All writeTrajectoryPoint() and writeTrajectorySplinePoint() calls until
+   * flushTrajectoryBatch() are sent to the robot at once.
+   */
+  void startTrajectoryBatch();
+
+  /*!
+   * \brief Sends all trajectory points queued since startTrajectoryBatch() and stops batching.
+   *
+   * \returns True on successful write.
+   */
+  bool flushTrajectoryBatch();
+
+  /*!
+   * \brief Starts a trajectory whose points are streamed to the robot while it is executed.
+   *
+   * Instead of announcing the number of points up front, points are written using the usual
+   * trajectory functions until endTrajectoryStream() is called. At most window_size points are in
+   * flight at any time, further writes block until the robot has consumed enough points. This
+   * allows executing arbitrarily long or online generated trajectories.
+   *
+   * \param window_size Maximum number of points sent but not yet consumed by the robot
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot.
+   *
+   * \throws UrException if the window size is 0
+   *
+   * \returns True on successful write.
+   */
+  bool startTrajectoryStream(const size_t window_size,
+                             const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Tells the robot that all points of a streamed trajectory have been written.
+   *
+   * The result of the trajectory is reported by the trajectory callback as usual.
+   *
+   * \returns True on successful write.
+   */
+  bool endTrajectoryStream();
+
   /*!
    * \brief Writes a control message in trajectory forward mode.
    *
+   * TrajectoryControlMessage::TRAJECTORY_CANCEL first stops writing points of the current
+   * trajectory, including uploads in progress on other threads, so the robot only discards the
+   * points already sent. Points are accepted again once a new trajectory is started.
+   *
    * \param trajectory_action The action to be taken, such as starting a new trajectory
    * \param point_number The number of points of a new trajectory to be sent
    * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
@@ -339,6 +699,107 @@ public:
   writeTrajectoryControlMessage(const control::TrajectoryControlMessage trajectory_action, const int point_number = 0,
                                 const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
 
+  /*!
+   * \brief Executes a trajectory kept in the robot's trajectory cache, so it doesn't have to be
+   * uploaded again.
+   *
+   * A trajectory is cached when it has been started using startCachedTrajectory() and executed
+   * successfully, see setTrajectoryCacheCapacity(). The result of a replayed trajectory is reported
+   * by the trajectory callback as usual.
+   *
+   * \param trajectory_id The ID the trajectory has been cached under
+   * \param answer_timeout Maximum time to wait for the robot to answer
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot
+   *
+   * \returns TrajectoryReplayResult::STARTED, if the trajectory is executed, TrajectoryReplayResult::NOT_CACHED,
+   * if it has to be uploaded again, e.g. using startCachedTrajectory(), and TrajectoryReplayResult::NO_ANSWER,
+   * if the request couldn't be sent or the robot didn't answer in time.
+   */
+  control::TrajectoryReplayResult
+  replayTrajectory(const int32_t trajectory_id,
+                   const std::chrono::milliseconds answer_timeout = std::chrono::milliseconds(500),
+                   const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Starts a new trajectory like writeTrajectoryControlMessage() with
+   * TrajectoryControlMessage::TRAJECTORY_START, that is kept in the robot's trajectory cache once it
+   * has been executed successfully.
+   *
+   * A trajectory cached under the same ID before is replaced. Trajectories not fitting into the
+   * cache are executed without being cached.
+   *
+   * \param trajectory_id The ID to cache the trajectory under
+   * \param point_number The number of points of the trajectory to be sent
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot
+   *
+   * \returns True on successful write.
+   */
+  bool startCachedTrajectory(const int32_t trajectory_id, const int point_number,
+                             const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Starts a new trajectory like writeTrajectoryControlMessage() with
+   * TrajectoryControlMessage::TRAJECTORY_START, but the robot only executes it once its start token
+   * has been written into the start register, see setTrajectoryStartRegister(). The points can be
+   * written right away, they are read by the robot once the trajectory starts.
+   *
+   * Use scheduleTrajectoryStart() to start the trajectory at a given time. A start scheduled before,
+   * that hasn't been triggered yet, is cancelled.
+   *
+   * \param start_token Token starting the trajectory. It must not be 0 and should differ from the
+   * previous token, as the start register keeps the token written last.
+   * \param point_number The number of points of the trajectory to be sent
+   * \param robot_receive_timeout The read timeout configuration for the reverse socket running in the external
+   * control script on the robot
+   *
+   * \returns False if no start register has been set, the token is 0 or the message couldn't be
+   * written, true otherwise
+   */
+  bool armTrajectory(const int32_t start_token, const int point_number,
+                     const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Schedules the start of a trajectory armed using armTrajectory() at a given host time.
+   *
+   * The host time is mapped to robot time using the RTDE client's clock synchronizer. The start
+   * token is written on the RTDE thread after the package sent in the cycle before that robot time,
+   * see control::TrajectoryStartTrigger. Robots scheduled for the same host
+   * time therefore start within about one control period of each other.
+   *
+   * \param start_token The token the trajectory has been armed with
+   * \param start_time Host time the trajectory should start at
+   *
+   * \returns False if no start register has been set or the clocks haven't been synchronized yet,
+   * true otherwise
+   */
+  bool scheduleTrajectoryStart(const int32_t start_token, const std::chrono::steady_clock::time_point start_time);
+
+  /*!
+   * \brief Getter for the trigger writing start tokens of armed trajectories, see
+   * setTrajectoryStartRegister().
+   *
+   * \returns The trigger, nullptr if no start register has been set
+   */
+  std::shared_ptr<control::TrajectoryStartTrigger> getTrajectoryStartTrigger() const
+  {
+    return trajectory_start_trigger_;
+  }
+
+  /*!
+   * \brief Getter for the arbiter letting several components command the robot through this driver,
+   * see control::CommandArbiter. It is created on the first call.
+   *
+   * The arbiter takes over the trajectory done callback, trajectory results are reported to the
+   * client that started the trajectory instead. Calling registerTrajectoryDoneCallback() afterwards
+   * disconnects the arbiter from the results. Commands written through the driver directly bypass
+   * the arbitration.
+   *
+   * \returns The arbiter, it must not be used after the driver has been destroyed
+   */
+  std::shared_ptr<control::CommandArbiter> getCommandArbiter();
+
   /*!
    * \brief Writes a control message in freedrive mode.
    *
@@ -383,6 +844,56 @@ public:
    */
   bool setToolVoltage(const ToolVoltage voltage);
 
+  /*!
+   * \brief Zero the force torque sensor (only available on e-Series) without waiting for it.
+   *
+   * Unlike zeroFTSensor(), this requires the external control script to be running.
+   *
+   * \returns A future becoming ready once the robot has executed the command. It holds false, if
+   * the command couldn't be sent or wasn't acknowledged.
+   */
+  comm::NotifyingFuture<bool> zeroFTSensorAsync();
+
+  /*!
+   * \brief Set the payload mass and center of gravity without waiting for it, see setPayload().
+   *
+   * Unlike setPayload(), this requires the external control script to be running.
+   *
+   * \param mass mass in kilograms
+   * \param cog Center of Gravity, a vector [CoGx, CoGy, CoGz] specifying the displacement (in meters) from the
+   * toolmount
+   *
+   * \returns A future becoming ready once the new payload is active. It holds false, if the
+   * command couldn't be sent or wasn't acknowledged.
+   */
+  comm::NotifyingFuture<bool> setPayloadAsync(const float mass, const vector3d_t& cog);
+
+  /*!
+   * \brief Set the tool voltage without waiting for it, see setToolVoltage().
+   *
+   * Unlike setToolVoltage(), this requires the external control script to be running.
+   *
+   * \param voltage tool voltage.
+   *
+   * \returns A future becoming ready once the new voltage is set. It holds false, if the command
+   * couldn't be sent or wasn't acknowledged.
+   */
+  comm::NotifyingFuture<bool> setToolVoltageAsync(const ToolVoltage voltage);
+
+  /*!
+   * \brief Sends several script commands at once, which the robot executes in a single go, e.g. for
+   * setting up payload, tool voltage and force mode during a changeover.
+   *
+   * Unlike the single commands, the batch's arguments aren't checked against the robot's version
+   * or their valid ranges, they are passed to the robot as they are.
+   *
+   * \param batch The commands to send
+   *
+   * \returns A future becoming ready once the robot has executed all commands. It holds false, if
+   * the batch couldn't be sent or wasn't acknowledged.
+   */
+  comm::NotifyingFuture<bool> sendScriptCommandBatchAsync(const control::ScriptCommandInterface::Batch& batch);
+
   /*!
    * \brief Start the robot to be controlled in force mode.
    *
@@ -508,6 +1019,65 @@ public:
    */
   bool writeKeepalive(const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(1000));
 
+  /*!
+   * \brief Let the library send keepalive signals whenever no other command has been sent in time.
+   *
+   * This replaces calling writeKeepalive() or sending TRAJECTORY_NOOP / FREEDRIVE_NOOP messages
+   * periodically while a trajectory is executed, freedrive is active or no controller is active.
+   * A keepalive signal is only sent once half of the robot receive timeout of the last command
+   * passed without another command, see control::ReverseInterface::setAutomaticKeepalive().
+   *
+   * \param enabled Whether keepalive signals should be sent automatically
+   */
+  void setAutomaticKeepalive(const bool enabled);
+
+  /*!
+   * \brief Checks whether keepalive signals are sent automatically, see setAutomaticKeepalive().
+   *
+   * \returns True, if keepalive signals are sent automatically
+   */
+  bool isAutomaticKeepaliveEnabled() const;
+
+  /*!
+   * \brief Send joint commands, force mode wrenches and keepalive signals from a writer thread.
+   *
+   * The write functions then only hand the latest command to the writer thread without waiting for
+   * the socket, see control::ReverseInterface::setAsyncSetpointWrites(). The writer thread is named
+   * using the "rev_tx" suffix and configured using setThreadConfig() like all other threads, e.g.
+   * to pin it to a core of its own.
+   *
+   * \param enabled Whether commands are sent by the writer thread
+   */
+  void setAsyncSetpointWrites(const bool enabled);
+
+  /*!
+   * \brief Sets how long joint commands written with a state time stay valid after the robot state
+   * they are computed from has been received. Expired commands are dropped instead of being sent,
+   * see control::ReverseInterface::setSetpointValidity().
+   *
+   * \param validity Validity of joint commands, zero to never drop them
+   */
+  void setSetpointValidity(const std::chrono::steady_clock::duration validity);
+
+  /*!
+   * \brief Solves the inverse kinematics of poses written with comm::ControlMode::MODE_POSE on the
+   * client, using a kinematics::KinematicsModel built from the robot's calibration.
+   *
+   * The resulting joint positions are streamed using servoj, see
+   * control::ReverseInterface::setInverseKinematics(), so the robot doesn't solve the inverse
+   * kinematics in every control cycle. The first pose of a stream is solved closest to the
+   * robot's \p actual_q, read from the state cache.
+   *
+   * \param enabled Whether the inverse kinematics are solved on the client
+   * \param tcp_offset Pose of the TCP relative to the tool flange. It has to match the TCP set on
+   * the robot.
+   *
+   * \returns False, if the robot's calibration hasn't been received on the primary interface yet,
+   * true otherwise
+   */
+  bool setClientSideInverseKinematics(const bool enabled,
+                                      const vector6d_t& tcp_offset = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+
   /*!
    * \brief Starts the RTDE communication.
    *
@@ -518,7 +1088,8 @@ public:
 
   /*!
    * \brief Sends a stop command to the socket interface which will signal the program running on
-   * the robot to no longer listen for commands sent from the remote pc.
+   * the robot to no longer listen for commands sent from the remote pc. Like a
+   * TrajectoryControlMessage::TRAJECTORY_CANCEL, this stops writing the points of a trajectory.
    *
    * \returns True on successful write.
    */
@@ -527,6 +1098,9 @@ public:
   /*!
    * \brief Checks if the kinematics information in the used model fits the actual robot.
    *
+   * The primary client receives the kinematics information concurrently to the RTDE setup while
+   * the driver is constructed, so this usually returns without waiting for the robot.
+   *
    * \param checksum Hash of the used kinematics information
    *
    * \returns True if the robot's calibration checksum matches the one given to the checker. False
@@ -552,6 +1126,17 @@ public:
    */
   bool sendScript(const std::string& program);
 
+  /*!
+   * \brief Getter for the client to the robot's primary interface, which is used to send scripts
+   * and can be used to consume robot state and messages, e.g. runtime exceptions.
+   *
+   * \returns The driver's primary client
+   */
+  primary_interface::PrimaryClient& getPrimaryClient()
+  {
+    return *primary_client_;
+  }
+
   /*!
    * \brief Sends the external control program to the robot.
    *
@@ -569,6 +1154,15 @@ public:
     return robot_version_;
   }
 
+  /*!
+   * \brief Returns the capabilities of the currently connected robot's version, computed once
+   * when connecting
+   */
+  const VersionCapabilities& getVersionCapabilities() const
+  {
+    return robot_capabilities_;
+  }
+
   /*!
    * \brief Getter for the RTDE output recipe used in the RTDE client.
    *
@@ -576,6 +1170,23 @@ public:
    */
   std::vector<std::string> getRTDEOutputRecipe();
 
+  /*!
+   * \brief Resolves a field of the RTDE output recipe to a handle for fast access, e.g. from the
+   * callback passed to enableRTDESynchronizedCommands(). Handles have to be resolved again after
+   * resetting the RTDE client.
+   *
+   * \param name The string identifier for the data field as used in the documentation
+   *
+   * \throws UrException if the field isn't part of the output recipe or the type doesn't match
+   *
+   * \returns A handle to the data field
+   */
+  template <typename T>
+  rtde_interface::FieldHandle<T> getRTDEOutputFieldHandle(const std::string& name) const
+  {
+    return rtde_client_->getOutputFieldHandle<T>(name);
+  }
+
   /*!
    * \brief Set the Keepalive count. This will set the number of allowed timeout reads on the robot.
    *
@@ -596,7 +1207,7 @@ public:
    */
   void registerTrajectoryDoneCallback(std::function<void(control::TrajectoryResult)> trajectory_done_cb)
   {
-    trajectory_interface_->setTrajectoryEndCallback(trajectory_done_cb);
+    trajectoryInterface().setTrajectoryEndCallback(trajectory_done_cb);
   }
 
   /*!
@@ -609,7 +1220,8 @@ public:
    */
   void registerToolContactResultCallback(std::function<void(control::ToolContactResult)> tool_contact_result_cb)
   {
-    script_command_interface_->setToolContactResultCallback(tool_contact_result_cb);
+    script_state_monitor_->setToolContactResultCallback(tool_contact_result_cb);
+    scriptCommandInterface().setToolContactResultCallback(tool_contact_result_cb);
   }
 
   /**
@@ -647,24 +1259,583 @@ public:
   void resetRTDEClient(const std::string& output_recipe_filename, const std::string& input_recipe_filename,
                        double target_frequency = 0.0, bool ignore_unavailable_outputs = false);
 
+  /**
+   * \brief Switches the RTDE output recipe on the existing RTDE connection. In contrast to
+   * resetRTDEClient() the connection is kept and RTDE communication continues after the switch, if
+   * it was started before. See RTDEClient::switchOutputRecipe() for details.
+   *
+   * \param output_recipe Vector containing the new output recipe
+   *
+   * \returns True on success, false if the client couldn't be paused or resumed
+   */
+  bool switchRTDEOutputRecipe(const std::vector<std::string>& output_recipe);
+
   void registerTrajectoryInterfaceDisconnectedCallback(std::function<void(const int)> fun)
   {
-    trajectory_interface_->registerDisconnectionCallback(fun);
+    trajectoryInterface().registerDisconnectionCallback(fun);
   }
 
-private:
-  static std::string readScriptFile(const std::string& filename);
   /*!
-   * \brief Reconnects the secondary stream used to send program to the robot.
+   * \brief Sets scheduling, CPU affinity and name of all threads of the driver, i.e. the RTDE
+   * client's threads and the threads of the servers the robot connects to.
    *
-   * Only for use in headless mode, as it replaces the use of the URCaps program.
+   * A name given in the config is extended with a short suffix per thread, e.g. "_rtde_rx" or
+   * "_rev". The settings are applied to running threads immediately and are kept when the RTDE
+   * client is reset using resetRTDEClient().
+   *
+   * \param config The thread settings
+   */
+  void setThreadConfig(const ThreadConfig& config);
+
+  /*!
+   * \brief Sets tuning options for all sockets of the driver, i.e. the RTDE and primary
+   * connections as well as the sockets of the robot connecting to the reverse, trajectory, script
+   * command and script sender interfaces.
+   *
+   * Options of connected sockets are applied immediately, the interfaces' servers apply them to
+   * robot connections established afterwards. The options are kept when the RTDE client is reset.
+   *
+   * \param options The socket options
+   */
+  void setSocketOptions(const comm::SocketOptions& options);
+
+  /*!
+   * \brief Lets a reactor handle the connections of the servers the robot connects to, i.e. the
+   * reverse, trajectory, script command and script sender interfaces, instead of one thread per
+   * server.
+   *
+   * Sharing one reactor between the drivers of many robots reduces the number of threads and
+   * context switches per robot. The RTDE client keeps its own threads, as it has to read every
+   * package in time.
+   *
+   * \param reactor The reactor to use, nullptr to use a thread per server again
+   */
+  void setReactor(std::shared_ptr<comm::Reactor> reactor);
+
+  /*!
+   * \brief Enables recording the latencies of received RTDE packages. See
+   * rtde_interface::RTDEClient::setLatencyInstrumentation() for details. This has to be called
+   * before startRTDECommunication() and is kept when the RTDE client is reset.
+   *
+   * \param enabled True to record latencies, false to disable recording
+   */
+  void setRTDELatencyInstrumentation(const bool enabled);
+
+  /*!
+   * \brief Enables detecting a lost connection to the robot within a few RTDE periods. See
+   * rtde_interface::RTDEClient::setStaleStreamDetection() for details.
+   *
+   * Once the RTDE stream is stale, the reverse interface stops sending setpoints of realtime
+   * control modes, see control::ReverseInterface::setRobotStateStale(), and the callback is
+   * called. Both are notified again once the stream is fresh. This has to be called before
+   * startRTDECommunication() and is kept when the RTDE client is reset.
+   *
+   * \param missed_periods Number of RTDE periods without a fresh package, 0 disables detection
+   * \param stale_callback Called with true once the stream is stale and with false once it is
+   * fresh again. It is called from the RTDE threads and has to return quickly.
+   */
+  void setStaleRTDEStreamDetection(const size_t missed_periods, std::function<void(bool)> stale_callback = nullptr);
+
+  /*!
+   * \brief Registers a callback for edges of a digital input or output, timestamped with the robot's
+   * RTDE timestamp. See rtde_interface::RTDEClient::addIOEdgeCallback() for details. This has to be
+   * called before startRTDECommunication() and is kept when the RTDE client is reset.
+   *
+   * \param bank The group of the I/O
+   * \param pin The pin inside the group
+   * \param edge The edges to report
+   * \param callback Function to call with every detected edge. It is called from the RTDE thread and
+   * has to return quickly.
+   *
+   * \throws UrException if the bank doesn't have the given pin
+   */
+  void addIOEdgeCallback(const rtde_interface::IOBank bank, const uint8_t pin, const rtde_interface::IOEdge edge,
+                         rtde_interface::IOEventEngine::EdgeCallback callback);
+
+  /*!
+   * \brief Switches the RTDE output frequency automatically between an idle and an active
+   * frequency. See rtde_interface::RTDEClient::setOutputFrequencyPolicy() for details. The RTDE
+   * output recipe has to contain \p robot_mode and \p runtime_state. This has to be called before
+   * startRTDECommunication() and is kept when the RTDE client is reset.
+   *
+   * \param policy The policy to use, nullptr to keep the current frequency
+   */
+  void setRTDEOutputFrequencyPolicy(std::shared_ptr<rtde_interface::OutputFrequencyPolicy> policy);
+
+  /*!
+   * \brief Configures the queue handing received RTDE data packages to the consumers, see
+   * rtde_interface::RTDEClient::setPipelineQueue(). A smaller queue bounds the memory of packages
+   * waiting to be consumed. This has to be called before startRTDECommunication() and is kept when
+   * the RTDE client is reset.
+   *
+   * \param capacity Maximum number of queued packages
+   * \param policy What to do with new packages while the queue is full
+   */
+  void setRTDEPipelineQueue(const size_t capacity, const comm::OverflowPolicy policy);
+
+  /*!
+   * \brief Getter for the recorded latencies of received RTDE packages.
+   *
+   * \returns The latency statistics, nullptr if latency instrumentation is disabled
+   */
+  std::shared_ptr<comm::LatencyStatistics> getRTDELatencyStatistics() const
+  {
+    return rtde_client_->getLatencyStatistics();
+  }
+
+  /*!
+   * \brief Starts sampling round-trip times and retransmits of the RTDE, primary,
+   * reverse, trajectory and script command connections in a thread of its own. See
+   * comm::ConnectionHealthMonitor for details. A monitor started before is replaced.
+   *
+   * \param sample_interval Interval in between two samples of all connections
+   */
+  void startConnectionHealthMonitoring(
+      const std::chrono::milliseconds sample_interval = comm::ConnectionHealthMonitor::DEFAULT_SAMPLE_INTERVAL);
+
+  /*!
+   * \brief Stops sampling the connections. The monitor and its last samples are kept.
+   */
+  void stopConnectionHealthMonitoring();
+
+  /*!
+   * \brief Getter for the monitor started using startConnectionHealthMonitoring(). Further
+   * connections, e.g. of a DashboardClient, can be added to it. The monitor is owned by the
+   * driver.
+   *
+   * \returns The connection health monitor, nullptr if monitoring has never been started
+   */
+  comm::ConnectionHealthMonitor* getConnectionHealthMonitor() const
+  {
+    return health_monitor_.get();
+  }
+
+  /*!
+   * \brief Getter for the number of received RTDE packages discarded, because they weren't read in
+   * time.
+   *
+   * \returns The number of discarded packages since RTDE communication has been started
+   */
+  uint64_t getNumDroppedRTDEPackages() const
+  {
+    return rtde_client_->getNumDroppedPackages();
+  }
+
+  /*!
+   * \brief Checks whether the program running on the robot is connected to the driver.
+   *
+   * \returns True, if the robot is connected to the reverse interface. Always false without a
+   * reverse interface.
+   */
+  bool isReverseInterfaceConnected() const
+  {
+    return reverse_interface_ != nullptr && reverse_interface_->isConnected();
+  }
+
+  /*!
+   * \brief Use the compact message format on the reverse socket if the script running on the robot
+   * supports it. See control::ReverseInterface::setUseCompactProtocol() for details.
+   *
+   * \param use_compact True to use the compact format when the robot supports it
+   */
+  void setUseCompactReverseProtocol(const bool use_compact)
+  {
+    reverseInterface().setUseCompactProtocol(use_compact);
+  }
+
+  /*!
+   * \brief Getter for the IP address of the robot this driver is connected to.
+   *
+   * \returns The robot's IP address
+   */
+  const std::string& getRobotIP() const
+  {
+    return robot_ip_;
+  }
+
+  /*!
+   * \brief Getter for the port the program can be requested on by the External Control URCap. If
+   * the driver has been created with script sender port 0, this is the port assigned by the
+   * operating system.
+   *
+   * \returns The script sender's port, 0 if the driver has no script sender
+   */
+  uint32_t getScriptSenderPort() const
+  {
+    return script_sender_ != nullptr ? script_sender_->getPort() : 0;
+  }
+
+  /*!
+   * \brief Minifies the control program before it is sent to the robot.
+   *
+   * This applies to every request of the program by the robot and, in headless mode, to every
+   * call to sendRobotProgram() from now on. Leaving out the sections of unused control modes
+   * reduces the size of the program and the time the robot needs to compile it.
+   *
+   * \param minifier The minifier to use, std::nullopt to send the program as it is
+   *
+   * \throws UrException if the program's sections are not nested properly
+   */
+  void setScriptMinifier(const std::optional<ScriptMinifier>& minifier);
+
+  /*!
+   * \brief Keeps the control program running on the robot when it doesn't receive a command in
+   * time.
+   *
+   * By default, the program exits when the read timeout of a command expires, e.g. because the
+   * application stopped sending commands. A resident program stops the robot and parks instead,
+   * reconnecting to the reverse interface if needed. The next command written re-arms it, so no
+   * program has to be sent and compiled again. Programs stopped by the controller, e.g. by
+   * stopping them on the teach pendant, still have to be restarted.
+   *
+   * This applies to every request of the program by the robot and, in headless mode, to every
+   * call to sendRobotProgram() from now on.
+   *
+   * \param resident True to park the program instead of exiting it
+   */
+  void setResidentProgram(const bool resident);
+
+  /*!
+   * \brief Configures a hot standby host the program running on the robot fails over to, if it
+   * loses this host.
+   *
+   * The standby host runs a second driver created with DriverCapabilities::STANDBY, which keeps
+   * its RTDE and primary connections, control servers and rendered program ready. Both drivers
+   * have to use the same ports and list each other as standby host.
+   *
+   * When the program doesn't receive a command in time, it parks like a resident program, see
+   * setResidentProgram(). While it is parked, this driver writes heartbeats every quarter of the
+   * failover timeout. If the program loses the connection or doesn't receive anything for the
+   * failover timeout, it reconnects all control sockets, alternating between both hosts. The
+   * driver the program connects to has control over the robot, which is re-armed by its next
+   * command. A host that has powered off silently is detected after the failover timeout, a closed
+   * connection right away.
+   *
+   * This applies to every request of the program by the robot and, in headless mode, to every
+   * call to sendRobotProgram() from now on.
+   *
+   * \param standby_ip IP address the robot reaches the standby host at, empty to disable failover
+   * \param failover_timeout Time a parked program waits for a heartbeat before failing over
+   *
+   * \throws UrException if the failover timeout isn't positive
+   */
+  void setStandbyHost(const std::string& standby_ip,
+                      const std::chrono::milliseconds failover_timeout = std::chrono::milliseconds(500));
+
+  /*!
+   * \brief Takes over control over the robot as hot standby, see setStandbyHost().
+   *
+   * Waits for the program to connect to this driver after failing over. In headless mode, the
+   * program is sent to the robot, if it hasn't connected when the timeout expires, e.g. because
+   * it has been stopped together with the failed host.
    *
-   * \returns true of on successful reconnection, false otherwise
+   * \param timeout Time to wait for the program to fail over to this driver
+   *
+   * \returns True if the program is connected to this driver or has been sent, false otherwise
+   */
+  bool takeOver(const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Sets the number of trajectory points the program running on the robot keeps in its
+   * trajectory cache, see replayTrajectory().
+   *
+   * The cache holds up to 16 trajectories, the oldest one is evicted when a new one doesn't fit.
+   * Every point takes 21 integers of the robot program's memory. The cache is disabled by default.
+   *
+   * This applies to every request of the program by the robot and, in headless mode, to every
+   * call to sendRobotProgram() from now on. A running program keeps its cache until it exits,
+   * which a resident program doesn't, see setResidentProgram().
+   *
+   * \param num_points Capacity of the cache in trajectory points, 0 disables the cache
+   */
+  void setTrajectoryCacheCapacity(const size_t num_points);
+
+  /*!
+   * \brief Lets the program running on the robot mirror its freedrive and tool contact state into
+   * an RTDE output integer register.
+   *
+   * The state is written to output_int_register_<register_index>, which has to be part of the
+   * output recipe, see control::ScriptStateMonitor for its encoding. Changes are detected by the
+   * RTDE client within one RTDE cycle and reported to the callbacks registered using
+   * registerFreedriveStateCallback() and registerToolContactResultCallback(). Tool contact results
+   * aren't sent on the script command socket anymore then.
+   *
+   * This has to be called before starting the RTDE communication and applies to every request of
+   * the program by the robot and, in headless mode, to every call to sendRobotProgram() from now
+   * on. The register can only be chosen once.
+   *
+   * \param register_index Index of the output integer register to use, in [0, 47]
+   *
+   * \throws UrException if the index is out of range, the register isn't part of the output recipe
+   * or another register has been chosen before
+   */
+  void setStateOutputRegister(const int register_index);
+
+  /*!
+   * \brief Sets the RTDE input integer register starting trajectories armed using armTrajectory().
+   *
+   * An armed trajectory is executed once input_int_register_<register_index> holds its start token.
+   * The register has to be part of the input recipe. Clock synchronization of the RTDE client is
+   * enabled, so starts can be scheduled at host times, see scheduleTrajectoryStart().
+   *
+   * This has to be called before starting the RTDE communication and applies to every request of
+   * the program by the robot and, in headless mode, to every call to sendRobotProgram() from now
+   * on. The register can only be chosen once.
+   *
+   * \param register_index Index of the input integer register to use, in [24, 47]
+   *
+   * \throws UrException if the index is out of range or another register has been chosen before
+   */
+  void setTrajectoryStartRegister(const int register_index);
+
+  /*!
+   * \brief Lets the program running on the robot mirror the progress of the executed trajectory
+   * into RTDE output registers every control cycle, see control::TrajectoryProgressMonitor.
+   *
+   * output_int_register_<index_register> holds the index of the executed point, -1 while no
+   * trajectory is executed. output_double_register_<time_register> holds the time left until that
+   * point is reached. Both registers have to be part of the output recipe. The progress is passed
+   * to the callback registered using registerTrajectoryProgressCallback().
+   *
+   * This has to be called before starting the RTDE communication and applies to every request of
+   * the program by the robot and, in headless mode, to every call to sendRobotProgram() from now
+   * on. The registers can only be chosen once.
+   *
+   * \param index_register Index of the output integer register to use, in [0, 47]
+   * \param time_register Index of the output double register to use, in [0, 47]
+   *
+   * \throws UrException if an index is out of range, a register isn't part of the output recipe or
+   * the registers have been chosen before
+   */
+  void setTrajectoryProgressRegisters(const int index_register, const int time_register);
+
+  /*!
+   * \brief Register a callback for the progress of the executed trajectory. It is called on the
+   * RTDE client's thread with every data package received while a trajectory is executed and once
+   * more when it has ended.
+   *
+   * This requires the progress being mirrored into RTDE registers, see
+   * setTrajectoryProgressRegisters(), and has to be called before starting the RTDE communication.
+   *
+   * \param trajectory_progress_cb Callback function called with the progress of each cycle
+   */
+  void registerTrajectoryProgressCallback(control::TrajectoryProgressMonitor::ProgressCallback trajectory_progress_cb)
+  {
+    trajectory_progress_cb_ = trajectory_progress_cb;
+    if (trajectory_progress_monitor_ != nullptr)
+    {
+      trajectory_progress_monitor_->setProgressCallback(trajectory_progress_cb);
+    }
+  }
+
+  /*!
+   * \brief Getter for the monitor decoding the trajectory progress, see
+   * setTrajectoryProgressRegisters().
+   *
+   * \returns The monitor or nullptr, if the progress isn't mirrored into RTDE registers
+   */
+  std::shared_ptr<const control::TrajectoryProgressMonitor> getTrajectoryProgressMonitor() const
+  {
+    return trajectory_progress_monitor_;
+  }
+
+  /*!
+   * \brief Lets the program running on the robot echo the sequence number of every setpoint it
+   * receives into an RTDE output integer register, to measure the round trip of setpoints, see
+   * control::SetpointLatencyMonitor.
+   *
+   * The reverse interface then numbers every setpoint written using writeJointCommand() and the
+   * monitor matches them with the echoes received through RTDE. The latencies are available from
+   * getSetpointLatencyMonitor() and as the \p urcl_setpoint_round_trip_seconds metric. The
+   * register has to be part of the output recipe.
+   *
+   * This has to be called before starting the RTDE communication and applies to every request of
+   * the program by the robot and, in headless mode, to every call to sendRobotProgram() from now
+   * on. The register can only be chosen once.
+   *
+   * \param echo_register Index of the output integer register to use, in [0, 47]
+   *
+   * \throws UrException if the index is out of range, the register isn't part of the output recipe,
+   * a register has been chosen before or the driver has no reverse interface
+   */
+  void setSetpointEchoRegister(const int echo_register);
+
+  /*!
+   * \brief Getter for the monitor measuring the round trip of setpoints, see
+   * setSetpointEchoRegister().
+   *
+   * \returns The monitor or nullptr, if setpoints aren't echoed
+   */
+  std::shared_ptr<const control::SetpointLatencyMonitor> getSetpointLatencyMonitor() const
+  {
+    return setpoint_latency_monitor_;
+  }
+
+  /*!
+   * \brief Changes the lookahead time and gain servoj is called with in MODE_SERVOJ without
+   * restarting the program, see control::ReverseInterface::writeServoParameters(). A restarted
+   * program uses the parameters given to the constructor again.
+   *
+   * \param lookahead_time Lookahead time in seconds, range [0.03, 0.2]
+   * \param gain Proportional gain, range [100, 2000]
+   *
+   * \returns True if the parameters have been sent
+   */
+  bool setServojParameters(const double lookahead_time, const uint32_t gain);
+
+  /*!
+   * \brief Adapts the lookahead time and optionally the gain of servoj to the jitter of the
+   * setpoints written in MODE_SERVOJ, see control::AdaptiveServojTuner.
+   *
+   * The adaption starts from the parameters given to the constructor. Changed parameters are sent
+   * through the reverse interface while the program keeps running.
+   *
+   * \param enabled True to adapt the parameters, false to keep the parameters sent last
+   * \param config Bounds and measurement window of the adaption
+   */
+  void setAdaptiveServojTuning(const bool enabled,
+                               const control::AdaptiveServojConfig& config = control::AdaptiveServojConfig());
+
+  /*!
+   * \brief Getter for the tuner adapting the servoj parameters, see setAdaptiveServojTuning().
+   *
+   * \returns The tuner or nullptr, if the parameters aren't adapted
+   */
+  std::shared_ptr<const control::AdaptiveServojTuner> getAdaptiveServojTuner() const;
+
+  /*!
+   * \brief Enables transferring arrays of doubles to the robot program through RTDE registers, see
+   * rtde_interface::RegisterTransfer and sendRegisterArray().
+   *
+   * The control and data registers have to be part of the input recipe, the acknowledgement
+   * register has to be part of the output recipe. The robot program receives the arrays in a
+   * thread of its own and provides them in the globals \p register_transfer_data,
+   * \p register_transfer_length and \p register_transfer_id. \p register_transfer_count is
+   * incremented with every completed transfer.
+   *
+   * This has to be called before starting the RTDE communication and applies to every request of
+   * the program by the robot and, in headless mode, to every call to sendRobotProgram() from now
+   * on. The registers can only be chosen once.
+   *
+   * \param config Registers used for the transfers and the maximum number of values per transfer
+   *
+   * \throws UrException if a register is out of range, the acknowledgement register isn't part of
+   * the output recipe or transfers have been enabled before
    */
-  bool reconnectSecondaryStream();
+  void enableRegisterTransfer(const rtde_interface::RegisterTransferConfig& config);
 
+  /*!
+   * \brief Sends an array of doubles to the robot program through RTDE registers, blocking until
+   * the robot program has received all values. See enableRegisterTransfer().
+   *
+   * Each chunk of registers takes one round trip to the robot, usually two RTDE cycles.
+   *
+   * \param values The values to send, at most RegisterTransferConfig::capacity
+   * \param id Id passed to the robot program along with the values
+   * \param chunk_timeout Maximum time to wait for the robot program to acknowledge each chunk
+   *
+   * \throws UrException if transfers haven't been enabled, there are too many values or the
+   * registers aren't part of the input recipe
+   *
+   * \returns True if the robot program received all values, false otherwise
+   */
+  bool sendRegisterArray(const std::vector<double>& values, const int32_t id,
+                         const std::chrono::milliseconds chunk_timeout = std::chrono::milliseconds(100));
+
+  /*!
+   * \brief Register a callback for freedrive mode being activated or deactivated on the robot.
+   *
+   * This requires the state being mirrored into an RTDE register, see setStateOutputRegister().
+   *
+   * \param freedrive_state_cb Callback function called with true once freedrive mode is active and
+   * false once it has ended
+   */
+  void registerFreedriveStateCallback(std::function<void(bool)> freedrive_state_cb)
+  {
+    script_state_monitor_->setFreedriveStateCallback(freedrive_state_cb);
+  }
+
+  /*!
+   * \brief Getter for the monitor decoding the state mirrored into an RTDE register, see
+   * setStateOutputRegister().
+   */
+  std::shared_ptr<const control::ScriptStateMonitor> getScriptStateMonitor() const
+  {
+    return script_state_monitor_;
+  }
+
+  /*!
+   * \brief Checks whether a resident program running on the robot is parked, see
+   * setResidentProgram().
+   *
+   * \returns True, if the program is parked and waiting to be re-armed by the next command
+   */
+  bool isProgramParked() const;
+
+  /*!
+   * \brief Getter for the time spent in the phases of the driver's startup, e.g. to find out what
+   * bounds bringing up a cell of robots.
+   *
+   * \returns The durations of the startup phases
+   */
+  const StartupTimings& getStartupTimings() const
+  {
+    return startup_timings_;
+  }
+
+  /*!
+   * \brief Checks whether the driver provides all of the given optional interfaces.
+   *
+   * \param capabilities The interfaces to check
+   *
+   * \returns True, if all interfaces have been created
+   */
+  bool hasCapabilities(const DriverCapabilities capabilities) const
+  {
+    return (capabilities_ & capabilities) == capabilities;
+  }
+
+  /*!
+   * \brief Lets the program running on the robot reconnect to the reverse interface without
+   * being reported as stopped, see control::ReverseInterface::setSessionResumeTimeout().
+   *
+   * Together with a resident program, a brief loss of the connection doesn't change the program
+   * state passed to the program state callback.
+   *
+   * \param timeout Time the program may take to reconnect, 0 to report every lost connection
+   */
+  void setSessionResumeTimeout(const std::chrono::milliseconds timeout);
+
+private:
+  static std::string readScriptFile(const std::string& filename);
+  //! Prepares the given program to be sent to the robot
+  void updateRobotProgram(const std::string& program);
   void initRTDE();
+  //! Lets the RTDE client notify the setpoint interpolator about every package received
+  void observeRTDEForSetpointInterpolation();
+  //! Lets the RTDE client trigger the command scheduler with every package received
+  void observeRTDEForCommandScheduling();
+  //! Lets the RTDE client pass changes of the state output register to the script state monitor
+  void observeRTDEForScriptState();
+  //! Lets the RTDE client trigger the start of armed trajectories and synchronize its clock
+  void observeRTDEForTrajectoryStart();
+  //! Lets the RTDE client pass every package to the trajectory progress monitor
+  void observeRTDEForTrajectoryProgress();
+  void observeRTDEForSetpointLatency();
+  //! Lets the RTDE client pass changes of the acknowledgement register to the register transfer
+  void observeRTDEForRegisterTransfer();
+  //! Passes the stale stream detection settings to the RTDE client
+  void configureStaleRTDEStreamDetection();
   void setupReverseInterface(const uint32_t reverse_port);
+  //! Accessors for the optional interfaces, throwing if the driver has been created without them
+  control::ReverseInterface& reverseInterface() const;
+  control::TrajectoryPointInterface& trajectoryInterface() const;
+  control::ScriptCommandInterface& scriptCommandInterface() const;
+  //! Checks points using the trajectory validator if set, logging the first violation
+  template <typename T>
+  bool validateTrajectory(const T* points, const size_t count) const;
+  //! Throws if the robot program hasn't been prepared, as there is no reverse interface
+  const ScriptTemplate& scriptTemplate() const;
 
   comm::INotifier notifier_;
   std::unique_ptr<rtde_interface::RTDEClient> rtde_client_;
@@ -672,8 +1843,7 @@ private:
   std::unique_ptr<control::TrajectoryPointInterface> trajectory_interface_;
   std::unique_ptr<control::ScriptCommandInterface> script_command_interface_;
   std::unique_ptr<control::ScriptSender> script_sender_;
-  std::unique_ptr<comm::URStream<primary_interface::PrimaryPackage>> primary_stream_;
-  std::unique_ptr<comm::URStream<primary_interface::PrimaryPackage>> secondary_stream_;
+  std::unique_ptr<primary_interface::PrimaryClient> primary_client_;
 
   double force_mode_gain_scale_factor_ = 0.5;
   double force_mode_damping_factor_ = 0.025;
@@ -685,12 +1855,65 @@ private:
 
   std::string robot_ip_;
   bool in_headless_mode_;
+  ThreadConfig thread_config_;
+  std::optional<comm::SocketOptions> socket_options_;
+  bool rtde_latency_instrumentation_ = false;
+  size_t stale_stream_periods_ = 0;
+  std::function<void(bool)> stale_stream_callback_;
+
+  struct IOEdgeSubscription
+  {
+    rtde_interface::IOBank bank;
+    uint8_t pin;
+    rtde_interface::IOEdge edge;
+    rtde_interface::IOEventEngine::EdgeCallback callback;
+  };
+  std::vector<IOEdgeSubscription> io_edge_subscriptions_;
+  std::shared_ptr<rtde_interface::OutputFrequencyPolicy> rtde_frequency_policy_;
+  // Queue of the RTDE client's pipeline, a capacity of 0 keeps the client's default
+  size_t rtde_queue_capacity_ = 0;
+  comm::OverflowPolicy rtde_queue_policy_ = comm::OverflowPolicy::DROP_NEWEST;
   std::string full_robot_program_;
+  std::string robot_program_;
+  std::shared_ptr<const ScriptTemplate> script_template_;
+  ScriptParameters script_parameters_;
+  std::optional<ScriptMinifier> script_minifier_;
 
   int get_packet_timeout_;
   bool non_blocking_read_;
 
   VersionInformation robot_version_;
+  VersionCapabilities robot_capabilities_;
+  StartupTimings startup_timings_;
+  DriverCapabilities capabilities_;
+
+  // Shared with the RTDE client notifying it. Stopped when the driver is destroyed.
+  std::shared_ptr<control::SetpointInterpolator> setpoint_interpolator_;
+  comm::ControlMode interpolation_control_mode_ = comm::ControlMode::MODE_IDLE;
+  RobotReceiveTimeout interpolation_receive_timeout_ = RobotReceiveTimeout::millisec(20);
+  bool interpolation_time_scaling_ = false;
+  // Shared with the RTDE client triggering it. Deactivated when the driver is destroyed.
+  std::shared_ptr<control::RTDECommandScheduler> command_scheduler_;
+  // Shared with the RTDE client passing it changes of the state output register
+  std::shared_ptr<control::ScriptStateMonitor> script_state_monitor_ = std::make_shared<control::ScriptStateMonitor>();
+  int state_output_register_ = -1;
+  // Shared with the RTDE client triggering armed trajectories
+  std::shared_ptr<control::TrajectoryStartTrigger> trajectory_start_trigger_;
+  int trajectory_start_register_ = -1;
+  // Shared with the RTDE client passing it the progress registers
+  std::shared_ptr<control::TrajectoryProgressMonitor> trajectory_progress_monitor_;
+  control::TrajectoryProgressMonitor::ProgressCallback trajectory_progress_cb_;
+  std::shared_ptr<control::SetpointLatencyMonitor> setpoint_latency_monitor_;
+  // Shared with the RTDE client passing it acknowledgements of transferred chunks
+  std::shared_ptr<rtde_interface::RegisterTransfer> register_transfer_;
+  // Checks trajectory points before they are written, if set
+  std::shared_ptr<const control::TrajectoryValidator> trajectory_validator_;
+  // Created on demand, declared after the interfaces it writes to so it is destroyed first
+  std::shared_ptr<control::CommandArbiter> command_arbiter_;
+  std::mutex command_arbiter_mutex_;
+
+  // Declared last, so sampling stops before the connections it samples are destroyed
+  std::unique_ptr<comm::ConnectionHealthMonitor> health_monitor_;
 };
 }  // namespace urcl
 #endif  // ifndef UR_CLIENT_LIBRARY_UR_UR_DRIVER_H_INCLUDED
\ No newline at end of file
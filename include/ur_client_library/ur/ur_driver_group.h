@@ -0,0 +1,217 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
+#define UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/comm/latency_statistics.h"
+#include "ur_client_library/comm/reactor.h"
+#include "ur_client_library/helpers.h"
+#include "ur_client_library/ur/ur_driver.h"
+
+namespace urcl
+{
+/*!
+ * \brief Health of a single driver inside a UrDriverGroup.
+ */
+struct DriverHealth
+{
+  //! IP address of the robot
+  std::string robot_ip;
+  //! Whether the program running on the robot is connected to the driver
+  bool reverse_interface_connected = false;
+  //! Number of received RTDE packages discarded, because they weren't read in time
+  uint64_t num_dropped_rtde_packages = 0;
+  //! Latencies of the received RTDE packages
+  std::shared_ptr<comm::LatencyStatistics> latency_statistics;
+};
+
+/*!
+ * \brief Hosts the drivers of several robots, sharing a fixed pool of I/O threads between them.
+ *
+ * The connections of the servers the robots connect to are multiplexed on the event loops of one
+ * comm::Reactor, which can be pinned to dedicated cores. Every driver handed to the group records
+ * RTDE latencies, so the health and latencies of all robots can be observed in one place. Each
+ * driver keeps its own RTDE threads, as the RTDE stream of a robot must not be delayed by the
+ * others.
+ */
+class UrDriverGroup
+{
+public:
+  /*!
+   * \brief Creates a group without drivers and starts its I/O threads.
+   *
+   * \param num_io_threads Number of I/O threads shared by all drivers. Has to be at least 1.
+   * \param io_thread_config Settings of the I/O threads. If CPUs are given, every thread is pinned
+   * to one of them in turns. A given name is extended with the index of the thread.
+   */
+  explicit UrDriverGroup(const size_t num_io_threads = 1, const ThreadConfig& io_thread_config = ThreadConfig());
+
+  /*!
+   * \brief Moves the drivers back to threads of their own, so they can outlive the group.
+   */
+  ~UrDriverGroup();
+
+  /*!
+   * \brief Adds a driver to the group. Its servers are moved to the group's I/O threads and RTDE
+   * latency instrumentation is enabled. This has to be called before the driver's RTDE
+   * communication is started.
+   *
+   * \param driver The driver to add
+   *
+   * \returns The index of the driver inside the group
+   */
+  size_t addDriver(std::shared_ptr<UrDriver> driver);
+
+  /*!
+   * \brief Creates a driver on the NUMA node of the CPUs its threads are pinned to and adds it to
+   * the group.
+   *
+   * The driver is created on a thread pinned to the CPUs of \p thread_config, so the pools, queues
+   * and buffers it allocates are placed on their node, see runOnNumaNode(). Its RTDE communication
+   * is started the same way by startRTDECommunication(). Afterwards, \p thread_config is applied to
+   * all threads of the driver, see UrDriver::setThreadConfig(). Components allocating memory later,
+   * e.g. a control::SharedCommandServer, should be created using runOnNumaNode() as well.
+   *
+   * \param factory Function creating the driver
+   * \param thread_config Settings of the driver's threads
+   *
+   * \returns The index of the driver inside the group
+   */
+  size_t addDriver(const std::function<std::shared_ptr<UrDriver>()>& factory, const ThreadConfig& thread_config);
+
+  /*!
+   * \brief Getter for a driver of the group.
+   *
+   * \param index The index returned by addDriver()
+   *
+   * \throws std::out_of_range if there is no driver with the given index
+   *
+   * \returns The driver
+   */
+  std::shared_ptr<UrDriver> getDriver(const size_t index) const;
+
+  /*!
+   * \brief Getter for the number of drivers in the group.
+   *
+   * \returns The number of drivers
+   */
+  size_t getNumDrivers() const;
+
+  /*!
+   * \brief Starts RTDE communication of all drivers.
+   */
+  void startRTDECommunication();
+
+  /*!
+   * \brief Collects the health of all drivers.
+   *
+   * \returns One entry per driver, in the order the drivers have been added
+   */
+  std::vector<DriverHealth> getHealth() const;
+
+  /*!
+   * \brief Getter for the number of drivers whose robot program is connected.
+   *
+   * \returns The number of connected drivers
+   */
+  size_t getNumConnected() const;
+
+  /*!
+   * \brief Aggregates the RTDE latencies of all drivers.
+   *
+   * \returns A snapshot of the latencies of all drivers combined
+   */
+  std::shared_ptr<comm::LatencyStatistics> getAggregatedLatencyStatistics() const;
+
+  /*!
+   * \brief Arms a new trajectory on every robot of the group, so they can be started together
+   * using startArmedTrajectories().
+   *
+   * All robots get the same, newly created start token, see UrDriver::armTrajectory(). Every driver
+   * needs a start register, see UrDriver::setTrajectoryStartRegister(). Once armed, the trajectory
+   * points are written to each driver as usual.
+   *
+   * \param point_numbers Number of points of the trajectory of each robot, in the order the drivers
+   * have been added
+   * \param robot_receive_timeout The read timeout configuration for the reverse sockets
+   *
+   * \throws UrException if the number of trajectories doesn't match the number of drivers
+   *
+   * \returns False if a trajectory couldn't be armed, true otherwise
+   */
+  bool armTrajectories(const std::vector<int>& point_numbers,
+                       const RobotReceiveTimeout& robot_receive_timeout = RobotReceiveTimeout::millisec(200));
+
+  /*!
+   * \brief Starts the trajectories armed using armTrajectories() on all robots at the same time.
+   *
+   * The start is scheduled \p lead_time ahead, which has to cover writing the start token to every
+   * robot. Each driver maps the start time to its robot's clock and writes the start token in the
+   * RTDE cycle before, see UrDriver::scheduleTrajectoryStart(), so the robots start within about one
+   * control period of each other instead of depending on when each start message is sent.
+   *
+   * \param lead_time Time from now the trajectories are started at
+   * \param timeout Time to wait after the start time for all start tokens to be written
+   *
+   * \returns False if nothing has been armed, a start couldn't be scheduled or a start token
+   * hasn't been written in time, true otherwise. Starts not triggered yet are cancelled on failure.
+   */
+  bool startArmedTrajectories(const std::chrono::milliseconds lead_time = std::chrono::milliseconds(50),
+                              const std::chrono::milliseconds timeout = std::chrono::milliseconds(500));
+
+  /*!
+   * \brief Getter for the reactor running the group's I/O threads.
+   *
+   * \returns The reactor shared by all drivers
+   */
+  std::shared_ptr<comm::Reactor> getReactor() const
+  {
+    return reactor_;
+  }
+
+private:
+  std::shared_ptr<comm::Reactor> reactor_;
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<UrDriver>> drivers_;
+  // Thread configs of the drivers, empty for drivers not created on a NUMA node
+  std::vector<ThreadConfig> thread_configs_;
+  int32_t start_token_ = 0;
+};
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
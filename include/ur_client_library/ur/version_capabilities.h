@@ -0,0 +1,196 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_UR_VERSION_CAPABILITIES_H_INCLUDED
+#define UR_CLIENT_LIBRARY_UR_VERSION_CAPABILITIES_H_INCLUDED
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include <ur_client_library/ur/version_information.h>
+
+namespace urcl
+{
+/*!
+ * \brief Calls of the dashboard server whose availability depends on the software version.
+ */
+enum class DashboardCommand : uint8_t
+{
+  POWER_OFF = 0,
+  POWER_ON,
+  BRAKE_RELEASE,
+  LOAD_PROGRAM,
+  LOAD_INSTALLATION,
+  PLAY,
+  PAUSE,
+  STOP,
+  CLOSE_POPUP,
+  CLOSE_SAFETY_POPUP,
+  RESTART_SAFETY,
+  UNLOCK_PROTECTIVE_STOP,
+  SHUTDOWN,
+  QUIT,
+  RUNNING,
+  IS_PROGRAM_SAVED,
+  IS_IN_REMOTE_CONTROL,
+  POPUP,
+  ADD_TO_LOG,
+  GET_ROBOT_MODEL,
+  GET_SERIAL_NUMBER,
+  ROBOT_MODE,
+  GET_LOADED_PROGRAM,
+  SAFETY_MODE,
+  SAFETY_STATUS,
+  PROGRAM_STATE,
+  GET_STATUS,  ///< robotmode, safetymode, programState and get loaded program in one request
+  GET_OPERATIONAL_MODE,
+  SET_OPERATIONAL_MODE,
+  CLEAR_OPERATIONAL_MODE,
+  SET_USER_ROLE,
+  GET_USER_ROLE,
+  GENERATE_FLIGHT_REPORT,
+  GENERATE_SUPPORT_FILE,
+  SAVE_LOG,
+};
+
+/*!
+ * \brief Robot features whose availability depends on the software version.
+ */
+enum class RobotFeature : uint8_t
+{
+  TOOL_COMMUNICATION = 0,       ///< Setting up the tool communication interface
+  FORCE_TORQUE_SENSOR_ZEROING,  ///< Zeroing the force-torque sensor
+  FORCE_MODE_GAIN_SCALING,      ///< Force mode with a gain scaling factor
+  TOOL_CONTACT,                 ///< Tool contact detection
+};
+
+/*!
+ * \brief Capabilities of a software version, computed once when the version is known.
+ *
+ * The minimum versions of all dashboard calls and robot features are kept in a static table, so
+ * constructing the capabilities only compares version numbers, and every query afterwards is a
+ * single bit lookup.
+ */
+class VersionCapabilities
+{
+public:
+  //! Maximum RTDE frequency of CB3 robots
+  static constexpr double CB3_MAX_RTDE_FREQUENCY = 125.0;
+  //! Maximum RTDE frequency of e-Series robots
+  static constexpr double URE_MAX_RTDE_FREQUENCY = 500.0;
+
+  /*!
+   * \brief Creates the capabilities of an unknown version, nothing is supported.
+   */
+  VersionCapabilities();
+
+  /*!
+   * \brief Computes the capabilities of a software version.
+   *
+   * \param version The PolyScope or URControl version of the robot
+   */
+  explicit VersionCapabilities(const VersionInformation& version);
+
+  /*!
+   * \brief Checks whether a dashboard call is available.
+   *
+   * \param command The dashboard call
+   *
+   * \returns True if the version supports the call, false otherwise
+   */
+  bool supports(const DashboardCommand command) const
+  {
+    return dashboard_commands_.test(static_cast<size_t>(command));
+  }
+
+  /*!
+   * \brief Checks whether a robot feature is available.
+   *
+   * \param feature The feature
+   *
+   * \returns True if the version supports the feature, false otherwise
+   */
+  bool supports(const RobotFeature feature) const
+  {
+    return features_.test(static_cast<size_t>(feature));
+  }
+
+  /*!
+   * \brief Getter for the highest frequency RTDE data can be requested with.
+   */
+  double getMaxRtdeFrequency() const
+  {
+    return max_rtde_frequency_;
+  }
+
+  /*!
+   * \brief Getter for the version the capabilities have been computed from.
+   */
+  const VersionInformation& getVersion() const
+  {
+    return version_;
+  }
+
+  /*!
+   * \brief Getter for the dashboard server's name of a call, e.g. for error messages.
+   *
+   * \param command The dashboard call
+   *
+   * \returns The call's name
+   */
+  static const char* getName(const DashboardCommand command);
+
+  /*!
+   * \brief Looks up the minimum version of a dashboard call.
+   *
+   * \param command The dashboard call
+   * \param e_series Whether to look up the version for e-Series or CB3 robots
+   * \param version Is set to the minimum version if the call is available on that robot series
+   *
+   * \returns False if the call isn't available on that robot series at all, true otherwise
+   */
+  static bool getMinimumVersion(const DashboardCommand command, const bool e_series, VersionInformation& version);
+
+  //! Number of dashboard calls in DashboardCommand
+  static const size_t NUM_DASHBOARD_COMMANDS = static_cast<size_t>(DashboardCommand::SAVE_LOG) + 1;
+  //! Number of features in RobotFeature
+  static const size_t NUM_ROBOT_FEATURES = static_cast<size_t>(RobotFeature::TOOL_CONTACT) + 1;
+
+private:
+  VersionInformation version_;
+  std::bitset<NUM_DASHBOARD_COMMANDS> dashboard_commands_;
+  std::bitset<NUM_ROBOT_FEATURES> features_;
+  double max_rtde_frequency_;
+};
+
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_UR_VERSION_CAPABILITIES_H_INCLUDED
@@ -0,0 +1,213 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/async_log_handler.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace urcl
+{
+namespace
+{
+std::atomic<uint64_t> g_next_handler_id(1);
+
+size_t roundUpToPowerOfTwo(const size_t value)
+{
+  size_t result = 1;
+  while (result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+AsyncLogHandler::AsyncLogHandler(std::unique_ptr<LogHandler> handler, const size_t ring_capacity,
+                                 const std::chrono::milliseconds flush_interval)
+  : handler_(std::move(handler))
+  , ring_capacity_(roundUpToPowerOfTwo(ring_capacity))
+  , flush_interval_(flush_interval)
+  , id_(g_next_handler_id++)
+  , next_sequence_(0)
+  , dropped_count_(0)
+  , reported_dropped_count_(0)
+  , keep_running_(true)
+{
+  thread_ = std::thread(&AsyncLogHandler::run, this);
+}
+
+AsyncLogHandler::~AsyncLogHandler()
+{
+  {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    keep_running_ = false;
+  }
+  run_cv_.notify_all();
+  thread_.join();
+  drain();
+}
+
+void AsyncLogHandler::log(const char* file, int line, LogLevel loglevel, const char* log)
+{
+  Ring& ring = getThreadRing();
+  const size_t head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) >= ring.records.size())
+  {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Record& record = ring.records[head & ring.mask];
+  record.sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+  record.file = file;
+  record.line = line;
+  record.level = loglevel;
+  const size_t length = strnlen(log, MAX_MESSAGE_LENGTH + 1);
+  if (length > MAX_MESSAGE_LENGTH)
+  {
+    std::memcpy(record.text, log, MAX_MESSAGE_LENGTH - 3);
+    std::memcpy(record.text + MAX_MESSAGE_LENGTH - 3, "...", 3);
+    record.text[MAX_MESSAGE_LENGTH] = '\0';
+  }
+  else
+  {
+    std::memcpy(record.text, log, length + 1);
+  }
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+void AsyncLogHandler::registerCurrentThread()
+{
+  getThreadRing();
+}
+
+void AsyncLogHandler::flush()
+{
+  drain();
+}
+
+AsyncLogHandler::Ring& AsyncLogHandler::getThreadRing()
+{
+  // Each thread keeps a reference to its ring, so the ring stays valid if the handler is replaced
+  // while the thread is logging.
+  thread_local uint64_t cached_handler_id = 0;
+  thread_local std::shared_ptr<Ring> cached_ring;
+  if (cached_handler_id != id_)
+  {
+    std::shared_ptr<Ring> ring = std::make_shared<Ring>(ring_capacity_);
+    {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      rings_.push_back(ring);
+    }
+    cached_ring = ring;
+    cached_handler_id = id_;
+  }
+  return *cached_ring;
+}
+
+void AsyncLogHandler::run()
+{
+  std::unique_lock<std::mutex> lock(run_mutex_);
+  while (keep_running_)
+  {
+    run_cv_.wait_for(lock, flush_interval_, [this]() { return !keep_running_; });
+    lock.unlock();
+    drain();
+    lock.lock();
+  }
+}
+
+void AsyncLogHandler::drain()
+{
+  std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    // Rings only referenced here belong to threads that have ended and can go once they are empty
+    for (auto it = rings_.begin(); it != rings_.end();)
+    {
+      if (it->use_count() == 1 && (*it)->head.load(std::memory_order_acquire) == (*it)->tail.load())
+      {
+        it = rings_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    rings = rings_;
+  }
+
+  // Every ring is ordered already, so the rings are merged by always taking the oldest message
+  std::vector<size_t> heads(rings.size());
+  for (size_t i = 0; i < rings.size(); ++i)
+  {
+    heads[i] = rings[i]->head.load(std::memory_order_acquire);
+  }
+  while (true)
+  {
+    Ring* oldest = nullptr;
+    size_t oldest_tail = 0;
+    for (size_t i = 0; i < rings.size(); ++i)
+    {
+      Ring& ring = *rings[i];
+      const size_t tail = ring.tail.load(std::memory_order_relaxed);
+      if (tail != heads[i] &&
+          (oldest == nullptr ||
+           ring.records[tail & ring.mask].sequence < oldest->records[oldest_tail & oldest->mask].sequence))
+      {
+        oldest = &ring;
+        oldest_tail = tail;
+      }
+    }
+    if (oldest == nullptr)
+    {
+      break;
+    }
+    const Record& record = oldest->records[oldest_tail & oldest->mask];
+    handler_->log(record.file, record.line, record.level, record.text);
+    oldest->tail.store(oldest_tail + 1, std::memory_order_release);
+  }
+
+  const uint64_t dropped_count = dropped_count_.load(std::memory_order_relaxed);
+  if (dropped_count != reported_dropped_count_)
+  {
+    char text[128];
+    std::snprintf(text, sizeof(text), "Dropped %" PRIu64 " log messages, because logging threads were too fast.",
+                  dropped_count - reported_dropped_count_);
+    reported_dropped_count_ = dropped_count;
+    handler_->log(__FILE__, __LINE__, LogLevel::WARN, text);
+  }
+}
+
+}  // namespace urcl
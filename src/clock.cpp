@@ -0,0 +1,137 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/clock.h"
+#include "ur_client_library/exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace urcl
+{
+namespace
+{
+std::shared_ptr<Clock>& clockInstance()
+{
+  static std::shared_ptr<Clock> clock = std::make_shared<SteadyClock>();
+  return clock;
+}
+}  // namespace
+
+void SteadyClock::sleepUntil(const time_point deadline)
+{
+  std::this_thread::sleep_until(deadline);
+}
+
+SimulatedClock::SimulatedClock(const double time_scale)
+  : time_scale_(time_scale), real_start_(std::chrono::steady_clock::now()), skipped_(duration::zero())
+{
+  if (!(time_scale >= 0.0))
+  {
+    throw UrException("The time scale of a simulated clock must not be negative.");
+  }
+}
+
+Clock::time_point SimulatedClock::now() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return nowLocked();
+}
+
+Clock::time_point SimulatedClock::nowLocked() const
+{
+  const auto real_elapsed = std::chrono::steady_clock::now() - real_start_;
+  return real_start_ + skipped_ +
+         std::chrono::duration_cast<duration>(std::chrono::duration<double>(real_elapsed) * time_scale_);
+}
+
+void SimulatedClock::sleepUntil(const time_point deadline)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (nowLocked() < deadline)
+  {
+    if (time_scale_ > 0.0)
+    {
+      const auto remaining = std::chrono::duration<double>(deadline - nowLocked()) / time_scale_;
+      advanced_cv_.wait_for(lock, remaining);
+    }
+    else
+    {
+      advanced_cv_.wait(lock);
+    }
+  }
+}
+
+void SimulatedClock::advance(const duration period)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    skipped_ += std::max(period, duration::zero());
+  }
+  advanced_cv_.notify_all();
+}
+
+Clock::duration SimulatedClock::realTimeUntil(const time_point deadline) const
+{
+  const auto remaining = deadline - now();
+  if (remaining <= duration::zero())
+  {
+    return remaining;
+  }
+  if (time_scale_ == 0.0)
+  {
+    return MAX_WAIT_SLICE;
+  }
+  const auto real = std::chrono::duration_cast<duration>(std::chrono::duration<double>(remaining) / time_scale_);
+  // At least one tick, so the caller doesn't treat a tiny remaining real time as reached
+  return std::clamp<duration>(real, duration(1), MAX_WAIT_SLICE);
+}
+
+void registerClock(std::shared_ptr<Clock> clock)
+{
+  if (clock == nullptr)
+  {
+    clock = std::make_shared<SteadyClock>();
+  }
+  std::atomic_store(&clockInstance(), clock);
+}
+
+void unregisterClock()
+{
+  registerClock(nullptr);
+}
+
+std::shared_ptr<Clock> getClock()
+{
+  return std::atomic_load(&clockInstance());
+}
+
+}  // namespace urcl
@@ -0,0 +1,178 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/connection_health_monitor.h"
+
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace comm
+{
+ConnectionHealthMonitor::ConnectionHealthMonitor(const std::chrono::milliseconds sample_interval)
+  : sample_interval_(sample_interval), running_(false)
+{
+}
+
+ConnectionHealthMonitor::~ConnectionHealthMonitor()
+{
+  stop();
+}
+
+void ConnectionHealthMonitor::addConnection(const std::string& name, Sampler sampler)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  for (auto& connection : connections_)
+  {
+    if (connection.first == name)
+    {
+      connection.second = sampler;
+      return;
+    }
+  }
+  connections_.emplace_back(name, sampler);
+}
+
+void ConnectionHealthMonitor::start()
+{
+  std::lock_guard<std::mutex> lk(run_mutex_);
+  if (running_)
+  {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&ConnectionHealthMonitor::run, this);
+  applyThreadConfig(thread_.native_handle(), thread_config_);
+}
+
+void ConnectionHealthMonitor::stop()
+{
+  {
+    std::lock_guard<std::mutex> lk(run_mutex_);
+    running_ = false;
+    run_cv_.notify_all();
+  }
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+}
+
+void ConnectionHealthMonitor::sample()
+{
+  std::vector<std::pair<std::string, Sampler>> connections;
+  std::function<void(const std::string&, const ConnectionHealth&)> retransmit_callback;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    connections = connections_;
+    retransmit_callback = retransmit_callback_;
+  }
+
+  for (const auto& connection : connections)
+  {
+    ConnectionHealth health;
+    health.sample_time = std::chrono::steady_clock::now();
+    health.connected = connection.second(health.statistics);
+    {
+      std::lock_guard<std::mutex> lk(mutex_);
+      auto previous = health_.find(connection.first);
+      if (health.connected)
+      {
+        // A counter smaller than before belongs to a new connection
+        const bool same_connection = previous != health_.end() && previous->second.connected &&
+                                     previous->second.statistics.retransmits <= health.statistics.retransmits;
+        health.new_retransmits = same_connection ?
+                                     health.statistics.retransmits - previous->second.statistics.retransmits :
+                                     health.statistics.retransmits;
+      }
+      health_[connection.first] = health;
+    }
+
+    if (health.new_retransmits > 0)
+    {
+      URCL_LOG_WARN("Connection '%s': %u segments retransmitted since the last sample, round-trip time %.3f ms",
+                    connection.first.c_str(), health.new_retransmits, health.statistics.rtt.count() / 1000.0);
+      if (retransmit_callback)
+      {
+        retransmit_callback(connection.first, health);
+      }
+    }
+  }
+}
+
+bool ConnectionHealthMonitor::getHealth(const std::string& name, ConnectionHealth& health) const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto it = health_.find(name);
+  if (it == health_.end())
+  {
+    return false;
+  }
+  health = it->second;
+  return true;
+}
+
+std::map<std::string, ConnectionHealthMonitor::ConnectionHealth> ConnectionHealthMonitor::getHealth() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return health_;
+}
+
+void ConnectionHealthMonitor::setRetransmitCallback(
+    std::function<void(const std::string&, const ConnectionHealth&)> callback)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  retransmit_callback_ = callback;
+}
+
+void ConnectionHealthMonitor::setThreadConfig(const ThreadConfig& config)
+{
+  std::lock_guard<std::mutex> lk(run_mutex_);
+  thread_config_ = config;
+  if (running_)
+  {
+    applyThreadConfig(thread_.native_handle(), thread_config_);
+  }
+}
+
+void ConnectionHealthMonitor::run()
+{
+  std::unique_lock<std::mutex> lk(run_mutex_);
+  while (running_)
+  {
+    lk.unlock();
+    sample();
+    lk.lock();
+    run_cv_.wait_for(lk, sample_interval_, [this]() { return !running_; });
+  }
+}
+
+}  // namespace comm
+}  // namespace urcl
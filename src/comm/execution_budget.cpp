@@ -0,0 +1,135 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/execution_budget.h"
+
+#include <time.h>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+void updateMax(std::atomic<int64_t>& max, const int64_t value)
+{
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+}  // namespace
+
+ExecutionBudget::Measurement::Measurement(ExecutionBudget* budget) : budget_(budget)
+{
+  if (budget_ != nullptr)
+  {
+    cpu_start_ = threadCpuTime();
+    wall_start_ = std::chrono::steady_clock::now();
+  }
+}
+
+ExecutionBudget::Measurement::~Measurement()
+{
+  if (budget_ != nullptr)
+  {
+    const std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+    budget_->record(wall_end - wall_start_, threadCpuTime() - cpu_start_);
+  }
+}
+
+ExecutionBudget::ExecutionBudget(const std::string& name, const std::chrono::nanoseconds budget,
+                                 const MetricLabels& labels)
+  : name_(name), budget_(budget), invocations_(0), overruns_(0), max_wall_ns_(0), max_cpu_ns_(0)
+{
+  MetricLabels all_labels{ { "budget", name_ } };
+  all_labels.insert(all_labels.end(), labels.begin(), labels.end());
+  overrun_metric_ = &getMetricsRegistry().getCounter("urcl_execution_budget_overruns_total",
+                                                     "Invocations exceeding their time budget", all_labels);
+}
+
+void ExecutionBudget::record(const std::chrono::nanoseconds wall_time, const std::chrono::nanoseconds cpu_time)
+{
+  invocations_.fetch_add(1, std::memory_order_relaxed);
+  updateMax(max_wall_ns_, wall_time.count());
+  updateMax(max_cpu_ns_, cpu_time.count());
+  if (wall_time <= budget_)
+  {
+    return;
+  }
+
+  overruns_.fetch_add(1, std::memory_order_relaxed);
+  overrun_metric_->increment();
+  BudgetOverrun overrun;
+  overrun.name = name_;
+  overrun.wall_time = wall_time;
+  overrun.cpu_time = cpu_time;
+  overrun.budget = budget_;
+  overrun.end_time = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(overrun_mutex_);
+    last_overrun_ = overrun;
+  }
+  if (overrun_handler_)
+  {
+    overrun_handler_(overrun);
+  }
+}
+
+bool ExecutionBudget::getLastOverrun(BudgetOverrun& overrun) const
+{
+  if (getOverruns() == 0)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(overrun_mutex_);
+  overrun = last_overrun_;
+  return true;
+}
+
+void ExecutionBudget::reset()
+{
+  std::lock_guard<std::mutex> lock(overrun_mutex_);
+  invocations_ = 0;
+  overruns_ = 0;
+  max_wall_ns_ = 0;
+  max_cpu_ns_ = 0;
+  last_overrun_ = BudgetOverrun();
+}
+
+std::chrono::nanoseconds ExecutionBudget::threadCpuTime()
+{
+  timespec time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -0,0 +1,215 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/latency_statistics.h"
+
+#include <limits>
+#include <sstream>
+
+namespace urcl
+{
+namespace comm
+{
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+void LatencyHistogram::record(const std::chrono::steady_clock::duration duration)
+{
+  const int64_t count = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  const uint64_t microseconds = count > 0 ? static_cast<uint64_t>(count) : 0;
+
+  buckets_[getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(microseconds, std::memory_order_relaxed);
+
+  uint64_t min = min_.load(std::memory_order_relaxed);
+  while (microseconds < min && !min_.compare_exchange_weak(min, microseconds, std::memory_order_relaxed))
+  {
+  }
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (microseconds > max && !max_.compare_exchange_weak(max, microseconds, std::memory_order_relaxed))
+  {
+  }
+}
+
+void LatencyHistogram::reset()
+{
+  for (auto& bucket : buckets_)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+  {
+    buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  count_.fetch_add(other.count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  const uint64_t other_min = other.min_.load(std::memory_order_relaxed);
+  uint64_t min = min_.load(std::memory_order_relaxed);
+  while (other_min < min && !min_.compare_exchange_weak(min, other_min, std::memory_order_relaxed))
+  {
+  }
+  const uint64_t other_max = other.max_.load(std::memory_order_relaxed);
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (other_max > max && !max_.compare_exchange_weak(max, other_max, std::memory_order_relaxed))
+  {
+  }
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+  return count_.load(std::memory_order_relaxed);
+}
+
+std::chrono::microseconds LatencyHistogram::getMin() const
+{
+  if (getCount() == 0)
+  {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(min_.load(std::memory_order_relaxed));
+}
+
+std::chrono::microseconds LatencyHistogram::getMax() const
+{
+  return std::chrono::microseconds(max_.load(std::memory_order_relaxed));
+}
+
+std::chrono::microseconds LatencyHistogram::getMean() const
+{
+  const uint64_t count = getCount();
+  if (count == 0)
+  {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(sum_.load(std::memory_order_relaxed) / count);
+}
+
+std::chrono::microseconds LatencyHistogram::getPercentile(const double percentile) const
+{
+  const uint64_t count = getCount();
+  if (count == 0)
+  {
+    return std::chrono::microseconds(0);
+  }
+  // Rank of the requested sample, starting at 1
+  const double clamped = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+  uint64_t rank = static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(count) + 0.5);
+  rank = rank == 0 ? 1 : rank;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+  {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank)
+    {
+      return std::chrono::microseconds(getBucketLowerBound(i));
+    }
+  }
+  return getMax();
+}
+
+std::string LatencyHistogram::toString() const
+{
+  std::stringstream ss;
+  ss << "count: " << getCount() << ", min: " << getMin().count() << " us, mean: " << getMean().count()
+     << " us, p50: " << getPercentile(50).count() << " us, p99: " << getPercentile(99).count()
+     << " us, max: " << getMax().count() << " us";
+  return ss.str();
+}
+
+size_t LatencyHistogram::getBucketIndex(const uint64_t microseconds)
+{
+  if (microseconds < SUB_BUCKETS)
+  {
+    return static_cast<size_t>(microseconds);
+  }
+  // Every power of two is split into SUB_BUCKETS buckets of equal width.
+  const size_t most_significant_bit = 63 - static_cast<size_t>(__builtin_clzll(microseconds));
+  const size_t shift = most_significant_bit - SUB_BUCKET_BITS;
+  if (shift > MAX_SHIFT)
+  {
+    return NUM_BUCKETS - 1;
+  }
+  return (shift + 1) * SUB_BUCKETS + static_cast<size_t>(microseconds >> shift) - SUB_BUCKETS;
+}
+
+uint64_t LatencyHistogram::getBucketLowerBound(const size_t index)
+{
+  if (index < SUB_BUCKETS)
+  {
+    return index;
+  }
+  const size_t shift = index / SUB_BUCKETS - 1;
+  return static_cast<uint64_t>(index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+}
+
+void LatencyStatistics::reset()
+{
+  kernel_to_receive.reset();
+  receive_to_parse.reset();
+  parse_to_enqueue.reset();
+  enqueue_to_consume.reset();
+  receive_interval.reset();
+}
+
+void LatencyStatistics::merge(const LatencyStatistics& other)
+{
+  kernel_to_receive.merge(other.kernel_to_receive);
+  receive_to_parse.merge(other.receive_to_parse);
+  parse_to_enqueue.merge(other.parse_to_enqueue);
+  enqueue_to_consume.merge(other.enqueue_to_consume);
+  receive_interval.merge(other.receive_interval);
+}
+
+std::string LatencyStatistics::toString() const
+{
+  std::stringstream ss;
+  ss << "kernel to receive: " << kernel_to_receive.toString() << std::endl
+     << "receive to parse: " << receive_to_parse.toString() << std::endl
+     << "parse to enqueue: " << parse_to_enqueue.toString() << std::endl
+     << "enqueue to consume: " << enqueue_to_consume.toString() << std::endl
+     << "receive interval: " << receive_interval.toString();
+  return ss.str();
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -0,0 +1,329 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/reactor.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+constexpr uint64_t WAKEUP_DATA = std::numeric_limits<uint64_t>::max();
+constexpr int MAX_EVENTS = 16;
+}  // namespace
+
+Reactor::Reactor(const size_t num_loops)
+  : post_guard_(std::make_shared<PostGuard>()), keep_running_(true), next_loop_(0)
+{
+  post_guard_->reactor = this;
+  if (num_loops == 0)
+  {
+    throw UrException("A reactor needs at least one event loop.");
+  }
+  for (size_t i = 0; i < num_loops; ++i)
+  {
+    std::unique_ptr<Loop> loop = std::make_unique<Loop>();
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd == -1)
+    {
+      throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to create epoll instance");
+    }
+    loop->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->wakeup_fd == -1)
+    {
+      close(loop->epoll_fd);
+      throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to create wakeup event");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKEUP_DATA;
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wakeup_fd, &event);
+    loops_.push_back(std::move(loop));
+  }
+  for (auto& loop : loops_)
+  {
+    loop->thread = std::thread(&Reactor::run, this, std::ref(*loop));
+  }
+}
+
+Reactor::~Reactor()
+{
+  {
+    // Futures completed from now on don't post their continuations anymore
+    std::lock_guard<std::mutex> lock(post_guard_->mutex);
+    post_guard_->reactor = nullptr;
+  }
+  keep_running_ = false;
+  for (auto& loop : loops_)
+  {
+    wakeUp(*loop);
+  }
+  for (auto& loop : loops_)
+  {
+    if (loop->thread.joinable())
+    {
+      loop->thread.join();
+    }
+    if (!loop->handlers.empty())
+    {
+      URCL_LOG_WARN("Destroying reactor while %zu file descriptors are still registered.", loop->handlers.size());
+    }
+    close(loop->wakeup_fd);
+    close(loop->epoll_fd);
+  }
+}
+
+size_t Reactor::assignLoop()
+{
+  return next_loop_++ % loops_.size();
+}
+
+bool Reactor::add(const size_t loop_index, const int fd, Callback callback)
+{
+  Loop& loop = *loops_.at(loop_index);
+  std::lock_guard<std::recursive_mutex> lock(loop.mutex);
+  if (loop.handlers.count(fd) != 0)
+  {
+    URCL_LOG_ERROR("FD %d is already registered on event loop %zu.", fd, loop_index);
+    return false;
+  }
+
+  // The generation tells events of a closed descriptor apart from a new one reusing its number, in
+  // case both show up in the same batch of events.
+  const uint32_t generation = loop.next_generation++;
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.u64 = (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+  if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
+  {
+    URCL_LOG_ERROR("Failed to register FD %d on event loop %zu. %s", fd, loop_index, strerror(errno));
+    return false;
+  }
+  loop.handlers[fd] = Handler{ generation, std::move(callback) };
+  return true;
+}
+
+void Reactor::remove(const size_t loop_index, const int fd)
+{
+  Loop& loop = *loops_.at(loop_index);
+  std::lock_guard<std::recursive_mutex> lock(loop.mutex);
+  if (loop.handlers.erase(fd) == 0)
+  {
+    return;
+  }
+  if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1)
+  {
+    URCL_LOG_ERROR("Failed to remove FD %d from event loop %zu. %s", fd, loop_index, strerror(errno));
+  }
+}
+
+void Reactor::synchronize(const size_t loop_index, const std::function<void()>& function)
+{
+  Loop& loop = *loops_.at(loop_index);
+  std::lock_guard<std::recursive_mutex> lock(loop.mutex);
+  function();
+}
+
+void Reactor::post(const size_t loop_index, Task task)
+{
+  Loop& loop = *loops_.at(loop_index);
+  {
+    std::lock_guard<std::mutex> lock(loop.tasks_mutex);
+    loop.tasks.push_back(std::move(task));
+  }
+  wakeUp(loop);
+}
+
+void Reactor::postDelayed(const size_t loop_index, const std::chrono::steady_clock::duration delay, Task task)
+{
+  Loop& loop = *loops_.at(loop_index);
+  {
+    std::lock_guard<std::mutex> lock(loop.tasks_mutex);
+    loop.timers.push_back(
+        Timer{ std::chrono::steady_clock::now() + delay, loop.next_timer_sequence++, std::move(task) });
+    std::push_heap(loop.timers.begin(), loop.timers.end(), std::greater<Timer>());
+  }
+  // The loop has to recompute its timeout
+  wakeUp(loop);
+}
+
+void Reactor::wakeUp(Loop& loop)
+{
+  const uint64_t value = 1;
+  if (::write(loop.wakeup_fd, &value, sizeof(value)) == -1 && errno != EAGAIN)
+  {
+    URCL_LOG_ERROR("Waking up event loop failed. %s", strerror(errno));
+  }
+}
+
+int Reactor::nextTimeout(Loop& loop)
+{
+  std::lock_guard<std::mutex> lock(loop.tasks_mutex);
+  if (!loop.tasks.empty())
+  {
+    return 0;
+  }
+  if (loop.timers.empty())
+  {
+    return -1;
+  }
+  const auto remaining = loop.timers.front().due - std::chrono::steady_clock::now();
+  if (remaining <= std::chrono::steady_clock::duration::zero())
+  {
+    return 0;
+  }
+  // Rounded up, so the loop doesn't wake up before the timer is due
+  const auto milliseconds = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+  return static_cast<int>(std::min<int64_t>(milliseconds, std::numeric_limits<int>::max()));
+}
+
+void Reactor::runTasks(Loop& loop)
+{
+  std::vector<Task> tasks;
+  {
+    std::lock_guard<std::mutex> lock(loop.tasks_mutex);
+    tasks.swap(loop.tasks);
+    const auto now = std::chrono::steady_clock::now();
+    while (!loop.timers.empty() && loop.timers.front().due <= now)
+    {
+      std::pop_heap(loop.timers.begin(), loop.timers.end(), std::greater<Timer>());
+      tasks.push_back(std::move(loop.timers.back().task));
+      loop.timers.pop_back();
+    }
+  }
+  for (auto& task : tasks)
+  {
+    if (!keep_running_)
+    {
+      return;
+    }
+    try
+    {
+      task();
+    }
+    catch (const std::exception& e)
+    {
+      URCL_LOG_ERROR("Running a task on an event loop failed. %s", e.what());
+    }
+  }
+}
+
+void Reactor::setThreadConfig(const ThreadConfig& config)
+{
+  for (size_t i = 0; i < loops_.size(); ++i)
+  {
+    applyThreadConfig(loops_[i]->thread.native_handle(), config.withNameSuffix(std::to_string(i)));
+  }
+}
+
+void Reactor::setLoopThreadConfig(const size_t loop, const ThreadConfig& config)
+{
+  applyThreadConfig(loops_.at(loop)->thread.native_handle(), config);
+}
+
+void Reactor::run(Loop& loop)
+{
+  epoll_event events[MAX_EVENTS];
+  while (keep_running_)
+  {
+    const int num_events = epoll_wait(loop.epoll_fd, events, MAX_EVENTS, nextTimeout(loop));
+    if (num_events < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      URCL_LOG_ERROR("epoll_wait() failed. Shutting down event loop. %s", strerror(errno));
+      break;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(loop.mutex);
+    for (int i = 0; i < num_events && keep_running_; ++i)
+    {
+      if (events[i].data.u64 != WAKEUP_DATA)
+      {
+        dispatch(loop, events[i].data.u64);
+      }
+      else
+      {
+        uint64_t value;
+        if (::read(loop.wakeup_fd, &value, sizeof(value)) == -1 && errno != EAGAIN)
+        {
+          URCL_LOG_ERROR("Reading the wakeup event failed. %s", strerror(errno));
+        }
+      }
+    }
+    if (keep_running_)
+    {
+      runTasks(loop);
+    }
+  }
+  URCL_LOG_DEBUG("Event loop ended.");
+}
+
+void Reactor::dispatch(Loop& loop, const uint64_t data)
+{
+  const int fd = static_cast<int>(data & 0xffffffff);
+  const uint32_t generation = static_cast<uint32_t>(data >> 32);
+  auto it = loop.handlers.find(fd);
+  if (it == loop.handlers.end() || it->second.generation != generation)
+  {
+    // The descriptor has been removed while handling an earlier event of this batch.
+    return;
+  }
+
+  // The callback may remove its own descriptor, so it must not be called from inside the map.
+  Callback callback = it->second.callback;
+  try
+  {
+    callback();
+  }
+  catch (const std::exception& e)
+  {
+    // A failing component must not take down the other components sharing this loop.
+    URCL_LOG_ERROR("Handling an event on FD %d failed. %s", fd, e.what());
+  }
+}
+
+}  // namespace comm
+}  // namespace urcl
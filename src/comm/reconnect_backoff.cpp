@@ -0,0 +1,75 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/reconnect_backoff.h"
+
+#include <algorithm>
+
+namespace urcl
+{
+namespace comm
+{
+ReconnectBackoff::ReconnectBackoff(const BackoffConfig& config)
+  : config_(config), current_delay_ms_(0.0), num_attempts_(0), random_engine_(std::random_device()())
+{
+  config_.jitter = std::min(std::max(config_.jitter, 0.0), 1.0);
+  config_.multiplier = std::max(config_.multiplier, 1.0);
+  reset();
+}
+
+bool ReconnectBackoff::nextDelay(std::chrono::milliseconds& delay)
+{
+  if (config_.max_attempts > 0 && num_attempts_ >= config_.max_attempts)
+  {
+    return false;
+  }
+  ++num_attempts_;
+
+  double delay_ms = current_delay_ms_;
+  if (config_.jitter > 0.0)
+  {
+    std::uniform_real_distribution<double> distribution(1.0 - config_.jitter, 1.0 + config_.jitter);
+    delay_ms *= distribution(random_engine_);
+  }
+  delay = std::chrono::milliseconds(static_cast<int64_t>(delay_ms));
+
+  current_delay_ms_ =
+      std::min(current_delay_ms_ * config_.multiplier, static_cast<double>(config_.max_delay.count()));
+  return true;
+}
+
+void ReconnectBackoff::reset()
+{
+  current_delay_ms_ = static_cast<double>(std::min(config_.initial_delay, config_.max_delay).count());
+  num_attempts_ = 0;
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -26,7 +26,9 @@
  */
 //----------------------------------------------------------------------
 
+#include <ur_client_library/clock.h>
 #include <ur_client_library/log.h>
+#include <ur_client_library/exceptions.h>
 #include <ur_client_library/comm/tcp_server.h>
 
 #include <iostream>
@@ -34,7 +36,10 @@
 #include <sstream>
 #include <strings.h>
 #include <cstring>
+#include <endian.h>
 #include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <algorithm>
 #include <system_error>
 
@@ -43,7 +48,16 @@ namespace urcl
 namespace comm
 {
 TCPServer::TCPServer(const int port, const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
-  : port_(port), maxfd_(0), max_clients_allowed_(0)
+  : keep_running_(false)
+  , reactor_loop_(0)
+  , port_(port)
+  , epoll_fd_(-1)
+  , shutdown_fd_(-1)
+  , max_clients_allowed_(0)
+  , listen_backlog_(DEFAULT_LISTEN_BACKLOG)
+  , receive_buffer_size_(DEFAULT_RECEIVE_BUFFER_SIZE)
+  , framing_(MessageFraming::NONE)
+  , frame_size_(0)
 {
   init();
   bind(max_num_tries, reconnection_time);
@@ -55,6 +69,8 @@ TCPServer::~TCPServer()
   URCL_LOG_DEBUG("Destroying TCPServer object.");
   shutdown();
   close(listen_fd_);
+  close(epoll_fd_);
+  close(shutdown_fd_);
 }
 
 void TCPServer::init()
@@ -70,39 +86,34 @@ void TCPServer::init()
 
   URCL_LOG_DEBUG("Created socket with FD %d", (int)listen_fd_);
 
-  FD_ZERO(&masterfds_);
-  FD_ZERO(&tempfds_);
-
-  // Create self-pipe for interrupting the worker loop
-  if (pipe(self_pipe_) == -1)
+  // The listening socket is non-blocking, so all pending connection requests can be accepted on an
+  // edge-triggered event.
+  int flags = fcntl(listen_fd_, F_GETFL);
+  if (flags == -1 || fcntl(listen_fd_, F_SETFL, flags | O_NONBLOCK) == -1)
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "Error creating self-pipe");
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to make socket nonblocking");
   }
-  URCL_LOG_DEBUG("Created read pipe at FD %d", self_pipe_[0]);
-  FD_SET(self_pipe_[0], &masterfds_);
 
-  // Make read and write ends of pipe nonblocking
-  int flags;
-  flags = fcntl(self_pipe_[0], F_GETFL);
-  if (flags == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_GETFL");
-  }
-  flags |= O_NONBLOCK;  // Make read end nonblocking
-  if (fcntl(self_pipe_[0], F_SETFL, flags) == -1)
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ == -1)
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_SETFL");
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Error creating epoll instance");
   }
 
-  flags = fcntl(self_pipe_[1], F_GETFL);
-  if (flags == -1)
+  // eventfd for interrupting the worker loop
+  shutdown_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (shutdown_fd_ == -1)
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_GETFL");
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Error creating shutdown eventfd");
   }
-  flags |= O_NONBLOCK;  // Make write end nonblocking
-  if (fcntl(self_pipe_[1], F_SETFL, flags) == -1)
+  URCL_LOG_DEBUG("Created shutdown eventfd at FD %d", shutdown_fd_);
+
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = shutdown_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, shutdown_fd_, &event) == -1)
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_SETFL");
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Error registering shutdown eventfd");
   }
 }
 
@@ -110,11 +121,24 @@ void TCPServer::shutdown()
 {
   keep_running_ = false;
 
-  // This is basically the self-pipe trick. Writing to the pipe will trigger an event for the event
-  // handler which will stop the select() call from blocking.
-  if (::write(self_pipe_[1], "x", 1) == -1 && errno != EAGAIN)
+  if (reactor_ != nullptr)
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "Writing to self-pipe failed.");
+    reactor_->synchronize(reactor_loop_, [this]() {
+      reactor_->remove(reactor_loop_, listen_fd_);
+      for (const int fd : client_fds_)
+      {
+        reactor_->remove(reactor_loop_, fd);
+      }
+    });
+    return;
+  }
+
+  // Signaling the eventfd will trigger an event for the event handler which will stop the
+  // epoll_wait() call from blocking.
+  const uint64_t one = 1;
+  if (::write(shutdown_fd_, &one, sizeof(one)) == -1 && errno != EAGAIN)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Writing to shutdown eventfd failed.");
   }
 
   // After the event loop has finished the thread will be joinable.
@@ -122,6 +146,12 @@ void TCPServer::shutdown()
   {
     worker_thread_.join();
     URCL_LOG_DEBUG("Worker thread joined.");
+
+    removeFromEpoll(listen_fd_);
+    for (const int fd : client_fds_)
+    {
+      removeFromEpoll(fd);
+    }
   }
 }
 
@@ -145,7 +175,7 @@ void TCPServer::bind(const size_t max_num_tries, const std::chrono::milliseconds
 
       if (connection_counter++ < max_num_tries || max_num_tries == 0)
       {
-        std::this_thread::sleep_for(reconnection_time);
+        getClock()->sleepFor(reconnection_time);
         ss << "Retrying in " << std::chrono::duration_cast<std::chrono::duration<float>>(reconnection_time).count()
            << " seconds";
         URCL_LOG_WARN("%s", ss.str().c_str());
@@ -157,15 +187,24 @@ void TCPServer::bind(const size_t max_num_tries, const std::chrono::milliseconds
     }
   } while (err == -1 && (connection_counter <= max_num_tries || max_num_tries == 0));
 
-  URCL_LOG_DEBUG("Bound %d:%d to FD %d", server_addr.sin_addr.s_addr, port_, (int)listen_fd_);
+  if (port_ == 0)
+  {
+    // Read back the port assigned by the operating system
+    socklen_t len = sizeof(server_addr);
+    if (::getsockname(listen_fd_, (struct sockaddr*)&server_addr, &len) == -1)
+    {
+      throw std::system_error(std::error_code(errno, std::generic_category()),
+                              "Failed to get the port assigned to the socket");
+    }
+    port_ = ntohs(server_addr.sin_port);
+  }
 
-  FD_SET(listen_fd_, &masterfds_);
-  maxfd_ = std::max((int)listen_fd_, self_pipe_[0]);
+  URCL_LOG_DEBUG("Bound %d:%d to FD %d", server_addr.sin_addr.s_addr, port_, (int)listen_fd_);
 }
 
 void TCPServer::startListen()
 {
-  int err = listen(listen_fd_, 1);
+  int err = listen(listen_fd_, listen_backlog_);
   if (err == -1)
   {
     std::ostringstream ss;
@@ -177,101 +216,147 @@ void TCPServer::startListen()
 
 void TCPServer::handleConnect()
 {
-  struct sockaddr_storage client_addr;
-  socklen_t addrlen = sizeof(client_addr);
-  int client_fd = accept(listen_fd_, (struct sockaddr*)&client_addr, &addrlen);
-  if (client_fd < 0)
+  // Accept until the backlog is drained, as an edge-triggered event is reported only once.
+  while (true)
   {
-    std::ostringstream ss;
-    ss << "Failed to accept connection request on port  " << port_;
-    throw std::system_error(std::error_code(errno, std::generic_category()), ss.str());
-  }
+    struct sockaddr_storage client_addr;
+    socklen_t addrlen = sizeof(client_addr);
+    int client_fd = accept4(listen_fd_, (struct sockaddr*)&client_addr, &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (client_fd < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED)
+      {
+        return;
+      }
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      std::ostringstream ss;
+      ss << "Failed to accept connection request on port  " << port_;
+      throw std::system_error(std::error_code(errno, std::generic_category()), ss.str());
+    }
 
-  if (client_fds_.size() < max_clients_allowed_ || max_clients_allowed_ == 0)
-  {
-    client_fds_.push_back(client_fd);
-    FD_SET(client_fd, &masterfds_);
-    if (client_fd > maxfd_)
+    if (client_fds_.size() < max_clients_allowed_ || max_clients_allowed_ == 0)
     {
-      maxfd_ = std::max(client_fd, self_pipe_[0]);
+      if (client_socket_options_)
+      {
+        applySocketOptions(client_fd, *client_socket_options_);
+      }
+      client_fds_.push_back(client_fd);
+      // One extra byte for terminating unframed data
+      client_buffers_[client_fd].data.resize(receive_buffer_size_ + 1);
+      if (reactor_ != nullptr)
+      {
+        reactor_->add(reactor_loop_, client_fd, [this, client_fd]() { readData(client_fd); });
+      }
+      else
+      {
+        addToEpoll(client_fd);
+      }
+      if (new_connection_callback_)
+      {
+        new_connection_callback_(client_fd);
+      }
     }
-    if (new_connection_callback_)
+    else
     {
-      new_connection_callback_(client_fd);
+      URCL_LOG_WARN("Connection attempt on port %d while maximum number of clients (%d) is already connected. "
+                    "Closing connection.",
+                    port_, max_clients_allowed_);
+      close(client_fd);
     }
   }
-  else
-  {
-    URCL_LOG_WARN("Connection attempt on port %d while maximum number of clients (%d) is already connected. Closing "
-                  "connection.",
-                  port_, max_clients_allowed_);
-    close(client_fd);
-  }
 }
 
 void TCPServer::spin()
 {
-  tempfds_ = masterfds_;
+  struct epoll_event events[MAX_EPOLL_EVENTS];
 
-  // blocks until activity on any socket from tempfds
-  int sel = select(maxfd_ + 1, &tempfds_, NULL, NULL, NULL);
-  if (sel < 0)
+  // blocks until activity on any registered socket
+  int num_events = epoll_wait(epoll_fd_, events, MAX_EPOLL_EVENTS, -1);
+  if (num_events < 0)
   {
-    URCL_LOG_ERROR("select() failed. Shutting down socket event handler.");
+    if (errno == EINTR)
+    {
+      return;
+    }
+    URCL_LOG_ERROR("epoll_wait() failed. Shutting down socket event handler.");
     keep_running_ = false;
     return;
   }
 
-  // Read part if pipe-trick. This will help interrupting the event handler thread.
-  if (FD_ISSET(self_pipe_[0], &masterfds_))
+  for (int i = 0; i < num_events; ++i)
   {
-    URCL_LOG_DEBUG("Activity on self-pipe");
-    char buffer;
-    if (read(self_pipe_[0], &buffer, 1) == -1)
+    const int fd = events[i].data.fd;
+    if (fd == shutdown_fd_)
     {
-      while (true)
+      // Reset the eventfd. This will help interrupting the event handler thread.
+      uint64_t value;
+      if (read(shutdown_fd_, &value, sizeof(value)) == -1 && errno != EAGAIN)
       {
-        if (errno == EAGAIN)
-          break;
-        else
-          URCL_LOG_ERROR("read failed");
+        URCL_LOG_ERROR("Reading from shutdown eventfd failed");
       }
+      URCL_LOG_DEBUG("Shutdown eventfd triggered");
+      // Events that are not handled anymore are reported again when the fds are registered on the
+      // next start. A stale trigger must not drop the other events, though, as they are reported
+      // only once.
+      if (!keep_running_)
+      {
+        return;
+      }
+      continue;
+    }
+
+    URCL_LOG_DEBUG("Activity on FD %d", fd);
+    if (fd == listen_fd_)
+    {
+      // Activity on the listen_fd means we have a new connection
+      handleConnect();
     }
     else
     {
-      URCL_LOG_DEBUG("Self-pipe triggered");
-      return;
+      readData(fd);
     }
   }
+}
 
-  // Check which fd has an activity
-  for (int i = 0; i <= maxfd_; i++)
+void TCPServer::addToEpoll(const int fd)
+{
+  struct epoll_event event;
+  event.events = EPOLLIN | EPOLLET;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1)
   {
-    if (FD_ISSET(i, &tempfds_))
-    {
-      URCL_LOG_DEBUG("Activity on FD %d", i);
-      if (listen_fd_ == i)
-      {
-        // Activity on the listen_fd means we have a new connection
-        handleConnect();
-      }
-      else
-      {
-        readData(i);
-      }
-    }
+    URCL_LOG_ERROR("Failed to register FD %d with epoll: %s", fd, strerror(errno));
+  }
+}
+
+void TCPServer::removeFromEpoll(const int fd)
+{
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) == -1 && errno != ENOENT)
+  {
+    URCL_LOG_ERROR("Failed to remove FD %d from epoll: %s", fd, strerror(errno));
   }
 }
 
 void TCPServer::handleDisconnect(const int fd)
 {
   URCL_LOG_DEBUG("%d disconnected.", fd);
+  if (reactor_ != nullptr)
+  {
+    reactor_->remove(reactor_loop_, fd);
+  }
+  else
+  {
+    removeFromEpoll(fd);
+  }
   close(fd);
+  client_buffers_.erase(fd);
   if (disconnect_callback_)
   {
     disconnect_callback_(fd);
   }
-  FD_CLR(fd, &masterfds_);
 
   for (size_t i = 0; i < client_fds_.size(); ++i)
   {
@@ -285,19 +370,38 @@ void TCPServer::handleDisconnect(const int fd)
 
 void TCPServer::readData(const int fd)
 {
-  bzero(&input_buffer_, INPUT_BUFFER_SIZE);  // clear input buffer
-  int nbytesrecv = recv(fd, input_buffer_, INPUT_BUFFER_SIZE, 0);
-  if (nbytesrecv > 0)
+  ClientBuffer& client = client_buffers_[fd];
+  if (client.data.size() < receive_buffer_size_ + 1)
   {
-    if (message_callback_)
-    {
-      message_callback_(fd, input_buffer_, nbytesrecv);
-    }
+    client.data.resize(receive_buffer_size_ + 1);
   }
-  else
+  const size_t capacity = client.data.size() - 1;
+
+  // Read until the socket is drained, as an edge-triggered event is reported only once.
+  while (true)
   {
+    int nbytesrecv = recv(fd, client.data.data() + client.fill, capacity - client.fill, 0);
+    if (nbytesrecv > 0)
+    {
+      client.fill += nbytesrecv;
+      if (!dispatchMessages(fd, client))
+      {
+        handleDisconnect(fd);
+        return;
+      }
+      continue;
+    }
+
     if (nbytesrecv < 0)
     {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        return;
+      }
+      if (errno == EINTR)
+      {
+        continue;
+      }
       if (errno == ECONNRESET)  // if connection gets reset by client, we want to suppress this output
       {
         URCL_LOG_DEBUG("client from FD %d sent a connection reset package.", fd);
@@ -312,9 +416,118 @@ void TCPServer::readData(const int fd)
       // normal disconnect
     }
     handleDisconnect(fd);
+    return;
   }
 }
 
+bool TCPServer::dispatchMessages(const int fd, ClientBuffer& client)
+{
+  char* data = client.data.data();
+  if (framing_ == MessageFraming::NONE)
+  {
+    data[client.fill] = '\0';
+    if (message_callback_)
+    {
+      message_callback_(fd, data, client.fill);
+    }
+    client.fill = 0;
+    return true;
+  }
+
+  const size_t capacity = client.data.size() - 1;
+  const size_t header_size = framing_ == MessageFraming::LENGTH_PREFIXED ? sizeof(uint32_t) : 0;
+  size_t offset = 0;
+  while (client.fill - offset >= header_size)
+  {
+    size_t message_size = frame_size_;
+    if (framing_ == MessageFraming::LENGTH_PREFIXED)
+    {
+      uint32_t length;
+      std::memcpy(&length, data + offset, sizeof(length));
+      message_size = be32toh(length);
+      if (message_size > capacity - header_size)
+      {
+        URCL_LOG_ERROR("Client at FD %d announced a message of %zu bytes, which exceeds the receive buffer of %zu "
+                       "bytes. Closing connection.",
+                       fd, message_size, capacity);
+        return false;
+      }
+    }
+    if (client.fill - offset < header_size + message_size)
+    {
+      break;
+    }
+    if (message_callback_)
+    {
+      message_callback_(fd, data + offset + header_size, message_size);
+    }
+    offset += header_size + message_size;
+  }
+
+  // Keep the incomplete rest for the next read
+  if (offset > 0)
+  {
+    std::memmove(data, data + offset, client.fill - offset);
+    client.fill -= offset;
+  }
+  return true;
+}
+
+void TCPServer::checkFraming(const size_t receive_buffer_size, const MessageFraming framing,
+                             const size_t frame_size) const
+{
+  if (receive_buffer_size == 0)
+  {
+    throw UrException("The receive buffer size of a TCPServer has to be greater than 0");
+  }
+  if (framing == MessageFraming::FIXED_SIZE && (frame_size == 0 || frame_size > receive_buffer_size))
+  {
+    std::stringstream ss;
+    ss << "Frame size " << frame_size << " is invalid for a receive buffer of " << receive_buffer_size
+       << " bytes. It has to be greater than 0 and must fit into the receive buffer.";
+    throw UrException(ss.str());
+  }
+  if (framing == MessageFraming::LENGTH_PREFIXED && receive_buffer_size <= sizeof(uint32_t))
+  {
+    std::stringstream ss;
+    ss << "A receive buffer of " << receive_buffer_size << " bytes cannot hold length prefixed messages.";
+    throw UrException(ss.str());
+  }
+}
+
+void TCPServer::setReceiveBufferSize(const size_t size)
+{
+  checkFraming(size, framing_, frame_size_);
+  receive_buffer_size_ = size;
+}
+
+void TCPServer::setMessageFraming(const MessageFraming framing, const size_t frame_size)
+{
+  checkFraming(receive_buffer_size_, framing, frame_size);
+  framing_ = framing;
+  frame_size_ = frame_size;
+}
+
+void TCPServer::setListenBacklog(const int backlog)
+{
+  listen_backlog_ = backlog;
+  // Listening again on a listening socket only updates its backlog
+  startListen();
+}
+
+void TCPServer::setClientSocketOptions(const SocketOptions& options)
+{
+  client_socket_options_ = options;
+
+  // Accepted sockets inherit the buffer sizes of the listening socket
+  SocketOptions listen_options;
+  listen_options.tcp_nodelay = false;
+  listen_options.tcp_quickack = false;
+  listen_options.receive_buffer_size = options.receive_buffer_size;
+  listen_options.send_buffer_size = options.send_buffer_size;
+  applySocketOptions(listen_fd_, listen_options);
+}
+
 void TCPServer::worker()
 {
   while (keep_running_)
@@ -326,33 +539,66 @@ void TCPServer::worker()
 
 void TCPServer::start()
 {
+  if (reactor_ != nullptr)
+  {
+    URCL_LOG_DEBUG("Registering TCPServer on port %d with reactor", port_);
+    keep_running_ = true;
+    reactor_->synchronize(reactor_loop_, [this]() {
+      reactor_->add(reactor_loop_, listen_fd_, [this]() { handleConnect(); });
+      for (const int fd : client_fds_)
+      {
+        reactor_->add(reactor_loop_, fd, [this, fd]() { readData(fd); });
+      }
+    });
+    return;
+  }
+
   URCL_LOG_DEBUG("Starting worker thread");
+  addToEpoll(listen_fd_);
+  for (const int fd : client_fds_)
+  {
+    addToEpoll(fd);
+  }
   keep_running_ = true;
   worker_thread_ = std::thread(&TCPServer::worker, this);
+  applyThreadConfig(worker_thread_.native_handle(), thread_config_);
 }
 
-bool TCPServer::write(const int fd, const uint8_t* buf, const size_t buf_len, size_t& written)
+void TCPServer::setThreadConfig(const ThreadConfig& config)
 {
-  written = 0;
-
-  size_t remaining = buf_len;
-
-  // handle partial sends
-  while (written < buf_len)
+  thread_config_ = config;
+  if (worker_thread_.joinable())
   {
-    ssize_t sent = ::send(fd, buf + written, remaining, 0);
-
-    if (sent <= 0)
-    {
-      URCL_LOG_ERROR("Sending data through socket failed.");
-      return false;
-    }
+    applyThreadConfig(worker_thread_.native_handle(), thread_config_);
+  }
+}
 
-    written += sent;
-    remaining -= sent;
+void TCPServer::setReactor(std::shared_ptr<Reactor> reactor)
+{
+  const bool was_running = keep_running_;
+  shutdown();
+  reactor_ = reactor;
+  if (reactor_ != nullptr)
+  {
+    reactor_loop_ = reactor_->assignLoop();
+  }
+  if (was_running)
+  {
+    start();
   }
+}
 
-  return true;
+bool TCPServer::write(const int fd, const uint8_t* buf, const size_t buf_len, size_t& written)
+{
+  struct iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(buf);
+  iov.iov_len = buf_len;
+  return sendIovec(fd, &iov, 1, written);
+}
+
+bool TCPServer::writev(const int fd, const struct iovec* iov, const size_t iov_count, size_t& written)
+{
+  return sendIovec(fd, iov, iov_count, written);
 }
 
 }  // namespace comm
@@ -22,21 +22,169 @@
 
 #include <arpa/inet.h>
 #include <endian.h>
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <netinet/tcp.h>
+#include <poll.h>
+#include <limits.h>
 #include <unistd.h>
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <sstream>
 #include <thread>
+#include <vector>
 
+#include "ur_client_library/clock.h"
+#include "ur_client_library/exceptions.h"
 #include "ur_client_library/log.h"
+#include "ur_client_library/trace.h"
 #include "ur_client_library/comm/tcp_socket.h"
 
 namespace urcl
 {
 namespace comm
 {
-TCPSocket::TCPSocket() : socket_fd_(-1), state_(SocketState::Invalid), reconnection_time_(std::chrono::seconds(10))
+bool sendIovec(const int fd, const struct iovec* iov, const size_t iov_count, size_t& written)
+{
+  written = 0;
+
+  // Work on a copy, so partially sent buffers can be advanced. Commands consist of a few buffers
+  // only, which are copied to the stack to keep sending free of allocations.
+  constexpr size_t NUM_STACK_IOVECS = 16;
+  struct iovec stack_iovecs[NUM_STACK_IOVECS];
+  std::vector<struct iovec> heap_iovecs;
+  struct iovec* remaining = stack_iovecs;
+  if (iov_count > NUM_STACK_IOVECS)
+  {
+    heap_iovecs.assign(iov, iov + iov_count);
+    remaining = heap_iovecs.data();
+  }
+  else
+  {
+    std::copy(iov, iov + iov_count, stack_iovecs);
+  }
+  size_t first = 0;
+  while (true)
+  {
+    while (first < iov_count && remaining[first].iov_len == 0)
+    {
+      ++first;
+    }
+    if (first == iov_count)
+    {
+      return true;
+    }
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = remaining + first;
+    msg.msg_iovlen = std::min<size_t>(iov_count - first, IOV_MAX);
+
+    ssize_t sent = ::sendmsg(fd, &msg, 0);
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    {
+      // Non-blocking sockets: Wait for space in the send buffer.
+      struct pollfd pfd;
+      pfd.fd = fd;
+      pfd.events = POLLOUT;
+      if (poll(&pfd, 1, -1) >= 0 || errno == EINTR)
+      {
+        continue;
+      }
+    }
+
+    if (sent <= 0)
+    {
+      URCL_LOG_ERROR("Sending data through socket failed.");
+      return false;
+    }
+
+    written += sent;
+
+    // handle partial sends
+    size_t advance = sent;
+    while (advance > 0)
+    {
+      struct iovec& current = remaining[first];
+      const size_t step = std::min(advance, current.iov_len);
+      current.iov_base = static_cast<uint8_t*>(current.iov_base) + step;
+      current.iov_len -= step;
+      advance -= step;
+      if (current.iov_len == 0)
+      {
+        ++first;
+      }
+    }
+  }
+}
+
+bool applySocketOptions(const int fd, const SocketOptions& options)
+{
+  bool success = true;
+  auto set = [&](const int level, const int name, const int value, const char* description) {
+    if (setsockopt(fd, level, name, &value, sizeof(value)) != 0)
+    {
+      URCL_LOG_WARN("Failed to set %s to %d on FD %d: %s", description, value, fd, strerror(errno));
+      success = false;
+    }
+  };
+
+  if (options.tcp_nodelay)
+  {
+    set(IPPROTO_TCP, TCP_NODELAY, 1, "TCP_NODELAY");
+  }
+  if (options.tcp_quickack)
+  {
+    set(IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+  }
+  if (options.busy_poll_us > 0)
+  {
+    set(SOL_SOCKET, SO_BUSY_POLL, options.busy_poll_us, "SO_BUSY_POLL");
+  }
+  // Setting the TOS also changes the priority, so an explicit priority has to be set after it.
+  if (options.tos >= 0)
+  {
+    set(IPPROTO_IP, IP_TOS, options.tos, "IP_TOS");
+  }
+  if (options.priority >= 0)
+  {
+    set(SOL_SOCKET, SO_PRIORITY, options.priority, "SO_PRIORITY");
+  }
+  if (options.receive_buffer_size > 0)
+  {
+    set(SOL_SOCKET, SO_RCVBUF, options.receive_buffer_size, "SO_RCVBUF");
+  }
+  if (options.send_buffer_size > 0)
+  {
+    set(SOL_SOCKET, SO_SNDBUF, options.send_buffer_size, "SO_SNDBUF");
+  }
+  return success;
+}
+
+bool readTcpStatistics(const int fd, TcpStatistics& statistics)
+{
+  struct tcp_info info;
+  socklen_t len = sizeof(info);
+  if (fd < 0 || getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) != 0)
+  {
+    return false;
+  }
+  statistics.rtt = std::chrono::microseconds(info.tcpi_rtt);
+  statistics.rtt_variance = std::chrono::microseconds(info.tcpi_rttvar);
+  statistics.retransmits = info.tcpi_total_retrans;
+  statistics.lost = info.tcpi_lost;
+  statistics.unacknowledged = info.tcpi_unacked;
+  statistics.congestion_window = info.tcpi_snd_cwnd;
+  return true;
+}
+
+TCPSocket::TCPSocket()
+  : socket_fd_(-1)
+  , state_(SocketState::Invalid)
+  , reconnection_time_(std::chrono::seconds(10))
+  , connect_timeout_(std::chrono::milliseconds(0))
 {
 }
 TCPSocket::~TCPSocket()
@@ -46,14 +194,70 @@ TCPSocket::~TCPSocket()
 
 void TCPSocket::setupOptions()
 {
-  int flag = 1;
-  setsockopt(socket_fd_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(int));
-  setsockopt(socket_fd_, IPPROTO_TCP, TCP_QUICKACK, &flag, sizeof(int));
+  if (transport_ != nullptr)
+  {
+    // Socket options don't apply to custom transports
+    std::chrono::microseconds timeout(0);
+    if (recv_timeout_ != nullptr)
+    {
+      timeout = std::chrono::seconds(recv_timeout_->tv_sec) + std::chrono::microseconds(recv_timeout_->tv_usec);
+    }
+    transport_->setReceiveTimeout(timeout);
+    return;
+  }
+
+  applySocketOptions(socket_fd_, socket_options_);
 
   if (recv_timeout_ != nullptr)
   {
     setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, recv_timeout_.get(), sizeof(timeval));
   }
+
+  if (kernel_timestamping_)
+  {
+    int timestamping_flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPING, &timestamping_flags, sizeof(int)) != 0)
+    {
+      URCL_LOG_WARN("Failed to enable kernel receive timestamps: %s", strerror(errno));
+    }
+  }
+}
+
+bool TCPSocket::connectWithTimeout(int socket_fd, struct sockaddr* address, size_t address_len)
+{
+  if (connect_timeout_.count() <= 0)
+  {
+    return open(socket_fd, address, address_len);
+  }
+
+  const int flags = fcntl(socket_fd, F_GETFL);
+  if (flags == -1 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) == -1)
+  {
+    return open(socket_fd, address, address_len);
+  }
+
+  bool connected = ::connect(socket_fd, address, address_len) == 0;
+  if (!connected && errno == EINPROGRESS)
+  {
+    struct pollfd pfd;
+    pfd.fd = socket_fd;
+    pfd.events = POLLOUT;
+    const int ready = ::poll(&pfd, 1, static_cast<int>(connect_timeout_.count()));
+    if (ready > 0)
+    {
+      int error = 0;
+      socklen_t len = sizeof(error);
+      connected = getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0;
+    }
+    else if (ready == 0)
+    {
+      URCL_LOG_DEBUG("Connection attempt timed out after %lld ms", static_cast<long long>(connect_timeout_.count()));
+    }
+  }
+
+  // The socket is used blocking once connected
+  fcntl(socket_fd, F_SETFL, flags);
+  return connected;
 }
 
 bool TCPSocket::setup(const std::string& host, const int port, const size_t max_num_tries,
@@ -72,6 +276,13 @@ bool TCPSocket::setup(const std::string& host, const int port, const size_t max_
   if (state_ == SocketState::Connected)
     return false;
 
+  // A socket left over from a lost connection is replaced by a new one
+  if (socket_fd_ >= 0)
+  {
+    ::close(socket_fd_);
+    socket_fd_ = -1;
+  }
+
   URCL_LOG_DEBUG("Setting up connection: %s:%d", host.c_str(), port);
 
   // gethostbyname() is deprecated so use getadderinfo() as described in:
@@ -90,33 +301,42 @@ bool TCPSocket::setup(const std::string& host, const int port, const size_t max_
   bool connected = false;
   while (!connected)
   {
-    if (getaddrinfo(host_name, service.c_str(), &hints, &result) != 0)
+    if (transport_ != nullptr)
     {
-      URCL_LOG_ERROR("Failed to get address for %s:%d", host.c_str(), port);
-      return false;
+      connected = transport_->connect(host, port);
     }
-    // loop through the list of addresses untill we find one that's connectable
-    for (struct addrinfo* p = result; p != nullptr; p = p->ai_next)
+    else
     {
-      socket_fd_ = ::socket(p->ai_family, p->ai_socktype, p->ai_protocol);
-
-      if (socket_fd_ != -1 && open(socket_fd_, p->ai_addr, p->ai_addrlen))
+      if (getaddrinfo(host_name, service.c_str(), &hints, &result) != 0)
       {
-        connected = true;
-        break;
+        URCL_LOG_ERROR("Failed to get address for %s:%d", host.c_str(), port);
+        return false;
+      }
+      // loop through the list of addresses untill we find one that's connectable
+      for (struct addrinfo* p = result; p != nullptr; p = p->ai_next)
+      {
+        socket_fd_ = ::socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+
+        if (socket_fd_ != -1 && connectWithTimeout(socket_fd_, p->ai_addr, p->ai_addrlen))
+        {
+          connected = true;
+          break;
+        }
+        if (socket_fd_ != -1)
+        {
+          ::close(socket_fd_);
+          socket_fd_ = -1;
+        }
       }
-    }
 
-    freeaddrinfo(result);
+      freeaddrinfo(result);
+    }
 
-    if (max_num_tries > 0)
+    if (!connected && max_num_tries > 0 && ++connect_counter >= max_num_tries)
     {
-      if (connect_counter++ >= max_num_tries)
-      {
-        URCL_LOG_ERROR("Failed to establish connection for %s:%d after %d tries", host.c_str(), port, max_num_tries);
-        state_ = SocketState::Invalid;
-        return false;
-      }
+      URCL_LOG_ERROR("Failed to establish connection for %s:%d after %zu tries", host.c_str(), port, max_num_tries);
+      state_ = SocketState::Invalid;
+      return false;
     }
 
     if (!connected)
@@ -127,7 +347,7 @@ bool TCPSocket::setup(const std::string& host, const int port, const size_t max_
          << ". Please check that the robot is booted and reachable on " << host_name << ". Retrying in "
          << std::chrono::duration_cast<std::chrono::duration<float>>(reconnection_time_resolved).count() << " seconds";
       URCL_LOG_ERROR("%s", ss.str().c_str());
-      std::this_thread::sleep_for(reconnection_time_resolved);
+      getClock()->sleepFor(reconnection_time_resolved);
     }
   }
   setupOptions();
@@ -138,16 +358,61 @@ bool TCPSocket::setup(const std::string& host, const int port, const size_t max_
 
 void TCPSocket::close()
 {
+  // Also mark sockets closed whose last connection attempt failed, so users waiting for a
+  // connection notice it has been given up.
+  state_ = SocketState::Closed;
+  if (transport_ != nullptr)
+  {
+    transport_->close();
+  }
   if (socket_fd_ >= 0)
   {
-    state_ = SocketState::Closed;
     ::close(socket_fd_);
     socket_fd_ = -1;
   }
 }
 
+void TCPSocket::setTransport(std::shared_ptr<Transport> transport)
+{
+  if (state_ == SocketState::Connected)
+  {
+    throw UrException("The transport of a socket cannot be changed while it is connected.");
+  }
+  transport_ = transport;
+}
+
+bool TCPSocket::getTcpStatistics(TcpStatistics& statistics) const
+{
+  if (transport_ != nullptr || state_ != SocketState::Connected)
+  {
+    return false;
+  }
+  return readTcpStatistics(socket_fd_, statistics);
+}
+
+bool TCPSocket::poll(const std::chrono::milliseconds timeout)
+{
+  if (state_ != SocketState::Connected)
+  {
+    return false;
+  }
+  if (transport_ != nullptr)
+  {
+    return transport_->poll(timeout);
+  }
+  struct pollfd pfd;
+  pfd.fd = socket_fd_;
+  pfd.events = POLLIN;
+  return ::poll(&pfd, 1, static_cast<int>(timeout.count())) > 0;
+}
+
 std::string TCPSocket::getIP() const
 {
+  if (transport_ != nullptr)
+  {
+    return transport_->getLocalIP();
+  }
+
   sockaddr_in name;
   socklen_t len = sizeof(name);
   int res = ::getsockname(socket_fd_, (sockaddr*)&name, &len);
@@ -172,6 +437,42 @@ bool TCPSocket::read(char* character)
   return read((uint8_t*)character, 1, read_chars);
 }
 
+ssize_t TCPSocket::recvWithTimestamp(uint8_t* buf, const size_t buf_len)
+{
+  iovec iov;
+  iov.iov_base = buf;
+  iov.iov_len = buf_len;
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping))];
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t res = ::recvmsg(socket_fd_, &msg, 0);
+  if (res <= 0)
+  {
+    return res;
+  }
+
+  last_kernel_timestamp_ = std::chrono::system_clock::time_point();
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING)
+    {
+      scm_timestamping timestamps;
+      std::memcpy(&timestamps, CMSG_DATA(cmsg), sizeof(timestamps));
+      // The first entry holds the software timestamp
+      const auto since_epoch =
+          std::chrono::seconds(timestamps.ts[0].tv_sec) + std::chrono::nanoseconds(timestamps.ts[0].tv_nsec);
+      last_kernel_timestamp_ = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch));
+    }
+  }
+  return res;
+}
+
 bool TCPSocket::read(uint8_t* buf, const size_t buf_len, size_t& read)
 {
   read = 0;
@@ -179,7 +480,29 @@ bool TCPSocket::read(uint8_t* buf, const size_t buf_len, size_t& read)
   if (state_ != SocketState::Connected)
     return false;
 
-  ssize_t res = ::recv(socket_fd_, buf, buf_len, 0);
+  if (transport_ != nullptr)
+  {
+    if (!transport_->read(buf, buf_len, read))
+    {
+      if (!transport_->isConnected())
+      {
+        state_ = SocketState::Disconnected;
+      }
+      return false;
+    }
+    URCL_TRACE(TracePoint::SOCKET_READ, read);
+    return true;
+  }
+
+  ssize_t res;
+  if (kernel_timestamping_)
+  {
+    res = recvWithTimestamp(buf, buf_len);
+  }
+  else
+  {
+    res = ::recv(socket_fd_, buf, buf_len, 0);
+  }
 
   if (res == 0)
   {
@@ -197,6 +520,7 @@ bool TCPSocket::read(uint8_t* buf, const size_t buf_len, size_t& read)
   }
 
   read = static_cast<size_t>(res);
+  URCL_TRACE(TracePoint::SOCKET_READ, read);
   return true;
 }
 
@@ -210,24 +534,36 @@ bool TCPSocket::write(const uint8_t* buf, const size_t buf_len, size_t& written)
     return false;
   }
 
-  size_t remaining = buf_len;
+  struct iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(buf);
+  iov.iov_len = buf_len;
+  return writev(&iov, 1, written);
+}
 
-  // handle partial sends
-  while (written < buf_len)
-  {
-    ssize_t sent = ::send(socket_fd_, buf + written, remaining, 0);
+bool TCPSocket::writev(const struct iovec* iov, const size_t iov_count, size_t& written)
+{
+  written = 0;
 
-    if (sent <= 0)
-    {
-      URCL_LOG_ERROR("Sending data through socket failed.");
-      return false;
-    }
+  if (state_ != SocketState::Connected)
+  {
+    URCL_LOG_ERROR("Attempt to write on a non-connected socket");
+    return false;
+  }
 
-    written += sent;
-    remaining -= sent;
+  if (transport_ != nullptr)
+  {
+    return transport_->write(iov, iov_count, written);
   }
+  return sendIovec(socket_fd_, iov, iov_count, written);
+}
 
-  return true;
+void TCPSocket::setSocketOptions(const SocketOptions& options)
+{
+  socket_options_ = options;
+  if (state_ == SocketState::Connected && transport_ == nullptr)
+  {
+    applySocketOptions(socket_fd_, socket_options_);
+  }
 }
 
 void TCPSocket::setReceiveTimeout(const timeval& timeout)
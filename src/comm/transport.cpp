@@ -0,0 +1,147 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/transport.h"
+
+#include <algorithm>
+
+namespace urcl
+{
+namespace comm
+{
+InMemoryTransport::Pair InMemoryTransport::createPair()
+{
+  auto connection = std::make_shared<Connection>();
+  return Pair(std::shared_ptr<InMemoryTransport>(new InMemoryTransport(connection, 0)),
+              std::shared_ptr<InMemoryTransport>(new InMemoryTransport(connection, 1)));
+}
+
+InMemoryTransport::InMemoryTransport(std::shared_ptr<Connection> connection, const size_t side)
+  : connection_(connection)
+  , rx_(connection_->channels[side])
+  , tx_(connection_->channels[1 - side])
+  , receive_timeout_(0)
+{
+}
+
+bool InMemoryTransport::connect(const std::string& host, const int port)
+{
+  std::lock_guard<std::mutex> lk(connection_->mutex);
+  if (connection_->closed)
+  {
+    for (auto& channel : connection_->channels)
+    {
+      channel.data.clear();
+    }
+    connection_->closed = false;
+  }
+  return true;
+}
+
+void InMemoryTransport::close()
+{
+  std::lock_guard<std::mutex> lk(connection_->mutex);
+  connection_->closed = true;
+  for (auto& channel : connection_->channels)
+  {
+    channel.cv.notify_all();
+  }
+}
+
+bool InMemoryTransport::isConnected() const
+{
+  std::lock_guard<std::mutex> lk(connection_->mutex);
+  // Data sent before the connection got closed can still be read
+  return !connection_->closed || !rx_.data.empty();
+}
+
+bool InMemoryTransport::read(uint8_t* buf, const size_t buf_len, size_t& read)
+{
+  read = 0;
+  std::unique_lock<std::mutex> lk(connection_->mutex);
+  auto readable = [this]() { return !rx_.data.empty() || connection_->closed; };
+  if (receive_timeout_.count() > 0)
+  {
+    rx_.cv.wait_for(lk, receive_timeout_, readable);
+  }
+  else
+  {
+    rx_.cv.wait(lk, readable);
+  }
+  if (rx_.data.empty())
+  {
+    return false;
+  }
+  read = std::min(buf_len, rx_.data.size());
+  std::copy_n(rx_.data.begin(), read, buf);
+  rx_.data.erase(rx_.data.begin(), rx_.data.begin() + read);
+  return true;
+}
+
+bool InMemoryTransport::write(const struct iovec* iov, const size_t iov_count, size_t& written)
+{
+  written = 0;
+  std::lock_guard<std::mutex> lk(connection_->mutex);
+  if (connection_->closed)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < iov_count; ++i)
+  {
+    const uint8_t* data = static_cast<const uint8_t*>(iov[i].iov_base);
+    tx_.data.insert(tx_.data.end(), data, data + iov[i].iov_len);
+    written += iov[i].iov_len;
+  }
+  tx_.cv.notify_all();
+  return true;
+}
+
+bool InMemoryTransport::write(const uint8_t* buf, const size_t buf_len, size_t& written)
+{
+  struct iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(buf);
+  iov.iov_len = buf_len;
+  return write(&iov, 1, written);
+}
+
+bool InMemoryTransport::poll(const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lk(connection_->mutex);
+  return rx_.cv.wait_for(lk, timeout, [this]() { return !rx_.data.empty() || connection_->closed; });
+}
+
+void InMemoryTransport::setReceiveTimeout(const std::chrono::microseconds timeout)
+{
+  std::lock_guard<std::mutex> lk(connection_->mutex);
+  receive_timeout_ = timeout;
+}
+
+}  // namespace comm
+}  // namespace urcl
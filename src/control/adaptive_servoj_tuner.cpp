@@ -0,0 +1,114 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/adaptive_servoj_tuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace urcl
+{
+namespace control
+{
+AdaptiveServojTuner::AdaptiveServojTuner(const AdaptiveServojConfig& config, const double lookahead_time,
+                                         const uint32_t gain)
+  : config_(config)
+  , initial_lookahead_time_(lookahead_time)
+  , initial_gain_(gain)
+  , lookahead_time_(lookahead_time)
+  , gain_(gain)
+  , jitter_us_(0)
+  , reset_requested_(false)
+  , num_intervals_(0)
+  , send_pending_(false)
+{
+  config_.window_size = std::max<size_t>(config_.window_size, 1);
+  config_.max_lookahead_time = std::max(config_.max_lookahead_time, config_.min_lookahead_time);
+  config_.min_gain = std::min(config_.min_gain, initial_gain_);
+}
+
+bool AdaptiveServojTuner::addSetpoint(const std::chrono::steady_clock::time_point send_time)
+{
+  if (reset_requested_.exchange(false, std::memory_order_acq_rel))
+  {
+    restart();
+  }
+
+  const std::chrono::steady_clock::time_point last_send_time = last_send_time_;
+  last_send_time_ = send_time;
+  if (last_send_time == std::chrono::steady_clock::time_point() || send_time - last_send_time > config_.max_interval)
+  {
+    return false;
+  }
+  intervals_.record(send_time - last_send_time);
+  if (++num_intervals_ < config_.window_size)
+  {
+    return false;
+  }
+
+  const std::chrono::microseconds jitter = intervals_.getPercentile(99) - intervals_.getPercentile(50);
+  intervals_.reset();
+  num_intervals_ = 0;
+  jitter_us_.store(jitter.count(), std::memory_order_relaxed);
+
+  const double target = std::clamp(config_.min_lookahead_time + config_.jitter_factor * jitter.count() * 1e-6,
+                                   config_.min_lookahead_time, config_.max_lookahead_time);
+  const double current = lookahead_time_.load(std::memory_order_relaxed);
+  if (std::abs(target - current) < config_.min_change && !send_pending_)
+  {
+    return false;
+  }
+  lookahead_time_.store(target, std::memory_order_relaxed);
+  if (config_.adapt_gain)
+  {
+    const double gain = std::round(initial_gain_ * config_.min_lookahead_time / target);
+    gain_.store(std::clamp(static_cast<uint32_t>(gain), config_.min_gain, initial_gain_), std::memory_order_relaxed);
+  }
+  send_pending_ = false;
+  return true;
+}
+
+void AdaptiveServojTuner::reset()
+{
+  reset_requested_.store(true, std::memory_order_release);
+}
+
+void AdaptiveServojTuner::restart()
+{
+  lookahead_time_.store(initial_lookahead_time_, std::memory_order_relaxed);
+  gain_.store(initial_gain_, std::memory_order_relaxed);
+  intervals_.reset();
+  num_intervals_ = 0;
+  last_send_time_ = std::chrono::steady_clock::time_point();
+  send_pending_ = true;
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -0,0 +1,430 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/command_arbiter.h"
+#include "ur_client_library/log.h"
+
+#include <algorithm>
+
+namespace urcl
+{
+namespace control
+{
+CommandClient::CommandClient(CommandArbiter& arbiter, const std::string& name, const int32_t priority)
+  : arbiter_(arbiter), name_(name), priority_(priority), requesting_(false), request_order_(0)
+{
+}
+
+CommandClient::~CommandClient()
+{
+  arbiter_.removeClient(this);
+}
+
+bool CommandClient::requestControl()
+{
+  return arbiter_.requestControl(this);
+}
+
+void CommandClient::releaseControl()
+{
+  arbiter_.releaseControl(this);
+}
+
+bool CommandClient::hasControl() const
+{
+  return arbiter_.hasControl(this);
+}
+
+void CommandClient::setControlCallback(std::function<void(bool)> callback)
+{
+  std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+  control_callback_ = callback;
+}
+
+void CommandClient::setTrajectoryDoneCallback(std::function<void(TrajectoryResult)> callback)
+{
+  std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+  trajectory_done_callback_ = callback;
+}
+
+bool CommandClient::writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                                      const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (control_mode == comm::ControlMode::MODE_STOPPED)
+  {
+    URCL_LOG_ERROR("Client '%s' must not stop the program shared with other clients.", name_.c_str());
+    return false;
+  }
+  return arbiter_.writeCommand(
+      this, [&]() { return arbiter_.reverse_interface_.write(&values, control_mode, robot_receive_timeout); });
+}
+
+bool CommandClient::writeTrajectoryControlMessage(const TrajectoryControlMessage trajectory_action,
+                                                  const int point_number,
+                                                  const RobotReceiveTimeout& robot_receive_timeout)
+{
+  return arbiter_.writeCommand(this, [&]() {
+    int points = point_number;
+    if (trajectory_action == TrajectoryControlMessage::TRAJECTORY_CANCEL)
+    {
+      // The robot discards the points written, but not read yet
+      points = static_cast<int>(arbiter_.trajectory_interface_.cancelTrajectoryWrites());
+      std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+      arbiter_.markTrajectoryCanceled();
+    }
+    else if (trajectory_action != TrajectoryControlMessage::TRAJECTORY_NOOP)
+    {
+      arbiter_.trajectory_interface_.resumeTrajectoryWrites();
+      std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+      arbiter_.addTrajectory(this);
+    }
+    return arbiter_.reverse_interface_.writeTrajectoryControlMessage(trajectory_action, points, robot_receive_timeout);
+  });
+}
+
+bool CommandClient::startTrajectoryStream(const size_t window_size, const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (window_size == 0)
+  {
+    throw UrException("The window of a streamed trajectory has to hold at least one point.");
+  }
+  return arbiter_.writeCommand(this, [&]() {
+    arbiter_.trajectory_interface_.resumeTrajectoryWrites();
+    {
+      std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+      arbiter_.addTrajectory(this);
+    }
+    if (!arbiter_.reverse_interface_.writeTrajectoryControlMessage(TrajectoryControlMessage::TRAJECTORY_STREAM, 0,
+                                                                   robot_receive_timeout))
+    {
+      return false;
+    }
+    arbiter_.trajectory_interface_.startTrajectoryStream(window_size);
+    return true;
+  });
+}
+
+bool CommandClient::endTrajectoryStream()
+{
+  return arbiter_.writeCommand(this, [&]() { return arbiter_.trajectory_interface_.endTrajectoryStream(); });
+}
+
+bool CommandClient::writeTrajectoryPoints(const std::vector<TrajectoryPoint>& points)
+{
+  return arbiter_.writeChunks<TrajectoryPoint>(this, points, [&](const TrajectoryPoint* chunk, const size_t count) {
+    return arbiter_.trajectory_interface_.writeTrajectoryPoints(chunk, count);
+  });
+}
+
+bool CommandClient::writeTrajectorySplinePoints(const std::vector<TrajectorySplinePoint>& points)
+{
+  return arbiter_.writeChunks<TrajectorySplinePoint>(
+      this, points, [&](const TrajectorySplinePoint* chunk, const size_t count) {
+        return arbiter_.trajectory_interface_.writeTrajectorySplinePoints(chunk, count);
+      });
+}
+
+bool CommandClient::writeTrajectorySplineSegments(const std::vector<TrajectorySplineSegment>& segments)
+{
+  return arbiter_.writeChunks<TrajectorySplineSegment>(
+      this, segments, [&](const TrajectorySplineSegment* chunk, const size_t count) {
+        return arbiter_.trajectory_interface_.writeTrajectorySplineSegments(chunk, count);
+      });
+}
+
+bool CommandClient::stopMotion()
+{
+  return arbiter_.writeCommand(this, [&]() {
+    // Leaving trajectory forwarding makes the robot cancel the trajectory
+    arbiter_.trajectory_interface_.cancelTrajectoryWrites();
+    {
+      std::lock_guard<std::mutex> lk(arbiter_.state_mutex_);
+      arbiter_.markTrajectoryCanceled();
+    }
+    return arbiter_.reverse_interface_.write(nullptr, comm::ControlMode::MODE_IDLE,
+                                             RobotReceiveTimeout::millisec(200));
+  });
+}
+
+CommandArbiter::CommandArbiter(ReverseInterface& reverse_interface, TrajectoryPointInterface& trajectory_interface)
+  : reverse_interface_(reverse_interface)
+  , trajectory_interface_(trajectory_interface)
+  , owner_(nullptr)
+  , request_counter_(0)
+  , num_handoffs_(0)
+{
+  trajectory_interface_.setTrajectoryEndCallback(
+      [this](const TrajectoryResult result) { handleTrajectoryDone(result); });
+}
+
+CommandArbiter::~CommandArbiter()
+{
+  trajectory_interface_.setTrajectoryEndCallback(nullptr);
+}
+
+std::shared_ptr<CommandClient> CommandArbiter::addClient(const std::string& name, const int32_t priority)
+{
+  std::shared_ptr<CommandClient> client(new CommandClient(*this, name, priority));
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  clients_.push_back(client.get());
+  return client;
+}
+
+std::string CommandArbiter::getOwnerName() const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return owner_ == nullptr ? "" : owner_->name_;
+}
+
+size_t CommandArbiter::getNumClients() const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return clients_.size();
+}
+
+uint64_t CommandArbiter::getNumHandoffs() const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return num_handoffs_;
+}
+
+void CommandArbiter::removeClient(CommandClient* client)
+{
+  std::vector<Notification> notifications;
+  bool cancel = false;
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    // The client is being destroyed, so it isn't notified anymore
+    client->control_callback_ = nullptr;
+    client->requesting_ = false;
+    if (owner_ == client)
+    {
+      cancel = changeOwner(nullptr, notifications);
+      grantNext(notifications);
+    }
+    clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+    for (auto& trajectory : pending_trajectories_)
+    {
+      if (trajectory.client == client)
+      {
+        trajectory.client = nullptr;
+      }
+    }
+  }
+  finishHandoff(cancel, notifications);
+}
+
+bool CommandArbiter::requestControl(CommandClient* client)
+{
+  std::vector<Notification> notifications;
+  bool cancel = false;
+  bool granted;
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    if (owner_ == client)
+    {
+      return true;
+    }
+    if (!client->requesting_)
+    {
+      client->requesting_ = true;
+      client->request_order_ = ++request_counter_;
+    }
+    if (owner_ == nullptr || owner_->priority_ < client->priority_)
+    {
+      if (owner_ != nullptr)
+      {
+        URCL_LOG_INFO("Client '%s' takes over control from client '%s'.", client->name_.c_str(),
+                      owner_->name_.c_str());
+      }
+      cancel = changeOwner(client, notifications);
+    }
+    granted = owner_ == client;
+  }
+  finishHandoff(cancel, notifications);
+  return granted;
+}
+
+void CommandArbiter::releaseControl(CommandClient* client)
+{
+  std::vector<Notification> notifications;
+  bool cancel = false;
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    client->requesting_ = false;
+    if (owner_ != client)
+    {
+      return;
+    }
+    cancel = changeOwner(nullptr, notifications);
+    grantNext(notifications);
+  }
+  finishHandoff(cancel, notifications);
+}
+
+bool CommandArbiter::hasControl(const CommandClient* client) const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return owner_ == client;
+}
+
+void CommandArbiter::grantNext(std::vector<Notification>& notifications)
+{
+  CommandClient* next = nullptr;
+  for (CommandClient* client : clients_)
+  {
+    if (!client->requesting_)
+    {
+      continue;
+    }
+    if (next == nullptr || client->priority_ > next->priority_ ||
+        (client->priority_ == next->priority_ && client->request_order_ < next->request_order_))
+    {
+      next = client;
+    }
+  }
+  if (next != nullptr)
+  {
+    changeOwner(next, notifications);
+  }
+}
+
+bool CommandArbiter::changeOwner(CommandClient* owner, std::vector<Notification>& notifications)
+{
+  if (owner_ == owner)
+  {
+    return false;
+  }
+  if (owner_ != nullptr && owner_->control_callback_)
+  {
+    notifications.push_back({ owner_->control_callback_, false });
+  }
+  owner_ = owner;
+  if (owner_ != nullptr)
+  {
+    ++num_handoffs_;
+    if (owner_->control_callback_)
+    {
+      notifications.push_back({ owner_->control_callback_, true });
+    }
+  }
+  // The next client starts from a stopped robot
+  return markTrajectoryCanceled();
+}
+
+bool CommandArbiter::markTrajectoryCanceled()
+{
+  if (pending_trajectories_.empty() || pending_trajectories_.back().canceled)
+  {
+    return false;
+  }
+  pending_trajectories_.back().canceled = true;
+  return true;
+}
+
+void CommandArbiter::addTrajectory(CommandClient* client)
+{
+  // The robot doesn't report a result for a trajectory replaced by a new one
+  if (!pending_trajectories_.empty() && !pending_trajectories_.back().canceled)
+  {
+    pending_trajectories_.pop_back();
+  }
+  pending_trajectories_.push_back({ client, false });
+}
+
+void CommandArbiter::finishHandoff(const bool cancel_trajectory, const std::vector<Notification>& notifications)
+{
+  if (cancel_trajectory)
+  {
+    // Bypasses command_mutex_, which an upload of the previous owner may hold
+    const size_t points_written = trajectory_interface_.cancelTrajectoryWrites();
+    reverse_interface_.writeTrajectoryControlMessage(TrajectoryControlMessage::TRAJECTORY_CANCEL,
+                                                     static_cast<int>(points_written));
+  }
+  for (const auto& notification : notifications)
+  {
+    notification.callback(notification.has_control);
+  }
+}
+
+void CommandArbiter::handleTrajectoryDone(const TrajectoryResult result)
+{
+  std::function<void(TrajectoryResult)> callback;
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    if (pending_trajectories_.empty())
+    {
+      // E.g. the answer to a cancel without a running trajectory
+      return;
+    }
+    CommandClient* client = pending_trajectories_.front().client;
+    pending_trajectories_.pop_front();
+    if (client != nullptr)
+    {
+      callback = client->trajectory_done_callback_;
+    }
+  }
+  if (callback)
+  {
+    callback(result);
+  }
+}
+
+bool CommandArbiter::writeCommand(const CommandClient* client, const std::function<bool()>& write)
+{
+  std::lock_guard<std::mutex> lk(command_mutex_);
+  if (!hasControl(client))
+  {
+    return false;
+  }
+  return write();
+}
+
+template <typename T>
+bool CommandArbiter::writeChunks(const CommandClient* client, const std::vector<T>& items,
+                                 const std::function<bool(const T*, size_t)>& write)
+{
+  if (items.empty())
+  {
+    return hasControl(client);
+  }
+  for (size_t offset = 0; offset < items.size(); offset += TrajectoryPointInterface::UPLOAD_CHUNK_SIZE)
+  {
+    const size_t count = std::min<size_t>(TrajectoryPointInterface::UPLOAD_CHUNK_SIZE, items.size() - offset);
+    if (!writeCommand(client, [&]() { return write(items.data() + offset, count); }))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -28,6 +28,8 @@
 
 #include <ur_client_library/control/reverse_interface.h>
 #include <math.h>
+#include <algorithm>
+#include <limits>
 
 namespace urcl
 {
@@ -37,9 +39,45 @@ ReverseInterface::ReverseInterface(uint32_t port, std::function<void(bool)> hand
                                    std::chrono::milliseconds step_time)
   : client_fd_(-1)
   , server_(port)
+  , bytes_sent_metric_(getMetricsRegistry().getCounter("urcl_reverse_interface_bytes_sent_total",
+                                                       "Bytes sent to the robot on the reverse interface",
+                                                       { { "port", std::to_string(server_.getPort()) } }))
+  , expired_setpoints_metric_(getMetricsRegistry().getCounter("urcl_reverse_interface_expired_setpoints_total",
+                                                              "Setpoints dropped because they expired before being "
+                                                              "sent",
+                                                              { { "port", std::to_string(server_.getPort()) } }))
   , handle_program_state_(handle_program_state)
   , step_time_(step_time)
   , keep_alive_count_modified_deprecated_(false)
+  , use_compact_protocol_(false)
+  , robot_supports_compact_(false)
+  , robot_echoes_setpoints_(false)
+  , program_parked_(false)
+  , session_id_(0)
+  , expecting_session_id_(false)
+  , session_resume_timeout_(0)
+  , resume_pending_(false)
+  , stop_resume_watchdog_(false)
+  , heartbeat_period_(0)
+  , stop_heartbeat_(false)
+  , automatic_keepalive_(false)
+  , stop_keepalive_(false)
+  , last_control_mode_(comm::ControlMode::MODE_UNINITIALIZED)
+  , last_read_timeout_(0)
+  , ik_streaming_(false)
+  , ik_has_solution_(false)
+  , num_unreachable_poses_(0)
+  , robot_state_stale_(false)
+  , num_stale_setpoints_(0)
+  , setpoint_validity_ns_(0)
+  , num_expired_setpoints_(0)
+  , setpoint_queue_(1, comm::OverflowPolicy::LATEST_ONLY)
+  , async_setpoint_writes_(false)
+  , published_setpoints_(0)
+  , discarded_setpoints_(0)
+  , protocol_(ReverseProtocol::FULL)
+  , sequenced_(false)
+  , last_sequence_(0)
 {
   handle_program_state_(false);
   server_.setMessageCallback(std::bind(&ReverseInterface::messageCallback, this, std::placeholders::_1,
@@ -47,19 +85,159 @@ ReverseInterface::ReverseInterface(uint32_t port, std::function<void(bool)> hand
   server_.setConnectCallback(std::bind(&ReverseInterface::connectionCallback, this, std::placeholders::_1));
   server_.setDisconnectCallback(std::bind(&ReverseInterface::disconnectionCallback, this, std::placeholders::_1));
   server_.setMaxClientsAllowed(1);
+  // The robot only sends 4 byte messages announcing its capabilities.
+  server_.setMessageFraming(comm::MessageFraming::FIXED_SIZE, sizeof(int32_t));
   server_.start();
 }
 
-bool ReverseInterface::write(const vector6d_t* positions, const comm::ControlMode control_mode,
+ReverseInterface::~ReverseInterface()
+{
+  setAsyncSetpointWrites(false);
+
+  {
+    std::lock_guard<std::mutex> lk(session_mutex_);
+    stop_resume_watchdog_ = true;
+  }
+  session_cv_.notify_all();
+  if (resume_watchdog_.joinable())
+  {
+    resume_watchdog_.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(heartbeat_mutex_);
+    stop_heartbeat_ = true;
+  }
+  heartbeat_cv_.notify_all();
+  if (heartbeat_thread_.joinable())
+  {
+    heartbeat_thread_.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(keepalive_mutex_);
+    stop_keepalive_ = true;
+  }
+  keepalive_cv_.notify_all();
+  if (keepalive_thread_.joinable())
+  {
+    keepalive_thread_.join();
+  }
+}
+
+void ReverseInterface::setSessionResumeTimeout(const std::chrono::milliseconds timeout)
+{
+  std::lock_guard<std::mutex> lk(session_mutex_);
+  session_resume_timeout_ = timeout;
+  if (timeout.count() > 0 && !resume_watchdog_.joinable())
+  {
+    resume_watchdog_ = std::thread(&ReverseInterface::resumeWatchdog, this);
+  }
+}
+
+void ReverseInterface::setAutomaticKeepalive(const bool enabled)
+{
+  std::lock_guard<std::mutex> lk(keepalive_mutex_);
+  automatic_keepalive_ = enabled;
+  if (enabled && !keepalive_thread_.joinable())
+  {
+    keepalive_thread_ = std::thread(&ReverseInterface::keepaliveLoop, this);
+  }
+  keepalive_cv_.notify_all();
+}
+
+void ReverseInterface::setParkedHeartbeatPeriod(const std::chrono::milliseconds period)
+{
+  std::lock_guard<std::mutex> lk(heartbeat_mutex_);
+  heartbeat_period_ = period;
+  if (period.count() > 0 && !heartbeat_thread_.joinable())
+  {
+    heartbeat_thread_ = std::thread(&ReverseInterface::heartbeatLoop, this);
+  }
+  heartbeat_cv_.notify_all();
+}
+
+void ReverseInterface::setAsyncSetpointWrites(const bool enabled)
+{
+  if (enabled == async_setpoint_writes_)
+  {
+    return;
+  }
+  async_setpoint_writes_ = enabled;
+  if (enabled)
+  {
+    setpoint_writer_ = std::thread(&ReverseInterface::runSetpointWriter, this);
+    applyThreadConfig(setpoint_writer_.native_handle(), setpoint_writer_config_);
+  }
+  else if (setpoint_writer_.joinable())
+  {
+    setpoint_writer_.join();
+  }
+}
+
+void ReverseInterface::setSetpointWriterThreadConfig(const ThreadConfig& config)
+{
+  setpoint_writer_config_ = config;
+  if (setpoint_writer_.joinable())
+  {
+    applyThreadConfig(setpoint_writer_.native_handle(), setpoint_writer_config_);
+  }
+}
+
+bool ReverseInterface::write(const vector6d_t* positions, comm::ControlMode control_mode,
                              const RobotReceiveTimeout& robot_receive_timeout)
 {
-  const int message_length = 7;
+  return writeBeforeDeadline(positions, control_mode, robot_receive_timeout,
+                             std::chrono::steady_clock::time_point::max());
+}
+
+bool ReverseInterface::write(const vector6d_t* positions, const comm::ControlMode control_mode,
+                             const RobotReceiveTimeout& robot_receive_timeout,
+                             const std::chrono::steady_clock::time_point state_time)
+{
+  const int64_t validity_ns = setpoint_validity_ns_;
+  if (validity_ns <= 0)
+  {
+    return write(positions, control_mode, robot_receive_timeout);
+  }
+  const auto deadline = state_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                         std::chrono::nanoseconds(validity_ns));
+  return writeBeforeDeadline(positions, control_mode, robot_receive_timeout, deadline);
+}
+
+bool ReverseInterface::writeBeforeDeadline(const vector6d_t* positions, comm::ControlMode control_mode,
+                                           const RobotReceiveTimeout& robot_receive_timeout,
+                                           const std::chrono::steady_clock::time_point deadline)
+{
   if (client_fd_ == -1)
   {
     return false;
   }
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
+  if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() > deadline)
+  {
+    countExpiredSetpoint();
+    return false;
+  }
+  if (robot_state_stale_ && comm::ControlModeTypes::is_control_mode_realtime(control_mode))
+  {
+    num_stale_setpoints_++;
+    return false;
+  }
+
+  vector6d_t joint_positions;
+  if (ik_model_ != nullptr && control_mode == comm::ControlMode::MODE_POSE && positions != nullptr)
+  {
+    if (!solvePose(*positions, joint_positions))
+    {
+      return false;
+    }
+    positions = &joint_positions;
+    control_mode = comm::ControlMode::MODE_SERVOJ;
+  }
+  else
+  {
+    ik_streaming_ = false;
+  }
 
   int read_timeout = 100;
   // If control mode is stopped, we shouldn't verify robot receive timeout
@@ -68,138 +246,358 @@ bool ReverseInterface::write(const vector6d_t* positions, const comm::ControlMod
     read_timeout = robot_receive_timeout.verifyRobotReceiveTimeout(control_mode, step_time_);
   }
 
-  // This can be removed once we remove the setkeepAliveCount() method
-  auto read_timeout_resolved = read_timeout;
-  if (keep_alive_count_modified_deprecated_)
+  if (!async_setpoint_writes_)
   {
-    // Translate keep alive count into read timeout. 20 milliseconds was the "old read timeout"
-    read_timeout_resolved = 20 * keepalive_count_;
+    return writeSetpoint(positions, control_mode, read_timeout);
   }
 
-  // The first element is always the read timeout.
-  int32_t val = read_timeout_resolved;
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+  QueuedSetpoint setpoint;
+  setpoint.has_values = positions != nullptr;
+  if (setpoint.has_values)
+  {
+    setpoint.values = *positions;
+  }
+  setpoint.control_mode = control_mode;
+  setpoint.read_timeout = read_timeout;
+  setpoint.deadline = deadline;
+  setpoint.sequence = published_setpoints_.load(std::memory_order_relaxed) + 1;
+  published_setpoints_.store(setpoint.sequence, std::memory_order_relaxed);
+  // Replacing a setpoint that hasn't been sent yet is counted by the queue
+  setpoint_queue_.enqueue(std::move(setpoint), async_setpoint_writes_);
+  return true;
+}
 
-  if (positions != nullptr)
+void ReverseInterface::setRobotStateStale(const bool stale)
+{
+  if (robot_state_stale_.exchange(stale) == stale)
   {
-    for (auto const& pos : *positions)
-    {
-      int32_t val = static_cast<int32_t>(round(pos * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
-    }
+    return;
   }
-  else
+  if (stale)
   {
-    b_pos += 6 * sizeof(int32_t);
+    discardQueuedSetpoint();
+  }
+}
+
+void ReverseInterface::setInverseKinematics(std::shared_ptr<const kinematics::KinematicsModel> model,
+                                            std::function<bool(vector6d_t&)> seed)
+{
+  ik_model_ = std::move(model);
+  ik_seed_ = std::move(seed);
+  ik_streaming_ = false;
+  ik_has_solution_ = false;
+}
+
+bool ReverseInterface::solvePose(const vector6d_t& pose, vector6d_t& q)
+{
+  vector6d_t q_near = ik_solution_;
+  bool has_q_near = ik_streaming_ && ik_has_solution_;
+  if (!ik_streaming_ && ik_seed_)
+  {
+    has_q_near = ik_seed_(q_near);
+  }
+  if (!has_q_near && ik_has_solution_)
+  {
+    q_near = ik_solution_;
+    has_q_near = true;
   }
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH - 1; i++)
+  bool solved;
+  if (has_q_near)
+  {
+    solved = ik_model_->inverse(pose, q_near, q);
+  }
+  else
+  {
+    std::array<vector6d_t, kinematics::KinematicsModel::MAX_IK_SOLUTIONS> solutions;
+    solved = ik_model_->inverse(pose, solutions) > 0;
+    q = solutions[0];
+  }
+  if (!solved)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    num_unreachable_poses_++;
+    URCL_LOG_DEBUG("Could not solve the inverse kinematics of pose [%f, %f, %f, %f, %f, %f], it is not sent to the "
+                   "robot.",
+                   pose[0], pose[1], pose[2], pose[3], pose[4], pose[5]);
+    return false;
   }
+  ik_solution_ = q;
+  ik_has_solution_ = true;
+  ik_streaming_ = true;
+  return true;
+}
 
-  val = htobe32(toUnderlying(control_mode));
-  b_pos += append(b_pos, val);
+bool ReverseInterface::writeSetpoint(const vector6d_t* positions, const comm::ControlMode control_mode,
+                                     const int32_t read_timeout)
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  if (positions != nullptr)
+  {
+    wire::encode(message, wire::reverse::SETPOINT_VALUES, *positions);
+  }
 
-  size_t written;
+  if (!writeCommand(read_timeout, control_mode, message))
+  {
+    return false;
+  }
+  if (control_mode == comm::ControlMode::MODE_SERVOJ)
+  {
+    std::shared_ptr<AdaptiveServojTuner> tuner = std::atomic_load(&servoj_tuner_);
+    if (tuner != nullptr && tuner->addSetpoint(std::chrono::steady_clock::now()))
+    {
+      URCL_LOG_DEBUG("Adapting servoj to a jitter of %ld us: lookahead time %.3f s, gain %u",
+                     static_cast<long>(tuner->getJitter().count()), tuner->getLookaheadTime(), tuner->getGain());
+      writeServoParameters(tuner->getLookaheadTime(), tuner->getGain());
+    }
+  }
+  return true;
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+bool ReverseInterface::writeServoParameters(const double lookahead_time, const uint32_t gain)
+{
+  if (lookahead_time < 0.03 || lookahead_time > 0.2 || gain < 100 || gain > 2000)
+  {
+    URCL_LOG_ERROR("Invalid servoj parameters: lookahead time %f s must be in [0.03, 0.2], gain %u must be in "
+                   "[100, 2000]",
+                   lookahead_time, gain);
+    return false;
+  }
+  if (client_fd_ == -1)
+  {
+    return false;
+  }
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::reverse::SERVO_LOOKAHEAD_TIME, lookahead_time);
+  wire::encode(message, wire::reverse::SERVO_GAIN, static_cast<int32_t>(gain));
+  return writeCommand(0, static_cast<comm::ControlMode>(SERVO_PARAMETERS), message);
 }
 
 bool ReverseInterface::writeTrajectoryControlMessage(const TrajectoryControlMessage trajectory_action,
                                                      const int point_number,
                                                      const RobotReceiveTimeout& robot_receive_timeout)
 {
-  const int message_length = 3;
   if (client_fd_ == -1)
   {
     return false;
   }
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
 
   int read_timeout = robot_receive_timeout.verifyRobotReceiveTimeout(comm::ControlMode::MODE_FORWARD, step_time_);
 
-  // This can be removed once we remove the setkeepAliveCount() method
-  auto read_timeout_resolved = read_timeout;
-  if (keep_alive_count_modified_deprecated_)
+  discardQueuedSetpoint();
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::reverse::TRAJECTORY_ACTION, toUnderlying(trajectory_action));
+  int32_t point_count = static_cast<int32_t>(point_number);
+  if (trajectory_action == TrajectoryControlMessage::TRAJECTORY_CANCEL && trajectory_writes_canceler_)
   {
-    // Translate keep alive count into read timeout. 20 milliseconds was the "old read timeout"
-    read_timeout_resolved = 20 * keepalive_count_;
+    point_count = static_cast<int32_t>(trajectory_writes_canceler_());
   }
+  wire::encode(message, wire::reverse::TRAJECTORY_POINT_COUNT, point_count);
+  return writeCommand(read_timeout, comm::ControlMode::MODE_FORWARD, message);
+}
 
-  // The first element is always the read timeout.
-  int32_t val = read_timeout_resolved;
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
-
-  val = htobe32(toUnderlying(trajectory_action));
-  b_pos += append(b_pos, val);
-
-  val = htobe32(point_number);
-  b_pos += append(b_pos, val);
-
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH - 1; i++)
+bool ReverseInterface::writeTrajectoryCacheControlMessage(const TrajectoryControlMessage trajectory_action,
+                                                          const int32_t trajectory_id, const int point_number,
+                                                          const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (client_fd_ == -1)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    return false;
   }
 
-  val = htobe32(toUnderlying(comm::ControlMode::MODE_FORWARD));
-  b_pos += append(b_pos, val);
-
-  size_t written;
+  int read_timeout = robot_receive_timeout.verifyRobotReceiveTimeout(comm::ControlMode::MODE_FORWARD, step_time_);
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+  discardQueuedSetpoint();
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::reverse::TRAJECTORY_ACTION, toUnderlying(trajectory_action));
+  wire::encode(message, wire::reverse::TRAJECTORY_POINT_COUNT, static_cast<int32_t>(point_number));
+  wire::encode(message, wire::reverse::TRAJECTORY_ID, trajectory_id);
+  return writeCommand(read_timeout, comm::ControlMode::MODE_FORWARD, message);
 }
 
 bool ReverseInterface::writeFreedriveControlMessage(const FreedriveControlMessage freedrive_action,
                                                     const RobotReceiveTimeout& robot_receive_timeout)
 {
-  const int message_length = 2;
   if (client_fd_ == -1)
   {
     return false;
   }
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
 
   int read_timeout = robot_receive_timeout.verifyRobotReceiveTimeout(comm::ControlMode::MODE_FREEDRIVE, step_time_);
 
+  discardQueuedSetpoint();
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::reverse::FREEDRIVE_ACTION, toUnderlying(freedrive_action));
+  return writeCommand(read_timeout, comm::ControlMode::MODE_FREEDRIVE, message);
+}
+
+bool ReverseInterface::writeCommand(const int32_t read_timeout, const comm::ControlMode control_mode,
+                                    int32_t* message)
+{
   // This can be removed once we remove the setkeepAliveCount() method
-  auto read_timeout_resolved = read_timeout;
+  int32_t read_timeout_resolved = read_timeout;
   if (keep_alive_count_modified_deprecated_)
   {
     // Translate keep alive count into read timeout. 20 milliseconds was the "old read timeout"
     read_timeout_resolved = 20 * keepalive_count_;
   }
 
-  // The first element is always the read timeout.
-  int32_t val = read_timeout_resolved;
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+  if (trajectory_writes_canceler_ && control_mode != comm::ControlMode::MODE_FORWARD &&
+      toUnderlying(control_mode) != HEARTBEAT && toUnderlying(control_mode) != SERVO_PARAMETERS)
+  {
+    bool leaves_forward;
+    {
+      std::lock_guard<std::mutex> keepalive_lk(keepalive_mutex_);
+      leaves_forward = last_control_mode_ == comm::ControlMode::MODE_FORWARD;
+    }
+    if (leaves_forward)
+    {
+      // The robot cancels the trajectory when leaving MODE_FORWARD. Canceling explicitly tells it
+      // how many points to discard.
+      int32_t cancel[MAX_MESSAGE_LENGTH] = { 0 };
+      wire::encode(cancel, wire::reverse::TRAJECTORY_ACTION, toUnderlying(TrajectoryControlMessage::TRAJECTORY_CANCEL));
+      wire::encode(cancel, wire::reverse::TRAJECTORY_POINT_COUNT,
+                   static_cast<int32_t>(trajectory_writes_canceler_()));
+      if (!writeCommand(read_timeout, comm::ControlMode::MODE_FORWARD, cancel))
+      {
+        return false;
+      }
+    }
+  }
 
-  val = htobe32(toUnderlying(freedrive_action));
-  b_pos += append(b_pos, val);
+  std::lock_guard<std::mutex> lk(write_mutex_);
+  size_t written;
+  const bool use_compact = use_compact_protocol_ && robot_supports_compact_;
+  if (protocol_ == ReverseProtocol::FULL && (use_compact || (robot_echoes_setpoints_ && !sequenced_)))
+  {
+    // The robot still expects the full format, so the switch is announced in the full format.
+    int32_t select[MAX_MESSAGE_LENGTH + 1] = { 0 };
+    wire::encode(select, wire::reverse::READ_TIMEOUT, read_timeout_resolved);
+    wire::encode(select, wire::reverse::PROTOCOL_PROTOCOL,
+                 toUnderlying(use_compact ? ReverseProtocol::COMPACT : ReverseProtocol::FULL));
+    wire::encode(select, wire::reverse::PROTOCOL_SEQUENCED, robot_echoes_setpoints_ ? 1 : 0);
+    wire::encode(select, wire::reverse::CONTROL_MODE, PROTOCOL_SELECT);
+    // A select sent while already numbering setpoints is followed by a number as well
+    const size_t select_length = sequenced_ ? MAX_MESSAGE_LENGTH + 1 : MAX_MESSAGE_LENGTH;
+    wire::toBigEndian(select, select_length);
+    if (!server_.write(client_fd_, reinterpret_cast<const uint8_t*>(select), select_length * sizeof(int32_t),
+                       written))
+    {
+      return false;
+    }
+    bytes_sent_metric_.increment(written);
+    if (use_compact)
+    {
+      URCL_LOG_DEBUG("Switched reverse interface to the compact protocol");
+      protocol_ = ReverseProtocol::COMPACT;
+    }
+    sequenced_ = robot_echoes_setpoints_;
+  }
+
+  size_t message_length = MAX_MESSAGE_LENGTH;
+  if (protocol_ == ReverseProtocol::COMPACT)
+  {
+    // The header replaces the read timeout, the payload fields directly follow it
+    message_length = wire::reverse::READ_TIMEOUT.end() + wire::reverse::compactPayloadLength(control_mode);
+    wire::encode(message, wire::reverse::READ_TIMEOUT,
+                 read_timeout_resolved * COMPACT_MODE_RANGE + toUnderlying(control_mode) -
+                     toUnderlying(comm::ControlMode::MODE_STOPPED));
+  }
+  else
+  {
+    // Unused fields stay zero to allow usage with other script commands
+    wire::encode(message, wire::reverse::READ_TIMEOUT, read_timeout_resolved);
+    wire::encode(message, wire::reverse::CONTROL_MODE, toUnderlying(control_mode));
+  }
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH - 1; i++)
+  wire::toBigEndian(message, message_length);
+  int32_t sequence = 0;
+  if (!sequenced_)
+  {
+    if (!server_.write(client_fd_, reinterpret_cast<const uint8_t*>(message), message_length * sizeof(int32_t),
+                       written))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    // Only setpoints are numbered, the sequence number directly follows the message
+    if (comm::ControlModeTypes::is_control_mode_realtime(control_mode))
+    {
+      last_sequence_ = last_sequence_ == std::numeric_limits<int32_t>::max() ? 1 : last_sequence_ + 1;
+      sequence = last_sequence_;
+    }
+    int32_t sequence_be = static_cast<int32_t>(htobe32(static_cast<uint32_t>(sequence)));
+    const struct iovec iov[2] = { { message, message_length * sizeof(int32_t) },
+                                  { &sequence_be, sizeof(sequence_be) } };
+    if (!server_.writev(client_fd_, iov, 2, written))
+    {
+      return false;
+    }
+  }
+  if (sequence != 0 && latency_monitor_ != nullptr)
+  {
+    latency_monitor_->recordSent(sequence, std::chrono::steady_clock::now());
+  }
+  bytes_sent_metric_.increment(written);
+  URCL_TRACE(TracePoint::REVERSE_INTERFACE_WRITE, written);
+  if (toUnderlying(control_mode) == HEARTBEAT || toUnderlying(control_mode) == SERVO_PARAMETERS)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    // Heartbeats and servo parameters neither re-arm the program nor count as commands
+    return true;
   }
+  // Any command re-arms a parked program
+  program_parked_ = false;
+
+  std::lock_guard<std::mutex> keepalive_lk(keepalive_mutex_);
+  // The keepalive thread only waits without a deadline if the last command didn't need keepalive messages
+  const bool wake_keepalive =
+      automatic_keepalive_ && (last_control_mode_ != control_mode || last_read_timeout_ != read_timeout_resolved);
+  last_control_mode_ = control_mode;
+  last_read_timeout_ = read_timeout_resolved;
+  last_command_time_ = std::chrono::steady_clock::now();
+  if (wake_keepalive)
+  {
+    keepalive_cv_.notify_one();
+  }
+  return true;
+}
 
-  val = htobe32(toUnderlying(comm::ControlMode::MODE_FREEDRIVE));
-  b_pos += append(b_pos, val);
+void ReverseInterface::countExpiredSetpoint()
+{
+  num_expired_setpoints_++;
+  expired_setpoints_metric_.increment();
+}
 
-  size_t written;
+void ReverseInterface::discardQueuedSetpoint()
+{
+  if (async_setpoint_writes_)
+  {
+    discarded_setpoints_ = published_setpoints_.load();
+  }
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+void ReverseInterface::runSetpointWriter()
+{
+  QueuedSetpoint setpoint;
+  while (async_setpoint_writes_)
+  {
+    if (!setpoint_queue_.waitDequeTimed(setpoint, std::chrono::milliseconds(100)) ||
+        setpoint.sequence <= discarded_setpoints_)
+    {
+      continue;
+    }
+    if (setpoint.deadline != std::chrono::steady_clock::time_point::max() &&
+        std::chrono::steady_clock::now() > setpoint.deadline)
+    {
+      countExpiredSetpoint();
+      continue;
+    }
+    if (!writeSetpoint(setpoint.has_values ? &setpoint.values : nullptr, setpoint.control_mode, setpoint.read_timeout))
+    {
+      URCL_LOG_DEBUG("Failed to send setpoint %llu to the robot.", static_cast<unsigned long long>(setpoint.sequence));
+    }
+  }
 }
 
 void ReverseInterface::setKeepaliveCount(const uint32_t count)
@@ -218,7 +616,17 @@ void ReverseInterface::connectionCallback(const int filedescriptor)
   {
     URCL_LOG_INFO("Robot connected to reverse interface. Ready to receive control commands.");
     client_fd_ = filedescriptor;
-    handle_program_state_(true);
+    expecting_session_id_ = false;
+    bool resume_pending;
+    {
+      std::lock_guard<std::mutex> lk(session_mutex_);
+      resume_pending = resume_pending_;
+    }
+    // The program state is only changed once it is known whether the previous session is resumed
+    if (!resume_pending)
+    {
+      handle_program_state_(true);
+    }
   }
   else
   {
@@ -231,14 +639,196 @@ void ReverseInterface::disconnectionCallback(const int filedescriptor)
 {
   URCL_LOG_INFO("Connection to reverse interface dropped.", filedescriptor);
   client_fd_ = -1;
+  robot_supports_compact_ = false;
+  robot_echoes_setpoints_ = false;
+  program_parked_ = false;
+  if (std::shared_ptr<AdaptiveServojTuner> tuner = std::atomic_load(&servoj_tuner_))
+  {
+    // The parameters are sent again, in case the program has been restarted with its initial ones
+    tuner->reset();
+  }
+  {
+    std::lock_guard<std::mutex> lk(write_mutex_);
+    protocol_ = ReverseProtocol::FULL;
+    sequenced_ = false;
+  }
+  {
+    // A reconnecting program waits for a new command
+    std::lock_guard<std::mutex> lk(keepalive_mutex_);
+    last_control_mode_ = comm::ControlMode::MODE_UNINITIALIZED;
+  }
+  {
+    std::lock_guard<std::mutex> lk(session_mutex_);
+    if (session_resume_timeout_.count() > 0 && session_id_ != 0)
+    {
+      resume_pending_ = true;
+      resume_deadline_ = std::chrono::steady_clock::now() + session_resume_timeout_;
+      session_cv_.notify_all();
+      return;
+    }
+  }
   handle_program_state_(false);
 }
 
 void ReverseInterface::messageCallback(const int filedescriptor, char* buffer, int nbytesrecv)
 {
+  if (nbytesrecv == sizeof(int32_t))
+  {
+    int32_t value;
+    std::memcpy(&value, buffer, sizeof(int32_t));
+    value = static_cast<int32_t>(be32toh(value));
+    if (expecting_session_id_)
+    {
+      expecting_session_id_ = false;
+      handleSessionAnnouncement(value);
+      return;
+    }
+    if (value == SESSION_ANNOUNCEMENT)
+    {
+      expecting_session_id_ = true;
+      return;
+    }
+    if (value == toUnderlying(ReverseProtocol::COMPACT))
+    {
+      URCL_LOG_DEBUG("Robot supports the compact reverse interface protocol");
+      robot_supports_compact_ = true;
+      return;
+    }
+    if (value == SETPOINT_ECHO)
+    {
+      URCL_LOG_DEBUG("Robot echoes the sequence numbers of setpoints");
+      robot_echoes_setpoints_ = true;
+      return;
+    }
+    if (value == PROGRAM_PARKED)
+    {
+      URCL_LOG_INFO("Robot program parked. The next command written will re-arm it.");
+      program_parked_ = true;
+      return;
+    }
+  }
   URCL_LOG_WARN("Message on ReverseInterface received. The reverse interface currently does not support any message "
                 "handling. This message will be ignored.");
 }
 
+void ReverseInterface::handleSessionAnnouncement(const int32_t session_id)
+{
+  bool resumed = false;
+  bool replaced = false;
+  {
+    std::lock_guard<std::mutex> lk(session_mutex_);
+    if (resume_pending_)
+    {
+      resume_pending_ = false;
+      resumed = session_id == session_id_;
+      replaced = !resumed;
+      session_cv_.notify_all();
+    }
+    session_id_ = session_id;
+  }
+
+  if (resumed)
+  {
+    URCL_LOG_INFO("Robot program resumed session %d on reverse interface.", session_id);
+  }
+  else if (replaced)
+  {
+    URCL_LOG_INFO("New robot program session %d connected to reverse interface.", session_id);
+    handle_program_state_(false);
+    handle_program_state_(true);
+  }
+}
+
+void ReverseInterface::resumeWatchdog()
+{
+  std::unique_lock<std::mutex> lk(session_mutex_);
+  while (!stop_resume_watchdog_)
+  {
+    if (!resume_pending_)
+    {
+      session_cv_.wait(lk);
+      continue;
+    }
+    if (std::chrono::steady_clock::now() < resume_deadline_)
+    {
+      session_cv_.wait_until(lk, resume_deadline_);
+      continue;
+    }
+
+    resume_pending_ = false;
+    const int32_t session_id = session_id_;
+    lk.unlock();
+    URCL_LOG_WARN("Robot program session %d wasn't resumed in time.", session_id);
+    handle_program_state_(false);
+    // A program connected in the meantime without resuming the session
+    if (client_fd_ != -1)
+    {
+      handle_program_state_(true);
+    }
+    lk.lock();
+  }
+}
+
+void ReverseInterface::keepaliveLoop()
+{
+  std::unique_lock<std::mutex> lk(keepalive_mutex_);
+  while (!stop_keepalive_)
+  {
+    if (!automatic_keepalive_ || !comm::ControlModeTypes::is_control_mode_non_realtime(last_control_mode_) ||
+        last_read_timeout_ <= 0)
+    {
+      keepalive_cv_.wait(lk);
+      continue;
+    }
+    const auto due = last_command_time_ + std::chrono::milliseconds(last_read_timeout_) / 2;
+    if (std::chrono::steady_clock::now() < due)
+    {
+      keepalive_cv_.wait_until(lk, due);
+      continue;
+    }
+    if (program_parked_)
+    {
+      // Checked again once half of the timeout has passed
+      last_command_time_ = std::chrono::steady_clock::now();
+      continue;
+    }
+
+    const comm::ControlMode control_mode = last_control_mode_;
+    const int32_t read_timeout = last_read_timeout_;
+    lk.unlock();
+    // TRAJECTORY_NOOP and FREEDRIVE_NOOP are both 0, an IDLE command has no payload at all
+    int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+    const bool written = writeCommand(read_timeout, control_mode, message);
+    lk.lock();
+    if (!written)
+    {
+      // Not retried before the next command
+      last_control_mode_ = comm::ControlMode::MODE_UNINITIALIZED;
+    }
+  }
+}
+
+void ReverseInterface::heartbeatLoop()
+{
+  std::unique_lock<std::mutex> lk(heartbeat_mutex_);
+  while (!stop_heartbeat_)
+  {
+    if (heartbeat_period_.count() <= 0)
+    {
+      heartbeat_cv_.wait(lk);
+      continue;
+    }
+    heartbeat_cv_.wait_for(lk, heartbeat_period_);
+    if (stop_heartbeat_ || !program_parked_ || client_fd_ == -1)
+    {
+      continue;
+    }
+    lk.unlock();
+    int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+    writeCommand(0, static_cast<comm::ControlMode>(HEARTBEAT), message);
+    lk.lock();
+  }
+}
+
 }  // namespace control
 }  // namespace urcl
@@ -0,0 +1,139 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/rtde_command_scheduler.h"
+
+#include <string>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace control
+{
+RTDECommandScheduler::RTDECommandScheduler(ReverseInterface& reverse_interface, const comm::ControlMode control_mode,
+                                           const RobotReceiveTimeout& robot_receive_timeout)
+  : reverse_interface_(reverse_interface)
+  , control_mode_(control_mode)
+  , robot_receive_timeout_(robot_receive_timeout)
+  , command_{}
+  , has_command_(false)
+  , active_(false)
+  , num_writes_(0)
+  , num_failed_writes_(0)
+{
+  checkControlMode(control_mode);
+}
+
+void RTDECommandScheduler::checkControlMode(const comm::ControlMode control_mode)
+{
+  if (!comm::ControlModeTypes::is_control_mode_realtime(control_mode))
+  {
+    throw UrException("Commands synchronized to RTDE packages require a realtime control mode, got " +
+                      std::to_string(toUnderlying(control_mode)));
+  }
+}
+
+void RTDECommandScheduler::setControlMode(const comm::ControlMode control_mode,
+                                          const RobotReceiveTimeout& robot_receive_timeout)
+{
+  checkControlMode(control_mode);
+  std::lock_guard<std::mutex> lk(cycle_mutex_);
+  control_mode_ = control_mode;
+  robot_receive_timeout_ = robot_receive_timeout;
+}
+
+void RTDECommandScheduler::setCommandCallback(CommandCallback callback)
+{
+  std::lock_guard<std::mutex> lk(cycle_mutex_);
+  callback_ = callback;
+}
+
+void RTDECommandScheduler::setCommand(const vector6d_t& command)
+{
+  std::lock_guard<std::mutex> lk(command_mutex_);
+  command_ = command;
+  has_command_ = true;
+}
+
+void RTDECommandScheduler::clearCommand()
+{
+  std::lock_guard<std::mutex> lk(command_mutex_);
+  has_command_ = false;
+}
+
+void RTDECommandScheduler::setActive(const bool active)
+{
+  std::lock_guard<std::mutex> lk(cycle_mutex_);
+  active_ = active;
+}
+
+void RTDECommandScheduler::onDataPackage(const rtde_interface::DataPackage& package)
+{
+  if (!active_)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(cycle_mutex_);
+  if (!active_)
+  {
+    return;
+  }
+
+  vector6d_t command;
+  if (callback_)
+  {
+    if (!callback_(package, command))
+    {
+      return;
+    }
+  }
+  else
+  {
+    std::lock_guard<std::mutex> command_lk(command_mutex_);
+    if (!has_command_)
+    {
+      return;
+    }
+    command = command_;
+  }
+
+  if (reverse_interface_.write(&command, control_mode_, robot_receive_timeout_))
+  {
+    ++num_writes_;
+  }
+  else
+  {
+    ++num_failed_writes_;
+  }
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -27,199 +27,288 @@
 //----------------------------------------------------------------------
 
 #include <ur_client_library/control/script_command_interface.h>
-#include <math.h>
+#include <ur_client_library/exceptions.h>
+
+#include <limits>
 
 namespace urcl
 {
 namespace control
 {
-ScriptCommandInterface::ScriptCommandInterface(uint32_t port) : ReverseInterface(port, [](bool foo) { return foo; })
+namespace
 {
-  client_connected_ = false;
+// A command counts as written, unless its acknowledgement has failed already
+bool isWritten(std::future<bool> acknowledgement)
+{
+  return acknowledgement.wait_for(std::chrono::seconds(0)) != std::future_status::ready || acknowledgement.get();
 }
 
-bool ScriptCommandInterface::zeroFTSensor()
+// Sequence numbers count from 1 to INT32_MAX and wrap around to 1. A number precedes another one if
+// it is less than half of that range behind it, so commands pending across the wrap stay in order.
+bool precedesOrEquals(const int32_t sequence_number, const int32_t other)
 {
-  const int message_length = 1;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
-  int32_t val = htobe32(toUnderlying(ScriptCommand::ZERO_FTSENSOR));
-  b_pos += append(b_pos, val);
-
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
+  constexpr int64_t RANGE = std::numeric_limits<int32_t>::max();
+  int64_t distance = (static_cast<int64_t>(other) - sequence_number) % RANGE;
+  if (distance < 0)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    distance += RANGE;
   }
-  size_t written;
-
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+  return distance < RANGE / 2;
 }
 
-bool ScriptCommandInterface::setPayload(const double mass, const vector3d_t* cog)
+// The arguments of a command are encoded the same way for single commands and batches
+void encodePayload(int32_t* message, const double mass, const vector3d_t* cog)
 {
-  const int message_length = 5;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
-  int32_t val = htobe32(toUnderlying(ScriptCommand::SET_PAYLOAD));
-  b_pos += append(b_pos, val);
+  wire::encode(message, wire::script_command::PAYLOAD_MASS, mass);
+  wire::encode(message, wire::script_command::PAYLOAD_COG, *cog);
+}
 
-  val = htobe32(static_cast<int32_t>(round(mass * MULT_JOINTSTATE)));
-  b_pos += append(b_pos, val);
+void encodeToolVoltage(int32_t* message, const ToolVoltage voltage)
+{
+  wire::encode(message, wire::script_command::TOOL_VOLTAGE_VOLTAGE, static_cast<double>(toUnderlying(voltage)));
+}
 
-  for (auto const& center_of_mass : *cog)
-  {
-    val = htobe32(static_cast<int32_t>(round(center_of_mass * MULT_JOINTSTATE)));
-    b_pos += append(b_pos, val);
-  }
+void encodeForceMode(int32_t* message, const vector6d_t* task_frame, const vector6uint32_t* selection_vector,
+                     const vector6d_t* wrench, const unsigned int type, const vector6d_t* limits,
+                     double damping_factor, double gain_scaling_factor)
+{
+  wire::encode(message, wire::script_command::FORCE_MODE_TASK_FRAME, *task_frame);
+  wire::encode(message, wire::script_command::FORCE_MODE_SELECTION, *selection_vector);
+  wire::encode(message, wire::script_command::FORCE_MODE_WRENCH, *wrench);
+  wire::encode(message, wire::script_command::FORCE_MODE_TYPE, static_cast<double>(type));
+  wire::encode(message, wire::script_command::FORCE_MODE_LIMITS, *limits);
+  wire::encode(message, wire::script_command::FORCE_MODE_DAMPING, damping_factor);
+  wire::encode(message, wire::script_command::FORCE_MODE_GAIN_SCALING, gain_scaling_factor);
+}
+}  // namespace
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
+int32_t* ScriptCommandInterface::Batch::add(const int32_t command)
+{
+  if (commands_.size() >= MAX_COMMANDS)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    throw UrException("A script command batch holds at most " + std::to_string(MAX_COMMANDS) + " commands.");
   }
-  size_t written;
+  commands_.emplace_back();
+  commands_.back().fill(0);
+  wire::encode(commands_.back().data(), wire::script_command::COMMAND, command);
+  return commands_.back().data();
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+void ScriptCommandInterface::Batch::zeroFTSensor()
+{
+  add(toUnderlying(ScriptCommand::ZERO_FTSENSOR));
 }
 
-bool ScriptCommandInterface::setToolVoltage(const ToolVoltage voltage)
+void ScriptCommandInterface::Batch::setPayload(const double mass, const vector3d_t* cog)
 {
-  const int message_length = 2;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
-  int32_t val = htobe32(toUnderlying(ScriptCommand::SET_TOOL_VOLTAGE));
-  b_pos += append(b_pos, val);
+  encodePayload(add(toUnderlying(ScriptCommand::SET_PAYLOAD)), mass, cog);
+}
 
-  val = htobe32(toUnderlying(voltage) * MULT_JOINTSTATE);
-  b_pos += append(b_pos, val);
+void ScriptCommandInterface::Batch::setToolVoltage(const ToolVoltage voltage)
+{
+  encodeToolVoltage(add(toUnderlying(ScriptCommand::SET_TOOL_VOLTAGE)), voltage);
+}
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
-  {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
-  }
-  size_t written;
+void ScriptCommandInterface::Batch::startForceMode(const vector6d_t* task_frame,
+                                                   const vector6uint32_t* selection_vector, const vector6d_t* wrench,
+                                                   const unsigned int type, const vector6d_t* limits,
+                                                   double damping_factor, double gain_scaling_factor)
+{
+  encodeForceMode(add(toUnderlying(ScriptCommand::START_FORCE_MODE)), task_frame, selection_vector, wrench, type,
+                  limits, damping_factor, gain_scaling_factor);
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+void ScriptCommandInterface::Batch::endForceMode()
+{
+  add(toUnderlying(ScriptCommand::END_FORCE_MODE));
 }
 
-bool ScriptCommandInterface::startForceMode(const vector6d_t* task_frame, const vector6uint32_t* selection_vector,
-                                            const vector6d_t* wrench, const unsigned int type, const vector6d_t* limits,
-                                            double damping_factor, double gain_scaling_factor)
+void ScriptCommandInterface::Batch::startToolContact()
 {
-  const int message_length = 28;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
+  add(toUnderlying(ScriptCommand::START_TOOL_CONTACT));
+}
 
-  int32_t val = htobe32(toUnderlying(ScriptCommand::START_FORCE_MODE));
-  b_pos += append(b_pos, val);
+void ScriptCommandInterface::Batch::endToolContact()
+{
+  add(toUnderlying(ScriptCommand::END_TOOL_CONTACT));
+}
 
-  for (auto const& frame : *task_frame)
-  {
-    val = htobe32(static_cast<int32_t>(round(frame * MULT_JOINTSTATE)));
-    b_pos += append(b_pos, val);
-  }
+ScriptCommandInterface::ScriptCommandInterface(uint32_t port)
+  : ReverseInterface(port, [](bool foo) { return foo; })
+  , next_sequence_number_(1)
+{
+  client_connected_ = false;
+  // The robot sends 4 byte status messages. The server is started by the base class already, so
+  // it has to be stopped for configuring the framing.
+  server_.shutdown();
+  server_.setMessageFraming(comm::MessageFraming::FIXED_SIZE, sizeof(int32_t));
+  server_.start();
+}
 
-  for (auto const& selection : *selection_vector)
-  {
-    val = htobe32(static_cast<int32_t>(selection * MULT_JOINTSTATE));
-    b_pos += append(b_pos, val);
-  }
+bool ScriptCommandInterface::zeroFTSensor()
+{
+  return isWritten(zeroFTSensorAsync());
+}
 
-  for (auto const& force_torque : *wrench)
-  {
-    val = htobe32(static_cast<int32_t>(round(force_torque * MULT_JOINTSTATE)));
-    b_pos += append(b_pos, val);
-  }
+comm::NotifyingFuture<bool> ScriptCommandInterface::zeroFTSensorAsync()
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::ZERO_FTSENSOR));
+  return sendCommand(message);
+}
 
-  val = htobe32(static_cast<int32_t>(type * MULT_JOINTSTATE));
-  b_pos += append(b_pos, val);
+bool ScriptCommandInterface::setPayload(const double mass, const vector3d_t* cog)
+{
+  return isWritten(setPayloadAsync(mass, cog));
+}
 
-  for (auto const& lim : *limits)
-  {
-    val = htobe32(static_cast<int32_t>(round(lim * MULT_JOINTSTATE)));
-    b_pos += append(b_pos, val);
-  }
+comm::NotifyingFuture<bool> ScriptCommandInterface::setPayloadAsync(const double mass, const vector3d_t* cog)
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::SET_PAYLOAD));
+  encodePayload(message, mass, cog);
+  return sendCommand(message);
+}
 
-  val = htobe32(static_cast<int32_t>(round(damping_factor * MULT_JOINTSTATE)));
-  b_pos += append(b_pos, val);
+bool ScriptCommandInterface::setToolVoltage(const ToolVoltage voltage)
+{
+  return isWritten(setToolVoltageAsync(voltage));
+}
 
-  val = htobe32(static_cast<int32_t>(round(gain_scaling_factor * MULT_JOINTSTATE)));
-  b_pos += append(b_pos, val);
+comm::NotifyingFuture<bool> ScriptCommandInterface::setToolVoltageAsync(const ToolVoltage voltage)
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::SET_TOOL_VOLTAGE));
+  encodeToolVoltage(message, voltage);
+  return sendCommand(message);
+}
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
-  {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
-  }
-  size_t written;
+bool ScriptCommandInterface::startForceMode(const vector6d_t* task_frame, const vector6uint32_t* selection_vector,
+                                            const vector6d_t* wrench, const unsigned int type, const vector6d_t* limits,
+                                            double damping_factor, double gain_scaling_factor)
+{
+  return isWritten(
+      startForceModeAsync(task_frame, selection_vector, wrench, type, limits, damping_factor, gain_scaling_factor));
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+comm::NotifyingFuture<bool>
+ScriptCommandInterface::startForceModeAsync(const vector6d_t* task_frame, const vector6uint32_t* selection_vector,
+                                            const vector6d_t* wrench, const unsigned int type,
+                                            const vector6d_t* limits, double damping_factor,
+                                            double gain_scaling_factor)
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::START_FORCE_MODE));
+  encodeForceMode(message, task_frame, selection_vector, wrench, type, limits, damping_factor, gain_scaling_factor);
+  return sendCommand(message);
 }
 
 bool ScriptCommandInterface::endForceMode()
 {
-  const int message_length = 1;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
+  return isWritten(endForceModeAsync());
+}
 
-  int32_t val = htobe32(toUnderlying(ScriptCommand::END_FORCE_MODE));
-  b_pos += append(b_pos, val);
+comm::NotifyingFuture<bool> ScriptCommandInterface::endForceModeAsync()
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::END_FORCE_MODE));
+  return sendCommand(message);
+}
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
-  {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
-  }
-  size_t written;
+bool ScriptCommandInterface::startToolContact()
+{
+  return isWritten(startToolContactAsync());
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+comm::NotifyingFuture<bool> ScriptCommandInterface::startToolContactAsync()
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::START_TOOL_CONTACT));
+  return sendCommand(message);
 }
 
-bool ScriptCommandInterface::startToolContact()
+bool ScriptCommandInterface::endToolContact()
 {
-  const int message_length = 1;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
+  return isWritten(endToolContactAsync());
+}
 
-  int32_t val = htobe32(toUnderlying(ScriptCommand::START_TOOL_CONTACT));
-  b_pos += append(b_pos, val);
+comm::NotifyingFuture<bool> ScriptCommandInterface::endToolContactAsync()
+{
+  int32_t message[MAX_MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::script_command::COMMAND, toUnderlying(ScriptCommand::END_TOOL_CONTACT));
+  return sendCommand(message);
+}
+
+bool ScriptCommandInterface::sendBatch(const Batch& batch)
+{
+  return isWritten(sendBatchAsync(batch));
+}
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
+comm::NotifyingFuture<bool> ScriptCommandInterface::sendBatchAsync(const Batch& batch)
+{
+  if (batch.empty())
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    comm::NotifyingPromise<bool> done;
+    done.setValue(true);
+    return done.getFuture();
   }
-  size_t written;
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+  // The batch's header is followed by its commands, the whole batch is acknowledged at once
+  std::vector<int32_t> messages(MAX_MESSAGE_LENGTH * (batch.size() + 1), 0);
+  wire::encode(messages.data(), wire::script_command::COMMAND, toUnderlying(ScriptCommand::BATCH));
+  wire::encode(messages.data(), wire::script_command::BATCH_COUNT, static_cast<int32_t>(batch.size()));
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    std::copy(batch.commands_[i].begin(), batch.commands_[i].end(), messages.begin() + MAX_MESSAGE_LENGTH * (i + 1));
+  }
+  return sendMessages(messages.data(), messages.size());
 }
 
-bool ScriptCommandInterface::endToolContact()
+comm::NotifyingFuture<bool> ScriptCommandInterface::sendCommand(int32_t* message)
 {
-  const int message_length = 1;
-  uint8_t buffer[sizeof(int32_t) * MAX_MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
+  return sendMessages(message, MAX_MESSAGE_LENGTH);
+}
 
-  int32_t val = htobe32(toUnderlying(ScriptCommand::END_TOOL_CONTACT));
-  b_pos += append(b_pos, val);
+comm::NotifyingFuture<bool> ScriptCommandInterface::sendMessages(int32_t* messages, const size_t length)
+{
+  // Holding the lock while writing keeps the pending commands in the order they are written
+  std::lock_guard<std::mutex> lock(acknowledgement_mutex_);
+  const int32_t sequence_number = next_sequence_number_;
+  next_sequence_number_ =
+      next_sequence_number_ == std::numeric_limits<int32_t>::max() ? 1 : next_sequence_number_ + 1;
+  wire::encode(messages, wire::script_command::SEQUENCE, sequence_number);
+  wire::toBigEndian(messages, length);
+
+  // Registered before writing, as the acknowledgement may arrive before the write returns
+  pending_acknowledgements_.emplace_back(sequence_number, comm::NotifyingPromise<bool>());
+  comm::NotifyingFuture<bool> acknowledgement = pending_acknowledgements_.back().second.getFuture();
+  size_t written;
+  if (!server_.write(client_fd_, reinterpret_cast<const uint8_t*>(messages), sizeof(int32_t) * length, written))
+  {
+    pending_acknowledgements_.back().second.setValue(false);
+    pending_acknowledgements_.pop_back();
+  }
+  return acknowledgement;
+}
 
-  // writing zeros to allow usage with other script commands
-  for (size_t i = message_length; i < MAX_MESSAGE_LENGTH; i++)
+void ScriptCommandInterface::setNextSequenceNumber(const int32_t sequence_number)
+{
+  if (sequence_number <= 0)
   {
-    val = htobe32(0);
-    b_pos += append(b_pos, val);
+    throw InvalidRange("Sequence numbers have to be positive");
   }
-  size_t written;
+  std::lock_guard<std::mutex> lock(acknowledgement_mutex_);
+  next_sequence_number_ = sequence_number;
+}
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+void ScriptCommandInterface::failPendingAcknowledgements()
+{
+  std::lock_guard<std::mutex> lock(acknowledgement_mutex_);
+  for (auto& pending : pending_acknowledgements_)
+  {
+    pending.second.setValue(false);
+  }
+  pending_acknowledgements_.clear();
 }
 
 bool ScriptCommandInterface::clientConnected()
@@ -247,6 +336,7 @@ void ScriptCommandInterface::disconnectionCallback(const int filedescriptor)
   URCL_LOG_DEBUG("Connection to ScriptCommandInterface dropped.", filedescriptor);
   client_fd_ = -1;
   client_connected_ = false;
+  failPendingAcknowledgements();
 }
 
 void ScriptCommandInterface::messageCallback(const int filedescriptor, char* buffer, int nbytesrecv)
@@ -256,6 +346,21 @@ void ScriptCommandInterface::messageCallback(const int filedescriptor, char* buf
     int32_t* status = reinterpret_cast<int*>(buffer);
     URCL_LOG_DEBUG("Received message %d on Script command interface", be32toh(*status));
 
+    // Negative values acknowledge the command with the negated sequence number
+    if (static_cast<int32_t>(be32toh(*status)) < 0)
+    {
+      const int32_t sequence_number = -static_cast<int32_t>(be32toh(*status));
+      std::lock_guard<std::mutex> lock(acknowledgement_mutex_);
+      // Commands are executed in order, so earlier ones not acknowledged have been dropped
+      while (!pending_acknowledgements_.empty() &&
+             precedesOrEquals(pending_acknowledgements_.front().first, sequence_number))
+      {
+        pending_acknowledgements_.front().second.setValue(pending_acknowledgements_.front().first == sequence_number);
+        pending_acknowledgements_.pop_front();
+      }
+      return;
+    }
+
     if (handle_tool_contact_result_)
     {
       handle_tool_contact_result_(static_cast<ToolContactResult>(be32toh(*status)));
@@ -41,6 +41,12 @@ ScriptSender::ScriptSender(uint32_t port, const std::string& program)
   server_.start();
 }
 
+void ScriptSender::setProgram(const std::string& program)
+{
+  std::lock_guard<std::mutex> lk(program_mutex_);
+  program_ = program;
+}
+
 void ScriptSender::connectionCallback(const int filedescriptor)
 {
   URCL_LOG_DEBUG("New client connected at FD %d.", filedescriptor);
@@ -62,6 +68,7 @@ void ScriptSender::messageCallback(const int filedescriptor, char* buffer)
 
 void ScriptSender::sendProgram(const int filedescriptor)
 {
+  std::lock_guard<std::mutex> lk(program_mutex_);
   size_t len = program_.size();
   const uint8_t* data = reinterpret_cast<const uint8_t*>(program_.c_str());
   size_t written;
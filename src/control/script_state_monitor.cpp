@@ -0,0 +1,68 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/script_state_monitor.h"
+
+namespace urcl
+{
+namespace control
+{
+ScriptStateMonitor::ScriptStateMonitor() : state_(0)
+{
+}
+
+void ScriptStateMonitor::update(const int32_t state)
+{
+  const int32_t previous = state_.exchange(state);
+  const int32_t changed = previous ^ state;
+
+  if ((changed & FREEDRIVE_ACTIVE) && freedrive_state_callback_)
+  {
+    freedrive_state_callback_((state & FREEDRIVE_ACTIVE) != 0);
+  }
+
+  if (!tool_contact_result_callback_)
+  {
+    return;
+  }
+  // The detection flag is kept until tool contact detection is started again, so a contact is
+  // still seen if detection is ended within the same RTDE cycle.
+  if ((changed & TOOL_CONTACT_DETECTED) && (state & TOOL_CONTACT_DETECTED))
+  {
+    tool_contact_result_callback_(ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS);
+  }
+  else if ((changed & TOOL_CONTACT_RUNNING) && !(state & TOOL_CONTACT_RUNNING) && !(state & TOOL_CONTACT_DETECTED))
+  {
+    tool_contact_result_callback_(ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_CANCELED);
+  }
+}
+
+}  // namespace control
+}  // namespace urcl
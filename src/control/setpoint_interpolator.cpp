@@ -0,0 +1,299 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/setpoint_interpolator.h"
+
+#include <algorithm>
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+double toSeconds(const std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+}  // namespace
+
+constexpr std::chrono::milliseconds SetpointInterpolator::DEFAULT_MAX_EXTRAPOLATION;
+
+SetpointInterpolator::SetpointInterpolator(OutputFunction output, const std::chrono::microseconds delay)
+  : output_(output)
+  , delay_(delay)
+  , max_extrapolation_(DEFAULT_MAX_EXTRAPOLATION)
+  , time_scaling_(false)
+  , trajectory_time_valid_(false)
+  , running_(false)
+  , num_extrapolated_cycles_(0)
+  , cycle_pending_(false)
+  , cycle_time_scale_(1.0)
+{
+}
+
+SetpointInterpolator::~SetpointInterpolator()
+{
+  stop();
+}
+
+bool SetpointInterpolator::addSetpoint(const vector6d_t& setpoint, const std::chrono::steady_clock::time_point time)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (!setpoints_.empty())
+  {
+    if (time < setpoints_.back().time)
+    {
+      return false;
+    }
+    if (time == setpoints_.back().time)
+    {
+      setpoints_.back().value = setpoint;
+      return true;
+    }
+  }
+  setpoints_.push_back({ setpoint, time });
+  if (setpoints_.size() > MAX_SETPOINTS)
+  {
+    setpoints_.pop_front();
+  }
+  return true;
+}
+
+void SetpointInterpolator::clear()
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  setpoints_.clear();
+  trajectory_time_valid_ = false;
+}
+
+bool SetpointInterpolator::sample(const std::chrono::steady_clock::time_point time, vector6d_t& setpoint) const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  bool extrapolated;
+  return sampleLocked(time, setpoint, extrapolated);
+}
+
+bool SetpointInterpolator::sampleLocked(const std::chrono::steady_clock::time_point time, vector6d_t& setpoint,
+                                        bool& extrapolated) const
+{
+  extrapolated = false;
+  if (setpoints_.empty())
+  {
+    return false;
+  }
+  if (time <= setpoints_.front().time || setpoints_.size() == 1)
+  {
+    setpoint = time <= setpoints_.front().time ? setpoints_.front().value : setpoints_.back().value;
+    extrapolated = time > setpoints_.back().time;
+    return true;
+  }
+
+  // Catmull-Rom tangent at a setpoint, one-sided at the ends
+  auto tangent = [this](const size_t i, const size_t joint) {
+    const size_t prev = i > 0 ? i - 1 : i;
+    const size_t next = i + 1 < setpoints_.size() ? i + 1 : i;
+    return (setpoints_[next].value[joint] - setpoints_[prev].value[joint]) /
+           toSeconds(setpoints_[next].time - setpoints_[prev].time);
+  };
+
+  const size_t last = setpoints_.size() - 1;
+  if (time >= setpoints_[last].time)
+  {
+    extrapolated = time > setpoints_[last].time;
+    const double dt = std::min(toSeconds(time - setpoints_[last].time), toSeconds(max_extrapolation_));
+    for (size_t joint = 0; joint < setpoint.size(); ++joint)
+    {
+      setpoint[joint] = setpoints_[last].value[joint] + tangent(last, joint) * dt;
+    }
+    return true;
+  }
+
+  const auto next = std::upper_bound(setpoints_.begin(), setpoints_.end(), time,
+                                     [](const std::chrono::steady_clock::time_point& t, const Setpoint& point) {
+                                       return t < point.time;
+                                     });
+  const size_t i = static_cast<size_t>(next - setpoints_.begin()) - 1;
+  const double h = toSeconds(setpoints_[i + 1].time - setpoints_[i].time);
+  const double s = toSeconds(time - setpoints_[i].time) / h;
+  const double s2 = s * s;
+  const double s3 = s2 * s;
+  const double h00 = 2 * s3 - 3 * s2 + 1;
+  const double h10 = s3 - 2 * s2 + s;
+  const double h01 = -2 * s3 + 3 * s2;
+  const double h11 = s3 - s2;
+  for (size_t joint = 0; joint < setpoint.size(); ++joint)
+  {
+    setpoint[joint] = h00 * setpoints_[i].value[joint] + h10 * h * tangent(i, joint) +
+                      h01 * setpoints_[i + 1].value[joint] + h11 * h * tangent(i + 1, joint);
+  }
+  return true;
+}
+
+void SetpointInterpolator::setDelay(const std::chrono::microseconds delay)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  delay_ = delay;
+}
+
+std::chrono::microseconds SetpointInterpolator::getDelay() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return delay_;
+}
+
+void SetpointInterpolator::setMaxExtrapolation(const std::chrono::microseconds max_extrapolation)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  max_extrapolation_ = max_extrapolation;
+}
+
+void SetpointInterpolator::setTimeScaling(const bool enabled)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  time_scaling_ = enabled;
+  trajectory_time_valid_ = false;
+}
+
+bool SetpointInterpolator::isTimeScalingEnabled() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return time_scaling_;
+}
+
+std::chrono::steady_clock::time_point SetpointInterpolator::getTrajectoryTime() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return trajectory_time_;
+}
+
+void SetpointInterpolator::start()
+{
+  std::lock_guard<std::mutex> lk(run_mutex_);
+  if (running_)
+  {
+    return;
+  }
+  running_ = true;
+  cycle_pending_ = false;
+  {
+    std::lock_guard<std::mutex> setpoints_lk(mutex_);
+    trajectory_time_valid_ = false;
+  }
+  thread_ = std::thread(&SetpointInterpolator::run, this);
+  applyThreadConfig(thread_.native_handle(), thread_config_);
+}
+
+void SetpointInterpolator::stop()
+{
+  {
+    std::lock_guard<std::mutex> lk(run_mutex_);
+    running_ = false;
+    run_cv_.notify_all();
+  }
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+}
+
+void SetpointInterpolator::notifyCycle(const std::chrono::steady_clock::time_point cycle_time, const double time_scale)
+{
+  {
+    std::lock_guard<std::mutex> lk(run_mutex_);
+    cycle_pending_ = true;
+    cycle_time_ = cycle_time;
+    cycle_time_scale_ = time_scale;
+  }
+  run_cv_.notify_one();
+}
+
+void SetpointInterpolator::setThreadConfig(const ThreadConfig& config)
+{
+  std::lock_guard<std::mutex> lk(run_mutex_);
+  thread_config_ = config;
+  if (running_)
+  {
+    applyThreadConfig(thread_.native_handle(), thread_config_);
+  }
+}
+
+void SetpointInterpolator::run()
+{
+  std::unique_lock<std::mutex> lk(run_mutex_);
+  while (running_)
+  {
+    run_cv_.wait(lk, [this]() { return cycle_pending_ || !running_; });
+    if (!running_)
+    {
+      break;
+    }
+    cycle_pending_ = false;
+    const std::chrono::steady_clock::time_point cycle_time = cycle_time_;
+    const double time_scale = std::max(cycle_time_scale_, 0.0);
+    lk.unlock();
+
+    vector6d_t setpoint;
+    bool extrapolated = false;
+    bool valid;
+    {
+      std::lock_guard<std::mutex> setpoints_lk(mutex_);
+      if (!time_scaling_)
+      {
+        trajectory_time_ = cycle_time - delay_;
+      }
+      else if (!trajectory_time_valid_)
+      {
+        trajectory_time_ = cycle_time - delay_;
+        trajectory_time_valid_ = true;
+      }
+      else
+      {
+        // A cycle replaced by a newer one is accounted for with the newer one's time scale
+        trajectory_time_ += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            (cycle_time - last_cycle_time_) * time_scale);
+      }
+      last_cycle_time_ = cycle_time;
+      valid = sampleLocked(trajectory_time_, setpoint, extrapolated);
+    }
+    if (valid)
+    {
+      if (extrapolated)
+      {
+        ++num_extrapolated_cycles_;
+      }
+      output_(setpoint);
+    }
+    lk.lock();
+  }
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -0,0 +1,99 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include "ur_client_library/control/setpoint_latency_monitor.h"
+
+namespace urcl
+{
+namespace control
+{
+SetpointLatencyMonitor::SetpointLatencyMonitor(const int echo_register)
+  : echo_field_("output_int_register_" + std::to_string(echo_register))
+  , last_echo_(0)
+  , last_latency_us_(0)
+  , unmatched_echoes_(0)
+  , latency_metric_(getMetricsRegistry().getHistogram("urcl_setpoint_round_trip_seconds",
+                                                      "Time from writing a setpoint to the reverse interface until "
+                                                      "the robot's echo of it has been received",
+                                                      Histogram::defaultDurationBounds(),
+                                                      { { "field", echo_field_ } }))
+{
+}
+
+void SetpointLatencyMonitor::recordSent(const int32_t sequence, const std::chrono::steady_clock::time_point send_time)
+{
+  SentSetpoint& slot = sent_[static_cast<size_t>(sequence) % HISTORY_SIZE];
+  // A reader seeing the same sequence number before and after reading the time has a consistent slot
+  slot.sequence.store(0, std::memory_order_release);
+  slot.send_time_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(send_time.time_since_epoch()).count(),
+                          std::memory_order_release);
+  slot.sequence.store(sequence, std::memory_order_release);
+}
+
+void SetpointLatencyMonitor::onDataPackage(const rtde_interface::DataPackage& package)
+{
+  // The handle is resolved once per recipe, as the output recipe can be switched
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    recipe_ = package.getCompiledRecipe();
+    size_t index;
+    echo_handle_ = recipe_ != nullptr && recipe_->findIndex(echo_field_, index) ?
+                       recipe_->getFieldHandle<int32_t>(echo_field_) :
+                       rtde_interface::FieldHandle<int32_t>();
+  }
+  int32_t echo;
+  if (!echo_handle_.isValid() || !package.getData(echo_handle_, echo) || echo <= 0 || echo == last_echo_)
+  {
+    return;
+  }
+  last_echo_ = echo;
+
+  const SentSetpoint& slot = sent_[static_cast<size_t>(echo) % HISTORY_SIZE];
+  const int32_t sequence = slot.sequence.load(std::memory_order_acquire);
+  const int64_t send_time_ns = slot.send_time_ns.load(std::memory_order_acquire);
+  if (sequence != echo || slot.sequence.load(std::memory_order_acquire) != echo)
+  {
+    unmatched_echoes_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const std::chrono::steady_clock::time_point receive_time =
+      package.getTimestamps().receive == std::chrono::steady_clock::time_point() ? std::chrono::steady_clock::now() :
+                                                                                  package.getTimestamps().receive;
+  const auto latency = receive_time - std::chrono::steady_clock::time_point(std::chrono::nanoseconds(send_time_ns));
+  latencies_.record(latency);
+  latency_metric_.observe(latency);
+  last_latency_us_.store(std::chrono::duration_cast<std::chrono::microseconds>(latency).count(),
+                         std::memory_order_relaxed);
+}
+
+}  // namespace control
+}  // namespace urcl
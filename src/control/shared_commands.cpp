@@ -0,0 +1,420 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/shared_commands.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+constexpr uint32_t MAGIC = 0x55524343;  // "URCC"
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t NAME_SIZE = 32;
+// Number of times a read is retried if the client overwrites the mailbox meanwhile
+constexpr size_t MAX_READ_ATTEMPTS = 16;
+// Time between checking whether the processes owning the slots are still running
+constexpr std::chrono::milliseconds LIVENESS_PERIOD(100);
+
+enum SlotStatus : uint32_t
+{
+  SLOT_FREE = 0,
+  SLOT_CLAIMING = 1,
+  SLOT_CLAIMED = 2
+};
+
+// Both sides of the segment run on the same host, so all values are stored in host byte order.
+struct SegmentHeader
+{
+  // Set last when creating the segment, so clients never see a partially initialized segment
+  std::atomic<uint32_t> magic;
+  uint16_t format_version;
+  uint32_t slot_count;
+  std::atomic<uint32_t> active;
+};
+
+struct alignas(CACHE_LINE_SIZE) ClientSlot
+{
+  // Written by the client claiming the slot. The server frees slots of processes that exited.
+  std::atomic<uint32_t> state;
+  // Incremented with every claim, so the server notices a slot being freed and claimed again in between two polls
+  std::atomic<uint32_t> generation;
+  int32_t pid;
+  int32_t priority;
+  char name[NAME_SIZE];
+  std::atomic<uint32_t> requested;
+  std::atomic<uint64_t> stops;
+  // Written by the server
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> granted;
+  std::atomic<uint64_t> rejected;
+  // Mailbox of the latest joint command, odd while being written. The n-th command leaves it at 2 * n.
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sequence;
+  int32_t control_mode;
+  uint32_t receive_timeout_ms;
+  double values[6];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The shared commands require lock-free 64 bit atomics.");
+
+size_t slotsOffset()
+{
+  return (sizeof(SegmentHeader) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+ClientSlot* getSlot(uint8_t* segment, const size_t index)
+{
+  return reinterpret_cast<ClientSlot*>(segment + slotsOffset() + index * sizeof(ClientSlot));
+}
+}  // namespace
+
+SharedCommandServer::SharedCommandServer(CommandArbiter& arbiter, const std::string& name, const size_t slot_count,
+                                         const std::chrono::microseconds poll_period)
+  : arbiter_(arbiter)
+  , name_(name)
+  , slot_count_(slot_count)
+  , poll_period_(poll_period)
+  , segment_size_(slotsOffset() + slot_count * sizeof(ClientSlot))
+  , segment_(nullptr)
+  , slots_(slot_count)
+  , num_connected_(0)
+  , running_(false)
+{
+  if (slot_count_ == 0)
+  {
+    throw UrException("The number of slots of a shared command segment has to be greater than 0.");
+  }
+
+  // Replace segments left over by servers that didn't shut down cleanly
+  ::shm_unlink(name_.c_str());
+  // Clients write into the segment, so it is only accessible by the same user
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    throw UrException("Could not create shared memory segment '" + name_ + "': " + std::strerror(errno));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(segment_size_)) != 0)
+  {
+    const int error = errno;
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    throw UrException("Could not resize shared memory segment '" + name_ + "': " + std::strerror(error));
+  }
+  void* data = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    ::shm_unlink(name_.c_str());
+    throw UrException("Could not map shared memory segment '" + name_ + "': " + std::strerror(error));
+  }
+  segment_ = static_cast<uint8_t*>(data);
+
+  SegmentHeader* header = new (segment_) SegmentHeader();
+  header->format_version = FORMAT_VERSION;
+  header->slot_count = static_cast<uint32_t>(slot_count_);
+  for (size_t i = 0; i < slot_count_; ++i)
+  {
+    new (getSlot(segment_, i)) ClientSlot();
+  }
+  header->active.store(1, std::memory_order_relaxed);
+  header->magic.store(MAGIC, std::memory_order_release);
+
+  running_ = true;
+  thread_ = std::thread(&SharedCommandServer::run, this);
+}
+
+SharedCommandServer::~SharedCommandServer()
+{
+  reinterpret_cast<SegmentHeader*>(segment_)->active.store(0, std::memory_order_release);
+  running_ = false;
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+  for (size_t i = 0; i < slot_count_; ++i)
+  {
+    disconnect(i);
+  }
+  ::munmap(segment_, segment_size_);
+  ::shm_unlink(name_.c_str());
+}
+
+void SharedCommandServer::run()
+{
+  auto next_liveness_check = std::chrono::steady_clock::now();
+  while (running_)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const bool check_liveness = now >= next_liveness_check;
+    if (check_liveness)
+    {
+      next_liveness_check = now + LIVENESS_PERIOD;
+    }
+    for (size_t i = 0; i < slot_count_; ++i)
+    {
+      poll(i, check_liveness);
+    }
+    std::this_thread::sleep_for(poll_period_);
+  }
+}
+
+void SharedCommandServer::poll(const size_t index, const bool check_liveness)
+{
+  ClientSlot* slot = getSlot(segment_, index);
+  SlotState& state = slots_[index];
+
+  uint32_t slot_state = slot->state.load(std::memory_order_acquire);
+  if (slot_state == SLOT_CLAIMED && check_liveness && ::kill(slot->pid, 0) != 0 && errno == ESRCH)
+  {
+    URCL_LOG_WARN("Process %d exited without releasing its shared command slot.", slot->pid);
+    uint32_t expected = SLOT_CLAIMED;
+    slot->state.compare_exchange_strong(expected, SLOT_FREE, std::memory_order_acq_rel);
+    slot_state = expected == SLOT_CLAIMED ? SLOT_FREE : expected;
+  }
+  const uint32_t generation = slot->generation.load(std::memory_order_acquire);
+  if (state.client != nullptr && (slot_state != SLOT_CLAIMED || generation != state.generation))
+  {
+    disconnect(index);
+  }
+  if (slot_state != SLOT_CLAIMED)
+  {
+    return;
+  }
+
+  if (state.client == nullptr)
+  {
+    state.client = arbiter_.addClient(std::string(slot->name, strnlen(slot->name, NAME_SIZE)), slot->priority);
+    state.generation = generation;
+    state.requested = false;
+    state.handled_sequence = slot->sequence.load(std::memory_order_acquire);
+    state.handled_stops = slot->stops.load(std::memory_order_acquire);
+    ++num_connected_;
+  }
+
+  const bool requested = slot->requested.load(std::memory_order_acquire) != 0;
+  if (requested != state.requested)
+  {
+    state.requested = requested;
+    if (requested)
+    {
+      state.client->requestControl();
+    }
+    else
+    {
+      state.client->releaseControl();
+    }
+  }
+
+  const uint64_t stops = slot->stops.load(std::memory_order_acquire);
+  if (stops != state.handled_stops)
+  {
+    state.handled_stops = stops;
+    if (!state.client->stopMotion())
+    {
+      slot->rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  for (size_t attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+  {
+    const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence == state.handled_sequence || sequence % 2 != 0)
+    {
+      break;
+    }
+    const comm::ControlMode control_mode = static_cast<comm::ControlMode>(slot->control_mode);
+    const uint32_t receive_timeout_ms = slot->receive_timeout_ms;
+    vector6d_t values;
+    std::memcpy(values.data(), slot->values, sizeof(slot->values));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != sequence)
+    {
+      continue;
+    }
+    state.handled_sequence = sequence;
+    if (!state.client->writeJointCommand(values, control_mode, RobotReceiveTimeout::millisec(receive_timeout_ms)))
+    {
+      slot->rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    break;
+  }
+
+  slot->granted.store(state.client->hasControl() ? 1 : 0, std::memory_order_release);
+}
+
+void SharedCommandServer::disconnect(const size_t index)
+{
+  SlotState& state = slots_[index];
+  if (state.client == nullptr)
+  {
+    return;
+  }
+  state.client.reset();
+  getSlot(segment_, index)->granted.store(0, std::memory_order_release);
+  --num_connected_;
+}
+
+SharedCommandClient::SharedCommandClient(const std::string& segment_name, const std::string& name,
+                                         const int32_t priority)
+  : segment_size_(0), segment_(nullptr), slot_(nullptr), sequence_(0), stops_(0)
+{
+  const int fd = ::shm_open(segment_name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+  {
+    throw UrException("Could not open shared memory segment '" + segment_name + "': " + std::strerror(errno));
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader))
+  {
+    ::close(fd);
+    throw UrException("Shared memory segment '" + segment_name + "' is not a shared command segment.");
+  }
+  segment_size_ = static_cast<size_t>(info.st_size);
+  void* data = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw UrException("Could not map shared memory segment '" + segment_name + "': " + std::strerror(error));
+  }
+  segment_ = static_cast<uint8_t*>(data);
+
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(segment_);
+  if (header->magic.load(std::memory_order_acquire) != MAGIC || header->format_version != FORMAT_VERSION ||
+      slotsOffset() + header->slot_count * sizeof(ClientSlot) > segment_size_)
+  {
+    ::munmap(segment_, segment_size_);
+    throw UrException("Shared memory segment '" + segment_name + "' is not a shared command segment.");
+  }
+
+  for (size_t i = 0; i < header->slot_count; ++i)
+  {
+    ClientSlot* slot = getSlot(segment_, i);
+    uint32_t expected = SLOT_FREE;
+    if (!slot->state.compare_exchange_strong(expected, SLOT_CLAIMING, std::memory_order_acq_rel))
+    {
+      continue;
+    }
+    slot->pid = static_cast<int32_t>(::getpid());
+    slot->priority = priority;
+    std::memset(slot->name, 0, NAME_SIZE);
+    std::strncpy(slot->name, name.c_str(), NAME_SIZE - 1);
+    slot->requested.store(0, std::memory_order_relaxed);
+    // Continue the counters of the previous client, so the server doesn't take them for new commands
+    sequence_ = slot->sequence.load(std::memory_order_relaxed);
+    stops_ = slot->stops.load(std::memory_order_relaxed);
+    slot->rejected.store(0, std::memory_order_relaxed);
+    slot->generation.fetch_add(1, std::memory_order_relaxed);
+    slot->state.store(SLOT_CLAIMED, std::memory_order_release);
+    slot_ = reinterpret_cast<uint8_t*>(slot);
+    return;
+  }
+  ::munmap(segment_, segment_size_);
+  throw UrException("Shared memory segment '" + segment_name + "' has no free client slot.");
+}
+
+SharedCommandClient::~SharedCommandClient()
+{
+  ClientSlot* slot = reinterpret_cast<ClientSlot*>(slot_);
+  slot->requested.store(0, std::memory_order_release);
+  slot->state.store(SLOT_FREE, std::memory_order_release);
+  ::munmap(segment_, segment_size_);
+}
+
+void SharedCommandClient::requestControl()
+{
+  reinterpret_cast<ClientSlot*>(slot_)->requested.store(1, std::memory_order_release);
+}
+
+void SharedCommandClient::releaseControl()
+{
+  reinterpret_cast<ClientSlot*>(slot_)->requested.store(0, std::memory_order_release);
+}
+
+bool SharedCommandClient::hasControl() const
+{
+  return reinterpret_cast<const ClientSlot*>(slot_)->granted.load(std::memory_order_acquire) != 0;
+}
+
+bool SharedCommandClient::writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                                            const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (control_mode == comm::ControlMode::MODE_STOPPED || !isActive())
+  {
+    return false;
+  }
+  ClientSlot* slot = reinterpret_cast<ClientSlot*>(slot_);
+  slot->sequence.store(sequence_ + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->control_mode = static_cast<int32_t>(control_mode);
+  slot->receive_timeout_ms = static_cast<uint32_t>(robot_receive_timeout.timeout_.count());
+  std::memcpy(slot->values, values.data(), sizeof(slot->values));
+  sequence_ += 2;
+  slot->sequence.store(sequence_, std::memory_order_release);
+  return true;
+}
+
+bool SharedCommandClient::stopMotion()
+{
+  if (!isActive())
+  {
+    return false;
+  }
+  reinterpret_cast<ClientSlot*>(slot_)->stops.store(++stops_, std::memory_order_release);
+  return true;
+}
+
+uint64_t SharedCommandClient::getNumRejectedCommands() const
+{
+  return reinterpret_cast<const ClientSlot*>(slot_)->rejected.load(std::memory_order_relaxed);
+}
+
+bool SharedCommandClient::isActive() const
+{
+  return reinterpret_cast<const SegmentHeader*>(segment_)->active.load(std::memory_order_acquire) != 0;
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -0,0 +1,237 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/spline_planner.h"
+#include "ur_client_library/exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+// Peak velocity and acceleration of a quintic moving a distance of 1 in a time of 1 in between two
+// rests
+constexpr double QUINTIC_PEAK_VELOCITY = 1.875;
+constexpr double QUINTIC_PEAK_ACCELERATION = 5.7735;
+
+// Number of intervals each segment is sampled in for checking the limits
+constexpr size_t NUM_LIMIT_SAMPLES = 32;
+
+// Segments are sent to the robot with millisecond resolution
+double roundUpDuration(const double duration)
+{
+  const double resolution = TrajectoryPointInterface::MULT_TIME;
+  return std::ceil(duration * resolution - 1e-6) / resolution;
+}
+
+// Coefficients of the quintic from (q0, qd0, qdd0) to (q1, qd1, qdd1) within time, each scaled by
+// the respective power of time. Lower orders follow directly from the start state.
+void quinticCoefficients(const vector6d_t& q0, const vector6d_t& qd0, const vector6d_t& qdd0, const vector6d_t& q1,
+                         const vector6d_t& qd1, const vector6d_t& qdd1, const double time, vector6d_t& coefficients3,
+                         vector6d_t& coefficients4, vector6d_t& coefficients5)
+{
+  const double time2 = time * time;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    const double distance = q1[j] - q0[j];
+    const double v0 = qd0[j] * time;
+    const double v1 = qd1[j] * time;
+    const double a0 = qdd0[j] * time2;
+    const double a1 = qdd1[j] * time2;
+    coefficients3[j] = 10.0 * distance - 6.0 * v0 - 4.0 * v1 - 1.5 * a0 + 0.5 * a1;
+    coefficients4[j] = -15.0 * distance + 8.0 * v0 + 7.0 * v1 + 1.5 * a0 - a1;
+    coefficients5[j] = 6.0 * distance - 3.0 * v0 - 3.0 * v1 - 0.5 * a0 + 0.5 * a1;
+  }
+}
+
+const vector6d_t& accelerationsOrZero(const TrajectorySplinePoint& point)
+{
+  static const vector6d_t zero = { 0, 0, 0, 0, 0, 0 };
+  return point.accelerations ? *point.accelerations : zero;
+}
+}  // namespace
+
+constexpr double SplinePlanner::MIN_SEGMENT_DURATION;
+
+SplinePlanner::SplinePlanner(const JointLimits& limits) : limits_(limits)
+{
+  for (size_t j = 0; j < 6; ++j)
+  {
+    if (!(limits.max_velocity[j] > 0) || !(limits.max_acceleration[j] > 0))
+    {
+      throw UrException("Joint limits used for spline planning have to be positive.");
+    }
+  }
+}
+
+bool SplinePlanner::planTrajectory(const vector6d_t& start, const std::vector<vector6d_t>& waypoints,
+                                   std::vector<TrajectorySplinePoint>& points) const
+{
+  points.resize(waypoints.size());
+  std::vector<double> durations(waypoints.size());
+  const vector6d_t* previous = &start;
+  for (size_t i = 0; i < waypoints.size(); ++i)
+  {
+    double duration = MIN_SEGMENT_DURATION;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const double distance = std::abs(waypoints[i][j] - (*previous)[j]);
+      duration = std::max(duration, QUINTIC_PEAK_VELOCITY * distance / limits_.max_velocity[j]);
+      duration = std::max(duration, std::sqrt(QUINTIC_PEAK_ACCELERATION * distance / limits_.max_acceleration[j]));
+    }
+    durations[i] = roundUpDuration(duration);
+    points[i].positions = waypoints[i];
+    previous = &waypoints[i];
+  }
+
+  static const vector6d_t zero = { 0, 0, 0, 0, 0, 0 };
+  for (size_t iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+  {
+    setWaypointStates(start, durations, points);
+
+    bool within_limits = true;
+    const vector6d_t* start_q = &start;
+    const vector6d_t* start_qd = &zero;
+    const vector6d_t* start_qdd = &zero;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      const double ratio = limitRatio(*start_q, *start_qd, *start_qdd, points[i], durations[i]);
+      if (ratio > 1.0)
+      {
+        // Stretching a segment by a factor scales its velocities down by that factor and its
+        // accelerations by its square. As the states at the waypoints change with the durations,
+        // this is only an estimate and always stretches by a bit more.
+        durations[i] = roundUpDuration(durations[i] * std::max(ratio, 1.01));
+        within_limits = false;
+      }
+      start_q = &points[i].positions;
+      start_qd = &points[i].velocities;
+      start_qdd = &*points[i].accelerations;
+    }
+    if (within_limits)
+    {
+      return true;
+    }
+  }
+  setWaypointStates(start, durations, points);
+  return false;
+}
+
+void SplinePlanner::computeSegments(const vector6d_t& start, const std::vector<TrajectorySplinePoint>& points,
+                                    std::vector<TrajectorySplineSegment>& segments)
+{
+  static const vector6d_t zero = { 0, 0, 0, 0, 0, 0 };
+  segments.resize(points.size());
+  const vector6d_t* start_q = &start;
+  const vector6d_t* start_qd = &zero;
+  const vector6d_t* start_qdd = &zero;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const TrajectorySplinePoint& point = points[i];
+    TrajectorySplineSegment& segment = segments[i];
+    quinticCoefficients(*start_q, *start_qd, *start_qdd, point.positions, point.velocities,
+                        accelerationsOrZero(point), point.goal_time, segment.coefficients3, segment.coefficients4,
+                        segment.coefficients5);
+    segment.duration = point.goal_time;
+    start_q = &point.positions;
+    start_qd = &point.velocities;
+    start_qdd = &accelerationsOrZero(point);
+  }
+}
+
+void SplinePlanner::setWaypointStates(const vector6d_t& start, const std::vector<double>& durations,
+                                      std::vector<TrajectorySplinePoint>& points) const
+{
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TrajectorySplinePoint& point = points[i];
+    point.goal_time = static_cast<float>(durations[i]);
+    vector6d_t accelerations = { 0, 0, 0, 0, 0, 0 };
+    point.velocities = { 0, 0, 0, 0, 0, 0 };
+    // The trajectory ends at rest
+    if (i + 1 < points.size())
+    {
+      const vector6d_t& previous = i == 0 ? start : points[i - 1].positions;
+      const vector6d_t& next = points[i + 1].positions;
+      const double mean_duration = 0.5 * (durations[i] + durations[i + 1]);
+      for (size_t j = 0; j < 6; ++j)
+      {
+        const double slope_in = (point.positions[j] - previous[j]) / durations[i];
+        const double slope_out = (next[j] - point.positions[j]) / durations[i + 1];
+        // Joints reversing their direction stop at the waypoint
+        if (slope_in * slope_out > 0)
+        {
+          const double max_velocity = limits_.max_velocity[j];
+          const double max_acceleration = limits_.max_acceleration[j];
+          point.velocities[j] = std::clamp(0.5 * (slope_in + slope_out), -max_velocity, max_velocity);
+          accelerations[j] = std::clamp((slope_out - slope_in) / mean_duration, -max_acceleration, max_acceleration);
+        }
+      }
+    }
+    point.accelerations = accelerations;
+  }
+}
+
+double SplinePlanner::limitRatio(const vector6d_t& start_q, const vector6d_t& start_qd, const vector6d_t& start_qdd,
+                                 const TrajectorySplinePoint& end, const double duration) const
+{
+  vector6d_t coefficients3, coefficients4, coefficients5;
+  quinticCoefficients(start_q, start_qd, start_qdd, end.positions, end.velocities, accelerationsOrZero(end), duration,
+                      coefficients3, coefficients4, coefficients5);
+
+  double ratio = 0;
+  for (size_t k = 0; k <= NUM_LIMIT_SAMPLES; ++k)
+  {
+    const double t = static_cast<double>(k) / NUM_LIMIT_SAMPLES;
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      // Derivatives with respect to the normalized time, scaled back to seconds
+      const double velocity = (start_qd[j] * duration + start_qdd[j] * duration * duration * t +
+                               3.0 * coefficients3[j] * t2 + 4.0 * coefficients4[j] * t3 +
+                               5.0 * coefficients5[j] * t3 * t) /
+                              duration;
+      const double acceleration = (start_qdd[j] * duration * duration + 6.0 * coefficients3[j] * t +
+                                   12.0 * coefficients4[j] * t2 + 20.0 * coefficients5[j] * t3) /
+                                  (duration * duration);
+      ratio = std::max(ratio, std::abs(velocity) / limits_.max_velocity[j]);
+      ratio = std::max(ratio, std::sqrt(std::abs(acceleration) / limits_.max_acceleration[j]));
+    }
+  }
+  return ratio;
+}
+
+}  // namespace control
+}  // namespace urcl
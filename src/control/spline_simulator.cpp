@@ -0,0 +1,488 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/spline_simulator.h"
+#include "ur_client_library/exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+const vector6d_t ZERO = { 0, 0, 0, 0, 0, 0 };
+
+// Euclidean norm of the difference, like norm() on lists in URScript
+double distance(const vector6d_t& a, const vector6d_t& b)
+{
+  double sum = 0.0;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    sum += (a[j] - b[j]) * (a[j] - b[j]);
+  }
+  return std::sqrt(sum);
+}
+
+vector6d_t splineVelocity(const vector6d_t& c1, const vector6d_t& c2, const vector6d_t& c3, const vector6d_t& c4,
+                          const vector6d_t& c5, const double t)
+{
+  vector6d_t qd;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    qd[j] = c1[j] + 2.0 * t * c2[j] + 3.0 * t * t * c3[j] + 4.0 * t * t * t * c4[j] + 5.0 * t * t * t * t * c5[j];
+  }
+  return qd;
+}
+}  // namespace
+
+SplineSimulator::SplineSimulator(const double step_time, const bool quantize)
+  : step_time_(step_time)
+  , quantize_(quantize)
+  , q_(ZERO)
+  , qd_(ZERO)
+  , time_(0.0)
+  , num_steps_(0)
+  , point_index_(0)
+  , record_samples_(false)
+  , slowed_down_(false)
+  , trajectory_result_(TrajectoryResult::TRAJECTORY_RESULT_UNKNOWN)
+  , spline_qd_(ZERO)
+  , spline_qdd_(ZERO)
+  , spline_planned_q_(ZERO)
+  , spline_planned_qd_(ZERO)
+  , spline_planned_qdd_(ZERO)
+  , spline_planned_valid_(false)
+{
+  if (!(step_time > 0.0))
+  {
+    throw UrException("The step time of the spline simulator has to be positive.");
+  }
+}
+
+SplineSimulationResult SplineSimulator::run(const vector6d_t& start, const std::vector<TrajectorySplinePoint>& points,
+                                            const bool record_samples)
+{
+  reset(start, record_samples);
+  for (size_t i = 0; i < points.size() && trajectory_result_ == TrajectoryResult::TRAJECTORY_RESULT_SUCCESS; ++i)
+  {
+    point_index_ = i;
+    const TrajectorySplinePoint& point = points[i];
+    const double time = quantize(point.goal_time, wire::MULT_TIME);
+    const bool is_last_point = i + 1 == points.size();
+    spline_planned_valid_ = false;
+    if (point.accelerations)
+    {
+      quinticSplineRun(quantize(point.positions), quantize(point.velocities), quantize(*point.accelerations), time,
+                       is_last_point, i == 0);
+    }
+    else
+    {
+      cubicSplineRun(quantize(point.positions), quantize(point.velocities), time, is_last_point, i == 0);
+      spline_qdd_ = ZERO;
+    }
+    ++point_index_;
+  }
+  return finish();
+}
+
+SplineSimulationResult SplineSimulator::run(const vector6d_t& start,
+                                            const std::vector<TrajectorySplineSegment>& segments,
+                                            const bool record_samples)
+{
+  reset(start, record_samples);
+  for (size_t i = 0; i < segments.size() && trajectory_result_ == TrajectoryResult::TRAJECTORY_RESULT_SUCCESS; ++i)
+  {
+    point_index_ = i;
+    TrajectorySplineSegment segment;
+    segment.coefficients3 = quantize(segments[i].coefficients3);
+    segment.coefficients4 = quantize(segments[i].coefficients4);
+    segment.coefficients5 = quantize(segments[i].coefficients5);
+    precomputedSplineRun(segment, quantize(segments[i].duration, wire::MULT_TIME), i + 1 == segments.size());
+    ++point_index_;
+  }
+  return finish();
+}
+
+bool SplineSimulator::targetWithinLimits(const vector6d_t& start, const vector6d_t& end, const double time)
+{
+  for (size_t j = 0; j < 6; ++j)
+  {
+    if (std::abs(end[j] - start[j]) / time > JOINT_IGNORE_SPEED)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SplineSimulator::checkSlowDownRequired(const double x, const vector6d_t& qd, const double max_deceleration)
+{
+  const double max_allowable_speed = MAX_JOINT_SPEED - x * max_deceleration;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    if (std::abs(qd[j]) > max_allowable_speed)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SplineSimulator::reset(const vector6d_t& start, const bool record_samples)
+{
+  q_ = start;
+  qd_ = ZERO;
+  time_ = 0.0;
+  num_steps_ = 0;
+  point_index_ = 0;
+  record_samples_ = record_samples;
+  slowed_down_ = false;
+  trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+  samples_.clear();
+  spline_qd_ = ZERO;
+  spline_qdd_ = ZERO;
+  spline_planned_valid_ = false;
+}
+
+bool SplineSimulator::zeroTimePoint(const vector6d_t& end_q, const double time, const bool is_first_point)
+{
+  // If users specify the current joint position with time 0 that may be fine, in that case the
+  // point is ignored. Otherwise, the motion is canceled.
+  if (is_first_point && time == 0.0 && distance(end_q, q_) < 0.01)
+  {
+    return false;
+  }
+  trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_CANCELED;
+  return false;
+}
+
+bool SplineSimulator::cubicSplineRun(const vector6d_t& end_q, const vector6d_t& end_qd, const double time,
+                                     const bool is_last_point, const bool is_first_point)
+{
+  const vector6d_t start_q = q_;
+  if (time <= 0.0)
+  {
+    return zeroTimePoint(end_q, time, is_first_point);
+  }
+  if (!targetWithinLimits(start_q, end_q, time))
+  {
+    trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_CANCELED;
+    return false;
+  }
+
+  const vector6d_t start_qd = spline_qd_;
+  Coefficients coefficients;
+  coefficients.c1 = start_qd;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    coefficients.c2[j] =
+        (-3 * start_q[j] + end_q[j] * 3 - start_qd[j] * 2 * time - end_qd[j] * time) / std::pow(time, 2);
+    coefficients.c3[j] = (2 * start_q[j] - 2 * end_q[j] + start_qd[j] * time + end_qd[j] * time) / std::pow(time, 3);
+  }
+  coefficients.c4 = ZERO;
+  coefficients.c5 = ZERO;
+  jointSplineRun(coefficients, time, is_last_point);
+  return !is_last_point;
+}
+
+bool SplineSimulator::quinticSplineRun(const vector6d_t& end_q, const vector6d_t& end_qd, const vector6d_t& end_qdd,
+                                       const double time, const bool is_last_point, const bool is_first_point)
+{
+  const vector6d_t start_q = q_;
+  if (time <= 0.0)
+  {
+    return zeroTimePoint(end_q, time, is_first_point);
+  }
+  if (!targetWithinLimits(start_q, end_q, time))
+  {
+    trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_CANCELED;
+    return false;
+  }
+
+  const vector6d_t start_qd = spline_qd_;
+  const vector6d_t start_qdd = spline_qdd_;
+  const double time2 = std::pow(time, 2);
+  Coefficients coefficients;
+  coefficients.c1 = start_qd;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    coefficients.c2[j] = 0.5 * start_qdd[j];
+    coefficients.c3[j] = (-20.0 * start_q[j] + 20.0 * end_q[j] - 3.0 * start_qdd[j] * time2 + end_qdd[j] * time2 -
+                          12.0 * start_qd[j] * time - 8.0 * end_qd[j] * time) /
+                         (2.0 * std::pow(time, 3));
+    coefficients.c4[j] = (30.0 * start_q[j] - 30.0 * end_q[j] + 3.0 * start_qdd[j] * time2 -
+                          2.0 * end_qdd[j] * time2 + 16.0 * start_qd[j] * time + 14.0 * end_qd[j] * time) /
+                         (2.0 * std::pow(time, 4));
+    coefficients.c5[j] = (-12.0 * start_q[j] + 12.0 * end_q[j] - start_qdd[j] * time2 + end_qdd[j] * time2 -
+                          6.0 * start_qd[j] * time - 6.0 * end_qd[j] * time) /
+                         (2.0 * std::pow(time, 5));
+  }
+  jointSplineRun(coefficients, time, is_last_point);
+  return !is_last_point;
+}
+
+bool SplineSimulator::precomputedSplineRun(const TrajectorySplineSegment& segment, const double time,
+                                           const bool is_last_point)
+{
+  if (time <= 0.0)
+  {
+    trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_CANCELED;
+    return false;
+  }
+
+  const vector6d_t start_q = q_;
+  if (!spline_planned_valid_)
+  {
+    spline_planned_q_ = start_q;
+    spline_planned_qd_ = spline_qd_;
+    spline_planned_qdd_ = spline_qdd_;
+    spline_planned_valid_ = true;
+  }
+  const double time2 = std::pow(time, 2);
+  vector6d_t scaled_coefficients1;
+  vector6d_t scaled_coefficients2;
+  vector6d_t end_q;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    scaled_coefficients1[j] = spline_planned_qd_[j] * time;
+    scaled_coefficients2[j] = 0.5 * spline_planned_qdd_[j] * time2;
+    end_q[j] = spline_planned_q_[j] + scaled_coefficients1[j] + scaled_coefficients2[j] + segment.coefficients3[j] +
+               segment.coefficients4[j] + segment.coefficients5[j];
+  }
+  if (!targetWithinLimits(start_q, end_q, time))
+  {
+    trajectory_result_ = TrajectoryResult::TRAJECTORY_RESULT_CANCELED;
+    return false;
+  }
+
+  // Moves the deviation from the planned start without changing the velocity and acceleration at
+  // both ends of the segment
+  Coefficients coefficients;
+  coefficients.c1 = spline_planned_qd_;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    const double deviation = spline_planned_q_[j] - start_q[j];
+    coefficients.c2[j] = 0.5 * spline_planned_qdd_[j];
+    coefficients.c3[j] = (segment.coefficients3[j] + 10.0 * deviation) / (time2 * time);
+    coefficients.c4[j] = (segment.coefficients4[j] - 15.0 * deviation) / (time2 * time2);
+    coefficients.c5[j] = (segment.coefficients5[j] + 6.0 * deviation) / (time2 * time2 * time);
+    spline_planned_q_[j] = end_q[j];
+    spline_planned_qd_[j] = (scaled_coefficients1[j] + 2.0 * scaled_coefficients2[j] +
+                             3.0 * segment.coefficients3[j] + 4.0 * segment.coefficients4[j] +
+                             5.0 * segment.coefficients5[j]) /
+                            time;
+    spline_planned_qdd_[j] = (2.0 * scaled_coefficients2[j] + 6.0 * segment.coefficients3[j] +
+                              12.0 * segment.coefficients4[j] + 20.0 * segment.coefficients5[j]) /
+                             time2;
+  }
+  jointSplineRun(coefficients, time, is_last_point);
+  return !is_last_point;
+}
+
+void SplineSimulator::jointSplineRun(const Coefficients& coefficients, const double total_time,
+                                     const bool is_last_point)
+{
+  double traveled = 0.0;
+  double scaled_step_time = step_time_;
+  double scaling_factor = 1.0;
+  bool is_slowing_down = false;
+  double slowing_down_time = 0.0;
+  // The time needed to decelerate to zero velocity when moving at maximum velocity
+  const double deceleration_time = MAX_JOINT_SPEED / MAX_DECELERATION;
+
+  // Interpolate the spline in whole time steps
+  while ((total_time - traveled) > step_time_)
+  {
+    const double time_left = total_time - traveled;
+    if (time_left <= deceleration_time && is_last_point)
+    {
+      if (!is_slowing_down)
+      {
+        // Peek what the joint velocities will be if a full time step is taken
+        const vector6d_t qd = splineVelocity(coefficients.c1, coefficients.c2, coefficients.c3, coefficients.c4,
+                                             coefficients.c5, traveled + step_time_);
+        const double x = deceleration_time - (time_left - step_time_);
+        is_slowing_down = checkSlowDownRequired(x, qd, MAX_DECELERATION);
+        if (is_slowing_down)
+        {
+          slowing_down_time = time_left + step_time_;
+          slowed_down_ = true;
+        }
+      }
+      if (is_slowing_down)
+      {
+        scaling_factor = time_left / slowing_down_time;
+        scaled_step_time = step_time_ * scaling_factor;
+      }
+    }
+
+    traveled += scaled_step_time;
+    jointSplineStep(coefficients, traveled, step_time_, scaling_factor);
+  }
+
+  // Approach zero velocity slowly, when slowing down
+  if (is_slowing_down)
+  {
+    double time_left = total_time - traveled;
+    while (time_left >= 1e-5)
+    {
+      time_left = total_time - traveled;
+      scaling_factor = time_left / slowing_down_time;
+      scaled_step_time = step_time_ * scaling_factor;
+      traveled += scaled_step_time;
+      jointSplineStep(coefficients, traveled, step_time_, scaling_factor);
+    }
+    scaling_factor = 0.0;
+  }
+
+  // Last part of the spline which uses less than one time step
+  jointSplineStep(coefficients, total_time, total_time - traveled, scaling_factor);
+}
+
+void SplineSimulator::jointSplineStep(const Coefficients& coefficients, const double traveled, const double timestep,
+                                      const double scaling_factor)
+{
+  const vector6d_t last_spline_qd = spline_qd_;
+  const double t = traveled;
+  spline_qd_ = splineVelocity(coefficients.c1, coefficients.c2, coefficients.c3, coefficients.c4, coefficients.c5, t);
+  double qdd_max = 0.0;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    spline_qdd_[j] = 2.0 * coefficients.c2[j] + 6.0 * t * coefficients.c3[j] + 12.0 * t * t * coefficients.c4[j] +
+                     20.0 * t * t * t * coefficients.c5[j];
+    spline_qd_[j] *= scaling_factor;
+    // Distributes the velocity change over the whole timestep
+    qdd_max = std::max(qdd_max, std::abs((spline_qd_[j] - last_spline_qd[j]) / timestep));
+  }
+  speedj(spline_qd_, qdd_max, timestep);
+  num_steps_ += 1;
+  record(scaling_factor);
+}
+
+void SplineSimulator::speedj(const vector6d_t& qd, const double acceleration, const double timestep)
+{
+  // A speedj() call blocks for at least one control cycle
+  const size_t num_cycles = std::max<size_t>(1, static_cast<size_t>(std::ceil(timestep / step_time_ - 1e-9)));
+  for (size_t cycle = 0; cycle < num_cycles; ++cycle)
+  {
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const double change = qd[j] - qd_[j];
+      // Time needed to reach the target velocity, the rest of the cycle is moved at it
+      double ramp_time = 0.0;
+      if (change != 0.0)
+      {
+        ramp_time = acceleration > 0.0 ? std::min(std::abs(change) / acceleration, step_time_) : step_time_;
+      }
+      const double signed_acceleration = ramp_time > 0.0 ? std::copysign(acceleration, change) : 0.0;
+      const double ramp_end_qd = qd_[j] + signed_acceleration * ramp_time;
+      q_[j] += qd_[j] * ramp_time + 0.5 * signed_acceleration * ramp_time * ramp_time +
+               ramp_end_qd * (step_time_ - ramp_time);
+      qd_[j] = ramp_end_qd;
+    }
+    time_ += step_time_;
+  }
+}
+
+void SplineSimulator::stopj()
+{
+  // All joints are decelerated synchronously, the fastest one with STOPJ_ACCELERATION
+  double max_qd = 0.0;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    max_qd = std::max(max_qd, std::abs(qd_[j]));
+  }
+  while (max_qd > 0.0)
+  {
+    const double stop_time = max_qd / STOPJ_ACCELERATION;
+    const double ramp_time = std::min(stop_time, step_time_);
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const double deceleration = qd_[j] / stop_time;
+      q_[j] += qd_[j] * ramp_time - 0.5 * deceleration * ramp_time * ramp_time;
+      qd_[j] = stop_time > step_time_ ? qd_[j] - deceleration * ramp_time : 0.0;
+    }
+    max_qd = stop_time > step_time_ ? max_qd - STOPJ_ACCELERATION * step_time_ : 0.0;
+    time_ += step_time_;
+    record(0.0);
+  }
+}
+
+void SplineSimulator::record(const double scaling_factor)
+{
+  if (!record_samples_)
+  {
+    return;
+  }
+  SplineSimulationSample sample;
+  sample.time = time_;
+  sample.q = q_;
+  sample.qd = qd_;
+  sample.scaling_factor = scaling_factor;
+  sample.point_index = point_index_;
+  samples_.push_back(sample);
+}
+
+double SplineSimulator::quantize(const double value, const int32_t multiplier) const
+{
+  return quantize_ ? std::round(value * multiplier) / multiplier : value;
+}
+
+vector6d_t SplineSimulator::quantize(const vector6d_t& values) const
+{
+  vector6d_t quantized;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    quantized[j] = quantize(values[j], wire::MULT_JOINTSTATE);
+  }
+  return quantized;
+}
+
+SplineSimulationResult SplineSimulator::finish()
+{
+  SplineSimulationResult result;
+  result.result = trajectory_result_;
+  result.motion_time = time_;
+  result.num_steps = num_steps_;
+  result.num_points = point_index_;
+  result.slowed_down = slowed_down_;
+  stopj();
+  result.execution_time = time_;
+  result.final_q = q_;
+  result.samples = std::move(samples_);
+  samples_.clear();
+  return result;
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -29,13 +29,13 @@
 #include <ur_client_library/control/trajectory_point_interface.h>
 #include <ur_client_library/exceptions.h>
 #include <math.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace urcl
 {
 namespace control
 {
-
 std::string trajectoryResultToString(const TrajectoryResult result)
 {
   switch (result)
@@ -53,8 +53,29 @@ std::string trajectoryResultToString(const TrajectoryResult result)
   }
 }
 
-TrajectoryPointInterface::TrajectoryPointInterface(uint32_t port) : ReverseInterface(port, [](bool foo) { return foo; })
+TrajectoryPointInterface::TrajectoryPointInterface(uint32_t port)
+  : ReverseInterface(port, [](bool foo) { return foo; })
+  , batching_(false)
+  , writes_canceled_(false)
+  , points_written_(0)
+  , streaming_(false)
+  , stream_window_size_(0)
+  , points_in_flight_(0)
+  , replay_answer_(TrajectoryReplayResult::NO_ANSWER)
 {
+  for (size_t i = 0; i < result_metrics_.size(); ++i)
+  {
+    result_metrics_[i] = &getMetricsRegistry().getCounter(
+        "urcl_trajectory_results_total", "Trajectories finished by the robot",
+        { { "port", std::to_string(server_.getPort()) },
+          { "result", trajectoryResultToString(static_cast<TrajectoryResult>(static_cast<int32_t>(i) - 1)) } });
+  }
+
+  // The robot sends 4 byte status messages. The server is started by the base class already, so
+  // it has to be stopped for configuring the framing.
+  server_.shutdown();
+  server_.setMessageFraming(comm::MessageFraming::FIXED_SIZE, sizeof(int32_t));
+  server_.start();
 }
 
 bool TrajectoryPointInterface::writeTrajectoryPoint(const vector6d_t* positions, const float acceleration,
@@ -65,139 +86,343 @@ bool TrajectoryPointInterface::writeTrajectoryPoint(const vector6d_t* positions,
   {
     return false;
   }
-  uint8_t buffer[sizeof(int32_t) * MESSAGE_LENGTH];
-  uint8_t* b_pos = buffer;
-
+  int32_t message[MESSAGE_LENGTH] = { 0 };
   if (positions != nullptr)
   {
-    for (auto const& pos : *positions)
-    {
-      int32_t val = static_cast<int32_t>(round(pos * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
-    }
-    for (size_t i = 0; i < positions->size(); ++i)
+    wire::encode(message, wire::trajectory::MOVE_POSITIONS, *positions);
+    wire::fill(message, wire::trajectory::MOVE_VELOCITY, velocity);
+    wire::fill(message, wire::trajectory::MOVE_ACCELERATION, acceleration);
+  }
+  wire::encode(message, wire::trajectory::TIME, goal_time);
+  wire::encode(message, wire::trajectory::MOVE_BLEND, blend_radius);
+  wire::encode(message, wire::trajectory::TYPE,
+               toUnderlying(cartesian ? TrajectoryMotionType::CARTESIAN_POINT : TrajectoryMotionType::JOINT_POINT));
+
+  wire::toBigEndian(message, MESSAGE_LENGTH);
+  return writeMessage(reinterpret_cast<const uint8_t*>(message), 1);
+}
+
+bool TrajectoryPointInterface::writeTrajectoryPoint(const vector6d_t* positions, const float goal_time,
+                                                    const float blend_radius, const bool cartesian)
+{
+  return writeTrajectoryPoint(positions, 1.4, 1.05, goal_time, blend_radius, cartesian);
+}
+
+bool TrajectoryPointInterface::writeTrajectorySplinePoint(const vector6d_t* positions, const vector6d_t* velocities,
+                                                          const vector6d_t* accelerations, const float goal_time)
+{
+  if (client_fd_ == -1)
+  {
+    return false;
+  }
+
+  if (positions == nullptr)
+  {
+    throw urcl::UrException("TrajectoryPointInterface::writeTrajectorySplinePoint is only getting a nullptr for "
+                            "positions\n");
+  }
+  if (velocities == nullptr)
+  {
+    throw urcl::UrException("TrajectoryPointInterface::writeTrajectorySplinePoint is only getting a nullptr for "
+                            "velocities\n");
+  }
+
+  int32_t message[MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::trajectory::SPLINE_POSITIONS, *positions);
+  wire::encode(message, wire::trajectory::SPLINE_VELOCITIES, *velocities);
+  TrajectorySplineType spline_type = TrajectorySplineType::SPLINE_CUBIC;
+  if (accelerations != nullptr)
+  {
+    spline_type = TrajectorySplineType::SPLINE_QUINTIC;
+    wire::encode(message, wire::trajectory::SPLINE_ACCELERATIONS, *accelerations);
+  }
+  wire::encode(message, wire::trajectory::TIME, goal_time);
+  wire::encode(message, wire::trajectory::SPLINE_TYPE, toUnderlying(spline_type));
+  wire::encode(message, wire::trajectory::TYPE, toUnderlying(TrajectoryMotionType::JOINT_POINT_SPLINE));
+
+  wire::toBigEndian(message, MESSAGE_LENGTH);
+  return writeMessage(reinterpret_cast<const uint8_t*>(message), 1);
+}
+
+bool TrajectoryPointInterface::writeTrajectoryPoints(const TrajectoryPoint* points, const size_t count)
+{
+  if (client_fd_ == -1)
+  {
+    return false;
+  }
+
+  encode_buffer_.assign(count * MESSAGE_LENGTH, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const TrajectoryPoint& point = points[i];
+    int32_t* const message = encode_buffer_.data() + i * MESSAGE_LENGTH;
+    wire::encode(message, wire::trajectory::MOVE_POSITIONS, point.positions);
+    wire::fill(message, wire::trajectory::MOVE_VELOCITY, point.velocity);
+    wire::fill(message, wire::trajectory::MOVE_ACCELERATION, point.acceleration);
+    wire::encode(message, wire::trajectory::TIME, point.goal_time);
+    wire::encode(message, wire::trajectory::MOVE_BLEND, point.blend_radius);
+    TrajectoryMotionType motion_type = TrajectoryMotionType::JOINT_POINT;
+    if (point.process)
     {
-      int32_t val = static_cast<int32_t>(round(velocity * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
+      motion_type = TrajectoryMotionType::PROCESS_POINT;
     }
-    for (size_t i = 0; i < positions->size(); ++i)
+    else if (point.cartesian)
     {
-      int32_t val = static_cast<int32_t>(round(acceleration * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
+      motion_type = TrajectoryMotionType::CARTESIAN_POINT;
     }
+    wire::encode(message, wire::trajectory::TYPE, toUnderlying(motion_type));
   }
-  else
+
+  return writeEncodeBuffer();
+}
+
+bool TrajectoryPointInterface::writeTrajectoryCircularPoints(const TrajectoryCircularPoint* points, const size_t count)
+{
+  if (client_fd_ == -1)
   {
-    b_pos += 6 * sizeof(int32_t);
+    return false;
   }
 
-  int32_t val = static_cast<int32_t>(round(goal_time * MULT_TIME));
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+  // The goal time isn't used by movec, so it stays zero
+  encode_buffer_.assign(count * MESSAGE_LENGTH, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const TrajectoryCircularPoint& point = points[i];
+    int32_t* const message = encode_buffer_.data() + i * MESSAGE_LENGTH;
+    wire::encode(message, wire::trajectory::CIRCULAR_TARGET, point.target_pose);
+    wire::encode(message, wire::trajectory::CIRCULAR_VIA, point.via_pose);
+    wire::encode(message, wire::trajectory::CIRCULAR_ACCELERATION, point.acceleration);
+    wire::encode(message, wire::trajectory::CIRCULAR_VELOCITY, point.velocity);
+    wire::encode(message, wire::trajectory::CIRCULAR_MODE, point.mode);
+    wire::encode(message, wire::trajectory::CIRCULAR_BLEND, point.blend_radius);
+    wire::encode(message, wire::trajectory::TYPE, toUnderlying(TrajectoryMotionType::CIRCULAR_POINT));
+  }
 
-  val = static_cast<int32_t>(round(blend_radius * MULT_TIME));
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+  return writeEncodeBuffer();
+}
 
-  if (cartesian)
+bool TrajectoryPointInterface::writeTrajectorySplineSegments(const TrajectorySplineSegment* segments,
+                                                             const size_t count)
+{
+  if (client_fd_ == -1)
   {
-    val = static_cast<int32_t>(control::TrajectoryMotionType::CARTESIAN_POINT);
+    return false;
   }
-  else
+
+  encode_buffer_.assign(count * MESSAGE_LENGTH, 0);
+  for (size_t i = 0; i < count; ++i)
   {
-    val = static_cast<int32_t>(control::TrajectoryMotionType::JOINT_POINT);
+    const TrajectorySplineSegment& segment = segments[i];
+    int32_t* const message = encode_buffer_.data() + i * MESSAGE_LENGTH;
+    wire::encode(message, wire::trajectory::SEGMENT_COEFFICIENTS3, segment.coefficients3);
+    wire::encode(message, wire::trajectory::SEGMENT_COEFFICIENTS4, segment.coefficients4);
+    wire::encode(message, wire::trajectory::SEGMENT_COEFFICIENTS5, segment.coefficients5);
+    wire::encode(message, wire::trajectory::TIME, segment.duration);
+    wire::encode(message, wire::trajectory::SPLINE_TYPE, toUnderlying(TrajectorySplineType::SPLINE_PRECOMPUTED));
+    wire::encode(message, wire::trajectory::TYPE, toUnderlying(TrajectoryMotionType::JOINT_POINT_SPLINE));
   }
 
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+  return writeEncodeBuffer();
+}
 
-  size_t written;
+bool TrajectoryPointInterface::writeTrajectorySplinePoints(const TrajectorySplinePoint* points, const size_t count)
+{
+  if (client_fd_ == -1)
+  {
+    return false;
+  }
 
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+  encode_buffer_.assign(count * MESSAGE_LENGTH, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const TrajectorySplinePoint& point = points[i];
+    int32_t* const message = encode_buffer_.data() + i * MESSAGE_LENGTH;
+    wire::encode(message, wire::trajectory::SPLINE_POSITIONS, point.positions);
+    wire::encode(message, wire::trajectory::SPLINE_VELOCITIES, point.velocities);
+    TrajectorySplineType spline_type = TrajectorySplineType::SPLINE_CUBIC;
+    if (point.accelerations)
+    {
+      spline_type = TrajectorySplineType::SPLINE_QUINTIC;
+      wire::encode(message, wire::trajectory::SPLINE_ACCELERATIONS, *point.accelerations);
+    }
+    wire::encode(message, wire::trajectory::TIME, point.goal_time);
+    wire::encode(message, wire::trajectory::SPLINE_TYPE, toUnderlying(spline_type));
+    wire::encode(message, wire::trajectory::TYPE, toUnderlying(TrajectoryMotionType::JOINT_POINT_SPLINE));
+  }
+
+  return writeEncodeBuffer();
 }
 
-bool TrajectoryPointInterface::writeTrajectoryPoint(const vector6d_t* positions, const float goal_time,
-                                                    const float blend_radius, const bool cartesian)
+bool TrajectoryPointInterface::writeEncodeBuffer()
 {
-  return writeTrajectoryPoint(positions, 1.4, 1.05, goal_time, blend_radius, cartesian);
+  // Swapping all messages in one tight loop lets the compiler vectorize it.
+  wire::toBigEndian(encode_buffer_.data(), encode_buffer_.size());
+  return writeMessage(reinterpret_cast<const uint8_t*>(encode_buffer_.data()), encode_buffer_.size() / MESSAGE_LENGTH);
 }
 
-bool TrajectoryPointInterface::writeTrajectorySplinePoint(const vector6d_t* positions, const vector6d_t* velocities,
-                                                          const vector6d_t* accelerations, const float goal_time)
+void TrajectoryPointInterface::startTrajectoryBatch()
 {
-  if (client_fd_ == -1)
+  batch_.clear();
+  batching_ = true;
+}
+
+bool TrajectoryPointInterface::flushTrajectoryBatch()
+{
+  batching_ = false;
+  bool success = countPointsWritten(batch_.size() / (sizeof(int32_t) * MESSAGE_LENGTH));
+  if (success && !batch_.empty())
   {
-    return false;
+    size_t written;
+    success = client_fd_ != -1 && server_.write(client_fd_, batch_.data(), batch_.size(), written);
   }
+  batch_.clear();
+  return success;
+}
 
-  control::TrajectorySplineType spline_type = control::TrajectorySplineType::SPLINE_CUBIC;
+bool TrajectoryPointInterface::writeMessage(const uint8_t* buffer, const size_t num_points)
+{
+  const size_t message_size = sizeof(int32_t) * MESSAGE_LENGTH;
+  if (writes_canceled_)
+  {
+    return false;
+  }
+  if (batching_ && !isStreaming())
+  {
+    batch_.insert(batch_.end(), buffer, buffer + num_points * message_size);
+    return true;
+  }
 
-  // 6 positions, 6 velocities, 6 accelerations, 1 goal time, spline type, 1 point type
-  uint8_t buffer[sizeof(int32_t) * MESSAGE_LENGTH] = { 0 };
-  uint8_t* b_pos = buffer;
-  if (positions != nullptr)
+  size_t sent = 0;
+  while (sent < num_points)
   {
-    for (auto const& pos : *positions)
+    const size_t chunk = reserveStreamWindow(std::min<size_t>(num_points - sent, UPLOAD_CHUNK_SIZE));
+    if (chunk == 0 || !countPointsWritten(chunk))
+    {
+      return false;
+    }
+    size_t written;
+    if (!server_.write(client_fd_, buffer + sent * message_size, chunk * message_size, written))
     {
-      int32_t val = static_cast<int32_t>(round(pos * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
+      return false;
     }
+    sent += chunk;
   }
-  else
+  return true;
+}
+
+void TrajectoryPointInterface::startTrajectoryStream(const size_t window_size)
+{
+  if (window_size == 0)
   {
-    throw urcl::UrException("TrajectoryPointInterface::writeTrajectorySplinePoint is only getting a nullptr for "
-                            "positions\n");
+    throw UrException("The window of a streamed trajectory has to hold at least one point.");
   }
+  std::lock_guard<std::mutex> lk(stream_mutex_);
+  stream_window_size_ = window_size;
+  points_in_flight_ = 0;
+  streaming_ = true;
+}
 
-  if (velocities != nullptr)
+bool TrajectoryPointInterface::endTrajectoryStream()
+{
+  stopTrajectoryStream();
+  if (client_fd_ == -1)
   {
-    spline_type = control::TrajectorySplineType::SPLINE_CUBIC;
-    for (auto const& vel : *velocities)
-    {
-      int32_t val = static_cast<int32_t>(round(vel * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
-    }
+    return false;
   }
-  else
+
+  int32_t message[MESSAGE_LENGTH] = { 0 };
+  wire::encode(message, wire::trajectory::TYPE, toUnderlying(TrajectoryMotionType::STREAM_END));
+  wire::toBigEndian(message, MESSAGE_LENGTH);
+  if (!countPointsWritten(1))
   {
-    throw urcl::UrException("TrajectoryPointInterface::writeTrajectorySplinePoint is only getting a nullptr for "
-                            "velocities\n");
+    return false;
   }
+  size_t written;
+  return server_.write(client_fd_, reinterpret_cast<const uint8_t*>(message), sizeof(message), written);
+}
 
-  if (accelerations != nullptr)
+bool TrajectoryPointInterface::isStreaming() const
+{
+  std::lock_guard<std::mutex> lk(stream_mutex_);
+  return streaming_;
+}
+
+size_t TrajectoryPointInterface::getPointsInFlight() const
+{
+  std::lock_guard<std::mutex> lk(stream_mutex_);
+  return points_in_flight_;
+}
+
+bool TrajectoryPointInterface::waitForStreamWindow(const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lk(stream_mutex_);
+  stream_window_cv_.wait_for(lk, timeout,
+                             [this]() { return !streaming_ || points_in_flight_ < stream_window_size_; });
+  return streaming_ && points_in_flight_ < stream_window_size_;
+}
+
+void TrajectoryPointInterface::resetReplayAnswer()
+{
+  std::lock_guard<std::mutex> lk(replay_mutex_);
+  replay_answer_ = TrajectoryReplayResult::NO_ANSWER;
+}
+
+TrajectoryReplayResult TrajectoryPointInterface::waitForReplayAnswer(const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lk(replay_mutex_);
+  replay_cv_.wait_for(lk, timeout, [this]() { return replay_answer_ != TrajectoryReplayResult::NO_ANSWER; });
+  return replay_answer_;
+}
+
+size_t TrajectoryPointInterface::reserveStreamWindow(const size_t max_points)
+{
+  std::unique_lock<std::mutex> lk(stream_mutex_);
+  if (!streaming_)
   {
-    spline_type = control::TrajectorySplineType::SPLINE_QUINTIC;
-    for (auto const& acc : *accelerations)
-    {
-      int32_t val = static_cast<int32_t>(round(acc * MULT_JOINTSTATE));
-      val = htobe32(val);
-      b_pos += append(b_pos, val);
-    }
+    return max_points;
   }
-  else
+  stream_window_cv_.wait(lk, [this]() { return !streaming_ || points_in_flight_ < stream_window_size_; });
+  if (!streaming_)
   {
-    b_pos += 6 * sizeof(int32_t);
+    return 0;
   }
+  const size_t chunk = std::min(max_points, stream_window_size_ - points_in_flight_);
+  points_in_flight_ += chunk;
+  return chunk;
+}
 
-  int32_t val = static_cast<int32_t>(round(goal_time * MULT_TIME));
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+size_t TrajectoryPointInterface::cancelTrajectoryWrites()
+{
+  writes_canceled_ = true;
+  stopTrajectoryStream();
+  // Points counted before are written completely, no further point is counted or written
+  std::lock_guard<std::mutex> lk(upload_mutex_);
+  return points_written_;
+}
 
-  val = static_cast<int32_t>(spline_type);
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+bool TrajectoryPointInterface::countPointsWritten(const size_t num_points)
+{
+  std::lock_guard<std::mutex> lk(upload_mutex_);
+  if (writes_canceled_)
+  {
+    return false;
+  }
+  points_written_ += num_points;
+  return true;
+}
 
-  val = static_cast<int32_t>(control::TrajectoryMotionType::JOINT_POINT_SPLINE);
-  val = htobe32(val);
-  b_pos += append(b_pos, val);
+void TrajectoryPointInterface::resumeTrajectoryWrites()
+{
+  std::lock_guard<std::mutex> lk(upload_mutex_);
+  points_written_ = 0;
+  writes_canceled_ = false;
+}
 
-  size_t written;
-  return server_.write(client_fd_, buffer, sizeof(buffer), written);
+void TrajectoryPointInterface::stopTrajectoryStream()
+{
+  std::lock_guard<std::mutex> lk(stream_mutex_);
+  streaming_ = false;
+  stream_window_cv_.notify_all();
 }
 
 void TrajectoryPointInterface::connectionCallback(const int filedescriptor)
@@ -205,6 +430,11 @@ void TrajectoryPointInterface::connectionCallback(const int filedescriptor)
   if (client_fd_ < 0)
   {
     URCL_LOG_DEBUG("Robot connected to trajectory interface.");
+    {
+      // The script of a new connection hasn't read any points
+      std::lock_guard<std::mutex> lk(upload_mutex_);
+      points_written_ = 0;
+    }
     client_fd_ = filedescriptor;
   }
   else
@@ -218,6 +448,11 @@ void TrajectoryPointInterface::disconnectionCallback(const int filedescriptor)
 {
   URCL_LOG_DEBUG("Connection to trajectory interface dropped.");
   client_fd_ = -1;
+  stopTrajectoryStream();
+  {
+    std::lock_guard<std::mutex> lk(stream_mutex_);
+    points_in_flight_ = 0;
+  }
   if (disconnection_callback_ != nullptr)
   {
     disconnection_callback_(filedescriptor);
@@ -229,8 +464,37 @@ void TrajectoryPointInterface::messageCallback(const int filedescriptor, char* b
   if (nbytesrecv == 4)
   {
     int32_t* status = reinterpret_cast<int*>(buffer);
+    if (static_cast<int32_t>(be32toh(*status)) == STREAM_POINT_CONSUMED)
+    {
+      std::lock_guard<std::mutex> lk(stream_mutex_);
+      if (points_in_flight_ > 0)
+      {
+        --points_in_flight_;
+      }
+      stream_window_cv_.notify_all();
+      return;
+    }
+    if (static_cast<int32_t>(be32toh(*status)) == REPLAY_STARTED ||
+        static_cast<int32_t>(be32toh(*status)) == REPLAY_NOT_CACHED)
+    {
+      {
+        std::lock_guard<std::mutex> lk(replay_mutex_);
+        replay_answer_ = static_cast<int32_t>(be32toh(*status)) == REPLAY_STARTED ? TrajectoryReplayResult::STARTED :
+                                                                                     TrajectoryReplayResult::NOT_CACHED;
+      }
+      replay_cv_.notify_all();
+      return;
+    }
     URCL_LOG_DEBUG("Received message %d on TrajectoryPointInterface", be32toh(*status));
 
+    // The trajectory has ended, so a streamed trajectory does not accept points anymore.
+    stopTrajectoryStream();
+
+    // Starting with TRAJECTORY_RESULT_UNKNOWN, which also counts unexpected values
+    const int32_t result = static_cast<int32_t>(be32toh(*status));
+    const bool known = result >= 0 && result < static_cast<int32_t>(result_metrics_.size()) - 1;
+    result_metrics_[known ? result + 1 : 0]->increment();
+
     if (handle_trajectory_end_)
     {
       handle_trajectory_end_(static_cast<TrajectoryResult>(be32toh(*status)));
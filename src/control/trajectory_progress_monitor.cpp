@@ -0,0 +1,97 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/trajectory_progress_monitor.h"
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+template <typename T>
+rtde_interface::FieldHandle<T> findField(const rtde_interface::CompiledRecipe& recipe, const std::string& name)
+{
+  size_t index;
+  if (!recipe.findIndex(name, index))
+  {
+    return rtde_interface::FieldHandle<T>();
+  }
+  return recipe.getFieldHandle<T>(name);
+}
+}  // namespace
+
+TrajectoryProgressMonitor::TrajectoryProgressMonitor(const int index_register, const int time_register)
+  : index_field_("output_int_register_" + std::to_string(index_register))
+  , time_field_("output_double_register_" + std::to_string(time_register))
+{
+}
+
+void TrajectoryProgressMonitor::onDataPackage(const rtde_interface::DataPackage& package)
+{
+  // The handles are resolved once per recipe, as the output recipe can be switched
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    recipe_ = package.getCompiledRecipe();
+    index_handle_ = recipe_ != nullptr ? findField<int32_t>(*recipe_, index_field_) :
+                                         rtde_interface::FieldHandle<int32_t>();
+    time_handle_ =
+        recipe_ != nullptr ? findField<double>(*recipe_, time_field_) : rtde_interface::FieldHandle<double>();
+    timestamp_handle_ =
+        recipe_ != nullptr ? findField<double>(*recipe_, "timestamp") : rtde_interface::FieldHandle<double>();
+  }
+  if (!index_handle_.isValid() || !time_handle_.isValid())
+  {
+    return;
+  }
+
+  TrajectoryProgress progress;
+  package.getData(index_handle_, progress.point_index);
+  package.getData(time_handle_, progress.time_left);
+  if (timestamp_handle_.isValid())
+  {
+    package.getData(timestamp_handle_, progress.robot_time);
+  }
+
+  bool report;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    // The cycle the trajectory has ended in is reported as well
+    report = progress.point_index >= 0 || progress_.point_index >= 0;
+    progress_ = progress;
+  }
+  if (report && callback_)
+  {
+    callback_(progress);
+  }
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -0,0 +1,365 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/trajectory_reducer.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/joint_space.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+// Position of the spline segment the robot interpolates from start to end within duration, at
+// time t. Quintic segments start with the acceleration the previous segment ends in, like on the
+// robot.
+vector6d_t splinePosition(const TrajectorySplinePoint& start, const TrajectorySplinePoint& end, const double duration,
+                          const double t, const bool quintic)
+{
+  const double tau = t / duration;
+  const double tau2 = tau * tau;
+  const double tau3 = tau2 * tau;
+  vector6d_t position;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    const double distance = end.positions[j] - start.positions[j];
+    const double v0 = start.velocities[j] * duration;
+    const double v1 = end.velocities[j] * duration;
+    if (quintic)
+    {
+      const double a0 = (*start.accelerations)[j] * duration * duration;
+      const double a1 = (*end.accelerations)[j] * duration * duration;
+      const double c3 = 10.0 * distance - 6.0 * v0 - 4.0 * v1 - 1.5 * a0 + 0.5 * a1;
+      const double c4 = -15.0 * distance + 8.0 * v0 + 7.0 * v1 + 1.5 * a0 - a1;
+      const double c5 = 6.0 * distance - 3.0 * v0 - 3.0 * v1 - 0.5 * a0 + 0.5 * a1;
+      position[j] = start.positions[j] + v0 * tau + 0.5 * a0 * tau2 + c3 * tau3 + c4 * tau3 * tau + c5 * tau3 * tau2;
+    }
+    else
+    {
+      const double c2 = 3.0 * distance - 2.0 * v0 - v1;
+      const double c3 = -2.0 * distance + v0 + v1;
+      position[j] = start.positions[j] + v0 * tau + c2 * tau2 + c3 * tau3;
+    }
+  }
+  return position;
+}
+
+// Largest joint deviation of q from the straight joint space path between start and end
+double pathDeviation(const vector6d_t& q, const vector6d_t& start, const vector6d_t& end)
+{
+  const vector6d_t direction = joint_space::subtract(end, start);
+  const double length_squared = joint_space::dot(direction, direction);
+  double s = 0.0;
+  if (length_squared > 0.0)
+  {
+    s = std::clamp(joint_space::dot(joint_space::subtract(q, start), direction) / length_squared, 0.0, 1.0);
+  }
+  return joint_space::maxAbsDifference(q, joint_space::add(start, joint_space::scale(direction, s)));
+}
+
+double tcpDistance(const vector6d_t& a, const vector6d_t& b)
+{
+  return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+}
+
+bool continuesJointRun(const MoveJPrimitive& first, const MotionPrimitiveValue& motion)
+{
+  const auto* movej = std::get_if<MoveJPrimitive>(&motion);
+  return movej != nullptr && movej->velocity == first.velocity && movej->acceleration == first.acceleration &&
+         (movej->duration.count() > 0) == (first.duration.count() > 0);
+}
+
+bool continuesSplineRun(const SplinePrimitive& first, const MotionPrimitiveValue& motion)
+{
+  const auto* spline = std::get_if<SplinePrimitive>(&motion);
+  return spline != nullptr && spline->target_accelerations.has_value() == first.target_accelerations.has_value();
+}
+
+TrajectorySplinePoint toSplinePoint(const SplinePrimitive& spline)
+{
+  TrajectorySplinePoint point;
+  point.positions = spline.target_positions;
+  point.velocities = spline.target_velocities;
+  point.accelerations = spline.target_accelerations;
+  point.goal_time = spline.duration.count();
+  return point;
+}
+}  // namespace
+
+TrajectoryReducer::TrajectoryReducer(const TrajectoryReductionOptions& options) : options_(options)
+{
+  if (!(options.joint_tolerance >= 0) || !(options.blend_radius >= 0))
+  {
+    throw UrException("Tolerance and blend radius of trajectory reduction must not be negative.");
+  }
+  if (options.max_merged_segments == 0)
+  {
+    throw UrException("Trajectory reduction has to merge at least one segment.");
+  }
+}
+
+void TrajectoryReducer::reduceSplineRun(const TrajectorySplinePoint* points, const size_t begin, const size_t end,
+                                        std::vector<size_t>& kept) const
+{
+  const bool quintic = points[begin].accelerations.has_value();
+  // Time of every point relative to the first one of the run
+  std::vector<double> times(end - begin, 0.0);
+  for (size_t k = begin + 1; k < end; ++k)
+  {
+    times[k - begin] = times[k - begin - 1] + points[k].goal_time;
+  }
+  simplify(begin, end, kept, [&](const size_t start, const size_t target, const size_t k) {
+    const double duration = times[target - begin] - times[start - begin];
+    if (!(duration > 0.0))
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+    const double t = times[k - begin] - times[start - begin];
+    return joint_space::maxAbsDifference(splinePosition(points[start], points[target], duration, t, quintic),
+                                         points[k].positions);
+  });
+}
+
+void TrajectoryReducer::reduceJointRun(const vector6d_t* targets, const size_t begin, const size_t end,
+                                       std::vector<size_t>& kept) const
+{
+  simplify(begin, end, kept, [&](const size_t start, const size_t target, const size_t k) {
+    return pathDeviation(targets[k], targets[start], targets[target]);
+  });
+}
+
+template <typename Deviation>
+void TrajectoryReducer::simplify(const size_t begin, const size_t end, std::vector<size_t>& kept,
+                                 Deviation deviation) const
+{
+  // Douglas-Peucker: a segment is split at the point deviating most from it, until every point
+  // left out is within tolerance. Segments merging too many points are split evenly.
+  std::vector<bool> keep(end - begin, false);
+  keep.front() = true;
+  keep.back() = true;
+  std::vector<std::pair<size_t, size_t>> segments = { { begin, end - 1 } };
+  while (!segments.empty())
+  {
+    const auto [start, target] = segments.back();
+    segments.pop_back();
+    if (target - start < 2)
+    {
+      continue;
+    }
+    double worst_deviation = -1.0;
+    size_t worst = start + 1;
+    for (size_t k = start + 1; k < target; ++k)
+    {
+      const double point_deviation = deviation(start, target, k);
+      if (point_deviation > worst_deviation)
+      {
+        worst_deviation = point_deviation;
+        worst = k;
+      }
+    }
+    if (worst_deviation > options_.joint_tolerance)
+    {
+      keep[worst - begin] = true;
+      segments.push_back({ start, worst });
+      segments.push_back({ worst, target });
+    }
+    else if (target - start > options_.max_merged_segments)
+    {
+      const size_t num_parts = (target - start + options_.max_merged_segments - 1) / options_.max_merged_segments;
+      size_t previous = start;
+      for (size_t part = 1; part <= num_parts; ++part)
+      {
+        const size_t next = start + (target - start) * part / num_parts;
+        keep[next - begin] = true;
+        segments.push_back({ previous, next });
+        previous = next;
+      }
+    }
+  }
+  for (size_t k = begin; k < end; ++k)
+  {
+    if (keep[k - begin])
+    {
+      kept.push_back(k);
+    }
+  }
+}
+
+double TrajectoryReducer::blendRadius(const vector6d_t& previous_pose, const vector6d_t& pose,
+                                      const vector6d_t& next_pose) const
+{
+  return std::min(options_.blend_radius,
+                  0.5 * std::min(tcpDistance(previous_pose, pose), tcpDistance(pose, next_pose)));
+}
+
+size_t TrajectoryReducer::reduce(const MotionPrimitiveValue* motions, const size_t count,
+                                 std::vector<MotionPrimitiveValue>& reduced) const
+{
+  reduced.clear();
+  reduced.reserve(count);
+  std::vector<size_t> kept;
+  std::vector<vector6d_t> targets;
+  std::vector<vector6d_t> poses;
+  std::vector<TrajectorySplinePoint> points;
+
+  size_t i = 0;
+  while (i < count)
+  {
+    if (const auto* first_movej = std::get_if<MoveJPrimitive>(&motions[i]))
+    {
+      size_t end = i + 1;
+      while (end < count && continuesJointRun(*first_movej, motions[end]))
+      {
+        ++end;
+      }
+      targets.clear();
+      for (size_t k = i; k < end; ++k)
+      {
+        targets.push_back(std::get<MoveJPrimitive>(motions[k]).target_joint_configuration);
+      }
+      kept.clear();
+      reduceJointRun(targets.data(), 0, targets.size(), kept);
+
+      const bool select_blend_radius = options_.blend_radius > 0.0 && kept.size() < targets.size();
+      if (select_blend_radius && options_.model != nullptr)
+      {
+        poses.resize(kept.size());
+        for (size_t k = 0; k < kept.size(); ++k)
+        {
+          // Reuse the targets of the kept points as input of the batched forward kinematics
+          targets[k] = targets[kept[k]];
+        }
+        options_.model->forward(targets.data(), poses.data(), kept.size());
+      }
+      for (size_t k = 0; k < kept.size(); ++k)
+      {
+        MoveJPrimitive movej = std::get<MoveJPrimitive>(motions[i + kept[k]]);
+        // The merged motion takes as long as all motions it replaces
+        const size_t merged_begin = k == 0 ? kept[k] : kept[k - 1] + 1;
+        std::chrono::duration<double> duration(0);
+        for (size_t m = merged_begin; m <= kept[k]; ++m)
+        {
+          duration += std::get<MoveJPrimitive>(motions[i + m]).duration;
+        }
+        movej.duration = duration;
+        if (select_blend_radius && k > 0 && k + 1 < kept.size())
+        {
+          movej.blend_radius = options_.model != nullptr ? blendRadius(poses[k - 1], poses[k], poses[k + 1]) :
+                                                           options_.blend_radius;
+        }
+        reduced.push_back(movej);
+      }
+      i = end;
+    }
+    else if (const auto* first_spline = std::get_if<SplinePrimitive>(&motions[i]))
+    {
+      size_t end = i + 1;
+      while (end < count && continuesSplineRun(*first_spline, motions[end]))
+      {
+        ++end;
+      }
+      points.clear();
+      for (size_t k = i; k < end; ++k)
+      {
+        points.push_back(toSplinePoint(std::get<SplinePrimitive>(motions[k])));
+      }
+      kept.clear();
+      reduceSplineRun(points.data(), 0, points.size(), kept);
+      for (size_t k = 0; k < kept.size(); ++k)
+      {
+        SplinePrimitive spline = std::get<SplinePrimitive>(motions[i + kept[k]]);
+        const size_t merged_begin = k == 0 ? kept[k] : kept[k - 1] + 1;
+        std::chrono::duration<double> duration(0);
+        for (size_t m = merged_begin; m <= kept[k]; ++m)
+        {
+          duration += std::get<SplinePrimitive>(motions[i + m]).duration;
+        }
+        spline.duration = duration;
+        reduced.push_back(spline);
+      }
+      i = end;
+    }
+    else
+    {
+      reduced.push_back(motions[i]);
+      ++i;
+    }
+  }
+  return count - reduced.size();
+}
+
+size_t TrajectoryReducer::reduce(const std::vector<MotionPrimitiveValue>& motions,
+                                 std::vector<MotionPrimitiveValue>& reduced) const
+{
+  return reduce(motions.data(), motions.size(), reduced);
+}
+
+size_t TrajectoryReducer::reduce(const std::vector<TrajectorySplinePoint>& points,
+                                 std::vector<TrajectorySplinePoint>& reduced) const
+{
+  reduced.clear();
+  std::vector<size_t> kept;
+  size_t begin = 0;
+  while (begin < points.size())
+  {
+    // Cubic and quintic points are reduced separately
+    size_t end = begin + 1;
+    while (end < points.size() &&
+           points[end].accelerations.has_value() == points[begin].accelerations.has_value())
+    {
+      ++end;
+    }
+    kept.clear();
+    reduceSplineRun(points.data(), begin, end, kept);
+    for (size_t k = 0; k < kept.size(); ++k)
+    {
+      TrajectorySplinePoint point = points[kept[k]];
+      if (k > 0)
+      {
+        for (size_t m = kept[k - 1] + 1; m < kept[k]; ++m)
+        {
+          point.goal_time += points[m].goal_time;
+        }
+      }
+      reduced.push_back(point);
+    }
+    begin = end;
+  }
+  return points.size() - reduced.size();
+}
+
+}  // namespace control
+}  // namespace urcl
@@ -0,0 +1,130 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/trajectory_start_trigger.h"
+
+namespace urcl
+{
+namespace control
+{
+TrajectoryStartTrigger::TrajectoryStartTrigger()
+  : has_previous_(false)
+  , previous_timestamp_(0.0)
+  , pending_(false)
+  , state_(State::IDLE)
+  , token_(0)
+  , robot_time_(0.0)
+  , trigger_time_(0.0)
+{
+}
+
+void TrajectoryStartTrigger::schedule(const int32_t token, const double robot_time)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  token_ = token;
+  robot_time_ = robot_time;
+  trigger_time_ = 0.0;
+  state_ = State::PENDING;
+  pending_ = true;
+}
+
+void TrajectoryStartTrigger::cancel()
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (state_ != State::PENDING)
+    {
+      return;
+    }
+    state_ = State::IDLE;
+    pending_ = false;
+  }
+  cv_.notify_all();
+}
+
+void TrajectoryStartTrigger::onDataPackage(const rtde_interface::DataPackage& package, const WriteFunction& write)
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    recipe_ = package.getCompiledRecipe();
+    size_t index;
+    timestamp_handle_ = recipe_->findIndex("timestamp", index) ? recipe_->getFieldHandle<double>("timestamp") :
+                                                                  rtde_interface::FieldHandle<double>();
+    has_previous_ = false;
+  }
+  double timestamp;
+  if (!package.getData(timestamp_handle_, timestamp))
+  {
+    return;
+  }
+  const double period = has_previous_ && timestamp > previous_timestamp_ ? timestamp - previous_timestamp_ : 0.0;
+  has_previous_ = true;
+  previous_timestamp_ = timestamp;
+
+  if (!pending_)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    // The register is read by the robot in the cycle after the one this package was sent in. Write
+    // it for the cycle closest to the start time.
+    if (state_ != State::PENDING || timestamp + 1.5 * period < robot_time_)
+    {
+      return;
+    }
+    state_ = write(token_) ? State::FIRED : State::FAILED;
+    trigger_time_ = timestamp;
+    pending_ = false;
+  }
+  cv_.notify_all();
+}
+
+bool TrajectoryStartTrigger::waitForTrigger(const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lk(mutex_);
+  cv_.wait_for(lk, timeout, [this] { return state_ != State::PENDING; });
+  return state_ == State::FIRED;
+}
+
+TrajectoryStartTrigger::State TrajectoryStartTrigger::getState() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return state_;
+}
+
+double TrajectoryStartTrigger::getTriggerTime() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return trigger_time_;
+}
+
+}  // namespace control
+}  // namespace urcl
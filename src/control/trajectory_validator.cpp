@@ -0,0 +1,502 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/trajectory_validator.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/joint_space.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace urcl
+{
+namespace control
+{
+namespace
+{
+const vector6d_t LOWEST = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                            std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                            std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+const vector6d_t HIGHEST = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+
+// False for infinite and NaN elements
+bool isFinite(const vector6d_t& values)
+{
+  return joint_space::withinLimits(values, LOWEST, HIGHEST);
+}
+
+vector6d_t toVector(const urcl::Pose& pose)
+{
+  return { pose.x, pose.y, pose.z, pose.rx, pose.ry, pose.rz };
+}
+}  // namespace
+
+std::string trajectoryViolationToString(const TrajectoryViolation violation)
+{
+  switch (violation)
+  {
+    case TrajectoryViolation::NONE:
+      return "NONE";
+    case TrajectoryViolation::INVALID_VALUE:
+      return "INVALID_VALUE";
+    case TrajectoryViolation::POSITION_LIMIT:
+      return "POSITION_LIMIT";
+    case TrajectoryViolation::VELOCITY_LIMIT:
+      return "VELOCITY_LIMIT";
+    case TrajectoryViolation::ACCELERATION_LIMIT:
+      return "ACCELERATION_LIMIT";
+    case TrajectoryViolation::WORKSPACE:
+      return "WORKSPACE";
+    default:
+      throw std::invalid_argument("Illegal trajectory violation");
+  }
+}
+
+/*!
+ * Checks the targets of one trajectory in order. Joint targets are collected while checking, so
+ * the workspace can be checked for all of them in a single forward kinematics batch at the end.
+ */
+class TrajectoryValidator::Pass
+{
+public:
+  explicit Pass(const TrajectoryValidator& validator)
+    : validator_(validator), has_previous_(false), index_(0), check_kinematics_(validator.model_ != nullptr)
+  {
+  }
+
+  bool jointTarget(const vector6d_t& q, const double velocity, const double acceleration, const double goal_time)
+  {
+    if (!checkPositions(q) || !checkGoalTime(goal_time))
+    {
+      return false;
+    }
+    if (goal_time > 0)
+    {
+      if (!checkAverageVelocity(q, goal_time))
+      {
+        return false;
+      }
+    }
+    else if (!checkLeadingAxis(velocity, acceleration))
+    {
+      return false;
+    }
+    setPrevious(q);
+    return true;
+  }
+
+  bool splinePoint(const TrajectorySplinePoint& point)
+  {
+    // Like on the robot, only the first point may have a goal time of 0, if it is the current
+    // joint position
+    if (!isFinite(point.velocities) || (point.accelerations && !isFinite(*point.accelerations)) ||
+        !(point.goal_time > 0 || (point.goal_time == 0 && index_ == 0)))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    if (!checkPositions(point.positions))
+    {
+      return false;
+    }
+    if (!joint_space::withinLimits(point.velocities, validator_.limits_.max_velocity) ||
+        !checkAverageVelocity(point.positions, point.goal_time))
+    {
+      return fail(TrajectoryViolation::VELOCITY_LIMIT);
+    }
+    if (point.accelerations && !joint_space::withinLimits(*point.accelerations, validator_.limits_.max_acceleration))
+    {
+      return fail(TrajectoryViolation::ACCELERATION_LIMIT);
+    }
+    setPrevious(point.positions);
+    return true;
+  }
+
+  bool cartesianTarget(const vector6d_t& pose, const double velocity, const double acceleration,
+                       const double goal_time)
+  {
+    if (!checkPose(pose) || !checkGoalTime(goal_time))
+    {
+      return false;
+    }
+    if (!(goal_time > 0) && !(velocity > 0 && std::isfinite(velocity) && acceleration > 0 && std::isfinite(acceleration)))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    // The joint positions the target is reached with aren't known
+    has_previous_ = false;
+    return true;
+  }
+
+  bool circularTarget(const vector6d_t& via_pose, const vector6d_t& target_pose, const double velocity,
+                      const double acceleration)
+  {
+    return checkPose(via_pose) && cartesianTarget(target_pose, velocity, acceleration, 0.0);
+  }
+
+  void next()
+  {
+    ++index_;
+  }
+
+  TrajectoryValidationResult finish()
+  {
+    if (!check_kinematics_ || joint_targets_.empty())
+    {
+      return result_;
+    }
+    poses_.resize(joint_targets_.size());
+    validator_.model_->forward(joint_targets_.data(), poses_.data(), joint_targets_.size());
+    for (size_t i = 0; i < poses_.size(); ++i)
+    {
+      if (!joint_space::withinLimits(poses_[i], validator_.workspace_min_, validator_.workspace_max_))
+      {
+        // A violation found earlier only takes precedence, if it belongs to an earlier target
+        if (result_ || joint_indices_[i] < result_.index)
+        {
+          result_.violation = TrajectoryViolation::WORKSPACE;
+          result_.index = joint_indices_[i];
+        }
+        break;
+      }
+    }
+    return result_;
+  }
+
+private:
+  bool fail(const TrajectoryViolation violation)
+  {
+    result_.violation = violation;
+    result_.index = index_;
+    return false;
+  }
+
+  bool checkGoalTime(const double goal_time)
+  {
+    if (!(goal_time >= 0) || !std::isfinite(goal_time))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    return true;
+  }
+
+  bool checkPositions(const vector6d_t& q)
+  {
+    if (!isFinite(q))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    if (!joint_space::withinLimits(q, validator_.position_min_, validator_.position_max_))
+    {
+      return fail(TrajectoryViolation::POSITION_LIMIT);
+    }
+    if (check_kinematics_)
+    {
+      joint_targets_.push_back(q);
+      joint_indices_.push_back(index_);
+    }
+    return true;
+  }
+
+  bool checkPose(const vector6d_t& pose)
+  {
+    if (!isFinite(pose))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    if (validator_.has_workspace_ &&
+        !joint_space::withinLimits(pose, validator_.workspace_min_, validator_.workspace_max_))
+    {
+      return fail(TrajectoryViolation::WORKSPACE);
+    }
+    return true;
+  }
+
+  // Reaching the target from the previous one in the goal time needs at least the average velocity
+  bool checkAverageVelocity(const vector6d_t& q, const double goal_time)
+  {
+    if (has_previous_ &&
+        !joint_space::withinLimits(joint_space::finiteDifference(q, previous_, goal_time),
+                                   validator_.limits_.max_velocity))
+    {
+      return fail(TrajectoryViolation::VELOCITY_LIMIT);
+    }
+    return true;
+  }
+
+  bool checkLeadingAxis(const double velocity, const double acceleration)
+  {
+    if (!(velocity > 0) || !(acceleration > 0))
+    {
+      return fail(TrajectoryViolation::INVALID_VALUE);
+    }
+    if (!(velocity <= validator_.max_leading_velocity_))
+    {
+      return fail(TrajectoryViolation::VELOCITY_LIMIT);
+    }
+    if (!(acceleration <= validator_.max_leading_acceleration_))
+    {
+      return fail(TrajectoryViolation::ACCELERATION_LIMIT);
+    }
+    return true;
+  }
+
+  void setPrevious(const vector6d_t& q)
+  {
+    previous_ = q;
+    has_previous_ = true;
+  }
+
+  const TrajectoryValidator& validator_;
+  TrajectoryValidationResult result_;
+  vector6d_t previous_;
+  bool has_previous_;
+  size_t index_;
+  bool check_kinematics_;
+  std::vector<vector6d_t> joint_targets_;
+  std::vector<size_t> joint_indices_;
+  std::vector<vector6d_t> poses_;
+};
+
+TrajectoryValidator::TrajectoryValidator(const JointLimits& limits)
+  : TrajectoryValidator(limits, { -2 * M_PI, -2 * M_PI, -2 * M_PI, -2 * M_PI, -2 * M_PI, -2 * M_PI },
+                        { 2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI, 2 * M_PI })
+{
+}
+
+TrajectoryValidator::TrajectoryValidator(const JointLimits& limits, const vector6d_t& position_min,
+                                         const vector6d_t& position_max)
+  : limits_(limits)
+  , position_min_(position_min)
+  , position_max_(position_max)
+  , max_leading_velocity_(0)
+  , max_leading_acceleration_(0)
+  , has_workspace_(false)
+{
+  for (size_t j = 0; j < 6; ++j)
+  {
+    if (!(limits.max_velocity[j] > 0) || !(limits.max_acceleration[j] > 0))
+    {
+      throw UrException("Joint limits used for trajectory validation have to be positive.");
+    }
+    if (!(position_min[j] <= position_max[j]))
+    {
+      throw UrException("Lower joint position limits have to be below the upper ones.");
+    }
+  }
+  max_leading_velocity_ = joint_space::maxAbs(limits.max_velocity);
+  max_leading_acceleration_ = joint_space::maxAbs(limits.max_acceleration);
+  clearWorkspace();
+}
+
+void TrajectoryValidator::setWorkspace(const vector3d_t& lower, const vector3d_t& upper,
+                                       std::shared_ptr<const kinematics::KinematicsModel> model)
+{
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (!(lower[i] <= upper[i]))
+    {
+      throw UrException("The lower corner of the workspace has to be below the upper one.");
+    }
+    workspace_min_[i] = lower[i];
+    workspace_max_[i] = upper[i];
+  }
+  has_workspace_ = true;
+  model_ = model;
+}
+
+void TrajectoryValidator::clearWorkspace()
+{
+  // The orientation isn't restricted, so checking the whole pose against the bounds only checks
+  // the position
+  workspace_min_.fill(-std::numeric_limits<double>::infinity());
+  workspace_max_.fill(std::numeric_limits<double>::infinity());
+  has_workspace_ = false;
+  model_ = nullptr;
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const MotionPrimitiveValue* motions, const size_t count) const
+{
+  Pass pass(*this);
+  for (size_t i = 0; i < count; ++i, pass.next())
+  {
+    const MotionPrimitiveValue& motion = motions[i];
+    bool valid = true;
+    if (const auto* movej = std::get_if<MoveJPrimitive>(&motion))
+    {
+      valid = pass.jointTarget(movej->target_joint_configuration, movej->velocity, movej->acceleration,
+                               movej->duration.count());
+    }
+    else if (const auto* movel = std::get_if<MoveLPrimitive>(&motion))
+    {
+      valid = pass.cartesianTarget(toVector(movel->target_pose), movel->velocity, movel->acceleration,
+                                   movel->duration.count());
+    }
+    else if (const auto* movep = std::get_if<MovePPrimitive>(&motion))
+    {
+      valid = pass.cartesianTarget(toVector(movep->target_pose), movep->velocity, movep->acceleration, 0.0);
+    }
+    else if (const auto* movec = std::get_if<MoveCPrimitive>(&motion))
+    {
+      valid = pass.circularTarget(toVector(movec->via_point_pose), toVector(movec->target_pose), movec->velocity,
+                                  movec->acceleration);
+    }
+    else if (const auto* spline = std::get_if<SplinePrimitive>(&motion))
+    {
+      TrajectorySplinePoint point;
+      point.positions = spline->target_positions;
+      point.velocities = spline->target_velocities;
+      point.accelerations = spline->target_accelerations;
+      point.goal_time = spline->duration.count();
+      valid = pass.splinePoint(point);
+    }
+    if (!valid)
+    {
+      break;
+    }
+  }
+  return pass.finish();
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const std::vector<MotionPrimitiveValue>& motions) const
+{
+  return validate(motions.data(), motions.size());
+}
+
+TrajectoryValidationResult
+TrajectoryValidator::validate(const std::vector<std::shared_ptr<MotionPrimitive>>& motions) const
+{
+  Pass pass(*this);
+  for (size_t i = 0; i < motions.size(); ++i, pass.next())
+  {
+    const MotionPrimitive& motion = *motions[i];
+    bool valid = true;
+    switch (motion.type)
+    {
+      case MotionType::MOVEJ:
+      {
+        const auto& movej = static_cast<const MoveJPrimitive&>(motion);
+        valid = pass.jointTarget(movej.target_joint_configuration, movej.velocity, movej.acceleration,
+                                 movej.duration.count());
+        break;
+      }
+      case MotionType::MOVEL:
+      {
+        const auto& movel = static_cast<const MoveLPrimitive&>(motion);
+        valid = pass.cartesianTarget(toVector(movel.target_pose), movel.velocity, movel.acceleration,
+                                     movel.duration.count());
+        break;
+      }
+      case MotionType::MOVEP:
+      {
+        const auto& movep = static_cast<const MovePPrimitive&>(motion);
+        valid = pass.cartesianTarget(toVector(movep.target_pose), movep.velocity, movep.acceleration, 0.0);
+        break;
+      }
+      case MotionType::MOVEC:
+      {
+        const auto& movec = static_cast<const MoveCPrimitive&>(motion);
+        valid = pass.circularTarget(toVector(movec.via_point_pose), toVector(movec.target_pose), movec.velocity,
+                                    movec.acceleration);
+        break;
+      }
+      case MotionType::SPLINE:
+      {
+        const auto& spline = static_cast<const SplinePrimitive&>(motion);
+        TrajectorySplinePoint point;
+        point.positions = spline.target_positions;
+        point.velocities = spline.target_velocities;
+        point.accelerations = spline.target_accelerations;
+        point.goal_time = spline.duration.count();
+        valid = pass.splinePoint(point);
+        break;
+      }
+      default:
+        break;
+    }
+    if (!valid)
+    {
+      break;
+    }
+  }
+  return pass.finish();
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const TrajectoryPoint* points, const size_t count) const
+{
+  Pass pass(*this);
+  for (size_t i = 0; i < count; ++i, pass.next())
+  {
+    const TrajectoryPoint& point = points[i];
+    // Process moves ignore the goal time
+    const double goal_time = point.process ? 0.0 : point.goal_time;
+    const bool valid = point.cartesian || point.process ?
+                           pass.cartesianTarget(point.positions, point.velocity, point.acceleration, goal_time) :
+                           pass.jointTarget(point.positions, point.velocity, point.acceleration, goal_time);
+    if (!valid)
+    {
+      break;
+    }
+  }
+  return pass.finish();
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const TrajectorySplinePoint* points, const size_t count) const
+{
+  Pass pass(*this);
+  for (size_t i = 0; i < count; ++i, pass.next())
+  {
+    if (!pass.splinePoint(points[i]))
+    {
+      break;
+    }
+  }
+  return pass.finish();
+}
+
+TrajectoryValidationResult TrajectoryValidator::validate(const TrajectoryCircularPoint* points,
+                                                         const size_t count) const
+{
+  Pass pass(*this);
+  for (size_t i = 0; i < count; ++i, pass.next())
+  {
+    const TrajectoryCircularPoint& point = points[i];
+    if (!pass.circularTarget(point.via_pose, point.target_pose, point.velocity, point.acceleration))
+    {
+      break;
+    }
+  }
+  return pass.finish();
+}
+
+}  // namespace control
+}  // namespace urcl
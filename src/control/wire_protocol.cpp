@@ -0,0 +1,138 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/control/wire_protocol.h"
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace urcl
+{
+namespace control
+{
+namespace wire
+{
+namespace
+{
+template <size_t N>
+void appendMessage(std::ostream& out, const Message<N>& message)
+{
+  out << message.name << "_LENGTH = " << message.length << "\n";
+  for (const Field& field : message.fields)
+  {
+    // The first element of a list read using socket_read_binary_integer() is its length
+    out << message.name << "_" << field.name << " = " << field.offset + 1 << "\n";
+  }
+}
+
+// Names of the control modes and the other control mode fields with a payload in the script
+const std::vector<std::pair<comm::ControlMode, const char*>> CONTROL_MODE_NAMES = {
+  { comm::ControlMode::MODE_IDLE, "MODE_IDLE" },
+  { comm::ControlMode::MODE_SERVOJ, "MODE_SERVOJ" },
+  { comm::ControlMode::MODE_SPEEDJ, "MODE_SPEEDJ" },
+  { comm::ControlMode::MODE_FORWARD, "MODE_FORWARD" },
+  { comm::ControlMode::MODE_SPEEDL, "MODE_SPEEDL" },
+  { comm::ControlMode::MODE_POSE, "MODE_POSE" },
+  { comm::ControlMode::MODE_FREEDRIVE, "MODE_FREEDRIVE" },
+  { comm::ControlMode::MODE_FORCE, "MODE_FORCE" },
+  { static_cast<comm::ControlMode>(reverse::SERVO_PARAMETERS_MODE), "REVERSE_SERVO_PARAMETERS" },
+};
+
+void appendCompactPayloadLength(std::ostream& out)
+{
+  // Modes are grouped by their payload length, in order of the first mode of each group
+  std::vector<std::pair<size_t, std::string>> conditions;
+  for (const auto& mode : CONTROL_MODE_NAMES)
+  {
+    const size_t length = reverse::compactPayloadLength(mode.first);
+    if (length == 0)
+    {
+      continue;
+    }
+    auto it = conditions.begin();
+    while (it != conditions.end() && it->first != length)
+    {
+      ++it;
+    }
+    const std::string condition = std::string("mode == ") + mode.second;
+    if (it == conditions.end())
+    {
+      conditions.emplace_back(length, condition);
+    }
+    else
+    {
+      it->second += " or " + condition;
+    }
+  }
+
+  out << "# Number of payload fields of a compact message in the given control mode\n";
+  out << "def compact_payload_length(mode):\n";
+  for (size_t i = 0; i < conditions.size(); ++i)
+  {
+    out << (i == 0 ? "  if " : "  elif ") << conditions[i].second << ":\n";
+    out << "    return " << conditions[i].first << "\n";
+  }
+  if (!conditions.empty())
+  {
+    out << "  end\n";
+  }
+  out << "  return 0\n";
+  out << "end\n";
+}
+}  // namespace
+
+std::string generateURScriptDefinitions()
+{
+  std::ostringstream out;
+  out << "# Message layouts generated from the driver's wire protocol\n";
+  out << "MULT_jointstate = " << MULT_JOINTSTATE << "\n";
+  out << "MULT_time = " << MULT_TIME << "\n";
+  appendMessage(out, reverse::SETPOINT);
+  appendMessage(out, reverse::TRAJECTORY);
+  appendMessage(out, reverse::FREEDRIVE);
+  appendMessage(out, reverse::PROTOCOL);
+  appendMessage(out, reverse::SERVO_PARAMETERS);
+  appendMessage(out, trajectory::MOVE);
+  appendMessage(out, trajectory::CIRCULAR);
+  appendMessage(out, trajectory::SPLINE);
+  appendMessage(out, trajectory::SEGMENT);
+  appendMessage(out, script_command::PLAIN);
+  appendMessage(out, script_command::PAYLOAD);
+  appendMessage(out, script_command::TOOL_VOLTAGE);
+  appendMessage(out, script_command::FORCE_MODE);
+  appendMessage(out, script_command::BATCH);
+  appendCompactPayloadLength(out);
+  return out.str();
+}
+
+}  // namespace wire
+}  // namespace control
+}  // namespace urcl
@@ -29,9 +29,26 @@
 #include <ur_client_library/helpers.h>
 #include <ur_client_library/log.h>
 
+#include <alloca.h>
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <system_error>
 
 // clang-format off
 // We want to keep the URL in one line to avoid formatting issues. This will make it easier to
@@ -95,4 +112,431 @@ bool setFiFoScheduling(pthread_t& thread, const int priority)
   }
   return true;
 }
+
+bool applyThreadConfig(pthread_t thread, const ThreadConfig& config)
+{
+  bool success = true;
+  if (config.policy == SCHED_FIFO)
+  {
+    success = setFiFoScheduling(thread, config.priority);
+  }
+  else if (config.policy >= 0)
+  {
+    struct sched_param params;
+    params.sched_priority = config.priority;
+    int ret = pthread_setschedparam(thread, config.policy, &params);
+    if (ret != 0)
+    {
+      URCL_LOG_ERROR("Unsuccessful in setting thread scheduling policy %i with priority %i. %s", config.policy,
+                     config.priority, strerror(ret));
+      success = false;
+    }
+  }
+
+  if (!config.cpus.empty())
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : config.cpus)
+    {
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+      {
+        URCL_LOG_ERROR("CPU %i is out of range and cannot be used for the affinity of a thread", cpu);
+        success = false;
+        continue;
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (ret != 0)
+    {
+      URCL_LOG_ERROR("Unsuccessful in setting the CPU affinity of a thread. %s", strerror(ret));
+      success = false;
+    }
+  }
+
+  if (!config.name.empty())
+  {
+    // The kernel limits thread names to 16 bytes including the terminating null byte.
+    const std::string name = config.name.substr(0, 15);
+    int ret = pthread_setname_np(thread, name.c_str());
+    if (ret != 0)
+    {
+      URCL_LOG_ERROR("Unsuccessful in setting the thread name to %s. %s", name.c_str(), strerror(ret));
+      success = false;
+    }
+  }
+  return success;
+}
+
+int getNumaNode(const int cpu)
+{
+  const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr)
+  {
+    return -1;
+  }
+  int node = -1;
+  while (dirent* entry = readdir(dir))
+  {
+    // The CPU's directory links to its node as "node<index>"
+    if (std::strncmp(entry->d_name, "node", 4) == 0 && std::isdigit(static_cast<unsigned char>(entry->d_name[4])))
+    {
+      node = std::atoi(entry->d_name + 4);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+int getNumaNode(const ThreadConfig& config)
+{
+  int node = -1;
+  for (const int cpu : config.cpus)
+  {
+    const int cpu_node = getNumaNode(cpu);
+    if (cpu_node < 0 || (node >= 0 && cpu_node != node))
+    {
+      return -1;
+    }
+    node = cpu_node;
+  }
+  return node;
+}
+
+void runOnNumaNode(const ThreadConfig& config, const std::function<void()>& function)
+{
+  if (config.cpus.empty())
+  {
+    function();
+    return;
+  }
+  const int node = getNumaNode(config);
+  std::exception_ptr exception;
+  std::thread thread([&]() {
+    ThreadConfig pinned;
+    pinned.cpus = config.cpus;
+    applyThreadConfig(pthread_self(), pinned);
+    if (node >= 0)
+    {
+      constexpr size_t BITS = sizeof(unsigned long) * 8;
+      std::vector<unsigned long> mask(static_cast<size_t>(node) / BITS + 1, 0);
+      mask[static_cast<size_t>(node) / BITS] = 1UL << (static_cast<size_t>(node) % BITS);
+      if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * BITS + 1) != 0)
+      {
+        URCL_LOG_WARN("Unsuccessful in preferring memory of NUMA node %i. %s", node, strerror(errno));
+      }
+    }
+    try
+    {
+      function();
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+  });
+  thread.join();
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+bool setThreadStackSize(const size_t bytes)
+{
+  if (bytes < static_cast<size_t>(PTHREAD_STACK_MIN))
+  {
+    URCL_LOG_ERROR("Thread stack size of %zu bytes is smaller than the minimum of %zu bytes", bytes,
+                   static_cast<size_t>(PTHREAD_STACK_MIN));
+    return false;
+  }
+  pthread_attr_t attr;
+  if (pthread_getattr_default_np(&attr) != 0)
+  {
+    return false;
+  }
+  int ret = pthread_attr_setstacksize(&attr, bytes);
+  if (ret == 0)
+  {
+    ret = pthread_setattr_default_np(&attr);
+  }
+  pthread_attr_destroy(&attr);
+  if (ret != 0)
+  {
+    URCL_LOG_ERROR("Failed to set the thread stack size to %zu bytes: %s", bytes, std::strerror(ret));
+    return false;
+  }
+  return true;
+}
+
+size_t getThreadStackSize()
+{
+  pthread_attr_t attr;
+  if (pthread_getattr_default_np(&attr) != 0)
+  {
+    return 0;
+  }
+  size_t bytes = 0;
+  pthread_attr_getstacksize(&attr, &bytes);
+  pthread_attr_destroy(&attr);
+  // Without a default set, threads get the size of the stack resource limit
+  if (bytes == 0)
+  {
+    rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+    {
+      bytes = limit.rlim_cur;
+    }
+  }
+  return bytes;
+}
+
+MemoryFootprint getMemoryFootprint()
+{
+  MemoryFootprint footprint;
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  std::ifstream statm("/proc/self/statm");
+  size_t virtual_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> virtual_pages >> resident_pages)
+  {
+    footprint.virtual_bytes = virtual_pages * page_size;
+    footprint.resident_bytes = resident_pages * page_size;
+  }
+  if (DIR* dir = opendir("/proc/self/task"))
+  {
+    while (dirent* entry = readdir(dir))
+    {
+      if (entry->d_name[0] != '.')
+      {
+        ++footprint.num_threads;
+      }
+    }
+    closedir(dir);
+  }
+  footprint.thread_stack_size = getThreadStackSize();
+  return footprint;
+}
+
+PriorityInheritanceMutex::PriorityInheritanceMutex()
+{
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  const int ret = pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+  if (ret != 0)
+  {
+    URCL_LOG_WARN("Priority inheritance is not supported: %s", strerror(ret));
+  }
+  pthread_mutex_init(&mutex_, ret == 0 ? &attr : nullptr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+PriorityInheritanceMutex::~PriorityInheritanceMutex()
+{
+  pthread_mutex_destroy(&mutex_);
+}
+
+void PriorityInheritanceMutex::lock()
+{
+  const int ret = pthread_mutex_lock(&mutex_);
+  if (ret != 0)
+  {
+    throw std::system_error(ret, std::generic_category(), "Locking a priority inheritance mutex failed");
+  }
+}
+
+bool PriorityInheritanceMutex::try_lock()
+{
+  return pthread_mutex_trylock(&mutex_) == 0;
+}
+
+void PriorityInheritanceMutex::unlock()
+{
+  pthread_mutex_unlock(&mutex_);
+}
+
+void prefaultStack(const size_t size)
+{
+  // Writing once per page is enough to fault in the whole range.
+  volatile char* stack = static_cast<volatile char*>(alloca(size));
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  for (size_t i = 0; i < size; i += page_size)
+  {
+    stack[i] = 0;
+  }
+}
+
+std::vector<int> parseCpuList(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string entry;
+  while (std::getline(stream, entry, ','))
+  {
+    int first, last;
+    char separator;
+    std::stringstream entry_stream(entry);
+    if (!(entry_stream >> first))
+    {
+      continue;
+    }
+    last = first;
+    if (entry_stream >> separator && (separator != '-' || !(entry_stream >> last)))
+    {
+      continue;
+    }
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<int> getIsolatedCpus()
+{
+  std::ifstream file("/sys/devices/system/cpu/isolated");
+  std::string list;
+  std::getline(file, list);
+  return parseCpuList(list);
+}
+
+namespace
+{
+void prefaultHeap(const size_t size)
+{
+  // Keep freed memory inside the process instead of returning it to the system, so the prefaulted
+  // pages are reused by later allocations.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  volatile char* buffer = static_cast<volatile char*>(malloc(size));
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  for (size_t i = 0; i < size; i += page_size)
+  {
+    buffer[i] = 0;
+  }
+  free(const_cast<char*>(buffer));
+}
+
+bool isFifoSchedulingPermitted(const int priority)
+{
+  // Try it on a short-lived thread, which covers both the rtprio limit and CAP_SYS_NICE.
+  int ret = 0;
+  std::thread trial([priority, &ret]() {
+    struct sched_param params;
+    params.sched_priority = priority;
+    ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &params);
+  });
+  trial.join();
+  return ret == 0;
+}
+}  // namespace
+
+RealtimeSetupReport setupRealtimeProcess(const RealtimeSetupConfig& config)
+{
+  RealtimeSetupReport report;
+
+  if (config.lock_memory)
+  {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+    {
+      report.memory_locked = true;
+    }
+    else
+    {
+      const int error = errno;
+      struct rlimit limit;
+      getrlimit(RLIMIT_MEMLOCK, &limit);
+      std::stringstream problem;
+      problem << "Locking the process memory failed (" << strerror(error) << "), the memlock limit is ";
+      if (limit.rlim_cur == RLIM_INFINITY)
+      {
+        problem << "unlimited";
+      }
+      else
+      {
+        problem << limit.rlim_cur / 1024 << " kB";
+      }
+      report.problems.push_back(problem.str());
+    }
+  }
+
+  if (config.stack_prefault_size > 0)
+  {
+    prefaultStack(config.stack_prefault_size);
+  }
+  if (config.heap_prefault_size > 0)
+  {
+    prefaultHeap(config.heap_prefault_size);
+  }
+  report.memory_prefaulted = config.stack_prefault_size > 0 || config.heap_prefault_size > 0;
+
+  if (!config.cpus.empty())
+  {
+    const std::vector<int> isolated = getIsolatedCpus();
+    for (const int cpu : config.cpus)
+    {
+      if (std::find(isolated.begin(), isolated.end(), cpu) == isolated.end())
+      {
+        report.non_isolated_cpus.push_back(cpu);
+      }
+    }
+    if (!report.non_isolated_cpus.empty())
+    {
+      std::stringstream problem;
+      problem << "CPUs";
+      for (const int cpu : report.non_isolated_cpus)
+      {
+        problem << " " << cpu;
+      }
+      problem << " are not isolated, other processes may be scheduled on them";
+      report.problems.push_back(problem.str());
+    }
+  }
+
+  if (config.fifo_priority > 0)
+  {
+    report.fifo_permitted = isFifoSchedulingPermitted(config.fifo_priority);
+    if (!report.fifo_permitted)
+    {
+      struct rlimit limit;
+      getrlimit(RLIMIT_RTPRIO, &limit);
+      std::stringstream problem;
+      problem << "SCHED_FIFO with priority " << config.fifo_priority << " is not permitted, the rtprio limit is ";
+      if (limit.rlim_cur == RLIM_INFINITY)
+      {
+        problem << "unlimited";
+      }
+      else
+      {
+        problem << limit.rlim_cur;
+      }
+      report.problems.push_back(problem.str());
+    }
+  }
+
+  if (report.ok())
+  {
+    URCL_LOG_INFO("Real-time process setup complete");
+  }
+  else
+  {
+    std::stringstream message;
+    for (const std::string& problem : report.problems)
+    {
+      message << "\n  - " << problem;
+    }
+    URCL_LOG_WARN("The system is not fully set up for real-time use:%s\nSee %s for details.", message.str().c_str(),
+                  RT_DOC_URL.c_str());
+  }
+  return report;
+}
 }  // namespace urcl
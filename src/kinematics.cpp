@@ -0,0 +1,548 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/kinematics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ur_client_library/joint_space.h"
+
+namespace urcl
+{
+namespace kinematics
+{
+namespace
+{
+using Transform = std::array<double, 12>;
+
+constexpr double PI = 3.14159265358979323846;
+
+// Newton iterations stop once position and orientation error are below this
+constexpr double CONVERGENCE_TOLERANCE = 1e-10;
+constexpr size_t MAX_ITERATIONS = 30;
+// Largest change of a single joint in one Newton iteration
+constexpr double MAX_STEP = 0.5;
+// Largest change of a single joint accepted when refining directly from the nearby configuration
+constexpr double MAX_NEAR_DEVIATION = 0.5;
+
+Transform multiply(const Transform& a, const Transform& b)
+{
+  Transform result;
+  for (size_t r = 0; r < 3; ++r)
+  {
+    for (size_t c = 0; c < 4; ++c)
+    {
+      result[r * 4 + c] = a[r * 4] * b[c] + a[r * 4 + 1] * b[4 + c] + a[r * 4 + 2] * b[8 + c];
+    }
+    result[r * 4 + 3] += a[r * 4 + 3];
+  }
+  return result;
+}
+
+Transform invert(const Transform& t)
+{
+  Transform result;
+  for (size_t r = 0; r < 3; ++r)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      result[r * 4 + c] = t[c * 4 + r];
+    }
+    result[r * 4 + 3] = -(t[r] * t[3] + t[4 + r] * t[7] + t[8 + r] * t[11]);
+  }
+  return result;
+}
+
+Transform fromPose(const vector6d_t& pose)
+{
+  const double angle = std::sqrt(pose[3] * pose[3] + pose[4] * pose[4] + pose[5] * pose[5]);
+  Transform t = { 1.0, 0.0, 0.0, pose[0], 0.0, 1.0, 0.0, pose[1], 0.0, 0.0, 1.0, pose[2] };
+  if (angle < 1e-12)
+  {
+    return t;
+  }
+  const double x = pose[3] / angle;
+  const double y = pose[4] / angle;
+  const double z = pose[5] / angle;
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+  const double v = 1.0 - c;
+  t[0] = c + x * x * v;
+  t[1] = x * y * v - z * s;
+  t[2] = x * z * v + y * s;
+  t[4] = y * x * v + z * s;
+  t[5] = c + y * y * v;
+  t[6] = y * z * v - x * s;
+  t[8] = z * x * v - y * s;
+  t[9] = z * y * v + x * s;
+  t[10] = c + z * z * v;
+  return t;
+}
+
+// Rotation vector of the rotation part of a transformation
+std::array<double, 3> rotationVector(const Transform& t)
+{
+  const double cos_angle = std::max(-1.0, std::min(1.0, 0.5 * (t[0] + t[5] + t[10] - 1.0)));
+  const double angle = std::acos(cos_angle);
+  std::array<double, 3> axis = { t[9] - t[6], t[2] - t[8], t[4] - t[1] };
+  if (angle < 1e-6)
+  {
+    // First order approximation, the axis scaled by 2 sin(angle) ~ 2 angle
+    return { 0.5 * axis[0], 0.5 * axis[1], 0.5 * axis[2] };
+  }
+  if (angle < PI - 1e-6)
+  {
+    const double factor = angle / (2.0 * std::sin(angle));
+    return { factor * axis[0], factor * axis[1], factor * axis[2] };
+  }
+
+  // Close to pi, the axis follows from the symmetric part of the matrix
+  const size_t k = t[0] >= t[5] && t[0] >= t[10] ? 0 : (t[5] >= t[10] ? 1 : 2);
+  std::array<double, 3> column = { 0.5 * (t[k] + t[k * 4]), 0.5 * (t[4 + k] + t[k * 4 + 1]),
+                                   0.5 * (t[8 + k] + t[k * 4 + 2]) };
+  column[k] = 0.5 * (t[k * 5] + 1.0);
+  const double norm = std::sqrt(column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+  double sign = axis[0] * column[0] + axis[1] * column[1] + axis[2] * column[2] < 0.0 ? -1.0 : 1.0;
+  return { sign * angle * column[0] / norm, sign * angle * column[1] / norm, sign * angle * column[2] / norm };
+}
+
+vector6d_t toPose(const Transform& t)
+{
+  const std::array<double, 3> rotation = rotationVector(t);
+  return { t[3], t[7], t[11], rotation[0], rotation[1], rotation[2] };
+}
+
+double normalizeAngle(double angle)
+{
+  angle = std::fmod(angle, 2.0 * PI);
+  if (angle > PI)
+  {
+    angle -= 2.0 * PI;
+  }
+  else if (angle < -PI)
+  {
+    angle += 2.0 * PI;
+  }
+  return angle;
+}
+
+// Solves the symmetric positive definite system a * x = b in place using Gaussian elimination
+void solve(std::array<double, 36>& a, std::array<double, 6>& b)
+{
+  for (size_t col = 0; col < 6; ++col)
+  {
+    size_t pivot = col;
+    for (size_t row = col + 1; row < 6; ++row)
+    {
+      if (std::fabs(a[row * 6 + col]) > std::fabs(a[pivot * 6 + col]))
+      {
+        pivot = row;
+      }
+    }
+    if (pivot != col)
+    {
+      for (size_t i = 0; i < 6; ++i)
+      {
+        std::swap(a[col * 6 + i], a[pivot * 6 + i]);
+      }
+      std::swap(b[col], b[pivot]);
+    }
+    for (size_t row = col + 1; row < 6; ++row)
+    {
+      const double factor = a[row * 6 + col] / a[col * 6 + col];
+      for (size_t i = col; i < 6; ++i)
+      {
+        a[row * 6 + i] -= factor * a[col * 6 + i];
+      }
+      b[row] -= factor * b[col];
+    }
+  }
+  for (size_t col = 6; col-- > 0;)
+  {
+    for (size_t i = col + 1; i < 6; ++i)
+    {
+      b[col] -= a[col * 6 + i] * b[i];
+    }
+    b[col] /= a[col * 6 + col];
+  }
+}
+}  // namespace
+
+KinematicsModel::KinematicsModel(const DHParameters& parameters) : parameters_(parameters)
+{
+  for (size_t i = 0; i < 6; ++i)
+  {
+    cos_alpha_[i] = std::cos(parameters_.alpha[i]);
+    sin_alpha_[i] = std::sin(parameters_.alpha[i]);
+  }
+  setTcpOffset({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+}
+
+KinematicsModel::KinematicsModel(const primary_interface::KinematicsInfo& info)
+  : KinematicsModel(DHParameters{ info.dh_theta_, info.dh_a_, info.dh_d_, info.dh_alpha_ })
+{
+}
+
+void KinematicsModel::setTcpOffset(const vector6d_t& tcp_offset)
+{
+  tcp_offset_ = tcp_offset;
+  tcp_ = fromPose(tcp_offset);
+  tcp_inverse_ = invert(tcp_);
+}
+
+KinematicsModel::Transform KinematicsModel::flangeTransform(const vector6d_t& q, std::array<Transform, 6>* frames) const
+{
+  Transform t = { 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  for (size_t j = 0; j < 6; ++j)
+  {
+    const double c = std::cos(q[j] + parameters_.theta[j]);
+    const double s = std::sin(q[j] + parameters_.theta[j]);
+    for (size_t r = 0; r < 3; ++r)
+    {
+      const double x = t[r * 4];
+      const double y = t[r * 4 + 1];
+      const double z = t[r * 4 + 2];
+      const double u = y * c - x * s;
+      t[r * 4] = x * c + y * s;
+      t[r * 4 + 1] = u * cos_alpha_[j] + z * sin_alpha_[j];
+      t[r * 4 + 2] = z * cos_alpha_[j] - u * sin_alpha_[j];
+      t[r * 4 + 3] += t[r * 4] * parameters_.a[j] + z * parameters_.d[j];
+    }
+    if (frames != nullptr)
+    {
+      (*frames)[j] = t;
+    }
+  }
+  return t;
+}
+
+vector6d_t KinematicsModel::forward(const vector6d_t& q) const
+{
+  return toPose(multiply(flangeTransform(q, nullptr), tcp_));
+}
+
+void KinematicsModel::forward(const vector6d_t* q, vector6d_t* poses, const size_t count) const
+{
+  using namespace joint_space::detail;
+
+  size_t k = 0;
+  for (; k + 1 < count; k += 2)
+  {
+    // Same chain as flangeTransform(), each lane holding one configuration
+    Pair t[12];
+    for (size_t i = 0; i < 12; ++i)
+    {
+      t[i] = broadcast(i % 5 == 0 ? 1.0 : 0.0);
+    }
+    for (size_t j = 0; j < 6; ++j)
+    {
+      const double cosines[2] = { std::cos(q[k][j] + parameters_.theta[j]),
+                                  std::cos(q[k + 1][j] + parameters_.theta[j]) };
+      const double sines[2] = { std::sin(q[k][j] + parameters_.theta[j]),
+                                std::sin(q[k + 1][j] + parameters_.theta[j]) };
+      const Pair c = load(cosines);
+      const Pair s = load(sines);
+      const Pair ca = broadcast(cos_alpha_[j]);
+      const Pair sa = broadcast(sin_alpha_[j]);
+      const Pair a = broadcast(parameters_.a[j]);
+      const Pair d = broadcast(parameters_.d[j]);
+      for (size_t r = 0; r < 3; ++r)
+      {
+        const Pair x = t[r * 4];
+        const Pair y = t[r * 4 + 1];
+        const Pair z = t[r * 4 + 2];
+        const Pair u = sub(mul(y, c), mul(x, s));
+        t[r * 4] = add(mul(x, c), mul(y, s));
+        t[r * 4 + 1] = add(mul(u, ca), mul(z, sa));
+        t[r * 4 + 2] = sub(mul(z, ca), mul(u, sa));
+        t[r * 4 + 3] = add(t[r * 4 + 3], add(mul(t[r * 4], a), mul(z, d)));
+      }
+    }
+
+    Transform flange[2];
+    for (size_t i = 0; i < 12; ++i)
+    {
+      double lanes[2];
+      store(lanes, t[i]);
+      flange[0][i] = lanes[0];
+      flange[1][i] = lanes[1];
+    }
+    poses[k] = toPose(multiply(flange[0], tcp_));
+    poses[k + 1] = toPose(multiply(flange[1], tcp_));
+  }
+  if (k < count)
+  {
+    poses[k] = forward(q[k]);
+  }
+}
+
+void KinematicsModel::forward(const std::vector<vector6d_t>& q, std::vector<vector6d_t>& poses) const
+{
+  poses.resize(q.size());
+  forward(q.data(), poses.data(), q.size());
+}
+
+size_t KinematicsModel::closedFormFlange(const Transform& t, std::array<vector6d_t, MAX_IK_SOLUTIONS>& solutions) const
+{
+  // Closed-form solution for the nominal geometry of a UR arm, i.e. alpha = [pi/2, 0, 0, pi/2,
+  // -pi/2, 0] and only d1, a2, a3, d4, d5 and d6 being non-zero. The offsets along the parallel
+  // axes of joints 2 to 4 add up to the nominal d4.
+  const double d1 = parameters_.d[0];
+  const double a2 = parameters_.a[1];
+  const double a3 = parameters_.a[2];
+  const double d4 = parameters_.d[1] + parameters_.d[2] + parameters_.d[3];
+  const double d5 = parameters_.d[4];
+  const double d6 = parameters_.d[5];
+  const double eps = 1e-9;
+
+  size_t num_solutions = 0;
+
+  // Shoulder pan from the position of the wrist
+  const double wrist_a = d6 * t[6] - t[7];
+  const double wrist_b = d6 * t[2] - t[3];
+  const double wrist_r = std::sqrt(wrist_a * wrist_a + wrist_b * wrist_b);
+  if (wrist_r < eps || std::fabs(d4) > wrist_r + eps)
+  {
+    return 0;
+  }
+  const double shoulder_acos = std::acos(std::max(-1.0, std::min(1.0, d4 / wrist_r)));
+  const double shoulder_atan = std::atan2(-wrist_b, wrist_a);
+
+  for (const double q1 : { shoulder_atan + shoulder_acos, shoulder_atan - shoulder_acos })
+  {
+    const double c1 = std::cos(q1);
+    const double s1 = std::sin(q1);
+
+    // Wrist 2
+    const double wrist2_cos = (t[3] * s1 - t[7] * c1 - d4) / d6;
+    if (std::fabs(wrist2_cos) > 1.0 + eps)
+    {
+      continue;
+    }
+    const double wrist2_acos = std::acos(std::max(-1.0, std::min(1.0, wrist2_cos)));
+
+    for (const double q5 : { wrist2_acos, -wrist2_acos })
+    {
+      const double c5 = std::cos(q5);
+      const double s5 = std::sin(q5);
+
+      // Wrist 3, arbitrary if wrist 1 and wrist 3 are aligned
+      double q6 = 0.0;
+      if (std::fabs(s5) > eps)
+      {
+        const double sign = s5 < 0.0 ? -1.0 : 1.0;
+        q6 = std::atan2(-sign * (t[1] * s1 - t[5] * c1), sign * (t[0] * s1 - t[4] * c1));
+      }
+      const double c6 = std::cos(q6);
+      const double s6 = std::sin(q6);
+
+      // Shoulder lift, elbow and wrist 1 form a planar arm
+      const double x04x = -s5 * (t[2] * c1 + t[6] * s1) - c5 * (s6 * (t[1] * c1 + t[5] * s1) - c6 * (t[0] * c1 + t[4] * s1));
+      const double x04y = c5 * (t[8] * c6 - t[9] * s6) - t[10] * s5;
+      const double p13x =
+          d5 * (s6 * (t[0] * c1 + t[4] * s1) + c6 * (t[1] * c1 + t[5] * s1)) - d6 * (t[2] * c1 + t[6] * s1) + t[3] * c1 + t[7] * s1;
+      const double p13y = t[11] - d1 - d6 * t[10] + d5 * (t[9] * c6 + t[8] * s6);
+
+      const double c3 = (p13x * p13x + p13y * p13y - a2 * a2 - a3 * a3) / (2.0 * a2 * a3);
+      if (std::fabs(c3) > 1.0 + eps)
+      {
+        continue;
+      }
+      const double elbow_acos = std::acos(std::max(-1.0, std::min(1.0, c3)));
+      for (const double q3 : { elbow_acos, -elbow_acos })
+      {
+        const double s3 = std::sin(q3);
+        const double lift_a = a2 + a3 * c3;
+        const double lift_b = a3 * s3;
+        const double q2 = std::atan2(lift_a * p13y - lift_b * p13x, lift_a * p13x + lift_b * p13y);
+        const double c23 = std::cos(q2 + q3);
+        const double s23 = std::sin(q2 + q3);
+        const double q4 = std::atan2(c23 * x04y - s23 * x04x, x04x * c23 + x04y * s23);
+
+        const vector6d_t angles = { q1, q2, q3, q4, q5, q6 };
+        vector6d_t& solution = solutions[num_solutions++];
+        for (size_t j = 0; j < 6; ++j)
+        {
+          solution[j] = normalizeAngle(angles[j] - parameters_.theta[j]);
+        }
+      }
+    }
+  }
+  return num_solutions;
+}
+
+bool KinematicsModel::refine(const Transform& target, vector6d_t& q) const
+{
+  std::array<Transform, 6> frames;
+  for (size_t iteration = 0; iteration <= MAX_ITERATIONS; ++iteration)
+  {
+    const Transform current = multiply(flangeTransform(q, &frames), tcp_);
+
+    // Error of the position and of the orientation as rotation vector in the base frame
+    Transform rotation_error = multiply(target, invert(current));
+    const std::array<double, 3> rotation = rotationVector(rotation_error);
+    std::array<double, 6> error = { target[3] - current[3], target[7] - current[7], target[11] - current[11],
+                                    rotation[0],           rotation[1],           rotation[2] };
+    double error_norm = 0.0;
+    for (const double e : error)
+    {
+      error_norm = std::max(error_norm, std::fabs(e));
+    }
+    if (error_norm < CONVERGENCE_TOLERANCE)
+    {
+      return true;
+    }
+    if (iteration == MAX_ITERATIONS)
+    {
+      break;
+    }
+
+    // Geometric Jacobian, joint j rotates around the z axis of the frame before it
+    std::array<std::array<double, 6>, 6> jacobian;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      double z[3] = { 0.0, 0.0, 1.0 };
+      double o[3] = { 0.0, 0.0, 0.0 };
+      if (j > 0)
+      {
+        const Transform& frame = frames[j - 1];
+        z[0] = frame[2];
+        z[1] = frame[6];
+        z[2] = frame[10];
+        o[0] = frame[3];
+        o[1] = frame[7];
+        o[2] = frame[11];
+      }
+      const double p[3] = { current[3] - o[0], current[7] - o[1], current[11] - o[2] };
+      jacobian[j] = { z[1] * p[2] - z[2] * p[1], z[2] * p[0] - z[0] * p[2], z[0] * p[1] - z[1] * p[0], z[0], z[1], z[2] };
+    }
+
+    // Damped least squares step: dq = J^T (J J^T + lambda^2 I)^-1 e
+    std::array<double, 36> system;
+    for (size_t r = 0; r < 6; ++r)
+    {
+      for (size_t c = 0; c < 6; ++c)
+      {
+        double sum = r == c ? 1e-12 : 0.0;
+        for (size_t j = 0; j < 6; ++j)
+        {
+          sum += jacobian[j][r] * jacobian[j][c];
+        }
+        system[r * 6 + c] = sum;
+      }
+    }
+    solve(system, error);
+
+    vector6d_t step;
+    double largest = 0.0;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      step[j] = 0.0;
+      for (size_t r = 0; r < 6; ++r)
+      {
+        step[j] += jacobian[j][r] * error[r];
+      }
+      largest = std::max(largest, std::fabs(step[j]));
+    }
+    const double scale = largest > MAX_STEP ? MAX_STEP / largest : 1.0;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      q[j] += scale * step[j];
+    }
+  }
+  return false;
+}
+
+size_t KinematicsModel::inverse(const vector6d_t& pose, std::array<vector6d_t, MAX_IK_SOLUTIONS>& solutions) const
+{
+  const Transform target = fromPose(pose);
+  std::array<vector6d_t, MAX_IK_SOLUTIONS> candidates;
+  const size_t num_candidates = closedFormFlange(multiply(target, tcp_inverse_), candidates);
+
+  size_t num_solutions = 0;
+  for (size_t i = 0; i < num_candidates; ++i)
+  {
+    vector6d_t q = candidates[i];
+    if (!refine(target, q))
+    {
+      continue;
+    }
+    for (double& angle : q)
+    {
+      angle = normalizeAngle(angle);
+    }
+    bool duplicate = false;
+    for (size_t j = 0; j < num_solutions && !duplicate; ++j)
+    {
+      duplicate = joint_space::maxAbsDifference(q, solutions[j]) < 1e-6;
+    }
+    if (!duplicate)
+    {
+      solutions[num_solutions++] = q;
+    }
+  }
+  return num_solutions;
+}
+
+bool KinematicsModel::inverse(const vector6d_t& pose, const vector6d_t& q_near, vector6d_t& q) const
+{
+  const Transform target = fromPose(pose);
+  vector6d_t candidate = q_near;
+  if (refine(target, candidate) && joint_space::maxAbsDifference(candidate, q_near) < MAX_NEAR_DEVIATION)
+  {
+    q = candidate;
+    return true;
+  }
+
+  std::array<vector6d_t, MAX_IK_SOLUTIONS> solutions;
+  const size_t num_solutions = inverse(pose, solutions);
+  double best_distance = 0.0;
+  for (size_t i = 0; i < num_solutions; ++i)
+  {
+    // Shift every joint by multiples of 2 pi towards the nearby configuration
+    vector6d_t& solution = solutions[i];
+    double distance = 0.0;
+    for (size_t j = 0; j < 6; ++j)
+    {
+      solution[j] = q_near[j] + normalizeAngle(solution[j] - q_near[j]);
+      distance += (solution[j] - q_near[j]) * (solution[j] - q_near[j]);
+    }
+    if (i == 0 || distance < best_distance)
+    {
+      best_distance = distance;
+      q = solution;
+    }
+  }
+  return num_solutions > 0;
+}
+
+}  // namespace kinematics
+}  // namespace urcl
@@ -32,15 +32,21 @@
 #include "ur_client_library/default_log_handler.h"
 #include <cstdarg>
 #include <cstdio>
+#include <mutex>
+#include <string>
 
 namespace urcl
 {
+namespace detail
+{
+std::atomic<LogLevel> g_log_level(LogLevel::INFO);
+}  // namespace detail
+
 class Logger
 {
 public:
   Logger()
   {
-    log_level_ = LogLevel::INFO;
     log_handler_.reset(new DefaultLogHandler());
   }
 
@@ -72,21 +78,81 @@ public:
     log_handler_->log(file, line, level, txt);
   }
 
-  void setLogLevel(LogLevel level)
+private:
+  std::unique_ptr<LogHandler> log_handler_;
+};
+Logger g_logger;
+
+namespace
+{
+std::atomic<uint32_t> g_rate_limit_messages(20);
+std::atomic<int64_t> g_rate_limit_interval_ns(1000000000);
+
+// Call sites are static variables that might be created and used during static destruction, so
+// the registry is never destroyed.
+std::mutex& logSitesMutex()
+{
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::vector<LogSite*>& logSites()
+{
+  static std::vector<LogSite*>* sites = new std::vector<LogSite*>();
+  return *sites;
+}
+
+int64_t steadyNanoseconds()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// FNV-1a, only used to recognize repetitions of a message
+uint64_t hashMessage(const char* text)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (; *text != '\0'; ++text)
+  {
+    hash = (hash ^ static_cast<unsigned char>(*text)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Formats a message into a buffer on the stack. Most messages fit into it, so logging usually
+// doesn't allocate memory.
+class FormattedMessage
+{
+public:
+  FormattedMessage(const char* fmt, va_list args)
   {
-    log_level_ = level;
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    const int characters = std::vsnprintf(stack_buffer_, sizeof(stack_buffer_), fmt, args);
+    if (characters < 0)
+    {
+      stack_buffer_[0] = '\0';
+    }
+    else if (characters >= static_cast<int>(sizeof(stack_buffer_)))
+    {
+      heap_buffer_.reset(new char[characters + 1]);
+      std::vsnprintf(heap_buffer_.get(), characters + 1, fmt, args_copy);
+    }
+
+    va_end(args_copy);
   }
 
-  LogLevel getLogLevel()
+  const char* text() const
   {
-    return log_level_;
+    return heap_buffer_ ? heap_buffer_.get() : stack_buffer_;
   }
 
 private:
-  std::unique_ptr<LogHandler> log_handler_;
-  LogLevel log_level_;
+  char stack_buffer_[1024];
+  std::unique_ptr<char[]> heap_buffer_;
 };
-Logger g_logger;
+}  // namespace
 
 void registerLogHandler(std::unique_ptr<LogHandler> loghandler)
 {
@@ -100,36 +166,135 @@ void unregisterLogHandler()
 
 void setLogLevel(LogLevel level)
 {
-  g_logger.setLogLevel(level);
+  detail::g_log_level.store(level, std::memory_order_relaxed);
+}
+
+LogLevel getLogLevel()
+{
+  return detail::g_log_level.load(std::memory_order_relaxed);
 }
 
 void log(const char* file, int line, LogLevel level, const char* fmt, ...)
 {
-  if (level >= g_logger.getLogLevel())
+  if (isLogLevelEnabled(level))
   {
-    size_t buffer_size = 1024;
-    std::unique_ptr<char[]> buffer;
-    buffer.reset(new char[buffer_size]);
-
     va_list args;
     va_start(args, fmt);
-    va_list args_copy;
-    va_copy(args_copy, args);
+    FormattedMessage message(fmt, args);
+    va_end(args);
+
+    g_logger.log(file, line, level, message.text());
+  }
+}
+
+LogSite::LogSite(const char* file, int line, LogLevel level)
+  : file_(file)
+  , line_(line)
+  , level_(level)
+  , interval_start_(0)
+  , interval_count_(0)
+  , last_message_hash_(0)
+  , last_message_time_(0)
+  , pending_suppressed_(0)
+  , logged_(0)
+  , suppressed_(0)
+{
+  std::lock_guard<std::mutex> lock(logSitesMutex());
+  logSites().push_back(this);
+}
+
+bool LogSite::admit()
+{
+  const uint32_t max_messages = g_rate_limit_messages.load(std::memory_order_relaxed);
+  if (max_messages == 0)
+  {
+    return true;
+  }
+
+  const int64_t now = steadyNanoseconds();
+  int64_t start = interval_start_.load(std::memory_order_relaxed);
+  if (now - start >= g_rate_limit_interval_ns.load(std::memory_order_relaxed) &&
+      interval_start_.compare_exchange_strong(start, now, std::memory_order_relaxed))
+  {
+    interval_count_.store(0, std::memory_order_relaxed);
+  }
 
-    size_t characters = 1 + std::vsnprintf(buffer.get(), buffer_size, fmt, args);
+  if (interval_count_.fetch_add(1, std::memory_order_relaxed) < max_messages)
+  {
+    return true;
+  }
+  pending_suppressed_.fetch_add(1, std::memory_order_relaxed);
+  suppressed_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
 
-    if (characters >= buffer_size)
+void log(LogSite& site, const char* fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  FormattedMessage message(fmt, args);
+  va_end(args);
+
+  if (g_rate_limit_messages.load(std::memory_order_relaxed) > 0)
+  {
+    // A message repeating the previous one is only logged once per interval. Races between threads
+    // logging from the same site at most let a repetition through.
+    const int64_t now = steadyNanoseconds();
+    const uint64_t hash = hashMessage(message.text());
+    if (site.last_message_hash_.exchange(hash, std::memory_order_relaxed) == hash &&
+        now - site.last_message_time_.load(std::memory_order_relaxed) <
+            g_rate_limit_interval_ns.load(std::memory_order_relaxed))
     {
-      buffer_size = characters + 1;
-      buffer.reset(new char[buffer_size]);
-      std::vsnprintf(buffer.get(), buffer_size, fmt, args_copy);
+      site.pending_suppressed_.fetch_add(1, std::memory_order_relaxed);
+      site.suppressed_.fetch_add(1, std::memory_order_relaxed);
+      return;
     }
+    site.last_message_time_.store(now, std::memory_order_relaxed);
+  }
 
-    va_end(args);
-    va_end(args_copy);
+  site.logged_.fetch_add(1, std::memory_order_relaxed);
+  const uint64_t suppressed = site.pending_suppressed_.exchange(0, std::memory_order_relaxed);
+  if (suppressed == 0)
+  {
+    g_logger.log(site.file_, site.line_, site.level_, message.text());
+    return;
+  }
 
-    g_logger.log(file, line, level, buffer.get());
+  // Only happens once per interval during a storm of messages, so the allocation doesn't matter
+  std::string text(message.text());
+  text += " (" + std::to_string(suppressed) + " similar messages suppressed)";
+  g_logger.log(site.file_, site.line_, site.level_, text.c_str());
+}
+
+void setLogRateLimit(uint32_t max_messages, std::chrono::milliseconds interval)
+{
+  g_rate_limit_messages.store(max_messages, std::memory_order_relaxed);
+  g_rate_limit_interval_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+                                 std::memory_order_relaxed);
+}
+
+std::vector<LogSiteStatistics> getLogSiteStatistics()
+{
+  std::lock_guard<std::mutex> lock(logSitesMutex());
+  std::vector<LogSiteStatistics> statistics;
+  statistics.reserve(logSites().size());
+  for (const LogSite* site : logSites())
+  {
+    statistics.push_back({ site->file_, site->line_, site->level_, site->logged_.load(std::memory_order_relaxed),
+                           site->suppressed_.load(std::memory_order_relaxed) });
+  }
+  return statistics;
+}
+
+uint64_t getSuppressedLogCount()
+{
+  std::lock_guard<std::mutex> lock(logSitesMutex());
+  uint64_t suppressed = 0;
+  for (const LogSite* site : logSites())
+  {
+    suppressed += site->suppressed_.load(std::memory_order_relaxed);
   }
+  return suppressed;
 }
 
 }  // namespace urcl
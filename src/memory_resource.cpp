@@ -0,0 +1,85 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/memory_resource.h"
+
+#include <atomic>
+
+namespace urcl
+{
+namespace
+{
+std::atomic<std::pmr::memory_resource*> g_memory_resource{ nullptr };
+
+// Every allocation is preceded by the resource and the size it has been allocated with, so it can
+// be freed without knowing either. The header keeps the object maximally aligned.
+struct AllocationHeader
+{
+  std::pmr::memory_resource* resource;
+  std::size_t size;
+};
+constexpr std::size_t HEADER_SIZE =
+    (sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+}  // namespace
+
+void setMemoryResource(std::pmr::memory_resource* resource)
+{
+  g_memory_resource.store(resource, std::memory_order_release);
+}
+
+std::pmr::memory_resource* getMemoryResource()
+{
+  std::pmr::memory_resource* resource = g_memory_resource.load(std::memory_order_acquire);
+  return resource != nullptr ? resource : std::pmr::new_delete_resource();
+}
+
+void* MemoryResourceAllocated::operator new(std::size_t size)
+{
+  std::pmr::memory_resource* resource = getMemoryResource();
+  const std::size_t total = HEADER_SIZE + size;
+  void* memory = resource->allocate(total, alignof(std::max_align_t));
+  AllocationHeader* header = static_cast<AllocationHeader*>(memory);
+  header->resource = resource;
+  header->size = total;
+  return static_cast<char*>(memory) + HEADER_SIZE;
+}
+
+void MemoryResourceAllocated::operator delete(void* ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+  void* memory = static_cast<char*>(ptr) - HEADER_SIZE;
+  const AllocationHeader* header = static_cast<const AllocationHeader*>(memory);
+  header->resource->deallocate(memory, header->size, alignof(std::max_align_t));
+}
+
+}  // namespace urcl
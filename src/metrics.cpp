@@ -0,0 +1,314 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/metrics.h"
+#include "ur_client_library/exceptions.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace urcl
+{
+namespace
+{
+bool isValidName(const std::string& name, const bool allow_colon)
+{
+  if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+  {
+    return false;
+  }
+  return std::all_of(name.begin(), name.end(), [allow_colon](const char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || (allow_colon && c == ':');
+  });
+}
+
+std::string formatValue(const double value)
+{
+  if (std::isnan(value))
+  {
+    return "NaN";
+  }
+  if (std::isinf(value))
+  {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  // Use the shortest representation that reads back as the same value
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+  if (std::strtod(buffer, nullptr) != value)
+  {
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  }
+  return buffer;
+}
+
+void appendEscaped(std::string& out, const std::string& text, const bool escape_quotes)
+{
+  for (const char c : text)
+  {
+    if (c == '\\')
+    {
+      out += "\\\\";
+    }
+    else if (c == '\n')
+    {
+      out += "\\n";
+    }
+    else if (c == '"' && escape_quotes)
+    {
+      out += "\\\"";
+    }
+    else
+    {
+      out += c;
+    }
+  }
+}
+
+// Formats the labels without the surrounding braces, so more labels can be appended
+std::string formatLabels(const MetricLabels& labels, const bool is_histogram)
+{
+  std::string formatted;
+  for (const auto& label : labels)
+  {
+    if (!isValidName(label.first, false) || label.first.compare(0, 2, "__") == 0 ||
+        (is_histogram && label.first == "le"))
+    {
+      throw UrException("Invalid metric label name '" + label.first + "'");
+    }
+    if (!formatted.empty())
+    {
+      formatted += ",";
+    }
+    formatted += label.first + "=\"";
+    appendEscaped(formatted, label.second, true);
+    formatted += "\"";
+  }
+  return formatted;
+}
+
+std::string braced(const std::string& labels)
+{
+  return labels.empty() ? std::string() : "{" + labels + "}";
+}
+
+void atomicAdd(std::atomic<double>& value, const double amount)
+{
+  double current = value.load(std::memory_order_relaxed);
+  while (!value.compare_exchange_weak(current, current + amount, std::memory_order_relaxed))
+  {
+  }
+}
+}  // namespace
+
+void Gauge::add(const double amount)
+{
+  atomicAdd(value_, amount);
+}
+
+Histogram::Histogram(const std::vector<double>& upper_bounds)
+  : upper_bounds_(upper_bounds), buckets_(new std::atomic<uint64_t>[upper_bounds.size() + 1]), sum_(0.0)
+{
+  for (size_t i = 0; i + 1 < upper_bounds_.size(); ++i)
+  {
+    if (!(upper_bounds_[i] < upper_bounds_[i + 1]))
+    {
+      throw UrException("Histogram bucket bounds have to be ascending");
+    }
+  }
+  for (size_t i = 0; i <= upper_bounds_.size(); ++i)
+  {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(const double value)
+{
+  const size_t bucket = std::lower_bound(upper_bounds_.begin(), upper_bounds_.end(), value) - upper_bounds_.begin();
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  atomicAdd(sum_, value);
+}
+
+uint64_t Histogram::getBucketCount(const size_t bucket) const
+{
+  if (bucket > upper_bounds_.size())
+  {
+    return 0;
+  }
+  return buckets_[bucket].load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getCount() const
+{
+  uint64_t count = 0;
+  for (size_t i = 0; i <= upper_bounds_.size(); ++i)
+  {
+    count += buckets_[i].load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+std::vector<double> Histogram::defaultDurationBounds()
+{
+  return { 50e-6, 100e-6, 250e-6, 500e-6, 1e-3, 2.5e-3, 5e-3, 10e-3, 25e-3, 50e-3, 100e-3, 250e-3, 500e-3, 1.0 };
+}
+
+MetricsRegistry::Family& MetricsRegistry::getFamily(const std::string& name, const std::string& help, const Type type)
+{
+  if (!isValidName(name, true))
+  {
+    throw UrException("Invalid metric name '" + name + "'");
+  }
+  auto it = families_.find(name);
+  if (it == families_.end())
+  {
+    Family family;
+    family.type = type;
+    family.help = help;
+    it = families_.emplace(name, std::move(family)).first;
+  }
+  else if (it->second.type != type)
+  {
+    throw UrException("Metric '" + name + "' has already been registered with another type");
+  }
+  return it->second;
+}
+
+Counter& MetricsRegistry::getCounter(const std::string& name, const std::string& help, const MetricLabels& labels)
+{
+  const std::string key = formatLabels(labels, false);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<Counter>& counter = getFamily(name, help, Type::COUNTER).counters[key];
+  if (!counter)
+  {
+    counter = std::make_unique<Counter>();
+  }
+  return *counter;
+}
+
+Gauge& MetricsRegistry::getGauge(const std::string& name, const std::string& help, const MetricLabels& labels)
+{
+  const std::string key = formatLabels(labels, false);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<Gauge>& gauge = getFamily(name, help, Type::GAUGE).gauges[key];
+  if (!gauge)
+  {
+    gauge = std::make_unique<Gauge>();
+  }
+  return *gauge;
+}
+
+Histogram& MetricsRegistry::getHistogram(const std::string& name, const std::string& help,
+                                         const std::vector<double>& upper_bounds, const MetricLabels& labels)
+{
+  const std::string key = formatLabels(labels, true);
+  // Validates the bounds before anything is registered
+  auto created = std::make_unique<Histogram>(upper_bounds);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Family& family = getFamily(name, help, Type::HISTOGRAM);
+  if (family.histograms.empty())
+  {
+    family.upper_bounds = upper_bounds;
+  }
+  else if (family.upper_bounds != upper_bounds)
+  {
+    throw UrException("Histogram '" + name + "' has already been registered with other bucket bounds");
+  }
+  std::unique_ptr<Histogram>& histogram = family.histograms[key];
+  if (!histogram)
+  {
+    histogram = std::move(created);
+  }
+  return *histogram;
+}
+
+std::string MetricsRegistry::exportText() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string out;
+  for (const auto& entry : families_)
+  {
+    const std::string& name = entry.first;
+    const Family& family = entry.second;
+    out += "# HELP " + name + " ";
+    appendEscaped(out, family.help, false);
+    out += "\n";
+
+    switch (family.type)
+    {
+      case Type::COUNTER:
+        out += "# TYPE " + name + " counter\n";
+        for (const auto& counter : family.counters)
+        {
+          out += name + braced(counter.first) + " " + std::to_string(counter.second->getValue()) + "\n";
+        }
+        break;
+      case Type::GAUGE:
+        out += "# TYPE " + name + " gauge\n";
+        for (const auto& gauge : family.gauges)
+        {
+          out += name + braced(gauge.first) + " " + formatValue(gauge.second->getValue()) + "\n";
+        }
+        break;
+      case Type::HISTOGRAM:
+        out += "# TYPE " + name + " histogram\n";
+        for (const auto& histogram : family.histograms)
+        {
+          const std::string prefix = histogram.first.empty() ? "" : histogram.first + ",";
+          const std::vector<double>& bounds = histogram.second->getUpperBounds();
+          // Buckets are cumulative in the exported format
+          uint64_t cumulative = 0;
+          for (size_t i = 0; i <= bounds.size(); ++i)
+          {
+            cumulative += histogram.second->getBucketCount(i);
+            const std::string bound = i < bounds.size() ? formatValue(bounds[i]) : "+Inf";
+            out += name + "_bucket{" + prefix + "le=\"" + bound + "\"} " + std::to_string(cumulative) + "\n";
+          }
+          out += name + "_sum" + braced(histogram.first) + " " + formatValue(histogram.second->getSum()) + "\n";
+          out += name + "_count" + braced(histogram.first) + " " + std::to_string(cumulative) + "\n";
+        }
+        break;
+    }
+  }
+  return out;
+}
+
+MetricsRegistry& getMetricsRegistry()
+{
+  // Never destroyed, as components might report metrics during static destruction
+  static MetricsRegistry* registry = new MetricsRegistry();
+  return *registry;
+}
+
+}  // namespace urcl
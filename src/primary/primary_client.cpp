@@ -0,0 +1,376 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/primary_client.h"
+
+#include <algorithm>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+#include "ur_client_library/primary/static_primary_consumer.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+PrimaryClient::PrimaryClient(const std::string& robot_ip, comm::INotifier& notifier, const int port)
+  : stream_(robot_ip, port)
+  , producer_(stream_, parser_)
+  , dispatcher_(*this)
+  , calibration_(RobotStateType::KINEMATICS_INFO)
+  , calibration_received_(false)
+  , version_received_(false)
+  , configuration_data_received_(false)
+{
+  parser_.setRobotStateFrames(true);
+  pipeline_.reset(new comm::Pipeline<PrimaryPackage>(producer_, &dispatcher_, "PrimaryClient Pipeline", notifier));
+  pipeline_->setMetricLabels({ { "host", robot_ip } });
+}
+
+PrimaryClient::~PrimaryClient()
+{
+  stop();
+}
+
+void PrimaryClient::start(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
+{
+  {
+    // The robot may have been recalibrated while the client was stopped
+    std::lock_guard<std::mutex> lock(calibration_mutex_);
+    calibration_received_ = false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(configuration_mutex_);
+    version_received_ = false;
+    configuration_data_received_ = false;
+  }
+  URCL_LOG_DEBUG("Starting primary client pipeline");
+  pipeline_->init(max_num_tries, reconnection_time);
+  pipeline_->run();
+}
+
+void PrimaryClient::stop()
+{
+  pipeline_->stop();
+  stream_.close();
+}
+
+void PrimaryClient::setPipelineQueue(const size_t capacity, const comm::OverflowPolicy policy)
+{
+  // The queue must not be replaced while the consumer thread uses it
+  const bool running = pipeline_->isRunning();
+  pipeline_->stop();
+  pipeline_->setQueue(capacity, policy);
+  if (running)
+  {
+    pipeline_->run();
+  }
+}
+
+bool PrimaryClient::reconnect()
+{
+  stop();
+  try
+  {
+    start(1, std::chrono::milliseconds(0));
+  }
+  catch (const UrException& e)
+  {
+    URCL_LOG_ERROR("%s", e.what());
+    return false;
+  }
+  return true;
+}
+
+void PrimaryClient::setRobotStateSubscription(const std::vector<RobotStateType>& types)
+{
+  parser_.setRobotStateSubscription(types);
+}
+
+void PrimaryClient::setRobotMessageEventRing(RobotMessageEventRing* ring)
+{
+  parser_.setRobotMessageEventRing(ring);
+}
+
+void PrimaryClient::addPrimaryConsumer(std::shared_ptr<comm::IConsumer<PrimaryPackage>> consumer)
+{
+  std::lock_guard<std::mutex> lock(consumers_mutex_);
+  consumers_.push_back(std::move(consumer));
+}
+
+void PrimaryClient::removePrimaryConsumer(const std::shared_ptr<comm::IConsumer<PrimaryPackage>>& consumer)
+{
+  std::lock_guard<std::mutex> lock(consumers_mutex_);
+  consumers_.erase(std::remove(consumers_.begin(), consumers_.end(), consumer), consumers_.end());
+}
+
+void PrimaryClient::setRobotMessageCallback(std::function<void(const RobotMessage&)> callback)
+{
+  std::lock_guard<std::mutex> lock(consumers_mutex_);
+  robot_message_callback_ = std::move(callback);
+}
+
+void PrimaryClient::setErrorCodeCallback(std::function<void(const ErrorCodeMessage&)> callback)
+{
+  std::lock_guard<std::mutex> lock(consumers_mutex_);
+  error_code_callback_ = std::move(callback);
+}
+
+void PrimaryClient::setRuntimeExceptionCallback(std::function<void(const RuntimeExceptionMessage&)> callback)
+{
+  std::lock_guard<std::mutex> lock(consumers_mutex_);
+  runtime_exception_callback_ = std::move(callback);
+}
+
+bool PrimaryClient::sendScript(const std::string& program)
+{
+  // urscripts (snippets) must end with a newline, or otherwise the controller's runtime will
+  // not execute them. To avoid problems, we always just append a newline here, even if
+  // there may already be one.
+  const std::string program_with_newline = program + '\n';
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(program_with_newline.c_str());
+  size_t written;
+
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  if (stream_.write(data, program_with_newline.size(), written))
+  {
+    URCL_LOG_DEBUG("Sent program to robot:\n%s", program_with_newline.c_str());
+    return true;
+  }
+
+  // The connection is usually kept alive by the pipeline. If it was closed nevertheless, e.g. when
+  // switching the robot from remote to local control and back, it is re-established once.
+  URCL_LOG_WARN("Could not send program to robot, reconnecting to the primary interface...");
+  if (reconnect() && stream_.write(data, program_with_newline.size(), written))
+  {
+    URCL_LOG_DEBUG("Sent program to robot:\n%s", program_with_newline.c_str());
+    return true;
+  }
+  URCL_LOG_ERROR("Could not send program to robot, the primary interface is not connected");
+  return false;
+}
+
+bool PrimaryClient::checkCalibration(const std::string& checksum)
+{
+  std::unique_lock<std::mutex> lock(calibration_mutex_);
+  calibration_cv_.wait(lock, [this]() { return calibration_received_; });
+  URCL_LOG_DEBUG("Got calibration information from robot.");
+  return calibration_hash_ == checksum;
+}
+
+bool PrimaryClient::getCalibrationHash(std::string& hash)
+{
+  std::lock_guard<std::mutex> lock(calibration_mutex_);
+  if (!calibration_received_)
+  {
+    return false;
+  }
+  hash = calibration_hash_;
+  return true;
+}
+
+bool PrimaryClient::getCalibration(KinematicsInfo& calibration)
+{
+  std::lock_guard<std::mutex> lock(calibration_mutex_);
+  if (!calibration_received_)
+  {
+    return false;
+  }
+  calibration.checksum_ = calibration_.checksum_;
+  calibration.dh_theta_ = calibration_.dh_theta_;
+  calibration.dh_a_ = calibration_.dh_a_;
+  calibration.dh_d_ = calibration_.dh_d_;
+  calibration.dh_alpha_ = calibration_.dh_alpha_;
+  calibration.calibration_status_ = calibration_.calibration_status_;
+  return true;
+}
+
+bool PrimaryClient::getRobotConfiguration(RobotConfiguration& configuration, const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(configuration_mutex_);
+  if (!configuration_cv_.wait_for(lock, timeout,
+                                  [this]() { return version_received_ && configuration_data_received_; }))
+  {
+    return false;
+  }
+  configuration = configuration_;
+  return true;
+}
+
+void PrimaryClient::setSocketOptions(const comm::SocketOptions& options)
+{
+  stream_.setSocketOptions(options);
+}
+
+bool PrimaryClient::getTcpStatistics(comm::TcpStatistics& stats)
+{
+  return stream_.getTcpStatistics(stats);
+}
+
+void PrimaryClient::updateCalibration(const PrimaryPackage& product)
+{
+  const KinematicsInfo* info = nullptr;
+  if (comm::PackageClassTraits<KinematicsInfo>::matches(product))
+  {
+    info = static_cast<const KinematicsInfo*>(&product);
+  }
+  else if (comm::PackageClassTraits<RobotStateFrame>::matches(product))
+  {
+    info = static_cast<const RobotStateFrame&>(product).getPackage<KinematicsInfo>();
+  }
+  if (info == nullptr)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(calibration_mutex_);
+  // The kinematics info is sent with every robot state package, but hardly ever changes. It is
+  // only hashed again if the received calibration differs from the one hashed before.
+  if (calibration_received_ && info->checksum_ == calibration_.checksum_ && info->dh_theta_ == calibration_.dh_theta_ &&
+      info->dh_a_ == calibration_.dh_a_ && info->dh_d_ == calibration_.dh_d_ &&
+      info->dh_alpha_ == calibration_.dh_alpha_)
+  {
+    return;
+  }
+  calibration_.checksum_ = info->checksum_;
+  calibration_.dh_theta_ = info->dh_theta_;
+  calibration_.dh_a_ = info->dh_a_;
+  calibration_.dh_d_ = info->dh_d_;
+  calibration_.dh_alpha_ = info->dh_alpha_;
+  calibration_.calibration_status_ = info->calibration_status_;
+  calibration_hash_ = info->toHash();
+  calibration_received_ = true;
+  calibration_cv_.notify_all();
+}
+
+void PrimaryClient::updateConfiguration(const PrimaryPackage& product)
+{
+  const bool is_version = comm::PackageClassTraits<VersionMessage>::matches(product);
+  const bool is_frame = comm::PackageClassTraits<RobotStateFrame>::matches(product);
+  if (!is_version && !is_frame)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(configuration_mutex_);
+  if (is_version)
+  {
+    configuration_.setVersion(static_cast<const VersionMessage&>(product));
+    version_received_ = true;
+  }
+  else if (!configuration_data_received_)
+  {
+    // The configuration is sent with every robot state package, but only taken once per connection.
+    const auto& frame = static_cast<const RobotStateFrame&>(product);
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+      const RobotStateView view = frame.getView(i);
+      if (view.getType() != RobotStateType::CONFIGURATION_DATA)
+      {
+        continue;
+      }
+      const ConfigurationDataView configuration_view(view.data(), view.size());
+      if (configuration_view.isValid())
+      {
+        configuration_.setConfiguration(configuration_view);
+        configuration_data_received_ = true;
+      }
+      break;
+    }
+  }
+  if (version_received_ && configuration_data_received_)
+  {
+    configuration_cv_.notify_all();
+  }
+}
+
+void PrimaryClient::dispatchMessage(const PrimaryPackage& product)
+{
+  if (!comm::PackageClassTraits<RobotMessage>::matches(product))
+  {
+    return;
+  }
+  const auto& message = static_cast<const RobotMessage&>(product);
+  if (robot_message_callback_)
+  {
+    robot_message_callback_(message);
+  }
+  if (error_code_callback_ && comm::PackageClassTraits<ErrorCodeMessage>::matches(product))
+  {
+    error_code_callback_(static_cast<const ErrorCodeMessage&>(message));
+  }
+  if (runtime_exception_callback_ && comm::PackageClassTraits<RuntimeExceptionMessage>::matches(product))
+  {
+    runtime_exception_callback_(static_cast<const RuntimeExceptionMessage&>(message));
+  }
+}
+
+bool PrimaryClient::forwardToConsumers(std::shared_ptr<PrimaryPackage> product)
+{
+  bool result = true;
+  for (auto& consumer : consumers_)
+  {
+    result = consumer->consume(product) && result;
+  }
+  return result;
+}
+
+bool PrimaryClient::Dispatcher::consume(std::shared_ptr<PrimaryPackage> product)
+{
+  if (product == nullptr)
+  {
+    return false;
+  }
+  client_.updateCalibration(*product);
+  client_.updateConfiguration(*product);
+  std::lock_guard<std::mutex> lock(client_.consumers_mutex_);
+  client_.dispatchMessage(*product);
+  return client_.forwardToConsumers(std::move(product));
+}
+
+bool PrimaryClient::Dispatcher::consumeProduct(std::unique_ptr<PrimaryPackage>& product)
+{
+  if (product == nullptr)
+  {
+    return false;
+  }
+  client_.updateCalibration(*product);
+  client_.updateConfiguration(*product);
+  std::lock_guard<std::mutex> lock(client_.consumers_mutex_);
+  client_.dispatchMessage(*product);
+  // Only pay for a shared pointer if anybody keeps the package
+  if (client_.consumers_.empty())
+  {
+    return true;
+  }
+  return client_.forwardToConsumers(std::shared_ptr<PrimaryPackage>(std::move(product)));
+}
+}  // namespace primary_interface
+}  // namespace urcl
@@ -0,0 +1,315 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_configuration.h"
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+namespace
+{
+constexpr const char* FORMAT_HEADER = "urcl_robot_configuration 1";
+
+void writeArray(std::ostream& out, const char* key, const vector6d_t& values)
+{
+  out << key;
+  for (const double value : values)
+  {
+    out << " " << value;
+  }
+  out << "\n";
+}
+
+bool readArray(std::istream& in, vector6d_t& values)
+{
+  for (double& value : values)
+  {
+    if (!(in >> value))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+void RobotConfiguration::setVersion(const VersionMessage& message)
+{
+  version.major = message.major_version_;
+  version.minor = message.minor_version_;
+  version.bugfix = static_cast<uint32_t>(message.svn_version_);
+  version.build = static_cast<uint32_t>(message.build_number_);
+  project_name = message.project_name_;
+}
+
+void RobotConfiguration::setConfiguration(const ConfigurationDataView& view)
+{
+  joint_min_limits = view.getJointMinLimits();
+  joint_max_limits = view.getJointMaxLimits();
+  joint_max_speeds = view.getJointMaxSpeeds();
+  joint_max_accelerations = view.getJointMaxAccelerations();
+  default_joint_speed = view.getDefaultJointSpeed();
+  default_joint_acceleration = view.getDefaultJointAcceleration();
+  default_tool_speed = view.getDefaultToolSpeed();
+  default_tool_acceleration = view.getDefaultToolAcceleration();
+  eq_radius = view.getEqRadius();
+  dh_a = view.getDHa();
+  dh_d = view.getDHd();
+  dh_alpha = view.getDHAlpha();
+  dh_theta = view.getDHTheta();
+  masterboard_version = view.getMasterboardVersion();
+  controller_box_type = view.getControllerBoxType();
+  robot_type = view.getRobotType();
+  robot_sub_type = view.getRobotSubType();
+}
+
+bool RobotConfiguration::isWithinJointLimits(const vector6d_t& positions) const
+{
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    if (positions[i] < joint_min_limits[i] || positions[i] > joint_max_limits[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool operator==(const RobotConfiguration& c1, const RobotConfiguration& c2)
+{
+  return c1.version == c2.version && c1.project_name == c2.project_name && c1.joint_min_limits == c2.joint_min_limits &&
+         c1.joint_max_limits == c2.joint_max_limits && c1.joint_max_speeds == c2.joint_max_speeds &&
+         c1.joint_max_accelerations == c2.joint_max_accelerations && c1.default_joint_speed == c2.default_joint_speed &&
+         c1.default_joint_acceleration == c2.default_joint_acceleration &&
+         c1.default_tool_speed == c2.default_tool_speed && c1.default_tool_acceleration == c2.default_tool_acceleration &&
+         c1.eq_radius == c2.eq_radius && c1.dh_a == c2.dh_a && c1.dh_d == c2.dh_d && c1.dh_alpha == c2.dh_alpha &&
+         c1.dh_theta == c2.dh_theta && c1.masterboard_version == c2.masterboard_version &&
+         c1.controller_box_type == c2.controller_box_type && c1.robot_type == c2.robot_type &&
+         c1.robot_sub_type == c2.robot_sub_type;
+}
+
+bool operator!=(const RobotConfiguration& c1, const RobotConfiguration& c2)
+{
+  return !(c1 == c2);
+}
+
+RobotConfigurationCache::RobotConfigurationCache(const std::string& directory) : directory_(directory)
+{
+  if (!directory_.empty() && directory_.back() != '/')
+  {
+    directory_ += '/';
+  }
+}
+
+std::string RobotConfigurationCache::getPath(const std::string& serial_number) const
+{
+  if (serial_number.empty())
+  {
+    throw UrException("Cannot cache the robot configuration for an empty serial number.");
+  }
+  for (const char c : serial_number)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+    {
+      throw UrException("Serial number '" + serial_number +
+                        "' contains characters that cannot be used for caching the robot configuration.");
+    }
+  }
+  return directory_ + serial_number + ".conf";
+}
+
+bool RobotConfigurationCache::store(const std::string& serial_number, const RobotConfiguration& configuration) const
+{
+  const std::string path = getPath(serial_number);
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    if (!out)
+    {
+      URCL_LOG_ERROR("Could not open %s for writing the robot configuration.", tmp_path.c_str());
+      return false;
+    }
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << FORMAT_HEADER << "\n";
+    out << "version " << configuration.version.major << " " << configuration.version.minor << " "
+        << configuration.version.bugfix << " " << configuration.version.build << "\n";
+    writeArray(out, "joint_min_limits", configuration.joint_min_limits);
+    writeArray(out, "joint_max_limits", configuration.joint_max_limits);
+    writeArray(out, "joint_max_speeds", configuration.joint_max_speeds);
+    writeArray(out, "joint_max_accelerations", configuration.joint_max_accelerations);
+    out << "defaults " << configuration.default_joint_speed << " " << configuration.default_joint_acceleration << " "
+        << configuration.default_tool_speed << " " << configuration.default_tool_acceleration << "\n";
+    out << "eq_radius " << configuration.eq_radius << "\n";
+    writeArray(out, "dh_a", configuration.dh_a);
+    writeArray(out, "dh_d", configuration.dh_d);
+    writeArray(out, "dh_alpha", configuration.dh_alpha);
+    writeArray(out, "dh_theta", configuration.dh_theta);
+    out << "hardware " << configuration.masterboard_version << " " << configuration.controller_box_type << " "
+        << configuration.robot_type << " " << configuration.robot_sub_type << "\n";
+    // The project name is free text and therefore always the last line.
+    out << "project_name " << configuration.project_name << "\n";
+    if (!out)
+    {
+      URCL_LOG_ERROR("Could not write the robot configuration to %s.", tmp_path.c_str());
+      return false;
+    }
+  }
+  // Replacing the file in one step makes sure readers never see a partially written snapshot.
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+  {
+    URCL_LOG_ERROR("Could not move the robot configuration to %s.", path.c_str());
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool RobotConfigurationCache::load(const std::string& serial_number, RobotConfiguration& configuration) const
+{
+  const std::string path = getPath(serial_number);
+  std::ifstream in(path);
+  if (!in)
+  {
+    return false;
+  }
+
+  std::string line;
+  if (!std::getline(in, line) || line != FORMAT_HEADER)
+  {
+    URCL_LOG_WARN("Ignoring robot configuration %s with unknown format.", path.c_str());
+    return false;
+  }
+
+  RobotConfiguration loaded;
+  // Every key has to be present, a snapshot missing any of them is rejected as a whole.
+  const std::vector<std::string> required_keys = { "version",          "joint_min_limits", "joint_max_limits",
+                                                   "joint_max_speeds", "joint_max_accelerations",
+                                                   "defaults",         "eq_radius",        "dh_a",
+                                                   "dh_d",             "dh_alpha",         "dh_theta",
+                                                   "hardware",         "project_name" };
+  size_t found_keys = 0;
+  for (const auto& expected_key : required_keys)
+  {
+    if (!std::getline(in, line))
+    {
+      break;
+    }
+    std::istringstream ss(line);
+    std::string key;
+    ss >> key;
+    if (key != expected_key)
+    {
+      break;
+    }
+
+    bool ok = true;
+    if (key == "version")
+    {
+      ok = static_cast<bool>(ss >> loaded.version.major >> loaded.version.minor >> loaded.version.bugfix >>
+                             loaded.version.build);
+    }
+    else if (key == "joint_min_limits")
+    {
+      ok = readArray(ss, loaded.joint_min_limits);
+    }
+    else if (key == "joint_max_limits")
+    {
+      ok = readArray(ss, loaded.joint_max_limits);
+    }
+    else if (key == "joint_max_speeds")
+    {
+      ok = readArray(ss, loaded.joint_max_speeds);
+    }
+    else if (key == "joint_max_accelerations")
+    {
+      ok = readArray(ss, loaded.joint_max_accelerations);
+    }
+    else if (key == "defaults")
+    {
+      ok = static_cast<bool>(ss >> loaded.default_joint_speed >> loaded.default_joint_acceleration >>
+                             loaded.default_tool_speed >> loaded.default_tool_acceleration);
+    }
+    else if (key == "eq_radius")
+    {
+      ok = static_cast<bool>(ss >> loaded.eq_radius);
+    }
+    else if (key == "dh_a")
+    {
+      ok = readArray(ss, loaded.dh_a);
+    }
+    else if (key == "dh_d")
+    {
+      ok = readArray(ss, loaded.dh_d);
+    }
+    else if (key == "dh_alpha")
+    {
+      ok = readArray(ss, loaded.dh_alpha);
+    }
+    else if (key == "dh_theta")
+    {
+      ok = readArray(ss, loaded.dh_theta);
+    }
+    else if (key == "hardware")
+    {
+      ok = static_cast<bool>(ss >> loaded.masterboard_version >> loaded.controller_box_type >> loaded.robot_type >>
+                             loaded.robot_sub_type);
+    }
+    else if (key == "project_name")
+    {
+      loaded.project_name = line.size() > key.size() + 1 ? line.substr(key.size() + 1) : "";
+    }
+    if (!ok)
+    {
+      break;
+    }
+    ++found_keys;
+  }
+
+  if (found_keys != required_keys.size())
+  {
+    URCL_LOG_WARN("Ignoring incomplete robot configuration %s.", path.c_str());
+    return false;
+  }
+  configuration = loaded;
+  return true;
+}
+}  // namespace primary_interface
+}  // namespace urcl
@@ -0,0 +1,248 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_message_events.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+bool RobotMessageEvent::isRepetitionOf(const RobotMessageEvent& other) const
+{
+  return type == other.type && source == other.source && code == other.code && argument == other.argument &&
+         report_level == other.report_level && line_number == other.line_number &&
+         column_number == other.column_number && getText() == other.getText();
+}
+
+bool decodeRobotMessageEvent(const RobotMessagePackageType type, const uint64_t timestamp, const uint8_t source,
+                             comm::BinParser& bp, RobotMessageEvent& event)
+{
+  event = RobotMessageEvent();
+  event.timestamp = timestamp;
+  event.source = source;
+  event.type = type;
+
+  switch (type)
+  {
+    case RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE:
+    {
+      if (!bp.checkSize(sizeof(int32_t) * 3 + sizeof(uint8_t) + sizeof(uint32_t)))
+      {
+        return false;
+      }
+      int32_t report_level;
+      uint8_t data_type;
+      uint32_t data;
+      bp.parse(event.code);
+      bp.parse(event.argument);
+      bp.parse(report_level);
+      bp.parse(data_type);
+      bp.parse(data);
+      event.report_level = static_cast<ReportLevel>(report_level);
+      break;
+    }
+    case RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION:
+    {
+      if (!bp.checkSize(sizeof(int32_t) * 2))
+      {
+        return false;
+      }
+      bp.parse(event.line_number);
+      bp.parse(event.column_number);
+      break;
+    }
+    case RobotMessagePackageType::ROBOT_MESSAGE_TEXT:
+      break;
+    default:
+      // Other messages have fields of their own in front of the text, they are only reported by type
+      bp.consume();
+      return true;
+  }
+
+  // The text fills the rest of the message and is copied in place instead of into a string
+  const size_t length = bp.remaining();
+  event.text_length = std::min(length, RobotMessageEvent::TEXT_CAPACITY);
+  event.text_truncated = length > RobotMessageEvent::TEXT_CAPACITY;
+  std::memcpy(event.text.data(), bp.position(), event.text_length);
+  bp.consume();
+  return true;
+}
+
+RobotMessageEventRing::RobotMessageEventRing(const size_t capacity) : head_(0), size_(0), dropped_(0)
+{
+  if (capacity == 0)
+  {
+    throw UrException("A RobotMessageEventRing needs a capacity of at least one event.");
+  }
+  events_.resize(capacity);
+}
+
+bool RobotMessageEventRing::push(const RobotMessageEvent& event)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ > 0)
+  {
+    RobotMessageEvent& newest = events_[(head_ + size_ - 1) % events_.size()];
+    if (event.isRepetitionOf(newest))
+    {
+      newest.repeat_count += event.repeat_count;
+      newest.timestamp = event.timestamp;
+      return true;
+    }
+  }
+
+  bool dropped = false;
+  if (size_ == events_.size())
+  {
+    head_ = (head_ + 1) % events_.size();
+    --size_;
+    ++dropped_;
+    dropped = true;
+  }
+  events_[(head_ + size_) % events_.size()] = event;
+  ++size_;
+  return !dropped;
+}
+
+bool RobotMessageEventRing::pop(RobotMessageEvent& event)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == 0)
+  {
+    return false;
+  }
+  event = events_[head_];
+  head_ = (head_ + 1) % events_.size();
+  --size_;
+  return true;
+}
+
+size_t RobotMessageEventRing::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+uint64_t RobotMessageEventRing::getDroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+RobotMessageLogger::RobotMessageLogger(const size_t max_messages, const std::chrono::milliseconds interval)
+  : max_messages_(max_messages)
+  , interval_(interval)
+  , interval_start_(std::chrono::steady_clock::now())
+  , logged_in_interval_(0)
+  , suppressed_in_interval_(0)
+  , suppressed_total_(0)
+{
+}
+
+bool RobotMessageLogger::log(const RobotMessageEvent& event)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - interval_start_ >= interval_)
+  {
+    if (suppressed_in_interval_ > 0)
+    {
+      URCL_LOG_WARN("Suppressed %" PRIu64 " robot messages exceeding the limit of %zu messages per interval",
+                    suppressed_in_interval_, max_messages_);
+    }
+    interval_start_ = now;
+    logged_in_interval_ = 0;
+    suppressed_in_interval_ = 0;
+  }
+  if (logged_in_interval_ >= max_messages_)
+  {
+    ++suppressed_in_interval_;
+    ++suppressed_total_;
+    return false;
+  }
+  ++logged_in_interval_;
+
+  const int text_length = static_cast<int>(event.text_length);
+  const char* text = event.text.data();
+  char repeats[32] = "";
+  if (event.repeat_count > 1)
+  {
+    std::snprintf(repeats, sizeof(repeats), " (repeated %u times)", static_cast<unsigned>(event.repeat_count));
+  }
+  switch (event.type)
+  {
+    case RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE:
+    {
+      LogLevel level = LogLevel::INFO;
+      if (event.report_level == ReportLevel::VIOLATION || event.report_level == ReportLevel::FAULT ||
+          event.report_level == ReportLevel::DEVL_VIOLATION || event.report_level == ReportLevel::DEVL_FAULT)
+      {
+        level = LogLevel::ERROR;
+      }
+      else if (event.report_level == ReportLevel::WARNING || event.report_level == ReportLevel::DEVL_WARNING)
+      {
+        level = LogLevel::WARN;
+      }
+      urcl::log(__FILE__, __LINE__, level, "Robot error C%dA%d: %.*s%s", event.code, event.argument,
+                text_length, text, repeats);
+      break;
+    }
+    case RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION:
+      URCL_LOG_ERROR("Runtime exception in line %d, column %d: %.*s%s", event.line_number,
+                     event.column_number, text_length, text, repeats);
+      break;
+    default:
+      URCL_LOG_INFO("Robot message of type %d: %.*s%s", static_cast<int>(event.type), text_length, text,
+                    repeats);
+      break;
+  }
+  return true;
+}
+
+size_t RobotMessageLogger::drain(RobotMessageEventRing& ring)
+{
+  size_t count = 0;
+  RobotMessageEvent event;
+  while (ring.pop(event))
+  {
+    log(event);
+    ++count;
+  }
+  return count;
+}
+}  // namespace primary_interface
+}  // namespace urcl
@@ -0,0 +1,126 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_state_frame.h"
+#include "ur_client_library/primary/abstract_primary_consumer.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace urcl
+{
+namespace primary_interface
+{
+std::unique_ptr<RobotStateFrame> RobotStateFrame::create(const uint8_t* data, const size_t size,
+                                                         const size_t max_sub_packages, const size_t package_storage)
+{
+  const size_t object_size = alignUp(sizeof(RobotStateFrame));
+  const size_t storage_size = alignUp(package_storage);
+  const size_t table_size = alignUp(max_sub_packages * sizeof(SubPackage));
+
+  // Frames are allocated together with their trailing storage, operator delete frees all of it
+  void* memory = RobotStateFrame::operator new(object_size + storage_size + table_size + size);
+  uint8_t* storage = static_cast<uint8_t*>(memory) + object_size;
+  SubPackage* table = reinterpret_cast<SubPackage*>(storage + storage_size);
+  uint8_t* frame_data = storage + storage_size + table_size;
+  std::memcpy(frame_data, data, size);
+
+  // The constructor cannot throw, the memory is owned by the frame from here on
+  return std::unique_ptr<RobotStateFrame>(
+      ::new (memory) RobotStateFrame(storage, storage_size, table, max_sub_packages, frame_data, size));
+}
+
+RobotStateFrame::RobotStateFrame(uint8_t* package_storage, const size_t package_storage_size,
+                                 SubPackage* sub_packages, const size_t max_sub_packages, uint8_t* data,
+                                 const size_t size)
+  : PrimaryPackage(PrimaryPackageClass::ROBOT_STATE_FRAME)
+  , package_storage_(package_storage)
+  , package_storage_size_(package_storage_size)
+  , package_storage_used_(0)
+  , sub_packages_(sub_packages)
+  , max_sub_packages_(max_sub_packages)
+  , num_sub_packages_(0)
+  , data_(data)
+  , data_size_(size)
+{
+}
+
+RobotStateFrame::~RobotStateFrame()
+{
+  for (size_t i = 0; i < num_sub_packages_; ++i)
+  {
+    if (sub_packages_[i].package != nullptr)
+    {
+      sub_packages_[i].package->~PrimaryPackage();
+    }
+  }
+}
+
+bool RobotStateFrame::addSubPackage(const RobotStateType type, const size_t offset, const size_t size)
+{
+  if (num_sub_packages_ == max_sub_packages_ || offset > data_size_ || size > data_size_ - offset)
+  {
+    return false;
+  }
+  sub_packages_[num_sub_packages_++] = { type, static_cast<uint32_t>(offset), static_cast<uint32_t>(size), nullptr };
+  return true;
+}
+
+void RobotStateFrame::consumeViews(RobotStateViewConsumer& consumer) const
+{
+  for (size_t i = 0; i < num_sub_packages_; ++i)
+  {
+    const SubPackage& sub_package = sub_packages_[i];
+    consumeRobotStateView(consumer, sub_package.type, data_ + sub_package.offset, sub_package.size);
+  }
+}
+
+bool RobotStateFrame::consumeWith(AbstractPrimaryConsumer& consumer)
+{
+  return consumer.consume(*this);
+}
+
+std::string RobotStateFrame::toString() const
+{
+  std::stringstream ss;
+  for (size_t i = 0; i < num_sub_packages_; ++i)
+  {
+    ss << "Sub-package type: " << static_cast<int>(sub_packages_[i].type) << ", " << sub_packages_[i].size
+       << " bytes" << std::endl;
+    if (sub_packages_[i].package != nullptr)
+    {
+      ss << sub_packages_[i].package->toString();
+    }
+  }
+  return ss.str();
+}
+
+}  // namespace primary_interface
+}  // namespace urcl
@@ -0,0 +1,230 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/clock_synchronizer.h"
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+constexpr std::chrono::milliseconds ClockSynchronizer::DEFAULT_WINDOW;
+
+ClockSynchronizer::ClockSynchronizer(const std::chrono::milliseconds window, const size_t num_windows)
+  : window_(std::chrono::duration<double>(window).count())
+  , num_windows_(num_windows)
+  , robot_reference_(0.0)
+  , last_robot_time_(0.0)
+  , current_{ 0.0, 0.0 }
+  , current_window_end_(0.0)
+  , num_samples_(0)
+  , intercept_(0.0)
+  , drift_(0.0)
+{
+  if (window.count() <= 0 || num_windows == 0)
+  {
+    throw UrException("A clock synchronizer needs a positive window duration and number of windows.");
+  }
+}
+
+void ClockSynchronizer::setRecipe(const CompiledRecipe& recipe)
+{
+  FieldHandle<double> handle = recipe.getFieldHandle<double>("timestamp");
+  std::lock_guard<std::mutex> lock(mutex_);
+  timestamp_handle_ = handle;
+}
+
+void ClockSynchronizer::update(const DataPackage& package)
+{
+  double robot_time;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!package.getData(timestamp_handle_, robot_time))
+    {
+      return;
+    }
+  }
+  const comm::PackageTimestamps& timestamps = package.getTimestamps();
+  // Kernel timestamps aren't delayed by scheduling the receiving thread
+  const bool has_kernel_time = timestamps.kernel.time_since_epoch().count() != 0;
+  update(robot_time, has_kernel_time ? timestamps.kernel : timestamps.receive);
+}
+
+void ClockSynchronizer::update(const double robot_time, const std::chrono::steady_clock::time_point host_time)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_samples_ > 0 && robot_time < last_robot_time_)
+  {
+    // The robot controller has been restarted
+    minima_.clear();
+    num_samples_ = 0;
+  }
+  if (num_samples_ == 0)
+  {
+    host_reference_ = host_time;
+    robot_reference_ = robot_time;
+  }
+  last_robot_time_ = robot_time;
+
+  const double x = robot_time - robot_reference_;
+  const Minimum sample{ robot_time, std::chrono::duration<double>(host_time - host_reference_).count() - x };
+  bool changed = true;
+  if (num_samples_ == 0)
+  {
+    current_ = sample;
+    current_window_end_ = robot_time + window_;
+  }
+  else if (robot_time >= current_window_end_)
+  {
+    minima_.push_back(current_);
+    if (minima_.size() > num_windows_)
+    {
+      minima_.pop_front();
+    }
+    current_ = sample;
+    current_window_end_ = robot_time + window_;
+  }
+  else if (sample.offset < current_.offset)
+  {
+    current_ = sample;
+  }
+  else
+  {
+    changed = false;
+  }
+  num_samples_++;
+  if (changed)
+  {
+    fit();
+  }
+}
+
+void ClockSynchronizer::fit()
+{
+  // The current window's minimum is included, so the estimate converges before a window closes
+  const size_t n = minima_.size() + 1;
+  double sum_x = current_.robot_time - robot_reference_;
+  double sum_y = current_.offset;
+  for (const auto& minimum : minima_)
+  {
+    sum_x += minimum.robot_time - robot_reference_;
+    sum_y += minimum.offset;
+  }
+  const double mean_x = sum_x / n;
+  const double mean_y = sum_y / n;
+
+  const double current_dx = current_.robot_time - robot_reference_ - mean_x;
+  double cov = current_dx * (current_.offset - mean_y);
+  double var = current_dx * current_dx;
+  for (const auto& minimum : minima_)
+  {
+    const double dx = minimum.robot_time - robot_reference_ - mean_x;
+    cov += dx * (minimum.offset - mean_y);
+    var += dx * dx;
+  }
+  // The drift can't be estimated from samples of (almost) the same time
+  drift_ = var > 1e-6 ? cov / var : 0.0;
+  intercept_ = mean_y - drift_ * mean_x;
+}
+
+double ClockSynchronizer::mapToHost(const double robot_time) const
+{
+  return intercept_ + (1.0 + drift_) * (robot_time - robot_reference_);
+}
+
+void ClockSynchronizer::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  minima_.clear();
+  num_samples_ = 0;
+  intercept_ = 0.0;
+  drift_ = 0.0;
+}
+
+bool ClockSynchronizer::isSynchronized() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_samples_ > 0;
+}
+
+std::chrono::steady_clock::time_point ClockSynchronizer::toHostTime(const double robot_time) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_samples_ == 0)
+  {
+    return std::chrono::steady_clock::time_point();
+  }
+  const std::chrono::duration<double> host(mapToHost(robot_time));
+  return host_reference_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(host);
+}
+
+std::chrono::system_clock::time_point ClockSynchronizer::toSystemTime(const double robot_time) const
+{
+  const std::chrono::steady_clock::time_point host_time = toHostTime(robot_time);
+  if (host_time == std::chrono::steady_clock::time_point())
+  {
+    return std::chrono::system_clock::time_point();
+  }
+  const auto since_now = host_time - std::chrono::steady_clock::now();
+  return std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(since_now);
+}
+
+double ClockSynchronizer::toRobotTime(const std::chrono::steady_clock::time_point host_time) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_samples_ == 0)
+  {
+    return 0.0;
+  }
+  const double host = std::chrono::duration<double>(host_time - host_reference_).count();
+  return robot_reference_ + (host - intercept_) / (1.0 + drift_);
+}
+
+double ClockSynchronizer::toRobotTime(const std::chrono::system_clock::time_point system_time) const
+{
+  const auto since_now = system_time - std::chrono::system_clock::now();
+  return toRobotTime(std::chrono::steady_clock::now() +
+                     std::chrono::duration_cast<std::chrono::steady_clock::duration>(since_now));
+}
+
+double ClockSynchronizer::getDriftPpm() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return drift_ * 1e6;
+}
+
+uint64_t ClockSynchronizer::getNumSamples() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_samples_;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,288 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/columnar_export.h"
+
+#include <iterator>
+#include <type_traits>
+
+#include "ur_client_library/comm/byte_swap.h"
+#include "ur_client_library/rtde/package_header.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+template <typename T>
+struct ElementSize
+{
+  static constexpr size_t value = sizeof(T);
+};
+
+template <typename T, size_t N>
+struct ElementSize<std::array<T, N>>
+{
+  static constexpr size_t value = sizeof(T);
+};
+
+size_t getElementSize(const rtde_type_variant& value)
+{
+  return std::visit([](auto&& arg) -> size_t { return ElementSize<std::decay_t<decltype(arg)>>::value; }, value);
+}
+
+// Converts count values of the given size from network to host byte order
+void toHostOrder(uint8_t* dst, const uint8_t* src, const size_t element_size, const size_t count)
+{
+  switch (element_size)
+  {
+    case sizeof(uint64_t):
+      comm::swapBytes<uint64_t>(dst, src, count);
+      break;
+    case sizeof(uint32_t):
+      comm::swapBytes<uint32_t>(dst, src, count);
+      break;
+    default:
+      std::memcpy(dst, src, count * element_size);
+      break;
+  }
+}
+
+template <typename T>
+void writeValue(std::ofstream& file, const T value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(const std::vector<char>& buffer, size_t& offset, T& value)
+{
+  if (offset + sizeof(T) > buffer.size())
+  {
+    return false;
+  }
+  std::memcpy(&value, buffer.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+}  // namespace
+
+constexpr char ColumnarWriter::MAGIC[8];
+
+ColumnarWriter::ColumnarWriter(const std::string& path, std::shared_ptr<const CompiledRecipe> recipe,
+                               const size_t chunk_rows)
+  : path_(path)
+  , recipe_(recipe)
+  , chunk_rows_(chunk_rows)
+  , file_(path, std::ios::binary | std::ios::trunc)
+  , package_buffer_(recipe->getDataSize())
+  , num_rows_(0)
+{
+  if (chunk_rows_ == 0)
+  {
+    throw UrException("The number of rows per chunk has to be greater than 0.");
+  }
+  if (!file_.is_open())
+  {
+    throw UrException("Could not create columnar file '" + path_ + "'.");
+  }
+
+  receive_times_.reserve(chunk_rows_);
+  for (const auto& field : recipe_->getFields())
+  {
+    Column column;
+    column.offset = field.offset;
+    column.size = field.known ? field.size : 0;
+    column.element_size = field.known ? getElementSize(field.empty_value) : 1;
+    column.values.reserve(chunk_rows_ * column.size);
+    columns_.push_back(std::move(column));
+  }
+
+  file_.write(MAGIC, sizeof(MAGIC));
+  writeValue(file_, FORMAT_VERSION);
+  writeValue(file_, static_cast<uint32_t>(recipe_->getRecipe().size()));
+  for (const auto& name : recipe_->getRecipe())
+  {
+    writeValue(file_, static_cast<uint16_t>(name.size()));
+    file_.write(name.data(), name.size());
+  }
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+  close();
+}
+
+bool ColumnarWriter::append(const DataPackage& package, const std::chrono::system_clock::time_point receive_time)
+{
+  if (package.getCompiledRecipe() != recipe_ && package.getCompiledRecipe()->getRecipe() != recipe_->getRecipe())
+  {
+    return false;
+  }
+  package.serializeData(package_buffer_.data());
+  appendData(package_buffer_.data(), receive_time);
+  return true;
+}
+
+bool ColumnarWriter::appendFrame(const uint8_t* frame, const size_t size, const uint16_t protocol_version,
+                                 const std::chrono::system_clock::time_point receive_time)
+{
+  const size_t header_size = sizeof(PackageHeader::_package_size_type) + sizeof(PackageType);
+  const size_t data_offset = header_size + (protocol_version == 2 ? sizeof(uint8_t) : 0);
+  if (size != data_offset + recipe_->getDataSize() ||
+      frame[sizeof(PackageHeader::_package_size_type)] != static_cast<uint8_t>(PackageType::RTDE_DATA_PACKAGE))
+  {
+    return false;
+  }
+  appendData(frame + data_offset, receive_time);
+  return true;
+}
+
+void ColumnarWriter::appendData(const uint8_t* data, const std::chrono::system_clock::time_point receive_time)
+{
+  receive_times_.push_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count());
+  for (auto& column : columns_)
+  {
+    const size_t end = column.values.size();
+    column.values.resize(end + column.size);
+    toHostOrder(column.values.data() + end, data + column.offset, column.element_size,
+                column.size / column.element_size);
+  }
+  ++num_rows_;
+  if (receive_times_.size() == chunk_rows_)
+  {
+    writeChunk();
+  }
+}
+
+void ColumnarWriter::writeChunk()
+{
+  if (receive_times_.empty())
+  {
+    return;
+  }
+  writeValue(file_, static_cast<uint32_t>(receive_times_.size()));
+  file_.write(reinterpret_cast<const char*>(receive_times_.data()), receive_times_.size() * sizeof(int64_t));
+  for (auto& column : columns_)
+  {
+    file_.write(reinterpret_cast<const char*>(column.values.data()), column.values.size());
+    column.values.clear();
+  }
+  receive_times_.clear();
+}
+
+void ColumnarWriter::close()
+{
+  if (file_.is_open())
+  {
+    writeChunk();
+    file_.close();
+  }
+}
+
+ColumnarFile::ColumnarFile(const std::string& path) : num_chunks_(0)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+  {
+    throw UrException("Could not open columnar file '" + path + "'.");
+  }
+  const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  size_t offset = sizeof(ColumnarWriter::MAGIC);
+  uint16_t format_version;
+  uint32_t recipe_size;
+  if (buffer.size() < offset || std::memcmp(buffer.data(), ColumnarWriter::MAGIC, offset) != 0 ||
+      !readValue(buffer, offset, format_version) || format_version != ColumnarWriter::FORMAT_VERSION ||
+      !readValue(buffer, offset, recipe_size))
+  {
+    throw UrException("File '" + path + "' is not a valid columnar RTDE file.");
+  }
+  std::vector<std::string> recipe;
+  for (uint32_t i = 0; i < recipe_size; ++i)
+  {
+    uint16_t length;
+    if (!readValue(buffer, offset, length) || offset + length > buffer.size())
+    {
+      throw UrException("The header of columnar file '" + path + "' is truncated.");
+    }
+    recipe.emplace_back(buffer.data() + offset, length);
+    offset += length;
+  }
+  recipe_ = std::make_shared<const CompiledRecipe>(recipe);
+  columns_.resize(recipe_->getFields().size());
+
+  size_t row_size = sizeof(int64_t);
+  for (const auto& field : recipe_->getFields())
+  {
+    row_size += field.known ? field.size : 0;
+  }
+  uint32_t rows;
+  while (readValue(buffer, offset, rows))
+  {
+    if (offset + rows * row_size > buffer.size())
+    {
+      throw UrException("Chunk " + std::to_string(num_chunks_) + " of columnar file '" + path + "' is truncated.");
+    }
+    for (uint32_t i = 0; i < rows; ++i)
+    {
+      int64_t nanoseconds = 0;
+      readValue(buffer, offset, nanoseconds);
+      receive_times_.emplace_back(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(nanoseconds)));
+    }
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      const CompiledRecipe::Field& field = recipe_->getFields()[i];
+      const size_t size = field.known ? rows * field.size : 0;
+      columns_[i].insert(columns_[i].end(), buffer.begin() + offset, buffer.begin() + offset + size);
+      offset += size;
+    }
+    ++num_chunks_;
+  }
+}
+
+size_t exportColumnar(RTDERecording& recording, const std::string& path, const size_t chunk_rows)
+{
+  ColumnarWriter writer(path, std::make_shared<const CompiledRecipe>(recording.getRecipe()), chunk_rows);
+  recording.rewind();
+  RTDERecording::Frame frame;
+  while (recording.next(frame))
+  {
+    writer.appendFrame(frame.data, frame.size, recording.getProtocolVersion(), frame.receive_time);
+  }
+  writer.close();
+  return writer.getNumRows();
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,174 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/data_package_history.h"
+
+#include <cmath>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+DataPackageHistory::DataPackageHistory(std::shared_ptr<const CompiledRecipe> recipe, const size_t capacity)
+  : recipe_(recipe)
+  , timestamp_handle_(recipe_->getFieldHandle<double>("timestamp"))
+  , capacity_(capacity)
+  , data_size_(recipe_->getDataSize())
+  , data_(capacity * recipe_->getDataSize())
+  , recipe_ids_(capacity)
+  , samples_(capacity)
+  , head_(0)
+  , size_(0)
+{
+  if (capacity_ == 0)
+  {
+    throw UrException("The capacity of a data package history has to be greater than 0.");
+  }
+}
+
+bool DataPackageHistory::push(const DataPackage& package, const Clock::time_point receive_time)
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+  double timestamp;
+  if (!package.getData(timestamp_handle_, timestamp))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (package.serializeData(data_.data() + head_ * data_size_) != data_size_)
+  {
+    return false;
+  }
+  recipe_ids_[head_] = package.getRecipeID();
+  samples_[head_] = Sample{ timestamp, receive_time };
+  head_ = (head_ + 1) % capacity_;
+  if (size_ < capacity_)
+  {
+    size_++;
+  }
+  return true;
+}
+
+bool DataPackageHistory::getNearest(const double timestamp, DataPackage& package, Sample* sample) const
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (size_ == 0)
+  {
+    return false;
+  }
+  size_t i = lowerBound(timestamp);
+  if (i == size_ || (i > 0 && std::abs(samples_[slotIndex(i - 1)].timestamp - timestamp) <=
+                                  std::abs(samples_[slotIndex(i)].timestamp - timestamp)))
+  {
+    i--;
+  }
+  const size_t slot = slotIndex(i);
+  fill(slot, package);
+  if (sample != nullptr)
+  {
+    *sample = samples_[slot];
+  }
+  return true;
+}
+
+size_t DataPackageHistory::getWindow(const double start_timestamp, const double end_timestamp,
+                                     std::vector<DataPackage>& packages, std::vector<Sample>* samples) const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  size_t num_found = 0;
+  for (size_t i = lowerBound(start_timestamp); i < size_; ++i)
+  {
+    const size_t slot = slotIndex(i);
+    if (samples_[slot].timestamp > end_timestamp)
+    {
+      break;
+    }
+    packages.emplace_back(recipe_);
+    fill(slot, packages.back());
+    if (samples != nullptr)
+    {
+      samples->push_back(samples_[slot]);
+    }
+    num_found++;
+  }
+  return num_found;
+}
+
+size_t DataPackageHistory::size() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return size_;
+}
+
+void DataPackageHistory::clear()
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  head_ = 0;
+  size_ = 0;
+}
+
+size_t DataPackageHistory::lowerBound(const double timestamp) const
+{
+  size_t low = 0;
+  size_t high = size_;
+  while (low < high)
+  {
+    const size_t mid = low + (high - low) / 2;
+    if (samples_[slotIndex(mid)].timestamp < timestamp)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+void DataPackageHistory::fill(const size_t slot, DataPackage& package) const
+{
+  // The BinParser only reads from the buffer
+  comm::BinParser bp(const_cast<uint8_t*>(data_.data()) + slot * data_size_, data_size_);
+  package.parseData(bp);
+  package.setRecipeID(recipe_ids_[slot]);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
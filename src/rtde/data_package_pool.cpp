@@ -0,0 +1,120 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/data_package_pool.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+void DataPackageDeleter::operator()(DataPackage* package) const
+{
+  std::unique_ptr<DataPackage> owned(package);
+  if (std::shared_ptr<DataPackagePool> locked_pool = pool.lock())
+  {
+    locked_pool->release(std::move(owned));
+  }
+}
+
+DataPackagePool::DataPackagePool(std::shared_ptr<const CompiledRecipe> recipe, const uint16_t protocol_version,
+                                 const size_t pool_size, const bool lazy_decoding)
+  : recipe_(recipe)
+  , protocol_version_(protocol_version)
+  , lazy_decoding_(lazy_decoding)
+  , pool_size_(pool_size)
+  , num_allocations_(0)
+{
+  packages_.reserve(pool_size_);
+  for (size_t i = 0; i < pool_size_; ++i)
+  {
+    DataPackage* package = new DataPackage(recipe_, protocol_version_, lazy_decoding_);
+    package->initEmpty();
+    packages_.push_back(package);
+  }
+}
+
+DataPackagePool::~DataPackagePool()
+{
+  for (auto& package : packages_)
+  {
+    delete package;
+  }
+}
+
+std::shared_ptr<DataPackagePool> DataPackagePool::create(std::shared_ptr<const CompiledRecipe> recipe,
+                                                         const uint16_t protocol_version, const size_t pool_size,
+                                                         const bool lazy_decoding)
+{
+  return std::shared_ptr<DataPackagePool>(new DataPackagePool(recipe, protocol_version, pool_size, lazy_decoding));
+}
+
+std::unique_ptr<DataPackage> DataPackagePool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> lk(packages_mutex_);
+    if (!packages_.empty())
+    {
+      std::unique_ptr<DataPackage> package(packages_.back());
+      packages_.pop_back();
+      return package;
+    }
+  }
+  num_allocations_++;
+  std::unique_ptr<DataPackage> package(new DataPackage(recipe_, protocol_version_, lazy_decoding_));
+  package->initEmpty();
+  return package;
+}
+
+void DataPackagePool::release(std::unique_ptr<DataPackage> package)
+{
+  if (package == nullptr || package->getCompiledRecipe() != recipe_ || package->isLazyDecoding() != lazy_decoding_)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(packages_mutex_);
+  if (packages_.size() < pool_size_)
+  {
+    packages_.push_back(package.release());
+  }
+}
+
+PooledDataPackage DataPackagePool::makePooled(std::unique_ptr<DataPackage> package)
+{
+  return PooledDataPackage(package.release(), DataPackageDeleter{ weak_from_this() });
+}
+
+size_t DataPackagePool::available()
+{
+  std::lock_guard<std::mutex> lk(packages_mutex_);
+  return packages_.size();
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
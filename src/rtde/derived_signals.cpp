@@ -0,0 +1,320 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/derived_signals.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+size_t DerivedSignals::addSignal(const std::string& name, const std::vector<std::string>& inputs, const size_t width,
+                                 const size_t state_size, Kernel kernel)
+{
+  size_t existing;
+  if (findSignal(name, existing))
+  {
+    throw UrException("A derived signal named '" + name + "' already exists.");
+  }
+
+  // Compiling the inputs as recipe resolves their types
+  const CompiledRecipe input_recipe(inputs);
+  size_t input_size = 0;
+  for (const auto& field : input_recipe.getFields())
+  {
+    if (!field.known)
+    {
+      throw UrException("The input '" + field.name + "' of derived signal '" + name + "' is no known data field.");
+    }
+    if (std::holds_alternative<double>(field.empty_value))
+    {
+      input_size += 1;
+    }
+    else if (std::holds_alternative<vector3d_t>(field.empty_value))
+    {
+      input_size += 3;
+    }
+    else if (std::holds_alternative<vector6d_t>(field.empty_value))
+    {
+      input_size += 6;
+    }
+    else
+    {
+      throw UrException("The input '" + field.name + "' of derived signal '" + name +
+                        "' is no floating point data field.");
+    }
+  }
+  Signal signal;
+  signal.name = name;
+  signal.inputs = inputs;
+  signal.width = width;
+  signal.state_size = state_size;
+  signal.kernel = std::move(kernel);
+  signal.input_offset = input_buffer_.size();
+  signal.state_offset = state_.size();
+  signal.value_offset = values_.size();
+  input_buffer_.resize(input_buffer_.size() + input_size, 0.0);
+  state_.resize(state_.size() + state_size, 0.0);
+  values_.resize(values_.size() + width, 0.0);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  published_values_.resize(values_.size(), 0.0);
+  signals_.push_back(std::move(signal));
+  // Rebind with the next package, so the new inputs are resolved
+  recipe_ = nullptr;
+  return signals_.size() - 1;
+}
+
+size_t DerivedSignals::addTcpLinearSpeed(const std::string& name)
+{
+  return addSignal(name, { "actual_TCP_speed" }, 1, 0, [](const double* inputs, double*, double* values) {
+    values[0] = std::sqrt(inputs[0] * inputs[0] + inputs[1] * inputs[1] + inputs[2] * inputs[2]);
+  });
+}
+
+size_t DerivedSignals::addJointMechanicalPower(const vector6d_t& torque_constants, const std::string& name)
+{
+  return addSignal(name, { "actual_current", "actual_qd" }, 6, 0,
+                   [torque_constants](const double* inputs, double*, double* values) {
+                     for (size_t i = 0; i < 6; ++i)
+                     {
+                       values[i] = torque_constants[i] * inputs[i] * inputs[6 + i];
+                     }
+                   });
+}
+
+size_t DerivedSignals::addSlidingRms(const std::string& field, const size_t window_size, const std::string& name)
+{
+  if (window_size == 0)
+  {
+    throw UrException("The window of a sliding RMS must not be empty.");
+  }
+  size_t width = 1;
+  const CompiledRecipe recipe({ field });
+  if (recipe.isComplete() && std::holds_alternative<vector3d_t>(recipe.getFields()[0].empty_value))
+  {
+    width = 3;
+  }
+  else if (recipe.isComplete() && std::holds_alternative<vector6d_t>(recipe.getFields()[0].empty_value))
+  {
+    width = 6;
+  }
+
+  // State layout: position in the ring, number of samples, running sums of squares, ring of squares
+  return addSignal(
+      name.empty() ? field + "_rms" : name, { field }, width, 2 + width + window_size * width,
+      [width, window_size](const double* inputs, double* state, double* values) {
+        size_t position = static_cast<size_t>(state[0]);
+        const double count = std::min(state[1] + 1.0, static_cast<double>(window_size));
+        double* sums = state + 2;
+        double* ring = sums + width;
+        double* slot = ring + position * width;
+        for (size_t i = 0; i < width; ++i)
+        {
+          const double square = inputs[i] * inputs[i];
+          sums[i] += square - slot[i];
+          slot[i] = square;
+        }
+        if (++position == window_size)
+        {
+          // Recompute the sums once per window, so rounding errors don't accumulate
+          position = 0;
+          std::fill(sums, sums + width, 0.0);
+          for (size_t j = 0; j < window_size; ++j)
+          {
+            for (size_t i = 0; i < width; ++i)
+            {
+              sums[i] += ring[j * width + i];
+            }
+          }
+        }
+        for (size_t i = 0; i < width; ++i)
+        {
+          values[i] = std::sqrt(std::max(sums[i], 0.0) / count);
+        }
+        state[0] = static_cast<double>(position);
+        state[1] = count;
+      });
+}
+
+void DerivedSignals::update(const DataPackage& package)
+{
+  std::shared_ptr<const CompiledRecipe> recipe = package.getCompiledRecipe();
+  if (recipe != recipe_)
+  {
+    bind(recipe);
+  }
+  if (inputs_.empty() && !signals_.empty())
+  {
+    return;
+  }
+
+  // Gather the inputs of all signals into one contiguous buffer
+  double* position = input_buffer_.data();
+  for (const auto& input : inputs_)
+  {
+    switch (input.width)
+    {
+      case 1:
+        package.getData(input.double_handle, *position);
+        break;
+      case 3:
+      {
+        vector3d_t value;
+        if (package.getData(input.vector3d_handle, value))
+        {
+          std::copy(value.begin(), value.end(), position);
+        }
+        break;
+      }
+      default:
+      {
+        vector6d_t value;
+        if (package.getData(input.vector6d_handle, value))
+        {
+          std::copy(value.begin(), value.end(), position);
+        }
+        break;
+      }
+    }
+    position += input.width;
+  }
+
+  for (const auto& signal : signals_)
+  {
+    signal.kernel(input_buffer_.data() + signal.input_offset, state_.data() + signal.state_offset,
+                  values_.data() + signal.value_offset);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::copy(values_.begin(), values_.end(), published_values_.begin());
+  ++num_updates_;
+}
+
+bool DerivedSignals::findSignal(const std::string& name, size_t& index) const
+{
+  for (size_t i = 0; i < signals_.size(); ++i)
+  {
+    if (signals_[i].name == name)
+    {
+      index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::string> DerivedSignals::getRequiredFields() const
+{
+  std::vector<std::string> fields;
+  for (const auto& signal : signals_)
+  {
+    for (const auto& input : signal.inputs)
+    {
+      if (std::find(fields.begin(), fields.end(), input) == fields.end())
+      {
+        fields.push_back(input);
+      }
+    }
+  }
+  return fields;
+}
+
+bool DerivedSignals::getValues(const size_t index, double* values) const
+{
+  const Signal& signal = signals_.at(index);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_updates_ == 0)
+  {
+    return false;
+  }
+  std::memcpy(values, published_values_.data() + signal.value_offset, signal.width * sizeof(double));
+  return true;
+}
+
+uint64_t DerivedSignals::getNumUpdates() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_updates_;
+}
+
+void DerivedSignals::bind(const std::shared_ptr<const CompiledRecipe>& recipe)
+{
+  recipe_ = recipe;
+  inputs_.clear();
+  std::fill(state_.begin(), state_.end(), 0.0);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_updates_ = 0;
+  }
+
+  std::vector<Input> inputs;
+  for (const auto& signal : signals_)
+  {
+    for (const auto& name : signal.inputs)
+    {
+      size_t index;
+      if (!recipe->findIndex(name, index))
+      {
+        URCL_LOG_ERROR("The data field '%s' used by derived signal '%s' is not part of the recipe. Derived signals "
+                       "will not be computed.",
+                       name.c_str(), signal.name.c_str());
+        return;
+      }
+      Input input;
+      const rtde_type_variant& type = recipe->getFields()[index].empty_value;
+      if (std::holds_alternative<double>(type))
+      {
+        input.width = 1;
+        input.double_handle = recipe->getFieldHandle<double>(name);
+      }
+      else if (std::holds_alternative<vector3d_t>(type))
+      {
+        input.width = 3;
+        input.vector3d_handle = recipe->getFieldHandle<vector3d_t>(name);
+      }
+      else
+      {
+        input.width = 6;
+        input.vector6d_handle = recipe->getFieldHandle<vector6d_t>(name);
+      }
+      inputs.push_back(input);
+    }
+  }
+  inputs_ = std::move(inputs);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,152 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/field_exporter.h"
+
+#include <algorithm>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+template <typename T, typename V>
+void writeValue(const V& value, T* buffer)
+{
+  *buffer = static_cast<T>(value);
+}
+
+template <typename T, typename V, size_t N>
+void writeValue(const std::array<V, N>& value, T* buffer)
+{
+  std::transform(value.begin(), value.end(), buffer, [](const V& element) { return static_cast<T>(element); });
+}
+
+template <typename H>
+struct HandleValue;
+
+template <typename V>
+struct HandleValue<FieldHandle<V>>
+{
+  using type = V;
+};
+
+template <typename V>
+size_t numValues(const V&)
+{
+  return 1;
+}
+
+template <typename V, size_t N>
+size_t numValues(const std::array<V, N>&)
+{
+  return N;
+}
+}  // namespace
+
+FieldExporter::FieldExporter(std::shared_ptr<const CompiledRecipe> recipe, const std::vector<std::string>& fields)
+  : recipe_(std::move(recipe)), fields_(fields), num_values_(0)
+{
+  entries_.reserve(fields_.size());
+  for (const auto& name : fields_)
+  {
+    size_t index;
+    if (!recipe_->findIndex(name, index))
+    {
+      throw UrException("The data field '" + name + "' is not part of the recipe and can't be exported.");
+    }
+    const rtde_type_variant& empty_value = recipe_->getFields()[index].empty_value;
+    if (std::holds_alternative<std::string>(empty_value))
+    {
+      throw UrException("The data field '" + name + "' isn't numeric and can't be exported.");
+    }
+    Entry entry;
+    entry.offset = num_values_;
+    std::visit(
+        [&](const auto& value) {
+          using V = std::decay_t<decltype(value)>;
+          if constexpr (!std::is_same_v<V, std::string>)
+          {
+            entry.handle = recipe_->getFieldHandle<V>(name);
+            num_values_ += numValues(value);
+          }
+        },
+        empty_value);
+    entries_.push_back(entry);
+  }
+}
+
+bool FieldExporter::exportTo(const DataPackage& package, double* buffer) const
+{
+  return exportValues(package, buffer);
+}
+
+bool FieldExporter::exportTo(const DataPackage& package, float* buffer) const
+{
+  return exportValues(package, buffer);
+}
+
+template <typename T>
+bool FieldExporter::exportValues(const DataPackage& package, T* buffer) const
+{
+  const std::shared_ptr<const CompiledRecipe> recipe = package.getCompiledRecipe();
+  if (recipe != recipe_ && recipe->getRecipe() != recipe_->getRecipe())
+  {
+    return false;
+  }
+  for (const auto& entry : entries_)
+  {
+    std::visit(
+        [&](const auto& handle) {
+          using V = typename HandleValue<std::decay_t<decltype(handle)>>::type;
+          V value;
+          package.getData(handle, value);
+          writeValue(value, buffer + entry.offset);
+        },
+        entry.handle);
+  }
+  return true;
+}
+
+size_t FieldExporter::getOffset(const std::string& field) const
+{
+  auto it = std::find(fields_.begin(), fields_.end(), field);
+  if (it == fields_.end())
+  {
+    throw UrException("The data field '" + field + "' isn't exported.");
+  }
+  return entries_[static_cast<size_t>(it - fields_.begin())].offset;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
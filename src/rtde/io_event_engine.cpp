@@ -0,0 +1,175 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/io_event_engine.h"
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+// Position of a bank's first pin inside its data field
+uint8_t firstBitOf(const IOBank bank)
+{
+  switch (bank)
+  {
+    case IOBank::CONFIGURABLE_INPUT:
+    case IOBank::CONFIGURABLE_OUTPUT:
+      return 8;
+    case IOBank::TOOL_INPUT:
+    case IOBank::TOOL_OUTPUT:
+      return 16;
+    default:
+      return 0;
+  }
+}
+}  // namespace
+
+uint8_t IOEventEngine::getNumPins(const IOBank bank)
+{
+  return bank == IOBank::TOOL_INPUT || bank == IOBank::TOOL_OUTPUT ? 2 : 8;
+}
+
+const char* IOEventEngine::getFieldName(const IOBank bank)
+{
+  return sourceOf(bank) == 0 ? "actual_digital_input_bits" : "actual_digital_output_bits";
+}
+
+size_t IOEventEngine::sourceOf(const IOBank bank)
+{
+  switch (bank)
+  {
+    case IOBank::STANDARD_INPUT:
+    case IOBank::CONFIGURABLE_INPUT:
+    case IOBank::TOOL_INPUT:
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+void IOEventEngine::subscribe(const IOBank bank, const uint8_t pin, const IOEdge edge, EdgeCallback callback)
+{
+  if (pin >= getNumPins(bank))
+  {
+    throw UrException("Cannot subscribe to edges of pin " + std::to_string(pin) + ", the I/O bank only has " +
+                      std::to_string(getNumPins(bank)) + " pins.");
+  }
+  Subscription subscription;
+  subscription.bank = bank;
+  subscription.pin = pin;
+  subscription.mask = 1ULL << (firstBitOf(bank) + pin);
+  subscription.rising = edge != IOEdge::FALLING;
+  subscription.falling = edge != IOEdge::RISING;
+  subscription.callback = callback;
+
+  Source& source = sources_[sourceOf(bank)];
+  source.mask |= subscription.mask;
+  source.subscriptions.push_back(subscription);
+}
+
+void IOEventEngine::setRecipe(const CompiledRecipe& recipe)
+{
+  timestamp_handle_ = recipe.getFieldHandle<double>("timestamp");
+  previous_timestamp_ = 0.0;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    Source& source = sources_[i];
+    source.has_previous = false;
+    if (!source.subscriptions.empty())
+    {
+      source.handle = recipe.getFieldHandle<uint64_t>(getFieldName(source.subscriptions.front().bank));
+    }
+  }
+}
+
+void IOEventEngine::update(const DataPackage& package, const std::chrono::steady_clock::time_point receive_time)
+{
+  double timestamp = 0.0;
+  package.getData(timestamp_handle_, timestamp);
+  for (auto& source : sources_)
+  {
+    uint64_t bits;
+    if (source.subscriptions.empty() || !package.getData(source.handle, bits))
+    {
+      continue;
+    }
+    if (!source.has_previous)
+    {
+      source.has_previous = true;
+      source.previous_bits = bits;
+      continue;
+    }
+
+    const uint64_t changed = (bits ^ source.previous_bits) & source.mask;
+    source.previous_bits = bits;
+    if (changed == 0)
+    {
+      continue;
+    }
+    const uint64_t rising = changed & bits;
+    const uint64_t falling = changed & ~bits;
+    for (const auto& subscription : source.subscriptions)
+    {
+      const bool is_rising = (rising & subscription.mask) != 0;
+      const bool is_falling = (falling & subscription.mask) != 0;
+      if ((is_rising && subscription.rising) || (is_falling && subscription.falling))
+      {
+        subscription.callback(IOEdgeEvent{ subscription.bank, subscription.pin, is_rising, timestamp,
+                                           previous_timestamp_, receive_time });
+      }
+    }
+  }
+  previous_timestamp_ = timestamp;
+}
+
+std::vector<std::string> IOEventEngine::getRequiredFields() const
+{
+  std::vector<std::string> fields;
+  if (empty())
+  {
+    return fields;
+  }
+  fields.push_back("timestamp");
+  for (const auto& source : sources_)
+  {
+    if (!source.subscriptions.empty())
+    {
+      fields.push_back(getFieldName(source.subscriptions.front().bank));
+    }
+  }
+  return fields;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
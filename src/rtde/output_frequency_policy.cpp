@@ -0,0 +1,87 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/output_frequency_policy.h"
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+OutputFrequencyPolicy::OutputFrequencyPolicy(const double active_frequency, const double idle_frequency,
+                                             const std::chrono::milliseconds idle_delay, ActivityCheck is_active)
+  : active_frequency_(active_frequency)
+  , idle_frequency_(idle_frequency)
+  , idle_delay_(idle_delay)
+  , is_active_(is_active ? is_active : isActiveByDefault)
+  , was_active_(false)
+{
+  if (!(active_frequency_ > 0.0) || !(idle_frequency_ > 0.0))
+  {
+    throw UrException("The output frequencies of the policy have to be positive.");
+  }
+}
+
+void OutputFrequencyPolicy::setRecipe(const CompiledRecipe& recipe)
+{
+  robot_mode_handle_ = recipe.getFieldHandle<int32_t>("robot_mode");
+  runtime_state_handle_ = recipe.getFieldHandle<uint32_t>("runtime_state");
+  was_active_ = false;
+}
+
+double OutputFrequencyPolicy::update(const DataPackage& package, const std::chrono::steady_clock::time_point now)
+{
+  int32_t robot_mode;
+  uint32_t runtime_state;
+  if (package.getData(robot_mode_handle_, robot_mode) && package.getData(runtime_state_handle_, runtime_state) &&
+      is_active_(static_cast<RobotMode>(robot_mode), static_cast<RuntimeState>(runtime_state)))
+  {
+    was_active_ = true;
+    last_active_ = now;
+    return active_frequency_;
+  }
+  if (was_active_ && now - last_active_ < idle_delay_)
+  {
+    return active_frequency_;
+  }
+  was_active_ = false;
+  return idle_frequency_;
+}
+
+bool OutputFrequencyPolicy::isActiveByDefault(const RobotMode robot_mode, const RuntimeState runtime_state)
+{
+  return robot_mode == RobotMode::RUNNING &&
+         (runtime_state == RuntimeState::PLAYING || runtime_state == RuntimeState::PAUSING ||
+          runtime_state == RuntimeState::RESUMING);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,334 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/rate_adapter.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+template <typename T>
+void readScalars(const DataPackage& package, const FieldHandle<T>& handle, double* scalars)
+{
+  T value;
+  if (package.getData(handle, value))
+  {
+    std::copy(value.begin(), value.end(), scalars);
+  }
+}
+
+void readScalars(const DataPackage& package, const FieldHandle<double>& handle, double* scalars)
+{
+  package.getData(handle, *scalars);
+}
+
+template <typename T>
+void writeScalars(DataPackage& package, const FieldHandle<T>& handle, const double* scalars, const double divisor)
+{
+  T value;
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    value[i] = scalars[i] / divisor;
+  }
+  package.setData(handle, value);
+}
+
+void writeScalars(DataPackage& package, const FieldHandle<double>& handle, const double* scalars,
+                  const double divisor)
+{
+  package.setData(handle, *scalars / divisor);
+}
+
+}  // namespace
+
+DecimatedPackage::DecimatedPackage()
+  : value(std::vector<std::string>())
+  , minimum(std::vector<std::string>())
+  , maximum(std::vector<std::string>())
+  , num_samples(0)
+  , num_skipped(0)
+{
+}
+
+DecimatedOutput::DecimatedOutput(const double max_rate, const Aggregation aggregation)
+  : period_(1.0 / max_rate), aggregation_(aggregation), window_open_(false), window_samples_(0), unread_(false)
+{
+}
+
+bool DecimatedOutput::waitForPackage(DecimatedPackage& package, const std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!cv_.wait_for(lock, timeout, [this] { return unread_; }))
+  {
+    return false;
+  }
+  return readLocked(package);
+}
+
+bool DecimatedOutput::tryGetPackage(DecimatedPackage& package)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return readLocked(package);
+}
+
+bool DecimatedOutput::readLocked(DecimatedPackage& package)
+{
+  if (!unread_)
+  {
+    return false;
+  }
+  package.value = published_.value;
+  if (aggregation_ == Aggregation::MIN_MAX)
+  {
+    package.minimum = published_.minimum;
+    package.maximum = published_.maximum;
+  }
+  package.num_samples = published_.num_samples;
+  package.num_skipped = published_.num_skipped;
+  published_.num_skipped = 0;
+  unread_ = false;
+  return true;
+}
+
+void DecimatedOutput::writeFields(DataPackage& package, const std::vector<Field>& fields,
+                                  const std::vector<double>& scalars, const double divisor)
+{
+  const double* position = scalars.data();
+  for (const auto& field : fields)
+  {
+    switch (field.width)
+    {
+      case 1:
+        writeScalars(package, field.double_handle, position, divisor);
+        break;
+      case 3:
+        writeScalars(package, field.vector3d_handle, position, divisor);
+        break;
+      default:
+        writeScalars(package, field.vector6d_handle, position, divisor);
+        break;
+    }
+    position += field.width;
+  }
+}
+
+void DecimatedOutput::bind(const size_t num_scalars)
+{
+  window_open_ = false;
+  window_samples_ = 0;
+  if (aggregation_ == Aggregation::MEAN)
+  {
+    sum_.assign(num_scalars, 0.0);
+  }
+  else if (aggregation_ == Aggregation::MIN_MAX)
+  {
+    min_.assign(num_scalars, std::numeric_limits<double>::infinity());
+    max_.assign(num_scalars, -std::numeric_limits<double>::infinity());
+  }
+}
+
+void DecimatedOutput::add(const DataPackage& package, const std::vector<Field>& fields,
+                          const std::vector<double>& scalars, const std::chrono::steady_clock::time_point now)
+{
+  // The first package is delivered right away, so consumers don't wait a whole period for the
+  // initial state
+  if (!window_open_)
+  {
+    window_open_ = true;
+    window_end_ = now;
+  }
+  ++window_samples_;
+
+  if (aggregation_ == Aggregation::MEAN)
+  {
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+      sum_[i] += scalars[i];
+    }
+  }
+  else if (aggregation_ == Aggregation::MIN_MAX)
+  {
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+      min_[i] = std::min(min_[i], scalars[i]);
+      max_[i] = std::max(max_[i], scalars[i]);
+    }
+  }
+
+  if (now < window_end_)
+  {
+    return;
+  }
+  publish(package, fields);
+
+  // Keep the windows aligned to the rate unless the stream has been interrupted
+  window_end_ += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period_);
+  if (window_end_ <= now)
+  {
+    window_end_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(period_);
+  }
+  window_samples_ = 0;
+  if (aggregation_ == Aggregation::MEAN)
+  {
+    std::fill(sum_.begin(), sum_.end(), 0.0);
+  }
+  else if (aggregation_ == Aggregation::MIN_MAX)
+  {
+    std::fill(min_.begin(), min_.end(), std::numeric_limits<double>::infinity());
+    std::fill(max_.begin(), max_.end(), -std::numeric_limits<double>::infinity());
+  }
+}
+
+void DecimatedOutput::publish(const DataPackage& package, const std::vector<Field>& fields)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_.value = package;
+    if (aggregation_ == Aggregation::MEAN)
+    {
+      writeFields(published_.value, fields, sum_, static_cast<double>(window_samples_));
+    }
+    else if (aggregation_ == Aggregation::MIN_MAX)
+    {
+      published_.minimum = package;
+      writeFields(published_.minimum, fields, min_, 1.0);
+      published_.maximum = package;
+      writeFields(published_.maximum, fields, max_, 1.0);
+    }
+    published_.num_samples = window_samples_;
+    if (unread_)
+    {
+      ++published_.num_skipped;
+    }
+    unread_ = true;
+  }
+  cv_.notify_one();
+}
+
+std::shared_ptr<DecimatedOutput> RateAdapter::addConsumer(const double max_rate, const Aggregation aggregation)
+{
+  if (!(max_rate > 0.0))
+  {
+    throw UrException("The rate of a consumer has to be positive.");
+  }
+  auto output = std::make_shared<DecimatedOutput>(max_rate, aggregation);
+  outputs_.push_back(output);
+  needs_scalars_ = needs_scalars_ || aggregation != Aggregation::LATEST;
+  if (recipe_ != nullptr)
+  {
+    output->bind(scalars_.size());
+  }
+  return output;
+}
+
+void RateAdapter::update(const DataPackage& package, const std::chrono::steady_clock::time_point now)
+{
+  std::shared_ptr<const CompiledRecipe> recipe = package.getCompiledRecipe();
+  if (recipe != recipe_)
+  {
+    bind(recipe);
+  }
+
+  if (needs_scalars_)
+  {
+    double* position = scalars_.data();
+    for (const auto& field : fields_)
+    {
+      switch (field.width)
+      {
+        case 1:
+          readScalars(package, field.double_handle, position);
+          break;
+        case 3:
+          readScalars(package, field.vector3d_handle, position);
+          break;
+        default:
+          readScalars(package, field.vector6d_handle, position);
+          break;
+      }
+      position += field.width;
+    }
+  }
+
+  for (auto& output : outputs_)
+  {
+    output->add(package, fields_, scalars_, now);
+  }
+}
+
+void RateAdapter::bind(const std::shared_ptr<const CompiledRecipe>& recipe)
+{
+  recipe_ = recipe;
+  fields_.clear();
+  size_t num_scalars = 0;
+  for (const auto& field : recipe->getFields())
+  {
+    if (!field.known)
+    {
+      continue;
+    }
+    DecimatedOutput::Field aggregated;
+    if (std::holds_alternative<double>(field.empty_value))
+    {
+      aggregated.width = 1;
+      aggregated.double_handle = recipe->getFieldHandle<double>(field.name);
+    }
+    else if (std::holds_alternative<vector3d_t>(field.empty_value))
+    {
+      aggregated.width = 3;
+      aggregated.vector3d_handle = recipe->getFieldHandle<vector3d_t>(field.name);
+    }
+    else if (std::holds_alternative<vector6d_t>(field.empty_value))
+    {
+      aggregated.width = 6;
+      aggregated.vector6d_handle = recipe->getFieldHandle<vector6d_t>(field.name);
+    }
+    else
+    {
+      continue;
+    }
+    fields_.push_back(aggregated);
+    num_scalars += aggregated.width;
+  }
+  scalars_.assign(num_scalars, 0.0);
+
+  for (auto& output : outputs_)
+  {
+    output->bind(num_scalars);
+  }
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
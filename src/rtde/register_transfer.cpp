@@ -0,0 +1,155 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/register_transfer.h"
+
+#include <algorithm>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+// Keeps 2 * sequence + 1 within the range of the integer registers
+constexpr int32_t MAX_SEQUENCE = (1 << 29) - 1;
+}  // namespace
+
+std::vector<std::string> RegisterTransferConfig::getInputRegisters() const
+{
+  std::vector<std::string> registers{ "input_int_register_" + std::to_string(control_register) };
+  for (uint32_t i = 0; i < num_data_registers; ++i)
+  {
+    registers.push_back("input_double_register_" + std::to_string(first_data_register + i));
+  }
+  return registers;
+}
+
+std::string RegisterTransferConfig::getAckField() const
+{
+  return "output_int_register_" + std::to_string(ack_register);
+}
+
+RegisterTransfer::RegisterTransfer(const RegisterTransferConfig& config)
+  : config_(config)
+  , sequence_(static_cast<int32_t>(std::chrono::steady_clock::now().time_since_epoch().count() % MAX_SEQUENCE))
+  , chunk_(config.num_data_registers, 0.0)
+  , acknowledged_(0)
+{
+  if (config.control_register < 24 || config.control_register > 47)
+  {
+    throw UrException("The control register of a register transfer has to be an input integer register in [24, 47], "
+                      "got " +
+                      std::to_string(config.control_register));
+  }
+  if (config.ack_register > 47)
+  {
+    throw UrException("The acknowledgement register of a register transfer has to be an output integer register in "
+                      "[0, 47], got " +
+                      std::to_string(config.ack_register));
+  }
+  if (config.num_data_registers < 2)
+  {
+    throw UrException("A register transfer needs at least 2 data registers, got " +
+                      std::to_string(config.num_data_registers));
+  }
+  if (config.first_data_register < 24 || config.first_data_register + config.num_data_registers > 48)
+  {
+    throw UrException("The data registers of a register transfer have to be input double registers in [24, 47], got " +
+                      std::to_string(config.first_data_register) + " to " +
+                      std::to_string(config.first_data_register + config.num_data_registers - 1));
+  }
+}
+
+size_t RegisterTransfer::getNumChunks(const size_t num_values) const
+{
+  return 1 + (num_values + config_.num_data_registers - 1) / config_.num_data_registers;
+}
+
+bool RegisterTransfer::send(const std::vector<double>& values, const int32_t id, const WriteFunction& write,
+                            const std::chrono::milliseconds chunk_timeout)
+{
+  if (values.size() > config_.capacity)
+  {
+    throw UrException("Cannot transfer " + std::to_string(values.size()) +
+                      " values, the robot program holds at most " + std::to_string(config_.capacity));
+  }
+
+  std::fill(chunk_.begin(), chunk_.end(), 0.0);
+  chunk_[0] = static_cast<double>(values.size());
+  chunk_[1] = static_cast<double>(id);
+  if (!sendChunk(2 * nextSequence() + 1, chunk_, write, chunk_timeout))
+  {
+    return false;
+  }
+
+  for (size_t offset = 0; offset < values.size(); offset += config_.num_data_registers)
+  {
+    const size_t count = std::min<size_t>(config_.num_data_registers, values.size() - offset);
+    std::copy(values.begin() + offset, values.begin() + offset + count, chunk_.begin());
+    std::fill(chunk_.begin() + count, chunk_.end(), 0.0);
+    if (!sendChunk(2 * nextSequence(), chunk_, write, chunk_timeout))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RegisterTransfer::onAcknowledgement(const int32_t control)
+{
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    acknowledged_ = control;
+  }
+  cv_.notify_all();
+}
+
+bool RegisterTransfer::sendChunk(const int32_t control, const std::vector<double>& data, const WriteFunction& write,
+                                 const std::chrono::milliseconds timeout)
+{
+  if (!write(control, data))
+  {
+    return false;
+  }
+  std::unique_lock<std::mutex> lk(mutex_);
+  return cv_.wait_for(lk, timeout, [this, control] { return acknowledged_ == control; });
+}
+
+int32_t RegisterTransfer::nextSequence()
+{
+  sequence_ = sequence_ % MAX_SEQUENCE + 1;
+  return sequence_;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -27,17 +27,23 @@
 //----------------------------------------------------------------------
 
 #include "ur_client_library/rtde/rtde_client.h"
+#include "ur_client_library/clock.h"
 #include "ur_client_library/exceptions.h"
+#include "ur_client_library/ur/version_capabilities.h"
 #include <algorithm>
 
 namespace urcl
 {
 namespace rtde_interface
 {
+std::mutex RTDEClient::handshake_cache_mutex_;
+std::unordered_map<std::string, RTDEClient::HandshakeCacheEntry> RTDEClient::handshake_cache_;
+
 RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::string& output_recipe_file,
                        const std::string& input_recipe_file, double target_frequency, bool ignore_unavailable_outputs)
   : stream_(robot_ip, UR_RTDE_PORT)
   , output_recipe_(ensureTimestampIsPresent(readRecipe(output_recipe_file)))
+  , minimize_output_recipe_(false)
   , ignore_unavailable_outputs_(ignore_unavailable_outputs)
   , input_recipe_(readRecipe(input_recipe_file))
   , parser_(output_recipe_)
@@ -45,10 +51,22 @@ RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const st
   , notifier_(notifier)
   , pipeline_(std::make_unique<comm::Pipeline<RTDEPackage>>(*prod_, PIPELINE_NAME, notifier, true))
   , writer_(&stream_, input_recipe_)
-  , max_frequency_(URE_MAX_FREQUENCY)
+  , max_frequency_(VersionCapabilities::URE_MAX_RTDE_FREQUENCY)
   , target_frequency_(target_frequency)
   , client_state_(ClientState::UNINITIALIZED)
+  , data_package_pool_size_(0)
+  , lazy_decoding_(false)
+  , data_package_history_size_(0)
+  , shared_state_slot_count_(SharedStatePublisher::DEFAULT_SLOT_COUNT)
+  , state_caching_(false)
+  , typed_recipe_tag_(nullptr)
+  , handshake_caching_(true)
+  , frequency_switch_running_(false)
+  , policy_frequency_(0.0)
+  , pipeline_queue_capacity_(comm::Pipeline<RTDEPackage>::DEFAULT_QUEUE_CAPACITY)
+  , pipeline_queue_policy_(comm::OverflowPolicy::DROP_NEWEST)
 {
+  pipeline_->setMetricLabels({ { "host", robot_ip } });
 }
 
 RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::vector<std::string>& output_recipe,
@@ -56,6 +74,7 @@ RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const st
                        bool ignore_unavailable_outputs)
   : stream_(robot_ip, UR_RTDE_PORT)
   , output_recipe_(ensureTimestampIsPresent(output_recipe))
+  , minimize_output_recipe_(false)
   , ignore_unavailable_outputs_(ignore_unavailable_outputs)
   , input_recipe_(input_recipe)
   , parser_(output_recipe_)
@@ -63,15 +82,32 @@ RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const st
   , notifier_(notifier)
   , pipeline_(std::make_unique<comm::Pipeline<RTDEPackage>>(*prod_, PIPELINE_NAME, notifier, true))
   , writer_(&stream_, input_recipe_)
-  , max_frequency_(URE_MAX_FREQUENCY)
+  , max_frequency_(VersionCapabilities::URE_MAX_RTDE_FREQUENCY)
   , target_frequency_(target_frequency)
   , client_state_(ClientState::UNINITIALIZED)
+  , data_package_pool_size_(0)
+  , lazy_decoding_(false)
+  , data_package_history_size_(0)
+  , shared_state_slot_count_(SharedStatePublisher::DEFAULT_SLOT_COUNT)
+  , state_caching_(false)
+  , typed_recipe_tag_(nullptr)
+  , handshake_caching_(true)
+  , frequency_switch_running_(false)
+  , policy_frequency_(0.0)
+  , pipeline_queue_capacity_(comm::Pipeline<RTDEPackage>::DEFAULT_QUEUE_CAPACITY)
+  , pipeline_queue_policy_(comm::OverflowPolicy::DROP_NEWEST)
 {
+  pipeline_->setMetricLabels({ { "host", robot_ip } });
 }
 
 RTDEClient::~RTDEClient()
 {
   disconnect();
+  if (shared_state_publisher_ != nullptr)
+  {
+    // Callers may still reference the publisher, but no packages are published any more
+    shared_state_publisher_->deactivate();
+  }
 }
 
 bool RTDEClient::init(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
@@ -81,6 +117,17 @@ bool RTDEClient::init(const size_t max_num_tries, const std::chrono::millisecond
     return true;
   }
 
+  if (minimize_output_recipe_)
+  {
+    const std::vector<std::string> minimized_recipe = minimizeOutputRecipe(output_recipe_);
+    if (minimized_recipe != output_recipe_)
+    {
+      URCL_LOG_INFO("Minimized the RTDE output recipe from %zu to %zu fields.", output_recipe_.size(),
+                    minimized_recipe.size());
+      resetOutputRecipe(minimized_recipe);
+    }
+  }
+
   unsigned int attempts = 0;
   while (attempts < MAX_INITIALIZE_ATTEMPTS)
   {
@@ -88,8 +135,9 @@ bool RTDEClient::init(const size_t max_num_tries, const std::chrono::millisecond
     if (client_state_ == ClientState::INITIALIZED)
       return true;
 
-    URCL_LOG_ERROR("Failed to initialize RTDE client, retrying in 10 seconds");
-    std::this_thread::sleep_for(std::chrono::seconds(10));
+    URCL_LOG_ERROR("Failed to initialize RTDE client, retrying in %ld ms",
+                   static_cast<long>(reconnection_time.count()));
+    getClock()->sleepFor(reconnection_time);
     attempts++;
   }
   std::stringstream ss;
@@ -99,67 +147,331 @@ bool RTDEClient::init(const size_t max_num_tries, const std::chrono::millisecond
 
 void RTDEClient::setupCommunication(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
 {
+  HandshakeCacheEntry cache_entry;
+  bool cached_handshake = findHandshakeCacheEntry(cache_entry);
+  if (cached_handshake && cache_entry.output_recipe != output_recipe_)
+  {
+    // Unavailable variables have already been removed from the cached recipe
+    resetOutputRecipe(cache_entry.output_recipe);
+  }
+  const std::vector<std::string> requested_output_recipe =
+      cached_handshake ? cache_entry.requested_output_recipe : output_recipe_;
+  const double requested_frequency = target_frequency_;
+
   client_state_ = ClientState::INITIALIZING;
-  // A running pipeline is needed inside setup
+  // Typed data packages are only used once the output recipe has been verified
+  parser_.setDataPackageFactory(nullptr);
+  parser_.clearOutputRecipes();
+  // A running pipeline is needed inside setup, where answers sent back-to-back must not be dropped
+  pipeline_->setQueue(comm::Pipeline<RTDEPackage>::DEFAULT_QUEUE_CAPACITY, comm::OverflowPolicy::DROP_NEWEST);
   pipeline_->init(max_num_tries, reconnection_time);
   pipeline_->run();
 
   uint16_t protocol_version = MAX_RTDE_PROTOCOL_VERSION;
-  while (!negotiateProtocolVersion(protocol_version) && client_state_ == ClientState::INITIALIZING)
+  if (cached_handshake)
   {
-    URCL_LOG_INFO("Robot did not accept RTDE protocol version '%hu'. Trying lower protocol version", protocol_version);
-    protocol_version--;
-    if (protocol_version == 0)
+    cached_handshake = setupCachedHandshake(cache_entry);
+    if (cached_handshake)
+    {
+      protocol_version = cache_entry.protocol_version;
+    }
+    else
     {
-      throw UrException("Protocol version for RTDE communication could not be established. Robot didn't accept any of "
-                        "the suggested versions.");
+      URCL_LOG_WARN("The robot's answers didn't match the cached RTDE handshake. Reconnecting to perform the full "
+                    "handshake.");
+      {
+        std::lock_guard<std::mutex> lock(handshake_cache_mutex_);
+        handshake_cache_.erase(stream_.getHost());
+      }
+      target_frequency_ = requested_frequency;
+      pipeline_->stop();
+      stream_.disconnect();
+      pipeline_->init(max_num_tries, reconnection_time);
+      pipeline_->run();
     }
   }
-  if (client_state_ == ClientState::UNINITIALIZED)
-    return;
 
-  URCL_LOG_INFO("Negotiated RTDE protocol version to %hu.", protocol_version);
-  parser_.setProtocolVersion(protocol_version);
+  if (!cached_handshake)
+  {
+    while (!negotiateProtocolVersion(protocol_version) && client_state_ == ClientState::INITIALIZING)
+    {
+      URCL_LOG_INFO("Robot did not accept RTDE protocol version '%hu'. Trying lower protocol version",
+                    protocol_version);
+      protocol_version--;
+      if (protocol_version == 0)
+      {
+        throw UrException("Protocol version for RTDE communication could not be established. Robot didn't accept any "
+                          "of the suggested versions.");
+      }
+    }
+    if (client_state_ == ClientState::UNINITIALIZED)
+      return;
+
+    URCL_LOG_INFO("Negotiated RTDE protocol version to %hu.", protocol_version);
+    parser_.setProtocolVersion(protocol_version);
+
+    queryURControlVersion();
+    if (client_state_ == ClientState::UNINITIALIZED)
+      return;
+
+    max_frequency_ = VersionCapabilities(urcontrol_version_).getMaxRtdeFrequency();
 
-  queryURControlVersion();
+    if (target_frequency_ == 0)
+    {
+      // Default to maximum frequency
+      target_frequency_ = max_frequency_;
+    }
+    else if (target_frequency_ <= 0.0 || target_frequency_ > max_frequency_)
+    {
+      // Target frequency outside valid range
+      throw UrException("Invalid target frequency of RTDE connection");
+    }
+
+    setupOutputs(protocol_version);
+    if (client_state_ == ClientState::UNINITIALIZED)
+      return;
+  }
+
+  if (!isRobotBooted())
+  {
+    disconnect();
+    return;
+  }
+
+  // Additional recipes are set up after checking the boot state, so only packages of the main
+  // output recipe are received while doing that.
+  setupAdditionalOutputs(protocol_version);
   if (client_state_ == ClientState::UNINITIALIZED)
     return;
 
-  if (urcontrol_version_.major < 5)
+  // With a cached handshake, the inputs have already been set up together with the outputs.
+  if (!cached_handshake)
   {
-    max_frequency_ = CB3_MAX_FREQUENCY;
+    setupInputs();
+    if (client_state_ == ClientState::UNINITIALIZED)
+      return;
   }
 
-  if (target_frequency_ == 0)
+  // The output recipe is final now, so the received packages can be prepared for it.
+  parser_.setLazyDecoding(lazy_decoding_);
+  if (data_package_pool_size_ > 0)
   {
-    // Default to maximum frequency
-    target_frequency_ = max_frequency_;
+    data_package_pool_ = DataPackagePool::create(parser_.getCompiledRecipe(), protocol_version,
+                                                 data_package_pool_size_, lazy_decoding_);
+    parser_.setDataPackagePool(data_package_pool_);
   }
-  else if (target_frequency_ <= 0.0 || target_frequency_ > max_frequency_)
+  data_package_history_.reset();
+  if (data_package_history_size_ > 0)
   {
-    // Target frequency outside valid range
-    throw UrException("Invalid target frequency of RTDE connection");
+    data_package_history_ =
+        std::make_shared<DataPackageHistory>(parser_.getCompiledRecipe(), data_package_history_size_);
   }
-
-  setupOutputs(protocol_version);
-  if (client_state_ == ClientState::UNINITIALIZED)
-    return;
-
-  if (!isRobotBooted())
+  if (shared_state_publisher_ != nullptr)
   {
-    disconnect();
-    return;
+    shared_state_publisher_->deactivate();
+  }
+  shared_state_publisher_.reset();
+  if (!shared_state_name_.empty())
+  {
+    shared_state_publisher_ = std::make_shared<SharedStatePublisher>(
+        shared_state_name_, parser_.getCompiledRecipe(), shared_state_slot_count_, protocol_version);
+  }
+  state_cache_.reset();
+  if (state_caching_)
+  {
+    state_cache_ = std::make_shared<StateCache>(parser_.getCompiledRecipe());
+  }
+  if (typed_package_factory_)
+  {
+    if (!typed_recipe_check_(*parser_.getCompiledRecipe()))
+    {
+      throw UrException("The RTDE output recipe doesn't match the configured typed recipe. Make sure to construct the "
+                        "client using the typed recipe's field names and that all fields are available on the robot.");
+    }
+    auto factory = typed_package_factory_;
+    parser_.setDataPackageFactory([factory, protocol_version]() { return factory(protocol_version); });
   }
 
-  setupInputs();
-  if (client_state_ == ClientState::UNINITIALIZED)
-    return;
+  if (handshake_caching_ && additional_output_recipes_.empty())
+  {
+    HandshakeCacheEntry entry;
+    entry.requested_output_recipe = requested_output_recipe;
+    entry.output_recipe = output_recipe_;
+    entry.input_recipe = input_recipe_;
+    entry.requested_frequency = requested_frequency;
+    entry.target_frequency = target_frequency_;
+    entry.protocol_version = protocol_version;
+    entry.urcontrol_version = urcontrol_version_;
+    std::lock_guard<std::mutex> lock(handshake_cache_mutex_);
+    handshake_cache_[stream_.getHost()] = entry;
+  }
 
   // We finished communication for now
   pipeline_->stop();
   client_state_ = ClientState::INITIALIZED;
 }
 
+void RTDEClient::clearHandshakeCache()
+{
+  std::lock_guard<std::mutex> lock(handshake_cache_mutex_);
+  handshake_cache_.clear();
+}
+
+void RTDEClient::setLatencyInstrumentation(const bool enabled, const bool kernel_timestamps)
+{
+  if (kernel_timestamps && client_state_ > ClientState::UNINITIALIZED)
+  {
+    throw UrException("Kernel timestamps have to be requested before initializing the RTDE client.");
+  }
+  if (client_state_ != ClientState::UNINITIALIZED && client_state_ != ClientState::INITIALIZED)
+  {
+    throw UrException("Latency instrumentation has to be configured before starting the RTDE client.");
+  }
+  latency_statistics_ = enabled ? std::make_shared<comm::LatencyStatistics>() : nullptr;
+  stream_.setKernelTimestamping(enabled && kernel_timestamps);
+  pipeline_->setLatencyStatistics(latency_statistics_);
+}
+
+void RTDEClient::setThreadConfig(const ThreadConfig& config)
+{
+  thread_config_ = config;
+  pipeline_->setProducerThreadConfig(thread_config_.withNameSuffix("rx"));
+  writer_.setThreadConfig(thread_config_.withNameSuffix("tx"));
+}
+
+void RTDEClient::setBufferedReading(const bool buffered)
+{
+  if (client_state_ > ClientState::UNINITIALIZED)
+  {
+    throw UrException("Buffered reading has to be configured before initializing the RTDE client.");
+  }
+  stream_.setBufferedReading(buffered);
+}
+
+void RTDEClient::setReconnectionBackoff(const comm::BackoffConfig& config)
+{
+  reconnection_backoff_ = config;
+  prod_->setReconnectionBackoff(reconnection_backoff_);
+}
+
+void RTDEClient::setConnectionStateCallback(std::function<void(comm::ConnectionState)> callback)
+{
+  connection_state_callback_ = std::move(callback);
+  prod_->setConnectionStateCallback(connection_state_callback_);
+}
+
+bool RTDEClient::findHandshakeCacheEntry(HandshakeCacheEntry& entry)
+{
+  // Additional output recipes are set up separately, as their recipe ids depend on the order of setup.
+  if (!handshake_caching_ || !additional_output_recipes_.empty())
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(handshake_cache_mutex_);
+  auto it = handshake_cache_.find(stream_.getHost());
+  if (it == handshake_cache_.end())
+  {
+    return false;
+  }
+  const HandshakeCacheEntry& cached = it->second;
+  const bool same_outputs = cached.requested_output_recipe == output_recipe_ || cached.output_recipe == output_recipe_;
+  const bool same_frequency =
+      cached.requested_frequency == target_frequency_ || cached.target_frequency == target_frequency_;
+  // Silently using a stripped-down recipe is only allowed if unavailable outputs may be ignored.
+  const bool outputs_allowed = ignore_unavailable_outputs_ || cached.output_recipe == cached.requested_output_recipe;
+  if (!same_outputs || !same_frequency || !outputs_allowed || cached.input_recipe != input_recipe_)
+  {
+    return false;
+  }
+  entry = cached;
+  return true;
+}
+
+bool RTDEClient::setupCachedHandshake(const HandshakeCacheEntry& entry)
+{
+  URCL_LOG_INFO("Setting up RTDE communication using the cached handshake with protocol version %hu",
+                entry.protocol_version);
+  // All requests are sent at once, so the answers have to be parsed with the cached protocol version.
+  parser_.setProtocolVersion(entry.protocol_version);
+
+  uint8_t buffer[16384];
+  size_t size = RequestProtocolVersionRequest::generateSerializedRequest(buffer, entry.protocol_version);
+  size += GetUrcontrolVersionRequest::generateSerializedRequest(buffer + size);
+  if (entry.protocol_version == 2)
+  {
+    size += ControlPackageSetupOutputsRequest::generateSerializedRequest(buffer + size, entry.target_frequency,
+                                                                        output_recipe_);
+  }
+  else
+  {
+    size += ControlPackageSetupOutputsRequest::generateSerializedRequest(buffer + size, output_recipe_);
+  }
+  size += ControlPackageSetupInputsRequest::generateSerializedRequest(buffer + size, input_recipe_);
+  size_t written;
+  if (!stream_.write(buffer, size, written))
+  {
+    URCL_LOG_ERROR("Could not send RTDE handshake requests to robot");
+    return false;
+  }
+
+  // Answers arrive in the order of the requests, text messages might be received in between.
+  std::unique_ptr<RTDEPackage> package;
+  auto receive_answer = [this, &package](const PackageType type) {
+    for (unsigned int num_packages = 0; num_packages < MAX_REQUEST_RETRIES; ++num_packages)
+    {
+      if (!pipeline_->getNextProduct(package, std::chrono::milliseconds(1000)))
+      {
+        return false;
+      }
+      if (package->getType() == type)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (!receive_answer(PackageType::RTDE_REQUEST_PROTOCOL_VERSION) ||
+      !static_cast<RequestProtocolVersion*>(package.get())->accepted_)
+  {
+    return false;
+  }
+  if (!receive_answer(PackageType::RTDE_GET_URCONTROL_VERSION) ||
+      static_cast<GetUrcontrolVersion*>(package.get())->version_information_ != entry.urcontrol_version)
+  {
+    return false;
+  }
+  if (!receive_answer(PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS))
+  {
+    return false;
+  }
+  std::vector<std::string> variable_types =
+      splitVariableTypes(static_cast<ControlPackageSetupOutputs*>(package.get())->variable_types_);
+  if (variable_types.size() != output_recipe_.size() ||
+      std::find(variable_types.begin(), variable_types.end(), "NOT_FOUND") != variable_types.end())
+  {
+    return false;
+  }
+  if (!receive_answer(PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS))
+  {
+    return false;
+  }
+  ControlPackageSetupInputs* setup_inputs = static_cast<ControlPackageSetupInputs*>(package.get());
+  variable_types = splitVariableTypes(setup_inputs->variable_types_);
+  if (variable_types.size() != input_recipe_.size() ||
+      std::find(variable_types.begin(), variable_types.end(), "NOT_FOUND") != variable_types.end() ||
+      std::find(variable_types.begin(), variable_types.end(), "IN_USE") != variable_types.end())
+  {
+    return false;
+  }
+
+  urcontrol_version_ = entry.urcontrol_version;
+  max_frequency_ = VersionCapabilities(urcontrol_version_).getMaxRtdeFrequency();
+  target_frequency_ = entry.target_frequency;
+  writer_.init(setup_inputs->input_recipe_id_, target_frequency_);
+  return true;
+}
+
 bool RTDEClient::negotiateProtocolVersion(const uint16_t protocol_version)
 {
   // Protocol version should always be 1 before starting negotiation
@@ -185,9 +497,10 @@ bool RTDEClient::negotiateProtocolVersion(const uint16_t protocol_version)
       disconnect();
       return false;
     }
-    if (rtde_interface::RequestProtocolVersion* tmp_version =
-            dynamic_cast<rtde_interface::RequestProtocolVersion*>(package.get()))
+    if (package->getType() == PackageType::RTDE_REQUEST_PROTOCOL_VERSION)
     {
+      rtde_interface::RequestProtocolVersion* tmp_version =
+          static_cast<rtde_interface::RequestProtocolVersion*>(package.get());
       // Reset the num_tries variable in case we have to try with another protocol version.
       num_retries = 0;
       return tmp_version->accepted_;
@@ -232,9 +545,10 @@ void RTDEClient::queryURControlVersion()
       return;
     }
 
-    if (rtde_interface::GetUrcontrolVersion* tmp_urcontrol_version =
-            dynamic_cast<rtde_interface::GetUrcontrolVersion*>(package.get()))
+    if (package->getType() == PackageType::RTDE_GET_URCONTROL_VERSION)
     {
+      rtde_interface::GetUrcontrolVersion* tmp_urcontrol_version =
+          static_cast<rtde_interface::GetUrcontrolVersion*>(package.get());
       urcontrol_version_ = tmp_urcontrol_version->version_information_;
       return;
     }
@@ -262,7 +576,12 @@ void RTDEClient::resetOutputRecipe(const std::vector<std::string> new_recipe)
   output_recipe_.assign(new_recipe.begin(), new_recipe.end());
   parser_ = RTDEParser(output_recipe_);
   prod_ = std::make_unique<comm::URProducer<RTDEPackage>>(stream_, parser_);
+  prod_->setReconnectionBackoff(reconnection_backoff_);
+  prod_->setConnectionStateCallback(connection_state_callback_);
   pipeline_ = std::make_unique<comm::Pipeline<RTDEPackage>>(*prod_, PIPELINE_NAME, notifier_, true);
+  pipeline_->setMetricLabels({ { "host", stream_.getHost() } });
+  pipeline_->setLatencyStatistics(latency_statistics_);
+  pipeline_->setProducerThreadConfig(thread_config_.withNameSuffix("rx"));
 }
 
 void RTDEClient::setupOutputs(const uint16_t protocol_version)
@@ -271,7 +590,7 @@ void RTDEClient::setupOutputs(const uint16_t protocol_version)
   size_t size;
   size_t written;
   uint8_t buffer[8192];
-  URCL_LOG_INFO("Setting up RTDE communication with frequency %f", target_frequency_);
+  URCL_LOG_INFO("Setting up RTDE communication with frequency %f", target_frequency_.load());
 
   while (num_retries < MAX_REQUEST_RETRIES)
   {
@@ -306,10 +625,10 @@ void RTDEClient::setupOutputs(const uint16_t protocol_version)
       return;
     }
 
-    if (rtde_interface::ControlPackageSetupOutputs* tmp_output =
-            dynamic_cast<rtde_interface::ControlPackageSetupOutputs*>(package.get()))
-
+    if (package->getType() == PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS)
     {
+      rtde_interface::ControlPackageSetupOutputs* tmp_output =
+          static_cast<rtde_interface::ControlPackageSetupOutputs*>(package.get());
       std::vector<std::string> variable_types = splitVariableTypes(tmp_output->variable_types_);
       std::vector<std::string> available_variables;
       std::vector<std::string> unavailable_variables;
@@ -375,6 +694,96 @@ void RTDEClient::setupOutputs(const uint16_t protocol_version)
   throw UrException(ss.str());
 }
 
+void RTDEClient::setupAdditionalOutputs(const uint16_t protocol_version)
+{
+  if (additional_output_recipes_.empty())
+  {
+    return;
+  }
+  if (protocol_version != 2)
+  {
+    throw UrException("Additional RTDE output recipes require RTDE protocol version 2.");
+  }
+
+  size_t size;
+  size_t written;
+  uint8_t buffer[8192];
+  for (auto& additional_recipe : additional_output_recipes_)
+  {
+    if (additional_recipe.frequency <= 0.0 || additional_recipe.frequency > max_frequency_)
+    {
+      throw UrException("Invalid frequency of additional RTDE output recipe");
+    }
+
+    unsigned int num_retries = 0;
+    bool accepted = false;
+    while (!accepted)
+    {
+      if (num_retries >= MAX_REQUEST_RETRIES)
+      {
+        std::stringstream ss;
+        ss << "Could not setup additional RTDE output recipe after " << MAX_REQUEST_RETRIES << " tries.";
+        throw UrException(ss.str());
+      }
+      size = ControlPackageSetupOutputsRequest::generateSerializedRequest(buffer, additional_recipe.frequency,
+                                                                          additional_recipe.recipe);
+      if (!stream_.write(buffer, size, written))
+      {
+        URCL_LOG_ERROR("Could not send additional RTDE output recipe to robot, disconnecting");
+        disconnect();
+        return;
+      }
+
+      std::unique_ptr<RTDEPackage> package;
+      if (!pipeline_->getLatestProduct(package, std::chrono::milliseconds(1000)))
+      {
+        URCL_LOG_ERROR("Did not receive confirmation on additional RTDE output recipe, disconnecting");
+        disconnect();
+        return;
+      }
+      if (package->getType() != PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS)
+      {
+        URCL_LOG_WARN("Did not receive answer to additional RTDE output setup. Message received instead: %s. "
+                      "Retrying...",
+                      package->toString().c_str());
+        num_retries++;
+        continue;
+      }
+
+      rtde_interface::ControlPackageSetupOutputs* tmp_output =
+          static_cast<rtde_interface::ControlPackageSetupOutputs*>(package.get());
+      std::vector<std::string> variable_types = splitVariableTypes(tmp_output->variable_types_);
+      std::vector<std::string> available_variables;
+      for (std::size_t i = 0; i < variable_types.size() && i < additional_recipe.recipe.size(); ++i)
+      {
+        if (variable_types[i] != "NOT_FOUND")
+        {
+          available_variables.push_back(additional_recipe.recipe[i]);
+        }
+      }
+
+      if (available_variables.size() == additional_recipe.recipe.size())
+      {
+        accepted = true;
+        parser_.addOutputRecipe(tmp_output->output_recipe_id_,
+                                std::make_shared<const CompiledRecipe>(additional_recipe.recipe),
+                                additional_recipe.callback);
+      }
+      else if (ignore_unavailable_outputs_ && !available_variables.empty())
+      {
+        URCL_LOG_WARN("Some variables of an additional output recipe are not recognized by the robot. They will "
+                      "be removed from the recipe.");
+        additional_recipe.recipe = available_variables;
+      }
+      else
+      {
+        throw UrException("An additional RTDE output recipe contains variables that are not recognized by the "
+                          "robot.");
+      }
+    }
+  }
+}
+
 void RTDEClient::setupInputs()
 {
   unsigned int num_retries = 0;
@@ -399,10 +808,10 @@ void RTDEClient::setupInputs()
       return;
     }
 
-    if (rtde_interface::ControlPackageSetupInputs* tmp_input =
-            dynamic_cast<rtde_interface::ControlPackageSetupInputs*>(package.get()))
-
+    if (package->getType() == PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS)
     {
+      rtde_interface::ControlPackageSetupInputs* tmp_input =
+          static_cast<rtde_interface::ControlPackageSetupInputs*>(package.get());
       std::vector<std::string> variable_types = splitVariableTypes(tmp_input->variable_types_);
       assert(input_recipe_.size() == variable_types.size());
       for (std::size_t i = 0; i < variable_types.size(); ++i)
@@ -422,7 +831,7 @@ void RTDEClient::setupInputs()
           throw UrException(message);
         }
       }
-      writer_.init(tmp_input->input_recipe_id_);
+      writer_.init(tmp_input->input_recipe_id_, target_frequency_);
 
       return;
     }
@@ -444,16 +853,44 @@ void RTDEClient::setupInputs()
 
 void RTDEClient::disconnect()
 {
+  stopFrequencySwitching();
   // If communication is started it should be paused before disconnecting
+  if (stream_watchdog_ != nullptr)
+  {
+    stream_watchdog_->stop();
+  }
   if (client_state_ > ClientState::UNINITIALIZED)
   {
     sendPause();
     pipeline_->stop();
     stream_.disconnect();
   }
+  stopRecording();
   client_state_ = ClientState::UNINITIALIZED;
 }
 
+void RTDEClient::startRecording(const std::string& path)
+{
+  if (client_state_ != ClientState::INITIALIZED)
+  {
+    throw UrException("A recording can only be started after the RTDE client has been initialized and before it is "
+                      "started.");
+  }
+  stopRecording();
+  auto recorder = std::make_shared<RTDERecorder>(path);
+  recorder->open(output_recipe_, parser_.getProtocolVersion());
+  recorder_ = recorder;
+}
+
+void RTDEClient::stopRecording()
+{
+  if (recorder_ != nullptr)
+  {
+    recorder_->close();
+    recorder_.reset();
+  }
+}
+
 bool RTDEClient::isRobotBooted()
 {
   // We need  to trigger the robot to start sending RTDE data packages in the negotiated format, in order to read
@@ -462,6 +899,7 @@ bool RTDEClient::isRobotBooted()
     return false;
 
   std::unique_ptr<RTDEPackage> package;
+  const FieldHandle<double> timestamp_handle = getOutputFieldHandle<double>("timestamp");
   double timestamp = 0;
   int reading_count = 0;
   // During bootup the RTDE interface gets restarted once. If we connect to the RTDE interface before that happens, we
@@ -476,9 +914,12 @@ bool RTDEClient::isRobotBooted()
     int timeout = static_cast<int>((1 / target_frequency_) * 1000) * 10;
     if (pipeline_->getLatestProduct(package, std::chrono::milliseconds(timeout)))
     {
-      rtde_interface::DataPackage* tmp_input = dynamic_cast<rtde_interface::DataPackage*>(package.get());
-      tmp_input->getData("timestamp", timestamp);
-      reading_count++;
+      rtde_interface::DataPackage* tmp_input = toDataPackage(package.get());
+      if (tmp_input != nullptr)
+      {
+        tmp_input->getData(timestamp_handle, timestamp);
+        reading_count++;
+      }
     }
     else
     {
@@ -504,6 +945,146 @@ bool RTDEClient::start()
     return false;
   }
 
+  if (!field_change_monitor_.empty())
+  {
+    field_change_monitor_.setRecipe(*parser_.getCompiledRecipe());
+  }
+  if (!io_event_engine_.empty())
+  {
+    io_event_engine_.setRecipe(*parser_.getCompiledRecipe());
+  }
+  if (stream_monitor_ != nullptr)
+  {
+    stream_monitor_->setRecipe(*parser_.getCompiledRecipe());
+    stream_monitor_->setTargetFrequency(target_frequency_);
+    stream_monitor_->restart();
+  }
+  if (stream_watchdog_ != nullptr)
+  {
+    stream_watchdog_->setRecipe(*parser_.getCompiledRecipe());
+    stream_watchdog_->setTargetFrequency(target_frequency_);
+    stream_watchdog_->start();
+  }
+  if (clock_synchronizer_ != nullptr)
+  {
+    clock_synchronizer_->setRecipe(*parser_.getCompiledRecipe());
+  }
+  if (frequency_policy_ != nullptr)
+  {
+    frequency_policy_->setRecipe(*parser_.getCompiledRecipe());
+    if (!frequency_switch_thread_.joinable())
+    {
+      policy_frequency_ = target_frequency_.load();
+      frequency_switch_running_ = true;
+      frequency_switch_thread_ = std::thread(&RTDEClient::frequencySwitchLoop, this);
+    }
+  }
+  if (client_state_ == ClientState::INITIALIZED)
+  {
+    // The producer thread is only started once, so the callbacks must not be changed after resuming from pause.
+    if (data_package_callback_ || !data_package_observers_.empty() || !field_change_monitor_.empty() ||
+        !io_event_engine_.empty() || data_package_history_ != nullptr || shared_state_publisher_ != nullptr ||
+        state_cache_ != nullptr || stream_monitor_ != nullptr || stream_watchdog_ != nullptr ||
+        clock_synchronizer_ != nullptr || frequency_policy_ != nullptr)
+    {
+      pipeline_->setProducerCallback([this](std::unique_ptr<RTDEPackage>& product) {
+        DataPackage* data_package = toDataPackage(product.get());
+        if (data_package == nullptr)
+        {
+          return false;
+        }
+        // Pool, history, publisher, cache, monitors and the clock synchronizer are only replaced while no data
+        // packages are received, i.e. while the client is paused.
+        if (stream_monitor_ != nullptr)
+        {
+          stream_monitor_->update(*data_package, data_package->getTimestamps().receive);
+        }
+        if (stream_watchdog_ != nullptr)
+        {
+          stream_watchdog_->update(*data_package, data_package->getTimestamps().receive);
+        }
+        if (clock_synchronizer_ != nullptr)
+        {
+          clock_synchronizer_->update(*data_package);
+        }
+        if (frequency_policy_ != nullptr)
+        {
+          const double frequency = frequency_policy_->update(*data_package, data_package->getTimestamps().receive);
+          if (frequency != policy_frequency_.load(std::memory_order_relaxed))
+          {
+            {
+              std::lock_guard<std::mutex> lock(frequency_switch_mutex_);
+              policy_frequency_ = frequency;
+            }
+            frequency_switch_cv_.notify_one();
+          }
+        }
+        if (data_package_history_ != nullptr)
+        {
+          data_package_history_->push(*data_package);
+        }
+        if (shared_state_publisher_ != nullptr)
+        {
+          shared_state_publisher_->publish(*data_package, data_package->getTimestamps().receive);
+        }
+        if (state_cache_ != nullptr)
+        {
+          state_cache_->update(*data_package, data_package->getTimestamps().receive);
+        }
+        field_change_monitor_.update(*data_package);
+        if (!io_event_engine_.empty())
+        {
+          io_event_engine_.update(*data_package, data_package->getTimestamps().receive);
+        }
+        for (const auto& observer : data_package_observers_)
+        {
+          comm::ExecutionBudget::Measurement measurement(observer.budget.get());
+          observer.callback(*data_package);
+        }
+        if (!data_package_callback_)
+        {
+          return false;
+        }
+        {
+          comm::ExecutionBudget::Measurement measurement(data_package_callback_budget_.get());
+          data_package_callback_(*data_package);
+        }
+        if (data_package_pool_ != nullptr)
+        {
+          product.release();
+          data_package_pool_->release(std::unique_ptr<DataPackage>(data_package));
+        }
+        else
+        {
+          product.reset();
+        }
+        return true;
+      });
+    }
+    else
+    {
+      pipeline_->setProducerCallback(nullptr);
+    }
+    pipeline_->setQueue(pipeline_queue_capacity_, pipeline_queue_policy_);
+    std::shared_ptr<StreamMonitor> stream_monitor = stream_monitor_;
+    if (stream_monitor != nullptr)
+    {
+      pipeline_->setOverflowCallback([stream_monitor]() { stream_monitor->reportOverflow(); });
+    }
+    else
+    {
+      pipeline_->setOverflowCallback(nullptr);
+    }
+    std::shared_ptr<RTDERecorder> recorder = recorder_;
+    if (recorder != nullptr)
+    {
+      prod_->setRawFrameCallback([recorder](const uint8_t* buf, const size_t size) { recorder->record(buf, size); });
+    }
+    else
+    {
+      prod_->setRawFrameCallback(nullptr);
+    }
+  }
   pipeline_->run();
 
   if (sendStart())
@@ -517,6 +1098,297 @@ bool RTDEClient::start()
   }
 }
 
+bool RTDEClient::switchOutputRecipe(const std::vector<std::string>& new_recipe)
+{
+  std::lock_guard<std::mutex> setup_lock(output_setup_mutex_);
+  if (client_state_ < ClientState::INITIALIZED)
+  {
+    throw UrException("The output recipe can only be switched after the RTDE client has been initialized.");
+  }
+  if (recorder_ != nullptr)
+  {
+    throw UrException("The output recipe cannot be switched while recording, as the recording is based on the "
+                      "current output recipe.");
+  }
+  std::vector<std::string> recipe = ensureTimestampIsPresent(new_recipe);
+  auto compiled_recipe = CompiledRecipe::intern(recipe);
+  if (typed_package_factory_ && !typed_recipe_check_(*compiled_recipe))
+  {
+    throw UrException("The new RTDE output recipe doesn't match the configured typed recipe.");
+  }
+
+  const bool was_running = client_state_ == ClientState::RUNNING;
+  if (was_running && !pause())
+  {
+    return false;
+  }
+  // The pipeline is only running while the client is started or paused, but it is needed to receive the answer.
+  const bool run_pipeline = client_state_ == ClientState::INITIALIZED;
+  if (run_pipeline)
+  {
+    pipeline_->run();
+  }
+  try
+  {
+    const std::vector<std::string> confirmed_recipe = setupSwitchedOutputs(recipe);
+    if (confirmed_recipe != recipe)
+    {
+      compiled_recipe = CompiledRecipe::intern(confirmed_recipe);
+    }
+  }
+  catch (const UrException&)
+  {
+    if (run_pipeline)
+    {
+      pipeline_->stop();
+    }
+    throw;
+  }
+  if (run_pipeline)
+  {
+    pipeline_->stop();
+  }
+
+  // No data packages are received while paused, so everything bound to the recipe can be replaced safely.
+  output_recipe_ = compiled_recipe->getRecipe();
+  parser_.setCompiledRecipe(compiled_recipe);
+  data_package_pool_.reset();
+  if (data_package_pool_size_ > 0)
+  {
+    data_package_pool_ = DataPackagePool::create(compiled_recipe, parser_.getProtocolVersion(),
+                                                 data_package_pool_size_, lazy_decoding_);
+    parser_.setDataPackagePool(data_package_pool_);
+  }
+  data_package_history_.reset();
+  if (data_package_history_size_ > 0)
+  {
+    data_package_history_ = std::make_shared<DataPackageHistory>(compiled_recipe, data_package_history_size_);
+  }
+  // Callers may still reference the old publisher, deactivating it lets the new one replace its segment
+  if (shared_state_publisher_ != nullptr)
+  {
+    shared_state_publisher_->deactivate();
+  }
+  shared_state_publisher_.reset();
+  if (!shared_state_name_.empty())
+  {
+    shared_state_publisher_ = std::make_shared<SharedStatePublisher>(
+        shared_state_name_, compiled_recipe, shared_state_slot_count_, parser_.getProtocolVersion());
+  }
+  state_cache_.reset();
+  if (state_caching_)
+  {
+    state_cache_ = std::make_shared<StateCache>(compiled_recipe);
+  }
+  if (!field_change_monitor_.empty())
+  {
+    field_change_monitor_.setRecipe(*compiled_recipe);
+  }
+  if (!io_event_engine_.empty())
+  {
+    io_event_engine_.setRecipe(*compiled_recipe);
+  }
+  if (frequency_policy_ != nullptr)
+  {
+    frequency_policy_->setRecipe(*compiled_recipe);
+  }
+  URCL_LOG_INFO("Switched RTDE output recipe to %zu variables.", output_recipe_.size());
+
+  if (was_running)
+  {
+    return start();
+  }
+  return true;
+}
+
+bool RTDEClient::setOutputFrequency(const double frequency)
+{
+  std::lock_guard<std::mutex> setup_lock(output_setup_mutex_);
+  if (client_state_ < ClientState::INITIALIZED)
+  {
+    throw UrException("The output frequency can only be changed after the RTDE client has been initialized.");
+  }
+  if (!(frequency > 0.0) || frequency > max_frequency_)
+  {
+    throw UrException("Invalid output frequency of " + std::to_string(frequency) + " Hz, it has to be in (0, " +
+                      std::to_string(max_frequency_) + "].");
+  }
+  if (parser_.getProtocolVersion() < 2)
+  {
+    throw UrException("The output frequency can only be changed with RTDE protocol version 2.");
+  }
+  if (frequency == target_frequency_)
+  {
+    return true;
+  }
+
+  const bool was_running = client_state_ == ClientState::RUNNING;
+  if (was_running && !pause())
+  {
+    return false;
+  }
+  // The pipeline is only running while the client is started or paused, but it is needed to receive the answer.
+  const bool run_pipeline = client_state_ == ClientState::INITIALIZED;
+  if (run_pipeline)
+  {
+    pipeline_->run();
+  }
+  const double previous_frequency = target_frequency_;
+  target_frequency_ = frequency;
+  try
+  {
+    // The recipe stays the same, so everything bound to the compiled recipe is kept.
+    setupSwitchedOutputs(output_recipe_);
+  }
+  catch (const UrException&)
+  {
+    target_frequency_ = previous_frequency;
+    if (run_pipeline)
+    {
+      pipeline_->stop();
+    }
+    throw;
+  }
+  if (run_pipeline)
+  {
+    pipeline_->stop();
+  }
+  URCL_LOG_INFO("Switched RTDE output frequency from %.1f Hz to %.1f Hz.", previous_frequency, frequency);
+
+  if (was_running)
+  {
+    return start();
+  }
+  return true;
+}
+
+void RTDEClient::setOutputFrequencyPolicy(std::shared_ptr<OutputFrequencyPolicy> policy)
+{
+  if (client_state_ > ClientState::INITIALIZED)
+  {
+    throw UrException("The output frequency policy has to be set before starting the RTDE client.");
+  }
+  frequency_policy_ = policy;
+  if (frequency_policy_ != nullptr && client_state_ == ClientState::UNINITIALIZED)
+  {
+    requireOutputFields(OutputFrequencyPolicy::getRequiredFields());
+  }
+}
+
+void RTDEClient::frequencySwitchLoop()
+{
+  double applied_frequency = target_frequency_;
+  std::unique_lock<std::mutex> lock(frequency_switch_mutex_);
+  while (true)
+  {
+    frequency_switch_cv_.wait(
+        lock, [&] { return !frequency_switch_running_ || policy_frequency_.load() != applied_frequency; });
+    if (!frequency_switch_running_)
+    {
+      return;
+    }
+    // A failed switch isn't repeated until the policy chooses another frequency
+    applied_frequency = policy_frequency_;
+    lock.unlock();
+    try
+    {
+      if (!setOutputFrequency(applied_frequency))
+      {
+        URCL_LOG_ERROR("Could not switch the RTDE output frequency to %.1f Hz.", applied_frequency);
+      }
+    }
+    catch (const UrException& e)
+    {
+      URCL_LOG_ERROR("Could not switch the RTDE output frequency to %.1f Hz: %s", applied_frequency, e.what());
+    }
+    lock.lock();
+  }
+}
+
+void RTDEClient::stopFrequencySwitching()
+{
+  {
+    std::lock_guard<std::mutex> lock(frequency_switch_mutex_);
+    frequency_switch_running_ = false;
+  }
+  frequency_switch_cv_.notify_one();
+  if (frequency_switch_thread_.joinable())
+  {
+    frequency_switch_thread_.join();
+  }
+}
+
+std::vector<std::string> RTDEClient::setupSwitchedOutputs(std::vector<std::string> recipe)
+{
+  const uint16_t protocol_version = parser_.getProtocolVersion();
+  auto request_outputs = [this, protocol_version](const std::vector<std::string>& requested_recipe) {
+    uint8_t buffer[8192];
+    size_t size;
+    size_t written;
+    if (protocol_version == 2)
+    {
+      size = ControlPackageSetupOutputsRequest::generateSerializedRequest(buffer, target_frequency_, requested_recipe);
+    }
+    else
+    {
+      size = ControlPackageSetupOutputsRequest::generateSerializedRequest(buffer, requested_recipe);
+    }
+    if (!stream_.write(buffer, size, written))
+    {
+      throw UrException("Could not send RTDE output recipe to robot.");
+    }
+    // Packages received before pausing might still be queued
+    std::unique_ptr<RTDEPackage> package;
+    for (unsigned int num_packages = 0; num_packages < MAX_REQUEST_RETRIES; ++num_packages)
+    {
+      if (!pipeline_->getNextProduct(package, std::chrono::milliseconds(1000)))
+      {
+        break;
+      }
+      if (package->getType() == PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS)
+      {
+        return splitVariableTypes(static_cast<ControlPackageSetupOutputs*>(package.get())->variable_types_);
+      }
+    }
+    throw UrException("Did not receive confirmation on RTDE output recipe.");
+  };
+
+  std::vector<std::string> variable_types = request_outputs(recipe);
+  std::vector<std::string> available_variables;
+  std::stringstream unavailable_variables;
+  for (std::size_t i = 0; i < variable_types.size() && i < recipe.size(); ++i)
+  {
+    if (variable_types[i] == "NOT_FOUND")
+    {
+      unavailable_variables << recipe[i] << " ";
+    }
+    else
+    {
+      available_variables.push_back(recipe[i]);
+    }
+  }
+  if (available_variables.size() == recipe.size())
+  {
+    return recipe;
+  }
+
+  std::string error_message = "The following variables are not recognized by the robot: " +
+                              unavailable_variables.str() + ". They will be removed from the output recipe.";
+  if (ignore_unavailable_outputs_ && !typed_package_factory_)
+  {
+    URCL_LOG_WARN("%s", error_message.c_str());
+    request_outputs(available_variables);
+    return available_variables;
+  }
+
+  // Restore the previous recipe, so the client stays usable
+  request_outputs(output_recipe_);
+  error_message = "The following variables of the new output recipe are not recognized by the robot: " +
+                  unavailable_variables.str() + ". The previous output recipe is kept.";
+  URCL_LOG_ERROR("%s", error_message.c_str());
+  throw UrException(error_message);
+}
+
 bool RTDEClient::pause()
 {
   if (client_state_ == ClientState::PAUSED)
@@ -527,6 +1399,11 @@ bool RTDEClient::pause()
     return false;
   }
 
+  // The robot stops publishing, which must not be reported as a stale stream
+  if (stream_watchdog_ != nullptr)
+  {
+    stream_watchdog_->stop();
+  }
   if (sendPause())
   {
     client_state_ = ClientState::PAUSED;
@@ -560,8 +1437,9 @@ bool RTDEClient::sendStart()
       return false;
     }
 
-    if (rtde_interface::ControlPackageStart* tmp = dynamic_cast<rtde_interface::ControlPackageStart*>(package.get()))
+    if (package->getType() == PackageType::RTDE_CONTROL_PACKAGE_START)
     {
+      rtde_interface::ControlPackageStart* tmp = static_cast<rtde_interface::ControlPackageStart*>(package.get());
       return tmp->accepted_;
     }
     else
@@ -592,17 +1470,19 @@ bool RTDEClient::sendPause()
     return false;
   }
   std::unique_ptr<RTDEPackage> package;
-  std::chrono::time_point start = std::chrono::steady_clock::now();
+  const std::shared_ptr<Clock> clock = getClock();
+  const Clock::time_point start = clock->now();
   int seconds = 5;
-  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(seconds))
+  while (clock->now() - start < std::chrono::seconds(seconds))
   {
     if (!pipeline_->getLatestProduct(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("Could not get response to RTDE communication pause request from robot");
       return false;
     }
-    if (rtde_interface::ControlPackagePause* tmp = dynamic_cast<rtde_interface::ControlPackagePause*>(package.get()))
+    if (package->getType() == PackageType::RTDE_CONTROL_PACKAGE_PAUSE)
     {
+      rtde_interface::ControlPackagePause* tmp = static_cast<rtde_interface::ControlPackagePause*>(package.get());
       client_state_ = ClientState::PAUSED;
       return tmp->accepted_;
     }
@@ -655,12 +1535,55 @@ std::vector<std::string> RTDEClient::ensureTimestampIsPresent(const std::vector<
   return recipe;
 }
 
+void RTDEClient::requireOutputFields(const std::vector<std::string>& fields)
+{
+  if (client_state_ > ClientState::UNINITIALIZED)
+  {
+    throw UrException("Required output fields have to be declared before initializing the RTDE client.");
+  }
+  for (const std::string& field : fields)
+  {
+    if (std::find(required_output_fields_.begin(), required_output_fields_.end(), field) ==
+        required_output_fields_.end())
+    {
+      required_output_fields_.push_back(field);
+    }
+  }
+}
+
+std::vector<std::string> RTDEClient::minimizeOutputRecipe(const std::vector<std::string>& output_recipe) const
+{
+  if (required_output_fields_.empty())
+  {
+    URCL_LOG_WARN("No output fields have been declared as required, so the RTDE output recipe is not minimized.");
+    return output_recipe;
+  }
+  std::vector<std::string> recipe;
+  for (const std::string& field : output_recipe)
+  {
+    // The timestamp is needed to check whether the robot is booted
+    if (field == "timestamp" || std::find(required_output_fields_.begin(), required_output_fields_.end(), field) !=
+                                    required_output_fields_.end())
+    {
+      recipe.push_back(field);
+    }
+  }
+  for (const std::string& field : required_output_fields_)
+  {
+    if (std::find(recipe.begin(), recipe.end(), field) == recipe.end())
+    {
+      recipe.push_back(field);
+    }
+  }
+  return ensureTimestampIsPresent(recipe);
+}
+
 std::unique_ptr<rtde_interface::DataPackage> RTDEClient::getDataPackage(std::chrono::milliseconds timeout)
 {
   std::unique_ptr<RTDEPackage> urpackage;
   if (pipeline_->getLatestProduct(urpackage, timeout))
   {
-    rtde_interface::DataPackage* tmp = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+    rtde_interface::DataPackage* tmp = toDataPackage(urpackage.get());
     if (tmp != nullptr)
     {
       urpackage.release();
@@ -670,6 +1593,26 @@ std::unique_ptr<rtde_interface::DataPackage> RTDEClient::getDataPackage(std::chr
   return std::unique_ptr<rtde_interface::DataPackage>(nullptr);
 }
 
+DataPackage* RTDEClient::toDataPackage(RTDEPackage* package) const
+{
+  // Data packages created by a factory are typed data packages
+  if (package == nullptr || package->getType() != PackageType::RTDE_DATA_PACKAGE || parser_.hasDataPackageFactory())
+  {
+    return nullptr;
+  }
+  return static_cast<DataPackage*>(package);
+}
+
+PooledDataPackage RTDEClient::getPooledDataPackage(std::chrono::milliseconds timeout)
+{
+  std::unique_ptr<rtde_interface::DataPackage> package = getDataPackage(timeout);
+  if (package == nullptr || data_package_pool_ == nullptr)
+  {
+    return PooledDataPackage(package.release(), DataPackageDeleter{});
+  }
+  return data_package_pool_->makePooled(std::move(package));
+}
+
 std::string RTDEClient::getIP() const
 {
   return stream_.getIP();
@@ -0,0 +1,310 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+#include <endian.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+// Magic, format version, protocol version and number of recipe entries
+constexpr size_t FILE_HEADER_SIZE = sizeof(RTDERecorder::MAGIC) + 2 * sizeof(uint16_t) + sizeof(uint32_t);
+
+template <typename T>
+void writeValue(uint8_t*& buf, const T value)
+{
+  std::memcpy(buf, &value, sizeof(T));
+  buf += sizeof(T);
+}
+
+template <typename T>
+T readValue(const uint8_t* buf)
+{
+  T value;
+  std::memcpy(&value, buf, sizeof(T));
+  return value;
+}
+}  // namespace
+
+constexpr char RTDERecorder::MAGIC[8];
+
+RTDERecorder::RTDERecorder(const std::string& path, const size_t chunk_size)
+  : path_(path), chunk_size_(chunk_size), fd_(-1), data_(nullptr), capacity_(0), size_(0), num_frames_(0)
+{
+  if (chunk_size_ == 0)
+  {
+    throw UrException("The chunk size of an RTDE recorder has to be greater than 0.");
+  }
+}
+
+RTDERecorder::~RTDERecorder()
+{
+  close();
+}
+
+void RTDERecorder::open(const std::vector<std::string>& recipe, const uint16_t protocol_version)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ >= 0)
+  {
+    throw UrException("RTDE recorder for file '" + path_ + "' is already open.");
+  }
+
+  size_t header_size = FILE_HEADER_SIZE;
+  for (const auto& name : recipe)
+  {
+    header_size += sizeof(uint16_t) + name.size();
+  }
+
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0)
+  {
+    throw UrException("Could not create RTDE recording '" + path_ + "': " + std::strerror(errno));
+  }
+  size_ = 0;
+  num_frames_ = 0;
+  if (!reserve(header_size))
+  {
+    ::close(fd_);
+    fd_ = -1;
+    throw UrException("Could not map RTDE recording '" + path_ + "': " + std::strerror(errno));
+  }
+
+  uint8_t* buf = data_;
+  std::memcpy(buf, MAGIC, sizeof(MAGIC));
+  buf += sizeof(MAGIC);
+  writeValue(buf, htobe16(FORMAT_VERSION));
+  writeValue(buf, htobe16(protocol_version));
+  writeValue(buf, htobe32(static_cast<uint32_t>(recipe.size())));
+  for (const auto& name : recipe)
+  {
+    writeValue(buf, htobe16(static_cast<uint16_t>(name.size())));
+    std::memcpy(buf, name.data(), name.size());
+    buf += name.size();
+  }
+  size_ = header_size;
+}
+
+bool RTDERecorder::record(const uint8_t* frame, const size_t size,
+                          const std::chrono::system_clock::time_point receive_time)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0)
+  {
+    return false;
+  }
+  if (!reserve(RECORD_HEADER_SIZE + size))
+  {
+    URCL_LOG_ERROR("Could not grow RTDE recording '%s': %s", path_.c_str(), std::strerror(errno));
+    return false;
+  }
+
+  const int64_t nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count();
+  uint8_t* buf = data_ + size_;
+  writeValue(buf, htobe64(static_cast<uint64_t>(nanoseconds)));
+  writeValue(buf, htobe32(static_cast<uint32_t>(size)));
+  std::memcpy(buf, frame, size);
+  size_ += RECORD_HEADER_SIZE + size;
+  ++num_frames_;
+  return true;
+}
+
+void RTDERecorder::close()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0)
+  {
+    return;
+  }
+  unmap();
+  if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+  {
+    URCL_LOG_WARN("Could not truncate RTDE recording '%s': %s", path_.c_str(), std::strerror(errno));
+  }
+  ::close(fd_);
+  fd_ = -1;
+}
+
+bool RTDERecorder::isOpen() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return fd_ >= 0;
+}
+
+size_t RTDERecorder::getNumFrames() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_frames_;
+}
+
+size_t RTDERecorder::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+bool RTDERecorder::reserve(const size_t size)
+{
+  if (size_ + size <= capacity_)
+  {
+    return true;
+  }
+
+  size_t capacity = capacity_;
+  while (capacity < size_ + size)
+  {
+    capacity += chunk_size_;
+  }
+
+  // Remap the whole file, as growing a mapping in place isn't possible portably.
+  unmap();
+  if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0)
+  {
+    return false;
+  }
+  void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (data == MAP_FAILED)
+  {
+    return false;
+  }
+  data_ = static_cast<uint8_t*>(data);
+  capacity_ = capacity;
+  return true;
+}
+
+void RTDERecorder::unmap()
+{
+  if (data_ != nullptr)
+  {
+    ::munmap(data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+}
+
+RTDERecording::RTDERecording(const std::string& path)
+  : data_(nullptr), size_(0), first_frame_(0), offset_(0), protocol_version_(0)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw UrException("Could not open RTDE recording '" + path + "': " + std::strerror(errno));
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < FILE_HEADER_SIZE)
+  {
+    ::close(fd);
+    throw UrException("File '" + path + "' is not a valid RTDE recording.");
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw UrException("Could not map RTDE recording '" + path + "': " + std::strerror(errno));
+  }
+  data_ = static_cast<const uint8_t*>(data);
+
+  const uint8_t* buf = data_;
+  if (std::memcmp(buf, RTDERecorder::MAGIC, sizeof(RTDERecorder::MAGIC)) != 0 ||
+      be16toh(readValue<uint16_t>(buf + sizeof(RTDERecorder::MAGIC))) != RTDERecorder::FORMAT_VERSION)
+  {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+    throw UrException("File '" + path + "' is not a valid RTDE recording.");
+  }
+  buf += sizeof(RTDERecorder::MAGIC) + sizeof(uint16_t);
+  protocol_version_ = be16toh(readValue<uint16_t>(buf));
+  buf += sizeof(uint16_t);
+  const uint32_t recipe_size = be32toh(readValue<uint32_t>(buf));
+  size_t offset = FILE_HEADER_SIZE;
+  for (uint32_t i = 0; i < recipe_size; ++i)
+  {
+    const uint16_t length =
+        offset + sizeof(uint16_t) <= size_ ? be16toh(readValue<uint16_t>(data_ + offset)) : UINT16_MAX;
+    offset += sizeof(uint16_t);
+    if (offset + length > size_)
+    {
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+      throw UrException("The header of RTDE recording '" + path + "' is truncated.");
+    }
+    recipe_.emplace_back(reinterpret_cast<const char*>(data_ + offset), length);
+    offset += length;
+  }
+  first_frame_ = offset;
+  offset_ = offset;
+}
+
+RTDERecording::~RTDERecording()
+{
+  ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+bool RTDERecording::next(Frame& frame)
+{
+  if (offset_ + RTDERecorder::RECORD_HEADER_SIZE > size_)
+  {
+    return false;
+  }
+  const uint64_t nanoseconds = be64toh(readValue<uint64_t>(data_ + offset_));
+  const uint32_t size = be32toh(readValue<uint32_t>(data_ + offset_ + sizeof(uint64_t)));
+  if (size == 0 || offset_ + RTDERecorder::RECORD_HEADER_SIZE + size > size_)
+  {
+    return false;
+  }
+  frame.receive_time = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+  frame.data = data_ + offset_ + RTDERecorder::RECORD_HEADER_SIZE;
+  frame.size = size;
+  offset_ += RTDERecorder::RECORD_HEADER_SIZE + size;
+  return true;
+}
+
+void RTDERecording::rewind()
+{
+  offset_ = first_frame_;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,736 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/rtde_relay.h"
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+constexpr uint8_t DELTA_FRAME = 0;
+constexpr uint8_t KEYFRAME = 1;
+
+// Quantised values are limited, so their deltas never overflow
+constexpr double MAX_QUANTISED = 4611686018427387904.0;  // 2^62
+
+template <typename T>
+struct ElementType
+{
+  using type = T;
+  static constexpr size_t COUNT = 1;
+};
+
+template <typename T, size_t N>
+struct ElementType<std::array<T, N>>
+{
+  using type = T;
+  static constexpr size_t COUNT = N;
+};
+
+struct ElementLayout
+{
+  size_t count;
+  size_t size;
+  bool floating;
+};
+
+ElementLayout layoutOf(const CompiledRecipe::Field& field)
+{
+  return std::visit(
+      [](auto&& arg) -> ElementLayout {
+        using Element = ElementType<std::decay_t<decltype(arg)>>;
+        return { Element::COUNT, sizeof(typename Element::type),
+                 std::is_floating_point<typename Element::type>::value };
+      },
+      field.empty_value);
+}
+
+uint64_t readBigEndian(const uint8_t* buffer, const size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    value = (value << 8) | buffer[i];
+  }
+  return value;
+}
+
+void writeBigEndian(uint8_t* buffer, const size_t size, uint64_t value)
+{
+  for (size_t i = size; i > 0; --i)
+  {
+    buffer[i - 1] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+void appendBigEndian(std::vector<uint8_t>& buffer, const size_t size, const uint64_t value)
+{
+  buffer.resize(buffer.size() + size);
+  writeBigEndian(buffer.data() + buffer.size() - size, size, value);
+}
+
+uint64_t doubleToBits(const double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double bitsToDouble(const uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+int64_t quantise(const double value, const double resolution)
+{
+  const double steps = value / resolution;
+  if (std::isnan(steps))
+  {
+    return 0;
+  }
+  return static_cast<int64_t>(std::llround(std::clamp(steps, -MAX_QUANTISED, MAX_QUANTISED)));
+}
+
+void appendVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t*& position, const uint8_t* end, uint64_t& value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && position < end; shift += 7)
+  {
+    const uint8_t byte = *position++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Maps small negative and positive deltas to small unsigned values
+uint64_t zigzag(const int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(const uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Builds the elements of all known fields of a recipe. The resolution of each field is looked up
+// by its name.
+template <typename ResolutionLookup>
+void buildElements(const CompiledRecipe& recipe, ResolutionLookup resolution_of,
+                   std::vector<RelayEncoder::Field>& fields, std::vector<RelayEncoder::Element>& elements)
+{
+  for (const auto& field : recipe.getFields())
+  {
+    if (!field.known)
+    {
+      continue;
+    }
+    const ElementLayout layout = layoutOf(field);
+    const double resolution = layout.floating ? resolution_of(field.name) : 0.0;
+    fields.push_back({ elements.size(), layout.count });
+    for (size_t i = 0; i < layout.count; ++i)
+    {
+      elements.push_back({ field.offset + i * layout.size, layout.size, resolution });
+    }
+  }
+}
+}  // namespace
+
+RelayEncoder::RelayEncoder(std::shared_ptr<const CompiledRecipe> recipe, const double resolution,
+                           const std::unordered_map<std::string, double>& field_resolutions,
+                           const size_t keyframe_interval)
+  : recipe_(recipe)
+  , keyframe_interval_(keyframe_interval)
+  , data_(recipe->getDataSize())
+  , sequence_number_(0)
+  , frames_since_keyframe_(0)
+  , keyframe_requested_(true)
+{
+  if (!(resolution > 0.0) || !std::isfinite(resolution))
+  {
+    throw UrException("The resolution of relayed floating point values has to be positive.");
+  }
+  for (const auto& field_resolution : field_resolutions)
+  {
+    size_t index;
+    if (!recipe_->findIndex(field_resolution.first, index) || !layoutOf(recipe_->getFields()[index]).floating)
+    {
+      throw UrException("Cannot set the resolution of '" + field_resolution.first +
+                        "', it isn't a floating point field of the relayed recipe.");
+    }
+    if (!(field_resolution.second > 0.0) || !std::isfinite(field_resolution.second))
+    {
+      throw UrException("The resolution of '" + field_resolution.first + "' has to be positive.");
+    }
+  }
+
+  buildElements(
+      *recipe_,
+      [&](const std::string& name) {
+        auto it = field_resolutions.find(name);
+        return it == field_resolutions.end() ? resolution : it->second;
+      },
+      fields_, elements_);
+  reference_.resize(elements_.size());
+  values_.resize(elements_.size());
+
+  header_.assign(std::begin(MAGIC), std::end(MAGIC));
+  appendBigEndian(header_, sizeof(FORMAT_VERSION), FORMAT_VERSION);
+  appendBigEndian(header_, sizeof(uint16_t), fields_.size());
+  size_t field_index = 0;
+  for (const auto& field : recipe_->getFields())
+  {
+    if (!field.known)
+    {
+      continue;
+    }
+    if (field.name.size() > UINT8_MAX)
+    {
+      throw UrException("Cannot relay field '" + field.name + "', its name is too long.");
+    }
+    header_.push_back(static_cast<uint8_t>(field.name.size()));
+    header_.insert(header_.end(), field.name.begin(), field.name.end());
+    appendBigEndian(header_, sizeof(uint64_t), doubleToBits(elements_[fields_[field_index].first_element].resolution));
+    ++field_index;
+  }
+}
+
+bool RelayEncoder::encode(const DataPackage& package, std::vector<uint8_t>& frame)
+{
+  if (package.getCompiledRecipe() != recipe_ || package.serializeData(data_.data()) != data_.size())
+  {
+    return false;
+  }
+
+  const bool keyframe = keyframe_requested_ || (keyframe_interval_ > 0 && frames_since_keyframe_ >= keyframe_interval_);
+  if (keyframe)
+  {
+    std::fill(reference_.begin(), reference_.end(), 0);
+    keyframe_requested_ = false;
+    frames_since_keyframe_ = 0;
+  }
+
+  for (size_t i = 0; i < elements_.size(); ++i)
+  {
+    const Element& element = elements_[i];
+    const uint64_t raw = readBigEndian(data_.data() + element.offset, element.size);
+    if (element.resolution > 0.0)
+    {
+      values_[i] = static_cast<uint64_t>(quantise(bitsToDouble(raw), element.resolution));
+    }
+    else
+    {
+      values_[i] = raw;
+    }
+  }
+
+  frame.clear();
+  frame.push_back(keyframe ? KEYFRAME : DELTA_FRAME);
+  appendVarint(frame, sequence_number_);
+  frame.push_back(package.getRecipeID());
+  // One bit per field tells whether the field changed
+  const size_t mask_offset = frame.size();
+  frame.resize(frame.size() + (fields_.size() + 7) / 8, 0);
+  for (size_t f = 0; f < fields_.size(); ++f)
+  {
+    const size_t begin = fields_[f].first_element;
+    const size_t end = begin + fields_[f].num_elements;
+    if (std::equal(values_.begin() + begin, values_.begin() + end, reference_.begin() + begin))
+    {
+      continue;
+    }
+    frame[mask_offset + f / 8] |= static_cast<uint8_t>(1 << (f % 8));
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (elements_[i].resolution > 0.0)
+      {
+        appendVarint(frame, zigzag(static_cast<int64_t>(values_[i] - reference_[i])));
+      }
+      else
+      {
+        appendVarint(frame, values_[i] ^ reference_[i]);
+      }
+      reference_[i] = values_[i];
+    }
+  }
+
+  ++sequence_number_;
+  ++frames_since_keyframe_;
+  return true;
+}
+
+bool RelayEncoder::isKeyframe(const uint8_t* frame, const size_t size)
+{
+  return size > 0 && frame[0] == KEYFRAME;
+}
+
+RelayDecoder::RelayDecoder(const std::vector<uint8_t>& header)
+  : sequence_number_(0), synchronized_(false), num_skipped_frames_(0)
+{
+  const size_t magic_size = sizeof(RelayEncoder::MAGIC);
+  if (header.size() < magic_size + 4 || !std::equal(std::begin(RelayEncoder::MAGIC), std::end(RelayEncoder::MAGIC),
+                                                    reinterpret_cast<const char*>(header.data())))
+  {
+    throw UrException("Invalid relay header.");
+  }
+  const uint8_t* position = header.data() + magic_size;
+  const uint8_t* end = header.data() + header.size();
+  const uint16_t version = static_cast<uint16_t>(readBigEndian(position, 2));
+  if (version != RelayEncoder::FORMAT_VERSION)
+  {
+    throw UrException("Unsupported relay format version " + std::to_string(version) + ".");
+  }
+  const size_t num_fields = readBigEndian(position + 2, 2);
+  position += 4;
+
+  std::vector<std::string> names;
+  std::unordered_map<std::string, double> resolutions;
+  for (size_t i = 0; i < num_fields; ++i)
+  {
+    if (position >= end || static_cast<size_t>(end - position) < 1u + *position + sizeof(uint64_t))
+    {
+      throw UrException("Relay header is truncated.");
+    }
+    const size_t name_size = *position++;
+    names.emplace_back(reinterpret_cast<const char*>(position), name_size);
+    position += name_size;
+    resolutions[names.back()] = bitsToDouble(readBigEndian(position, sizeof(uint64_t)));
+    position += sizeof(uint64_t);
+  }
+  if (position != end)
+  {
+    throw UrException("Relay header has trailing data.");
+  }
+
+  recipe_ = CompiledRecipe::intern(names);
+  if (!recipe_->isComplete())
+  {
+    throw UrException("Relay header contains unknown fields.");
+  }
+  for (const auto& field : recipe_->getFields())
+  {
+    const double resolution = resolutions[field.name];
+    const bool floating = layoutOf(field).floating;
+    if (floating != (resolution > 0.0) || !std::isfinite(resolution))
+    {
+      throw UrException("Relay header contains an invalid resolution for '" + field.name + "'.");
+    }
+  }
+  buildElements(
+      *recipe_, [&resolutions](const std::string& name) { return resolutions[name]; }, fields_, elements_);
+  reference_.resize(elements_.size());
+  values_.resize(elements_.size());
+  data_.resize(recipe_->getDataSize());
+}
+
+bool RelayDecoder::decode(const uint8_t* frame, const size_t size, DataPackage& package)
+{
+  if (package.getCompiledRecipe() != recipe_ || size == 0 || frame[0] > KEYFRAME)
+  {
+    return false;
+  }
+  const uint8_t* position = frame + 1;
+  const uint8_t* end = frame + size;
+  uint64_t sequence_number;
+  if (!readVarint(position, end, sequence_number))
+  {
+    return false;
+  }
+  const bool keyframe = frame[0] == KEYFRAME;
+  if (!keyframe && (!synchronized_ || sequence_number != sequence_number_ + 1))
+  {
+    if (synchronized_)
+    {
+      URCL_LOG_WARN("Lost relayed frames, waiting for the next keyframe.");
+    }
+    synchronized_ = false;
+    ++num_skipped_frames_;
+    return false;
+  }
+
+  const size_t mask_size = (fields_.size() + 7) / 8;
+  if (end - position < static_cast<std::ptrdiff_t>(1 + mask_size))
+  {
+    return false;
+  }
+  const uint8_t recipe_id = *position++;
+  const uint8_t* mask = position;
+  position += mask_size;
+
+  // Decode into a copy, so a malformed frame doesn't corrupt the reference
+  if (keyframe)
+  {
+    std::fill(values_.begin(), values_.end(), 0);
+  }
+  else
+  {
+    std::copy(reference_.begin(), reference_.end(), values_.begin());
+  }
+  for (size_t f = 0; f < fields_.size(); ++f)
+  {
+    if ((mask[f / 8] & (1 << (f % 8))) == 0)
+    {
+      continue;
+    }
+    const size_t begin = fields_[f].first_element;
+    for (size_t i = begin; i < begin + fields_[f].num_elements; ++i)
+    {
+      uint64_t encoded;
+      if (!readVarint(position, end, encoded))
+      {
+        return false;
+      }
+      if (elements_[i].resolution > 0.0)
+      {
+        values_[i] += static_cast<uint64_t>(unzigzag(encoded));
+      }
+      else
+      {
+        values_[i] ^= encoded;
+      }
+    }
+  }
+  if (position != end)
+  {
+    return false;
+  }
+
+  reference_.swap(values_);
+  sequence_number_ = sequence_number;
+  synchronized_ = true;
+
+  for (size_t i = 0; i < elements_.size(); ++i)
+  {
+    const RelayEncoder::Element& element = elements_[i];
+    uint64_t raw = reference_[i];
+    if (element.resolution > 0.0)
+    {
+      raw = doubleToBits(static_cast<double>(static_cast<int64_t>(reference_[i])) * element.resolution);
+    }
+    writeBigEndian(data_.data() + element.offset, element.size, raw);
+  }
+  comm::BinParser bp(data_.data(), data_.size());
+  if (!package.parseData(bp))
+  {
+    return false;
+  }
+  package.setRecipeID(recipe_id);
+  return true;
+}
+
+RTDERelay::RTDERelay(const uint32_t port, std::shared_ptr<const CompiledRecipe> recipe, const size_t decimation,
+                     const double resolution, const std::unordered_map<std::string, double>& field_resolutions,
+                     const size_t queue_size)
+  : encoder_(recipe, resolution, field_resolutions, 0)
+  , decimation_(decimation)
+  , num_skipped_packages_(0)
+  , num_dropped_frames_(0)
+  , num_sent_bytes_(0)
+  , num_clients_(0)
+  , queue_(queue_size)
+  , queue_head_(0)
+  , queue_count_(0)
+  , keyframe_requested_(false)
+  , running_(true)
+  , server_(port)
+{
+  if (decimation_ == 0)
+  {
+    throw UrException("The decimation of the RTDE relay has to be at least 1.");
+  }
+  if (queue_.empty())
+  {
+    throw UrException("The queue of the RTDE relay has to hold at least one frame.");
+  }
+  send_thread_ = std::thread(&RTDERelay::sendLoop, this);
+  server_.setConnectCallback(std::bind(&RTDERelay::connectionCallback, this, std::placeholders::_1));
+  server_.setDisconnectCallback(std::bind(&RTDERelay::disconnectionCallback, this, std::placeholders::_1));
+  server_.start();
+}
+
+RTDERelay::~RTDERelay()
+{
+  server_.shutdown();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  cv_.notify_one();
+  if (send_thread_.joinable())
+  {
+    send_thread_.join();
+  }
+}
+
+bool RTDERelay::update(const DataPackage& package)
+{
+  if (package.getCompiledRecipe() != encoder_.getCompiledRecipe())
+  {
+    return false;
+  }
+  if (num_skipped_packages_ > 0)
+  {
+    --num_skipped_packages_;
+    return true;
+  }
+  num_skipped_packages_ = decimation_ - 1;
+  if (num_clients_ == 0)
+  {
+    return true;
+  }
+
+  if (keyframe_requested_.exchange(false))
+  {
+    encoder_.requestKeyframe();
+  }
+  if (!encoder_.encode(package, frame_))
+  {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_count_ == queue_.size())
+    {
+      // The frame's delta is lost, so monitors have to resynchronize
+      ++num_dropped_frames_;
+      keyframe_requested_ = true;
+      return true;
+    }
+    queue_[(queue_head_ + queue_count_) % queue_.size()].swap(frame_);
+    ++queue_count_;
+  }
+  cv_.notify_one();
+  return true;
+}
+
+void RTDERelay::connectionCallback(const int filedescriptor)
+{
+  URCL_LOG_INFO("Remote monitor connected to the RTDE relay at FD %d.", filedescriptor);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connected_.push_back(filedescriptor);
+  }
+  ++num_clients_;
+  keyframe_requested_ = true;
+  cv_.notify_one();
+}
+
+void RTDERelay::disconnectionCallback(const int filedescriptor)
+{
+  URCL_LOG_INFO("Remote monitor at FD %d disconnected from the RTDE relay.", filedescriptor);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    disconnected_.push_back(filedescriptor);
+  }
+  --num_clients_;
+  cv_.notify_one();
+}
+
+bool RTDERelay::send(const int filedescriptor, const std::vector<uint8_t>& message)
+{
+  uint8_t size[sizeof(uint32_t)];
+  writeBigEndian(size, sizeof(size), message.size());
+  struct iovec iov[2];
+  iov[0].iov_base = size;
+  iov[0].iov_len = sizeof(size);
+  iov[1].iov_base = const_cast<uint8_t*>(message.data());
+  iov[1].iov_len = message.size();
+  size_t written;
+  if (!server_.writev(filedescriptor, iov, 2, written))
+  {
+    return false;
+  }
+  num_sent_bytes_ += written;
+  return true;
+}
+
+void RTDERelay::sendLoop()
+{
+  std::vector<uint8_t> frame;
+  std::vector<int> connected;
+  std::vector<int> disconnected;
+  // Monitors wait for a keyframe after receiving the header
+  std::vector<int> joining;
+  std::vector<int> active;
+  while (true)
+  {
+    bool has_frame = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] {
+        return !running_ || queue_count_ > 0 || !connected_.empty() || !disconnected_.empty();
+      });
+      if (!running_)
+      {
+        return;
+      }
+      connected.swap(connected_);
+      disconnected.swap(disconnected_);
+      if (queue_count_ > 0)
+      {
+        frame.swap(queue_[queue_head_]);
+        queue_head_ = (queue_head_ + 1) % queue_.size();
+        --queue_count_;
+        has_frame = true;
+      }
+    }
+
+    // Disconnects are handled first, as a new monitor might reuse the file descriptor
+    for (const int fd : disconnected)
+    {
+      joining.erase(std::remove(joining.begin(), joining.end(), fd), joining.end());
+      active.erase(std::remove(active.begin(), active.end(), fd), active.end());
+    }
+    for (const int fd : connected)
+    {
+      if (send(fd, encoder_.getHeader()))
+      {
+        joining.push_back(fd);
+      }
+    }
+    connected.clear();
+    disconnected.clear();
+
+    if (!has_frame)
+    {
+      continue;
+    }
+    if (RelayEncoder::isKeyframe(frame.data(), frame.size()))
+    {
+      active.insert(active.end(), joining.begin(), joining.end());
+      joining.clear();
+    }
+    active.erase(std::remove_if(active.begin(), active.end(), [&](const int fd) { return !send(fd, frame); }),
+                 active.end());
+  }
+}
+
+RTDERelayClient::RTDERelayClient(const std::string& host, const int port) : host_(host), port_(port)
+{
+}
+
+bool RTDERelayClient::connect(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
+{
+  if (!TCPSocket::setup(host_, port_, max_num_tries, reconnection_time) || !readMessage(message_))
+  {
+    return false;
+  }
+  try
+  {
+    decoder_ = std::make_unique<RelayDecoder>(message_);
+  }
+  catch (const UrException& e)
+  {
+    URCL_LOG_ERROR("Could not connect to the RTDE relay: %s", e.what());
+    TCPSocket::close();
+    return false;
+  }
+  return true;
+}
+
+bool RTDERelayClient::readPackage(DataPackage& package)
+{
+  if (decoder_ == nullptr || package.getCompiledRecipe() != decoder_->getCompiledRecipe())
+  {
+    return false;
+  }
+  while (readMessage(message_))
+  {
+    if (decoder_->decode(message_.data(), message_.size(), package))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RTDERelayClient::readMessage(std::vector<uint8_t>& message)
+{
+  auto read_all = [this](uint8_t* buffer, const size_t size) {
+    size_t total = 0;
+    while (total < size)
+    {
+      size_t read;
+      if (!TCPSocket::read(buffer + total, size - total, read) || read == 0)
+      {
+        return false;
+      }
+      total += read;
+    }
+    return true;
+  };
+
+  uint8_t size_buffer[sizeof(uint32_t)];
+  if (!read_all(size_buffer, sizeof(size_buffer)))
+  {
+    return false;
+  }
+  const uint32_t size = static_cast<uint32_t>(readBigEndian(size_buffer, sizeof(size_buffer)));
+  if (size > MAX_MESSAGE_SIZE)
+  {
+    URCL_LOG_ERROR("Received a message of %u bytes from the RTDE relay, closing the connection.", size);
+    TCPSocket::close();
+    return false;
+  }
+  message.resize(size);
+  return read_all(message.data(), size);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -28,41 +28,269 @@
 
 #include "ur_client_library/rtde/rtde_writer.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace urcl
 {
 namespace rtde_interface
 {
 RTDEWriter::RTDEWriter(comm::URStream<RTDEPackage>* stream, const std::vector<std::string>& recipe)
-  : stream_(stream), recipe_(recipe), queue_{ 32 }, running_(false), package_(recipe_)
+  : stream_(stream)
+  , recipe_(recipe)
+  , compiled_recipe_(CompiledRecipe::intern(recipe_))
+  , recipe_id_(0)
+  , field_values_(new std::atomic<uint64_t>[compiled_recipe_->getFields().size()])
+  , field_owned_(new std::atomic<bool>[compiled_recipe_->getFields().size()])
+  , publishing_banks_(0)
+  , bank_publications_(0)
+  , dirty_(false)
+  , open_transactions_(0)
+  , flush_policy_(FlushPolicy::PER_CYCLE)
+  , running_(false)
+  , cycle_time_(0)
+  , packages_sent_metric_(nullptr)
+  , write_failures_metric_(nullptr)
+  , ramps_requested_(false)
+  , num_active_ramps_(0)
 {
+  ramp_requested_.fill(false);
+  for (size_t i = 0; i < NUM_RAMP_TARGETS; ++i)
+  {
+    requested_generations_[i].store(0);
+    finished_generations_[i].store(0);
+  }
+  const std::vector<CompiledRecipe::Field>& fields = compiled_recipe_->getFields();
+  is_mask_.resize(fields.size());
+  for (size_t i = 0; i < fields.size(); ++i)
+  {
+    field_values_[i].store(0);
+    field_owned_[i].store(false);
+    const std::string suffix = "_mask";
+    const std::string& name = fields[i].name;
+    is_mask_[i] = name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+  field_snapshot_.resize(fields.size());
+  resolveFields();
 }
 
-void RTDEWriter::init(uint8_t recipe_id)
+void RTDEWriter::resolveFields()
+{
+  speed_slider_mask_index_ = resolveField<uint32_t>("speed_slider_mask");
+  speed_slider_fraction_index_ = resolveField<double>("speed_slider_fraction");
+  standard_digital_output_fields_ = resolvePinFields("standard_digital_output");
+  configurable_digital_output_fields_ = resolvePinFields("configurable_digital_output");
+  tool_digital_output_fields_ = resolvePinFields("tool_digital_output");
+  standard_analog_output_mask_index_ = resolveField<uint8_t>("standard_analog_output_mask");
+  standard_analog_output_type_index_ = resolveField<uint8_t>("standard_analog_output_type");
+  for (size_t i = 0; i < standard_analog_output_indices_.size(); ++i)
+  {
+    standard_analog_output_indices_[i] = resolveField<double>("standard_analog_output_" + std::to_string(i));
+  }
+  for (size_t i = 0; i < input_bit_register_indices_.size(); ++i)
+  {
+    input_bit_register_indices_[i] = resolveField<bool>("input_bit_register_" + std::to_string(64 + i));
+  }
+  for (size_t i = 0; i < input_int_register_indices_.size(); ++i)
+  {
+    input_int_register_indices_[i] = resolveField<int32_t>("input_int_register_" + std::to_string(24 + i));
+    input_double_register_indices_[i] = resolveField<double>("input_double_register_" + std::to_string(24 + i));
+  }
+}
+
+void RTDEWriter::init(uint8_t recipe_id, double target_frequency)
 {
   recipe_id_ = recipe_id;
-  package_.initEmpty();
+  if (target_frequency > 0.0)
+  {
+    cycle_time_ = std::chrono::microseconds(static_cast<int64_t>(1e6 / target_frequency));
+  }
+
+  const uint16_t payload_size = static_cast<uint16_t>(sizeof(recipe_id_) + compiled_recipe_->getDataSize());
+  frame_.assign(sizeof(PackageHeader::_package_size_type) + sizeof(PackageType) + payload_size, 0);
+  size_t size = PackageHeader::serializeHeader(frame_.data(), PackageType::RTDE_DATA_PACKAGE, payload_size);
+  comm::PackageSerializer::serialize(frame_.data() + size, recipe_id_);
+
+  const MetricLabels labels{ { "host", stream_->getHost() } };
+  packages_sent_metric_ = &getMetricsRegistry().getCounter("urcl_rtde_writer_packages_sent_total",
+                                                           "Input packages sent to the robot", labels);
+  write_failures_metric_ = &getMetricsRegistry().getCounter("urcl_rtde_writer_write_failures_total",
+                                                            "Input packages that could not be sent", labels);
+
   running_ = true;
   writer_thread_ = std::thread(&RTDEWriter::run, this);
+  applyThreadConfig(writer_thread_.native_handle(), thread_config_);
+}
+
+void RTDEWriter::setThreadConfig(const ThreadConfig& config)
+{
+  thread_config_ = config;
+  if (writer_thread_.joinable())
+  {
+    applyThreadConfig(writer_thread_.native_handle(), thread_config_);
+  }
 }
 
 void RTDEWriter::run()
 {
-  uint8_t buffer[4096];
-  size_t size;
   size_t written;
-  std::unique_ptr<DataPackage> package;
+  auto next_send = std::chrono::steady_clock::now();
+  const std::chrono::microseconds ramp_period = cycle_time_.count() > 0 ? cycle_time_ : DEFAULT_RAMP_PERIOD;
   while (running_)
   {
-    if (queue_.waitDequeTimed(package, 1000000))
+    const bool ramping = num_active_ramps_ > 0 || ramps_requested_.load();
+    if (ramping)
+    {
+      // Ramps are advanced once per cycle, whether other data has been changed or not
+      std::this_thread::sleep_until(next_send);
+    }
+    else if (dirty_signal_.wait(1000000))
+    {
+      if (flush_policy_ == FlushPolicy::PER_CYCLE)
+      {
+        std::this_thread::sleep_until(next_send);
+      }
+    }
+    else
+    {
+      continue;
+    }
+    // Changes made from here on will trigger another package
+    dirty_ = false;
+    if (ramping)
+    {
+      // Changes signalled before are sent with this package
+      dirty_signal_.tryWait();
+    }
+    if (ramps_requested_.load())
+    {
+      applyRampRequests();
+    }
+    if (num_active_ramps_ > 0)
+    {
+      advanceRamps(std::chrono::steady_clock::now());
+    }
+    serializeFields();
+    if (stream_->write(frame_.data(), frame_.size(), written))
+    {
+      packages_sent_metric_->increment();
+    }
+    else
     {
-      package->setRecipeID(recipe_id_);
-      size = package->serializePackage(buffer);
-      stream_->write(buffer, size, written);
+      write_failures_metric_->increment();
     }
+    next_send = std::chrono::steady_clock::now() + (num_active_ramps_ > 0 ? ramp_period : cycle_time_);
   }
   URCL_LOG_DEBUG("Write thread ended.");
 }
 
+void RTDEWriter::serializeFields()
+{
+  const std::vector<CompiledRecipe::Field>& fields = compiled_recipe_->getFields();
+  const size_t data_offset = frame_.size() - compiled_recipe_->getDataSize();
+  std::vector<uint64_t>& values = field_snapshot_;
+
+  // Masks are consumed first. As the send functions set the masks last, all values belonging to a
+  // consumed mask bit are visible when reading the values afterwards.
+  for (size_t i = 0; i < fields.size(); ++i)
+  {
+    if (is_mask_[i])
+    {
+      values[i] = field_values_[i].exchange(0);
+    }
+  }
+  // Values published by a register bank meanwhile are read again, so each publication is sent as
+  // a whole.
+  uint64_t bank_publications;
+  do
+  {
+    while (publishing_banks_.load() != 0)
+    {
+      std::this_thread::yield();
+    }
+    bank_publications = bank_publications_.load();
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+      if (!is_mask_[i])
+      {
+        values[i] = field_values_[i].load();
+      }
+    }
+  } while (publishing_banks_.load() != 0 || bank_publications_.load() != bank_publications);
+
+  for (size_t i = 0; i < fields.size(); ++i)
+  {
+    if (!fields[i].known)
+    {
+      continue;
+    }
+    uint8_t* buffer = frame_.data() + data_offset + fields[i].offset;
+    std::visit(
+        [buffer, &values, i](auto&& empty_value) {
+          using T = std::decay_t<decltype(empty_value)>;
+          if constexpr (std::is_arithmetic<T>::value)
+          {
+            T value;
+            std::memcpy(&value, &values[i], sizeof(T));
+            comm::PackageSerializer::serialize(buffer, value);
+          }
+        },
+        fields[i].empty_value);
+  }
+}
+
+void RTDEWriter::beginTransaction()
+{
+  ++open_transactions_;
+}
+
+bool RTDEWriter::commitTransaction()
+{
+  int open_transactions = open_transactions_.load();
+  do
+  {
+    if (open_transactions <= 0)
+    {
+      URCL_LOG_ERROR("Cannot commit RTDE transaction, as there is no open transaction.");
+      return false;
+    }
+  } while (!open_transactions_.compare_exchange_weak(open_transactions, open_transactions - 1));
+
+  if (open_transactions == 1)
+  {
+    triggerSend();
+  }
+  return true;
+}
+
+void RTDEWriter::notifyWriter()
+{
+  if (open_transactions_ > 0 || flush_policy_ == FlushPolicy::ON_COMMIT)
+  {
+    // The changes are kept in the value slots and will be sent with the next package
+    return;
+  }
+  triggerSend();
+}
+
+void RTDEWriter::triggerSend()
+{
+  if (!dirty_.exchange(true))
+  {
+    dirty_signal_.signal();
+  }
+}
+
+void RTDEWriter::mergeBits(const size_t value_index, const size_t mask_index, const uint8_t bits, const uint8_t value)
+{
+  const uint64_t pending_mask = field_values_[mask_index].load();
+  uint64_t old_value = field_values_[value_index].load();
+  while (!field_values_[value_index].compare_exchange_weak(old_value,
+                                                           (old_value & pending_mask & ~bits) | (value & bits)))
+  {
+  }
+}
+
 bool RTDEWriter::sendSpeedSlider(double speed_slider_fraction)
 {
   if (speed_slider_fraction > 1.0 || speed_slider_fraction < 0.0)
@@ -74,22 +302,14 @@ bool RTDEWriter::sendSpeedSlider(double speed_slider_fraction)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint32_t mask = 1;
-  bool success = true;
-  success = package_.setData("speed_slider_mask", mask);
-  success = success && package_.setData("speed_slider_fraction", speed_slider_fraction);
-
-  if (success)
+  if (speed_slider_mask_index_ == NOT_IN_RECIPE || speed_slider_fraction_index_ == NOT_IN_RECIPE)
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  mask = 0;
-  success = package_.setData("speed_slider_mask", mask);
-  return success;
+  storeField(speed_slider_fraction_index_, speed_slider_fraction);
+  field_values_[speed_slider_mask_index_].fetch_or(1);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendStandardDigitalOutput(uint8_t output_pin, bool value)
@@ -102,31 +322,16 @@ bool RTDEWriter::sendStandardDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
-  {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("standard_digital_output_mask", mask);
-  success = success && package_.setData("standard_digital_output", digital_output);
-
-  if (success)
+  const PinFields& fields = standard_digital_output_fields_;
+  if (fields.mask == NOT_IN_RECIPE || fields.value == NOT_IN_RECIPE)
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  mask = 0;
-  success = package_.setData("standard_digital_output_mask", mask);
-  return success;
+  uint8_t mask = pinToMask(output_pin);
+  mergeBits(fields.value, fields.mask, mask, value ? 255 : 0);
+  field_values_[fields.mask].fetch_or(mask);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendConfigurableDigitalOutput(uint8_t output_pin, bool value)
@@ -140,31 +345,16 @@ bool RTDEWriter::sendConfigurableDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
+  const PinFields& fields = configurable_digital_output_fields_;
+  if (fields.mask == NOT_IN_RECIPE || fields.value == NOT_IN_RECIPE)
   {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("configurable_digital_output_mask", mask);
-  success = success && package_.setData("configurable_digital_output", digital_output);
-
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  mask = 0;
-  success = package_.setData("configurable_digital_output_mask", mask);
-  return success;
+  uint8_t mask = pinToMask(output_pin);
+  mergeBits(fields.value, fields.mask, mask, value ? 255 : 0);
+  field_values_[fields.mask].fetch_or(mask);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendToolDigitalOutput(uint8_t output_pin, bool value)
@@ -177,31 +367,16 @@ bool RTDEWriter::sendToolDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
+  const PinFields& fields = tool_digital_output_fields_;
+  if (fields.mask == NOT_IN_RECIPE || fields.value == NOT_IN_RECIPE)
   {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("tool_digital_output_mask", mask);
-  success = success && package_.setData("tool_digital_output", digital_output);
-
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  mask = 0;
-  success = package_.setData("tool_digital_output_mask", mask);
-  return success;
+  uint8_t mask = pinToMask(output_pin);
+  mergeBits(fields.value, fields.mask, mask, value ? 255 : 0);
+  field_values_[fields.mask].fetch_or(mask);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendStandardAnalogOutput(uint8_t output_pin, double value, const AnalogOutputType type)
@@ -221,30 +396,25 @@ bool RTDEWriter::sendStandardAnalogOutput(uint8_t output_pin, double value, cons
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-
-  bool success = true;
-  success = package_.setData("standard_analog_output_mask", mask);
-  if (type != AnalogOutputType::SET_ON_TEACH_PENDANT)
+  const size_t mask_index = standard_analog_output_mask_index_;
+  const size_t value_index = standard_analog_output_indices_[output_pin];
+  if (mask_index == NOT_IN_RECIPE || value_index == NOT_IN_RECIPE)
   {
-    auto output_type_bits = [](const uint8_t pin, const uint8_t type) { return type << pin; };
-    uint8_t output_type = output_type_bits(output_pin, toUnderlying(type));
-    success = success && package_.setData("standard_analog_output_type", output_type);
+    return false;
   }
-  success = success && package_.setData("standard_analog_output_0", value);
-  success = success && package_.setData("standard_analog_output_1", value);
-
-  if (success)
+  uint8_t mask = pinToMask(output_pin);
+  if (type != AnalogOutputType::SET_ON_TEACH_PENDANT)
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
+    if (standard_analog_output_type_index_ == NOT_IN_RECIPE)
     {
       return false;
     }
+    mergeBits(standard_analog_output_type_index_, mask_index, mask, toUnderlying(type) << output_pin);
   }
-  mask = 0;
-  success = package_.setData("standard_analog_output_mask", mask);
-  return success;
+  storeField(value_index, value);
+  field_values_[mask_index].fetch_or(mask);
+  notifyWriter();
+  return true;
 }
 
 uint8_t RTDEWriter::pinToMask(uint8_t pin)
@@ -267,20 +437,14 @@ bool RTDEWriter::sendInputBitRegister(uint32_t register_id, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  std::stringstream ss;
-  ss << "input_bit_register_" << register_id;
-
-  bool success = package_.setData(ss.str(), value);
-
-  if (success)
+  const size_t index = input_bit_register_indices_[register_id - 64];
+  if (index == NOT_IN_RECIPE || !checkNotOwned(index))
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  return success;
+  storeField(index, value);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendInputIntRegister(uint32_t register_id, int32_t value)
@@ -293,20 +457,14 @@ bool RTDEWriter::sendInputIntRegister(uint32_t register_id, int32_t value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  std::stringstream ss;
-  ss << "input_int_register_" << register_id;
-
-  bool success = package_.setData(ss.str(), value);
-
-  if (success)
+  const size_t index = input_int_register_indices_[register_id - 24];
+  if (index == NOT_IN_RECIPE || !checkNotOwned(index))
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
+    return false;
   }
-  return success;
+  storeField(index, value);
+  notifyWriter();
+  return true;
 }
 
 bool RTDEWriter::sendInputDoubleRegister(uint32_t register_id, double value)
@@ -319,20 +477,284 @@ bool RTDEWriter::sendInputDoubleRegister(uint32_t register_id, double value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  std::stringstream ss;
-  ss << "input_double_register_" << register_id;
+  const size_t index = input_double_register_indices_[register_id - 24];
+  if (index == NOT_IN_RECIPE || !checkNotOwned(index))
+  {
+    return false;
+  }
+  storeField(index, value);
+  notifyWriter();
+  return true;
+}
 
-  bool success = package_.setData(ss.str(), value);
+std::unique_ptr<InputRegisterBank> RTDEWriter::createInputRegisterBank(const std::vector<std::string>& registers)
+{
+  std::vector<size_t> field_indices;
+  for (const std::string& name : registers)
+  {
+    size_t index = NOT_IN_RECIPE;
+    if (name.rfind("input_bit_register_", 0) == 0)
+    {
+      index = resolveField<bool>(name);
+    }
+    else if (name.rfind("input_int_register_", 0) == 0)
+    {
+      index = resolveField<int32_t>(name);
+    }
+    else if (name.rfind("input_double_register_", 0) == 0)
+    {
+      index = resolveField<double>(name);
+    }
+    bool owned = false;
+    if (index == NOT_IN_RECIPE || !field_owned_[index].compare_exchange_strong(owned, true))
+    {
+      releaseBank(field_indices);
+      throw UrException("Cannot create an RTDE input register bank, as '" + name +
+                        "' is not an input register of the recipe or is already owned by another bank.");
+    }
+    field_indices.push_back(index);
+  }
+  return std::unique_ptr<InputRegisterBank>(new InputRegisterBank(*this, registers, field_indices));
+}
 
-  if (success)
+bool RTDEWriter::resolveRampFields(const RampTarget target, size_t& value_index, size_t& mask_index,
+                                   uint32_t& mask) const
+{
+  switch (target)
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
+    case RampTarget::SPEED_SLIDER:
+      value_index = speed_slider_fraction_index_;
+      mask_index = speed_slider_mask_index_;
+      mask = 1;
+      break;
+    case RampTarget::STANDARD_ANALOG_OUTPUT_0:
+    case RampTarget::STANDARD_ANALOG_OUTPUT_1:
     {
+      const size_t pin = toUnderlying(target) - toUnderlying(RampTarget::STANDARD_ANALOG_OUTPUT_0);
+      value_index = standard_analog_output_indices_[pin];
+      mask_index = standard_analog_output_mask_index_;
+      mask = 1u << pin;
+      break;
+    }
+    default:
       return false;
+  }
+  return value_index != NOT_IN_RECIPE && mask_index != NOT_IN_RECIPE;
+}
+
+bool RTDEWriter::startRamp(const RampTarget target, const double start_value, const double end_value,
+                           const std::chrono::milliseconds duration, const RampProfile profile)
+{
+  if (start_value < 0.0 || start_value > 1.0 || end_value < 0.0 || end_value > 1.0 || duration.count() < 0)
+  {
+    URCL_LOG_ERROR("Ramps have to be between 0 and 1 with a non-negative duration, got %f to %f in %lld ms.",
+                   start_value, end_value, static_cast<long long>(duration.count()));
+    return false;
+  }
+  size_t value_index, mask_index;
+  uint32_t mask;
+  if (!resolveRampFields(target, value_index, mask_index, mask))
+  {
+    return false;
+  }
+
+  Ramp ramp;
+  ramp.start_value = start_value;
+  ramp.end_value = end_value;
+  ramp.start_time = std::chrono::steady_clock::now();
+  ramp.duration = duration;
+  ramp.profile = profile;
+  ramp.active = true;
+  requestRamp(target, ramp);
+  return true;
+}
+
+void RTDEWriter::cancelRamp(const RampTarget target)
+{
+  if (!isRampActive(target))
+  {
+    return;
+  }
+  requestRamp(target, Ramp());
+}
+
+bool RTDEWriter::isRampActive(const RampTarget target) const
+{
+  const size_t i = toUnderlying(target);
+  return requested_generations_[i].load() != finished_generations_[i].load();
+}
+
+void RTDEWriter::requestRamp(const RampTarget target, const Ramp& ramp)
+{
+  const size_t i = toUnderlying(target);
+  {
+    std::lock_guard<PriorityInheritanceMutex> lock(ramp_mutex_);
+    requested_ramps_[i] = ramp;
+    requested_ramps_[i].generation = requested_generations_[i].load() + 1;
+    ramp_requested_[i] = true;
+    requested_generations_[i].store(requested_ramps_[i].generation);
+    ramps_requested_ = true;
+  }
+  triggerSend();
+}
+
+void RTDEWriter::applyRampRequests()
+{
+  // The writer thread doesn't wait for the application, it takes the requests over next cycle
+  std::unique_lock<PriorityInheritanceMutex> lock(ramp_mutex_, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    return;
+  }
+  for (size_t i = 0; i < NUM_RAMP_TARGETS; ++i)
+  {
+    if (!ramp_requested_[i])
+    {
+      continue;
+    }
+    ramp_requested_[i] = false;
+    if (ramps_[i].active)
+    {
+      --num_active_ramps_;
+    }
+    ramps_[i] = requested_ramps_[i];
+    if (ramps_[i].active)
+    {
+      ++num_active_ramps_;
+    }
+    else
+    {
+      finished_generations_[i].store(ramps_[i].generation);
+    }
+  }
+  ramps_requested_ = false;
+}
+
+void RTDEWriter::advanceRamps(const std::chrono::steady_clock::time_point now)
+{
+  for (size_t i = 0; i < NUM_RAMP_TARGETS; ++i)
+  {
+    Ramp& ramp = ramps_[i];
+    if (!ramp.active)
+    {
+      continue;
+    }
+    double progress = 1.0;
+    if (ramp.duration.count() > 0)
+    {
+      progress = std::chrono::duration<double>(now - ramp.start_time) / ramp.duration;
+      progress = std::min(std::max(progress, 0.0), 1.0);
+    }
+    const double shape = ramp.profile == RampProfile::SMOOTH ? 0.5 - 0.5 * std::cos(M_PI * progress) : progress;
+    const double value =
+        progress >= 1.0 ? ramp.end_value : ramp.start_value + (ramp.end_value - ramp.start_value) * shape;
+
+    size_t value_index, mask_index;
+    uint32_t mask;
+    resolveRampFields(static_cast<RampTarget>(i), value_index, mask_index, mask);
+    storeField(value_index, value);
+    field_values_[mask_index].fetch_or(mask);
+
+    if (progress >= 1.0)
+    {
+      ramp.active = false;
+      --num_active_ramps_;
+      finished_generations_[i].store(ramp.generation);
+    }
+  }
+}
+
+bool RTDEWriter::checkNotOwned(const size_t index) const
+{
+  if (field_owned_[index].load())
+  {
+    URCL_LOG_ERROR("The RTDE input field '%s' is owned by a register bank and cannot be written directly.",
+                   compiled_recipe_->getFields()[index].name.c_str());
+    return false;
+  }
+  return true;
+}
+
+void RTDEWriter::publishBank(const std::vector<size_t>& field_indices, const std::vector<uint64_t>& values)
+{
+  ++publishing_banks_;
+  for (size_t i = 0; i < field_indices.size(); ++i)
+  {
+    field_values_[field_indices[i]].store(values[i]);
+  }
+  ++bank_publications_;
+  --publishing_banks_;
+  notifyWriter();
+}
+
+void RTDEWriter::releaseBank(const std::vector<size_t>& field_indices)
+{
+  for (const size_t index : field_indices)
+  {
+    field_owned_[index].store(false);
+  }
+}
+
+InputRegisterBank::InputRegisterBank(RTDEWriter& writer, const std::vector<std::string>& registers,
+                                     const std::vector<size_t>& field_indices)
+  : writer_(writer), registers_(registers), field_indices_(field_indices), staged_values_(field_indices.size())
+{
+  // Publishing before setting every register must not reset the others
+  for (size_t i = 0; i < field_indices_.size(); ++i)
+  {
+    staged_values_[i] = writer_.field_values_[field_indices_[i]].load();
+  }
+}
+
+InputRegisterBank::~InputRegisterBank()
+{
+  writer_.releaseBank(field_indices_);
+}
+
+bool InputRegisterBank::setBitRegister(uint32_t register_id, bool value)
+{
+  if (register_id < 64 || register_id > 127)
+  {
+    return false;
+  }
+  return stage(writer_.input_bit_register_indices_[register_id - 64], RTDEWriter::toBits(value));
+}
+
+bool InputRegisterBank::setIntRegister(uint32_t register_id, int32_t value)
+{
+  if (register_id < 24 || register_id > 47)
+  {
+    return false;
+  }
+  return stage(writer_.input_int_register_indices_[register_id - 24], RTDEWriter::toBits(value));
+}
+
+bool InputRegisterBank::setDoubleRegister(uint32_t register_id, double value)
+{
+  if (register_id < 24 || register_id > 47)
+  {
+    return false;
+  }
+  return stage(writer_.input_double_register_indices_[register_id - 24], RTDEWriter::toBits(value));
+}
+
+void InputRegisterBank::publish()
+{
+  writer_.publishBank(field_indices_, staged_values_);
+}
+
+bool InputRegisterBank::stage(const size_t field_index, const uint64_t bits)
+{
+  // Banks own a handful of registers, so searching them is cheaper than any lookup structure.
+  for (size_t i = 0; i < field_indices_.size(); ++i)
+  {
+    if (field_indices_[i] == field_index)
+    {
+      staged_values_[i] = bits;
+      return true;
     }
   }
-  return success;
+  return false;
 }
 
 }  // namespace rtde_interface
@@ -0,0 +1,438 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/shared_state.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+constexpr uint32_t MAGIC = 0x5552534d;  // "URSM"
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr size_t CACHE_LINE_SIZE = 64;
+// Number of times a read is retried if the publisher overwrites the slot meanwhile
+constexpr size_t MAX_READ_ATTEMPTS = 16;
+
+// Both sides of the segment run on the same host, so all values are stored in host byte order.
+struct SegmentHeader
+{
+  // Set last when creating the segment, so readers never see a partially initialized segment
+  std::atomic<uint32_t> magic;
+  uint16_t format_version;
+  uint16_t protocol_version;
+  uint32_t slot_count;
+  uint32_t data_size;
+  uint32_t slot_size;
+  // Size of the recipe following the header, field names are separated by newlines
+  uint32_t recipe_size;
+  uint64_t slots_offset;
+  std::atomic<uint32_t> active;
+  // Process publishing into the segment, 0 if unknown
+  int32_t publisher_pid;
+  // Number of packages published so far, on a cache line of its own as it changes with every package
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published;
+};
+
+struct SlotHeader
+{
+  // Odd while the slot is being written. The n-th package written to a slot leaves it at 2 * n.
+  std::atomic<uint64_t> sequence;
+  int64_t receive_time_ns;
+  uint8_t recipe_id;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The shared state requires lock-free 64 bit atomics.");
+
+size_t alignToCacheLine(const size_t size)
+{
+  return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+size_t slotSize(const size_t data_size)
+{
+  return alignToCacheLine(sizeof(SlotHeader) + data_size);
+}
+
+uint64_t expectedSequence(const uint64_t package_number, const size_t slot_count)
+{
+  return 2 * (package_number / slot_count + 1);
+}
+
+bool isProcessAlive(const int32_t pid)
+{
+  return pid <= 0 || ::kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+// Removes a segment left over by a publisher that didn't shut down cleanly. A segment still
+// published to is kept.
+void removeStaleSegment(const std::string& name)
+{
+  const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    return;
+  }
+  bool published = false;
+  struct stat segment_stat;
+  if (::fstat(fd, &segment_stat) == 0 && static_cast<size_t>(segment_stat.st_size) >= sizeof(SegmentHeader))
+  {
+    void* data = ::mmap(nullptr, sizeof(SegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      const SegmentHeader* header = static_cast<const SegmentHeader*>(data);
+      published = header->magic.load(std::memory_order_acquire) == MAGIC &&
+                  header->active.load(std::memory_order_acquire) != 0 && isProcessAlive(header->publisher_pid);
+      ::munmap(data, sizeof(SegmentHeader));
+    }
+  }
+  ::close(fd);
+  if (published)
+  {
+    throw UrException("Shared memory segment '" + name + "' is still in use by another publisher.");
+  }
+  ::shm_unlink(name.c_str());
+}
+
+// Checks whether the name still refers to the given segment, it may have been replaced meanwhile
+bool isNameOf(const std::string& name, const dev_t device, const ino_t inode)
+{
+  const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat segment_stat;
+  const bool same = ::fstat(fd, &segment_stat) == 0 && segment_stat.st_dev == device && segment_stat.st_ino == inode;
+  ::close(fd);
+  return same;
+}
+}  // namespace
+
+SharedStatePublisher::SharedStatePublisher(const std::string& name, std::shared_ptr<const CompiledRecipe> recipe,
+                                           const size_t slot_count, const uint16_t protocol_version)
+  : name_(name)
+  , recipe_(recipe)
+  , slot_count_(slot_count)
+  , slot_size_(slotSize(recipe->getDataSize()))
+  , slots_offset_(0)
+  , segment_size_(0)
+  , segment_(nullptr)
+  , device_(0)
+  , inode_(0)
+{
+  if (slot_count_ == 0)
+  {
+    throw UrException("The number of slots of a shared state segment has to be greater than 0.");
+  }
+
+  std::string recipe_string;
+  for (const auto& field : recipe_->getRecipe())
+  {
+    recipe_string += field + "\n";
+  }
+  slots_offset_ = alignToCacheLine(sizeof(SegmentHeader) + recipe_string.size());
+  segment_size_ = slots_offset_ + slot_count_ * slot_size_;
+
+  removeStaleSegment(name_);
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0)
+  {
+    throw UrException("Could not create shared memory segment '" + name_ + "': " + std::strerror(errno));
+  }
+  struct stat segment_stat;
+  if (::fstat(fd, &segment_stat) != 0 || ::ftruncate(fd, static_cast<off_t>(segment_size_)) != 0)
+  {
+    const int error = errno;
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    throw UrException("Could not resize shared memory segment '" + name_ + "': " + std::strerror(error));
+  }
+  void* data = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    ::shm_unlink(name_.c_str());
+    throw UrException("Could not map shared memory segment '" + name_ + "': " + std::strerror(error));
+  }
+  segment_ = static_cast<uint8_t*>(data);
+  device_ = segment_stat.st_dev;
+  inode_ = segment_stat.st_ino;
+
+  SegmentHeader* header = new (segment_) SegmentHeader();
+  header->format_version = FORMAT_VERSION;
+  header->protocol_version = protocol_version;
+  header->slot_count = static_cast<uint32_t>(slot_count_);
+  header->data_size = static_cast<uint32_t>(recipe_->getDataSize());
+  header->slot_size = static_cast<uint32_t>(slot_size_);
+  header->recipe_size = static_cast<uint32_t>(recipe_string.size());
+  header->slots_offset = slots_offset_;
+  header->publisher_pid = static_cast<int32_t>(::getpid());
+  std::memcpy(segment_ + sizeof(SegmentHeader), recipe_string.data(), recipe_string.size());
+  for (size_t i = 0; i < slot_count_; ++i)
+  {
+    new (segment_ + slots_offset_ + i * slot_size_) SlotHeader();
+  }
+  header->active.store(1, std::memory_order_relaxed);
+  header->magic.store(MAGIC, std::memory_order_release);
+}
+
+SharedStatePublisher::~SharedStatePublisher()
+{
+  deactivate();
+  ::munmap(segment_, segment_size_);
+  // A publisher created after deactivating this one owns the name now
+  if (isNameOf(name_, device_, inode_))
+  {
+    ::shm_unlink(name_.c_str());
+  }
+}
+
+void SharedStatePublisher::deactivate()
+{
+  reinterpret_cast<SegmentHeader*>(segment_)->active.store(0, std::memory_order_release);
+}
+
+bool SharedStatePublisher::publish(const DataPackage& package, const Clock::time_point receive_time)
+{
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(segment_);
+  if (package.getCompiledRecipe() != recipe_ || header->active.load(std::memory_order_relaxed) == 0)
+  {
+    return false;
+  }
+
+  const uint64_t package_number = header->published.load(std::memory_order_relaxed);
+  uint8_t* slot = segment_ + slots_offset_ + (package_number % slot_count_) * slot_size_;
+  SlotHeader* slot_header = reinterpret_cast<SlotHeader*>(slot);
+
+  const uint64_t sequence = slot_header->sequence.load(std::memory_order_relaxed);
+  slot_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (package.serializeData(slot + sizeof(SlotHeader)) != recipe_->getDataSize())
+  {
+    // Nothing has been written, so the slot still holds its previous package
+    slot_header->sequence.store(sequence, std::memory_order_release);
+    return false;
+  }
+  slot_header->receive_time_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count();
+  slot_header->recipe_id = package.getRecipeID();
+  slot_header->sequence.store(sequence + 2, std::memory_order_release);
+  header->published.store(package_number + 1, std::memory_order_release);
+  return true;
+}
+
+SharedStateReader::SharedStateReader(const std::string& name)
+  : protocol_version_(0)
+  , slot_count_(0)
+  , slot_size_(0)
+  , slots_offset_(0)
+  , segment_size_(0)
+  , segment_(nullptr)
+  , recipe_id_(0)
+  , next_package_(0)
+  , missed_count_(0)
+{
+  const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    throw UrException("Could not open shared memory segment '" + name + "': " + std::strerror(errno));
+  }
+  struct stat segment_stat;
+  if (::fstat(fd, &segment_stat) != 0 || static_cast<size_t>(segment_stat.st_size) < sizeof(SegmentHeader))
+  {
+    ::close(fd);
+    throw UrException("Shared memory segment '" + name + "' doesn't contain a shared robot state.");
+  }
+  segment_size_ = static_cast<size_t>(segment_stat.st_size);
+  void* data = ::mmap(nullptr, segment_size_, PROT_READ, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw UrException("Could not map shared memory segment '" + name + "': " + std::strerror(error));
+  }
+  segment_ = static_cast<const uint8_t*>(data);
+
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(segment_);
+  slot_count_ = header->slot_count;
+  slot_size_ = header->slot_size;
+  slots_offset_ = header->slots_offset;
+  if (header->magic.load(std::memory_order_acquire) != MAGIC || header->format_version != FORMAT_VERSION ||
+      slot_count_ == 0 || slots_offset_ < sizeof(SegmentHeader) + header->recipe_size ||
+      slots_offset_ + slot_count_ * slot_size_ > segment_size_)
+  {
+    ::munmap(const_cast<uint8_t*>(segment_), segment_size_);
+    throw UrException("Shared memory segment '" + name + "' doesn't contain a shared robot state.");
+  }
+  protocol_version_ = header->protocol_version;
+
+  std::vector<std::string> recipe;
+  std::istringstream recipe_stream(
+      std::string(reinterpret_cast<const char*>(segment_ + sizeof(SegmentHeader)), header->recipe_size));
+  std::string field;
+  while (std::getline(recipe_stream, field))
+  {
+    recipe.push_back(field);
+  }
+  recipe_ = std::make_shared<const CompiledRecipe>(recipe);
+  if (recipe_->getDataSize() != header->data_size || slotSize(header->data_size) != slot_size_)
+  {
+    ::munmap(const_cast<uint8_t*>(segment_), segment_size_);
+    throw UrException("The layout of shared memory segment '" + name + "' doesn't match its recipe.");
+  }
+  data_.resize(recipe_->getDataSize());
+  next_package_ = header->published.load(std::memory_order_acquire);
+}
+
+SharedStateReader::~SharedStateReader()
+{
+  ::munmap(const_cast<uint8_t*>(segment_), segment_size_);
+}
+
+bool SharedStateReader::readLatest(DataPackage& package, Clock::time_point* receive_time)
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(segment_);
+  for (size_t i = 0; i < MAX_READ_ATTEMPTS; ++i)
+  {
+    const uint64_t published = header->published.load(std::memory_order_acquire);
+    if (published == 0)
+    {
+      return false;
+    }
+    if (copySlot(published - 1, receive_time))
+    {
+      return fill(package);
+    }
+  }
+  return false;
+}
+
+bool SharedStateReader::readNext(DataPackage& package, Clock::time_point* receive_time)
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(segment_);
+  while (true)
+  {
+    const uint64_t published = header->published.load(std::memory_order_acquire);
+    if (next_package_ >= published)
+    {
+      return false;
+    }
+    if (published - next_package_ > slot_count_)
+    {
+      // The oldest unread packages have been overwritten already
+      missed_count_ += published - slot_count_ - next_package_;
+      next_package_ = published - slot_count_;
+    }
+    // Packages counted as published are complete, so a failing copy means the slot has been
+    // overwritten.
+    if (copySlot(next_package_++, receive_time))
+    {
+      return fill(package);
+    }
+    missed_count_++;
+  }
+}
+
+uint64_t SharedStateReader::getPublishedCount() const
+{
+  return reinterpret_cast<const SegmentHeader*>(segment_)->published.load(std::memory_order_acquire);
+}
+
+bool SharedStateReader::isActive() const
+{
+  return reinterpret_cast<const SegmentHeader*>(segment_)->active.load(std::memory_order_acquire) != 0;
+}
+
+bool SharedStateReader::copySlot(const uint64_t package_number, Clock::time_point* receive_time)
+{
+  const uint8_t* slot = segment_ + slots_offset_ + (package_number % slot_count_) * slot_size_;
+  const SlotHeader* slot_header = reinterpret_cast<const SlotHeader*>(slot);
+
+  const uint64_t sequence = slot_header->sequence.load(std::memory_order_acquire);
+  if (sequence != expectedSequence(package_number, slot_count_))
+  {
+    return false;
+  }
+  std::memcpy(data_.data(), slot + sizeof(SlotHeader), data_.size());
+  const int64_t receive_time_ns = slot_header->receive_time_ns;
+  const uint8_t recipe_id = slot_header->recipe_id;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot_header->sequence.load(std::memory_order_relaxed) != sequence)
+  {
+    return false;
+  }
+
+  recipe_id_ = recipe_id;
+  if (receive_time != nullptr)
+  {
+    *receive_time = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(receive_time_ns)));
+  }
+  return true;
+}
+
+bool SharedStateReader::fill(DataPackage& package)
+{
+  comm::BinParser bp(data_.data(), data_.size());
+  if (!package.parseData(bp))
+  {
+    return false;
+  }
+  package.setRecipeID(recipe_id_);
+  return true;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
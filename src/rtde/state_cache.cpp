@@ -0,0 +1,216 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+// Resolves a handle of a field, that might not be part of the recipe
+template <typename T>
+FieldHandle<T> findField(const CompiledRecipe& recipe, const std::string& name)
+{
+  size_t index;
+  if (!recipe.findIndex(name, index) || !std::holds_alternative<T>(recipe.getFields()[index].empty_value))
+  {
+    return FieldHandle<T>();
+  }
+  return recipe.getFieldHandle<T>(name);
+}
+}  // namespace
+
+StateSnapshot::StateSnapshot(std::shared_ptr<const CompiledRecipe> recipe)
+  : recipe_(recipe)
+  , data_(recipe_->getDataSize())
+  , valid_(false)
+  , package_number_(0)
+  , recipe_id_(0)
+  , actual_q_handle_(findField<vector6d_t>(*recipe_, "actual_q"))
+  , actual_qd_handle_(findField<vector6d_t>(*recipe_, "actual_qd"))
+  , acceleration_{}
+{
+}
+
+bool StateSnapshot::predictJointState(const Clock::time_point time, vector6d_t& q, vector6d_t& qd,
+                                      const PredictionModel model,
+                                      const std::chrono::microseconds measurement_delay) const
+{
+  vector6d_t actual_q;
+  vector6d_t actual_qd;
+  if (!getData(actual_q_handle_, actual_q) || !getData(actual_qd_handle_, actual_qd))
+  {
+    return false;
+  }
+  // A state is never predicted into the past
+  const double dt = std::max(0.0, std::chrono::duration<double>(time - receive_time_ + measurement_delay).count());
+  const bool accelerate = model == PredictionModel::CONSTANT_ACCELERATION;
+  for (size_t i = 0; i < q.size(); ++i)
+  {
+    const double acceleration = accelerate ? acceleration_[i] : 0.0;
+    q[i] = actual_q[i] + actual_qd[i] * dt + 0.5 * acceleration * dt * dt;
+    qd[i] = actual_qd[i] + acceleration * dt;
+  }
+  return true;
+}
+
+bool StateSnapshot::fill(DataPackage& package) const
+{
+  if (!valid_ || package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+  // The BinParser only reads from the buffer
+  comm::BinParser bp(const_cast<uint8_t*>(data_.data()), data_.size());
+  package.parseData(bp);
+  package.setRecipeID(recipe_id_);
+  return true;
+}
+
+StateCache::StateCache(std::shared_ptr<const CompiledRecipe> recipe)
+  : recipe_(recipe)
+  , data_size_(recipe_->getDataSize())
+  , data_(2 * recipe_->getDataSize())
+  , accelerations_{}
+  , update_count_(0)
+  , timestamp_handle_(findField<double>(*recipe_, "timestamp"))
+  , actual_qd_handle_(findField<vector6d_t>(*recipe_, "actual_qd"))
+  , has_previous_(false)
+  , previous_timestamp_(0.0)
+  , previous_qd_{}
+{
+}
+
+vector6d_t StateCache::estimateAcceleration(const DataPackage& package)
+{
+  vector6d_t acceleration{};
+  double timestamp;
+  vector6d_t qd;
+  if (!package.getData(timestamp_handle_, timestamp) || !package.getData(actual_qd_handle_, qd))
+  {
+    return acceleration;
+  }
+  const double dt = timestamp - previous_timestamp_;
+  if (has_previous_ && dt > 0.0)
+  {
+    for (size_t i = 0; i < acceleration.size(); ++i)
+    {
+      acceleration[i] = (qd[i] - previous_qd_[i]) / dt;
+    }
+  }
+  has_previous_ = true;
+  previous_timestamp_ = timestamp;
+  previous_qd_ = qd;
+  return acceleration;
+}
+
+bool StateCache::update(const DataPackage& package, const Clock::time_point receive_time)
+{
+  if (package.getCompiledRecipe() != recipe_)
+  {
+    return false;
+  }
+
+  // Readers look at the slot of the latest package, so the other one is written.
+  const uint64_t package_number = update_count_.load(std::memory_order_relaxed) + 1;
+  const size_t slot_index = package_number % slots_.size();
+  Slot& slot = slots_[slot_index];
+  uint8_t* data = data_.data() + slot_index * data_size_;
+
+  const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (package.serializeData(data) != data_size_)
+  {
+    // Nothing has been written, so the slot still holds its previous package
+    slot.sequence.store(sequence, std::memory_order_release);
+    return false;
+  }
+  accelerations_[slot_index] = estimateAcceleration(package);
+  slot.package_number.store(package_number, std::memory_order_relaxed);
+  slot.receive_time_ns.store(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count(),
+      std::memory_order_relaxed);
+  slot.recipe_id.store(package.getRecipeID(), std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  update_count_.store(package_number, std::memory_order_release);
+  return true;
+}
+
+bool StateCache::read(StateSnapshot& snapshot) const
+{
+  if (snapshot.recipe_ != recipe_)
+  {
+    return false;
+  }
+
+  for (size_t attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+  {
+    const uint64_t latest = update_count_.load(std::memory_order_acquire);
+    if (latest == 0)
+    {
+      return false;
+    }
+    const size_t slot_index = latest % slots_.size();
+    const Slot& slot = slots_[slot_index];
+
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0)
+    {
+      continue;
+    }
+    std::memcpy(snapshot.data_.data(), data_.data() + slot_index * data_size_, data_size_);
+    snapshot.acceleration_ = accelerations_[slot_index];
+    const uint64_t package_number = slot.package_number.load(std::memory_order_relaxed);
+    const int64_t receive_time_ns = slot.receive_time_ns.load(std::memory_order_relaxed);
+    const uint8_t recipe_id = slot.recipe_id.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+    {
+      continue;
+    }
+
+    snapshot.valid_ = true;
+    snapshot.package_number_ = package_number;
+    snapshot.receive_time_ =
+        Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(receive_time_ns)));
+    snapshot.recipe_id_ = recipe_id;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,186 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/stream_monitor.h"
+
+#include <cmath>
+
+namespace urcl
+{
+namespace rtde_interface
+{
+StreamMonitor::StreamMonitor()
+  : period_(0.0)
+  , late_tolerance_(1.5)
+  , has_previous_(false)
+  , previous_timestamp_(0.0)
+  , jitter_sum_(0)
+  , num_intervals_(0)
+{
+}
+
+void StreamMonitor::setRecipe(const CompiledRecipe& recipe)
+{
+  FieldHandle<double> handle = recipe.getFieldHandle<double>("timestamp");
+  std::lock_guard<std::mutex> lock(mutex_);
+  timestamp_handle_ = handle;
+  has_previous_ = false;
+}
+
+void StreamMonitor::setTargetFrequency(const double frequency)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  period_ = frequency > 0.0 ? 1.0 / frequency : 0.0;
+  has_previous_ = false;
+}
+
+void StreamMonitor::setLateTolerance(const double factor)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  late_tolerance_ = factor;
+}
+
+void StreamMonitor::setViolationCallback(ViolationCallback callback)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  callback_ = std::move(callback);
+}
+
+void StreamMonitor::update(const DataPackage& package, const std::chrono::steady_clock::time_point arrival_time)
+{
+  bool missed = false;
+  bool late = false;
+  StreamStatistics statistics;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double timestamp;
+    if (!package.getData(timestamp_handle_, timestamp))
+    {
+      return;
+    }
+    statistics_.num_packages++;
+    if (has_previous_ && period_ > 0.0)
+    {
+      const double timestamp_interval = timestamp - previous_timestamp_;
+      if (timestamp_interval > late_tolerance_ * period_)
+      {
+        const uint64_t cycles = static_cast<uint64_t>(std::llround(timestamp_interval / period_));
+        if (cycles > 1)
+        {
+          statistics_.num_missed += cycles - 1;
+          missed = true;
+        }
+      }
+
+      const auto arrival_interval =
+          std::chrono::duration_cast<std::chrono::microseconds>(arrival_time - previous_arrival_);
+      const auto period = std::chrono::microseconds(static_cast<int64_t>(period_ * 1e6));
+      const auto jitter = arrival_interval > period ? arrival_interval - period : period - arrival_interval;
+      num_intervals_++;
+      jitter_sum_ += jitter;
+      statistics_.mean_jitter = jitter_sum_ / num_intervals_;
+      if (jitter > statistics_.max_jitter)
+      {
+        statistics_.max_jitter = jitter;
+      }
+      if (arrival_interval > statistics_.max_arrival_interval)
+      {
+        statistics_.max_arrival_interval = arrival_interval;
+      }
+      // A package following missed ones arrives late naturally, it is only counted as missed.
+      if (!missed && arrival_interval.count() > late_tolerance_ * period.count())
+      {
+        statistics_.num_late++;
+        late = true;
+      }
+    }
+    has_previous_ = true;
+    previous_timestamp_ = timestamp;
+    previous_arrival_ = arrival_time;
+    statistics = statistics_;
+  }
+
+  if (missed)
+  {
+    notify(StreamViolation::MISSED_PACKAGES, statistics);
+  }
+  if (late)
+  {
+    notify(StreamViolation::LATE_PACKAGE, statistics);
+  }
+}
+
+void StreamMonitor::reportOverflow()
+{
+  StreamStatistics statistics;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.num_overflows++;
+    statistics = statistics_;
+  }
+  notify(StreamViolation::PIPELINE_OVERFLOW, statistics);
+}
+
+void StreamMonitor::restart()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  has_previous_ = false;
+}
+
+void StreamMonitor::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  has_previous_ = false;
+  jitter_sum_ = std::chrono::microseconds(0);
+  num_intervals_ = 0;
+  statistics_ = StreamStatistics();
+}
+
+StreamStatistics StreamMonitor::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void StreamMonitor::notify(const StreamViolation violation, const StreamStatistics& statistics)
+{
+  ViolationCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback = callback_;
+  }
+  if (callback)
+  {
+    callback(violation, statistics);
+  }
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,206 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/stream_watchdog.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+StreamWatchdog::StreamWatchdog()
+  : keep_running_(true)
+  , period_(0.002)
+  , missed_periods_(DEFAULT_MISSED_PERIODS)
+  , watching_(false)
+  , armed_(false)
+  , stale_(false)
+  , has_timestamp_(false)
+  , last_timestamp_(0.0)
+  , num_stale_events_(0)
+{
+  thread_ = std::thread(&StreamWatchdog::run, this);
+}
+
+StreamWatchdog::~StreamWatchdog()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    keep_running_ = false;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void StreamWatchdog::setRecipe(const CompiledRecipe& recipe)
+{
+  FieldHandle<double> handle = recipe.getFieldHandle<double>("timestamp");
+  std::lock_guard<std::mutex> lock(mutex_);
+  timestamp_handle_ = handle;
+  has_timestamp_ = false;
+}
+
+void StreamWatchdog::setTargetFrequency(const double frequency)
+{
+  if (!(frequency > 0.0))
+  {
+    throw UrException("The publishing frequency watched by a stream watchdog has to be positive.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  period_ = 1.0 / frequency;
+}
+
+void StreamWatchdog::setMissedPeriods(const size_t missed_periods)
+{
+  if (missed_periods == 0)
+  {
+    throw UrException("A stream watchdog has to allow at least one missed period.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  missed_periods_ = missed_periods;
+}
+
+void StreamWatchdog::setStaleCallback(StaleCallback callback)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  callback_ = std::move(callback);
+}
+
+void StreamWatchdog::update(const DataPackage& package, const std::chrono::steady_clock::time_point arrival_time)
+{
+  bool was_stale = false;
+  StaleCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double timestamp;
+    if (!watching_ || !package.getData(timestamp_handle_, timestamp))
+    {
+      return;
+    }
+    if (has_timestamp_ && timestamp <= last_timestamp_)
+    {
+      // The robot didn't advance, so the package doesn't prove the stream alive
+      return;
+    }
+    has_timestamp_ = true;
+    last_timestamp_ = timestamp;
+    deadline_ = arrival_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   std::chrono::duration<double>(period_ * missed_periods_));
+    // The watchdog's thread waits without a deadline until armed or fresh again
+    if (stale_ || !armed_)
+    {
+      was_stale = stale_;
+      callback = callback_;
+      stale_ = false;
+      armed_ = true;
+      cv_.notify_all();
+    }
+  }
+  if (was_stale)
+  {
+    URCL_LOG_INFO("RTDE stream is fresh again.");
+    if (callback)
+    {
+      callback(false);
+    }
+  }
+}
+
+void StreamWatchdog::start()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  watching_ = true;
+  armed_ = false;
+  has_timestamp_ = false;
+}
+
+void StreamWatchdog::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    watching_ = false;
+    armed_ = false;
+  }
+  cv_.notify_all();
+}
+
+bool StreamWatchdog::isStale() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stale_;
+}
+
+uint64_t StreamWatchdog::getNumStaleEvents() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_stale_events_;
+}
+
+std::chrono::steady_clock::duration StreamWatchdog::getTimeout() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(period_ * missed_periods_));
+}
+
+void StreamWatchdog::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (keep_running_)
+  {
+    if (!armed_ || stale_)
+    {
+      cv_.wait(lock);
+      continue;
+    }
+    // Fed packages move the deadline, so it is checked again after every wakeup
+    const std::chrono::steady_clock::time_point deadline = deadline_;
+    if (std::chrono::steady_clock::now() < deadline)
+    {
+      cv_.wait_until(lock, deadline);
+      continue;
+    }
+    stale_ = true;
+    num_stale_events_++;
+    StaleCallback callback = callback_;
+    const size_t missed_periods = missed_periods_;
+    lock.unlock();
+    URCL_LOG_WARN("RTDE stream is stale, no package received for %zu periods.", missed_periods);
+    if (callback)
+    {
+      callback(true);
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
@@ -0,0 +1,166 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/trace.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+
+namespace urcl
+{
+namespace
+{
+// Each slot is guarded by its sequence number, which is 0 while the slot is being written and the
+// index of the event plus one afterwards. Readers skip slots that changed while being read.
+struct TraceSlot
+{
+  std::atomic<uint64_t> sequence;
+  std::atomic<int64_t> time;
+  std::atomic<uint32_t> thread_id;
+  std::atomic<uint8_t> point;
+  std::atomic<uint64_t> argument;
+};
+
+std::array<TraceSlot, TRACE_BUFFER_SIZE> g_trace_slots;
+std::atomic<uint64_t> g_next_trace_index(0);
+// Events with an index below this have been cleared
+std::atomic<uint64_t> g_first_trace_index(0);
+
+uint32_t currentThreadId()
+{
+  thread_local const uint32_t thread_id = static_cast<uint32_t>(::syscall(SYS_gettid));
+  return thread_id;
+}
+}  // namespace
+
+std::string tracePointToString(const TracePoint point)
+{
+  switch (point)
+  {
+    case TracePoint::SOCKET_READ:
+      return "SOCKET_READ";
+    case TracePoint::PARSE_DONE:
+      return "PARSE_DONE";
+    case TracePoint::PIPELINE_ENQUEUE:
+      return "PIPELINE_ENQUEUE";
+    case TracePoint::PIPELINE_DEQUEUE:
+      return "PIPELINE_DEQUEUE";
+    case TracePoint::CONSUMER_INVOKED:
+      return "CONSUMER_INVOKED";
+    case TracePoint::CONSUMER_DONE:
+      return "CONSUMER_DONE";
+    case TracePoint::REVERSE_INTERFACE_WRITE:
+      return "REVERSE_INTERFACE_WRITE";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+void recordTraceEvent(const TracePoint point, const uint64_t argument)
+{
+  const int64_t time = std::chrono::steady_clock::now().time_since_epoch().count();
+  const uint64_t index = g_next_trace_index.fetch_add(1, std::memory_order_relaxed);
+  TraceSlot& slot = g_trace_slots[index % TRACE_BUFFER_SIZE];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.time.store(time, std::memory_order_relaxed);
+  slot.thread_id.store(currentThreadId(), std::memory_order_relaxed);
+  slot.point.store(static_cast<uint8_t>(point), std::memory_order_relaxed);
+  slot.argument.store(argument, std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> getTraceEvents()
+{
+  const uint64_t first = g_first_trace_index.load(std::memory_order_relaxed);
+  std::vector<TraceEvent> events;
+  for (const TraceSlot& slot : g_trace_slots)
+  {
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || sequence <= first)
+    {
+      continue;
+    }
+    TraceEvent event;
+    event.time = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(slot.time.load(std::memory_order_relaxed)));
+    event.thread_id = slot.thread_id.load(std::memory_order_relaxed);
+    event.point = static_cast<TracePoint>(slot.point.load(std::memory_order_relaxed));
+    event.argument = slot.argument.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      events.push_back(event);
+    }
+  }
+  std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time < b.time; });
+  return events;
+}
+
+void clearTraceEvents()
+{
+  g_first_trace_index.store(g_next_trace_index.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::string traceEventsToJson(const std::vector<TraceEvent>& events)
+{
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  const int pid = static_cast<int>(::getpid());
+  char buffer[256];
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const TraceEvent& event = events[i];
+    const double timestamp_us =
+        std::chrono::duration<double, std::micro>(event.time.time_since_epoch()).count();
+    // Consumer calls are shown as durations, all other trace points as instants
+    const char* phase = "i";
+    std::string name = tracePointToString(event.point);
+    if (event.point == TracePoint::CONSUMER_INVOKED || event.point == TracePoint::CONSUMER_DONE)
+    {
+      phase = event.point == TracePoint::CONSUMER_INVOKED ? "B" : "E";
+      name = "CONSUMER";
+    }
+    std::snprintf(buffer, sizeof(buffer),
+                  "%s{\"name\":\"%s\",\"ph\":\"%s\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%" PRIu32
+                  ",\"args\":{\"argument\":%" PRIu64 "}}",
+                  i > 0 ? "," : "", name.c_str(), phase, timestamp_us, pid, event.thread_id, event.argument);
+    json += buffer;
+  }
+  json += "]}";
+  return json;
+}
+
+}  // namespace urcl
@@ -34,18 +34,19 @@ CalibrationChecker::CalibrationChecker(const std::string& expected_hash)
   : expected_hash_(expected_hash), checked_(false), matches_(false)
 {
 }
-bool CalibrationChecker::consume(std::shared_ptr<primary_interface::PrimaryPackage> product)
+bool CalibrationChecker::handle(primary_interface::KinematicsInfo& kin_info)
 {
-  auto kin_info = std::dynamic_pointer_cast<primary_interface::KinematicsInfo>(product);
-  if (kin_info != nullptr)
-  {
-    // URCL_LOG_INFO("%s", product->toString().c_str());
-    //
-    matches_ = kin_info->toHash() == expected_hash_;
+  matches_ = kin_info.toHash() == expected_hash_;
+  checked_ = true;
+  return true;
+}
 
-    checked_ = true;
+bool CalibrationChecker::handle(primary_interface::RobotStateFrame& frame)
+{
+  if (auto kin_info = frame.getPackage<primary_interface::KinematicsInfo>())
+  {
+    return handle(*kin_info);
   }
-
   return true;
 }
 }  // namespace urcl
@@ -27,10 +27,14 @@
 //----------------------------------------------------------------------
 
 #include <iostream>
+#include <memory>
 #include <regex>
+#include <unordered_map>
 #include <thread>
 #include <unistd.h>
+#include <ur_client_library/clock.h>
 #include <ur_client_library/log.h>
+#include <ur_client_library/rtde/rtde_client.h>
 #include <ur_client_library/ur/dashboard_client.h>
 #include <ur_client_library/exceptions.h>
 
@@ -42,6 +46,36 @@ DashboardClient::DashboardClient(const std::string& host) : host_(host), port_(D
 {
 }
 
+bool DashboardClient::matches(const std::string& str, const std::string& pattern)
+{
+  // Compiling a regex is far more expensive than matching it, while only a small set of patterns is
+  // used, so compiled patterns are reused across calls and clients.
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const std::regex>> cache;
+  static constexpr size_t MAX_CACHED_PATTERNS = 128;
+
+  std::shared_ptr<const std::regex> regex;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(pattern);
+    if (it != cache.end())
+    {
+      regex = it->second;
+    }
+    else
+    {
+      // Patterns containing user input, e.g. program names, must not grow the cache without bounds
+      if (cache.size() >= MAX_CACHED_PATTERNS)
+      {
+        cache.clear();
+      }
+      regex = std::make_shared<const std::regex>(pattern);
+      cache.emplace(pattern, regex);
+    }
+  }
+  return std::regex_match(str, *regex);
+}
+
 void DashboardClient::rtrim(std::string& str, const std::string& chars)
 {
   str.erase(str.find_last_not_of(chars) + 1);
@@ -61,6 +95,7 @@ bool DashboardClient::connect(const size_t max_num_tries, const std::chrono::mil
 
   while (not ret_val)
   {
+    read_buffer_.clear();
     // The first read after connection can take more time.
     tv.tv_sec = 10;
     tv.tv_usec = 0;
@@ -97,6 +132,7 @@ void DashboardClient::disconnect()
 {
   URCL_LOG_INFO("Disconnecting from Dashboard server on %s:%d", host_.c_str(), port_);
   TCPSocket::close();
+  read_buffer_.clear();
 }
 
 bool DashboardClient::send(const std::string& text)
@@ -109,25 +145,25 @@ bool DashboardClient::send(const std::string& text)
 
 std::string DashboardClient::read()
 {
-  std::stringstream result;
-  char character;
-  size_t read_chars = 99;
-  while (read_chars > 0)
+  // Responses are read in chunks. Anything after the first line belongs to the next response, e.g.
+  // when several commands have been sent at once, and is kept for the next call.
+  size_t line_end;
+  while ((line_end = read_buffer_.find('\n')) == std::string::npos)
   {
-    if (!TCPSocket::read((uint8_t*)&character, 1, read_chars))
+    char chunk[1024];
+    size_t read_chars = 0;
+    if (!TCPSocket::read(reinterpret_cast<uint8_t*>(chunk), sizeof(chunk), read_chars))
     {
       disconnect();
       throw TimeoutException("Did not receive answer from dashboard server in time. Disconnecting from dashboard "
                              "server.",
                              *recv_timeout_);
     }
-    result << character;
-    if (character == '\n')
-    {
-      break;
-    }
+    read_buffer_.append(chunk, read_chars);
   }
-  return result.str();
+  std::string result = read_buffer_.substr(0, line_end + 1);
+  read_buffer_.erase(0, line_end + 1);
+  return result;
 }
 
 std::string DashboardClient::sendAndReceive(const std::string& text)
@@ -152,12 +188,41 @@ std::string DashboardClient::sendAndReceive(const std::string& text)
   return response;
 }
 
+std::vector<std::string> DashboardClient::sendAndReceive(const std::vector<std::string>& commands)
+{
+  std::string batch;
+  for (const auto& command : commands)
+  {
+    batch += command;
+    if (command.empty() || command.back() != '\n')
+    {
+      batch += '\n';
+    }
+  }
+
+  std::vector<std::string> responses;
+  responses.reserve(commands.size());
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  // The server answers the commands one after another, so all of them can be sent at once and the
+  // responses are read in order afterwards.
+  if (!send(batch))
+  {
+    throw UrException("Failed to send request to dashboard server. Are you connected to the Dashboard Server?");
+  }
+  for (size_t i = 0; i < commands.size(); ++i)
+  {
+    responses.push_back(read());
+    rtrim(responses.back());
+  }
+  return responses;
+}
+
 bool DashboardClient::sendRequest(const std::string& command, const std::string& expected)
 {
   URCL_LOG_DEBUG("Send Request: %s", command.c_str());
   std::string response = sendAndReceive(command);
   URCL_LOG_DEBUG("Got Response: %s", response.c_str());
-  bool ret = std::regex_match(response, std::regex(expected));
+  bool ret = matches(response, expected);
   if (!ret)
   {
     URCL_LOG_WARN("Expected: \"%s\", but received: \"%s\"", expected.c_str(), response.c_str());
@@ -169,7 +234,7 @@ std::string DashboardClient::sendRequestString(const std::string& command, const
 {
   URCL_LOG_DEBUG("Send Request: %s", command.c_str());
   std::string response = sendAndReceive(command);
-  bool ret = std::regex_match(response, std::regex(expected));
+  bool ret = matches(response, expected);
   if (!ret)
   {
     throw UrException("Expected: " + expected + ", but received: " + response);
@@ -191,13 +256,13 @@ bool DashboardClient::waitForReply(const std::string& command, const std::string
     response = sendAndReceive(command);
 
     // Check if the response was as expected
-    if (std::regex_match(response, std::regex(expected)))
+    if (matches(response, expected))
     {
       return true;
     }
 
     // wait 100ms before trying again
-    std::this_thread::sleep_for(wait_period);
+    getClock()->sleepFor(std::chrono::duration_cast<Clock::duration>(wait_period));
     time_done += wait_period;
   }
 
@@ -225,121 +290,198 @@ bool DashboardClient::retryCommand(const std::string& requestCommand, const std:
   return false;
 }
 
+void DashboardClient::attachRTDEClient(rtde_interface::RTDEClient& rtde_client)
+{
+  std::shared_ptr<RTDEState> state = std::make_shared<RTDEState>();
+  rtde_client.addFieldChangeCallback<int32_t>("robot_mode", [state](const int32_t& robot_mode) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->robot_mode = robot_mode;
+    state->has_robot_mode = true;
+    state->cv.notify_all();
+  });
+  rtde_client.addFieldChangeCallback<uint32_t>("runtime_state", [state](const uint32_t& runtime_state) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->runtime_state = runtime_state;
+    state->has_runtime_state = true;
+    state->cv.notify_all();
+  });
+  rtde_state_ = state;
+}
+
+bool DashboardClient::waitForRobotMode(const RobotMode mode, const std::chrono::duration<double> timeout)
+{
+  if (rtde_state_ != nullptr)
+  {
+    std::unique_lock<std::mutex> lock(rtde_state_->mutex);
+    if (rtde_state_->has_robot_mode)
+    {
+      if (rtde_state_->cv.wait_for(lock, timeout,
+                                   [&]() { return rtde_state_->robot_mode == static_cast<int32_t>(mode); }))
+      {
+        return true;
+      }
+      URCL_LOG_WARN("Robot mode did not change to %s within the timeout. Last robot mode received via RTDE was %d",
+                    robotModeString(mode).c_str(), rtde_state_->robot_mode);
+      return false;
+    }
+  }
+  return waitForReply("robotmode", "Robotmode: " + robotModeString(mode), timeout);
+}
+
+bool DashboardClient::waitForRuntimeState(const RuntimeState state, const std::string& expected_program_state,
+                                          const std::chrono::duration<double> timeout)
+{
+  if (rtde_state_ != nullptr)
+  {
+    std::unique_lock<std::mutex> lock(rtde_state_->mutex);
+    if (rtde_state_->has_runtime_state)
+    {
+      if (rtde_state_->cv.wait_for(lock, timeout,
+                                   [&]() { return rtde_state_->runtime_state == static_cast<uint32_t>(state); }))
+      {
+        return true;
+      }
+      URCL_LOG_WARN("Program state did not change to %s within the timeout. Last runtime state received via RTDE "
+                    "was %u",
+                    runtimeStateString(state).c_str(), rtde_state_->runtime_state);
+      return false;
+    }
+  }
+  return waitForReply("programState", expected_program_state, timeout);
+}
+
 bool DashboardClient::commandPowerOff()
 {
-  assertVersion("5.0.0", "3.0", "power off");
-  return sendRequest("power off", "Powering off") && waitForReply("robotmode", "Robotmode: POWER_OFF");
+  assertSupported(DashboardCommand::POWER_OFF);
+  return sendRequest("power off", "Powering off") && waitForRobotMode(RobotMode::POWER_OFF, std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandPowerOn(const std::chrono::duration<double> timeout)
 {
-  assertVersion("5.0.0", "3.0", "power on");
-  return retryCommand("power on", "Powering on", "robotmode", "Robotmode: IDLE", timeout);
+  assertSupported(DashboardCommand::POWER_ON);
+  const std::chrono::duration<double> retry_period = std::chrono::seconds(1);
+  std::chrono::duration<double> time_done(0);
+  do
+  {
+    sendRequest("power on", "Powering on");
+    time_done += retry_period;
+
+    if (waitForRobotMode(RobotMode::IDLE, retry_period))
+    {
+      return true;
+    }
+  } while (time_done < timeout);
+  return false;
 }
 
 bool DashboardClient::commandBrakeRelease()
 {
-  assertVersion("5.0.0", "3.0", "brake release");
-  return sendRequest("brake release", "Brake releasing") && waitForReply("robotmode", "Robotmode: RUNNING");
+  assertSupported(DashboardCommand::BRAKE_RELEASE);
+  return sendRequest("brake release", "Brake releasing") &&
+         waitForRobotMode(RobotMode::RUNNING, std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandLoadProgram(const std::string& program_file_name)
 {
-  assertVersion("5.0.0", "1.4", "load <program>");
+  assertSupported(DashboardCommand::LOAD_PROGRAM);
   return sendRequest("load " + program_file_name + "", "(?:Loading program: ).*(?:" + program_file_name + ").*") &&
          waitForReply("programState", "STOPPED " + program_file_name);
 }
 
 bool DashboardClient::commandLoadInstallation(const std::string& installation_file_name)
 {
-  assertVersion("5.0.0", "3.2", "load installation");
+  assertSupported(DashboardCommand::LOAD_INSTALLATION);
   return sendRequest("load installation " + installation_file_name,
                      "(?:Loading installation: ).*(?:" + installation_file_name + ").*");
 }
 
 bool DashboardClient::commandPlay()
 {
-  assertVersion("5.0.0", "1.4", "play");
-  return sendRequest("play", "Starting program") && waitForReply("programState", "(?:PLAYING ).*");
+  assertSupported(DashboardCommand::PLAY);
+  return sendRequest("play", "Starting program") &&
+         waitForRuntimeState(RuntimeState::PLAYING, "(?:PLAYING ).*", std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandPause()
 {
-  assertVersion("5.0.0", "1.4", "pause");
-  return sendRequest("pause", "Pausing program") && waitForReply("programState", "(?:PAUSED ).*");
+  assertSupported(DashboardCommand::PAUSE);
+  return sendRequest("pause", "Pausing program") &&
+         waitForRuntimeState(RuntimeState::PAUSED, "(?:PAUSED ).*", std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandStop()
 {
-  assertVersion("5.0.0", "1.4", "stop");
-  return sendRequest("stop", "Stopped") && waitForReply("programState", "(?:STOPPED ).*");
+  assertSupported(DashboardCommand::STOP);
+  return sendRequest("stop", "Stopped") &&
+         waitForRuntimeState(RuntimeState::STOPPED, "(?:STOPPED ).*", std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandClosePopup()
 {
-  assertVersion("5.0.0", "1.6", "close popup");
+  assertSupported(DashboardCommand::CLOSE_POPUP);
   return sendRequest("close popup", "closing popup");
 }
 
 bool DashboardClient::commandCloseSafetyPopup()
 {
-  assertVersion("5.0.0", "3.1", "close safety popup");
+  assertSupported(DashboardCommand::CLOSE_SAFETY_POPUP);
   return sendRequest("close safety popup", "closing safety popup");
 }
 
 bool DashboardClient::commandRestartSafety()
 {
-  assertVersion("5.1.0", "3.7", "restart safety");
-  return sendRequest("restart safety", "Restarting safety") && waitForReply("robotmode", "Robotmode: POWER_OFF");
+  assertSupported(DashboardCommand::RESTART_SAFETY);
+  return sendRequest("restart safety", "Restarting safety") &&
+         waitForRobotMode(RobotMode::POWER_OFF, std::chrono::seconds(30));
 }
 
 bool DashboardClient::commandUnlockProtectiveStop()
 {
-  assertVersion("5.0.0", "3.1", "unlock protective stop");
+  assertSupported(DashboardCommand::UNLOCK_PROTECTIVE_STOP);
   return sendRequest("unlock protective stop", "Protective stop releasing");
 }
 
 bool DashboardClient::commandShutdown()
 {
-  assertVersion("5.0.0", "1.4", "shutdown");
+  assertSupported(DashboardCommand::SHUTDOWN);
   return sendRequest("shutdown", "Shutting down");
 }
 
 bool DashboardClient::commandQuit()
 {
-  assertVersion("5.0.0", "1.4", "quit");
+  assertSupported(DashboardCommand::QUIT);
   return sendRequest("quit", "Disconnected");
 }
 
 bool DashboardClient::commandRunning()
 {
-  assertVersion("5.0.0", "1.6", "running");
+  assertSupported(DashboardCommand::RUNNING);
   return sendRequest("running", "Program running: true");
 }
 
 bool DashboardClient::commandIsProgramSaved()
 {
-  assertVersion("5.0.0", "1.8", "isProgramSaved");
+  assertSupported(DashboardCommand::IS_PROGRAM_SAVED);
   return sendRequest("isProgramSaved", "(?:true ).*");
 }
 
 bool DashboardClient::commandIsInRemoteControl()
 {
-  assertVersion("5.6.0", "-", "is in remote control");
+  assertSupported(DashboardCommand::IS_IN_REMOTE_CONTROL);
   std::string response = sendAndReceive("is in remote control");
-  bool ret = std::regex_match(response, std::regex("true"));
+  bool ret = matches(response, "true");
   return ret;
 }
 
 bool DashboardClient::commandPopup(const std::string& popup_text)
 {
-  assertVersion("5.0.0", "1.6", "popup");
+  assertSupported(DashboardCommand::POPUP);
   return sendRequest("popup " + popup_text, "showing popup");
 }
 
 bool DashboardClient::commandAddToLog(const std::string& log_text)
 {
-  assertVersion("5.0.0", "1.8", "addToLog");
+  assertSupported(DashboardCommand::ADD_TO_LOG);
   return sendRequest("addToLog " + log_text, "Added log message");
 }
 
@@ -349,104 +491,118 @@ bool DashboardClient::commandPolyscopeVersion(std::string& polyscope_version)
   polyscope_version = sendRequestString("PolyscopeVersion", expected);
   std::string version_string = polyscope_version.substr(polyscope_version.find(" ") + 1,
                                                         polyscope_version.find(" (") - polyscope_version.find(" ") - 1);
-  polyscope_version_ = VersionInformation::fromString(version_string);
-  return std::regex_match(polyscope_version, std::regex(expected));
+  capabilities_ = VersionCapabilities(VersionInformation::fromString(version_string));
+  return matches(polyscope_version, expected);
 }
 
 bool DashboardClient::commandGetRobotModel(std::string& robot_model)
 {
-  assertVersion("5.6.0", "3.12", "get robot model");
+  assertSupported(DashboardCommand::GET_ROBOT_MODEL);
   std::string expected = "(?:UR).*";
   robot_model = sendRequestString("get robot model", expected);
-  return std::regex_match(robot_model, std::regex(expected));
+  return matches(robot_model, expected);
 }
 
 bool DashboardClient::commandGetSerialNumber(std::string& serial_number)
 {
-  assertVersion("5.6.0", "3.12", "get serial number");
+  assertSupported(DashboardCommand::GET_SERIAL_NUMBER);
   std::string expected = "(?:20).*";
   serial_number = sendRequestString("get serial number", expected);
-  return std::regex_match(serial_number, std::regex(expected));
+  return matches(serial_number, expected);
 }
 
 bool DashboardClient::commandRobotMode(std::string& robot_mode)
 {
-  assertVersion("5.0.0", "1.6", "robotmode");
+  assertSupported(DashboardCommand::ROBOT_MODE);
   std::string expected = "(?:Robotmode: ).*";
   robot_mode = sendRequestString("robotmode", expected);
-  return std::regex_match(robot_mode, std::regex(expected));
+  return matches(robot_mode, expected);
 }
 
 bool DashboardClient::commandGetLoadedProgram(std::string& loaded_program)
 {
-  assertVersion("5.0.0", "1.6", "get loaded program");
+  assertSupported(DashboardCommand::GET_LOADED_PROGRAM);
   std::string expected = "(?:Loaded program: ).*";
   loaded_program = sendRequestString("get loaded program", expected);
-  return std::regex_match(loaded_program, std::regex(expected));
+  return matches(loaded_program, expected);
 }
 
 bool DashboardClient::commandSafetyMode(std::string& safety_mode)
 {
-  assertVersion("5.0.0", "3.0", "safetymode");
+  assertSupported(DashboardCommand::SAFETY_MODE);
   std::string expected = "(?:Safetymode: ).*";
   safety_mode = sendRequestString("safetymode", expected);
-  return std::regex_match(safety_mode, std::regex(expected));
+  return matches(safety_mode, expected);
 }
 
 bool DashboardClient::commandSafetyStatus(std::string& safety_status)
 {
-  assertVersion("5.4.0", "3.11", "safetystatus");
+  assertSupported(DashboardCommand::SAFETY_STATUS);
   std::string expected = "(?:Safetystatus: ).*";
   safety_status = sendRequestString("safetystatus", expected);
-  return std::regex_match(safety_status, std::regex(expected));
+  return matches(safety_status, expected);
 }
 
 bool DashboardClient::commandProgramState(std::string& program_state)
 {
-  assertVersion("5.0.0", "1.8", "programState");
+  assertSupported(DashboardCommand::PROGRAM_STATE);
   std::string expected = "(?:).*";
   program_state = sendRequestString("programState", expected);
-  return !std::regex_match(program_state, std::regex("(?:could not understand).*"));
+  return !matches(program_state, "(?:could not understand).*");
+}
+
+bool DashboardClient::commandGetStatus(DashboardStatus& status)
+{
+  assertSupported(DashboardCommand::GET_STATUS);
+  std::vector<std::string> responses =
+      sendAndReceive({ "robotmode", "safetymode", "programState", "get loaded program" });
+  status.robot_mode = responses[0];
+  status.safety_mode = responses[1];
+  status.program_state = responses[2];
+  status.loaded_program = responses[3];
+  return matches(status.robot_mode, "(?:Robotmode: ).*") && matches(status.safety_mode, "(?:Safetymode: ).*") &&
+         !matches(status.program_state, "(?:could not understand).*") &&
+         matches(status.loaded_program, "(?:Loaded program: |No program loaded).*");
 }
 
 bool DashboardClient::commandGetOperationalMode(std::string& operational_mode)
 {
-  assertVersion("5.6.0", "-", "get operational mode");
+  assertSupported(DashboardCommand::GET_OPERATIONAL_MODE);
   std::string expected = "(?:).*";
   operational_mode = sendRequestString("get operational mode", expected);
-  return !std::regex_match(operational_mode, std::regex("(?:could not understand).*"));
+  return !matches(operational_mode, "(?:could not understand).*");
 }
 
 bool DashboardClient::commandSetOperationalMode(const std::string& operational_mode)
 {
-  assertVersion("5.0.0", "-", "set operational mode");
+  assertSupported(DashboardCommand::SET_OPERATIONAL_MODE);
   return sendRequest("set operational mode " + operational_mode,
                      "(?:Operational mode ).*(?:" + operational_mode + ").*");
 }
 
 bool DashboardClient::commandClearOperationalMode()
 {
-  assertVersion("5.0.0", "-", "clear operational mode");
+  assertSupported(DashboardCommand::CLEAR_OPERATIONAL_MODE);
   return sendRequest("clear operational mode", "(?:No longer controlling the operational mode. ).*");
 }
 
 bool DashboardClient::commandSetUserRole(const std::string& user_role)
 {
-  assertVersion("-", "1.8", "setUserRole");
+  assertSupported(DashboardCommand::SET_USER_ROLE);
   return sendRequest("setUserRole " + user_role, "(?:Setting user role: ).*");
 }
 
 bool DashboardClient::commandGetUserRole(std::string& user_role)
 {
-  assertVersion("-", "1.8", "getUserRole");
+  assertSupported(DashboardCommand::GET_USER_ROLE);
   std::string expected = "(?:).*";
   user_role = sendRequestString("getUserRole", expected);
-  return !std::regex_match(user_role, std::regex("(?:could not understand).*"));
+  return !matches(user_role, "(?:could not understand).*");
 }
 
 bool DashboardClient::commandGenerateFlightReport(const std::string& report_type)
 {
-  assertVersion("5.8.0", "3.13", "generate flight report");
+  assertSupported(DashboardCommand::GENERATE_FLIGHT_REPORT);
   timeval configured_tv = getConfiguredReceiveTimeout();
   timeval tv;
   tv.tv_sec = 180;
@@ -459,7 +615,7 @@ bool DashboardClient::commandGenerateFlightReport(const std::string& report_type
 
 bool DashboardClient::commandGenerateSupportFile(const std::string& dir_path)
 {
-  assertVersion("5.8.0", "3.13", "generate support file");
+  assertSupported(DashboardCommand::GENERATE_SUPPORT_FILE);
   timeval configured_tv = getConfiguredReceiveTimeout();
   timeval tv;
   tv.tv_sec = 600;
@@ -472,39 +628,40 @@ bool DashboardClient::commandGenerateSupportFile(const std::string& dir_path)
 
 bool DashboardClient::commandSaveLog()
 {
-  assertVersion("5.0.0", "1.8", "save log");
+  assertSupported(DashboardCommand::SAVE_LOG);
   return sendRequest("saveLog", "Log saved to disk");
 }
 
-void DashboardClient::assertVersion(const std::string& e_series_min_ver, const std::string& cb3_min_ver,
-                                    const std::string& required_call)
+void DashboardClient::assertSupported(const DashboardCommand command) const
 {
-  if (!polyscope_version_.isESeries() && cb3_min_ver == "-")
+  if (capabilities_.supports(command))
   {
-    std::stringstream ss;
-    ss << "The dasboard call '" << required_call
-       << "' is only available on e-series robots, but you seem to be running version " << polyscope_version_;
-    throw UrException(ss.str());
+    return;
   }
 
-  if (polyscope_version_.isESeries() && e_series_min_ver == "-")
+  const VersionInformation& polyscope_version = capabilities_.getVersion();
+  VersionInformation minimum_version;
+  if (!VersionCapabilities::getMinimumVersion(command, polyscope_version.isESeries(), minimum_version))
   {
     std::stringstream ss;
-    ss << "The dasboard call '" << required_call
-       << "' is only available on pre-e-series robots (5.x.y), but you seem to be running version "
-       << polyscope_version_;
+    if (polyscope_version.isESeries())
+    {
+      ss << "The dasboard call '" << VersionCapabilities::getName(command)
+         << "' is only available on pre-e-series robots (5.x.y), but you seem to be running version "
+         << polyscope_version;
+    }
+    else
+    {
+      ss << "The dasboard call '" << VersionCapabilities::getName(command)
+         << "' is only available on e-series robots, but you seem to be running version " << polyscope_version;
+    }
     throw UrException(ss.str());
   }
 
-  auto ref = polyscope_version_.isESeries() ? VersionInformation::fromString(e_series_min_ver) :
-                                              VersionInformation::fromString(cb3_min_ver);
-  if (ref > polyscope_version_)
-  {
-    std::stringstream ss;
-    ss << "Polyscope version " << polyscope_version_ << " isn't recent enough to use dashboard call '" << required_call
-       << "'";
-    throw UrException(ss.str());
-  }
+  std::stringstream ss;
+  ss << "Polyscope version " << polyscope_version << " isn't recent enough to use dashboard call '"
+     << VersionCapabilities::getName(command) << "'";
+  throw UrException(ss.str());
 }
 
 timeval DashboardClient::getConfiguredReceiveTimeout() const
@@ -0,0 +1,366 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/dashboard_poller.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace
+{
+// All queries of a poll are sent at once, the server answers each of them with a single line.
+constexpr char POLL_QUERIES[] = "robotmode\nsafetystatus\nget operational mode\n";
+constexpr size_t NUM_QUERIES = 3;
+
+std::string takeLine(std::string& buffer)
+{
+  const size_t line_end = buffer.find('\n');
+  std::string line = buffer.substr(0, line_end);
+  buffer.erase(0, line_end + 1);
+  line.erase(line.find_last_not_of("\t\n\v\f\r ") + 1);
+  return line;
+}
+
+// Returns the part of the answer following the prefix, or false if the answer has another prefix
+bool stripPrefix(const std::string& answer, const std::string& prefix, std::string& value)
+{
+  if (answer.compare(0, prefix.size(), prefix) != 0)
+  {
+    return false;
+  }
+  value = answer.substr(prefix.size());
+  return true;
+}
+
+std::optional<RobotMode> parseRobotMode(const std::string& answer)
+{
+  std::string name;
+  if (stripPrefix(answer, "Robotmode: ", name))
+  {
+    for (int mode = static_cast<int>(RobotMode::NO_CONTROLLER); mode <= static_cast<int>(RobotMode::UPDATING_FIRMWARE);
+         ++mode)
+    {
+      if (robotModeString(static_cast<RobotMode>(mode)) == name)
+      {
+        return static_cast<RobotMode>(mode);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<SafetyStatus> parseSafetyStatus(const std::string& answer)
+{
+  std::string name;
+  if (stripPrefix(answer, "Safetystatus: ", name))
+  {
+    for (int status = static_cast<int>(SafetyStatus::NORMAL);
+         status <= static_cast<int>(SafetyStatus::SYSTEM_THREE_POSITION_ENABLING_STOP); ++status)
+    {
+      if (safetyStatusString(static_cast<SafetyStatus>(status)) == name)
+      {
+        return static_cast<SafetyStatus>(status);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<OperationalMode> parseOperationalMode(const std::string& answer)
+{
+  if (answer == "NONE")
+  {
+    return OperationalMode::NONE;
+  }
+  if (answer == "MANUAL")
+  {
+    return OperationalMode::MANUAL;
+  }
+  if (answer == "AUTOMATIC")
+  {
+    return OperationalMode::AUTOMATIC;
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+DashboardPoller::DashboardPoller(std::shared_ptr<comm::Reactor> reactor, const std::chrono::milliseconds period,
+                                 const std::chrono::milliseconds timeout)
+  : reactor_(reactor != nullptr ? reactor : std::make_shared<comm::Reactor>(1))
+  , loop_(reactor_->assignLoop())
+  , period_(period)
+  , timeout_(timeout)
+  , next_id_(0)
+{
+}
+
+DashboardPoller::~DashboardPoller()
+{
+  reactor_->synchronize(loop_, [this]() {
+    for (auto& robot : robots_)
+    {
+      disconnect(*robot.second);
+      reactor_->remove(loop_, robot.second->timer_fd);
+      ::close(robot.second->timer_fd);
+    }
+    robots_.clear();
+  });
+}
+
+size_t DashboardPoller::addRobot(const std::string& host, ResultCallback callback, const int port)
+{
+  std::unique_ptr<Robot> robot = std::make_unique<Robot>();
+  robot->host = host;
+  robot->callback = callback;
+
+  // Resolve the address once, so the event loop never blocks on name resolution
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result;
+  if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0)
+  {
+    throw UrException("Failed to get address of dashboard server " + host + ":" + std::to_string(port));
+  }
+  std::memcpy(&robot->address, result->ai_addr, result->ai_addrlen);
+  robot->address_length = result->ai_addrlen;
+  freeaddrinfo(result);
+
+  robot->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (robot->timer_fd == -1)
+  {
+    throw UrException("Failed to create the poll timer for dashboard server " + host + ". " + strerror(errno));
+  }
+
+  size_t id;
+  reactor_->synchronize(loop_, [&]() {
+    Robot& r = *robot;
+    if (!reactor_->add(loop_, r.timer_fd, [this, &r]() { onTimer(r); }))
+    {
+      ::close(r.timer_fd);
+      throw UrException("Failed to register the poll timer for dashboard server " + r.host);
+    }
+    id = next_id_++;
+    robots_[id] = std::move(robot);
+    // Connect on the event loop, so callbacks are only ever called from there
+    setTimer(r, std::chrono::milliseconds(0));
+  });
+  return id;
+}
+
+void DashboardPoller::removeRobot(const size_t id)
+{
+  reactor_->synchronize(loop_, [this, id]() {
+    auto it = robots_.find(id);
+    if (it == robots_.end())
+    {
+      return;
+    }
+    disconnect(*it->second);
+    reactor_->remove(loop_, it->second->timer_fd);
+    ::close(it->second->timer_fd);
+    robots_.erase(it);
+  });
+}
+
+void DashboardPoller::connect(Robot& robot)
+{
+  robot.socket_fd = ::socket(robot.address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (robot.socket_fd == -1)
+  {
+    fail(robot, "Failed to create socket");
+    return;
+  }
+  int flag = 1;
+  setsockopt(robot.socket_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+  // The connection is complete once the server's welcome message arrives. A failed connection
+  // attempt makes the socket readable as well.
+  if (::connect(robot.socket_fd, reinterpret_cast<const sockaddr*>(&robot.address), robot.address_length) != 0 &&
+      errno != EINPROGRESS)
+  {
+    fail(robot, "Failed to connect");
+    return;
+  }
+  if (!reactor_->add(loop_, robot.socket_fd, [this, &robot]() { onReadable(robot); }))
+  {
+    fail(robot, "Failed to register socket");
+    return;
+  }
+  robot.state = RobotState::CONNECTING;
+  robot.read_buffer.clear();
+  setTimer(robot, timeout_);
+}
+
+void DashboardPoller::disconnect(Robot& robot)
+{
+  if (robot.socket_fd != -1)
+  {
+    reactor_->remove(loop_, robot.socket_fd);
+    ::close(robot.socket_fd);
+    robot.socket_fd = -1;
+  }
+}
+
+void DashboardPoller::poll(Robot& robot)
+{
+  const ssize_t sent = ::send(robot.socket_fd, POLL_QUERIES, sizeof(POLL_QUERIES) - 1, MSG_NOSIGNAL);
+  if (sent != static_cast<ssize_t>(sizeof(POLL_QUERIES) - 1))
+  {
+    fail(robot, "Failed to send queries");
+    return;
+  }
+  robot.state = RobotState::POLLING;
+  robot.poll_start = std::chrono::steady_clock::now();
+  setTimer(robot, timeout_);
+}
+
+void DashboardPoller::fail(Robot& robot, const char* reason)
+{
+  if (robot.state == RobotState::IDLE || robot.state == RobotState::POLLING)
+  {
+    URCL_LOG_WARN("Lost connection to dashboard server %s: %s", robot.host.c_str(), reason);
+  }
+  else
+  {
+    URCL_LOG_DEBUG("Could not connect to dashboard server %s: %s", robot.host.c_str(), reason);
+  }
+  disconnect(robot);
+  robot.state = RobotState::DISCONNECTED;
+  setTimer(robot, period_);
+
+  // The callback may remove the robot, so it is called last and not from inside the robot
+  ResultCallback callback = robot.callback;
+  callback(DashboardPollResult());
+}
+
+void DashboardPoller::onTimer(Robot& robot)
+{
+  uint64_t expirations;
+  if (::read(robot.timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+  {
+    return;
+  }
+  switch (robot.state)
+  {
+    case RobotState::DISCONNECTED:
+      connect(robot);
+      break;
+    case RobotState::CONNECTING:
+      fail(robot, "Timeout while connecting");
+      break;
+    case RobotState::IDLE:
+      poll(robot);
+      break;
+    case RobotState::POLLING:
+      fail(robot, "Timeout while waiting for answers");
+      break;
+  }
+}
+
+void DashboardPoller::onReadable(Robot& robot)
+{
+  char chunk[1024];
+  while (true)
+  {
+    const ssize_t received = ::recv(robot.socket_fd, chunk, sizeof(chunk), 0);
+    if (received > 0)
+    {
+      robot.read_buffer.append(chunk, static_cast<size_t>(received));
+      continue;
+    }
+    if (received == 0)
+    {
+      fail(robot, "Connection closed by the server");
+      return;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+      break;
+    }
+    fail(robot, strerror(errno));
+    return;
+  }
+
+  if (robot.state == RobotState::CONNECTING && robot.read_buffer.find('\n') != std::string::npos)
+  {
+    takeLine(robot.read_buffer);
+    robot.state = RobotState::IDLE;
+    poll(robot);
+  }
+  else if (robot.state == RobotState::POLLING &&
+           static_cast<size_t>(std::count(robot.read_buffer.begin(), robot.read_buffer.end(), '\n')) >= NUM_QUERIES)
+  {
+    handleAnswers(robot);
+  }
+}
+
+void DashboardPoller::handleAnswers(Robot& robot)
+{
+  DashboardPollResult result;
+  result.connected = true;
+  result.round_trip_time = std::chrono::steady_clock::now() - robot.poll_start;
+  result.robot_mode = parseRobotMode(takeLine(robot.read_buffer));
+  result.safety_status = parseSafetyStatus(takeLine(robot.read_buffer));
+  result.operational_mode = parseOperationalMode(takeLine(robot.read_buffer));
+
+  // Keep polling at a fixed rate
+  robot.state = RobotState::IDLE;
+  setTimer(robot, std::chrono::duration_cast<std::chrono::milliseconds>(period_ - result.round_trip_time));
+
+  ResultCallback callback = robot.callback;
+  callback(result);
+}
+
+void DashboardPoller::setTimer(Robot& robot, const std::chrono::milliseconds delay)
+{
+  itimerspec spec{};
+  // A zero value would disarm the timer
+  const std::chrono::milliseconds value = std::max(delay, std::chrono::milliseconds(1));
+  spec.it_value.tv_sec = value.count() / 1000;
+  spec.it_value.tv_nsec = (value.count() % 1000) * 1000000;
+  if (timerfd_settime(robot.timer_fd, 0, &spec, nullptr) == -1)
+  {
+    URCL_LOG_ERROR("Failed to set the poll timer for dashboard server %s. %s", robot.host.c_str(), strerror(errno));
+  }
+}
+}  // namespace urcl
@@ -0,0 +1,255 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/event_stream.h"
+
+namespace urcl
+{
+namespace
+{
+class RobotMessageForwarder : public comm::IConsumer<primary_interface::PrimaryPackage>
+{
+public:
+  explicit RobotMessageForwarder(EventStream& stream) : stream_(stream)
+  {
+  }
+
+  bool consume(std::shared_ptr<primary_interface::PrimaryPackage> product) override
+  {
+    auto message = std::dynamic_pointer_cast<primary_interface::RobotMessage>(product);
+    if (message != nullptr)
+    {
+      stream_.pushRobotMessage(message);
+    }
+    return true;
+  }
+
+private:
+  EventStream& stream_;
+};
+
+std::chrono::steady_clock::time_point receiveTime(const comm::PackageTimestamps& timestamps)
+{
+  return timestamps.receive == std::chrono::steady_clock::time_point() ? std::chrono::steady_clock::now() :
+                                                                         timestamps.receive;
+}
+}  // namespace
+
+EventStream::EventStream(EventCallback callback, std::shared_ptr<rtde_interface::ClockSynchronizer> clock,
+                         const std::chrono::milliseconds reorder_window, const size_t queue_capacity)
+  : callback_(callback)
+  , clock_(clock)
+  , reorder_window_(reorder_window)
+  , free_packages_(queue_capacity)
+  , latest_robot_time_(0.0)
+  , running_(true)
+{
+  for (auto& source : sources_)
+  {
+    source.reset(new Source(queue_capacity));
+  }
+  thread_ = std::thread(&EventStream::run, this);
+}
+
+EventStream::~EventStream()
+{
+  running_ = false;
+  pending_.signal();
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+}
+
+bool EventStream::pushDataPackage(const rtde_interface::DataPackage& package)
+{
+  QueuedEvent queued;
+  queued.event.source = EventSource::DATA_PACKAGE;
+  queued.event.receive_time = receiveTime(package.getTimestamps());
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe = package.getCompiledRecipe();
+  if (recipe != timestamp_recipe_)
+  {
+    timestamp_recipe_ = recipe;
+    size_t index;
+    timestamp_handle_ = recipe != nullptr && recipe->findIndex("timestamp", index) ?
+                            recipe->getFieldHandle<double>("timestamp") :
+                            rtde_interface::FieldHandle<double>();
+  }
+  double robot_time;
+  if (timestamp_handle_.isValid() && package.getData(timestamp_handle_, robot_time))
+  {
+    latest_robot_time_.store(robot_time, std::memory_order_relaxed);
+    queued.event.robot_time = robot_time;
+  }
+  else
+  {
+    queued.event.robot_time = mapToRobotTime(queued.event.receive_time);
+  }
+
+  // Copies of the same recipe are reused, so their memory is reused as well
+  while (free_packages_.tryDequeue(queued.package))
+  {
+    if (queued.package->getCompiledRecipe() == recipe)
+    {
+      break;
+    }
+    queued.package.reset();
+  }
+  if (queued.package == nullptr)
+  {
+    queued.package.reset(new rtde_interface::DataPackage(package));
+  }
+  else
+  {
+    *queued.package = package;
+  }
+  queued.event.data_package = queued.package.get();
+  return push(EventSource::DATA_PACKAGE, std::move(queued));
+}
+
+bool EventStream::pushRobotMessage(std::shared_ptr<primary_interface::RobotMessage> message)
+{
+  QueuedEvent queued;
+  queued.event.source = EventSource::ROBOT_MESSAGE;
+  queued.event.receive_time = receiveTime(message->getTimestamps());
+  queued.event.robot_time = mapToRobotTime(queued.event.receive_time);
+  queued.event.robot_message = message;
+  return push(EventSource::ROBOT_MESSAGE, std::move(queued));
+}
+
+bool EventStream::pushTrajectoryResult(const control::TrajectoryResult result)
+{
+  QueuedEvent queued;
+  queued.event.source = EventSource::TRAJECTORY_RESULT;
+  queued.event.receive_time = std::chrono::steady_clock::now();
+  queued.event.robot_time = mapToRobotTime(queued.event.receive_time);
+  queued.event.trajectory_result = result;
+  return push(EventSource::TRAJECTORY_RESULT, std::move(queued));
+}
+
+bool EventStream::pushToolContactResult(const control::ToolContactResult result)
+{
+  QueuedEvent queued;
+  queued.event.source = EventSource::TOOL_CONTACT_RESULT;
+  queued.event.receive_time = std::chrono::steady_clock::now();
+  queued.event.robot_time = mapToRobotTime(queued.event.receive_time);
+  queued.event.tool_contact_result = result;
+  return push(EventSource::TOOL_CONTACT_RESULT, std::move(queued));
+}
+
+std::shared_ptr<comm::IConsumer<primary_interface::PrimaryPackage>> EventStream::createPrimaryConsumer()
+{
+  return std::make_shared<RobotMessageForwarder>(*this);
+}
+
+bool EventStream::push(const EventSource source, QueuedEvent&& queued)
+{
+  Source& target = *sources_[static_cast<size_t>(source)];
+  if (!target.queue.tryEnqueue(std::move(queued)))
+  {
+    target.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  pending_.signal();
+  return true;
+}
+
+double EventStream::mapToRobotTime(const std::chrono::steady_clock::time_point receive_time) const
+{
+  if (clock_ != nullptr && clock_->isSynchronized())
+  {
+    return clock_->toRobotTime(receive_time);
+  }
+  return latest_robot_time_.load(std::memory_order_relaxed);
+}
+
+void EventStream::run()
+{
+  std::chrono::steady_clock::duration wait_time = reorder_window_;
+  while (running_)
+  {
+    if (deliverNext(wait_time))
+    {
+      continue;
+    }
+    // Woken up by the next push or once the oldest event may be delivered
+    pending_.wait(std::chrono::duration_cast<std::chrono::microseconds>(wait_time).count());
+  }
+}
+
+bool EventStream::deliverNext(std::chrono::steady_clock::duration& wait_time)
+{
+  Source* oldest = nullptr;
+  bool all_queued = true;
+  for (auto& source : sources_)
+  {
+    if (!source->has_head)
+    {
+      source->has_head = source->queue.tryDequeue(source->head);
+    }
+    if (!source->has_head)
+    {
+      all_queued = false;
+      continue;
+    }
+    // Ties are broken by receive time, so events stamped with the latest package's time follow it
+    if (oldest == nullptr || source->head.event.robot_time < oldest->head.event.robot_time ||
+        (source->head.event.robot_time == oldest->head.event.robot_time &&
+         source->head.event.receive_time < oldest->head.event.receive_time))
+    {
+      oldest = source.get();
+    }
+  }
+  if (oldest == nullptr)
+  {
+    wait_time = reorder_window_;
+    return false;
+  }
+
+  const auto deadline = oldest->head.event.receive_time + reorder_window_;
+  const auto now = std::chrono::steady_clock::now();
+  if (!all_queued && now < deadline)
+  {
+    wait_time = deadline - now;
+    return false;
+  }
+
+  callback_(oldest->head.event);
+  if (oldest->head.package != nullptr && !free_packages_.tryEnqueue(std::move(oldest->head.package)))
+  {
+    oldest->head.package.reset();
+  }
+  oldest->head = QueuedEvent();
+  oldest->has_head = false;
+  return true;
+}
+
+}  // namespace urcl
@@ -30,11 +30,20 @@
 
 #include "ur_client_library/ur/instruction_executor.h"
 #include "ur_client_library/control/trajectory_point_interface.h"
+
+#include <type_traits>
+urcl::InstructionExecutor::~InstructionExecutor()
+{
+  std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+  if (trajectory_running_)
+  {
+    driver_->setAutomaticKeepalive(keepalive_enabled_before_);
+  }
+}
 void urcl::InstructionExecutor::trajDoneCallback(const urcl::control::TrajectoryResult& result)
 {
   std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
-  trajectory_result_ = result;
-  trajectory_running_ = false;
+  finishTrajectory(result);
 }
 void urcl::InstructionExecutor::trajDisconnectCallback(const int filedescriptor)
 {
@@ -42,71 +51,553 @@ void urcl::InstructionExecutor::trajDisconnectCallback(const int filedescriptor)
   std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
   if (trajectory_running_)
   {
-    trajectory_result_ = urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE;
+    finishTrajectory(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+  }
+}
+void urcl::InstructionExecutor::finishTrajectory(const urcl::control::TrajectoryResult result)
+{
+  trajectory_result_ = result;
+  if (trajectory_running_)
+  {
     trajectory_running_ = false;
+    queueing_ = false;
+    URCL_LOG_INFO("Trajectory done with result %s", control::trajectoryResultToString(result).c_str());
+    trajectory_promise_.setValue(result);
+    driver_->setAutomaticKeepalive(keepalive_enabled_before_);
   }
 }
-bool urcl::InstructionExecutor::executeMotion(
-    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence)
+void urcl::InstructionExecutor::enableKeepalive()
 {
-  if (!driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_START,
-                                              motion_sequence.size()))
+  std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+  // The trajectory might have finished already
+  if (trajectory_running_)
   {
-    URCL_LOG_ERROR("Cannot send trajectory control command. No client connected?");
-    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
-    trajectory_result_ = urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE;
+    driver_->setAutomaticKeepalive(true);
+  }
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult> urcl::InstructionExecutor::failedTrajectory()
+{
+  comm::NotifyingPromise<control::TrajectoryResult> failure;
+  failure.setValue(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+  return failure.getFuture();
+}
+bool urcl::InstructionExecutor::beginTrajectory(comm::NotifyingFuture<control::TrajectoryResult>& result)
+{
+  std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+  if (trajectory_running_)
+  {
+    URCL_LOG_ERROR("Cannot execute a motion sequence while another one is running.");
+    result = failedTrajectory();
+    return false;
+  }
+  // Mark the trajectory as running before starting it, so an early result isn't missed
+  trajectory_promise_ = comm::NotifyingPromise<control::TrajectoryResult>();
+  result = trajectory_promise_.getFuture();
+  trajectory_running_ = true;
+  keepalive_enabled_before_ = driver_->isAutomaticKeepaliveEnabled();
+  return true;
+}
+namespace
+{
+urcl::control::TrajectoryPoint toTrajectoryPoint(const urcl::control::MotionPrimitive& primitive)
+{
+  urcl::control::TrajectoryPoint point;
+  point.acceleration = primitive.acceleration;
+  point.velocity = primitive.velocity;
+  point.goal_time = primitive.duration.count();
+  point.blend_radius = primitive.blend_radius;
+  return point;
+}
+urcl::vector6d_t toVector(const urcl::Pose& pose)
+{
+  return { pose.x, pose.y, pose.z, pose.rx, pose.ry, pose.rz };
+}
+std::optional<urcl::control::MotionPrimitiveValue>
+toMotionPrimitiveValue(const urcl::control::MotionPrimitive& primitive)
+{
+  switch (primitive.type)
+  {
+    case urcl::control::MotionType::MOVEJ:
+      return static_cast<const urcl::control::MoveJPrimitive&>(primitive);
+    case urcl::control::MotionType::MOVEL:
+      return static_cast<const urcl::control::MoveLPrimitive&>(primitive);
+    case urcl::control::MotionType::MOVEP:
+      return static_cast<const urcl::control::MovePPrimitive&>(primitive);
+    case urcl::control::MotionType::MOVEC:
+      return static_cast<const urcl::control::MoveCPrimitive&>(primitive);
+    case urcl::control::MotionType::SPLINE:
+      return static_cast<const urcl::control::SplinePrimitive&>(primitive);
+    default:
+      return std::nullopt;
+  }
+}
+// Converts a whole motion sequence, returns false if it holds a primitive of unknown type
+bool toMotionPrimitiveValues(const std::vector<std::shared_ptr<urcl::control::MotionPrimitive>>& motion_sequence,
+                             std::vector<urcl::control::MotionPrimitiveValue>& values)
+{
+  values.reserve(motion_sequence.size());
+  for (const auto& primitive : motion_sequence)
+  {
+    const auto value = toMotionPrimitiveValue(*primitive);
+    if (!value)
+    {
+      return false;
+    }
+    values.push_back(*value);
+  }
+  return true;
+}
+}  // namespace
+bool urcl::InstructionExecutor::acceptValidation(const control::TrajectoryValidationResult& result)
+{
+  if (!result)
+  {
+    URCL_LOG_ERROR("Rejecting motion sequence, motion %zu violates %s.", result.index,
+                   control::trajectoryViolationToString(result.violation).c_str());
     return false;
   }
+  return true;
+}
+bool urcl::InstructionExecutor::validateMotions(
+    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence) const
+{
+  return trajectory_validator_ == nullptr || acceptValidation(trajectory_validator_->validate(motion_sequence));
+}
+bool urcl::InstructionExecutor::validateMotions(const control::MotionPrimitiveValue* motion_sequence,
+                                                const size_t num_primitives) const
+{
+  return trajectory_validator_ == nullptr ||
+         acceptValidation(trajectory_validator_->validate(motion_sequence, num_primitives));
+}
+bool urcl::InstructionExecutor::addMotion(const control::MotionPrimitiveValue& primitive, MotionBuffer& buffer)
+{
+  // Consecutive primitives of the same kind are written at once, the order is kept by writing
+  // the buffered primitives before a primitive of another kind.
+  bool success = true;
+  if (const auto* movec = std::get_if<control::MoveCPrimitive>(&primitive))
+  {
+    if (!buffer.points.empty() || !buffer.spline_points.empty())
+    {
+      success = flushMotions(buffer);
+    }
+    control::TrajectoryCircularPoint point;
+    point.via_pose = toVector(movec->via_point_pose);
+    point.target_pose = toVector(movec->target_pose);
+    point.acceleration = movec->acceleration;
+    point.velocity = movec->velocity;
+    point.blend_radius = movec->blend_radius;
+    point.mode = movec->mode;
+    buffer.circular_points.push_back(point);
+    return success;
+  }
+  if (const auto* spline = std::get_if<control::SplinePrimitive>(&primitive))
+  {
+    if (!buffer.points.empty() || !buffer.circular_points.empty())
+    {
+      success = flushMotions(buffer);
+    }
+    control::TrajectorySplinePoint point;
+    point.positions = spline->target_positions;
+    point.velocities = spline->target_velocities;
+    point.accelerations = spline->target_accelerations;
+    point.goal_time = spline->duration.count();
+    buffer.spline_points.push_back(point);
+    return success;
+  }
 
+  if (!buffer.circular_points.empty() || !buffer.spline_points.empty())
+  {
+    success = flushMotions(buffer);
+  }
+  if (const auto* movej = std::get_if<control::MoveJPrimitive>(&primitive))
+  {
+    control::TrajectoryPoint point = toTrajectoryPoint(*movej);
+    point.positions = movej->target_joint_configuration;
+    buffer.points.push_back(point);
+  }
+  else if (const auto* movel = std::get_if<control::MoveLPrimitive>(&primitive))
+  {
+    control::TrajectoryPoint point = toTrajectoryPoint(*movel);
+    point.positions = toVector(movel->target_pose);
+    point.cartesian = true;
+    buffer.points.push_back(point);
+  }
+  else if (const auto* movep = std::get_if<control::MovePPrimitive>(&primitive))
+  {
+    control::TrajectoryPoint point = toTrajectoryPoint(*movep);
+    point.positions = toVector(movep->target_pose);
+    point.cartesian = true;
+    point.process = true;
+    buffer.points.push_back(point);
+  }
+  return success;
+}
+bool urcl::InstructionExecutor::flushMotions(MotionBuffer& buffer)
+{
+  bool success = true;
+  if (!buffer.points.empty())
+  {
+    success = driver_->writeTrajectoryPoints(buffer.points);
+    buffer.points.clear();
+  }
+  else if (!buffer.circular_points.empty())
+  {
+    success = driver_->writeTrajectoryCircularPoints(buffer.circular_points);
+    buffer.circular_points.clear();
+  }
+  else if (!buffer.spline_points.empty())
+  {
+    success = driver_->writeTrajectorySplinePoints(buffer.spline_points);
+    buffer.spline_points.clear();
+  }
+  return success;
+}
+bool urcl::InstructionExecutor::writeMotions(
+    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence, MotionBuffer& buffer)
+{
+  bool success = true;
   for (const auto& primitive : motion_sequence)
   {
-    switch (primitive->type)
+    const auto value = toMotionPrimitiveValue(*primitive);
+    if (!value)
     {
-      case control::MotionType::MOVEJ:
-      {
-        auto movej_primitive = std::static_pointer_cast<control::MoveJPrimitive>(primitive);
-        driver_->writeTrajectoryPoint(movej_primitive->target_joint_configuration, primitive->acceleration,
-                                      primitive->velocity, false, primitive->duration.count(), primitive->blend_radius);
-        break;
-      }
-      case control::MotionType::MOVEL:
-      {
-        auto movel_primitive = std::static_pointer_cast<control::MoveLPrimitive>(primitive);
-        urcl::vector6d_t pose_vec = { movel_primitive->target_pose.x,  movel_primitive->target_pose.y,
-                                      movel_primitive->target_pose.z,  movel_primitive->target_pose.rx,
-                                      movel_primitive->target_pose.ry, movel_primitive->target_pose.rz };
-        driver_->writeTrajectoryPoint(pose_vec, primitive->acceleration, primitive->velocity, true,
-                                      primitive->duration.count(), primitive->blend_radius);
-        break;
-      }
-      default:
-        URCL_LOG_ERROR("Unsupported motion type");
-        // The hardware will complain about missing trajectory points and return a failure for
-        // trajectory execution. Hence, we need to step into the running loop below.
+      URCL_LOG_ERROR("Unsupported motion type");
+      // The hardware will complain about missing trajectory points and return a failure for
+      // trajectory execution, which completes the returned future.
+      continue;
     }
+    success = addMotion(*value, buffer) && success;
+  }
+  return flushMotions(buffer) && success;
+}
+bool urcl::InstructionExecutor::writeMotions(const control::MotionPrimitiveValue* motion_sequence,
+                                             const size_t num_primitives, MotionBuffer& buffer)
+{
+  bool success = true;
+  for (size_t i = 0; i < num_primitives; ++i)
+  {
+    success = addMotion(motion_sequence[i], buffer) && success;
+  }
+  return flushMotions(buffer) && success;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult> urcl::InstructionExecutor::executeMotionAsync(
+    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence)
+{
+  std::vector<control::MotionPrimitiveValue> values;
+  if (trajectory_reducer_ != nullptr && toMotionPrimitiveValues(motion_sequence, values))
+  {
+    return executeMotionAsync(values.data(), values.size());
+  }
+  if (!validateMotions(motion_sequence))
+  {
+    return failedTrajectory();
+  }
+  comm::NotifyingFuture<control::TrajectoryResult> result;
+  if (!beginTrajectory(result) || !startTrajectory(motion_sequence.size()))
+  {
+    return result;
+  }
+  // The buffer is only used by the one trajectory running
+  writeMotions(motion_sequence, motion_buffer_);
+  return result;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::executeMotionAsync(const std::vector<control::MotionPrimitiveValue>& motion_sequence)
+{
+  return executeMotionAsync(motion_sequence.data(), motion_sequence.size());
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::executeMotionAsync(const control::MotionPrimitiveValue* motion_sequence,
+                                              const size_t num_primitives)
+{
+  if (trajectory_reducer_ != nullptr)
+  {
+    std::vector<control::MotionPrimitiveValue> reduced;
+    trajectory_reducer_->reduce(motion_sequence, num_primitives, reduced);
+    return executeReducedMotionAsync(reduced.data(), reduced.size());
+  }
+  return executeReducedMotionAsync(motion_sequence, num_primitives);
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::executeReducedMotionAsync(const control::MotionPrimitiveValue* motion_sequence,
+                                                     const size_t num_primitives)
+{
+  if (!validateMotions(motion_sequence, num_primitives))
+  {
+    return failedTrajectory();
+  }
+  comm::NotifyingFuture<control::TrajectoryResult> result;
+  if (!beginTrajectory(result) || !startTrajectory(num_primitives))
+  {
+    return result;
+  }
+  writeMotions(motion_sequence, num_primitives, motion_buffer_);
+  return result;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::executeCachedMotionAsync(const int32_t trajectory_id,
+                                                    const std::vector<control::MotionPrimitiveValue>& motion_sequence)
+{
+  return executeCachedMotionAsync(trajectory_id, motion_sequence.data(), motion_sequence.size());
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::executeCachedMotionAsync(const int32_t trajectory_id,
+                                                    const control::MotionPrimitiveValue* motion_sequence,
+                                                    const size_t num_primitives)
+{
+  comm::NotifyingFuture<control::TrajectoryResult> result;
+  if (!beginTrajectory(result))
+  {
+    return result;
+  }
+  // The robot's program must not time out while waiting for the answer
+  enableKeepalive();
+  const control::TrajectoryReplayResult replay = driver_->replayTrajectory(trajectory_id);
+  if (replay == control::TrajectoryReplayResult::STARTED)
+  {
+    URCL_LOG_DEBUG("Replaying cached trajectory %d", trajectory_id);
+    return result;
+  }
+  if (replay == control::TrajectoryReplayResult::NO_ANSWER)
+  {
+    URCL_LOG_ERROR("The robot didn't answer the request for replaying trajectory %d.", trajectory_id);
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    finishTrajectory(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+    return result;
   }
-  trajectory_running_ = true;
 
-  while (trajectory_running_)
+  URCL_LOG_DEBUG("Trajectory %d isn't cached, uploading it", trajectory_id);
+  std::vector<control::MotionPrimitiveValue> reduced;
+  if (trajectory_reducer_ != nullptr)
+  {
+    trajectory_reducer_->reduce(motion_sequence, num_primitives, reduced);
+    motion_sequence = reduced.data();
+  }
+  const size_t num_uploaded = trajectory_reducer_ != nullptr ? reduced.size() : num_primitives;
+  if (!validateMotions(motion_sequence, num_uploaded))
+  {
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    finishTrajectory(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+    return result;
+  }
+  if (startTrajectory(num_uploaded, trajectory_id))
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_NOOP);
+    writeMotions(motion_sequence, num_uploaded, motion_buffer_);
   }
+  return result;
+}
+int32_t urcl::InstructionExecutor::motionSequenceId(const control::MotionPrimitiveValue* motion_sequence,
+                                                    const size_t num_primitives)
+{
+  // 32 bit FNV-1a over the parameters of all motions
+  uint32_t hash = 2166136261u;
+  auto add = [&hash](const auto& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+      hash = (hash ^ bytes[i]) * 16777619u;
+    }
+  };
+  auto add_pose = [&add](const urcl::Pose& pose) {
+    for (const double value : { pose.x, pose.y, pose.z, pose.rx, pose.ry, pose.rz })
+    {
+      add(value);
+    }
+  };
+  for (size_t i = 0; i < num_primitives; ++i)
   {
+    std::visit(
+        [&](const auto& primitive) {
+          add(primitive.type);
+          add(primitive.duration.count());
+          add(primitive.acceleration);
+          add(primitive.velocity);
+          add(primitive.blend_radius);
+          using T = std::decay_t<decltype(primitive)>;
+          if constexpr (std::is_same_v<T, control::MoveJPrimitive>)
+          {
+            add(primitive.target_joint_configuration);
+          }
+          else if constexpr (std::is_same_v<T, control::MoveCPrimitive>)
+          {
+            add_pose(primitive.via_point_pose);
+            add_pose(primitive.target_pose);
+            add(primitive.mode);
+          }
+          else if constexpr (std::is_same_v<T, control::SplinePrimitive>)
+          {
+            add(primitive.target_positions);
+            add(primitive.target_velocities);
+            add(primitive.target_accelerations.has_value());
+            if (primitive.target_accelerations)
+            {
+              add(*primitive.target_accelerations);
+            }
+          }
+          else
+          {
+            add_pose(primitive.target_pose);
+          }
+        },
+        motion_sequence[i]);
+  }
+  return static_cast<int32_t>(hash);
+}
+bool urcl::InstructionExecutor::startTrajectory(const size_t num_primitives,
+                                                const std::optional<int32_t>& trajectory_id)
+{
+  const bool started =
+      trajectory_id ? driver_->startCachedTrajectory(*trajectory_id, num_primitives) :
+                      driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_START,
+                                                             num_primitives);
+  if (!started)
+  {
+    URCL_LOG_ERROR("Cannot send trajectory control command. No client connected?");
     std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
-    URCL_LOG_INFO("Trajectory done with result %s", control::trajectoryResultToString(trajectory_result_).c_str());
-    return trajectory_result_ == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+    finishTrajectory(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+    return false;
   }
+  enableKeepalive();
+  return true;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::startMotionQueue(const size_t window_size)
+{
+  if (window_size == 0)
+  {
+    throw UrException("The window of a motion queue has to hold at least one motion.");
+  }
+  comm::NotifyingFuture<control::TrajectoryResult> result;
+  if (!beginTrajectory(result))
+  {
+    return result;
+  }
+
+  if (!driver_->startTrajectoryStream(window_size))
+  {
+    URCL_LOG_ERROR("Cannot send trajectory control command. No client connected?");
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    finishTrajectory(urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+    return result;
+  }
+  {
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    // The trajectory might have failed already
+    queueing_ = trajectory_running_;
+  }
+  enableKeepalive();
+  return result;
+}
+bool urcl::InstructionExecutor::queueMotion(
+    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence)
+{
+  if (!isQueueing())
+  {
+    URCL_LOG_ERROR("Cannot queue a motion sequence without a running motion queue.");
+    return false;
+  }
+  std::vector<control::MotionPrimitiveValue> values;
+  if (trajectory_reducer_ != nullptr && toMotionPrimitiveValues(motion_sequence, values))
+  {
+    return queueMotion(values);
+  }
+  if (!validateMotions(motion_sequence))
+  {
+    return false;
+  }
+  // Blocks only while the robot's window is full, i.e. while previous motions are still running
+  return writeMotions(motion_sequence, queue_buffer_);
+}
+bool urcl::InstructionExecutor::queueMotion(const std::vector<control::MotionPrimitiveValue>& motion_sequence)
+{
+  if (!isQueueing())
+  {
+    URCL_LOG_ERROR("Cannot queue a motion sequence without a running motion queue.");
+    return false;
+  }
+  if (trajectory_reducer_ != nullptr)
+  {
+    std::vector<control::MotionPrimitiveValue> reduced;
+    trajectory_reducer_->reduce(motion_sequence, reduced);
+    return queueReducedMotion(reduced.data(), reduced.size());
+  }
+  return queueReducedMotion(motion_sequence.data(), motion_sequence.size());
+}
+bool urcl::InstructionExecutor::queueReducedMotion(const control::MotionPrimitiveValue* motion_sequence,
+                                                   const size_t num_primitives)
+{
+  if (!validateMotions(motion_sequence, num_primitives))
+  {
+    return false;
+  }
+  return writeMotions(motion_sequence, num_primitives, queue_buffer_);
+}
+bool urcl::InstructionExecutor::endMotionQueue()
+{
+  {
+    std::unique_lock<std::mutex> lock(trajectory_result_mutex_);
+    if (!queueing_)
+    {
+      return false;
+    }
+    queueing_ = false;
+  }
+  return driver_->endTrajectoryStream();
+}
+bool urcl::InstructionExecutor::executeMotion(
+    const std::vector<std::shared_ptr<control::MotionPrimitive>>& motion_sequence)
+{
+  return executeMotionAsync(motion_sequence).get() == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+}
+bool urcl::InstructionExecutor::executeMotion(const std::vector<control::MotionPrimitiveValue>& motion_sequence)
+{
+  return executeMotionAsync(motion_sequence).get() == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+}
+bool urcl::InstructionExecutor::executeCachedMotion(const int32_t trajectory_id,
+                                                    const std::vector<control::MotionPrimitiveValue>& motion_sequence)
+{
+  return executeCachedMotionAsync(trajectory_id, motion_sequence).get() ==
+         urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
 }
 bool urcl::InstructionExecutor::moveJ(const urcl::vector6d_t& target, const double acceleration, const double velocity,
                                       const double time, const double blend_radius)
 {
-  return executeMotion({ std::make_shared<control::MoveJPrimitive>(
-      target, blend_radius, std::chrono::milliseconds(static_cast<int>(time * 1000)), acceleration, velocity) });
+  return moveJAsync(target, acceleration, velocity, time, blend_radius).get() ==
+         urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
 }
 bool urcl::InstructionExecutor::moveL(const urcl::Pose& target, const double acceleration, const double velocity,
                                       const double time, const double blend_radius)
 {
-  return executeMotion({ std::make_shared<control::MoveLPrimitive>(
-      target, blend_radius, std::chrono::milliseconds(static_cast<int>(time * 1000)), acceleration, velocity) });
+  return moveLAsync(target, acceleration, velocity, time, blend_radius).get() ==
+         urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::moveJAsync(const urcl::vector6d_t& target, const double acceleration, const double velocity,
+                                      const double time, const double blend_radius)
+{
+  const control::MotionPrimitiveValue primitive = control::MoveJPrimitive(
+      target, blend_radius, std::chrono::milliseconds(static_cast<int>(time * 1000)), acceleration, velocity);
+  return executeMotionAsync(&primitive, 1);
+}
+bool urcl::InstructionExecutor::moveP(const urcl::Pose& target, const double acceleration, const double velocity,
+                                      const double blend_radius)
+{
+  const control::MotionPrimitiveValue primitive =
+      control::MovePPrimitive(target, blend_radius, acceleration, velocity);
+  return executeMotionAsync(&primitive, 1).get() == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+}
+bool urcl::InstructionExecutor::moveC(const urcl::Pose& via_point, const urcl::Pose& target, const double acceleration,
+                                      const double velocity, const double blend_radius, const int32_t mode)
+{
+  const control::MotionPrimitiveValue primitive =
+      control::MoveCPrimitive(via_point, target, blend_radius, acceleration, velocity, mode);
+  return executeMotionAsync(&primitive, 1).get() == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS;
+}
+urcl::comm::NotifyingFuture<urcl::control::TrajectoryResult>
+urcl::InstructionExecutor::moveLAsync(const urcl::Pose& target, const double acceleration, const double velocity,
+                                      const double time, const double blend_radius)
+{
+  const control::MotionPrimitiveValue primitive = control::MoveLPrimitive(
+      target, blend_radius, std::chrono::milliseconds(static_cast<int>(time * 1000)), acceleration, velocity);
+  return executeMotionAsync(&primitive, 1);
 }
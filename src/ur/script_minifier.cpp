@@ -0,0 +1,164 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/script_minifier.h"
+
+#include <sstream>
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace
+{
+const std::string SECTION_BEGIN = "BEGIN_SECTION ";
+const std::string SECTION_END = "END_SECTION ";
+const std::set<std::string> PRESERVED_COMMENTS = { "HEADER_BEGIN", "HEADER_END", "NODE_CONTROL_LOOP_BEGINS",
+                                                   "NODE_CONTROL_LOOP_ENDS" };
+
+const char* const WHITESPACE = " \t\r";
+
+std::string trim(const std::string& str)
+{
+  const size_t begin = str.find_first_not_of(WHITESPACE);
+  if (begin == std::string::npos)
+  {
+    return "";
+  }
+  const size_t end = str.find_last_not_of(WHITESPACE);
+  return str.substr(begin, end - begin + 1);
+}
+
+// Returns the position of the comment in the line or std::string::npos, ignoring '#' inside strings
+size_t findComment(const std::string& line)
+{
+  char quote = 0;
+  for (size_t i = 0; i < line.size(); ++i)
+  {
+    const char c = line[i];
+    if (quote != 0)
+    {
+      if (c == '\\')
+      {
+        ++i;
+      }
+      else if (c == quote)
+      {
+        quote = 0;
+      }
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote = c;
+    }
+    else if (c == '#')
+    {
+      return i;
+    }
+  }
+  return std::string::npos;
+}
+}  // namespace
+
+ScriptMinifier::ScriptMinifier(const std::set<std::string>& excluded_sections) : excluded_sections_(excluded_sections)
+{
+}
+
+std::string ScriptMinifier::minify(const std::string& script) const
+{
+  std::string minified;
+  minified.reserve(script.size());
+
+  std::vector<std::string> open_sections;
+  size_t excluded_depth = 0;
+
+  std::istringstream stream(script);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    std::string code = trim(line);
+    const size_t comment_position = findComment(code);
+    if (comment_position == 0)
+    {
+      const std::string comment = trim(code.substr(1));
+      if (comment.compare(0, SECTION_BEGIN.size(), SECTION_BEGIN) == 0)
+      {
+        const std::string name = trim(comment.substr(SECTION_BEGIN.size()));
+        open_sections.push_back(name);
+        if (excluded_depth > 0 || excluded_sections_.count(name) > 0)
+        {
+          ++excluded_depth;
+        }
+        continue;
+      }
+      if (comment.compare(0, SECTION_END.size(), SECTION_END) == 0)
+      {
+        const std::string name = trim(comment.substr(SECTION_END.size()));
+        if (open_sections.empty() || open_sections.back() != name)
+        {
+          throw UrException("Script section '" + name + "' ends without having been begun.");
+        }
+        open_sections.pop_back();
+        if (excluded_depth > 0)
+        {
+          --excluded_depth;
+        }
+        continue;
+      }
+      if (excluded_depth == 0 && PRESERVED_COMMENTS.count(comment) > 0)
+      {
+        minified += "# " + comment + "\n";
+      }
+      continue;
+    }
+
+    if (excluded_depth > 0)
+    {
+      continue;
+    }
+    if (comment_position != std::string::npos)
+    {
+      code = trim(code.substr(0, comment_position));
+    }
+    if (!code.empty())
+    {
+      minified += code + "\n";
+    }
+  }
+
+  if (!open_sections.empty())
+  {
+    throw UrException("Script section '" + open_sections.back() + "' is not terminated.");
+  }
+  return minified;
+}
+
+}  // namespace urcl
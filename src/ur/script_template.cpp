@@ -0,0 +1,230 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/script_template.h"
+
+#include <sys/stat.h>
+
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace
+{
+const std::string PLACEHOLDER_BEGIN = "{{";
+const std::string PLACEHOLDER_END = "}}";
+
+bool isPlaceholderName(const std::string& script, const size_t begin, const size_t end)
+{
+  if (begin == end)
+  {
+    return false;
+  }
+  for (size_t i = begin; i < end; ++i)
+  {
+    const char c = script[i];
+    if (c == '{' || c == '}' || c == '\n')
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct CachedTemplate
+{
+  struct timespec modification_time;
+  off_t size;
+  std::shared_ptr<const ScriptTemplate> script_template;
+};
+}  // namespace
+
+ScriptTemplate::ScriptTemplate(const std::string& script) : script_(script)
+{
+  std::unordered_map<std::string, size_t> placeholder_indices;
+  size_t literal_begin = 0;
+  size_t position = script_.find(PLACEHOLDER_BEGIN);
+  while (position != std::string::npos)
+  {
+    const size_t name_begin = position + PLACEHOLDER_BEGIN.size();
+    const size_t name_end = script_.find(PLACEHOLDER_END, name_begin);
+    if (name_end == std::string::npos)
+    {
+      break;
+    }
+    if (!isPlaceholderName(script_, name_begin, name_end))
+    {
+      position = script_.find(PLACEHOLDER_BEGIN, position + 1);
+      continue;
+    }
+
+    const std::string name = script_.substr(name_begin, name_end - name_begin);
+    auto inserted = placeholder_indices.emplace(name, placeholders_.size());
+    if (inserted.second)
+    {
+      placeholders_.push_back(name);
+    }
+    if (position > literal_begin)
+    {
+      segments_.push_back({ literal_begin, position - literal_begin, NO_PLACEHOLDER });
+    }
+    literal_begin = name_end + PLACEHOLDER_END.size();
+    segments_.push_back({ position, literal_begin - position, inserted.first->second });
+    position = script_.find(PLACEHOLDER_BEGIN, literal_begin);
+  }
+  if (literal_begin < script_.size())
+  {
+    segments_.push_back({ literal_begin, script_.size() - literal_begin, NO_PLACEHOLDER });
+  }
+}
+
+std::shared_ptr<const ScriptTemplate> ScriptTemplate::fromFile(const std::string& filename)
+{
+  static std::mutex templates_mutex;
+  static std::unordered_map<std::string, CachedTemplate> templates;
+
+  struct stat file_status;
+  if (stat(filename.c_str(), &file_status) != 0)
+  {
+    std::stringstream ss;
+    ss << "URScript file '" << filename << "' doesn't exists.";
+    throw UrException(ss.str().c_str());
+  }
+
+  std::lock_guard<std::mutex> lk(templates_mutex);
+  auto cached = templates.find(filename);
+  if (cached != templates.end() && cached->second.modification_time.tv_sec == file_status.st_mtim.tv_sec &&
+      cached->second.modification_time.tv_nsec == file_status.st_mtim.tv_nsec &&
+      cached->second.size == file_status.st_size)
+  {
+    return cached->second.script_template;
+  }
+
+  std::ifstream ifs(filename);
+  if (!ifs)
+  {
+    std::stringstream ss;
+    ss << "URScript file '" << filename << "' doesn't exists.";
+    throw UrException(ss.str().c_str());
+  }
+  std::string content((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
+
+  auto script_template = std::make_shared<const ScriptTemplate>(content);
+  templates[filename] = { file_status.st_mtim, file_status.st_size, script_template };
+  return script_template;
+}
+
+std::string ScriptTemplate::render(const ScriptParameters& parameters) const
+{
+  const size_t hash = hashParameters(parameters);
+  {
+    std::lock_guard<std::mutex> lk(cache_mutex_);
+    auto cached = cache_.find(hash);
+    if (cached != cache_.end() && cached->second.parameters == parameters)
+    {
+      return *cached->second.program;
+    }
+  }
+
+  // Resolve every placeholder once, so the segments can be copied without further lookups.
+  std::vector<const std::string*> replacements(placeholders_.size(), nullptr);
+  for (size_t i = 0; i < placeholders_.size(); ++i)
+  {
+    auto parameter = parameters.find(placeholders_[i]);
+    if (parameter != parameters.end())
+    {
+      replacements[i] = &parameter->second;
+    }
+  }
+
+  size_t length = 0;
+  for (const auto& segment : segments_)
+  {
+    const bool replaced = segment.placeholder != NO_PLACEHOLDER && replacements[segment.placeholder] != nullptr;
+    length += replaced ? replacements[segment.placeholder]->size() : segment.length;
+  }
+
+  auto program = std::make_shared<std::string>();
+  program->reserve(length);
+  for (const auto& segment : segments_)
+  {
+    if (segment.placeholder != NO_PLACEHOLDER && replacements[segment.placeholder] != nullptr)
+    {
+      program->append(*replacements[segment.placeholder]);
+    }
+    else
+    {
+      program->append(script_, segment.begin, segment.length);
+    }
+  }
+
+  std::lock_guard<std::mutex> lk(cache_mutex_);
+  if (cache_.find(hash) == cache_.end())
+  {
+    if (cache_order_.size() >= MAX_CACHED_PROGRAMS)
+    {
+      cache_.erase(cache_order_.front());
+      cache_order_.erase(cache_order_.begin());
+    }
+    cache_order_.push_back(hash);
+  }
+  cache_[hash] = { parameters, program };
+  return *program;
+}
+
+std::vector<std::string> ScriptTemplate::getPlaceholders() const
+{
+  return placeholders_;
+}
+
+size_t ScriptTemplate::getCachedProgramCount() const
+{
+  std::lock_guard<std::mutex> lk(cache_mutex_);
+  return cache_.size();
+}
+
+size_t ScriptTemplate::hashParameters(const ScriptParameters& parameters)
+{
+  std::hash<std::string> hasher;
+  size_t hash = parameters.size();
+  for (const auto& parameter : parameters)
+  {
+    hash ^= hasher(parameter.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= hasher(parameter.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+}  // namespace urcl
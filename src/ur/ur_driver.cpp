@@ -34,23 +34,89 @@
 #include "ur_client_library/ur/ur_driver.h"
 #include "ur_client_library/exceptions.h"
 #include "ur_client_library/primary/primary_parser.h"
+#include "ur_client_library/ur/script_template.h"
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <sstream>
+#include <thread>
 
-#include <ur_client_library/ur/calibration_checker.h>
 
 namespace urcl
 {
-static const std::string BEGIN_REPLACE("{{BEGIN_REPLACE}}");
-static const std::string JOINT_STATE_REPLACE("{{JOINT_STATE_REPLACE}}");
-static const std::string TIME_REPLACE("{{TIME_REPLACE}}");
-static const std::string SERVO_J_REPLACE("{{SERVO_J_REPLACE}}");
-static const std::string SERVER_IP_REPLACE("{{SERVER_IP_REPLACE}}");
-static const std::string SERVER_PORT_REPLACE("{{SERVER_PORT_REPLACE}}");
-static const std::string TRAJECTORY_PORT_REPLACE("{{TRAJECTORY_SERVER_PORT_REPLACE}}");
-static const std::string SCRIPT_COMMAND_PORT_REPLACE("{{SCRIPT_COMMAND_SERVER_PORT_REPLACE}}");
-static const std::string FORCE_MODE_SET_DAMPING_REPLACE("{{FORCE_MODE_SET_DAMPING_REPLACE}}");
-static const std::string FORCE_MODE_SET_GAIN_SCALING_REPLACE("{{FORCE_MODE_SET_GAIN_SCALING_REPLACE}}");
+static const std::string BEGIN_REPLACE("BEGIN_REPLACE");
+static const std::string JOINT_STATE_REPLACE("JOINT_STATE_REPLACE");
+static const std::string TIME_REPLACE("TIME_REPLACE");
+static const std::string WIRE_PROTOCOL_REPLACE("WIRE_PROTOCOL_REPLACE");
+static const std::string SERVO_J_REPLACE("SERVO_J_REPLACE");
+static const std::string SERVOJ_LOOKAHEAD_TIME_REPLACE("SERVOJ_LOOKAHEAD_TIME_REPLACE");
+static const std::string SERVOJ_GAIN_REPLACE("SERVOJ_GAIN_REPLACE");
+static const std::string SERVER_IP_REPLACE("SERVER_IP_REPLACE");
+static const std::string SERVER_PORT_REPLACE("SERVER_PORT_REPLACE");
+static const std::string TRAJECTORY_PORT_REPLACE("TRAJECTORY_SERVER_PORT_REPLACE");
+static const std::string SCRIPT_COMMAND_PORT_REPLACE("SCRIPT_COMMAND_SERVER_PORT_REPLACE");
+static const std::string RESIDENT_PROGRAM_REPLACE("RESIDENT_PROGRAM_REPLACE");
+static const std::string STANDBY_SERVER_IP_REPLACE("STANDBY_SERVER_IP_REPLACE");
+static const std::string FAILOVER_TIMEOUT_REPLACE("FAILOVER_TIMEOUT_REPLACE");
+static const std::string STATE_OUTPUT_REGISTER_REPLACE("STATE_OUTPUT_REGISTER_REPLACE");
+static const std::string TRAJECTORY_CACHE_CAPACITY_REPLACE("TRAJECTORY_CACHE_CAPACITY_REPLACE");
+static const std::string TRAJECTORY_START_REGISTER_REPLACE("TRAJECTORY_START_REGISTER_REPLACE");
+static const std::string TRAJECTORY_PROGRESS_INDEX_REGISTER_REPLACE("TRAJECTORY_PROGRESS_INDEX_REGISTER_REPLACE");
+static const std::string TRAJECTORY_PROGRESS_TIME_REGISTER_REPLACE("TRAJECTORY_PROGRESS_TIME_REGISTER_REPLACE");
+static const std::string SETPOINT_ECHO_REGISTER_REPLACE("SETPOINT_ECHO_REGISTER_REPLACE");
+static const std::string REGISTER_TRANSFER_CONTROL_REPLACE("REGISTER_TRANSFER_CONTROL_REPLACE");
+static const std::string REGISTER_TRANSFER_ACK_REPLACE("REGISTER_TRANSFER_ACK_REPLACE");
+static const std::string REGISTER_TRANSFER_FIRST_DATA_REPLACE("REGISTER_TRANSFER_FIRST_DATA_REPLACE");
+static const std::string REGISTER_TRANSFER_NUM_DATA_REPLACE("REGISTER_TRANSFER_NUM_DATA_REPLACE");
+static const std::string REGISTER_TRANSFER_CAPACITY_REPLACE("REGISTER_TRANSFER_CAPACITY_REPLACE");
+static const std::string FORCE_MODE_SET_DAMPING_REPLACE("FORCE_MODE_SET_DAMPING_REPLACE");
+static const std::string FORCE_MODE_SET_GAIN_SCALING_REPLACE("FORCE_MODE_SET_GAIN_SCALING_REPLACE");
+
+namespace
+{
+// Measures the time until it goes out of scope
+class TimedPhase
+{
+public:
+  explicit TimedPhase(std::chrono::microseconds& duration)
+    : duration_(duration), begin_(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~TimedPhase()
+  {
+    duration_ = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_);
+  }
+
+private:
+  std::chrono::microseconds& duration_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+double toMilliseconds(const std::chrono::microseconds duration)
+{
+  return duration.count() / 1000.0;
+}
+
+// Resolves a handle of a field, that might not be part of the recipe
+rtde_interface::FieldHandle<double> findDoubleField(const rtde_interface::CompiledRecipe& recipe,
+                                                    const std::string& name)
+{
+  size_t index;
+  if (!recipe.findIndex(name, index))
+  {
+    return rtde_interface::FieldHandle<double>();
+  }
+  return recipe.getFieldHandle<double>(name);
+}
+}  // namespace
+
+static comm::NotifyingFuture<bool> failedAcknowledgement()
+{
+  comm::NotifyingPromise<bool> acknowledgement;
+  acknowledgement.setValue(false);
+  return acknowledgement.getFuture();
+}
 
 urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_file,
                          const std::string& output_recipe_file, const std::string& input_recipe_file,
@@ -58,77 +124,126 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
                          std::unique_ptr<ToolCommSetup> tool_comm_setup, const uint32_t reverse_port,
                          const uint32_t script_sender_port, int servoj_gain, double servoj_lookahead_time,
                          bool non_blocking_read, const std::string& reverse_ip, const uint32_t trajectory_port,
-                         const uint32_t script_command_port)
+                         const uint32_t script_command_port, const DriverCapabilities capabilities)
   : servoj_gain_(servoj_gain)
   , servoj_lookahead_time_(servoj_lookahead_time)
   , handle_program_state_(handle_program_state)
   , robot_ip_(robot_ip)
+  , capabilities_(capabilities)
 {
   URCL_LOG_DEBUG("Initializing urdriver");
+  const auto startup_begin = std::chrono::steady_clock::now();
   URCL_LOG_DEBUG("Initializing RTDE client");
   rtde_client_.reset(new rtde_interface::RTDEClient(robot_ip_, notifier_, output_recipe_file, input_recipe_file));
-
-  primary_stream_.reset(
-      new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, urcl::primary_interface::UR_PRIMARY_PORT));
-  secondary_stream_.reset(
-      new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, urcl::primary_interface::UR_SECONDARY_PORT));
-  secondary_stream_->connect();
+  rtde_client_->setStateCaching(true);
+
+  primary_client_.reset(new primary_interface::PrimaryClient(robot_ip_, notifier_));
+  // Startup phases not depending on each other run concurrently, so startup takes as long as the
+  // slowest chain of dependent phases: The primary interface, loading the script and the control
+  // servers are independent of the RTDE handshake, which the reverse interface and rendering the
+  // script wait for.
+  auto primary_connected = std::async(std::launch::async, [this]() {
+    const TimedPhase phase(startup_timings_.primary);
+    try
+    {
+      primary_client_->start();
+      return true;
+    }
+    catch (const UrException& e)
+    {
+      URCL_LOG_ERROR("%s", e.what());
+      return false;
+    }
+  });
+  // The program stops without the reverse interface, so it is only prepared with it
+  const bool prepare_program = hasCapabilities(DriverCapabilities::REVERSE_INTERFACE);
+  auto script_loaded = std::async(std::launch::async, [this, script_file, prepare_program]() {
+    if (!prepare_program)
+    {
+      return;
+    }
+    const TimedPhase phase(startup_timings_.script_loading);
+    // Templates and rendered programs are cached, so re-creating a driver doesn't parse the script again
+    script_template_ = ScriptTemplate::fromFile(script_file);
+  });
+  auto control_servers_started = std::async(std::launch::async, [this, trajectory_port, script_command_port]() {
+    const TimedPhase phase(startup_timings_.control_servers);
+    if (hasCapabilities(DriverCapabilities::TRAJECTORY_INTERFACE))
+    {
+      trajectory_interface_.reset(new control::TrajectoryPointInterface(trajectory_port));
+    }
+    if (hasCapabilities(DriverCapabilities::SCRIPT_COMMAND_INTERFACE))
+    {
+      script_command_interface_.reset(new control::ScriptCommandInterface(script_command_port));
+    }
+  });
 
   non_blocking_read_ = non_blocking_read;
   get_packet_timeout_ = non_blocking_read_ ? 0 : 100;
 
-  initRTDE();
-  setupReverseInterface(reverse_port);
-
-  // Figure out the ip automatically if the user didn't provide it
-  std::string local_ip = reverse_ip.empty() ? rtde_client_->getIP() : reverse_ip;
-
-  std::string prog = readScriptFile(script_file);
-  while (prog.find(JOINT_STATE_REPLACE) != std::string::npos)
   {
-    prog.replace(prog.find(JOINT_STATE_REPLACE), JOINT_STATE_REPLACE.length(),
-                 std::to_string(control::ReverseInterface::MULT_JOINTSTATE));
+    const TimedPhase phase(startup_timings_.rtde);
+    initRTDE();
   }
-  while (prog.find(TIME_REPLACE) != std::string::npos)
+  if (hasCapabilities(DriverCapabilities::REVERSE_INTERFACE))
   {
-    prog.replace(prog.find(TIME_REPLACE), TIME_REPLACE.length(),
-                 std::to_string(control::TrajectoryPointInterface::MULT_TIME));
+    const TimedPhase phase(startup_timings_.reverse_interface);
+    setupReverseInterface(reverse_port);
   }
+  const auto rendering_begin = std::chrono::steady_clock::now();
+
+  // Figure out the ip automatically if the user didn't provide it
+  std::string local_ip = reverse_ip.empty() ? rtde_client_->getIP() : reverse_ip;
 
   std::ostringstream out;
   out << "lookahead_time=" << servoj_lookahead_time_ << ", gain=" << servoj_gain_;
-  while (prog.find(SERVO_J_REPLACE) != std::string::npos)
-  {
-    prog.replace(prog.find(SERVO_J_REPLACE), SERVO_J_REPLACE.length(), out.str());
-  }
-
-  while (prog.find(SERVER_IP_REPLACE) != std::string::npos)
-  {
-    prog.replace(prog.find(SERVER_IP_REPLACE), SERVER_IP_REPLACE.length(), local_ip);
-  }
-
-  while (prog.find(SERVER_PORT_REPLACE) != std::string::npos)
-  {
-    prog.replace(prog.find(SERVER_PORT_REPLACE), SERVER_PORT_REPLACE.length(), std::to_string(reverse_port));
-  }
 
-  while (prog.find(TRAJECTORY_PORT_REPLACE) != std::string::npos)
+  ScriptParameters& parameters = script_parameters_;
+  parameters[JOINT_STATE_REPLACE] = std::to_string(control::ReverseInterface::MULT_JOINTSTATE);
+  parameters[TIME_REPLACE] = std::to_string(control::TrajectoryPointInterface::MULT_TIME);
+  parameters[WIRE_PROTOCOL_REPLACE] = control::wire::generateURScriptDefinitions();
+  parameters[SERVO_J_REPLACE] = out.str();
+  parameters[SERVOJ_LOOKAHEAD_TIME_REPLACE] = std::to_string(servoj_lookahead_time_);
+  parameters[SERVOJ_GAIN_REPLACE] = std::to_string(servoj_gain_);
+  parameters[SERVER_IP_REPLACE] = local_ip;
+  // Servers created with port 0 are bound to a port assigned by the operating system, the program
+  // has to connect to that one
+  control_servers_started.get();
+  if (reverse_interface_ != nullptr && trajectory_interface_ != nullptr)
   {
-    prog.replace(prog.find(TRAJECTORY_PORT_REPLACE), TRAJECTORY_PORT_REPLACE.length(), std::to_string(trajectory_port));
-  }
-
-  while (prog.find(SCRIPT_COMMAND_PORT_REPLACE) != std::string::npos)
-  {
-    prog.replace(prog.find(SCRIPT_COMMAND_PORT_REPLACE), SCRIPT_COMMAND_PORT_REPLACE.length(),
-                 std::to_string(script_command_port));
+    // Cancels carry the number of points written, so the robot discards exactly the ones it didn't read
+    control::TrajectoryPointInterface* trajectory_interface = trajectory_interface_.get();
+    reverse_interface_->setTrajectoryWritesCanceler(
+        [trajectory_interface]() { return trajectory_interface->cancelTrajectoryWrites(); });
   }
+  parameters[SERVER_PORT_REPLACE] =
+      std::to_string(reverse_interface_ != nullptr ? reverse_interface_->getPort() : reverse_port);
+  parameters[TRAJECTORY_PORT_REPLACE] =
+      std::to_string(trajectory_interface_ != nullptr ? trajectory_interface_->getPort() : trajectory_port);
+  parameters[SCRIPT_COMMAND_PORT_REPLACE] =
+      std::to_string(script_command_interface_ != nullptr ? script_command_interface_->getPort() : script_command_port);
+  parameters[RESIDENT_PROGRAM_REPLACE] = "False";
+  parameters[STANDBY_SERVER_IP_REPLACE] = "";
+  parameters[FAILOVER_TIMEOUT_REPLACE] = "0.5";
+  parameters[STATE_OUTPUT_REGISTER_REPLACE] = "-1";
+  parameters[TRAJECTORY_CACHE_CAPACITY_REPLACE] = "0";
+  parameters[TRAJECTORY_START_REGISTER_REPLACE] = "-1";
+  parameters[TRAJECTORY_PROGRESS_INDEX_REGISTER_REPLACE] = "-1";
+  parameters[TRAJECTORY_PROGRESS_TIME_REGISTER_REPLACE] = "-1";
+  parameters[SETPOINT_ECHO_REGISTER_REPLACE] = "-1";
+  parameters[REGISTER_TRANSFER_CONTROL_REPLACE] = "-1";
+  parameters[REGISTER_TRANSFER_ACK_REPLACE] = "-1";
+  parameters[REGISTER_TRANSFER_FIRST_DATA_REPLACE] = "-1";
+  parameters[REGISTER_TRANSFER_NUM_DATA_REPLACE] = "0";
+  parameters[REGISTER_TRANSFER_CAPACITY_REPLACE] = "0";
 
   robot_version_ = rtde_client_->getVersion();
+  robot_capabilities_ = VersionCapabilities(robot_version_);
 
   std::stringstream begin_replace;
   if (tool_comm_setup != nullptr)
   {
-    if (robot_version_.major < 5)
+    if (!robot_capabilities_.supports(RobotFeature::TOOL_COMMUNICATION))
     {
       throw ToolCommNotAvailable("Tool communication setup requested, but this robot version does not support using "
                                  "the tool communication interface. Please check your configuration.",
@@ -141,32 +256,52 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
                   << tool_comm_setup->getStopBits() << ", " << tool_comm_setup->getRxIdleChars() << ", "
                   << tool_comm_setup->getTxIdleChars() << ")";
   }
-  prog.replace(prog.find(BEGIN_REPLACE), BEGIN_REPLACE.length(), begin_replace.str());
+  parameters[BEGIN_REPLACE] = begin_replace.str();
+
+  // Rethrows exceptions from loading the script
+  script_loaded.get();
+  const std::string prog = prepare_program ? script_template_->render(parameters) : "";
+  startup_timings_.script_rendering = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - rendering_begin);
+
+  if (!primary_connected.get())
+  {
+    URCL_LOG_ERROR("Could not connect to the robot's primary interface");
+  }
 
   in_headless_mode_ = headless_mode;
-  if (in_headless_mode_)
+  robot_program_ = prog;
   {
-    full_robot_program_ = "stop program\n";
-    full_robot_program_ += "def externalControl():\n";
-    std::istringstream prog_stream(prog);
-    std::string line;
-    while (std::getline(prog_stream, line))
+    const TimedPhase phase(startup_timings_.program_setup);
+    if (!prepare_program)
     {
-      full_robot_program_ += "\t" + line + "\n";
+      URCL_LOG_DEBUG("No reverse interface created, so no program is sent to the robot");
+    }
+    else if (in_headless_mode_ && hasCapabilities(DriverCapabilities::STANDBY))
+    {
+      // A standby driver only sends the program when taking over
+      updateRobotProgram(robot_program_);
+    }
+    else if (in_headless_mode_)
+    {
+      updateRobotProgram(robot_program_);
+      sendRobotProgram();
+    }
+    else if (hasCapabilities(DriverCapabilities::SCRIPT_SENDER))
+    {
+      script_sender_.reset(new control::ScriptSender(script_sender_port, prog));
+      URCL_LOG_DEBUG("Created script sender");
     }
-    full_robot_program_ += "end\n";
-    sendRobotProgram();
-  }
-  else
-  {
-    script_sender_.reset(new control::ScriptSender(script_sender_port, prog));
-    URCL_LOG_DEBUG("Created script sender");
   }
 
-  trajectory_interface_.reset(new control::TrajectoryPointInterface(trajectory_port));
-  script_command_interface_.reset(new control::ScriptCommandInterface(script_command_port));
-
-  URCL_LOG_DEBUG("Initialization done");
+  startup_timings_.total =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startup_begin);
+  URCL_LOG_DEBUG("Initialization done after %.1f ms (RTDE: %.1f ms, primary: %.1f ms, script loading: %.1f ms, control "
+                 "servers: %.1f ms, reverse interface: %.1f ms, script rendering: %.1f ms, program setup: %.1f ms)",
+                 toMilliseconds(startup_timings_.total), toMilliseconds(startup_timings_.rtde),
+                 toMilliseconds(startup_timings_.primary), toMilliseconds(startup_timings_.script_loading),
+                 toMilliseconds(startup_timings_.control_servers), toMilliseconds(startup_timings_.reverse_interface),
+                 toMilliseconds(startup_timings_.script_rendering), toMilliseconds(startup_timings_.program_setup));
 }
 
 urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_file,
@@ -216,6 +351,25 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
   }
 }
 
+UrDriver::~UrDriver()
+{
+  // The interpolator and the scheduler are shared with the RTDE client and write to the reverse
+  // interface
+  if (setpoint_interpolator_ != nullptr)
+  {
+    setpoint_interpolator_->stop();
+  }
+  if (command_scheduler_ != nullptr)
+  {
+    command_scheduler_->setActive(false);
+  }
+  // The stream watchdog notifies the reverse interface from its own thread
+  if (rtde_client_ != nullptr && rtde_client_->getStreamWatchdog() != nullptr)
+  {
+    rtde_client_->getStreamWatchdog()->setStaleCallback(nullptr);
+  }
+}
+
 std::unique_ptr<rtde_interface::DataPackage> urcl::UrDriver::getDataPackage()
 {
   // This can take one of two values, 0ms or 100ms. The large timeout is for when the robot is commanding the control
@@ -229,54 +383,274 @@ std::unique_ptr<rtde_interface::DataPackage> urcl::UrDriver::getDataPackage()
 bool UrDriver::writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
                                  const RobotReceiveTimeout& robot_receive_timeout)
 {
-  return reverse_interface_->write(&values, control_mode, robot_receive_timeout);
+  return reverseInterface().write(&values, control_mode, robot_receive_timeout);
+}
+
+bool UrDriver::writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
+                                 const RobotReceiveTimeout& robot_receive_timeout,
+                                 const std::chrono::steady_clock::time_point state_time)
+{
+  return reverseInterface().write(&values, control_mode, robot_receive_timeout, state_time);
+}
+
+bool UrDriver::writeForceModeWrench(const vector6d_t& wrench, const RobotReceiveTimeout& robot_receive_timeout)
+{
+  return reverseInterface().write(&wrench, comm::ControlMode::MODE_FORCE, robot_receive_timeout);
 }
 
 bool UrDriver::writeTrajectoryPoint(const vector6d_t& positions, const float acceleration, const float velocity,
                                     const bool cartesian, const float goal_time, const float blend_radius)
 {
-  return trajectory_interface_->writeTrajectoryPoint(&positions, acceleration, velocity, goal_time, blend_radius,
+  if (trajectory_validator_ != nullptr)
+  {
+    control::TrajectoryPoint point;
+    point.positions = positions;
+    point.acceleration = acceleration;
+    point.velocity = velocity;
+    point.goal_time = goal_time;
+    point.cartesian = cartesian;
+    if (!validateTrajectory(&point, 1))
+    {
+      return false;
+    }
+  }
+  return trajectoryInterface().writeTrajectoryPoint(&positions, acceleration, velocity, goal_time, blend_radius,
                                                      cartesian);
 }
 
 bool UrDriver::writeTrajectoryPoint(const vector6d_t& positions, const bool cartesian, const float goal_time,
                                     const float blend_radius)
 {
-  return trajectory_interface_->writeTrajectoryPoint(&positions, goal_time, blend_radius, cartesian);
+  if (trajectory_validator_ != nullptr)
+  {
+    control::TrajectoryPoint point;
+    point.positions = positions;
+    point.goal_time = goal_time;
+    point.cartesian = cartesian;
+    if (!validateTrajectory(&point, 1))
+    {
+      return false;
+    }
+  }
+  return trajectoryInterface().writeTrajectoryPoint(&positions, goal_time, blend_radius, cartesian);
 }
 
 bool UrDriver::writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities,
                                           const vector6d_t& accelerations, const float goal_time)
 {
-  return trajectory_interface_->writeTrajectorySplinePoint(&positions, &velocities, &accelerations, goal_time);
+  if (trajectory_validator_ != nullptr)
+  {
+    const control::TrajectorySplinePoint point{ positions, velocities, accelerations, goal_time };
+    if (!validateTrajectory(&point, 1))
+    {
+      return false;
+    }
+  }
+  return trajectoryInterface().writeTrajectorySplinePoint(&positions, &velocities, &accelerations, goal_time);
 }
 
 bool UrDriver::writeTrajectorySplinePoint(const vector6d_t& positions, const vector6d_t& velocities,
                                           const float goal_time)
 {
-  return trajectory_interface_->writeTrajectorySplinePoint(&positions, &velocities, nullptr, goal_time);
+  if (trajectory_validator_ != nullptr)
+  {
+    const control::TrajectorySplinePoint point{ positions, velocities, std::nullopt, goal_time };
+    if (!validateTrajectory(&point, 1))
+    {
+      return false;
+    }
+  }
+  return trajectoryInterface().writeTrajectorySplinePoint(&positions, &velocities, nullptr, goal_time);
 }
 
 bool UrDriver::writeTrajectorySplinePoint(const vector6d_t& positions, const float goal_time)
 {
-  return trajectory_interface_->writeTrajectorySplinePoint(&positions, nullptr, nullptr, goal_time);
+  if (trajectory_validator_ != nullptr)
+  {
+    const control::TrajectorySplinePoint point{ positions, vector6d_t{ 0, 0, 0, 0, 0, 0 }, std::nullopt, goal_time };
+    if (!validateTrajectory(&point, 1))
+    {
+      return false;
+    }
+  }
+  return trajectoryInterface().writeTrajectorySplinePoint(&positions, nullptr, nullptr, goal_time);
+}
+
+bool UrDriver::writeTrajectoryPoints(const std::vector<control::TrajectoryPoint>& points)
+{
+  if (!validateTrajectory(points.data(), points.size()))
+  {
+    return false;
+  }
+  return trajectoryInterface().writeTrajectoryPoints(points.data(), points.size());
+}
+
+bool UrDriver::writeTrajectorySplinePoints(const std::vector<control::TrajectorySplinePoint>& points)
+{
+  if (!validateTrajectory(points.data(), points.size()))
+  {
+    return false;
+  }
+  return trajectoryInterface().writeTrajectorySplinePoints(points.data(), points.size());
+}
+
+bool UrDriver::writeTrajectoryCircularPoints(const std::vector<control::TrajectoryCircularPoint>& points)
+{
+  if (!validateTrajectory(points.data(), points.size()))
+  {
+    return false;
+  }
+  return trajectoryInterface().writeTrajectoryCircularPoints(points.data(), points.size());
+}
+
+void UrDriver::setTrajectoryValidator(std::shared_ptr<const control::TrajectoryValidator> validator)
+{
+  trajectory_validator_ = validator;
+}
+
+template <typename T>
+bool UrDriver::validateTrajectory(const T* points, const size_t count) const
+{
+  if (trajectory_validator_ == nullptr)
+  {
+    return true;
+  }
+  const control::TrajectoryValidationResult result = trajectory_validator_->validate(points, count);
+  if (!result)
+  {
+    URCL_LOG_ERROR("Rejecting trajectory, point %zu violates %s.", result.index,
+                   control::trajectoryViolationToString(result.violation).c_str());
+    return false;
+  }
+  return true;
+}
+
+bool UrDriver::writeTrajectorySplineSegments(const std::vector<control::TrajectorySplineSegment>& segments)
+{
+  return trajectoryInterface().writeTrajectorySplineSegments(segments.data(), segments.size());
+}
+
+void UrDriver::startTrajectoryBatch()
+{
+  trajectoryInterface().startTrajectoryBatch();
+}
+
+bool UrDriver::flushTrajectoryBatch()
+{
+  return trajectoryInterface().flushTrajectoryBatch();
+}
+
+bool UrDriver::startTrajectoryStream(const size_t window_size, const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (window_size == 0)
+  {
+    throw UrException("The window of a streamed trajectory has to hold at least one point.");
+  }
+  trajectoryInterface().resumeTrajectoryWrites();
+  if (!reverseInterface().writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_STREAM, 0,
+                                                         robot_receive_timeout))
+  {
+    return false;
+  }
+  trajectoryInterface().startTrajectoryStream(window_size);
+  return true;
+}
+
+bool UrDriver::endTrajectoryStream()
+{
+  return trajectoryInterface().endTrajectoryStream();
 }
 
 bool UrDriver::writeTrajectoryControlMessage(const control::TrajectoryControlMessage trajectory_action,
                                              const int point_number, const RobotReceiveTimeout& robot_receive_timeout)
 {
-  return reverse_interface_->writeTrajectoryControlMessage(trajectory_action, point_number, robot_receive_timeout);
+  // A cancel stops an upload in progress through the canceler set on the reverse interface
+  if (trajectory_action != control::TrajectoryControlMessage::TRAJECTORY_CANCEL &&
+      trajectory_action != control::TrajectoryControlMessage::TRAJECTORY_NOOP)
+  {
+    trajectoryInterface().resumeTrajectoryWrites();
+  }
+  return reverseInterface().writeTrajectoryControlMessage(trajectory_action, point_number, robot_receive_timeout);
+}
+
+control::TrajectoryReplayResult UrDriver::replayTrajectory(const int32_t trajectory_id,
+                                                          const std::chrono::milliseconds answer_timeout,
+                                                          const RobotReceiveTimeout& robot_receive_timeout)
+{
+  trajectoryInterface().resetReplayAnswer();
+  // A replay doesn't read points from the trajectory socket, so a cancel mustn't discard any
+  trajectoryInterface().resumeTrajectoryWrites();
+  if (!reverseInterface().writeTrajectoryCacheControlMessage(control::TrajectoryControlMessage::TRAJECTORY_REPLAY,
+                                                             trajectory_id, 0, robot_receive_timeout))
+  {
+    return control::TrajectoryReplayResult::NO_ANSWER;
+  }
+  return trajectoryInterface().waitForReplayAnswer(answer_timeout);
+}
+
+bool UrDriver::startCachedTrajectory(const int32_t trajectory_id, const int point_number,
+                                     const RobotReceiveTimeout& robot_receive_timeout)
+{
+  trajectoryInterface().resumeTrajectoryWrites();
+  return reverseInterface().writeTrajectoryCacheControlMessage(
+      control::TrajectoryControlMessage::TRAJECTORY_START_CACHED, trajectory_id, point_number, robot_receive_timeout);
+}
+
+bool UrDriver::armTrajectory(const int32_t start_token, const int point_number,
+                             const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (trajectory_start_trigger_ == nullptr)
+  {
+    URCL_LOG_ERROR("Trajectories can only be armed once a start register has been set.");
+    return false;
+  }
+  if (start_token == 0)
+  {
+    URCL_LOG_ERROR("The start token of an armed trajectory must not be 0.");
+    return false;
+  }
+  trajectory_start_trigger_->cancel();
+  trajectoryInterface().resumeTrajectoryWrites();
+  return reverseInterface().writeTrajectoryCacheControlMessage(
+      control::TrajectoryControlMessage::TRAJECTORY_START_ARMED, start_token, point_number, robot_receive_timeout);
+}
+
+bool UrDriver::scheduleTrajectoryStart(const int32_t start_token,
+                                       const std::chrono::steady_clock::time_point start_time)
+{
+  if (trajectory_start_trigger_ == nullptr)
+  {
+    return false;
+  }
+  std::shared_ptr<rtde_interface::ClockSynchronizer> clock = rtde_client_->getClockSynchronizer();
+  if (clock == nullptr || !clock->isSynchronized())
+  {
+    URCL_LOG_ERROR("The start of a trajectory cannot be scheduled before the clocks are synchronized.");
+    return false;
+  }
+  trajectory_start_trigger_->schedule(start_token, clock->toRobotTime(start_time));
+  return true;
+}
+
+std::shared_ptr<control::CommandArbiter> UrDriver::getCommandArbiter()
+{
+  std::lock_guard<std::mutex> lk(command_arbiter_mutex_);
+  if (command_arbiter_ == nullptr)
+  {
+    command_arbiter_ = std::make_shared<control::CommandArbiter>(reverseInterface(), trajectoryInterface());
+  }
+  return command_arbiter_;
 }
 
 bool UrDriver::writeFreedriveControlMessage(const control::FreedriveControlMessage freedrive_action,
                                             const RobotReceiveTimeout& robot_receive_timeout)
 {
-  return reverse_interface_->writeFreedriveControlMessage(freedrive_action, robot_receive_timeout);
+  return reverseInterface().writeFreedriveControlMessage(freedrive_action, robot_receive_timeout);
 }
 
 bool UrDriver::zeroFTSensor()
 {
-  if (getVersion().major < 5)
+  if (!robot_capabilities_.supports(RobotFeature::FORCE_TORQUE_SENSOR_ZEROING))
   {
     std::stringstream ss;
     ss << "Zeroing the Force-Torque sensor is only available for e-Series robots (Major version >= 5). This robot's "
@@ -287,9 +661,9 @@ bool UrDriver::zeroFTSensor()
   }
   else
   {
-    if (script_command_interface_->clientConnected())
+    if (scriptCommandInterface().clientConnected())
     {
-      return script_command_interface_->zeroFTSensor();
+      return scriptCommandInterface().zeroFTSensor();
     }
     else
     {
@@ -304,9 +678,9 @@ bool UrDriver::zeroFTSensor()
 
 bool UrDriver::setPayload(const float mass, const vector3d_t& cog)
 {
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->setPayload(mass, &cog);
+    return scriptCommandInterface().setPayload(mass, &cog);
   }
   else
   {
@@ -339,9 +713,9 @@ bool UrDriver::setToolVoltage(const ToolVoltage voltage)
       return false;
   }
 
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->setToolVoltage(voltage);
+    return scriptCommandInterface().setToolVoltage(voltage);
   }
   else
   {
@@ -352,12 +726,68 @@ bool UrDriver::setToolVoltage(const ToolVoltage voltage)
     return sendScript(cmd.str());
   }
 }
+comm::NotifyingFuture<bool> UrDriver::zeroFTSensorAsync()
+{
+  if (!robot_capabilities_.supports(RobotFeature::FORCE_TORQUE_SENSOR_ZEROING))
+  {
+    std::stringstream ss;
+    ss << "Zeroing the Force-Torque sensor is only available for e-Series robots (Major version >= 5). This robot's "
+          "version is "
+       << getVersion();
+    URCL_LOG_ERROR(ss.str().c_str());
+    return failedAcknowledgement();
+  }
+  if (!scriptCommandInterface().clientConnected())
+  {
+    URCL_LOG_ERROR("Script command interface is not running. Unable to zero the Force-Torque sensor.");
+    return failedAcknowledgement();
+  }
+  return scriptCommandInterface().zeroFTSensorAsync();
+}
+
+comm::NotifyingFuture<bool> UrDriver::setPayloadAsync(const float mass, const vector3d_t& cog)
+{
+  if (!scriptCommandInterface().clientConnected())
+  {
+    URCL_LOG_ERROR("Script command interface is not running. Unable to set the payload.");
+    return failedAcknowledgement();
+  }
+  return scriptCommandInterface().setPayloadAsync(mass, &cog);
+}
+
+comm::NotifyingFuture<bool> UrDriver::setToolVoltageAsync(const ToolVoltage voltage)
+{
+  if (voltage != ToolVoltage::OFF && voltage != ToolVoltage::_12V && voltage != ToolVoltage::_24V)
+  {
+    std::stringstream ss;
+    ss << "The tool voltage should be 0, 12 or 24. The tool voltage is " << toUnderlying(voltage);
+    URCL_LOG_ERROR(ss.str().c_str());
+    return failedAcknowledgement();
+  }
+  if (!scriptCommandInterface().clientConnected())
+  {
+    URCL_LOG_ERROR("Script command interface is not running. Unable to set the tool voltage.");
+    return failedAcknowledgement();
+  }
+  return scriptCommandInterface().setToolVoltageAsync(voltage);
+}
+
+comm::NotifyingFuture<bool> UrDriver::sendScriptCommandBatchAsync(const control::ScriptCommandInterface::Batch& batch)
+{
+  if (!scriptCommandInterface().clientConnected())
+  {
+    URCL_LOG_ERROR("Script command interface is not running. Unable to send the script command batch.");
+    return failedAcknowledgement();
+  }
+  return scriptCommandInterface().sendBatchAsync(batch);
+}
+
 // Function for e-series robots (Needs both damping factor and gain scaling factor)
 bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_t& selection_vector,
                               const vector6d_t& wrench, const unsigned int type, const vector6d_t& limits,
                               double damping_factor, double gain_scaling_factor)
 {
-  if (robot_version_.major < 5)
+  if (!robot_capabilities_.supports(RobotFeature::FORCE_MODE_GAIN_SCALING))
   {
     std::stringstream ss;
     ss << "Force mode gain scaling factor cannot be set on a CB3 robot.";
@@ -407,9 +837,9 @@ bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_
     throw InvalidRange(ss.str().c_str());
   }
 
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->startForceMode(&task_frame, &selection_vector, &wrench, type, &limits,
+    return scriptCommandInterface().startForceMode(&task_frame, &selection_vector, &wrench, type, &limits,
                                                      damping_factor, gain_scaling_factor);
   }
   else
@@ -424,7 +854,7 @@ bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_
                               const vector6d_t& wrench, const unsigned int type, const vector6d_t& limits,
                               double damping_factor)
 {
-  if (robot_version_.major >= 5)
+  if (robot_capabilities_.supports(RobotFeature::FORCE_MODE_GAIN_SCALING))
   {
     std::stringstream ss;
     ss << "You should also specify a force mode gain scaling factor to activate force mode on an e-series robot.";
@@ -465,9 +895,9 @@ bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_
     throw InvalidRange(ss.str().c_str());
   }
 
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->startForceMode(&task_frame, &selection_vector, &wrench, type, &limits,
+    return scriptCommandInterface().startForceMode(&task_frame, &selection_vector, &wrench, type, &limits,
                                                      damping_factor, 0);
   }
   else
@@ -480,7 +910,7 @@ bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_
 bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_t& selection_vector,
                               const vector6d_t& wrench, const unsigned int type, const vector6d_t& limits)
 {
-  if (robot_version_.major < 5)
+  if (!robot_capabilities_.supports(RobotFeature::FORCE_MODE_GAIN_SCALING))
   {
     return startForceMode(task_frame, selection_vector, wrench, type, limits, force_mode_damping_factor_);
   }
@@ -493,9 +923,9 @@ bool UrDriver::startForceMode(const vector6d_t& task_frame, const vector6uint32_
 
 bool UrDriver::endForceMode()
 {
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->endForceMode();
+    return scriptCommandInterface().endForceMode();
   }
   else
   {
@@ -506,7 +936,7 @@ bool UrDriver::endForceMode()
 
 bool UrDriver::startToolContact()
 {
-  if (getVersion().major < 5)
+  if (!robot_capabilities_.supports(RobotFeature::TOOL_CONTACT))
   {
     std::stringstream ss;
     ss << "Tool contact is only available for e-Series robots (Major version >= 5). This robot's "
@@ -516,9 +946,9 @@ bool UrDriver::startToolContact()
     return false;
   }
 
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->startToolContact();
+    return scriptCommandInterface().startToolContact();
   }
   else
   {
@@ -529,7 +959,7 @@ bool UrDriver::startToolContact()
 
 bool UrDriver::endToolContact()
 {
-  if (getVersion().major < 5)
+  if (!robot_capabilities_.supports(RobotFeature::TOOL_CONTACT))
   {
     std::stringstream ss;
     ss << "Tool contact is only available for e-Series robots (Major version >= 5). This robot's "
@@ -539,9 +969,9 @@ bool UrDriver::endToolContact()
     return false;
   }
 
-  if (script_command_interface_->clientConnected())
+  if (scriptCommandInterface().clientConnected())
   {
-    return script_command_interface_->endToolContact();
+    return scriptCommandInterface().endToolContact();
   }
   else
   {
@@ -553,105 +983,273 @@ bool UrDriver::endToolContact()
 bool UrDriver::writeKeepalive(const RobotReceiveTimeout& robot_receive_timeout)
 {
   vector6d_t* fake = nullptr;
-  return reverse_interface_->write(fake, comm::ControlMode::MODE_IDLE, robot_receive_timeout);
+  return reverseInterface().write(fake, comm::ControlMode::MODE_IDLE, robot_receive_timeout);
 }
 
-void UrDriver::startRTDECommunication()
+void UrDriver::setAutomaticKeepalive(const bool enabled)
 {
-  rtde_client_->start();
+  reverseInterface().setAutomaticKeepalive(enabled);
 }
 
-bool UrDriver::stopControl()
+bool UrDriver::isAutomaticKeepaliveEnabled() const
 {
-  vector6d_t* fake = nullptr;
-  return reverse_interface_->write(fake, comm::ControlMode::MODE_STOPPED);
+  return reverseInterface().isAutomaticKeepaliveEnabled();
 }
 
-std::string UrDriver::readScriptFile(const std::string& filename)
+void UrDriver::setAsyncSetpointWrites(const bool enabled)
 {
-  std::ifstream ifs;
-  ifs.open(filename);
-  if (!ifs)
-  {
-    std::stringstream ss;
-    ss << "URScript file '" << filename << "' doesn't exists.";
-    throw UrException(ss.str().c_str());
-  }
-  std::string content((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
+  reverseInterface().setAsyncSetpointWrites(enabled);
+}
 
-  return content;
+void UrDriver::setSetpointValidity(const std::chrono::steady_clock::duration validity)
+{
+  reverseInterface().setSetpointValidity(validity);
 }
 
-bool UrDriver::checkCalibration(const std::string& checksum)
+bool UrDriver::setClientSideInverseKinematics(const bool enabled, const vector6d_t& tcp_offset)
 {
-  if (primary_stream_ == nullptr)
+  if (!enabled)
   {
-    throw std::runtime_error("checkCalibration() called without a primary interface connection being established.");
+    reverseInterface().setInverseKinematics(nullptr);
+    return true;
   }
-  primary_interface::PrimaryParser parser;
-  comm::URProducer<primary_interface::PrimaryPackage> prod(*primary_stream_, parser);
-  prod.setupProducer();
-
-  CalibrationChecker consumer(checksum);
-
-  comm::INotifier notifier;
-
-  comm::Pipeline<primary_interface::PrimaryPackage> pipeline(prod, &consumer, "Pipeline", notifier);
-  pipeline.run();
 
-  while (!consumer.isChecked())
+  primary_interface::KinematicsInfo calibration(primary_interface::RobotStateType::KINEMATICS_INFO);
+  if (!primary_client_->getCalibration(calibration))
   {
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    URCL_LOG_ERROR("Cannot solve the inverse kinematics on the client, the robot's calibration hasn't been received "
+                   "yet.");
+    return false;
   }
-  URCL_LOG_DEBUG("Got calibration information from robot.");
-  return consumer.checkSuccessful();
+  auto model = std::make_shared<kinematics::KinematicsModel>(calibration);
+  model->setTcpOffset(tcp_offset);
+  reverseInterface().setInverseKinematics(model, [this](vector6d_t& q) {
+    std::shared_ptr<rtde_interface::StateCache> cache = getStateCache();
+    if (cache == nullptr)
+    {
+      return false;
+    }
+    rtde_interface::StateSnapshot snapshot = cache->createSnapshot();
+    return cache->read(snapshot) && snapshot.getData("actual_q", q);
+  });
+  return true;
 }
 
-rtde_interface::RTDEWriter& UrDriver::getRTDEWriter()
+void UrDriver::enableSetpointInterpolation(const comm::ControlMode control_mode, const std::chrono::microseconds delay,
+                                           const RobotReceiveTimeout& robot_receive_timeout)
 {
-  return rtde_client_->getWriter();
+  if (!comm::ControlModeTypes::is_control_mode_realtime(control_mode))
+  {
+    throw UrException("Setpoint interpolation requires a realtime control mode, got " +
+                      std::to_string(toUnderlying(control_mode)));
+  }
+  if (setpoint_interpolator_ == nullptr)
+  {
+    // The output function is only called while the interpolator is running, so the command
+    // settings can be changed while it is stopped.
+    setpoint_interpolator_ = std::make_shared<control::SetpointInterpolator>([this](const vector6d_t& values) {
+      return writeJointCommand(values, interpolation_control_mode_, interpolation_receive_timeout_);
+    });
+    observeRTDEForSetpointInterpolation();
+  }
+  setpoint_interpolator_->stop();
+  interpolation_control_mode_ = control_mode;
+  interpolation_receive_timeout_ = robot_receive_timeout;
+  setpoint_interpolator_->clear();
+  setpoint_interpolator_->setDelay(delay);
+  setpoint_interpolator_->setTimeScaling(interpolation_time_scaling_);
+  setpoint_interpolator_->setThreadConfig(thread_config_.withNameSuffix("interp"));
+  setpoint_interpolator_->start();
 }
 
-bool UrDriver::sendScript(const std::string& program)
+void UrDriver::disableSetpointInterpolation()
 {
-  if (secondary_stream_ == nullptr)
+  if (setpoint_interpolator_ != nullptr)
   {
-    throw std::runtime_error("Sending script to robot requested while there is no secondary interface established. "
-                             "This should not happen.");
+    setpoint_interpolator_->stop();
   }
+}
 
-  // urscripts (snippets) must end with a newline, or otherwise the controller's runtime will
-  // not execute them. To avoid problems, we always just append a newline here, even if
-  // there may already be one.
-  auto program_with_newline = program + '\n';
+bool UrDriver::addInterpolatedSetpoint(const vector6d_t& values, const std::chrono::steady_clock::time_point time)
+{
+  if (setpoint_interpolator_ == nullptr || !setpoint_interpolator_->isRunning())
+  {
+    return false;
+  }
+  return setpoint_interpolator_->addSetpoint(values, time);
+}
 
-  size_t len = program_with_newline.size();
-  const uint8_t* data = reinterpret_cast<const uint8_t*>(program_with_newline.c_str());
-  size_t written;
+void UrDriver::setSetpointInterpolationTimeScaling(const bool enabled)
+{
+  interpolation_time_scaling_ = enabled;
+  if (setpoint_interpolator_ != nullptr)
+  {
+    setpoint_interpolator_->setTimeScaling(enabled);
+  }
+}
 
-  const auto send_script_contents = [this, program_with_newline, data, len,
-                                     &written](const std::string&& description) -> bool {
-    if (secondary_stream_->write(data, len, written))
-    {
-      URCL_LOG_DEBUG("Sent program to robot:\n%s", program_with_newline.c_str());
-      return true;
-    }
-    const std::string error_message = "Could not send program to robot: " + description;
-    URCL_LOG_ERROR(error_message.c_str());
+void UrDriver::observeRTDEForSetpointInterpolation()
+{
+  std::shared_ptr<control::SetpointInterpolator> interpolator = setpoint_interpolator_;
+  // The handles are resolved once per recipe, as the output recipe can be switched
+  rtde_client_->addDataPackageObserver(
+      [interpolator, recipe = std::shared_ptr<const rtde_interface::CompiledRecipe>(),
+       speed_scaling_handle = rtde_interface::FieldHandle<double>(),
+       speed_fraction_handle = rtde_interface::FieldHandle<double>()](
+          const rtde_interface::DataPackage& package) mutable {
+        if (package.getCompiledRecipe() != recipe)
+        {
+          recipe = package.getCompiledRecipe();
+          speed_scaling_handle = findDoubleField(*recipe, "speed_scaling");
+          speed_fraction_handle = findDoubleField(*recipe, "target_speed_fraction");
+        }
+        double speed_scaling = 1.0;
+        double speed_fraction = 1.0;
+        package.getData(speed_scaling_handle, speed_scaling);
+        package.getData(speed_fraction_handle, speed_fraction);
+        interpolator->notifyCycle(package.getTimestamps().receive, speed_scaling * speed_fraction);
+      });
+}
+
+void UrDriver::enableRTDESynchronizedCommands(const comm::ControlMode control_mode,
+                                              control::RTDECommandScheduler::CommandCallback callback,
+                                              const RobotReceiveTimeout& robot_receive_timeout)
+{
+  if (command_scheduler_ == nullptr)
+  {
+    command_scheduler_ =
+        std::make_shared<control::RTDECommandScheduler>(reverseInterface(), control_mode, robot_receive_timeout);
+    observeRTDEForCommandScheduling();
+  }
+  command_scheduler_->setActive(false);
+  command_scheduler_->setControlMode(control_mode, robot_receive_timeout);
+  command_scheduler_->setCommandCallback(callback);
+  command_scheduler_->clearCommand();
+  command_scheduler_->setActive(true);
+}
+
+void UrDriver::disableRTDESynchronizedCommands()
+{
+  if (command_scheduler_ != nullptr)
+  {
+    command_scheduler_->setActive(false);
+  }
+}
+
+bool UrDriver::setRTDESynchronizedCommand(const vector6d_t& values)
+{
+  if (command_scheduler_ == nullptr || !command_scheduler_->isActive())
+  {
     return false;
+  }
+  command_scheduler_->setCommand(values);
+  return true;
+}
+
+void UrDriver::observeRTDEForScriptState()
+{
+  std::shared_ptr<control::ScriptStateMonitor> monitor = script_state_monitor_;
+  rtde_client_->addFieldChangeCallback<int32_t>("output_int_register_" + std::to_string(state_output_register_),
+                                                [monitor](const int32_t& state) { monitor->update(state); });
+}
+
+void UrDriver::observeRTDEForTrajectoryStart()
+{
+  if (rtde_client_->getClockSynchronizer() == nullptr)
+  {
+    rtde_client_->setClockSynchronization(true);
+  }
+  std::shared_ptr<control::TrajectoryStartTrigger> trigger = trajectory_start_trigger_;
+  rtde_interface::RTDEWriter* writer = &rtde_client_->getWriter();
+  const uint32_t register_index = static_cast<uint32_t>(trajectory_start_register_);
+  control::TrajectoryStartTrigger::WriteFunction write = [writer, register_index](const int32_t token) {
+    return writer->sendInputIntRegister(register_index, token);
   };
+  rtde_client_->addDataPackageObserver(
+      [trigger, write](const rtde_interface::DataPackage& package) { trigger->onDataPackage(package, write); });
+}
 
-  if (send_script_contents("initial attempt"))
+void UrDriver::observeRTDEForTrajectoryProgress()
+{
+  std::shared_ptr<control::TrajectoryProgressMonitor> monitor = trajectory_progress_monitor_;
+  rtde_client_->addDataPackageObserver(
+      [monitor](const rtde_interface::DataPackage& package) { monitor->onDataPackage(package); });
+}
+
+void UrDriver::observeRTDEForSetpointLatency()
+{
+  std::shared_ptr<control::SetpointLatencyMonitor> monitor = setpoint_latency_monitor_;
+  rtde_client_->addDataPackageObserver(
+      [monitor](const rtde_interface::DataPackage& package) { monitor->onDataPackage(package); });
+}
+
+void UrDriver::observeRTDEForRegisterTransfer()
+{
+  std::shared_ptr<rtde_interface::RegisterTransfer> transfer = register_transfer_;
+  rtde_client_->addFieldChangeCallback<int32_t>(transfer->getConfig().getAckField(), [transfer](const int32_t& control) {
+    transfer->onAcknowledgement(control);
+  });
+}
+
+void UrDriver::observeRTDEForCommandScheduling()
+{
+  std::shared_ptr<control::RTDECommandScheduler> scheduler = command_scheduler_;
+  rtde_client_->addDataPackageObserver(
+      [scheduler](const rtde_interface::DataPackage& package) { scheduler->onDataPackage(package); });
+}
+
+void UrDriver::startRTDECommunication()
+{
+  rtde_client_->start();
+}
+
+bool UrDriver::stopControl()
+{
+  // Leaving trajectory forwarding cancels the trajectory including the upload in progress, see
+  // ReverseInterface::setTrajectoryWritesCanceler()
+  vector6d_t* fake = nullptr;
+  return reverseInterface().write(fake, comm::ControlMode::MODE_STOPPED);
+}
+
+std::string UrDriver::readScriptFile(const std::string& filename)
+{
+  std::ifstream ifs;
+  ifs.open(filename);
+  if (!ifs)
   {
-    return true;
+    std::stringstream ss;
+    ss << "URScript file '" << filename << "' doesn't exists.";
+    throw UrException(ss.str().c_str());
   }
+  std::string content((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
 
-  if (reconnectSecondaryStream())
+  return content;
+}
+
+bool UrDriver::checkCalibration(const std::string& checksum)
+{
+  if (primary_client_ == nullptr)
   {
-    return send_script_contents("after reconnecting secondary stream");
+    throw std::runtime_error("checkCalibration() called without a primary interface connection being established.");
   }
+  return primary_client_->checkCalibration(checksum);
+}
 
-  return false;
+rtde_interface::RTDEWriter& UrDriver::getRTDEWriter()
+{
+  return rtde_client_->getWriter();
+}
+
+bool UrDriver::sendScript(const std::string& program)
+{
+  if (primary_client_ == nullptr)
+  {
+    throw std::runtime_error("Sending script to robot requested while there is no primary interface established. "
+                             "This should not happen.");
+  }
+  // The primary client keeps its connection open and reconnects in the background, so the script
+  // is sent right away without a new handshake.
+  return primary_client_->sendScript(program);
 }
 
 bool UrDriver::sendRobotProgram()
@@ -667,17 +1265,276 @@ bool UrDriver::sendRobotProgram()
   }
 }
 
-bool UrDriver::reconnectSecondaryStream()
+void UrDriver::setScriptMinifier(const std::optional<ScriptMinifier>& minifier)
+{
+  // Minify first, so a script that cannot be minified leaves the current program in place.
+  const std::string program = minifier ? minifier->minify(robot_program_) : robot_program_;
+  script_minifier_ = minifier;
+  updateRobotProgram(program);
+}
+
+void UrDriver::setResidentProgram(const bool resident)
 {
-  URCL_LOG_DEBUG("Closing secondary stream...");
-  secondary_stream_->close();
-  if (secondary_stream_->connect())
+  script_parameters_[RESIDENT_PROGRAM_REPLACE] = resident ? "True" : "False";
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+void UrDriver::setStandbyHost(const std::string& standby_ip, const std::chrono::milliseconds failover_timeout)
+{
+  if (failover_timeout.count() <= 0)
   {
-    URCL_LOG_DEBUG("Secondary stream connected");
-    return true;
+    throw UrException("The failover timeout has to be positive, got " + std::to_string(failover_timeout.count()) +
+                      " ms");
+  }
+  script_parameters_[STANDBY_SERVER_IP_REPLACE] = standby_ip;
+  std::ostringstream timeout;
+  timeout << std::chrono::duration<double>(failover_timeout).count();
+  script_parameters_[FAILOVER_TIMEOUT_REPLACE] = timeout.str();
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+  reverseInterface().setParkedHeartbeatPeriod(standby_ip.empty() ? std::chrono::milliseconds(0) :
+                                                                   failover_timeout / 4);
+}
+
+bool UrDriver::takeOver(const std::chrono::milliseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!reverseInterface().isConnected())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      if (!in_headless_mode_)
+      {
+        URCL_LOG_ERROR("The program didn't fail over within %ld ms", static_cast<long>(timeout.count()));
+        return false;
+      }
+      URCL_LOG_WARN("The program didn't fail over within %ld ms, sending it to the robot",
+                    static_cast<long>(timeout.count()));
+      return sendRobotProgram();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  URCL_LOG_INFO("Took over control over the robot");
+  return true;
+}
+
+void UrDriver::setTrajectoryCacheCapacity(const size_t num_points)
+{
+  script_parameters_[TRAJECTORY_CACHE_CAPACITY_REPLACE] = std::to_string(num_points);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+void UrDriver::setStateOutputRegister(const int register_index)
+{
+  if (register_index < 0 || register_index > 47)
+  {
+    throw UrException("The state can only be mirrored into the output integer registers 0 to 47, got " +
+                      std::to_string(register_index));
+  }
+  if (state_output_register_ == register_index)
+  {
+    return;
+  }
+  if (state_output_register_ >= 0)
+  {
+    throw UrException("The state is mirrored into output_int_register_" + std::to_string(state_output_register_) +
+                      " already.");
+  }
+  const std::string field = "output_int_register_" + std::to_string(register_index);
+  const std::vector<std::string> recipe = rtde_client_->getOutputRecipe();
+  if (std::find(recipe.begin(), recipe.end(), field) == recipe.end())
+  {
+    throw UrException("The state cannot be mirrored into " + field + " as it isn't part of the output recipe.");
+  }
+
+  state_output_register_ = register_index;
+  observeRTDEForScriptState();
+  script_parameters_[STATE_OUTPUT_REGISTER_REPLACE] = std::to_string(register_index);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+void UrDriver::setTrajectoryStartRegister(const int register_index)
+{
+  if (register_index < 24 || register_index > 47)
+  {
+    throw UrException("Trajectories can only be started using the input integer registers 24 to 47, got " +
+                      std::to_string(register_index));
+  }
+  if (trajectory_start_register_ == register_index)
+  {
+    return;
+  }
+  if (trajectory_start_register_ >= 0)
+  {
+    throw UrException("Trajectories are started using input_int_register_" +
+                      std::to_string(trajectory_start_register_) + " already.");
+  }
+
+  trajectory_start_register_ = register_index;
+  trajectory_start_trigger_ = std::make_shared<control::TrajectoryStartTrigger>();
+  observeRTDEForTrajectoryStart();
+  script_parameters_[TRAJECTORY_START_REGISTER_REPLACE] = std::to_string(register_index);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+void UrDriver::setTrajectoryProgressRegisters(const int index_register, const int time_register)
+{
+  if (index_register < 0 || index_register > 47 || time_register < 0 || time_register > 47)
+  {
+    throw UrException("The trajectory progress can only be mirrored into the output registers 0 to 47, got " +
+                      std::to_string(index_register) + " and " + std::to_string(time_register));
+  }
+  if (trajectory_progress_monitor_ != nullptr)
+  {
+    throw UrException("The trajectory progress is mirrored into " + trajectory_progress_monitor_->getIndexField() +
+                      " and " + trajectory_progress_monitor_->getTimeField() + " already.");
+  }
+  auto monitor = std::make_shared<control::TrajectoryProgressMonitor>(index_register, time_register);
+  const std::vector<std::string> recipe = rtde_client_->getOutputRecipe();
+  for (const std::string& field : { monitor->getIndexField(), monitor->getTimeField() })
+  {
+    if (std::find(recipe.begin(), recipe.end(), field) == recipe.end())
+    {
+      throw UrException("The trajectory progress cannot be mirrored into " + field +
+                        " as it isn't part of the output recipe.");
+    }
+  }
+
+  monitor->setProgressCallback(trajectory_progress_cb_);
+  trajectory_progress_monitor_ = monitor;
+  observeRTDEForTrajectoryProgress();
+  script_parameters_[TRAJECTORY_PROGRESS_INDEX_REGISTER_REPLACE] = std::to_string(index_register);
+  script_parameters_[TRAJECTORY_PROGRESS_TIME_REGISTER_REPLACE] = std::to_string(time_register);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+void UrDriver::setSetpointEchoRegister(const int echo_register)
+{
+  if (echo_register < 0 || echo_register > 47)
+  {
+    throw UrException("Setpoints can only be echoed into the output integer registers 0 to 47, got " +
+                      std::to_string(echo_register));
+  }
+  if (setpoint_latency_monitor_ != nullptr)
+  {
+    throw UrException("Setpoints are echoed into " + setpoint_latency_monitor_->getEchoField() + " already.");
+  }
+  auto monitor = std::make_shared<control::SetpointLatencyMonitor>(echo_register);
+  const std::vector<std::string> recipe = rtde_client_->getOutputRecipe();
+  if (std::find(recipe.begin(), recipe.end(), monitor->getEchoField()) == recipe.end())
+  {
+    throw UrException("Setpoints cannot be echoed into " + monitor->getEchoField() +
+                      " as it isn't part of the output recipe.");
+  }
+
+  reverseInterface().setSetpointLatencyMonitor(monitor);
+  setpoint_latency_monitor_ = monitor;
+  observeRTDEForSetpointLatency();
+  script_parameters_[SETPOINT_ECHO_REGISTER_REPLACE] = std::to_string(echo_register);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+bool UrDriver::setServojParameters(const double lookahead_time, const uint32_t gain)
+{
+  return reverseInterface().writeServoParameters(lookahead_time, gain);
+}
+
+void UrDriver::setAdaptiveServojTuning(const bool enabled, const control::AdaptiveServojConfig& config)
+{
+  reverseInterface().setAdaptiveServojTuner(
+      enabled ? std::make_shared<control::AdaptiveServojTuner>(config, servoj_lookahead_time_, servoj_gain_) : nullptr);
+}
+
+std::shared_ptr<const control::AdaptiveServojTuner> UrDriver::getAdaptiveServojTuner() const
+{
+  return reverseInterface().getAdaptiveServojTuner();
+}
+
+void UrDriver::enableRegisterTransfer(const rtde_interface::RegisterTransferConfig& config)
+{
+  if (register_transfer_ != nullptr)
+  {
+    throw UrException("Register transfers have been enabled already.");
+  }
+
+  auto transfer = std::make_shared<rtde_interface::RegisterTransfer>(config);
+  register_transfer_ = transfer;
+  observeRTDEForRegisterTransfer();
+  script_parameters_[REGISTER_TRANSFER_CONTROL_REPLACE] = std::to_string(config.control_register);
+  script_parameters_[REGISTER_TRANSFER_ACK_REPLACE] = std::to_string(config.ack_register);
+  script_parameters_[REGISTER_TRANSFER_FIRST_DATA_REPLACE] = std::to_string(config.first_data_register);
+  script_parameters_[REGISTER_TRANSFER_NUM_DATA_REPLACE] = std::to_string(config.num_data_registers);
+  script_parameters_[REGISTER_TRANSFER_CAPACITY_REPLACE] = std::to_string(config.capacity);
+  robot_program_ = scriptTemplate().render(script_parameters_);
+  updateRobotProgram(script_minifier_ ? script_minifier_->minify(robot_program_) : robot_program_);
+}
+
+bool UrDriver::sendRegisterArray(const std::vector<double>& values, const int32_t id,
+                                 const std::chrono::milliseconds chunk_timeout)
+{
+  if (register_transfer_ == nullptr)
+  {
+    throw UrException("Register transfers haven't been enabled, see enableRegisterTransfer().");
+  }
+
+  const rtde_interface::RegisterTransferConfig& config = register_transfer_->getConfig();
+  // Created per transfer, as the writer is replaced when the RTDE client is reset
+  std::unique_ptr<rtde_interface::InputRegisterBank> bank =
+      rtde_client_->getWriter().createInputRegisterBank(config.getInputRegisters());
+  rtde_interface::RegisterTransfer::WriteFunction write = [&bank, &config](const int32_t control,
+                                                                           const std::vector<double>& data) {
+    bool success = bank->setIntRegister(config.control_register, control);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+      success = bank->setDoubleRegister(config.first_data_register + static_cast<uint32_t>(i), data[i]) && success;
+    }
+    if (success)
+    {
+      bank->publish();
+    }
+    return success;
+  };
+  return register_transfer_->send(values, id, write, chunk_timeout);
+}
+
+bool UrDriver::isProgramParked() const
+{
+  return reverseInterface().isProgramParked();
+}
+
+void UrDriver::setSessionResumeTimeout(const std::chrono::milliseconds timeout)
+{
+  reverseInterface().setSessionResumeTimeout(timeout);
+}
+
+void UrDriver::updateRobotProgram(const std::string& program)
+{
+  if (!in_headless_mode_)
+  {
+    if (script_sender_ != nullptr)
+    {
+      script_sender_->setProgram(program);
+    }
+    return;
   }
-  URCL_LOG_ERROR("Failed to reconnect secondary stream!");
-  return false;
+
+  full_robot_program_ = "stop program\n";
+  full_robot_program_ += "def externalControl():\n";
+  std::istringstream prog_stream(program);
+  std::string line;
+  // Indentation is not needed by the robot, so a minified program is not indented.
+  const std::string indentation = script_minifier_ ? "" : "\t";
+  while (std::getline(prog_stream, line))
+  {
+    full_robot_program_ += indentation + line + "\n";
+  }
+  full_robot_program_ += "end\n";
 }
 
 std::vector<std::string> UrDriver::getRTDEOutputRecipe()
@@ -692,26 +1549,311 @@ void UrDriver::setKeepaliveCount(const uint32_t count)
                 "set the "
                 "read timeout in the write commands directly. This keepalive count will overwrite the timeout passed "
                 "to the write functions.");
-  reverse_interface_->setKeepaliveCount(count);
+  reverseInterface().setKeepaliveCount(count);
 }
 
 void UrDriver::resetRTDEClient(const std::vector<std::string>& output_recipe,
                                const std::vector<std::string>& input_recipe, double target_frequency,
                                bool ignore_unavailable_outputs)
 {
+  // The health monitor samples the RTDE client from its own thread
+  const bool monitoring = health_monitor_ != nullptr && health_monitor_->isRunning();
+  if (monitoring)
+  {
+    health_monitor_->stop();
+  }
   rtde_client_.reset(new rtde_interface::RTDEClient(robot_ip_, notifier_, output_recipe, input_recipe, target_frequency,
                                                     ignore_unavailable_outputs));
+  rtde_client_->setStateCaching(true);
+  if (setpoint_interpolator_ != nullptr)
+  {
+    observeRTDEForSetpointInterpolation();
+  }
+  if (command_scheduler_ != nullptr)
+  {
+    observeRTDEForCommandScheduling();
+  }
+  if (state_output_register_ >= 0)
+  {
+    observeRTDEForScriptState();
+  }
+  if (trajectory_start_trigger_ != nullptr)
+  {
+    observeRTDEForTrajectoryStart();
+  }
+  if (trajectory_progress_monitor_ != nullptr)
+  {
+    observeRTDEForTrajectoryProgress();
+  }
+  if (setpoint_latency_monitor_ != nullptr)
+  {
+    observeRTDEForSetpointLatency();
+  }
+  if (register_transfer_ != nullptr)
+  {
+    observeRTDEForRegisterTransfer();
+  }
+  rtde_client_->setThreadConfig(thread_config_.withNameSuffix("rtde"));
+  rtde_client_->setLatencyInstrumentation(rtde_latency_instrumentation_);
+  configureStaleRTDEStreamDetection();
+  for (const auto& subscription : io_edge_subscriptions_)
+  {
+    rtde_client_->addIOEdgeCallback(subscription.bank, subscription.pin, subscription.edge, subscription.callback);
+  }
+  rtde_client_->setOutputFrequencyPolicy(rtde_frequency_policy_);
+  if (rtde_queue_capacity_ > 0)
+  {
+    rtde_client_->setPipelineQueue(rtde_queue_capacity_, rtde_queue_policy_);
+  }
+  if (socket_options_)
+  {
+    rtde_client_->setSocketOptions(*socket_options_);
+  }
+  if (monitoring)
+  {
+    health_monitor_->start();
+  }
   initRTDE();
 }
 
 void UrDriver::resetRTDEClient(const std::string& output_recipe_filename, const std::string& input_recipe_filename,
                                double target_frequency, bool ignore_unavailable_outputs)
 {
+  // The health monitor samples the RTDE client from its own thread
+  const bool monitoring = health_monitor_ != nullptr && health_monitor_->isRunning();
+  if (monitoring)
+  {
+    health_monitor_->stop();
+  }
   rtde_client_.reset(new rtde_interface::RTDEClient(robot_ip_, notifier_, output_recipe_filename, input_recipe_filename,
                                                     target_frequency, ignore_unavailable_outputs));
+  rtde_client_->setStateCaching(true);
+  if (setpoint_interpolator_ != nullptr)
+  {
+    observeRTDEForSetpointInterpolation();
+  }
+  if (command_scheduler_ != nullptr)
+  {
+    observeRTDEForCommandScheduling();
+  }
+  if (state_output_register_ >= 0)
+  {
+    observeRTDEForScriptState();
+  }
+  if (trajectory_start_trigger_ != nullptr)
+  {
+    observeRTDEForTrajectoryStart();
+  }
+  if (trajectory_progress_monitor_ != nullptr)
+  {
+    observeRTDEForTrajectoryProgress();
+  }
+  if (setpoint_latency_monitor_ != nullptr)
+  {
+    observeRTDEForSetpointLatency();
+  }
+  if (register_transfer_ != nullptr)
+  {
+    observeRTDEForRegisterTransfer();
+  }
+  rtde_client_->setThreadConfig(thread_config_.withNameSuffix("rtde"));
+  rtde_client_->setLatencyInstrumentation(rtde_latency_instrumentation_);
+  configureStaleRTDEStreamDetection();
+  for (const auto& subscription : io_edge_subscriptions_)
+  {
+    rtde_client_->addIOEdgeCallback(subscription.bank, subscription.pin, subscription.edge, subscription.callback);
+  }
+  rtde_client_->setOutputFrequencyPolicy(rtde_frequency_policy_);
+  if (rtde_queue_capacity_ > 0)
+  {
+    rtde_client_->setPipelineQueue(rtde_queue_capacity_, rtde_queue_policy_);
+  }
+  if (socket_options_)
+  {
+    rtde_client_->setSocketOptions(*socket_options_);
+  }
+  if (monitoring)
+  {
+    health_monitor_->start();
+  }
   initRTDE();
 }
 
+bool UrDriver::switchRTDEOutputRecipe(const std::vector<std::string>& output_recipe)
+{
+  return rtde_client_->switchOutputRecipe(output_recipe);
+}
+
+void UrDriver::setThreadConfig(const ThreadConfig& config)
+{
+  thread_config_ = config;
+  rtde_client_->setThreadConfig(thread_config_.withNameSuffix("rtde"));
+  if (reverse_interface_ != nullptr)
+  {
+    reverse_interface_->setThreadConfig(thread_config_.withNameSuffix("rev"));
+    reverse_interface_->setSetpointWriterThreadConfig(thread_config_.withNameSuffix("rev_tx"));
+  }
+  if (trajectory_interface_ != nullptr)
+  {
+    trajectory_interface_->setThreadConfig(thread_config_.withNameSuffix("traj"));
+  }
+  if (script_command_interface_ != nullptr)
+  {
+    script_command_interface_->setThreadConfig(thread_config_.withNameSuffix("cmd"));
+  }
+  if (script_sender_ != nullptr)
+  {
+    script_sender_->setThreadConfig(thread_config_.withNameSuffix("script"));
+  }
+  if (health_monitor_ != nullptr)
+  {
+    health_monitor_->setThreadConfig(thread_config_.withNameSuffix("health"));
+  }
+  if (setpoint_interpolator_ != nullptr)
+  {
+    setpoint_interpolator_->setThreadConfig(thread_config_.withNameSuffix("interp"));
+  }
+}
+
+void UrDriver::setSocketOptions(const comm::SocketOptions& options)
+{
+  socket_options_ = options;
+  rtde_client_->setSocketOptions(options);
+  primary_client_->setSocketOptions(options);
+  if (reverse_interface_ != nullptr)
+  {
+    reverse_interface_->setSocketOptions(options);
+  }
+  if (trajectory_interface_ != nullptr)
+  {
+    trajectory_interface_->setSocketOptions(options);
+  }
+  if (script_command_interface_ != nullptr)
+  {
+    script_command_interface_->setSocketOptions(options);
+  }
+  if (script_sender_ != nullptr)
+  {
+    script_sender_->setSocketOptions(options);
+  }
+}
+
+void UrDriver::setReactor(std::shared_ptr<comm::Reactor> reactor)
+{
+  if (reverse_interface_ != nullptr)
+  {
+    reverse_interface_->setReactor(reactor);
+  }
+  if (trajectory_interface_ != nullptr)
+  {
+    trajectory_interface_->setReactor(reactor);
+  }
+  if (script_command_interface_ != nullptr)
+  {
+    script_command_interface_->setReactor(reactor);
+  }
+  if (script_sender_ != nullptr)
+  {
+    script_sender_->setReactor(reactor);
+  }
+}
+
+void UrDriver::startConnectionHealthMonitoring(const std::chrono::milliseconds sample_interval)
+{
+  health_monitor_.reset(new comm::ConnectionHealthMonitor(sample_interval));
+  health_monitor_->addConnection("rtde", [this](comm::TcpStatistics& stats) {
+    return rtde_client_->getTcpStatistics(stats);
+  });
+  health_monitor_->addConnection("primary", [this](comm::TcpStatistics& stats) {
+    return primary_client_->getTcpStatistics(stats);
+  });
+  if (reverse_interface_ != nullptr)
+  {
+    health_monitor_->addConnection("reverse", [this](comm::TcpStatistics& stats) {
+      return reverse_interface_->getTcpStatistics(stats);
+    });
+  }
+  if (trajectory_interface_ != nullptr)
+  {
+    health_monitor_->addConnection("trajectory", [this](comm::TcpStatistics& stats) {
+      return trajectory_interface_->getTcpStatistics(stats);
+    });
+  }
+  if (script_command_interface_ != nullptr)
+  {
+    health_monitor_->addConnection("script_command", [this](comm::TcpStatistics& stats) {
+      return script_command_interface_->getTcpStatistics(stats);
+    });
+  }
+  health_monitor_->setThreadConfig(thread_config_.withNameSuffix("health"));
+  health_monitor_->start();
+}
+
+void UrDriver::stopConnectionHealthMonitoring()
+{
+  if (health_monitor_ != nullptr)
+  {
+    health_monitor_->stop();
+  }
+}
+
+void UrDriver::setRTDELatencyInstrumentation(const bool enabled)
+{
+  rtde_latency_instrumentation_ = enabled;
+  rtde_client_->setLatencyInstrumentation(enabled);
+}
+
+void UrDriver::setStaleRTDEStreamDetection(const size_t missed_periods, std::function<void(bool)> stale_callback)
+{
+  stale_stream_periods_ = missed_periods;
+  stale_stream_callback_ = std::move(stale_callback);
+  configureStaleRTDEStreamDetection();
+}
+
+void UrDriver::addIOEdgeCallback(const rtde_interface::IOBank bank, const uint8_t pin,
+                                 const rtde_interface::IOEdge edge, rtde_interface::IOEventEngine::EdgeCallback callback)
+{
+  rtde_client_->addIOEdgeCallback(bank, pin, edge, callback);
+  io_edge_subscriptions_.push_back({ bank, pin, edge, callback });
+}
+
+void UrDriver::setRTDEOutputFrequencyPolicy(std::shared_ptr<rtde_interface::OutputFrequencyPolicy> policy)
+{
+  rtde_client_->setOutputFrequencyPolicy(policy);
+  rtde_frequency_policy_ = policy;
+}
+
+void UrDriver::setRTDEPipelineQueue(const size_t capacity, const comm::OverflowPolicy policy)
+{
+  rtde_client_->setPipelineQueue(capacity, policy);
+  rtde_queue_capacity_ = capacity;
+  rtde_queue_policy_ = policy;
+}
+
+void UrDriver::configureStaleRTDEStreamDetection()
+{
+  rtde_client_->setStaleStreamDetection(stale_stream_periods_);
+  std::shared_ptr<rtde_interface::StreamWatchdog> watchdog = rtde_client_->getStreamWatchdog();
+  if (watchdog == nullptr)
+  {
+    if (reverse_interface_ != nullptr)
+    {
+      reverse_interface_->setRobotStateStale(false);
+    }
+    return;
+  }
+  watchdog->setStaleCallback([this](bool stale) {
+    if (reverse_interface_ != nullptr)
+    {
+      reverse_interface_->setRobotStateStale(stale);
+    }
+    if (stale_stream_callback_)
+    {
+      stale_stream_callback_(stale);
+    }
+  });
+}
+
 void UrDriver::initRTDE()
 {
   if (!rtde_client_->init())
@@ -720,6 +1862,46 @@ void UrDriver::initRTDE()
   }
 }
 
+control::ReverseInterface& UrDriver::reverseInterface() const
+{
+  if (reverse_interface_ == nullptr)
+  {
+    throw UrException("The driver has been created without DriverCapabilities::REVERSE_INTERFACE, so it can't send "
+                      "commands to the robot.");
+  }
+  return *reverse_interface_;
+}
+
+control::TrajectoryPointInterface& UrDriver::trajectoryInterface() const
+{
+  if (trajectory_interface_ == nullptr)
+  {
+    throw UrException("The driver has been created without DriverCapabilities::TRAJECTORY_INTERFACE, so it can't "
+                      "forward trajectories to the robot.");
+  }
+  return *trajectory_interface_;
+}
+
+control::ScriptCommandInterface& UrDriver::scriptCommandInterface() const
+{
+  if (script_command_interface_ == nullptr)
+  {
+    throw UrException("The driver has been created without DriverCapabilities::SCRIPT_COMMAND_INTERFACE, so it can't "
+                      "send script commands to the robot.");
+  }
+  return *script_command_interface_;
+}
+
+const ScriptTemplate& UrDriver::scriptTemplate() const
+{
+  if (script_template_ == nullptr)
+  {
+    throw UrException("The driver has been created without DriverCapabilities::REVERSE_INTERFACE, so there is no "
+                      "robot program to change.");
+  }
+  return *script_template_;
+}
+
 void UrDriver::setupReverseInterface(const uint32_t reverse_port)
 {
   auto rtde_frequency = rtde_client_->getTargetFrequency();
@@ -0,0 +1,240 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/ur_driver_group.h"
+#include "ur_client_library/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+namespace urcl
+{
+namespace
+{
+// A start register keeps the token written last, possibly by an earlier process. Starting from the
+// clock makes it unlikely that a new token matches it.
+int32_t nextStartToken()
+{
+  static std::atomic<int32_t> token(
+      static_cast<int32_t>(std::chrono::steady_clock::now().time_since_epoch().count() & 0x3fffffff));
+  int32_t next;
+  do
+  {
+    next = ++token & 0x7fffffff;
+  } while (next == 0);
+  return next;
+}
+}  // namespace
+
+UrDriverGroup::UrDriverGroup(const size_t num_io_threads, const ThreadConfig& io_thread_config)
+  : reactor_(std::make_shared<comm::Reactor>(num_io_threads))
+{
+  for (size_t i = 0; i < reactor_->getNumLoops(); ++i)
+  {
+    ThreadConfig config = io_thread_config.withNameSuffix(std::to_string(i));
+    if (!io_thread_config.cpus.empty())
+    {
+      config.cpus = { io_thread_config.cpus[i % io_thread_config.cpus.size()] };
+    }
+    reactor_->setLoopThreadConfig(i, config);
+  }
+}
+
+UrDriverGroup::~UrDriverGroup()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& driver : drivers_)
+  {
+    driver->setReactor(nullptr);
+  }
+}
+
+size_t UrDriverGroup::addDriver(std::shared_ptr<UrDriver> driver)
+{
+  driver->setRTDELatencyInstrumentation(true);
+  driver->setReactor(reactor_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  drivers_.push_back(driver);
+  thread_configs_.push_back(ThreadConfig());
+  URCL_LOG_DEBUG("Added driver for robot %s to driver group.", driver->getRobotIP().c_str());
+  return drivers_.size() - 1;
+}
+
+size_t UrDriverGroup::addDriver(const std::function<std::shared_ptr<UrDriver>()>& factory,
+                                const ThreadConfig& thread_config)
+{
+  std::shared_ptr<UrDriver> driver;
+  runOnNumaNode(thread_config, [&]() { driver = factory(); });
+  driver->setThreadConfig(thread_config);
+  URCL_LOG_DEBUG("Created driver for robot %s on NUMA node %i.", driver->getRobotIP().c_str(),
+                 getNumaNode(thread_config));
+  const size_t index = addDriver(driver);
+  std::lock_guard<std::mutex> lock(mutex_);
+  thread_configs_[index] = thread_config;
+  return index;
+}
+
+std::shared_ptr<UrDriver> UrDriverGroup::getDriver(const size_t index) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return drivers_.at(index);
+}
+
+size_t UrDriverGroup::getNumDrivers() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return drivers_.size();
+}
+
+void UrDriverGroup::startRTDECommunication()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < drivers_.size(); ++i)
+  {
+    // Starting binds the RTDE client to its recipe and creates its threads, which inherit the node
+    runOnNumaNode(thread_configs_[i], [this, i]() { drivers_[i]->startRTDECommunication(); });
+  }
+}
+
+std::vector<DriverHealth> UrDriverGroup::getHealth() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<DriverHealth> health;
+  health.reserve(drivers_.size());
+  for (const auto& driver : drivers_)
+  {
+    DriverHealth entry;
+    entry.robot_ip = driver->getRobotIP();
+    entry.reverse_interface_connected = driver->isReverseInterfaceConnected();
+    entry.num_dropped_rtde_packages = driver->getNumDroppedRTDEPackages();
+    entry.latency_statistics = driver->getRTDELatencyStatistics();
+    health.push_back(entry);
+  }
+  return health;
+}
+
+size_t UrDriverGroup::getNumConnected() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t num_connected = 0;
+  for (const auto& driver : drivers_)
+  {
+    if (driver->isReverseInterfaceConnected())
+    {
+      ++num_connected;
+    }
+  }
+  return num_connected;
+}
+
+std::shared_ptr<comm::LatencyStatistics> UrDriverGroup::getAggregatedLatencyStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto aggregated = std::make_shared<comm::LatencyStatistics>();
+  for (const auto& driver : drivers_)
+  {
+    std::shared_ptr<comm::LatencyStatistics> statistics = driver->getRTDELatencyStatistics();
+    if (statistics != nullptr)
+    {
+      aggregated->merge(*statistics);
+    }
+  }
+  return aggregated;
+}
+
+bool UrDriverGroup::armTrajectories(const std::vector<int>& point_numbers,
+                                    const RobotReceiveTimeout& robot_receive_timeout)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (point_numbers.size() != drivers_.size())
+  {
+    throw UrException("Got " + std::to_string(point_numbers.size()) + " trajectories for " +
+                      std::to_string(drivers_.size()) + " drivers.");
+  }
+  start_token_ = nextStartToken();
+  bool armed = true;
+  for (size_t i = 0; i < drivers_.size(); ++i)
+  {
+    if (!drivers_[i]->armTrajectory(start_token_, point_numbers[i], robot_receive_timeout))
+    {
+      URCL_LOG_ERROR("Failed to arm the trajectory of robot %s.", drivers_[i]->getRobotIP().c_str());
+      armed = false;
+    }
+  }
+  return armed;
+}
+
+bool UrDriverGroup::startArmedTrajectories(const std::chrono::milliseconds lead_time,
+                                           const std::chrono::milliseconds timeout)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (start_token_ == 0)
+  {
+    URCL_LOG_ERROR("No trajectories have been armed.");
+    return false;
+  }
+  const int32_t token = start_token_;
+  start_token_ = 0;
+
+  const auto start_time = std::chrono::steady_clock::now() + lead_time;
+  bool started = true;
+  for (auto& driver : drivers_)
+  {
+    if (!driver->scheduleTrajectoryStart(token, start_time))
+    {
+      URCL_LOG_ERROR("Failed to schedule the trajectory start of robot %s.", driver->getRobotIP().c_str());
+      started = false;
+      break;
+    }
+  }
+  for (auto& driver : drivers_)
+  {
+    std::shared_ptr<control::TrajectoryStartTrigger> trigger = driver->getTrajectoryStartTrigger();
+    if (!started)
+    {
+      if (trigger != nullptr)
+      {
+        trigger->cancel();
+      }
+      continue;
+    }
+    const auto remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(start_time + timeout - std::chrono::steady_clock::now());
+    if (!trigger->waitForTrigger(std::max(remaining, std::chrono::milliseconds(0))))
+    {
+      URCL_LOG_ERROR("The trajectory of robot %s hasn't been started in time.", driver->getRobotIP().c_str());
+      trigger->cancel();
+      started = false;
+    }
+  }
+  return started;
+}
+}  // namespace urcl
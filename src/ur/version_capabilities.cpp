@@ -0,0 +1,164 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <array>
+
+#include <ur_client_library/ur/version_capabilities.h>
+
+namespace urcl
+{
+namespace
+{
+struct MinimumVersion
+{
+  bool available;
+  uint32_t major;
+  uint32_t minor;
+};
+
+constexpr MinimumVersion NOT_AVAILABLE{ false, 0, 0 };
+
+constexpr MinimumVersion since(const uint32_t major_version, const uint32_t minor_version)
+{
+  return MinimumVersion{ true, major_version, minor_version };
+}
+
+struct DashboardCommandEntry
+{
+  DashboardCommand command;
+  const char* name;
+  MinimumVersion e_series;
+  MinimumVersion cb3;
+};
+
+// Ordered like DashboardCommand
+const std::array<DashboardCommandEntry, VersionCapabilities::NUM_DASHBOARD_COMMANDS> DASHBOARD_COMMANDS = { {
+    { DashboardCommand::POWER_OFF, "power off", since(5, 0), since(3, 0) },
+    { DashboardCommand::POWER_ON, "power on", since(5, 0), since(3, 0) },
+    { DashboardCommand::BRAKE_RELEASE, "brake release", since(5, 0), since(3, 0) },
+    { DashboardCommand::LOAD_PROGRAM, "load <program>", since(5, 0), since(1, 4) },
+    { DashboardCommand::LOAD_INSTALLATION, "load installation", since(5, 0), since(3, 2) },
+    { DashboardCommand::PLAY, "play", since(5, 0), since(1, 4) },
+    { DashboardCommand::PAUSE, "pause", since(5, 0), since(1, 4) },
+    { DashboardCommand::STOP, "stop", since(5, 0), since(1, 4) },
+    { DashboardCommand::CLOSE_POPUP, "close popup", since(5, 0), since(1, 6) },
+    { DashboardCommand::CLOSE_SAFETY_POPUP, "close safety popup", since(5, 0), since(3, 1) },
+    { DashboardCommand::RESTART_SAFETY, "restart safety", since(5, 1), since(3, 7) },
+    { DashboardCommand::UNLOCK_PROTECTIVE_STOP, "unlock protective stop", since(5, 0), since(3, 1) },
+    { DashboardCommand::SHUTDOWN, "shutdown", since(5, 0), since(1, 4) },
+    { DashboardCommand::QUIT, "quit", since(5, 0), since(1, 4) },
+    { DashboardCommand::RUNNING, "running", since(5, 0), since(1, 6) },
+    { DashboardCommand::IS_PROGRAM_SAVED, "isProgramSaved", since(5, 0), since(1, 8) },
+    { DashboardCommand::IS_IN_REMOTE_CONTROL, "is in remote control", since(5, 6), NOT_AVAILABLE },
+    { DashboardCommand::POPUP, "popup", since(5, 0), since(1, 6) },
+    { DashboardCommand::ADD_TO_LOG, "addToLog", since(5, 0), since(1, 8) },
+    { DashboardCommand::GET_ROBOT_MODEL, "get robot model", since(5, 6), since(3, 12) },
+    { DashboardCommand::GET_SERIAL_NUMBER, "get serial number", since(5, 6), since(3, 12) },
+    { DashboardCommand::ROBOT_MODE, "robotmode", since(5, 0), since(1, 6) },
+    { DashboardCommand::GET_LOADED_PROGRAM, "get loaded program", since(5, 0), since(1, 6) },
+    { DashboardCommand::SAFETY_MODE, "safetymode", since(5, 0), since(3, 0) },
+    { DashboardCommand::SAFETY_STATUS, "safetystatus", since(5, 4), since(3, 11) },
+    { DashboardCommand::PROGRAM_STATE, "programState", since(5, 0), since(1, 8) },
+    { DashboardCommand::GET_STATUS, "robotmode, safetymode, programState and get loaded program", since(5, 0),
+      since(3, 0) },
+    { DashboardCommand::GET_OPERATIONAL_MODE, "get operational mode", since(5, 6), NOT_AVAILABLE },
+    { DashboardCommand::SET_OPERATIONAL_MODE, "set operational mode", since(5, 0), NOT_AVAILABLE },
+    { DashboardCommand::CLEAR_OPERATIONAL_MODE, "clear operational mode", since(5, 0), NOT_AVAILABLE },
+    { DashboardCommand::SET_USER_ROLE, "setUserRole", NOT_AVAILABLE, since(1, 8) },
+    { DashboardCommand::GET_USER_ROLE, "getUserRole", NOT_AVAILABLE, since(1, 8) },
+    { DashboardCommand::GENERATE_FLIGHT_REPORT, "generate flight report", since(5, 8), since(3, 13) },
+    { DashboardCommand::GENERATE_SUPPORT_FILE, "generate support file", since(5, 8), since(3, 13) },
+    { DashboardCommand::SAVE_LOG, "save log", since(5, 0), since(1, 8) },
+} };
+
+// All features currently listed are e-Series only
+const std::array<MinimumVersion, VersionCapabilities::NUM_ROBOT_FEATURES> ROBOT_FEATURES = { {
+    since(5, 0),  // TOOL_COMMUNICATION
+    since(5, 0),  // FORCE_TORQUE_SENSOR_ZEROING
+    since(5, 0),  // FORCE_MODE_GAIN_SCALING
+    since(5, 0),  // TOOL_CONTACT
+} };
+
+VersionInformation toVersion(const MinimumVersion& minimum)
+{
+  VersionInformation version;
+  version.major = minimum.major;
+  version.minor = minimum.minor;
+  return version;
+}
+
+bool isSupported(const MinimumVersion& minimum, const VersionInformation& version)
+{
+  return minimum.available && toVersion(minimum) <= version;
+}
+}  // namespace
+
+constexpr double VersionCapabilities::CB3_MAX_RTDE_FREQUENCY;
+constexpr double VersionCapabilities::URE_MAX_RTDE_FREQUENCY;
+
+VersionCapabilities::VersionCapabilities() : max_rtde_frequency_(URE_MAX_RTDE_FREQUENCY)
+{
+}
+
+VersionCapabilities::VersionCapabilities(const VersionInformation& version)
+  : version_(version)
+  , max_rtde_frequency_(version.isESeries() ? URE_MAX_RTDE_FREQUENCY : CB3_MAX_RTDE_FREQUENCY)
+{
+  const bool e_series = version.isESeries();
+  for (const auto& entry : DASHBOARD_COMMANDS)
+  {
+    dashboard_commands_.set(static_cast<size_t>(entry.command),
+                            isSupported(e_series ? entry.e_series : entry.cb3, version));
+  }
+  for (size_t i = 0; i < ROBOT_FEATURES.size(); ++i)
+  {
+    features_.set(i, isSupported(ROBOT_FEATURES[i], version));
+  }
+}
+
+const char* VersionCapabilities::getName(const DashboardCommand command)
+{
+  return DASHBOARD_COMMANDS[static_cast<size_t>(command)].name;
+}
+
+bool VersionCapabilities::getMinimumVersion(const DashboardCommand command, const bool e_series,
+                                            VersionInformation& version)
+{
+  const DashboardCommandEntry& entry = DASHBOARD_COMMANDS[static_cast<size_t>(command)];
+  const MinimumVersion& minimum = e_series ? entry.e_series : entry.cb3;
+  if (!minimum.available)
+  {
+    return false;
+  }
+  version = toVersion(minimum);
+  return true;
+}
+
+}  // namespace urcl
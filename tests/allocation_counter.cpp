@@ -0,0 +1,152 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cerrno>
+
+// glibc's allocator, which the wrappers below forward to
+extern "C"
+{
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t num, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void* __libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void* ptr);
+}
+
+namespace
+{
+std::atomic<bool> g_counting(false);
+std::atomic<size_t> g_num_allocations(0);
+std::atomic<size_t> g_num_deallocations(0);
+
+inline void countAllocation()
+{
+  if (g_counting.load(std::memory_order_relaxed))
+  {
+    g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+inline void countDeallocation(void* ptr)
+{
+  if (ptr != nullptr && g_counting.load(std::memory_order_relaxed))
+  {
+    g_num_deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+}  // namespace
+
+extern "C"
+{
+  void* malloc(size_t size)
+  {
+    countAllocation();
+    return __libc_malloc(size);
+  }
+
+  void* calloc(size_t num, size_t size)
+  {
+    countAllocation();
+    return __libc_calloc(num, size);
+  }
+
+  void* realloc(void* ptr, size_t size)
+  {
+    countAllocation();
+    return __libc_realloc(ptr, size);
+  }
+
+  void* memalign(size_t alignment, size_t size)
+  {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+  }
+
+  void* aligned_alloc(size_t alignment, size_t size)
+  {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void** ptr, size_t alignment, size_t size)
+  {
+    countAllocation();
+    void* result = __libc_memalign(alignment, size);
+    if (result == nullptr)
+    {
+      return ENOMEM;
+    }
+    *ptr = result;
+    return 0;
+  }
+
+  void free(void* ptr)
+  {
+    countDeallocation(ptr);
+    __libc_free(ptr);
+  }
+}
+
+namespace urcl
+{
+namespace test
+{
+AllocationCounter::AllocationCounter()
+{
+  g_num_allocations = 0;
+  g_num_deallocations = 0;
+  g_counting = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+  stop();
+}
+
+void AllocationCounter::stop()
+{
+  g_counting = false;
+}
+
+size_t AllocationCounter::getNumAllocations() const
+{
+  return g_num_allocations;
+}
+
+size_t AllocationCounter::getNumDeallocations() const
+{
+  return g_num_deallocations;
+}
+
+}  // namespace test
+}  // namespace urcl
@@ -0,0 +1,85 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TESTS_ALLOCATION_COUNTER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TESTS_ALLOCATION_COUNTER_H_INCLUDED
+
+#include <cstddef>
+
+namespace urcl
+{
+namespace test
+{
+/*!
+ * \brief Counts heap allocations and deallocations made by any thread of the process while it is
+ * active, e.g. to check that a real-time path doesn't allocate memory in steady state.
+ *
+ * Linking allocation_counter.cpp into a test replaces the malloc family of functions by counting
+ * wrappers around glibc's allocator. This covers operator new and delete as well, as libstdc++
+ * implements them using malloc and free. Only one counter may be active at a time.
+ *
+ * Reporting a test failure allocates memory, so assertions should be made after stop().
+ */
+class AllocationCounter
+{
+public:
+  /*!
+   * \brief Resets the counts and starts counting.
+   */
+  AllocationCounter();
+
+  /*!
+   * \brief Stops counting, if still active.
+   */
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+  /*!
+   * \brief Stops counting. The counts are kept until the next counter is created.
+   */
+  void stop();
+
+  /*!
+   * \brief Getter for the number of allocations, including reallocations, made while counting.
+   */
+  size_t getNumAllocations() const;
+
+  /*!
+   * \brief Getter for the number of deallocations made while counting.
+   */
+  size_t getNumDeallocations() const;
+};
+
+}  // namespace test
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TESTS_ALLOCATION_COUNTER_H_INCLUDED
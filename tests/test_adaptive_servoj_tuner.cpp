@@ -0,0 +1,144 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <ur_client_library/control/adaptive_servoj_tuner.h>
+
+using namespace urcl;
+using namespace std::chrono_literals;
+
+class AdaptiveServojTunerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    config_.window_size = 100;
+  }
+
+  std::unique_ptr<control::AdaptiveServojTuner> createTuner()
+  {
+    auto tuner = std::make_unique<control::AdaptiveServojTuner>(config_, 0.03, 2000);
+    // The first setpoint only starts the first interval
+    tuner->addSetpoint(time_);
+    return tuner;
+  }
+
+  // Reports num_intervals setpoints, every tenth one late by the given delay, and returns how often
+  // the tuner asked for the parameters to be sent.
+  size_t streamSetpoints(control::AdaptiveServojTuner& tuner, const size_t num_intervals,
+                         const std::chrono::microseconds delay = 0us)
+  {
+    size_t num_changes = 0;
+    for (size_t i = 1; i <= num_intervals; ++i)
+    {
+      time_ += i % 10 == 0 ? 2ms + delay : 2ms;
+      if (tuner.addSetpoint(time_))
+      {
+        ++num_changes;
+      }
+    }
+    return num_changes;
+  }
+
+  control::AdaptiveServojConfig config_;
+  std::chrono::steady_clock::time_point time_ = std::chrono::steady_clock::now();
+};
+
+TEST_F(AdaptiveServojTunerTest, steady_stream_keeps_minimum_lookahead)
+{
+  auto tuner = createTuner();
+
+  EXPECT_EQ(streamSetpoints(*tuner, 1000), 0u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), 0.03);
+  EXPECT_EQ(tuner->getGain(), 2000u);
+  EXPECT_LT(tuner->getJitter(), 200us);
+}
+
+TEST_F(AdaptiveServojTunerTest, jitter_raises_lookahead)
+{
+  auto tuner = createTuner();
+
+  EXPECT_EQ(streamSetpoints(*tuner, 100, 18ms), 1u);
+  EXPECT_GT(tuner->getJitter(), 10ms);
+  EXPECT_GT(tuner->getLookaheadTime(), 0.05);
+  EXPECT_LE(tuner->getLookaheadTime(), config_.max_lookahead_time);
+  // The gain is only adapted on request
+  EXPECT_EQ(tuner->getGain(), 2000u);
+
+  // Unchanged jitter doesn't need sending again
+  EXPECT_EQ(streamSetpoints(*tuner, 100, 18ms), 0u);
+
+  // Once the jitter is gone, the lookahead time drops again
+  EXPECT_EQ(streamSetpoints(*tuner, 300), 1u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), 0.03);
+}
+
+TEST_F(AdaptiveServojTunerTest, adapt_gain_lowers_gain)
+{
+  config_.adapt_gain = true;
+  config_.min_gain = 300;
+  auto tuner = createTuner();
+
+  EXPECT_EQ(streamSetpoints(*tuner, 100, 18ms), 1u);
+  EXPECT_LT(tuner->getGain(), 2000u);
+  EXPECT_GT(tuner->getGain(), 300u);
+
+  EXPECT_EQ(streamSetpoints(*tuner, 100, 200ms), 1u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), config_.max_lookahead_time);
+  EXPECT_EQ(tuner->getGain(), 300u);
+}
+
+TEST_F(AdaptiveServojTunerTest, pauses_are_not_jitter)
+{
+  auto tuner = createTuner();
+
+  streamSetpoints(*tuner, 50);
+  time_ += 10s;
+  EXPECT_EQ(streamSetpoints(*tuner, 100), 0u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), 0.03);
+}
+
+TEST_F(AdaptiveServojTunerTest, reset_restores_initial_parameters)
+{
+  auto tuner = createTuner();
+  streamSetpoints(*tuner, 100, 18ms);
+  ASSERT_GT(tuner->getLookaheadTime(), 0.03);
+
+  tuner->reset();
+  // The restarted program uses the initial parameters again. The measured ones are sent with the
+  // next window even though they didn't change in between.
+  EXPECT_EQ(streamSetpoints(*tuner, 1), 0u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), 0.03);
+  EXPECT_EQ(streamSetpoints(*tuner, 100), 1u);
+  EXPECT_DOUBLE_EQ(tuner->getLookaheadTime(), 0.03);
+}
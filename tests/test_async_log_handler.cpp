@@ -0,0 +1,176 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/async_log_handler.h"
+#include "ur_client_library/log.h"
+
+using namespace urcl;
+
+struct LoggedMessage
+{
+  std::string file;
+  int line;
+  LogLevel level;
+  std::string text;
+  std::thread::id thread;
+};
+
+class CollectingLogHandler : public LogHandler
+{
+public:
+  explicit CollectingLogHandler(std::shared_ptr<std::vector<LoggedMessage>> messages) : messages_(messages)
+  {
+  }
+
+  void log(const char* file, int line, LogLevel loglevel, const char* log) override
+  {
+    messages_->push_back({ file, line, loglevel, log, std::this_thread::get_id() });
+  }
+
+private:
+  std::shared_ptr<std::vector<LoggedMessage>> messages_;
+};
+
+class AsyncLogHandlerTest : public ::testing::Test
+{
+protected:
+  std::unique_ptr<AsyncLogHandler> createHandler(const size_t ring_capacity,
+                                                 const std::chrono::milliseconds flush_interval)
+  {
+    return std::make_unique<AsyncLogHandler>(std::make_unique<CollectingLogHandler>(messages_), ring_capacity,
+                                             flush_interval);
+  }
+
+  std::shared_ptr<std::vector<LoggedMessage>> messages_ = std::make_shared<std::vector<LoggedMessage>>();
+};
+
+TEST_F(AsyncLogHandlerTest, messages_are_passed_on_by_the_background_thread)
+{
+  std::unique_ptr<AsyncLogHandler> handler = createHandler(16, std::chrono::milliseconds(1));
+  handler->log("file.cpp", 42, LogLevel::ERROR, "Pipeline producer overflowed!");
+  // Destroying the handler waits for the background thread to finish
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  handler.reset();
+
+  ASSERT_EQ(messages_->size(), 1u);
+  EXPECT_NE(messages_->at(0).thread, std::this_thread::get_id());
+  EXPECT_EQ(messages_->at(0).file, "file.cpp");
+  EXPECT_EQ(messages_->at(0).line, 42);
+  EXPECT_EQ(messages_->at(0).level, LogLevel::ERROR);
+  EXPECT_EQ(messages_->at(0).text, "Pipeline producer overflowed!");
+}
+
+TEST_F(AsyncLogHandlerTest, messages_of_several_threads_keep_their_order)
+{
+  std::unique_ptr<AsyncLogHandler> handler = createHandler(1024, std::chrono::hours(1));
+  handler->log("file.cpp", 1, LogLevel::INFO, "0");
+  std::thread thread([&]() {
+    handler->log("file.cpp", 2, LogLevel::INFO, "1");
+    handler->log("file.cpp", 2, LogLevel::INFO, "2");
+  });
+  thread.join();
+  handler->log("file.cpp", 1, LogLevel::INFO, "3");
+  handler->flush();
+
+  ASSERT_EQ(messages_->size(), 4u);
+  for (size_t i = 0; i < messages_->size(); ++i)
+  {
+    EXPECT_EQ(messages_->at(i).text, std::to_string(i));
+  }
+}
+
+TEST_F(AsyncLogHandlerTest, messages_are_dropped_when_the_ring_is_full)
+{
+  std::unique_ptr<AsyncLogHandler> handler = createHandler(4, std::chrono::hours(1));
+  for (int i = 0; i < 6; ++i)
+  {
+    handler->log("file.cpp", i, LogLevel::WARN, "message");
+  }
+  EXPECT_EQ(handler->getDroppedCount(), 2u);
+  handler->flush();
+
+  ASSERT_EQ(messages_->size(), 5u);
+  EXPECT_EQ(messages_->back().level, LogLevel::WARN);
+  EXPECT_NE(messages_->back().text.find("Dropped 2 log messages"), std::string::npos);
+
+  // The ring can be used again after draining it
+  handler->log("file.cpp", 1, LogLevel::INFO, "after");
+  handler->flush();
+  EXPECT_EQ(messages_->back().text, "after");
+}
+
+TEST_F(AsyncLogHandlerTest, long_messages_are_truncated)
+{
+  std::unique_ptr<AsyncLogHandler> handler = createHandler(4, std::chrono::hours(1));
+  const std::string text(2000, 'x');
+  handler->log("file.cpp", 1, LogLevel::INFO, text.c_str());
+  handler->flush();
+
+  ASSERT_EQ(messages_->size(), 1u);
+  ASSERT_EQ(messages_->at(0).text.size(), AsyncLogHandler::MAX_MESSAGE_LENGTH);
+  EXPECT_EQ(messages_->at(0).text.substr(AsyncLogHandler::MAX_MESSAGE_LENGTH - 3), "...");
+}
+
+TEST_F(AsyncLogHandlerTest, remaining_messages_are_passed_on_when_destroyed)
+{
+  std::unique_ptr<AsyncLogHandler> handler = createHandler(16, std::chrono::hours(1));
+  std::thread thread([&]() { handler->log("file.cpp", 1, LogLevel::INFO, "from an ended thread"); });
+  thread.join();
+  handler.reset();
+
+  ASSERT_EQ(messages_->size(), 1u);
+  EXPECT_EQ(messages_->at(0).text, "from an ended thread");
+}
+
+TEST_F(AsyncLogHandlerTest, logging_macros_use_the_registered_handler)
+{
+  registerLogHandler(createHandler(16, std::chrono::milliseconds(1)));
+  URCL_LOG_INFO("Value %d of %s", 5, "test");
+  // Replacing the handler destroys the asynchronous one, which passes on all remaining messages
+  unregisterLogHandler();
+
+  ASSERT_EQ(messages_->size(), 1u);
+  EXPECT_EQ(messages_->at(0).text, "Value 5 of test");
+  EXPECT_EQ(messages_->at(0).level, LogLevel::INFO);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
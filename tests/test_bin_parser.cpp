@@ -270,6 +270,77 @@ TEST(bin_parser, parse_outside_buffer_length)
   EXPECT_THROW(bp.parse<int32_t>(parsed_int), UrException);
 }
 
+TEST(bin_parser, status_mode_poisons_parser)
+{
+  uint8_t buffer[] = { 0x00, 0x00, 0x00, 0x01, 0x02, 0x03 };
+  comm::BinParser bp(buffer, sizeof(buffer), comm::BinParser::ErrorMode::STATUS);
+
+  int32_t parsed_int;
+  bp.parse(parsed_int);
+  EXPECT_EQ(parsed_int, 1);
+  EXPECT_FALSE(bp.failed());
+
+  // Reading past the end doesn't throw, but fails the parser
+  EXPECT_NO_THROW(bp.parse(parsed_int));
+  EXPECT_EQ(parsed_int, 0);
+  EXPECT_TRUE(bp.failed());
+  EXPECT_EQ(bp.getStatus(), comm::ParseStatus::TRUNCATED);
+  EXPECT_TRUE(bp.empty());
+
+  // All further reads return zeroed values, even if they would fit into the remaining bytes
+  uint8_t parsed_byte = 42;
+  bp.parse(parsed_byte);
+  EXPECT_EQ(parsed_byte, 0);
+  vector6d_t parsed_vector = { 1, 2, 3, 4, 5, 6 };
+  bp.parse(parsed_vector);
+  EXPECT_EQ(parsed_vector, vector6d_t());
+  std::string parsed_string = "string";
+  bp.parse(parsed_string, 4);
+  EXPECT_TRUE(parsed_string.empty());
+  EXPECT_TRUE(bp.failed());
+}
+
+TEST(bin_parser, status_mode_sub_parser)
+{
+  uint8_t buffer[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+  comm::BinParser bp(buffer, sizeof(buffer), comm::BinParser::ErrorMode::STATUS);
+  {
+    comm::BinParser sbp(bp, 2);
+    uint32_t parsed_int;
+    sbp.parse(parsed_int);
+    EXPECT_TRUE(sbp.failed());
+  }
+
+  // The sub-parser's failure is passed on to the parent
+  EXPECT_TRUE(bp.failed());
+  EXPECT_TRUE(bp.empty());
+
+  // A sub-parser larger than the parent's buffer fails right away
+  comm::BinParser bp1(buffer, sizeof(buffer), comm::BinParser::ErrorMode::STATUS);
+  {
+    comm::BinParser sbp(bp1, sizeof(buffer) + 1);
+    EXPECT_TRUE(sbp.failed());
+  }
+  EXPECT_TRUE(bp1.failed());
+
+  comm::BinParser bp2(buffer, sizeof(buffer));
+  EXPECT_THROW(comm::BinParser(bp2, sizeof(buffer) + 1), UrException);
+}
+
+TEST(bin_parser, require)
+{
+  uint8_t buffer[] = { 0x01, 0x02, 0x03, 0x04 };
+  comm::BinParser bp(buffer, sizeof(buffer));
+
+  EXPECT_TRUE(bp.require(sizeof(buffer)));
+  EXPECT_FALSE(bp.failed());
+
+  // require() doesn't throw in either mode
+  EXPECT_FALSE(bp.require(sizeof(buffer) + 1));
+  EXPECT_TRUE(bp.failed());
+  EXPECT_TRUE(bp.empty());
+}
+
 TEST(bin_parser, bin_parser_parent)
 {
   // The buffer represents the string 'String to be parsed'
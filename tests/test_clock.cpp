@@ -0,0 +1,118 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <ur_client_library/clock.h>
+#include <ur_client_library/exceptions.h>
+
+using namespace urcl;
+
+TEST(Clock, steady_clock_is_registered_by_default)
+{
+  unregisterClock();
+  ASSERT_NE(getClock(), nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<SteadyClock>(getClock()), nullptr);
+
+  auto simulated = std::make_shared<SimulatedClock>();
+  registerClock(simulated);
+  EXPECT_EQ(getClock(), simulated);
+
+  registerClock(nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<SteadyClock>(getClock()), nullptr);
+}
+
+TEST(Clock, accelerated_clock_sleeps_shorter)
+{
+  SimulatedClock clock(100.0);
+  const auto real_start = std::chrono::steady_clock::now();
+  const auto simulated_start = clock.now();
+  clock.sleepFor(std::chrono::seconds(1));
+  const auto real_elapsed = std::chrono::steady_clock::now() - real_start;
+
+  EXPECT_GE(clock.now() - simulated_start, std::chrono::seconds(1));
+  EXPECT_LT(real_elapsed, std::chrono::milliseconds(500));
+}
+
+TEST(Clock, advancing_wakes_up_sleepers)
+{
+  SimulatedClock clock(0.0);
+  const auto start = clock.now();
+  auto sleeper = std::async(std::launch::async, [&]() { clock.sleepFor(std::chrono::seconds(10)); });
+  EXPECT_EQ(sleeper.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  clock.advance(std::chrono::seconds(5));
+  EXPECT_EQ(sleeper.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  clock.advance(std::chrono::seconds(5));
+  EXPECT_EQ(sleeper.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(clock.now() - start, std::chrono::seconds(10));
+}
+
+TEST(Clock, wait_until_returns_on_predicate_or_deadline)
+{
+  SimulatedClock clock(0.0);
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+
+  auto waiter = std::async(std::launch::async, [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    return clock.waitUntil(cv, lock, clock.now() + std::chrono::hours(1), [&]() { return done; });
+  });
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cv.notify_all();
+  ASSERT_EQ(waiter.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(waiter.get());
+
+  done = false;
+  auto timed_out = std::async(std::launch::async, [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    return clock.waitUntil(cv, lock, clock.now() + std::chrono::hours(1), [&]() { return done; });
+  });
+  EXPECT_EQ(timed_out.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  clock.advance(std::chrono::hours(1));
+  ASSERT_EQ(timed_out.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_FALSE(timed_out.get());
+}
+
+TEST(Clock, negative_time_scale_is_rejected)
+{
+  EXPECT_THROW(SimulatedClock(-1.0), UrException);
+}
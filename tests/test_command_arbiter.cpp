@@ -0,0 +1,269 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <ur_client_library/control/command_arbiter.h>
+#include <ur_client_library/control/shared_commands.h>
+#include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/exceptions.h>
+
+#include <cstring>
+#include <future>
+#include <thread>
+#include <unistd.h>
+
+using namespace urcl;
+
+class CommandArbiterTest : public ::testing::Test
+{
+protected:
+  class Client : public comm::TCPSocket
+  {
+  public:
+    Client(const int& port)
+    {
+      std::string host = "127.0.0.1";
+      TCPSocket::setup(host, port);
+      timeval tv;
+      tv.tv_sec = 1;
+      tv.tv_usec = 0;
+      TCPSocket::setReceiveTimeout(tv);
+    }
+
+    // Reads one message of the reverse socket
+    std::vector<int32_t> readMessage()
+    {
+      std::vector<int32_t> values(control::wire::reverse::MESSAGE_LENGTH);
+      uint8_t* b_pos = reinterpret_cast<uint8_t*>(values.data());
+      size_t read = 0;
+      size_t remainder = sizeof(int32_t) * values.size();
+      while (remainder > 0)
+      {
+        if (!TCPSocket::read(b_pos, remainder, read))
+        {
+          throw(std::runtime_error("Failed to read from socket, this should not happen during a test!"));
+        }
+        b_pos += read;
+        remainder -= read;
+      }
+      for (auto& val : values)
+      {
+        val = be32toh(val);
+      }
+      return values;
+    }
+
+    void send(const int32_t value)
+    {
+      int32_t val = htobe32(value);
+      size_t written = 0;
+      TCPSocket::write(reinterpret_cast<uint8_t*>(&val), sizeof(val), written);
+    }
+  };
+
+  void SetUp()
+  {
+    reverse_interface_.reset(new control::ReverseInterface(50021, [](bool) {}));
+    trajectory_interface_.reset(new control::TrajectoryPointInterface(50022));
+    reverse_client_.reset(new Client(50021));
+    trajectory_client_.reset(new Client(50022));
+    // Need to be sure that the clients have connected to the servers
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    arbiter_.reset(new control::CommandArbiter(*reverse_interface_, *trajectory_interface_));
+  }
+
+  void TearDown()
+  {
+    arbiter_.reset();
+    reverse_client_->close();
+    trajectory_client_->close();
+  }
+
+  template <typename Predicate>
+  bool waitFor(Predicate predicate, const std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+  {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (!predicate())
+    {
+      if (std::chrono::steady_clock::now() > end)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  std::unique_ptr<control::ReverseInterface> reverse_interface_;
+  std::unique_ptr<control::TrajectoryPointInterface> trajectory_interface_;
+  std::unique_ptr<Client> reverse_client_;
+  std::unique_ptr<Client> trajectory_client_;
+  std::unique_ptr<control::CommandArbiter> arbiter_;
+};
+
+TEST_F(CommandArbiterTest, higher_priority_preempts)
+{
+  // Declared before the clients, as destroying a client may hand control to another one
+  std::vector<bool> planner_changes;
+  std::vector<bool> supervisor_changes;
+  std::shared_ptr<control::CommandClient> planner = arbiter_->addClient("planner", 1);
+  std::shared_ptr<control::CommandClient> supervisor = arbiter_->addClient("supervisor", 2);
+  planner->setControlCallback([&](bool has_control) { planner_changes.push_back(has_control); });
+  supervisor->setControlCallback([&](bool has_control) { supervisor_changes.push_back(has_control); });
+  EXPECT_EQ(2u, arbiter_->getNumClients());
+
+  EXPECT_TRUE(planner->requestControl());
+  EXPECT_EQ("planner", arbiter_->getOwnerName());
+  EXPECT_TRUE(supervisor->requestControl());
+  EXPECT_EQ("supervisor", arbiter_->getOwnerName());
+  EXPECT_FALSE(planner->hasControl());
+  EXPECT_EQ(std::vector<bool>({ true, false }), planner_changes);
+  EXPECT_EQ(std::vector<bool>({ true }), supervisor_changes);
+  EXPECT_EQ(2u, arbiter_->getNumHandoffs());
+
+  // Only the client in control reaches the robot
+  const vector6d_t positions = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+  EXPECT_FALSE(planner->writeJointCommand(positions, comm::ControlMode::MODE_SERVOJ));
+  EXPECT_TRUE(supervisor->writeJointCommand(positions, comm::ControlMode::MODE_SERVOJ));
+  std::vector<int32_t> message = reverse_client_->readMessage();
+  EXPECT_EQ(1.0, static_cast<double>(message[1]) / control::ReverseInterface::MULT_JOINTSTATE);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), message[7]);
+
+  // Stopping the program would affect all clients
+  EXPECT_FALSE(supervisor->writeJointCommand(positions, comm::ControlMode::MODE_STOPPED));
+
+  // A lower priority doesn't preempt
+  EXPECT_FALSE(planner->requestControl());
+  EXPECT_EQ("supervisor", arbiter_->getOwnerName());
+}
+
+TEST_F(CommandArbiterTest, pending_request_granted_on_release)
+{
+  bool first_has_control = false;
+  std::shared_ptr<control::CommandClient> supervisor = arbiter_->addClient("supervisor", 2);
+  std::shared_ptr<control::CommandClient> first = arbiter_->addClient("first", 1);
+  std::shared_ptr<control::CommandClient> second = arbiter_->addClient("second", 1);
+  first->setControlCallback([&](bool has_control) { first_has_control = has_control; });
+
+  EXPECT_TRUE(supervisor->requestControl());
+  EXPECT_FALSE(first->requestControl());
+  EXPECT_FALSE(second->requestControl());
+
+  // Equal priorities are granted in the order of the requests
+  supervisor->releaseControl();
+  EXPECT_TRUE(first_has_control);
+  EXPECT_EQ("first", arbiter_->getOwnerName());
+
+  first->releaseControl();
+  EXPECT_FALSE(first_has_control);
+  EXPECT_EQ("second", arbiter_->getOwnerName());
+
+  // Destroying the client in control hands over as well
+  EXPECT_FALSE(first->requestControl());
+  second.reset();
+  EXPECT_EQ("first", arbiter_->getOwnerName());
+  EXPECT_EQ(2u, arbiter_->getNumClients());
+
+  first->releaseControl();
+  EXPECT_EQ("", arbiter_->getOwnerName());
+}
+
+TEST_F(CommandArbiterTest, preemption_cancels_trajectory)
+{
+  std::promise<control::TrajectoryResult> planner_result;
+  bool supervisor_called = false;
+  std::shared_ptr<control::CommandClient> planner = arbiter_->addClient("planner", 1);
+  std::shared_ptr<control::CommandClient> supervisor = arbiter_->addClient("supervisor", 2);
+  planner->setTrajectoryDoneCallback([&](control::TrajectoryResult result) { planner_result.set_value(result); });
+  supervisor->setTrajectoryDoneCallback([&](control::TrajectoryResult) { supervisor_called = true; });
+
+  ASSERT_TRUE(planner->requestControl());
+  ASSERT_TRUE(planner->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 2));
+  std::vector<int32_t> message = reverse_client_->readMessage();
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_START), message[1]);
+  EXPECT_EQ(2, message[2]);
+
+  ASSERT_TRUE(supervisor->requestControl());
+  message = reverse_client_->readMessage();
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_CANCEL), message[1]);
+
+  // The planner's uploads are rejected now
+  control::TrajectoryPoint point;
+  point.positions = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  point.goal_time = 1.0f;
+  EXPECT_FALSE(planner->writeTrajectoryPoints({ point, point }));
+
+  // The result of the canceled trajectory belongs to the planner
+  trajectory_client_->send(toUnderlying(control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED));
+  std::future<control::TrajectoryResult> future = planner_result.get_future();
+  ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(1)));
+  EXPECT_EQ(control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED, future.get());
+  EXPECT_FALSE(supervisor_called);
+}
+
+TEST_F(CommandArbiterTest, shared_memory_client)
+{
+  const std::string segment = "/urcl_test_commands_" + std::to_string(::getpid());
+  control::SharedCommandServer server(*arbiter_, segment, 2, std::chrono::microseconds(200));
+  std::unique_ptr<control::SharedCommandClient> remote(new control::SharedCommandClient(segment, "remote", 1));
+  ASSERT_TRUE(waitFor([&]() { return server.getNumConnectedClients() == 1; }));
+  EXPECT_EQ(1u, arbiter_->getNumClients());
+
+  remote->requestControl();
+  ASSERT_TRUE(waitFor([&]() { return remote->hasControl(); }));
+  EXPECT_EQ("remote", arbiter_->getOwnerName());
+
+  const vector6d_t positions = { 0.5, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  EXPECT_TRUE(remote->writeJointCommand(positions, comm::ControlMode::MODE_SPEEDJ));
+  std::vector<int32_t> message = reverse_client_->readMessage();
+  EXPECT_EQ(0.5, static_cast<double>(message[1]) / control::ReverseInterface::MULT_JOINTSTATE);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SPEEDJ), message[7]);
+
+  // An in-process client of a higher priority takes over
+  std::shared_ptr<control::CommandClient> supervisor = arbiter_->addClient("supervisor", 2);
+  ASSERT_TRUE(supervisor->requestControl());
+  ASSERT_TRUE(waitFor([&]() { return !remote->hasControl(); }));
+  EXPECT_TRUE(remote->writeJointCommand(positions, comm::ControlMode::MODE_SPEEDJ));
+  EXPECT_TRUE(waitFor([&]() { return remote->getNumRejectedCommands() == 1; }));
+
+  // Releasing the slot removes the client from the arbitration
+  remote.reset();
+  EXPECT_TRUE(waitFor([&]() { return server.getNumConnectedClients() == 0; }));
+  EXPECT_EQ(1u, arbiter_->getNumClients());
+
+  control::SharedCommandClient first(segment, "first", 1);
+  control::SharedCommandClient second(segment, "second", 1);
+  EXPECT_THROW(control::SharedCommandClient(segment, "third", 1), UrException);
+}
+
+TEST(SharedCommandClientTest, missing_segment)
+{
+  EXPECT_THROW(control::SharedCommandClient("/urcl_missing_command_segment", "client", 1), UrException);
+}
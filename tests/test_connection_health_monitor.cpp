@@ -0,0 +1,137 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "ur_client_library/comm/connection_health_monitor.h"
+#include "ur_client_library/comm/tcp_server.h"
+
+using namespace urcl;
+
+TEST(ConnectionHealthMonitorTest, read_tcp_statistics)
+{
+  comm::TcpStatistics stats;
+  EXPECT_FALSE(comm::readTcpStatistics(-1, stats));
+
+  comm::TCPServer server(60005);
+  server.start();
+  comm::TCPSocket socket;
+  EXPECT_FALSE(socket.getTcpStatistics(stats));
+
+  class Client : public comm::TCPSocket
+  {
+  public:
+    using TCPSocket::setup;
+  } client;
+  ASSERT_TRUE(client.setup("127.0.0.1", 60005, 1));
+  const uint8_t data[] = { 1, 2, 3 };
+  size_t written;
+  ASSERT_TRUE(client.write(data, sizeof(data), written));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  ASSERT_TRUE(client.getTcpStatistics(stats));
+  EXPECT_GT(stats.rtt.count(), 0);
+  EXPECT_GT(stats.congestion_window, 0u);
+  EXPECT_EQ(stats.retransmits, 0u);
+}
+
+TEST(ConnectionHealthMonitorTest, count_new_retransmits)
+{
+  comm::ConnectionHealthMonitor monitor;
+  bool connected = true;
+  uint32_t retransmits = 0;
+  monitor.addConnection("fake", [&](comm::TcpStatistics& stats) {
+    stats.retransmits = retransmits;
+    stats.rtt = std::chrono::microseconds(250);
+    return connected;
+  });
+  std::vector<uint32_t> reported;
+  using ConnectionHealth = comm::ConnectionHealthMonitor::ConnectionHealth;
+  monitor.setRetransmitCallback([&](const std::string& name, const ConnectionHealth& health) {
+    EXPECT_EQ(name, "fake");
+    reported.push_back(health.new_retransmits);
+  });
+
+  ConnectionHealth health;
+  EXPECT_FALSE(monitor.getHealth("fake", health));
+  monitor.sample();
+  ASSERT_TRUE(monitor.getHealth("fake", health));
+  EXPECT_TRUE(health.connected);
+  EXPECT_EQ(health.new_retransmits, 0u);
+  EXPECT_EQ(health.statistics.rtt, std::chrono::microseconds(250));
+
+  retransmits = 3;
+  monitor.sample();
+  retransmits = 5;
+  monitor.sample();
+  ASSERT_TRUE(monitor.getHealth("fake", health));
+  EXPECT_EQ(health.new_retransmits, 2u);
+
+  connected = false;
+  monitor.sample();
+  ASSERT_TRUE(monitor.getHealth("fake", health));
+  EXPECT_FALSE(health.connected);
+  EXPECT_EQ(health.new_retransmits, 0u);
+
+  // A new connection starts counting from 0
+  connected = true;
+  retransmits = 1;
+  monitor.sample();
+  EXPECT_EQ(reported, std::vector<uint32_t>({ 3, 2, 1 }));
+  EXPECT_EQ(monitor.getHealth().size(), 1u);
+}
+
+TEST(ConnectionHealthMonitorTest, sample_periodically)
+{
+  comm::ConnectionHealthMonitor monitor(std::chrono::milliseconds(5));
+  std::atomic<size_t> num_samples(0);
+  monitor.addConnection("fake", [&](comm::TcpStatistics& stats) {
+    num_samples++;
+    return true;
+  });
+  monitor.start();
+  EXPECT_TRUE(monitor.isRunning());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  monitor.stop();
+  EXPECT_FALSE(monitor.isRunning());
+  const size_t samples_taken = num_samples;
+  EXPECT_GT(samples_taken, 2u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(num_samples, samples_taken);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
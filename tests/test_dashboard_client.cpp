@@ -116,15 +116,8 @@ TEST_F(DashboardClientTest, log_and_getters)
 TEST_F(DashboardClientTest, flight_report_and_support_file)
 {
   EXPECT_TRUE(dashboard_client_->connect());
-  bool correct_polyscope_version = true;
-  try
-  {
-    dashboard_client_->assertVersion("5.6.0", "3.13", "test_function");
-  }
-  catch (const UrException& e)
-  {
-    correct_polyscope_version = false;
-  }
+  bool correct_polyscope_version =
+      dashboard_client_->getVersionCapabilities().supports(DashboardCommand::GENERATE_FLIGHT_REPORT);
 
   if (correct_polyscope_version)
   {
@@ -143,11 +136,11 @@ TEST_F(DashboardClientTest, e_series_version)
 {
   std::string msg;
   EXPECT_TRUE(dashboard_client_->connect());
-  if (!dashboard_client_->polyscope_version_.isESeries())
+  if (!dashboard_client_->getVersionCapabilities().getVersion().isESeries())
     GTEST_SKIP();
-  dashboard_client_->polyscope_version_ = VersionInformation::fromString("5.0.0");
+  dashboard_client_->capabilities_ = VersionCapabilities(VersionInformation::fromString("5.0.0"));
   EXPECT_THROW(dashboard_client_->commandSafetyStatus(msg), UrException);
-  dashboard_client_->polyscope_version_ = VersionInformation::fromString("5.5.0");
+  dashboard_client_->capabilities_ = VersionCapabilities(VersionInformation::fromString("5.5.0"));
   EXPECT_TRUE(dashboard_client_->commandSafetyStatus(msg));
   EXPECT_THROW(dashboard_client_->commandSetUserRole("none"), UrException);
 }
@@ -157,11 +150,11 @@ TEST_F(DashboardClientTest, cb3_version)
 {
   std::string msg;
   EXPECT_TRUE(dashboard_client_->connect());
-  if (dashboard_client_->polyscope_version_.isESeries())
+  if (dashboard_client_->getVersionCapabilities().getVersion().isESeries())
     GTEST_SKIP();
-  dashboard_client_->polyscope_version_ = VersionInformation::fromString("1.6.0");
+  dashboard_client_->capabilities_ = VersionCapabilities(VersionInformation::fromString("1.6.0"));
   EXPECT_THROW(dashboard_client_->commandIsProgramSaved(), UrException);
-  dashboard_client_->polyscope_version_ = VersionInformation::fromString("1.8.0");
+  dashboard_client_->capabilities_ = VersionCapabilities(VersionInformation::fromString("1.8.0"));
   EXPECT_TRUE(dashboard_client_->commandIsProgramSaved());
   EXPECT_THROW(dashboard_client_->commandIsInRemoteControl(), UrException);
 }
@@ -179,15 +172,8 @@ TEST_F(DashboardClientTest, set_receive_timeout)
   EXPECT_EQ(expected_tv.tv_sec, actual_tv.tv_sec);
   EXPECT_EQ(expected_tv.tv_usec, actual_tv.tv_usec);
 
-  bool correct_polyscope_version = true;
-  try
-  {
-    dashboard_client_->assertVersion("5.6.0", "3.13", "test_function");
-  }
-  catch (const UrException& e)
-  {
-    correct_polyscope_version = false;
-  }
+  bool correct_polyscope_version =
+      dashboard_client_->getVersionCapabilities().supports(DashboardCommand::GENERATE_FLIGHT_REPORT);
   if (correct_polyscope_version)
   {
     EXPECT_TRUE(dashboard_client_->commandGenerateFlightReport(""));
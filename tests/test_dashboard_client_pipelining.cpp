@@ -0,0 +1,161 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/exceptions.h>
+#define private public
+#include <ur_client_library/ur/dashboard_client.h>
+
+using namespace urcl;
+
+static const int g_port = 60011;
+
+// Answers dashboard commands like the robot does. All answers to the commands contained in one
+// chunk of received data are written back at once.
+class FakeDashboardServer
+{
+public:
+  FakeDashboardServer() : server_(g_port)
+  {
+    answers_ = { { "PolyscopeVersion", "URSoftware 5.12.2.1101534 (Jul 06 2022)" },
+                 { "robotmode", "Robotmode: RUNNING" },
+                 { "safetymode", "Safetymode: NORMAL" },
+                 { "programState", "PLAYING wait_program.urp" },
+                 { "get loaded program", "Loaded program: /programs/wait_program.urp" } };
+    server_.setConnectCallback([this](const int fd) { send(fd, "Connected: Universal Robots Dashboard Server\n"); });
+    server_.setMessageCallback([this](const int fd, char* buffer, int nbytesrecv) {
+      std::string answers;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        received_.append(buffer, nbytesrecv);
+        size_t line_end;
+        while ((line_end = received_.find('\n')) != std::string::npos)
+        {
+          const std::string command = received_.substr(0, line_end);
+          received_.erase(0, line_end + 1);
+          commands_.push_back(command);
+          auto it = answers_.find(command);
+          answers += (it != answers_.end() ? it->second : "could not understand: '" + command + "'") + "\n";
+        }
+      }
+      send(fd, answers);
+    });
+    server_.start();
+  }
+
+  std::vector<std::string> getCommands()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commands_;
+  }
+
+private:
+  void send(const int fd, const std::string& text)
+  {
+    size_t written;
+    server_.write(fd, reinterpret_cast<const uint8_t*>(text.data()), text.size(), written);
+  }
+
+  comm::TCPServer server_;
+  std::mutex mutex_;
+  std::string received_;
+  std::vector<std::string> commands_;
+  std::map<std::string, std::string> answers_;
+};
+
+class DashboardClientPipeliningTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    server_.reset(new FakeDashboardServer());
+    client_.reset(new DashboardClient("127.0.0.1"));
+    client_->port_ = g_port;
+    ASSERT_TRUE(client_->connect(1));
+  }
+
+  void TearDown()
+  {
+    client_.reset();
+    server_.reset();
+  }
+
+  std::unique_ptr<FakeDashboardServer> server_;
+  std::unique_ptr<DashboardClient> client_;
+};
+
+TEST_F(DashboardClientPipeliningTest, answers_are_matched_to_commands_in_order)
+{
+  std::vector<std::string> responses = client_->sendAndReceive({ "safetymode", "robotmode", "unknown", "robotmode" });
+  ASSERT_EQ(responses.size(), 4u);
+  EXPECT_EQ(responses[0], "Safetymode: NORMAL");
+  EXPECT_EQ(responses[1], "Robotmode: RUNNING");
+  EXPECT_EQ(responses[2], "could not understand: 'unknown'");
+  EXPECT_EQ(responses[3], "Robotmode: RUNNING");
+
+  // Single requests still work after a batch
+  EXPECT_EQ(client_->sendAndReceive("programState"), "PLAYING wait_program.urp");
+}
+
+TEST_F(DashboardClientPipeliningTest, status_is_queried_with_one_batch)
+{
+  DashboardStatus status;
+  ASSERT_TRUE(client_->commandGetStatus(status));
+  EXPECT_EQ(status.robot_mode, "Robotmode: RUNNING");
+  EXPECT_EQ(status.safety_mode, "Safetymode: NORMAL");
+  EXPECT_EQ(status.program_state, "PLAYING wait_program.urp");
+  EXPECT_EQ(status.loaded_program, "Loaded program: /programs/wait_program.urp");
+
+  const std::vector<std::string> expected_commands = { "PolyscopeVersion", "robotmode", "safetymode", "programState",
+                                                       "get loaded program" };
+  EXPECT_EQ(server_->getCommands(), expected_commands);
+}
+
+TEST_F(DashboardClientPipeliningTest, requests_match_expected_answers)
+{
+  EXPECT_TRUE(client_->sendRequest("robotmode", "(?:Robotmode: ).*"));
+  EXPECT_FALSE(client_->sendRequest("robotmode", "(?:Safetymode: ).*"));
+  EXPECT_TRUE(client_->waitForReply("safetymode", "Safetymode: NORMAL", std::chrono::seconds(1)));
+  EXPECT_THROW(client_->sendRequestString("robotmode", "Robotmode: POWER_OFF"), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
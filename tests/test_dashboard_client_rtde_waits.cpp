@@ -0,0 +1,184 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ur_client_library/comm/tcp_server.h>
+#define private public
+#include <ur_client_library/ur/dashboard_client.h>
+
+using namespace urcl;
+
+static const int g_port = 60012;
+
+// Answers dashboard commands with fixed answers. The program state never changes, so waits can
+// only succeed if they are satisfied using the RTDE state.
+class FakeDashboardServer
+{
+public:
+  FakeDashboardServer() : server_(g_port)
+  {
+    answers_ = { { "PolyscopeVersion", "URSoftware 5.12.2.1101534 (Jul 06 2022)" },
+                 { "play", "Starting program" },
+                 { "stop", "Stopped" },
+                 { "brake release", "Brake releasing" },
+                 { "robotmode", "Robotmode: IDLE" },
+                 { "programState", "STOPPED wait_program.urp" } };
+    server_.setConnectCallback([this](const int fd) { send(fd, "Connected: Universal Robots Dashboard Server\n"); });
+    server_.setMessageCallback([this](const int fd, char* buffer, int nbytesrecv) {
+      std::string answers;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        received_.append(buffer, nbytesrecv);
+        size_t line_end;
+        while ((line_end = received_.find('\n')) != std::string::npos)
+        {
+          const std::string command = received_.substr(0, line_end);
+          received_.erase(0, line_end + 1);
+          if (command == "robotmode" || command == "programState")
+          {
+            ++status_requests_;
+          }
+          auto it = answers_.find(command);
+          answers += (it != answers_.end() ? it->second : "could not understand: '" + command + "'") + "\n";
+        }
+      }
+      send(fd, answers);
+    });
+    server_.start();
+  }
+
+  size_t getStatusRequests()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return status_requests_;
+  }
+
+private:
+  void send(const int fd, const std::string& text)
+  {
+    size_t written;
+    server_.write(fd, reinterpret_cast<const uint8_t*>(text.data()), text.size(), written);
+  }
+
+  comm::TCPServer server_;
+  std::mutex mutex_;
+  std::string received_;
+  size_t status_requests_ = 0;
+  std::map<std::string, std::string> answers_;
+};
+
+class DashboardClientRTDEWaitsTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    server_.reset(new FakeDashboardServer());
+    client_.reset(new DashboardClient("127.0.0.1"));
+    client_->port_ = g_port;
+    ASSERT_TRUE(client_->connect(1));
+    // Stands in for the state an attached RTDE client would report
+    state_ = std::make_shared<DashboardClient::RTDEState>();
+    client_->rtde_state_ = state_;
+  }
+
+  void TearDown()
+  {
+    client_.reset();
+    server_.reset();
+  }
+
+  void setRuntimeState(const RuntimeState runtime_state)
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->runtime_state = static_cast<uint32_t>(runtime_state);
+    state_->has_runtime_state = true;
+    state_->cv.notify_all();
+  }
+
+  void setRobotMode(const RobotMode robot_mode)
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->robot_mode = static_cast<int32_t>(robot_mode);
+    state_->has_robot_mode = true;
+    state_->cv.notify_all();
+  }
+
+  std::unique_ptr<FakeDashboardServer> server_;
+  std::unique_ptr<DashboardClient> client_;
+  std::shared_ptr<DashboardClient::RTDEState> state_;
+};
+
+TEST_F(DashboardClientRTDEWaitsTest, program_state_is_confirmed_by_rtde_state)
+{
+  setRuntimeState(RuntimeState::STOPPED);
+  std::thread robot([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    setRuntimeState(RuntimeState::PLAYING);
+  });
+  EXPECT_TRUE(client_->commandPlay());
+  robot.join();
+
+  setRuntimeState(RuntimeState::STOPPING);
+  EXPECT_FALSE(client_->waitForRuntimeState(RuntimeState::STOPPED, "(?:STOPPED ).*", std::chrono::milliseconds(50)));
+  EXPECT_EQ(server_->getStatusRequests(), 0u);
+}
+
+TEST_F(DashboardClientRTDEWaitsTest, robot_mode_is_confirmed_by_rtde_state)
+{
+  setRobotMode(RobotMode::IDLE);
+  std::thread robot([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    setRobotMode(RobotMode::RUNNING);
+  });
+  EXPECT_TRUE(client_->commandBrakeRelease());
+  robot.join();
+  EXPECT_EQ(server_->getStatusRequests(), 0u);
+}
+
+TEST_F(DashboardClientRTDEWaitsTest, dashboard_server_is_polled_until_rtde_data_arrives)
+{
+  EXPECT_TRUE(client_->waitForRobotMode(RobotMode::IDLE, std::chrono::seconds(1)));
+  EXPECT_TRUE(client_->waitForRuntimeState(RuntimeState::STOPPED, "(?:STOPPED ).*", std::chrono::seconds(1)));
+  EXPECT_EQ(server_->getStatusRequests(), 2u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
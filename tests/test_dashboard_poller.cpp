@@ -0,0 +1,222 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/ur/dashboard_poller.h>
+
+using namespace urcl;
+
+// Answers dashboard queries with fixed answers, optionally not answering at all
+class FakeDashboardServer
+{
+public:
+  FakeDashboardServer(const int port, const std::map<std::string, std::string>& answers, const bool respond = true)
+    : server_(port), answers_(answers), respond_(respond), connections_(0)
+  {
+    server_.setConnectCallback([this](const int fd) {
+      ++connections_;
+      send(fd, "Connected: Universal Robots Dashboard Server\n");
+    });
+    server_.setMessageCallback([this](const int fd, char* buffer, int nbytesrecv) {
+      std::string answers;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        received_.append(buffer, nbytesrecv);
+        size_t line_end;
+        while ((line_end = received_.find('\n')) != std::string::npos)
+        {
+          const std::string command = received_.substr(0, line_end);
+          received_.erase(0, line_end + 1);
+          auto it = answers_.find(command);
+          answers += (it != answers_.end() ? it->second : "could not understand: '" + command + "'") + "\n";
+        }
+      }
+      if (respond_)
+      {
+        send(fd, answers);
+      }
+    });
+    server_.start();
+  }
+
+  size_t getConnections() const
+  {
+    return connections_;
+  }
+
+private:
+  void send(const int fd, const std::string& text)
+  {
+    size_t written;
+    server_.write(fd, reinterpret_cast<const uint8_t*>(text.data()), text.size(), written);
+  }
+
+  comm::TCPServer server_;
+  std::mutex mutex_;
+  std::string received_;
+  std::map<std::string, std::string> answers_;
+  bool respond_;
+  std::atomic<size_t> connections_;
+};
+
+// Collects the results of one robot
+class ResultCollector
+{
+public:
+  DashboardPoller::ResultCallback callback()
+  {
+    return [this](const DashboardPollResult& result) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      results_.push_back(result);
+      cv_.notify_all();
+    };
+  }
+
+  bool waitForResults(const size_t count)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, std::chrono::seconds(2), [&]() { return results_.size() >= count; });
+  }
+
+  std::vector<DashboardPollResult> getResults()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return results_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<DashboardPollResult> results_;
+};
+
+TEST(DashboardPollerTest, robots_are_polled_periodically_with_typed_results)
+{
+  FakeDashboardServer e_series(60013, { { "robotmode", "Robotmode: RUNNING" },
+                                        { "safetystatus", "Safetystatus: PROTECTIVE_STOP" },
+                                        { "get operational mode", "AUTOMATIC" } });
+  FakeDashboardServer cb3(60014, { { "robotmode", "Robotmode: POWER_OFF" }, { "safetystatus", "Safetystatus: NORMAL" } });
+  ResultCollector e_series_results;
+  ResultCollector cb3_results;
+
+  DashboardPoller poller(nullptr, std::chrono::milliseconds(20), std::chrono::milliseconds(500));
+  poller.addRobot("127.0.0.1", e_series_results.callback(), 60013);
+  poller.addRobot("127.0.0.1", cb3_results.callback(), 60014);
+
+  ASSERT_TRUE(e_series_results.waitForResults(3));
+  ASSERT_TRUE(cb3_results.waitForResults(3));
+
+  for (const auto& result : e_series_results.getResults())
+  {
+    EXPECT_TRUE(result.connected);
+    EXPECT_EQ(result.robot_mode, RobotMode::RUNNING);
+    EXPECT_EQ(result.safety_status, SafetyStatus::PROTECTIVE_STOP);
+    EXPECT_EQ(result.operational_mode, OperationalMode::AUTOMATIC);
+  }
+  for (const auto& result : cb3_results.getResults())
+  {
+    EXPECT_TRUE(result.connected);
+    EXPECT_EQ(result.robot_mode, RobotMode::POWER_OFF);
+    EXPECT_EQ(result.safety_status, SafetyStatus::NORMAL);
+    EXPECT_FALSE(result.operational_mode.has_value());
+  }
+  // The connections are kept open between polls
+  EXPECT_EQ(e_series.getConnections(), 1u);
+  EXPECT_EQ(cb3.getConnections(), 1u);
+}
+
+TEST(DashboardPollerTest, robots_not_answering_are_reconnected)
+{
+  FakeDashboardServer server(60015, {}, false);
+  ResultCollector results;
+
+  DashboardPoller poller(nullptr, std::chrono::milliseconds(20), std::chrono::milliseconds(50));
+  poller.addRobot("127.0.0.1", results.callback(), 60015);
+
+  ASSERT_TRUE(results.waitForResults(2));
+  for (const auto& result : results.getResults())
+  {
+    EXPECT_FALSE(result.connected);
+  }
+  EXPECT_GE(server.getConnections(), 2u);
+}
+
+TEST(DashboardPollerTest, unreachable_robots_are_reported)
+{
+  ResultCollector results;
+  DashboardPoller poller(nullptr, std::chrono::milliseconds(20), std::chrono::milliseconds(50));
+  poller.addRobot("127.0.0.1", results.callback(), 60016);
+
+  ASSERT_TRUE(results.waitForResults(2));
+  EXPECT_FALSE(results.getResults()[0].connected);
+}
+
+TEST(DashboardPollerTest, removed_robots_are_not_polled_anymore)
+{
+  FakeDashboardServer server(60017, { { "robotmode", "Robotmode: IDLE" } });
+  std::shared_ptr<comm::Reactor> reactor = std::make_shared<comm::Reactor>(1);
+  ResultCollector results;
+
+  DashboardPoller poller(reactor, std::chrono::milliseconds(20), std::chrono::milliseconds(500));
+  const size_t id = poller.addRobot("127.0.0.1", results.callback(), 60017);
+  ASSERT_TRUE(results.waitForResults(1));
+  EXPECT_EQ(results.getResults()[0].robot_mode, RobotMode::IDLE);
+  EXPECT_FALSE(results.getResults()[0].safety_status.has_value());
+
+  poller.removeRobot(id);
+  const size_t num_results = results.getResults().size();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(results.getResults().size(), num_results);
+}
+
+TEST(DashboardPollerTest, unresolvable_hosts_are_rejected)
+{
+  DashboardPoller poller;
+  EXPECT_THROW(poller.addRobot("not.a.valid.host.invalid", [](const DashboardPollResult&) {}), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/primary/robot_message/error_code_message.h"
+#include "ur_client_library/ur/event_stream.h"
+
+using namespace urcl;
+
+class EventStreamTest : public ::testing::Test
+{
+protected:
+  EventStream::EventCallback record()
+  {
+    return [this](const Event& event) {
+      std::lock_guard<std::mutex> lk(mutex_);
+      Event copy = event;
+      if (event.data_package != nullptr)
+      {
+        double timestamp = -1.0;
+        event.data_package->getData(recipe_->getFieldHandle<double>("timestamp"), timestamp);
+        timestamps_.push_back(timestamp);
+        copy.data_package = nullptr;
+      }
+      events_.push_back(copy);
+    };
+  }
+
+  bool waitForEvents(const size_t count, const std::chrono::milliseconds timeout = std::chrono::seconds(1))
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+      {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (events_.size() >= count)
+        {
+          return true;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  std::mutex mutex_;
+  std::vector<Event> events_;
+  std::vector<double> timestamps_;
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_ =
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp" });
+};
+
+TEST_F(EventStreamTest, events_delivered_in_robot_time_order)
+{
+  auto clock = std::make_shared<rtde_interface::ClockSynchronizer>();
+  clock->update(0.0, std::chrono::steady_clock::now());
+  EventStream stream(record(), clock);
+
+  // The package is received first, but has been measured last
+  rtde_interface::DataPackage package(recipe_);
+  package.initEmpty();
+  double timestamp = 10.0;
+  package.setData("timestamp", timestamp);
+  EXPECT_TRUE(stream.pushDataPackage(package));
+  EXPECT_TRUE(stream.pushTrajectoryResult(control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
+  EXPECT_TRUE(stream.pushToolContactResult(control::ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS));
+
+  ASSERT_TRUE(waitForEvents(3));
+  std::lock_guard<std::mutex> lk(mutex_);
+  EXPECT_EQ(events_[0].source, EventSource::TRAJECTORY_RESULT);
+  EXPECT_EQ(events_[0].trajectory_result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(events_[1].source, EventSource::TOOL_CONTACT_RESULT);
+  EXPECT_EQ(events_[1].tool_contact_result, control::ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS);
+  EXPECT_EQ(events_[2].source, EventSource::DATA_PACKAGE);
+  EXPECT_DOUBLE_EQ(events_[2].robot_time, 10.0);
+}
+
+TEST_F(EventStreamTest, data_packages_keep_their_order_and_content)
+{
+  EventStream stream(record());
+  rtde_interface::DataPackage package(recipe_);
+  package.initEmpty();
+  const size_t num_packages = 100;
+  for (size_t i = 0; i < num_packages; ++i)
+  {
+    double timestamp = i * 0.002;
+    package.setData("timestamp", timestamp);
+    EXPECT_TRUE(stream.pushDataPackage(package));
+    if (i % 10 == 0)
+    {
+      // Lets the stream deliver packages and hand their copies back for reuse
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  // Without a clock, results are stamped with the robot time of the latest package
+  EXPECT_TRUE(stream.pushTrajectoryResult(control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED));
+
+  ASSERT_TRUE(waitForEvents(num_packages + 1));
+  std::lock_guard<std::mutex> lk(mutex_);
+  for (size_t i = 0; i < num_packages; ++i)
+  {
+    EXPECT_EQ(events_[i].source, EventSource::DATA_PACKAGE);
+    EXPECT_DOUBLE_EQ(events_[i].robot_time, i * 0.002);
+    EXPECT_DOUBLE_EQ(timestamps_[i], i * 0.002);
+  }
+  EXPECT_EQ(events_[num_packages].source, EventSource::TRAJECTORY_RESULT);
+  EXPECT_DOUBLE_EQ(events_[num_packages].robot_time, (num_packages - 1) * 0.002);
+}
+
+TEST_F(EventStreamTest, robot_messages_forwarded_by_primary_consumer)
+{
+  EventStream stream(record());
+  auto consumer = stream.createPrimaryConsumer();
+  auto message = std::make_shared<primary_interface::ErrorCodeMessage>(42, 0);
+  EXPECT_TRUE(consumer->consume(message));
+
+  ASSERT_TRUE(waitForEvents(1));
+  std::lock_guard<std::mutex> lk(mutex_);
+  EXPECT_EQ(events_[0].source, EventSource::ROBOT_MESSAGE);
+  EXPECT_EQ(events_[0].robot_message, message);
+}
+
+TEST_F(EventStreamTest, full_queue_drops_events)
+{
+  EventStream stream(record(), nullptr, std::chrono::milliseconds(20), 1);
+  const size_t num_results = 10;
+  size_t accepted = 0;
+  for (size_t i = 0; i < num_results; ++i)
+  {
+    accepted += stream.pushTrajectoryResult(control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS) ? 1 : 0;
+  }
+  EXPECT_LT(accepted, num_results);
+  EXPECT_EQ(stream.getDroppedCount(EventSource::TRAJECTORY_RESULT), num_results - accepted);
+  EXPECT_EQ(stream.getDroppedCount(EventSource::DATA_PACKAGE), 0u);
+
+  ASSERT_TRUE(waitForEvents(accepted));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::lock_guard<std::mutex> lk(mutex_);
+  EXPECT_EQ(events_.size(), accepted);
+}
@@ -0,0 +1,132 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "ur_client_library/comm/execution_budget.h"
+#include "ur_client_library/comm/pipeline.h"
+
+using namespace urcl;
+
+TEST(ExecutionBudget, invocation_within_budget)
+{
+  comm::ExecutionBudget budget("within", std::chrono::milliseconds(2));
+  budget.record(std::chrono::microseconds(500), std::chrono::microseconds(400));
+  budget.record(std::chrono::microseconds(800), std::chrono::microseconds(300));
+
+  EXPECT_EQ(budget.getInvocations(), 2u);
+  EXPECT_EQ(budget.getOverruns(), 0u);
+  EXPECT_EQ(budget.getMaxWallTime(), std::chrono::microseconds(800));
+  EXPECT_EQ(budget.getMaxCpuTime(), std::chrono::microseconds(400));
+  comm::BudgetOverrun overrun;
+  EXPECT_FALSE(budget.getLastOverrun(overrun));
+}
+
+TEST(ExecutionBudget, overrun_is_reported)
+{
+  comm::ExecutionBudget budget("overrun", std::chrono::milliseconds(2), { { "host", "budget_test" } });
+  std::vector<comm::BudgetOverrun> handled;
+  budget.setOverrunHandler([&handled](const comm::BudgetOverrun& overrun) { handled.push_back(overrun); });
+
+  budget.record(std::chrono::microseconds(1000), std::chrono::microseconds(1000));
+  budget.record(std::chrono::microseconds(3000), std::chrono::microseconds(200));
+
+  EXPECT_EQ(budget.getOverruns(), 1u);
+  ASSERT_EQ(handled.size(), 1u);
+  EXPECT_EQ(handled[0].name, "overrun");
+  EXPECT_EQ(handled[0].wall_time, std::chrono::microseconds(3000));
+  EXPECT_EQ(handled[0].cpu_time, std::chrono::microseconds(200));
+  EXPECT_EQ(handled[0].budget, std::chrono::milliseconds(2));
+
+  comm::BudgetOverrun overrun;
+  ASSERT_TRUE(budget.getLastOverrun(overrun));
+  EXPECT_EQ(overrun.wall_time, std::chrono::microseconds(3000));
+  EXPECT_EQ(getMetricsRegistry()
+                .getCounter("urcl_execution_budget_overruns_total", "",
+                            { { "budget", "overrun" }, { "host", "budget_test" } })
+                .getValue(),
+            1u);
+
+  budget.reset();
+  EXPECT_EQ(budget.getInvocations(), 0u);
+  EXPECT_EQ(budget.getOverruns(), 0u);
+  EXPECT_FALSE(budget.getLastOverrun(overrun));
+}
+
+TEST(ExecutionBudget, measurement_separates_cpu_and_wall_time)
+{
+  comm::ExecutionBudget budget("sleeping", std::chrono::milliseconds(1));
+  {
+    comm::ExecutionBudget::Measurement measurement(&budget);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(budget.getInvocations(), 1u);
+  EXPECT_EQ(budget.getOverruns(), 1u);
+  EXPECT_GE(budget.getMaxWallTime(), std::chrono::milliseconds(5));
+  // Sleeping doesn't use the CPU
+  EXPECT_LT(budget.getMaxCpuTime(), std::chrono::milliseconds(2));
+
+  // Measuring without a budget does nothing
+  comm::ExecutionBudget::Measurement measurement(nullptr);
+}
+
+TEST(ExecutionBudget, multi_consumer_budgets)
+{
+  class SleepingConsumer : public comm::IConsumer<int>
+  {
+  public:
+    explicit SleepingConsumer(std::chrono::milliseconds duration) : duration_(duration)
+    {
+    }
+    bool consume(std::shared_ptr<int>) override
+    {
+      std::this_thread::sleep_for(duration_);
+      return true;
+    }
+    std::chrono::milliseconds duration_;
+  };
+
+  SleepingConsumer fast(std::chrono::milliseconds(0));
+  SleepingConsumer slow(std::chrono::milliseconds(3));
+  comm::MultiConsumer<int> consumer({ &fast, &slow });
+  auto fast_budget = std::make_shared<comm::ExecutionBudget>("fast", std::chrono::milliseconds(2));
+  auto slow_budget = std::make_shared<comm::ExecutionBudget>("slow", std::chrono::milliseconds(2));
+  consumer.setConsumerBudget(0, fast_budget);
+  consumer.setConsumerBudget(1, slow_budget);
+
+  EXPECT_TRUE(consumer.consume(std::make_shared<int>(1)));
+  EXPECT_EQ(fast_budget->getInvocations(), 1u);
+  EXPECT_EQ(fast_budget->getOverruns(), 0u);
+  EXPECT_EQ(slow_budget->getInvocations(), 1u);
+  EXPECT_EQ(slow_budget->getOverruns(), 1u);
+  EXPECT_THROW(consumer.setConsumerBudget(2, nullptr), std::out_of_range);
+}
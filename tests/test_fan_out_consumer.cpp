@@ -0,0 +1,167 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/fan_out_consumer.h>
+
+using namespace urcl;
+
+namespace
+{
+struct TestProduct
+{
+  explicit TestProduct(const int value) : value(value)
+  {
+    timestamps.enqueue = std::chrono::steady_clock::now();
+  }
+
+  const comm::PackageTimestamps& getTimestamps() const
+  {
+    return timestamps;
+  }
+
+  int value;
+  comm::PackageTimestamps timestamps;
+};
+
+class TestConsumer : public comm::IConsumer<TestProduct>
+{
+public:
+  explicit TestConsumer(const std::chrono::milliseconds delay = std::chrono::milliseconds(0), const bool fail = false)
+    : delay_(delay), fail_(fail)
+  {
+  }
+
+  bool consume(std::shared_ptr<TestProduct> product) override
+  {
+    std::this_thread::sleep_for(delay_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    values_.push_back(product->value);
+    return !fail_;
+  }
+
+  void stopConsumer() override
+  {
+    stopped_ = true;
+  }
+
+  std::vector<int> getValues()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return values_;
+  }
+
+  std::atomic<bool> stopped_{ false };
+
+private:
+  std::chrono::milliseconds delay_;
+  bool fail_;
+  std::mutex mutex_;
+  std::vector<int> values_;
+};
+}  // namespace
+
+TEST(fan_out_consumer, slow_consumer_does_not_delay_real_time_consumer)
+{
+  TestConsumer real_time;
+  TestConsumer slow(std::chrono::milliseconds(50));
+  comm::FanOutConsumer<TestProduct> fan_out;
+  const size_t real_time_index = fan_out.addConsumer(&real_time, true);
+  const size_t slow_index = fan_out.addConsumer(&slow, false, 2);
+  fan_out.setupConsumer();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(fan_out.consume(std::make_shared<TestProduct>(i)));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+
+  EXPECT_EQ(real_time.getValues(), (std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+  EXPECT_EQ(fan_out.getNumConsumed(real_time_index), 10u);
+  EXPECT_EQ(fan_out.getLag(real_time_index).getCount(), 10u);
+  EXPECT_EQ(fan_out.getNumDropped(real_time_index), 0u);
+  EXPECT_GE(fan_out.getNumDropped(slow_index), 7u);
+  EXPECT_EQ(fan_out.getQueueHighWaterMark(slow_index), 2u);
+
+  fan_out.stopConsumer();
+  EXPECT_TRUE(real_time.stopped_);
+  EXPECT_TRUE(slow.stopped_);
+  EXPECT_LE(slow.getValues().size(), 3u);
+  EXPECT_EQ(fan_out.getLag(slow_index).getCount(), slow.getValues().size());
+}
+
+TEST(fan_out_consumer, blocking_consumer_receives_all_products)
+{
+  TestConsumer consumer(std::chrono::milliseconds(1));
+  comm::FanOutConsumer<TestProduct> fan_out;
+  const size_t index = fan_out.addConsumer(&consumer, false, 2, comm::OverflowPolicy::BLOCK);
+
+  std::vector<int> expected;
+  for (int i = 0; i < 20; ++i)
+  {
+    EXPECT_TRUE(fan_out.consume(std::make_shared<TestProduct>(i)));
+    expected.push_back(i);
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (consumer.getValues().size() < expected.size() && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  fan_out.stopConsumer();
+
+  EXPECT_EQ(consumer.getValues(), expected);
+  EXPECT_EQ(fan_out.getNumDropped(index), 0u);
+  EXPECT_EQ(fan_out.getNumConsumed(index), 20u);
+}
+
+TEST(fan_out_consumer, failing_real_time_consumer)
+{
+  TestConsumer failing(std::chrono::milliseconds(0), true);
+  TestConsumer other;
+  comm::FanOutConsumer<TestProduct> fan_out;
+  fan_out.addConsumer(&failing, true);
+  fan_out.addConsumer(&other, true);
+
+  EXPECT_FALSE(fan_out.consume(std::make_shared<TestProduct>(1)));
+  EXPECT_EQ(other.getValues(), std::vector<int>{ 1 });
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
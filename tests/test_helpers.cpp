@@ -0,0 +1,322 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <ur_client_library/helpers.h>
+
+using namespace urcl;
+
+namespace
+{
+std::string getThreadName(pthread_t thread)
+{
+  char name[16];
+  EXPECT_EQ(pthread_getname_np(thread, name, sizeof(name)), 0);
+  return name;
+}
+
+// Returns the first CPU the process may run on
+int getAllowedCpu()
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  EXPECT_EQ(sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpu_set))
+    {
+      return cpu;
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+class ThreadConfigTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    keep_running_ = true;
+    thread_ = std::thread([this]() {
+      while (keep_running_)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  }
+
+  void TearDown()
+  {
+    keep_running_ = false;
+    thread_.join();
+  }
+
+  std::atomic<bool> keep_running_;
+  std::thread thread_;
+};
+
+TEST_F(ThreadConfigTest, empty_config_keeps_thread_unchanged)
+{
+  const std::string name_before = getThreadName(thread_.native_handle());
+  ThreadConfig config;
+  EXPECT_TRUE(config.empty());
+  EXPECT_TRUE(applyThreadConfig(thread_.native_handle(), config));
+  EXPECT_EQ(getThreadName(thread_.native_handle()), name_before);
+}
+
+TEST_F(ThreadConfigTest, apply_name_and_affinity)
+{
+  const int cpu = getAllowedCpu();
+  ThreadConfig config;
+  config.name = "urcl_test";
+  config.cpus = { cpu };
+  EXPECT_FALSE(config.empty());
+  EXPECT_TRUE(applyThreadConfig(thread_.native_handle(), config));
+
+  EXPECT_EQ(getThreadName(thread_.native_handle()), "urcl_test");
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  ASSERT_EQ(pthread_getaffinity_np(thread_.native_handle(), sizeof(cpu_set), &cpu_set), 0);
+  EXPECT_EQ(CPU_COUNT(&cpu_set), 1);
+  EXPECT_TRUE(CPU_ISSET(cpu, &cpu_set));
+}
+
+TEST_F(ThreadConfigTest, long_names_are_truncated)
+{
+  ThreadConfig config;
+  config.name = "a_very_long_thread_name";
+  EXPECT_TRUE(applyThreadConfig(thread_.native_handle(), config));
+  EXPECT_EQ(getThreadName(thread_.native_handle()), "a_very_long_thr");
+}
+
+TEST_F(ThreadConfigTest, apply_scheduling_policy)
+{
+  ThreadConfig config;
+  config.policy = SCHED_OTHER;
+  config.priority = 0;
+  EXPECT_TRUE(applyThreadConfig(thread_.native_handle(), config));
+
+  int policy;
+  sched_param params;
+  ASSERT_EQ(pthread_getschedparam(thread_.native_handle(), &policy, &params), 0);
+  EXPECT_EQ(policy, SCHED_OTHER);
+}
+
+TEST_F(ThreadConfigTest, invalid_cpu_fails)
+{
+  ThreadConfig config;
+  config.cpus = { -1 };
+  EXPECT_FALSE(applyThreadConfig(thread_.native_handle(), config));
+}
+
+TEST(ThreadConfig, name_suffix)
+{
+  ThreadConfig config;
+  EXPECT_EQ(config.withNameSuffix("rx").name, "");
+
+  config.name = "urcl";
+  config.cpus = { 1 };
+  ThreadConfig suffixed = config.withNameSuffix("rx");
+  EXPECT_EQ(suffixed.name, "urcl_rx");
+  EXPECT_EQ(suffixed.cpus, config.cpus);
+}
+
+TEST(ThreadConfig, numa_node_of_cpus)
+{
+  EXPECT_EQ(getNumaNode(ThreadConfig()), -1);
+  EXPECT_EQ(getNumaNode(100000), -1);
+
+  ThreadConfig config;
+  config.cpus = { 0 };
+  EXPECT_EQ(getNumaNode(config), getNumaNode(0));
+}
+
+TEST(ThreadConfig, run_on_numa_node)
+{
+  // Without CPUs, the function runs on the calling thread
+  std::thread::id id;
+  runOnNumaNode(ThreadConfig(), [&id]() { id = std::this_thread::get_id(); });
+  EXPECT_EQ(id, std::this_thread::get_id());
+
+  ThreadConfig config;
+  config.cpus = { 0 };
+  int cpu = -1;
+  runOnNumaNode(config, [&]() {
+    id = std::this_thread::get_id();
+    cpu = sched_getcpu();
+  });
+  EXPECT_NE(id, std::this_thread::get_id());
+  EXPECT_EQ(cpu, 0);
+
+  EXPECT_THROW(runOnNumaNode(config, []() { throw std::runtime_error("failed"); }), std::runtime_error);
+}
+
+TEST(ThreadStackSize, applies_to_new_threads)
+{
+  const size_t previous = getThreadStackSize();
+  EXPECT_FALSE(setThreadStackSize(1));
+
+  const size_t stack_size = 256 * 1024;
+  ASSERT_TRUE(setThreadStackSize(stack_size));
+  EXPECT_EQ(getThreadStackSize(), stack_size);
+  size_t thread_stack_size = 0;
+  std::thread thread([&thread_stack_size]() {
+    pthread_attr_t attr;
+    pthread_getattr_np(pthread_self(), &attr);
+    pthread_attr_getstacksize(&attr, &thread_stack_size);
+    pthread_attr_destroy(&attr);
+  });
+  thread.join();
+  EXPECT_EQ(thread_stack_size, stack_size);
+
+  if (previous > 0)
+  {
+    setThreadStackSize(previous);
+  }
+}
+
+TEST(ThreadStackSize, memory_footprint)
+{
+  const MemoryFootprint footprint = getMemoryFootprint();
+  EXPECT_GT(footprint.resident_bytes, 0u);
+  EXPECT_GE(footprint.virtual_bytes, footprint.resident_bytes);
+  EXPECT_GE(footprint.num_threads, 1u);
+  EXPECT_EQ(footprint.thread_stack_size, getThreadStackSize());
+}
+
+TEST(RealtimeSetup, parse_cpu_list)
+{
+  EXPECT_EQ(parseCpuList(""), std::vector<int>());
+  EXPECT_EQ(parseCpuList("3"), std::vector<int>({ 3 }));
+  EXPECT_EQ(parseCpuList("0-2,5"), std::vector<int>({ 0, 1, 2, 5 }));
+  EXPECT_EQ(parseCpuList("1,x,4-"), std::vector<int>({ 1 }));
+}
+
+TEST(RealtimeSetup, disabled_config_reports_nothing)
+{
+  RealtimeSetupConfig config;
+  config.lock_memory = false;
+  config.stack_prefault_size = 0;
+  config.heap_prefault_size = 0;
+  RealtimeSetupReport report = setupRealtimeProcess(config);
+  EXPECT_TRUE(report.ok());
+  EXPECT_FALSE(report.memory_locked);
+  EXPECT_FALSE(report.memory_prefaulted);
+}
+
+TEST(RealtimeSetup, reports_non_isolated_cpus)
+{
+  const std::vector<int> isolated = getIsolatedCpus();
+  const int cpu = getAllowedCpu();
+
+  RealtimeSetupConfig config;
+  config.lock_memory = false;
+  config.cpus = { cpu };
+  RealtimeSetupReport report = setupRealtimeProcess(config);
+  EXPECT_TRUE(report.memory_prefaulted);
+  const bool is_isolated = std::find(isolated.begin(), isolated.end(), cpu) != isolated.end();
+  EXPECT_EQ(report.non_isolated_cpus.empty(), is_isolated);
+  EXPECT_EQ(report.ok(), is_isolated);
+}
+
+TEST(RealtimeSetup, problems_match_report)
+{
+  RealtimeSetupConfig config;
+  config.fifo_priority = 1;
+  RealtimeSetupReport report = setupRealtimeProcess(config);
+  size_t expected_problems = 0;
+  expected_problems += report.memory_locked ? 0 : 1;
+  expected_problems += report.fifo_permitted ? 0 : 1;
+  EXPECT_EQ(report.problems.size(), expected_problems);
+  if (report.memory_locked)
+  {
+    munlockall();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
+
+TEST(PriorityInheritanceMutex, try_lock_fails_while_locked)
+{
+  PriorityInheritanceMutex mutex;
+  std::unique_lock<PriorityInheritanceMutex> lock(mutex);
+  bool acquired = true;
+  std::thread([&] { acquired = mutex.try_lock(); }).join();
+  EXPECT_FALSE(acquired);
+
+  lock.unlock();
+  std::thread([&] {
+    acquired = mutex.try_lock();
+    if (acquired)
+    {
+      mutex.unlock();
+    }
+  }).join();
+  EXPECT_TRUE(acquired);
+}
+
+TEST(PriorityInheritanceMutex, excludes_concurrent_threads)
+{
+  PriorityInheritanceMutex mutex;
+  int counter = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 10000; ++j)
+      {
+        std::lock_guard<PriorityInheritanceMutex> lock(mutex);
+        ++counter;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(counter, 40000);
+}
@@ -98,6 +98,19 @@ TEST_F(InstructionExecutorTest, execute_motion_sequence_success)
   ASSERT_TRUE(executor_->executeMotion(motion_sequence));
 }
 
+TEST_F(InstructionExecutorTest, execute_motion_sequence_by_value_success)
+{
+  std::vector<urcl::control::MotionPrimitiveValue> motion_sequence{
+    urcl::control::MoveJPrimitive(urcl::vector6d_t{ -1.57, -1.57, 0, 0, 0, 0 }, 0.1, std::chrono::seconds(5)),
+    urcl::control::MoveJPrimitive(urcl::vector6d_t{ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }, 0.1, std::chrono::seconds(5)),
+    urcl::control::MoveLPrimitive(urcl::Pose{ -0.203, 0.263, 0.559, 0.68, -1.083, -2.076 }, 0.1,
+                                  std::chrono::seconds(2)),
+    urcl::control::MoveLPrimitive(urcl::Pose{ -0.203, 0.463, 0.559, 0.68, -1.083, -2.076 }, 0.1,
+                                  std::chrono::seconds(2)),
+  };
+  ASSERT_TRUE(executor_->executeMotion(motion_sequence));
+}
+
 TEST_F(InstructionExecutorTest, execute_movej_success)
 {
   // default parametrization
@@ -269,6 +282,72 @@ TEST_F(InstructionExecutorTest, empty_sequence_succeeds)
   ASSERT_TRUE(executor_->executeMotion(motion_sequence));
 }
 
+TEST_F(InstructionExecutorTest, execute_motion_async_success)
+{
+  ASSERT_TRUE(executor_->moveJ({ -1.57, -1.57, 0, 0, 0, 0 }));
+  std::future<urcl::control::TrajectoryResult> result =
+      executor_->moveJAsync({ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }, 1.4, 1.04, 2);
+  EXPECT_TRUE(executor_->isTrajectoryRunning());
+
+  // Only one sequence can be executed at a time
+  std::future<urcl::control::TrajectoryResult> rejected = executor_->moveJAsync({ -1.57, -1.57, 0, 0, 0, 0 });
+  ASSERT_EQ(rejected.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_EQ(rejected.get(), urcl::control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_EQ(result.get(), urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_FALSE(executor_->isTrajectoryRunning());
+}
+
+TEST_F(InstructionExecutorTest, execute_motion_queue_success)
+{
+  ASSERT_TRUE(executor_->moveJ({ -1.57, -1.57, 0, 0, 0, 0 }));
+  EXPECT_FALSE(executor_->queueMotion({ std::make_shared<urcl::control::MoveJPrimitive>(
+      urcl::vector6d_t{ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }) }));
+
+  std::future<urcl::control::TrajectoryResult> result = executor_->startMotionQueue(2);
+  ASSERT_TRUE(executor_->isQueueing());
+  for (int i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(executor_->queueMotion({ std::make_shared<urcl::control::MoveJPrimitive>(
+        urcl::vector6d_t{ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }, 0.1, std::chrono::seconds(1)) }));
+    ASSERT_TRUE(executor_->queueMotion({ std::make_shared<urcl::control::MoveJPrimitive>(
+        urcl::vector6d_t{ -1.57, -1.57, 0, 0, 0, 0 }, i == 1 ? 0.0 : 0.1, std::chrono::seconds(1)) }));
+  }
+  ASSERT_TRUE(executor_->endMotionQueue());
+  EXPECT_FALSE(executor_->isQueueing());
+
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_EQ(result.get(), urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+}
+
+TEST_F(InstructionExecutorTest, execute_mixed_primitives_success)
+{
+  // move to a feasible starting pose
+  ASSERT_TRUE(executor_->moveJ({ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }));
+  ASSERT_TRUE(executor_->moveL({ -0.203, 0.263, 0.559, 0.68, -1.083, -2.076 }));
+  ASSERT_TRUE(executor_->moveP({ -0.203, 0.463, 0.559, 0.68, -1.083, -2.076 }, 1.2, 0.25));
+  ASSERT_TRUE(executor_->moveC({ -0.103, 0.363, 0.559, 0.68, -1.083, -2.076 },
+                               { -0.203, 0.263, 0.559, 0.68, -1.083, -2.076 }, 1.2, 0.25));
+
+  // Consecutive primitives of the same kind are sent together, mixed sequences have to keep
+  // their order.
+  std::vector<std::shared_ptr<urcl::control::MotionPrimitive>> motion_sequence{
+    std::make_shared<urcl::control::MovePPrimitive>(urcl::Pose{ -0.203, 0.463, 0.559, 0.68, -1.083, -2.076 }, 0.05),
+    std::make_shared<urcl::control::MovePPrimitive>(urcl::Pose{ -0.203, 0.363, 0.559, 0.68, -1.083, -2.076 }),
+    std::make_shared<urcl::control::MoveCPrimitive>(urcl::Pose{ -0.103, 0.313, 0.559, 0.68, -1.083, -2.076 },
+                                                    urcl::Pose{ -0.203, 0.263, 0.559, 0.68, -1.083, -2.076 }),
+    std::make_shared<urcl::control::MoveJPrimitive>(urcl::vector6d_t{ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 }),
+    std::make_shared<urcl::control::SplinePrimitive>(urcl::vector6d_t{ -1.57, -1.57, 1.6, -0.7, 0.7, 0.2 },
+                                                     urcl::vector6d_t{ 0, 0, 0, 0, 0, 0 }, std::nullopt,
+                                                     std::chrono::seconds(1)),
+    std::make_shared<urcl::control::SplinePrimitive>(urcl::vector6d_t{ -1.57, -1.6, 1.6, -0.7, 0.7, 0.2 },
+                                                     urcl::vector6d_t{ 0, 0, 0, 0, 0, 0 },
+                                                     urcl::vector6d_t{ 0, 0, 0, 0, 0, 0 }, std::chrono::seconds(1)),
+  };
+  ASSERT_TRUE(executor_->executeMotion(motion_sequence));
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
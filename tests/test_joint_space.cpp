@@ -0,0 +1,150 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "ur_client_library/joint_space.h"
+
+using namespace urcl;
+
+TEST(joint_space, element_wise_operations)
+{
+  const vector6d_t a = { 1.0, -2.0, 3.0, -4.0, 5.0, -6.0 };
+  const vector6d_t b = { 0.5, 0.5, 0.5, 0.5, 0.5, 0.5 };
+
+  const vector6d_t sum = joint_space::add(a, b);
+  const vector6d_t difference = joint_space::subtract(a, b);
+  const vector6d_t scaled = joint_space::scale(a, 2.0);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_DOUBLE_EQ(sum[i], a[i] + b[i]);
+    EXPECT_DOUBLE_EQ(difference[i], a[i] - b[i]);
+    EXPECT_DOUBLE_EQ(scaled[i], 2.0 * a[i]);
+  }
+
+  EXPECT_DOUBLE_EQ(joint_space::dot(a, b), -1.5);
+  EXPECT_DOUBLE_EQ(joint_space::norm(a), std::sqrt(91.0));
+  EXPECT_DOUBLE_EQ(joint_space::maxAbs(a), 6.0);
+  EXPECT_DOUBLE_EQ(joint_space::maxAbsDifference(a, b), 6.5);
+}
+
+TEST(joint_space, limits)
+{
+  const vector6d_t lower = { -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+  const vector6d_t upper = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+  EXPECT_TRUE(joint_space::withinLimits({ -1.0, 0.0, 0.5, 1.0, -0.5, 0.0 }, lower, upper));
+  EXPECT_TRUE(joint_space::withinLimits({ -1.0, 0.0, 0.5, 1.0, -0.5, 0.0 }, upper));
+  for (size_t i = 0; i < 6; ++i)
+  {
+    vector6d_t q = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    q[i] = 1.5;
+    EXPECT_FALSE(joint_space::withinLimits(q, lower, upper)) << "joint " << i;
+    q[i] = -1.5;
+    EXPECT_FALSE(joint_space::withinLimits(q, upper)) << "joint " << i;
+    q[i] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(joint_space::withinLimits(q, lower, upper)) << "joint " << i;
+  }
+
+  const vector6d_t clamped = joint_space::clamp({ -2.0, 0.5, 2.0, -0.5, 1.0, -1.0 }, lower, upper);
+  const vector6d_t expected = { -1.0, 0.5, 1.0, -0.5, 1.0, -1.0 };
+  EXPECT_EQ(clamped, expected);
+}
+
+TEST(joint_space, tcp_errors)
+{
+  const vector6d_t a = { 0.1, 0.2, 0.3, 0.0, 0.0, 0.0 };
+  const vector6d_t b = { 0.1, 0.5, 0.7, 0.0, 0.0, 0.3 };
+  EXPECT_DOUBLE_EQ(joint_space::tcpPositionError(a, b), 0.5);
+  EXPECT_NEAR(joint_space::tcpOrientationError(a, b), 0.3, 1e-12);
+  EXPECT_NEAR(joint_space::tcpOrientationError(b, a), 0.3, 1e-12);
+  EXPECT_NEAR(joint_space::tcpOrientationError(b, b), 0.0, 1e-12);
+
+  // Rotations by almost pi around opposite axes are only slightly apart
+  const vector6d_t c = { 0.0, 0.0, 0.0, M_PI - 0.01, 0.0, 0.0 };
+  const vector6d_t d = { 0.0, 0.0, 0.0, -(M_PI - 0.01), 0.0, 0.0 };
+  EXPECT_NEAR(joint_space::tcpOrientationError(c, d), 0.02, 1e-9);
+}
+
+TEST(joint_space, differentiator_estimates_velocity_and_acceleration)
+{
+  joint_space::JointStateDifferentiator differentiator;
+  const double dt = 0.002;
+  const vector6d_t acceleration = { 1.0, -2.0, 0.5, 0.0, 3.0, -1.0 };
+
+  EXPECT_FALSE(differentiator.hasVelocity());
+  for (size_t step = 0; step < 10; ++step)
+  {
+    const double t = step * dt;
+    ASSERT_TRUE(differentiator.update(joint_space::scale(acceleration, 0.5 * t * t), dt));
+  }
+  EXPECT_TRUE(differentiator.hasVelocity());
+  EXPECT_TRUE(differentiator.hasAcceleration());
+
+  // Backward differences lag half a sample behind for the velocity
+  const double t = 9 * dt;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_NEAR(differentiator.getVelocities()[i], acceleration[i] * (t - 0.5 * dt), 1e-9);
+    EXPECT_NEAR(differentiator.getAccelerations()[i], acceleration[i], 1e-6);
+  }
+
+  EXPECT_FALSE(differentiator.update(acceleration, 0.0));
+  differentiator.reset();
+  EXPECT_FALSE(differentiator.hasVelocity());
+  EXPECT_EQ(differentiator.getVelocities(), vector6d_t({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }));
+}
+
+TEST(joint_space, differentiator_smoothing)
+{
+  EXPECT_THROW(joint_space::JointStateDifferentiator(0.0), UrException);
+  EXPECT_THROW(joint_space::JointStateDifferentiator(1.5), UrException);
+
+  joint_space::JointStateDifferentiator differentiator(0.5);
+  const vector6d_t zero = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  const vector6d_t one = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  differentiator.update(zero, 1.0);
+  differentiator.update(zero, 1.0);
+  // A step of the velocity from 0 to 1 only passes through halfway
+  differentiator.update(one, 1.0);
+  EXPECT_DOUBLE_EQ(differentiator.getVelocities()[0], 0.5);
+  differentiator.update(joint_space::scale(one, 2.0), 1.0);
+  EXPECT_DOUBLE_EQ(differentiator.getVelocities()[0], 0.75);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,209 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ur_client_library/joint_space.h"
+#include "ur_client_library/kinematics.h"
+
+using namespace urcl;
+
+namespace
+{
+// Nominal parameters of a UR5e
+kinematics::DHParameters ur5eParameters()
+{
+  kinematics::DHParameters parameters;
+  parameters.theta = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  parameters.a = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+  parameters.d = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+  parameters.alpha = { M_PI_2, 0.0, 0.0, M_PI_2, -M_PI_2, 0.0 };
+  return parameters;
+}
+
+// Parameters with calibration deltas of the magnitude found on real robots
+kinematics::DHParameters calibratedParameters()
+{
+  kinematics::DHParameters parameters = ur5eParameters();
+  parameters.theta = { 1.2e-5, 2.1e-4, -4.3e-4, 2.2e-4, -2.1e-5, 3.0e-6 };
+  parameters.a = { 2.5e-5, -0.4252, -0.3920, 3.1e-5, 4.2e-5, 0.0 };
+  parameters.d = { 0.16253, 1.8e-4, -1.9e-4, 0.13324, 0.09972, 0.09958 };
+  parameters.alpha = { 1.5707, 1.2e-4, 4.1e-4, 1.5702, -1.5711, 0.0 };
+  return parameters;
+}
+
+std::vector<vector6d_t> randomConfigurations(const size_t count)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-M_PI, M_PI);
+  std::vector<vector6d_t> configurations(count);
+  for (auto& q : configurations)
+  {
+    for (auto& angle : q)
+    {
+      angle = distribution(generator);
+    }
+  }
+  return configurations;
+}
+
+void expectPoseNear(const vector6d_t& a, const vector6d_t& b)
+{
+  EXPECT_LT(joint_space::tcpPositionError(a, b), 1e-9);
+  EXPECT_LT(joint_space::tcpOrientationError(a, b), 1e-9);
+}
+}  // namespace
+
+TEST(kinematics, forward_zero_configuration)
+{
+  kinematics::KinematicsModel model(ur5eParameters());
+  const vector6d_t pose = model.forward({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+  EXPECT_NEAR(pose[0], -0.8172, 1e-12);
+  EXPECT_NEAR(pose[1], -0.2329, 1e-12);
+  EXPECT_NEAR(pose[2], 0.0628, 1e-12);
+  // The flange points along -y, rotated by pi/2 around x
+  expectPoseNear(pose, { -0.8172, -0.2329, 0.0628, M_PI_2, 0.0, 0.0 });
+}
+
+TEST(kinematics, tcp_offset)
+{
+  kinematics::KinematicsModel model(ur5eParameters());
+  const vector6d_t q = { 0.3, -1.2, 1.1, -0.5, 1.4, 0.2 };
+  const vector6d_t flange = model.forward(q);
+  model.setTcpOffset({ 0.0, 0.0, 0.1, 0.0, 0.0, 0.0 });
+  const vector6d_t tcp = model.forward(q);
+  EXPECT_NEAR(joint_space::tcpPositionError(flange, tcp), 0.1, 1e-12);
+  EXPECT_LT(joint_space::tcpOrientationError(flange, tcp), 1e-12);
+}
+
+TEST(kinematics, batch_forward_matches_single)
+{
+  kinematics::KinematicsModel model(calibratedParameters());
+  model.setTcpOffset({ 0.01, -0.02, 0.15, 0.1, 0.2, -0.3 });
+  const std::vector<vector6d_t> configurations = randomConfigurations(101);
+  std::vector<vector6d_t> poses;
+  model.forward(configurations, poses);
+  ASSERT_EQ(poses.size(), configurations.size());
+  for (size_t i = 0; i < configurations.size(); ++i)
+  {
+    const vector6d_t expected = model.forward(configurations[i]);
+    for (size_t j = 0; j < 6; ++j)
+    {
+      EXPECT_NEAR(poses[i][j], expected[j], 1e-12);
+    }
+  }
+}
+
+TEST(kinematics, inverse_returns_all_solutions)
+{
+  kinematics::KinematicsModel model(ur5eParameters());
+  for (const auto& q : randomConfigurations(50))
+  {
+    const vector6d_t pose = model.forward(q);
+    std::array<vector6d_t, kinematics::KinematicsModel::MAX_IK_SOLUTIONS> solutions;
+    const size_t num_solutions = model.inverse(pose, solutions);
+    ASSERT_GT(num_solutions, 0u);
+
+    bool found_original = false;
+    for (size_t i = 0; i < num_solutions; ++i)
+    {
+      expectPoseNear(model.forward(solutions[i]), pose);
+      found_original = found_original || joint_space::maxAbsDifference(solutions[i], q) < 1e-6;
+    }
+    EXPECT_TRUE(found_original);
+  }
+}
+
+TEST(kinematics, inverse_with_calibration)
+{
+  kinematics::KinematicsModel model(calibratedParameters());
+  model.setTcpOffset({ 0.0, 0.0, 0.2, 0.0, 0.0, 0.0 });
+  for (const auto& q : randomConfigurations(50))
+  {
+    const vector6d_t pose = model.forward(q);
+
+    // Starting close to the solution
+    vector6d_t solution;
+    vector6d_t q_near = q;
+    q_near[0] += 0.05;
+    q_near[3] -= 0.05;
+    ASSERT_TRUE(model.inverse(pose, q_near, solution));
+    EXPECT_LT(joint_space::maxAbsDifference(solution, q), 1e-6);
+
+    // All solutions reach the pose, too
+    std::array<vector6d_t, kinematics::KinematicsModel::MAX_IK_SOLUTIONS> solutions;
+    const size_t num_solutions = model.inverse(pose, solutions);
+    ASSERT_GT(num_solutions, 0u);
+    for (size_t i = 0; i < num_solutions; ++i)
+    {
+      expectPoseNear(model.forward(solutions[i]), pose);
+    }
+  }
+}
+
+TEST(kinematics, inverse_picks_closest_solution)
+{
+  kinematics::KinematicsModel model(ur5eParameters());
+  const vector6d_t q = { 0.4, -1.9, 1.6, -1.2, -1.5, 0.3 };
+  const vector6d_t pose = model.forward(q);
+
+  // Far away from the nearby configuration, but shifted by 2 pi in the first joint
+  vector6d_t q_near = q;
+  q_near[0] += 2.0 * M_PI + 0.6;
+  q_near[2] -= 0.6;
+  vector6d_t solution;
+  ASSERT_TRUE(model.inverse(pose, q_near, solution));
+  EXPECT_NEAR(solution[0], q[0] + 2.0 * M_PI, 1e-6);
+  for (size_t j = 1; j < 6; ++j)
+  {
+    EXPECT_NEAR(solution[j], q[j], 1e-6);
+  }
+}
+
+TEST(kinematics, unreachable_pose)
+{
+  kinematics::KinematicsModel model(ur5eParameters());
+  const vector6d_t pose = { 2.0, 0.0, 0.5, 0.0, M_PI, 0.0 };
+  std::array<vector6d_t, kinematics::KinematicsModel::MAX_IK_SOLUTIONS> solutions;
+  EXPECT_EQ(model.inverse(pose, solutions), 0u);
+  vector6d_t solution;
+  EXPECT_FALSE(model.inverse(pose, { 0.0, -1.5, 1.5, 0.0, 1.5, 0.0 }, solution));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
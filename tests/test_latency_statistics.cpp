@@ -0,0 +1,180 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/latency_statistics.h>
+
+using namespace urcl;
+
+TEST(latency_histogram, empty_histogram)
+{
+  comm::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getCount(), 0u);
+  EXPECT_EQ(histogram.getMin().count(), 0);
+  EXPECT_EQ(histogram.getMax().count(), 0);
+  EXPECT_EQ(histogram.getMean().count(), 0);
+  EXPECT_EQ(histogram.getPercentile(50).count(), 0);
+}
+
+TEST(latency_histogram, record_durations)
+{
+  comm::LatencyHistogram histogram;
+  for (int i = 1; i <= 100; ++i)
+  {
+    histogram.record(std::chrono::microseconds(i * 10));
+  }
+  EXPECT_EQ(histogram.getCount(), 100u);
+  EXPECT_EQ(histogram.getMin().count(), 10);
+  EXPECT_EQ(histogram.getMax().count(), 1000);
+  EXPECT_EQ(histogram.getMean().count(), 505);
+
+  // Buckets have a relative width of about 3%
+  EXPECT_NEAR(histogram.getPercentile(50).count(), 500, 500 * 0.04);
+  EXPECT_NEAR(histogram.getPercentile(99).count(), 990, 990 * 0.04);
+  EXPECT_EQ(histogram.getPercentile(0).count(), 10);
+  EXPECT_NEAR(histogram.getPercentile(100).count(), 1000, 1000 * 0.04);
+}
+
+TEST(latency_histogram, small_durations_are_exact)
+{
+  comm::LatencyHistogram histogram;
+  for (int i = 0; i < 32; ++i)
+  {
+    histogram.record(std::chrono::microseconds(i));
+  }
+  EXPECT_EQ(histogram.getPercentile(50).count(), 15);
+  EXPECT_EQ(histogram.getPercentile(100).count(), 31);
+}
+
+TEST(latency_histogram, negative_and_huge_durations)
+{
+  comm::LatencyHistogram histogram;
+  histogram.record(std::chrono::microseconds(-5));
+  histogram.record(std::chrono::hours(24 * 365));
+  EXPECT_EQ(histogram.getCount(), 2u);
+  EXPECT_EQ(histogram.getMin().count(), 0);
+  EXPECT_EQ(histogram.getMax(), std::chrono::hours(24 * 365));
+  EXPECT_EQ(histogram.getPercentile(0).count(), 0);
+  EXPECT_GT(histogram.getPercentile(100), std::chrono::minutes(30));
+}
+
+TEST(latency_histogram, reset)
+{
+  comm::LatencyHistogram histogram;
+  histogram.record(std::chrono::milliseconds(2));
+  histogram.reset();
+  EXPECT_EQ(histogram.getCount(), 0u);
+  EXPECT_EQ(histogram.getMax().count(), 0);
+  histogram.record(std::chrono::milliseconds(1));
+  EXPECT_EQ(histogram.getMin().count(), 1000);
+}
+
+TEST(latency_histogram, concurrent_recording)
+{
+  comm::LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&histogram, t]() {
+      for (int i = 0; i < 1000; ++i)
+      {
+        histogram.record(std::chrono::microseconds(t * 1000 + i));
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.getCount(), 4000u);
+  EXPECT_EQ(histogram.getMin().count(), 0);
+  EXPECT_EQ(histogram.getMax().count(), 3999);
+}
+
+TEST(latency_histogram, merge)
+{
+  comm::LatencyHistogram first;
+  comm::LatencyHistogram second;
+  comm::LatencyHistogram empty;
+  for (int i = 1; i <= 50; ++i)
+  {
+    first.record(std::chrono::microseconds(i));
+    second.record(std::chrono::microseconds(i + 50));
+  }
+
+  first.merge(second);
+  first.merge(empty);
+  EXPECT_EQ(first.getCount(), 100u);
+  EXPECT_EQ(first.getMin().count(), 1);
+  EXPECT_EQ(first.getMax().count(), 100);
+  EXPECT_EQ(first.getMean().count(), 50);
+
+  // Merging into an empty histogram takes over the minimum
+  empty.merge(second);
+  EXPECT_EQ(empty.getCount(), 50u);
+  EXPECT_EQ(empty.getMin().count(), 51);
+}
+
+TEST(latency_statistics, merge)
+{
+  comm::LatencyStatistics first;
+  comm::LatencyStatistics second;
+  first.receive_interval.record(std::chrono::microseconds(2000));
+  second.receive_interval.record(std::chrono::microseconds(2100));
+  second.enqueue_to_consume.record(std::chrono::microseconds(30));
+
+  first.merge(second);
+  EXPECT_EQ(first.receive_interval.getCount(), 2u);
+  EXPECT_EQ(first.receive_interval.getMax().count(), 2100);
+  EXPECT_EQ(first.enqueue_to_consume.getCount(), 1u);
+  EXPECT_EQ(first.kernel_to_receive.getCount(), 0u);
+}
+
+TEST(latency_statistics, to_string)
+{
+  comm::LatencyStatistics statistics;
+  statistics.receive_to_parse.record(std::chrono::microseconds(20));
+  const std::string summary = statistics.toString();
+  EXPECT_NE(summary.find("receive to parse: count: 1, min: 20 us"), std::string::npos);
+  EXPECT_NE(summary.find("kernel to receive: count: 0"), std::string::npos);
+  statistics.reset();
+  EXPECT_EQ(statistics.receive_to_parse.getCount(), 0u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,208 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Messages below INFO are removed from this file at compile time
+#define URCL_LOG_MIN_LEVEL 1
+#include "ur_client_library/log.h"
+
+using namespace urcl;
+
+class CountingLogHandler : public LogHandler
+{
+public:
+  explicit CountingLogHandler(std::shared_ptr<std::vector<std::string>> messages) : messages_(messages)
+  {
+  }
+
+  void log(const char* file, int line, LogLevel loglevel, const char* log) override
+  {
+    messages_->push_back(log);
+  }
+
+private:
+  std::shared_ptr<std::vector<std::string>> messages_;
+};
+
+class LogTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    registerLogHandler(std::make_unique<CountingLogHandler>(messages_));
+  }
+
+  void TearDown() override
+  {
+    unregisterLogHandler();
+    setLogLevel(LogLevel::INFO);
+    setLogRateLimit(20, std::chrono::seconds(1));
+  }
+
+  int evaluate(const int value)
+  {
+    ++evaluations_;
+    return value;
+  }
+
+  std::shared_ptr<std::vector<std::string>> messages_ = std::make_shared<std::vector<std::string>>();
+  int evaluations_ = 0;
+};
+
+TEST_F(LogTest, arguments_are_not_evaluated_below_the_log_level)
+{
+  setLogLevel(LogLevel::WARN);
+  URCL_LOG_INFO("value %d", evaluate(1));
+  EXPECT_EQ(evaluations_, 0);
+  EXPECT_TRUE(messages_->empty());
+
+  URCL_LOG_WARN("value %d", evaluate(2));
+  EXPECT_EQ(evaluations_, 1);
+  ASSERT_EQ(messages_->size(), 1u);
+  EXPECT_EQ(messages_->at(0), "value 2");
+}
+
+TEST_F(LogTest, messages_below_the_compile_time_level_are_removed)
+{
+  setLogLevel(LogLevel::DEBUG);
+  URCL_LOG_DEBUG("value %d", evaluate(1));
+  EXPECT_EQ(evaluations_, 0);
+  EXPECT_TRUE(messages_->empty());
+
+  URCL_LOG_INFO("value %d", evaluate(2));
+  EXPECT_EQ(evaluations_, 1);
+  EXPECT_EQ(messages_->size(), 1u);
+}
+
+TEST_F(LogTest, log_level_can_be_queried)
+{
+  setLogLevel(LogLevel::ERROR);
+  EXPECT_EQ(getLogLevel(), LogLevel::ERROR);
+  EXPECT_TRUE(isLogLevelEnabled(LogLevel::FATAL));
+  EXPECT_TRUE(isLogLevelEnabled(LogLevel::ERROR));
+  EXPECT_FALSE(isLogLevelEnabled(LogLevel::WARN));
+}
+
+TEST_F(LogTest, long_messages_are_logged_completely)
+{
+  const std::string text(3000, 'x');
+  URCL_LOG_ERROR("%s", text.c_str());
+  ASSERT_EQ(messages_->size(), 1u);
+  EXPECT_EQ(messages_->at(0), text);
+}
+
+TEST_F(LogTest, messages_beyond_the_rate_limit_are_suppressed)
+{
+  setLogRateLimit(3, std::chrono::milliseconds(200));
+  for (int i = 0; i < 12; ++i)
+  {
+    if (i == 10)
+    {
+      // Suppressed messages aren't formatted
+      EXPECT_EQ(evaluations_, 3);
+      ASSERT_EQ(messages_->size(), 3u);
+      EXPECT_EQ(messages_->at(2), "overflow 2");
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+    URCL_LOG_WARN("overflow %d", evaluate(i));
+  }
+  ASSERT_EQ(messages_->size(), 5u);
+  EXPECT_EQ(messages_->at(3), "overflow 10 (7 similar messages suppressed)");
+  EXPECT_EQ(messages_->at(4), "overflow 11");
+}
+
+TEST_F(LogTest, repeated_messages_are_suppressed)
+{
+  for (int i = 0; i < 5; ++i)
+  {
+    URCL_LOG_ERROR("Failed to read from stream, reconnecting");
+  }
+  ASSERT_EQ(messages_->size(), 1u);
+
+  URCL_LOG_ERROR("Other message");
+  for (const char* text : { "first", "first", "first", "second" })
+  {
+    URCL_LOG_ERROR("%s", text);
+  }
+  ASSERT_EQ(messages_->size(), 4u);
+  EXPECT_EQ(messages_->at(1), "Other message");
+  EXPECT_EQ(messages_->at(2), "first");
+  EXPECT_EQ(messages_->at(3), "second (2 similar messages suppressed)");
+}
+
+TEST_F(LogTest, call_site_counters_are_accessible)
+{
+  const uint64_t suppressed_before = getSuppressedLogCount();
+  setLogRateLimit(2, std::chrono::seconds(10));
+  int line = 0;
+  for (int i = 0; i < 6; ++i)
+  {
+    // clang-format off
+    line = __LINE__; URCL_LOG_INFO("message %d", i);
+    // clang-format on
+  }
+  EXPECT_EQ(getSuppressedLogCount(), suppressed_before + 4);
+
+  bool found = false;
+  for (const LogSiteStatistics& site : getLogSiteStatistics())
+  {
+    if (site.line == line && std::string(site.file) == __FILE__)
+    {
+      found = true;
+      EXPECT_EQ(site.level, LogLevel::INFO);
+      EXPECT_EQ(site.logged, 2u);
+      EXPECT_EQ(site.suppressed, 4u);
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST_F(LogTest, rate_limit_can_be_disabled)
+{
+  setLogRateLimit(0);
+  for (int i = 0; i < 50; ++i)
+  {
+    URCL_LOG_INFO("Pipeline producer overflowed!");
+  }
+  EXPECT_EQ(messages_->size(), 50u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <ur_client_library/memory_resource.h>
+#include <ur_client_library/primary/robot_state_frame.h>
+#include <ur_client_library/rtde/data_package.h>
+
+using namespace urcl;
+
+namespace
+{
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  size_t num_allocations = 0;
+  size_t outstanding_bytes = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++num_allocations;
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+  {
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}  // namespace
+
+class MemoryResourceTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    setMemoryResource(nullptr);
+  }
+
+  CountingResource resource_;
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_ =
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp", "actual_q" });
+};
+
+TEST_F(MemoryResourceTest, default_resource_is_new_delete)
+{
+  EXPECT_EQ(getMemoryResource(), std::pmr::new_delete_resource());
+  setMemoryResource(&resource_);
+  EXPECT_EQ(getMemoryResource(), &resource_);
+  setMemoryResource(nullptr);
+  EXPECT_EQ(getMemoryResource(), std::pmr::new_delete_resource());
+}
+
+TEST_F(MemoryResourceTest, packages_allocated_from_resource)
+{
+  setMemoryResource(&resource_);
+  std::unique_ptr<rtde_interface::DataPackage> package(new rtde_interface::DataPackage(recipe_));
+  package->initEmpty();
+  // The package object and its field values
+  EXPECT_EQ(resource_.num_allocations, 2u);
+  EXPECT_GT(resource_.outstanding_bytes, sizeof(rtde_interface::DataPackage));
+
+  std::unique_ptr<rtde_interface::DataPackage> copy(new rtde_interface::DataPackage(*package));
+  EXPECT_EQ(resource_.num_allocations, 4u);
+
+  copy.reset();
+  package.reset();
+  EXPECT_EQ(resource_.outstanding_bytes, 0u);
+}
+
+TEST_F(MemoryResourceTest, memory_returned_to_original_resource)
+{
+  setMemoryResource(&resource_);
+  std::unique_ptr<rtde_interface::DataPackage> package(new rtde_interface::DataPackage(recipe_));
+  package->initEmpty();
+  const uint8_t data[16] = {};
+  std::unique_ptr<primary_interface::RobotStateFrame> frame =
+      primary_interface::RobotStateFrame::create(data, sizeof(data), 4, 64);
+  EXPECT_EQ(resource_.num_allocations, 3u);
+
+  setMemoryResource(nullptr);
+  package.reset();
+  frame.reset();
+  EXPECT_EQ(resource_.outstanding_bytes, 0u);
+  EXPECT_EQ(resource_.num_allocations, 3u);
+}
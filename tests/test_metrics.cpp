@@ -0,0 +1,145 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/metrics.h"
+
+using namespace urcl;
+
+TEST(MetricsTest, counters_and_gauges_are_exported)
+{
+  MetricsRegistry registry;
+  registry.getCounter("urcl_test_total", "Test counter", { { "host", "a" } }).increment(3);
+  registry.getCounter("urcl_test_total", "Test counter", { { "host", "b" } }).increment();
+  registry.getGauge("urcl_test_depth", "Test gauge").set(2.5);
+
+  const std::string expected = "# HELP urcl_test_depth Test gauge\n"
+                               "# TYPE urcl_test_depth gauge\n"
+                               "urcl_test_depth 2.5\n"
+                               "# HELP urcl_test_total Test counter\n"
+                               "# TYPE urcl_test_total counter\n"
+                               "urcl_test_total{host=\"a\"} 3\n"
+                               "urcl_test_total{host=\"b\"} 1\n";
+  EXPECT_EQ(registry.exportText(), expected);
+}
+
+TEST(MetricsTest, same_labels_return_the_same_metric)
+{
+  MetricsRegistry registry;
+  Counter& first = registry.getCounter("urcl_test_total", "", { { "port", "50001" } });
+  Counter& second = registry.getCounter("urcl_test_total", "", { { "port", "50001" } });
+  EXPECT_EQ(&first, &second);
+  EXPECT_NE(&first, &registry.getCounter("urcl_test_total", "", { { "port", "50002" } }));
+}
+
+TEST(MetricsTest, histograms_are_exported_with_cumulative_buckets)
+{
+  MetricsRegistry registry;
+  Histogram& histogram = registry.getHistogram("urcl_test_seconds", "Test histogram", { 0.1, 1.0 }, { { "a", "b" } });
+  histogram.observe(0.05);
+  histogram.observe(0.1);
+  histogram.observe(0.5);
+  histogram.observe(std::chrono::seconds(2));
+  EXPECT_EQ(histogram.getBucketCount(0), 2u);
+  EXPECT_EQ(histogram.getBucketCount(1), 1u);
+  EXPECT_EQ(histogram.getBucketCount(2), 1u);
+  EXPECT_EQ(histogram.getCount(), 4u);
+  EXPECT_DOUBLE_EQ(histogram.getSum(), 2.65);
+
+  const std::string expected = "# HELP urcl_test_seconds Test histogram\n"
+                               "# TYPE urcl_test_seconds histogram\n"
+                               "urcl_test_seconds_bucket{a=\"b\",le=\"0.1\"} 2\n"
+                               "urcl_test_seconds_bucket{a=\"b\",le=\"1\"} 3\n"
+                               "urcl_test_seconds_bucket{a=\"b\",le=\"+Inf\"} 4\n"
+                               "urcl_test_seconds_sum{a=\"b\"} 2.65\n"
+                               "urcl_test_seconds_count{a=\"b\"} 4\n";
+  EXPECT_EQ(registry.exportText(), expected);
+}
+
+TEST(MetricsTest, label_values_are_escaped)
+{
+  MetricsRegistry registry;
+  registry.getGauge("urcl_test", "Line\nbreak", { { "name", "say \"hi\"\\" } }).add(-1.0);
+  const std::string expected = "# HELP urcl_test Line\\nbreak\n"
+                               "# TYPE urcl_test gauge\n"
+                               "urcl_test{name=\"say \\\"hi\\\"\\\\\"} -1\n";
+  EXPECT_EQ(registry.exportText(), expected);
+}
+
+TEST(MetricsTest, invalid_registrations_throw)
+{
+  MetricsRegistry registry;
+  registry.getCounter("urcl_test_total", "");
+  EXPECT_THROW(registry.getGauge("urcl_test_total", ""), UrException);
+  EXPECT_THROW(registry.getCounter("0urcl", ""), UrException);
+  EXPECT_THROW(registry.getCounter("urcl-test", ""), UrException);
+  EXPECT_THROW(registry.getCounter("urcl_test_total", "", { { "__name", "x" } }), UrException);
+  EXPECT_THROW(registry.getHistogram("urcl_hist", "", { 1.0, 0.5 }), UrException);
+  EXPECT_THROW(registry.getHistogram("urcl_hist", "", { 1.0 }, { { "le", "1" } }), UrException);
+  registry.getHistogram("urcl_hist", "", { 1.0 });
+  EXPECT_THROW(registry.getHistogram("urcl_hist", "", { 2.0 }, { { "a", "b" } }), UrException);
+}
+
+TEST(MetricsTest, counters_can_be_incremented_concurrently)
+{
+  MetricsRegistry registry;
+  Counter& counter = registry.getCounter("urcl_test_total", "");
+  Histogram& histogram = registry.getHistogram("urcl_test_seconds", "", Histogram::defaultDurationBounds());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&counter, &histogram]() {
+      for (int j = 0; j < 10000; ++j)
+      {
+        counter.increment();
+        histogram.observe(0.001);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(counter.getValue(), 40000u);
+  EXPECT_EQ(histogram.getCount(), 40000u);
+  EXPECT_NEAR(histogram.getSum(), 40.0, 1e-6);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
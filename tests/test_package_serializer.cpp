@@ -30,6 +30,8 @@
 
 #include <gtest/gtest.h>
 #include <ur_client_library/comm/package_serializer.h>
+#include <ur_client_library/comm/bin_parser.h>
+#include <ur_client_library/types.h>
 
 using namespace urcl;
 
@@ -80,6 +82,56 @@ TEST(package_serializer, serialize_int32)
   }
 }
 
+TEST(package_serializer, serialize_vector6d)
+{
+  uint8_t buffer[sizeof(double) * 6];
+  vector6d_t target = { 2.341, -2.341, 0.0, 1.0, -1.0, 2.341 };
+  size_t actual_size = comm::PackageSerializer::serialize(buffer, target);
+
+  EXPECT_EQ(sizeof(buffer), actual_size);
+
+  uint8_t expected_value[] = { 0x40, 0x02, 0xba, 0x5e, 0x35, 0x3f, 0x7c, 0xee };
+  uint8_t expected_negated_value[] = { 0xc0, 0x02, 0xba, 0x5e, 0x35, 0x3f, 0x7c, 0xee };
+  for (unsigned int i = 0; i < sizeof(double); ++i)
+  {
+    EXPECT_EQ(expected_value[i], buffer[i]);
+    EXPECT_EQ(expected_negated_value[i], buffer[sizeof(double) + i]);
+    EXPECT_EQ(expected_value[i], buffer[5 * sizeof(double) + i]);
+  }
+}
+
+TEST(package_serializer, serialize_and_parse_arrays)
+{
+  // Sizes not being a multiple of the vector register width also test the remainder handling
+  std::array<double, 7> doubles = { 1.5, -2.25, 3.0, 1e-9, -1e9, 0.0, 42.0 };
+  std::array<int32_t, 11> integers = { -1, 2, -3, 4, -5, 6, -7, 8, -9, 10, 0x12345678 };
+  std::array<uint64_t, 3> large_integers = { 0x0102030405060708, 1, 0xffffffff00000000 };
+
+  uint8_t buffer[4096];
+  size_t size = 0;
+  size += comm::PackageSerializer::serialize(buffer + size, doubles);
+  size += comm::PackageSerializer::serialize(buffer + size, integers);
+  size += comm::PackageSerializer::serialize(buffer + size, large_integers);
+  EXPECT_EQ(size, sizeof(doubles) + sizeof(integers) + sizeof(large_integers));
+
+  // Network byte order is big endian
+  EXPECT_EQ(buffer[sizeof(doubles) + 10 * sizeof(int32_t)], 0x12);
+  EXPECT_EQ(buffer[sizeof(doubles) + sizeof(integers)], 0x01);
+
+  comm::BinParser bp(buffer, size);
+  std::array<double, 7> parsed_doubles;
+  std::array<int32_t, 11> parsed_integers;
+  std::array<uint64_t, 3> parsed_large_integers;
+  bp.parse(parsed_doubles);
+  bp.parse(parsed_integers);
+  bp.parse(parsed_large_integers);
+  EXPECT_TRUE(bp.empty());
+
+  EXPECT_EQ(doubles, parsed_doubles);
+  EXPECT_EQ(integers, parsed_integers);
+  EXPECT_EQ(large_integers, parsed_large_integers);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -30,6 +30,7 @@
 
 #include <gtest/gtest.h>
 #include <condition_variable>
+#include <limits>
 
 #include <ur_client_library/comm/pipeline.h>
 #include <ur_client_library/comm/tcp_server.h>
@@ -37,6 +38,7 @@
 #include <ur_client_library/comm/producer.h>
 #include <ur_client_library/rtde/rtde_package.h>
 #include <ur_client_library/rtde/rtde_parser.h>
+#include <ur_client_library/trace.h>
 
 using namespace urcl;
 
@@ -129,7 +131,13 @@ protected:
       return true;
     }
 
+    virtual void onTimeout()
+    {
+      num_timeouts_++;
+    }
+
     double timestamp_ = 0.0;
+    std::atomic<size_t> num_timeouts_{ 0 };
     std::condition_variable consumed_cv_;
     std::mutex consumed_mutex_;
     bool consumed_callback_ = false;
@@ -176,6 +184,61 @@ TEST_F(PipelineTest, get_product_from_running_pipeline)
   }
 }
 
+TEST_F(PipelineTest, queue_depth_is_reported_as_metric)
+{
+  pipeline_->setMetricLabels({ { "host", "127.0.0.1" } });
+  Gauge& queue_depth = getMetricsRegistry().getGauge("urcl_pipeline_queue_depth", "",
+                                                     { { "pipeline", "RTDE_PIPELINE" }, { "host", "127.0.0.1" } });
+  queue_depth.set(0);
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (queue_depth.getValue() < 1.0 && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(queue_depth.getValue(), 1.0);
+  EXPECT_NE(getMetricsRegistry().exportText().find(
+                "urcl_pipeline_queue_depth{pipeline=\"RTDE_PIPELINE\",host=\"127.0.0.1\"} 1\n"),
+            std::string::npos);
+}
+
+#ifdef URCL_TRACING
+TEST_F(PipelineTest, stages_of_a_package_are_traced)
+{
+  waitForConnectionCallback();
+  pipeline_->run();
+  clearTraceEvents();
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  ASSERT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(500)));
+
+  const uint64_t package_id = tracePackageId(urpackage->getTimestamps().receive);
+  std::vector<TracePoint> stages;
+  for (const TraceEvent& event : getTraceEvents())
+  {
+    // The package might have been read in several chunks
+    if ((event.point == TracePoint::SOCKET_READ && (stages.empty() || stages.back() != TracePoint::SOCKET_READ)) ||
+        event.argument == package_id)
+    {
+      stages.push_back(event.point);
+    }
+  }
+  const std::vector<TracePoint> expected = { TracePoint::SOCKET_READ, TracePoint::PARSE_DONE,
+                                             TracePoint::PIPELINE_ENQUEUE, TracePoint::PIPELINE_DEQUEUE };
+  EXPECT_EQ(stages, expected);
+}
+#endif
+
 TEST_F(PipelineTest, stop_pipeline)
 {
   waitForConnectionCallback();
@@ -234,6 +297,248 @@ TEST_F(PipelineTest, consumer_pipeline)
   pipeline_->stop();
 }
 
+TEST_F(PipelineTest, consumer_without_shared_ownership)
+{
+  // Consumer that doesn't keep products and therefore doesn't need a shared pointer
+  class UniqueConsumer : public TestConsumer
+  {
+  public:
+    bool consume(std::shared_ptr<rtde_interface::RTDEPackage> product) override
+    {
+      num_shared_++;
+      return TestConsumer::consume(product);
+    }
+
+    bool consumeProduct(std::unique_ptr<rtde_interface::RTDEPackage>& product) override
+    {
+      std::lock_guard<std::mutex> lk(consumed_mutex_);
+      if (rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(product.get()))
+      {
+        data->getData("timestamp", timestamp_);
+      }
+      consumed_cv_.notify_one();
+      consumed_callback_ = true;
+      return true;
+    }
+
+    std::atomic<size_t> num_shared_{ 0 };
+  };
+
+  stream_.reset(new comm::URStream<rtde_interface::RTDEPackage>("127.0.0.1", 60002));
+  producer_.reset(new comm::URProducer<rtde_interface::RTDEPackage>(*stream_.get(), *parser_.get()));
+  UniqueConsumer consumer;
+  pipeline_.reset(
+      new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), &consumer, "RTDE_PIPELINE", notifier_));
+  pipeline_->init();
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+  EXPECT_TRUE(consumer.waitForConsumer(500));
+  pipeline_->stop();
+
+  EXPECT_FLOAT_EQ(consumer.timestamp_, 7103.8579);
+  EXPECT_EQ(consumer.num_shared_, 0u);
+}
+
+TEST_F(PipelineTest, consumer_budget)
+{
+  class SlowConsumer : public TestConsumer
+  {
+  public:
+    bool consume(std::shared_ptr<rtde_interface::RTDEPackage> product) override
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      return TestConsumer::consume(product);
+    }
+  };
+
+  stream_.reset(new comm::URStream<rtde_interface::RTDEPackage>("127.0.0.1", 60002));
+  producer_.reset(new comm::URProducer<rtde_interface::RTDEPackage>(*stream_.get(), *parser_.get()));
+  SlowConsumer consumer;
+  pipeline_.reset(
+      new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), &consumer, "RTDE_PIPELINE", notifier_));
+  auto budget = std::make_shared<comm::ExecutionBudget>("slow_consumer", std::chrono::milliseconds(2));
+  pipeline_->setConsumerBudget(budget);
+  EXPECT_EQ(pipeline_->getConsumerBudget(), budget);
+  pipeline_->init();
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (budget->getInvocations() == 0 && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  pipeline_->stop();
+
+  EXPECT_EQ(budget->getInvocations(), 1u);
+  EXPECT_EQ(budget->getOverruns(), 1u);
+  EXPECT_GE(budget->getMaxWallTime(), std::chrono::milliseconds(5));
+}
+
+TEST_F(PipelineTest, consumer_timeout)
+{
+  stream_.reset(new comm::URStream<rtde_interface::RTDEPackage>("127.0.0.1", 60002));
+  producer_.reset(new comm::URProducer<rtde_interface::RTDEPackage>(*stream_.get(), *parser_.get()));
+  TestConsumer consumer;
+  pipeline_.reset(
+      new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), &consumer, "RTDE_PIPELINE", notifier_));
+  EXPECT_EQ(pipeline_->getConsumerTimeout(), comm::Pipeline<rtde_interface::RTDEPackage>::DEFAULT_CONSUMER_TIMEOUT);
+  pipeline_->setConsumerTimeoutFromFrequency(500);
+  EXPECT_EQ(pipeline_->getConsumerTimeout(), std::chrono::microseconds(2000));
+  // Frequencies without a valid period keep the timeout
+  pipeline_->setConsumerTimeoutFromFrequency(0.0);
+  pipeline_->setConsumerTimeoutFromFrequency(-125.0);
+  pipeline_->setConsumerTimeoutFromFrequency(std::numeric_limits<double>::quiet_NaN());
+  pipeline_->setConsumerTimeoutFromFrequency(std::numeric_limits<double>::denorm_min());
+  EXPECT_EQ(pipeline_->getConsumerTimeout(), std::chrono::microseconds(2000));
+  pipeline_->init();
+  waitForConnectionCallback();
+
+  // Without any data, the consumer is updated with the configured period
+  pipeline_->run();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  pipeline_->stop();
+  EXPECT_GT(consumer.num_timeouts_, 20u);
+
+  // Without a timeout the consumer isn't woken up
+  consumer.num_timeouts_ = 0;
+  pipeline_->setConsumerTimeout(std::chrono::microseconds(0));
+  pipeline_->run();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  pipeline_->stop();
+  EXPECT_EQ(consumer.num_timeouts_, 0u);
+}
+
+TEST_F(PipelineTest, producer_callback)
+{
+  std::mutex callback_mutex;
+  std::condition_variable callback_cv;
+  double timestamp = 0.0;
+  pipeline_->setProducerCallback([&](std::unique_ptr<rtde_interface::RTDEPackage>& product) {
+    std::lock_guard<std::mutex> lk(callback_mutex);
+    if (rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(product.get()))
+    {
+      data->getData("timestamp", timestamp);
+    }
+    callback_cv.notify_one();
+    return true;
+  });
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  // RTDE package with timestamp
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+
+  {
+    std::unique_lock<std::mutex> lk(callback_mutex);
+    callback_cv.wait_for(lk, std::chrono::milliseconds(500), [&timestamp]() { return timestamp != 0.0; });
+  }
+  EXPECT_FLOAT_EQ(timestamp, 7103.8579);
+
+  // Products consumed by the callback are not queued
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  EXPECT_FALSE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(100)));
+
+  pipeline_->stop();
+}
+
+TEST_F(PipelineTest, get_next_product_in_order)
+{
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  // Two RTDE packages with timestamps 7103.8579 and 2.0 sent back-to-back
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+
+  std::chrono::milliseconds timeout{ 500 };
+  std::vector<double> expected_timestamps = { 7103.8579, 2.0 };
+  for (const double expected_timestamp : expected_timestamps)
+  {
+    std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+    ASSERT_TRUE(pipeline_->getNextProduct(urpackage, timeout));
+    rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+    ASSERT_NE(data, nullptr);
+    double timestamp;
+    data->getData("timestamp", timestamp);
+    EXPECT_FLOAT_EQ(timestamp, expected_timestamp);
+  }
+
+  pipeline_->stop();
+}
+
+TEST_F(PipelineTest, record_latency_statistics)
+{
+  auto statistics = std::make_shared<comm::LatencyStatistics>();
+  pipeline_->setLatencyStatistics(statistics);
+  EXPECT_EQ(pipeline_->getLatencyStatistics(), statistics);
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  std::chrono::milliseconds timeout{ 500 };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    server_->write(client_fd_, data_package, sizeof(data_package), written);
+    std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+    ASSERT_TRUE(pipeline_->getNextProduct(urpackage, timeout));
+
+    const comm::PackageTimestamps& timestamps = urpackage->getTimestamps();
+    EXPECT_EQ(timestamps.kernel, std::chrono::steady_clock::time_point());
+    EXPECT_NE(timestamps.receive, std::chrono::steady_clock::time_point());
+    EXPECT_LE(timestamps.receive, timestamps.parse);
+    EXPECT_LE(timestamps.parse, timestamps.enqueue);
+  }
+  pipeline_->stop();
+
+  EXPECT_EQ(statistics->kernel_to_receive.getCount(), 0u);
+  EXPECT_EQ(statistics->receive_to_parse.getCount(), 2u);
+  EXPECT_EQ(statistics->parse_to_enqueue.getCount(), 2u);
+  EXPECT_EQ(statistics->enqueue_to_consume.getCount(), 2u);
+  EXPECT_EQ(statistics->receive_interval.getCount(), 1u);
+}
+
+TEST_F(PipelineTest, latest_only_queue)
+{
+  pipeline_->setQueue(8, comm::OverflowPolicy::LATEST_ONLY);
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  // Three RTDE packages with timestamps 7103.8579, 2.0 and 1.0 sent back-to-back
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                              0x00, 0x0c, 0x55, 0x01, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+
+  // Wait until all packages have been received, only the newest one is kept
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  ASSERT_TRUE(pipeline_->getNextProduct(urpackage, std::chrono::milliseconds(500)));
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_FLOAT_EQ(timestamp, 1.0);
+  EXPECT_EQ(pipeline_->getNumDroppedProducts(), 2u);
+  EXPECT_EQ(pipeline_->getQueueHighWaterMark(), 1u);
+  EXPECT_FALSE(pipeline_->getNextProduct(urpackage, std::chrono::milliseconds(10)));
+
+  pipeline_->stop();
+}
+
 TEST_F(PipelineTest, connect_non_connected_robot)
 {
   stream_.reset(new comm::URStream<rtde_interface::RTDEPackage>("127.0.0.1", 12321));
@@ -0,0 +1,367 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/primary/abstract_primary_consumer.h>
+#define private public
+#include <ur_client_library/primary/primary_client.h>
+
+using namespace urcl;
+
+static const int g_port = 60010;
+
+class PrimaryClientTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    server_.reset(new comm::TCPServer(g_port));
+    server_->setConnectCallback([this](const int fd) {
+      std::lock_guard<std::mutex> lk(mutex_);
+      client_fd_ = fd;
+      cv_.notify_all();
+    });
+    server_->setMessageCallback([this](const int /*fd*/, char* buffer, int nbytesrecv) {
+      std::lock_guard<std::mutex> lk(mutex_);
+      received_.append(buffer, nbytesrecv);
+      cv_.notify_all();
+    });
+    server_->start();
+
+    client_.reset(new primary_interface::PrimaryClient("127.0.0.1", notifier_, g_port));
+    client_->start();
+    std::unique_lock<std::mutex> lk(mutex_);
+    ASSERT_TRUE(cv_.wait_for(lk, std::chrono::seconds(1), [this]() { return client_fd_ >= 0; }));
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+    server_.reset();
+  }
+
+  template <typename T>
+  static void append(std::vector<uint8_t>& buffer, const T value)
+  {
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+      buffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * (sizeof(T) - 1 - i))));
+    }
+  }
+
+  // Sends a robot message with the given payload to the client
+  void sendRobotMessage(const primary_interface::RobotMessagePackageType type, const std::vector<uint8_t>& payload)
+  {
+    std::vector<uint8_t> package;
+    append<int32_t>(package, 0);
+    append<int8_t>(package, static_cast<int8_t>(primary_interface::RobotPackageType::ROBOT_MESSAGE));
+    append<uint64_t>(package, 123456);
+    append<int8_t>(package, -2);
+    append<uint8_t>(package, static_cast<uint8_t>(type));
+    package.insert(package.end(), payload.begin(), payload.end());
+    setSize(package);
+    size_t written;
+    ASSERT_TRUE(server_->write(client_fd_, package.data(), package.size(), written));
+  }
+
+  static void appendDouble(std::vector<uint8_t>& buffer, const double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    append<uint64_t>(buffer, bits);
+  }
+
+  // Sends a robot state package containing only the given kinematics info to the client
+  void sendKinematicsInfo(const primary_interface::KinematicsInfo& info)
+  {
+    std::vector<uint8_t> sub_package;
+    append<int32_t>(sub_package, 0);
+    append<uint8_t>(sub_package, static_cast<uint8_t>(primary_interface::RobotStateType::KINEMATICS_INFO));
+    for (const uint32_t checksum : info.checksum_)
+    {
+      append<uint32_t>(sub_package, checksum);
+    }
+    for (const vector6d_t* values : { &info.dh_theta_, &info.dh_a_, &info.dh_d_, &info.dh_alpha_ })
+    {
+      for (const double value : *values)
+      {
+        appendDouble(sub_package, value);
+      }
+    }
+    append<uint32_t>(sub_package, info.calibration_status_);
+    setSize(sub_package);
+
+    std::vector<uint8_t> package;
+    append<int32_t>(package, 0);
+    append<int8_t>(package, static_cast<int8_t>(primary_interface::RobotPackageType::ROBOT_STATE));
+    package.insert(package.end(), sub_package.begin(), sub_package.end());
+    setSize(package);
+    size_t written;
+    ASSERT_TRUE(server_->write(client_fd_, package.data(), package.size(), written));
+  }
+
+  static void setSize(std::vector<uint8_t>& package)
+  {
+    const uint32_t size = static_cast<uint32_t>(package.size());
+    for (size_t i = 0; i < 4; ++i)
+    {
+      package[i] = static_cast<uint8_t>(size >> (8 * (3 - i)));
+    }
+  }
+
+  template <typename Predicate>
+  bool waitFor(Predicate predicate)
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return cv_.wait_for(lk, std::chrono::seconds(1), predicate);
+  }
+
+  comm::INotifier notifier_;
+  std::unique_ptr<comm::TCPServer> server_;
+  std::unique_ptr<primary_interface::PrimaryClient> client_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int client_fd_ = -1;
+  std::string received_;
+};
+
+class MessageCounter : public primary_interface::AbstractPrimaryConsumer
+{
+public:
+  bool consume(primary_interface::RobotMessage& /*pkg*/) override
+  {
+    ++robot_messages;
+    return true;
+  }
+  bool consume(primary_interface::RobotState& /*pkg*/) override
+  {
+    return true;
+  }
+  bool consume(primary_interface::VersionMessage& /*pkg*/) override
+  {
+    return true;
+  }
+  bool consume(primary_interface::KinematicsInfo& /*pkg*/) override
+  {
+    return true;
+  }
+
+  std::atomic<size_t> robot_messages{ 0 };
+};
+
+TEST_F(PrimaryClientTest, send_script_uses_the_open_connection)
+{
+  EXPECT_TRUE(client_->sendScript("textmsg(\"hello\")"));
+  EXPECT_TRUE(waitFor([this]() { return received_ == "textmsg(\"hello\")\n"; }));
+  EXPECT_TRUE(client_->sendScript("textmsg(\"world\")"));
+  EXPECT_TRUE(waitFor([this]() { return received_ == "textmsg(\"hello\")\ntextmsg(\"world\")\n"; }));
+}
+
+TEST_F(PrimaryClientTest, error_codes_are_reported)
+{
+  struct ErrorCode
+  {
+    int32_t code;
+    primary_interface::ReportLevel report_level;
+    uint32_t data;
+    std::string text;
+    uint64_t timestamp;
+    primary_interface::RobotMessagePackageType message_type;
+  };
+  std::mutex message_mutex;
+  std::vector<ErrorCode> error_codes;
+  client_->setErrorCodeCallback([&](const primary_interface::ErrorCodeMessage& message) {
+    std::lock_guard<std::mutex> lk(message_mutex);
+    error_codes.push_back({ message.message_code_, message.report_level_, message.data_, message.text_,
+                            message.timestamp_, message.message_type_ });
+    cv_.notify_all();
+  });
+
+  std::vector<uint8_t> payload;
+  append<int32_t>(payload, 209);
+  append<int32_t>(payload, 0);
+  append<int32_t>(payload, static_cast<int32_t>(primary_interface::ReportLevel::VIOLATION));
+  append<uint8_t>(payload, 1);
+  append<uint32_t>(payload, 42);
+  const std::string text = "Protective stop";
+  payload.insert(payload.end(), text.begin(), text.end());
+  sendRobotMessage(primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE, payload);
+
+  ASSERT_TRUE(waitFor([&]() {
+    std::lock_guard<std::mutex> lk(message_mutex);
+    return !error_codes.empty();
+  }));
+  std::lock_guard<std::mutex> lk(message_mutex);
+  EXPECT_EQ(error_codes[0].code, 209);
+  EXPECT_EQ(error_codes[0].report_level, primary_interface::ReportLevel::VIOLATION);
+  EXPECT_EQ(error_codes[0].data, 42u);
+  EXPECT_EQ(error_codes[0].text, text);
+  EXPECT_EQ(error_codes[0].timestamp, 123456u);
+  EXPECT_EQ(error_codes[0].message_type, primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE);
+}
+
+TEST_F(PrimaryClientTest, runtime_exceptions_are_reported_to_callbacks_and_consumers)
+{
+  std::atomic<int> line_number{ 0 };
+  std::atomic<size_t> robot_messages{ 0 };
+  client_->setRuntimeExceptionCallback([&](const primary_interface::RuntimeExceptionMessage& message) {
+    line_number = message.line_number_;
+    cv_.notify_all();
+  });
+  client_->setRobotMessageCallback([&](const primary_interface::RobotMessage& /*message*/) { ++robot_messages; });
+  auto counter = std::make_shared<MessageCounter>();
+  client_->addPrimaryConsumer(counter);
+
+  std::vector<uint8_t> payload;
+  append<int32_t>(payload, 3);
+  append<int32_t>(payload, 5);
+  const std::string text = "compile_error_name_not_found:foo:";
+  payload.insert(payload.end(), text.begin(), text.end());
+  sendRobotMessage(primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION, payload);
+
+  EXPECT_TRUE(waitFor([&]() { return line_number == 3 && counter->robot_messages == 1; }));
+  EXPECT_EQ(robot_messages, 1u);
+
+  client_->removePrimaryConsumer(counter);
+  sendRobotMessage(primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_TEXT, {});
+  EXPECT_TRUE(waitFor([&]() { return robot_messages == 2; }));
+  EXPECT_EQ(counter->robot_messages, 1u);
+}
+
+TEST_F(PrimaryClientTest, calibration_is_checked_against_the_received_kinematics_info)
+{
+  primary_interface::KinematicsInfo info(primary_interface::RobotStateType::KINEMATICS_INFO);
+  info.checksum_ = { 1, 2, 3, 4, 5, 6 };
+  info.dh_theta_ = { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5 };
+  info.dh_a_ = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+  info.dh_d_ = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+  info.dh_alpha_ = { 1.570796327, 0.0, 0.0, 1.570796327, -1.570796327, 0.0 };
+  info.calibration_status_ = 0;
+
+  std::string hash;
+  EXPECT_FALSE(client_->getCalibrationHash(hash));
+
+  sendKinematicsInfo(info);
+  EXPECT_TRUE(client_->checkCalibration(info.toHash()));
+  EXPECT_FALSE(client_->checkCalibration("calib_12345"));
+  ASSERT_TRUE(client_->getCalibrationHash(hash));
+  EXPECT_EQ(hash, info.toHash());
+
+  // A changed calibration is hashed again
+  info.dh_theta_[0] = 0.01;
+  sendKinematicsInfo(info);
+  EXPECT_TRUE(waitFor([&]() { return client_->getCalibrationHash(hash) && hash == info.toHash(); }));
+}
+
+TEST_F(PrimaryClientTest, robot_configuration_is_taken_from_version_and_configuration_data)
+{
+  primary_interface::RobotConfiguration configuration;
+  EXPECT_FALSE(client_->getRobotConfiguration(configuration));
+
+  std::vector<uint8_t> version;
+  const std::string project_name = "URControl";
+  append<int8_t>(version, static_cast<int8_t>(project_name.size()));
+  version.insert(version.end(), project_name.begin(), project_name.end());
+  append<uint8_t>(version, 5);
+  append<uint8_t>(version, 12);
+  append<int32_t>(version, 3);
+  append<int32_t>(version, 1234);
+  sendRobotMessage(primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_VERSION, version);
+
+  // Configuration data with only the joint limits and the robot type filled in
+  std::vector<uint8_t> sub_package;
+  append<int32_t>(sub_package, 0);
+  append<uint8_t>(sub_package, static_cast<uint8_t>(primary_interface::RobotStateType::CONFIGURATION_DATA));
+  for (size_t joint = 0; joint < 6; ++joint)
+  {
+    appendDouble(sub_package, -6.28);
+    appendDouble(sub_package, 6.28);
+  }
+  sub_package.resize(5 + 432, 0);
+  append<int32_t>(sub_package, 7);
+  append<int32_t>(sub_package, 0);
+  setSize(sub_package);
+  std::vector<uint8_t> package;
+  append<int32_t>(package, 0);
+  append<int8_t>(package, static_cast<int8_t>(primary_interface::RobotPackageType::ROBOT_STATE));
+  package.insert(package.end(), sub_package.begin(), sub_package.end());
+  setSize(package);
+  size_t written;
+  ASSERT_TRUE(server_->write(client_fd_, package.data(), package.size(), written));
+
+  ASSERT_TRUE(client_->getRobotConfiguration(configuration, std::chrono::seconds(1)));
+  EXPECT_EQ(configuration.version, VersionInformation::fromString("5.12.3.1234"));
+  EXPECT_EQ(configuration.project_name, project_name);
+  EXPECT_EQ(configuration.joint_min_limits[5], -6.28);
+  EXPECT_EQ(configuration.joint_max_limits[0], 6.28);
+  EXPECT_EQ(configuration.robot_type, 7);
+  EXPECT_TRUE(configuration.isWithinJointLimits({ 0.0, 1.0, -1.0, 3.14, -3.14, 6.0 }));
+  EXPECT_FALSE(configuration.isWithinJointLimits({ 0.0, 1.0, -1.0, 3.14, -3.14, 6.5 }));
+}
+
+TEST_F(PrimaryClientTest, send_script_reconnects_a_closed_connection)
+{
+  client_->stream_.close();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    client_fd_ = -1;
+  }
+
+  EXPECT_TRUE(client_->sendScript("textmsg(\"hello\")"));
+  EXPECT_TRUE(waitFor([this]() { return received_ == "textmsg(\"hello\")\n"; }));
+  EXPECT_EQ(client_->getConnectionState(), comm::ConnectionState::CONNECTED);
+}
+
+TEST_F(PrimaryClientTest, replaced_pipeline_queue_keeps_delivering_packages)
+{
+  auto counter = std::make_shared<MessageCounter>();
+  client_->addPrimaryConsumer(counter);
+  client_->setPipelineQueue(8, comm::OverflowPolicy::DROP_OLDEST);
+
+  sendRobotMessage(primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_TEXT, {});
+  EXPECT_TRUE(waitFor([&]() { return counter->robot_messages == 1; }));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -29,8 +29,11 @@
 // -- END LICENSE BLOCK ------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <sys/socket.h>
 #include <chrono>
 #include <condition_variable>
+#include <thread>
+#include <vector>
 
 #include <ur_client_library/comm/producer.h>
 #include <ur_client_library/comm/stream.h>
@@ -120,6 +123,189 @@ TEST_F(ProducerTest, get_data_package)
   producer.stopProducer();
 }
 
+TEST_F(ProducerTest, get_buffered_data_packages)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  stream.setBufferedReading(true);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+
+  producer.setupProducer();
+  waitForConnectionCallback();
+  producer.startProducer();
+
+  // Three RTDE packages with timestamp, sent at once
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    data.insert(data.end(), data_package, data_package + sizeof(data_package));
+  }
+  size_t written;
+  server_->write(client_fd_, data.data(), data.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // All received packages are produced at once
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 3u);
+  for (auto& product : products)
+  {
+    rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(product.get());
+    ASSERT_NE(data, nullptr);
+    double timestamp;
+    data->getData("timestamp", timestamp);
+    EXPECT_FLOAT_EQ(timestamp, 7103.86);
+  }
+
+  producer.stopProducer();
+}
+
+TEST_F(ProducerTest, skip_truncated_frame)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  stream.setBufferedReading(true);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+  const MetricLabels labels = { { "host", "127.0.0.1" }, { "port", "60002" } };
+  Counter& malformed = getMetricsRegistry().getCounter("urcl_malformed_frames_total", "", labels);
+  const uint64_t malformed_before = malformed.getValue();
+
+  producer.setupProducer();
+  waitForConnectionCallback();
+  producer.startProducer();
+
+  // A data package whose timestamp is cut short, followed by a complete one
+  uint8_t truncated_package[] = { 0x00, 0x08, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb };
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  std::vector<uint8_t> data(truncated_package, truncated_package + sizeof(truncated_package));
+  data.insert(data.end(), data_package, data_package + sizeof(data_package));
+  size_t written;
+  server_->write(client_fd_, data.data(), data.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // The truncated frame is skipped without ending the production
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 1u);
+  rtde_interface::DataPackage* package = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+  ASSERT_NE(package, nullptr);
+  double timestamp;
+  package->getData("timestamp", timestamp);
+  EXPECT_FLOAT_EQ(timestamp, 7103.86);
+  EXPECT_EQ(malformed.getValue(), malformed_before + 1);
+
+  producer.stopProducer();
+}
+
+TEST_F(ProducerTest, reconnect_after_connection_loss)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::milliseconds(50);
+  producer.setReconnectionBackoff(config);
+  std::vector<comm::ConnectionState> states;
+  producer.setConnectionStateCallback([&states](comm::ConnectionState state) { states.push_back(state); });
+  const MetricLabels labels = { { "host", "127.0.0.1" }, { "port", "60002" } };
+  Counter& reconnects = getMetricsRegistry().getCounter("urcl_reconnects_total", "", labels);
+  Counter& parsed = getMetricsRegistry().getCounter("urcl_packages_parsed_total", "", labels);
+  const uint64_t reconnects_before = reconnects.getValue();
+  const uint64_t parsed_before = parsed.getValue();
+
+  producer.setupProducer();
+  EXPECT_TRUE(waitForConnectionCallback());
+  producer.startProducer();
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::CONNECTED);
+
+  // Drop the connection from the server side
+  ::shutdown(client_fd_, SHUT_RDWR);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_TRUE(products.empty());
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::RECONNECTING);
+
+  // The next call waits for the delay and reconnects
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::CONNECTED);
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_EQ(products.size(), 1u);
+
+  const std::vector<comm::ConnectionState> expected_states = { comm::ConnectionState::CONNECTED,
+                                                               comm::ConnectionState::RECONNECTING,
+                                                               comm::ConnectionState::CONNECTED };
+  EXPECT_EQ(states, expected_states);
+  EXPECT_EQ(reconnects.getValue(), reconnects_before + 1);
+  EXPECT_EQ(parsed.getValue(), parsed_before + 1);
+  producer.stopProducer();
+}
+
+TEST_F(ProducerTest, stopping_cancels_reconnection)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::seconds(60);
+  producer.setReconnectionBackoff(config);
+
+  producer.setupProducer();
+  EXPECT_TRUE(waitForConnectionCallback());
+  producer.startProducer();
+  ::shutdown(client_fd_, SHUT_RDWR);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::RECONNECTING);
+
+  std::thread stopper([&producer]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    producer.stopProducer();
+  });
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::RECONNECTING);
+  stopper.join();
+}
+
+TEST_F(ProducerTest, give_up_reconnecting)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::milliseconds(10);
+  config.max_attempts = 2;
+  producer.setReconnectionBackoff(config);
+
+  producer.setupProducer();
+  EXPECT_TRUE(waitForConnectionCallback());
+  producer.startProducer();
+  ::shutdown(client_fd_, SHUT_RDWR);
+  server_.reset();
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_TRUE(producer.tryGet(products));
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::RECONNECTING);
+  EXPECT_FALSE(producer.tryGet(products));
+  EXPECT_EQ(producer.getConnectionState(), comm::ConnectionState::FAILED);
+}
+
 TEST_F(ProducerTest, connect_non_connected_robot)
 {
   comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 12321);
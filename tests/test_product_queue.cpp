@@ -0,0 +1,246 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <ur_client_library/comm/product_queue.h>
+
+using namespace urcl;
+
+namespace
+{
+void fill(comm::ProductQueue<int>& queue, const int first, const int last, size_t& num_failed)
+{
+  std::atomic<bool> keep_waiting{ false };
+  for (int i = first; i <= last; ++i)
+  {
+    if (!queue.enqueue(std::make_unique<int>(i), keep_waiting))
+    {
+      num_failed++;
+    }
+  }
+}
+
+std::vector<int> drain(comm::ProductQueue<int>& queue)
+{
+  std::vector<int> values;
+  std::unique_ptr<int> product;
+  while (queue.tryDequeue(product))
+  {
+    values.push_back(*product);
+  }
+  return values;
+}
+}  // namespace
+
+TEST(product_queue, drop_newest)
+{
+  comm::ProductQueue<int> queue(4, comm::OverflowPolicy::DROP_NEWEST);
+  size_t num_failed = 0;
+  fill(queue, 1, 6, num_failed);
+  EXPECT_EQ(num_failed, 2u);
+  EXPECT_EQ(queue.getNumDropped(), 2u);
+  EXPECT_EQ(queue.getHighWaterMark(), 4u);
+  EXPECT_EQ(drain(queue), (std::vector<int>{ 1, 2, 3, 4 }));
+}
+
+TEST(product_queue, drop_oldest)
+{
+  comm::ProductQueue<int> queue(4, comm::OverflowPolicy::DROP_OLDEST);
+  size_t num_failed = 0;
+  fill(queue, 1, 6, num_failed);
+  EXPECT_EQ(num_failed, 2u);
+  EXPECT_EQ(queue.getNumDropped(), 2u);
+  EXPECT_EQ(queue.getHighWaterMark(), 4u);
+  EXPECT_EQ(drain(queue), (std::vector<int>{ 3, 4, 5, 6 }));
+}
+
+TEST(product_queue, latest_only)
+{
+  comm::ProductQueue<int> queue(4, comm::OverflowPolicy::LATEST_ONLY);
+  EXPECT_EQ(queue.getCapacity(), 1u);
+  size_t num_failed = 0;
+  fill(queue, 1, 3, num_failed);
+  EXPECT_EQ(queue.getNumDropped(), 2u);
+  EXPECT_EQ(queue.getHighWaterMark(), 1u);
+
+  std::unique_ptr<int> product;
+  EXPECT_TRUE(queue.waitDequeTimed(product, std::chrono::milliseconds(10)));
+  EXPECT_EQ(*product, 3);
+  EXPECT_FALSE(queue.waitDequeTimed(product, std::chrono::milliseconds(10)));
+}
+
+TEST(product_queue, latest_only_frees_on_producer)
+{
+  struct Tracked
+  {
+    explicit Tracked(std::vector<std::thread::id>& destroyed) : destroyed_(destroyed)
+    {
+    }
+    ~Tracked()
+    {
+      destroyed_.push_back(std::this_thread::get_id());
+    }
+    std::vector<std::thread::id>& destroyed_;
+  };
+
+  std::vector<std::thread::id> destroyed;
+  comm::ProductQueue<Tracked> queue(1, comm::OverflowPolicy::LATEST_ONLY);
+  std::unique_ptr<Tracked> product;
+  for (int i = 0; i < 5; ++i)
+  {
+    std::thread producer([&]() {
+      std::atomic<bool> keep_waiting{ false };
+      queue.enqueue(std::make_unique<Tracked>(destroyed), keep_waiting);
+    });
+    producer.join();
+    // The previous product is handed back to the queue instead of being destroyed here.
+    const size_t num_destroyed = destroyed.size();
+    ASSERT_TRUE(queue.tryDequeue(product));
+    EXPECT_EQ(destroyed.size(), num_destroyed);
+  }
+  EXPECT_EQ(queue.getNumDropped(), 0u);
+  EXPECT_FALSE(destroyed.empty());
+  for (auto& id : destroyed)
+  {
+    EXPECT_NE(id, std::this_thread::get_id());
+  }
+}
+
+TEST(product_queue, latest_only_concurrent)
+{
+  comm::ProductQueue<int> queue(1, comm::OverflowPolicy::LATEST_ONLY);
+  const int num_products = 100000;
+  std::thread producer([&queue]() {
+    std::atomic<bool> keep_waiting{ true };
+    for (int i = 1; i <= num_products; ++i)
+    {
+      queue.enqueue(std::make_unique<int>(i), keep_waiting);
+    }
+  });
+
+  int last = 0;
+  size_t num_taken = 0;
+  std::unique_ptr<int> product;
+  while (last < num_products && queue.waitDequeTimed(product, std::chrono::milliseconds(1000)))
+  {
+    // Products are never taken twice or out of order
+    EXPECT_GT(*product, last);
+    last = *product;
+    num_taken++;
+  }
+  producer.join();
+  EXPECT_EQ(last, num_products);
+  EXPECT_EQ(num_taken + queue.getNumDropped(), static_cast<size_t>(num_products));
+}
+
+TEST(product_queue, block_until_consumed)
+{
+  comm::ProductQueue<int> queue(2, comm::OverflowPolicy::BLOCK);
+  std::atomic<bool> keep_waiting{ true };
+  std::thread producer([&queue, &keep_waiting]() {
+    for (int i = 1; i <= 10; ++i)
+    {
+      EXPECT_TRUE(queue.enqueue(std::make_unique<int>(i), keep_waiting));
+    }
+  });
+
+  std::vector<int> values;
+  std::unique_ptr<int> product;
+  while (values.size() < 10 && queue.waitDequeTimed(product, std::chrono::milliseconds(1000)))
+  {
+    values.push_back(*product);
+  }
+  producer.join();
+  EXPECT_EQ(values, (std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }));
+  EXPECT_EQ(queue.getNumDropped(), 0u);
+  EXPECT_LE(queue.getHighWaterMark(), 2u);
+}
+
+TEST(product_queue, stop_blocking)
+{
+  comm::ProductQueue<int> queue(1, comm::OverflowPolicy::BLOCK);
+  size_t num_failed = 0;
+  fill(queue, 1, 2, num_failed);
+  EXPECT_EQ(num_failed, 1u);
+  EXPECT_EQ(queue.getNumDropped(), 1u);
+  EXPECT_EQ(drain(queue), std::vector<int>{ 1 });
+}
+
+TEST(product_queue, blocked_producer_is_woken_by_consumer)
+{
+  // Every product has to wait for the previous one to be taken. Waiting for the timeout of a
+  // blocked producer each time would take seconds.
+  comm::ProductQueue<int> queue(1, comm::OverflowPolicy::BLOCK);
+  constexpr int num_products = 200;
+  std::atomic<bool> keep_waiting{ true };
+  const auto start = std::chrono::steady_clock::now();
+  std::thread producer([&queue, &keep_waiting]() {
+    for (int i = 1; i <= num_products; ++i)
+    {
+      EXPECT_TRUE(queue.enqueue(std::make_unique<int>(i), keep_waiting));
+    }
+  });
+
+  int last = 0;
+  std::unique_ptr<int> product;
+  while (last < num_products && queue.waitDequeTimed(product, std::chrono::milliseconds(1000)))
+  {
+    EXPECT_EQ(*product, last + 1);
+    last = *product;
+  }
+  producer.join();
+  EXPECT_EQ(last, num_products);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST(product_queue, stop_blocked_producer)
+{
+  comm::ProductQueue<int> queue(1, comm::OverflowPolicy::BLOCK);
+  std::atomic<bool> keep_waiting{ true };
+  ASSERT_TRUE(queue.enqueue(std::make_unique<int>(1), keep_waiting));
+  std::atomic<bool> enqueued{ true };
+  std::thread producer([&]() { enqueued = queue.enqueue(std::make_unique<int>(2), keep_waiting); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  keep_waiting = false;
+  producer.join();
+  EXPECT_FALSE(enqueued);
+  EXPECT_EQ(queue.getNumDropped(), 1u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
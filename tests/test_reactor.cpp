@@ -0,0 +1,356 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/reactor.h>
+#include <ur_client_library/exceptions.h>
+
+using namespace urcl;
+
+class ReactorTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    ASSERT_EQ(pipe(pipe_fds_), 0);
+  }
+
+  void TearDown()
+  {
+    close(pipe_fds_[0]);
+    close(pipe_fds_[1]);
+  }
+
+  void writePipe()
+  {
+    const char byte = 'x';
+    ASSERT_EQ(::write(pipe_fds_[1], &byte, 1), 1);
+  }
+
+  // Reads what has been written to the pipe and counts the callback
+  void readPipe()
+  {
+    char byte;
+    ASSERT_EQ(::read(pipe_fds_[0], &byte, 1), 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_calls_;
+    callback_thread_ = std::this_thread::get_id();
+    cv_.notify_all();
+  }
+
+  bool waitForCalls(const size_t num_calls, const std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&]() { return num_calls_ >= num_calls; });
+  }
+
+  int pipe_fds_[2];
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t num_calls_ = 0;
+  std::thread::id callback_thread_;
+};
+
+TEST_F(ReactorTest, callback_on_readable_descriptor)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  ASSERT_TRUE(reactor.add(loop, pipe_fds_[0], [this]() { readPipe(); }));
+
+  writePipe();
+  EXPECT_TRUE(waitForCalls(1));
+  writePipe();
+  writePipe();
+  EXPECT_TRUE(waitForCalls(3));
+  EXPECT_NE(callback_thread_, std::this_thread::get_id());
+
+  reactor.remove(loop, pipe_fds_[0]);
+}
+
+TEST_F(ReactorTest, no_callback_after_remove)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  ASSERT_TRUE(reactor.add(loop, pipe_fds_[0], [this]() { readPipe(); }));
+  writePipe();
+  EXPECT_TRUE(waitForCalls(1));
+
+  reactor.remove(loop, pipe_fds_[0]);
+  writePipe();
+  EXPECT_FALSE(waitForCalls(2, std::chrono::milliseconds(100)));
+}
+
+TEST_F(ReactorTest, registering_twice_fails)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  ASSERT_TRUE(reactor.add(loop, pipe_fds_[0], [this]() { readPipe(); }));
+  EXPECT_FALSE(reactor.add(loop, pipe_fds_[0], [this]() { readPipe(); }));
+  reactor.remove(loop, pipe_fds_[0]);
+
+  // Invalid descriptors can't be registered
+  EXPECT_FALSE(reactor.add(loop, -1, []() {}));
+}
+
+TEST_F(ReactorTest, callback_removes_its_descriptor)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  ASSERT_TRUE(reactor.add(loop, pipe_fds_[0], [&]() {
+    reactor.remove(loop, pipe_fds_[0]);
+    readPipe();
+  }));
+  writePipe();
+  EXPECT_TRUE(waitForCalls(1));
+
+  writePipe();
+  EXPECT_FALSE(waitForCalls(2, std::chrono::milliseconds(100)));
+}
+
+TEST_F(ReactorTest, exceptions_do_not_stop_the_loop)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::atomic<bool> throw_exception(true);
+  ASSERT_TRUE(reactor.add(loop, pipe_fds_[0], [&]() {
+    if (throw_exception)
+    {
+      throw_exception = false;
+      char byte;
+      ASSERT_EQ(::read(pipe_fds_[0], &byte, 1), 1);
+      throw UrException("Failing callback");
+    }
+    readPipe();
+  }));
+  writePipe();
+  writePipe();
+  EXPECT_TRUE(waitForCalls(1));
+  EXPECT_FALSE(throw_exception);
+
+  reactor.remove(loop, pipe_fds_[0]);
+}
+
+TEST(Reactor, loops_are_assigned_in_turns)
+{
+  comm::Reactor reactor(3);
+  EXPECT_EQ(reactor.getNumLoops(), 3u);
+  std::set<size_t> loops;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    const size_t loop = reactor.assignLoop();
+    EXPECT_LT(loop, 3u);
+    loops.insert(loop);
+  }
+  EXPECT_EQ(loops.size(), 3u);
+
+  EXPECT_THROW(comm::Reactor(0), UrException);
+}
+
+TEST(Reactor, synchronize_runs_function)
+{
+  comm::Reactor reactor;
+  bool called = false;
+  reactor.synchronize(reactor.assignLoop(), [&]() { called = true; });
+  EXPECT_TRUE(called);
+}
+
+TEST(Reactor, posted_functions_run_in_order_on_the_loop_thread)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<int> calls;
+  std::set<std::thread::id> threads;
+  for (int i = 0; i < 5; ++i)
+  {
+    reactor.post(loop, [&, i]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      calls.push_back(i);
+      threads.insert(std::this_thread::get_id());
+      cv.notify_all();
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&]() { return calls.size() == 5; }));
+  EXPECT_EQ(calls, std::vector<int>({ 0, 1, 2, 3, 4 }));
+  ASSERT_EQ(threads.size(), 1u);
+  EXPECT_NE(*threads.begin(), std::this_thread::get_id());
+}
+
+TEST(Reactor, delayed_functions_run_when_due)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<int> calls;
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point late_call;
+  auto record = [&](const int value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    calls.push_back(value);
+    if (value == 2)
+    {
+      late_call = std::chrono::steady_clock::now();
+    }
+    cv.notify_all();
+  };
+  reactor.postDelayed(loop, std::chrono::milliseconds(50), [&]() { record(2); });
+  reactor.postDelayed(loop, std::chrono::milliseconds(10), [&]() { record(1); });
+  reactor.post(loop, [&]() { record(0); });
+
+  std::unique_lock<std::mutex> lock(mutex);
+  ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&]() { return calls.size() == 3; }));
+  EXPECT_EQ(calls, std::vector<int>({ 0, 1, 2 }));
+  EXPECT_GE(late_call - start, std::chrono::milliseconds(50));
+}
+
+TEST(Reactor, continuation_is_called_once_the_future_is_ready)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::promise<int> promise;
+  std::promise<int> result;
+  std::promise<std::thread::id> thread;
+  reactor.whenReady(loop, promise.get_future(), [&](std::future<int>& future) {
+    thread.set_value(std::this_thread::get_id());
+    result.set_value(future.get());
+  });
+
+  std::future<int> result_future = result.get_future();
+  EXPECT_EQ(result_future.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+  promise.set_value(42);
+  ASSERT_EQ(result_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(result_future.get(), 42);
+  EXPECT_NE(thread.get_future().get(), std::this_thread::get_id());
+}
+
+TEST(Reactor, notifying_future_posts_continuation_when_completed)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  comm::NotifyingPromise<int> promise;
+  std::promise<int> result;
+  std::promise<std::thread::id> thread;
+  reactor.whenReady(loop, promise.getFuture(), [&](std::future<int>& future) {
+    thread.set_value(std::this_thread::get_id());
+    result.set_value(future.get());
+  });
+
+  // Nothing is polled, the completing thread posts the continuation
+  std::future<int> result_future = result.get_future();
+  EXPECT_EQ(result_future.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+  std::thread::id completing_thread;
+  std::thread([&]() {
+    completing_thread = std::this_thread::get_id();
+    promise.setValue(42);
+  }).join();
+  ASSERT_EQ(result_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(result_future.get(), 42);
+  const std::thread::id loop_thread = thread.get_future().get();
+  EXPECT_NE(loop_thread, std::this_thread::get_id());
+  EXPECT_NE(loop_thread, completing_thread);
+
+  // Futures that are ready already are posted right away
+  comm::NotifyingPromise<int> ready_promise;
+  ready_promise.setValue(7);
+  std::promise<int> ready_result;
+  reactor.whenReady(loop, ready_promise.getFuture(),
+                    [&](std::future<int>& future) { ready_result.set_value(future.get()); });
+  std::future<int> ready_future = ready_result.get_future();
+  ASSERT_EQ(ready_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(ready_future.get(), 7);
+}
+
+TEST(Reactor, broken_notifying_promise_posts_continuation)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::promise<bool> broken;
+  {
+    comm::NotifyingPromise<int> promise;
+    reactor.whenReady(loop, promise.getFuture(), [&](std::future<int>& future) {
+      try
+      {
+        future.get();
+        broken.set_value(false);
+      }
+      catch (const std::future_error& error)
+      {
+        broken.set_value(error.code() == std::future_errc::broken_promise);
+      }
+    });
+  }
+  std::future<bool> broken_future = broken.get_future();
+  ASSERT_EQ(broken_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(broken_future.get());
+}
+
+TEST(Reactor, notifying_future_completed_after_reactor_is_destroyed)
+{
+  comm::NotifyingPromise<int> promise;
+  bool called = false;
+  {
+    comm::Reactor reactor;
+    reactor.whenReady(reactor.assignLoop(), promise.getFuture(), [&](std::future<int>&) { called = true; });
+  }
+  promise.setValue(1);
+  EXPECT_FALSE(called);
+}
+
+TEST(Reactor, failing_tasks_do_not_stop_the_loop)
+{
+  comm::Reactor reactor;
+  const size_t loop = reactor.assignLoop();
+  std::promise<void> called;
+  reactor.post(loop, []() { throw std::runtime_error("failing task"); });
+  reactor.post(loop, [&]() { called.set_value(); });
+  EXPECT_EQ(called.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
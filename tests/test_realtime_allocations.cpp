@@ -0,0 +1,313 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <ur_client_library/comm/package_serializer.h>
+#include <ur_client_library/comm/producer.h>
+#include <ur_client_library/comm/stream.h>
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/control/reverse_interface.h>
+#include <ur_client_library/rtde/data_package_pool.h>
+#include <ur_client_library/rtde/rtde_parser.h>
+#include <ur_client_library/rtde/rtde_writer.h>
+
+#include "allocation_counter.h"
+
+using namespace urcl;
+
+namespace
+{
+// Cycles run before counting, so buffers and pools have reached their steady-state size
+const size_t NUM_WARMUP_CYCLES = 10;
+const size_t NUM_CYCLES = 200;
+
+// A template, as wrapping the condition into a std::function might allocate
+template <typename ConditionT>
+bool waitFor(const ConditionT& condition, const std::chrono::milliseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+class ConnectionWaiter
+{
+public:
+  void onConnect(const int fd)
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    fd_ = fd;
+    cv_.notify_one();
+  }
+
+  int wait()
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    cv_.wait_for(lk, std::chrono::seconds(1), [this]() { return fd_ >= 0; });
+    return fd_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int fd_ = -1;
+};
+
+class Client : public comm::TCPSocket
+{
+public:
+  explicit Client(const int port)
+  {
+    TCPSocket::setup("127.0.0.1", port);
+    timeval tv;
+    tv.tv_sec = 1;
+    tv.tv_usec = 0;
+    TCPSocket::setReceiveTimeout(tv);
+  }
+};
+}  // namespace
+
+TEST(RealtimeAllocationsTest, rtde_receive_path_does_not_allocate)
+{
+  comm::TCPServer server(60018);
+  ConnectionWaiter connection;
+  server.setConnectCallback(std::bind(&ConnectionWaiter::onConnect, &connection, std::placeholders::_1));
+  server.start();
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60018);
+  const std::vector<std::string> recipe = { "timestamp", "actual_q", "robot_mode", "runtime_state" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  auto pool = rtde_interface::DataPackagePool::create(parser.getCompiledRecipe(), 2, 4);
+  parser.setDataPackagePool(pool);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+  producer.setupProducer();
+  const int client_fd = connection.wait();
+  ASSERT_GE(client_fd, 0);
+  producer.startProducer();
+
+  const auto timestamp_handle = parser.getCompiledRecipe()->getFieldHandle<double>("timestamp");
+  const auto actual_q_handle = parser.getCompiledRecipe()->getFieldHandle<vector6d_t>("actual_q");
+
+  // Data package with recipe id 1
+  uint8_t package[68];
+  size_t offset = comm::PackageSerializer::serialize(package, static_cast<uint16_t>(sizeof(package)));
+  offset += comm::PackageSerializer::serialize(package + offset, static_cast<uint8_t>('U'));
+  offset += comm::PackageSerializer::serialize(package + offset, static_cast<uint8_t>(1));
+  const size_t timestamp_offset = offset;
+  offset += sizeof(double);
+  offset += comm::PackageSerializer::serialize(package + offset, vector6d_t{ 0.1, -1.5, 1.2, -0.3, 1.6, 0.0 });
+  offset += comm::PackageSerializer::serialize(package + offset, static_cast<int32_t>(7));
+  offset += comm::PackageSerializer::serialize(package + offset, static_cast<uint32_t>(2));
+  ASSERT_EQ(offset, sizeof(package));
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  products.reserve(4);
+  size_t num_received = 0;
+  auto run_cycle = [&](const size_t cycle) {
+    comm::PackageSerializer::serialize(package + timestamp_offset, static_cast<double>(cycle));
+    size_t written;
+    server.write(client_fd, package, sizeof(package), written);
+    producer.tryGet(products);
+    for (auto& product : products)
+    {
+      rtde_interface::DataPackage* data = static_cast<rtde_interface::DataPackage*>(product.release());
+      double timestamp;
+      vector6d_t actual_q;
+      if (data->getData(timestamp_handle, timestamp) && data->getData(actual_q_handle, actual_q) &&
+          timestamp == static_cast<double>(cycle))
+      {
+        num_received++;
+      }
+      pool->release(std::unique_ptr<rtde_interface::DataPackage>(data));
+    }
+    products.clear();
+  };
+
+  for (size_t i = 0; i < NUM_WARMUP_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  test::AllocationCounter counter;
+  for (size_t i = NUM_WARMUP_CYCLES; i < NUM_WARMUP_CYCLES + NUM_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  counter.stop();
+
+  EXPECT_EQ(num_received, NUM_WARMUP_CYCLES + NUM_CYCLES);
+  EXPECT_EQ(counter.getNumAllocations(), 0u);
+  EXPECT_EQ(counter.getNumDeallocations(), 0u);
+  EXPECT_EQ(pool->getNumAllocations(), 0u);
+  producer.stopProducer();
+}
+
+TEST(RealtimeAllocationsTest, reverse_interface_write_does_not_allocate)
+{
+  std::atomic<bool> program_running(false);
+  control::ReverseInterface reverse_interface(60020, [&program_running](bool running) { program_running = running; });
+
+  Client client(60020);
+  ASSERT_TRUE(waitFor([&program_running]() { return program_running.load(); }, std::chrono::seconds(1)));
+
+  vector6d_t positions = { 0.0, -1.5, 1.2, -0.3, 1.6, 0.0 };
+  // Read timeout, positions and control mode
+  uint8_t message[8 * sizeof(int32_t)];
+  size_t num_received = 0;
+  auto run_cycle = [&](const size_t cycle) {
+    positions[0] = cycle * 1e-3;
+    reverse_interface.write(&positions, comm::ControlMode::MODE_SERVOJ);
+    size_t received = 0;
+    while (received < sizeof(message))
+    {
+      size_t read = 0;
+      if (!client.read(message + received, sizeof(message) - received, read))
+      {
+        return;
+      }
+      received += read;
+    }
+    int32_t first_position;
+    std::memcpy(&first_position, message + sizeof(int32_t), sizeof(first_position));
+    if (static_cast<int32_t>(be32toh(first_position)) == static_cast<int32_t>(std::round(positions[0] * 1e6)))
+    {
+      num_received++;
+    }
+  };
+
+  for (size_t i = 0; i < NUM_WARMUP_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  test::AllocationCounter counter;
+  for (size_t i = NUM_WARMUP_CYCLES; i < NUM_WARMUP_CYCLES + NUM_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  counter.stop();
+
+  EXPECT_EQ(num_received, NUM_WARMUP_CYCLES + NUM_CYCLES);
+  EXPECT_EQ(counter.getNumAllocations(), 0u);
+  EXPECT_EQ(counter.getNumDeallocations(), 0u);
+
+  client.close();
+  waitFor([&program_running]() { return !program_running; }, std::chrono::seconds(1));
+}
+
+TEST(RealtimeAllocationsTest, rtde_writer_send_does_not_allocate)
+{
+  comm::TCPServer server(60019);
+  std::atomic<size_t> bytes_received(0);
+  server.setMessageCallback(
+      [&bytes_received](const int, char*, const int nbytesrecv) { bytes_received += static_cast<size_t>(nbytesrecv); });
+  server.start();
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60019);
+  ASSERT_TRUE(stream.connect());
+  const std::vector<std::string> recipe = { "speed_slider_mask", "speed_slider_fraction", "standard_digital_output_mask",
+                                            "standard_digital_output", "input_double_register_25",
+                                            "input_int_register_24" };
+  rtde_interface::RTDEWriter writer(&stream, recipe);
+  writer.init(1);
+  auto bank = writer.createInputRegisterBank({ "input_int_register_24" });
+
+  // Header, recipe id and fields
+  const size_t package_size =
+      3 + 1 + sizeof(uint32_t) + sizeof(double) + 2 * sizeof(uint8_t) + sizeof(double) + sizeof(int32_t);
+  size_t num_sent = 0;
+  auto run_cycle = [&](const size_t cycle) {
+    writer.beginTransaction();
+    writer.sendSpeedSlider((cycle % 100) * 0.01);
+    writer.sendStandardDigitalOutput(cycle % 8, cycle % 2 == 0);
+    writer.sendInputDoubleRegister(25, static_cast<double>(cycle));
+    bank->setIntRegister(24, static_cast<int32_t>(cycle));
+    bank->publish();
+    writer.commitTransaction();
+    num_sent++;
+    waitFor([&]() { return bytes_received >= num_sent * package_size; }, std::chrono::seconds(1));
+  };
+
+  for (size_t i = 0; i < NUM_WARMUP_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  test::AllocationCounter counter;
+  for (size_t i = NUM_WARMUP_CYCLES; i < NUM_WARMUP_CYCLES + NUM_CYCLES; ++i)
+  {
+    run_cycle(i);
+  }
+  counter.stop();
+
+  EXPECT_EQ(bytes_received, num_sent * package_size);
+  EXPECT_EQ(counter.getNumAllocations(), 0u);
+  EXPECT_EQ(counter.getNumDeallocations(), 0u);
+}
+
+TEST(RealtimeAllocationsTest, data_package_copy_assignment_does_not_allocate)
+{
+  const std::vector<std::string> recipe = { "timestamp", "actual_q", "robot_mode", "runtime_state" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  rtde_interface::DataPackage latest(recipe);
+  latest.initEmpty();
+  auto lazy_recipe = rtde_interface::CompiledRecipe::intern(recipe);
+  rtde_interface::DataPackage lazy_package(lazy_recipe, 2, true);
+  lazy_package.initEmpty();
+  rtde_interface::DataPackage lazy_latest(lazy_recipe, 2, true);
+  lazy_latest.initEmpty();
+
+  test::AllocationCounter counter;
+  for (int i = 0; i < 100; ++i)
+  {
+    double timestamp = i;
+    package.setData("timestamp", timestamp);
+    latest = package;
+    lazy_latest = lazy_package;
+  }
+  counter.stop();
+  EXPECT_EQ(counter.getNumAllocations(), 0u);
+}
@@ -0,0 +1,127 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <ur_client_library/comm/reconnect_backoff.h>
+
+using namespace urcl;
+
+TEST(reconnect_backoff, default_delays)
+{
+  comm::ReconnectBackoff backoff;
+  std::chrono::milliseconds delay;
+  const int64_t expected[] = { 1000, 2000, 4000, 8000, 16000, 32000, 64000, 120000, 120000 };
+  for (const int64_t expected_delay : expected)
+  {
+    ASSERT_TRUE(backoff.nextDelay(delay));
+    EXPECT_EQ(delay.count(), expected_delay);
+  }
+  EXPECT_EQ(backoff.getNumAttempts(), 9u);
+}
+
+TEST(reconnect_backoff, reset)
+{
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::milliseconds(100);
+  config.multiplier = 3.0;
+  comm::ReconnectBackoff backoff(config);
+  std::chrono::milliseconds delay;
+  backoff.nextDelay(delay);
+  backoff.nextDelay(delay);
+  EXPECT_EQ(delay.count(), 300);
+
+  backoff.reset();
+  EXPECT_EQ(backoff.getNumAttempts(), 0u);
+  backoff.nextDelay(delay);
+  EXPECT_EQ(delay.count(), 100);
+}
+
+TEST(reconnect_backoff, max_attempts)
+{
+  comm::BackoffConfig config;
+  config.max_attempts = 2;
+  comm::ReconnectBackoff backoff(config);
+  std::chrono::milliseconds delay;
+  EXPECT_TRUE(backoff.nextDelay(delay));
+  EXPECT_TRUE(backoff.nextDelay(delay));
+  EXPECT_FALSE(backoff.nextDelay(delay));
+
+  backoff.reset();
+  EXPECT_TRUE(backoff.nextDelay(delay));
+}
+
+TEST(reconnect_backoff, jitter_stays_in_range)
+{
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::milliseconds(1000);
+  config.multiplier = 1.0;
+  config.jitter = 0.2;
+  comm::ReconnectBackoff backoff(config);
+  std::chrono::milliseconds delay;
+  bool varied = false;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    ASSERT_TRUE(backoff.nextDelay(delay));
+    EXPECT_GE(delay.count(), 800);
+    EXPECT_LE(delay.count(), 1200);
+    varied = varied || delay.count() != 1000;
+  }
+  EXPECT_TRUE(varied);
+}
+
+TEST(reconnect_backoff, invalid_config_is_clamped)
+{
+  comm::BackoffConfig config;
+  config.initial_delay = std::chrono::milliseconds(500);
+  config.max_delay = std::chrono::milliseconds(200);
+  config.multiplier = 0.5;
+  config.jitter = 5.0;
+  comm::ReconnectBackoff backoff(config);
+  EXPECT_EQ(backoff.getConfig().multiplier, 1.0);
+  EXPECT_EQ(backoff.getConfig().jitter, 1.0);
+
+  config.jitter = 0.0;
+  comm::ReconnectBackoff clamped(config);
+  std::chrono::milliseconds delay;
+  clamped.nextDelay(delay);
+  EXPECT_EQ(delay.count(), 200);
+  clamped.nextDelay(delay);
+  EXPECT_EQ(delay.count(), 200);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/register_transfer.h"
+
+using namespace urcl;
+
+class RegisterTransferTest : public ::testing::Test
+{
+protected:
+  RegisterTransferTest()
+    : config_(makeConfig())
+    , transfer_(config_)
+    , write_([this](const int32_t control, const std::vector<double>& data) {
+      chunks_.push_back(std::make_pair(control, data));
+      if (acknowledge_)
+      {
+        transfer_.onAcknowledgement(control);
+      }
+      return true;
+    })
+  {
+  }
+
+  static rtde_interface::RegisterTransferConfig makeConfig()
+  {
+    rtde_interface::RegisterTransferConfig config;
+    config.control_register = 30;
+    config.ack_register = 31;
+    config.first_data_register = 24;
+    config.num_data_registers = 8;
+    config.capacity = 100;
+    return config;
+  }
+
+  rtde_interface::RegisterTransferConfig config_;
+  rtde_interface::RegisterTransfer transfer_;
+  rtde_interface::RegisterTransfer::WriteFunction write_;
+  std::vector<std::pair<int32_t, std::vector<double>>> chunks_;
+  bool acknowledge_ = true;
+};
+
+TEST_F(RegisterTransferTest, registers)
+{
+  const std::vector<std::string> registers = config_.getInputRegisters();
+  ASSERT_EQ(registers.size(), 9u);
+  EXPECT_EQ(registers.front(), "input_int_register_30");
+  EXPECT_EQ(registers[1], "input_double_register_24");
+  EXPECT_EQ(registers.back(), "input_double_register_31");
+  EXPECT_EQ(config_.getAckField(), "output_int_register_31");
+}
+
+TEST_F(RegisterTransferTest, invalid_config_throws)
+{
+  rtde_interface::RegisterTransferConfig config = makeConfig();
+  config.control_register = 12;
+  EXPECT_THROW(rtde_interface::RegisterTransfer{ config }, UrException);
+
+  config = makeConfig();
+  config.num_data_registers = 1;
+  EXPECT_THROW(rtde_interface::RegisterTransfer{ config }, UrException);
+
+  config = makeConfig();
+  config.first_data_register = 44;
+  EXPECT_THROW(rtde_interface::RegisterTransfer{ config }, UrException);
+}
+
+TEST_F(RegisterTransferTest, send_splits_values_into_chunks)
+{
+  std::vector<double> values;
+  for (int i = 0; i < 20; ++i)
+  {
+    values.push_back(i * 0.5);
+  }
+
+  ASSERT_TRUE(transfer_.send(values, 7, write_));
+  ASSERT_EQ(chunks_.size(), transfer_.getNumChunks(values.size()));
+  ASSERT_EQ(chunks_.size(), 4u);
+
+  // Header chunk
+  EXPECT_EQ(chunks_[0].first % 2, 1);
+  EXPECT_DOUBLE_EQ(chunks_[0].second[0], 20.0);
+  EXPECT_DOUBLE_EQ(chunks_[0].second[1], 7.0);
+
+  std::vector<double> received;
+  for (size_t i = 1; i < chunks_.size(); ++i)
+  {
+    EXPECT_EQ(chunks_[i].first % 2, 0);
+    EXPECT_NE(chunks_[i].first, chunks_[i - 1].first);
+    ASSERT_EQ(chunks_[i].second.size(), 8u);
+    received.insert(received.end(), chunks_[i].second.begin(), chunks_[i].second.end());
+  }
+  // The last chunk is padded
+  ASSERT_EQ(received.size(), 24u);
+  received.resize(values.size());
+  EXPECT_EQ(received, values);
+}
+
+TEST_F(RegisterTransferTest, empty_transfer_sends_header_only)
+{
+  ASSERT_TRUE(transfer_.send({}, 3, write_));
+  ASSERT_EQ(chunks_.size(), 1u);
+  EXPECT_DOUBLE_EQ(chunks_[0].second[0], 0.0);
+}
+
+TEST_F(RegisterTransferTest, control_values_never_repeat)
+{
+  ASSERT_TRUE(transfer_.send({ 1.0 }, 1, write_));
+  ASSERT_TRUE(transfer_.send({ 1.0 }, 1, write_));
+  for (size_t i = 0; i < chunks_.size(); ++i)
+  {
+    EXPECT_NE(chunks_[i].first, 0);
+    if (i > 0)
+    {
+      EXPECT_NE(chunks_[i].first, chunks_[i - 1].first);
+    }
+  }
+}
+
+TEST_F(RegisterTransferTest, missing_acknowledgement_fails)
+{
+  acknowledge_ = false;
+  EXPECT_FALSE(transfer_.send({ 1.0, 2.0 }, 1, write_, std::chrono::milliseconds(10)));
+  EXPECT_EQ(chunks_.size(), 1u);
+}
+
+TEST_F(RegisterTransferTest, acknowledgement_from_other_thread)
+{
+  acknowledge_ = false;
+  std::vector<double> values(30, 1.0);
+  std::vector<std::thread> robot;
+  rtde_interface::RegisterTransfer::WriteFunction write = [this, &robot](const int32_t control,
+                                                                         const std::vector<double>& data) {
+    chunks_.push_back(std::make_pair(control, data));
+    robot.emplace_back([this, control] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      transfer_.onAcknowledgement(control);
+    });
+    return true;
+  };
+  EXPECT_TRUE(transfer_.send(values, 2, write, std::chrono::milliseconds(500)));
+  EXPECT_EQ(chunks_.size(), transfer_.getNumChunks(values.size()));
+  for (auto& thread : robot)
+  {
+    thread.join();
+  }
+}
+
+TEST_F(RegisterTransferTest, too_many_values_throw)
+{
+  EXPECT_THROW(transfer_.send(std::vector<double>(101, 0.0), 1, write_), UrException);
+  EXPECT_TRUE(chunks_.empty());
+}
+
+TEST_F(RegisterTransferTest, failed_write_fails)
+{
+  rtde_interface::RegisterTransfer::WriteFunction write = [](const int32_t, const std::vector<double>&) {
+    return false;
+  };
+  EXPECT_FALSE(transfer_.send({ 1.0 }, 1, write));
+}
@@ -0,0 +1,180 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <condition_variable>
+
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/replay_producer.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+using namespace urcl;
+
+class StoppedNotifier : public comm::INotifier
+{
+public:
+  void stopped(std::string name) override
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stopped_ = true;
+    cv_.notify_one();
+  }
+
+  bool waitForStopped(const std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return cv_.wait_for(lk, timeout, [this] { return stopped_; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+};
+
+class ReplayProducerTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    path_ = "replay_producer_test_" + std::to_string(::getpid()) + ".bin";
+    std::vector<std::string> recipe = { "timestamp", "actual_q" };
+
+    rtde_interface::RTDERecorder recorder(path_);
+    recorder.open(recipe, 2);
+    uint8_t buffer[4096];
+    const auto start = std::chrono::system_clock::now();
+    for (size_t i = 0; i < NUM_FRAMES; ++i)
+    {
+      rtde_interface::DataPackage package(recipe, 2);
+      package.initEmpty();
+      double timestamp = static_cast<double>(i);
+      package.setData("timestamp", timestamp);
+      package.setRecipeID(1);
+      const size_t size = package.serializePackage(buffer);
+      ASSERT_TRUE(recorder.record(buffer, size, start + i * FRAME_PERIOD));
+    }
+    recorder.close();
+
+    recording_.reset(new rtde_interface::RTDERecording(path_));
+    parser_.reset(new rtde_interface::RTDEParser(recording_->getRecipe()));
+    parser_->setProtocolVersion(recording_->getProtocolVersion());
+  }
+
+  void TearDown()
+  {
+    std::remove(path_.c_str());
+  }
+
+  double getTimestamp(rtde_interface::RTDEPackage& package)
+  {
+    double timestamp = -1.0;
+    auto* data = dynamic_cast<rtde_interface::DataPackage*>(&package);
+    if (data != nullptr)
+    {
+      data->getData("timestamp", timestamp);
+    }
+    return timestamp;
+  }
+
+  static constexpr size_t NUM_FRAMES = 10;
+  static constexpr std::chrono::milliseconds FRAME_PERIOD{ 20 };
+
+  std::string path_;
+  std::unique_ptr<rtde_interface::RTDERecording> recording_;
+  std::unique_ptr<rtde_interface::RTDEParser> parser_;
+};
+
+constexpr size_t ReplayProducerTest::NUM_FRAMES;
+constexpr std::chrono::milliseconds ReplayProducerTest::FRAME_PERIOD;
+
+TEST_F(ReplayProducerTest, replay_through_pipeline)
+{
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(*recording_, *parser_);
+  StoppedNotifier notifier;
+  comm::Pipeline<rtde_interface::RTDEPackage> pipeline(producer, "REPLAY_PIPELINE", notifier);
+
+  std::vector<double> timestamps;
+  pipeline.setProducerCallback([&](std::unique_ptr<rtde_interface::RTDEPackage>& product) {
+    timestamps.push_back(getTimestamp(*product));
+    return true;
+  });
+  pipeline.init();
+  pipeline.run();
+  ASSERT_TRUE(notifier.waitForStopped(std::chrono::seconds(1)));
+  pipeline.stop();
+
+  ASSERT_EQ(NUM_FRAMES, timestamps.size());
+  for (size_t i = 0; i < NUM_FRAMES; ++i)
+  {
+    EXPECT_EQ(static_cast<double>(i), timestamps[i]);
+  }
+}
+
+TEST_F(ReplayProducerTest, replay_restarts_on_setup)
+{
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(*recording_, *parser_);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(producer.tryGet(products));
+  }
+  producer.setupProducer();
+  products.clear();
+  ASSERT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(1u, products.size());
+  EXPECT_EQ(0.0, getTimestamp(*products[0]));
+}
+
+TEST_F(ReplayProducerTest, replay_paced_to_recording)
+{
+  const double speed = 2.0;
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(*recording_, *parser_, speed);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+
+  const auto start = std::chrono::steady_clock::now();
+  while (producer.tryGet(products))
+  {
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(NUM_FRAMES, products.size());
+  EXPECT_GE(elapsed, (NUM_FRAMES - 1) * FRAME_PERIOD / speed);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
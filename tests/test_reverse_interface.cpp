@@ -33,6 +33,9 @@
 #include <ur_client_library/comm/tcp_socket.h>
 #include <ur_client_library/exceptions.h>
 
+#include <cmath>
+#include <poll.h>
+
 using namespace urcl;
 
 class ReverseIntefaceTest : public ::testing::Test
@@ -89,6 +92,42 @@ protected:
       control_mode = be32toh(val);
     }
 
+    std::vector<int32_t> readInts(const size_t count)
+    {
+      std::vector<int32_t> values(count);
+      uint8_t* b_pos = reinterpret_cast<uint8_t*>(values.data());
+      size_t read = 0;
+      size_t remainder = sizeof(int32_t) * count;
+      while (remainder > 0)
+      {
+        if (!TCPSocket::read(b_pos, remainder, read))
+        {
+          std::cout << "Failed to read from socket, this should not happen during a test!" << std::endl;
+          break;
+        }
+        b_pos += read;
+        remainder -= read;
+      }
+      for (auto& val : values)
+      {
+        val = be32toh(val);
+      }
+      return values;
+    }
+
+    bool waitForMessage(const std::chrono::milliseconds timeout)
+    {
+      pollfd fd = { getSocketFD(), POLLIN, 0 };
+      return ::poll(&fd, 1, static_cast<int>(timeout.count())) == 1;
+    }
+
+    void send(const int32_t value)
+    {
+      int32_t val = htobe32(value);
+      size_t written = 0;
+      TCPSocket::write(reinterpret_cast<uint8_t*>(&val), sizeof(val), written);
+    }
+
     // Helper functions to get different parts of the received message
     vector6int32_t getPositions()
     {
@@ -151,8 +190,8 @@ protected:
   void SetUp()
   {
     reverse_interface_.reset(new control::ReverseInterface(
-        50001, std::bind(&ReverseIntefaceTest::handleProgramState, this, std::placeholders::_1)));
-    client_.reset(new Client(50001));
+        0, std::bind(&ReverseIntefaceTest::handleProgramState, this, std::placeholders::_1)));
+    client_.reset(new Client(reverse_interface_->getPort()));
   }
 
   void TearDown()
@@ -258,6 +297,71 @@ TEST_F(ReverseIntefaceTest, write_trajectory_point_number)
   EXPECT_EQ(written_point_number, received_point_number);
 }
 
+TEST_F(ReverseIntefaceTest, cancel_sends_points_written)
+{
+  // Wait for the client to connect to the server
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  size_t num_cancels = 0;
+  reverse_interface_->setTrajectoryWritesCanceler([&num_cancels]() {
+    ++num_cancels;
+    return size_t(7);
+  });
+
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 3);
+  EXPECT_EQ(3, client_->getTrajectoryPointNumber());
+  EXPECT_EQ(0u, num_cancels);
+
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_CANCEL);
+  EXPECT_EQ(7, client_->getTrajectoryPointNumber());
+  EXPECT_EQ(1u, num_cancels);
+}
+
+TEST_F(ReverseIntefaceTest, leaving_forward_cancels_trajectory)
+{
+  // Wait for the client to connect to the server
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  size_t num_cancels = 0;
+  reverse_interface_->setTrajectoryWritesCanceler([&num_cancels]() {
+    ++num_cancels;
+    return size_t(5);
+  });
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 20);
+  EXPECT_EQ(20, client_->getTrajectoryPointNumber());
+
+  vector6d_t pos = { 0, 0, 0, 0, 0, 0 };
+  reverse_interface_->write(&pos, comm::ControlMode::MODE_IDLE);
+  int32_t read_timeout;
+  int32_t control_mode;
+  vector6int32_t received;
+  client_->readMessage(read_timeout, received, control_mode);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_FORWARD), control_mode);
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_CANCEL), received[0]);
+  EXPECT_EQ(5, received[1]);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_IDLE), client_->getControlMode());
+
+  // Only leaving MODE_FORWARD cancels the trajectory
+  reverse_interface_->write(&pos, comm::ControlMode::MODE_SERVOJ);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+  EXPECT_EQ(1u, num_cancels);
+}
+
+TEST_F(ReverseIntefaceTest, write_trajectory_cache_control_message)
+{
+  // Wait for the client to connect to the server
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  reverse_interface_->writeTrajectoryCacheControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START_CACHED,
+                                                         -123456, 15);
+  vector6int32_t received_pos = client_->getPositions();
+
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_START_CACHED), received_pos[0]);
+  EXPECT_EQ(15, received_pos[1]);
+  EXPECT_EQ(-123456, received_pos[2]);
+  EXPECT_EQ(0, received_pos[3]);
+}
+
 TEST_F(ReverseIntefaceTest, control_mode_is_forward)
 {
   // Wait for the client to connect to the server
@@ -385,6 +489,11 @@ TEST_F(ReverseIntefaceTest, write_control_mode)
   reverse_interface_->write(&pos, expected_control_mode);
   received_control_mode = client_->getControlMode();
 
+  EXPECT_EQ(toUnderlying(expected_control_mode), received_control_mode);
+  expected_control_mode = comm::ControlMode::MODE_FORCE;
+  reverse_interface_->write(&pos, expected_control_mode);
+  received_control_mode = client_->getControlMode();
+
   EXPECT_EQ(toUnderlying(expected_control_mode), received_control_mode);
 
   expected_control_mode = comm::ControlMode::MODE_STOPPED;
@@ -445,6 +554,437 @@ TEST_F(ReverseIntefaceTest, deprecated_set_keep_alive_count)
   EXPECT_EQ(expected_read_timeout, received_read_timeout);
 }
 
+TEST_F(ReverseIntefaceTest, compact_protocol_requires_robot_support)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  reverse_interface_->setUseCompactProtocol(true);
+
+  reverse_interface_->write(nullptr, comm::ControlMode::MODE_IDLE);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_IDLE), client_->getControlMode());
+  EXPECT_EQ(control::ReverseProtocol::FULL, reverse_interface_->getProtocol());
+}
+
+TEST_F(ReverseIntefaceTest, compact_protocol)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  reverse_interface_->setUseCompactProtocol(true);
+  client_->send(toUnderlying(control::ReverseProtocol::COMPACT));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // The switch is announced in the full format
+  reverse_interface_->write(nullptr, comm::ControlMode::MODE_IDLE, RobotReceiveTimeout::millisec(200));
+  std::vector<int32_t> select = client_->readInts(8);
+  EXPECT_EQ(200, select[0]);
+  EXPECT_EQ(toUnderlying(control::ReverseProtocol::COMPACT), select[1]);
+  EXPECT_EQ(-100, select[7]);
+  EXPECT_EQ(control::ReverseProtocol::COMPACT, reverse_interface_->getProtocol());
+
+  // Idle commands only consist of a header
+  std::vector<int32_t> idle = client_->readInts(1);
+  EXPECT_EQ(200 * 16 + toUnderlying(comm::ControlMode::MODE_IDLE) + 2, idle[0]);
+
+  urcl::vector6d_t written_positions = { 1.2, -3.1, -2.2, -3.4, 1.1, 1.2 };
+  reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(20));
+  std::vector<int32_t> servo = client_->readInts(7);
+  EXPECT_EQ(20 * 16 + toUnderlying(comm::ControlMode::MODE_SERVOJ) + 2, servo[0]);
+  for (size_t i = 0; i < written_positions.size(); ++i)
+  {
+    EXPECT_EQ(written_positions[i], ((double)servo[i + 1]) / reverse_interface_->MULT_JOINTSTATE);
+  }
+
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 42,
+                                                    RobotReceiveTimeout::millisec(200));
+  std::vector<int32_t> trajectory = client_->readInts(4);
+  EXPECT_EQ(200 * 16 + toUnderlying(comm::ControlMode::MODE_FORWARD) + 2, trajectory[0]);
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_START), trajectory[1]);
+  EXPECT_EQ(42, trajectory[2]);
+  EXPECT_EQ(0, trajectory[3]);
+
+  reverse_interface_->writeTrajectoryCacheControlMessage(control::TrajectoryControlMessage::TRAJECTORY_REPLAY, 7, 0,
+                                                         RobotReceiveTimeout::millisec(200));
+  std::vector<int32_t> replay = client_->readInts(4);
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_REPLAY), replay[1]);
+  EXPECT_EQ(7, replay[3]);
+
+  reverse_interface_->writeFreedriveControlMessage(control::FreedriveControlMessage::FREEDRIVE_START,
+                                                   RobotReceiveTimeout::millisec(200));
+  std::vector<int32_t> freedrive = client_->readInts(2);
+  EXPECT_EQ(200 * 16 + toUnderlying(comm::ControlMode::MODE_FREEDRIVE) + 2, freedrive[0]);
+  EXPECT_EQ(toUnderlying(control::FreedriveControlMessage::FREEDRIVE_START), freedrive[1]);
+
+  urcl::vector6d_t wrench = { 0.0, 0.0, -10.0, 0.0, 0.0, 0.5 };
+  reverse_interface_->write(&wrench, comm::ControlMode::MODE_FORCE, RobotReceiveTimeout::millisec(20));
+  std::vector<int32_t> force = client_->readInts(7);
+  EXPECT_EQ(20 * 16 + toUnderlying(comm::ControlMode::MODE_FORCE) + 2, force[0]);
+  for (size_t i = 0; i < wrench.size(); ++i)
+  {
+    EXPECT_EQ(wrench[i], ((double)force[i + 1]) / reverse_interface_->MULT_JOINTSTATE);
+  }
+
+  // Stopping the script only needs a header as well
+  reverse_interface_->write(nullptr, comm::ControlMode::MODE_STOPPED);
+  EXPECT_EQ(100 * 16, client_->readInts(1)[0]);
+}
+
+TEST_F(ReverseIntefaceTest, setpoints_are_numbered_for_echoing)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  auto monitor = std::make_shared<control::SetpointLatencyMonitor>(3);
+  reverse_interface_->setSetpointLatencyMonitor(monitor);
+  client_->send(4);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Numbering is announced in the full format, without a number itself
+  urcl::vector6d_t written_positions = { 1.2, -3.1, -2.2, -3.4, 1.1, 1.2 };
+  reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(20));
+  std::vector<int32_t> select = client_->readInts(8);
+  EXPECT_EQ(toUnderlying(control::ReverseProtocol::FULL), select[1]);
+  EXPECT_EQ(1, select[2]);
+  EXPECT_EQ(-100, select[7]);
+  EXPECT_TRUE(reverse_interface_->isSequencingSetpoints());
+
+  std::vector<int32_t> servo = client_->readInts(9);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), servo[7]);
+  EXPECT_EQ(1, servo[8]);
+  reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(20));
+  EXPECT_EQ(2, client_->readInts(9)[8]);
+
+  // Other commands are followed by 0
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 42,
+                                                    RobotReceiveTimeout::millisec(200));
+  EXPECT_EQ(0, client_->readInts(9)[8]);
+}
+
+TEST_F(ReverseIntefaceTest, program_parked)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  EXPECT_FALSE(reverse_interface_->isProgramParked());
+
+  // A resident program reports being parked instead of disconnecting
+  client_->send(2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(reverse_interface_->isProgramParked());
+  EXPECT_TRUE(reverse_interface_->isConnected());
+
+  // The next command re-arms it
+  reverse_interface_->write(nullptr, comm::ControlMode::MODE_IDLE);
+  client_->getControlMode();
+  EXPECT_FALSE(reverse_interface_->isProgramParked());
+
+  client_->send(2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(reverse_interface_->isProgramParked());
+  client_->close();
+  EXPECT_TRUE(waitForProgramState(1000, false));
+  EXPECT_FALSE(reverse_interface_->isProgramParked());
+}
+
+TEST_F(ReverseIntefaceTest, heartbeats_while_parked)
+{
+  reverse_interface_->setParkedHeartbeatPeriod(std::chrono::milliseconds(20));
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  // Heartbeats are only written while the program is parked
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(100)));
+  client_->send(2);
+  EXPECT_TRUE(client_->waitForMessage(std::chrono::milliseconds(1000)));
+  int32_t read_timeout;
+  vector6int32_t pos;
+  int32_t control_mode;
+  client_->readMessage(read_timeout, pos, control_mode);
+  EXPECT_EQ(0, read_timeout);
+  EXPECT_EQ(13, control_mode);
+
+  // They don't re-arm the program
+  EXPECT_TRUE(reverse_interface_->isProgramParked());
+  reverse_interface_->setParkedHeartbeatPeriod(std::chrono::milliseconds(0));
+}
+
+TEST_F(ReverseIntefaceTest, session_resumed_after_reconnect)
+{
+  reverse_interface_->setSessionResumeTimeout(std::chrono::milliseconds(1000));
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  client_->send(3);
+  client_->send(42);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(42, reverse_interface_->getSessionId());
+
+  // Reconnecting with the same session keeps the program running
+  client_->close();
+  EXPECT_FALSE(waitForProgramState(200, false));
+  client_.reset(new Client(reverse_interface_->getPort()));
+  client_->send(3);
+  client_->send(42);
+  EXPECT_FALSE(waitForProgramState(1500, false));
+  EXPECT_TRUE(reverse_interface_->isConnected());
+}
+
+TEST_F(ReverseIntefaceTest, new_session_restarts_program_state)
+{
+  reverse_interface_->setSessionResumeTimeout(std::chrono::milliseconds(1000));
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  client_->send(3);
+  client_->send(42);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<bool> program_states;
+  std::mutex states_mutex;
+  reverse_interface_.reset();
+  reverse_interface_.reset(new control::ReverseInterface(0, [&](bool program_state) {
+    std::lock_guard<std::mutex> lk(states_mutex);
+    program_states.push_back(program_state);
+  }));
+  reverse_interface_->setSessionResumeTimeout(std::chrono::milliseconds(1000));
+  client_.reset(new Client(reverse_interface_->getPort()));
+  client_->send(3);
+  client_->send(42);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // A different session connecting is reported as the program being restarted
+  client_->close();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  client_.reset(new Client(reverse_interface_->getPort()));
+  client_->send(3);
+  client_->send(43);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(43, reverse_interface_->getSessionId());
+
+  {
+    std::lock_guard<std::mutex> lk(states_mutex);
+    EXPECT_EQ(program_states, std::vector<bool>({ false, true, false, true }));
+  }
+  // The callback must not outlive the states it records
+  client_->close();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  reverse_interface_.reset();
+}
+
+TEST_F(ReverseIntefaceTest, session_not_resumed_in_time)
+{
+  reverse_interface_->setSessionResumeTimeout(std::chrono::milliseconds(200));
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  client_->send(3);
+  client_->send(42);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  client_->close();
+  EXPECT_TRUE(waitForProgramState(1000, false));
+}
+
+TEST_F(ReverseIntefaceTest, automatic_keepalive)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  reverse_interface_->setAutomaticKeepalive(true);
+  EXPECT_TRUE(reverse_interface_->isAutomaticKeepaliveEnabled());
+
+  // A no-op is sent once half of the read timeout passed without another command
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 5,
+                                                    RobotReceiveTimeout::millisec(200));
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_START), client_->getTrajectoryControlMode());
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(50)));
+  int32_t read_timeout;
+  int32_t control_mode;
+  vector6int32_t pos;
+  client_->readMessage(read_timeout, pos, control_mode);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+  EXPECT_EQ(200, read_timeout);
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_FORWARD), control_mode);
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_NOOP), pos[0]);
+
+  // Commands written in time make keepalive messages unnecessary
+  for (size_t i = 0; i < 5; ++i)
+  {
+    reverse_interface_->writeFreedriveControlMessage(control::FreedriveControlMessage::FREEDRIVE_NOOP,
+                                                     RobotReceiveTimeout::millisec(200));
+    EXPECT_EQ(toUnderlying(control::FreedriveControlMessage::FREEDRIVE_NOOP), client_->getFreedriveControlMode());
+    EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(50)));
+  }
+
+  // Realtime control modes aren't kept alive
+  vector6d_t positions = { 0, 0, 0, 0, 0, 0 };
+  reverse_interface_->write(&positions, comm::ControlMode::MODE_SERVOJ, RobotReceiveTimeout::millisec(20));
+  client_->getControlMode();
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(100)));
+
+  reverse_interface_->setAutomaticKeepalive(false);
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_NOOP, 0,
+                                                    RobotReceiveTimeout::millisec(100));
+  client_->getControlMode();
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(150)));
+}
+
+TEST_F(ReverseIntefaceTest, async_setpoint_writes)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+  reverse_interface_->setAsyncSetpointWrites(true);
+  EXPECT_TRUE(reverse_interface_->isAsyncSetpointWritesEnabled());
+
+  vector6d_t written_positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  EXPECT_TRUE(reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ));
+  vector6int32_t received_positions = client_->getPositions();
+  EXPECT_EQ(written_positions[0], ((double)received_positions[0]) / reverse_interface_->MULT_JOINTSTATE);
+  EXPECT_EQ(written_positions[5], ((double)received_positions[5]) / reverse_interface_->MULT_JOINTSTATE);
+
+  // Setpoints written faster than they are sent are replaced by newer ones, the last one is always sent
+  const size_t num_setpoints = 1000;
+  for (size_t i = 1; i <= num_setpoints; ++i)
+  {
+    written_positions[0] = static_cast<double>(i);
+    EXPECT_TRUE(reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ));
+  }
+  size_t num_received = 0;
+  while (client_->waitForMessage(std::chrono::milliseconds(100)))
+  {
+    received_positions = client_->getPositions();
+    ++num_received;
+  }
+  EXPECT_EQ(static_cast<double>(num_setpoints),
+            ((double)received_positions[0]) / reverse_interface_->MULT_JOINTSTATE);
+  EXPECT_EQ(num_setpoints, num_received + reverse_interface_->getNumReplacedSetpoints());
+
+  // Other commands are still sent right away
+  reverse_interface_->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 5);
+  EXPECT_EQ(toUnderlying(control::TrajectoryControlMessage::TRAJECTORY_START), client_->getTrajectoryControlMode());
+
+  reverse_interface_->setAsyncSetpointWrites(false);
+  EXPECT_TRUE(reverse_interface_->write(&written_positions, comm::ControlMode::MODE_SERVOJ));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+}
+
+TEST_F(ReverseIntefaceTest, client_side_inverse_kinematics)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  // Nominal UR5e
+  kinematics::DHParameters parameters;
+  parameters.theta = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  parameters.a = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+  parameters.d = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+  parameters.alpha = { M_PI_2, 0.0, 0.0, M_PI_2, -M_PI_2, 0.0 };
+  auto model = std::make_shared<kinematics::KinematicsModel>(parameters);
+
+  const vector6d_t q = { 0.4, -1.9, 1.6, -1.2, -1.5, 0.3 };
+  size_t num_seeds = 0;
+  reverse_interface_->setInverseKinematics(model, [&q, &num_seeds](vector6d_t& seed) {
+    seed = q;
+    seed[0] += 0.1;
+    ++num_seeds;
+    return true;
+  });
+
+  // Poses are sent as joint positions using servoj
+  vector6d_t pose = model->forward(q);
+  EXPECT_TRUE(reverse_interface_->write(&pose, comm::ControlMode::MODE_POSE));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+  vector6int32_t received_positions = client_->getPositions();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_NEAR(q[i], ((double)received_positions[i]) / reverse_interface_->MULT_JOINTSTATE, 1e-6);
+  }
+
+  // Following poses of the stream are solved closest to the previous solution
+  pose[2] += 0.01;
+  EXPECT_TRUE(reverse_interface_->write(&pose, comm::ControlMode::MODE_POSE));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+  EXPECT_EQ(num_seeds, 1u);
+
+  // Unreachable poses are not sent
+  vector6d_t unreachable = { 2.0, 0.0, 0.5, 0.0, M_PI, 0.0 };
+  EXPECT_FALSE(reverse_interface_->write(&unreachable, comm::ControlMode::MODE_POSE));
+  EXPECT_EQ(reverse_interface_->getNumUnreachablePoses(), 1u);
+
+  // Without a model, poses are sent to the robot as they are
+  reverse_interface_->setInverseKinematics(nullptr);
+  EXPECT_TRUE(reverse_interface_->write(&pose, comm::ControlMode::MODE_POSE));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_POSE), client_->getControlMode());
+}
+
+TEST_F(ReverseIntefaceTest, stale_robot_state)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  vector6d_t pos = { 0, 0, 0, 0, 0, 0 };
+  EXPECT_TRUE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SERVOJ));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+
+  // Setpoints based on a stale state aren't sent
+  reverse_interface_->setRobotStateStale(true);
+  EXPECT_TRUE(reverse_interface_->isRobotStateStale());
+  EXPECT_FALSE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SPEEDJ));
+  EXPECT_FALSE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SERVOJ));
+  EXPECT_EQ(reverse_interface_->getNumStaleSetpoints(), 2u);
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(20)));
+
+  // Non-realtime commands are still sent
+  EXPECT_TRUE(reverse_interface_->write(&pos, comm::ControlMode::MODE_IDLE));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_IDLE), client_->getControlMode());
+
+  reverse_interface_->setRobotStateStale(false);
+  EXPECT_TRUE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SPEEDJ));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SPEEDJ), client_->getControlMode());
+  EXPECT_EQ(reverse_interface_->getNumStaleSetpoints(), 2u);
+}
+
+TEST_F(ReverseIntefaceTest, expired_setpoints)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  vector6d_t pos = { 0, 0, 0, 0, 0, 0 };
+  const auto timeout = RobotReceiveTimeout::millisec(20);
+  const auto old_state = std::chrono::steady_clock::now() - std::chrono::milliseconds(10);
+
+  // Without a validity, setpoints never expire
+  EXPECT_TRUE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SERVOJ, timeout, old_state));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+
+  reverse_interface_->setSetpointValidity(std::chrono::milliseconds(5));
+  EXPECT_EQ(reverse_interface_->getSetpointValidity(), std::chrono::milliseconds(5));
+  EXPECT_FALSE(reverse_interface_->write(&pos, comm::ControlMode::MODE_SPEEDJ, timeout, old_state));
+  EXPECT_EQ(reverse_interface_->getNumExpiredSetpoints(), 1u);
+  EXPECT_FALSE(client_->waitForMessage(std::chrono::milliseconds(20)));
+
+  EXPECT_TRUE(
+      reverse_interface_->write(&pos, comm::ControlMode::MODE_SPEEDJ, timeout, std::chrono::steady_clock::now()));
+  EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SPEEDJ), client_->getControlMode());
+  EXPECT_EQ(reverse_interface_->getNumExpiredSetpoints(), 1u);
+}
+
+TEST_F(ReverseIntefaceTest, write_servo_parameters)
+{
+  EXPECT_TRUE(waitForProgramState(1000, true));
+
+  EXPECT_FALSE(reverse_interface_->writeServoParameters(0.01, 300));
+  EXPECT_FALSE(reverse_interface_->writeServoParameters(0.1, 3000));
+  EXPECT_TRUE(reverse_interface_->writeServoParameters(0.1, 300));
+  int32_t read_timeout;
+  vector6int32_t pos;
+  int32_t control_mode;
+  client_->readMessage(read_timeout, pos, control_mode);
+  EXPECT_EQ(0, read_timeout);
+  EXPECT_EQ(12, control_mode);
+  EXPECT_EQ(100, pos[0]);
+  EXPECT_EQ(300, pos[1]);
+
+  // A tuner sends its parameters once a window of setpoints is completed
+  control::AdaptiveServojConfig config;
+  config.min_lookahead_time = 0.1;
+  config.window_size = 5;
+  reverse_interface_->setAdaptiveServojTuner(std::make_shared<control::AdaptiveServojTuner>(config, 0.03, 2000));
+  vector6d_t setpoint = { 0, 0, 0, 0, 0, 0 };
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_TRUE(reverse_interface_->write(&setpoint, comm::ControlMode::MODE_SERVOJ));
+    EXPECT_EQ(toUnderlying(comm::ControlMode::MODE_SERVOJ), client_->getControlMode());
+  }
+  client_->readMessage(read_timeout, pos, control_mode);
+  EXPECT_EQ(12, control_mode);
+  EXPECT_EQ(100, pos[0]);
+  EXPECT_EQ(2000, pos[1]);
+  EXPECT_NEAR(reverse_interface_->getAdaptiveServojTuner()->getLookaheadTime(), 0.1, 0.001);
+  reverse_interface_->setAdaptiveServojTuner(nullptr);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
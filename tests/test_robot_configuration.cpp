@@ -0,0 +1,151 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/primary/robot_configuration.h"
+
+using namespace urcl;
+using namespace urcl::primary_interface;
+
+class RobotConfigurationCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    serial_ = "20235500" + std::to_string(::getpid());
+
+    configuration_.version = VersionInformation::fromString("5.15.2.10876");
+    configuration_.project_name = "URControl with spaces";
+    configuration_.joint_min_limits = { -6.283185307179586, -6.28, -3.14, -6.28, -6.28, -6.28 };
+    configuration_.joint_max_limits = { 6.283185307179586, 6.28, 3.14, 6.28, 6.28, 6.28 };
+    configuration_.joint_max_speeds = { 3.14, 3.14, 3.14, 3.14, 3.14, 3.14 };
+    configuration_.joint_max_accelerations = { 40.0, 40.0, 40.0, 40.0, 40.0, 40.0 };
+    configuration_.default_joint_speed = 1.0471975511965976;
+    configuration_.default_joint_acceleration = 1.3962634015954636;
+    configuration_.default_tool_speed = 0.25;
+    configuration_.default_tool_acceleration = 1.2;
+    configuration_.eq_radius = 0.1;
+    configuration_.dh_a = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+    configuration_.dh_d = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+    configuration_.dh_alpha = { 1.570796327, 0.0, 0.0, 1.570796327, -1.570796327, 0.0 };
+    configuration_.dh_theta = { 1e-17, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    configuration_.masterboard_version = 3;
+    configuration_.controller_box_type = 11;
+    configuration_.robot_type = 7;
+    configuration_.robot_sub_type = 0;
+  }
+
+  void TearDown()
+  {
+    std::remove(cache_.getPath(serial_).c_str());
+  }
+
+  RobotConfigurationCache cache_{ "." };
+  std::string serial_;
+  RobotConfiguration configuration_;
+};
+
+TEST_F(RobotConfigurationCacheTest, stored_configuration_is_loaded_unchanged)
+{
+  ASSERT_TRUE(cache_.store(serial_, configuration_));
+
+  RobotConfiguration loaded;
+  ASSERT_TRUE(cache_.load(serial_, loaded));
+  EXPECT_EQ(loaded, configuration_);
+}
+
+TEST_F(RobotConfigurationCacheTest, storing_replaces_the_previous_configuration)
+{
+  ASSERT_TRUE(cache_.store(serial_, configuration_));
+  configuration_.version = VersionInformation::fromString("5.16.0.0");
+  configuration_.project_name = "";
+  ASSERT_TRUE(cache_.store(serial_, configuration_));
+
+  RobotConfiguration loaded;
+  ASSERT_TRUE(cache_.load(serial_, loaded));
+  EXPECT_EQ(loaded, configuration_);
+}
+
+TEST_F(RobotConfigurationCacheTest, missing_configuration_is_not_loaded)
+{
+  RobotConfiguration loaded;
+  EXPECT_FALSE(cache_.load(serial_, loaded));
+}
+
+TEST_F(RobotConfigurationCacheTest, truncated_configuration_is_rejected)
+{
+  ASSERT_TRUE(cache_.store(serial_, configuration_));
+  std::string content;
+  {
+    std::ifstream in(cache_.getPath(serial_));
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(cache_.getPath(serial_), std::ios::trunc);
+    out << content.substr(0, content.size() / 2);
+  }
+
+  RobotConfiguration loaded;
+  loaded.robot_type = 42;
+  EXPECT_FALSE(cache_.load(serial_, loaded));
+  EXPECT_EQ(loaded.robot_type, 42);
+}
+
+TEST_F(RobotConfigurationCacheTest, serial_numbers_are_restricted_to_file_name_characters)
+{
+  EXPECT_THROW(cache_.getPath(""), UrException);
+  EXPECT_THROW(cache_.getPath("../secret"), UrException);
+  EXPECT_THROW(cache_.store("a b", configuration_), UrException);
+  EXPECT_EQ(RobotConfigurationCache("cache").getPath("2023-55_00"), "cache/2023-55_00.conf");
+}
+
+TEST(RobotConfigurationTest, joint_limits_are_checked_inclusively)
+{
+  RobotConfiguration configuration;
+  configuration.joint_min_limits = { -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+  configuration.joint_max_limits = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+  EXPECT_TRUE(configuration.isWithinJointLimits({ -1.0, 1.0, 0.0, 0.0, 0.0, 0.0 }));
+  EXPECT_FALSE(configuration.isWithinJointLimits({ 0.0, 0.0, 0.0, 0.0, 0.0, -1.01 }));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/log.h"
+#include "ur_client_library/primary/primary_parser.h"
+#include "ur_client_library/primary/robot_message_events.h"
+
+using namespace urcl;
+using namespace urcl::primary_interface;
+
+template <typename T>
+static void append(std::vector<uint8_t>& buffer, const T value)
+{
+  for (size_t i = 0; i < sizeof(T); ++i)
+  {
+    buffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * (sizeof(T) - 1 - i))));
+  }
+}
+
+static std::vector<uint8_t> errorCodePayload(const int32_t code, const std::string& text)
+{
+  std::vector<uint8_t> payload;
+  append<int32_t>(payload, code);
+  append<int32_t>(payload, 0);
+  append<int32_t>(payload, static_cast<int32_t>(ReportLevel::VIOLATION));
+  append<uint8_t>(payload, 0);
+  append<uint32_t>(payload, 0);
+  payload.insert(payload.end(), text.begin(), text.end());
+  return payload;
+}
+
+static RobotMessageEvent errorCodeEvent(const int32_t code, const std::string& text)
+{
+  std::vector<uint8_t> payload = errorCodePayload(code, text);
+  comm::BinParser bp(payload.data(), payload.size());
+  RobotMessageEvent event;
+  EXPECT_TRUE(decodeRobotMessageEvent(RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE, 42, 1, bp, event));
+  return event;
+}
+
+class CountingLogHandler : public LogHandler
+{
+public:
+  explicit CountingLogHandler(std::vector<std::string>& messages) : messages_(messages)
+  {
+  }
+
+  void log(const char* /*file*/, int /*line*/, LogLevel /*loglevel*/, const char* log) override
+  {
+    messages_.push_back(log);
+  }
+
+private:
+  std::vector<std::string>& messages_;
+};
+
+TEST(robot_message_events, decode_error_code)
+{
+  RobotMessageEvent event = errorCodeEvent(209, "Protective stop");
+  EXPECT_EQ(event.type, RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE);
+  EXPECT_EQ(event.timestamp, 42u);
+  EXPECT_EQ(event.code, 209);
+  EXPECT_EQ(event.report_level, ReportLevel::VIOLATION);
+  EXPECT_EQ(event.getText(), "Protective stop");
+  EXPECT_FALSE(event.text_truncated);
+
+  const std::string long_text(RobotMessageEvent::TEXT_CAPACITY + 10, 'x');
+  event = errorCodeEvent(209, long_text);
+  EXPECT_EQ(event.getText(), long_text.substr(0, RobotMessageEvent::TEXT_CAPACITY));
+  EXPECT_TRUE(event.text_truncated);
+
+  std::vector<uint8_t> too_short(6, 0);
+  comm::BinParser bp(too_short.data(), too_short.size());
+  EXPECT_FALSE(decodeRobotMessageEvent(RobotMessagePackageType::ROBOT_MESSAGE_ERROR_CODE, 0, 0, bp, event));
+}
+
+TEST(robot_message_events, ring_collapses_repetitions_and_drops_oldest)
+{
+  RobotMessageEventRing ring(2);
+  EXPECT_TRUE(ring.push(errorCodeEvent(209, "Protective stop")));
+  EXPECT_TRUE(ring.push(errorCodeEvent(209, "Protective stop")));
+  EXPECT_TRUE(ring.push(errorCodeEvent(209, "Protective stop")));
+  EXPECT_EQ(ring.size(), 1u);
+
+  EXPECT_TRUE(ring.push(errorCodeEvent(210, "Other")));
+  EXPECT_FALSE(ring.push(errorCodeEvent(211, "Third")));
+  EXPECT_EQ(ring.size(), 2u);
+  EXPECT_EQ(ring.getDroppedCount(), 1u);
+
+  RobotMessageEvent event;
+  ASSERT_TRUE(ring.pop(event));
+  EXPECT_EQ(event.code, 210);
+  ASSERT_TRUE(ring.pop(event));
+  EXPECT_EQ(event.code, 211);
+  EXPECT_FALSE(ring.pop(event));
+
+  // Once the event was taken, a repetition is queued again
+  ring.push(errorCodeEvent(211, "Third"));
+  ring.push(errorCodeEvent(211, "Third"));
+  ASSERT_TRUE(ring.pop(event));
+  EXPECT_EQ(event.repeat_count, 2u);
+
+  EXPECT_THROW(RobotMessageEventRing(0), UrException);
+}
+
+TEST(robot_message_events, logger_limits_messages_per_interval)
+{
+  std::vector<std::string> messages;
+  registerLogHandler(std::make_unique<CountingLogHandler>(messages));
+
+  RobotMessageEventRing ring(16);
+  for (int32_t code = 0; code < 5; ++code)
+  {
+    ring.push(errorCodeEvent(code, "Fault"));
+  }
+  RobotMessageLogger logger(2, std::chrono::hours(1));
+  EXPECT_EQ(logger.drain(ring), 5u);
+  EXPECT_EQ(messages.size(), 2u);
+  EXPECT_EQ(logger.getSuppressedCount(), 3u);
+  EXPECT_EQ(messages[0], "Robot error C0A0: Fault");
+
+  unregisterLogHandler();
+}
+
+TEST(robot_message_events, parser_queues_events_instead_of_packages)
+{
+  std::vector<uint8_t> package;
+  append<int32_t>(package, 0);
+  append<int8_t>(package, static_cast<int8_t>(RobotPackageType::ROBOT_MESSAGE));
+  append<uint64_t>(package, 1000);
+  append<int8_t>(package, -2);
+  append<uint8_t>(package, static_cast<uint8_t>(RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION));
+  append<int32_t>(package, 12);
+  append<int32_t>(package, 4);
+  const std::string text = "compile_error_name_not_found:foo:";
+  package.insert(package.end(), text.begin(), text.end());
+  const uint32_t size = static_cast<uint32_t>(package.size());
+  for (size_t i = 0; i < 4; ++i)
+  {
+    package[i] = static_cast<uint8_t>(size >> (8 * (3 - i)));
+  }
+
+  RobotMessageEventRing ring;
+  PrimaryParser parser;
+  parser.setRobotMessageEventRing(&ring);
+  std::vector<std::unique_ptr<PrimaryPackage>> products;
+  comm::BinParser bp(package.data(), package.size());
+  EXPECT_TRUE(parser.parse(bp, products));
+  EXPECT_TRUE(products.empty());
+
+  RobotMessageEvent event;
+  ASSERT_TRUE(ring.pop(event));
+  EXPECT_EQ(event.type, RobotMessagePackageType::ROBOT_MESSAGE_RUNTIME_EXCEPTION);
+  EXPECT_EQ(event.line_number, 12);
+  EXPECT_EQ(event.column_number, 4);
+  EXPECT_EQ(event.getText(), text);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
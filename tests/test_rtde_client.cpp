@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <algorithm>
 #include <cmath>
 #include <optional>
@@ -412,6 +413,113 @@ TEST_F(RTDEClientTest, check_unknown_rtde_output_variable)
   EXPECT_THROW(client_->init(), UrException);
 }
 
+TEST_F(RTDEClientTest, reconnect_using_handshake_cache)
+{
+  rtde_interface::RTDEClient::clearHandshakeCache();
+  ASSERT_TRUE(client_->init());
+  const std::vector<std::string> output_recipe = client_->getOutputRecipe();
+  const VersionInformation version = client_->getVersion();
+  const double target_frequency = client_->getTargetFrequency();
+
+  // The second handshake with the same robot and recipes is based on the cached result
+  client_.reset(new rtde_interface::RTDEClient(g_ROBOT_IP, notifier_, output_recipe_file_, input_recipe_file_));
+  ASSERT_TRUE(client_->init());
+  EXPECT_EQ(output_recipe, client_->getOutputRecipe());
+  EXPECT_EQ(version, client_->getVersion());
+  EXPECT_EQ(target_frequency, client_->getTargetFrequency());
+
+  EXPECT_TRUE(client_->start());
+  std::unique_ptr<rtde_interface::DataPackage> data_pkg = client_->getDataPackage(std::chrono::milliseconds(100));
+  EXPECT_NE(nullptr, data_pkg);
+}
+
+TEST_F(RTDEClientTest, switch_output_recipe)
+{
+  ASSERT_TRUE(client_->init());
+  ASSERT_TRUE(client_->start());
+
+  const std::vector<std::string> new_recipe = { "timestamp", "actual_q", "target_q" };
+  ASSERT_TRUE(client_->switchOutputRecipe(new_recipe));
+  EXPECT_EQ(new_recipe, client_->getOutputRecipe());
+
+  std::unique_ptr<rtde_interface::DataPackage> data_pkg = client_->getDataPackage(std::chrono::milliseconds(100));
+  ASSERT_NE(nullptr, data_pkg);
+  vector6d_t target_q;
+  EXPECT_TRUE(data_pkg->getData("target_q", target_q));
+
+  // Unknown variables are rejected and the previous recipe is kept
+  EXPECT_THROW(client_->switchOutputRecipe({ "timestamp", "unknown_rtde_variable" }), UrException);
+  EXPECT_EQ(new_recipe, client_->getOutputRecipe());
+}
+
+TEST_F(RTDEClientTest, switch_output_recipe_keeps_shared_state_readable)
+{
+  const std::string name = "/urcl_rtde_client_test_" + std::to_string(::getpid());
+  client_->setSharedStatePublishing(name);
+  ASSERT_TRUE(client_->init());
+  ASSERT_TRUE(client_->start());
+
+  // The old publisher is still referenced while the recipe is switched
+  std::shared_ptr<rtde_interface::SharedStatePublisher> old_publisher = client_->getSharedStatePublisher();
+  const std::vector<std::string> new_recipe = { "timestamp", "actual_q", "target_q" };
+  ASSERT_TRUE(client_->switchOutputRecipe(new_recipe));
+  old_publisher.reset();
+
+  rtde_interface::SharedStateReader reader(name);
+  EXPECT_TRUE(reader.isActive());
+  EXPECT_EQ(new_recipe, reader.getCompiledRecipe()->getRecipe());
+}
+
+TEST_F(RTDEClientTest, minimize_output_recipe)
+{
+  client_->setOutputRecipeMinimization(true);
+  client_->requireOutputFields({ "robot_mode", "actual_q", "target_q" });
+  client_->addFieldChangeCallback<double>("speed_scaling", [](const double&) {});
+  ASSERT_TRUE(client_->init());
+
+  // Fields of the configured recipe keep their order, others are appended
+  const std::vector<std::string> expected_recipe = { "timestamp", "actual_q", "speed_scaling", "robot_mode",
+                                                     "target_q" };
+  EXPECT_EQ(expected_recipe, client_->getOutputRecipe());
+  EXPECT_THROW(client_->requireOutputFields({ "actual_qd" }), UrException);
+
+  ASSERT_TRUE(client_->start());
+  std::unique_ptr<rtde_interface::DataPackage> data_pkg = client_->getDataPackage(std::chrono::milliseconds(100));
+  ASSERT_NE(nullptr, data_pkg);
+  vector6d_t target_q;
+  EXPECT_TRUE(data_pkg->getData("target_q", target_q));
+  vector6d_t actual_qd;
+  EXPECT_FALSE(data_pkg->getData("actual_qd", actual_qd));
+}
+
+TEST_F(RTDEClientTest, set_output_frequency)
+{
+  ASSERT_TRUE(client_->init());
+  ASSERT_TRUE(client_->start());
+  std::unique_ptr<rtde_interface::DataPackage> data_pkg = client_->getDataPackage(std::chrono::milliseconds(100));
+  ASSERT_NE(nullptr, data_pkg);
+  const auto recipe = data_pkg->getCompiledRecipe();
+
+  ASSERT_TRUE(client_->setOutputFrequency(10));
+  EXPECT_EQ(client_->getTargetFrequency(), 10);
+
+  // Packages keep their recipe and arrive with the new frequency
+  data_pkg = client_->getDataPackage(std::chrono::milliseconds(1000));
+  ASSERT_NE(nullptr, data_pkg);
+  EXPECT_EQ(data_pkg->getCompiledRecipe(), recipe);
+  double first_timestamp = 0.0;
+  data_pkg->getData("timestamp", first_timestamp);
+  data_pkg = client_->getDataPackage(std::chrono::milliseconds(1000));
+  ASSERT_NE(nullptr, data_pkg);
+  double second_timestamp = 0.0;
+  data_pkg->getData("timestamp", second_timestamp);
+  EXPECT_NEAR(second_timestamp - first_timestamp, 0.1, 0.01);
+
+  EXPECT_THROW(client_->setOutputFrequency(client_->getMaxFrequency() + 1), UrException);
+  EXPECT_THROW(client_->setOutputFrequency(0), UrException);
+  EXPECT_EQ(client_->getTargetFrequency(), 10);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
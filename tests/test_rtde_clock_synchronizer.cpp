@@ -0,0 +1,131 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/clock_synchronizer.h"
+
+using namespace urcl;
+
+class ClockSynchronizerTest : public ::testing::Test
+{
+protected:
+  // Host time a package sent at the given robot time arrives at, delayed by the given latency
+  std::chrono::steady_clock::time_point hostTime(const double robot_time, const double latency) const
+  {
+    const std::chrono::duration<double> host(OFFSET + robot_time * (1.0 + DRIFT) + latency);
+    return start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(host);
+  }
+
+  static constexpr double OFFSET = 3.0;
+  static constexpr double DRIFT = 50e-6;
+  std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+};
+
+TEST_F(ClockSynchronizerTest, not_synchronized_without_samples)
+{
+  rtde_interface::ClockSynchronizer synchronizer;
+  EXPECT_FALSE(synchronizer.isSynchronized());
+  EXPECT_EQ(synchronizer.toHostTime(1.0), std::chrono::steady_clock::time_point());
+  EXPECT_THROW(rtde_interface::ClockSynchronizer(std::chrono::milliseconds(0)), UrException);
+  EXPECT_THROW(rtde_interface::ClockSynchronizer(std::chrono::milliseconds(100), 0), UrException);
+}
+
+TEST_F(ClockSynchronizerTest, estimate_offset_and_drift_despite_jitter)
+{
+  rtde_interface::ClockSynchronizer synchronizer;
+  std::mt19937 generator(42);
+  // Mostly short latencies with occasional long delays
+  std::exponential_distribution<double> latency(1.0 / 0.0005);
+  const double robot_start = 1000.0;
+  for (int i = 0; i < 500 * 10; ++i)
+  {
+    const double robot_time = robot_start + i * 0.002;
+    synchronizer.update(robot_time, hostTime(robot_time, 0.0002 + latency(generator)));
+  }
+  ASSERT_TRUE(synchronizer.isSynchronized());
+  EXPECT_EQ(synchronizer.getNumSamples(), 5000u);
+  EXPECT_NEAR(synchronizer.getDriftPpm(), DRIFT * 1e6, 5.0);
+
+  // The minimum latency is part of the offset, as it can't be distinguished from it
+  const double robot_time = robot_start + 10.0;
+  const auto expected = hostTime(robot_time, 0.0002);
+  const auto error = synchronizer.toHostTime(robot_time) - expected;
+  EXPECT_LT(std::abs(std::chrono::duration<double>(error).count()), 0.0001);
+  EXPECT_NEAR(synchronizer.toRobotTime(expected), robot_time, 0.0001);
+
+  // System time mappings go through the steady clock
+  const auto system_time = synchronizer.toSystemTime(robot_time);
+  EXPECT_NEAR(synchronizer.toRobotTime(system_time), robot_time, 0.001);
+}
+
+TEST_F(ClockSynchronizerTest, reset_on_robot_restart)
+{
+  rtde_interface::ClockSynchronizer synchronizer;
+  for (int i = 0; i < 100; ++i)
+  {
+    synchronizer.update(500.0 + i * 0.002, hostTime(500.0 + i * 0.002, 0.0001));
+  }
+  // The controller restarted, its clock starts from 0 again at a different host time
+  synchronizer.update(0.0, hostTime(600.0, 0.0001));
+  EXPECT_EQ(synchronizer.getNumSamples(), 1u);
+  const auto error = synchronizer.toHostTime(0.0) - hostTime(600.0, 0.0001);
+  EXPECT_LT(std::abs(std::chrono::duration<double>(error).count()), 1e-6);
+
+  synchronizer.reset();
+  EXPECT_FALSE(synchronizer.isSynchronized());
+}
+
+TEST_F(ClockSynchronizerTest, update_from_data_package)
+{
+  auto recipe = std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp" });
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  rtde_interface::ClockSynchronizer synchronizer;
+  synchronizer.setRecipe(*recipe);
+
+  double robot_time = 10.0;
+  package.setData("timestamp", robot_time);
+  package.getTimestamps().receive = hostTime(robot_time, 0.001);
+  synchronizer.update(package);
+  EXPECT_EQ(synchronizer.toHostTime(robot_time), package.getTimestamps().receive);
+
+  // Kernel timestamps are preferred
+  robot_time = 10.002;
+  package.setData("timestamp", robot_time);
+  package.getTimestamps().kernel = hostTime(robot_time, 0.0);
+  package.getTimestamps().receive = hostTime(robot_time, 0.001);
+  synchronizer.update(package);
+  const auto error = synchronizer.toHostTime(robot_time) - package.getTimestamps().kernel;
+  EXPECT_LT(std::abs(std::chrono::duration<double>(error).count()), 1e-6);
+}
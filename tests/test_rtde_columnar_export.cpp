@@ -0,0 +1,172 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include "ur_client_library/rtde/columnar_export.h"
+
+using namespace urcl;
+
+class ColumnarExportTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recording_path_ = "columnar_export_test_" + std::to_string(::getpid()) + ".bin";
+    path_ = "columnar_export_test_" + std::to_string(::getpid()) + ".col";
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "actual_q", "robot_mode", "unknown_field" });
+  }
+
+  void TearDown()
+  {
+    std::remove(recording_path_.c_str());
+    std::remove(path_.c_str());
+  }
+
+  rtde_interface::DataPackage createSample(const size_t i)
+  {
+    rtde_interface::DataPackage package(recipe_, 2);
+    package.initEmpty();
+    double timestamp = static_cast<double>(i);
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { timestamp, 0, 0, 0, 0, -timestamp };
+    package.setData("actual_q", actual_q);
+    int32_t robot_mode = static_cast<int32_t>(i) - 1;
+    package.setData("robot_mode", robot_mode);
+    package.setRecipeID(1);
+    return package;
+  }
+
+  std::chrono::system_clock::time_point getReceiveTime(const size_t i)
+  {
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(2 * i));
+  }
+
+  void expectSamples(const rtde_interface::ColumnarFile& file, const size_t num_samples)
+  {
+    ASSERT_EQ(num_samples, file.getNumRows());
+    std::vector<double> timestamps;
+    std::vector<vector6d_t> actual_q;
+    std::vector<int32_t> robot_modes;
+    ASSERT_TRUE(file.getColumn("timestamp", timestamps));
+    ASSERT_TRUE(file.getColumn("actual_q", actual_q));
+    ASSERT_TRUE(file.getColumn("robot_mode", robot_modes));
+    ASSERT_EQ(num_samples, timestamps.size());
+    ASSERT_EQ(num_samples, actual_q.size());
+    ASSERT_EQ(num_samples, robot_modes.size());
+    for (size_t i = 0; i < num_samples; ++i)
+    {
+      EXPECT_EQ(getReceiveTime(i), file.getReceiveTimes()[i]);
+      EXPECT_EQ(static_cast<double>(i), timestamps[i]);
+      EXPECT_EQ(static_cast<double>(i), actual_q[i][0]);
+      EXPECT_EQ(-static_cast<double>(i), actual_q[i][5]);
+      EXPECT_EQ(static_cast<int32_t>(i) - 1, robot_modes[i]);
+    }
+  }
+
+  std::string recording_path_;
+  std::string path_;
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+};
+
+TEST_F(ColumnarExportTest, export_recording)
+{
+  {
+    rtde_interface::RTDERecorder recorder(recording_path_);
+    recorder.open(recipe_->getRecipe(), 2);
+    uint8_t buffer[4096];
+    for (size_t i = 0; i < 10; ++i)
+    {
+      const size_t size = createSample(i).serializePackage(buffer);
+      ASSERT_TRUE(recorder.record(buffer, size, getReceiveTime(i)));
+    }
+    // Text message, which should be skipped
+    uint8_t text_message[] = { 0x00, 0x07, 0x4d, 0x02, 'a', 'b', 'c' };
+    ASSERT_TRUE(recorder.record(text_message, sizeof(text_message)));
+  }
+
+  rtde_interface::RTDERecording recording(recording_path_);
+  EXPECT_EQ(10u, rtde_interface::exportColumnar(recording, path_, 3));
+
+  rtde_interface::ColumnarFile file(path_);
+  EXPECT_EQ(recipe_->getRecipe(), file.getCompiledRecipe()->getRecipe());
+  EXPECT_EQ(4u, file.getNumChunks());
+  expectSamples(file, 10);
+}
+
+TEST_F(ColumnarExportTest, append_data_packages)
+{
+  {
+    rtde_interface::ColumnarWriter writer(path_, recipe_);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      ASSERT_TRUE(writer.append(createSample(i), getReceiveTime(i)));
+    }
+    rtde_interface::DataPackage other_package(std::vector<std::string>{ "timestamp" });
+    other_package.initEmpty();
+    EXPECT_FALSE(writer.append(other_package, getReceiveTime(5)));
+    EXPECT_EQ(5u, writer.getNumRows());
+  }
+
+  rtde_interface::ColumnarFile file(path_);
+  EXPECT_EQ(1u, file.getNumChunks());
+  expectSamples(file, 5);
+}
+
+TEST_F(ColumnarExportTest, get_column_checks_type)
+{
+  {
+    rtde_interface::ColumnarWriter writer(path_, recipe_);
+    writer.append(createSample(0), getReceiveTime(0));
+  }
+
+  rtde_interface::ColumnarFile file(path_);
+  std::vector<int32_t> wrong_type;
+  EXPECT_FALSE(file.getColumn("timestamp", wrong_type));
+  std::vector<double> values;
+  EXPECT_FALSE(file.getColumn("target_q", values));
+  EXPECT_FALSE(file.getColumn("unknown_field", values));
+}
+
+TEST_F(ColumnarExportTest, invalid_file_throws)
+{
+  EXPECT_THROW(rtde_interface::ColumnarFile file(path_), UrException);
+  EXPECT_THROW(rtde_interface::ColumnarWriter writer(path_, recipe_, 0), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
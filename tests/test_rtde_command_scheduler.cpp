@@ -0,0 +1,206 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/control/rtde_command_scheduler.h"
+#include "ur_client_library/exceptions.h"
+
+using namespace urcl;
+
+class RTDECommandSchedulerTest : public ::testing::Test
+{
+protected:
+  class Client : public comm::TCPSocket
+  {
+  public:
+    explicit Client(const int port)
+    {
+      std::string host = "127.0.0.1";
+      TCPSocket::setup(host, port);
+      timeval tv;
+      tv.tv_sec = 1;
+      tv.tv_usec = 0;
+      TCPSocket::setReceiveTimeout(tv);
+    }
+
+    bool readMessage(int32_t& read_timeout, vector6int32_t& pos, int32_t& control_mode)
+    {
+      int32_t buf[8];
+      uint8_t* b_pos = reinterpret_cast<uint8_t*>(buf);
+      size_t read = 0;
+      size_t remainder = sizeof(buf);
+      while (remainder > 0)
+      {
+        if (!TCPSocket::read(b_pos, remainder, read))
+        {
+          return false;
+        }
+        b_pos += read;
+        remainder -= read;
+      }
+      read_timeout = be32toh(buf[0]);
+      for (size_t i = 0; i < pos.size(); ++i)
+      {
+        pos[i] = be32toh(buf[i + 1]);
+      }
+      control_mode = be32toh(buf[7]);
+      return true;
+    }
+  };
+
+  void SetUp()
+  {
+    reverse_interface_.reset(new control::ReverseInterface(50005, [this](bool connected) {
+      std::lock_guard<std::mutex> lk(connected_mutex_);
+      connected_ = connected;
+      connected_cv_.notify_all();
+    }));
+    client_.reset(new Client(50005));
+    std::unique_lock<std::mutex> lk(connected_mutex_);
+    ASSERT_TRUE(connected_cv_.wait_for(lk, std::chrono::seconds(1), [this]() { return connected_; }));
+  }
+
+  void TearDown()
+  {
+    client_->close();
+    std::unique_lock<std::mutex> lk(connected_mutex_);
+    connected_cv_.wait_for(lk, std::chrono::seconds(1), [this]() { return !connected_; });
+  }
+
+  std::unique_ptr<control::ReverseInterface> reverse_interface_;
+  std::unique_ptr<Client> client_;
+  rtde_interface::DataPackage package_{ std::vector<std::string>{ "actual_q" } };
+
+private:
+  bool connected_ = false;
+  std::mutex connected_mutex_;
+  std::condition_variable connected_cv_;
+};
+
+TEST_F(RTDECommandSchedulerTest, reject_non_realtime_control_mode)
+{
+  EXPECT_THROW(control::RTDECommandScheduler(*reverse_interface_, comm::ControlMode::MODE_FORWARD), UrException);
+  control::RTDECommandScheduler scheduler(*reverse_interface_, comm::ControlMode::MODE_SERVOJ);
+  EXPECT_THROW(scheduler.setControlMode(comm::ControlMode::MODE_IDLE, RobotReceiveTimeout::millisec(20)),
+               UrException);
+}
+
+TEST_F(RTDECommandSchedulerTest, write_latest_command_per_package)
+{
+  control::RTDECommandScheduler scheduler(*reverse_interface_, comm::ControlMode::MODE_SPEEDJ,
+                                          RobotReceiveTimeout::millisec(100));
+  const vector6d_t command = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 };
+  scheduler.setCommand(command);
+
+  // Inactive schedulers don't write anything
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(scheduler.getNumWrites(), 0u);
+
+  scheduler.setActive(true);
+  EXPECT_TRUE(scheduler.isActive());
+  scheduler.onDataPackage(package_);
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(scheduler.getNumWrites(), 2u);
+  for (int i = 0; i < 2; ++i)
+  {
+    int32_t read_timeout, control_mode;
+    vector6int32_t pos;
+    ASSERT_TRUE(client_->readMessage(read_timeout, pos, control_mode));
+    EXPECT_EQ(read_timeout, 100);
+    EXPECT_EQ(control_mode, toUnderlying(comm::ControlMode::MODE_SPEEDJ));
+    EXPECT_EQ(pos[5], static_cast<int32_t>(std::round(0.6 * control::ReverseInterface::MULT_JOINTSTATE)));
+  }
+
+  // Without a command, nothing is written
+  scheduler.clearCommand();
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(scheduler.getNumWrites(), 2u);
+}
+
+TEST_F(RTDECommandSchedulerTest, compute_command_from_package)
+{
+  control::RTDECommandScheduler scheduler(*reverse_interface_, comm::ControlMode::MODE_SERVOJ);
+  const auto handle = package_.getCompiledRecipe()->getFieldHandle<vector6d_t>("actual_q");
+  size_t calls = 0;
+  scheduler.setCommandCallback([&](const rtde_interface::DataPackage& package, vector6d_t& command) {
+    ++calls;
+    if (!package.getData(handle, command))
+    {
+      return false;
+    }
+    command[0] += 0.5;
+    // Skip every second cycle
+    return calls % 2 == 1;
+  });
+  scheduler.setActive(true);
+
+  package_.initEmpty();
+  vector6d_t actual_q = { 1.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  ASSERT_TRUE(package_.setData(handle, actual_q));
+  scheduler.onDataPackage(package_);
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(calls, 2u);
+  EXPECT_EQ(scheduler.getNumWrites(), 1u);
+
+  int32_t read_timeout, control_mode;
+  vector6int32_t pos;
+  ASSERT_TRUE(client_->readMessage(read_timeout, pos, control_mode));
+  EXPECT_EQ(control_mode, toUnderlying(comm::ControlMode::MODE_SERVOJ));
+  EXPECT_EQ(pos[0], static_cast<int32_t>(std::round(1.5 * control::ReverseInterface::MULT_JOINTSTATE)));
+
+  scheduler.setActive(false);
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(calls, 2u);
+}
+
+TEST_F(RTDECommandSchedulerTest, count_failed_writes)
+{
+  control::RTDECommandScheduler scheduler(*reverse_interface_, comm::ControlMode::MODE_SERVOJ);
+  scheduler.setCommand({ 0, 0, 0, 0, 0, 0 });
+  scheduler.setActive(true);
+  TearDown();
+
+  scheduler.onDataPackage(package_);
+  EXPECT_EQ(scheduler.getNumWrites(), 0u);
+  EXPECT_EQ(scheduler.getNumFailedWrites(), 1u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -160,6 +160,231 @@ TEST(rtde_data_package, parse_and_get_bitset_data)
   EXPECT_EQ(expected_robot_status_bits, actual_robot_status_bits);
 }
 
+TEST(rtde_data_package, compiled_recipe_layout)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q", "speed_scaling", "robot_status_bits" };
+  rtde_interface::CompiledRecipe compiled_recipe(recipe);
+
+  EXPECT_TRUE(compiled_recipe.isComplete());
+  ASSERT_EQ(compiled_recipe.getFields().size(), recipe.size());
+  EXPECT_EQ(compiled_recipe.getFields()[0].offset, 0);
+  EXPECT_EQ(compiled_recipe.getFields()[1].offset, 8);
+  EXPECT_EQ(compiled_recipe.getFields()[2].offset, 56);
+  EXPECT_EQ(compiled_recipe.getFields()[3].offset, 64);
+  EXPECT_EQ(compiled_recipe.getDataSize(), 68);
+
+  rtde_interface::CompiledRecipe incomplete_recipe({ "timestamp", "not_a_field" });
+  EXPECT_FALSE(incomplete_recipe.isComplete());
+  size_t index;
+  EXPECT_FALSE(incomplete_recipe.findIndex("not_a_field", index));
+}
+
+TEST(rtde_data_package, get_data_with_field_handle)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  auto compiled_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe);
+  rtde_interface::DataPackage package(compiled_recipe);
+  package.initEmpty();
+
+  uint8_t data_package[] = { 0x01, 0x40, 0xd0, 0x75, 0x8c, 0x49, 0xba, 0x5e, 0x35, 0xbf, 0xf9, 0x9c, 0x77, 0xd1, 0x10,
+                             0xb4, 0x60, 0xbf, 0xfb, 0xa2, 0x33, 0xd1, 0x10, 0xb4, 0x60, 0xc0, 0x01, 0x9f, 0xbe, 0x68,
+                             0x88, 0x5a, 0x30, 0xbf, 0xe9, 0xdb, 0x22, 0xa2, 0x21, 0x68, 0xc0, 0x3f, 0xf9, 0x85, 0x87,
+                             0xa0, 0x00, 0x00, 0x00, 0xbf, 0x9f, 0xbe, 0x74, 0x44, 0x2d, 0x18, 0x00 };
+  comm::BinParser bp(data_package, sizeof(data_package));
+  EXPECT_TRUE(package.parseWith(bp));
+
+  rtde_interface::FieldHandle<vector6d_t> actual_q_handle = compiled_recipe->getFieldHandle<vector6d_t>("actual_q");
+  rtde_interface::FieldHandle<double> timestamp_handle = compiled_recipe->getFieldHandle<double>("timestamp");
+  EXPECT_TRUE(actual_q_handle.isValid());
+
+  vector6d_t expected_q = { -1.6007, -1.7271, -2.203, -0.808, 1.5951, -0.031 };
+  vector6d_t actual_q;
+  EXPECT_TRUE(package.getData(actual_q_handle, actual_q));
+  double abs = 1e-4;
+  for (size_t i = 0; i < actual_q.size(); ++i)
+  {
+    EXPECT_NEAR(expected_q[i], actual_q[i], abs);
+  }
+
+  double actual_timestamp;
+  EXPECT_TRUE(package.getData(timestamp_handle, actual_timestamp));
+  EXPECT_NEAR(16854.1919, actual_timestamp, abs);
+
+  EXPECT_THROW(compiled_recipe->getFieldHandle<double>("actual_q"), UrException);
+  EXPECT_THROW(compiled_recipe->getFieldHandle<double>("speed_scaling"), UrException);
+  EXPECT_FALSE(rtde_interface::FieldHandle<double>().isValid());
+  EXPECT_FALSE(package.getData(rtde_interface::FieldHandle<double>(), actual_timestamp));
+}
+
+TEST(rtde_data_package, set_data_with_field_handle)
+{
+  std::vector<std::string> recipe{ "speed_slider_mask" };
+  auto compiled_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe);
+  rtde_interface::DataPackage package(compiled_recipe);
+  package.initEmpty();
+
+  EXPECT_TRUE(package.setData(compiled_recipe->getFieldHandle<uint32_t>("speed_slider_mask"), 1u));
+
+  uint8_t buffer[4096];
+  package.setRecipeID(1);
+  size_t size = package.serializePackage(buffer);
+
+  EXPECT_EQ(size, 8);
+  uint8_t expected[] = { 0x0, 0x08, 0x55, 0x01, 0x00, 0x00, 0x00, 0x01 };
+  for (size_t i = 0; i < size; ++i)
+  {
+    EXPECT_EQ(buffer[i], expected[i]);
+  }
+}
+
+TEST(rtde_data_package, parse_pkg_lazy_decoding)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  auto compiled_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe);
+  rtde_interface::DataPackage package(compiled_recipe, 2, true);
+  package.initEmpty();
+
+  uint8_t data_package[] = { 0x01, 0x40, 0xd0, 0x75, 0x8c, 0x49, 0xba, 0x5e, 0x35, 0xbf, 0xf9, 0x9c, 0x77, 0xd1, 0x10,
+                             0xb4, 0x60, 0xbf, 0xfb, 0xa2, 0x33, 0xd1, 0x10, 0xb4, 0x60, 0xc0, 0x01, 0x9f, 0xbe, 0x68,
+                             0x88, 0x5a, 0x30, 0xbf, 0xe9, 0xdb, 0x22, 0xa2, 0x21, 0x68, 0xc0, 0x3f, 0xf9, 0x85, 0x87,
+                             0xa0, 0x00, 0x00, 0x00, 0xbf, 0x9f, 0xbe, 0x74, 0x44, 0x2d, 0x18, 0x00 };
+  comm::BinParser bp(data_package, sizeof(data_package));
+  EXPECT_TRUE(package.parseWith(bp));
+  EXPECT_TRUE(bp.empty());
+
+  // A copy contains the same serialized data
+  rtde_interface::DataPackage copy(package);
+
+  vector6d_t expected_q = { -1.6007, -1.7271, -2.203, -0.808, 1.5951, -0.031 };
+  vector6d_t actual_q;
+  EXPECT_TRUE(copy.getData("actual_q", actual_q));
+  double abs = 1e-4;
+  for (size_t i = 0; i < actual_q.size(); ++i)
+  {
+    EXPECT_NEAR(expected_q[i], actual_q[i], abs);
+  }
+
+  double actual_timestamp;
+  EXPECT_TRUE(copy.getData(compiled_recipe->getFieldHandle<double>("timestamp"), actual_timestamp));
+  EXPECT_NEAR(16854.1919, actual_timestamp, abs);
+
+  EXPECT_THROW(copy.getData("timestamp", actual_q), std::bad_variant_access);
+  EXPECT_NE(copy.toString().find("timestamp"), std::string::npos);
+}
+
+TEST(rtde_data_package, serialize_pkg_lazy_decoding)
+{
+  std::vector<std::string> recipe{ "speed_slider_mask", "speed_slider_fraction" };
+  auto compiled_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe);
+  rtde_interface::DataPackage eager_package(compiled_recipe);
+  rtde_interface::DataPackage lazy_package(compiled_recipe, 2, true);
+
+  uint32_t mask = 1;
+  double fraction = 0.5;
+  for (auto package : { &eager_package, &lazy_package })
+  {
+    package->initEmpty();
+    EXPECT_TRUE(package->setData("speed_slider_mask", mask));
+    EXPECT_TRUE(package->setData("speed_slider_fraction", fraction));
+    package->setRecipeID(1);
+  }
+
+  uint8_t eager_buffer[4096];
+  uint8_t lazy_buffer[4096];
+  size_t eager_size = eager_package.serializePackage(eager_buffer);
+  size_t lazy_size = lazy_package.serializePackage(lazy_buffer);
+
+  ASSERT_EQ(eager_size, 16);
+  ASSERT_EQ(lazy_size, eager_size);
+  for (size_t i = 0; i < lazy_size; ++i)
+  {
+    EXPECT_EQ(lazy_buffer[i], eager_buffer[i]);
+  }
+}
+
+TEST(rtde_data_package, lazy_decoding_unknown_field)
+{
+  std::vector<std::string> recipe{ "speed_slider_mask", "unknown_field" };
+  rtde_interface::DataPackage package(std::make_shared<const rtde_interface::CompiledRecipe>(recipe), 2, true);
+  package.initEmpty();
+
+  double value = 1.0;
+  EXPECT_FALSE(package.setData("unknown_field", value));
+  EXPECT_FALSE(package.getData("unknown_field", value));
+
+  // Unknown fields are not part of the serialized frame
+  uint8_t buffer[4096];
+  EXPECT_EQ(package.serializePackage(buffer), 8);
+}
+
+TEST(rtde_data_package, equal_recipes_are_interned)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  rtde_interface::DataPackage package(recipe);
+  rtde_interface::DataPackage other_package(recipe);
+  EXPECT_EQ(package.getCompiledRecipe(), other_package.getCompiledRecipe());
+  EXPECT_EQ(rtde_interface::CompiledRecipe::intern(recipe), package.getCompiledRecipe());
+
+  rtde_interface::DataPackage different_package(std::vector<std::string>{ "timestamp" });
+  EXPECT_NE(different_package.getCompiledRecipe(), package.getCompiledRecipe());
+}
+
+TEST(rtde_data_package, copy_and_move)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  double timestamp = 1.5;
+  package.setData("timestamp", timestamp);
+  package.setRecipeID(3);
+
+  rtde_interface::DataPackage copy(package);
+  EXPECT_EQ(copy.getCompiledRecipe(), package.getCompiledRecipe());
+  double copied_timestamp = 0.0;
+  ASSERT_TRUE(copy.getData("timestamp", copied_timestamp));
+  EXPECT_DOUBLE_EQ(copied_timestamp, 1.5);
+  EXPECT_EQ(copy.getRecipeID(), 3);
+
+  rtde_interface::DataPackage assigned(recipe);
+  assigned.initEmpty();
+  timestamp = 2.5;
+  package.setData("timestamp", timestamp);
+  assigned = package;
+  ASSERT_TRUE(assigned.getData("timestamp", copied_timestamp));
+  EXPECT_DOUBLE_EQ(copied_timestamp, 2.5);
+
+  rtde_interface::DataPackage moved(std::move(copy));
+  ASSERT_TRUE(moved.getData("timestamp", copied_timestamp));
+  EXPECT_DOUBLE_EQ(copied_timestamp, 1.5);
+  assigned = std::move(moved);
+  ASSERT_TRUE(assigned.getData("timestamp", copied_timestamp));
+  EXPECT_DOUBLE_EQ(copied_timestamp, 1.5);
+}
+
+TEST(rtde_data_package, field_types_at_compile_time)
+{
+  static_assert(rtde_interface::isKnownField("actual_q"));
+  static_assert(!rtde_interface::isKnownField("actual_qq"));
+  constexpr rtde_interface::FieldType type = []() {
+    rtde_interface::FieldType found{};
+    rtde_interface::findFieldType("robot_mode", found);
+    return found;
+  }();
+  static_assert(type == rtde_interface::FieldType::INT32);
+
+  for (const auto& entry : rtde_interface::FIELD_TYPES)
+  {
+    rtde_interface::FieldType found;
+    ASSERT_TRUE(rtde_interface::findFieldType(entry.name, found)) << entry.name;
+    EXPECT_EQ(found, entry.type) << entry.name;
+  }
+
+  rtde_interface::CompiledRecipe recipe({ "actual_TCP_pose", "speed_scaling", "output_bit_registers0_to_31" });
+  EXPECT_TRUE(std::holds_alternative<vector6d_t>(recipe.getFields()[0].empty_value));
+  EXPECT_TRUE(std::holds_alternative<double>(recipe.getFields()[1].empty_value));
+  EXPECT_TRUE(std::holds_alternative<uint32_t>(recipe.getFields()[2].empty_value));
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
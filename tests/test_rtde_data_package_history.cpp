@@ -0,0 +1,146 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/rtde/data_package_history.h"
+
+using namespace urcl;
+
+class DataPackageHistoryTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "actual_q", "robot_mode" });
+    history_.reset(new rtde_interface::DataPackageHistory(recipe_, 4));
+  }
+
+  void pushSample(const double timestamp, const bool lazy_decoding = false)
+  {
+    rtde_interface::DataPackage package(recipe_, 2, lazy_decoding);
+    package.initEmpty();
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { timestamp, 0, 0, 0, 0, -timestamp };
+    package.setData("actual_q", actual_q);
+    int32_t robot_mode = static_cast<int32_t>(timestamp * 10);
+    package.setData("robot_mode", robot_mode);
+    package.setRecipeID(1);
+    ASSERT_TRUE(history_->push(package));
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackageHistory> history_;
+};
+
+TEST_F(DataPackageHistoryTest, get_nearest)
+{
+  rtde_interface::DataPackage package(recipe_);
+  EXPECT_FALSE(history_->getNearest(1.0, package));
+
+  pushSample(1.0);
+  pushSample(1.1, true);
+  pushSample(1.2);
+  EXPECT_EQ(history_->size(), 3);
+
+  rtde_interface::DataPackageHistory::Sample sample;
+  ASSERT_TRUE(history_->getNearest(1.13, package, &sample));
+  EXPECT_DOUBLE_EQ(sample.timestamp, 1.1);
+  vector6d_t actual_q;
+  ASSERT_TRUE(package.getData("actual_q", actual_q));
+  EXPECT_DOUBLE_EQ(actual_q[0], 1.1);
+  EXPECT_DOUBLE_EQ(actual_q[5], -1.1);
+  int32_t robot_mode;
+  ASSERT_TRUE(package.getData("robot_mode", robot_mode));
+  EXPECT_EQ(robot_mode, 11);
+  EXPECT_EQ(package.getRecipeID(), 1);
+
+  ASSERT_TRUE(history_->getNearest(0.0, package, &sample));
+  EXPECT_DOUBLE_EQ(sample.timestamp, 1.0);
+  ASSERT_TRUE(history_->getNearest(5.0, package, &sample));
+  EXPECT_DOUBLE_EQ(sample.timestamp, 1.2);
+
+  // Filling a lazy package works, as well
+  rtde_interface::DataPackage lazy_package(recipe_, 2, true);
+  ASSERT_TRUE(history_->getNearest(1.0, lazy_package));
+  double timestamp;
+  ASSERT_TRUE(lazy_package.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 1.0);
+}
+
+TEST_F(DataPackageHistoryTest, oldest_samples_are_overwritten)
+{
+  for (int i = 0; i < 6; ++i)
+  {
+    pushSample(i);
+  }
+  EXPECT_EQ(history_->size(), 4);
+
+  std::vector<rtde_interface::DataPackage> packages;
+  std::vector<rtde_interface::DataPackageHistory::Sample> samples;
+  EXPECT_EQ(history_->getWindow(0.0, 10.0, packages, &samples), 4);
+  ASSERT_EQ(samples.size(), 4);
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(samples[i].timestamp, i + 2.0);
+    double timestamp;
+    ASSERT_TRUE(packages[i].getData("timestamp", timestamp));
+    EXPECT_DOUBLE_EQ(timestamp, i + 2.0);
+  }
+
+  packages.clear();
+  samples.clear();
+  EXPECT_EQ(history_->getWindow(2.5, 4.0, packages, &samples), 2);
+  ASSERT_EQ(samples.size(), 2);
+  EXPECT_DOUBLE_EQ(samples[0].timestamp, 3.0);
+  EXPECT_DOUBLE_EQ(samples[1].timestamp, 4.0);
+
+  history_->clear();
+  EXPECT_EQ(history_->size(), 0);
+}
+
+TEST_F(DataPackageHistoryTest, invalid_configuration)
+{
+  auto no_timestamp = std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "actual_q" });
+  EXPECT_THROW(rtde_interface::DataPackageHistory(no_timestamp, 4), UrException);
+  EXPECT_THROW(rtde_interface::DataPackageHistory(recipe_, 0), UrException);
+
+  rtde_interface::DataPackage other_recipe_package(std::vector<std::string>{ "timestamp" });
+  other_recipe_package.initEmpty();
+  EXPECT_FALSE(history_->push(other_recipe_package));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/rtde/data_package_pool.h"
+
+using namespace urcl;
+
+class DataPackagePoolTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp" });
+    pool_ = rtde_interface::DataPackagePool::create(recipe_, 2, 2);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::shared_ptr<rtde_interface::DataPackagePool> pool_;
+};
+
+TEST_F(DataPackagePoolTest, acquired_packages_are_initialized)
+{
+  EXPECT_EQ(pool_->available(), 2);
+  std::unique_ptr<rtde_interface::DataPackage> package = pool_->acquire();
+  EXPECT_EQ(pool_->available(), 1);
+
+  double timestamp = 1.0;
+  EXPECT_TRUE(package->getData("timestamp", timestamp));
+  EXPECT_EQ(timestamp, 0.0);
+  EXPECT_EQ(package->getCompiledRecipe(), recipe_);
+}
+
+TEST_F(DataPackagePoolTest, released_packages_are_reused)
+{
+  std::unique_ptr<rtde_interface::DataPackage> package = pool_->acquire();
+  rtde_interface::DataPackage* raw_package = package.get();
+  pool_->release(std::move(package));
+  EXPECT_EQ(pool_->available(), 2);
+
+  package = pool_->acquire();
+  EXPECT_EQ(package.get(), raw_package);
+  EXPECT_EQ(pool_->getNumAllocations(), 0);
+}
+
+TEST_F(DataPackagePoolTest, pooled_package_returns_on_release)
+{
+  std::unique_ptr<rtde_interface::DataPackage> package = pool_->acquire();
+  rtde_interface::DataPackage* raw_package = package.get();
+  {
+    rtde_interface::PooledDataPackage pooled = pool_->makePooled(std::move(package));
+    EXPECT_EQ(pool_->available(), 1);
+  }
+  EXPECT_EQ(pool_->available(), 2);
+  EXPECT_EQ(pool_->acquire().get(), raw_package);
+}
+
+TEST_F(DataPackagePoolTest, exhausted_pool_allocates)
+{
+  auto package_1 = pool_->acquire();
+  auto package_2 = pool_->acquire();
+  auto package_3 = pool_->acquire();
+  EXPECT_NE(package_3, nullptr);
+  EXPECT_EQ(pool_->getNumAllocations(), 1);
+
+  // The pool doesn't grow beyond its size
+  pool_->release(std::move(package_1));
+  pool_->release(std::move(package_2));
+  pool_->release(std::move(package_3));
+  EXPECT_EQ(pool_->available(), 2);
+}
+
+TEST_F(DataPackagePoolTest, foreign_packages_are_not_accepted)
+{
+  auto package = std::make_unique<rtde_interface::DataPackage>(std::vector<std::string>{ "timestamp" });
+  pool_->release(std::move(package));
+  EXPECT_EQ(pool_->available(), 2);
+}
+
+TEST_F(DataPackagePoolTest, package_outlives_pool)
+{
+  rtde_interface::PooledDataPackage pooled = pool_->makePooled(pool_->acquire());
+  pool_.reset();
+  double timestamp;
+  EXPECT_TRUE(pooled->getData("timestamp", timestamp));
+  pooled.reset();
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ur_client_library/rtde/derived_signals.h"
+
+using namespace urcl;
+
+class DerivedSignalsTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    package_.reset(new rtde_interface::DataPackage(
+        std::vector<std::string>{ "timestamp", "actual_TCP_speed", "actual_current", "actual_qd", "actual_TCP_force" }));
+    package_->initEmpty();
+  }
+
+  void receive(vector6d_t tcp_speed, vector6d_t current, vector6d_t qd, vector6d_t force)
+  {
+    package_->setData("actual_TCP_speed", tcp_speed);
+    package_->setData("actual_current", current);
+    package_->setData("actual_qd", qd);
+    package_->setData("actual_TCP_force", force);
+    signals_.update(*package_);
+  }
+
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+  rtde_interface::DerivedSignals signals_;
+};
+
+TEST_F(DerivedSignalsTest, tcp_linear_speed)
+{
+  size_t index = signals_.addTcpLinearSpeed();
+  double speed;
+  EXPECT_FALSE(signals_.getValue(index, speed));
+
+  receive({ 0.3, 0.0, 0.4, 1.0, 1.0, 1.0 }, {}, {}, {});
+  ASSERT_TRUE(signals_.getValue(index, speed));
+  EXPECT_DOUBLE_EQ(speed, 0.5);
+  EXPECT_EQ(signals_.getNumUpdates(), 1u);
+}
+
+TEST_F(DerivedSignalsTest, joint_mechanical_power)
+{
+  size_t index = signals_.addJointMechanicalPower({ 2.0, 2.0, 2.0, 1.0, 1.0, 1.0 });
+  receive({}, { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 }, { 0.5, 0.5, -0.5, 1.0, 0.0, 2.0 }, {});
+  vector6d_t power;
+  ASSERT_TRUE(signals_.getValue(index, power));
+  vector6d_t expected = { 1.0, 2.0, -3.0, 4.0, 0.0, 12.0 };
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_DOUBLE_EQ(power[i], expected[i]);
+  }
+}
+
+TEST_F(DerivedSignalsTest, sliding_rms)
+{
+  size_t index = signals_.addSlidingRms("actual_TCP_force", 4);
+  size_t found;
+  ASSERT_TRUE(signals_.findSignal("actual_TCP_force_rms", found));
+  EXPECT_EQ(found, index);
+  EXPECT_EQ(signals_.getWidth(index), 6u);
+
+  std::vector<double> forces = { 1.0, -1.0, 3.0, -3.0, 2.0, 2.0, 2.0, 2.0, 0.0 };
+  vector6d_t rms;
+  for (size_t i = 0; i < forces.size(); ++i)
+  {
+    receive({}, {}, {}, { forces[i], 0.0, 0.0, 0.0, 0.0, 1.0 });
+    ASSERT_TRUE(signals_.getValue(index, rms));
+
+    // Reference computed over the samples within the window
+    const size_t first = i + 1 >= 4 ? i + 1 - 4 : 0;
+    double sum = 0.0;
+    for (size_t j = first; j <= i; ++j)
+    {
+      sum += forces[j] * forces[j];
+    }
+    EXPECT_NEAR(rms[0], std::sqrt(sum / (i + 1 - first)), 1e-12);
+    EXPECT_DOUBLE_EQ(rms[1], 0.0);
+    EXPECT_DOUBLE_EQ(rms[5], 1.0);
+  }
+}
+
+TEST_F(DerivedSignalsTest, custom_signal_and_required_fields)
+{
+  size_t index = signals_.addSignal("speed_sum", { "actual_TCP_speed", "timestamp" }, 1, 1,
+                                    [](const double* inputs, double* state, double* values) {
+                                      state[0] += inputs[0];
+                                      values[0] = state[0] + inputs[6];
+                                    });
+  signals_.addTcpLinearSpeed();
+  std::vector<std::string> expected = { "actual_TCP_speed", "timestamp" };
+  EXPECT_EQ(signals_.getRequiredFields(), expected);
+
+  double timestamp = 10.0;
+  package_->setData("timestamp", timestamp);
+  receive({ 1.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, {}, {}, {});
+  receive({ 2.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, {}, {}, {});
+  double value;
+  ASSERT_TRUE(signals_.getValue(index, value));
+  EXPECT_DOUBLE_EQ(value, 13.0);
+}
+
+TEST_F(DerivedSignalsTest, recipe_change_resets_state)
+{
+  size_t index = signals_.addSlidingRms("actual_TCP_force", 10);
+  receive({}, {}, {}, { 4.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+
+  rtde_interface::DataPackage other(std::vector<std::string>{ "actual_TCP_force" });
+  other.initEmpty();
+  vector6d_t force = { 2.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  other.setData("actual_TCP_force", force);
+  signals_.update(other);
+  EXPECT_EQ(signals_.getNumUpdates(), 1u);
+  vector6d_t rms;
+  ASSERT_TRUE(signals_.getValue(index, rms));
+  EXPECT_DOUBLE_EQ(rms[0], 2.0);
+
+  // Signals whose inputs are missing aren't computed
+  rtde_interface::DataPackage missing(std::vector<std::string>{ "timestamp" });
+  missing.initEmpty();
+  signals_.update(missing);
+  EXPECT_EQ(signals_.getNumUpdates(), 0u);
+  EXPECT_FALSE(signals_.getValue(index, rms));
+}
+
+TEST_F(DerivedSignalsTest, invalid_signals)
+{
+  signals_.addTcpLinearSpeed();
+  EXPECT_THROW(signals_.addTcpLinearSpeed(), UrException);
+  EXPECT_THROW(signals_.addSlidingRms("actual_TCP_force", 0), UrException);
+  EXPECT_THROW(signals_.addSlidingRms("robot_mode", 10), UrException);
+  EXPECT_THROW(signals_.addSignal("unknown", { "no_such_field" }, 1, 0, nullptr), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/rtde/field_change_monitor.h"
+
+using namespace urcl;
+
+class FieldChangeMonitorTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "robot_mode", "actual_q" });
+  }
+
+  void checkChanges(const bool lazy_decoding)
+  {
+    package_.reset(new rtde_interface::DataPackage(recipe_, 2, lazy_decoding));
+    package_->initEmpty();
+    rtde_interface::FieldChangeMonitor monitor;
+    std::vector<int32_t> robot_modes;
+    size_t num_q_changes = 0;
+    monitor.subscribe<int32_t>("robot_mode", [&robot_modes](const int32_t& mode) { robot_modes.push_back(mode); });
+    monitor.subscribe<vector6d_t>("actual_q", [&num_q_changes](const vector6d_t&) { num_q_changes++; });
+    monitor.setRecipe(*recipe_);
+
+    // The first package always reports the current values
+    monitor.update(*package_);
+    EXPECT_EQ(robot_modes, std::vector<int32_t>{ 0 });
+    EXPECT_EQ(num_q_changes, 1);
+
+    // Changing other fields doesn't trigger the callbacks
+    double timestamp = 1.0;
+    package_->setData("timestamp", timestamp);
+    monitor.update(*package_);
+    EXPECT_EQ(robot_modes.size(), 1);
+    EXPECT_EQ(num_q_changes, 1);
+
+    int32_t robot_mode = 7;
+    package_->setData("robot_mode", robot_mode);
+    monitor.update(*package_);
+    monitor.update(*package_);
+    EXPECT_EQ(robot_modes, (std::vector<int32_t>{ 0, 7 }));
+
+    vector6d_t actual_q = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 };
+    package_->setData("actual_q", actual_q);
+    monitor.update(*package_);
+    EXPECT_EQ(num_q_changes, 2);
+
+    // Rebinding resets the previously seen values
+    monitor.setRecipe(*recipe_);
+    monitor.update(*package_);
+    EXPECT_EQ(robot_modes, (std::vector<int32_t>{ 0, 7, 7 }));
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+};
+
+TEST_F(FieldChangeMonitorTest, callback_only_on_change)
+{
+  checkChanges(false);
+}
+
+TEST_F(FieldChangeMonitorTest, callback_only_on_change_lazy_decoding)
+{
+  checkChanges(true);
+}
+
+TEST_F(FieldChangeMonitorTest, invalid_subscription_throws)
+{
+  rtde_interface::FieldChangeMonitor missing_field;
+  missing_field.subscribe<uint32_t>("runtime_state", [](const uint32_t&) {});
+  EXPECT_THROW(missing_field.setRecipe(*recipe_), UrException);
+
+  rtde_interface::FieldChangeMonitor wrong_type;
+  wrong_type.subscribe<uint32_t>("robot_mode", [](const uint32_t&) {});
+  EXPECT_THROW(wrong_type.setRecipe(*recipe_), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/field_exporter.h"
+
+using namespace urcl;
+
+class FieldExporterTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "actual_q", "actual_qd", "robot_mode", "actual_current" });
+  }
+
+  // Fills a package, which decodes its fields lazily or when parsed
+  void createPackage(const bool lazy_decoding)
+  {
+    package_.reset(new rtde_interface::DataPackage(recipe_, 2, lazy_decoding));
+    package_->initEmpty();
+    vector6d_t q = { 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 };
+    vector6d_t qd = { 1.1, 1.2, 1.3, 1.4, 1.5, 1.6 };
+    vector6d_t current = { 2.1, 2.2, 2.3, 2.4, 2.5, 2.6 };
+    int32_t robot_mode = 7;
+    package_->setData("actual_q", q);
+    package_->setData("actual_qd", qd);
+    package_->setData("actual_current", current);
+    package_->setData("robot_mode", robot_mode);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+};
+
+TEST_F(FieldExporterTest, export_doubles)
+{
+  rtde_interface::FieldExporter exporter(recipe_, { "actual_q", "actual_qd", "actual_current" });
+  ASSERT_EQ(exporter.getNumValues(), 18u);
+  EXPECT_EQ(exporter.getOffset("actual_qd"), 6u);
+  EXPECT_EQ(exporter.getOffset("actual_current"), 12u);
+
+  for (const bool lazy_decoding : { false, true })
+  {
+    createPackage(lazy_decoding);
+    std::array<double, 18> buffer;
+    ASSERT_TRUE(exporter.exportTo(*package_, buffer.data()));
+    EXPECT_DOUBLE_EQ(buffer[0], 0.1);
+    EXPECT_DOUBLE_EQ(buffer[5], 0.6);
+    EXPECT_DOUBLE_EQ(buffer[6], 1.1);
+    EXPECT_DOUBLE_EQ(buffer[17], 2.6);
+  }
+}
+
+TEST_F(FieldExporterTest, export_floats_and_integers)
+{
+  rtde_interface::FieldExporter exporter(recipe_, { "robot_mode", "actual_q" });
+  ASSERT_EQ(exporter.getNumValues(), 7u);
+
+  for (const bool lazy_decoding : { false, true })
+  {
+    createPackage(lazy_decoding);
+    std::array<float, 7> buffer;
+    ASSERT_TRUE(exporter.exportTo(*package_, buffer.data()));
+    EXPECT_FLOAT_EQ(buffer[0], 7.0f);
+    EXPECT_FLOAT_EQ(buffer[1], 0.1f);
+    EXPECT_FLOAT_EQ(buffer[6], 0.6f);
+  }
+}
+
+TEST_F(FieldExporterTest, reject_other_recipe)
+{
+  rtde_interface::FieldExporter exporter(recipe_, { "actual_q" });
+  auto other_recipe =
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp", "actual_q" });
+  rtde_interface::DataPackage other(other_recipe, 2, false);
+  other.initEmpty();
+  std::array<double, 6> buffer;
+  EXPECT_FALSE(exporter.exportTo(other, buffer.data()));
+
+  // Packages of an equal recipe compiled separately are accepted
+  auto equal_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe_->getRecipe());
+  rtde_interface::DataPackage equal(equal_recipe, 2, false);
+  equal.initEmpty();
+  EXPECT_TRUE(exporter.exportTo(equal, buffer.data()));
+}
+
+TEST_F(FieldExporterTest, invalid_fields)
+{
+  EXPECT_THROW(rtde_interface::FieldExporter(recipe_, { "actual_tcp_pose" }), UrException);
+  rtde_interface::FieldExporter exporter(recipe_, { "actual_q" });
+  EXPECT_THROW(exporter.getOffset("actual_qd"), UrException);
+}
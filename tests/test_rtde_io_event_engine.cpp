@@ -0,0 +1,141 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/io_event_engine.h"
+
+using namespace urcl;
+
+class IOEventEngineTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{
+        "timestamp", "actual_digital_input_bits", "actual_digital_output_bits" });
+    package_.reset(new rtde_interface::DataPackage(recipe_));
+    package_->initEmpty();
+  }
+
+  void setState(const double timestamp, const uint64_t inputs, const uint64_t outputs)
+  {
+    double t = timestamp;
+    package_->setData("timestamp", t);
+    uint64_t input_bits = inputs;
+    package_->setData("actual_digital_input_bits", input_bits);
+    uint64_t output_bits = outputs;
+    package_->setData("actual_digital_output_bits", output_bits);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+};
+
+TEST_F(IOEventEngineTest, edges_are_reported_with_timestamps)
+{
+  rtde_interface::IOEventEngine engine;
+  std::vector<rtde_interface::IOEdgeEvent> events;
+  auto record = [&events](const rtde_interface::IOEdgeEvent& event) { events.push_back(event); };
+  engine.subscribe(rtde_interface::IOBank::STANDARD_INPUT, 2, rtde_interface::IOEdge::RISING, record);
+  engine.subscribe(rtde_interface::IOBank::CONFIGURABLE_INPUT, 0, rtde_interface::IOEdge::FALLING, record);
+  engine.subscribe(rtde_interface::IOBank::TOOL_OUTPUT, 1, rtde_interface::IOEdge::BOTH, record);
+  EXPECT_FALSE(engine.empty());
+  EXPECT_EQ(engine.getRequiredFields(), (std::vector<std::string>{ "timestamp", "actual_digital_input_bits",
+                                                                   "actual_digital_output_bits" }));
+  engine.setRecipe(*recipe_);
+
+  // The first package only provides the initial state
+  setState(1.0, 0x100, 0x0);
+  engine.update(*package_);
+  EXPECT_TRUE(events.empty());
+
+  // Standard input 2 rises, configurable input 0 falls, standard input 3 isn't subscribed
+  setState(1.002, 0x00C, 0x0);
+  engine.update(*package_);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].bank, rtde_interface::IOBank::STANDARD_INPUT);
+  EXPECT_EQ(events[0].pin, 2);
+  EXPECT_TRUE(events[0].rising);
+  EXPECT_DOUBLE_EQ(events[0].timestamp, 1.002);
+  EXPECT_DOUBLE_EQ(events[0].previous_timestamp, 1.0);
+  EXPECT_EQ(events[1].bank, rtde_interface::IOBank::CONFIGURABLE_INPUT);
+  EXPECT_EQ(events[1].pin, 0);
+  EXPECT_FALSE(events[1].rising);
+
+  // Unchanged states and edges in the wrong direction aren't reported
+  events.clear();
+  setState(1.004, 0x00C, 0x0);
+  engine.update(*package_);
+  setState(1.006, 0x108, 0x0);
+  engine.update(*package_);
+  EXPECT_TRUE(events.empty());
+
+  // Tool output 1 is bit 17 of the output bits
+  setState(1.008, 0x108, 1ULL << 17);
+  engine.update(*package_);
+  setState(1.010, 0x108, 0x0);
+  engine.update(*package_);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].bank, rtde_interface::IOBank::TOOL_OUTPUT);
+  EXPECT_EQ(events[0].pin, 1);
+  EXPECT_TRUE(events[0].rising);
+  EXPECT_FALSE(events[1].rising);
+  EXPECT_DOUBLE_EQ(events[1].previous_timestamp, 1.008);
+
+  // Rebinding resets the previously seen states
+  events.clear();
+  engine.setRecipe(*recipe_);
+  setState(1.012, 0x0, 1ULL << 17);
+  engine.update(*package_);
+  EXPECT_TRUE(events.empty());
+}
+
+TEST_F(IOEventEngineTest, invalid_subscription_throws)
+{
+  rtde_interface::IOEventEngine engine;
+  EXPECT_TRUE(engine.empty());
+  EXPECT_TRUE(engine.getRequiredFields().empty());
+  EXPECT_THROW(engine.subscribe(rtde_interface::IOBank::STANDARD_OUTPUT, 8, rtde_interface::IOEdge::BOTH, nullptr),
+               UrException);
+  EXPECT_THROW(engine.subscribe(rtde_interface::IOBank::TOOL_INPUT, 2, rtde_interface::IOEdge::BOTH, nullptr),
+               UrException);
+
+  engine.subscribe(rtde_interface::IOBank::TOOL_INPUT, 1, rtde_interface::IOEdge::BOTH,
+                   [](const rtde_interface::IOEdgeEvent&) {});
+  EXPECT_EQ(engine.getRequiredFields(), (std::vector<std::string>{ "timestamp", "actual_digital_input_bits" }));
+  rtde_interface::CompiledRecipe missing_field(std::vector<std::string>{ "timestamp", "actual_digital_output_bits" });
+  EXPECT_THROW(engine.setRecipe(missing_field), UrException);
+  rtde_interface::CompiledRecipe missing_timestamp(std::vector<std::string>{ "actual_digital_input_bits" });
+  EXPECT_THROW(engine.setRecipe(missing_timestamp), UrException);
+}
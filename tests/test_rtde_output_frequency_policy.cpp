@@ -0,0 +1,114 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/output_frequency_policy.h"
+
+using namespace urcl;
+
+class OutputFrequencyPolicyTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "robot_mode", "runtime_state" });
+    package_.reset(new rtde_interface::DataPackage(recipe_));
+    package_->initEmpty();
+  }
+
+  void setState(const RobotMode robot_mode, const RuntimeState runtime_state)
+  {
+    int32_t mode = static_cast<int32_t>(robot_mode);
+    package_->setData("robot_mode", mode);
+    uint32_t state = static_cast<uint32_t>(runtime_state);
+    package_->setData("runtime_state", state);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+};
+
+TEST_F(OutputFrequencyPolicyTest, switches_between_idle_and_active)
+{
+  rtde_interface::OutputFrequencyPolicy policy(500.0, 10.0, std::chrono::milliseconds(2000));
+  policy.setRecipe(*recipe_);
+  const auto start = std::chrono::steady_clock::now();
+
+  // Idle right from the start
+  setState(RobotMode::RUNNING, RuntimeState::STOPPED);
+  EXPECT_EQ(policy.update(*package_, start), 10.0);
+
+  // Active as soon as a program plays
+  setState(RobotMode::RUNNING, RuntimeState::PLAYING);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(100)), 500.0);
+
+  // Short breaks keep the active frequency
+  setState(RobotMode::RUNNING, RuntimeState::PAUSED);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(1000)), 500.0);
+  setState(RobotMode::RUNNING, RuntimeState::RESUMING);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(1500)), 500.0);
+  setState(RobotMode::RUNNING, RuntimeState::STOPPED);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(3000)), 500.0);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(3500)), 10.0);
+
+  // Without a running robot, a playing program doesn't count
+  setState(RobotMode::POWER_OFF, RuntimeState::PLAYING);
+  EXPECT_EQ(policy.update(*package_, start + std::chrono::milliseconds(4000)), 10.0);
+}
+
+TEST_F(OutputFrequencyPolicyTest, custom_activity_check)
+{
+  rtde_interface::OutputFrequencyPolicy policy(
+      125.0, 1.0, std::chrono::milliseconds(0),
+      [](const RobotMode robot_mode, const RuntimeState) { return robot_mode == RobotMode::BACKDRIVE; });
+  policy.setRecipe(*recipe_);
+  EXPECT_EQ(policy.getActiveFrequency(), 125.0);
+  EXPECT_EQ(policy.getIdleFrequency(), 1.0);
+
+  setState(RobotMode::BACKDRIVE, RuntimeState::STOPPED);
+  EXPECT_EQ(policy.update(*package_), 125.0);
+  setState(RobotMode::RUNNING, RuntimeState::PLAYING);
+  EXPECT_EQ(policy.update(*package_), 1.0);
+}
+
+TEST_F(OutputFrequencyPolicyTest, invalid_configuration_throws)
+{
+  EXPECT_THROW(rtde_interface::OutputFrequencyPolicy(0.0, 10.0), UrException);
+  EXPECT_THROW(rtde_interface::OutputFrequencyPolicy(500.0, -1.0), UrException);
+
+  rtde_interface::OutputFrequencyPolicy policy(500.0, 10.0);
+  rtde_interface::CompiledRecipe missing_fields(std::vector<std::string>{ "timestamp", "robot_mode" });
+  EXPECT_THROW(policy.setRecipe(missing_fields), UrException);
+  EXPECT_EQ(rtde_interface::OutputFrequencyPolicy::getRequiredFields(),
+            (std::vector<std::string>{ "robot_mode", "runtime_state" }));
+}
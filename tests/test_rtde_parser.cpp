@@ -255,6 +255,147 @@ TEST(rtde_parser, test_buffer_too_long)
   EXPECT_FALSE(parser.parse(bp, products));
 }
 
+TEST(rtde_parser, truncated_data_package)
+{
+  // The header announces a package that doesn't hold the whole recipe
+  unsigned char raw_data[] = { 0x00, 0x08, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb };
+  comm::BinParser bp(raw_data, sizeof(raw_data), comm::BinParser::ErrorMode::STATUS);
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  rtde_interface::RTDEParser parser({ "timestamp" });
+  parser.setProtocolVersion(2);
+  EXPECT_FALSE(parser.parse(bp, products));
+  EXPECT_TRUE(bp.failed());
+  EXPECT_TRUE(products.empty());
+
+  // A header announcing more bytes than received fails the parser as well
+  unsigned char short_data[] = { 0x00, 0x0c, 0x55, 0x01, 0x40 };
+  comm::BinParser bp1(short_data, sizeof(short_data), comm::BinParser::ErrorMode::STATUS);
+  EXPECT_FALSE(parser.parse(bp1, products));
+  EXPECT_TRUE(bp1.failed());
+}
+
+TEST(rtde_parser, data_package_from_pool)
+{
+  unsigned char raw_data[] = { 0x00, 0x14, 0x55, 0x01, 0x40, 0xd0, 0x07, 0x0d, 0x2f, 0x1a,
+                               0x9f, 0xbe, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+  std::vector<std::string> recipe = { "timestamp", "target_speed_fraction" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  auto pool = rtde_interface::DataPackagePool::create(parser.getCompiledRecipe(), 2, 1);
+  parser.setDataPackagePool(pool);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    comm::BinParser bp(raw_data, sizeof(raw_data));
+    std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+    ASSERT_TRUE(parser.parse(bp, products));
+    ASSERT_EQ(products.size(), 1);
+
+    std::unique_ptr<rtde_interface::DataPackage> package(
+        dynamic_cast<rtde_interface::DataPackage*>(products[0].release()));
+    ASSERT_NE(package, nullptr);
+    double target_speed_fraction;
+    EXPECT_TRUE(package->getData("target_speed_fraction", target_speed_fraction));
+    EXPECT_EQ(target_speed_fraction, 1.0);
+    pool->release(std::move(package));
+  }
+  EXPECT_EQ(pool->getNumAllocations(), 0);
+
+  auto other_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe);
+  EXPECT_THROW(parser.setDataPackagePool(rtde_interface::DataPackagePool::create(other_recipe, 2, 1)), UrException);
+}
+
+TEST(rtde_parser, switch_compiled_recipe)
+{
+  unsigned char raw_data[] = { 0x00, 0x14, 0x55, 0x01, 0x40, 0xd0, 0x07, 0x0d, 0x2f, 0x1a,
+                               0x9f, 0xbe, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+  rtde_interface::RTDEParser parser({ "timestamp" });
+  parser.setProtocolVersion(2);
+  auto pool = rtde_interface::DataPackagePool::create(parser.getCompiledRecipe(), 2, 1);
+  parser.setDataPackagePool(pool);
+
+  auto new_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(
+      std::vector<std::string>{ "timestamp", "target_speed_fraction" });
+  parser.setCompiledRecipe(new_recipe);
+  EXPECT_EQ(new_recipe, parser.getCompiledRecipe());
+
+  // The pool of the previous recipe isn't used anymore
+  comm::BinParser bp(raw_data, sizeof(raw_data));
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  ASSERT_TRUE(parser.parse(bp, products));
+  ASSERT_EQ(products.size(), 1);
+  auto* package = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+  ASSERT_NE(package, nullptr);
+  EXPECT_EQ(new_recipe, package->getCompiledRecipe());
+  double target_speed_fraction;
+  EXPECT_TRUE(package->getData("target_speed_fraction", target_speed_fraction));
+  EXPECT_EQ(target_speed_fraction, 1.0);
+}
+
+TEST(rtde_parser, package_type_matches_class)
+{
+  unsigned char protocol_version_data[] = { 0x00, 0x04, 0x56, 0x01 };
+  unsigned char data_package_data[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+
+  rtde_interface::RTDEParser parser({ "timestamp" });
+  parser.setProtocolVersion(2);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+
+  comm::BinParser protocol_version_bp(protocol_version_data, sizeof(protocol_version_data));
+  ASSERT_TRUE(parser.parse(protocol_version_bp, products));
+  comm::BinParser data_package_bp(data_package_data, sizeof(data_package_data));
+  ASSERT_TRUE(parser.parse(data_package_bp, products));
+  ASSERT_EQ(products.size(), 2);
+
+  EXPECT_EQ(products[0]->getType(), rtde_interface::PackageType::RTDE_REQUEST_PROTOCOL_VERSION);
+  EXPECT_NE(dynamic_cast<rtde_interface::RequestProtocolVersion*>(products[0].get()), nullptr);
+  EXPECT_EQ(products[1]->getType(), rtde_interface::PackageType::RTDE_DATA_PACKAGE);
+  EXPECT_NE(dynamic_cast<rtde_interface::DataPackage*>(products[1].get()), nullptr);
+}
+
+TEST(rtde_parser, additional_output_recipe)
+{
+  unsigned char main_recipe_data[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  unsigned char additional_recipe_data[] = { 0x00, 0x0c, 0x55, 0x02, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+  rtde_interface::RTDEParser parser({ "timestamp" });
+  parser.setProtocolVersion(2);
+  size_t num_callbacks = 0;
+  double target_speed_fraction = 0.0;
+  parser.addOutputRecipe(
+      2, std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "target_speed_fraction" }),
+      [&](rtde_interface::DataPackage& package) {
+        num_callbacks++;
+        package.getData("target_speed_fraction", target_speed_fraction);
+      });
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  comm::BinParser additional_bp(additional_recipe_data, sizeof(additional_recipe_data));
+  ASSERT_TRUE(parser.parse(additional_bp, products));
+  EXPECT_EQ(products.size(), 0);
+  EXPECT_EQ(num_callbacks, 1);
+  EXPECT_EQ(target_speed_fraction, 1.0);
+
+  comm::BinParser main_bp(main_recipe_data, sizeof(main_recipe_data));
+  ASSERT_TRUE(parser.parse(main_bp, products));
+  ASSERT_EQ(products.size(), 1);
+  EXPECT_EQ(num_callbacks, 1);
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  EXPECT_TRUE(data->getData("timestamp", timestamp));
+  EXPECT_FLOAT_EQ(timestamp, 7103.8579);
+
+  parser.clearOutputRecipes();
+  comm::BinParser cleared_bp(additional_recipe_data, sizeof(additional_recipe_data));
+  ASSERT_TRUE(parser.parse(cleared_bp, products));
+  EXPECT_EQ(products.size(), 2);
+  EXPECT_EQ(num_callbacks, 1);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,222 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/rtde/rate_adapter.h"
+
+using namespace urcl;
+
+class RateAdapterTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    package_.reset(new rtde_interface::DataPackage(std::vector<std::string>{ "timestamp", "actual_q", "robot_mode" }));
+    package_->initEmpty();
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  // Feeds the i-th package of a 500 Hz stream
+  void receive(const int i)
+  {
+    double timestamp = i * 0.002;
+    vector6d_t actual_q = { static_cast<double>(i), -static_cast<double>(i), 0.0, 0.0, 0.0, 1.0 };
+    int32_t robot_mode = i;
+    package_->setData("timestamp", timestamp);
+    package_->setData("actual_q", actual_q);
+    package_->setData("robot_mode", robot_mode);
+    adapter_.update(*package_, start_ + std::chrono::microseconds(i * 2000));
+  }
+
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+  rtde_interface::RateAdapter adapter_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+TEST_F(RateAdapterTest, latest_package_at_consumer_rate)
+{
+  auto output = adapter_.addConsumer(100.0);
+  rtde_interface::DecimatedPackage result;
+
+  std::vector<double> timestamps;
+  for (int i = 0; i < 50; ++i)
+  {
+    receive(i);
+    if (output->tryGetPackage(result))
+    {
+      double timestamp;
+      ASSERT_TRUE(result.value.getData("timestamp", timestamp));
+      EXPECT_EQ(result.num_samples, timestamps.empty() ? 1u : 5u);
+      EXPECT_EQ(result.num_skipped, 0u);
+      timestamps.push_back(timestamp);
+    }
+  }
+  ASSERT_EQ(timestamps.size(), 10u);
+  for (size_t i = 0; i < timestamps.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(timestamps[i], i * 0.01);
+  }
+  EXPECT_FALSE(output->tryGetPackage(result));
+}
+
+TEST_F(RateAdapterTest, mean_aggregation)
+{
+  auto output = adapter_.addConsumer(100.0, rtde_interface::Aggregation::MEAN);
+  rtde_interface::DecimatedPackage result;
+  receive(0);
+  ASSERT_TRUE(output->tryGetPackage(result));
+  EXPECT_EQ(result.num_samples, 1u);
+  for (int i = 1; i < 6; ++i)
+  {
+    receive(i);
+  }
+  ASSERT_TRUE(output->tryGetPackage(result));
+  EXPECT_EQ(result.num_samples, 5u);
+
+  vector6d_t actual_q;
+  ASSERT_TRUE(result.value.getData("actual_q", actual_q));
+  EXPECT_DOUBLE_EQ(actual_q[0], 3.0);
+  EXPECT_DOUBLE_EQ(actual_q[1], -3.0);
+  EXPECT_DOUBLE_EQ(actual_q[5], 1.0);
+  double timestamp;
+  ASSERT_TRUE(result.value.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 0.006);
+
+  // Integer fields keep the latest value
+  int32_t robot_mode;
+  ASSERT_TRUE(result.value.getData("robot_mode", robot_mode));
+  EXPECT_EQ(robot_mode, 5);
+}
+
+TEST_F(RateAdapterTest, min_max_aggregation)
+{
+  auto output = adapter_.addConsumer(100.0, rtde_interface::Aggregation::MIN_MAX);
+  for (int i = 0; i < 11; ++i)
+  {
+    receive(i);
+  }
+  rtde_interface::DecimatedPackage result;
+  ASSERT_TRUE(output->tryGetPackage(result));
+  EXPECT_EQ(result.num_samples, 5u);
+  EXPECT_EQ(result.num_skipped, 2u);
+
+  vector6d_t latest, minimum, maximum;
+  ASSERT_TRUE(result.value.getData("actual_q", latest));
+  ASSERT_TRUE(result.minimum.getData("actual_q", minimum));
+  ASSERT_TRUE(result.maximum.getData("actual_q", maximum));
+  EXPECT_DOUBLE_EQ(latest[0], 10.0);
+  EXPECT_DOUBLE_EQ(minimum[0], 6.0);
+  EXPECT_DOUBLE_EQ(maximum[0], 10.0);
+  EXPECT_DOUBLE_EQ(minimum[1], -10.0);
+  EXPECT_DOUBLE_EQ(maximum[1], -6.0);
+}
+
+TEST_F(RateAdapterTest, consumers_with_different_rates)
+{
+  auto hmi = adapter_.addConsumer(25.0);
+  auto historian = adapter_.addConsumer(100.0);
+  int num_hmi = 0;
+  int num_historian = 0;
+  rtde_interface::DecimatedPackage result;
+  for (int i = 0; i < 500; ++i)
+  {
+    receive(i);
+    num_hmi += hmi->tryGetPackage(result) ? 1 : 0;
+    num_historian += historian->tryGetPackage(result) ? 1 : 0;
+  }
+  EXPECT_EQ(num_hmi, 25);
+  EXPECT_EQ(num_historian, 100);
+}
+
+TEST_F(RateAdapterTest, recipe_change_discards_open_windows)
+{
+  auto output = adapter_.addConsumer(100.0, rtde_interface::Aggregation::MEAN);
+  rtde_interface::DecimatedPackage result;
+  for (int i = 0; i < 3; ++i)
+  {
+    receive(i);
+  }
+  ASSERT_TRUE(output->tryGetPackage(result));
+
+  // The first package of the new recipe opens a new window
+  rtde_interface::DataPackage other(std::vector<std::string>{ "timestamp", "target_q" });
+  other.initEmpty();
+  for (int i = 3; i < 9; ++i)
+  {
+    double timestamp = i * 0.002;
+    other.setData("timestamp", timestamp);
+    adapter_.update(other, start_ + std::chrono::microseconds(i * 2000));
+    if (i == 3)
+    {
+      ASSERT_TRUE(output->tryGetPackage(result));
+      EXPECT_EQ(result.num_samples, 1u);
+      EXPECT_EQ(result.num_skipped, 0u);
+    }
+  }
+  ASSERT_TRUE(output->tryGetPackage(result));
+  EXPECT_EQ(result.num_samples, 5u);
+  double timestamp;
+  ASSERT_TRUE(result.value.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 0.012);
+  vector6d_t target_q;
+  EXPECT_TRUE(result.value.getData("target_q", target_q));
+}
+
+TEST_F(RateAdapterTest, wait_for_package)
+{
+  auto output = adapter_.addConsumer(100.0);
+  rtde_interface::DecimatedPackage result;
+  EXPECT_FALSE(output->waitForPackage(result, std::chrono::milliseconds(10)));
+
+  std::thread feeder([this]() {
+    for (int i = 0; i < 5; ++i)
+    {
+      receive(i);
+    }
+  });
+  EXPECT_TRUE(output->waitForPackage(result, std::chrono::milliseconds(1000)));
+  feeder.join();
+}
+
+TEST_F(RateAdapterTest, invalid_rate)
+{
+  EXPECT_THROW(adapter_.addConsumer(0.0), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
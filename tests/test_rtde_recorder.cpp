@@ -0,0 +1,180 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <fstream>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+using namespace urcl;
+
+class RTDERecorderTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    path_ = "rtde_recorder_test_" + std::to_string(::getpid()) + ".bin";
+    recipe_ = { "timestamp", "actual_q" };
+  }
+
+  void TearDown()
+  {
+    std::remove(path_.c_str());
+  }
+
+  size_t serializeSample(uint8_t* buffer, const double timestamp)
+  {
+    rtde_interface::DataPackage package(recipe_, 2);
+    package.initEmpty();
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { timestamp, 0, 0, 0, 0, -timestamp };
+    package.setData("actual_q", actual_q);
+    package.setRecipeID(1);
+    return package.serializePackage(buffer);
+  }
+
+  void recordSamples(rtde_interface::RTDERecorder& recorder, const size_t num_samples)
+  {
+    uint8_t buffer[4096];
+    for (size_t i = 0; i < num_samples; ++i)
+    {
+      const size_t size = serializeSample(buffer, static_cast<double>(i));
+      ASSERT_TRUE(recorder.record(buffer, size, std::chrono::system_clock::time_point(std::chrono::milliseconds(i))));
+    }
+  }
+
+  void expectSamples(rtde_interface::RTDERecording& recording, const size_t num_samples)
+  {
+    rtde_interface::RTDEParser parser(recording.getRecipe());
+    parser.setProtocolVersion(recording.getProtocolVersion());
+    rtde_interface::RTDERecording::Frame frame;
+    size_t num_frames = 0;
+    while (recording.next(frame))
+    {
+      EXPECT_EQ(std::chrono::system_clock::time_point(std::chrono::milliseconds(num_frames)), frame.receive_time);
+      comm::BinParser bp(const_cast<uint8_t*>(frame.data), frame.size);
+      std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+      ASSERT_TRUE(parser.parse(bp, products));
+      ASSERT_EQ(1u, products.size());
+      auto* data = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+      ASSERT_NE(nullptr, data);
+      double timestamp;
+      ASSERT_TRUE(data->getData("timestamp", timestamp));
+      EXPECT_EQ(static_cast<double>(num_frames), timestamp);
+      ++num_frames;
+    }
+    EXPECT_EQ(num_samples, num_frames);
+  }
+
+  std::string path_;
+  std::vector<std::string> recipe_;
+};
+
+TEST_F(RTDERecorderTest, record_and_read_back)
+{
+  {
+    rtde_interface::RTDERecorder recorder(path_);
+    recorder.open(recipe_, 2);
+    recordSamples(recorder, 10);
+    EXPECT_EQ(10u, recorder.getNumFrames());
+    recorder.close();
+    EXPECT_FALSE(recorder.isOpen());
+  }
+
+  rtde_interface::RTDERecording recording(path_);
+  EXPECT_EQ(recipe_, recording.getRecipe());
+  EXPECT_EQ(2, recording.getProtocolVersion());
+  expectSamples(recording, 10);
+
+  recording.rewind();
+  expectSamples(recording, 10);
+}
+
+TEST_F(RTDERecorderTest, file_grows_in_chunks)
+{
+  rtde_interface::RTDERecorder recorder(path_, 64);
+  recorder.open(recipe_, 2);
+  recordSamples(recorder, 100);
+  const size_t size = recorder.getSize();
+  recorder.close();
+
+  std::ifstream file(path_, std::ios::binary | std::ios::ate);
+  EXPECT_EQ(size, static_cast<size_t>(file.tellg()));
+
+  rtde_interface::RTDERecording recording(path_);
+  expectSamples(recording, 100);
+}
+
+TEST_F(RTDERecorderTest, read_unclosed_recording)
+{
+  rtde_interface::RTDERecorder recorder(path_);
+  recorder.open(recipe_, 2);
+  recordSamples(recorder, 5);
+
+  // The file still has the size of the first chunk, the unused part is filled with zeros.
+  rtde_interface::RTDERecording recording(path_);
+  expectSamples(recording, 5);
+}
+
+TEST_F(RTDERecorderTest, record_requires_open_recorder)
+{
+  rtde_interface::RTDERecorder recorder(path_);
+  uint8_t buffer[4096];
+  const size_t size = serializeSample(buffer, 0.0);
+  EXPECT_FALSE(recorder.record(buffer, size));
+
+  recorder.open(recipe_, 2);
+  EXPECT_THROW(recorder.open(recipe_, 2), UrException);
+  EXPECT_TRUE(recorder.record(buffer, size));
+  recorder.close();
+  EXPECT_FALSE(recorder.record(buffer, size));
+  EXPECT_EQ(1u, recorder.getNumFrames());
+}
+
+TEST_F(RTDERecorderTest, invalid_recording_throws)
+{
+  EXPECT_THROW(rtde_interface::RTDERecording recording(path_), UrException);
+
+  std::ofstream file(path_, std::ios::binary);
+  file << "This is no RTDE recording";
+  file.close();
+  EXPECT_THROW(rtde_interface::RTDERecording recording(path_), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
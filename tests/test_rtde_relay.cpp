@@ -0,0 +1,240 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/rtde_relay.h"
+
+using namespace urcl;
+
+class RTDERelayTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = rtde_interface::CompiledRecipe::intern({ "timestamp", "actual_q", "speed_scaling", "robot_mode",
+                                                       "joint_mode", "actual_digital_output_bits",
+                                                       "safety_status_bits", "unknown_field" });
+  }
+
+  rtde_interface::DataPackage createPackage(const size_t i)
+  {
+    rtde_interface::DataPackage package(recipe_);
+    package.initEmpty();
+    const double t = 0.002 * i;
+    double timestamp = 1000.0 + t;
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q;
+    for (size_t j = 0; j < actual_q.size(); ++j)
+    {
+      actual_q[j] = std::sin(t + j);
+    }
+    package.setData("actual_q", actual_q);
+    double speed_scaling = 1.0;
+    package.setData("speed_scaling", speed_scaling);
+    int32_t robot_mode = 7;
+    package.setData("robot_mode", robot_mode);
+    vector6int32_t joint_mode = { 253, 253, 253, 253, 253, -1 };
+    package.setData("joint_mode", joint_mode);
+    uint64_t digital_outputs = (i / 100) % 2 == 0 ? 0x5ULL : 0x8000000000000005ULL;
+    package.setData("actual_digital_output_bits", digital_outputs);
+    uint32_t safety_status_bits = 1;
+    package.setData("safety_status_bits", safety_status_bits);
+    package.setRecipeID(1);
+    return package;
+  }
+
+  void expectDecoded(const rtde_interface::DataPackage& expected, rtde_interface::DataPackage& decoded)
+  {
+    rtde_interface::DataPackage original = expected;
+    double expected_timestamp, timestamp;
+    ASSERT_TRUE(original.getData("timestamp", expected_timestamp));
+    ASSERT_TRUE(decoded.getData("timestamp", timestamp));
+    EXPECT_NEAR(timestamp, expected_timestamp, 0.5e-6);
+    vector6d_t expected_q, actual_q;
+    ASSERT_TRUE(original.getData("actual_q", expected_q));
+    ASSERT_TRUE(decoded.getData("actual_q", actual_q));
+    for (size_t j = 0; j < actual_q.size(); ++j)
+    {
+      EXPECT_NEAR(actual_q[j], expected_q[j], 0.5e-6);
+    }
+    vector6int32_t expected_joint_mode, joint_mode;
+    ASSERT_TRUE(original.getData("joint_mode", expected_joint_mode));
+    ASSERT_TRUE(decoded.getData("joint_mode", joint_mode));
+    EXPECT_EQ(joint_mode, expected_joint_mode);
+    uint64_t expected_outputs, outputs;
+    ASSERT_TRUE(original.getData("actual_digital_output_bits", expected_outputs));
+    ASSERT_TRUE(decoded.getData("actual_digital_output_bits", outputs));
+    EXPECT_EQ(outputs, expected_outputs);
+    EXPECT_EQ(decoded.getRecipeID(), 1);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+};
+
+TEST_F(RTDERelayTest, encode_and_decode)
+{
+  rtde_interface::RelayEncoder encoder(recipe_, rtde_interface::RelayEncoder::DEFAULT_RESOLUTION, {}, 100);
+  rtde_interface::RelayDecoder decoder(encoder.getHeader());
+  EXPECT_TRUE(decoder.getCompiledRecipe()->isComplete());
+  EXPECT_EQ(decoder.getCompiledRecipe()->getFields().size(), 7u);
+
+  rtde_interface::DataPackage decoded(decoder.getCompiledRecipe());
+  std::vector<uint8_t> frame;
+  size_t encoded_size = 0;
+  const size_t num_packages = 1000;
+  for (size_t i = 0; i < num_packages; ++i)
+  {
+    rtde_interface::DataPackage package = createPackage(i);
+    ASSERT_TRUE(encoder.encode(package, frame));
+    EXPECT_EQ(rtde_interface::RelayEncoder::isKeyframe(frame.data(), frame.size()), i % 100 == 0);
+    encoded_size += frame.size();
+    ASSERT_TRUE(decoder.decode(frame.data(), frame.size(), decoded));
+    expectDecoded(package, decoded);
+  }
+  EXPECT_LT(encoded_size, num_packages * recipe_->getDataSize() / 3);
+  EXPECT_TRUE(decoder.isSynchronized());
+
+  rtde_interface::DataPackage other_package(std::vector<std::string>{ "timestamp" });
+  other_package.initEmpty();
+  EXPECT_FALSE(encoder.encode(other_package, frame));
+  EXPECT_FALSE(decoder.decode(frame.data(), frame.size(), other_package));
+}
+
+TEST_F(RTDERelayTest, lost_frames_are_skipped_until_keyframe)
+{
+  rtde_interface::RelayEncoder encoder(recipe_, rtde_interface::RelayEncoder::DEFAULT_RESOLUTION, {}, 0);
+  rtde_interface::RelayDecoder decoder(encoder.getHeader());
+  rtde_interface::DataPackage decoded(decoder.getCompiledRecipe());
+  std::vector<uint8_t> frame;
+
+  ASSERT_TRUE(encoder.encode(createPackage(0), frame));
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size(), decoded));
+  ASSERT_TRUE(encoder.encode(createPackage(1), frame));
+  ASSERT_TRUE(encoder.encode(createPackage(2), frame));
+  EXPECT_FALSE(decoder.decode(frame.data(), frame.size(), decoded));
+  EXPECT_FALSE(decoder.isSynchronized());
+  ASSERT_TRUE(encoder.encode(createPackage(3), frame));
+  EXPECT_FALSE(decoder.decode(frame.data(), frame.size(), decoded));
+  EXPECT_EQ(decoder.getNumSkippedFrames(), 2u);
+
+  encoder.requestKeyframe();
+  rtde_interface::DataPackage package = createPackage(4);
+  ASSERT_TRUE(encoder.encode(package, frame));
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size(), decoded));
+  expectDecoded(package, decoded);
+
+  // Truncated frames are rejected
+  package = createPackage(5);
+  ASSERT_TRUE(encoder.encode(package, frame));
+  EXPECT_FALSE(decoder.decode(frame.data(), frame.size() - 1, decoded));
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size(), decoded));
+  expectDecoded(package, decoded);
+}
+
+TEST_F(RTDERelayTest, field_resolutions)
+{
+  rtde_interface::RelayEncoder encoder(recipe_, 1e-3, { { "actual_q", 1e-5 } });
+  rtde_interface::RelayDecoder decoder(encoder.getHeader());
+  rtde_interface::DataPackage decoded(decoder.getCompiledRecipe());
+  std::vector<uint8_t> frame;
+  rtde_interface::DataPackage package = createPackage(17);
+  ASSERT_TRUE(encoder.encode(package, frame));
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size(), decoded));
+
+  double expected_timestamp, timestamp;
+  ASSERT_TRUE(package.getData("timestamp", expected_timestamp));
+  ASSERT_TRUE(decoded.getData("timestamp", timestamp));
+  EXPECT_NEAR(timestamp, expected_timestamp, 0.5e-3);
+  vector6d_t expected_q, actual_q;
+  ASSERT_TRUE(package.getData("actual_q", expected_q));
+  ASSERT_TRUE(decoded.getData("actual_q", actual_q));
+  EXPECT_NEAR(actual_q[2], expected_q[2], 0.5e-5);
+
+  EXPECT_THROW(rtde_interface::RelayEncoder(recipe_, 0.0), UrException);
+  EXPECT_THROW(rtde_interface::RelayEncoder(recipe_, 1e-3, { { "actual_q", -1.0 } }), UrException);
+  EXPECT_THROW(rtde_interface::RelayEncoder(recipe_, 1e-3, { { "robot_mode", 1.0 } }), UrException);
+  EXPECT_THROW(rtde_interface::RelayEncoder(recipe_, 1e-3, { { "actual_qd", 1.0 } }), UrException);
+
+  std::vector<uint8_t> header = encoder.getHeader();
+  header[0] = 'X';
+  EXPECT_THROW(rtde_interface::RelayDecoder decoder(header), UrException);
+  header = encoder.getHeader();
+  header.pop_back();
+  EXPECT_THROW(rtde_interface::RelayDecoder decoder(header), UrException);
+}
+
+TEST_F(RTDERelayTest, relay_forwards_packages_to_clients)
+{
+  const int port = 60021;
+  rtde_interface::RTDERelay relay(port, recipe_, 2);
+  rtde_interface::RTDERelayClient client("127.0.0.1", port);
+  ASSERT_TRUE(client.connect(1));
+  ASSERT_NE(client.getCompiledRecipe(), nullptr);
+  for (size_t i = 0; i < 100 && relay.getNumClients() == 0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(relay.getNumClients(), 1u);
+
+  std::atomic<bool> running(true);
+  std::thread producer([&]() {
+    for (size_t i = 0; running; ++i)
+    {
+      relay.update(createPackage(i));
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+  });
+
+  rtde_interface::DataPackage decoded(client.getCompiledRecipe());
+  double previous_timestamp = 0.0;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    ASSERT_TRUE(client.readPackage(decoded));
+    double timestamp;
+    ASSERT_TRUE(decoded.getData("timestamp", timestamp));
+    if (i > 0)
+    {
+      // Every second package is forwarded
+      EXPECT_NEAR(timestamp - previous_timestamp, 0.004, 1e-5);
+    }
+    previous_timestamp = timestamp;
+  }
+  running = false;
+  producer.join();
+  EXPECT_GT(relay.getNumSentBytes(), 0u);
+  EXPECT_EQ(relay.getNumDroppedFrames(), 0u);
+}
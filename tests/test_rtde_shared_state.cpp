@@ -0,0 +1,236 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/shared_state.h"
+
+using namespace urcl;
+
+class SharedStateTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    // Tests may run in parallel processes
+    name_ = "/urcl_shared_state_test_" + std::to_string(::getpid());
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "actual_q", "robot_mode" });
+  }
+
+  rtde_interface::DataPackage createPackage(const double timestamp)
+  {
+    rtde_interface::DataPackage package(recipe_);
+    package.initEmpty();
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { timestamp, timestamp, timestamp, timestamp, timestamp, timestamp };
+    package.setData("actual_q", actual_q);
+    int32_t robot_mode = static_cast<int32_t>(timestamp);
+    package.setData("robot_mode", robot_mode);
+    package.setRecipeID(1);
+    return package;
+  }
+
+  std::string name_;
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+};
+
+TEST_F(SharedStateTest, publish_and_read)
+{
+  rtde_interface::SharedStatePublisher publisher(name_, recipe_, 4, 2);
+  rtde_interface::SharedStateReader reader(name_);
+  EXPECT_TRUE(reader.isActive());
+  EXPECT_EQ(reader.getCompiledRecipe()->getRecipe(), recipe_->getRecipe());
+  EXPECT_EQ(reader.getProtocolVersion(), 2);
+
+  rtde_interface::DataPackage package(reader.getCompiledRecipe());
+  EXPECT_FALSE(reader.readLatest(package));
+  EXPECT_FALSE(reader.readNext(package));
+
+  const auto receive_time = rtde_interface::SharedStatePublisher::Clock::now();
+  ASSERT_TRUE(publisher.publish(createPackage(1.0), receive_time));
+  ASSERT_TRUE(publisher.publish(createPackage(2.0)));
+  EXPECT_EQ(reader.getPublishedCount(), 2u);
+
+  double timestamp;
+  ASSERT_TRUE(reader.readLatest(package));
+  ASSERT_TRUE(package.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 2.0);
+  EXPECT_EQ(package.getRecipeID(), 1);
+
+  rtde_interface::SharedStateReader::Clock::time_point read_receive_time;
+  ASSERT_TRUE(reader.readNext(package, &read_receive_time));
+  ASSERT_TRUE(package.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 1.0);
+  EXPECT_EQ(read_receive_time, receive_time);
+  int32_t robot_mode;
+  ASSERT_TRUE(package.getData("robot_mode", robot_mode));
+  EXPECT_EQ(robot_mode, 1);
+
+  ASSERT_TRUE(reader.readNext(package));
+  ASSERT_TRUE(package.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 2.0);
+  EXPECT_FALSE(reader.readNext(package));
+  EXPECT_EQ(reader.getMissedCount(), 0u);
+}
+
+TEST_F(SharedStateTest, slow_reader_misses_overwritten_packages)
+{
+  rtde_interface::SharedStatePublisher publisher(name_, recipe_, 4);
+  rtde_interface::SharedStateReader reader(name_);
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(publisher.publish(createPackage(i)));
+  }
+
+  rtde_interface::DataPackage package(reader.getCompiledRecipe());
+  double timestamp;
+  ASSERT_TRUE(reader.readNext(package));
+  ASSERT_TRUE(package.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 6.0);
+  EXPECT_EQ(reader.getMissedCount(), 6u);
+}
+
+TEST_F(SharedStateTest, invalid_usage)
+{
+  EXPECT_THROW(rtde_interface::SharedStateReader reader(name_), UrException);
+  EXPECT_THROW(rtde_interface::SharedStatePublisher publisher(name_, recipe_, 0), UrException);
+
+  auto publisher = std::make_unique<rtde_interface::SharedStatePublisher>(name_, recipe_);
+  rtde_interface::SharedStateReader reader(name_);
+
+  // Packages have to be based on the publisher's and reader's recipe
+  EXPECT_FALSE(publisher->publish(rtde_interface::DataPackage(reader.getCompiledRecipe())));
+  rtde_interface::DataPackage package(recipe_);
+  EXPECT_FALSE(reader.readLatest(package));
+
+  publisher.reset();
+  EXPECT_FALSE(reader.isActive());
+  EXPECT_THROW(rtde_interface::SharedStateReader other_reader(name_), UrException);
+}
+
+TEST_F(SharedStateTest, active_segment_is_not_replaced)
+{
+  rtde_interface::SharedStatePublisher publisher(name_, recipe_);
+  EXPECT_THROW(rtde_interface::SharedStatePublisher other_publisher(name_, recipe_), UrException);
+
+  rtde_interface::SharedStateReader reader(name_);
+  EXPECT_TRUE(reader.isActive());
+  ASSERT_TRUE(publisher.publish(createPackage(1.0)));
+  rtde_interface::DataPackage package(reader.getCompiledRecipe());
+  EXPECT_TRUE(reader.readLatest(package));
+}
+
+TEST_F(SharedStateTest, deactivated_publisher_is_replaced)
+{
+  // Like a recipe switch while a caller still references the old publisher
+  auto old_publisher = std::make_shared<rtde_interface::SharedStatePublisher>(name_, recipe_);
+  old_publisher->deactivate();
+  EXPECT_FALSE(old_publisher->publish(createPackage(1.0)));
+  auto new_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(
+      std::vector<std::string>{ "timestamp", "target_q" });
+  rtde_interface::SharedStatePublisher publisher(name_, new_recipe);
+
+  // The old publisher must not remove the segment of the new one
+  old_publisher.reset();
+  rtde_interface::SharedStateReader reader(name_);
+  EXPECT_TRUE(reader.isActive());
+  EXPECT_EQ(reader.getCompiledRecipe()->getRecipe(), new_recipe->getRecipe());
+}
+
+TEST_F(SharedStateTest, segment_of_terminated_process_is_replaced)
+{
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    // Terminates without removing the segment, as a crashing process would
+    new rtde_interface::SharedStatePublisher(name_, recipe_);
+    ::_exit(0);
+  }
+  int status;
+  ASSERT_EQ(child, ::waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+
+  rtde_interface::SharedStatePublisher publisher(name_, recipe_);
+  rtde_interface::SharedStateReader reader(name_);
+  EXPECT_TRUE(reader.isActive());
+}
+
+TEST_F(SharedStateTest, concurrent_reads_are_consistent)
+{
+  rtde_interface::SharedStatePublisher publisher(name_, recipe_, 2);
+  rtde_interface::SharedStateReader reader(name_);
+  std::atomic<bool> running(true);
+  std::thread publish_thread([&]() {
+    double i = 0;
+    while (running)
+    {
+      publisher.publish(createPackage(i++));
+    }
+  });
+
+  rtde_interface::DataPackage package(reader.getCompiledRecipe());
+  size_t num_read = 0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (num_read < 10000 && std::chrono::steady_clock::now() < deadline)
+  {
+    if (!reader.readLatest(package))
+    {
+      continue;
+    }
+    num_read++;
+    // All elements are written with the same value, a torn read would mix packages
+    double timestamp;
+    vector6d_t actual_q;
+    ASSERT_TRUE(package.getData("timestamp", timestamp));
+    ASSERT_TRUE(package.getData("actual_q", actual_q));
+    for (const double q : actual_q)
+    {
+      ASSERT_DOUBLE_EQ(q, timestamp);
+    }
+  }
+  running = false;
+  publish_thread.join();
+  EXPECT_GT(num_read, 0u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,232 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/rtde/state_cache.h"
+
+using namespace urcl;
+
+class StateCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "actual_q", "robot_mode" });
+  }
+
+  rtde_interface::DataPackage createPackage(const double timestamp)
+  {
+    rtde_interface::DataPackage package(recipe_);
+    package.initEmpty();
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { timestamp, timestamp, timestamp, timestamp, timestamp, timestamp };
+    package.setData("actual_q", actual_q);
+    int32_t robot_mode = static_cast<int32_t>(timestamp);
+    package.setData("robot_mode", robot_mode);
+    package.setRecipeID(1);
+    return package;
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+};
+
+TEST_F(StateCacheTest, update_and_read)
+{
+  rtde_interface::StateCache cache(recipe_);
+  rtde_interface::StateSnapshot snapshot = cache.createSnapshot();
+  EXPECT_FALSE(cache.read(snapshot));
+  EXPECT_FALSE(snapshot.isValid());
+  double timestamp;
+  EXPECT_FALSE(snapshot.getData("timestamp", timestamp));
+
+  const auto receive_time = rtde_interface::StateCache::Clock::now();
+  ASSERT_TRUE(cache.update(createPackage(1.0)));
+  ASSERT_TRUE(cache.update(createPackage(2.0), receive_time));
+  EXPECT_EQ(cache.getUpdateCount(), 2u);
+
+  ASSERT_TRUE(cache.read(snapshot));
+  EXPECT_TRUE(snapshot.isValid());
+  EXPECT_EQ(snapshot.getPackageNumber(), 2u);
+  EXPECT_EQ(snapshot.getReceiveTime(), receive_time);
+  EXPECT_EQ(snapshot.getRecipeID(), 1);
+  ASSERT_TRUE(snapshot.getData("timestamp", timestamp));
+  EXPECT_DOUBLE_EQ(timestamp, 2.0);
+
+  const auto actual_q_handle = recipe_->getFieldHandle<vector6d_t>("actual_q");
+  vector6d_t actual_q;
+  ASSERT_TRUE(snapshot.getData(actual_q_handle, actual_q));
+  EXPECT_DOUBLE_EQ(actual_q[5], 2.0);
+  EXPECT_FALSE(snapshot.getData("actual_qd", actual_q));
+
+  rtde_interface::DataPackage package(recipe_);
+  ASSERT_TRUE(snapshot.fill(package));
+  int32_t robot_mode;
+  ASSERT_TRUE(package.getData("robot_mode", robot_mode));
+  EXPECT_EQ(robot_mode, 2);
+  EXPECT_EQ(package.getRecipeID(), 1);
+}
+
+TEST_F(StateCacheTest, predict_joint_state)
+{
+  auto recipe = std::make_shared<const rtde_interface::CompiledRecipe>(
+      std::vector<std::string>{ "timestamp", "actual_q", "actual_qd" });
+  auto create_package = [&recipe](const double timestamp, const double q, const double qd) {
+    rtde_interface::DataPackage package(recipe);
+    package.initEmpty();
+    package.setData("timestamp", timestamp);
+    vector6d_t actual_q = { q, q, q, q, q, q };
+    package.setData("actual_q", actual_q);
+    vector6d_t actual_qd = { qd, qd, qd, qd, qd, qd };
+    package.setData("actual_qd", actual_qd);
+    return package;
+  };
+
+  rtde_interface::StateCache cache(recipe);
+  rtde_interface::StateSnapshot snapshot = cache.createSnapshot();
+  const auto receive_time = rtde_interface::StateCache::Clock::now();
+  vector6d_t q;
+  vector6d_t qd;
+  EXPECT_FALSE(snapshot.predictJointState(receive_time, q, qd));
+
+  // Without a previous package, no acceleration is known
+  ASSERT_TRUE(cache.update(create_package(1.0, 0.5, 1.0), receive_time));
+  ASSERT_TRUE(cache.read(snapshot));
+  ASSERT_TRUE(snapshot.predictJointState(receive_time + std::chrono::milliseconds(10), q, qd,
+                                         rtde_interface::PredictionModel::CONSTANT_ACCELERATION));
+  EXPECT_NEAR(q[0], 0.51, 1e-9);
+  EXPECT_NEAR(qd[0], 1.0, 1e-9);
+
+  // The velocity increased by 0.02 rad/s within 2 ms
+  ASSERT_TRUE(cache.update(create_package(1.002, 0.502, 1.02), receive_time));
+  ASSERT_TRUE(cache.read(snapshot));
+  ASSERT_TRUE(snapshot.predictJointState(receive_time + std::chrono::milliseconds(10), q, qd));
+  EXPECT_NEAR(q[3], 0.502 + 1.02 * 0.01, 1e-9);
+  EXPECT_NEAR(qd[3], 1.02, 1e-9);
+
+  ASSERT_TRUE(snapshot.predictJointState(receive_time + std::chrono::milliseconds(8), q, qd,
+                                         rtde_interface::PredictionModel::CONSTANT_ACCELERATION,
+                                         std::chrono::milliseconds(2)));
+  EXPECT_NEAR(q[5], 0.502 + 1.02 * 0.01 + 0.5 * 10.0 * 0.01 * 0.01, 1e-9);
+  EXPECT_NEAR(qd[5], 1.02 + 10.0 * 0.01, 1e-9);
+
+  // The state isn't predicted into the past
+  ASSERT_TRUE(snapshot.predictJointState(receive_time - std::chrono::milliseconds(10), q, qd));
+  EXPECT_NEAR(q[0], 0.502, 1e-9);
+
+  // The default recipe doesn't contain actual_qd
+  rtde_interface::StateCache other_cache(recipe_);
+  rtde_interface::StateSnapshot other_snapshot = other_cache.createSnapshot();
+  ASSERT_TRUE(other_cache.update(createPackage(1.0)));
+  ASSERT_TRUE(other_cache.read(other_snapshot));
+  EXPECT_FALSE(other_snapshot.predictJointState(receive_time, q, qd));
+}
+
+TEST_F(StateCacheTest, packages_of_other_recipes_are_rejected)
+{
+  rtde_interface::StateCache cache(recipe_);
+  auto other_recipe = std::make_shared<const rtde_interface::CompiledRecipe>(recipe_->getRecipe());
+  rtde_interface::DataPackage package(other_recipe);
+  package.initEmpty();
+  EXPECT_FALSE(cache.update(package));
+  EXPECT_EQ(cache.getUpdateCount(), 0u);
+
+  ASSERT_TRUE(cache.update(createPackage(1.0)));
+  rtde_interface::StateSnapshot snapshot(other_recipe);
+  EXPECT_FALSE(cache.read(snapshot));
+  rtde_interface::StateSnapshot own_snapshot = cache.createSnapshot();
+  ASSERT_TRUE(cache.read(own_snapshot));
+  EXPECT_FALSE(own_snapshot.fill(package));
+}
+
+TEST_F(StateCacheTest, concurrent_readers_see_consistent_packages)
+{
+  rtde_interface::StateCache cache(recipe_);
+  std::vector<rtde_interface::DataPackage> packages;
+  const size_t num_packages = 20000;
+  for (size_t i = 1; i <= num_packages; ++i)
+  {
+    packages.push_back(createPackage(static_cast<double>(i)));
+  }
+
+  std::atomic<bool> writing(true);
+  std::atomic<size_t> num_inconsistent(0);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; ++i)
+  {
+    readers.emplace_back([&]() {
+      rtde_interface::StateSnapshot snapshot = cache.createSnapshot();
+      const auto timestamp_handle = recipe_->getFieldHandle<double>("timestamp");
+      const auto actual_q_handle = recipe_->getFieldHandle<vector6d_t>("actual_q");
+      uint64_t last_package_number = 0;
+      while (writing)
+      {
+        if (!cache.read(snapshot))
+        {
+          continue;
+        }
+        double timestamp;
+        vector6d_t actual_q;
+        snapshot.getData(timestamp_handle, timestamp);
+        snapshot.getData(actual_q_handle, actual_q);
+        for (const double q : actual_q)
+        {
+          if (q != timestamp)
+          {
+            num_inconsistent++;
+          }
+        }
+        if (timestamp != static_cast<double>(snapshot.getPackageNumber()) ||
+            snapshot.getPackageNumber() < last_package_number)
+        {
+          num_inconsistent++;
+        }
+        last_package_number = snapshot.getPackageNumber();
+      }
+    });
+  }
+
+  for (const auto& package : packages)
+  {
+    ASSERT_TRUE(cache.update(package));
+  }
+  writing = false;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+  EXPECT_EQ(num_inconsistent, 0u);
+  EXPECT_EQ(cache.getUpdateCount(), num_packages);
+}
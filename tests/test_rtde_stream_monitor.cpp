@@ -0,0 +1,153 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ur_client_library/rtde/stream_monitor.h"
+
+using namespace urcl;
+
+class StreamMonitorTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "robot_mode" });
+    package_.reset(new rtde_interface::DataPackage(recipe_, 2));
+    package_->initEmpty();
+    monitor_.setRecipe(*recipe_);
+    monitor_.setTargetFrequency(500.0);
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  // Feeds a package with the given robot timestamp, arriving at the given time after start
+  void receive(double timestamp, const std::chrono::microseconds arrival)
+  {
+    package_->setData("timestamp", timestamp);
+    monitor_.update(*package_, start_ + arrival);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+  rtde_interface::StreamMonitor monitor_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+TEST_F(StreamMonitorTest, regular_stream)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    receive(i * 0.002, std::chrono::microseconds(i * 2000));
+  }
+  rtde_interface::StreamStatistics statistics = monitor_.getStatistics();
+  EXPECT_EQ(statistics.num_packages, 100u);
+  EXPECT_EQ(statistics.num_missed, 0u);
+  EXPECT_EQ(statistics.num_late, 0u);
+  EXPECT_EQ(statistics.num_overflows, 0u);
+  EXPECT_EQ(statistics.max_arrival_interval.count(), 2000);
+  EXPECT_EQ(statistics.max_jitter.count(), 0);
+}
+
+TEST_F(StreamMonitorTest, detect_missed_and_late_packages)
+{
+  std::vector<rtde_interface::StreamViolation> violations;
+  monitor_.setViolationCallback(
+      [&violations](const rtde_interface::StreamViolation violation, const rtde_interface::StreamStatistics&) {
+        violations.push_back(violation);
+      });
+
+  receive(0.000, std::chrono::microseconds(0));
+  receive(0.002, std::chrono::microseconds(2000));
+  // Two cycles of the robot never arrived
+  receive(0.008, std::chrono::microseconds(8000));
+  // The next cycle arrived late, but nothing is missing
+  receive(0.010, std::chrono::microseconds(12000));
+  // A slightly delayed package is within the tolerance
+  receive(0.012, std::chrono::microseconds(14500));
+
+  rtde_interface::StreamStatistics statistics = monitor_.getStatistics();
+  EXPECT_EQ(statistics.num_packages, 5u);
+  EXPECT_EQ(statistics.num_missed, 2u);
+  EXPECT_EQ(statistics.num_late, 1u);
+  EXPECT_EQ(statistics.max_arrival_interval.count(), 6000);
+  EXPECT_EQ(statistics.max_jitter.count(), 4000);
+  ASSERT_EQ(violations.size(), 2u);
+  EXPECT_EQ(violations[0], rtde_interface::StreamViolation::MISSED_PACKAGES);
+  EXPECT_EQ(violations[1], rtde_interface::StreamViolation::LATE_PACKAGE);
+
+  monitor_.reportOverflow();
+  EXPECT_EQ(monitor_.getStatistics().num_overflows, 1u);
+  EXPECT_EQ(violations.back(), rtde_interface::StreamViolation::PIPELINE_OVERFLOW);
+}
+
+TEST_F(StreamMonitorTest, late_tolerance)
+{
+  monitor_.setLateTolerance(3.0);
+  receive(0.000, std::chrono::microseconds(0));
+  receive(0.004, std::chrono::microseconds(5000));
+  rtde_interface::StreamStatistics statistics = monitor_.getStatistics();
+  EXPECT_EQ(statistics.num_missed, 0u);
+  EXPECT_EQ(statistics.num_late, 0u);
+}
+
+TEST_F(StreamMonitorTest, restart_and_reset)
+{
+  receive(0.000, std::chrono::microseconds(0));
+  receive(0.002, std::chrono::microseconds(2000));
+
+  // A pause doesn't count as missed packages
+  monitor_.restart();
+  receive(1.000, std::chrono::microseconds(1000000));
+  rtde_interface::StreamStatistics statistics = monitor_.getStatistics();
+  EXPECT_EQ(statistics.num_packages, 3u);
+  EXPECT_EQ(statistics.num_missed, 0u);
+  EXPECT_EQ(statistics.num_late, 0u);
+
+  monitor_.reset();
+  statistics = monitor_.getStatistics();
+  EXPECT_EQ(statistics.num_packages, 0u);
+  EXPECT_EQ(statistics.max_arrival_interval.count(), 0);
+}
+
+TEST_F(StreamMonitorTest, recipe_without_timestamp)
+{
+  auto recipe = std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "robot_mode" });
+  EXPECT_THROW(monitor_.setRecipe(*recipe), UrException);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/stream_watchdog.h"
+
+using namespace urcl;
+
+class StreamWatchdogTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    recipe_ = std::make_shared<const rtde_interface::CompiledRecipe>(
+        std::vector<std::string>{ "timestamp", "robot_mode" });
+    package_.reset(new rtde_interface::DataPackage(recipe_, 2));
+    package_->initEmpty();
+    watchdog_.setRecipe(*recipe_);
+    watchdog_.setTargetFrequency(500.0);
+    watchdog_.setStaleCallback([this](bool stale) {
+      if (stale)
+      {
+        stale_calls_++;
+      }
+      else
+      {
+        fresh_calls_++;
+      }
+    });
+    watchdog_.start();
+  }
+
+  void receive(double timestamp)
+  {
+    package_->setData("timestamp", timestamp);
+    watchdog_.update(*package_, std::chrono::steady_clock::now());
+  }
+
+  // Waits for the stale callback, which is called from the watchdog's thread
+  bool waitForStaleCalls(const int count, const std::chrono::milliseconds timeout = std::chrono::milliseconds(500))
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (stale_calls_ < count && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return stale_calls_ >= count;
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  std::unique_ptr<rtde_interface::DataPackage> package_;
+  std::atomic<int> stale_calls_{ 0 };
+  std::atomic<int> fresh_calls_{ 0 };
+  rtde_interface::StreamWatchdog watchdog_;
+};
+
+TEST_F(StreamWatchdogTest, timeout_from_periods)
+{
+  EXPECT_EQ(watchdog_.getTimeout(), std::chrono::milliseconds(6));
+  watchdog_.setMissedPeriods(5);
+  EXPECT_EQ(watchdog_.getTimeout(), std::chrono::milliseconds(10));
+  EXPECT_THROW(watchdog_.setMissedPeriods(0), UrException);
+  EXPECT_THROW(watchdog_.setTargetFrequency(0.0), UrException);
+}
+
+TEST_F(StreamWatchdogTest, not_armed_before_first_package)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(watchdog_.isStale());
+  EXPECT_EQ(stale_calls_, 0);
+}
+
+TEST_F(StreamWatchdogTest, detect_stopped_stream)
+{
+  const auto start = std::chrono::steady_clock::now();
+  receive(0.0);
+  ASSERT_TRUE(waitForStaleCalls(1));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, watchdog_.getTimeout());
+  EXPECT_TRUE(watchdog_.isStale());
+  EXPECT_EQ(watchdog_.getNumStaleEvents(), 1u);
+
+  // A fresh package ends the stale state right away
+  receive(0.002);
+  EXPECT_FALSE(watchdog_.isStale());
+  EXPECT_EQ(fresh_calls_, 1);
+
+  ASSERT_TRUE(waitForStaleCalls(2));
+  EXPECT_EQ(watchdog_.getNumStaleEvents(), 2u);
+}
+
+TEST_F(StreamWatchdogTest, repeated_timestamp_is_not_fresh)
+{
+  receive(0.0);
+  ASSERT_TRUE(waitForStaleCalls(1));
+  receive(0.0);
+  EXPECT_TRUE(watchdog_.isStale());
+  EXPECT_EQ(fresh_calls_, 0);
+}
+
+TEST_F(StreamWatchdogTest, regular_stream_stays_fresh)
+{
+  watchdog_.setMissedPeriods(50);
+  for (int i = 0; i < 20; ++i)
+  {
+    receive(i * 0.002);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  EXPECT_FALSE(watchdog_.isStale());
+  EXPECT_EQ(stale_calls_, 0);
+}
+
+TEST_F(StreamWatchdogTest, stopped_watchdog_stays_quiet)
+{
+  receive(0.0);
+  watchdog_.stop();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(stale_calls_, 0);
+
+  watchdog_.start();
+  receive(1.0);
+  EXPECT_TRUE(waitForStaleCalls(1));
+}
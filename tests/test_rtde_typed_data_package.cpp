@@ -0,0 +1,119 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+#include "ur_client_library/rtde/typed_data_package.h"
+
+using namespace urcl;
+
+struct JointState
+{
+  double timestamp;
+  vector6d_t actual_q;
+
+  static constexpr auto fields()
+  {
+    return std::make_tuple(rtde_interface::RecipeField("timestamp", &JointState::timestamp),
+                           rtde_interface::RecipeField("actual_q", &JointState::actual_q));
+  }
+};
+
+// Protocol version 2 data package with recipe { "timestamp", "actual_q" } and recipe id 1
+static uint8_t g_data_package[] = { 0x01, 0x40, 0xd0, 0x75, 0x8c, 0x49, 0xba, 0x5e, 0x35, 0xbf, 0xf9, 0x9c, 0x77,
+                                    0xd1, 0x10, 0xb4, 0x60, 0xbf, 0xfb, 0xa2, 0x33, 0xd1, 0x10, 0xb4, 0x60, 0xc0,
+                                    0x01, 0x9f, 0xbe, 0x68, 0x88, 0x5a, 0x30, 0xbf, 0xe9, 0xdb, 0x22, 0xa2, 0x21,
+                                    0x68, 0xc0, 0x3f, 0xf9, 0x85, 0x87, 0xa0, 0x00, 0x00, 0x00, 0xbf, 0x9f, 0xbe,
+                                    0x74, 0x44, 0x2d, 0x18, 0x00 };
+
+TEST(rtde_typed_data_package, get_recipe)
+{
+  std::vector<std::string> expected_recipe{ "timestamp", "actual_q" };
+  EXPECT_EQ(rtde_interface::TypedDataPackage<JointState>::getRecipe(), expected_recipe);
+}
+
+TEST(rtde_typed_data_package, matches_compiled_recipe)
+{
+  rtde_interface::CompiledRecipe matching_recipe({ "timestamp", "actual_q" });
+  EXPECT_TRUE(rtde_interface::TypedDataPackage<JointState>::matches(matching_recipe));
+
+  rtde_interface::CompiledRecipe wrong_order({ "actual_q", "timestamp" });
+  EXPECT_FALSE(rtde_interface::TypedDataPackage<JointState>::matches(wrong_order));
+
+  rtde_interface::CompiledRecipe wrong_type({ "timestamp", "actual_qd_unknown" });
+  EXPECT_FALSE(rtde_interface::TypedDataPackage<JointState>::matches(wrong_type));
+
+  rtde_interface::CompiledRecipe additional_field({ "timestamp", "actual_q", "speed_scaling" });
+  EXPECT_FALSE(rtde_interface::TypedDataPackage<JointState>::matches(additional_field));
+}
+
+TEST(rtde_typed_data_package, parse_pkg_protocolv2)
+{
+  rtde_interface::TypedDataPackage<JointState> package(2);
+  comm::BinParser bp(g_data_package, sizeof(g_data_package));
+  EXPECT_TRUE(package.parseWith(bp));
+
+  vector6d_t expected_q = { -1.6007, -1.7271, -2.203, -0.808, 1.5951, -0.031 };
+  double abs = 1e-4;
+  for (size_t i = 0; i < expected_q.size(); ++i)
+  {
+    EXPECT_NEAR(expected_q[i], package.data.actual_q[i], abs);
+  }
+  EXPECT_NEAR(16854.1919, package.data.timestamp, abs);
+}
+
+TEST(rtde_typed_data_package, parser_uses_factory)
+{
+  std::vector<uint8_t> raw_data = { 0x00, 0x00, 0x55 };
+  raw_data.insert(raw_data.end(), std::begin(g_data_package), std::end(g_data_package));
+  raw_data[1] = static_cast<uint8_t>(raw_data.size());
+
+  rtde_interface::RTDEParser parser(rtde_interface::TypedDataPackage<JointState>::getRecipe());
+  parser.setProtocolVersion(2);
+  parser.setDataPackageFactory([]() { return std::make_unique<rtde_interface::TypedDataPackage<JointState>>(2); });
+
+  comm::BinParser bp(raw_data.data(), raw_data.size());
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  ASSERT_TRUE(parser.parse(bp, products));
+  ASSERT_EQ(products.size(), 1);
+
+  auto* package = dynamic_cast<rtde_interface::TypedDataPackage<JointState>*>(products[0].get());
+  ASSERT_NE(package, nullptr);
+  EXPECT_NEAR(16854.1919, package->data.timestamp, 1e-4);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
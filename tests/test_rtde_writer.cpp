@@ -30,6 +30,7 @@
 
 #include <gtest/gtest.h>
 #include <condition_variable>
+#include <thread>
 
 #include <ur_client_library/rtde/rtde_writer.h>
 #include <ur_client_library/comm/tcp_server.h>
@@ -77,6 +78,10 @@ protected:
     bp.parse(type);
     bp.parse(recipe_id);
     parseMessage(bp);
+    if (std::get<uint32_t>(parsed_data_["speed_slider_mask"]) != 0)
+    {
+      speed_slider_history_.push_back(std::get<double>(parsed_data_["speed_slider_fraction"]));
+    }
     message_cv_.notify_one();
     message_callback_ = true;
   }
@@ -124,13 +129,32 @@ protected:
     "input_bit_register_65",
     "input_int_register_25",
     "input_double_register_25",
+    "input_int_register_26",
   };
   std::unique_ptr<rtde_interface::RTDEWriter> writer_;
   std::unique_ptr<comm::TCPServer> server_;
   std::unique_ptr<comm::URStream<rtde_interface::RTDEPackage>> stream_;
   std::unordered_map<std::string, input_types> parsed_data_;
 
+  std::vector<double> getSpeedSliderHistory()
+  {
+    std::lock_guard<std::mutex> lk(message_mutex_);
+    return speed_slider_history_;
+  }
+
+  bool waitForRampEnd(const rtde_interface::RampTarget target, const std::chrono::milliseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (writer_->isRampActive(target) && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return !writer_->isRampActive(target);
+  }
+
 private:
+  std::vector<double> speed_slider_history_;
+
   void parseMessage(comm::BinParser bp)
   {
     for (auto& item : input_recipe_)
@@ -164,6 +188,7 @@ private:
     { "input_bit_register_65", bool() },
     { "input_int_register_25", int32_t() },
     { "input_double_register_25", double() },
+    { "input_int_register_26", int32_t() },
   };
 };
 
@@ -260,6 +285,59 @@ TEST_F(RTDEWriterTest, send_tool_digital_output)
   EXPECT_FALSE(writer_->sendToolDigitalOutput(pin, send_pin_value));
 }
 
+TEST_F(RTDEWriterTest, coalesce_digital_outputs_within_cycle)
+{
+  writer_.reset(new rtde_interface::RTDEWriter(stream_.get(), input_recipe_));
+  writer_->init(1, 10);
+
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 1));
+  ASSERT_TRUE(waitForMessageCallback(1000));
+
+  // All of these should be sent in the next cycle's package
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(0, true));
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(1, false));
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(2, true));
+  ASSERT_TRUE(waitForMessageCallback(1000));
+
+  uint8_t received_mask = std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]);
+  uint8_t received_value = std::get<uint8_t>(parsed_data_["standard_digital_output"]);
+  EXPECT_EQ(received_mask, 7);
+  EXPECT_EQ(received_value & received_mask, 5);
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_25"]), 1);
+}
+
+TEST_F(RTDEWriterTest, transaction_sends_one_package)
+{
+  writer_->setFlushPolicy(rtde_interface::FlushPolicy::IMMEDIATE);
+
+  writer_->beginTransaction();
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 42));
+  EXPECT_TRUE(writer_->sendInputDoubleRegister(25, 2.5));
+  EXPECT_TRUE(writer_->sendToolDigitalOutput(1, true));
+  EXPECT_FALSE(waitForMessageCallback(200));
+
+  EXPECT_TRUE(writer_->commitTransaction());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_25"]), 42);
+  EXPECT_EQ(std::get<double>(parsed_data_["input_double_register_25"]), 2.5);
+  EXPECT_EQ(std::get<uint8_t>(parsed_data_["tool_digital_output_mask"]), 2);
+
+  EXPECT_FALSE(writer_->commitTransaction());
+}
+
+TEST_F(RTDEWriterTest, flush_policy_on_commit)
+{
+  writer_->setFlushPolicy(rtde_interface::FlushPolicy::ON_COMMIT);
+
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 7));
+  EXPECT_FALSE(waitForMessageCallback(200));
+
+  writer_->beginTransaction();
+  EXPECT_TRUE(writer_->commitTransaction());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_25"]), 7);
+}
+
 TEST_F(RTDEWriterTest, send_standard_analog_output_unknown_domain)
 {
   waitForMessageCallback(1000);
@@ -441,6 +519,109 @@ TEST_F(RTDEWriterTest, send_input_double_register)
   EXPECT_FALSE(writer_->sendInputDoubleRegister(register_id, send_register_value));
 }
 
+TEST_F(RTDEWriterTest, register_bank_owns_registers)
+{
+  auto bank = writer_->createInputRegisterBank({ "input_int_register_25", "input_double_register_25" });
+  EXPECT_EQ(bank->getRegisters().size(), 2u);
+  EXPECT_FALSE(writer_->sendInputIntRegister(25, 1));
+  EXPECT_FALSE(writer_->sendInputDoubleRegister(25, 1.0));
+  EXPECT_TRUE(writer_->sendInputIntRegister(26, 1));
+
+  EXPECT_THROW(writer_->createInputRegisterBank({ "input_int_register_26", "input_int_register_25" }), UrException);
+  EXPECT_THROW(writer_->createInputRegisterBank({ "input_int_register_30" }), UrException);
+  EXPECT_THROW(writer_->createInputRegisterBank({ "speed_slider_fraction" }), UrException);
+  // A failed bank doesn't keep any registers
+  EXPECT_TRUE(writer_->sendInputIntRegister(26, 2));
+
+  EXPECT_TRUE(bank->setIntRegister(25, 3));
+  EXPECT_FALSE(bank->setIntRegister(26, 3));
+  EXPECT_FALSE(bank->setBitRegister(65, true));
+  EXPECT_FALSE(bank->setDoubleRegister(48, 1.0));
+
+  bank.reset();
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 4));
+}
+
+TEST_F(RTDEWriterTest, register_banks_are_sent_together)
+{
+  auto bank = writer_->createInputRegisterBank({ "input_int_register_25", "input_double_register_25" });
+  auto other_bank = writer_->createInputRegisterBank({ "input_int_register_26", "input_bit_register_65" });
+
+  writer_->beginTransaction();
+  EXPECT_TRUE(bank->setIntRegister(25, 42));
+  EXPECT_TRUE(bank->setDoubleRegister(25, 2.5));
+  bank->publish();
+  EXPECT_TRUE(other_bank->setIntRegister(26, 7));
+  EXPECT_TRUE(other_bank->setBitRegister(65, true));
+  other_bank->publish();
+  EXPECT_TRUE(writer_->commitTransaction());
+
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_25"]), 42);
+  EXPECT_EQ(std::get<double>(parsed_data_["input_double_register_25"]), 2.5);
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_26"]), 7);
+  EXPECT_EQ(std::get<bool>(parsed_data_["input_bit_register_65"]), true);
+
+  // Registers not staged again keep their published values
+  EXPECT_TRUE(bank->setIntRegister(25, 43));
+  bank->publish();
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_25"]), 43);
+  EXPECT_EQ(std::get<double>(parsed_data_["input_double_register_25"]), 2.5);
+  EXPECT_EQ(std::get<int32_t>(parsed_data_["input_int_register_26"]), 7);
+}
+
+TEST_F(RTDEWriterTest, speed_slider_ramp)
+{
+  ASSERT_TRUE(writer_->startRamp(rtde_interface::RampTarget::SPEED_SLIDER, 0.2, 0.8, std::chrono::milliseconds(100)));
+  EXPECT_TRUE(writer_->isRampActive(rtde_interface::RampTarget::SPEED_SLIDER));
+  ASSERT_TRUE(waitForRampEnd(rtde_interface::RampTarget::SPEED_SLIDER, std::chrono::seconds(1)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  const std::vector<double> history = getSpeedSliderHistory();
+  // One package per ramp period, packages arriving together are only parsed once
+  ASSERT_GT(history.size(), 5u);
+  EXPECT_GE(history.front(), 0.2);
+  EXPECT_DOUBLE_EQ(history.back(), 0.8);
+  for (size_t i = 1; i < history.size(); ++i)
+  {
+    EXPECT_GE(history[i], history[i - 1]);
+  }
+}
+
+TEST_F(RTDEWriterTest, analog_output_smooth_ramp)
+{
+  ASSERT_TRUE(writer_->startRamp(rtde_interface::RampTarget::STANDARD_ANALOG_OUTPUT_1, 1.0, 0.0,
+                                 std::chrono::milliseconds(20), rtde_interface::RampProfile::SMOOTH));
+  ASSERT_TRUE(waitForRampEnd(rtde_interface::RampTarget::STANDARD_ANALOG_OUTPUT_1, std::chrono::seconds(1)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_DOUBLE_EQ(std::get<double>(parsed_data_["standard_analog_output_1"]), 0.0);
+  EXPECT_EQ(std::get<uint8_t>(parsed_data_["standard_analog_output_mask"]), 2);
+}
+
+TEST_F(RTDEWriterTest, cancel_ramp)
+{
+  ASSERT_TRUE(writer_->startRamp(rtde_interface::RampTarget::SPEED_SLIDER, 0.0, 1.0, std::chrono::seconds(10)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  writer_->cancelRamp(rtde_interface::RampTarget::SPEED_SLIDER);
+  ASSERT_TRUE(waitForRampEnd(rtde_interface::RampTarget::SPEED_SLIDER, std::chrono::seconds(1)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  const size_t num_packages = getSpeedSliderHistory().size();
+  ASSERT_GT(num_packages, 0u);
+  EXPECT_LT(getSpeedSliderHistory().back(), 0.1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(getSpeedSliderHistory().size(), num_packages);
+}
+
+TEST_F(RTDEWriterTest, invalid_ramp_fails)
+{
+  EXPECT_FALSE(writer_->startRamp(rtde_interface::RampTarget::SPEED_SLIDER, 0.0, 1.5, std::chrono::seconds(1)));
+  EXPECT_FALSE(writer_->startRamp(rtde_interface::RampTarget::SPEED_SLIDER, -0.1, 1.0, std::chrono::seconds(1)));
+  EXPECT_FALSE(writer_->startRamp(rtde_interface::RampTarget::SPEED_SLIDER, 0.0, 1.0, std::chrono::milliseconds(-1)));
+  EXPECT_FALSE(writer_->isRampActive(rtde_interface::RampTarget::SPEED_SLIDER));
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
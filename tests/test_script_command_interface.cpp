@@ -29,10 +29,13 @@
 // -- END LICENSE BLOCK ------------------------------------------------
 
 #include <gtest/gtest.h>
+
 #include <iterator>
+#include <limits>
 #include <numeric>
 
 #include <ur_client_library/control/script_command_interface.h>
+#include <ur_client_library/exceptions.h>
 #include <ur_client_library/comm/tcp_socket.h>
 
 using namespace urcl;
@@ -64,11 +67,17 @@ protected:
 
     void readMessage(int32_t& command, std::vector<int32_t>& message)
     {
-      // Max message length is 28
-      uint8_t buf[sizeof(int32_t) * 28];
+      int32_t sequence_number;
+      readMessage(command, message, sequence_number);
+    }
+
+    void readMessage(int32_t& command, std::vector<int32_t>& message, int32_t& sequence_number)
+    {
+      // Messages have 29 fields, the last one holding the sequence number
+      uint8_t buf[sizeof(int32_t) * 29];
       uint8_t* b_pos = buf;
       size_t read = 0;
-      size_t remainder = sizeof(int32_t) * 28;
+      size_t remainder = sizeof(int32_t) * 29;
       while (remainder > 0)
       {
         if (!TCPSocket::read(b_pos, remainder, read))
@@ -82,7 +91,7 @@ protected:
 
       // Reset buffer pos for parsing
       b_pos = buf;
-      uint8_t* b_end = b_pos + read;
+      uint8_t* b_end = b_pos + sizeof(int32_t) * 28;
 
       // Decode command signal
       int32_t val;
@@ -97,13 +106,16 @@ protected:
         message.push_back(be32toh(val));
         b_pos += sizeof(int32_t);
       }
+
+      std::memcpy(&val, b_end, sizeof(int32_t));
+      sequence_number = be32toh(val);
     }
   };
 
   void SetUp()
   {
-    script_command_interface_.reset(new control::ScriptCommandInterface(50004));
-    client_.reset(new Client(50004));
+    script_command_interface_.reset(new control::ScriptCommandInterface(0));
+    client_.reset(new Client(script_command_interface_->getPort()));
   }
 
   void TearDown()
@@ -382,6 +394,179 @@ TEST_F(ScriptCommandInterfaceTest, test_tool_contact_callback)
   EXPECT_EQ(toUnderlying(received_result_), toUnderlying(send_result));
 }
 
+TEST_F(ScriptCommandInterfaceTest, test_command_acknowledgement)
+{
+  waitForClientConnection();
+
+  std::future<bool> acknowledgement = script_command_interface_->zeroFTSensorAsync();
+  int32_t command;
+  std::vector<int32_t> message;
+  int32_t sequence_number;
+  client_->readMessage(command, message, sequence_number);
+  EXPECT_EQ(command, 0);
+  EXPECT_GT(sequence_number, 0);
+  EXPECT_EQ(acknowledgement.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  client_->send(-sequence_number);
+  ASSERT_EQ(acknowledgement.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(acknowledgement.get());
+}
+
+TEST_F(ScriptCommandInterfaceTest, test_pipelined_commands)
+{
+  waitForClientConnection();
+  script_command_interface_->setToolContactResultCallback(
+      std::bind(&ScriptCommandInterfaceTest::handleToolContactResult, this, std::placeholders::_1));
+
+  vector3d_t cog = { 0.2, 0.3, 0.1 };
+  std::future<bool> payload = script_command_interface_->setPayloadAsync(1.0, &cog);
+  std::future<bool> voltage = script_command_interface_->setToolVoltageAsync(ToolVoltage::_24V);
+  std::future<bool> tool_contact = script_command_interface_->endToolContactAsync();
+
+  std::vector<int32_t> sequence_numbers(3);
+  for (auto& sequence_number : sequence_numbers)
+  {
+    int32_t command;
+    std::vector<int32_t> message;
+    client_->readMessage(command, message, sequence_number);
+  }
+  EXPECT_LT(sequence_numbers[0], sequence_numbers[1]);
+  EXPECT_LT(sequence_numbers[1], sequence_numbers[2]);
+
+  client_->send(-sequence_numbers[0]);
+  ASSERT_EQ(payload.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(payload.get());
+  EXPECT_EQ(voltage.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  // Tool contact results are still passed to the callback
+  client_->send(toUnderlying(control::ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_CANCELED));
+  EXPECT_TRUE(waitToolContactResult(control::ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_CANCELED));
+
+  // Acknowledging a later command fails the earlier ones not acknowledged
+  client_->send(-sequence_numbers[2]);
+  ASSERT_EQ(tool_contact.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(tool_contact.get());
+  ASSERT_EQ(voltage.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_FALSE(voltage.get());
+}
+
+TEST_F(ScriptCommandInterfaceTest, test_command_batch)
+{
+  waitForClientConnection();
+
+  control::ScriptCommandInterface::Batch batch;
+  vector3d_t cog = { 0.2, 0.3, 0.1 };
+  batch.setPayload(1.0, &cog);
+  batch.setToolVoltage(ToolVoltage::_24V);
+  batch.zeroFTSensor();
+  ASSERT_EQ(batch.size(), 3u);
+  std::future<bool> acknowledgement = script_command_interface_->sendBatchAsync(batch);
+
+  // The header carries the number of commands and the batch's sequence number
+  int32_t command;
+  std::vector<int32_t> message;
+  int32_t sequence_number;
+  client_->readMessage(command, message, sequence_number);
+  EXPECT_EQ(command, 7);
+  EXPECT_EQ(message[0], 3);
+  EXPECT_GT(sequence_number, 0);
+
+  const std::vector<int32_t> expected_commands = { 1, 2, 0 };
+  for (const int32_t expected_command : expected_commands)
+  {
+    std::vector<int32_t> batch_message;
+    int32_t batch_sequence_number;
+    client_->readMessage(command, batch_message, batch_sequence_number);
+    EXPECT_EQ(command, expected_command);
+    EXPECT_EQ(batch_sequence_number, 0);
+    if (expected_command == 1)
+    {
+      EXPECT_EQ(batch_message[0], 1.0 * script_command_interface_->MULT_JOINTSTATE);
+    }
+    else if (expected_command == 2)
+    {
+      EXPECT_EQ(batch_message[0] / script_command_interface_->MULT_JOINTSTATE, 24);
+    }
+  }
+
+  client_->send(-sequence_number);
+  ASSERT_EQ(acknowledgement.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(acknowledgement.get());
+
+  // An empty batch isn't sent at all
+  batch.clear();
+  EXPECT_TRUE(script_command_interface_->sendBatch(batch));
+
+  for (size_t i = 0; i < control::ScriptCommandInterface::Batch::MAX_COMMANDS; ++i)
+  {
+    batch.endForceMode();
+  }
+  EXPECT_THROW(batch.endForceMode(), UrException);
+}
+
+TEST_F(ScriptCommandInterfaceTest, test_disconnect_fails_pending_commands)
+{
+  waitForClientConnection();
+
+  std::future<bool> acknowledgement = script_command_interface_->endForceModeAsync();
+  int32_t command;
+  std::vector<int32_t> message;
+  client_->readMessage(command, message);
+
+  client_->close();
+  ASSERT_EQ(acknowledgement.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_FALSE(acknowledgement.get());
+
+  // Without a robot connected, commands fail right away
+  acknowledgement = script_command_interface_->startToolContactAsync();
+  ASSERT_EQ(acknowledgement.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_FALSE(acknowledgement.get());
+  EXPECT_FALSE(script_command_interface_->startToolContact());
+}
+
+TEST_F(ScriptCommandInterfaceTest, test_sequence_number_wrap_around)
+{
+  class WrappingScriptCommandInterface : public control::ScriptCommandInterface
+  {
+  public:
+    using ScriptCommandInterface::ScriptCommandInterface;
+    using ScriptCommandInterface::setNextSequenceNumber;
+  };
+  client_->close();
+  waitForClientConnection(false);
+  auto script_command_interface = new WrappingScriptCommandInterface(0);
+  script_command_interface->setNextSequenceNumber(std::numeric_limits<int32_t>::max() - 1);
+  script_command_interface_.reset(script_command_interface);
+  client_.reset(new Client(script_command_interface_->getPort()));
+  waitForClientConnection();
+
+  std::vector<std::future<bool>> acknowledgements;
+  acknowledgements.push_back(script_command_interface_->zeroFTSensorAsync());
+  acknowledgements.push_back(script_command_interface_->endForceModeAsync());
+  acknowledgements.push_back(script_command_interface_->endToolContactAsync());
+  std::vector<int32_t> sequence_numbers(3);
+  for (auto& sequence_number : sequence_numbers)
+  {
+    int32_t command;
+    std::vector<int32_t> message;
+    client_->readMessage(command, message, sequence_number);
+  }
+  EXPECT_EQ(sequence_numbers[0], std::numeric_limits<int32_t>::max() - 1);
+  EXPECT_EQ(sequence_numbers[1], std::numeric_limits<int32_t>::max());
+  EXPECT_EQ(sequence_numbers[2], 1);
+
+  // Acknowledging the command after the wrap doesn't fail the ones before it
+  client_->send(-sequence_numbers[0]);
+  ASSERT_EQ(acknowledgements[0].wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(acknowledgements[0].get());
+  client_->send(-sequence_numbers[2]);
+  ASSERT_EQ(acknowledgements[2].wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_TRUE(acknowledgements[2].get());
+  // The one in between hasn't been acknowledged, so it has been dropped
+  ASSERT_EQ(acknowledgements[1].wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_FALSE(acknowledgements[1].get());
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
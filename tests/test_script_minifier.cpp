@@ -0,0 +1,116 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/ur/script_minifier.h>
+#include <ur_client_library/ur/script_template.h>
+
+using namespace urcl;
+
+const std::string SCRIPT_FILE = "../resources/external_control.urscript";
+
+TEST(script_minifier, strip_comments_and_whitespace)
+{
+  const std::string script = "# HEADER_BEGIN\n"
+                             "# A comment\n"
+                             "def f(): # trailing comment\n"
+                             "\n"
+                             "  textmsg(\"# not a comment\")   \n"
+                             "\ttextmsg('#')\n"
+                             "end\n"
+                             "# HEADER_END\n";
+  const std::string expected = "# HEADER_BEGIN\n"
+                               "def f():\n"
+                               "textmsg(\"# not a comment\")\n"
+                               "textmsg('#')\n"
+                               "end\n"
+                               "# HEADER_END\n";
+  EXPECT_EQ(expected, ScriptMinifier().minify(script));
+}
+
+TEST(script_minifier, exclude_sections)
+{
+  const std::string script = "a = 1\n"
+                             "# BEGIN_SECTION A\n"
+                             "b = 2\n"
+                             "  # BEGIN_SECTION B\n"
+                             "  c = 3\n"
+                             "  # END_SECTION B\n"
+                             "# END_SECTION A\n"
+                             "# BEGIN_SECTION B\n"
+                             "d = 4\n"
+                             "# END_SECTION B\n";
+  EXPECT_EQ("a = 1\nb = 2\nc = 3\nd = 4\n", ScriptMinifier().minify(script));
+  EXPECT_EQ("a = 1\nb = 2\n", ScriptMinifier({ "B" }).minify(script));
+  EXPECT_EQ("a = 1\nd = 4\n", ScriptMinifier({ "A" }).minify(script));
+  EXPECT_EQ("a = 1\n", ScriptMinifier({ "A", "B" }).minify(script));
+}
+
+TEST(script_minifier, invalid_sections)
+{
+  EXPECT_THROW(ScriptMinifier().minify("# BEGIN_SECTION A\na = 1\n"), UrException);
+  EXPECT_THROW(ScriptMinifier().minify("a = 1\n# END_SECTION A\n"), UrException);
+  EXPECT_THROW(ScriptMinifier().minify("# BEGIN_SECTION A\n# BEGIN_SECTION B\n# END_SECTION A\n# END_SECTION B\n"),
+               UrException);
+}
+
+TEST(script_minifier, minify_external_control_script)
+{
+  const std::string script = ScriptTemplate::fromFile(SCRIPT_FILE)->render({});
+
+  const std::string minified = ScriptMinifier().minify(script);
+  EXPECT_LT(minified.size(), script.size());
+  EXPECT_NE(std::string::npos, minified.find("# HEADER_BEGIN\n"));
+  EXPECT_NE(std::string::npos, minified.find("# HEADER_END\n"));
+  EXPECT_NE(std::string::npos, minified.find("# NODE_CONTROL_LOOP_BEGINS\n"));
+  EXPECT_NE(std::string::npos, minified.find("# NODE_CONTROL_LOOP_ENDS\n"));
+  EXPECT_NE(std::string::npos, minified.find("thread speedlThread():"));
+
+  // Leaving out all sections must not leave references to the code removed
+  const std::string reduced = ScriptMinifier(ScriptMinifier::SECTIONS).minify(script);
+  EXPECT_LT(reduced.size(), minified.size());
+  for (const std::string& name : { "speedThread", "speedlThread", "servoThreadP", "forceThread", "set_speed(",
+                                   "set_speedl", "set_servo_pose", "set_wrench", "SplineRun", "jointSpline",
+                                   "list_max_norm" })
+  {
+    EXPECT_EQ(std::string::npos, reduced.find(name)) << name;
+  }
+  EXPECT_NE(std::string::npos, reduced.find("thread servoThread():"));
+  EXPECT_NE(std::string::npos, reduced.find("thread trajectoryThread():"));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -82,8 +82,8 @@ protected:
   void SetUp()
   {
     program_ = "test program\n";
-    script_sender_.reset(new control::ScriptSender(50002, program_));
-    client_.reset(new Client(50002));
+    script_sender_.reset(new control::ScriptSender(0, program_));
+    client_.reset(new Client(script_sender_->getPort()));
   }
 
   void TearDown()
@@ -120,6 +120,15 @@ TEST_F(ScriptSenderTest, request_program)
   EXPECT_EQ(program_, received_program);
 }
 
+TEST_F(ScriptSenderTest, request_replaced_program)
+{
+  const std::string new_program = "new program\n";
+  script_sender_->setProgram(new_program);
+
+  client_->send("request_program\n");
+  EXPECT_EQ(new_program, client_->recv());
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,98 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ur_client_library/control/script_state_monitor.h"
+
+using namespace urcl;
+using control::ScriptStateMonitor;
+using control::ToolContactResult;
+
+class ScriptStateMonitorTest : public ::testing::Test
+{
+protected:
+  void SetUp()
+  {
+    monitor_.setFreedriveStateCallback([this](bool active) { freedrive_states_.push_back(active); });
+    monitor_.setToolContactResultCallback([this](ToolContactResult result) { results_.push_back(result); });
+  }
+
+  ScriptStateMonitor monitor_;
+  std::vector<bool> freedrive_states_;
+  std::vector<ToolContactResult> results_;
+};
+
+TEST_F(ScriptStateMonitorTest, freedrive_changes_are_reported)
+{
+  monitor_.update(0);
+  EXPECT_TRUE(freedrive_states_.empty());
+
+  monitor_.update(ScriptStateMonitor::FREEDRIVE_ACTIVE);
+  EXPECT_TRUE(monitor_.isFreedriveActive());
+  monitor_.update(ScriptStateMonitor::FREEDRIVE_ACTIVE | ScriptStateMonitor::TOOL_CONTACT_RUNNING);
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_RUNNING);
+  EXPECT_FALSE(monitor_.isFreedriveActive());
+  EXPECT_EQ(freedrive_states_, std::vector<bool>({ true, false }));
+}
+
+TEST_F(ScriptStateMonitorTest, detected_tool_contact_is_reported_once)
+{
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_RUNNING);
+  EXPECT_TRUE(monitor_.isToolContactRunning());
+  EXPECT_TRUE(results_.empty());
+
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_RUNNING | ScriptStateMonitor::TOOL_CONTACT_DETECTED);
+  // Ending tool contact detection after a contact isn't a cancellation
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_DETECTED);
+  EXPECT_EQ(results_, std::vector<ToolContactResult>({ ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS }));
+
+  // Starting again clears the detection
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_RUNNING);
+  monitor_.update(0);
+  EXPECT_EQ(results_, std::vector<ToolContactResult>({ ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS,
+                                                       ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_CANCELED }));
+}
+
+TEST_F(ScriptStateMonitorTest, contact_ended_within_one_cycle_is_still_detected)
+{
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_RUNNING);
+  monitor_.update(ScriptStateMonitor::TOOL_CONTACT_DETECTED);
+  EXPECT_EQ(results_, std::vector<ToolContactResult>({ ToolContactResult::UNTIL_TOOL_CONTACT_RESULT_SUCCESS }));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
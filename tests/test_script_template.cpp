@@ -0,0 +1,121 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/ur/script_template.h>
+
+using namespace urcl;
+
+TEST(script_template, render_replaces_all_occurrences)
+{
+  ScriptTemplate script_template("socket_open(\"{{IP}}\", {{PORT}})\ntextmsg(\"{{IP}}\")\n");
+  const std::string program = script_template.render({ { "IP", "192.168.56.1" }, { "PORT", "50001" } });
+  EXPECT_EQ("socket_open(\"192.168.56.1\", 50001)\ntextmsg(\"192.168.56.1\")\n", program);
+
+  const std::vector<std::string> expected_placeholders = { "IP", "PORT" };
+  EXPECT_EQ(expected_placeholders, script_template.getPlaceholders());
+}
+
+TEST(script_template, unknown_placeholders_are_kept)
+{
+  ScriptTemplate script_template("{{A}} {{B}}");
+  EXPECT_EQ("a {{B}}", script_template.render({ { "A", "a" } }));
+  EXPECT_EQ("{{A}} {{B}}", script_template.render({}));
+}
+
+TEST(script_template, script_without_placeholders)
+{
+  ScriptTemplate script_template("a = { 1 } {{\nb = 2 }}");
+  EXPECT_TRUE(script_template.getPlaceholders().empty());
+  EXPECT_EQ("a = { 1 } {{\nb = 2 }}", script_template.render({ { "A", "a" } }));
+
+  ScriptTemplate empty_template("");
+  EXPECT_EQ("", empty_template.render({}));
+}
+
+TEST(script_template, replacements_are_not_rendered_again)
+{
+  ScriptTemplate script_template("{{A}}{{B}}");
+  EXPECT_EQ("{{B}}b", script_template.render({ { "A", "{{B}}" }, { "B", "b" } }));
+}
+
+TEST(script_template, rendered_programs_are_cached)
+{
+  ScriptTemplate script_template("port = {{PORT}}");
+  EXPECT_EQ("port = 1", script_template.render({ { "PORT", "1" } }));
+  EXPECT_EQ("port = 1", script_template.render({ { "PORT", "1" } }));
+  EXPECT_EQ(1u, script_template.getCachedProgramCount());
+
+  EXPECT_EQ("port = 2", script_template.render({ { "PORT", "2" } }));
+  EXPECT_EQ(2u, script_template.getCachedProgramCount());
+
+  for (size_t i = 0; i < 2 * ScriptTemplate::MAX_CACHED_PROGRAMS; ++i)
+  {
+    EXPECT_EQ("port = " + std::to_string(i), script_template.render({ { "PORT", std::to_string(i) } }));
+  }
+  EXPECT_EQ(ScriptTemplate::MAX_CACHED_PROGRAMS, script_template.getCachedProgramCount());
+}
+
+TEST(script_template, from_file)
+{
+  EXPECT_THROW(ScriptTemplate::fromFile("non_existing_script.urscript"), UrException);
+
+  const std::string filename = "script_template_test.urscript";
+  {
+    std::ofstream ofs(filename);
+    ofs << "ip = \"{{IP}}\"\n";
+  }
+  auto script_template = ScriptTemplate::fromFile(filename);
+  EXPECT_EQ("ip = \"10.0.0.1\"\n", script_template->render({ { "IP", "10.0.0.1" } }));
+
+  // An unchanged file isn't read again
+  EXPECT_EQ(script_template, ScriptTemplate::fromFile(filename));
+
+  {
+    std::ofstream ofs(filename);
+    ofs << "server_ip = \"{{IP}}\"\n";
+  }
+  auto changed_template = ScriptTemplate::fromFile(filename);
+  EXPECT_EQ("server_ip = \"10.0.0.1\"\n", changed_template->render({ { "IP", "10.0.0.1" } }));
+
+  std::remove(filename.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,232 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "ur_client_library/control/setpoint_interpolator.h"
+
+using namespace urcl;
+
+namespace
+{
+vector6d_t uniform(const double value)
+{
+  return { value, value, value, value, value, value };
+}
+}  // namespace
+
+TEST(SetpointInterpolatorTest, sample_without_setpoints)
+{
+  control::SetpointInterpolator interpolator([](const vector6d_t&) { return true; });
+  vector6d_t setpoint;
+  EXPECT_FALSE(interpolator.sample(std::chrono::steady_clock::now(), setpoint));
+}
+
+TEST(SetpointInterpolatorTest, interpolate_through_setpoints)
+{
+  control::SetpointInterpolator interpolator([](const vector6d_t&) { return true; });
+  const auto start = std::chrono::steady_clock::now();
+  const std::chrono::milliseconds step(20);
+  // A straight line is reproduced exactly, as all tangents are equal
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_TRUE(interpolator.addSetpoint(uniform(i * 0.1), start + i * step));
+  }
+
+  vector6d_t setpoint;
+  ASSERT_TRUE(interpolator.sample(start - step, setpoint));
+  EXPECT_DOUBLE_EQ(setpoint[0], 0.0);
+  ASSERT_TRUE(interpolator.sample(start + 2 * step, setpoint));
+  EXPECT_NEAR(setpoint[0], 0.2, 1e-9);
+  ASSERT_TRUE(interpolator.sample(start + std::chrono::milliseconds(30), setpoint));
+  EXPECT_NEAR(setpoint[3], 0.15, 1e-9);
+  ASSERT_TRUE(interpolator.sample(start + std::chrono::milliseconds(72), setpoint));
+  EXPECT_NEAR(setpoint[5], 0.36, 1e-9);
+}
+
+TEST(SetpointInterpolatorTest, interpolation_is_smooth)
+{
+  control::SetpointInterpolator interpolator([](const vector6d_t&) { return true; });
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<double> values = { 0.0, 0.5, 0.2, 0.8 };
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    ASSERT_TRUE(interpolator.addSetpoint(uniform(values[i]), start + std::chrono::milliseconds(40 * i)));
+  }
+
+  // The velocity right before and after a setpoint is the same
+  const std::chrono::microseconds eps(10);
+  const auto knot = start + std::chrono::milliseconds(40);
+  vector6d_t before, at, after;
+  ASSERT_TRUE(interpolator.sample(knot - eps, before));
+  ASSERT_TRUE(interpolator.sample(knot, at));
+  ASSERT_TRUE(interpolator.sample(knot + eps, after));
+  EXPECT_NEAR(at[0], 0.5, 1e-9);
+  EXPECT_NEAR(at[0] - before[0], after[0] - at[0], 1e-6);
+}
+
+TEST(SetpointInterpolatorTest, extrapolation_is_limited)
+{
+  control::SetpointInterpolator interpolator([](const vector6d_t&) { return true; });
+  interpolator.setMaxExtrapolation(std::chrono::milliseconds(10));
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(0.0), start));
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(1.0), start + std::chrono::milliseconds(100)));
+
+  vector6d_t setpoint;
+  ASSERT_TRUE(interpolator.sample(start + std::chrono::milliseconds(105), setpoint));
+  EXPECT_NEAR(setpoint[0], 1.05, 1e-9);
+  ASSERT_TRUE(interpolator.sample(start + std::chrono::milliseconds(500), setpoint));
+  EXPECT_NEAR(setpoint[0], 1.1, 1e-9);
+
+  interpolator.setMaxExtrapolation(std::chrono::milliseconds(0));
+  ASSERT_TRUE(interpolator.sample(start + std::chrono::milliseconds(500), setpoint));
+  EXPECT_DOUBLE_EQ(setpoint[0], 1.0);
+}
+
+TEST(SetpointInterpolatorTest, reject_outdated_setpoints)
+{
+  control::SetpointInterpolator interpolator([](const vector6d_t&) { return true; });
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(1.0), start));
+  EXPECT_FALSE(interpolator.addSetpoint(uniform(2.0), start - std::chrono::milliseconds(1)));
+
+  // A setpoint with the same time replaces the previous one
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(3.0), start));
+  vector6d_t setpoint;
+  ASSERT_TRUE(interpolator.sample(start, setpoint));
+  EXPECT_DOUBLE_EQ(setpoint[0], 3.0);
+
+  interpolator.clear();
+  EXPECT_FALSE(interpolator.sample(start, setpoint));
+}
+
+TEST(SetpointInterpolatorTest, output_sampled_setpoints_per_cycle)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<vector6d_t> outputs;
+  control::SetpointInterpolator interpolator(
+      [&](const vector6d_t& setpoint) {
+        std::lock_guard<std::mutex> lk(mutex);
+        outputs.push_back(setpoint);
+        cv.notify_all();
+        return true;
+      },
+      std::chrono::milliseconds(10));
+  interpolator.start();
+  EXPECT_TRUE(interpolator.isRunning());
+  EXPECT_EQ(interpolator.getDelay(), std::chrono::milliseconds(10));
+
+  const auto start = std::chrono::steady_clock::now();
+  // Without setpoints, nothing is sent
+  interpolator.notifyCycle(start);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    EXPECT_TRUE(outputs.empty());
+  }
+
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(0.0), start));
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(1.0), start + std::chrono::milliseconds(20)));
+  interpolator.notifyCycle(start + std::chrono::milliseconds(20));
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return outputs.size() == 1; }));
+    EXPECT_NEAR(outputs[0][0], 0.5, 1e-9);
+  }
+  EXPECT_EQ(interpolator.getNumExtrapolatedCycles(), 0u);
+
+  interpolator.notifyCycle(start + std::chrono::milliseconds(35));
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return outputs.size() == 2; }));
+    EXPECT_NEAR(outputs[1][0], 1.25, 1e-9);
+  }
+  EXPECT_EQ(interpolator.getNumExtrapolatedCycles(), 1u);
+
+  interpolator.stop();
+  EXPECT_FALSE(interpolator.isRunning());
+}
+
+TEST(SetpointInterpolatorTest, time_scaling)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<vector6d_t> outputs;
+  control::SetpointInterpolator interpolator([&](const vector6d_t& setpoint) {
+    std::lock_guard<std::mutex> lk(mutex);
+    outputs.push_back(setpoint);
+    cv.notify_all();
+    return true;
+  });
+  interpolator.setTimeScaling(true);
+  EXPECT_TRUE(interpolator.isTimeScalingEnabled());
+  interpolator.start();
+
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(0.0), start));
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(1.0), start + std::chrono::milliseconds(20)));
+  ASSERT_TRUE(interpolator.addSetpoint(uniform(2.0), start + std::chrono::milliseconds(40)));
+
+  auto cycle = [&](const std::chrono::milliseconds time, const double time_scale) {
+    const size_t num_outputs = outputs.size();
+    interpolator.notifyCycle(start + time, time_scale);
+    std::unique_lock<std::mutex> lk(mutex);
+    EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return outputs.size() == num_outputs + 1; }));
+    return outputs.back()[0];
+  };
+
+  // The trajectory clock starts at the first cycle
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(0), 1.0), 0.0, 1e-9);
+  // At half speed, the trajectory advances half the cycle time
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(20), 0.5), 0.5, 1e-9);
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(40), 0.5), 1.0, 1e-9);
+  EXPECT_EQ(interpolator.getTrajectoryTime(), start + std::chrono::milliseconds(20));
+  // A stopped robot stops the trajectory
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(60), 0.0), 1.0, 1e-9);
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(70), 1.0), 1.5, 1e-9);
+
+  // Without time scaling, the cycle times are used again
+  interpolator.setTimeScaling(false);
+  EXPECT_NEAR(cycle(std::chrono::milliseconds(40), 0.5), 2.0, 1e-9);
+  interpolator.stop();
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
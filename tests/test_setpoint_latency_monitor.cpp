@@ -0,0 +1,96 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ur_client_library/control/setpoint_latency_monitor.h"
+
+using namespace urcl;
+
+class SetpointLatencyMonitorTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    package_.initEmpty();
+  }
+
+  void receiveEcho(int32_t sequence, std::chrono::steady_clock::time_point receive_time)
+  {
+    package_.setData("output_int_register_5", sequence);
+    package_.getTimestamps().receive = receive_time;
+    monitor_.onDataPackage(package_);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_ =
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "output_int_register_5" });
+  rtde_interface::DataPackage package_{ recipe_ };
+  control::SetpointLatencyMonitor monitor_{ 5 };
+};
+
+TEST_F(SetpointLatencyMonitorTest, echoes_are_matched_with_their_setpoints)
+{
+  EXPECT_EQ(monitor_.getEchoField(), "output_int_register_5");
+  const auto start = std::chrono::steady_clock::now();
+  monitor_.recordSent(1, start);
+  monitor_.recordSent(2, start + std::chrono::milliseconds(2));
+
+  // Nothing has been echoed yet
+  receiveEcho(0, start + std::chrono::milliseconds(1));
+  EXPECT_EQ(monitor_.getLatencyHistogram().getCount(), 0u);
+
+  receiveEcho(1, start + std::chrono::milliseconds(3));
+  EXPECT_EQ(monitor_.getLastLatency(), std::chrono::milliseconds(3));
+  // The same echo in the next package isn't measured again
+  receiveEcho(1, start + std::chrono::milliseconds(5));
+  EXPECT_EQ(monitor_.getLatencyHistogram().getCount(), 1u);
+
+  receiveEcho(2, start + std::chrono::milliseconds(6));
+  EXPECT_EQ(monitor_.getLastLatency(), std::chrono::milliseconds(4));
+  EXPECT_EQ(monitor_.getLatencyHistogram().getCount(), 2u);
+  EXPECT_EQ(monitor_.getNumUnmatchedEchoes(), 0u);
+}
+
+TEST_F(SetpointLatencyMonitorTest, echoes_of_overwritten_setpoints_are_not_matched)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int32_t sequence = 1; sequence <= static_cast<int32_t>(control::SetpointLatencyMonitor::HISTORY_SIZE) + 1;
+       ++sequence)
+  {
+    monitor_.recordSent(sequence, start);
+  }
+
+  receiveEcho(1, start + std::chrono::milliseconds(1));
+  EXPECT_EQ(monitor_.getNumUnmatchedEchoes(), 1u);
+  EXPECT_EQ(monitor_.getLatencyHistogram().getCount(), 0u);
+}
@@ -0,0 +1,209 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ur_client_library/control/spline_planner.h"
+#include "ur_client_library/exceptions.h"
+
+using namespace urcl;
+
+namespace
+{
+vector6d_t uniform(const double value)
+{
+  return { value, value, value, value, value, value };
+}
+
+control::JointLimits testLimits()
+{
+  control::JointLimits limits;
+  limits.max_velocity = { 1.0, 1.0, 2.0, 2.0, 3.0, 3.0 };
+  limits.max_acceleration = { 5.0, 5.0, 10.0, 10.0, 20.0, 20.0 };
+  return limits;
+}
+
+struct JointState
+{
+  vector6d_t q, qd, qdd;
+};
+
+// Evaluates a segment the way the robot does, starting from the state the previous segment ends in
+JointState evaluate(const JointState& start, const control::TrajectorySplineSegment& segment, const double t)
+{
+  JointState state;
+  const double time = segment.duration;
+  const double x = t / time;
+  for (size_t j = 0; j < 6; ++j)
+  {
+    const double c1 = start.qd[j] * time;
+    const double c2 = 0.5 * start.qdd[j] * time * time;
+    const double c3 = segment.coefficients3[j];
+    const double c4 = segment.coefficients4[j];
+    const double c5 = segment.coefficients5[j];
+    state.q[j] = start.q[j] + c1 * x + c2 * x * x + c3 * std::pow(x, 3) + c4 * std::pow(x, 4) + c5 * std::pow(x, 5);
+    state.qd[j] = (c1 + 2 * c2 * x + 3 * c3 * x * x + 4 * c4 * std::pow(x, 3) + 5 * c5 * std::pow(x, 4)) / time;
+    state.qdd[j] = (2 * c2 + 6 * c3 * x + 12 * c4 * x * x + 20 * c5 * std::pow(x, 3)) / (time * time);
+  }
+  return state;
+}
+}  // namespace
+
+TEST(SplinePlannerTest, non_positive_limits_throw)
+{
+  control::JointLimits limits = testLimits();
+  limits.max_velocity[2] = 0;
+  EXPECT_THROW(control::SplinePlanner planner(limits), UrException);
+
+  limits = testLimits();
+  limits.max_acceleration[5] = -1;
+  EXPECT_THROW(control::SplinePlanner planner(limits), UrException);
+}
+
+TEST(SplinePlannerTest, empty_trajectory)
+{
+  control::SplinePlanner planner(testLimits());
+  std::vector<control::TrajectorySplinePoint> points(3);
+  EXPECT_TRUE(planner.planTrajectory(uniform(0), {}, points));
+  EXPECT_TRUE(points.empty());
+}
+
+TEST(SplinePlannerTest, single_segment_is_limited_by_leading_joint)
+{
+  control::SplinePlanner planner(testLimits());
+  std::vector<control::TrajectorySplinePoint> points;
+  vector6d_t target = uniform(0);
+  target[0] = 1.0;
+  ASSERT_TRUE(planner.planTrajectory(uniform(0), { target }, points));
+
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_EQ(points[0].positions, target);
+  EXPECT_EQ(points[0].velocities, uniform(0));
+  ASSERT_TRUE(points[0].accelerations);
+  EXPECT_EQ(*points[0].accelerations, uniform(0));
+  // A rest to rest quintic over 1 rad peaks at 1.875 rad/s when taking 1 s
+  EXPECT_NEAR(points[0].goal_time, 1.875, 0.002);
+}
+
+TEST(SplinePlannerTest, zero_distance_uses_minimum_duration)
+{
+  control::SplinePlanner planner(testLimits());
+  std::vector<control::TrajectorySplinePoint> points;
+  ASSERT_TRUE(planner.planTrajectory(uniform(0.5), { uniform(0.5) }, points));
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_FLOAT_EQ(points[0].goal_time, control::SplinePlanner::MIN_SEGMENT_DURATION);
+}
+
+TEST(SplinePlannerTest, trajectory_stays_within_limits)
+{
+  const control::JointLimits limits = testLimits();
+  control::SplinePlanner planner(limits);
+  const vector6d_t start = uniform(0);
+  std::vector<vector6d_t> waypoints;
+  for (int i = 1; i <= 20; ++i)
+  {
+    waypoints.push_back({ 0.1 * i, -0.2 * i, std::sin(0.3 * i), 0.05 * i * i, std::cos(0.5 * i) - 1, 0.0 });
+  }
+  std::vector<control::TrajectorySplinePoint> points;
+  ASSERT_TRUE(planner.planTrajectory(start, waypoints, points));
+  std::vector<control::TrajectorySplineSegment> segments;
+  control::SplinePlanner::computeSegments(start, points, segments);
+  ASSERT_EQ(segments.size(), waypoints.size());
+
+  JointState state{ start, uniform(0), uniform(0) };
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    // Durations are sent with millisecond resolution
+    EXPECT_NEAR(std::round(segments[i].duration * 1000), segments[i].duration * 1000, 1e-3);
+    for (int k = 0; k <= 100; ++k)
+    {
+      const JointState sample = evaluate(state, segments[i], segments[i].duration * k / 100.0);
+      for (size_t j = 0; j < 6; ++j)
+      {
+        EXPECT_LE(std::abs(sample.qd[j]), limits.max_velocity[j] * 1.02) << "segment " << i << " joint " << j;
+        EXPECT_LE(std::abs(sample.qdd[j]), limits.max_acceleration[j] * 1.02) << "segment " << i << " joint " << j;
+      }
+    }
+    state = evaluate(state, segments[i], segments[i].duration);
+    for (size_t j = 0; j < 6; ++j)
+    {
+      EXPECT_NEAR(state.q[j], waypoints[i][j], 1e-6);
+    }
+  }
+  for (size_t j = 0; j < 6; ++j)
+  {
+    EXPECT_NEAR(state.qd[j], 0, 1e-6);
+    EXPECT_NEAR(state.qdd[j], 0, 1e-6);
+  }
+}
+
+TEST(SplinePlannerTest, segments_reach_points)
+{
+  std::vector<control::TrajectorySplinePoint> points(2);
+  points[0].positions = { 0.2, 0.4, -0.3, 0.1, 0.0, -0.1 };
+  points[0].velocities = { 0.1, 0.2, -0.1, 0.0, 0.3, -0.2 };
+  points[0].accelerations = vector6d_t{ 0.5, -0.5, 0.2, 0.0, 0.1, -0.3 };
+  points[0].goal_time = 1.5;
+  // Without accelerations, the segment ends with zero acceleration
+  points[1].positions = { 0.5, 0.3, -0.2, 0.4, 0.2, 0.1 };
+  points[1].velocities = uniform(0);
+  points[1].goal_time = 2.0;
+
+  const vector6d_t start = { 0.1, 0.3, -0.1, 0.0, -0.2, 0.0 };
+  std::vector<control::TrajectorySplineSegment> segments;
+  control::SplinePlanner::computeSegments(start, points, segments);
+  ASSERT_EQ(segments.size(), 2u);
+  EXPECT_FLOAT_EQ(segments[0].duration, 1.5);
+
+  JointState state = evaluate({ start, uniform(0), uniform(0) }, segments[0], segments[0].duration);
+  for (size_t j = 0; j < 6; ++j)
+  {
+    EXPECT_NEAR(state.q[j], points[0].positions[j], 1e-9);
+    EXPECT_NEAR(state.qd[j], points[0].velocities[j], 1e-9);
+    EXPECT_NEAR(state.qdd[j], (*points[0].accelerations)[j], 1e-9);
+  }
+  state = evaluate(state, segments[1], segments[1].duration);
+  for (size_t j = 0; j < 6; ++j)
+  {
+    EXPECT_NEAR(state.q[j], points[1].positions[j], 1e-9);
+    EXPECT_NEAR(state.qd[j], 0, 1e-9);
+    EXPECT_NEAR(state.qdd[j], 0, 1e-9);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,243 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ur_client_library/control/spline_planner.h"
+#include "ur_client_library/control/spline_simulator.h"
+#include "ur_client_library/exceptions.h"
+
+using namespace urcl;
+
+namespace
+{
+vector6d_t uniform(const double value)
+{
+  return { value, value, value, value, value, value };
+}
+
+control::TrajectorySplinePoint quinticPoint(const vector6d_t& positions, const double goal_time)
+{
+  control::TrajectorySplinePoint point;
+  point.positions = positions;
+  point.velocities = uniform(0);
+  point.accelerations = uniform(0);
+  point.goal_time = goal_time;
+  return point;
+}
+
+control::TrajectorySplinePoint cubicPoint(const vector6d_t& positions, const vector6d_t& velocities,
+                                          const double goal_time)
+{
+  control::TrajectorySplinePoint point;
+  point.positions = positions;
+  point.velocities = velocities;
+  point.goal_time = goal_time;
+  return point;
+}
+
+void expectNear(const vector6d_t& actual, const vector6d_t& expected, const double tolerance)
+{
+  for (size_t j = 0; j < 6; ++j)
+  {
+    EXPECT_NEAR(actual[j], expected[j], tolerance) << "joint " << j;
+  }
+}
+}  // namespace
+
+TEST(SplineSimulatorTest, non_positive_step_time_throws)
+{
+  EXPECT_THROW(control::SplineSimulator simulator(0.0), UrException);
+  EXPECT_THROW(control::SplineSimulator simulator(-0.002), UrException);
+}
+
+TEST(SplineSimulatorTest, limit_checks_match_script)
+{
+  EXPECT_TRUE(control::SplineSimulator::targetWithinLimits(uniform(0), uniform(1.0), 0.05));
+  EXPECT_FALSE(control::SplineSimulator::targetWithinLimits(uniform(0), uniform(1.0), 0.04));
+
+  // The allowed speed decreases linearly with the time left to decelerate
+  EXPECT_FALSE(control::SplineSimulator::checkSlowDownRequired(0.0, uniform(6.0), 15.0));
+  EXPECT_TRUE(control::SplineSimulator::checkSlowDownRequired(0.1, uniform(6.0), 15.0));
+  EXPECT_TRUE(control::SplineSimulator::checkSlowDownRequired(0.4, uniform(-0.5), 15.0));
+}
+
+TEST(SplineSimulatorTest, empty_trajectory_succeeds)
+{
+  control::SplineSimulator simulator;
+  const control::SplineSimulationResult result =
+      simulator.run(uniform(0.3), std::vector<control::TrajectorySplinePoint>());
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(result.num_steps, 0u);
+  EXPECT_DOUBLE_EQ(result.execution_time, 0.0);
+  EXPECT_EQ(result.final_q, uniform(0.3));
+}
+
+TEST(SplineSimulatorTest, quintic_point_reaches_target_in_goal_time)
+{
+  control::SplineSimulator simulator;
+  const vector6d_t target = { 0.5, -0.5, 1.0, 0.0, 0.2, -1.0 };
+  const control::SplineSimulationResult result = simulator.run(uniform(0), { quinticPoint(target, 2.0) }, true);
+
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_FALSE(result.slowed_down);
+  EXPECT_EQ(result.num_points, 1u);
+  // 999 whole steps and the remainder of the last one
+  EXPECT_EQ(result.num_steps, 1000u);
+  EXPECT_NEAR(result.motion_time, 2.0, 1e-9);
+  EXPECT_LE(result.execution_time - result.motion_time, 0.01);
+  expectNear(result.final_q, target, 1e-3);
+
+  ASSERT_FALSE(result.samples.empty());
+  EXPECT_EQ(result.samples.size(), static_cast<size_t>(std::round(result.execution_time / 0.002)));
+  for (size_t i = 1; i < result.samples.size(); ++i)
+  {
+    EXPECT_GT(result.samples[i].time, result.samples[i - 1].time);
+  }
+  // A rest to rest quintic over 1 rad peaks at 1.875 rad/s when taking 1 s
+  double peak = 0.0;
+  for (const auto& sample : result.samples)
+  {
+    peak = std::max(peak, std::abs(sample.qd[5]));
+  }
+  EXPECT_NEAR(peak, 1.875 / 2.0, 1e-3);
+}
+
+TEST(SplineSimulatorTest, cubic_points_pass_through_waypoints)
+{
+  control::SplineSimulator simulator;
+  const std::vector<control::TrajectorySplinePoint> points = {
+    cubicPoint(uniform(0.2), uniform(0.4), 0.7),
+    cubicPoint(uniform(0.5), uniform(0.2), 0.8),
+    cubicPoint(uniform(0.6), uniform(0), 0.5),
+  };
+  const control::SplineSimulationResult result = simulator.run(uniform(0), points, true);
+
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(result.num_points, 3u);
+  EXPECT_NEAR(result.motion_time, 2.0, 0.01);
+  expectNear(result.final_q, uniform(0.6), 2e-3);
+
+  // The samples are tagged with the point they belong to
+  double first_point_end = 0.0;
+  for (const auto& sample : result.samples)
+  {
+    if (sample.point_index == 0)
+    {
+      first_point_end = sample.time;
+    }
+  }
+  EXPECT_NEAR(first_point_end, 0.7, 0.003);
+}
+
+TEST(SplineSimulatorTest, too_fast_target_cancels)
+{
+  control::SplineSimulator simulator;
+  const std::vector<control::TrajectorySplinePoint> points = {
+    quinticPoint(uniform(0.1), 0.5),
+    quinticPoint(uniform(1.1), 0.01),
+    quinticPoint(uniform(1.2), 0.5),
+  };
+  const control::SplineSimulationResult result = simulator.run(uniform(0), points);
+
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED);
+  EXPECT_EQ(result.num_points, 2u);
+  EXPECT_NEAR(result.motion_time, 0.5, 1e-9);
+}
+
+TEST(SplineSimulatorTest, zero_time_first_point_at_start_is_skipped)
+{
+  control::SplineSimulator simulator;
+  const vector6d_t start = uniform(0.2);
+  control::SplineSimulationResult result =
+      simulator.run(start, { quinticPoint(start, 0.0), quinticPoint(uniform(0.4), 1.0) });
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(result.num_points, 2u);
+  EXPECT_NEAR(result.motion_time, 1.0, 1e-9);
+
+  // Anywhere else, a zero time cancels the trajectory
+  result = simulator.run(start, { quinticPoint(uniform(0.4), 1.0), quinticPoint(uniform(0.4), 0.0) });
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED);
+  result = simulator.run(start, { quinticPoint(uniform(0.3), 0.0) });
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED);
+}
+
+TEST(SplineSimulatorTest, fast_end_of_trajectory_is_slowed_down)
+{
+  control::SplineSimulator simulator;
+  // The last point ends at full speed, so the script slows down towards its end
+  const control::SplineSimulationResult result =
+      simulator.run(uniform(0), { cubicPoint(uniform(1.0), uniform(2.0), 1.0) }, true);
+
+  EXPECT_EQ(result.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_TRUE(result.slowed_down);
+  // Slowing down follows the path, but takes longer
+  EXPECT_GT(result.motion_time, 1.05);
+  expectNear(result.final_q, uniform(1.0), 0.01);
+  EXPECT_LT(std::abs(result.samples[result.num_steps - 1].qd[0]), 0.05);
+  EXPECT_LT(result.samples[result.num_steps - 1].scaling_factor, 0.01);
+}
+
+TEST(SplineSimulatorTest, precomputed_segments_match_points)
+{
+  control::JointLimits limits;
+  limits.max_velocity = uniform(2.0);
+  limits.max_acceleration = uniform(8.0);
+  control::SplinePlanner planner(limits);
+  const vector6d_t start = uniform(0);
+  const std::vector<vector6d_t> waypoints = { { 0.3, -0.2, 0.1, 0.0, 0.5, -0.4 },
+                                              { 0.6, 0.1, -0.3, 0.2, 0.8, -0.1 },
+                                              { 0.2, 0.4, 0.0, 0.5, 1.0, 0.3 } };
+  std::vector<control::TrajectorySplinePoint> points;
+  ASSERT_TRUE(planner.planTrajectory(start, waypoints, points));
+  std::vector<control::TrajectorySplineSegment> segments;
+  control::SplinePlanner::computeSegments(start, points, segments);
+
+  control::SplineSimulator simulator;
+  const control::SplineSimulationResult from_points = simulator.run(start, points);
+  const control::SplineSimulationResult from_segments = simulator.run(start, segments);
+
+  EXPECT_EQ(from_points.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(from_segments.result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(from_points.num_steps, from_segments.num_steps);
+  EXPECT_NEAR(from_points.motion_time, from_segments.motion_time, 1e-9);
+  expectNear(from_segments.final_q, waypoints.back(), 2e-3);
+  expectNear(from_segments.final_q, from_points.final_q, 1e-3);
+
+  double total_time = 0.0;
+  for (const auto& point : points)
+  {
+    total_time += point.goal_time;
+  }
+  EXPECT_NEAR(from_segments.motion_time, total_time, 0.01);
+}
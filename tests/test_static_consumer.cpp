@@ -0,0 +1,200 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/primary/static_primary_consumer.h"
+#include "ur_client_library/rtde/static_rtde_consumer.h"
+
+using namespace urcl;
+
+struct JointState
+{
+  double timestamp;
+  vector6d_t actual_q;
+
+  static constexpr auto fields()
+  {
+    return std::make_tuple(rtde_interface::RecipeField("timestamp", &JointState::timestamp),
+                           rtde_interface::RecipeField("actual_q", &JointState::actual_q));
+  }
+};
+
+class PrimaryCounter
+  : public primary_interface::StaticPrimaryConsumer<PrimaryCounter, primary_interface::KinematicsInfo,
+                                                    primary_interface::RobotState, primary_interface::VersionMessage>
+{
+public:
+  void setupConsumer() override
+  {
+  }
+  void teardownConsumer() override
+  {
+  }
+  void stopConsumer() override
+  {
+  }
+  void onTimeout() override
+  {
+  }
+
+  bool handle(primary_interface::KinematicsInfo& /*info*/)
+  {
+    ++kinematics_info;
+    return true;
+  }
+  bool handle(primary_interface::RobotState& /*state*/)
+  {
+    ++robot_state;
+    return true;
+  }
+  bool handle(primary_interface::VersionMessage& /*message*/)
+  {
+    ++version_message;
+    return false;
+  }
+  bool handleOther(primary_interface::PrimaryPackage& /*product*/)
+  {
+    ++other;
+    return true;
+  }
+
+  size_t kinematics_info = 0;
+  size_t robot_state = 0;
+  size_t version_message = 0;
+  size_t other = 0;
+};
+
+class RTDECounter
+  : public rtde_interface::StaticRTDEConsumer<RTDECounter, rtde_interface::TypedDataPackage<JointState>,
+                                              rtde_interface::DataPackage, rtde_interface::TextMessage>
+{
+public:
+  void setupConsumer() override
+  {
+  }
+  void teardownConsumer() override
+  {
+  }
+  void stopConsumer() override
+  {
+  }
+  void onTimeout() override
+  {
+  }
+
+  bool handle(rtde_interface::TypedDataPackage<JointState>& /*package*/)
+  {
+    ++typed_data_package;
+    return true;
+  }
+  bool handle(rtde_interface::DataPackage& /*package*/)
+  {
+    ++data_package;
+    return true;
+  }
+  bool handle(rtde_interface::TextMessage& /*message*/)
+  {
+    ++text_message;
+    return true;
+  }
+
+  size_t typed_data_package = 0;
+  size_t data_package = 0;
+  size_t text_message = 0;
+};
+
+TEST(static_consumer, primary_packages_are_dispatched_by_class)
+{
+  PrimaryCounter consumer;
+
+  std::unique_ptr<primary_interface::PrimaryPackage> kin_info(
+      new primary_interface::KinematicsInfo(primary_interface::RobotStateType::KINEMATICS_INFO));
+  EXPECT_TRUE(consumer.consumeProduct(kin_info));
+  EXPECT_EQ(consumer.kinematics_info, 1u);
+  EXPECT_EQ(consumer.robot_state, 0u);
+
+  std::shared_ptr<primary_interface::PrimaryPackage> robot_state(
+      new primary_interface::RobotState(primary_interface::RobotStateType::ROBOT_MODE_DATA));
+  EXPECT_TRUE(consumer.consume(robot_state));
+  EXPECT_EQ(consumer.robot_state, 1u);
+
+  std::shared_ptr<primary_interface::PrimaryPackage> version(new primary_interface::VersionMessage(0, 0));
+  EXPECT_FALSE(consumer.consume(version));
+  EXPECT_EQ(consumer.version_message, 1u);
+
+  std::shared_ptr<primary_interface::PrimaryPackage> message(new primary_interface::RobotMessage(0, 0));
+  EXPECT_TRUE(consumer.consume(message));
+  EXPECT_EQ(consumer.other, 1u);
+}
+
+TEST(static_consumer, package_class_traits_follow_the_class_hierarchy)
+{
+  primary_interface::KinematicsInfo kin_info(primary_interface::RobotStateType::KINEMATICS_INFO);
+  EXPECT_TRUE(comm::PackageClassTraits<primary_interface::KinematicsInfo>::matches(kin_info));
+  EXPECT_TRUE(comm::PackageClassTraits<primary_interface::RobotState>::matches(kin_info));
+  EXPECT_FALSE(comm::PackageClassTraits<primary_interface::RobotMessage>::matches(kin_info));
+
+  primary_interface::VersionMessage version(0, 0);
+  EXPECT_TRUE(comm::PackageClassTraits<primary_interface::RobotMessage>::matches(version));
+  EXPECT_TRUE(comm::PackageClassTraits<primary_interface::VersionMessage>::matches(version));
+  EXPECT_FALSE(comm::PackageClassTraits<primary_interface::RobotState>::matches(version));
+}
+
+TEST(static_consumer, rtde_data_packages_are_dispatched_by_recipe)
+{
+  RTDECounter consumer;
+
+  std::unique_ptr<rtde_interface::RTDEPackage> typed(new rtde_interface::TypedDataPackage<JointState>());
+  EXPECT_TRUE(consumer.consumeProduct(typed));
+  EXPECT_EQ(consumer.typed_data_package, 1u);
+  EXPECT_EQ(consumer.data_package, 0u);
+
+  std::unique_ptr<rtde_interface::RTDEPackage> data(
+      new rtde_interface::DataPackage(std::vector<std::string>{ "timestamp" }));
+  EXPECT_TRUE(consumer.consumeProduct(data));
+  EXPECT_EQ(consumer.typed_data_package, 1u);
+  EXPECT_EQ(consumer.data_package, 1u);
+
+  std::shared_ptr<rtde_interface::RTDEPackage> text(new rtde_interface::TextMessage(2));
+  EXPECT_TRUE(consumer.consume(text));
+  EXPECT_EQ(consumer.text_message, 1u);
+
+  std::shared_ptr<rtde_interface::RTDEPackage> start(new rtde_interface::ControlPackageStart());
+  EXPECT_TRUE(consumer.consume(start));
+  EXPECT_EQ(consumer.typed_data_package + consumer.data_package + consumer.text_message, 3u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -29,8 +29,12 @@
 // -- END LICENSE BLOCK ------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #include <ur_client_library/comm/stream.h>
 #include <ur_client_library/comm/tcp_server.h>
@@ -188,6 +192,142 @@ TEST_F(StreamTest, read_rtde_data_package)
   }
 }
 
+TEST_F(StreamTest, buffered_read_multiple_packages)
+{
+  // Three RTDE packages with timestamp, sent at once
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5 };
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    data.insert(data.end(), data_package, data_package + sizeof(data_package));
+  }
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  stream.setBufferedReading(true);
+  EXPECT_TRUE(stream.isBufferedReading());
+  stream.connect();
+  EXPECT_TRUE(waitForConnectionCallback());
+  EXPECT_FALSE(stream.hasBufferedPackage());
+
+  size_t written;
+  server_->write(client_fd_, data.data(), data.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  uint8_t buf[4096];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    size_t read = 0;
+    ASSERT_TRUE(stream.read(buf, sizeof(buf), read));
+    ASSERT_EQ(read, sizeof(data_package));
+    for (size_t j = 0; j < read; ++j)
+    {
+      EXPECT_EQ(data_package[j], buf[j]);
+    }
+    // All packages have been received with the first read from the socket
+    EXPECT_EQ(stream.hasBufferedPackage(), i < 2);
+  }
+}
+
+TEST_F(StreamTest, buffered_read_split_package)
+{
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5 };
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  stream.setBufferedReading(true);
+  timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = 100000;
+  stream.setReceiveTimeout(tv);
+  stream.connect();
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  // Only the first part of the package arrives before the read times out
+  size_t written;
+  server_->write(client_fd_, data_package, 5, written);
+  uint8_t buf[4096];
+  size_t read = 0;
+  EXPECT_FALSE(stream.read(buf, sizeof(buf), read));
+
+  // The received part is kept, so the package is complete once the rest arrives
+  server_->write(client_fd_, data_package + 5, sizeof(data_package) - 5, written);
+  read = 0;
+  ASSERT_TRUE(stream.read(buf, sizeof(buf), read));
+  ASSERT_EQ(read, sizeof(data_package));
+  for (size_t i = 0; i < read; ++i)
+  {
+    EXPECT_EQ(data_package[i], buf[i]);
+  }
+}
+
+TEST_F(StreamTest, read_frames_in_place)
+{
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5 };
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    data.insert(data.end(), data_package, data_package + sizeof(data_package));
+  }
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  uint8_t* frame = nullptr;
+  size_t length = 0;
+
+  // Frames can only be handed out of the read buffer
+  EXPECT_FALSE(stream.readFrame(frame, length));
+  stream.setBufferedReading(true);
+  stream.connect();
+  EXPECT_TRUE(waitForConnectionCallback());
+  EXPECT_FALSE(stream.nextBufferedFrame(frame, length));
+
+  size_t written;
+  server_->write(client_fd_, data.data(), data.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  ASSERT_TRUE(stream.readFrame(frame, length));
+  ASSERT_EQ(length, sizeof(data_package));
+  EXPECT_TRUE(std::equal(frame, frame + length, data_package));
+
+  // The second package has been received with the first one
+  uint8_t* second_frame = nullptr;
+  ASSERT_TRUE(stream.nextBufferedFrame(second_frame, length));
+  ASSERT_EQ(length, sizeof(data_package));
+  EXPECT_EQ(second_frame, frame + sizeof(data_package));
+  EXPECT_TRUE(std::equal(second_frame, second_frame + length, data_package));
+  EXPECT_FALSE(stream.nextBufferedFrame(frame, length));
+}
+
+TEST_F(StreamTest, read_package_larger_than_default_buffers)
+{
+  // Primary packages have a 32 bit length field, this one exceeds both the 4 KB default frame
+  // buffer and the stream's read buffer
+  const uint32_t package_size = 100000;
+  std::vector<uint8_t> data(package_size);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  const uint32_t size_be = htobe32(package_size);
+  std::memcpy(data.data(), &size_be, sizeof(size_be));
+
+  for (const bool buffered : { false, true })
+  {
+    comm::URStream<primary_interface::PrimaryPackage> stream("127.0.0.1", 60003);
+    stream.setBufferedReading(buffered);
+    stream.connect();
+    ASSERT_TRUE(waitForConnectionCallback());
+
+    size_t written;
+    ASSERT_TRUE(server_->write(client_fd_, data.data(), data.size(), written));
+
+    std::vector<uint8_t> buf(4096);
+    size_t read = 0;
+    ASSERT_TRUE(stream.read(buf, read));
+    ASSERT_EQ(read, package_size);
+    EXPECT_GE(buf.size(), package_size);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), buf.begin()));
+  }
+}
+
 TEST_F(StreamTest, read_primary_data_package)
 {
   /* First RobotState of UR5e from URSim v5.8
@@ -35,6 +35,7 @@
 
 #include <ur_client_library/comm/tcp_server.h>
 #include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/exceptions.h>
 
 using namespace urcl;
 
@@ -146,7 +147,6 @@ protected:
     }
   }
 
-  int port_ = 50001;
   std::string message_ = "";
   int client_fd_ = -1;
 
@@ -167,16 +167,18 @@ private:
 
 TEST_F(TCPServerTest, socket_creation)
 {
-  comm::TCPServer server(port_);
+  // Port 0 lets the operating system assign a free port
+  comm::TCPServer server(0);
+  EXPECT_GT(server.getPort(), 0);
 
   // Shouldn't be able to create antoher server on same port
-  EXPECT_THROW(comm::TCPServer server2(port_, 1, std::chrono::milliseconds(1)), std::system_error);
+  EXPECT_THROW(comm::TCPServer server2(server.getPort(), 1, std::chrono::milliseconds(1)), std::system_error);
 
   server.start();
 
   // We should be able to connect to the server even though the callbacks haven't been configured
-  ASSERT_NO_THROW(Client client(port_));
-  Client client(port_);
+  ASSERT_NO_THROW(Client client(server.getPort()));
+  Client client(server.getPort());
 
   // We should also be able to send message and disconnect. We wait to be absolutely sure no exception is thrown
   EXPECT_NO_THROW(client.send("message\n"));
@@ -188,7 +190,7 @@ TEST_F(TCPServerTest, socket_creation)
 
 TEST_F(TCPServerTest, callback_functions)
 {
-  comm::TCPServer server(port_);
+  comm::TCPServer server(0);
   server.setMessageCallback(std::bind(&TCPServerTest_callback_functions_Test::messageCallback, this,
                                       std::placeholders::_1, std::placeholders::_2));
   server.setConnectCallback(
@@ -198,7 +200,7 @@ TEST_F(TCPServerTest, callback_functions)
   server.start();
 
   // Check that the appropriate callback functions are called
-  Client client(port_);
+  Client client(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
 
   client.send("message\n");
@@ -210,7 +212,7 @@ TEST_F(TCPServerTest, callback_functions)
 
 TEST_F(TCPServerTest, unlimited_clients_allowed)
 {
-  comm::TCPServer server(port_);
+  comm::TCPServer server(0);
   server.setMessageCallback(std::bind(&TCPServerTest_unlimited_clients_allowed_Test::messageCallback, this,
                                       std::placeholders::_1, std::placeholders::_2));
   server.setConnectCallback(
@@ -224,14 +226,14 @@ TEST_F(TCPServerTest, unlimited_clients_allowed)
   std::unique_ptr<Client> client;
   for (unsigned int i = 0; i < 100; ++i)
   {
-    clients.push_back(std::make_unique<Client>(port_));
+    clients.push_back(std::make_unique<Client>(server.getPort()));
     ASSERT_TRUE(waitForConnectionCallback());
   }
 }
 
 TEST_F(TCPServerTest, max_clients_allowed)
 {
-  comm::TCPServer server(port_);
+  comm::TCPServer server(0);
   server.setMessageCallback(std::bind(&TCPServerTest_max_clients_allowed_Test::messageCallback, this,
                                       std::placeholders::_1, std::placeholders::_2));
   server.setConnectCallback(
@@ -242,15 +244,15 @@ TEST_F(TCPServerTest, max_clients_allowed)
   server.setMaxClientsAllowed(1);
 
   // Test that only one client can connect
-  Client client1(port_);
+  Client client1(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
-  Client client2(port_);
+  Client client2(server.getPort());
   EXPECT_FALSE(waitForConnectionCallback());
 }
 
 TEST_F(TCPServerTest, message_transmission)
 {
-  comm::TCPServer server(port_);
+  comm::TCPServer server(0);
   server.setMessageCallback(std::bind(&TCPServerTest_message_transmission_Test::messageCallback, this,
                                       std::placeholders::_1, std::placeholders::_2));
   server.setConnectCallback(
@@ -259,7 +261,7 @@ TEST_F(TCPServerTest, message_transmission)
       std::bind(&TCPServerTest_message_transmission_Test::disconnectionCallback, this, std::placeholders::_1));
   server.start();
 
-  Client client(port_);
+  Client client(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
 
   // Test that messages are transmitted corectly between client and server
@@ -279,7 +281,7 @@ TEST_F(TCPServerTest, message_transmission)
 
 TEST_F(TCPServerTest, client_connections)
 {
-  comm::TCPServer server(port_);
+  comm::TCPServer server(0);
   server.setMessageCallback(std::bind(&TCPServerTest_client_connections_Test::messageCallback, this,
                                       std::placeholders::_1, std::placeholders::_2));
   server.setConnectCallback(
@@ -294,15 +296,15 @@ TEST_F(TCPServerTest, client_connections)
   size_t written;
 
   // Test that we can connect multiple clients
-  Client client1(port_);
+  Client client1(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
   int client1_fd = client_fd_;
 
-  Client client2(port_);
+  Client client2(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
   int client2_fd = client_fd_;
 
-  Client client3(port_);
+  Client client3(server.getPort());
   EXPECT_TRUE(waitForConnectionCallback());
   int client3_fd = client_fd_;
 
@@ -326,6 +328,217 @@ TEST_F(TCPServerTest, client_connections)
   EXPECT_FALSE(server.write(client2_fd, data, len, written));
   EXPECT_FALSE(server.write(client3_fd, data, len, written));
 }
+TEST_F(TCPServerTest, message_transmission_using_reactor)
+{
+  auto reactor = std::make_shared<comm::Reactor>();
+  comm::TCPServer server(0);
+  server.setMessageCallback(std::bind(&TCPServerTest_message_transmission_using_reactor_Test::messageCallback, this,
+                                      std::placeholders::_1, std::placeholders::_2));
+  server.setConnectCallback(std::bind(&TCPServerTest_message_transmission_using_reactor_Test::connectionCallback, this,
+                                      std::placeholders::_1));
+  server.setDisconnectCallback(std::bind(
+      &TCPServerTest_message_transmission_using_reactor_Test::disconnectionCallback, this, std::placeholders::_1));
+  server.setReactor(reactor);
+  server.start();
+
+  Client client(server.getPort());
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  std::string message = "test message\n";
+  client.send(message);
+  EXPECT_TRUE(waitForMessageCallback());
+  EXPECT_EQ(message, message_);
+
+  client.close();
+  EXPECT_TRUE(waitForDisconnectionCallback());
+}
+
+TEST_F(TCPServerTest, move_running_server_to_reactor)
+{
+  auto reactor = std::make_shared<comm::Reactor>();
+  comm::TCPServer server(0);
+  server.setMessageCallback(std::bind(&TCPServerTest_move_running_server_to_reactor_Test::messageCallback, this,
+                                      std::placeholders::_1, std::placeholders::_2));
+  server.setConnectCallback(
+      std::bind(&TCPServerTest_move_running_server_to_reactor_Test::connectionCallback, this, std::placeholders::_1));
+  server.start();
+
+  Client client(server.getPort());
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  // The existing connection is kept when switching between the worker thread and the reactor
+  server.setReactor(reactor);
+  client.send("via reactor\n");
+  EXPECT_TRUE(waitForMessageCallback());
+  EXPECT_EQ(message_, "via reactor\n");
+
+  server.setReactor(nullptr);
+  client.send("via worker\n");
+  EXPECT_TRUE(waitForMessageCallback());
+  EXPECT_EQ(message_, "via worker\n");
+}
+
+TEST_F(TCPServerTest, burst_larger_than_input_buffer_is_read_completely)
+{
+  comm::TCPServer server(0);
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::string received;
+  server.setMessageCallback([&](const int fd, char* buffer, int nbytesrecv) {
+    std::lock_guard<std::mutex> lk(mutex);
+    received.append(buffer, nbytesrecv);
+    cv.notify_one();
+  });
+  server.start();
+
+  // The whole burst arrives with a single edge-triggered event, so it has to be drained at once.
+  const std::string burst = std::string(1000, 'a') + "\n";
+  Client client(server.getPort());
+  client.send(burst);
+
+  std::unique_lock<std::mutex> lk(mutex);
+  EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return received.size() >= burst.size(); }));
+  EXPECT_EQ(received, burst);
+}
+
+TEST_F(TCPServerTest, clients_connecting_at_once_are_all_accepted)
+{
+  comm::TCPServer server(0);
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t num_connected = 0;
+  server.setConnectCallback([&](const int fd) {
+    std::lock_guard<std::mutex> lk(mutex);
+    ++num_connected;
+    cv.notify_one();
+  });
+  server.start();
+
+  std::vector<std::unique_ptr<Client>> clients;
+  for (size_t i = 0; i < 5; ++i)
+  {
+    clients.push_back(std::make_unique<Client>(server.getPort()));
+  }
+
+  std::unique_lock<std::mutex> lk(mutex);
+  EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return num_connected == clients.size(); }));
+}
+
+TEST_F(TCPServerTest, fixed_size_framing_passes_whole_messages)
+{
+  comm::TCPServer server(0);
+  server.setMessageFraming(comm::MessageFraming::FIXED_SIZE, 4);
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> messages;
+  server.setMessageCallback([&](const int fd, char* buffer, int nbytesrecv) {
+    std::lock_guard<std::mutex> lk(mutex);
+    messages.push_back(std::string(buffer, nbytesrecv));
+    cv.notify_one();
+  });
+  server.start();
+
+  Client client(server.getPort());
+  client.send("aaaabb");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  client.send("bbcccc");
+
+  std::unique_lock<std::mutex> lk(mutex);
+  EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&]() { return messages.size() >= 3; }));
+  EXPECT_EQ(messages, std::vector<std::string>({ "aaaa", "bbbb", "cccc" }));
+}
+
+TEST_F(TCPServerTest, length_prefixed_framing_strips_prefix)
+{
+  comm::TCPServer server(0);
+  server.setMessageFraming(comm::MessageFraming::LENGTH_PREFIXED);
+  server.setMessageCallback(std::bind(&TCPServerTest_length_prefixed_framing_strips_prefix_Test::messageCallback,
+                                      this, std::placeholders::_1, std::placeholders::_2));
+  server.start();
+
+  Client client(server.getPort());
+  const std::string message = "request_program\n";
+  std::string framed(4, '\0');
+  framed[3] = static_cast<char>(message.size());
+  client.send(framed + message);
+
+  EXPECT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(message_, message);
+}
+
+TEST_F(TCPServerTest, oversized_length_prefixed_message_disconnects_client)
+{
+  comm::TCPServer server(0);
+  server.setReceiveBufferSize(16);
+  server.setMessageFraming(comm::MessageFraming::LENGTH_PREFIXED);
+  server.setDisconnectCallback(std::bind(
+      &TCPServerTest_oversized_length_prefixed_message_disconnects_client_Test::disconnectionCallback, this,
+      std::placeholders::_1));
+  server.start();
+
+  Client client(server.getPort());
+  std::string framed(4, '\0');
+  framed[3] = 100;
+  client.send(framed);
+
+  EXPECT_TRUE(waitForDisconnectionCallback(1000));
+}
+
+TEST_F(TCPServerTest, invalid_framing_is_rejected)
+{
+  comm::TCPServer server(0);
+  EXPECT_THROW(server.setReceiveBufferSize(0), UrException);
+  EXPECT_THROW(server.setMessageFraming(comm::MessageFraming::FIXED_SIZE, 0), UrException);
+
+  server.setReceiveBufferSize(8);
+  EXPECT_THROW(server.setMessageFraming(comm::MessageFraming::FIXED_SIZE, 9), UrException);
+  server.setMessageFraming(comm::MessageFraming::FIXED_SIZE, 8);
+  EXPECT_THROW(server.setReceiveBufferSize(4), UrException);
+  EXPECT_EQ(server.getReceiveBufferSize(), 8u);
+}
+
+TEST_F(TCPServerTest, writev_sends_all_buffers_in_order)
+{
+  comm::TCPServer server(0);
+  server.setConnectCallback(std::bind(&TCPServerTest_writev_sends_all_buffers_in_order_Test::connectionCallback, this,
+                                      std::placeholders::_1));
+  server.start();
+
+  Client client(server.getPort());
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  std::string header = "header ";
+  std::string empty = "";
+  std::string payload = "payload\n";
+  struct iovec iov[3];
+  iov[0].iov_base = &header[0];
+  iov[0].iov_len = header.size();
+  iov[1].iov_base = &empty[0];
+  iov[1].iov_len = 0;
+  iov[2].iov_base = &payload[0];
+  iov[2].iov_len = payload.size();
+
+  size_t written;
+  EXPECT_TRUE(server.writev(client_fd_, iov, 3, written));
+  EXPECT_EQ(written, header.size() + payload.size());
+  EXPECT_EQ(client.recv(), header + payload);
+}
+
+TEST_F(TCPServerTest, listen_backlog_can_be_changed_while_running)
+{
+  comm::TCPServer server(0);
+  server.setConnectCallback(std::bind(&TCPServerTest_listen_backlog_can_be_changed_while_running_Test::connectionCallback,
+                                      this, std::placeholders::_1));
+  EXPECT_EQ(server.getListenBacklog(), 8);
+  server.start();
+
+  server.setListenBacklog(2);
+  EXPECT_EQ(server.getListenBacklog(), 2);
+
+  Client client(server.getPort());
+  EXPECT_TRUE(waitForConnectionCallback());
+}
+
 TEST_F(TCPServerTest, check_address_already_in_use)
 {
   comm::TCPServer blocking_server(12321);
@@ -33,6 +33,10 @@
 #include <condition_variable>
 #include <cstddef>
 
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
 // This file adds a test for a deprecated function. To avoid a compiler warning in CI (where we want
 // to treat warnings as errors) we suppress the warning inside this file.
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -300,6 +304,85 @@ TEST_F(TCPSocketTest, read_on_connected_socket)
   EXPECT_EQ(send_message, received_message);
 }
 
+TEST_F(TCPSocketTest, kernel_receive_timestamps)
+{
+  client_->setKernelTimestamping(true);
+  client_->setup();
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  const auto send_time = std::chrono::system_clock::now();
+  std::string send_message = "test message";
+  size_t written;
+  server_->write(client_fd_, reinterpret_cast<const uint8_t*>(send_message.c_str()), send_message.size(), written);
+
+  uint8_t buffer[64];
+  size_t read = 0;
+  ASSERT_TRUE(client_->read(buffer, sizeof(buffer), read));
+  EXPECT_EQ(send_message, std::string(reinterpret_cast<char*>(buffer), read));
+
+  const auto kernel_timestamp = client_->getLastKernelTimestamp();
+  ASSERT_NE(kernel_timestamp, std::chrono::system_clock::time_point());
+  EXPECT_GE(kernel_timestamp, send_time - std::chrono::seconds(1));
+  EXPECT_LE(kernel_timestamp, std::chrono::system_clock::now());
+}
+
+TEST_F(TCPSocketTest, socket_options)
+{
+  comm::SocketOptions server_options;
+  server_options.priority = 2;
+  server_->shutdown();
+  server_->setClientSocketOptions(server_options);
+  server_->start();
+
+  comm::SocketOptions options;
+  options.priority = 3;
+  options.tos = 0x10;
+  client_->setSocketOptions(options);
+  client_->setup();
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  int value = 0;
+  socklen_t len = sizeof(value);
+  ASSERT_EQ(getsockopt(client_->getSocketFD(), SOL_SOCKET, SO_PRIORITY, &value, &len), 0);
+  EXPECT_EQ(value, 3);
+  ASSERT_EQ(getsockopt(client_->getSocketFD(), IPPROTO_IP, IP_TOS, &value, &len), 0);
+  EXPECT_EQ(value, 0x10);
+
+  // Options of a connected socket are applied immediately
+  options.priority = 1;
+  client_->setSocketOptions(options);
+  ASSERT_EQ(getsockopt(client_->getSocketFD(), SOL_SOCKET, SO_PRIORITY, &value, &len), 0);
+  EXPECT_EQ(value, 1);
+
+  // The server applies its options to accepted sockets
+  ASSERT_EQ(getsockopt(client_fd_, SOL_SOCKET, SO_PRIORITY, &value, &len), 0);
+  EXPECT_EQ(value, 2);
+  ASSERT_EQ(getsockopt(client_fd_, IPPROTO_TCP, TCP_NODELAY, &value, &len), 0);
+  EXPECT_NE(value, 0);
+}
+
+TEST_F(TCPSocketTest, connect_with_timeout)
+{
+  client_->setConnectTimeout(std::chrono::milliseconds(500));
+  EXPECT_TRUE(client_->setup(1));
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  // The connected socket is blocking again
+  const int flags = fcntl(client_->getSocketFD(), F_GETFL);
+  EXPECT_EQ(flags & O_NONBLOCK, 0);
+}
+
+TEST_F(TCPSocketTest, connect_timeout_limits_attempt_duration)
+{
+  // An address that is not routed drops the connection request, so a blocking connect would hang
+  // for a long time.
+  Client client(60001, "10.255.255.1");
+  client.setConnectTimeout(std::chrono::milliseconds(100));
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client.setup(1));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
+
 TEST_F(TCPSocketTest, get_socket_fd)
 {
   // When the client is not connected to any socket the fd should be -1
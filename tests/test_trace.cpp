@@ -0,0 +1,147 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/trace.h"
+
+using namespace urcl;
+
+class TraceTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    clearTraceEvents();
+  }
+};
+
+TEST_F(TraceTest, recorded_events_are_returned_in_order)
+{
+  recordTraceEvent(TracePoint::SOCKET_READ, 128);
+  recordTraceEvent(TracePoint::PARSE_DONE, 42);
+  recordTraceEvent(TracePoint::PIPELINE_ENQUEUE, 42);
+
+  const std::vector<TraceEvent> events = getTraceEvents();
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].point, TracePoint::SOCKET_READ);
+  EXPECT_EQ(events[0].argument, 128u);
+  EXPECT_EQ(events[1].point, TracePoint::PARSE_DONE);
+  EXPECT_EQ(events[2].point, TracePoint::PIPELINE_ENQUEUE);
+  EXPECT_LE(events[0].time, events[1].time);
+  EXPECT_LE(events[1].time, events[2].time);
+  EXPECT_EQ(events[0].thread_id, events[2].thread_id);
+}
+
+TEST_F(TraceTest, cleared_events_are_not_returned)
+{
+  recordTraceEvent(TracePoint::SOCKET_READ, 1);
+  clearTraceEvents();
+  EXPECT_TRUE(getTraceEvents().empty());
+  recordTraceEvent(TracePoint::SOCKET_READ, 2);
+  ASSERT_EQ(getTraceEvents().size(), 1u);
+  EXPECT_EQ(getTraceEvents()[0].argument, 2u);
+}
+
+TEST_F(TraceTest, only_the_newest_events_are_kept)
+{
+  for (uint64_t i = 0; i < TRACE_BUFFER_SIZE + 10; ++i)
+  {
+    recordTraceEvent(TracePoint::PIPELINE_DEQUEUE, i);
+  }
+  const std::vector<TraceEvent> events = getTraceEvents();
+  ASSERT_EQ(events.size(), TRACE_BUFFER_SIZE);
+  EXPECT_EQ(events.front().argument, 10u);
+  EXPECT_EQ(events.back().argument, TRACE_BUFFER_SIZE + 9);
+}
+
+TEST_F(TraceTest, events_are_distinguished_by_thread)
+{
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; ++j)
+      {
+        recordTraceEvent(TracePoint::CONSUMER_INVOKED, j);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  const std::vector<TraceEvent> events = getTraceEvents();
+  EXPECT_EQ(events.size(), 4000u);
+  std::set<uint32_t> thread_ids;
+  for (const TraceEvent& event : events)
+  {
+    thread_ids.insert(event.thread_id);
+  }
+  EXPECT_EQ(thread_ids.size(), 4u);
+}
+
+TEST_F(TraceTest, events_are_exported_as_json)
+{
+  recordTraceEvent(TracePoint::CONSUMER_INVOKED, 7);
+  recordTraceEvent(TracePoint::CONSUMER_DONE, 0);
+  recordTraceEvent(TracePoint::REVERSE_INTERFACE_WRITE, 32);
+
+  const std::string json = traceEventsToJson(getTraceEvents());
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[{\"name\":\"CONSUMER\",\"ph\":\"B\""), 0u);
+  EXPECT_NE(json.find("\"name\":\"CONSUMER\",\"ph\":\"E\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"REVERSE_INTERFACE_WRITE\",\"ph\":\"i\""), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"argument\":32}}]}"), std::string::npos);
+  EXPECT_EQ(traceEventsToJson({}), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}");
+}
+
+TEST_F(TraceTest, trace_points_are_removed_without_tracing)
+{
+  int evaluations = 0;
+  URCL_TRACE(TracePoint::SOCKET_READ, ++evaluations);
+#ifdef URCL_TRACING
+  EXPECT_EQ(evaluations, 1);
+  EXPECT_EQ(getTraceEvents().size(), 1u);
+#else
+  EXPECT_EQ(evaluations, 0);
+  EXPECT_TRUE(getTraceEvents().empty());
+#endif
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
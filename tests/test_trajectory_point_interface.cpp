@@ -28,9 +28,13 @@
 // POSSIBILITY OF SUCH DAMAGE.
 // -- END LICENSE BLOCK ------------------------------------------------
 
+#include <cmath>
+#include <future>
+#include <thread>
 #include <gtest/gtest.h>
 #include <ur_client_library/control/trajectory_point_interface.h>
 #include <ur_client_library/comm/tcp_socket.h>
+#include <ur_client_library/exceptions.h>
 
 using namespace urcl;
 
@@ -118,6 +122,23 @@ protected:
       motion_type = be32toh(val);
     }
 
+    // Reads until nothing arrives for the given time and returns the number of bytes read
+    size_t drain(const std::chrono::milliseconds timeout)
+    {
+      timeval tv;
+      tv.tv_sec = 0;
+      tv.tv_usec = std::chrono::duration_cast<std::chrono::microseconds>(timeout).count();
+      TCPSocket::setReceiveTimeout(tv);
+      uint8_t buf[4096];
+      size_t total = 0;
+      size_t read = 0;
+      while (TCPSocket::read(buf, sizeof(buf), read))
+      {
+        total += read;
+      }
+      return total;
+    }
+
     vector6int32_t getPosition()
     {
       int32_t goal_time, blend_radius_or_spline_type, motion_type;
@@ -182,8 +203,8 @@ protected:
 
   void SetUp()
   {
-    traj_point_interface_.reset(new control::TrajectoryPointInterface(50003));
-    client_.reset(new Client(50003));
+    traj_point_interface_.reset(new control::TrajectoryPointInterface(0));
+    client_.reset(new Client(traj_point_interface_->getPort()));
     // Need to be sure that the client has connected to the server
     std::this_thread::sleep_for(std::chrono::seconds(1));
   }
@@ -423,6 +444,187 @@ TEST_F(TrajectoryPointInterfaceTest, write_cartesian)
   EXPECT_EQ(send_cartesian, received_cartesian);
 }
 
+TEST_F(TrajectoryPointInterfaceTest, write_batch)
+{
+  urcl::vector6d_t first_positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  urcl::vector6d_t second_positions = { -0.5, 0.1, 0.2, 0.3, 0.4, 0.5 };
+
+  traj_point_interface_->startTrajectoryBatch();
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&first_positions, 0, 0, false));
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&second_positions, 0, 0, false));
+  EXPECT_TRUE(traj_point_interface_->flushTrajectoryBatch());
+
+  vector6int32_t received_positions = client_->getPosition();
+  EXPECT_EQ(first_positions[0], ((double)received_positions[0]) / traj_point_interface_->MULT_JOINTSTATE);
+  EXPECT_EQ(first_positions[5], ((double)received_positions[5]) / traj_point_interface_->MULT_JOINTSTATE);
+  received_positions = client_->getPosition();
+  EXPECT_EQ(second_positions[0], ((double)received_positions[0]) / traj_point_interface_->MULT_JOINTSTATE);
+  EXPECT_EQ(second_positions[5], ((double)received_positions[5]) / traj_point_interface_->MULT_JOINTSTATE);
+
+  // After flushing, points are sent directly again
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&first_positions, 0, 0, false));
+  received_positions = client_->getPosition();
+  EXPECT_EQ(first_positions[0], ((double)received_positions[0]) / traj_point_interface_->MULT_JOINTSTATE);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_trajectory_points)
+{
+  std::vector<control::TrajectoryPoint> points(3);
+  points[0].positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  points[0].goal_time = 0.5;
+  points[1].positions = { -0.5, 0.1, 0.2, 0.3, 0.4, 0.5 };
+  points[1].acceleration = 0.5;
+  points[1].velocity = 0.2;
+  points[1].blend_radius = 0.1;
+  points[2].positions = { 0.3, -0.4, 0.5, 1.1, -1.2, 0.2 };
+  points[2].cartesian = true;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoints(points.data(), points.size()));
+
+  for (const auto& point : points)
+  {
+    Client::TrajData received = client_->getData();
+    for (size_t i = 0; i < point.positions.size(); ++i)
+    {
+      EXPECT_EQ(point.positions[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+      EXPECT_EQ(std::round(point.velocity * traj_point_interface_->MULT_JOINTSTATE), received.vel[i]);
+      EXPECT_EQ(std::round(point.acceleration * traj_point_interface_->MULT_JOINTSTATE), received.acc[i]);
+    }
+    EXPECT_EQ(std::round(point.goal_time * traj_point_interface_->MULT_TIME), received.goal_time);
+    EXPECT_EQ(std::round(point.blend_radius * traj_point_interface_->MULT_TIME), received.blend_radius_or_spline_type);
+    EXPECT_EQ(static_cast<int32_t>(point.cartesian ? control::TrajectoryMotionType::CARTESIAN_POINT :
+                                                     control::TrajectoryMotionType::JOINT_POINT),
+              received.motion_type);
+  }
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_trajectory_spline_points)
+{
+  std::vector<control::TrajectorySplinePoint> points(2);
+  points[0].positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  points[0].velocities = { 0.1, 0.2, 0.3, -0.1, -0.2, -0.3 };
+  points[0].goal_time = 0.5;
+  points[1].positions = { -0.5, 0.1, 0.2, 0.3, 0.4, 0.5 };
+  points[1].velocities = { 0.4, 0.5, 0.6, -0.4, -0.5, -0.6 };
+  points[1].accelerations = urcl::vector6d_t{ 1.0, 1.1, 1.2, -1.0, -1.1, -1.2 };
+  points[1].goal_time = 1.5;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectorySplinePoints(points.data(), points.size()));
+
+  Client::TrajData received = client_->getData();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(points[0].positions[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(points[0].velocities[i], ((double)received.vel[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(0, received.acc[i]);
+  }
+  EXPECT_EQ(500, received.goal_time);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectorySplineType::SPLINE_CUBIC), received.blend_radius_or_spline_type);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectoryMotionType::JOINT_POINT_SPLINE), received.motion_type);
+
+  received = client_->getData();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(points[1].positions[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(points[1].velocities[i], ((double)received.vel[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ((*points[1].accelerations)[i], ((double)received.acc[i]) / traj_point_interface_->MULT_JOINTSTATE);
+  }
+  EXPECT_EQ(1500, received.goal_time);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectorySplineType::SPLINE_QUINTIC), received.blend_radius_or_spline_type);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_trajectory_spline_segments)
+{
+  std::vector<control::TrajectorySplineSegment> segments(1);
+  segments[0].coefficients3 = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  segments[0].coefficients4 = { 0.1, 0.2, 0.3, -0.1, -0.2, -0.3 };
+  segments[0].coefficients5 = { 1.0, 1.1, 1.2, -1.0, -1.1, -1.2 };
+  segments[0].duration = 0.25;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectorySplineSegments(segments.data(), segments.size()));
+
+  Client::TrajData received = client_->getData();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(segments[0].coefficients3[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(segments[0].coefficients4[i], ((double)received.vel[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(segments[0].coefficients5[i], ((double)received.acc[i]) / traj_point_interface_->MULT_JOINTSTATE);
+  }
+  EXPECT_EQ(250, received.goal_time);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectorySplineType::SPLINE_PRECOMPUTED),
+            received.blend_radius_or_spline_type);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectoryMotionType::JOINT_POINT_SPLINE), received.motion_type);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_process_points)
+{
+  std::vector<control::TrajectoryPoint> points(1);
+  points[0].positions = { 0.3, -0.4, 0.5, 1.1, -1.2, 0.2 };
+  points[0].cartesian = true;
+  points[0].process = true;
+  points[0].velocity = 0.25;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoints(points.data(), points.size()));
+
+  Client::TrajData received = client_->getData();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(points[0].positions[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+  }
+  EXPECT_EQ(std::round(points[0].velocity * traj_point_interface_->MULT_JOINTSTATE), received.vel[0]);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectoryMotionType::PROCESS_POINT), received.motion_type);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_circular_points)
+{
+  std::vector<control::TrajectoryCircularPoint> points(1);
+  points[0].target_pose = { 0.3, -0.4, 0.5, 1.1, -1.2, 0.2 };
+  points[0].via_pose = { 0.2, -0.3, 0.4, 1.0, -1.1, 0.1 };
+  points[0].acceleration = 0.5;
+  points[0].velocity = 0.1;
+  points[0].blend_radius = 0.02;
+  points[0].mode = 1;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryCircularPoints(points.data(), points.size()));
+
+  Client::TrajData received = client_->getData();
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_EQ(points[0].target_pose[i], ((double)received.pos[i]) / traj_point_interface_->MULT_JOINTSTATE);
+    EXPECT_EQ(points[0].via_pose[i], ((double)received.vel[i]) / traj_point_interface_->MULT_JOINTSTATE);
+  }
+  EXPECT_EQ(std::round(points[0].acceleration * traj_point_interface_->MULT_JOINTSTATE), received.acc[0]);
+  EXPECT_EQ(std::round(points[0].velocity * traj_point_interface_->MULT_JOINTSTATE), received.acc[1]);
+  EXPECT_EQ(points[0].mode, received.acc[2]);
+  EXPECT_EQ(0, received.goal_time);
+  EXPECT_EQ(std::round(points[0].blend_radius * traj_point_interface_->MULT_TIME),
+            received.blend_radius_or_spline_type);
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectoryMotionType::CIRCULAR_POINT), received.motion_type);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, write_trajectory_points_matches_single_points)
+{
+  urcl::vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  control::TrajectoryPoint point;
+  point.positions = positions;
+  point.acceleration = 0.7;
+  point.velocity = 0.3;
+  point.goal_time = 1.25;
+  point.blend_radius = 0.02;
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0.7, 0.3, 1.25, 0.02, false));
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoints(&point, 1));
+
+  Client::TrajData single = client_->getData();
+  Client::TrajData bulk = client_->getData();
+  EXPECT_EQ(single.pos, bulk.pos);
+  EXPECT_EQ(single.vel, bulk.vel);
+  EXPECT_EQ(single.acc, bulk.acc);
+  EXPECT_EQ(single.goal_time, bulk.goal_time);
+  EXPECT_EQ(single.blend_radius_or_spline_type, bulk.blend_radius_or_spline_type);
+  EXPECT_EQ(single.motion_type, bulk.motion_type);
+}
+
 TEST_F(TrajectoryPointInterfaceTest, trajectory_result)
 {
   traj_point_interface_->setTrajectoryEndCallback(
@@ -438,6 +640,193 @@ TEST_F(TrajectoryPointInterfaceTest, trajectory_result)
   EXPECT_TRUE(waitTrajectoryEnd(1000, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
 }
 
+TEST_F(TrajectoryPointInterfaceTest, replay_answers)
+{
+  traj_point_interface_->setTrajectoryEndCallback(
+      std::bind(&TrajectoryPointInterfaceTest::handleTrajectoryEnd, this, std::placeholders::_1));
+
+  EXPECT_EQ(control::TrajectoryReplayResult::NO_ANSWER,
+            traj_point_interface_->waitForReplayAnswer(std::chrono::milliseconds(50)));
+
+  client_->send(control::TrajectoryPointInterface::REPLAY_NOT_CACHED);
+  EXPECT_EQ(control::TrajectoryReplayResult::NOT_CACHED,
+            traj_point_interface_->waitForReplayAnswer(std::chrono::seconds(1)));
+
+  traj_point_interface_->resetReplayAnswer();
+  client_->send(control::TrajectoryPointInterface::REPLAY_STARTED);
+  EXPECT_EQ(control::TrajectoryReplayResult::STARTED,
+            traj_point_interface_->waitForReplayAnswer(std::chrono::seconds(1)));
+
+  // Answers don't end the trajectory, so no result is reported
+  EXPECT_TRUE(waitTrajectoryEnd(100, control::TrajectoryResult::TRAJECTORY_RESULT_UNKNOWN));
+  client_->send(toUnderlying(control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
+  EXPECT_TRUE(waitTrajectoryEnd(1000, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
+}
+
+TEST_F(TrajectoryPointInterfaceTest, stream_window_blocks_until_points_are_consumed)
+{
+  urcl::vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  traj_point_interface_->startTrajectoryStream(2);
+  EXPECT_TRUE(traj_point_interface_->isStreaming());
+
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  EXPECT_EQ(2u, traj_point_interface_->getPointsInFlight());
+  EXPECT_FALSE(traj_point_interface_->waitForStreamWindow(std::chrono::milliseconds(50)));
+
+  auto third_write = std::async(std::launch::async, [&]() {
+    return traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false);
+  });
+  EXPECT_EQ(std::future_status::timeout, third_write.wait_for(std::chrono::milliseconds(100)));
+
+  client_->getData();
+  client_->send(control::TrajectoryPointInterface::STREAM_POINT_CONSUMED);
+  ASSERT_EQ(std::future_status::ready, third_write.wait_for(std::chrono::seconds(1)));
+  EXPECT_TRUE(third_write.get());
+  EXPECT_EQ(2u, traj_point_interface_->getPointsInFlight());
+
+  client_->getData();
+  client_->getData();
+  client_->send(control::TrajectoryPointInterface::STREAM_POINT_CONSUMED);
+  EXPECT_TRUE(traj_point_interface_->waitForStreamWindow(std::chrono::seconds(1)));
+}
+
+TEST_F(TrajectoryPointInterfaceTest, stream_splits_bulk_writes_into_window)
+{
+  std::vector<control::TrajectoryPoint> points(5);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i].positions = { 0.1 * i, 0, 0, 0, 0, 0 };
+  }
+  traj_point_interface_->startTrajectoryStream(2);
+
+  auto write = std::async(std::launch::async,
+                          [&]() { return traj_point_interface_->writeTrajectoryPoints(points.data(), points.size()); });
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    Client::TrajData received = client_->getData();
+    EXPECT_EQ(static_cast<int32_t>(i) * 100000, received.pos[0]);
+    EXPECT_LE(traj_point_interface_->getPointsInFlight(), 2u);
+    client_->send(control::TrajectoryPointInterface::STREAM_POINT_CONSUMED);
+  }
+  ASSERT_EQ(std::future_status::ready, write.wait_for(std::chrono::seconds(1)));
+  EXPECT_TRUE(write.get());
+}
+
+TEST_F(TrajectoryPointInterfaceTest, end_trajectory_stream)
+{
+  urcl::vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  EXPECT_THROW(traj_point_interface_->startTrajectoryStream(0), UrException);
+
+  traj_point_interface_->startTrajectoryStream(1);
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  EXPECT_TRUE(traj_point_interface_->endTrajectoryStream());
+  EXPECT_FALSE(traj_point_interface_->isStreaming());
+
+  client_->getData();
+  Client::TrajData end_marker = client_->getData();
+  EXPECT_EQ(static_cast<int32_t>(control::TrajectoryMotionType::STREAM_END), end_marker.motion_type);
+  EXPECT_EQ(0, end_marker.pos[0]);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, trajectory_result_ends_stream)
+{
+  urcl::vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  traj_point_interface_->setTrajectoryEndCallback(
+      std::bind(&TrajectoryPointInterfaceTest::handleTrajectoryEnd, this, std::placeholders::_1));
+  traj_point_interface_->startTrajectoryStream(1);
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+
+  auto blocked_write = std::async(std::launch::async, [&]() {
+    return traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false);
+  });
+  EXPECT_EQ(std::future_status::timeout, blocked_write.wait_for(std::chrono::milliseconds(100)));
+
+  client_->send(toUnderlying(control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE));
+  EXPECT_TRUE(waitTrajectoryEnd(1000, control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE));
+  ASSERT_EQ(std::future_status::ready, blocked_write.wait_for(std::chrono::seconds(1)));
+  EXPECT_FALSE(blocked_write.get());
+  EXPECT_FALSE(traj_point_interface_->isStreaming());
+}
+
+TEST_F(TrajectoryPointInterfaceTest, canceled_writes_are_rejected_until_resumed)
+{
+  urcl::vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  traj_point_interface_->startTrajectoryStream(1);
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  auto blocked_write = std::async(std::launch::async, [&]() {
+    return traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false);
+  });
+  EXPECT_EQ(std::future_status::timeout, blocked_write.wait_for(std::chrono::milliseconds(100)));
+
+  // Only the first point fit into the window
+  EXPECT_EQ(1u, traj_point_interface_->cancelTrajectoryWrites());
+  EXPECT_TRUE(traj_point_interface_->isTrajectoryWritingCanceled());
+  ASSERT_EQ(std::future_status::ready, blocked_write.wait_for(std::chrono::seconds(1)));
+  EXPECT_FALSE(blocked_write.get());
+  EXPECT_FALSE(traj_point_interface_->isStreaming());
+  client_->getData();
+
+  EXPECT_FALSE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  traj_point_interface_->startTrajectoryBatch();
+  EXPECT_FALSE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  EXPECT_FALSE(traj_point_interface_->flushTrajectoryBatch());
+  EXPECT_FALSE(traj_point_interface_->endTrajectoryStream());
+  EXPECT_EQ(1u, traj_point_interface_->cancelTrajectoryWrites());
+
+  traj_point_interface_->resumeTrajectoryWrites();
+  EXPECT_FALSE(traj_point_interface_->isTrajectoryWritingCanceled());
+  positions[0] = 0.5;
+  EXPECT_TRUE(traj_point_interface_->writeTrajectoryPoint(&positions, 0, 0, false));
+  EXPECT_EQ(500000, client_->getPosition()[0]);
+  EXPECT_TRUE(traj_point_interface_->endTrajectoryStream());
+  client_->getData();
+  // The end of a stream counts as a point, the robot reads it as well
+  EXPECT_EQ(2u, traj_point_interface_->cancelTrajectoryWrites());
+}
+
+TEST_F(TrajectoryPointInterfaceTest, cancel_stops_upload_in_progress)
+{
+  // Much more than fits into the socket buffers, so the upload blocks until the robot reads
+  std::vector<control::TrajectoryPoint> points(200000);
+  auto upload = std::async(std::launch::async, [&]() {
+    return traj_point_interface_->writeTrajectoryPoints(points.data(), points.size());
+  });
+  EXPECT_EQ(std::future_status::timeout, upload.wait_for(std::chrono::milliseconds(200)));
+
+  const size_t points_written = traj_point_interface_->cancelTrajectoryWrites();
+  const size_t received = client_->drain(std::chrono::milliseconds(200));
+  ASSERT_EQ(std::future_status::ready, upload.wait_for(std::chrono::seconds(1)));
+  EXPECT_FALSE(upload.get());
+
+  // The upload stops in between whole points, the robot discards exactly the ones written
+  const size_t message_size = sizeof(int32_t) * control::TrajectoryPointInterface::MESSAGE_LENGTH;
+  EXPECT_EQ(0u, received % message_size);
+  EXPECT_LT(received / message_size, points.size());
+  EXPECT_EQ(points_written, received / message_size);
+}
+
+TEST_F(TrajectoryPointInterfaceTest, points_delivered_late_are_counted_when_canceling)
+{
+  // The upload blocks in the middle of a chunk, which is only sent completely once the robot reads
+  std::vector<control::TrajectoryPoint> points(200000);
+  auto upload = std::async(std::launch::async, [&]() {
+    return traj_point_interface_->writeTrajectoryPoints(points.data(), points.size());
+  });
+  EXPECT_EQ(std::future_status::timeout, upload.wait_for(std::chrono::milliseconds(200)));
+  const size_t points_written = traj_point_interface_->cancelTrajectoryWrites();
+
+  // Much longer than the robot used to wait for further points of a canceled trajectory
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const size_t received = client_->drain(std::chrono::milliseconds(200));
+  ASSERT_EQ(std::future_status::ready, upload.wait_for(std::chrono::seconds(1)));
+  EXPECT_FALSE(upload.get());
+
+  const size_t message_size = sizeof(int32_t) * control::TrajectoryPointInterface::MESSAGE_LENGTH;
+  EXPECT_EQ(points_written * message_size, received);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,104 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ur_client_library/control/trajectory_progress_monitor.h"
+
+using namespace urcl;
+
+class TrajectoryProgressMonitorTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    package_.initEmpty();
+    monitor_.setProgressCallback(
+        [this](const control::TrajectoryProgress& progress) { reported_.push_back(progress); });
+  }
+
+  void passCycle(double robot_time, int32_t point_index, double time_left)
+  {
+    package_.setData("timestamp", robot_time);
+    package_.setData("output_int_register_20", point_index);
+    package_.setData("output_double_register_21", time_left);
+    monitor_.onDataPackage(package_);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_ =
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{
+          "timestamp", "output_int_register_20", "output_double_register_21" });
+  rtde_interface::DataPackage package_{ recipe_ };
+  control::TrajectoryProgressMonitor monitor_{ 20, 21 };
+  std::vector<control::TrajectoryProgress> reported_;
+};
+
+TEST_F(TrajectoryProgressMonitorTest, reports_every_cycle_of_a_trajectory)
+{
+  EXPECT_EQ(monitor_.getIndexField(), "output_int_register_20");
+  EXPECT_EQ(monitor_.getTimeField(), "output_double_register_21");
+
+  // Nothing is reported while no trajectory is executed
+  passCycle(1.0, -1, 0.0);
+  EXPECT_TRUE(reported_.empty());
+  EXPECT_EQ(monitor_.getProgress().point_index, -1);
+
+  passCycle(1.002, 0, 0.5);
+  passCycle(1.004, 0, 0.498);
+  passCycle(1.006, 1, 1.0);
+  passCycle(1.008, -1, 0.0);
+  passCycle(1.010, -1, 0.0);
+
+  ASSERT_EQ(reported_.size(), 4u);
+  EXPECT_EQ(reported_[0].point_index, 0);
+  EXPECT_DOUBLE_EQ(reported_[0].time_left, 0.5);
+  EXPECT_DOUBLE_EQ(reported_[0].robot_time, 1.002);
+  EXPECT_DOUBLE_EQ(reported_[1].time_left, 0.498);
+  EXPECT_EQ(reported_[2].point_index, 1);
+  // The cycle the trajectory has ended in is reported once
+  EXPECT_EQ(reported_[3].point_index, -1);
+  EXPECT_DOUBLE_EQ(monitor_.getProgress().robot_time, 1.010);
+}
+
+TEST_F(TrajectoryProgressMonitorTest, packages_without_registers_are_ignored)
+{
+  rtde_interface::DataPackage package(
+      std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp" }));
+  package.initEmpty();
+  monitor_.onDataPackage(package);
+  EXPECT_TRUE(reported_.empty());
+
+  // Switching back to a recipe with the registers resolves them again
+  passCycle(2.0, 3, 0.1);
+  ASSERT_EQ(reported_.size(), 1u);
+  EXPECT_EQ(reported_[0].point_index, 3);
+}
@@ -0,0 +1,226 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ur_client_library/control/trajectory_reducer.h"
+#include "ur_client_library/exceptions.h"
+
+using namespace urcl;
+using namespace urcl::control;
+
+namespace
+{
+std::shared_ptr<kinematics::KinematicsModel> ur5eModel()
+{
+  kinematics::DHParameters parameters;
+  parameters.theta = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  parameters.a = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+  parameters.d = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+  parameters.alpha = { M_PI_2, 0.0, 0.0, M_PI_2, -M_PI_2, 0.0 };
+  return std::make_shared<kinematics::KinematicsModel>(parameters);
+}
+
+vector6d_t lineTarget(const double s)
+{
+  return { 0.5 * s, -1.0 + 0.2 * s, 1.0 - 0.3 * s, -1.5, -1.5, 0.1 * s };
+}
+
+// Follows lineTarget() up to s = 0.5 and turns to another direction afterwards
+vector6d_t cornerTarget(const double s)
+{
+  vector6d_t target = lineTarget(s);
+  target[4] += 0.4 * std::max(s - 0.5, 0.0);
+  return target;
+}
+
+// Samples the quintic q(t) = t^5 - 2 t^3 + t of every joint at the given number of points
+std::vector<TrajectorySplinePoint> quinticSamples(const size_t count, const double step)
+{
+  std::vector<TrajectorySplinePoint> points(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double t = step * static_cast<double>(i);
+    const double q = std::pow(t, 5) - 2.0 * std::pow(t, 3) + t;
+    const double qd = 5.0 * std::pow(t, 4) - 6.0 * t * t + 1.0;
+    const double qdd = 20.0 * std::pow(t, 3) - 12.0 * t;
+    points[i].positions = { q, q, q, q, q, q };
+    points[i].velocities = { qd, qd, qd, qd, qd, qd };
+    points[i].accelerations = vector6d_t{ qdd, qdd, qdd, qdd, qdd, qdd };
+    points[i].goal_time = i == 0 ? 0.0 : step;
+  }
+  return points;
+}
+}  // namespace
+
+TEST(trajectory_reducer, rejects_invalid_options)
+{
+  TrajectoryReductionOptions options;
+  options.joint_tolerance = -0.1;
+  EXPECT_THROW(TrajectoryReducer reducer(options), UrException);
+  options = TrajectoryReductionOptions();
+  options.blend_radius = -0.1;
+  EXPECT_THROW(TrajectoryReducer reducer(options), UrException);
+  options = TrajectoryReductionOptions();
+  options.max_merged_segments = 0;
+  EXPECT_THROW(TrajectoryReducer reducer(options), UrException);
+}
+
+TEST(trajectory_reducer, removes_collinear_joint_targets)
+{
+  TrajectoryReducer reducer(TrajectoryReductionOptions{});
+  std::vector<MotionPrimitiveValue> motions;
+  for (size_t i = 0; i <= 10; ++i)
+  {
+    motions.push_back(MoveJPrimitive(lineTarget(0.1 * i), 0.0, std::chrono::milliseconds(100)));
+  }
+
+  std::vector<MotionPrimitiveValue> reduced;
+  EXPECT_EQ(reducer.reduce(motions, reduced), 9u);
+  ASSERT_EQ(reduced.size(), 2u);
+  const auto& first = std::get<MoveJPrimitive>(reduced[0]);
+  const auto& last = std::get<MoveJPrimitive>(reduced[1]);
+  EXPECT_EQ(first.target_joint_configuration, lineTarget(0.0));
+  EXPECT_NEAR(first.duration.count(), 0.1, 1e-12);
+  EXPECT_EQ(last.target_joint_configuration, lineTarget(1.0));
+  // The remaining motion takes as long as the ones it replaces
+  EXPECT_NEAR(last.duration.count(), 1.0, 1e-12);
+}
+
+TEST(trajectory_reducer, keeps_points_deviating_from_the_path)
+{
+  TrajectoryReductionOptions options;
+  options.joint_tolerance = 0.01;
+  TrajectoryReducer reducer(options);
+
+  std::vector<MotionPrimitiveValue> motions;
+  for (size_t i = 0; i <= 10; ++i)
+  {
+    motions.push_back(MoveJPrimitive(cornerTarget(0.1 * i)));
+  }
+  // A point within tolerance of the path
+  std::get<MoveJPrimitive>(motions[8]).target_joint_configuration[0] += 0.005;
+
+  std::vector<MotionPrimitiveValue> reduced;
+  reducer.reduce(motions, reduced);
+  ASSERT_EQ(reduced.size(), 3u);
+  EXPECT_EQ(std::get<MoveJPrimitive>(reduced[1]).target_joint_configuration, cornerTarget(0.5));
+
+  // Motions of different speeds and other primitives split the runs
+  motions[3] = MoveJPrimitive(cornerTarget(0.3), 0.0, std::chrono::milliseconds(0), 1.4, 0.5);
+  motions.insert(motions.begin() + 7, MoveLPrimitive(Pose(0.3, 0.2, 0.5, 0.0, M_PI, 0.0)));
+  reducer.reduce(motions, reduced);
+  ASSERT_EQ(reduced.size(), 9u);
+  EXPECT_TRUE(std::holds_alternative<MoveLPrimitive>(reduced[6]));
+  EXPECT_EQ(std::get<MoveJPrimitive>(reduced[7]).target_joint_configuration,
+            std::get<MoveJPrimitive>(motions[8]).target_joint_configuration);
+  EXPECT_EQ(std::get<MoveJPrimitive>(reduced[8]).target_joint_configuration, cornerTarget(1.0));
+}
+
+TEST(trajectory_reducer, selects_blend_radii)
+{
+  TrajectoryReductionOptions options;
+  options.joint_tolerance = 0.01;
+  options.blend_radius = 0.05;
+  std::vector<MotionPrimitiveValue> motions;
+  for (size_t i = 0; i <= 10; ++i)
+  {
+    motions.push_back(MoveJPrimitive(cornerTarget(0.1 * i)));
+  }
+
+  std::vector<MotionPrimitiveValue> reduced;
+  TrajectoryReducer reducer(options);
+  reducer.reduce(motions, reduced);
+  ASSERT_EQ(reduced.size(), 3u);
+  EXPECT_DOUBLE_EQ(std::get<MoveJPrimitive>(reduced[0]).blend_radius, 0.0);
+  EXPECT_DOUBLE_EQ(std::get<MoveJPrimitive>(reduced[1]).blend_radius, 0.05);
+  EXPECT_DOUBLE_EQ(std::get<MoveJPrimitive>(reduced[2]).blend_radius, 0.0);
+
+  // With kinematics, blends must not overlap
+  auto model = ur5eModel();
+  options.model = model;
+  options.blend_radius = 10.0;
+  TrajectoryReducer limited_reducer(options);
+  limited_reducer.reduce(motions, reduced);
+  ASSERT_EQ(reduced.size(), 3u);
+  const vector6d_t start = model->forward(cornerTarget(0.0));
+  const vector6d_t corner = model->forward(cornerTarget(0.5));
+  const vector6d_t end = model->forward(cornerTarget(1.0));
+  auto distance = [](const vector6d_t& a, const vector6d_t& b) {
+    return std::sqrt(std::pow(a[0] - b[0], 2) + std::pow(a[1] - b[1], 2) + std::pow(a[2] - b[2], 2));
+  };
+  EXPECT_NEAR(std::get<MoveJPrimitive>(reduced[1]).blend_radius,
+              0.5 * std::min(distance(start, corner), distance(corner, end)), 1e-12);
+}
+
+TEST(trajectory_reducer, removes_spline_points_on_the_interpolated_spline)
+{
+  // Any segment between samples of a single quintic is that quintic
+  const std::vector<TrajectorySplinePoint> points = quinticSamples(51, 1.0 / 64.0);
+  TrajectoryReductionOptions options;
+  options.joint_tolerance = 1e-9;
+  options.max_merged_segments = 10;
+  TrajectoryReducer reducer(options);
+
+  std::vector<TrajectorySplinePoint> reduced;
+  EXPECT_EQ(reducer.reduce(points, reduced), 45u);
+  ASSERT_EQ(reduced.size(), 6u);
+  EXPECT_EQ(reduced[0].positions, points[0].positions);
+  EXPECT_EQ(reduced[5].positions, points[50].positions);
+  for (size_t i = 1; i < reduced.size(); ++i)
+  {
+    EXPECT_EQ(reduced[i].positions, points[10 * i].positions);
+    EXPECT_FLOAT_EQ(reduced[i].goal_time, 10.0 / 64.0);
+  }
+
+  // The same points as cubic splines don't match the interpolation between fewer points
+  std::vector<TrajectorySplinePoint> cubic_points = points;
+  for (auto& point : cubic_points)
+  {
+    point.accelerations.reset();
+  }
+  EXPECT_LT(reducer.reduce(cubic_points, reduced), 45u);
+
+  // Spline primitives are reduced the same way
+  std::vector<MotionPrimitiveValue> motions;
+  for (const auto& point : points)
+  {
+    motions.push_back(SplinePrimitive(point.positions, point.velocities, point.accelerations,
+                                      std::chrono::duration<double>(point.goal_time)));
+  }
+  std::vector<MotionPrimitiveValue> reduced_motions;
+  EXPECT_EQ(reducer.reduce(motions, reduced_motions), 45u);
+  EXPECT_DOUBLE_EQ(std::get<SplinePrimitive>(reduced_motions[3]).duration.count(), 10.0 / 64.0);
+}
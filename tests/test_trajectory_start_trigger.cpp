@@ -0,0 +1,125 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/control/trajectory_start_trigger.h"
+
+using namespace urcl;
+
+class TrajectoryStartTriggerTest : public ::testing::Test
+{
+protected:
+  TrajectoryStartTriggerTest()
+    : recipe_(std::make_shared<const rtde_interface::CompiledRecipe>(std::vector<std::string>{ "timestamp" }))
+    , package_(recipe_)
+    , write_([this](const int32_t token) {
+      written_.push_back(token);
+      return write_succeeds_;
+    })
+  {
+    package_.initEmpty();
+  }
+
+  void receive(const double timestamp)
+  {
+    package_.setData("timestamp", timestamp);
+    trigger_.onDataPackage(package_, write_);
+  }
+
+  std::shared_ptr<const rtde_interface::CompiledRecipe> recipe_;
+  rtde_interface::DataPackage package_;
+  control::TrajectoryStartTrigger::WriteFunction write_;
+  control::TrajectoryStartTrigger trigger_;
+  std::vector<int32_t> written_;
+  bool write_succeeds_ = true;
+};
+
+TEST_F(TrajectoryStartTriggerTest, writes_token_one_period_ahead)
+{
+  receive(10.000);
+  trigger_.schedule(42, 10.010);
+  EXPECT_EQ(trigger_.getState(), control::TrajectoryStartTrigger::State::PENDING);
+
+  receive(10.002);
+  receive(10.004);
+  receive(10.006);
+  EXPECT_TRUE(written_.empty());
+
+  // The robot reads the register in the cycle after this package
+  receive(10.008);
+  ASSERT_EQ(written_.size(), 1u);
+  EXPECT_EQ(written_[0], 42);
+  EXPECT_EQ(trigger_.getState(), control::TrajectoryStartTrigger::State::FIRED);
+  EXPECT_DOUBLE_EQ(trigger_.getTriggerTime(), 10.008);
+  EXPECT_TRUE(trigger_.waitForTrigger(std::chrono::milliseconds(0)));
+
+  // The token is written once
+  receive(10.010);
+  EXPECT_EQ(written_.size(), 1u);
+}
+
+TEST_F(TrajectoryStartTriggerTest, past_start_time_triggers_right_away)
+{
+  trigger_.schedule(7, 5.0);
+  receive(10.0);
+  ASSERT_EQ(written_.size(), 1u);
+  EXPECT_EQ(written_[0], 7);
+}
+
+TEST_F(TrajectoryStartTriggerTest, cancel)
+{
+  EXPECT_FALSE(trigger_.waitForTrigger(std::chrono::milliseconds(0)));
+
+  trigger_.schedule(42, 20.0);
+  std::thread canceller([this] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    trigger_.cancel();
+  });
+  EXPECT_FALSE(trigger_.waitForTrigger(std::chrono::seconds(5)));
+  canceller.join();
+  EXPECT_EQ(trigger_.getState(), control::TrajectoryStartTrigger::State::IDLE);
+
+  receive(20.0);
+  EXPECT_TRUE(written_.empty());
+}
+
+TEST_F(TrajectoryStartTriggerTest, failed_write)
+{
+  write_succeeds_ = false;
+  trigger_.schedule(42, 1.0);
+  receive(1.0);
+  EXPECT_EQ(written_.size(), 1u);
+  EXPECT_EQ(trigger_.getState(), control::TrajectoryStartTrigger::State::FAILED);
+  EXPECT_FALSE(trigger_.waitForTrigger(std::chrono::milliseconds(0)));
+}
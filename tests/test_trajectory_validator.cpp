@@ -0,0 +1,243 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "ur_client_library/control/trajectory_validator.h"
+#include "ur_client_library/exceptions.h"
+
+using namespace urcl;
+using namespace urcl::control;
+
+namespace
+{
+JointLimits testLimits()
+{
+  JointLimits limits;
+  limits.max_velocity = { 2.0, 2.0, 3.0, 3.0, 3.0, 3.0 };
+  limits.max_acceleration = { 5.0, 5.0, 10.0, 10.0, 10.0, 10.0 };
+  return limits;
+}
+
+std::shared_ptr<kinematics::KinematicsModel> ur5eModel()
+{
+  kinematics::DHParameters parameters;
+  parameters.theta = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  parameters.a = { 0.0, -0.425, -0.3922, 0.0, 0.0, 0.0 };
+  parameters.d = { 0.1625, 0.0, 0.0, 0.1333, 0.0997, 0.0996 };
+  parameters.alpha = { M_PI_2, 0.0, 0.0, M_PI_2, -M_PI_2, 0.0 };
+  return std::make_shared<kinematics::KinematicsModel>(parameters);
+}
+
+std::vector<TrajectorySplinePoint> splineTrajectory(const size_t count)
+{
+  std::vector<TrajectorySplinePoint> points(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double q = 0.001 * static_cast<double>(i + 1);
+    points[i].positions = { q, -q, q, -q, q, -q };
+    points[i].velocities = { 1.0, -1.0, 1.0, -1.0, 1.0, -1.0 };
+    points[i].accelerations = vector6d_t{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    points[i].goal_time = 0.01;
+  }
+  return points;
+}
+}  // namespace
+
+TEST(trajectory_validator, rejects_invalid_limits)
+{
+  JointLimits limits = testLimits();
+  limits.max_velocity[3] = 0.0;
+  EXPECT_THROW(TrajectoryValidator validator(limits), UrException);
+
+  const vector6d_t lower = { -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+  const vector6d_t upper = { 1.0, 1.0, 1.0, 1.0, -2.0, 1.0 };
+  EXPECT_THROW(TrajectoryValidator validator(testLimits(), lower, upper), UrException);
+
+  TrajectoryValidator validator(testLimits());
+  EXPECT_THROW(validator.setWorkspace({ 0.0, 0.0, 1.0 }, { 1.0, 1.0, 0.0 }), UrException);
+}
+
+TEST(trajectory_validator, accepts_valid_spline_trajectory)
+{
+  TrajectoryValidator validator(testLimits());
+  const std::vector<TrajectorySplinePoint> points = splineTrajectory(1000);
+  const TrajectoryValidationResult result = validator.validate(points.data(), points.size());
+  EXPECT_TRUE(result);
+  EXPECT_EQ(result.violation, TrajectoryViolation::NONE);
+}
+
+TEST(trajectory_validator, reports_first_violating_spline_point)
+{
+  TrajectoryValidator validator(testLimits());
+  std::vector<TrajectorySplinePoint> points = splineTrajectory(100);
+
+  points[40].positions[2] = 7.0;
+  points[60].velocities[0] = 2.5;
+  TrajectoryValidationResult result = validator.validate(points.data(), points.size());
+  EXPECT_FALSE(result);
+  EXPECT_EQ(result.violation, TrajectoryViolation::POSITION_LIMIT);
+  EXPECT_EQ(result.index, 40u);
+
+  points = splineTrajectory(100);
+  points[60].velocities[0] = 2.5;
+  result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::VELOCITY_LIMIT);
+  EXPECT_EQ(result.index, 60u);
+
+  points = splineTrajectory(100);
+  points[70].accelerations = vector6d_t{ 0.0, 0.0, 0.0, 0.0, 0.0, -10.5 };
+  result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::ACCELERATION_LIMIT);
+  EXPECT_EQ(result.index, 70u);
+
+  points = splineTrajectory(100);
+  points[80].positions[4] = std::numeric_limits<double>::quiet_NaN();
+  result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::INVALID_VALUE);
+  EXPECT_EQ(result.index, 80u);
+}
+
+TEST(trajectory_validator, checks_velocity_needed_to_reach_spline_points)
+{
+  TrajectoryValidator validator(testLimits());
+  std::vector<TrajectorySplinePoint> points = splineTrajectory(10);
+  // 0.041 rad within 0.01 s needs 4.1 rad/s
+  points[5].positions[0] += 0.04;
+  TrajectoryValidationResult result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::VELOCITY_LIMIT);
+  EXPECT_EQ(result.index, 5u);
+
+  // Only the first point may have a goal time of zero
+  points = splineTrajectory(10);
+  points[0].goal_time = 0.0;
+  EXPECT_TRUE(validator.validate(points.data(), points.size()));
+  points[3].goal_time = 0.0;
+  result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::INVALID_VALUE);
+  EXPECT_EQ(result.index, 3u);
+}
+
+TEST(trajectory_validator, checks_joint_motions)
+{
+  const vector6d_t lower = { -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+  const vector6d_t upper = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  TrajectoryValidator validator(testLimits(), lower, upper);
+
+  std::vector<MotionPrimitiveValue> motions;
+  motions.push_back(MoveJPrimitive({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, 0.0, std::chrono::seconds(0), 1.4, 1.04));
+  motions.push_back(MoveJPrimitive({ 0.5, 0.5, 0.5, 0.5, 0.5, 0.5 }, 0.0, std::chrono::seconds(1)));
+  motions.push_back(MoveLPrimitive(Pose(0.3, 0.2, 0.5, 0.0, M_PI, 0.0)));
+  EXPECT_TRUE(validator.validate(motions));
+
+  // The leading axis can't be faster than the fastest joint
+  motions[0] = MoveJPrimitive({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }, 0.0, std::chrono::seconds(0), 1.4, 3.5);
+  TrajectoryValidationResult result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::VELOCITY_LIMIT);
+  EXPECT_EQ(result.index, 0u);
+
+  // 1 rad within 0.25 s needs 4 rad/s
+  motions[0] = MoveJPrimitive({ -0.5, 0.0, 0.0, 0.0, 0.0, 0.0 });
+  motions[1] = MoveJPrimitive({ 0.5, 0.0, 0.0, 0.0, 0.0, 0.0 }, 0.0, std::chrono::milliseconds(250));
+  result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::VELOCITY_LIMIT);
+  EXPECT_EQ(result.index, 1u);
+
+  motions[1] = MoveJPrimitive({ 0.5, 0.0, 0.0, 1.2, 0.0, 0.0 });
+  result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::POSITION_LIMIT);
+  EXPECT_EQ(result.index, 1u);
+
+  // The same applies to primitives stored as shared pointers
+  std::vector<std::shared_ptr<MotionPrimitive>> shared_motions;
+  shared_motions.push_back(std::make_shared<MoveJPrimitive>(vector6d_t{ -0.5, 0.0, 0.0, 0.0, 0.0, 0.0 }));
+  shared_motions.push_back(std::make_shared<MoveJPrimitive>(vector6d_t{ 0.5, 0.0, 0.0, 1.2, 0.0, 0.0 }));
+  result = validator.validate(shared_motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::POSITION_LIMIT);
+  EXPECT_EQ(result.index, 1u);
+
+  std::vector<TrajectoryPoint> points(2);
+  points[0].positions = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  points[1].positions = { 0.3, 0.2, 0.5, 0.0, M_PI, 0.0 };
+  points[1].cartesian = true;
+  points[1].velocity = -0.1;
+  result = validator.validate(points.data(), points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::INVALID_VALUE);
+  EXPECT_EQ(result.index, 1u);
+}
+
+TEST(trajectory_validator, checks_cartesian_workspace)
+{
+  TrajectoryValidator validator(testLimits());
+  validator.setWorkspace({ -0.6, -0.6, 0.0 }, { 0.6, 0.6, 0.8 });
+
+  std::vector<TrajectoryCircularPoint> circular_points(1);
+  circular_points[0].via_pose = { 0.3, 0.0, 0.3, 0.0, M_PI, 0.0 };
+  circular_points[0].target_pose = { 0.3, 0.3, 0.3, 0.0, M_PI, 0.0 };
+  EXPECT_TRUE(validator.validate(circular_points.data(), circular_points.size()));
+  circular_points[0].via_pose[2] = -0.1;
+  TrajectoryValidationResult result = validator.validate(circular_points.data(), circular_points.size());
+  EXPECT_EQ(result.violation, TrajectoryViolation::WORKSPACE);
+  EXPECT_EQ(result.index, 0u);
+
+  // Without a model, joint targets can't be checked against the workspace
+  const vector6d_t home = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  std::vector<MotionPrimitiveValue> motions = { MoveJPrimitive(home) };
+  EXPECT_TRUE(validator.validate(motions));
+
+  // The TCP of a UR5e is at x = -0.817 with all joints at zero
+  auto model = ur5eModel();
+  validator.setWorkspace({ -0.6, -0.6, 0.0 }, { 0.6, 0.6, 0.8 }, model);
+  const vector6d_t inside = { 0.0, -M_PI_2, M_PI_2, -M_PI_2, -M_PI_2, 0.0 };
+  const vector6d_t inside_pose = model->forward(inside);
+  ASSERT_LT(std::abs(inside_pose[0]), 0.6);
+  ASSERT_LT(std::abs(inside_pose[1]), 0.6);
+  ASSERT_GT(inside_pose[2], 0.0);
+  motions = { MoveJPrimitive(inside), MoveJPrimitive(inside), MoveJPrimitive(home), MoveJPrimitive(inside) };
+  result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::WORKSPACE);
+  EXPECT_EQ(result.index, 2u);
+
+  // An earlier workspace violation takes precedence over a later limit violation
+  motions[3] = MoveJPrimitive({ 7.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+  result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::WORKSPACE);
+  EXPECT_EQ(result.index, 2u);
+
+  validator.clearWorkspace();
+  result = validator.validate(motions);
+  EXPECT_EQ(result.violation, TrajectoryViolation::POSITION_LIMIT);
+  EXPECT_EQ(result.index, 3u);
+}
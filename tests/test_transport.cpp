@@ -0,0 +1,186 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "ur_client_library/comm/stream.h"
+#include "ur_client_library/comm/transport.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/rtde_package.h"
+#include "ur_client_library/ur/dashboard_client.h"
+
+using namespace urcl;
+
+namespace
+{
+std::string readLine(comm::InMemoryTransport& transport)
+{
+  std::string line;
+  uint8_t character;
+  size_t read;
+  while (transport.read(&character, 1, read))
+  {
+    line += static_cast<char>(character);
+    if (character == '\n')
+    {
+      break;
+    }
+  }
+  return line;
+}
+
+void writeLine(comm::InMemoryTransport& transport, const std::string& line)
+{
+  size_t written;
+  transport.write(reinterpret_cast<const uint8_t*>(line.data()), line.size(), written);
+}
+}  // namespace
+
+TEST(TransportTest, in_memory_pair)
+{
+  auto pair = comm::InMemoryTransport::createPair();
+  uint8_t data[] = { 1, 2, 3, 4, 5 };
+  size_t written;
+  ASSERT_TRUE(pair.first->write(data, sizeof(data), written));
+  EXPECT_EQ(written, sizeof(data));
+  EXPECT_TRUE(pair.second->poll(std::chrono::milliseconds(0)));
+
+  uint8_t buf[3];
+  size_t read;
+  ASSERT_TRUE(pair.second->read(buf, sizeof(buf), read));
+  EXPECT_EQ(read, 3u);
+  EXPECT_EQ(buf[2], 3);
+  ASSERT_TRUE(pair.second->read(buf, sizeof(buf), read));
+  EXPECT_EQ(read, 2u);
+  EXPECT_EQ(buf[1], 5);
+
+  pair.second->setReceiveTimeout(std::chrono::milliseconds(10));
+  EXPECT_FALSE(pair.second->poll(std::chrono::milliseconds(10)));
+  EXPECT_FALSE(pair.second->read(buf, sizeof(buf), read));
+  EXPECT_TRUE(pair.second->isConnected());
+
+  // Data sent before closing can still be read
+  ASSERT_TRUE(pair.first->write(data, sizeof(data), written));
+  pair.first->close();
+  EXPECT_FALSE(pair.first->write(data, sizeof(data), written));
+  EXPECT_TRUE(pair.second->isConnected());
+  ASSERT_TRUE(pair.second->read(buf, sizeof(buf), read));
+  ASSERT_TRUE(pair.second->read(buf, sizeof(buf), read));
+  EXPECT_FALSE(pair.second->isConnected());
+  EXPECT_FALSE(pair.second->read(buf, sizeof(buf), read));
+
+  // Reconnecting starts over
+  EXPECT_TRUE(pair.second->connect("", 0));
+  EXPECT_TRUE(pair.first->isConnected());
+  EXPECT_FALSE(pair.second->poll(std::chrono::milliseconds(0)));
+}
+
+TEST(TransportTest, stream_over_custom_transport)
+{
+  auto pair = comm::InMemoryTransport::createPair();
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 0);
+  stream.setTransport(pair.first);
+  ASSERT_TRUE(stream.connect());
+  EXPECT_EQ(stream.getState(), comm::SocketState::Connected);
+  EXPECT_EQ(stream.getSocketFD(), -1);
+  EXPECT_THROW(stream.setTransport(nullptr), UrException);
+
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5 };
+  size_t written;
+  // Written in two parts, the stream has to put the package back together
+  ASSERT_TRUE(pair.second->write(data_package, 5, written));
+  ASSERT_TRUE(pair.second->write(data_package + 5, sizeof(data_package) - 5, written));
+  EXPECT_TRUE(stream.poll(std::chrono::milliseconds(0)));
+
+  uint8_t buf[4096];
+  size_t read = 0;
+  ASSERT_TRUE(stream.read(buf, sizeof(buf), read));
+  ASSERT_EQ(read, sizeof(data_package));
+  EXPECT_TRUE(std::equal(buf, buf + read, data_package));
+
+  ASSERT_TRUE(stream.write(data_package, sizeof(data_package), written));
+  ASSERT_TRUE(pair.second->read(buf, sizeof(buf), read));
+  EXPECT_EQ(read, sizeof(data_package));
+
+  // The receive timeout is passed on to the transport
+  timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = 10000;
+  stream.setReceiveTimeout(tv);
+  read = 0;
+  EXPECT_FALSE(stream.read(buf, sizeof(buf), read));
+  EXPECT_EQ(stream.getState(), comm::SocketState::Connected);
+
+  pair.second->close();
+  EXPECT_FALSE(stream.read(buf, sizeof(buf), read));
+  EXPECT_EQ(stream.getState(), comm::SocketState::Disconnected);
+}
+
+TEST(TransportTest, dashboard_client_over_custom_transport)
+{
+  auto pair = comm::InMemoryTransport::createPair();
+  std::thread dashboard_server([&pair]() {
+    auto transport = pair.second;
+    writeLine(*transport, "Connected: Universal Robots Dashboard Server\n");
+    while (true)
+    {
+      const std::string request = readLine(*transport);
+      if (request.empty())
+      {
+        return;
+      }
+      if (request == "PolyscopeVersion\n")
+      {
+        writeLine(*transport, "URSoftware 5.12.0.1101534 (Jun 21 2022)\n");
+      }
+      else
+      {
+        writeLine(*transport, "echo: " + request);
+      }
+    }
+  });
+
+  DashboardClient client("127.0.0.1");
+  client.setTransport(pair.first);
+  ASSERT_TRUE(client.connect(1));
+  EXPECT_EQ(client.sendAndReceive("hello"), "echo: hello");
+  client.disconnect();
+  dashboard_server.join();
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
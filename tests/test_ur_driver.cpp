@@ -41,6 +41,8 @@ using namespace urcl;
 const std::string SCRIPT_FILE = "../resources/external_control.urscript";
 const std::string OUTPUT_RECIPE = "resources/rtde_output_recipe.txt";
 const std::string INPUT_RECIPE = "resources/rtde_input_recipe.txt";
+// Doesn't use any inputs of the driver running the program, as the robot doesn't share inputs between clients
+const std::string MONITORING_INPUT_RECIPE = "resources/rtde_input_recipe_monitoring.txt";
 const std::string CALIBRATION_CHECKSUM = "calib_12788084448423163542";
 std::string g_ROBOT_IP = "192.168.56.101";
 bool g_HEADLESS = true;
@@ -92,6 +94,35 @@ TEST_F(UrDriverTest, read_existing_script_file)
   unlink(existing_script_file);
 }
 
+TEST_F(UrDriverTest, startup_timings)
+{
+  const StartupTimings& timings = g_my_robot->ur_driver_->getStartupTimings();
+  EXPECT_GT(timings.rtde.count(), 0);
+  EXPECT_GT(timings.primary.count(), 0);
+  // Phases running concurrently to the RTDE handshake don't add to the total startup time
+  EXPECT_GE(timings.total, timings.rtde + timings.reverse_interface + timings.script_rendering);
+  EXPECT_LT(timings.total, timings.rtde + timings.primary + timings.script_loading + timings.control_servers +
+                               timings.reverse_interface + timings.script_rendering + timings.program_setup);
+}
+
+TEST_F(UrDriverTest, monitoring_only_driver)
+{
+  UrDriver monitor(g_ROBOT_IP, SCRIPT_FILE, OUTPUT_RECIPE, MONITORING_INPUT_RECIPE, std::function<void(bool)>(),
+                   g_HEADLESS, std::unique_ptr<ToolCommSetup>(), 50011, 50012, 2000, 0.03, false, "", 50013, 50014,
+                   DriverCapabilities::MONITORING_ONLY);
+  EXPECT_FALSE(monitor.hasCapabilities(DriverCapabilities::REVERSE_INTERFACE));
+  EXPECT_FALSE(monitor.isReverseInterfaceConnected());
+  EXPECT_THROW(monitor.writeKeepalive(), UrException);
+  EXPECT_THROW(monitor.zeroFTSensor(), UrException);
+  EXPECT_THROW(monitor.writeTrajectoryPoint(vector6d_t{}, false), UrException);
+
+  monitor.startRTDECommunication();
+  EXPECT_NE(monitor.getDataPackage(), nullptr);
+
+  // The monitoring driver doesn't send a program replacing the running one
+  EXPECT_FALSE(g_my_robot->waitForProgramNotRunning(1000));
+}
+
 TEST_F(UrDriverTest, robot_receive_timeout)
 {
   // Robot program should time out after the robot receive timeout, whether it takes exactly 200 ms is not so important
@@ -226,9 +257,9 @@ TEST_F(UrDriverTest, target_outside_limits_pose)
 
 TEST_F(UrDriverTest, send_robot_program_retry_on_failure)
 {
-  // Check that sendRobotProgram is robust to the secondary stream being disconnected. This is what happens when
+  // Check that sendRobotProgram is robust to the primary stream being disconnected. This is what happens when
   // switching from Remote to Local and back to Remote mode for example.
-  g_my_robot->ur_driver_->secondary_stream_->close();
+  g_my_robot->ur_driver_->primary_client_->stream_.close();
 
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
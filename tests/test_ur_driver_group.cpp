@@ -0,0 +1,112 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <dirent.h>
+
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include <ur_client_library/ur/ur_driver_group.h>
+
+using namespace urcl;
+
+namespace
+{
+// Names of all threads of this process
+std::set<std::string> getThreadNames()
+{
+  std::set<std::string> names;
+  DIR* tasks = opendir("/proc/self/task");
+  if (tasks == nullptr)
+  {
+    return names;
+  }
+  while (dirent* entry = readdir(tasks))
+  {
+    std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+    std::string name;
+    if (std::getline(comm, name))
+    {
+      names.insert(name);
+    }
+  }
+  closedir(tasks);
+  return names;
+}
+}  // namespace
+
+TEST(ur_driver_group, empty_group)
+{
+  UrDriverGroup group;
+  EXPECT_EQ(group.getNumDrivers(), 0u);
+  EXPECT_EQ(group.getNumConnected(), 0u);
+  EXPECT_TRUE(group.getHealth().empty());
+  EXPECT_THROW(group.getDriver(0), std::out_of_range);
+  EXPECT_NO_THROW(group.startRTDECommunication());
+
+  std::shared_ptr<comm::LatencyStatistics> statistics = group.getAggregatedLatencyStatistics();
+  ASSERT_NE(statistics, nullptr);
+  EXPECT_EQ(statistics->receive_interval.getCount(), 0u);
+}
+
+TEST(ur_driver_group, armed_trajectories_without_drivers)
+{
+  UrDriverGroup group;
+  EXPECT_THROW(group.armTrajectories({ 3 }), UrException);
+  EXPECT_FALSE(group.startArmedTrajectories());
+  EXPECT_TRUE(group.armTrajectories({}));
+  EXPECT_TRUE(group.startArmedTrajectories(std::chrono::milliseconds(0)));
+  // The start token is used up
+  EXPECT_FALSE(group.startArmedTrajectories());
+}
+
+TEST(ur_driver_group, io_threads)
+{
+  ThreadConfig config;
+  config.name = "urcl_io";
+  UrDriverGroup group(3, config);
+  ASSERT_NE(group.getReactor(), nullptr);
+  EXPECT_EQ(group.getReactor()->getNumLoops(), 3u);
+
+  const std::set<std::string> names = getThreadNames();
+  EXPECT_EQ(names.count("urcl_io_0"), 1u);
+  EXPECT_EQ(names.count("urcl_io_1"), 1u);
+  EXPECT_EQ(names.count("urcl_io_2"), 1u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
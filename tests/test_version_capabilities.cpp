@@ -0,0 +1,91 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <ur_client_library/ur/version_capabilities.h>
+
+using namespace urcl;
+
+TEST(version_capabilities, unknown_version_supports_nothing)
+{
+  VersionCapabilities capabilities;
+  for (size_t i = 0; i < VersionCapabilities::NUM_DASHBOARD_COMMANDS; ++i)
+  {
+    EXPECT_FALSE(capabilities.supports(static_cast<DashboardCommand>(i)));
+    EXPECT_NE(std::string(VersionCapabilities::getName(static_cast<DashboardCommand>(i))), "");
+  }
+  for (size_t i = 0; i < VersionCapabilities::NUM_ROBOT_FEATURES; ++i)
+  {
+    EXPECT_FALSE(capabilities.supports(static_cast<RobotFeature>(i)));
+  }
+}
+
+TEST(version_capabilities, e_series_minimum_versions)
+{
+  VersionCapabilities old_version(VersionInformation::fromString("5.5.1"));
+  EXPECT_TRUE(old_version.supports(DashboardCommand::SAFETY_STATUS));
+  EXPECT_FALSE(old_version.supports(DashboardCommand::IS_IN_REMOTE_CONTROL));
+  EXPECT_FALSE(old_version.supports(DashboardCommand::SET_USER_ROLE));
+  EXPECT_TRUE(old_version.supports(RobotFeature::TOOL_CONTACT));
+  EXPECT_DOUBLE_EQ(old_version.getMaxRtdeFrequency(), VersionCapabilities::URE_MAX_RTDE_FREQUENCY);
+
+  VersionCapabilities new_version(VersionInformation::fromString("5.8.0.1234"));
+  EXPECT_TRUE(new_version.supports(DashboardCommand::IS_IN_REMOTE_CONTROL));
+  EXPECT_TRUE(new_version.supports(DashboardCommand::GENERATE_FLIGHT_REPORT));
+  EXPECT_EQ(new_version.getVersion(), VersionInformation::fromString("5.8.0.1234"));
+}
+
+TEST(version_capabilities, cb3_minimum_versions)
+{
+  VersionCapabilities capabilities(VersionInformation::fromString("3.12.0"));
+  EXPECT_TRUE(capabilities.supports(DashboardCommand::GET_ROBOT_MODEL));
+  EXPECT_TRUE(capabilities.supports(DashboardCommand::SET_USER_ROLE));
+  EXPECT_FALSE(capabilities.supports(DashboardCommand::GENERATE_SUPPORT_FILE));
+  EXPECT_FALSE(capabilities.supports(DashboardCommand::GET_OPERATIONAL_MODE));
+  for (size_t i = 0; i < VersionCapabilities::NUM_ROBOT_FEATURES; ++i)
+  {
+    EXPECT_FALSE(capabilities.supports(static_cast<RobotFeature>(i)));
+  }
+  EXPECT_DOUBLE_EQ(capabilities.getMaxRtdeFrequency(), VersionCapabilities::CB3_MAX_RTDE_FREQUENCY);
+}
+
+TEST(version_capabilities, minimum_version_lookup)
+{
+  VersionInformation version;
+  ASSERT_TRUE(VersionCapabilities::getMinimumVersion(DashboardCommand::RESTART_SAFETY, true, version));
+  EXPECT_EQ(version, VersionInformation::fromString("5.1.0"));
+  ASSERT_TRUE(VersionCapabilities::getMinimumVersion(DashboardCommand::RESTART_SAFETY, false, version));
+  EXPECT_EQ(version, VersionInformation::fromString("3.7"));
+  EXPECT_FALSE(VersionCapabilities::getMinimumVersion(DashboardCommand::GET_USER_ROLE, true, version));
+  EXPECT_FALSE(VersionCapabilities::getMinimumVersion(DashboardCommand::CLEAR_OPERATIONAL_MODE, false, version));
+}
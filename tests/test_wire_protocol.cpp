@@ -0,0 +1,137 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2025 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <regex>
+#include <set>
+#include <sstream>
+
+#include <ur_client_library/control/wire_protocol.h>
+#include <ur_client_library/types.h>
+
+using namespace urcl::control;
+
+const std::string SCRIPT_FILE = "../resources/external_control.urscript";
+
+TEST(wire_protocol, encode_fields)
+{
+  int32_t message[wire::trajectory::MESSAGE_LENGTH] = { 0 };
+  const urcl::vector6d_t positions = { 0.1, -0.2, 0.3, -0.4, 0.5, -0.6 };
+  wire::encode(message, wire::trajectory::MOVE_POSITIONS, positions);
+  wire::fill(message, wire::trajectory::MOVE_VELOCITY, 1.5);
+  wire::encode(message, wire::trajectory::TIME, 2.0);
+  wire::encode(message, wire::trajectory::TYPE, static_cast<int32_t>(4));
+
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    EXPECT_EQ(std::round(positions[i] * wire::MULT_JOINTSTATE), message[i]);
+    EXPECT_EQ(1500000, message[6 + i]);
+    EXPECT_EQ(0, message[12 + i]);
+  }
+  EXPECT_EQ(2000, message[18]);
+  EXPECT_EQ(0, message[19]);
+  EXPECT_EQ(4, message[20]);
+}
+
+TEST(wire_protocol, compact_payload_length)
+{
+  EXPECT_EQ(6u, wire::reverse::compactPayloadLength(urcl::comm::ControlMode::MODE_SERVOJ));
+  EXPECT_EQ(6u, wire::reverse::compactPayloadLength(urcl::comm::ControlMode::MODE_FORCE));
+  EXPECT_EQ(3u, wire::reverse::compactPayloadLength(urcl::comm::ControlMode::MODE_FORWARD));
+  EXPECT_EQ(1u, wire::reverse::compactPayloadLength(urcl::comm::ControlMode::MODE_FREEDRIVE));
+  EXPECT_EQ(0u, wire::reverse::compactPayloadLength(urcl::comm::ControlMode::MODE_IDLE));
+  EXPECT_EQ(2u, wire::reverse::compactPayloadLength(
+                    static_cast<urcl::comm::ControlMode>(wire::reverse::SERVO_PARAMETERS_MODE)));
+}
+
+TEST(wire_protocol, urscript_definitions)
+{
+  const std::string definitions = wire::generateURScriptDefinitions();
+  // Indices are one-based, as the first element read holds the number of integers
+  EXPECT_NE(std::string::npos, definitions.find("\nREVERSE_SETPOINT_LENGTH = 8\n"));
+  EXPECT_NE(std::string::npos, definitions.find("\nREVERSE_SETPOINT_CONTROL_MODE = 8\n"));
+  EXPECT_NE(std::string::npos, definitions.find("\nTRAJECTORY_MOVE_VELOCITY = 7\n"));
+  EXPECT_NE(std::string::npos, definitions.find("\nTRAJECTORY_MOVE_ACCELERATION = 13\n"));
+  EXPECT_NE(std::string::npos, definitions.find("\nSCRIPT_COMMAND_SEQUENCE = 29\n"));
+  EXPECT_NE(std::string::npos, definitions.find("\nMULT_jointstate = 1000000\n"));
+  EXPECT_NE(std::string::npos, definitions.find("def compact_payload_length(mode):\n"
+                                                "  if mode == MODE_SERVOJ or mode == MODE_SPEEDJ or mode == MODE_SPEEDL "
+                                                "or mode == MODE_POSE or mode == MODE_FORCE:\n"
+                                                "    return 6\n"
+                                                "  elif mode == MODE_FORWARD:\n"
+                                                "    return 3\n"
+                                                "  elif mode == MODE_FREEDRIVE:\n"
+                                                "    return 1\n"
+                                                "  elif mode == REVERSE_SERVO_PARAMETERS:\n"
+                                                "    return 2\n"
+                                                "  end\n"));
+}
+
+TEST(wire_protocol, script_uses_generated_definitions)
+{
+  std::ifstream file(SCRIPT_FILE);
+  ASSERT_TRUE(file.good());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string script = buffer.str();
+  ASSERT_NE(std::string::npos, script.find("{{WIRE_PROTOCOL_REPLACE}}"));
+
+  std::set<std::string> defined;
+  const std::regex definition("^([A-Za-z_0-9]+) = ", std::regex::multiline);
+  const std::string definitions = wire::generateURScriptDefinitions();
+  for (auto it = std::sregex_iterator(definitions.begin(), definitions.end(), definition);
+       it != std::sregex_iterator(); ++it)
+  {
+    defined.insert((*it)[1]);
+  }
+  for (auto it = std::sregex_iterator(script.begin(), script.end(), definition); it != std::sregex_iterator(); ++it)
+  {
+    defined.insert((*it)[1]);
+  }
+
+  // Every message field the script refers to has to be defined
+  const std::regex field_reference("\\b(REVERSE_(SETPOINT|TRAJECTORY|FREEDRIVE|PROTOCOL|SERVO_PARAMETERS)|"
+                                   "TRAJECTORY_(MOVE|CIRCULAR|SPLINE|SEGMENT)|SCRIPT_(COMMAND|PAYLOAD|TOOL_VOLTAGE|"
+                                   "FORCE_MODE|BATCH))_[A-Z0-9_]+\\b");
+  size_t num_references = 0;
+  for (auto it = std::sregex_iterator(script.begin(), script.end(), field_reference); it != std::sregex_iterator();
+       ++it)
+  {
+    if (it->str().find("_REPLACE") != std::string::npos)
+    {
+      continue;
+    }
+    EXPECT_EQ(1u, defined.count(it->str())) << it->str() << " is not defined";
+    ++num_references;
+  }
+  EXPECT_GT(num_references, 0u);
+}